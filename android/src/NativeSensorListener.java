@@ -3,6 +3,8 @@
 
 package org.xcsoar;
 
+import java.nio.ByteBuffer;
+
 /**
  * An #SensorListener implementation that passes method calls to
  * native code.
@@ -30,6 +32,9 @@ final class NativeSensorListener implements SensorListener {
                                       boolean hasSpeed, double speed,
                                       boolean hasAccuracy, double accuracy);
 
+  @Override
+  public native void onSensorBatch(ByteBuffer buffer, int n, long now);
+
   @Override
   public native void onAccelerationSensor1(double acceleration);
 
@@ -14,6 +14,7 @@ import java.io.Closeable;
 
 import android.content.Context;
 import android.os.Handler;
+import android.os.SystemClock;
 import android.hardware.Sensor;
 import android.hardware.SensorEvent;
 import android.hardware.SensorEventListener;
@@ -22,6 +23,8 @@ import android.util.Log;
 import android.view.Surface;
 import android.view.WindowManager;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.HashMap;
 import java.util.Map;
 
@@ -99,6 +102,39 @@ public class NonGPSSensors
 
   private final SafeDestruct safeDestruct = new SafeDestruct();
 
+  // Sample types in the batch buffer; these must have the same
+  // numerical values as SensorListener::SensorSample::Type (C++).
+  private static final int SAMPLE_ACCELERATION = 1;
+  private static final int SAMPLE_ROTATION = 2;
+  private static final int SAMPLE_MAGNETIC_FIELD = 3;
+  private static final int SAMPLE_PRESSURE = 4;
+
+  // The size of one record in the batch buffer: timestamp (long),
+  // type (int), four values (float) and padding (int), matching
+  // SensorListener::SensorSample (C++).
+  private static final int SAMPLE_SIZE = 32;
+
+  private static final int MAX_BATCH = 64;
+
+  // Submit the batch after this delay, i.e. about once per display
+  // frame.
+  private static final long BATCH_DELAY_MS = 16;
+
+  // Sensor events are collected in this buffer and submitted to
+  // native code with one call, see flushBatch().  Only accessed in
+  // the main thread.
+  private final ByteBuffer batch_ =
+    ByteBuffer.allocateDirect(MAX_BATCH * SAMPLE_SIZE)
+    .order(ByteOrder.nativeOrder());
+  private int batch_count_ = 0;
+
+  private final Runnable flushBatchRunnable = new Runnable() {
+      @Override
+      public void run() {
+        flushBatch();
+      }
+    };
+
   NonGPSSensors(Context context, SensorListener listener) {
     handler_ = new Handler(context.getMainLooper());
     this.listener = listener;
@@ -201,11 +237,53 @@ public class NonGPSSensors
   @Override
   public void close() {
     safeDestruct.beginShutdown();
+    handler_.removeCallbacks(flushBatchRunnable);
     for (int id : SUPPORTED_SENSORS) enabled_sensors_[id] = false;
     updateSensorSubscriptions();
     safeDestruct.finishShutdown();
   }
 
+  /**
+   * Append a record to the batch buffer.  The first record schedules
+   * flushBatch(); a full buffer is flushed right away.
+   */
+  private void addSample(long timestamp, int type,
+                         float v0, float v1, float v2, float v3) {
+    batch_.putLong(timestamp);
+    batch_.putInt(type);
+    batch_.putFloat(v0);
+    batch_.putFloat(v1);
+    batch_.putFloat(v2);
+    batch_.putFloat(v3);
+    batch_.putInt(0);
+
+    if (++batch_count_ >= MAX_BATCH) {
+      handler_.removeCallbacks(flushBatchRunnable);
+      flushBatch();
+    } else if (batch_count_ == 1)
+      handler_.postDelayed(flushBatchRunnable, BATCH_DELAY_MS);
+  }
+
+  /**
+   * Submit all collected samples to native code with one JNI call.
+   */
+  private void flushBatch() {
+    if (batch_count_ == 0)
+      return;
+
+    if (safeDestruct.increment()) {
+      try {
+        listener.onSensorBatch(batch_, batch_count_,
+                               SystemClock.elapsedRealtimeNanos());
+      } finally {
+        safeDestruct.decrement();
+      }
+    }
+
+    batch_.clear();
+    batch_count_ = 0;
+  }
+
   /**
    * from runnable; called by the #Handler and indirectly by
    * updateSensorSubscriptions(). Updates the sensor subscriptions inside the
@@ -232,7 +310,10 @@ public class NonGPSSensors
   public void onAccuracyChanged(Sensor sensor, int accuracy) {
   }
 
-  /** from SensorEventListener; report new sensor values to XCSoar. */
+  /**
+   * from SensorEventListener; collect new sensor values, to be
+   * submitted to XCSoar by flushBatch().
+   */
   public void onSensorChanged(SensorEvent event) {
     if (!safeDestruct.increment())
       return;
@@ -261,22 +342,21 @@ public class NonGPSSensors
         }
         // TODO: do lowpass filtering to remove vibrations?!?
 
-        listener.onAccelerationSensor1(acceleration);
-
-        listener.onAccelerationSensor(event.values[0], event.values[1],
-                                      event.values[2]);
+        addSample(event.timestamp, SAMPLE_ACCELERATION,
+                  event.values[0], event.values[1], event.values[2],
+                  (float) acceleration);
         break;
       case Sensor.TYPE_GYROSCOPE:
-        listener.onRotationSensor(event.values[0], event.values[1],
-                                  event.values[2]);
+        addSample(event.timestamp, SAMPLE_ROTATION,
+                  event.values[0], event.values[1], event.values[2], 0);
         break;
       case Sensor.TYPE_MAGNETIC_FIELD:
-        listener.onMagneticFieldSensor(event.values[0], event.values[1],
-                                       event.values[2]);
+        addSample(event.timestamp, SAMPLE_MAGNETIC_FIELD,
+                  event.values[0], event.values[1], event.values[2], 0);
         break;
       case Sensor.TYPE_PRESSURE:
-        listener.onBarometricPressureSensor(event.values[0],
-                                            kf_sensor_noise_variance_);
+        addSample(event.timestamp, SAMPLE_PRESSURE,
+                  event.values[0], kf_sensor_noise_variance_, 0, 0);
         break;
       }
     } finally {
@@ -3,6 +3,8 @@
 
 package org.xcsoar;
 
+import java.nio.ByteBuffer;
+
 /**
  * Handler for sensor values obtained from Java code.
  */
@@ -21,6 +23,16 @@ public interface SensorListener {
                         boolean hasSpeed, double speed,
                         boolean hasAccuracy, double accuracy);
 
+  /**
+   * Submit a batch of samples from the internal sensors, see
+   * NonGPSSensors.
+   *
+   * @param buffer a direct buffer containing #n records
+   * @param now the value of SystemClock.elapsedRealtimeNanos(), the
+   * time base of the record timestamps
+   */
+  void onSensorBatch(ByteBuffer buffer, int n, long now);
+
   void onAccelerationSensor1(double acceleration);
   void onAccelerationSensor(float ddx, float ddy, float ddz);
   void onRotationSensor(float dtheta_x, float dtheta_y, float dtheta_z);
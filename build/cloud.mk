@@ -1,13 +1,15 @@
 CLOUD_SERVER_SOURCES = \
 	$(SRC)/Tracking/SkyLines/Server.cpp \
+	$(SRC)/Tracking/SkyLines/Batch.cpp \
 	$(SRC)/Tracking/SkyLines/Assemble.cpp \
 	$(SRC)/Cloud/Serialiser.cpp \
 	$(SRC)/Cloud/Client.cpp \
 	$(SRC)/Cloud/Thermal.cpp \
 	$(SRC)/Cloud/Data.cpp \
+	$(SRC)/Cloud/Journal.cpp \
 	$(SRC)/Cloud/Sender.cpp \
 	$(SRC)/Cloud/Main.cpp
-CLOUD_SERVER_DEPENDS = ASYNC LIBNET IO OS GEO MATH UTIL
+CLOUD_SERVER_DEPENDS = ASYNC LIBNET IO OS THREAD GEO MATH UTIL
 $(eval $(call link-program,xcsoar-cloud-server,CLOUD_SERVER))
 
 CLOUD_TO_KML_SOURCES = \
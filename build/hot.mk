@@ -12,7 +12,9 @@ HOT_SOURCES = \
 	$(SRC)/Terrain/RasterMap.cpp \
 	$(SRC)/Terrain/HeightMatrix.cpp \
 	$(SRC)/Terrain/RasterRenderer.cpp \
+	$(SRC)/Terrain/SlopeShading.cpp \
 	$(SRC)/Terrain/RasterTile.cpp \
+	$(SRC)/Terrain/HeightPyramid.cpp \
 	$(SRC)/Terrain/ScanLine.cpp \
 	$(SRC)/Terrain/Intersection.cpp \
 	$(SRC)/Projection/Projection.cpp \
@@ -24,12 +26,16 @@ HOT_SOURCES = \
 	$(ENGINE_SRC_DIR)/GlideSolvers/GlidePolar.cpp \
 	$(ENGINE_SRC_DIR)/Route/FlatTriangleFan.cpp \
 	$(ENGINE_SRC_DIR)/Route/FlatTriangleFanTree.cpp \
+	$(ENGINE_SRC_DIR)/Route/FlatTriangleFanGrid.cpp \
+	$(ENGINE_SRC_DIR)/Route/ReachAirspaceMask.cpp \
 	$(ENGINE_SRC_DIR)/Route/ReachFan.cpp \
 	$(ENGINE_SRC_DIR)/Route/RoutePolar.cpp \
 	$(ENGINE_SRC_DIR)/Route/RouteLink.cpp \
 	$(ENGINE_SRC_DIR)/Route/RoutePolars.cpp \
+	$(ENGINE_SRC_DIR)/Route/RoutePolarCache.cpp \
 	$(ENGINE_SRC_DIR)/Contest/Solvers/ContestDijkstra.cpp \
 	$(ENGINE_SRC_DIR)/Contest/Solvers/TraceManager.cpp \
+	$(ENGINE_SRC_DIR)/Contest/Solvers/TraceSnapshot.cpp \
 	$(ENGINE_SRC_DIR)/Contest/Solvers/TriangleContest.cpp
 
 $(call SRC_TO_OBJ,$(HOT_SOURCES)): OPTIMIZE += -O3
@@ -57,6 +57,7 @@ KOBO_POWER_OFF_SOURCES = \
 	$(SRC)/Hardware/Battery.cpp \
 	$(SRC)/Screen/Layout.cpp \
 	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/Logger/FlightIndex.cpp \
 	$(SRC)/Renderer/FlightListRenderer.cpp \
 	$(SRC)/Renderer/TextRenderer.cpp \
 	$(SRC)/FlightInfo.cpp \
@@ -33,6 +33,15 @@ ASYNC_SOURCES += \
 endif
 endif
 
+ifeq ($(TARGET_IS_LINUX)$(USE_URING),yy)
+ASYNC_SOURCES += \
+	$(SRC)/io/uring/Ring.cxx \
+	$(SRC)/io/uring/Queue.cxx \
+	$(SRC)/io/uring/BufferRing.cxx \
+	$(SRC)/io/uring/ReadStream.cxx \
+	$(SRC)/event/UringManager.cxx
+endif
+
 ASYNC_DEPENDS = CARES OS
 
 $(eval $(call link-library,async,ASYNC))
@@ -17,15 +17,19 @@ LIBCOMPUTER_SOURCES = \
 	$(SRC)/Computer/ConditionMonitor/AirspaceEnterMonitor.cpp \
 	$(SRC)/Computer/ConditionMonitor/MoreConditionMonitors.cpp \
 	$(SRC)/Computer/CuComputer.cpp \
+	$(SRC)/Computer/TrafficProximityComputer.cpp \
+	$(SRC)/Tracking/JETProvider/Extrapolate.cpp \
 	$(SRC)/Computer/FlyingComputer.cpp \
 	$(SRC)/Computer/CirclingComputer.cpp \
 	$(SRC)/Computer/ThermalBandComputer.cpp \
 	$(SRC)/Computer/Wind/Computer.cpp \
+	$(SRC)/Computer/ContestCheckpoint.cpp \
 	$(SRC)/Computer/ContestComputer.cpp \
 	$(SRC)/Computer/TraceComputer.cpp \
 	$(SRC)/Computer/WarningComputer.cpp \
 	$(SRC)/Computer/ThermalRecency.cpp \
 	$(SRC)/Computer/ThermalLocator.cpp \
+	$(SRC)/Computer/ThermalHistory.cpp \
 	$(SRC)/Computer/ThermalBase.cpp \
 	$(SRC)/Computer/LiftDatabaseComputer.cpp \
 	$(SRC)/Computer/LogComputer.cpp \
@@ -37,6 +41,7 @@ LIBCOMPUTER_SOURCES = \
 	$(SRC)/Computer/GlideComputerAirData.cpp \
 	$(SRC)/Computer/WaveComputer.cpp \
 	$(SRC)/Computer/StatsComputer.cpp \
+	$(SRC)/Computer/ReachThread.cpp \
 	$(SRC)/Computer/RouteComputer.cpp \
 	$(SRC)/Computer/TaskComputer.cpp \
 	$(SRC)/Computer/GlideComputerInterface.cpp \
@@ -5,6 +5,7 @@ IO_SRC_DIR = $(SRC)/io
 IO_SOURCES = \
 	$(SRC)/lib/zlib/Error.cxx \
 	$(SRC)/lib/zlib/GunzipReader.cxx \
+	$(SRC)/lib/zlib/GzipOutputStream.cxx \
 	$(IO_SRC_DIR)/CopyFile.cxx \
 	$(IO_SRC_DIR)/Open.cxx \
 	$(IO_SRC_DIR)/MemoryReader.cxx \
@@ -15,19 +16,22 @@ IO_SOURCES = \
 	$(IO_SRC_DIR)/FileReader.cxx \
 	$(IO_SRC_DIR)/BufferedOutputStream.cxx \
 	$(IO_SRC_DIR)/FileOutputStream.cxx \
+	$(IO_SRC_DIR)/AsyncFileWriter.cpp \
 	$(IO_SRC_DIR)/FileTransaction.cpp \
 	$(IO_SRC_DIR)/FileCache.cpp \
 	$(IO_SRC_DIR)/ZipArchive.cpp \
+	$(IO_SRC_DIR)/ZipArchiveCache.cpp \
 	$(IO_SRC_DIR)/ZipReader.cpp \
 	$(IO_SRC_DIR)/StringConverter.cpp \
 	$(IO_SRC_DIR)/ConvertLineReader.cpp \
 	$(IO_SRC_DIR)/FileLineReader.cpp \
+	$(IO_SRC_DIR)/MappedLineReader.cpp \
 	$(IO_SRC_DIR)/KeyValueFileReader.cpp \
 	$(IO_SRC_DIR)/KeyValueFileWriter.cpp \
 	$(IO_SRC_DIR)/ZipLineReader.cpp \
 	$(IO_SRC_DIR)/CSVLine.cpp
 
-IO_DEPENDS = OS ZLIB FMT UTIL
+IO_DEPENDS = OS THREAD ZLIB FMT UTIL
 
 $(eval $(call link-library,io,IO))
 
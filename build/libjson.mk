@@ -2,6 +2,7 @@ JSON_SOURCES = \
 	$(SRC)/json/Serialize.cxx \
 	$(SRC)/json/Parse.cxx \
 	$(SRC)/json/ParserOutputStream.cxx \
+	$(SRC)/json/StreamParser.cxx \
 	$(SRC)/json/Boost.cxx
 JSON_CPPFLAGS = -DBOOST_JSON_STANDALONE
 
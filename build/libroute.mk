@@ -8,8 +8,11 @@ ROUTE_SOURCES = \
 	$(ROUTE_SRC_DIR)/RouteLink.cpp \
 	$(ROUTE_SRC_DIR)/RoutePolar.cpp \
 	$(ROUTE_SRC_DIR)/RoutePolars.cpp \
+	$(ROUTE_SRC_DIR)/RoutePolarCache.cpp \
 	$(ROUTE_SRC_DIR)/FlatTriangleFan.cpp \
 	$(ROUTE_SRC_DIR)/FlatTriangleFanTree.cpp \
+	$(ROUTE_SRC_DIR)/FlatTriangleFanGrid.cpp \
+	$(ROUTE_SRC_DIR)/ReachAirspaceMask.cpp \
 	$(ROUTE_SRC_DIR)/ReachFan.cpp
 
 ROUTE_DEPENDS = GEO GLIDE
@@ -4,7 +4,9 @@ TERRAIN_SOURCES = \
 	$(SRC)/Terrain/RasterProjection.cpp \
 	$(SRC)/Terrain/RasterMap.cpp \
 	$(SRC)/Terrain/RasterTile.cpp \
+	$(SRC)/Terrain/HeightPyramid.cpp \
 	$(SRC)/Terrain/RasterTileCache.cpp \
+	$(SRC)/Terrain/RasterTileFile.cpp \
 	$(SRC)/Terrain/ZzipStream.cpp \
 	$(SRC)/Terrain/Loader.cpp \
 	$(SRC)/Terrain/WorldFile.cpp \
@@ -12,8 +14,10 @@ TERRAIN_SOURCES = \
 	$(SRC)/Terrain/ScanLine.cpp \
 	$(SRC)/Terrain/RasterTerrain.cpp \
 	$(SRC)/Terrain/Thread.cpp \
+	$(SRC)/Terrain/Prefetch.cpp \
 	$(SRC)/Terrain/HeightMatrix.cpp \
 	$(SRC)/Terrain/RasterRenderer.cpp \
+	$(SRC)/Terrain/SlopeShading.cpp \
 	$(SRC)/Terrain/TerrainRenderer.cpp \
 	$(SRC)/Terrain/TerrainSettings.cpp
 
@@ -2,12 +2,16 @@ TOPO_SOURCES = \
 	$(SRC)/Topography/ShapeFile.cpp \
 	$(SRC)/Topography/TopographyFile.cpp \
 	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyPackage.cpp \
 	$(SRC)/Topography/TopographyFileRenderer.cpp \
 	$(SRC)/Topography/TopographyRenderer.cpp \
 	$(SRC)/Topography/Thread.cpp \
 	$(SRC)/Topography/TopographyGlue.cpp \
 	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Topography/ShapeBufferAllocator.cpp \
+	$(SRC)/Topography/ShapeIndex.cpp \
 	$(SRC)/Topography/Index.cpp \
+	$(SRC)/Topography/TopographyTileCache.cpp \
 	$(SRC)/Topography/CachedTopographyRenderer.cpp
 
 TOPO_CPPFLAGS_INTERNAL = $(SCREEN_CPPFLAGS)
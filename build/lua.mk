@@ -21,6 +21,7 @@ LUA_SOURCES = \
 	$(SRC)/lua/Log.cpp \
 	$(SRC)/lua/Http.cpp \
 	$(SRC)/lua/Timer.cpp \
+	$(SRC)/lua/FieldTable.cpp \
 	$(SRC)/lua/Geo.cpp \
 	$(SRC)/lua/Map.cpp \
 	$(SRC)/lua/Blackboard.cpp \
@@ -34,6 +35,7 @@ LUA_SOURCES = \
 	$(SRC)/lua/Wind.cpp \
 	$(SRC)/lua/Logger.cpp \
 	$(SRC)/lua/Tracking.cpp \
+	$(SRC)/lua/Devices.cpp \
 	$(SRC)/lua/Replay.cpp \
 	$(SRC)/lua/InputEvent.cpp \
 
@@ -180,6 +180,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Task/RoutePlannerGlue.cpp \
 	$(SRC)/Task/ProtectedRoutePlanner.cpp \
 	$(SRC)/Task/TaskStore.cpp \
+	$(SRC)/Task/TaskIndex.cpp \
 	$(SRC)/Task/TypeStrings.cpp \
 	$(SRC)/Task/ValidationErrorStrings.cpp \
 	\
@@ -203,8 +204,10 @@ XCSOAR_SOURCES := \
 	$(SRC)/Renderer/GradientRenderer.cpp \
 	$(SRC)/Renderer/GlassRenderer.cpp \
 	$(SRC)/Renderer/TransparentRendererCache.cpp \
+	$(SRC)/Renderer/OpaqueRendererCache.cpp \
 	$(SRC)/Renderer/LabelBlock.cpp \
 	$(SRC)/Renderer/TextInBox.cpp \
+	$(SRC)/Renderer/TrafficLabelCache.cpp \
 	$(SRC)/Renderer/TraceHistoryRenderer.cpp \
 	$(SRC)/Renderer/ThermalBandRenderer.cpp \
 	$(SRC)/Renderer/TaskProgressRenderer.cpp \
@@ -212,6 +215,7 @@ XCSOAR_SOURCES := \
 	\
 	$(SRC)/Airspace/AirspaceGlue.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/Airspace/NearestAirspace.cpp \
@@ -233,9 +237,12 @@ XCSOAR_SOURCES := \
 	$(SRC)/FLARM/FlarmNetRecord.cpp \
 	$(SRC)/FLARM/FlarmNetDatabase.cpp \
 	$(SRC)/FLARM/FlarmNetReader.cpp \
+	$(SRC)/FLARM/FlarmNetCache.cpp \
 	$(SRC)/FLARM/Traffic.cpp \
 	$(SRC)/FLARM/Calculations.cpp \
+	$(SRC)/FLARM/Threat.cpp \
 	$(SRC)/FLARM/Friends.cpp \
+	$(SRC)/FLARM/NameCache.cpp \
 	$(SRC)/FLARM/Computer.cpp \
 	$(SRC)/FLARM/Global.cpp \
 	$(SRC)/FLARM/Glue.cpp \
@@ -252,11 +259,15 @@ XCSOAR_SOURCES := \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/util/MD5.cpp \
 	$(SRC)/Logger/NMEALogger.cpp \
+	$(SRC)/Logger/CompressedNMEA.cpp \
 	$(SRC)/Logger/ExternalLogger.cpp \
 	$(SRC)/Logger/FlightLogger.cpp \
+	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/Logger/FlightIndex.cpp \
 	$(SRC)/Logger/GlueFlightLogger.cpp \
 	$(SRC)/Replay/Replay.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCIndex.cpp \
 	$(SRC)/Replay/IgcReplay.cpp \
 	$(SRC)/Replay/NmeaReplay.cpp \
 	$(SRC)/Replay/DemoReplay.cpp \
@@ -270,6 +281,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Waypoint/WaypointListBuilder.cpp \
 	$(SRC)/Waypoint/WaypointFilter.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/SaveGlue.cpp \
 	$(SRC)/Waypoint/LastUsed.cpp \
 	$(SRC)/Waypoint/HomeGlue.cpp \
@@ -354,6 +366,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
+	$(SRC)/Renderer/AirspaceMeshCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
 	$(SRC)/Renderer/AirspaceLabelList.cpp \
 	$(SRC)/Renderer/AirspaceLabelRenderer.cpp \
@@ -384,6 +397,8 @@ XCSOAR_SOURCES := \
 	\
 	$(SRC)/Weather/Rasp/RaspStore.cpp \
 	$(SRC)/Weather/Rasp/RaspCache.cpp \
+	$(SRC)/Weather/SampleGrid.cpp \
+	$(SRC)/Weather/Stats.cpp \
 	$(SRC)/Weather/Rasp/RaspRenderer.cpp \
 	$(SRC)/Weather/Rasp/RaspStyle.cpp \
 	$(SRC)/Weather/Rasp/Configured.cpp \
@@ -408,6 +423,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Audio/Settings.cpp \
 	$(SRC)/Audio/VarioSettings.cpp \
 	$(SRC)/MergeThread.cpp \
+	$(SRC)/Profiler.cpp \
 	$(SRC)/CalculationThread.cpp \
 	$(SRC)/DisplayMode.cpp \
 	\
@@ -476,6 +492,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Audio/Sound.cpp \
 	$(SRC)/Compatibility/fmode.c \
 	$(SRC)/Profile/Profile.cpp \
+	$(SRC)/Profile/SaveThread.cpp \
 	$(SRC)/Profile/Screen.cpp \
 	$(SRC)/Profile/TrackingProfile.cpp \
 	$(SRC)/Profile/WeatherProfile.cpp \
@@ -503,6 +520,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Job/Thread.cpp \
 	$(SRC)/Job/Async.cpp \
 	$(SRC)/Job/InlineJobRunner.cpp \
+	$(SRC)/Job/Pool.cpp \
 	\
 	$(SRC)/RateLimiter.cpp \
 	\
@@ -530,6 +548,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/ApplyVegaSwitches.cpp \
 	$(SRC)/MainWindow.cpp \
 	$(SRC)/Startup.cpp \
+	$(SRC)/StartupTrace.cpp \
 	$(SRC)/Components.cpp \
 	$(SRC)/DataGlobals.cpp \
 	\
@@ -543,6 +562,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Device/Parser.cpp \
 	$(SRC)/Device/Simulator.cpp \
 	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Util/SensorFrame.cpp \
 	$(SRC)/Device/Util/NMEAWriter.cpp \
 	$(SRC)/Device/Util/NMEAReader.cpp \
 	$(SRC)/Device/Config.cpp \
@@ -637,7 +657,12 @@ XCSOAR_SOURCES += \
 	$(SRC)/Weather/NOAADownloader.cpp \
 	$(SRC)/Weather/NOAAStore.cpp \
 	$(SRC)/Weather/NOAAUpdater.cpp \
+	$(SRC)/Weather/NOAABatch.cpp \
 	$(SRC)/Weather/Skysight/Skysight.cpp \
+	$(SRC)/Weather/Skysight/OverlayLoader.cpp \
+	$(SRC)/Weather/Skysight/ImageCache.cpp \
+	$(SRC)/Weather/Skysight/ColorRamp.cpp \
+	$(SRC)/Weather/Skysight/FrameIndex.cpp \
 	$(SRC)/Weather/Skysight/CDFDecoder.cpp \
 	$(SRC)/Weather/Skysight/APIQueue.cpp \
 	$(SRC)/Weather/Skysight/SkysightAPI.cpp \
@@ -653,14 +678,19 @@ endif
 XCSOAR_SOURCES += \
 	$(SRC)/net/client/tim/Glue.cpp \
 	$(SRC)/Tracking/SkyLines/Client.cpp \
+	$(SRC)/Tracking/SkyLines/Batch.cpp \
 	$(SRC)/Tracking/SkyLines/Assemble.cpp \
 	$(SRC)/Tracking/SkyLines/Key.cpp \
 	$(SRC)/Tracking/SkyLines/Glue.cpp \
-	$(SRC)/Tracking/TrackingGlue.cpp
+	$(SRC)/Tracking/TrackingGlue.cpp \
+	$(SRC)/Tracking/MergedTraffic.cpp
 
 XCSOAR_SOURCES += \
 	$(SRC)/Tracking/JETProvider/JETProvider.cpp \
-	$(SRC)/Tracking/JETProvider/RadarParser.cpp
+	$(SRC)/Tracking/JETProvider/RadarParser.cpp \
+	$(SRC)/Tracking/JETProvider/Delta.cpp \
+	$(SRC)/Tracking/JETProvider/TrafficTable.cpp \
+	$(SRC)/Tracking/JETProvider/Scheduler.cpp
 
 ifeq ($(HAVE_PCM_PLAYER),y)
 XCSOAR_SOURCES += $(SRC)/Audio/VarioGlue.cpp
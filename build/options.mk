@@ -30,6 +30,13 @@ endif
 # (e.g. "address,undefined").
 SANITIZE ?= n
 
+# read from device ports with io_uring?  (Linux only; falls back to
+# epoll at runtime if the kernel doesn't support it)
+USE_URING ?= n
+ifeq ($(TARGET_IS_LINUX)$(USE_URING),yy)
+  TARGET_CPPFLAGS += -DENABLE_URING
+endif
+
 # show map renderer times?
 STOP_WATCH ?= n
 ifeq ($(STOP_WATCH),y)
@@ -17,6 +17,7 @@ OV_MENU_SOURCES = \
 	$(SRC)/Renderer/TwoTextRowsRenderer.cpp \
 	$(SRC)/Renderer/FlightListRenderer.cpp \
 	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/Logger/FlightIndex.cpp \
 	$(SRC)/Gauge/LogoView.cpp \
 	$(SRC)/Dialogs/DialogSettings.cpp \
 	$(SRC)/Dialogs/WidgetDialog.cpp \
@@ -28,6 +28,7 @@ SCREEN_SOURCES = \
 SCREEN_CUSTOM_SOURCES = \
 	$(WINDOW_SRC_DIR)/custom/DoubleClick.cpp \
 	$(CANVAS_SRC_DIR)/custom/GeoBitmap.cpp \
+	$(CANVAS_SRC_DIR)/custom/ScaleImage.cpp \
 	$(CANVAS_SRC_DIR)/custom/Pen.cpp \
 	$(CONTROL_SRC_DIR)/custom/LargeTextWindow.cpp \
 	$(WINDOW_SRC_DIR)/custom/Window.cpp \
@@ -132,6 +133,9 @@ SCREEN_SOURCES += \
 	$(CANVAS_SRC_DIR)/opengl/Shaders.cpp \
 	$(CANVAS_SRC_DIR)/opengl/CanvasRotateShift.cpp \
 	$(CANVAS_SRC_DIR)/opengl/Triangulate.cpp
+ifeq ($(FREETYPE),y)
+SCREEN_SOURCES += $(CANVAS_SRC_DIR)/opengl/GlyphAtlas.cpp
+endif
 endif
 
 ifeq ($(ENABLE_SDL),y)
@@ -193,6 +197,7 @@ SCREEN_SOURCES += \
 	$(CANVAS_SRC_DIR)/custom/Bitmap.cpp \
 	$(CANVAS_SRC_DIR)/custom/ResourceBitmap.cpp \
 	$(CANVAS_SRC_DIR)/memory/Export.cpp \
+	$(CANVAS_SRC_DIR)/memory/Damage.cpp \
 	$(WINDOW_SRC_DIR)/poll/TopWindow.cpp \
 	$(WINDOW_SRC_DIR)/fb/TopWindow.cpp \
 	$(CANVAS_SRC_DIR)/fb/TopCanvas.cpp \
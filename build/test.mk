@@ -70,6 +70,8 @@ endef
 
 $(foreach name,$(HARNESS_PROGRAMS),$(eval $(call link-harness-program,$(name))))
 
+$(eval $(call link-harness-program,BenchmarkTask))
+
 TEST_NAMES = \
 	test_fixed \
 	TestWaypoints \
@@ -86,22 +88,62 @@ TEST_NAMES = \
 	TestUnits TestEarth TestSunEphemeris \
 	TestValidity TestUTM \
 	TestAllocatedGrid \
-	TestRadixTree TestGeoBounds TestGeoClip \
+	TestRasterTileFile \
+	TestTopographyPackage \
+	TestShapeBufferAllocator \
+	TestShapeIndex \
+	TestThreadPool \
+	TestTaskGraph \
+	TestJobPool \
+	TestParallelOperation \
+	TestLockFreeFifoBuffer \
+	TestTripleBuffer \
+	TestContestManager \
+	TestContestCheckpoint \
+	TestRetrospective \
+	TestTraceSnapshot \
+	TestTraceComputer \
+	TestTerrainPrefetch \
+	TestSlopeShading \
+	TestGroundIntersections \
+	TestTerrainTilesCache \
+	TestRadixTree TestArenaAllocator TestQuadTree TestMappedLineReader TestAsyncFileWriter TestCompressedNMEA TestFlightIndex TestZipArchive TestGeoBounds TestGeoClip TestPolygonBandIndex \
 	TestLogger TestGRecord TestClimbAvCalc \
-	TestWaypointReader TestThermalBase \
+	TestWaypointReader TestThermalBase TestThermalHistory \
 	TestFlarmNet \
+	TestFlarmNameCache \
+	TestTrafficList \
+	TestFlarmCalculations \
+	TestFlarmThreat \
+	TestFadingTrafficList \
 	TestColorRamp TestGeoPoint TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
 	TestMacCready TestOrderedTask TestAATPoint \
+	TestTaskDijkstraMin TestTaskDijkstraMax \
+	TestAStar \
+	TestReachFan \
+	TestRoutePolarCache \
+	TestRouteRepair \
 	TestPlanes \
 	TestTaskPoint \
 	TestTaskWaypoint \
 	TestTeamCode \
 	TestZeroFinder \
-	TestAirspaceParser \
+	TestAirspaceParser TestAirspacesSynchronise TestAirspaceCache TestWaypointCache \
+	TestAirspaceWarningManager \
 	TestMETARParser \
+	TestNOAABatch \
+	TestSkyLinesBatch \
+	TestTaskIndex \
+	TestWeatherSampleGrid \
+	TestWeatherStats \
+	TestStartupTrace \
+	TestMergedTraffic \
+	TestTrafficProximity \
+	TestRadarParser \
 	TestIGCParser \
+	TestIGCIndex \
 	TestStrings TestUTF8 \
 	TestCRC \
 	TestUnitsFormatter \
@@ -111,6 +153,17 @@ TEST_NAMES = \
 	TestTimeFormatter \
 	TestIGCFilenameFormatter \
 	TestNMEAFormatter \
+	TestNMEASentenceTable \
+	TestLineSplitter \
+	TestSensorFrame \
+	TestProfiler \
+	TestWaypointLabelList \
+	TestFramePacer \
+	TestDamage \
+	TestPixelOperations \
+	TestScaleImage \
+	TestSkysightColorRamp \
+	TestSkysightFrameIndex \
 	TestLXNToIGC \
 	TestLeastSquares \
 	TestHexString \
@@ -123,6 +176,10 @@ TEST_NAMES += \
 	TestDriver
 endif
 
+ifeq ($(TARGET_IS_LINUX)$(USE_URING),yy)
+TEST_NAMES += TestUringReadStream
+endif
+
 TESTS = $(call name-to-bin,$(TEST_NAMES))
 
 TEST_HEX_STRING_SOURCES = \
@@ -165,6 +222,14 @@ TEST_IGC_PARSER_SOURCES = \
 TEST_IGC_PARSER_DEPENDS = MATH UTIL
 $(eval $(call link-program,TestIGCParser,TEST_IGC_PARSER))
 
+TEST_IGC_INDEX_SOURCES = \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCIndex.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestIGCIndex.cpp
+TEST_IGC_INDEX_DEPENDS = IO OS MATH UTIL
+$(eval $(call link-program,TestIGCIndex,TEST_IGC_INDEX))
+
 TEST_METAR_PARSER_SOURCES = \
 	$(SRC)/Weather/METARParser.cpp \
 	$(SRC)/Units/Descriptor.cpp \
@@ -175,6 +240,87 @@ TEST_METAR_PARSER_SOURCES = \
 TEST_METAR_PARSER_DEPENDS = MATH UTIL
 $(eval $(call link-program,TestMETARParser,TEST_METAR_PARSER))
 
+TEST_NOAA_BATCH_SOURCES = \
+	$(SRC)/Weather/NOAABatch.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestNOAABatch.cpp
+TEST_NOAA_BATCH_DEPENDS = TIME UTIL
+$(eval $(call link-program,TestNOAABatch,TEST_NOAA_BATCH))
+
+TEST_SKYLINES_BATCH_SOURCES = \
+	$(SRC)/Tracking/SkyLines/Batch.cpp \
+	$(SRC)/Tracking/SkyLines/Assemble.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSkyLinesBatch.cpp
+TEST_SKYLINES_BATCH_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestSkyLinesBatch,TEST_SKYLINES_BATCH))
+
+TEST_TASK_INDEX_SOURCES = \
+	$(SRC)/Task/TaskIndex.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTaskIndex.cpp
+TEST_TASK_INDEX_DEPENDS = IO OS UTIL
+$(eval $(call link-program,TestTaskIndex,TEST_TASK_INDEX))
+
+TEST_WEATHER_SAMPLE_GRID_SOURCES = \
+	$(SRC)/Weather/SampleGrid.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWeatherSampleGrid.cpp
+TEST_WEATHER_SAMPLE_GRID_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestWeatherSampleGrid,TEST_WEATHER_SAMPLE_GRID))
+
+TEST_WEATHER_STATS_SOURCES = \
+	$(SRC)/Weather/Stats.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWeatherStats.cpp
+TEST_WEATHER_STATS_DEPENDS = UTIL FMT
+$(eval $(call link-program,TestWeatherStats,TEST_WEATHER_STATS))
+
+TEST_STARTUP_TRACE_SOURCES = \
+	$(SRC)/StartupTrace.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestStartupTrace.cpp
+TEST_STARTUP_TRACE_DEPENDS = IO THREAD FMT UTIL
+$(eval $(call link-program,TestStartupTrace,TEST_STARTUP_TRACE))
+
+TEST_RADAR_PARSER_SOURCES = \
+	$(SRC)/Tracking/JETProvider/RadarParser.cpp \
+	$(SRC)/Tracking/JETProvider/Delta.cpp \
+	$(SRC)/Tracking/JETProvider/TrafficTable.cpp \
+	$(SRC)/Tracking/JETProvider/Extrapolate.cpp \
+	$(SRC)/Tracking/JETProvider/Scheduler.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestRadarParser.cpp
+TEST_RADAR_PARSER_DEPENDS = GEO MATH FMT UTIL
+$(eval $(call link-program,TestRadarParser,TEST_RADAR_PARSER))
+
+TEST_MERGED_TRAFFIC_SOURCES = \
+	$(SRC)/Tracking/MergedTraffic.cpp \
+	$(SRC)/FLARM/Id.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestMergedTraffic.cpp
+TEST_MERGED_TRAFFIC_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestMergedTraffic,TEST_MERGED_TRAFFIC))
+
+TEST_TRAFFIC_PROXIMITY_SOURCES = \
+	$(SRC)/Computer/TrafficProximityComputer.cpp \
+	$(SRC)/Tracking/JETProvider/RadarParser.cpp \
+	$(SRC)/Tracking/JETProvider/Delta.cpp \
+	$(SRC)/Tracking/JETProvider/TrafficTable.cpp \
+	$(SRC)/Tracking/JETProvider/Extrapolate.cpp \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTrafficProximity.cpp
+TEST_TRAFFIC_PROXIMITY_DEPENDS = GEO MATH TIME FMT UTIL
+$(eval $(call link-program,TestTrafficProximity,TEST_TRAFFIC_PROXIMITY))
+
 TEST_AIRSPACE_PARSER_SOURCES = \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Units/Descriptor.cpp \
@@ -190,6 +336,36 @@ TEST_AIRSPACE_PARSER_LDADD = $(FAKE_LIBS)
 TEST_AIRSPACE_PARSER_DEPENDS = OPERATION IO OS AIRSPACE ZZIP GEO MATH UTIL
 $(eval $(call link-program,TestAirspaceParser,TEST_AIRSPACE_PARSER))
 
+TEST_AIRSPACES_SYNCHRONISE_SOURCES = \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAirspacesSynchronise.cpp
+TEST_AIRSPACES_SYNCHRONISE_DEPENDS = AIRSPACE GEO MATH UTIL
+$(eval $(call link-program,TestAirspacesSynchronise,TEST_AIRSPACES_SYNCHRONISE))
+
+TEST_AIRSPACE_CACHE_SOURCES = \
+	$(SRC)/Airspace/AirspaceCache.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAirspaceCache.cpp
+TEST_AIRSPACE_CACHE_DEPENDS = AIRSPACE IO GEO MATH UTIL
+$(eval $(call link-program,TestAirspaceCache,TEST_AIRSPACE_CACHE))
+
+TEST_WAYPOINT_CACHE_SOURCES = \
+	$(SRC)/Waypoint/WaypointCache.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWaypointCache.cpp
+TEST_WAYPOINT_CACHE_DEPENDS = WAYPOINT IO GEO MATH UTIL
+$(eval $(call link-program,TestWaypointCache,TEST_WAYPOINT_CACHE))
+
+TEST_AIRSPACE_WARNING_MANAGER_SOURCES = \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAirspaceWarningManager.cpp
+TEST_AIRSPACE_WARNING_MANAGER_DEPENDS = AIRSPACE GLIDE THREAD GEO MATH UTIL
+$(eval $(call link-program,TestAirspaceWarningManager,TEST_AIRSPACE_WARNING_MANAGER))
+
 TEST_DATE_TIME_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestDateTime.cpp
@@ -225,10 +401,11 @@ $(eval $(call link-program,TestWrapClock,TEST_WRAP_CLOCK))
 TEST_PROFILE_SOURCES = \
 	$(SRC)/LocalPath.cpp \
 	$(SRC)/Profile/Profile.cpp \
+	$(SRC)/Profile/SaveThread.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/TestProfile.cpp
-TEST_PROFILE_DEPENDS = PROFILE MATH IO OS UTIL
+TEST_PROFILE_DEPENDS = PROFILE MATH IO OS THREAD UTIL
 $(eval $(call link-program,TestProfile,TEST_PROFILE))
 
 TEST_MAC_CREADY_SOURCES = \
@@ -248,6 +425,46 @@ TEST_ORDERED_TASK_OBJS = $(call SRC_TO_OBJ,$(TEST_ORDERED_TASK_SOURCES))
 TEST_ORDERED_TASK_DEPENDS = TASK ROUTE GLIDE WAYPOINT GEO TIME MATH UTIL
 $(eval $(call link-program,TestOrderedTask,TEST_ORDERED_TASK))
 
+TEST_TASK_DIJKSTRA_MIN_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTaskDijkstraMin.cpp
+TEST_TASK_DIJKSTRA_MIN_DEPENDS = TASK GEO MATH UTIL
+$(eval $(call link-program,TestTaskDijkstraMin,TEST_TASK_DIJKSTRA_MIN))
+
+TEST_TASK_DIJKSTRA_MAX_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTaskDijkstraMax.cpp
+TEST_TASK_DIJKSTRA_MAX_DEPENDS = TASK GEO MATH UTIL
+$(eval $(call link-program,TestTaskDijkstraMax,TEST_TASK_DIJKSTRA_MAX))
+
+TEST_ASTAR_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAStar.cpp
+$(eval $(call link-program,TestAStar,TEST_ASTAR))
+
+TEST_REACH_FAN_SOURCES = \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Engine/GlideSolvers/GlideSettings.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestReachFan.cpp
+TEST_REACH_FAN_DEPENDS = ROUTE AIRSPACE TERRAIN OPERATION IO ZZIP OS THREAD GLIDE GEO MATH UTIL
+$(eval $(call link-program,TestReachFan,TEST_REACH_FAN))
+
+TEST_ROUTE_POLAR_CACHE_SOURCES = \
+	$(SRC)/Engine/GlideSolvers/GlideSettings.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestRoutePolarCache.cpp
+TEST_ROUTE_POLAR_CACHE_DEPENDS = ROUTE GLIDE GEO MATH UTIL
+$(eval $(call link-program,TestRoutePolarCache,TEST_ROUTE_POLAR_CACHE))
+
+TEST_ROUTE_REPAIR_SOURCES = \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Engine/GlideSolvers/GlideSettings.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestRouteRepair.cpp
+TEST_ROUTE_REPAIR_DEPENDS = ROUTE AIRSPACE TERRAIN OPERATION IO ZZIP OS THREAD GLIDE GEO MATH UTIL
+$(eval $(call link-program,TestRouteRepair,TEST_ROUTE_REPAIR))
+
 TEST_AAT_POINT_SOURCES = \
 	$(SRC)/Engine/Util/Gradient.cpp \
 	$(SRC)/Engine/Navigation/Aircraft.cpp \
@@ -395,17 +612,69 @@ TEST_FLARM_NET_SOURCES = \
 	$(SRC)/FLARM/Id.cpp \
 	$(SRC)/FLARM/FlarmNetRecord.cpp \
 	$(SRC)/FLARM/FlarmNetDatabase.cpp \
+	$(SRC)/FLARM/FlarmNetCache.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestFlarmNet.cpp
 TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL
 $(eval $(call link-program,TestFlarmNet,TEST_FLARM_NET))
 
+TEST_FLARM_NAME_CACHE_SOURCES = \
+	$(SRC)/FLARM/NameCache.cpp \
+	$(SRC)/FLARM/Details.cpp \
+	$(SRC)/FLARM/Global.cpp \
+	$(SRC)/FLARM/TrafficDatabases.cpp \
+	$(SRC)/FLARM/NameDatabase.cpp \
+	$(SRC)/FLARM/FlarmNetDatabase.cpp \
+	$(SRC)/FLARM/FlarmNetRecord.cpp \
+	$(SRC)/FLARM/Id.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlarmNameCache.cpp
+TEST_FLARM_NAME_CACHE_DEPENDS = IO OS UTIL
+$(eval $(call link-program,TestFlarmNameCache,TEST_FLARM_NAME_CACHE))
+
+TEST_TRAFFIC_LIST_SOURCES = \
+	$(SRC)/FLARM/Id.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTrafficList.cpp
+TEST_TRAFFIC_LIST_DEPENDS = MATH UTIL
+$(eval $(call link-program,TestTrafficList,TEST_TRAFFIC_LIST))
+
+TEST_FLARM_CALCULATIONS_SOURCES = \
+	$(SRC)/FLARM/Calculations.cpp \
+	$(SRC)/Computer/ClimbAverageCalculator.cpp \
+	$(SRC)/FLARM/Id.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlarmCalculations.cpp
+TEST_FLARM_CALCULATIONS_DEPENDS = MATH UTIL
+$(eval $(call link-program,TestFlarmCalculations,TEST_FLARM_CALCULATIONS))
+
+TEST_FLARM_THREAT_SOURCES = \
+	$(SRC)/FLARM/Threat.cpp \
+	$(SRC)/FLARM/Id.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlarmThreat.cpp
+TEST_FLARM_THREAT_DEPENDS = MATH UTIL
+$(eval $(call link-program,TestFlarmThreat,TEST_FLARM_THREAT))
+
+TEST_FADING_TRAFFIC_LIST_SOURCES = \
+	$(SRC)/FLARM/Id.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFadingTrafficList.cpp
+TEST_FADING_TRAFFIC_LIST_DEPENDS = MATH UTIL
+$(eval $(call link-program,TestFadingTrafficList,TEST_FADING_TRAFFIC_LIST))
+
 TEST_GEO_CLIP_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoClip.cpp
 TEST_GEO_CLIP_DEPENDS = GEO MATH
 $(eval $(call link-program,TestGeoClip,TEST_GEO_CLIP))
 
+TEST_POLYGON_BAND_INDEX_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestPolygonBandIndex.cpp
+TEST_POLYGON_BAND_INDEX_DEPENDS = GEO MATH
+$(eval $(call link-program,TestPolygonBandIndex,TEST_POLYGON_BAND_INDEX))
+
 TEST_CLIMB_AV_CALC_SOURCES = \
 	$(SRC)/Computer/ClimbAverageCalculator.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -491,6 +760,77 @@ TEST_NMEA_FORMATTER_SOURCES = \
 TEST_NMEA_FORMATTER_DEPENDS = LIBNMEA GEO MATH IO UTIL TIME
 $(eval $(call link-program,TestNMEAFormatter,TEST_NMEA_FORMATTER))
 
+TEST_NMEA_SENTENCE_TABLE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestNMEASentenceTable.cpp
+TEST_NMEA_SENTENCE_TABLE_DEPENDS =
+$(eval $(call link-program,TestNMEASentenceTable,TEST_NMEA_SENTENCE_TABLE))
+
+TEST_LINE_SPLITTER_SOURCES = \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLineSplitter.cpp
+TEST_LINE_SPLITTER_DEPENDS = UTIL
+$(eval $(call link-program,TestLineSplitter,TEST_LINE_SPLITTER))
+
+TEST_SENSOR_FRAME_SOURCES = \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/Device/Util/SensorFrame.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSensorFrame.cpp
+TEST_SENSOR_FRAME_DEPENDS = LIBNMEA GEO MATH UTIL TIME
+$(eval $(call link-program,TestSensorFrame,TEST_SENSOR_FRAME))
+
+TEST_PROFILER_SOURCES = \
+	$(SRC)/Profiler.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestProfiler.cpp
+TEST_PROFILER_DEPENDS = FMT UTIL
+$(eval $(call link-program,TestProfiler,TEST_PROFILER))
+
+TEST_WAYPOINT_LABEL_LIST_SOURCES = \
+	$(SRC)/Renderer/WaypointLabelList.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWaypointLabelList.cpp
+TEST_WAYPOINT_LABEL_LIST_DEPENDS = UTIL
+$(eval $(call link-program,TestWaypointLabelList,TEST_WAYPOINT_LABEL_LIST))
+
+TEST_FRAME_PACER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFramePacer.cpp
+$(eval $(call link-program,TestFramePacer,TEST_FRAME_PACER))
+
+TEST_DAMAGE_SOURCES = \
+	$(SRC)/ui/canvas/memory/Damage.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestDamage.cpp
+$(eval $(call link-program,TestDamage,TEST_DAMAGE))
+
+TEST_PIXEL_OPERATIONS_SOURCES = \
+	$(SRC)/ui/canvas/memory/Dither.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestPixelOperations.cpp
+$(eval $(call link-program,TestPixelOperations,TEST_PIXEL_OPERATIONS))
+
+TEST_SCALE_IMAGE_SOURCES = \
+	$(SRC)/ui/canvas/custom/ScaleImage.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestScaleImage.cpp
+$(eval $(call link-program,TestScaleImage,TEST_SCALE_IMAGE))
+
+TEST_SKYSIGHT_COLOR_RAMP_SOURCES = \
+	$(SRC)/Weather/Skysight/ColorRamp.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSkysightColorRamp.cpp
+$(eval $(call link-program,TestSkysightColorRamp,TEST_SKYSIGHT_COLOR_RAMP))
+
+TEST_SKYSIGHT_FRAME_INDEX_SOURCES = \
+	$(SRC)/Weather/Skysight/FrameIndex.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSkysightFrameIndex.cpp
+$(eval $(call link-program,TestSkysightFrameIndex,TEST_SKYSIGHT_FRAME_INDEX))
+
 TEST_STRINGS_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestStrings.cpp
@@ -521,6 +861,7 @@ $(eval $(call link-program,TestPolars,TEST_POLARS))
 TEST_GLIDE_POLAR_SOURCES = \
 	$(ENGINE_SRC_DIR)/GlideSolvers/GlidePolar.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/GlideResult.cpp \
+	$(ENGINE_SRC_DIR)/GlideSolvers/GlideSettings.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/GlideState.cpp \
 	$(ENGINE_SRC_DIR)/GlideSolvers/MacCready.cpp \
 	$(SRC)/Units/Descriptor.cpp \
@@ -576,6 +917,13 @@ TEST_THERMALBASE_SOURCES = \
 TEST_THERMALBASE_DEPENDS = GEO MATH THREAD
 $(eval $(call link-program,TestThermalBase,TEST_THERMALBASE))
 
+TEST_THERMAL_HISTORY_SOURCES = \
+	$(SRC)/Computer/ThermalHistory.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestThermalHistory.cpp
+TEST_THERMAL_HISTORY_DEPENDS = GEO MATH
+$(eval $(call link-program,TestThermalHistory,TEST_THERMAL_HISTORY))
+
 TEST_EARTH_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestEarth.cpp
@@ -613,12 +961,194 @@ TEST_ALLOCATED_GRID_SOURCES = \
 TEST_ALLOCATED_GRID_DEPENDS = UTIL
 $(eval $(call link-program,TestAllocatedGrid,TEST_ALLOCATED_GRID))
 
+TEST_RASTER_TILE_FILE_SOURCES = \
+	$(SRC)/Terrain/RasterTileFile.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestRasterTileFile.cpp
+TEST_RASTER_TILE_FILE_DEPENDS = IO OS UTIL
+$(eval $(call link-program,TestRasterTileFile,TEST_RASTER_TILE_FILE))
+
+TEST_TOPOGRAPHY_PACKAGE_SOURCES = \
+	$(SRC)/Topography/TopographyPackage.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTopographyPackage.cpp
+TEST_TOPOGRAPHY_PACKAGE_DEPENDS = GEO MATH IO OS UTIL
+$(eval $(call link-program,TestTopographyPackage,TEST_TOPOGRAPHY_PACKAGE))
+
+TEST_SHAPE_BUFFER_ALLOCATOR_SOURCES = \
+	$(SRC)/Topography/ShapeBufferAllocator.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestShapeBufferAllocator.cpp
+$(eval $(call link-program,TestShapeBufferAllocator,TEST_SHAPE_BUFFER_ALLOCATOR))
+
+TEST_SHAPE_INDEX_SOURCES = \
+	$(SRC)/Topography/ShapeIndex.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestShapeIndex.cpp
+$(eval $(call link-program,TestShapeIndex,TEST_SHAPE_INDEX))
+
+TEST_THREAD_POOL_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestThreadPool.cpp
+TEST_THREAD_POOL_DEPENDS = THREAD
+$(eval $(call link-program,TestThreadPool,TEST_THREAD_POOL))
+
+TEST_TASK_GRAPH_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTaskGraph.cpp
+TEST_TASK_GRAPH_DEPENDS = THREAD
+$(eval $(call link-program,TestTaskGraph,TEST_TASK_GRAPH))
+
+TEST_JOB_POOL_SOURCES = \
+	$(SRC)/Job/Pool.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestJobPool.cpp
+TEST_JOB_POOL_DEPENDS = OPERATION THREAD UTIL
+$(eval $(call link-program,TestJobPool,TEST_JOB_POOL))
+
+TEST_PARALLEL_OPERATION_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestParallelOperation.cpp
+TEST_PARALLEL_OPERATION_DEPENDS = OPERATION THREAD UTIL
+$(eval $(call link-program,TestParallelOperation,TEST_PARALLEL_OPERATION))
+
+TEST_LOCK_FREE_FIFO_BUFFER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLockFreeFifoBuffer.cpp
+TEST_LOCK_FREE_FIFO_BUFFER_DEPENDS = THREAD
+$(eval $(call link-program,TestLockFreeFifoBuffer,TEST_LOCK_FREE_FIFO_BUFFER))
+
+TEST_TRIPLE_BUFFER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTripleBuffer.cpp
+TEST_TRIPLE_BUFFER_DEPENDS = THREAD
+$(eval $(call link-program,TestTripleBuffer,TEST_TRIPLE_BUFFER))
+
+TEST_CONTEST_MANAGER_SOURCES = \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestContestManager.cpp
+TEST_CONTEST_MANAGER_DEPENDS = CONTEST THREAD GEO MATH TIME UTIL
+$(eval $(call link-program,TestContestManager,TEST_CONTEST_MANAGER))
+
+TEST_CONTEST_CHECKPOINT_SOURCES = \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Computer/ContestCheckpoint.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestContestCheckpoint.cpp
+TEST_CONTEST_CHECKPOINT_DEPENDS = CONTEST IO GEO MATH TIME UTIL
+$(eval $(call link-program,TestContestCheckpoint,TEST_CONTEST_CHECKPOINT))
+
+TEST_RETROSPECTIVE_SOURCES = \
+	$(SRC)/Engine/Contest/Solvers/Retrospective.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestRetrospective.cpp
+TEST_RETROSPECTIVE_DEPENDS = WAYPOINT GEO MATH UTIL
+$(eval $(call link-program,TestRetrospective,TEST_RETROSPECTIVE))
+
+TEST_TRACE_SNAPSHOT_SOURCES = \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Contest/Solvers/TraceSnapshot.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTraceSnapshot.cpp
+TEST_TRACE_SNAPSHOT_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestTraceSnapshot,TEST_TRACE_SNAPSHOT))
+
+TEST_TRACE_COMPUTER_SOURCES = \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Computer/TraceComputer.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTraceComputer.cpp
+TEST_TRACE_COMPUTER_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestTraceComputer,TEST_TRACE_COMPUTER))
+
+TEST_TERRAIN_PREFETCH_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTerrainPrefetch.cpp
+TEST_TERRAIN_PREFETCH_DEPENDS = TERRAIN IO OS GEO MATH UTIL
+$(eval $(call link-program,TestTerrainPrefetch,TEST_TERRAIN_PREFETCH))
+
+TEST_SLOPE_SHADING_SOURCES = \
+	$(SRC)/Terrain/SlopeShading.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSlopeShading.cpp
+TEST_SLOPE_SHADING_DEPENDS =
+$(eval $(call link-program,TestSlopeShading,TEST_SLOPE_SHADING))
+
+TEST_GROUND_INTERSECTIONS_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestGroundIntersections.cpp
+TEST_GROUND_INTERSECTIONS_DEPENDS = TERRAIN IO OS GEO MATH UTIL
+$(eval $(call link-program,TestGroundIntersections,TEST_GROUND_INTERSECTIONS))
+
+TEST_TERRAIN_TILES_CACHE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTerrainTilesCache.cpp
+TEST_TERRAIN_TILES_CACHE_DEPENDS = TERRAIN IO OS GEO MATH UTIL
+$(eval $(call link-program,TestTerrainTilesCache,TEST_TERRAIN_TILES_CACHE))
+
 TEST_RADIX_TREE_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestRadixTree.cpp
 TEST_RADIX_TREE_DEPENDS = UTIL
 $(eval $(call link-program,TestRadixTree,TEST_RADIX_TREE))
 
+TEST_ARENA_ALLOCATOR_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestArenaAllocator.cpp
+TEST_ARENA_ALLOCATOR_DEPENDS = UTIL
+$(eval $(call link-program,TestArenaAllocator,TEST_ARENA_ALLOCATOR))
+
+TEST_QUAD_TREE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestQuadTree.cpp
+TEST_QUAD_TREE_DEPENDS = UTIL
+$(eval $(call link-program,TestQuadTree,TEST_QUAD_TREE))
+
+TEST_MAPPED_LINE_READER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestMappedLineReader.cpp
+TEST_MAPPED_LINE_READER_DEPENDS = IO OS UTIL
+$(eval $(call link-program,TestMappedLineReader,TEST_MAPPED_LINE_READER))
+
+TEST_ASYNC_FILE_WRITER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAsyncFileWriter.cpp
+TEST_ASYNC_FILE_WRITER_DEPENDS = IO OS THREAD UTIL
+$(eval $(call link-program,TestAsyncFileWriter,TEST_ASYNC_FILE_WRITER))
+
+TEST_URING_READ_STREAM_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestUringReadStream.cpp
+TEST_URING_READ_STREAM_DEPENDS = ASYNC IO OS THREAD UTIL
+$(eval $(call link-program,TestUringReadStream,TEST_URING_READ_STREAM))
+
+TEST_COMPRESSED_NMEA_SOURCES = \
+	$(SRC)/Logger/CompressedNMEA.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestCompressedNMEA.cpp
+TEST_COMPRESSED_NMEA_DEPENDS = IO OS UTIL
+$(eval $(call link-program,TestCompressedNMEA,TEST_COMPRESSED_NMEA))
+
+TEST_FLIGHT_INDEX_SOURCES = \
+	$(SRC)/Logger/FlightIndex.cpp \
+	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/FlightInfo.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlightIndex.cpp
+TEST_FLIGHT_INDEX_DEPENDS = IO OS TIME UTIL
+$(eval $(call link-program,TestFlightIndex,TEST_FLIGHT_INDEX))
+
+TEST_ZIP_ARCHIVE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestZipArchive.cpp
+TEST_ZIP_ARCHIVE_DEPENDS = IO OS ZZIP ZLIB UTIL
+$(eval $(call link-program,TestZipArchive,TEST_ZIP_ARCHIVE))
+
 TEST_LOGGER_SOURCES = \
 	$(SRC)/IGC/IGCFix.cpp \
 	$(SRC)/IGC/IGCWriter.cpp \
@@ -730,6 +1260,12 @@ DEBUG_PROGRAM_NAMES = \
 	FlightTable \
 	BenchmarkProjection \
 	BenchmarkFAITriangleSector \
+	BenchmarkRadarParser \
+	BenchmarkIGCParser \
+	BenchmarkGlideComputer \
+	BenchmarkFlarmTraffic \
+	BenchmarkPixelOperations \
+	BenchmarkTask \
 	DumpTextFile DumpTextZip DumpTextInflate \
 	DumpHexColor \
 	RunXMLParser \
@@ -737,7 +1273,7 @@ DEBUG_PROGRAM_NAMES = \
 	RunMD5 RunSHA256 \
 	ReadGRecord VerifyGRecord AppendGRecord FixGRecord \
 	AddChecksum \
-	LoadTopography LoadTerrain \
+	LoadTopography ConvertTopography LoadTerrain ConvertTerrainTiles \
 	RunHeightMatrix \
 	RunInputParser \
 	RunWaypointParser RunAirspaceParser \
@@ -772,6 +1308,10 @@ DEBUG_PROGRAM_NAMES += \
 	RunExternalWind \
 	RunTask \
 	LoadImage ViewImage \
+	BenchmarkTopography \
+	BenchmarkAirspace \
+	BenchmarkRoute \
+	BenchmarkContest \
 	RunCanvas \
 	RunListControl \
 	RunTextEntry RunNumberEntry RunDateEntry RunTimeEntry RunAngleEntry \
@@ -801,6 +1341,8 @@ endif
 ifeq ($(TARGET),UNIX)
 DEBUG_PROGRAM_NAMES += \
 	AnalyseFlight \
+	AnalyseFlights \
+	RunBatchReplay \
 	FeedFlyNetData
 endif
 
@@ -875,6 +1417,7 @@ DEBUG_REPLAY_SOURCES = \
 	$(SRC)/Engine/Task/Stats/TaskStats.cpp \
 	$(SRC)/Engine/Task/Stats/CommonStats.cpp \
 	$(SRC)/Engine/Task/Stats/ElementStat.cpp \
+	$(SRC)/Logger/CompressedNMEA.cpp \
 	$(TEST_SRC_DIR)/FakeMessage.cpp \
 	$(TEST_SRC_DIR)/FakeLanguage.cpp \
 	$(TEST_SRC_DIR)/FakeGeoid.cpp \
@@ -890,6 +1433,23 @@ BENCHMARK_PROJECTION_DEPENDS = MATH
 BENCHMARK_PROJECTION_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,BenchmarkProjection,BENCHMARK_PROJECTION))
 
+BENCHMARK_TOPOGRAPHY_SOURCES = \
+	$(MORE_SCREEN_SOURCES) \
+	$(SRC)/Compatibility/fmode.c \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Renderer/LabelBlock.cpp \
+	$(SRC)/Renderer/TransparentRendererCache.cpp \
+	$(SRC)/Look/TopographyLook.cpp \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/Fonts.cpp \
+	$(TEST_SRC_DIR)/FakeAsset.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTopography.cpp
+BENCHMARK_TOPOGRAPHY_LDADD = $(FAKE_LIBS)
+BENCHMARK_TOPOGRAPHY_DEPENDS = TOPO SCREEN RESOURCE EVENT OPERATION ASYNC OS IO THREAD GEO MATH ZZIP UTIL
+$(eval $(call link-program,BenchmarkTopography,BENCHMARK_TOPOGRAPHY))
+
 BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleSettings.cpp \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleArea.cpp \
@@ -897,6 +1457,79 @@ BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 BENCHMARK_FAI_TRIANGLE_SECTOR_DEPENDS = GEO MATH
 $(eval $(call link-program,BenchmarkFAITriangleSector,BENCHMARK_FAI_TRIANGLE_SECTOR))
 
+BENCHMARK_RADAR_PARSER_SOURCES = \
+	$(SRC)/Tracking/JETProvider/RadarParser.cpp \
+	$(SRC)/Tracking/JETProvider/Delta.cpp \
+	$(SRC)/Tracking/JETProvider/TrafficTable.cpp \
+	$(SRC)/Tracking/JETProvider/Extrapolate.cpp \
+	$(SRC)/Tracking/JETProvider/Scheduler.cpp \
+	$(SRC)/Tracking/MergedTraffic.cpp \
+	$(SRC)/FLARM/Id.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkRadarParser.cpp
+BENCHMARK_RADAR_PARSER_DEPENDS = IO OS GEO MATH FMT UTIL
+$(eval $(call link-program,BenchmarkRadarParser,BENCHMARK_RADAR_PARSER))
+
+BENCHMARK_IGC_PARSER_SOURCES = \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(TEST_SRC_DIR)/BenchmarkIGCParser.cpp
+BENCHMARK_IGC_PARSER_DEPENDS = IO OS GEO MATH UTIL
+$(eval $(call link-program,BenchmarkIGCParser,BENCHMARK_IGC_PARSER))
+
+BENCHMARK_FLARM_TRAFFIC_SOURCES = \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/Device/Driver/FLARM/StaticParser.cpp \
+	$(SRC)/FLARM/Computer.cpp \
+	$(SRC)/FLARM/Threat.cpp \
+	$(SRC)/FLARM/Calculations.cpp \
+	$(SRC)/FLARM/NameCache.cpp \
+	$(SRC)/FLARM/Details.cpp \
+	$(SRC)/FLARM/Global.cpp \
+	$(SRC)/FLARM/TrafficDatabases.cpp \
+	$(SRC)/FLARM/NameDatabase.cpp \
+	$(SRC)/FLARM/FlarmNetDatabase.cpp \
+	$(SRC)/FLARM/FlarmNetRecord.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/Id.cpp \
+	$(SRC)/Computer/ClimbAverageCalculator.cpp \
+	$(SRC)/Tracking/MergedTraffic.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/BenchmarkFlarmTraffic.cpp
+BENCHMARK_FLARM_TRAFFIC_DEPENDS = LIBNMEA GEO MATH IO OS UTIL TIME
+$(eval $(call link-program,BenchmarkFlarmTraffic,BENCHMARK_FLARM_TRAFFIC))
+
+BENCHMARK_PIXEL_OPERATIONS_SOURCES = \
+	$(SRC)/ui/canvas/memory/Dither.cpp \
+	$(TEST_SRC_DIR)/BenchmarkPixelOperations.cpp
+BENCHMARK_PIXEL_OPERATIONS_DEPENDS = UTIL
+$(eval $(call link-program,BenchmarkPixelOperations,BENCHMARK_PIXEL_OPERATIONS))
+
+BENCHMARK_AIRSPACE_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/BenchmarkAirspace.cpp
+BENCHMARK_AIRSPACE_LDADD = $(FAKE_LIBS)
+BENCHMARK_AIRSPACE_DEPENDS = $(DEBUG_REPLAY_DEPENDS) AIRSPACE OPERATION ZZIP GEO MATH UTIL
+$(eval $(call link-program,BenchmarkAirspace,BENCHMARK_AIRSPACE))
+
+BENCHMARK_ROUTE_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(ENGINE_SRC_DIR)/GlideSolvers/GlideSettings.cpp \
+	$(TEST_SRC_DIR)/BenchmarkRoute.cpp
+BENCHMARK_ROUTE_DEPENDS = ROUTE AIRSPACE TERRAIN OPERATION $(DEBUG_REPLAY_DEPENDS) ZZIP GLIDE GEO MATH UTIL
+$(eval $(call link-program,BenchmarkRoute,BENCHMARK_ROUTE))
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_DEPENDS = IO OS ZZIP UTIL
@@ -979,6 +1612,8 @@ RUN_NOAA_DOWNLOADER_SOURCES = \
 	$(SRC)/Weather/NOAADownloader.cpp \
 	$(SRC)/Weather/NOAAStore.cpp \
 	$(SRC)/Weather/NOAAUpdater.cpp \
+	$(SRC)/Weather/NOAABatch.cpp \
+	$(SRC)/Weather/Stats.cpp \
 	$(SRC)/Weather/METARParser.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
 	$(SRC)/Formatter/GeoPointFormatter.cpp \
@@ -1004,6 +1639,7 @@ RUN_SL_TRACKING_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/net/SocketError.cxx \
 	$(SRC)/Tracking/SkyLines/Client.cpp \
+	$(SRC)/Tracking/SkyLines/Batch.cpp \
 	$(SRC)/Tracking/SkyLines/Assemble.cpp \
 	$(SRC)/Formatter/NMEAFormatter.cpp \
 	$(SRC)/TransponderCode.cpp \
@@ -1048,6 +1684,7 @@ $(eval $(call link-program,ReadMO,READ_MO))
 READ_PROFILE_STRING_SOURCES = \
 	$(SRC)/LocalPath.cpp \
 	$(SRC)/Profile/Profile.cpp \
+	$(SRC)/Profile/SaveThread.cpp \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/ReadProfileString.cpp
 READ_PROFILE_STRING_DEPENDS = PROFILE IO OS UTIL
@@ -1056,6 +1693,7 @@ $(eval $(call link-program,ReadProfileString,READ_PROFILE_STRING))
 READ_PROFILE_INT_SOURCES = \
 	$(SRC)/LocalPath.cpp \
 	$(SRC)/Profile/Profile.cpp \
+	$(SRC)/Profile/SaveThread.cpp \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/ReadProfileInt.cpp
 READ_PROFILE_INT_DEPENDS = PROFILE IO OS UTIL
@@ -1131,6 +1769,20 @@ LOAD_TOPOGRAPHY_DEPENDS = OPERATION TOPO RESOURCE GEO MATH THREAD IO SYSTEM UTIL
 LOAD_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,LoadTopography,LOAD_TOPOGRAPHY))
 
+CONVERT_TOPOGRAPHY_SOURCES = \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/system/Path.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/ConvertTopography.cpp
+ifeq ($(OPENGL),y)
+CONVERT_TOPOGRAPHY_SOURCES += \
+	$(CANVAS_SRC_DIR)/opengl/Triangulate.cpp
+endif
+CONVERT_TOPOGRAPHY_DEPENDS = TOPO RESOURCE GEO MATH THREAD IO SYSTEM UTIL ZZIP
+CONVERT_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,ConvertTopography,CONVERT_TOPOGRAPHY))
+
 LOAD_TERRAIN_SOURCES = \
 	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
 	$(TEST_SRC_DIR)/LoadTerrain.cpp
@@ -1138,6 +1790,13 @@ LOAD_TERRAIN_CPPFLAGS = $(SCREEN_CPPFLAGS)
 LOAD_TERRAIN_DEPENDS = TERRAIN OPERATION GEO MATH OS IO ZZIP UTIL
 $(eval $(call link-program,LoadTerrain,LOAD_TERRAIN))
 
+CONVERT_TERRAIN_TILES_SOURCES = \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/ConvertTerrainTiles.cpp
+CONVERT_TERRAIN_TILES_CPPFLAGS = $(SCREEN_CPPFLAGS)
+CONVERT_TERRAIN_TILES_DEPENDS = TERRAIN OPERATION GEO MATH OS IO ZZIP UTIL
+$(eval $(call link-program,ConvertTerrainTiles,CONVERT_TERRAIN_TILES))
+
 RUN_HEIGHT_MATRIX_SOURCES = \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Projection/WindowProjection.cpp \
@@ -1500,6 +2159,9 @@ RUN_FLIGHT_LOGGER_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/Computer/CirclingComputer.cpp \
 	$(SRC)/Logger/FlightLogger.cpp \
+	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/Logger/FlightIndex.cpp \
+	$(SRC)/FlightInfo.cpp \
 	$(SRC)/TransponderCode.cpp \
 	$(SRC)/Formatter/NMEAFormatter.cpp \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
@@ -1610,6 +2272,18 @@ RUN_CONTEST_SOURCES = \
 RUN_CONTEST_DEPENDS = $(DEBUG_REPLAY_DEPENDS) CONTEST UTIL GEO MATH TIME
 $(eval $(call link-program,RunContestAnalysis,RUN_CONTEST))
 
+BENCHMARK_CONTEST_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(SRC)/Formatter/NMEAFormatter.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Point.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Trace.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/BenchmarkContest.cpp
+BENCHMARK_CONTEST_DEPENDS = $(DEBUG_REPLAY_DEPENDS) CONTEST UTIL GEO MATH TIME
+$(eval $(call link-program,BenchmarkContest,BENCHMARK_CONTEST))
+
 RUN_WAVE_COMPUTER_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/Computer/WaveComputer.cpp \
@@ -1641,10 +2315,65 @@ ANALYSE_FLIGHT_SOURCES = \
 	$(TEST_SRC_DIR)/ContestPrinting.cpp \
 	$(TEST_SRC_DIR)/FlightPhaseJSON.cpp \
 	$(TEST_SRC_DIR)/FlightPhaseDetector.cpp \
+	$(TEST_SRC_DIR)/FlightAnalysis.cpp \
 	$(TEST_SRC_DIR)/AnalyseFlight.cpp
 ANALYSE_FLIGHT_DEPENDS = $(DEBUG_REPLAY_DEPENDS) CONTEST JSON UTIL GEO MATH TIME
 $(eval $(call link-program,AnalyseFlight,ANALYSE_FLIGHT))
 
+ANALYSE_FLIGHTS_SOURCES = \
+	$(filter-out $(TEST_SRC_DIR)/AnalyseFlight.cpp,$(ANALYSE_FLIGHT_SOURCES)) \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(TEST_SRC_DIR)/AnalyseFlights.cpp
+ANALYSE_FLIGHTS_DEPENDS = \
+	$(DEBUG_REPLAY_DEPENDS) \
+	CONTEST TASKFILE ROUTE GLIDE WAYPOINT JSON \
+	IO OS THREAD UTIL GEO MATH TIME
+$(eval $(call link-program,AnalyseFlights,ANALYSE_FLIGHTS))
+
+RUN_BATCH_REPLAY_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(ENGINE_SRC_DIR)/ThermalBand/ThermalBand.cpp \
+	$(ENGINE_SRC_DIR)/ThermalBand/ThermalSlice.cpp \
+	$(ENGINE_SRC_DIR)/ThermalBand/ThermalEncounterBand.cpp \
+	$(ENGINE_SRC_DIR)/ThermalBand/ThermalEncounterCollection.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/ProtectedRoutePlanner.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/Formatter/TimeFormatter.cpp \
+	$(SRC)/Engine/Navigation/TraceHistory.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/Logger/Settings.cpp \
+	$(SRC)/TeamCode/TeamCode.cpp \
+	$(SRC)/TeamCode/Settings.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(SRC)/TransponderCode.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/RunBatchReplay.cpp
+RUN_BATCH_REPLAY_DEPENDS = \
+	$(DEBUG_REPLAY_DEPENDS) \
+	LIBCOMPUTER LIBNMEA \
+	CONTEST TASKFILE ROUTE GLIDE WAYPOINT AIRSPACE JSON \
+	IO OS THREAD UTIL GEO MATH TIME
+$(eval $(call link-program,RunBatchReplay,RUN_BATCH_REPLAY))
+
+BENCHMARK_GLIDE_COMPUTER_SOURCES = \
+	$(filter-out $(TEST_SRC_DIR)/RunBatchReplay.cpp,$(RUN_BATCH_REPLAY_SOURCES)) \
+	$(TEST_SRC_DIR)/BenchmarkGlideComputer.cpp
+BENCHMARK_GLIDE_COMPUTER_DEPENDS = $(RUN_BATCH_REPLAY_DEPENDS)
+$(eval $(call link-program,BenchmarkGlideComputer,BENCHMARK_GLIDE_COMPUTER))
+
 FLIGHT_PATH_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/TransponderCode.cpp \
@@ -1714,6 +2443,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/Renderer/GeoBitmapRenderer.cpp \
 	$(SRC)/Renderer/TransparentRendererCache.cpp \
+	$(SRC)/Renderer/OpaqueRendererCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
 	$(SRC)/Renderer/BackgroundRenderer.cpp \
 	$(SRC)/LocalPath.cpp \
@@ -1722,6 +2452,8 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Projection/CompareProjection.cpp \
 	$(SRC)/Weather/Rasp/RaspStore.cpp \
 	$(SRC)/Weather/Rasp/RaspCache.cpp \
+	$(SRC)/Weather/SampleGrid.cpp \
+	$(SRC)/Weather/Stats.cpp \
 	$(SRC)/Weather/Rasp/RaspRenderer.cpp \
 	$(SRC)/Weather/Rasp/RaspStyle.cpp \
 	$(SRC)/Renderer/FAITriangleAreaRenderer.cpp \
@@ -1731,6 +2463,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
+	$(SRC)/Renderer/AirspaceMeshCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
 	$(SRC)/Renderer/AirspaceLabelList.cpp \
 	$(SRC)/Renderer/AirspaceLabelRenderer.cpp \
@@ -1777,6 +2510,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Formatter/AirspaceUserUnitsFormatter.cpp \
 	$(SRC)/Formatter/HexColor.cpp \
 	$(SRC)/Profile/Profile.cpp \
+	$(SRC)/Profile/SaveThread.cpp \
 	$(SRC)/Profile/ComputerProfile.cpp \
 	$(SRC)/Profile/TaskProfile.cpp \
 	$(SRC)/Profile/RouteProfile.cpp \
@@ -1793,6 +2527,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Waypoint/LastUsed.cpp \
 	$(SRC)/Waypoint/WaypointFileType.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
@@ -2151,6 +2886,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Renderer/GeoBitmapRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
+	$(SRC)/Renderer/AirspaceMeshCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
 	$(SRC)/Renderer/TransparentRendererCache.cpp \
 	$(SRC)/Renderer/GradientRenderer.cpp \
@@ -2174,6 +2910,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/LocalPath.cpp \
 	$(MORE_SCREEN_SOURCES) \
 	$(SRC)/Profile/Profile.cpp \
+	$(SRC)/Profile/SaveThread.cpp \
 	$(SRC)/Dialogs/WidgetDialog.cpp \
 	$(SRC)/Dialogs/dlgAnalysis.cpp \
 	$(SRC)/Dialogs/DialogSettings.cpp \
@@ -2215,6 +2952,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Airspace/AirspaceGlue.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
@@ -2361,6 +3099,7 @@ RUN_TASK_EDITOR_DIALOG_SOURCES = \
 	$(SRC)/Formatter/Units.cpp \
 	$(SRC)/Waypoint/WaypointFileType.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
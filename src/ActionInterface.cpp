@@ -48,10 +48,14 @@ XCSoarInterface::ReceiveGPS() noexcept
 void
 XCSoarInterface::ReceiveCalculated() noexcept
 {
+  /* the snapshot is owned by this thread until the next
+     AcquireCalculated() call, so it can be copied without holding
+     the DeviceBlackboard mutex */
+  if (const DerivedInfo *calculated = device_blackboard->AcquireCalculated())
+    ReadBlackboardCalculated(*calculated);
+
   {
     const std::lock_guard lock{device_blackboard->mutex};
-
-    ReadBlackboardCalculated(device_blackboard->Calculated());
     device_blackboard->ReadComputerSettings(GetComputerSettings());
   }
 
@@ -161,7 +165,7 @@ ActionInterface::SetMacCready(double mc, bool to_devices) noexcept
 
   /* update InfoBoxes (that might show the MacCready setting) */
 
-  InfoBoxManager::SetDirty();
+  InfoBoxManager::SetDirty(InfoBoxContent::DEPENDS_SETTINGS);
 
   /* send to calculation thread and trigger recalculation */
 
@@ -273,9 +277,9 @@ ActionInterface::UpdateDisplayMode() noexcept
 void
 ActionInterface::SendUIState() noexcept
 {
-  /* force-update all InfoBoxes just in case the display mode has
-     changed */
-  InfoBoxManager::SetDirty();
+  /* update the InfoBoxes which depend on the display mode, just in
+     case it has changed */
+  InfoBoxManager::SetDirty(InfoBoxContent::DEPENDS_UI_STATE);
   InfoBoxManager::ProcessTimer();
 
   main_window->SetUIState(GetUIState());
@@ -300,7 +304,7 @@ ActionInterface::SetActiveFrequency(const RadioFrequency freq,
 
   /* update InfoBoxes (that might show the ActiveFrequency setting) */
 
-  InfoBoxManager::SetDirty();
+  InfoBoxManager::SetDirty(InfoBoxContent::DEPENDS_SETTINGS);
 
   /* send to external devices */
 
@@ -329,7 +333,7 @@ ActionInterface::SetStandbyFrequency(const RadioFrequency freq,
 
   /* update InfoBoxes (that might show the ActiveFrequency setting) */
 
-  InfoBoxManager::SetDirty();
+  InfoBoxManager::SetDirty(InfoBoxContent::DEPENDS_SETTINGS);
 
   /* send to external devices */
 
@@ -389,7 +393,7 @@ ActionInterface::SetTransponderCode(TransponderCode code, bool to_devices) noexc
   SetComputerSettings().transponder.transponder_code = code;
 
   /* update InfoBoxes (that might show the code setting) */
-  InfoBoxManager::SetDirty();
+  InfoBoxManager::SetDirty(InfoBoxContent::DEPENDS_SETTINGS);
 
   /* send to external devices */
   if (to_devices) {
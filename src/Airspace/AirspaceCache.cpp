@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "AirspaceCache.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "io/BufferedOutputStream.hxx"
+#include "io/BufferedReader.hxx"
+#include "util/tstring_view.hxx"
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include <string.h>
+
+namespace {
+
+struct CacheHeader {
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t version;
+
+  /**
+   * The length of the key string following this header.
+   */
+  uint32_t key_length;
+
+  uint32_t n_airspaces;
+};
+
+/**
+ * One airspace.  It is followed by its name, its type (both as
+ * TCHAR strings without null terminator) and, for polygons, its
+ * points.
+ */
+struct AirspaceRecord {
+  AirspaceAltitude base, top;
+
+  /**
+   * Circles only.
+   */
+  GeoPoint center;
+  double radius;
+
+  /**
+   * Polygons only.
+   */
+  uint32_t n_points;
+
+  uint32_t name_length, type_length;
+
+  RadioFrequency radio_frequency;
+
+  AbstractAirspace::Shape shape;
+  AirspaceClass asclass;
+  AirspaceActivity days;
+};
+
+/* the snapshot is a copy of the objects' memory */
+static_assert(std::is_trivially_copyable_v<AirspaceAltitude>);
+static_assert(std::is_trivially_copyable_v<AirspaceRecord>);
+
+/* sanity limits for reading */
+static constexpr uint32_t MAX_KEY_LENGTH = 4096;
+static constexpr uint32_t MAX_AIRSPACES = 1024 * 1024;
+static constexpr uint32_t MAX_STRING_LENGTH = 4096;
+static constexpr uint32_t MAX_POINTS = 1024 * 1024;
+
+} // anonymous namespace
+
+static void
+WriteString(BufferedOutputStream &os, const tstring_view s)
+{
+  os.Write(std::as_bytes(std::span{s}));
+}
+
+void
+SaveAirspaceCache(BufferedOutputStream &os, std::string_view key,
+                  const std::vector<AirspacePtr> &airspaces)
+{
+  CacheHeader header;
+  memset(&header, 0, sizeof(header));
+  header.version = CacheHeader::VERSION;
+  header.key_length = key.size();
+  header.n_airspaces = airspaces.size();
+
+  os.Write(std::as_bytes(std::span{&header, 1}));
+  os.Write(std::as_bytes(std::span{key}));
+
+  std::vector<GeoPoint> points;
+
+  for (const auto &i : airspaces) {
+    const AbstractAirspace &as = *i;
+    const tstring_view name = as.GetName(), type = as.GetType();
+
+    AirspaceRecord record;
+
+    /* zero-fill all implicit padding bytes (to make valgrind happy) */
+    memset(static_cast<void *>(&record), 0, sizeof(record));
+
+    record.base = as.GetBase();
+    record.top = as.GetTop();
+    record.name_length = name.size();
+    record.type_length = type.size();
+    record.radio_frequency = as.GetRadioFrequency();
+    record.shape = as.GetShape();
+    record.asclass = as.GetClass();
+    record.days = as.GetDays();
+
+    points.clear();
+
+    switch (as.GetShape()) {
+    case AbstractAirspace::Shape::CIRCLE: {
+      const auto &circle = static_cast<const AirspaceCircle &>(as);
+      record.center = circle.GetCenter();
+      record.radius = circle.GetRadius();
+      break;
+    }
+
+    case AbstractAirspace::Shape::POLYGON:
+      for (const auto &p : as.GetPoints())
+        points.push_back(p.GetLocation());
+      record.center = GeoPoint::Invalid();
+      record.n_points = points.size();
+      break;
+    }
+
+    os.Write(std::as_bytes(std::span{&record, 1}));
+    WriteString(os, name);
+    WriteString(os, type);
+    os.Write(std::as_bytes(std::span{points}));
+  }
+}
+
+static tstring
+ReadString(BufferedReader &r, std::size_t length)
+{
+  if (length > MAX_STRING_LENGTH)
+    throw std::runtime_error("Malformed airspace cache string");
+
+  tstring s(length, _T('\0'));
+  r.ReadFull(std::as_writable_bytes(std::span{s}));
+  return s;
+}
+
+static bool
+IsValidAltitude(const AirspaceAltitude &altitude) noexcept
+{
+  switch (altitude.reference) {
+  case AltitudeReference::AGL:
+  case AltitudeReference::MSL:
+  case AltitudeReference::STD:
+    return true;
+  }
+
+  return false;
+}
+
+std::vector<AirspacePtr>
+LoadAirspaceCache(BufferedReader &r, std::string_view key)
+{
+  const auto header = r.ReadFullT<CacheHeader>();
+  if (header.version != CacheHeader::VERSION ||
+      header.key_length > MAX_KEY_LENGTH ||
+      header.n_airspaces > MAX_AIRSPACES)
+    throw std::runtime_error("Malformed airspace cache header");
+
+  std::string old_key(header.key_length, '\0');
+  r.ReadFull(std::as_writable_bytes(std::span{old_key}));
+  if (old_key != key)
+    throw std::runtime_error("Airspace cache is for another file");
+
+  std::vector<AirspacePtr> airspaces;
+  airspaces.reserve(header.n_airspaces);
+
+  std::vector<GeoPoint> points;
+
+  for (uint32_t i = 0; i < header.n_airspaces; ++i) {
+    const auto record = r.ReadFullT<AirspaceRecord>();
+    if (record.asclass >= AIRSPACECLASSCOUNT ||
+        !IsValidAltitude(record.base) || !IsValidAltitude(record.top))
+      throw std::runtime_error("Malformed airspace cache record");
+
+    auto name = ReadString(r, record.name_length);
+    auto type = ReadString(r, record.type_length);
+
+    AirspacePtr as;
+
+    switch (record.shape) {
+    case AbstractAirspace::Shape::CIRCLE:
+      if (!record.center.Check() || !std::isfinite(record.radius) ||
+          record.radius <= 0)
+        throw std::runtime_error("Malformed airspace cache circle");
+
+      as = std::make_shared<AirspaceCircle>(record.center, record.radius);
+      break;
+
+    case AbstractAirspace::Shape::POLYGON:
+      if (record.n_points < 3 || record.n_points > MAX_POINTS)
+        throw std::runtime_error("Malformed airspace cache polygon");
+
+      points.resize(record.n_points);
+      r.ReadFull(std::as_writable_bytes(std::span{points}));
+
+      for (const auto &p : points)
+        if (!p.Check())
+          throw std::runtime_error("Malformed airspace cache polygon");
+
+      as = std::make_shared<AirspacePolygon>(points);
+      break;
+
+    default:
+      throw std::runtime_error("Malformed airspace cache record");
+    }
+
+    as->SetProperties(std::move(name), record.asclass, std::move(type),
+                      record.base, record.top);
+    as->SetRadioFrequency(record.radio_frequency);
+    as->SetDays(record.days);
+
+    airspaces.push_back(std::move(as));
+  }
+
+  return airspaces;
+}
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Airspace/Ptr.hpp"
+
+#include <string_view>
+#include <vector>
+
+class BufferedOutputStream;
+class BufferedReader;
+
+/*
+ * A binary snapshot of the airspaces parsed from one file, to be
+ * stored in the #FileCache.  It is only valid on the machine which
+ * wrote it.
+ */
+
+/**
+ * Write a snapshot of the specified airspaces.
+ *
+ * Throws on error.
+ *
+ * @param key identifies the source (e.g. its path); LoadAirspaceCache()
+ * refuses a snapshot written with a different key
+ */
+void
+SaveAirspaceCache(BufferedOutputStream &os, std::string_view key,
+                  const std::vector<AirspacePtr> &airspaces);
+
+/**
+ * Read a snapshot written by SaveAirspaceCache().
+ *
+ * Throws on error (e.g. a malformed or incompatible snapshot).
+ *
+ * @return the airspaces in the order they were saved
+ */
+std::vector<AirspacePtr>
+LoadAirspaceCache(BufferedReader &r, std::string_view key);
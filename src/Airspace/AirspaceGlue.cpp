@@ -3,6 +3,7 @@
 
 #include "Airspace/AirspaceGlue.hpp"
 #include "Airspace/AirspaceParser.hpp"
+#include "Airspace/AirspaceCache.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
 #include "Atmosphere/Pressure.hpp"
 #include "Profile/Keys.hpp"
@@ -10,22 +11,44 @@
 #include "Language/Language.hpp"
 #include "LogFile.hpp"
 #include "system/Path.hpp"
-#include "io/FileLineReader.hpp"
+#include "io/FileCache.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/Reader.hxx"
+#include "io/MappedLineReader.hpp"
+#include "io/FileMapping.hpp"
 #include "io/ZipArchive.hpp"
 #include "io/ZipLineReader.hpp"
 #include "io/MapFile.hpp"
 #include "util/RuntimeError.hxx"
+#include "util/UTF8.hpp"
 #include "Profile/Profile.hpp"
 
+#include <string>
+#include <vector>
+
 #include <string.h>
 
 static bool
 ParseAirspaceFile(Airspaces &airspaces, Path path,
                   OperationEnvironment &operation)
 try {
-  FileLineReader reader(path, Charset::AUTO);
-
   try {
+#ifndef _UNICODE
+    const FileMapping mapping(path);
+    const std::span<const std::byte> raw = mapping;
+    const std::string_view data{(const char *)raw.data(), raw.size()};
+
+    if (ValidateUTF8(data)) {
+      /* fast path: parse the mapped file directly */
+      ParseAirspaceFile(airspaces, data, operation);
+      return true;
+    }
+#endif
+
+    /* detect the charset of the whole file and convert it */
+    MappedFileLineReader reader(path, Charset::AUTO);
     ParseAirspaceFile(airspaces, reader, operation);
   } catch (...) {
     // TODO translate this?
@@ -62,8 +85,97 @@ try {
   return false;
 }
 
+static std::vector<AirspacePtr>
+LoadCache(FileCache &cache, const TCHAR *name, Path original_path,
+          std::string_view key)
+{
+  auto r = cache.Load(name, original_path);
+  if (!r)
+    return {};
+
+  BufferedReader br(*r);
+  return LoadAirspaceCache(br, key);
+}
+
+static void
+SaveCache(FileCache &cache, const TCHAR *name, Path original_path,
+          std::string_view key, const std::vector<AirspacePtr> &airspaces)
+{
+  auto os = cache.Save(name, original_path);
+  BufferedOutputStream bos(*os);
+  SaveAirspaceCache(bos, key, airspaces);
+  bos.Flush();
+  os->Commit();
+}
+
+/**
+ * Load the airspaces of one file from the #FileCache, or parse the
+ * file and store the result in the cache.
+ *
+ * @param cache_name the name of the cache file for this source
+ * @param original_path the file whose modification time and size
+ * validate the cache
+ * @param key identifies the source within the cache file (a change
+ * of the configured path invalidates the cache)
+ * @param parse parses the file into the given #Airspaces object;
+ * returns false on error
+ */
+template<typename P>
+static bool
+LoadAirspaceFile(Airspaces &airspaces, FileCache *cache,
+                 const TCHAR *cache_name, Path original_path,
+                 const std::string &key, P &&parse)
+{
+  if (cache != nullptr) {
+    try {
+      auto cached = LoadCache(*cache, cache_name, original_path, key);
+      if (!cached.empty()) {
+        for (auto &i : cached)
+          airspaces.Add(std::move(i));
+        return true;
+      }
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to load airspace cache");
+    }
+  }
+
+  /* parse into a separate container to collect this file's
+     airspaces for the cache */
+  Airspaces parsed;
+  const bool success = parse(parsed);
+  parsed.Optimise();
+
+  std::vector<AirspacePtr> result;
+  for (const auto &i : parsed.QueryAll())
+    result.push_back(i.GetAirspacePtr());
+
+  if (success && cache != nullptr && !result.empty()) {
+    try {
+      SaveCache(*cache, cache_name, original_path, key, result);
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to save airspace cache");
+    }
+  }
+
+  for (auto &i : result)
+    airspaces.Add(std::move(i));
+
+  return success;
+}
+
+static bool
+LoadAirspaceFile(Airspaces &airspaces, FileCache *cache,
+                 const TCHAR *cache_name, Path path,
+                 OperationEnvironment &operation)
+{
+  return LoadAirspaceFile(airspaces, cache, cache_name, path,
+                          path.ToUTF8(), [&](Airspaces &parsed){
+                            return ParseAirspaceFile(parsed, path, operation);
+                          });
+}
+
 void
-ReadAirspace(Airspaces &airspaces,
+ReadAirspace(Airspaces &airspaces, FileCache *cache,
              AtmosphericPressure press,
              OperationEnvironment &operation)
 {
@@ -75,17 +187,28 @@ ReadAirspace(Airspaces &airspaces,
   // Read the airspace filenames from the registry
   if (const auto path = Profile::GetPath(ProfileKeys::AirspaceFile);
       path != nullptr)
-    airspace_ok |= ParseAirspaceFile(airspaces, path, operation);
+    airspace_ok |= LoadAirspaceFile(airspaces, cache, _T("airspace"),
+                                    path, operation);
 
   if (const auto path = Profile::GetPath(ProfileKeys::AdditionalAirspaceFile);
       path != nullptr)
-    airspace_ok |= ParseAirspaceFile(airspaces, path, operation);
+    airspace_ok |= LoadAirspaceFile(airspaces, cache,
+                                    _T("airspace_additional"),
+                                    path, operation);
 
   try {
     if (auto archive = OpenMapFile();
-        archive && archive->Exists("airspace.txt"))
-      airspace_ok |= ParseAirspaceFile(airspaces, archive->get(),
-                                       "airspace.txt", operation);
+        archive && archive->Exists("airspace.txt")) {
+      const auto map_path = Profile::GetPath(ProfileKeys::MapFile);
+      airspace_ok |=
+        LoadAirspaceFile(airspaces, cache, _T("airspace_map"), map_path,
+                         map_path.ToUTF8() + "/airspace.txt",
+                         [&](Airspaces &parsed){
+                           return ParseAirspaceFile(parsed, archive->get(),
+                                                    "airspace.txt",
+                                                    operation);
+                         });
+    }
   } catch (...) {
     LogError(std::current_exception(),
              "Failed to load airspaces from map file");
@@ -7,12 +7,17 @@ class RasterTerrain;
 class AtmosphericPressure;
 class Airspaces;
 class OperationEnvironment;
+class FileCache;
 
 /**
  * Reads the airspace files into the memory
+ *
+ * @param cache an optional cache for the parsed airspaces; files
+ * which have not been modified since they were parsed are loaded from
+ * there
  */
 void
-ReadAirspace(Airspaces &airspaces,
+ReadAirspace(Airspaces &airspaces, FileCache *cache,
              AtmosphericPressure press,
              OperationEnvironment &operation);
 
@@ -20,8 +20,13 @@
 #include "util/RuntimeError.hxx"
 #include "util/StaticString.hxx"
 #include "util/StringCompare.hxx"
+#include "util/StringSplit.hxx"
+#include "util/StringStrip.hxx"
+#include "util/UTF8.hpp"
 
+#include <cassert>
 #include <stdexcept>
+#include <string>
 
 #include <tchar.h>
 
@@ -910,20 +915,91 @@ DetectFileType(const TCHAR *line)
   return AirspaceFileType::UNKNOWN;
 }
 
+namespace {
+
+/**
+ * Feeds the lines of one airspace file to the OpenAir or TNP line
+ * parser, after detecting the file type.
+ */
+class AirspaceFileParser {
+  Airspaces &airspaces;
+
+  TempAirspace temp_area;
+  AirspaceFileType filetype = AirspaceFileType::UNKNOWN;
+  bool ignore = false;
+
+public:
+  explicit AirspaceFileParser(Airspaces &_airspaces) noexcept
+    :airspaces(_airspaces) {}
+
+  /**
+   * Throws on error.
+   *
+   * @param line a non-empty line without trailing whitespace; it
+   * may be modified
+   */
+  void ParseLine(TCHAR *line, unsigned line_num);
+
+  /**
+   * Commit the last airspace.  Throws on error.
+   */
+  void Finish();
+};
+
+} // anonymous namespace
+
+void
+AirspaceFileParser::ParseLine(TCHAR *line, unsigned line_num)
+{
+  if (filetype == AirspaceFileType::UNKNOWN) {
+    filetype = DetectFileType(line);
+    if (filetype == AirspaceFileType::UNKNOWN)
+      return;
+  }
+
+  try {
+    if (filetype == AirspaceFileType::OPENAIR)
+      ::ParseLine(airspaces, line_num, line, temp_area);
+    if (filetype == AirspaceFileType::TNP) {
+      StringParser<TCHAR> input(line);
+      ParseLineTNP(airspaces, line_num, input, temp_area, ignore);
+    }
+  } catch (const TempAirspace::CommitError &e) {
+    throw FormatRuntimeError("Error in airspace at line %u: %s",
+                             temp_area.first_line_number, e.msg);
+  } catch (...) {
+    // TODO translate this?
+    std::throw_with_nested(FormatRuntimeError("Error in line %u ('%s')",
+                                              line_num, line));
+  }
+}
+
+void
+AirspaceFileParser::Finish()
+{
+  if (filetype == AirspaceFileType::UNKNOWN)
+    throw std::runtime_error(WideToUTF8Converter(_("Unknown airspace filetype")));
+
+  // Process final area (if any)
+  try {
+    temp_area.Commit(airspaces);
+  } catch (const TempAirspace::CommitError &e) {
+    throw FormatRuntimeError("Error in airspace at line %u: %s",
+                             temp_area.first_line_number, e.msg);
+  }
+}
+
 void
 ParseAirspaceFile(Airspaces &airspaces,
                   TLineReader &reader,
                   ProgressListener &progress)
 {
-  bool ignore = false;
-
   // Create and init ProgressDialog
   progress.SetProgressRange(1024);
 
   const long file_size = reader.GetSize();
 
-  TempAirspace temp_area;
-  AirspaceFileType filetype = AirspaceFileType::UNKNOWN;
+  AirspaceFileParser parser(airspaces);
 
   TCHAR *line;
 
@@ -935,37 +1011,55 @@ ParseAirspaceFile(Airspaces &airspaces,
     if (StringIsEmpty(line))
       continue;
 
-    if (filetype == AirspaceFileType::UNKNOWN) {
-      filetype = DetectFileType(line);
-      if (filetype == AirspaceFileType::UNKNOWN)
-        continue;
-    }
-
-    // Parse the line
-    try {
-      if (filetype == AirspaceFileType::OPENAIR)
-        ParseLine(airspaces, line_num, line, temp_area);
-      if (filetype == AirspaceFileType::TNP) {
-        StringParser<TCHAR> input(line);
-        ParseLineTNP(airspaces, line_num, input, temp_area, ignore);
-      }
-    } catch (const TempAirspace::CommitError &e) {
-      throw FormatRuntimeError("Error in airspace at line %u: %s",
-                               temp_area.first_line_number, e.msg);
-    } catch (...) {
-      // TODO translate this?
-      std::throw_with_nested(FormatRuntimeError("Error in line %u ('%s')",
-                                                line_num, line));
-    }
+    parser.ParseLine(line, line_num);
 
     // Update the ProgressDialog
     if ((line_num & 0xff) == 0)
       progress.SetProgressPosition(reader.Tell() * 1024 / file_size);
   }
 
-  if (filetype == AirspaceFileType::UNKNOWN)
-    throw std::runtime_error(WideToUTF8Converter(_("Unknown airspace filetype")));
+  parser.Finish();
+}
 
-  // Process final area (if any)
-  temp_area.Commit(airspaces);
+#ifndef _UNICODE
+
+void
+ParseAirspaceFile(Airspaces &airspaces, std::string_view data,
+                  ProgressListener &progress)
+{
+  assert(ValidateUTF8(data));
+
+  progress.SetProgressRange(1024);
+
+  const std::size_t size = data.size();
+
+  if (data.starts_with(utf8_byte_order_mark))
+    data.remove_prefix(utf8_byte_order_mark.size());
+
+  AirspaceFileParser parser(airspaces);
+
+  /* the line parsers need a null-terminated string, so the stripped
+     line is copied here; this buffer is reused for all lines */
+  std::string buffer;
+
+  for (unsigned line_num = 1; data.data() != nullptr; line_num++) {
+    const auto [line, rest] = Split(data, '\n');
+    data = rest;
+
+    const auto stripped = StripRight(line);
+
+    // Skip empty line
+    if (!stripped.empty()) {
+      buffer.assign(stripped);
+      parser.ParseLine(buffer.data(), line_num);
+    }
+
+    // Update the ProgressDialog
+    if ((line_num & 0xff) == 0)
+      progress.SetProgressPosition((size - data.size()) * 1024 / size);
+  }
+
+  parser.Finish();
 }
+
+#endif
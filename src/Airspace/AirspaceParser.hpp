@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <string_view>
+
 class Airspaces;
 class TLineReader;
 class ProgressListener;
@@ -14,3 +16,22 @@ void
 ParseAirspaceFile(Airspaces &airspaces,
                   TLineReader &reader,
                   ProgressListener &progress);
+
+#ifndef _UNICODE
+
+/**
+ * Parse an airspace file which is completely in memory (e.g. a
+ * #FileMapping), without a #TLineReader and without per-line
+ * charset conversion.
+ *
+ * Throws on error.
+ *
+ * @param data the file contents, which must be valid UTF-8 (check
+ * with ValidateUTF8() first and use the #TLineReader overload with
+ * #Charset::AUTO otherwise)
+ */
+void
+ParseAirspaceFile(Airspaces &airspaces, std::string_view data,
+                  ProgressListener &progress);
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "org_xcsoar_FileProvider.h"
 #include "Engine/Waypoint/Waypoints.hpp"
+#include "Waypoint/WaypointDetailsReader.hpp"
 #include "system/Path.hpp"
 #include "java/String.hxx"
 #include "Components.hpp"
@@ -18,6 +19,8 @@ Java_org_xcsoar_FileProvider_getWaypointFileForUri(JNIEnv *env, jclass,
   if (!w)
     return nullptr;
 
+  WaypointDetails::Load(*w);
+
   const auto filename = Java::String::GetUTFChars(env, _filename);
 
   /* check if the given file really exists; refuse access to other
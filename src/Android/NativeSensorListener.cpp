@@ -80,6 +80,34 @@ Java_org_xcsoar_NativeSensorListener_onLocationSensor(JNIEnv *env, jobject obj,
                             hasAccuracy, accuracy);
 }
 
+gcc_visibility_default
+JNIEXPORT void JNICALL
+Java_org_xcsoar_NativeSensorListener_onSensorBatch(JNIEnv *env, jobject obj,
+                                                   jobject buffer, jint n,
+                                                   jlong now)
+{
+  jlong ptr = env->GetLongField(obj, NativeSensorListener::ptr_field);
+  if (ptr == 0 || n <= 0)
+    return;
+
+  using SensorSample = SensorListener::SensorSample;
+
+  const auto *samples = (const SensorSample *)
+    env->GetDirectBufferAddress(buffer);
+  if (samples == nullptr ||
+      env->GetDirectBufferCapacity(buffer) < jlong(n * sizeof(*samples)))
+    return;
+
+  /* the sample timestamps are in the SystemClock.elapsedRealtimeNanos()
+     time base; "now" is the value of that clock right before this
+     call */
+  const auto clock_offset = std::chrono::steady_clock::now().time_since_epoch()
+    - std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds{now});
+
+  auto &listener = *(SensorListener *)ptr;
+  listener.OnSensorBatch({samples, std::size_t(n)}, clock_offset);
+}
+
 gcc_visibility_default
 JNIEXPORT void JNICALL
 Java_org_xcsoar_NativeSensorListener_onAccelerationSensor1(JNIEnv *env, jobject obj,
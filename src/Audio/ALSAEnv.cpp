@@ -19,7 +19,9 @@ static constexpr char ALSA_DEVICE_ENV[] = "ALSA_DEVICE";
 static constexpr char ALSA_LATENCY_ENV[] = "ALSA_LATENCY";
 
 static constexpr char DEFAULT_ALSA_DEVICE[] = "default";
-static constexpr unsigned DEFAULT_ALSA_LATENCY = 100000;
+/* 30 ms, i.e. four periods of 7.5 ms: short enough to keep the audio
+   vario responsive */
+static constexpr unsigned DEFAULT_ALSA_LATENCY = 30000;
 
 
 static const char *InitALSADeviceName()
@@ -44,7 +46,7 @@ static unsigned InitALSALatency()
     latency = ParseUnsigned(latency_env_value, &p);
     if (*p != '\0') {
       LogFormat("Invalid %s value \"%s\"", ALSA_LATENCY_ENV, latency_env_value);
-      return false;
+      latency = DEFAULT_ALSA_LATENCY;
     }
   }
   LogFormat("Using ALSA PCM latency %u μs (use environment variable "
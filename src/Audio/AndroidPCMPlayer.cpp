@@ -13,6 +13,7 @@
 
 #include <SLES/OpenSLES_Android.h>
 
+#include <algorithm>
 #include <cassert>
 
 AndroidPCMPlayer::~AndroidPCMPlayer()
@@ -160,7 +161,7 @@ AndroidPCMPlayer::Start(PCMSynthesiser &_source)
        * OpenSL/ES callback which gets invoked when a buffer has been
        * consumed.  It synthesises and enqueues the next buffer.
        */
-      reinterpret_cast<AndroidPCMPlayer *>(pContext)->Enqueue();
+      reinterpret_cast<AndroidPCMPlayer *>(pContext)->OnBufferConsumed();
   }, this);
   if (result != SL_RESULT_SUCCESS) {
     LogFormat("PCMPlayer: Play.RegisterCallback() result=%#x", (int)result);
@@ -184,7 +185,12 @@ AndroidPCMPlayer::Start(PCMSynthesiser &_source)
   }
 
   next = 0;
-  filled = false;
+  filled = 0;
+
+  /* begin with 10 ms periods; OnBufferConsumed() will grow them if
+     the device cannot keep up */
+  buffer_frames = std::clamp<size_t>(_source.GetSampleRate() / 100,
+                                     64, MAX_BUFFER_FRAMES);
   for (unsigned i = 0; i < ARRAY_SIZE(buffers) - 1; ++i)
     Enqueue();
 
@@ -205,6 +211,24 @@ AndroidPCMPlayer::Stop()
   source = nullptr;
 }
 
+void
+AndroidPCMPlayer::OnBufferConsumed()
+{
+  SLAndroidSimpleBufferQueueState state;
+  if (queue.GetState(&state) == SL_RESULT_SUCCESS && state.count == 0) {
+    /* the last buffer has been played before we were able to enqueue
+       another one: switch to larger buffers to avoid more dropouts */
+    const std::lock_guard lock{mutex};
+    if (buffer_frames < MAX_BUFFER_FRAMES) {
+      buffer_frames = std::min(buffer_frames * 2, MAX_BUFFER_FRAMES);
+      LogFormat("PCMPlayer: buffer underrun, increasing buffer to %u frames",
+                (unsigned)buffer_frames);
+    }
+  }
+
+  Enqueue();
+}
+
 void
 AndroidPCMPlayer::Enqueue()
 {
@@ -212,15 +236,16 @@ AndroidPCMPlayer::Enqueue()
 
   const std::lock_guard lock{mutex};
 
-  if (!filled) {
-    filled = true;
-    source->Synthesise(buffers[next], ARRAY_SIZE(buffers[next]));
+  if (filled == 0) {
+    filled = buffer_frames;
+    source->Synthesise(buffers[next], filled);
   }
 
-  SLresult result = queue.Enqueue(buffers[next], sizeof(buffers[next]));
+  SLresult result = queue.Enqueue(buffers[next],
+                                  filled * sizeof(buffers[next][0]));
   if (result == SL_RESULT_SUCCESS) {
     next = (next + 1) % ARRAY_SIZE(buffers);
-    filled = false;
+    filled = 0;
   }
 
   if (result != SL_RESULT_SUCCESS)
@@ -22,10 +22,16 @@ class AndroidPCMPlayer : public PCMPlayer {
   SLES::AndroidSimpleBufferQueue queue;
 
   /**
-   * This mutex protects the attributes "next" and "filled".  It is
-   * only needed while playback is launched, when the initial buffers
-   * are being enqueued in the caller thread, while another thread may
-   * invoke the registered callback.
+   * The size of each buffer.  This is also the largest value
+   * #buffer_frames may grow to.
+   */
+  static constexpr size_t MAX_BUFFER_FRAMES = 4096;
+
+  /**
+   * This mutex protects the attributes "next", "filled" and
+   * "buffer_frames".  It is only needed while playback is launched,
+   * when the initial buffers are being enqueued in the caller thread,
+   * while another thread may invoke the registered callback.
    */
   Mutex mutex;
 
@@ -35,19 +41,31 @@ class AndroidPCMPlayer : public PCMPlayer {
   unsigned next;
 
   /**
-   * Does the "next" buffer already contain synthesised samples?  This
-   * can happen when PCMDataSource::GetData() has been called, but
-   * the OpenSL/ES buffer queue was full.  The buffer will then be
-   * postponed.
+   * The number of synthesised samples in the "next" buffer, or zero
+   * if it has not been filled yet.  It is non-zero when
+   * PCMDataSource::GetData() has been called, but the OpenSL/ES
+   * buffer queue was full.  The buffer will then be postponed.
    */
-  bool filled;
+  size_t filled;
+
+  /**
+   * The number of samples to be synthesised into each buffer.  This
+   * starts with a short period (low latency) and is doubled each time
+   * the buffer queue runs dry.
+   */
+  size_t buffer_frames;
 
   /**
    * An array of buffers.  It's one more than being managed by
    * OpenSL/ES, and the one not enqueued (see attribute #next) will be
    * written to.
    */
-  int16_t buffers[3][4096];
+  int16_t buffers[3][MAX_BUFFER_FRAMES];
+
+  /**
+   * Called by OpenSL/ES when a buffer has been consumed.
+   */
+  void OnBufferConsumed();
 
   void Enqueue();
 
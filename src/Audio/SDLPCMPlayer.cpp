@@ -5,6 +5,7 @@
 
 #include "PCMDataSource.hpp"
 
+#include <bit>
 #include <cassert>
 
 SDLPCMPlayer::~SDLPCMPlayer()
@@ -33,7 +34,9 @@ SDLPCMPlayer::Start(PCMDataSource &_source)
   wanted.freq = static_cast<int>(new_sample_rate);
   wanted.format = AUDIO_S16SYS;
   wanted.channels = 1;
-  wanted.samples = 4096;
+  /* a power of two no longer than 20 ms, for a responsive audio
+     vario */
+  wanted.samples = static_cast<Uint16>(std::bit_floor(new_sample_rate / 50));
   wanted.callback = [](void *ud, Uint8 *stream, int len_bytes) {
     assert(nullptr != ud);
     assert(nullptr != stream);
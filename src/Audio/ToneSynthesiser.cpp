@@ -6,31 +6,63 @@
 
 #include <cassert>
 
+static constexpr uint32_t ANGLE_MASK =
+  (uint32_t(ISINETABLE.size()) << 16) - 1;
+
+uint32_t
+ToneSynthesiser::ToIncrement(unsigned tone_hz) const
+{
+  return ((uint64_t(ISINETABLE.size()) << FRACTION_BITS) * tone_hz
+          / sample_rate) & ANGLE_MASK;
+}
+
 void
 ToneSynthesiser::SetTone(unsigned tone_hz)
 {
-  increment = ISINETABLE.size() * tone_hz / sample_rate;
+  increment = target_increment = ToIncrement(tone_hz);
+  glide_remaining = 0;
+}
+
+void
+ToneSynthesiser::GlideTone(unsigned tone_hz, size_t n_samples)
+{
+  target_increment = ToIncrement(tone_hz);
+  glide_remaining = n_samples;
+
+  if (glide_remaining == 0)
+    increment = target_increment;
 }
 
 void
 ToneSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
-  assert(angle < ISINETABLE.size());
+  static_assert(ANGLE_MASK == (uint32_t(INT_ANGLE_RANGE) << FRACTION_BITS) - 1);
+  assert(angle <= ANGLE_MASK);
 
   for (int16_t *end = buffer + n; buffer != end; ++buffer) {
-    *buffer = ISINETABLE[angle] * (32767 / 1024) * (int)volume / 100;
-    angle = (angle + increment) & (ISINETABLE.size() - 1);
+    *buffer = ISINETABLE[angle >> FRACTION_BITS] * (32767 / 1024)
+      * (int)volume / 100;
+
+    if (glide_remaining > 0) {
+      /* move a fraction of the remaining distance; the last step
+         lands exactly on the target */
+      const int32_t delta = int32_t(target_increment) - int32_t(increment);
+      increment += delta / int32_t(glide_remaining);
+      --glide_remaining;
+    }
+
+    angle = (angle + increment) & ANGLE_MASK;
   }
 }
 
 unsigned
 ToneSynthesiser::ToZero() const
 {
-  assert(angle < ISINETABLE.size());
+  assert(angle <= ANGLE_MASK);
 
   if (angle < increment)
     /* close enough */
     return 0;
 
-  return (ISINETABLE.size() - angle) / increment;
+  return (ANGLE_MASK + 1 - angle) / increment;
 }
@@ -5,11 +5,40 @@
 
 #include "PCMSynthesiser.hpp"
 
+#include <cstdint>
+
 /**
  * This class generates tones with a sine wave.
  */
 class ToneSynthesiser : public PCMSynthesiser {
-  unsigned volume = 100, angle = 0, increment = 0;
+  /**
+   * The number of fractional bits in #angle and #increment.  The
+   * fraction allows finer frequency steps and smooth glides.
+   */
+  static constexpr unsigned FRACTION_BITS = 16;
+
+  unsigned volume = 100;
+
+  /**
+   * The current position in the sine table (fixed point).
+   */
+  uint32_t angle = 0;
+
+  /**
+   * The value added to #angle for each sample (fixed point).
+   */
+  uint32_t increment = 0;
+
+  /**
+   * The value #increment glides to; see GlideTone().
+   */
+  uint32_t target_increment = 0;
+
+  /**
+   * The number of samples remaining until #increment reaches
+   * #target_increment.
+   */
+  size_t glide_remaining = 0;
 
 public:
   explicit ToneSynthesiser(unsigned _sample_rate) : sample_rate(_sample_rate) {
@@ -29,8 +58,18 @@ public:
     volume = _volume;
   }
 
+  /**
+   * Switch to the specified tone immediately.
+   */
   void SetTone(unsigned tone_hz);
 
+  /**
+   * Change the tone frequency linearly over the next #n_samples
+   * samples, to avoid audible steps when the tone is updated once per
+   * audio period.
+   */
+  void GlideTone(unsigned tone_hz, size_t n_samples);
+
   /* methods from class PCMSynthesiser */
   virtual void Synthesise(int16_t *buffer, size_t n);
 
@@ -50,4 +89,17 @@ protected:
   void Restart() {
     angle = 0;
   }
+
+  /**
+   * Skip the rest of a glide started by GlideTone() and switch to
+   * the target frequency right away.
+   */
+  void FinishGlide() {
+    increment = target_increment;
+    glide_remaining = 0;
+  }
+
+private:
+  [[gnu::pure]]
+  uint32_t ToIncrement(unsigned tone_hz) const;
 };
@@ -19,18 +19,27 @@ VarioSynthesiser::VarioToFrequency(int ivario)
 void
 VarioSynthesiser::SetVario(double vario)
 {
-  const std::lock_guard lock{mutex};
-
-  const int ivario = std::clamp((int)(vario * 100), min_vario, max_vario);
+  pending.store(std::clamp((int)(vario * 100), min_vario, max_vario),
+                std::memory_order_relaxed);
+}
 
+void
+VarioSynthesiser::ApplyVario(int ivario, size_t n)
+{
   if (dead_band_enabled && InDeadBand(ivario)) {
     /* inside the "dead band" */
-    UnsafeSetSilence();
+    ApplySilence();
     return;
   }
 
-  /* update the ToneSynthesiser base class */
-  SetTone(VarioToFrequency(ivario));
+  /* update the ToneSynthesiser base class; while the tone is
+     audible, glide to the new frequency during this audio period
+     instead of jumping, else switch right away */
+  const unsigned frequency = VarioToFrequency(ivario);
+  if (audible_remaining > 0 || silence_count == 0)
+    GlideTone(frequency, n);
+  else
+    SetTone(frequency);
 
   if (ivario > 0) {
     /* while climbing, the vario sound gets interrupted by silence
@@ -62,12 +71,11 @@ VarioSynthesiser::SetVario(double vario)
 void
 VarioSynthesiser::SetSilence()
 {
-  const std::lock_guard lock{mutex};
-  UnsafeSetSilence();
+  pending.store(SILENCE_REQUEST, std::memory_order_relaxed);
 }
 
 void
-VarioSynthesiser::UnsafeSetSilence()
+VarioSynthesiser::ApplySilence()
 {
   audible_count = 0;
   silence_count = 1;
@@ -85,7 +93,12 @@ VarioSynthesiser::UnsafeSetSilence()
 void
 VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
-  const std::lock_guard lock{mutex};
+  if (const int request = pending.exchange(NO_REQUEST,
+                                           std::memory_order_relaxed);
+      request == SILENCE_REQUEST)
+    ApplySilence();
+  else if (request != NO_REQUEST)
+    ApplyVario(request, n);
 
   assert(audible_count > 0 || silence_count > 0);
 
@@ -126,8 +139,10 @@ VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
       n -= o;
       silence_remaining -= o;
     } else {
-      /* period finished, begin next one */
+      /* period finished, begin next one; the new tone starts at
+         its final frequency */
 
+      FinishGlide();
       audible_remaining = audible_count;
       silence_remaining = silence_count;
     }
@@ -4,17 +4,33 @@
 #pragma once
 
 #include "ToneSynthesiser.hpp"
-#include "thread/Mutex.hxx"
+
+#include <atomic>
+#include <climits>
 
 /**
  * This class generates vario sound.
+ *
+ * SetVario() and SetSilence() may be called from any thread.  They
+ * do not lock; they only store the request in a lock-free slot which
+ * is applied by the next Synthesise() call (in the audio thread), so
+ * a sensor thread can feed the vario value without waiting for the
+ * audio thread.  A new tone frequency is interpolated over the audio
+ * period in which it gets applied.
  */
 class VarioSynthesiser final : public ToneSynthesiser {
   /**
-   * This mutex protects all atttributes below.  It is locked
-   * automatically by all public methods.
+   * Special values for #pending.
    */
-  Mutex mutex;
+  static constexpr int NO_REQUEST = INT_MIN, SILENCE_REQUEST = INT_MIN + 1;
+
+  /**
+   * The most recent vario value [cm/s] which has not yet been
+   * applied by Synthesise(), or #SILENCE_REQUEST, or #NO_REQUEST.
+   */
+  std::atomic_int pending{NO_REQUEST};
+
+  /* the following attributes are only used by Synthesise() */
 
   /**
    * The number of audible samples in each period.
@@ -83,8 +99,9 @@ public:
      min_dead(-30), max_dead(10), min_vario(-500), max_vario(500) {}
 
   /**
-   * Update the vario value.  This calculates a new tone frequency and
-   * a new "silence" rate (for positive vario values).
+   * Update the vario value.  The next Synthesise() call calculates a
+   * new tone frequency and a new "silence" rate (for positive vario
+   * values).
    *
    * @param vario the current vario value [m/s]
    */
@@ -140,9 +157,16 @@ public:
 
 private:
   /**
-   * Same as SetSilence(), but doesn't lock the mutex.
+   * Apply a vario value [cm/s] submitted by SetVario().
+   *
+   * @param n the number of samples in the current audio period
+   */
+  void ApplyVario(int ivario, size_t n);
+
+  /**
+   * Apply a SetSilence() request.
    */
-  void UnsafeSetSilence();
+  void ApplySilence();
 
   /**
    * Convert a vario value to a tone frequency.
@@ -5,6 +5,9 @@
 #include "Hardware/Battery.hpp"
 #include "Hardware/PowerInfo.hpp"
 #include "Hardware/PowerGlobal.hpp"
+#include "Hardware/PowerGovernor.hpp"
+#include "CalculationThread.hpp"
+#include "Components.hpp"
 #include "UIActions.hpp"
 #include "LogFile.hpp"
 #include "Simulator.hpp"
@@ -28,6 +31,9 @@ BatteryTimer::Process()
   const auto &battery = info.battery;
   const auto &external = info.external;
 
+  if (calculation_thread != nullptr)
+    calculation_thread->SetPowerScale(Power::GetComputeScale(info));
+
   /* Battery status - simulator only - for safety of battery data
      note: Simulator only - more important to keep running in your plane
   */
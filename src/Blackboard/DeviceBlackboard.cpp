@@ -16,6 +16,7 @@ DeviceBlackboard::DeviceBlackboard() noexcept
   // Clear the gps_info and calculated_info
   gps_info.Reset();
   calculated_info.Reset();
+  calculated_spare.Reset();
 
   // Set GPS assumed time to system time
   gps_info.UpdateClock();
@@ -180,6 +181,22 @@ DeviceBlackboard::ScheduleMerge() noexcept
   TriggerMergeThread();
 }
 
+int
+DeviceBlackboard::GetTotalEnergyVarioSource() const noexcept
+{
+  if (replay_data.alive || simulator_data.alive)
+    return -1;
+
+  /* the same order as in Merge(): the first device wins */
+  for (unsigned i = 0; i < per_device_data.size(); ++i) {
+    const NMEAInfo &basic = per_device_data[i];
+    if (basic.alive && basic.total_energy_vario_available)
+      return i;
+  }
+
+  return -1;
+}
+
 void
 DeviceBlackboard::Merge() noexcept
 {
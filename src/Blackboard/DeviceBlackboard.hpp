@@ -9,6 +9,7 @@
 #include "Device/Features.hpp"
 #include "thread/Mutex.hxx"
 #include "time/WrapClock.hpp"
+#include "util/TripleBuffer.hpp"
 
 #include <array>
 
@@ -55,12 +56,37 @@ class DeviceBlackboard
    */
   WrapClock real_clock, replay_clock;
 
+  /**
+   * Passes the calculated data from the thread which runs the
+   * #GlideComputer to the main thread, without holding #mutex while
+   * copying it.
+   */
+  TripleBuffer<DerivedInfo> calculated_snapshot;
+
+  /**
+   * The second buffer for the calculated data; the first one is
+   * BaseBlackboard::calculated_info.  WriteCalculated() fills the one
+   * which is not current without holding #mutex, and then only swaps
+   * #calculated.
+   */
+  DerivedInfo calculated_spare;
+
+  /**
+   * The current calculated data: points to either
+   * #calculated_info or #calculated_spare.  Protected by #mutex.
+   */
+  DerivedInfo *calculated = &calculated_info;
+
 public:
   Mutex mutex;
 
 public:
   DeviceBlackboard() noexcept;
 
+  const DerivedInfo &Calculated() const noexcept {
+    return *calculated;
+  }
+
   /**
    * Reads the given derived_info usually provided by the
    * GlideComputerBlackboard and saves it to the own Blackboard
@@ -68,7 +94,50 @@ public:
    * by the GlideComputerBlackboard
    */
   void ReadBlackboard(const DerivedInfo &derived_info) noexcept {
-    calculated_info = derived_info;
+    *calculated = derived_info;
+  }
+
+  /**
+   * Like ReadBlackboard(), but copies into the spare buffer first
+   * and locks #mutex only to make it current.  This may only be
+   * called by the thread which runs the #GlideComputer; the caller
+   * must not hold the mutex.
+   */
+  void WriteCalculated(const DerivedInfo &derived_info) noexcept {
+    /* only this thread modifies the pointer, so it can be read
+       without locking */
+    DerivedInfo &back = calculated == &calculated_info
+      ? calculated_spare
+      : calculated_info;
+    back = derived_info;
+
+    const std::lock_guard lock{mutex};
+    calculated = &back;
+  }
+
+  /**
+   * Publish a new version of the calculated data for
+   * AcquireCalculated().  This may only be called by the thread
+   * which runs the #GlideComputer; the caller must not hold the
+   * mutex.
+   */
+  void PublishCalculated(const DerivedInfo &derived_info) noexcept {
+    calculated_snapshot.GetBack() = derived_info;
+    calculated_snapshot.Publish();
+  }
+
+  /**
+   * Obtain the most recent version submitted by
+   * PublishCalculated().  This may only be called by the main
+   * thread; the caller does not need to hold the mutex.
+   *
+   * @return the new version (valid until the next call) or nullptr
+   * if nothing was published since the last call
+   */
+  const DerivedInfo *AcquireCalculated() noexcept {
+    return calculated_snapshot.Acquire()
+      ? &calculated_snapshot.GetFront()
+      : nullptr;
   }
 
   /**
@@ -136,6 +205,16 @@ public:
     return RealState(i).flarm.IsDetected();
   }
 
+  /**
+   * Which device supplied the total energy vario value merged into
+   * Basic()?  The caller must hold the mutex.
+   *
+   * @return the device index or -1 if the value does not come from a
+   * device (or there is none)
+   */
+  [[gnu::pure]]
+  int GetTotalEnergyVarioSource() const noexcept;
+
   void SetStartupLocation(const GeoPoint &loc, double alt) noexcept;
   void ProcessSimulation() noexcept;
   void StopReplay() noexcept;
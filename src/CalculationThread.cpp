@@ -7,6 +7,47 @@
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Components.hpp"
 #include "Hardware/CPU.hpp"
+#include "Profiler.hpp"
+#include "Computer/ContestCheckpoint.hpp"
+#include "LocalPath.hpp"
+#include "LogFile.hpp"
+#include "system/Path.hpp"
+#include "system/FileUtil.hpp"
+#include "io/FileReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+
+using namespace std::chrono;
+
+/**
+ * How often is the contest checkpoint written?
+ */
+static constexpr auto CONTEST_CHECKPOINT_INTERVAL = minutes{2};
+
+/**
+ * The maximum time per tick spent starting idle calculations.  A
+ * calculation which is already running is not interrupted, so the
+ * next fix may be delayed by this plus the duration of the slowest
+ * one.
+ */
+#ifdef KOBO
+static constexpr auto IDLE_BUDGET = milliseconds{400};
+#else
+static constexpr auto IDLE_BUDGET = milliseconds{200};
+#endif
+
+/**
+ * The idle calculations are postponed while new fixes are waiting,
+ * but not longer than this.
+ */
+static constexpr auto IDLE_MAX_DELAY = seconds{2};
+
+static AllocatedPath
+GetContestCheckpointPath() noexcept
+{
+  return AllocatedPath::Build(GetCachePath(), _T("contest.ckp"));
+}
 
 /**
  * Constructor of the CalculationThread class
@@ -24,7 +65,84 @@ CalculationThread::CalculationThread(GlideComputer &_glide_computer)
                 std::chrono::milliseconds{100},
                 std::chrono::milliseconds{50}),
    force(false),
-   glide_computer(_glide_computer) {
+   glide_computer(_glide_computer),
+   last_checkpoint(TimeStamp::Undefined()) {
+}
+
+void
+CalculationThread::LoadContestCheckpoint() noexcept
+try {
+  const auto path = GetContestCheckpointPath();
+  if (!File::Exists(path))
+    return;
+
+  FileReader file(path);
+  BufferedReader reader(file);
+  glide_computer.SetContestCheckpoint(::LoadContestCheckpoint(reader));
+} catch (...) {
+  LogError(std::current_exception(), "Failed to load contest checkpoint");
+}
+
+inline void
+CalculationThread::UpdateContestCheckpoint() noexcept
+{
+  const auto &basic = glide_computer.Basic();
+  const auto &calculated = glide_computer.Calculated();
+
+  if (!calculated.flight.flying ||
+      !glide_computer.GetComputerSettings().contest.enable) {
+    if (last_checkpoint.IsDefined()) {
+      /* landed: the flight is over, don't resume it */
+      last_checkpoint = TimeStamp::Undefined();
+      File::Delete(GetContestCheckpointPath());
+    }
+
+    return;
+  }
+
+  if (!basic.time_available ||
+      (last_checkpoint.IsDefined() && basic.time >= last_checkpoint &&
+       basic.time - last_checkpoint < CONTEST_CHECKPOINT_INTERVAL))
+    return;
+
+  last_checkpoint = basic.time;
+
+  try {
+    ContestCheckpoint checkpoint;
+    glide_computer.MakeContestCheckpoint(checkpoint);
+
+    FileOutputStream file(GetContestCheckpointPath());
+    BufferedOutputStream bos(file);
+    SaveContestCheckpoint(bos, checkpoint);
+    bos.Flush();
+    file.Commit();
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to save contest checkpoint");
+  }
+}
+
+inline bool
+CalculationThread::IsNewFixAvailable() const noexcept
+{
+  const std::lock_guard lock{device_blackboard->mutex};
+  return device_blackboard->Basic().location_available.Modified(glide_computer.Basic().location_available);
+}
+
+inline void
+CalculationThread::ProcessIdle() noexcept
+{
+  /* the fix calculations have priority: if the next fix has
+     already arrived, process it first (its Trigger() is already
+     pending) */
+  if (!idle_due.Check(IDLE_MAX_DELAY) && IsNewFixAvailable())
+    return;
+
+  if (glide_computer.ProcessIdle(false, steady_clock::now() + IDLE_BUDGET)) {
+    idle_due.Reset();
+    UpdateContestCheckpoint();
+  } else
+    /* the budget was exceeded: continue in the next tick */
+    Trigger();
 }
 
 void
@@ -41,12 +159,21 @@ CalculationThread::SetScreenDistanceMeters(double new_value)
   screen_distance_meters = new_value;
 }
 
+void
+CalculationThread::SetPowerScale(double new_value) noexcept
+{
+  const std::lock_guard lock{mutex};
+  power_scale = new_value;
+}
+
 /**
  * Main loop of the CalculationThread
  */
 void
 CalculationThread::Tick() noexcept
 {
+  const Profiler::ScopeTick profiler_tick{Profiler::Thread::CALCULATION};
+
 #ifdef HAVE_CPU_FREQUENCY
   const ScopeLockCPU cpu;
 #endif
@@ -64,8 +191,11 @@ CalculationThread::Tick() noexcept
   }
 
   bool force;
+  double power_scale;
   {
     const std::lock_guard lock{mutex};
+    power_scale = this->power_scale;
+
     // Copy settings from ComputerSettingsBlackboard to GlideComputerBlackboard
     glide_computer.ReadComputerSettings(settings_computer);
 
@@ -76,6 +206,7 @@ CalculationThread::Tick() noexcept
     }
   }
 
+  glide_computer.SetPowerScale(power_scale);
   glide_computer.Expire();
 
   bool do_idle = false;
@@ -87,20 +218,22 @@ CalculationThread::Tick() noexcept
   // values changed, so copy them back now: ONLY CALCULATED INFO
   // should be changed in DoCalculations, so we only need to write
   // that one back (otherwise we may write over new data)
-  {
-    const std::lock_guard lock{device_blackboard->mutex};
-    device_blackboard->ReadBlackboard(glide_computer.Calculated());
-  }
+  device_blackboard->WriteCalculated(glide_computer.Calculated());
+
+  /* the main thread picks this copy up without locking */
+  device_blackboard->PublishCalculated(glide_computer.Calculated());
 
   // if (new GPS data)
   if (gps_updated || force)
     // inform map new data is ready
     TriggerCalculatedUpdate();
 
-  if (do_idle) {
+  if (do_idle && !idle_due.IsDefined())
+    idle_due.Update();
+
+  if (idle_due.IsDefined())
     // do slow calculations last, to minimise latency
-    glide_computer.ProcessIdle();
-  }
+    ProcessIdle();
 }
 
 void
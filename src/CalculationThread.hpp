@@ -6,6 +6,8 @@
 #include "thread/WorkerThread.hpp"
 #include "thread/Mutex.hxx"
 #include "Computer/Settings.hpp"
+#include "time/Stamp.hpp"
+#include "time/PeriodClock.hpp"
 
 class GlideComputer;
 
@@ -16,8 +18,8 @@ class GlideComputer;
  */
 class CalculationThread final : public WorkerThread {
   /**
-   * This mutex protects #settings_computer and
-   * #screen_distance_meters.
+   * This mutex protects #settings_computer,
+   * #screen_distance_meters and #power_scale.
    */
   Mutex mutex;
 
@@ -32,15 +34,39 @@ class CalculationThread final : public WorkerThread {
 
   double screen_distance_meters;
 
+  /**
+   * The fraction of the nominal contest solver rate allowed by the
+   * power governor, see Power::GetComputeScale().
+   */
+  double power_scale = 1;
+
   /** Pointer to the GlideComputer that should be used */
   GlideComputer &glide_computer;
 
+  /**
+   * The time of the last contest checkpoint; invalid if none was
+   * written during this flight.
+   */
+  TimeStamp last_checkpoint;
+
+  /**
+   * When did the idle calculations become due?  Undefined if they
+   * are not due.
+   */
+  PeriodClock idle_due;
+
 public:
   CalculationThread(GlideComputer &_glide_computer);
 
   void SetComputerSettings(const ComputerSettings &new_value);
   void SetScreenDistanceMeters(double new_value);
 
+  /**
+   * @param new_value the fraction of the nominal contest solver
+   * rate, between 0 and 1
+   */
+  void SetPowerScale(double new_value) noexcept;
+
   /**
    * Throws on error.
    */
@@ -51,6 +77,34 @@ public:
 
   void ForceTrigger();
 
+  /**
+   * Load the contest checkpoint written before the program was
+   * restarted during the flight, if there is one.  Call this before
+   * Start().
+   */
+  void LoadContestCheckpoint() noexcept;
+
+private:
+  /**
+   * Has the device thread received a fix which has not yet been
+   * processed?
+   */
+  [[gnu::pure]]
+  bool IsNewFixAvailable() const noexcept;
+
+  /**
+   * Run the idle calculations within the time budget.  They are
+   * postponed while new fixes are waiting, and continued in the next
+   * tick if the budget is exceeded.
+   */
+  void ProcessIdle() noexcept;
+
+  /**
+   * Save a contest checkpoint periodically while flying, and delete
+   * it after landing.
+   */
+  void UpdateContestCheckpoint() noexcept;
+
 protected:
   void Tick() noexcept override;
 };
@@ -94,6 +94,22 @@ CloudClientContainer::Insert(CloudClient &client)
   rtree.insert(client.shared_from_this());
 }
 
+void
+CloudClientContainer::Replay(CloudClient &&c)
+{
+  if (auto *client = Find(c.key); client != nullptr) {
+    Refresh(*client, c.address, c.location, c.altitude);
+    client->stamp = c.stamp;
+    return;
+  }
+
+  auto client = std::make_shared<CloudClient>(std::move(c));
+  Insert(*client);
+
+  if (client->id >= next_id)
+    next_id = client->id + 1;
+}
+
 void
 CloudClientContainer::Remove(CloudClient &client)
 {
@@ -230,6 +230,13 @@ public:
 
   void Insert(CloudClient &client);
 
+  /**
+   * Apply a client state which was loaded from a #CloudJournal:
+   * update the existing client with the same key, or insert a new
+   * one with the recorded id.
+   */
+  void Replay(CloudClient &&client);
+
   /**
    * Remove a #CloudClient and its data.  Be careful - the given reference
    * is invalidated, unless the caller holds another #CloudClientPtr.
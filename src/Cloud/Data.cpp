@@ -14,7 +14,7 @@ using std::cerr;
 using std::endl;
 
 static constexpr uint32_t CLOUD_MAGIC = 0x5753f60f;
-static constexpr uint32_t CLOUD_VERSION = 1;
+static constexpr uint32_t CLOUD_VERSION = 2;
 
 void
 CloudData::DumpClients()
@@ -35,6 +35,7 @@ CloudData::Save(Serialiser &s) const
 {
   s.Write32(CLOUD_MAGIC);
   s.Write32(CLOUD_VERSION);
+  s.Write32(generation);
   clients.Save(s);
   s.Write8(1);
   thermals.Save(s);
@@ -47,9 +48,13 @@ CloudData::Load(Deserialiser &s)
   if (s.Read32() != CLOUD_MAGIC)
     throw std::runtime_error("Bad magic");
 
-  if (s.Read32() != CLOUD_VERSION)
+  const uint32_t version = s.Read32();
+  if (version < 1 || version > CLOUD_VERSION)
     throw std::runtime_error("Bad version");
 
+  /* version 1 did not have a journal */
+  generation = version >= 2 ? s.Read32() : 0;
+
   clients.Load(s);
 
   if (s.Read8() != 0) {
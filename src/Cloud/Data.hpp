@@ -13,6 +13,12 @@ struct CloudData {
   CloudClientContainer clients;
   CloudThermalContainer thermals;
 
+  /**
+   * The generation of the first #CloudJournal whose records are not
+   * contained in this object.
+   */
+  uint32_t generation = 0;
+
   void DumpClients();
 
   void Save(Serialiser &s) const;
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Journal.hpp"
+#include "Data.hpp"
+#include "Serialiser.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/FileReader.hxx"
+#include "util/Exception.hxx"
+
+#include <iostream>
+
+static constexpr uint32_t JOURNAL_MAGIC = 0x5753f610;
+
+enum class JournalRecord : uint8_t {
+  FIX = 1,
+  THERMAL = 2,
+};
+
+/**
+ * The buffer size for one record; it is flushed with one write()
+ * call.
+ */
+static constexpr size_t RECORD_BUFFER_SIZE = 512;
+
+CloudJournal::CloudJournal() noexcept = default;
+
+CloudJournal::~CloudJournal() noexcept = default;
+
+void
+CloudJournal::Open(Path path, uint32_t _generation)
+{
+  Close();
+
+  auto f = std::make_unique<FileOutputStream>(path,
+                                              FileOutputStream::Mode::CREATE_VISIBLE);
+
+  Serialiser s(*f, RECORD_BUFFER_SIZE);
+  s.Write32(JOURNAL_MAGIC);
+  s.Write32(_generation);
+  s.Flush();
+
+  file = std::move(f);
+  generation = _generation;
+}
+
+void
+CloudJournal::Close() noexcept
+{
+  if (file == nullptr)
+    return;
+
+  try {
+    file->Commit();
+  } catch (...) {
+    std::cerr << GetFullMessage(std::current_exception()) << std::endl;
+  }
+
+  file.reset();
+}
+
+template<typename F>
+void
+CloudJournal::Append(uint8_t type, F &&f) noexcept
+{
+  if (file == nullptr)
+    return;
+
+  try {
+    Serialiser s(*file, RECORD_BUFFER_SIZE);
+    s.Write8(type);
+    f(s);
+    s.Flush();
+  } catch (...) {
+    std::cerr << "Journal disabled: "
+              << GetFullMessage(std::current_exception()) << std::endl;
+    file.reset();
+  }
+}
+
+void
+CloudJournal::AppendFix(const CloudClient &client) noexcept
+{
+  Append(uint8_t(JournalRecord::FIX), [&client](Serialiser &s){
+    client.Save(s);
+  });
+}
+
+void
+CloudJournal::AppendThermal(const CloudThermal &thermal) noexcept
+{
+  Append(uint8_t(JournalRecord::THERMAL), [&thermal](Serialiser &s){
+    thermal.Save(s);
+  });
+}
+
+CloudJournalInfo
+ReplayCloudJournal(CloudData &data, Path path)
+{
+  FileReader fr(path);
+  Deserialiser s(fr);
+
+  if (s.Read32() != JOURNAL_MAGIC)
+    throw std::runtime_error("Bad journal magic");
+
+  CloudJournalInfo info{s.Read32(), 0};
+  if (info.generation < data.generation)
+    /* already contained in the snapshot */
+    return info;
+
+  try {
+    while (!s.Read().empty() || s.Fill(true)) {
+      switch (JournalRecord(s.Read8())) {
+      case JournalRecord::FIX:
+        data.clients.Replay(CloudClient::Load(s));
+        break;
+
+      case JournalRecord::THERMAL:
+        {
+          auto thermal = std::make_shared<CloudThermal>(CloudThermal::Load(s));
+          data.thermals.Insert(*thermal);
+        }
+        break;
+
+      default:
+        throw std::runtime_error("Bad journal record");
+      }
+
+      ++info.n_records;
+    }
+  } catch (...) {
+    /* the rest of this file was not written completely */
+    std::cerr << "Journal " << path.c_str() << " truncated after "
+              << info.n_records << " records: "
+              << GetFullMessage(std::current_exception()) << std::endl;
+  }
+
+  return info;
+}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <memory>
+
+#include <stdint.h>
+
+class Path;
+class FileOutputStream;
+struct CloudData;
+struct CloudClient;
+struct CloudThermal;
+
+/**
+ * An append-only log of the changes made to #CloudData since the
+ * last snapshot.  Each record is written to the kernel with a single
+ * write() call, so a crashing server loses nothing that was
+ * journalled.
+ *
+ * Each journal file has a generation number.  A snapshot written
+ * with #CloudData::generation contains all journals with a lower
+ * generation; those are skipped by ReplayCloudJournal().
+ *
+ * This class is not thread-safe; it is protected by the same mutex
+ * as the #CloudData.
+ */
+class CloudJournal {
+  std::unique_ptr<FileOutputStream> file;
+
+  uint32_t generation;
+
+public:
+  CloudJournal() noexcept;
+  ~CloudJournal() noexcept;
+
+  CloudJournal(const CloudJournal &) = delete;
+  CloudJournal &operator=(const CloudJournal &) = delete;
+
+  bool IsOpen() const noexcept {
+    return file != nullptr;
+  }
+
+  uint32_t GetGeneration() const noexcept {
+    return generation;
+  }
+
+  /**
+   * Create a new (empty) journal file, replacing an existing one.
+   *
+   * Throws on error.
+   */
+  void Open(Path path, uint32_t generation);
+
+  void Close() noexcept;
+
+  /**
+   * Record the current state of a client after it has submitted a
+   * fix.
+   *
+   * Errors are logged, and the journal is closed.
+   */
+  void AppendFix(const CloudClient &client) noexcept;
+
+  /**
+   * Record a new thermal.
+   *
+   * Errors are logged, and the journal is closed.
+   */
+  void AppendThermal(const CloudThermal &thermal) noexcept;
+
+private:
+  template<typename F>
+  void Append(uint8_t type, F &&f) noexcept;
+};
+
+struct CloudJournalInfo {
+  uint32_t generation;
+
+  /**
+   * The number of records which were applied.
+   */
+  unsigned n_records;
+};
+
+/**
+ * Apply all records of the given journal file to #data, unless it
+ * is older than #CloudData::generation.  A truncated record at the
+ * end (from a crash during write()) is ignored.
+ *
+ * Throws on error.
+ */
+CloudJournalInfo
+ReplayCloudJournal(CloudData &data, Path path);
@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "Data.hpp"
+#include "Journal.hpp"
 #include "Dump.hpp"
 #include "Sender.hpp"
 #include "Serialiser.hpp"
@@ -11,17 +12,24 @@
 #include "event/Loop.hxx"
 #include "event/CoarseTimerEvent.hxx"
 #include "event/SignalMonitor.hxx"
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
 #include "net/IPv4Address.hxx"
 #include "io/FileOutputStream.hxx"
 #include "io/FileReader.hxx"
+#include "system/FileUtil.hpp"
 #include "util/PrintException.hxx"
 #include "util/Exception.hxx"
 #include "util/Compiler.h"
 #include "util/ScopeExit.hxx"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <forward_list>
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 #include <signal.h>
 
@@ -29,6 +37,7 @@
 static constexpr double TRAFFIC_RANGE = 50000;
 static constexpr double THERMAL_RANGE = 50000;
 
+static constexpr std::chrono::steady_clock::duration MAX_CLIENT_AGE = std::chrono::minutes(10);
 static constexpr std::chrono::steady_clock::duration MAX_TRAFFIC_AGE = std::chrono::minutes(15);
 static constexpr std::chrono::steady_clock::duration MAX_THERMAL_AGE = std::chrono::minutes(30);
 
@@ -38,55 +47,98 @@ using std::cout;
 using std::cerr;
 using std::endl;
 
-class CloudServer final
-  : public SkyLinesTracking::Server, CloudData
+/**
+ * The data shared by all #CloudServer instances.
+ */
+struct SharedCloudData : CloudData {
+  /**
+   * Protects the containers.  It is held only while they are
+   * accessed; responses are sent after releasing it.
+   */
+  Mutex mutex;
+
+  /**
+   * Records all changes to the containers.  Protected by #mutex.
+   */
+  CloudJournal journal;
+};
+
+static void
+Expire(CloudData &data, std::chrono::steady_clock::time_point now) noexcept
 {
-  const AllocatedPath db_path;
+  data.clients.Expire(now - MAX_CLIENT_AGE);
+  data.thermals.Expire(now - MAX_THERMAL_AGE);
+}
 
-  CoarseTimerEvent save_timer, expire_timer;
+static void
+WriteSnapshot(const CloudData &data, Path path)
+{
+  FileOutputStream fos(path);
 
-public:
-  CloudServer(AllocatedPath &&_db_path, EventLoop &event_loop,
-              SocketAddress bind_address)
-    :SkyLinesTracking::Server(event_loop, bind_address),
-     db_path(std::move(_db_path)),
-     save_timer(event_loop, BIND_THIS_METHOD(OnSaveTimer)),
-     expire_timer(event_loop, BIND_THIS_METHOD(OnExpireTimer))
   {
-#ifndef _WIN32
-    SignalMonitorRegister(SIGINT, BIND_THIS_METHOD(OnQuitSignal));
-    SignalMonitorRegister(SIGTERM, BIND_THIS_METHOD(OnQuitSignal));
-    SignalMonitorRegister(SIGQUIT, BIND_THIS_METHOD(OnQuitSignal));
+    Serialiser s(fos);
+    data.Save(s);
+    s.Flush();
+  }
 
-    SignalMonitorRegister(SIGHUP, BIND_THIS_METHOD(OnReloadSignal));
-    SignalMonitorRegister(SIGUSR1, BIND_THIS_METHOD(OnDumpSignal));
-#endif
+  fos.Commit();
+}
 
-    ScheduleSave();
+/**
+ * Merge a rotated journal into the snapshot file and delete the
+ * journal.  This works on a private copy loaded from the files and
+ * does not touch the live data.
+ *
+ * Throws on error.
+ */
+static void
+Compact(Path db_path, Path journal_path)
+{
+  /* allocated on the heap because the client container is large */
+  auto data = std::make_unique<CloudData>();
+
+  if (File::Exists(db_path)) {
+    FileReader fr(db_path);
+    Deserialiser s(fr);
+    data->Load(s);
   }
 
-  void Load();
-  void Save();
+  const auto info = ReplayCloudJournal(*data, journal_path);
 
-private:
-  void OnSaveTimer() noexcept {
-    Save();
-    ScheduleSave();
-  }
+  Expire(*data, std::chrono::steady_clock::now());
+  data->generation = std::max(data->generation, info.generation + 1);
 
-  void ScheduleSave() {
-    save_timer.Schedule(std::chrono::minutes(1));
-  }
+  WriteSnapshot(*data, db_path);
+  File::Delete(journal_path);
+}
 
-  void OnExpireTimer() noexcept {
-    clients.Expire(GetEventLoop().SteadyNow() - std::chrono::minutes(10));
-    if (!clients.empty())
-      ScheduleExpire();
-  }
+/**
+ * Handles the packets received on one UDP socket.  With more than one
+ * thread, each thread has its own instance bound to the same port
+ * with SO_REUSEPORT, and the kernel distributes the clients over
+ * them.
+ */
+class CloudServer final : public SkyLinesTracking::Server {
+  SharedCloudData &data;
+
+  /**
+   * A client which shall receive a packet.
+   */
+  struct Recipient {
+    StaticSocketAddress address;
+    uint64_t key;
+
+    Recipient(SocketAddress _address, uint64_t _key) noexcept
+      :key(_key) {
+      address = _address;
+    }
+  };
 
-  void ScheduleExpire() {
-    expire_timer.Schedule(std::chrono::minutes(5));
-  }
+public:
+  CloudServer(SharedCloudData &_data, EventLoop &event_loop,
+              SocketAddress bind_address, bool reuse_port)
+    :SkyLinesTracking::Server(event_loop, bind_address, reuse_port),
+     data(_data) {}
 
 protected:
   /* virtual methods from class SkyLinesTracking::Server */
@@ -125,20 +177,6 @@ protected:
     cerr << GetFullMessage(e) << endl;
     GetEventLoop().Break();
   }
-
-#ifndef _WIN32
-  void OnQuitSignal() noexcept {
-    GetEventLoop().Break();
-  }
-
-  void OnReloadSignal() noexcept {
-    Save();
-  }
-
-  void OnDumpSignal() noexcept {
-    DumpClients();
-  }
-#endif
 };
 
 void
@@ -148,44 +186,62 @@ CloudServer::OnFix(const Client &c,
 {
   (void)time_of_day; // TODO: use this parameter
 
-  CloudClient *client;
-  if (location.IsValid()) {
-    bool was_empty = clients.empty();
+  std::vector<Recipient> recipients;
+  unsigned id;
+  GeoPoint client_location;
+  int client_altitude;
 
-    client = &clients.Make(c.address, c.key, location, altitude);
-
-    cout << "FIX\t"
-         << client->address << '\t'
-         << std::hex << client->key << std::dec << '\t'
-         << client->id << '\t'
-         << client->location << '\t'
-         << client->altitude << 'm'
-         << endl;
+  {
+    const std::lock_guard lock{data.mutex};
+    auto &clients = data.clients;
+
+    CloudClient *client;
+    if (location.IsValid()) {
+      client = &clients.Make(c.address, c.key, location, altitude);
+
+      cout << "FIX\t"
+           << client->address << '\t'
+           << std::hex << client->key << std::dec << '\t'
+           << client->id << '\t'
+           << client->location << '\t'
+           << client->altitude << 'm'
+           << endl;
+    } else {
+      client = clients.Find(c.key);
+      if (client == nullptr)
+        return;
 
-    if (was_empty)
-      ScheduleExpire();
-  } else {
-    client = clients.Find(c.key);
-    if (client != nullptr)
       clients.Refresh(*client, c.address);
+    }
+
+    data.journal.AppendFix(*client);
+
+    id = client->id;
+    client_location = client->location;
+    client_altitude = client->altitude;
+
+    /* send this new traffic location to all interested clients
+       immediately */
+    const auto now = std::chrono::steady_clock::now();
+    for (const auto &i : clients.QueryWithinRange(client_location,
+                                                  TRAFFIC_RANGE)) {
+      if (i->key == c.key)
+        /* ignore this client's own submissions - he knows them
+           already */
+        continue;
+
+      if (now > i->wants_traffic)
+        /* not interested (anymore) */
+        continue;
+
+      recipients.emplace_back(i->address, i->key);
+    }
   }
 
-  /* send this new traffic location to all interested clients
-     immediately */
-  const auto now = std::chrono::steady_clock::now();
-  for (const auto &i : clients.QueryWithinRange(location, TRAFFIC_RANGE)) {
-    if (i->key == c.key)
-      /* ignore this client's own submissions - he knows them
-         already */
-      continue;
-
-    if (now > i->wants_traffic)
-      /* not interested (anymore) */
-      continue;
-
-    TrafficResponseSender s(*this, i->address, i->key);
-    s.Add(client->id, 0, //TODO: time?
-          client->location, client->altitude);
+  for (const auto &i : recipients) {
+    TrafficResponseSender s(*this, i.address, i.key);
+    s.Add(id, 0, //TODO: time?
+          client_location, client_altitude);
     s.Flush();
   }
 }
@@ -197,35 +253,42 @@ CloudServer::OnTrafficRequest(const Client &c, bool near)
     /* "near" is the only selection flag we know */
     return;
 
-  auto *client = clients.Find(c.key);
-  if (client == nullptr)
-    /* we don't send our data to clients who didn't sent anything to
-       us yet */
-    return;
+  TrafficResponseSender s(*this, c.address, c.key);
+
+  {
+    const std::lock_guard lock{data.mutex};
+    auto &clients = data.clients;
 
-  const auto now = std::chrono::steady_clock::now();
+    auto *client = clients.Find(c.key);
+    if (client == nullptr)
+      /* we don't send our data to clients who didn't sent anything to
+         us yet */
+      return;
 
-  client->wants_traffic = now + REQUEST_EXPIRY;
+    const auto now = std::chrono::steady_clock::now();
 
-  const auto min_stamp = now - MAX_TRAFFIC_AGE;
+    client->wants_traffic = now + REQUEST_EXPIRY;
 
-  TrafficResponseSender s(*this, c.address, c.key);
+    const auto min_stamp = now - MAX_TRAFFIC_AGE;
 
-  unsigned n = 0;
-  for (const auto &traffic : clients.QueryWithinRange(client->location,
-                                                      TRAFFIC_RANGE)) {
-    if (traffic.get() == client)
-      continue;
+    unsigned n = 0;
+    for (const auto &traffic : clients.QueryWithinRange(client->location,
+                                                        TRAFFIC_RANGE)) {
+      if (traffic.get() == client)
+        continue;
 
-    if (traffic->stamp < min_stamp)
-      /* don't send stale traffic, it's probably not there anymore */
-      continue;
+      if (traffic->stamp < min_stamp)
+        /* don't send stale traffic, it's probably not there anymore */
+        continue;
 
-    s.Add(traffic->id, 0, //TODO: time?
-          traffic->location, traffic->altitude);
+      /* this may send a full packet while the mutex is locked, but
+         at most once, because the loop stops at 64 */
+      s.Add(traffic->id, 0, //TODO: time?
+            traffic->location, traffic->altitude);
 
-    if (++n > 64)
-      break;
+      if (++n > 64)
+        break;
+    }
   }
 
   s.Flush();
@@ -239,7 +302,9 @@ CloudServer::OnWaveSubmit(const Client &c,
                           int top_altitude,
                           double lift)
 {
-  auto *client = clients.Find(c.key);
+  const std::lock_guard lock{data.mutex};
+
+  auto *client = data.clients.Find(c.key);
   if (client == nullptr)
     /* we don't trust the client if he didn't sent anything to us
        yet */
@@ -265,42 +330,56 @@ CloudServer::OnThermalSubmit(const Client &c,
                              int top_altitude,
                              double lift)
 {
-  auto *client = clients.Find(c.key);
-  if (client == nullptr)
-    /* we don't trust the client if he didn't sent anything to us
-       yet */
-    return;
+  std::vector<Recipient> recipients;
+  SkyLinesTracking::Thermal packed;
 
-  cout << "THERMAL\t"
-       << client->address << '\t'
-       << std::hex << client->key << std::dec << '\t'
-       << client->id << '\t'
-       << top_location << '\t'
-       << bottom_altitude << '-' << top_altitude << "m\t"
-       << lift << "m/s"
-       << endl;
+  {
+    const std::lock_guard lock{data.mutex};
+    auto &clients = data.clients;
+
+    auto *client = clients.Find(c.key);
+    if (client == nullptr)
+      /* we don't trust the client if he didn't sent anything to us
+         yet */
+      return;
+
+    cout << "THERMAL\t"
+         << client->address << '\t'
+         << std::hex << client->key << std::dec << '\t'
+         << client->id << '\t'
+         << top_location << '\t'
+         << bottom_altitude << '-' << top_altitude << "m\t"
+         << lift << "m/s"
+         << endl;
+
+    const auto &thermal =
+      data.thermals.Make(c.key,
+                         AGeoPoint(bottom_location, bottom_altitude),
+                         AGeoPoint(top_location, top_altitude),
+                         lift);
+    data.journal.AppendThermal(thermal);
+    packed = thermal.Pack();
+
+    /* send this new thermal to all interested clients immediately */
+    const auto now = std::chrono::steady_clock::now();
+    for (const auto &i : clients.QueryWithinRange(bottom_location,
+                                                  THERMAL_RANGE)) {
+      if (i->key == c.key)
+        /* ignore this client's own submissions - he knows them
+           already */
+        continue;
+
+      if (now > i->wants_thermals)
+        /* not interested (anymore) */
+        continue;
+
+      recipients.emplace_back(i->address, i->key);
+    }
+  }
 
-  const auto &thermal =
-    thermals.Make(c.key,
-                  AGeoPoint(bottom_location, bottom_altitude),
-                  AGeoPoint(top_location, top_altitude),
-                  lift);
-
-  /* send this new thermal to all interested clients immediately */
-  const auto now = std::chrono::steady_clock::now();
-  for (const auto &i : clients.QueryWithinRange(bottom_location,
-                                                THERMAL_RANGE)) {
-    if (i->key == c.key)
-      /* ignore this client's own submissions - he knows them
-         already */
-      continue;
-
-    if (now > i->wants_thermals)
-      /* not interested (anymore) */
-      continue;
-
-    ThermalResponseSender s(*this, i->address, i->key);
-    s.Add(thermal.Pack());
+  for (const auto &i : recipients) {
+    ThermalResponseSender s(*this, i.address, i.key);
+    s.Add(packed);
     s.Flush();
   }
 }
@@ -308,92 +387,387 @@ CloudServer::OnThermalSubmit(const Client &c,
 void
 CloudServer::OnThermalRequest(const Client &c)
 {
-  auto *client = clients.Find(c.key);
-  if (client == nullptr)
-    /* we don't send our data to clients who didn't sent anything to
-       us yet */
-    return;
+  std::vector<SkyLinesTracking::Thermal> result;
+
+  {
+    const std::lock_guard lock{data.mutex};
 
-  const auto now = std::chrono::steady_clock::now();
+    auto *client = data.clients.Find(c.key);
+    if (client == nullptr)
+      /* we don't send our data to clients who didn't sent anything to
+         us yet */
+      return;
 
-  client->wants_thermals = now + REQUEST_EXPIRY;
+    const auto now = std::chrono::steady_clock::now();
 
-  const auto min_time = now - MAX_THERMAL_AGE;
+    client->wants_thermals = now + REQUEST_EXPIRY;
 
-  ThermalResponseSender s(*this, c.address, c.key);
+    const auto min_time = now - MAX_THERMAL_AGE;
 
-  unsigned n = 0;
-  for (const auto &thermal : thermals.QueryWithinRange(client->location,
-                                                       THERMAL_RANGE)) {
-    if (thermal->client_key == c.key)
-      /* ignore this client's own submissions - he knows them
-         already */
-      continue;
+    for (const auto &thermal : data.thermals.QueryWithinRange(client->location,
+                                                              THERMAL_RANGE)) {
+      if (thermal->client_key == c.key)
+        /* ignore this client's own submissions - he knows them
+           already */
+        continue;
 
-    if (thermal->time < min_time)
-      /* don't send old thermals, they're useless */
-      continue;
+      if (thermal->time < min_time)
+        /* don't send old thermals, they're useless */
+        continue;
 
-    s.Add(thermal->Pack());
+      result.push_back(thermal->Pack());
 
-    if (++n > 256)
-      break;
+      if (result.size() > 256)
+        break;
+    }
   }
 
+  ThermalResponseSender s(*this, c.address, c.key);
+  for (const auto &thermal : result)
+    s.Add(thermal);
   s.Flush();
 }
 
+/**
+ * An additional #CloudServer with its own thread and #EventLoop.
+ */
+class CloudWorker final : Thread {
+  EventLoop event_loop{ThreadId::Null()};
+  CloudServer server;
+
+public:
+  CloudWorker(SharedCloudData &data, SocketAddress bind_address)
+    :Thread("CloudWorker"),
+     server(data, event_loop, bind_address, true) {}
+
+  using Thread::Start;
+
+  void Stop() noexcept {
+    event_loop.InjectBreak();
+    Join();
+  }
+
+protected:
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    event_loop.SetAlive(true);
+    event_loop.Run();
+    event_loop.SetAlive(false);
+  }
+};
+
+/**
+ * Runs Compact() in a separate thread, so saving does not block
+ * packet handling.
+ */
+class CloudCompactor final : public Thread {
+  const Path db_path, journal_path;
+
+  std::atomic<bool> done{false};
+
+public:
+  CloudCompactor(Path _db_path, Path _journal_path) noexcept
+    :Thread("CloudCompactor"),
+     db_path(_db_path), journal_path(_journal_path) {}
+
+  bool IsDone() const noexcept {
+    return done.load(std::memory_order_acquire);
+  }
+
+  void Start() {
+    done.store(false, std::memory_order_relaxed);
+    Thread::Start();
+  }
+
+protected:
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    try {
+      Compact(db_path, journal_path);
+    } catch (...) {
+      cerr << "Failed to save data" << endl;
+      PrintException(std::current_exception());
+    }
+
+    done.store(true, std::memory_order_release);
+  }
+};
+
+/**
+ * Owns the data, the worker threads and the main thread's
+ * #CloudServer, and runs the periodic tasks.
+ */
+class CloudService final {
+  const AllocatedPath db_path;
+
+  /**
+   * The #CloudJournal which is being written, and the one which has
+   * been rotated out and is being merged into the snapshot.
+   */
+  const AllocatedPath journal_path, old_journal_path;
+
+  SharedCloudData data;
+
+  CloudServer server;
+
+  std::forward_list<CloudWorker> workers;
+
+  CloudCompactor compactor;
+
+  CoarseTimerEvent save_timer, expire_timer;
+
+public:
+  CloudService(AllocatedPath &&_db_path, EventLoop &event_loop,
+               SocketAddress bind_address, unsigned n_threads)
+    :db_path(std::move(_db_path)),
+     journal_path(db_path + ".journal"),
+     old_journal_path(db_path + ".journal.old"),
+     server(data, event_loop, bind_address, n_threads > 1),
+     compactor(db_path, old_journal_path),
+     save_timer(event_loop, BIND_THIS_METHOD(OnSaveTimer)),
+     expire_timer(event_loop, BIND_THIS_METHOD(OnExpireTimer))
+  {
+    for (unsigned i = 1; i < n_threads; ++i)
+      workers.emplace_front(data, bind_address);
+
+#ifndef _WIN32
+    SignalMonitorRegister(SIGINT, BIND_THIS_METHOD(OnQuitSignal));
+    SignalMonitorRegister(SIGTERM, BIND_THIS_METHOD(OnQuitSignal));
+    SignalMonitorRegister(SIGQUIT, BIND_THIS_METHOD(OnQuitSignal));
+
+    SignalMonitorRegister(SIGHUP, BIND_THIS_METHOD(OnReloadSignal));
+    SignalMonitorRegister(SIGUSR1, BIND_THIS_METHOD(OnDumpSignal));
+#endif
+
+    ScheduleSave();
+    ScheduleExpire();
+  }
+
+  auto &GetEventLoop() const noexcept {
+    return save_timer.GetEventLoop();
+  }
+
+  /**
+   * Load the snapshot, replay the journals and open a new journal.
+   * Errors are logged.
+   */
+  void Load() noexcept;
+
+  /**
+   * Rotate the journal and merge it into the snapshot in the
+   * compactor thread.
+   */
+  void Save() noexcept;
+
+  /**
+   * Like Save(), but synchronous; to be called after the workers
+   * have been stopped.
+   */
+  void Flush();
+
+  void StartWorkers() {
+    for (auto &worker : workers)
+      worker.Start();
+  }
+
+  void StopWorkers() noexcept {
+    for (auto &worker : workers)
+      worker.Stop();
+  }
+
+private:
+  /**
+   * Move the current journal to #old_journal_path and start a new
+   * one.
+   *
+   * Throws on error.
+   */
+  void RotateJournal();
+
+  void OnSaveTimer() noexcept {
+    Save();
+    ScheduleSave();
+  }
+
+  void ScheduleSave() {
+    save_timer.Schedule(std::chrono::minutes(1));
+  }
+
+  void OnExpireTimer() noexcept {
+    const auto now = GetEventLoop().SteadyNow();
+
+    {
+      const std::lock_guard lock{data.mutex};
+      Expire(data, now);
+    }
+
+    ScheduleExpire();
+  }
+
+  void ScheduleExpire() {
+    expire_timer.Schedule(std::chrono::minutes(5));
+  }
+
+#ifndef _WIN32
+  void OnQuitSignal() noexcept {
+    GetEventLoop().Break();
+  }
+
+  void OnReloadSignal() noexcept {
+    Save();
+  }
+
+  void OnDumpSignal() noexcept {
+    const std::lock_guard lock{data.mutex};
+    data.DumpClients();
+  }
+#endif
+};
+
+void
+CloudService::Load() noexcept
+{
+  const std::lock_guard lock{data.mutex};
+
+  try {
+    if (File::Exists(db_path)) {
+      FileReader fr(db_path);
+      Deserialiser s(fr);
+      data.Load(s);
+    }
+
+    /* records which were not merged into the snapshot before the
+       server was stopped */
+    unsigned n_records = 0;
+    uint32_t generation = data.generation;
+    for (const Path path : {Path{old_journal_path}, Path{journal_path}}) {
+      if (!File::Exists(path))
+        continue;
+
+      const auto info = ReplayCloudJournal(data, path);
+      n_records += info.n_records;
+      generation = std::max(generation, info.generation + 1);
+    }
+
+    if (n_records > 0) {
+      cout << "Replayed " << n_records << " journal records" << endl;
+      data.generation = generation;
+      WriteSnapshot(data, db_path);
+    }
+
+    File::Delete(old_journal_path);
+  } catch (...) {
+    cerr << "Failed to load database" << endl;
+    PrintException(std::current_exception());
+  }
+
+  try {
+    data.journal.Open(journal_path, data.generation);
+  } catch (...) {
+    PrintException(std::current_exception());
+  }
+}
+
 void
-CloudServer::Load()
+CloudService::RotateJournal()
 {
-  FileReader fr(db_path);
-  Deserialiser s(fr);
-  CloudData::Load(s);
+  const std::lock_guard lock{data.mutex};
+
+  if (!data.journal.IsOpen())
+    /* the journal was disabled after an error; the snapshot would
+       miss the changes since then, but it is the best we have */
+    return;
+
+  /* the open file descriptor follows the rename; nothing gets
+     appended to it after the mutex is released */
+  if (!File::Rename(journal_path, old_journal_path))
+    throw std::runtime_error("Failed to rename journal");
+
+  const uint32_t generation = data.journal.GetGeneration() + 1;
+  data.journal.Close();
+  data.journal.Open(journal_path, generation);
 }
 
 void
-CloudServer::Save()
+CloudService::Save() noexcept
 {
-  cout << "Saving data to " << db_path.c_str() << endl;
+  if (compactor.IsDefined()) {
+    if (!compactor.IsDone())
+      /* still busy with the previous one */
+      return;
 
-  FileOutputStream fos(db_path);
+    compactor.Join();
+  }
 
-  {
-    Serialiser s(fos);
-    CloudData::Save(s);
-    s.Flush();
+  cout << "Saving data to " << db_path.c_str() << endl;
+
+  try {
+    /* a journal which could not be merged last time is retried
+       before rotating again */
+    if (!File::Exists(old_journal_path))
+      RotateJournal();
+
+    if (File::Exists(old_journal_path))
+      compactor.Start();
+  } catch (...) {
+    cerr << "Failed to save data" << endl;
+    PrintException(std::current_exception());
   }
+}
 
-  fos.Commit();
+void
+CloudService::Flush()
+{
+  if (compactor.IsDefined())
+    compactor.Join();
+
+  cout << "Saving data to " << db_path.c_str() << endl;
+
+  if (!File::Exists(old_journal_path))
+    RotateJournal();
+
+  if (File::Exists(old_journal_path))
+    Compact(db_path, old_journal_path);
 }
 
 int
 main(int argc, char **argv)
 try {
-  if (argc != 2) {
-    cerr << "Usage: " << argv[0] << " DBPATH" << endl;
+  if (argc < 2 || argc > 3) {
+    cerr << "Usage: " << argv[0] << " DBPATH [THREADS]" << endl;
     return EXIT_FAILURE;
   }
 
   const Path db_path(argv[1]);
 
+  unsigned n_threads = 1;
+  if (argc > 2) {
+    char *endptr;
+    n_threads = strtoul(argv[2], &endptr, 10);
+    if (endptr == argv[2] || *endptr != 0 || n_threads < 1 ||
+        n_threads > 64) {
+      cerr << "Invalid number of threads: " << argv[2] << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   EventLoop event_loop;
   SignalMonitorInit(event_loop);
   AtScopeExit() { SignalMonitorFinish(); };
 
-  CloudServer server(db_path, event_loop,
-                     IPv4Address(CloudServer::GetDefaultPort()));
+  CloudService service(db_path, event_loop,
+                       IPv4Address(SkyLinesTracking::Server::GetDefaultPort()),
+                       n_threads);
 
-  try {
-    server.Load();
-  } catch (const std::runtime_error &e) {
-    cerr << "Failed to load database" << endl;
-    PrintException(e);
-  }
+  service.Load();
+
+  service.StartWorkers();
 
   event_loop.Run();
 
-  server.Save();
+  service.StopWorkers();
+
+  service.Flush();
 
   return EXIT_SUCCESS;
 } catch (const std::exception &exception) {
@@ -18,7 +18,9 @@ class Serialiser : public BufferedOutputStream {
     std::chrono::system_clock::now();
 
 public:
-  explicit Serialiser(OutputStream &_os):BufferedOutputStream(_os) {}
+  explicit Serialiser(OutputStream &_os,
+                      size_t buffer_size=32768) noexcept
+    :BufferedOutputStream(_os, buffer_size) {}
 
   template<typename T>
   void WriteT(const T &value) {
@@ -28,6 +28,9 @@ namespace CommandLine {
 #ifdef HAVE_CMDLINE_REPLAY
   const char *replay_path;
 #endif
+
+  const char *startup_trace_path;
+  bool benchmark_startup = false;
 }
 
 void
@@ -64,6 +67,12 @@ CommandLine::Parse(Args &args)
     } else if (StringIsEqual(s, "-replay=", 8)) {
       replay_path = s + 8;
 #endif
+    } else if (StringIsEqual(s, "-startup-trace=", 15)) {
+      startup_trace_path = s + 15;
+      if (StringIsEmpty(startup_trace_path))
+        args.UsageError();
+    } else if (StringIsEqual(s, "-benchmark-startup")) {
+      benchmark_startup = true;
 #ifdef SIMULATOR_AVAILABLE
     } else if (StringIsEqual(s, "-simulator")) {
       global_simulator_flag = true;
@@ -130,6 +139,14 @@ CommandLine::Parse(Args &args)
     }
   }
 
+#ifdef SIMULATOR_AVAILABLE
+  /* don't wait for the simulator prompt */
+  if (benchmark_startup && !sim_set_in_cmd_line_flag) {
+    global_simulator_flag = true;
+    sim_set_in_cmd_line_flag = true;
+  }
+#endif
+
   if (width < 240 || width > 4096 ||
       height < 240 || height > 4096)
     args.UsageError();
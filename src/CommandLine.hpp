@@ -22,6 +22,17 @@ namespace CommandLine {
   extern const char *replay_path;
 #endif
 
+  /**
+   * Write a #StartupTrace report to this file ("-startup-trace=").
+   */
+  extern const char *startup_trace_path;
+
+  /**
+   * Quit as soon as the startup is complete, after writing the
+   * #StartupTrace report ("-benchmark-startup").
+   */
+  extern bool benchmark_startup;
+
 /**
  * Reads and parses arguments/options from the command line
  * @param CommandLine command line argument string
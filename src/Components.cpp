@@ -10,6 +10,7 @@
 #include "thread/Handle.hpp"
 
 FileCache *file_cache;
+JobPool *job_pool;
 TopographyStore *topography;
 RasterTerrain *terrain;
 AsyncTerrainOverviewLoader *terrain_loader;
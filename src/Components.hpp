@@ -4,6 +4,7 @@
 #pragma once
 
 class FileCache;
+class JobPool;
 class TopographyStore;
 class RasterTerrain;
 class AsyncTerrainOverviewLoader;
@@ -26,6 +27,12 @@ namespace TIM { class Glue; }
 
 // other global objects
 extern FileCache *file_cache;
+
+/**
+ * The worker threads for background jobs of all subsystems.
+ */
+extern JobPool *job_pool;
+
 extern Airspaces airspace_database;
 extern Waypoints way_points;
 extern ProtectedTaskManager *protected_task_manager;
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Accumulates the CPU time spent in the subsystems of the
+ * #GlideComputer.  It is only attached by benchmarks; the computers
+ * skip all accounting if none is set.
+ *
+ * Time is accounted exclusively: while a nested subsystem runs, the
+ * clock of the enclosing one is paused.
+ */
+class ComputerProfiler {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+
+  enum class Subsystem : uint8_t {
+    AIR_DATA,
+    WIND,
+    TRACE,
+    TASK,
+    ROUTE,
+    CONTEST,
+    AIRSPACE,
+    STATS,
+
+    /**
+     * Everything else inside #GlideComputer (team code, traffic,
+     * condition monitors, ...).
+     */
+    OTHER,
+
+    COUNT
+  };
+
+  static constexpr std::size_t N_SUBSYSTEMS =
+    std::size_t(Subsystem::COUNT);
+
+  using Totals = std::array<Duration, N_SUBSYSTEMS>;
+
+private:
+  Totals totals{};
+
+  /**
+   * The subsystem whose clock is running; #Subsystem::COUNT if none.
+   */
+  Subsystem current = Subsystem::COUNT;
+
+  Clock::time_point since;
+
+public:
+  [[gnu::const]]
+  static const char *GetName(Subsystem s) noexcept {
+    static constexpr const char *names[N_SUBSYSTEMS] = {
+      "air_data",
+      "wind",
+      "trace",
+      "task",
+      "route",
+      "contest",
+      "airspace",
+      "stats",
+      "other",
+    };
+
+    return names[std::size_t(s)];
+  }
+
+  const Totals &GetTotals() const noexcept {
+    return totals;
+  }
+
+  void Reset() noexcept {
+    totals = {};
+  }
+
+  /**
+   * Switch the clock to the given subsystem.
+   *
+   * @return the previous subsystem, to be passed to Leave()
+   */
+  Subsystem Enter(Subsystem s) noexcept {
+    const auto now = Clock::now();
+    Account(now);
+
+    const Subsystem previous = current;
+    current = s;
+    since = now;
+    return previous;
+  }
+
+  /**
+   * Stop the clock of the current subsystem and resume the given
+   * one.
+   */
+  void Leave(Subsystem previous) noexcept {
+    const auto now = Clock::now();
+    Account(now);
+
+    current = previous;
+    since = now;
+  }
+
+private:
+  void Account(Clock::time_point now) noexcept {
+    if (current != Subsystem::COUNT)
+      totals[std::size_t(current)] += now - since;
+  }
+};
+
+/**
+ * Accounts the time of the current scope to a subsystem.  Does
+ * nothing if no #ComputerProfiler is attached.
+ */
+class ScopeComputerProfile {
+  ComputerProfiler *const profiler;
+  ComputerProfiler::Subsystem previous;
+
+public:
+  ScopeComputerProfile(ComputerProfiler *_profiler,
+                       ComputerProfiler::Subsystem s) noexcept
+    :profiler(_profiler)
+  {
+    if (profiler != nullptr)
+      previous = profiler->Enter(s);
+  }
+
+  ~ScopeComputerProfile() noexcept {
+    if (profiler != nullptr)
+      profiler->Leave(previous);
+  }
+
+  ScopeComputerProfile(const ScopeComputerProfile &) = delete;
+  ScopeComputerProfile &operator=(const ScopeComputerProfile &) = delete;
+};
@@ -7,25 +7,39 @@
 
 void
 ConditionMonitor::Update(const NMEAInfo &basic, const DerivedInfo &calculated,
-                         const ComputerSettings &settings) noexcept
+                         const ComputerSettings &settings,
+                         unsigned changed) noexcept
 {
+  pending_inputs |= changed;
+
   if (!calculated.flight.flying)
     return;
 
   bool restart = false;
   const auto Time = basic.time;
-  if (Ready_Time_Check(Time, &restart)) {
+  if (Ready_Time_Check(Time, &restart) &&
+      (restart || (pending_inputs & inputs) != 0)) {
+    const auto start = Clock::now();
+
     LastTime_Check = Time;
+    pending_inputs = 0;
+
     if (CheckCondition(basic, calculated, settings)) {
       if (Ready_Time_Notification(Time) && !restart) {
         LastTime_Notification = Time;
         Notify();
         SaveLast();
-      }
+      } else
+        /* the notification is only deferred: check again even if
+           the inputs do not change */
+        pending_inputs = inputs;
     }
 
     if (restart)
       SaveLast();
+
+    cost += Clock::now() - start;
+    ++n_checks;
   }
 }
 
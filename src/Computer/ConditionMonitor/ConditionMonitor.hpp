@@ -5,6 +5,8 @@
 
 #include "time/Stamp.hpp"
 
+#include <chrono>
+
 struct NMEAInfo;
 struct DerivedInfo;
 struct ComputerSettings;
@@ -15,20 +17,85 @@ struct ComputerSettings;
  */
 class ConditionMonitor
 {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * Bits describing the inputs of CheckCondition().  A monitor is
+   * only checked if one of its inputs has changed since the last
+   * check.
+   */
+  enum Input : unsigned {
+    /**
+     * A new GPS fix (NMEAInfo::location_available), and everything
+     * calculated from it.
+     */
+    INPUT_FIX = 0x1,
+
+    /**
+     * A new wind estimate (DerivedInfo::wind_available).
+     */
+    INPUT_WIND = 0x2,
+  };
+
 protected:
   TimeStamp LastTime_Notification = TimeStamp::Undefined();
   TimeStamp LastTime_Check = TimeStamp::Undefined();
   FloatDuration Interval_Notification;
   const FloatDuration Interval_Check;
 
+private:
+  /**
+   * A combination of #Input bits read by CheckCondition().
+   */
+  const unsigned inputs;
+
+  /**
+   * The #Input bits which have changed since the last check.
+   */
+  unsigned pending_inputs = ~0u;
+
+  /**
+   * The CPU time spent in CheckCondition() and Notify().
+   */
+  Clock::duration cost{};
+
+  unsigned n_checks = 0;
+
 public:
   constexpr ConditionMonitor(FloatDuration _interval_notification,
-                             FloatDuration _interval_check) noexcept
+                             FloatDuration _interval_check,
+                             unsigned _inputs=INPUT_FIX) noexcept
     :Interval_Notification(_interval_notification),
-     Interval_Check(_interval_check) {}
+     Interval_Check(_interval_check),
+     inputs(_inputs) {}
 
+  /**
+   * Check the condition if the check interval has elapsed and if
+   * one of the inputs has changed.
+   *
+   * @param changed the #Input bits which have changed since the
+   * last call
+   */
   void Update(const NMEAInfo &basic, const DerivedInfo &calculated,
-              const ComputerSettings &settings) noexcept;
+              const ComputerSettings &settings,
+              unsigned changed) noexcept;
+
+  FloatDuration GetCheckInterval() const noexcept {
+    return Interval_Check;
+  }
+
+  unsigned GetInputs() const noexcept {
+    return inputs;
+  }
+
+  Clock::duration GetCost() const noexcept {
+    return cost;
+  }
+
+  unsigned GetCheckCount() const noexcept {
+    return n_checks;
+  }
 
 private:
   virtual bool CheckCondition(const NMEAInfo &basic,
@@ -13,7 +13,8 @@ class ConditionMonitorWind final : public ConditionMonitor {
 
 public:
   constexpr ConditionMonitorWind() noexcept
-    :ConditionMonitor(std::chrono::minutes{5}, std::chrono::seconds{10}) {}
+    :ConditionMonitor(std::chrono::minutes{5}, std::chrono::seconds{10},
+                      INPUT_WIND) {}
 
 protected:
   bool CheckCondition(const NMEAInfo &basic,
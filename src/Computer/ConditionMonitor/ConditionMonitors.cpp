@@ -2,15 +2,28 @@
 // Copyright The XCSoar Project
 
 #include "ConditionMonitors.hpp"
+#include "NMEA/Info.hpp"
+#include "NMEA/Derived.hpp"
 
 void
 ConditionMonitors::Update(const NMEAInfo &basic, const DerivedInfo &calculated,
                           const ComputerSettings &settings) noexcept
 {
-  wind.Update(basic, calculated, settings);
-  finalglide.Update(basic, calculated, settings);
-  sunset.Update(basic, calculated, settings);
-  aattime.Update(basic, calculated, settings);
-  glideterrain.Update(basic, calculated, settings);
-  landablereachable.Update(basic, calculated, settings);
+  /* a Validity which differs in either direction is a change (the
+     other direction is a time warp) */
+  unsigned changed = 0;
+  if (basic.location_available != last_fix)
+    changed |= ConditionMonitor::INPUT_FIX;
+  if (calculated.wind_available != last_wind)
+    changed |= ConditionMonitor::INPUT_WIND;
+
+  last_fix = basic.location_available;
+  last_wind = calculated.wind_available;
+
+  wind.Update(basic, calculated, settings, changed);
+  finalglide.Update(basic, calculated, settings, changed);
+  sunset.Update(basic, calculated, settings, changed);
+  aattime.Update(basic, calculated, settings, changed);
+  glideterrain.Update(basic, calculated, settings, changed);
+  landablereachable.Update(basic, calculated, settings, changed);
 }
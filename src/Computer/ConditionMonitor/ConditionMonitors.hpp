@@ -9,7 +9,13 @@
 #include "ConditionMonitorLandableReachable.hpp"
 #include "ConditionMonitorSunset.hpp"
 #include "ConditionMonitorWind.hpp"
+#include "NMEA/Validity.hpp"
 
+/**
+ * Schedules the #ConditionMonitor instances: each one is checked at
+ * its own interval, and only if one of its inputs (see
+ * ConditionMonitor::Input) has changed.
+ */
 class ConditionMonitors {
   ConditionMonitorWind wind;
   ConditionMonitorFinalGlide finalglide;
@@ -18,7 +24,27 @@ class ConditionMonitors {
   ConditionMonitorGlideTerrain glideterrain;
   ConditionMonitorLandableReachable landablereachable;
 
+  /**
+   * The input states seen by the last Update() call, for detecting
+   * changes.
+   */
+  Validity last_fix, last_wind;
+
 public:
   void Update(const NMEAInfo &basic, const DerivedInfo &calculated,
               const ComputerSettings &settings) noexcept;
+
+  /**
+   * Invoke the visitor with the name and the #ConditionMonitor of
+   * each monitor, e.g. to report their CPU cost.
+   */
+  template<typename V>
+  void VisitMonitors(V &&visitor) const {
+    visitor("wind", wind);
+    visitor("final_glide", finalglide);
+    visitor("sunset", sunset);
+    visitor("aat_time", aattime);
+    visitor("glide_terrain", glideterrain);
+    visitor("landable_reachable", landablereachable);
+  }
 };
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ContestCheckpoint.hpp"
+#include "io/BufferedOutputStream.hxx"
+#include "io/BufferedReader.hxx"
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include <string.h>
+
+namespace {
+
+struct CheckpointHeader {
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t version;
+
+  /**
+   * The number of #TracePoint records following this header.  They
+   * are followed by the #ContestStatistics.
+   */
+  uint32_t n_points;
+
+  BrokenDate date;
+
+  Contest contest;
+};
+
+/* the checkpoint is a copy of the objects' memory */
+static_assert(std::is_trivially_copyable_v<CheckpointHeader>);
+static_assert(std::is_trivially_copyable_v<TracePoint>);
+static_assert(std::is_trivially_copyable_v<ContestStatistics>);
+
+/* sanity limit for reading */
+static constexpr uint32_t MAX_POINTS = 64 * 1024;
+
+} // anonymous namespace
+
+void
+SaveContestCheckpoint(BufferedOutputStream &os,
+                      const ContestCheckpoint &checkpoint)
+{
+  CheckpointHeader header;
+  memset(static_cast<void *>(&header), 0, sizeof(header));
+  header.version = CheckpointHeader::VERSION;
+  header.n_points = checkpoint.trace.size();
+  header.date = checkpoint.date;
+  header.contest = checkpoint.contest;
+
+  os.Write(std::as_bytes(std::span{&header, 1}));
+  os.Write(std::as_bytes(std::span{checkpoint.trace}));
+  os.Write(std::as_bytes(std::span{&checkpoint.stats, 1}));
+}
+
+ContestCheckpoint
+LoadContestCheckpoint(BufferedReader &r)
+{
+  const auto header = r.ReadFullT<CheckpointHeader>();
+  if (header.version != CheckpointHeader::VERSION ||
+      header.n_points > MAX_POINTS ||
+      header.contest > Contest::NONE)
+    throw std::runtime_error("Malformed contest checkpoint header");
+
+  ContestCheckpoint checkpoint;
+  checkpoint.contest = header.contest;
+  checkpoint.date = header.date;
+
+  checkpoint.trace.resize(header.n_points);
+  r.ReadFull(std::as_writable_bytes(std::span{checkpoint.trace}));
+
+  for (std::size_t i = 0; i < checkpoint.trace.size(); ++i)
+    if (!checkpoint.trace[i].IsDefined() ||
+        !checkpoint.trace[i].GetLocation().Check() ||
+        (i > 0 && checkpoint.trace[i].IsOlderThan(checkpoint.trace[i - 1])))
+      throw std::runtime_error("Malformed contest checkpoint trace");
+
+  checkpoint.stats = r.ReadFullT<ContestStatistics>();
+
+  for (const auto &solution : checkpoint.stats.solution)
+    if (solution.size() > solution.capacity())
+      throw std::runtime_error("Malformed contest checkpoint solution");
+
+  return checkpoint;
+}
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Contest/Settings.hpp"
+#include "Engine/Contest/ContestStatistics.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "time/BrokenDate.hpp"
+
+#include <chrono>
+
+class BufferedOutputStream;
+class BufferedReader;
+
+/**
+ * The state of the contest optimisation, saved periodically during
+ * the flight so it can be resumed after the program was restarted.
+ */
+struct ContestCheckpoint {
+  /**
+   * A checkpoint older than this is not used.
+   */
+  static constexpr std::chrono::duration<unsigned> MAX_AGE =
+    std::chrono::minutes{30};
+
+  /**
+   * The contest #stats were calculated for.
+   */
+  Contest contest;
+
+  /**
+   * The UTC date of the flight; may be invalid if the GPS did not
+   * provide one.
+   */
+  BrokenDate date;
+
+  /**
+   * The full trace of the flight.
+   */
+  TracePointVector trace;
+
+  ContestStatistics stats;
+
+  /**
+   * May this checkpoint be used to resume the flight which is at
+   * the given date and time now?
+   */
+  [[gnu::pure]]
+  bool IsResumable(BrokenDate now_date,
+                   TracePoint::Time now) const noexcept {
+    if (trace.empty() || date != now_date)
+      return false;
+
+    const auto last = trace.back().GetTime();
+    return last <= now && now - last <= MAX_AGE;
+  }
+};
+
+/**
+ * Write the checkpoint to a file.  It is only valid on the machine
+ * which wrote it.
+ *
+ * Throws on error.
+ */
+void
+SaveContestCheckpoint(BufferedOutputStream &os,
+                      const ContestCheckpoint &checkpoint);
+
+/**
+ * Read a checkpoint written by SaveContestCheckpoint().
+ *
+ * Throws on error (e.g. a malformed or incompatible checkpoint).
+ */
+ContestCheckpoint
+LoadContestCheckpoint(BufferedReader &r);
@@ -10,6 +10,19 @@ ContestComputer::ContestComputer(const Trace &trace_full,
   :contest_manager(Contest::OLC_SPRINT, trace_full, trace_triangle, trace_sprint, true)
 {
   contest_manager.SetIncremental(true);
+  contest_manager.SetForEach([this](std::size_t n,
+                                    const std::function<void(std::size_t)> &f){
+    pool.ForEach(n, f);
+  });
+}
+
+void
+ContestComputer::Restore(const ContestSettings &settings,
+                         const ContestStatistics &contest_stats)
+{
+  contest_manager.SetHandicap(settings.handicap);
+  contest_manager.SetContest(settings.contest);
+  contest_manager.Restore(contest_stats);
 }
 
 void
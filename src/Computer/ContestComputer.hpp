@@ -4,12 +4,19 @@
 #pragma once
 
 #include "Engine/Contest/ContestManager.hpp"
+#include "thread/ThreadPool.hpp"
 
 struct ContestSettings;
 struct ContestStatistics;
 class Trace;
 
 class ContestComputer {
+  /**
+   * Runs the independent solvers of a contest in parallel.  At most
+   * three of them run at a time (WeGlide Free).
+   */
+  ThreadPool pool{"Contest", ThreadPool::GetDefaultWorkers(2), true};
+
   ContestManager contest_manager;
 
 public:
@@ -32,6 +39,12 @@ public:
     contest_manager.SetPredicted(predicted);
   }
 
+  /**
+   * @see ContestManager::Restore()
+   */
+  void Restore(const ContestSettings &settings_computer,
+               const ContestStatistics &contest_stats);
+
   void Solve(const ContestSettings &settings_computer,
              ContestStatistics &contest_stats);
 
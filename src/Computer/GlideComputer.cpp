@@ -5,11 +5,15 @@
 #include "Computer/Settings.hpp"
 #include "NMEA/Derived.hpp"
 #include "GlideComputerInterface.hpp"
+#include "NMEA/Aircraft.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 
 using namespace std::chrono;
 
-static PeriodClock last_team_code_update;
+/**
+ * The nominal interval of the idle calculations, see ProcessGPS().
+ */
+static constexpr auto IDLE_INTERVAL = milliseconds{500};
 
 GlideComputer::GlideComputer(const ComputerSettings &_settings,
                              const Waypoints &_way_points,
@@ -27,6 +31,60 @@ GlideComputer::GlideComputer(const ComputerSettings &_settings,
   ReadComputerSettings(_settings);
   events.SetComputer(*this);
   idle_clock.Update();
+  InitIdleGraph();
+}
+
+void
+GlideComputer::InitIdleGraph() noexcept
+{
+  /* each task writes to different parts of DerivedInfo (if at all),
+     so the results do not depend on the order; the slow contest
+     solver is added first, to be started first */
+
+  idle_graph.AddTask("contest", [this]{
+    if (!idle_exhaustive && contest_scale < 1 &&
+        !last_contest.Check(duration_cast<milliseconds>(IDLE_INTERVAL /
+                                                        contest_scale)))
+      /* save power: skip this pass */
+      return;
+
+    last_contest.Update();
+    task_computer.ProcessContest(Basic(), SetCalculated(),
+                                 GetComputerSettings(), idle_exhaustive);
+  });
+
+  const unsigned airspace = idle_graph.AddTask("airspace", [this]{
+    const ScopeComputerProfile profile(profiler,
+                                       ComputerProfiler::Subsystem::AIRSPACE);
+    DerivedInfo &calculated = SetCalculated();
+    warning_computer.Update(GetComputerSettings(), Basic(),
+                            calculated, calculated.airspace_warnings);
+  });
+
+  idle_graph.AddTask("task", [this]{
+    task_computer.ProcessTaskIdle(Basic(), Calculated());
+  });
+
+  // Log GPS fixes for internal usage
+  // (snail trail, stats, contest, ...)
+  idle_graph.AddTask("stats", [this]{
+    const ScopeComputerProfile profile(profiler,
+                                       ComputerProfiler::Subsystem::STATS);
+    stats_computer.DoLogging(Basic(), Calculated());
+    log_computer.Run(Basic(), Calculated(), GetComputerSettings().logger);
+  });
+
+  /* checks the airspace warnings */
+  idle_graph.AddTask("monitors", [this]{
+    idle_condition_monitors.Update(Basic(), Calculated(),
+                                   GetComputerSettings());
+  }, {airspace});
+
+  // Calculate summary of flight
+  idle_graph.AddTask("retrospective", [this]{
+    if (Basic().location_available)
+      retrospective.UpdateSample(Basic().location);
+  });
 }
 
 void
@@ -41,6 +99,7 @@ GlideComputer::ResetFlight(const bool full)
 
   cu_computer.Reset();
   warning_computer.Reset();
+  traffic_proximity_computer.Reset();
 
   trace_history_time.Reset();
 }
@@ -58,6 +117,9 @@ GlideComputer::ProcessGPS(bool force)
   DerivedInfo &calculated = SetCalculated();
   const ComputerSettings &settings = GetComputerSettings();
 
+  const ScopeComputerProfile profile(profiler,
+                                     ComputerProfiler::Subsystem::OTHER);
+
   const bool last_flying = calculated.flight.flying;
 
   if (basic.time_available) {
@@ -109,10 +171,19 @@ GlideComputer::ProcessGPS(bool force)
                                     SetCalculated(),
                                     settings);
 
-  stats_computer.ProcessClimbEvents(calculated);
+  {
+    const ScopeComputerProfile stats_profile(profiler,
+                                             ComputerProfiler::Subsystem::STATS);
+    stats_computer.ProcessClimbEvents(calculated);
+  }
 
   cu_computer.Compute(basic, calculated, settings);
 
+  traffic_proximity_computer.Compute(basic,
+                                     ToAircraftState(basic, calculated),
+                                     settings.jet_provider_setting,
+                                     calculated.traffic_proximity);
+
   // Calculate the team code
   CalculateOwnTeamCode();
 
@@ -137,7 +208,7 @@ GlideComputer::ProcessGPS(bool force)
 
   CalculateFuelBurnTimeRemain(calculated);
 
-  return idle_clock.CheckUpdate(milliseconds(500));
+  return idle_clock.CheckUpdate(IDLE_INTERVAL);
 }
 
 void
@@ -153,28 +224,24 @@ GlideComputer::CalculateFuelBurnTimeRemain(DerivedInfo &calculated)
   calculated.fuel_burn_time_remain_available.Update(Basic().clock);
 }
 
-void
-GlideComputer::ProcessIdle(bool exhaustive)
+bool
+GlideComputer::ProcessIdle(bool exhaustive, TaskGraph::TimePoint deadline)
 {
-  const MoreData &basic = Basic();
-  DerivedInfo &calculated = SetCalculated();
+  const ScopeComputerProfile profile(profiler,
+                                     ComputerProfiler::Subsystem::OTHER);
 
-  // Log GPS fixes for internal usage
-  // (snail trail, stats, contest, ...)
-  stats_computer.DoLogging(basic, calculated);
-  log_computer.Run(basic, calculated, GetComputerSettings().logger);
-
-  task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
-                            exhaustive);
-
-  warning_computer.Update(GetComputerSettings(), basic,
-                          calculated, calculated.airspace_warnings);
+  /* the profiler is not thread-safe; with one attached, all tasks
+     run in this thread */
+  ThreadPool *const pool = profiler == nullptr ? &idle_pool : nullptr;
 
-  idle_condition_monitors.Update(basic, calculated, GetComputerSettings());
+  if (exhaustive && idle_graph.IsPending()) {
+    /* finish the pass which was interrupted by its deadline */
+    idle_exhaustive = false;
+    idle_graph.Run(pool);
+  }
 
-  // Calculate summary of flight
-  if (basic.location_available)
-    retrospective.UpdateSample(basic.location);
+  idle_exhaustive = exhaustive;
+  return idle_graph.Run(pool, deadline);
 }
 
 bool
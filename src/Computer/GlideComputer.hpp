@@ -12,6 +12,10 @@
 #include "LogComputer.hpp"
 #include "WarningComputer.hpp"
 #include "CuComputer.hpp"
+#include "TrafficProximityComputer.hpp"
+#include "ComputerProfiler.hpp"
+#include "thread/TaskGraph.hpp"
+#include "thread/ThreadPool.hpp"
 #include "Engine/Contest/Solvers/Retrospective.hpp"
 #include "ConditionMonitor/ConditionMonitors.hpp"
 #include "ConditionMonitor/MoreConditionMonitors.hpp"
@@ -33,6 +37,7 @@ class GlideComputer : public GlideComputerBlackboard
   StatsComputer stats_computer;
   LogComputer log_computer;
   CuComputer cu_computer;
+  TrafficProximityComputer traffic_proximity_computer;
 
   ConditionMonitors condition_monitors;
   MoreConditionMonitors idle_condition_monitors;
@@ -44,6 +49,8 @@ class GlideComputer : public GlideComputerBlackboard
   bool team_code_ref_found;
   GeoPoint team_code_ref_location;
 
+  PeriodClock last_team_code_update;
+
   PeriodClock idle_clock;
 
   /**
@@ -52,6 +59,32 @@ class GlideComputer : public GlideComputerBlackboard
    */
   DeltaTime trace_history_time;
 
+  ComputerProfiler *profiler = nullptr;
+
+  /**
+   * The calculations of ProcessIdle() and the dependencies between
+   * them; independent ones run in parallel on #idle_pool.
+   */
+  TaskGraph idle_graph;
+  ThreadPool idle_pool{"GlideComputer", ThreadPool::GetDefaultWorkers(2)};
+
+  /**
+   * The parameter of the ProcessIdle() call in progress.
+   */
+  bool idle_exhaustive;
+
+  /**
+   * The fraction of the nominal contest solver rate allowed by the
+   * power governor, see SetPowerScale().
+   */
+  double contest_scale = 1;
+
+  /**
+   * When did the contest solver last run?  Used to throttle it when
+   * #contest_scale is below 1.
+   */
+  PeriodClock last_contest;
+
 public:
   GlideComputer(const ComputerSettings &_settings,
                 const Waypoints &_way_points,
@@ -65,6 +98,23 @@ public:
     log_computer.SetLogger(logger);
   }
 
+  /**
+   * Attach a #ComputerProfiler which measures the time spent in each
+   * subsystem (or detach it with nullptr).  Only used by benchmarks.
+   */
+  void SetProfiler(ComputerProfiler *_profiler) noexcept {
+    profiler = _profiler;
+    air_data_computer.SetProfiler(_profiler);
+    task_computer.SetProfiler(_profiler);
+  }
+
+  /**
+   * Set the source of the radar traffic checked for proximity.
+   */
+  void SetJETProviderData(const JETProvider::Data *data) noexcept {
+    traffic_proximity_computer.SetData(data);
+  }
+
   /**
    * Resets the GlideComputer data
    * @param full Reset all data?
@@ -90,13 +140,40 @@ public:
 
   /**
    * Process slow calculations. Called by the CalculationThread.
+   *
+   * The calculations which have not been started when the deadline
+   * passes are postponed; the next call continues with them (before
+   * starting over).
+   *
+   * @return true if all calculations have been done, false if some
+   * are left for the next call
    */
-  void ProcessIdle(bool exhaustive=false);
+  bool ProcessIdle(bool exhaustive=false,
+                   TaskGraph::TimePoint deadline=TaskGraph::TimePoint::max());
 
   void ProcessExhaustive() {
     ProcessIdle(true);
   }
 
+  /**
+   * Slow down the contest solver to save power.  The other idle
+   * calculations (logger, airspace warnings, condition monitors)
+   * are safety relevant and keep their full rate.
+   *
+   * @param scale the fraction of the nominal rate, between 0 and 1
+   */
+  void SetPowerScale(double scale) noexcept {
+    contest_scale = scale;
+  }
+
+  /**
+   * The tasks of ProcessIdle(), with the durations and the critical
+   * path of the last complete pass.
+   */
+  const TaskGraph &GetIdleGraph() const noexcept {
+    return idle_graph;
+  }
+
   void OnStartTask();
   void OnFinishTask();
   void OnTransitionEnter();
@@ -105,6 +182,13 @@ public:
     return air_data_computer.GetWindStore();
   }
 
+  /**
+   * Caller must lock ThermalHistory::mutex.
+   */
+  const ThermalHistory &GetThermalHistory() const noexcept {
+    return air_data_computer.GetThermalHistory();
+  }
+
   const CuSonde &GetCuSonde() const {
     return cu_computer.GetCuSonde();
   }
@@ -145,6 +229,15 @@ public:
     task_computer.SetContestIncremental(incremental);
   }
 
+  void SetContestCheckpoint(ContestCheckpoint &&checkpoint) noexcept {
+    task_computer.SetContestCheckpoint(std::move(checkpoint));
+  }
+
+  void MakeContestCheckpoint(ContestCheckpoint &dest) const {
+    task_computer.MakeContestCheckpoint(Basic(), Calculated(),
+                                        GetComputerSettings(), dest);
+  }
+
 protected:
   void OnTakeoff();
   void OnLanding();
@@ -155,6 +248,7 @@ protected:
   void TakeoffLanding(bool last_flying);
 
 private:
+  void InitIdleGraph() noexcept;
 
   /**
    * Fill the cache variable TeamCodeRefLocation.
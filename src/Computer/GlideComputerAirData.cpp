@@ -44,9 +44,13 @@ GlideComputerAirData::ResetFlight(DerivedInfo &calculated,
 
   gr_computer.Reset();
 
-  if (full)
+  if (full) {
     flying_computer.Reset();
 
+    const std::lock_guard lock{thermal_history.mutex};
+    thermal_history.Clear();
+  }
+
   circling_computer.Reset();
   wave_computer.Reset();
 
@@ -61,6 +65,9 @@ GlideComputerAirData::ProcessBasic(const MoreData &basic,
                                    DerivedInfo &calculated,
                                    const ComputerSettings &settings)
 {
+  const ScopeComputerProfile profile(profiler,
+                                     ComputerProfiler::Subsystem::AIR_DATA);
+
   TerrainHeight(basic, calculated);
   ProcessSun(basic, calculated, settings);
 
@@ -72,6 +79,9 @@ GlideComputerAirData::ProcessVertical(const MoreData &basic,
                                       DerivedInfo &calculated,
                                       const ComputerSettings &settings)
 {
+  const ScopeComputerProfile profile(profiler,
+                                     ComputerProfiler::Subsystem::AIR_DATA);
+
   /* the "circling" flag may be modified by
      CirclingComputer::Turning(); remember the old state so this
      method can check for modifications */
@@ -86,10 +96,14 @@ GlideComputerAirData::ProcessVertical(const MoreData &basic,
   wave_computer.Compute(basic, calculated.flight,
                         calculated.wave, settings.wave);
 
-  wind_computer.Compute(settings.wind, settings.polar.glide_polar_task,
-                        basic, calculated);
-  wind_computer.Select(settings.wind, basic, calculated);
-  wind_computer.ComputeHeadWind(basic, calculated);
+  {
+    const ScopeComputerProfile wind_profile(profiler,
+                                            ComputerProfiler::Subsystem::WIND);
+    wind_computer.Compute(settings.wind, settings.polar.glide_polar_task,
+                          basic, calculated);
+    wind_computer.Select(settings.wind, basic, calculated);
+    wind_computer.ComputeHeadWind(basic, calculated);
+  }
 
   if (basic.location_available)
     thermallocator.Process(calculated.circling && calculated.turning,
@@ -254,6 +268,9 @@ GlideComputerAirData::FlightTimes(const NMEAInfo &basic,
                                   DerivedInfo &calculated,
                                   const ComputerSettings &settings)
 {
+  const ScopeComputerProfile profile(profiler,
+                                     ComputerProfiler::Subsystem::AIR_DATA);
+
   if (basic.time_available &&
       delta_time.Update(basic.time, {}, minutes{3}).count() < 0)
     /* time warp: reset the computer */
@@ -370,6 +387,16 @@ GlideComputerAirData::LastThermalStats(const MoreData &basic,
         LowPassFilter(calculated.last_thermal_average_smooth,
                       calculated.last_thermal.lift_rate, LOW_PASS_FILTER_THERMAL_AVERAGE_ALPHA);
 
+  if (basic.location_available) {
+    const GeoPoint &location = calculated.thermal_locator.estimate_valid
+      ? calculated.thermal_locator.estimate_location
+      : basic.location;
+
+    const std::lock_guard lock{thermal_history.mutex};
+    thermal_history.Add(location, gain, duration,
+                        calculated.cruise_start_time);
+  }
+
   ThermalSources(basic, calculated, calculated.thermal_locator);
 }
 
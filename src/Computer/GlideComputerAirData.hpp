@@ -13,6 +13,8 @@
 #include "LiftDatabaseComputer.hpp"
 #include "AverageVarioComputer.hpp"
 #include "ThermalLocator.hpp"
+#include "ThermalHistory.hpp"
+#include "ComputerProfiler.hpp"
 
 struct VarioInfo;
 struct OneClimbInfo;
@@ -43,6 +45,11 @@ class GlideComputerAirData {
 
   ThermalLocator thermallocator;
 
+  /**
+   * All climbs since takeoff.
+   */
+  ThermalHistory thermal_history;
+
   AverageVarioComputer average_vario;
 
   /**
@@ -50,6 +57,8 @@ class GlideComputerAirData {
    */
   DeltaTime delta_time;
 
+  ComputerProfiler *profiler = nullptr;
+
 public:
   GlideComputerAirData(const Waypoints &way_points);
 
@@ -57,10 +66,21 @@ public:
     terrain = _terrain;
   }
 
+  void SetProfiler(ComputerProfiler *_profiler) noexcept {
+    profiler = _profiler;
+  }
+
   const WindStore &GetWindStore() const {
     return wind_computer.GetWindStore();
   }
 
+  /**
+   * Caller must lock ThermalHistory::mutex.
+   */
+  const ThermalHistory &GetThermalHistory() const noexcept {
+    return thermal_history;
+  }
+
   void ResetFlight(DerivedInfo &calculated, const bool full=true);
 
   void ResetStats() {
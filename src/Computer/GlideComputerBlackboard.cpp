@@ -61,7 +61,7 @@ GlideComputerBlackboard::RestoreFinish()
 void
 GlideComputerBlackboard::ReadBlackboard(const MoreData &nmea_info)
 {
-  gps_info = nmea_info;
+  gps_info.CopyFrom(nmea_info);
 }
 
 /**
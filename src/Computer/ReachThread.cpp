@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ReachThread.hpp"
+#include "Task/ProtectedRoutePlanner.hpp"
+
+ReachThread::ReachThread(ProtectedRoutePlanner &_route_planner) noexcept
+  :StandbyThread("Reach"), route_planner(_route_planner) {}
+
+void
+ReachThread::Trigger(const AGeoPoint &origin,
+                     const RoutePlannerConfig &config,
+                     int h_ceiling, bool do_solve)
+{
+  const std::lock_guard lock{mutex};
+
+  next_origin = origin;
+  next_config = config;
+  next_h_ceiling = h_ceiling;
+  next_do_solve = do_solve;
+  StandbyThread::Trigger();
+}
+
+void
+ReachThread::Tick() noexcept
+{
+  if (!priority_set) {
+    /* don't compete with the CalculationThread */
+    SetLowPriority();
+    priority_set = true;
+  }
+
+  const AGeoPoint origin = next_origin;
+  const RoutePlannerConfig config = next_config;
+  const int h_ceiling = next_h_ceiling;
+  const bool do_solve = next_do_solve;
+
+  const ScopeUnlock unlock(mutex);
+  route_planner.SolveReach(origin, config, h_ceiling, do_solve);
+}
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "thread/StandbyThread.hpp"
+#include "Engine/Route/Config.hpp"
+#include "Geo/GeoPoint.hpp"
+
+class ProtectedRoutePlanner;
+
+/**
+ * A thread which solves the reach footprint in background, so a slow
+ * ReachFan::Solve() doesn't delay the #CalculationThread.  The
+ * result is published by ProtectedRoutePlanner::SolveReach().
+ */
+class ReachThread final : private StandbyThread {
+  ProtectedRoutePlanner &route_planner;
+
+  bool priority_set = false;
+
+  /* the parameters of the next solve; protected by
+     StandbyThread::mutex */
+  AGeoPoint next_origin;
+  RoutePlannerConfig next_config;
+  int next_h_ceiling;
+  bool next_do_solve;
+
+public:
+  explicit ReachThread(ProtectedRoutePlanner &_route_planner) noexcept;
+
+  using StandbyThread::LockWaitDone;
+  using StandbyThread::LockStop;
+
+  /**
+   * Schedule a solve from the given origin.  If the thread is still
+   * busy with the previous one, the new parameters replace any solve
+   * which has not yet begun, so the thread always continues with the
+   * latest state.
+   *
+   * Throws on error.
+   */
+  void Trigger(const AGeoPoint &origin, const RoutePlannerConfig &config,
+               int h_ceiling, bool do_solve);
+
+private:
+  /* virtual methods from class StandbyThread*/
+  void Tick() noexcept override;
+};
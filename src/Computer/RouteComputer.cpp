@@ -13,14 +13,29 @@
 RouteComputer::RouteComputer(const Airspaces &airspace_database,
                              const ProtectedAirspaceWarningManager *warnings)
   :protected_route_planner(route_planner, airspace_database, warnings),
+   reach_thread(protected_route_planner),
    terrain(NULL)
-{}
+{
+  protected_route_planner.SetReachForEach([this](std::size_t n,
+                                                 const std::function<void(std::size_t)> &f){
+    reach_pool.ForEach(n, f);
+  });
+}
+
+RouteComputer::~RouteComputer() noexcept
+{
+  reach_thread.LockStop();
+}
 
 void
 RouteComputer::ResetFlight()
 {
   route_clock.Reset();
   reach_clock.Reset();
+
+  /* don't let a solve in progress publish a reach of the old
+     flight */
+  reach_thread.LockWaitDone();
   protected_route_planner.Reset();
 
   last_task_type = TaskType::NONE;
@@ -56,6 +71,7 @@ RouteComputer::TerrainWarning(const MoreData &basic,
   const GlideResult& sol = calculated.task_stats.current_leg.solution_remaining;
   if (!sol.IsDefined()) {
     calculated.terrain_warning_location.SetInvalid();
+    calculated.glide_clearance.Clear();
     return;
   }
 
@@ -94,6 +110,8 @@ RouteComputer::TerrainWarning(const MoreData &basic,
 
         calculated.terrain_warning_location =
           route_planner.Intersection(start, dest);
+        route_planner.CalcGlideClearance(start, dest,
+                                         calculated.glide_clearance);
       }
       return;
     } else {
@@ -102,6 +120,7 @@ RouteComputer::TerrainWarning(const MoreData &basic,
     }
   }
   calculated.terrain_warning_location.SetInvalid();
+  calculated.glide_clearance.Clear();
 }
 
 inline void
@@ -123,18 +142,27 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
   const int h_ceiling(std::max((int)basic.nav_altitude + 500,
                                (int)calculated.common_stats.height_max_working));
 
-  if (reach_clock.CheckAdvance(basic.time, PERIOD)) {
-    protected_route_planner.SolveReach(start, config, h_ceiling, do_solve);
-
-    if (do_solve) {
-      calculated.terrain_base = protected_route_planner.GetTerrainBase();
-      calculated.terrain_base_valid = true;
+  if (reach_clock.CheckAdvance(basic.time, REACH_PERIOD)) {
+    /* the solve runs in the ReachThread, which publishes the result
+       when it's done */
+    try {
+      reach_thread.Trigger(start, config, h_ceiling, do_solve);
+    } catch (...) {
+      /* no thread: solve synchronously */
+      protected_route_planner.SolveReach(start, config, h_ceiling, do_solve);
     }
   }
+
+  /* pick up the latest result */
+  if (do_solve && !protected_route_planner.IsTerrainReachEmpty()) {
+    calculated.terrain_base = protected_route_planner.GetTerrainBase();
+    calculated.terrain_base_valid = true;
+  }
 }
 
 void
 RouteComputer::set_terrain(const RasterTerrain* _terrain) {
   terrain = _terrain;
   protected_route_planner.SetTerrain(terrain);
+  reach_thread.LockWaitDone();
 }
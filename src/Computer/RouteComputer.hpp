@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include "ReachThread.hpp"
 #include "Task/ProtectedRoutePlanner.hpp"
 #include "Engine/Task/TaskType.hpp"
 #include "Engine/Route/RoutePlanner.hpp"
 #include "time/GPSClock.hpp"
+#include "thread/ThreadPool.hpp"
 
 struct MoreData;
 struct DerivedInfo;
@@ -19,9 +21,23 @@ class GlidePolar;
 class RouteComputer {
   static constexpr std::chrono::steady_clock::duration PERIOD = std::chrono::seconds(5);
 
+  /**
+   * The reach is updated more often, because ReachFan::Update() keeps
+   * the previous solution while the aircraft has moved only a
+   * little.
+   */
+  static constexpr std::chrono::steady_clock::duration REACH_PERIOD = std::chrono::seconds(1);
+
   RoutePlannerGlue route_planner;
   ProtectedRoutePlanner protected_route_planner;
 
+  ReachThread reach_thread;
+
+  /**
+   * Expands the reach fan trees in parallel.
+   */
+  ThreadPool reach_pool{"Reach", ThreadPool::GetDefaultWorkers(3), true};
+
   GPSClock route_clock;
   GPSClock reach_clock;
 
@@ -33,6 +49,7 @@ class RouteComputer {
 public:
   RouteComputer(const Airspaces &airspace_database,
                 const ProtectedAirspaceWarningManager *warnings);
+  ~RouteComputer() noexcept;
 
   const ProtectedRoutePlanner &GetProtectedRoutePlanner() const {
     return protected_route_planner;
@@ -40,9 +57,12 @@ public:
 
   /**
    * Release all references to airspace objects from the "master"
-   * container.  Call this before modifying the container.
+   * container, and wait for a reach calculation in progress.  Call
+   * this before modifying the container.
    */
   void ClearAirspaces() {
+    /* the reach may be reading the container */
+    reach_thread.LockWaitDone();
     route_planner.Reset();
   }
 
@@ -53,6 +73,10 @@ public:
                     const GlidePolar &glide_polar,
                     const GlidePolar &safety_polar);
 
+  /**
+   * Waits for a reach calculation in progress, which may still use
+   * the old terrain.
+   */
   void set_terrain(const RasterTerrain* _terrain);
 
 private:
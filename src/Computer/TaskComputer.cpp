@@ -42,13 +42,60 @@ TaskComputer::ResetFlight([[maybe_unused]] const bool full)
   last_location_available.Clear();
 }
 
+void
+TaskComputer::MakeContestCheckpoint(const MoreData &basic,
+                                    const DerivedInfo &calculated,
+                                    const ComputerSettings &settings_computer,
+                                    ContestCheckpoint &dest) const
+{
+  dest.contest = settings_computer.contest.contest;
+  dest.date = basic.date_time_utc;
+  trace.LockedCopyTo(dest.trace);
+  dest.stats = calculated.contest_stats;
+}
+
+inline void
+TaskComputer::ResumeContestCheckpoint(const MoreData &basic,
+                                      DerivedInfo &calculated,
+                                      const ComputerSettings &settings_computer)
+{
+  const ContestCheckpoint checkpoint = std::move(*pending_checkpoint);
+  pending_checkpoint.reset();
+
+  if (!basic.time_available || !trace.GetFull().empty() ||
+      !checkpoint.IsResumable(basic.date_time_utc,
+                              basic.time.Cast<duration<unsigned>>()))
+    return;
+
+  trace.Restore(settings_computer, checkpoint.trace);
+
+  /* the predicted results depend on the current position, they
+     will be recalculated */
+  const auto &settings = settings_computer.contest;
+  if (settings.enable && !settings.predict &&
+      checkpoint.contest == settings.contest) {
+    contest.Restore(settings, checkpoint.stats);
+    calculated.contest_stats = checkpoint.stats;
+  }
+}
+
 void
 TaskComputer::ProcessBasicTask(const MoreData &basic,
                                DerivedInfo &calculated,
                                const ComputerSettings &settings_computer,
                                bool force)
 {
-  trace.Update(settings_computer, basic, calculated);
+  if (pending_checkpoint && calculated.flight.flying)
+    ResumeContestCheckpoint(basic, calculated, settings_computer);
+
+  {
+    const ScopeComputerProfile profile(profiler,
+                                       ComputerProfiler::Subsystem::TRACE);
+    trace.Update(settings_computer, basic, calculated);
+  }
+
+  const ScopeComputerProfile profile(profiler,
+                                     ComputerProfiler::Subsystem::TASK);
 
   ProtectedTaskManager::ExclusiveLease _task(task);
 
@@ -86,6 +133,9 @@ TaskComputer::ProcessMoreTask(const MoreData &basic,
                               DerivedInfo &calculated,
                               const ComputerSettings &settings_computer)
 {
+  const ScopeComputerProfile profile(profiler,
+                                     ComputerProfiler::Subsystem::ROUTE);
+
   const GlidePolar &glide_polar = settings_computer.polar.glide_polar_task;
   const GlidePolar &safety_polar = calculated.glide_polar_safety;
 
@@ -128,10 +178,13 @@ Predicted(const ContestSettings &settings,
 }
 
 void
-TaskComputer::ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
-                          const ComputerSettings &settings_computer,
-                          bool exhaustive)
+TaskComputer::ProcessContest(const MoreData &basic, DerivedInfo &calculated,
+                             const ComputerSettings &settings_computer,
+                             bool exhaustive)
 {
+  const ScopeComputerProfile profile(profiler,
+                                     ComputerProfiler::Subsystem::CONTEST);
+
   contest.SetPredicted(Predicted(settings_computer.contest, basic,
                                  calculated.task_stats.current_leg));
 
@@ -140,6 +193,14 @@ TaskComputer::ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
                             calculated.contest_stats);
   else
     contest.Solve(settings_computer.contest, calculated.contest_stats);
+}
+
+void
+TaskComputer::ProcessTaskIdle(const MoreData &basic,
+                              const DerivedInfo &calculated)
+{
+  const ScopeComputerProfile profile(profiler,
+                                     ComputerProfiler::Subsystem::TASK);
 
   const AircraftState as = ToAircraftState(basic, calculated);
 
@@ -166,6 +227,9 @@ TaskComputer::ProcessAutoTask([[maybe_unused]] const NMEAInfo &basic,
   if (calculated.altitude_agl_valid && calculated.altitude_agl > 500)
     return;
 
+  const ScopeComputerProfile profile(profiler,
+                                     ComputerProfiler::Subsystem::TASK);
+
   ProtectedTaskManager::ExclusiveLease _task(task);
   _task->TakeoffAutotask(calculated.flight.takeoff_location,
                          calculated.terrain_altitude);
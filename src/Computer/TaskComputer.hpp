@@ -6,9 +6,13 @@
 #include "RouteComputer.hpp"
 #include "TraceComputer.hpp"
 #include "ContestComputer.hpp"
+#include "ContestCheckpoint.hpp"
+#include "ComputerProfiler.hpp"
 #include "Engine/Navigation/Aircraft.hpp"
 #include "NMEA/Validity.hpp"
 
+#include <optional>
+
 struct NMEAInfo;
 class ProtectedTaskManager;
 class ProtectedAirspaceWarningManager;
@@ -30,11 +34,23 @@ class TaskComputer
 
   Validity last_location_available;
 
+  /**
+   * A checkpoint loaded at startup; it is used to resume the contest
+   * optimisation as soon as the aircraft is flying.
+   */
+  std::optional<ContestCheckpoint> pending_checkpoint;
+
+  ComputerProfiler *profiler = nullptr;
+
 public:
   TaskComputer(ProtectedTaskManager &_task,
                const Airspaces &airspace_database,
                const ProtectedAirspaceWarningManager *warnings);
 
+  void SetProfiler(ComputerProfiler *_profiler) noexcept {
+    profiler = _profiler;
+  }
+
   const ProtectedTaskManager &GetProtectedTaskManager() const {
     return task;
   }
@@ -76,12 +92,43 @@ public:
     contest.SetIncremental(incremental);
   }
 
+  /**
+   * Resume the given checkpoint if the aircraft is still flying the
+   * same flight.  It is checked (and discarded if not applicable) on
+   * the first #ProcessBasicTask() call while flying.
+   */
+  void SetContestCheckpoint(ContestCheckpoint &&checkpoint) noexcept {
+    pending_checkpoint = std::move(checkpoint);
+  }
+
+  /**
+   * Take a snapshot of the trace and the contest results.
+   */
+  void MakeContestCheckpoint(const MoreData &basic,
+                             const DerivedInfo &calculated,
+                             const ComputerSettings &settings_computer,
+                             ContestCheckpoint &dest) const;
+
   /**
    * Auto-create a task on takeoff that leads back home.
    */
   void ProcessAutoTask(const NMEAInfo &basic, const DerivedInfo &calculated);
 
-  void ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
-                   const ComputerSettings &settings_computer,
-                   bool exhaustive=false);
+  /**
+   * Solve the contest.  Writes only DerivedInfo::contest_stats, and
+   * may therefore run in parallel with ProcessTaskIdle().
+   */
+  void ProcessContest(const MoreData &basic, DerivedInfo &calculated,
+                      const ComputerSettings &settings_computer,
+                      bool exhaustive=false);
+
+  /**
+   * The slow task calculations.  Does not modify #DerivedInfo.
+   */
+  void ProcessTaskIdle(const MoreData &basic, const DerivedInfo &calculated);
+
+private:
+  void ResumeContestCheckpoint(const MoreData &basic,
+                               DerivedInfo &calculated,
+                               const ComputerSettings &settings_computer);
 };
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ThermalHistory.hpp"
+#include "Geo/FAISphere.hpp"
+#include "Math/Util.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void
+ThermalHistory::Add(const GeoPoint &location, double gain,
+                    FloatDuration duration, TimeStamp time) noexcept
+{
+  assert(location.IsValid());
+  assert(gain > 0);
+  assert(duration.count() > 0);
+
+  const double lift_rate = gain / duration.count();
+
+  auto [i, inserted] = cells.try_emplace(MakeKey(ToCell(location.latitude),
+                                                 ToCell(location.longitude)));
+  Hotspot &hotspot = i->second;
+
+  if (inserted) {
+    hotspot.location = location;
+    hotspot.gain = gain;
+    hotspot.duration = duration;
+    hotspot.best_lift_rate = lift_rate;
+    hotspot.time = time;
+    hotspot.n_climbs = 1;
+    return;
+  }
+
+  /* merge with the climbs in this cell; the new location stays
+     inside the cell */
+  hotspot.location = hotspot.location.Interpolate(location,
+                                                  gain / (hotspot.gain + gain));
+  hotspot.gain += gain;
+  hotspot.duration += duration;
+  hotspot.best_lift_rate = std::max(hotspot.best_lift_rate, lift_rate);
+  hotspot.time = std::max(hotspot.time, time);
+  ++hotspot.n_climbs;
+}
+
+const ThermalHistory::Hotspot *
+ThermalHistory::FindNearest(const GeoPoint &location, double max_distance,
+                            double min_lift_rate) const noexcept
+{
+  assert(location.IsValid());
+
+  const Hotspot *best = nullptr;
+  double best_distance = max_distance;
+
+  const auto check = [&](const Hotspot &hotspot){
+    if (hotspot.GetLiftRate() < min_lift_rate)
+      return;
+
+    const double distance = location.DistanceS(hotspot.location);
+    if (distance <= best_distance) {
+      best = &hotspot;
+      best_distance = distance;
+    }
+  };
+
+  /* the shortest side of all cells within max_distance; the cells
+     get narrower towards the poles */
+  const Angle cell_angle = Angle::Degrees(1. / CELLS_PER_DEGREE);
+  const Angle max_latitude =
+    std::min(location.latitude.Absolute() +
+             FAISphere::EarthDistanceToAngle(max_distance) + cell_angle,
+             Angle::QuarterCircle());
+  const double min_side =
+    FAISphere::AngleToEarthDistance(cell_angle) * max_latitude.cos();
+
+  const double n_rings = min_side > 0
+    ? std::ceil(max_distance / min_side) + 1
+    : HUGE_VAL;
+  if (Square(2 * n_rings + 1) > double(cells.size())) {
+    /* cheaper to look at all hotspots */
+    for (const auto &[key, hotspot] : cells)
+      check(hotspot);
+    return best;
+  }
+
+  const int lat = ToCell(location.latitude);
+  const int lon = ToCell(location.longitude);
+
+  const auto check_cell = [&](int cell_lat, int cell_lon){
+    if (auto i = cells.find(MakeKey(cell_lat, cell_lon)); i != cells.end())
+      check(i->second);
+  };
+
+  for (int r = 0; r <= int(n_rings); ++r) {
+    /* all cells of this ring and beyond are separated from the
+       location by at least r-1 cells */
+    if (best != nullptr && best_distance <= (r - 1) * min_side)
+      break;
+
+    if (r == 0) {
+      check_cell(lat, lon);
+      continue;
+    }
+
+    for (int x = -r; x <= r; ++x) {
+      check_cell(lat - r, lon + x);
+      check_cell(lat + r, lon + x);
+    }
+
+    for (int y = -r + 1; y < r; ++y) {
+      check_cell(lat + y, lon - r);
+      check_cell(lat + y, lon + r);
+    }
+  }
+
+  return best;
+}
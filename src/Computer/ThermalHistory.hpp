@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoPoint.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "thread/Mutex.hxx"
+#include "time/Stamp.hpp"
+#include "time/FloatDuration.hxx"
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * All climbs of the flight, indexed on a grid of latitude/longitude
+ * cells (about 1.1 km high).  Climbs falling into the same cell are
+ * merged into one #Hotspot.  Adding a climb is O(1); queries only
+ * look at the cells near the given location (or at all hotspots, if
+ * that is cheaper).
+ */
+class ThermalHistory {
+public:
+  /**
+   * The number of grid cells per degree of latitude and longitude.
+   */
+  static constexpr int CELLS_PER_DEGREE = 100;
+
+  struct Hotspot {
+    /**
+     * The average location of the climbs, weighted by their height
+     * gain.
+     */
+    GeoPoint location;
+
+    /**
+     * The total height gain of all climbs [m].
+     */
+    double gain;
+
+    /**
+     * The total duration of all climbs.
+     */
+    FloatDuration duration;
+
+    /**
+     * The best average lift rate of a single climb [m/s].
+     */
+    double best_lift_rate;
+
+    /**
+     * The end of the most recent climb.
+     */
+    TimeStamp time;
+
+    unsigned n_climbs;
+
+    /**
+     * The average lift rate of all climbs [m/s].
+     */
+    double GetLiftRate() const noexcept {
+      return gain / duration.count();
+    }
+  };
+
+  mutable Mutex mutex;
+
+private:
+  using Key = uint_least64_t;
+
+  std::unordered_map<Key, Hotspot> cells;
+
+public:
+  bool empty() const noexcept {
+    return cells.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return cells.size();
+  }
+
+  void Clear() noexcept {
+    cells.clear();
+  }
+
+  /**
+   * Record a climb.
+   *
+   * @param gain the height gain [m], must be positive
+   * @param duration the duration of the climb, must be positive
+   */
+  void Add(const GeoPoint &location, double gain, FloatDuration duration,
+           TimeStamp time) noexcept;
+
+  /**
+   * Find the hotspot nearest to the given location.
+   *
+   * @param max_distance ignore hotspots farther away than this [m]
+   * @param min_lift_rate ignore hotspots with a lower average lift
+   * rate [m/s]
+   * @return the hotspot or nullptr if there is none; the pointer is
+   * invalidated by the next Add() or Clear() call
+   */
+  [[gnu::pure]]
+  const Hotspot *FindNearest(const GeoPoint &location, double max_distance,
+                             double min_lift_rate=0) const noexcept;
+
+  /**
+   * Invoke the visitor for each #Hotspot inside the given bounds.
+   */
+  template<typename V>
+  void VisitWithin(const GeoBounds &bounds, V &&visitor) const {
+    const int south = ToCell(bounds.GetSouth());
+    const int north = ToCell(bounds.GetNorth());
+    const int west = ToCell(bounds.GetWest());
+    int east = ToCell(bounds.GetEast());
+    if (east < west)
+      /* the bounds cross the date line */
+      east += 360 * CELLS_PER_DEGREE;
+
+    if (std::size_t(north - south + 1) * std::size_t(east - west + 1) >
+        cells.size()) {
+      /* cheaper to look at all hotspots */
+      for (const auto &[key, hotspot] : cells)
+        if (bounds.IsInside(hotspot.location))
+          visitor(hotspot);
+      return;
+    }
+
+    for (int lat = south; lat <= north; ++lat) {
+      for (int lon = west; lon <= east; ++lon) {
+        auto i = cells.find(MakeKey(lat, lon));
+        if (i != cells.end() && bounds.IsInside(i->second.location))
+          visitor(i->second);
+      }
+    }
+  }
+
+private:
+  [[gnu::const]]
+  static int ToCell(Angle angle) noexcept {
+    return (int)std::floor(angle.Degrees() * CELLS_PER_DEGREE);
+  }
+
+  /**
+   * @param lon the longitude cell; it is wrapped around the date
+   * line
+   */
+  static constexpr Key MakeKey(int lat, int lon) noexcept {
+    constexpr int n_lon = 360 * CELLS_PER_DEGREE;
+    lon %= n_lon;
+    if (lon < 0)
+      lon += n_lon;
+
+    return (Key(lat + 90 * CELLS_PER_DEGREE) << 32) | Key(lon);
+  }
+};
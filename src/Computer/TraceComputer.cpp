@@ -5,6 +5,9 @@
 #include "Settings.hpp"
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
+#include "Engine/Trace/Vector.hpp"
+
+#include <algorithm>
 
 static constexpr unsigned full_trace_size = 1024;
 static constexpr unsigned contest_trace_size = 256;
@@ -20,22 +23,69 @@ TraceComputer::TraceComputer()
 }
 
 void
-TraceComputer::Reset()
+TraceComputer::Publish() noexcept
 {
+  /* recycle the previous copy if no reader holds it anymore; nobody
+     can obtain a new reference, because it is not published */
+  std::shared_ptr<Published> p = spare.use_count() == 1
+    ? std::const_pointer_cast<Published>(std::move(spare))
+    : std::make_shared<Published>();
+  spare.reset();
+
+  full.GetPoints(p->points);
+  p->projection = full.GetProjection();
+  p->serial = full.GetAppendSerial();
+
   {
     const std::lock_guard lock{mutex};
-    full.clear();
+    published.swap(spare);
+    published = std::move(p);
   }
+}
 
+void
+TraceComputer::Reset()
+{
+  full.clear();
   contest.clear();
   sprint.clear();
+
+  Publish();
+}
+
+void
+TraceComputer::Restore(const ComputerSettings &settings_computer,
+                       const TracePointVector &points)
+{
+  assert(full.empty());
+
+  for (const auto &point : points)
+    full.push_back(point);
+
+  Publish();
+
+  if (settings_computer.contest.enable) {
+    for (const auto &point : points) {
+      sprint.push_back(point);
+      contest.push_back(point);
+    }
+  }
+}
+
+Serial
+TraceComputer::LockedGetSerial() const
+{
+  const auto p = GetPublished();
+  return p ? p->serial : Serial{};
 }
 
 void
 TraceComputer::LockedCopyTo(TracePointVector &v) const
 {
-  const std::lock_guard lock{mutex};
-  full.GetPoints(v);
+  v.clear();
+
+  if (const auto p = GetPublished())
+    v = p->points;
 }
 
 void
@@ -44,8 +94,34 @@ TraceComputer::LockedCopyTo(TracePointVector &v,
                             const GeoPoint &location,
                             double resolution) const
 {
-  const std::lock_guard lock{mutex};
-  full.GetPoints(v, min_time, location, resolution);
+  const auto p = GetPublished();
+  if (!p)
+    return;
+
+  /* same as Trace::GetPoints(), but on the published copy */
+
+  const auto &points = p->points;
+  auto i = std::find_if(points.begin(), points.end(),
+                        [min_time](const TracePoint &point){
+                          return point.GetTime() >= min_time;
+                        });
+  if (i == points.end())
+    return;
+
+  const unsigned range = p->projection.ProjectRangeInteger(location,
+                                                           resolution);
+  const unsigned sq_range = range * range;
+
+  v.reserve(v.size() + std::distance(i, points.end()));
+
+  const TracePoint *previous = &*i;
+  v.push_back(*i);
+  for (++i; i != points.end(); ++i) {
+    if (i->FlatSquareDistanceTo(*previous) >= sq_range) {
+      v.push_back(*i);
+      previous = &*i;
+    }
+  }
 }
 
 void
@@ -61,10 +137,8 @@ TraceComputer::Update(const ComputerSettings &settings_computer,
 
   const TracePoint point(basic);
 
-  {
-    const std::lock_guard lock{mutex};
-    full.push_back(point);
-  }
+  full.push_back(point);
+  Publish();
 
   // only contest requires trace_sprint
   if (settings_computer.contest.enable) {
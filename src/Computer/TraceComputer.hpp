@@ -5,6 +5,11 @@
 
 #include "thread/Mutex.hxx"
 #include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "util/Serial.hpp"
+
+#include <memory>
 
 struct ComputerSettings;
 struct MoreData;
@@ -15,24 +20,41 @@ struct DerivedInfo;
  */
 class TraceComputer {
   /**
-   * This mutex protects trace_full: it must be locked while editing
-   * the trace, and while reading it from a thread other than the
-   * #CalculationThread.
+   * A copy of the full trace, published for other threads after
+   * each modification.  It is never modified after it has been
+   * published.
+   */
+  struct Published {
+    TracePointVector points;
+    FlatProjection projection;
+    Serial serial;
+  };
+
+  /**
+   * This mutex protects #published.  It is only held while the
+   * pointer is copied, so readers never block the
+   * #CalculationThread for longer than that.
    */
   mutable Mutex mutex;
 
+  std::shared_ptr<const Published> published;
+
+  /**
+   * The previously published copy; it is recycled by Publish() as
+   * soon as no reader holds it anymore.  This attribute is only used
+   * by the #CalculationThread.
+   */
+  std::shared_ptr<const Published> spare;
+
   Trace full, contest, sprint;
 
 public:
   TraceComputer();
 
-  operator Mutex &() const {
-    return const_cast<Mutex &>(mutex);
-  }
-
   /**
-   * Returns a reference to the full trace.  When using this reference
-   * outside of the #CalculationThread, the mutex must be locked.
+   * Returns a reference to the full trace.  This object may be used
+   * only inside the #CalculationThread; other threads use
+   * LockedCopyTo().
    */
   const Trace &GetFull() const {
     return full;
@@ -57,14 +79,30 @@ public:
   void Reset();
 
   /**
-   * Extract all trace points.  The trace is locked, and the method
-   * may be called from any thread.
+   * Fill the (empty) traces with the given points, e.g. from a
+   * checkpoint saved before the program was restarted.
+   */
+  void Restore(const ComputerSettings &settings_computer,
+               const TracePointVector &points);
+
+  /**
+   * Returns the Trace::GetAppendSerial() of the published full
+   * trace.  It changes whenever the full trace is modified, and
+   * allows callers to skip copying a trace which they already have.
+   * The method may be called from any thread.
+   */
+  [[gnu::pure]]
+  Serial LockedGetSerial() const;
+
+  /**
+   * Extract all trace points from the published copy of the full
+   * trace.  The method may be called from any thread.
    */
   void LockedCopyTo(TracePointVector &v) const;
 
   /**
-   * Extract some trace points.  The trace is locked, and the method
-   * may be called from any thread.
+   * Extract some trace points from the published copy of the full
+   * trace.  The method may be called from any thread.
    */
   void LockedCopyTo(TracePointVector &v,
                     std::chrono::duration<unsigned> min_time,
@@ -72,4 +110,17 @@ public:
 
   void Update(const ComputerSettings &settings_computer,
               const MoreData &basic, const DerivedInfo &calculated);
+
+private:
+  [[gnu::pure]]
+  std::shared_ptr<const Published> GetPublished() const noexcept {
+    const std::lock_guard lock{mutex};
+    return published;
+  }
+
+  /**
+   * Publish a copy of the full trace for other threads.  To be
+   * called after the full trace has been modified.
+   */
+  void Publish() noexcept;
 };
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Math/Angle.hpp"
+#include "NMEA/Validity.hpp"
+#include "util/StaticString.hxx"
+
+#include <type_traits>
+
+/**
+ * Radar (JETProvider) traffic closing in on the aircraft, as
+ * calculated by #TrafficProximityComputer.
+ */
+struct TrafficProximityInfo {
+  /**
+   * Is this information up to date?  If not, then no radar traffic
+   * has been checked.
+   */
+  Validity available;
+
+  /**
+   * The number of intruders within the search volume which are
+   * closing in.
+   */
+  unsigned intruder_count;
+
+  /**
+   * The most urgent intruder (the one with the smallest time to the
+   * closest approach); only valid if #intruder_count is non-zero.
+   */
+  struct Intruder {
+    StaticString<16> id;
+
+    /**
+     * The current horizontal distance [m].
+     */
+    double distance;
+
+    /**
+     * The altitude of the intruder above (positive) or below
+     * (negative) the aircraft [m].
+     */
+    double relative_altitude;
+
+    /**
+     * The bearing from the aircraft to the intruder.
+     */
+    Angle bearing;
+
+    /**
+     * The speed at which the horizontal distance shrinks [m/s].
+     */
+    double closing_speed;
+
+    /**
+     * The time until the closest horizontal approach [s].
+     */
+    double time_to_closest;
+  } nearest;
+
+  void Clear() noexcept {
+    available.Clear();
+    intruder_count = 0;
+  }
+
+  bool HasIntruder() const noexcept {
+    return available && intruder_count > 0;
+  }
+};
+
+static_assert(std::is_trivial<TrafficProximityInfo>::value,
+              "type is not trivial");
@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TrafficProximityComputer.hpp"
+#include "TrafficProximity.hpp"
+#include "NMEA/MoreData.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Tracking/JETProvider/JETProvider.hpp"
+#include "Tracking/JETProvider/Settings.hpp"
+#include "Tracking/JETProvider/TrafficTable.hpp"
+#include "Tracking/JETProvider/Extrapolate.hpp"
+#include "Geo/GeoVector.hpp"
+
+#include <algorithm>
+
+#include <math.h>
+
+/**
+ * Approximate length of one degree of latitude [m].
+ */
+static constexpr double METERS_PER_DEGREE = 111195;
+
+/**
+ * If more cells than this would have to be searched, the table is
+ * scanned linearly.
+ */
+static constexpr unsigned MAX_SEARCH_RADIUS = 8;
+
+void
+TrafficProximityComputer::Reset() noexcept
+{
+  table.reset();
+  index.clear();
+}
+
+inline TrafficProximityComputer::CellKey
+TrafficProximityComputer::GetCell(double latitude, double longitude,
+                                  double altitude) const noexcept
+{
+  return {
+    int32_t(floor(latitude * METERS_PER_DEGREE / cell_size)),
+    int32_t(floor(longitude * longitude_scale / cell_size)),
+    int32_t(floor(altitude / band_height)),
+  };
+}
+
+void
+TrafficProximityComputer::BuildIndex(const std::shared_ptr<const JETProvider::TrafficTable> &_table,
+                                     const AircraftState &aircraft,
+                                     const JETProviderSettings &settings) noexcept
+{
+  table = _table;
+  cell_size = std::max(settings.proximity.range, 500.);
+  band_height = std::max(settings.proximity.height, 50.);
+  longitude_scale = METERS_PER_DEGREE *
+    std::max(aircraft.location.latitude.fastcosine(), 0.01);
+  max_speed = max_vspeed = 0;
+
+  index.clear();
+  index.reserve(table->size());
+
+  uint32_t i = 0;
+  for (const auto &traffic : *table) {
+    index.push_back({
+        GetCell(traffic.location.latitude.Degrees(),
+                traffic.location.longitude.Degrees(),
+                traffic.altitude),
+        i++,
+      });
+
+    max_speed = std::max(max_speed, traffic.speed);
+    max_vspeed = std::max(max_vspeed, fabs(traffic.vspeed));
+  }
+
+  std::sort(index.begin(), index.end(), [](const Entry &a, const Entry &b){
+    return a.key < b.key;
+  });
+}
+
+void
+TrafficProximityComputer::Compute(const MoreData &basic,
+                                  const AircraftState &aircraft,
+                                  const JETProviderSettings &settings,
+                                  TrafficProximityInfo &info) noexcept
+{
+  const auto *_data = data.load(std::memory_order_relaxed);
+  if (_data == nullptr || !settings.proximity.enabled ||
+      !basic.location_available || !basic.NavAltitudeAvailable()) {
+    info.Clear();
+    return;
+  }
+
+  const auto snapshot = _data->GetSnapshot();
+  if (snapshot.table == nullptr) {
+    Reset();
+    info.Clear();
+    return;
+  }
+
+  /* prefer the GPS clock, like the map does */
+  const auto now = basic.time_available && basic.date_time_utc.IsPlausible()
+    ? basic.date_time_utc.ToTimePoint()
+    : std::chrono::system_clock::now();
+
+  Compute(snapshot.table, now,
+          JETProvider::GetStaleAfter(settings.radar.interval),
+          aircraft, settings, info);
+  info.available.Update(basic.clock);
+}
+
+void
+TrafficProximityComputer::Compute(const std::shared_ptr<const JETProvider::TrafficTable> &_table,
+                                  std::chrono::system_clock::time_point now,
+                                  std::chrono::duration<double> stale_after,
+                                  const AircraftState &aircraft,
+                                  const JETProviderSettings &settings,
+                                  TrafficProximityInfo &info) noexcept
+{
+  const double range = settings.proximity.range;
+  const double height = settings.proximity.height;
+  const double min_cos_cone =
+    Angle::Degrees(settings.proximity.cone).fastcosine();
+
+  if (_table != table || cell_size != std::max(range, 500.) ||
+      band_height != std::max(height, 50.))
+    BuildIndex(_table, aircraft, settings);
+
+  const auto own_velocity = aircraft.track.SinCos();
+  const double own_vx = own_velocity.first * aircraft.ground_speed;
+  const double own_vy = own_velocity.second * aircraft.ground_speed;
+
+  info.intruder_count = 0;
+
+  const auto check = [&](const JETProvider::Traffic &traffic){
+    const auto e = JETProvider::Extrapolate(traffic, now, stale_after,
+                                            stale_after);
+    if (!e || e->stale || e->altitude < 0)
+      return;
+
+    const double relative_altitude = e->altitude - aircraft.altitude;
+    if (fabs(relative_altitude) > height)
+      return;
+
+    const GeoVector vector(aircraft.location, e->location);
+    if (vector.distance > range)
+      return;
+
+    /* the intruder's position and velocity relative to us
+       (x = east, y = north) */
+    const auto direction = vector.bearing.SinCos();
+    const double px = direction.first * vector.distance;
+    const double py = direction.second * vector.distance;
+
+    const auto track = Angle::Degrees(traffic.track).SinCos();
+    const double vx = track.first * traffic.speed - own_vx;
+    const double vy = track.second * traffic.speed - own_vy;
+
+    /* negative if closing in */
+    const double dot = px * vx + py * vy;
+    if (dot >= 0)
+      return;
+
+    const double relative_speed = hypot(vx, vy);
+    if (vector.distance > 1 &&
+        -dot / (vector.distance * relative_speed) < min_cos_cone)
+      /* passing by, outside of the closure cone */
+      return;
+
+    const double time_to_closest = -dot / (relative_speed * relative_speed);
+
+    if (info.intruder_count++ == 0 ||
+        time_to_closest < info.nearest.time_to_closest) {
+      auto &nearest = info.nearest;
+      nearest.id = traffic.traffic_id;
+      nearest.distance = vector.distance;
+      nearest.relative_altitude = relative_altitude;
+      nearest.bearing = vector.bearing;
+      nearest.closing_speed = vector.distance > 1
+        ? -dot / vector.distance
+        : relative_speed;
+      nearest.time_to_closest = time_to_closest;
+    }
+  };
+
+  /* a target may have moved this far since it was reported */
+  const double margin = std::min(stale_after.count(), 600.);
+  const unsigned radius =
+    unsigned(ceil((range + max_speed * margin) / cell_size));
+  const unsigned band_radius =
+    unsigned(ceil((height + max_vspeed * margin) / band_height));
+
+  if (radius > MAX_SEARCH_RADIUS || band_radius > MAX_SEARCH_RADIUS ||
+      (2 * radius + 1) * (2 * radius + 1) * (2 * band_radius + 1) >= index.size()) {
+    /* the grid would not help */
+    for (const auto &traffic : *table)
+      check(traffic);
+    return;
+  }
+
+  const CellKey center = GetCell(aircraft.location.latitude.Degrees(),
+                                 aircraft.location.longitude.Degrees(),
+                                 aircraft.altitude);
+  const auto begin = table->begin();
+
+  for (int dy = -int(radius); dy <= int(radius); ++dy) {
+    for (int dx = -int(radius); dx <= int(radius); ++dx) {
+      /* the bands of one cell are adjacent in the index */
+      const CellKey first{center.y + dy, center.x + dx,
+                          center.band - int(band_radius)};
+      const CellKey last{center.y + dy, center.x + dx,
+                         center.band + int(band_radius)};
+
+      auto i = std::lower_bound(index.begin(), index.end(), first,
+                                [](const Entry &a, const CellKey &b){
+                                  return a.key < b;
+                                });
+      for (; i != index.end() && i->key <= last; ++i)
+        check(begin[i->index]);
+    }
+  }
+}
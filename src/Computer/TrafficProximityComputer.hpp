@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <compare>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct MoreData;
+struct AircraftState;
+struct TrafficProximityInfo;
+struct JETProviderSettings;
+namespace JETProvider { struct Data; class TrafficTable; }
+
+/**
+ * Looks for radar (JETProvider) traffic closing in on the aircraft.
+ *
+ * For each new traffic table, the targets are sorted into a grid of
+ * cells (one search range wide) and altitude bands (one search
+ * height tall), so each check only has to look at the cells around
+ * the aircraft instead of the whole table.
+ */
+class TrafficProximityComputer {
+  std::atomic<const JETProvider::Data *> data{nullptr};
+
+  struct CellKey {
+    int32_t y, x;
+    int32_t band;
+
+    friend constexpr auto operator<=>(const CellKey &,
+                                      const CellKey &) noexcept = default;
+  };
+
+  struct Entry {
+    CellKey key;
+    uint32_t index;
+  };
+
+  /**
+   * The table #index was built for.
+   */
+  std::shared_ptr<const JETProvider::TrafficTable> table;
+
+  /**
+   * All targets of #table, sorted by their cell.
+   */
+  std::vector<Entry> index;
+
+  /**
+   * The grid parameters #index was built with.
+   */
+  double cell_size, band_height, longitude_scale;
+
+  /**
+   * The largest ground speed and vertical speed of all targets of
+   * #table.  Used to widen the search by the distance a target may
+   * have moved since its report.
+   */
+  double max_speed, max_vspeed;
+
+public:
+  /**
+   * Set the source of the radar traffic.  May be called while the
+   * CalculationThread is running.
+   */
+  void SetData(const JETProvider::Data *_data) noexcept {
+    data.store(_data, std::memory_order_relaxed);
+  }
+
+  void Reset() noexcept;
+
+  void Compute(const MoreData &basic, const AircraftState &aircraft,
+               const JETProviderSettings &settings,
+               TrafficProximityInfo &info) noexcept;
+
+  /**
+   * Check the given table.  This is the part of Compute() which does
+   * not depend on the blackboard.
+   *
+   * @param stale_after traffic older than this is ignored
+   * @param info the #TrafficProximityInfo::available attribute is not
+   * modified
+   */
+  void Compute(const std::shared_ptr<const JETProvider::TrafficTable> &table,
+               std::chrono::system_clock::time_point now,
+               std::chrono::duration<double> stale_after,
+               const AircraftState &aircraft,
+               const JETProviderSettings &settings,
+               TrafficProximityInfo &info) noexcept;
+
+private:
+  void BuildIndex(const std::shared_ptr<const JETProvider::TrafficTable> &table,
+                  const AircraftState &aircraft,
+                  const JETProviderSettings &settings) noexcept;
+
+  [[gnu::pure]]
+  CellKey GetCell(double latitude, double longitude,
+                  double altitude) const noexcept;
+};
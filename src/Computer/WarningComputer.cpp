@@ -17,6 +17,10 @@ WarningComputer::WarningComputer(const AirspaceWarningConfig &_config,
    manager(_config, airspaces),
    protected_manager(manager)
 {
+  manager.SetForEach([this](std::size_t n,
+                            const std::function<void(std::size_t)> &f){
+    pool.ForEach(n, f);
+  });
 }
 
 void
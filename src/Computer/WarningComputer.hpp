@@ -5,6 +5,7 @@
 
 #include "Engine/Airspace/AirspaceWarningManager.hpp"
 #include "Airspace/ProtectedAirspaceWarningManager.hpp"
+#include "thread/ThreadPool.hpp"
 #include "time/DeltaTime.hpp"
 
 class Airspaces;
@@ -21,6 +22,12 @@ class WarningComputer {
 
   Airspaces &airspaces;
 
+  /**
+   * Runs the warning predictions of the #AirspaceWarningManager in
+   * parallel.
+   */
+  ThreadPool pool{"AirspaceWarning", ThreadPool::GetDefaultWorkers(3)};
+
   AirspaceWarningManager manager;
   ProtectedAirspaceWarningManager protected_manager;
 
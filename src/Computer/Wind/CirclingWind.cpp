@@ -131,30 +131,46 @@ CirclingWind::CalcWind()
   if ((samples.back().time - samples[0].time) / (samples.size() - 1) > std::chrono::seconds{2})
     return Result(0);
 
+  const unsigned n = samples.size();
+  const unsigned half = n / 2;
+
   // find average
-  double av = 0;
-  for (unsigned i = 0; i < samples.size(); i++)
-    av += samples[i].vector.norm;
+  double total = 0;
+  for (const Sample &sample : samples)
+    total += sample.vector.norm;
+
+  const double av = total / n;
+
+  /* find zero time for times above average: for each rotation j,
+     rthisp is the sum of all speeds weighted with their (circular)
+     index distance from j; the minimum is where the ground speed is
+     lowest */
 
-  av /= samples.size();
+  /* the sum for j=0 */
+  double rthisp = 0;
+  for (unsigned i = 1; i < n; i++)
+    rthisp += samples[i].vector.norm * (i > half ? n - i : i);
+
+  /* the sum of the "half" samples following j, whose weight
+     decreases by one when j advances */
+  double window = 0;
+  for (unsigned i = 1; i <= half; i++)
+    window += samples[i % n].vector.norm;
 
-  // find zero time for times above average
   double rthismax = 0;
   double rthismin = 0;
   int jmax = -1;
   int jmin = -1;
 
-  for (unsigned j = 0; j < samples.size(); j++) {
-    double rthisp = 0;
-
-    for (unsigned i = 1; i < samples.size(); i++) {
-      const unsigned ithis = (i + j) % samples.size();
-      unsigned idiff = i;
-
-      if (idiff > samples.size() / 2)
-        idiff = samples.size() - idiff;
+  for (unsigned j = 0; j < n; j++) {
+    if (j > 0) {
+      /* advance the weights by one sample in O(1): the "half"
+         following samples lose one, the others gain one; if n is
+         odd, the sample opposite of j keeps its weight */
+      const double opposite = samples[(j + half) % n].vector.norm;
+      rthisp += total - 2 * window - (n % 2 != 0 ? opposite : 0);
 
-      rthisp += samples[ithis].vector.norm * idiff;
+      window += samples[(j + half) % n].vector.norm - samples[j].vector.norm;
     }
 
     if ((rthisp < rthismax) || (jmax == -1)) {
@@ -4,6 +4,7 @@
 #include "Descriptor.hpp"
 #include "DataEditor.hpp"
 #include "NMEA/Info.hpp"
+#include "GliderLink/GliderLinkId.hpp"
 #include "Geo/Geoid.hpp"
 #include "time/FloatDuration.hxx"
 
@@ -153,6 +154,18 @@ ComputeNoncompVario(const double pressure, const double d_pressure)
   return FACTOR * pow(pressure, EXPONENT) * d_pressure;
 }
 
+/**
+ * Publish the state of the pressure Kalman filter.
+ */
+static void
+ProvidePressure(NMEAInfo &basic, const SelfTimingKalmanFilter1d &kalman_filter) noexcept
+{
+  basic.ProvideNoncompVario(ComputeNoncompVario(kalman_filter.GetXAbs(),
+                                                kalman_filter.GetXVel()));
+  basic.ProvideStaticPressure(
+      AtmosphericPressure::HectoPascal(kalman_filter.GetXAbs()));
+}
+
 void
 DeviceDescriptor::OnBarometricPressureSensor(float pressure,
                                              float sensor_noise_variance) noexcept
@@ -167,10 +180,51 @@ DeviceDescriptor::OnBarometricPressureSensor(float pressure,
 
   basic.UpdateClock();
   basic.alive.Update(basic.clock);
-  basic.ProvideNoncompVario(ComputeNoncompVario(kalman_filter.GetXAbs(),
-                                                kalman_filter.GetXVel()));
-  basic.ProvideStaticPressure(
-      AtmosphericPressure::HectoPascal(kalman_filter.GetXAbs()));
+  ProvidePressure(basic, kalman_filter);
+
+  e.Commit();
+}
+
+void
+DeviceDescriptor::OnSensorBatch(std::span<const SensorSample> samples,
+                                steady_clock::duration clock_offset) noexcept
+{
+  if (samples.empty())
+    return;
+
+  /* apply all samples with one lock and one merge */
+  const auto e = BeginEdit();
+  NMEAInfo &basic = *e;
+  basic.UpdateClock();
+  basic.alive.Update(basic.clock);
+
+  bool have_pressure = false;
+
+  for (const auto &sample : samples) {
+    switch (sample.type) {
+    case SensorSample::Type::ACCELERATION:
+      basic.acceleration.ProvideGLoad(sample.values[3]);
+      break;
+
+    case SensorSample::Type::ROTATION:
+    case SensorSample::Type::MAGNETIC_FIELD:
+      // TODO
+      break;
+
+    case SensorSample::Type::PRESSURE:
+      /* feed the filter with the measurement time, not with the
+         time this batch arrives */
+      kalman_filter.Update(sample.values[0], sample.values[1],
+                           steady_clock::time_point{
+                             duration_cast<steady_clock::duration>(nanoseconds{sample.timestamp})
+                             + clock_offset});
+      have_pressure = true;
+      break;
+    }
+  }
+
+  if (have_pressure)
+    ProvidePressure(basic, kalman_filter);
 
   e.Commit();
 }
@@ -432,17 +486,27 @@ DeviceDescriptor::OnGliderLinkTraffic(GliderLinkId id, const char *callsign,
   basic.UpdateClock();
   basic.alive.Update(basic.clock);
 
-  GliderLinkTrafficList &traffic_list = basic.glink_data.traffic;
+  /* GliderLink targets share the list of non-FLARM traffic, so they
+     are merged with the other devices' traffic, and processed and
+     drawn like it */
+  AdsbTrafficList &traffic_list = basic.flarm.adsb_traffic;
+  traffic_list.modified.Update(basic.clock);
 
-  GliderLinkTraffic *traffic = traffic_list.FindTraffic(id);
+  const FlarmId flarm_id = id.ToFlarmId();
+  FlarmTraffic *traffic = traffic_list.FindTraffic(flarm_id);
   if (traffic == nullptr) {
-    traffic = traffic_list.AllocateTraffic();
+    traffic = traffic_list.AllocateTraffic(flarm_id);
     if (traffic == nullptr)
       // no more slots available
       return;
 
-    traffic->Clear();
-    traffic->id = id;
+    traffic->alarm_level = FlarmTraffic::AlarmType::NONE;
+    traffic->type = FlarmTraffic::AircraftType::GLIDER;
+    traffic->source = FlarmTraffic::Source::GLIDER_LINK;
+    traffic->stealth = false;
+    traffic->turn_rate_received = false;
+    traffic->climb_rate_avg30s_available = false;
+    traffic->cpa_available = false;
 
     traffic_list.new_traffic.Update(basic.clock);
   }
@@ -450,16 +514,26 @@ DeviceDescriptor::OnGliderLinkTraffic(GliderLinkId id, const char *callsign,
   traffic->name.SetASCII(callsign);
 
   traffic->location = location;
+  traffic->location_available = true;
+
+  /* the relative position is calculated by FlarmComputer */
+  traffic->relative_north = traffic->relative_east = 0;
+  traffic->relative_altitude = 0;
+  traffic->distance = 0;
 
-  traffic->altitude_received = altitude > ALT_NONE;
-  if (traffic->altitude_received)
+  traffic->altitude_available = altitude > ALT_NONE;
+  if (traffic->altitude_available)
     traffic->altitude = altitude;
   traffic->speed_received = gspeed >= GSPEED_NONE;
   if (traffic->speed_received)
     traffic->speed = gspeed;
   traffic->climb_rate_received = vspeed > VSPEED_NONE;
   if (traffic->climb_rate_received)
-    traffic->climb_rate = vspeed;
+    /* there is no history to average; this shows up in the climb
+       label like FLARM's 30s average */
+    traffic->climb_rate = traffic->climb_rate_avg30s = vspeed;
+  else
+    traffic->climb_rate_avg30s = 0;
   traffic->track_received = bearing < BEARING_NONE;
   if (traffic->track_received)
     traffic->track = Angle::Degrees(bearing);
@@ -10,6 +10,7 @@
 #include "Driver/FLARM/Device.hpp"
 #include "Driver/LX/Internal.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
+#include "Audio/VarioGlue.hpp"
 #include "Components.hpp"
 #include "Port/ConfiguredPort.hpp"
 #include "Port/DumpPort.hpp"
@@ -49,6 +50,7 @@
 #endif
 
 #include <cassert>
+#include <utility>
 
 class OpenDeviceJob final : public Job {
   DeviceDescriptor &device;
@@ -1281,6 +1283,15 @@ DeviceDescriptor::OnSensorUpdate(const MoreData &basic) noexcept
   /* must hold the mutex because this method may run in any thread,
      just in case the main thread deletes the Device while this method
      still runs */
+  {
+    const std::lock_guard lock{statistics_mutex};
+    if (received_time != std::chrono::steady_clock::time_point{}) {
+      statistics.merge_delay.Add(std::chrono::steady_clock::now() -
+                                 received_time);
+      merged_time = std::exchange(received_time, {});
+    }
+  }
+
   const std::lock_guard lock{mutex};
 
   if (device != nullptr)
@@ -1297,6 +1308,13 @@ DeviceDescriptor::OnCalculatedUpdate(const MoreData &basic,
 {
   assert(InMainThread());
 
+  {
+    const std::lock_guard lock{statistics_mutex};
+    if (merged_time != std::chrono::steady_clock::time_point{})
+      statistics.calculated_delay.Add(std::chrono::steady_clock::now() -
+                                      std::exchange(merged_time, {}));
+  }
+
   if (device != nullptr)
     try {
       device->OnCalculatedUpdate(basic, calculated);
@@ -1305,6 +1323,31 @@ DeviceDescriptor::OnCalculatedUpdate(const MoreData &basic,
     }
 }
 
+void
+DeviceDescriptor::ResetStatistics() noexcept
+{
+  const std::lock_guard lock{statistics_mutex};
+  statistics = {};
+  received_time = merged_time = {};
+}
+
+inline void
+DeviceDescriptor::FeedAudioVario(const NMEAInfo &info,
+                                 Validity old_availability) noexcept
+{
+  if (vario_audio_source.load(std::memory_order_relaxed) &&
+      info.total_energy_vario_available.Modified(old_availability))
+    AudioVarioGlue::SetValue(info.total_energy_vario);
+}
+
+void
+DeviceDescriptor::OnDataReceived(std::chrono::steady_clock::time_point now) noexcept
+{
+  const std::lock_guard lock{statistics_mutex};
+  if (received_time == std::chrono::steady_clock::time_point{})
+    received_time = now;
+}
+
 inline void
 DeviceDescriptor::LockSetErrorMessage(const TCHAR *msg) noexcept
 {
@@ -1374,15 +1417,24 @@ DeviceDescriptor::DataReceived(std::span<const std::byte> s) noexcept
   if (monitor != nullptr)
     monitor->DataReceived(s);
 
+  {
+    const std::lock_guard lock{statistics_mutex};
+    statistics.bytes_received += s.size();
+  }
+
   // Pass data directly to drivers that use binary data protocols
   if (driver != nullptr && device != nullptr && driver->UsesRawData()) {
     auto basic = device_blackboard->LockGetDeviceDataUpdateClock(index);
 
     const ExternalSettings old_settings = basic.settings;
+    const Validity old_vario = basic.total_energy_vario_available;
 
     /* call Device::DataReceived() without holding
        DeviceBlackboard::mutex to avoid blocking all other threads */
     if (device->DataReceived(s, basic)) {
+      OnDataReceived(std::chrono::steady_clock::now());
+      FeedAudioVario(basic, old_vario);
+
       if (!config.sync_from_device)
         basic.settings = old_settings;
 
@@ -1392,9 +1444,19 @@ DeviceDescriptor::DataReceived(std::span<const std::byte> s) noexcept
     return true;
   }
 
-  if (!IsNMEAOut())
+  if (!IsNMEAOut()) {
+    in_burst = true;
+    burst_parsed = false;
+
     PortLineSplitter::DataReceived(s);
 
+    in_burst = false;
+
+    /* one merge for all lines of this chunk */
+    if (burst_parsed)
+      device_blackboard->ScheduleMerge();
+  }
+
   return true;
 }
 
@@ -1409,8 +1471,30 @@ DeviceDescriptor::LineReceived(const char *line) noexcept
 
   const auto e = BeginEdit();
   e->UpdateClock();
-  ParseNMEA(line, *e);
-  e.Commit();
+
+  const Validity old_vario = e->total_energy_vario_available;
+
+  const auto start = std::chrono::steady_clock::now();
+  const bool parsed = ParseNMEA(line, *e);
+  const auto end = std::chrono::steady_clock::now();
+
+  if (parsed)
+    FeedAudioVario(*e, old_vario);
+
+  {
+    const std::lock_guard lock{statistics_mutex};
+    ++statistics.lines_received;
+    if (!parsed)
+      ++statistics.parse_failures;
+    statistics.AddParseTime(end - start);
+    if (received_time == std::chrono::steady_clock::time_point{})
+      received_time = end;
+  }
+
+  if (in_burst)
+    burst_parsed = true;
+  else
+    e.Commit();
 
   return true;
 }
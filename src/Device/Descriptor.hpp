@@ -9,6 +9,7 @@
 #include "Port/State.hpp"
 #include "Port/Listener.hpp"
 #include "Device/Parser.hpp"
+#include "Statistics.hpp"
 #include "RadioFrequency.hpp"
 #include "TransponderCode.hpp"
 #include "NMEA/ExternalSettings.hpp"
@@ -269,6 +270,49 @@ class DeviceDescriptor final
    */
   bool borrowed = false;
 
+  /**
+   * True while DataReceived() lets the #PortLineSplitter parse the
+   * lines of one received chunk.  LineReceived() then leaves it to
+   * DataReceived() to schedule the merge, so a burst of sentences
+   * wakes up the MergeThread only once.
+   *
+   * These attributes are only accessed from the port's receive
+   * thread.
+   */
+  bool in_burst = false;
+
+  /**
+   * Has a line been parsed since #in_burst was set?
+   */
+  bool burst_parsed;
+
+  /**
+   * Does this device supply the vario value which is played by the
+   * audio vario?  Then each new total energy vario value is passed
+   * to #AudioVarioGlue right after parsing it, without waiting for
+   * the MergeThread.  This flag is updated by the MergeThread.
+   */
+  std::atomic_bool vario_audio_source{false};
+
+  /**
+   * Protects #statistics, #received_time and #merged_time.
+   */
+  mutable Mutex statistics_mutex;
+
+  DeviceStatistics statistics;
+
+  /**
+   * When was the oldest data received which has not yet been merged?
+   * A default-constructed value means there is none.
+   */
+  std::chrono::steady_clock::time_point received_time{};
+
+  /**
+   * The #received_time of the most recent merge which has not yet
+   * been seen by OnCalculatedUpdate().
+   */
+  std::chrono::steady_clock::time_point merged_time{};
+
 public:
   DeviceDescriptor(EventLoop &_event_loop, Cares::Channel &_cares,
                    unsigned index, PortListener *port_listener) noexcept;
@@ -297,6 +341,23 @@ public:
     return error_message;
   }
 
+  /**
+   * Obtain a copy of the throughput and latency counters.
+   */
+  DeviceStatistics GetStatistics() const noexcept {
+    const std::lock_guard lock{statistics_mutex};
+    return statistics;
+  }
+
+  void ResetStatistics() noexcept;
+
+  /**
+   * @see #vario_audio_source
+   */
+  void SetVarioAudioSource(bool value) noexcept {
+    vario_audio_source.store(value, std::memory_order_relaxed);
+  }
+
   /**
    * Was there a failure on the #Port object?
    */
@@ -581,6 +642,19 @@ public:
                           const DerivedInfo &calculated) noexcept;
 
 private:
+  /**
+   * Remember that data was received, for measuring the delay until
+   * it gets merged.
+   */
+  void OnDataReceived(std::chrono::steady_clock::time_point now) noexcept;
+
+  /**
+   * Pass a new total energy vario value to the audio vario if this
+   * is the #vario_audio_source.
+   */
+  void FeedAudioVario(const NMEAInfo &info,
+                      Validity old_availability) noexcept;
+
   void LockSetErrorMessage(const TCHAR *msg) noexcept;
 #ifdef _UNICODE
   void LockSetErrorMessage(const char *msg) noexcept;
@@ -611,6 +685,8 @@ private:
                         bool hasAccuracy, double accuracy) noexcept override;
 
 #ifdef ANDROID
+  void OnSensorBatch(std::span<const SensorSample> samples,
+                     std::chrono::steady_clock::duration clock_offset) noexcept override;
   void OnAccelerationSensor(double acceleration) noexcept override;
   void OnAccelerationSensor(float ddx, float ddy,
                             float ddz) noexcept override;
@@ -6,7 +6,7 @@
 #include "FLARM/Error.hpp"
 #include "FLARM/Version.hpp"
 #include "FLARM/Status.hpp"
-#include "FLARM/List.hpp"
+#include "FLARM/Data.hpp"
 #include "util/Macros.hpp"
 #include "util/StringAPI.hxx"
 
@@ -80,11 +80,47 @@ ReadBearing(NMEAInputLine &line, Angle &value_r)
   return true;
 }
 
-void
-ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept
+/**
+ * Insert or update a target in the given list.
+ */
+template<std::size_t N>
+static void
+StoreTraffic(BasicTrafficList<N> &list, const FlarmTraffic &traffic,
+             TimeStamp clock) noexcept
+{
+  list.modified.Update(clock);
+
+  FlarmTraffic *slot = list.FindTraffic(traffic.id);
+  if (slot == nullptr) {
+    slot = list.AllocateTraffic(traffic.id);
+    if (slot == nullptr)
+      // no more slots available
+      return;
+
+    list.new_traffic.Update(clock);
+  }
+
+  // set time of fix to current time
+  slot->valid.Update(clock);
+
+  slot->Update(traffic);
+}
+
+/**
+ * Is this ADS-B target close enough to matter?
+ */
+[[gnu::pure]]
+static bool
+IsRelevantAdsb(const FlarmTraffic &traffic) noexcept
 {
-  flarm.modified.Update(clock);
+  return hypot(traffic.relative_north,
+               traffic.relative_east) <= ADSB_MAX_DISTANCE &&
+    fabs(double(traffic.relative_altitude)) <= ADSB_MAX_ALTITUDE;
+}
 
+void
+ParsePFLAA(NMEAInputLine &line, FlarmData &flarm, TimeStamp clock) noexcept
+{
   // PFLAA,<AlarmLevel>,<RelativeNorth>,<RelativeEast>,<RelativeVertical>,
   //   <IDType>,<ID>,<Track>,<TurnRate>,<GroundSpeed>,<ClimbRate>,<AcftType>
   FlarmTraffic traffic;
@@ -156,21 +192,24 @@ ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept
   else
     traffic.type = (FlarmTraffic::AircraftType)type;
 
-  FlarmTraffic *flarm_slot = flarm.FindTraffic(traffic.id);
-  if (flarm_slot == nullptr) {
-    flarm_slot = flarm.AllocateTraffic();
-    if (flarm_slot == nullptr)
-      // no more slots available
-      return;
+  line.Skip(); /* no-track flag */
 
-    flarm_slot->Clear();
-    flarm_slot->id = traffic.id;
+  // source (since protocol version 8; absent means FLARM)
+  traffic.source = (FlarmTraffic::Source)line.Read(0);
 
-    flarm.new_traffic.Update(clock);
+  if (traffic.IsAdsb() && !traffic.HasAlarm()) {
+    /* filter irrelevant ADS-B targets before they cost anything in
+       the merge, the computer and the renderer */
+    if (!IsRelevantAdsb(traffic)) {
+      flarm.adsb_traffic.modified.Update(clock);
+      return;
+    }
+
+    /* it may have been an alarm target until now */
+    flarm.traffic.RemoveTraffic(traffic.id);
+    StoreTraffic(flarm.adsb_traffic, traffic, clock);
+  } else {
+    flarm.adsb_traffic.RemoveTraffic(traffic.id);
+    StoreTraffic(flarm.traffic, traffic, clock);
   }
-
-  // set time of fix to current time
-  flarm_slot->valid.Update(clock);
-
-  flarm_slot->Update(traffic);
 }
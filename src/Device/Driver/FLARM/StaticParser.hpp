@@ -13,7 +13,7 @@ class NMEAInputLine;
 struct FlarmError;
 struct FlarmVersion;
 struct FlarmStatus;
-struct TrafficList;
+struct FlarmData;
 
 /**
  * Parses a PFLAE sentence (self-test results).
@@ -49,14 +49,30 @@ ParsePFLAV(NMEAInputLine &line, FlarmVersion &version,
 void
 ParsePFLAU(NMEAInputLine &line, FlarmStatus &flarm, TimeStamp clock) noexcept;
 
+/**
+ * ADS-B targets without an alarm which are further away than this
+ * [m] are dropped by ParsePFLAA().
+ */
+static constexpr double ADSB_MAX_DISTANCE = 20000;
+
+/**
+ * ADS-B targets without an alarm with a larger vertical separation
+ * than this [m] are dropped by ParsePFLAA().
+ */
+static constexpr double ADSB_MAX_ALTITUDE = 2000;
+
 /**
  * Parses a PFLAA sentence
  * (Data on other moving objects around)
  *
+ * FLARM targets and targets with an alarm go to FlarmData::traffic,
+ * all other ADS-B targets to FlarmData::adsb_traffic, unless they
+ * are too far away to be relevant.
+ *
  * @param line The Flarm NMEA record to parse.
- * @param flarm The current Flarm status which will be updated by this NMEA
+ * @param flarm The current Flarm data which will be updated by this NMEA
  *              record.
  * @param clock The time now.
  */
 void
-ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept;
+ParsePFLAA(NMEAInputLine &line, FlarmData &flarm, TimeStamp clock) noexcept;
@@ -3,6 +3,7 @@
 
 #include "Internal.hpp"
 #include "Message.hpp"
+#include "Device/Util/SentenceTable.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
 
@@ -194,6 +195,27 @@ PDTSM(NMEAInputLine &line, [[maybe_unused]] NMEAInfo &info)
   return true;
 }
 
+namespace {
+
+enum class VegaSentence : uint8_t {
+  PDSWC, PDAAV, PDVSC, PDVDV, PDVDS, PDVVT, PDVSD, PDTSM,
+};
+
+constexpr NMEASentence<VegaSentence> vega_sentence_list[] = {
+  {"$PDSWC"sv, VegaSentence::PDSWC},
+  {"$PDAAV"sv, VegaSentence::PDAAV},
+  {"$PDVSC"sv, VegaSentence::PDVSC},
+  {"$PDVDV"sv, VegaSentence::PDVDV},
+  {"$PDVDS"sv, VegaSentence::PDVDS},
+  {"$PDVVT"sv, VegaSentence::PDVVT},
+  {"$PDVSD"sv, VegaSentence::PDVSD},
+  {"$PDTSM"sv, VegaSentence::PDTSM},
+};
+
+constexpr NMEASentenceTable vega_sentences{vega_sentence_list};
+
+} // anonymous namespace
+
 bool
 VegaDevice::ParseNMEA(const char *String, NMEAInfo &info)
 {
@@ -204,26 +226,40 @@ VegaDevice::ParseNMEA(const char *String, NMEAInfo &info)
   if (type.starts_with("$PD"sv))
     detected = true;
 
-  if (type == "$PDSWC"sv)
+  const auto *sentence = vega_sentences.Find(type);
+  if (sentence == nullptr)
+    return false;
+
+  switch (*sentence) {
+  case VegaSentence::PDSWC:
     return PDSWC(line, info, volatile_data);
-  else if (type == "$PDAAV"sv)
+
+  case VegaSentence::PDAAV:
     return PDAAV(line, info);
-  else if (type == "$PDVSC"sv)
+
+  case VegaSentence::PDVSC:
     return PDVSC(line, info);
-  else if (type == "$PDVDV"sv)
+
+  case VegaSentence::PDVDV:
     return PDVDV(line, info);
-  else if (type == "$PDVDS"sv)
+
+  case VegaSentence::PDVDS:
     return PDVDS(line, info);
-  else if (type == "$PDVVT"sv)
+
+  case VegaSentence::PDVVT:
     return PDVVT(line, info);
-  else if (type == "$PDVSD"sv) {
+
+  case VegaSentence::PDVSD: {
     const auto message = line.Rest();
     StaticString<256> buffer;
     buffer.SetASCII(message);
     Message::AddMessage(buffer);
     return true;
-  } else if (type == "$PDTSM"sv)
+  }
+
+  case VegaSentence::PDTSM:
     return PDTSM(line, info);
-  else
-    return false;
+  }
+
+  return false;
 }
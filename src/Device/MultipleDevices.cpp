@@ -133,6 +133,13 @@ MultipleDevices::NotifySensorUpdate(const MoreData &basic) noexcept
     i->OnSensorUpdate(basic);
 }
 
+void
+MultipleDevices::SetVarioAudioSource(int index) noexcept
+{
+  for (DeviceDescriptor *i : devices)
+    i->SetVarioAudioSource((int)i->GetIndex() == index);
+}
+
 void
 MultipleDevices::NotifyCalculatedUpdate(const MoreData &basic,
                                         const DerivedInfo &calculated) noexcept
@@ -76,6 +76,14 @@ public:
   void PutTransponderCode(TransponderCode code, OperationEnvironment &env) noexcept;
   void PutQNH(AtmosphericPressure pres, OperationEnvironment &env) noexcept;
   void NotifySensorUpdate(const MoreData &basic) noexcept;
+
+  /**
+   * Let the specified device feed its total energy vario values
+   * directly to the audio vario.
+   *
+   * @param index the device index or -1 for none
+   */
+  void SetVarioAudioSource(int index) noexcept;
   void NotifyCalculatedUpdate(const MoreData &basic,
                               const DerivedInfo &calculated) noexcept;
 
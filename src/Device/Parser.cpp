@@ -8,6 +8,7 @@
 #include "NMEA/InputLine.hpp"
 #include "Units/System.hpp"
 #include "Driver/FLARM/StaticParser.hpp"
+#include "Util/SentenceTable.hpp"
 #include "util/CharUtil.hxx"
 #include "util/NumberParser.hxx"
 #include "util/StringSplit.hxx"
@@ -27,6 +28,43 @@ NMEAParser::Reset()
   last_time = {};
 }
 
+namespace {
+
+enum class Sentence : uint8_t {
+  GSA, GLL, RMC, GGA, HDM, MWV,
+  PTAS1, PFLAE, PFLAV, PFLAA, PFLAU, PGRMZ,
+};
+
+/**
+ * Standard sentences, without the "$" and the talker id.
+ */
+constexpr NMEASentence<Sentence> standard_sentence_list[] = {
+  {"GSA"sv, Sentence::GSA},
+  {"GLL"sv, Sentence::GLL},
+  {"RMC"sv, Sentence::RMC},
+  {"GGA"sv, Sentence::GGA},
+  {"HDM"sv, Sentence::HDM},
+  {"MWV"sv, Sentence::MWV},
+};
+
+constexpr NMEASentenceTable standard_sentences{standard_sentence_list};
+
+/**
+ * Proprietary sentences, without the "$".
+ */
+constexpr NMEASentence<Sentence> proprietary_sentence_list[] = {
+  {"PTAS1"sv, Sentence::PTAS1},
+  {"PFLAE"sv, Sentence::PFLAE},
+  {"PFLAV"sv, Sentence::PFLAV},
+  {"PFLAA"sv, Sentence::PFLAA},
+  {"PFLAU"sv, Sentence::PFLAU},
+  {"PGRMZ"sv, Sentence::PGRMZ},
+};
+
+constexpr NMEASentenceTable proprietary_sentences{proprietary_sentence_list};
+
+} // anonymous namespace
+
 bool
 NMEAParser::ParseLine(const char *string, NMEAInfo &info)
 {
@@ -45,61 +83,67 @@ NMEAParser::ParseLine(const char *string, NMEAInfo &info)
     return false;
 
   if (IsAlphaASCII(type[1]) && IsAlphaASCII(type[2])) {
-    const auto type2 = type.substr(3);
+    if (const auto *sentence = standard_sentences.Find(type.substr(3))) {
+      switch (*sentence) {
+      case Sentence::GSA:
+        return GSA(line, info);
 
-    if (type2 == "GSA"sv)
-      return GSA(line, info);
+      case Sentence::GLL:
+        return GLL(line, info);
 
-    if (type2 == "GLL"sv)
-      return GLL(line, info);
+      case Sentence::RMC:
+        return RMC(line, info);
 
-    if (type2 == "RMC"sv)
-      return RMC(line, info);
+      case Sentence::GGA:
+        return GGA(line, info);
 
-    if (type2 == "GGA"sv)
-      return GGA(line, info);
+      case Sentence::HDM:
+        return HDM(line, info);
 
-    if (type2 == "HDM"sv)
-      return HDM(line, info);
+      case Sentence::MWV:
+        return MWV(line, info);
 
-    if (type2 == "MWV"sv)
-      return MWV(line, info);
+      default:
+        break;
+      }
+    }
   }
 
   // if (proprietary sentence) ...
   if (type[1] == 'P') {
-    const auto type2 = type.substr(1);
+    const auto *sentence = proprietary_sentences.Find(type.substr(1));
+    if (sentence == nullptr)
+      return false;
 
+    switch (*sentence) {
     // Airspeed and vario sentence
-    if (type2 == "PTAS1"sv)
+    case Sentence::PTAS1:
       return PTAS1(line, info);
 
     // FLARM sentences
-    if (type2 == "PFLAE"sv) {
+    case Sentence::PFLAE:
       ParsePFLAE(line, info.flarm.error, info.clock);
       return true;
-    }
 
-    if (type2 == "PFLAV"sv) {
+    case Sentence::PFLAV:
       ParsePFLAV(line, info.flarm.version, info.clock);
       return true;
-    }
 
-    if (type2 == "PFLAA"sv) {
-      ParsePFLAA(line, info.flarm.traffic, info.clock);
+    case Sentence::PFLAA:
+      ParsePFLAA(line, info.flarm, info.clock);
       return true;
-    }
 
-    if (type2 == "PFLAU"sv) {
+    case Sentence::PFLAU:
       ParsePFLAU(line, info.flarm.status, info.clock);
       return true;
-    }
 
     // Garmin altitude sentence
-    if (type2 == "PGRMZ"sv)
+    case Sentence::PGRMZ:
       return RMZ(line, info);
 
-    return false;
+    default:
+      return false;
+    }
   }
 
   return false;
@@ -5,15 +5,13 @@
 #include "Device/Error.hpp"
 #include "time/TimeoutClock.hpp"
 #include "Operation/Cancelled.hpp"
-
-#include <algorithm>
+#include "util/ScopeExit.hxx"
 
 #include <cassert>
 
 void
 BufferedPort::Flush()
 {
-  const std::lock_guard lock{mutex};
   buffer.Clear();
 }
 
@@ -21,7 +19,7 @@ bool
 BufferedPort::StopRxThread()
 {
   const std::lock_guard lock{mutex};
-  running = false;
+  running.store(false, std::memory_order_release);
 
   cond.notify_all();
   return true;
@@ -31,9 +29,12 @@ bool
 BufferedPort::StartRxThread()
 {
   const std::lock_guard lock{mutex};
-  if (!running) {
-    running = true;
+  if (!running.load(std::memory_order_relaxed)) {
+    /* discard stale data before handing the stream to the handler;
+       once #running is published, the producer stops writing to the
+       buffer, so this must happen first */
     buffer.Clear();
+    running.store(true, std::memory_order_release);
   }
 
   cond.notify_all();
@@ -43,26 +44,28 @@ BufferedPort::StartRxThread()
 std::size_t
 BufferedPort::Read(std::span<std::byte> dest)
 {
-  assert(!running);
-
-  const std::lock_guard lock{mutex};
+  assert(!running.load(std::memory_order_relaxed));
 
-  auto r = buffer.Read();
-  if (r.size() > dest.size())
-    r = r.first(dest.size());
-  std::copy(r.begin(), r.end(), dest.data());
-  buffer.Consume(r.size());
-  return r.size();
+  return buffer.Read(dest);
 }
 
 void
 BufferedPort::WaitRead(std::chrono::steady_clock::duration _timeout)
 {
+  if (!buffer.IsEmpty())
+    return;
+
   TimeoutClock timeout(_timeout);
   std::unique_lock lock{mutex};
 
-  while (buffer.empty()) {
-    if (running)
+  /* announce the blocked reader before checking the buffer again;
+     DataReceived() publishes new data before checking this flag, so
+     at least one of the two sees the other */
+  waiting = true;
+  AtScopeExit(this) { waiting = false; };
+
+  while (buffer.IsEmpty()) {
+    if (running.load(std::memory_order_acquire))
       throw OperationCancelled{};
 
     auto remaining = timeout.GetRemainingSigned();
@@ -76,24 +79,17 @@ BufferedPort::WaitRead(std::chrono::steady_clock::duration _timeout)
 bool
 BufferedPort::DataReceived(std::span<const std::byte> s) noexcept
 {
-  if (running) {
+  if (running.load(std::memory_order_acquire)) {
     return handler.DataReceived(s);
   } else {
-    const std::lock_guard lock{mutex};
-
-    buffer.Shift();
-    auto r = buffer.Write();
-    if (r.empty())
-      /* the buffer is already full, discard excess data */
-      return true;
-
-    /* discard excess data */
-    const std::size_t nbytes = std::min(s.size(), r.size());
+    /* discards excess data if the buffer is full */
+    buffer.Write(s);
 
-    std::copy_n(s.begin(), nbytes, r.begin());
-    buffer.Append(nbytes);
+    if (waiting) {
+      const std::lock_guard lock{mutex};
+      cond.notify_all();
+    }
 
-    cond.notify_all();
     return true;
   }
 }
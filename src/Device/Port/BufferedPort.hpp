@@ -7,8 +7,9 @@
 #include "io/DataHandler.hpp"
 #include "thread/Mutex.hxx"
 #include "thread/Cond.hxx"
-#include "util/StaticFifoBuffer.hxx"
+#include "util/LockFreeFifoBuffer.hpp"
 
+#include <atomic>
 #include <cstdint>
 
 /**
@@ -16,22 +17,38 @@
  * FIFO buffer.  This buffer can be fed from another thread.  Derive
  * from this class and call DataReceived() (or use the DataHandler
  * base class) whenever you get some data from the device.
+ *
+ * The buffer is a lock-free ring between the receive thread
+ * (producer) and the thread calling Read() (consumer); the mutex is
+ * only used to wake up a consumer blocked in WaitRead().
  */
 class BufferedPort : public Port, protected DataHandler {
   /**
-   * Protects the buffer and the flags.
+   * Protects #cond.
    */
   Mutex mutex;
 
   /**
    * Emitted by DataReceived() after data has been placed into the
-   * buffer.
+   * buffer, if #waiting is set, and by StartRxThread() and
+   * StopRxThread().
    */
   Cond cond;
 
-  StaticFifoBuffer<std::byte, 16384> buffer;
+  LockFreeFifoBuffer<std::byte, 16384> buffer;
 
-  bool running = false;
+  /**
+   * Is the receive thread delivering to the #DataHandler instead of
+   * the buffer?  Only modified while #mutex is held, but read
+   * lock-free by DataReceived().
+   */
+  std::atomic_bool running{false};
+
+  /**
+   * Is a thread blocked in WaitRead()?  Only then does
+   * DataReceived() need to lock the mutex and signal #cond.
+   */
+  std::atomic_bool waiting{false};
 
 public:
   using Port::Port;
@@ -5,6 +5,9 @@
 #include "net/IPv4Address.hxx"
 #include "net/SocketError.hxx"
 #include "event/Call.hxx"
+#include "event/Loop.hxx"
+
+#include <cerrno>
 
 SocketPort::SocketPort(EventLoop &event_loop,
                        PortListener *_listener, DataHandler &_handler) noexcept
@@ -22,7 +25,7 @@ SocketPort::OpenIndirect(SocketDescriptor s) noexcept
   socket.Open(s);
 
   BlockingCall(GetEventLoop(), [this](){
-    socket.ScheduleRead();
+    ScheduleRead();
   });
 }
 
@@ -33,16 +36,29 @@ SocketPort::Open(SocketDescriptor s) noexcept
   assert(!socket.IsDefined());
 
   socket.Open(s);
-  socket.ScheduleRead();
+  ScheduleRead();
 }
 
 SocketPort::~SocketPort() noexcept
 {
   BlockingCall(GetEventLoop(), [this](){
-    socket.Close();
+    Close();
   });
 }
 
+void
+SocketPort::Close() noexcept
+{
+#ifdef HAVE_URING
+  if (uring_read != nullptr) {
+    uring_read->Cancel();
+    uring_read = nullptr;
+  }
+#endif
+
+  socket.Close();
+}
+
 PortState
 SocketPort::GetState() const noexcept
 {
@@ -66,6 +82,39 @@ SocketPort::Write(std::span<const std::byte> src)
   return nbytes;
 }
 
+void
+SocketPort::ScheduleRead() noexcept
+{
+#ifdef HAVE_URING
+  if (auto *queue = GetEventLoop().GetUring()) {
+    uring_read = Uring::ReadStream::Start(*queue,
+                                          socket.GetSocket().ToFileDescriptor(),
+                                          *this);
+    if (uring_read != nullptr)
+      return;
+  }
+#endif
+
+  socket.ScheduleRead();
+}
+
+void
+SocketPort::OnReadEnd()
+{
+  Close();
+  OnConnectionClosed();
+  StateChanged();
+}
+
+void
+SocketPort::OnReadError(std::exception_ptr e) noexcept
+{
+  Close();
+  OnConnectionError();
+  StateChanged();
+  Error(std::move(e));
+}
+
 inline void
 SocketPort::OnSocketReady(unsigned) noexcept
 try {
@@ -75,16 +124,43 @@ try {
     throw MakeSocketError("Failed to receive");
 
   if (nbytes == 0) {
-    socket.Close();
-    OnConnectionClosed();
-    StateChanged();
+    OnReadEnd();
     return;
   }
 
   DataReceived({input, std::size_t(nbytes)});
 } catch (...) {
-  socket.Close();
-  OnConnectionError();
-  StateChanged();
-  Error(std::current_exception());
+  OnReadError(std::current_exception());
+}
+
+#ifdef HAVE_URING
+
+void
+SocketPort::OnUringRead(std::span<const std::byte> src) noexcept
+{
+  DataReceived(src);
+}
+
+void
+SocketPort::OnUringReadEnd() noexcept
+try {
+  uring_read = nullptr;
+  OnReadEnd();
+} catch (...) {
+  OnReadError(std::current_exception());
+}
+
+void
+SocketPort::OnUringReadError(int error) noexcept
+{
+  uring_read = nullptr;
+
+  /* the EventLoop is shutting down */
+  if (error == ECANCELED)
+    return;
+
+  OnReadError(std::make_exception_ptr(MakeSocketError(error,
+                                                      "Failed to receive")));
 }
+
+#endif
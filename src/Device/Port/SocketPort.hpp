@@ -5,14 +5,32 @@
 
 #include "BufferedPort.hpp"
 #include "event/SocketEvent.hxx"
+#include "io/uring/Features.h"
+
+#ifdef HAVE_URING
+#include "io/uring/ReadStream.hxx"
+#endif
+
+#include <exception>
 
 /**
  * A base class for socket-based ports.
  */
 class SocketPort : public BufferedPort
+#ifdef HAVE_URING
+  , Uring::ReadStreamHandler
+#endif
 {
   SocketEvent socket;
 
+#ifdef HAVE_URING
+  /**
+   * Reads from the socket instead of #socket if io_uring is
+   * available.
+   */
+  Uring::ReadStream *uring_read = nullptr;
+#endif
+
 public:
   SocketPort(EventLoop &event_loop,
              PortListener *_listener, DataHandler &_handler) noexcept;
@@ -44,9 +62,7 @@ protected:
   void Open(SocketDescriptor s) noexcept;
   void OpenIndirect(SocketDescriptor s) noexcept;
 
-  void Close() noexcept {
-    socket.Close();
-  }
+  void Close() noexcept;
 
   bool IsConnected() const noexcept {
     return socket.IsDefined();
@@ -68,5 +84,25 @@ protected:
   virtual void OnConnectionError() noexcept {}
 
 private:
+  /**
+   * Start reading from the socket.  Must be called in the
+   * #EventLoop thread.
+   */
+  void ScheduleRead() noexcept;
+
+  /**
+   * The peer has closed the connection.  Throws on error.
+   */
+  void OnReadEnd();
+
+  void OnReadError(std::exception_ptr e) noexcept;
+
   void OnSocketReady(unsigned events) noexcept;
+
+#ifdef HAVE_URING
+  /* virtual methods from class Uring::ReadStreamHandler */
+  void OnUringRead(std::span<const std::byte> src) noexcept override;
+  void OnUringReadEnd() noexcept override;
+  void OnUringReadError(int error) noexcept override;
+#endif
 };
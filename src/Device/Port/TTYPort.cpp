@@ -9,6 +9,7 @@
 #include "system/TTYDescriptor.hxx"
 #include "system/FileUtil.hpp"
 #include "event/Call.hxx"
+#include "event/Loop.hxx"
 #include "util/StringFormat.hpp"
 
 #include <system_error>
@@ -143,7 +144,7 @@ TTYPort::TTYPort(EventLoop &event_loop,
 TTYPort::~TTYPort() noexcept
 {
   BlockingCall(GetEventLoop(), [this](){
-    socket.Close();
+    Close();
   });
 }
 
@@ -171,7 +172,7 @@ TTYPort::Open(const TCHAR *path, unsigned baud_rate)
   socket.Open(fd.Release());
 
   BlockingCall(GetEventLoop(), [this](){
-    socket.ScheduleRead();
+    ScheduleRead();
   });
 
   valid.store(true, std::memory_order_relaxed);
@@ -197,7 +198,7 @@ TTYPort::OpenPseudo()
   valid.store(true, std::memory_order_relaxed);
 
   BlockingCall(GetEventLoop(), [this](){
-    socket.ScheduleRead();
+    ScheduleRead();
   });
 
   StateChanged();
@@ -281,6 +282,51 @@ TTYPort::SetBaudrate(unsigned baud_rate)
   ::SetBaudrate(tty, baud_rate);
 }
 
+void
+TTYPort::ScheduleRead() noexcept
+{
+#ifdef HAVE_URING
+  if (auto *queue = GetEventLoop().GetUring()) {
+    uring_read = Uring::ReadStream::Start(*queue, socket.GetFileDescriptor(),
+                                          *this);
+    if (uring_read != nullptr)
+      return;
+  }
+#endif
+
+  socket.ScheduleRead();
+}
+
+void
+TTYPort::Close() noexcept
+{
+#ifdef HAVE_URING
+  if (uring_read != nullptr) {
+    uring_read->Cancel();
+    uring_read = nullptr;
+  }
+#endif
+
+  socket.Close();
+}
+
+void
+TTYPort::OnReadError(int e) noexcept
+{
+  socket.Cancel();
+  valid.store(false, std::memory_order_relaxed);
+  StateChanged();
+  Error(strerror(e));
+}
+
+void
+TTYPort::OnReadEnd() noexcept
+{
+  socket.Close();
+  valid.store(false, std::memory_order_relaxed);
+  StateChanged();
+}
+
 void
 TTYPort::OnSocketReady(unsigned) noexcept
 {
@@ -289,20 +335,43 @@ TTYPort::OnSocketReady(unsigned) noexcept
   std::byte input[4096];
   ssize_t nbytes = tty.Read(input, sizeof(input));
   if (nbytes < 0) {
-    int e = errno;
-    socket.Cancel();
-    valid.store(false, std::memory_order_relaxed);
-    StateChanged();
-    Error(strerror(e));
+    OnReadError(errno);
     return;
   }
 
   if (nbytes == 0) {
-    socket.Close();
-    valid.store(false, std::memory_order_relaxed);
-    StateChanged();
+    OnReadEnd();
     return;
   }
 
   DataReceived({input, std::size_t(nbytes)});
 }
+
+#ifdef HAVE_URING
+
+void
+TTYPort::OnUringRead(std::span<const std::byte> src) noexcept
+{
+  DataReceived(src);
+}
+
+void
+TTYPort::OnUringReadEnd() noexcept
+{
+  uring_read = nullptr;
+  OnReadEnd();
+}
+
+void
+TTYPort::OnUringReadError(int error) noexcept
+{
+  uring_read = nullptr;
+
+  /* the EventLoop is shutting down */
+  if (error == ECANCELED)
+    return;
+
+  OnReadError(error);
+}
+
+#endif
@@ -5,6 +5,11 @@
 
 #include "BufferedPort.hpp"
 #include "event/PipeEvent.hxx"
+#include "io/uring/Features.h"
+
+#ifdef HAVE_URING
+#include "io/uring/ReadStream.hxx"
+#endif
 
 #include <atomic>
 #include <tchar.h>
@@ -13,9 +18,20 @@
  * A serial port class for POSIX (/dev/ttyS*, /dev/ttyUSB*).
  */
 class TTYPort : public BufferedPort
+#ifdef HAVE_URING
+  , Uring::ReadStreamHandler
+#endif
 {
   PipeEvent socket;
 
+#ifdef HAVE_URING
+  /**
+   * Reads from the device instead of #socket if io_uring is
+   * available.
+   */
+  Uring::ReadStream *uring_read = nullptr;
+#endif
+
   std::atomic<bool> valid;
 
 public:
@@ -59,5 +75,27 @@ public:
 private:
   void WaitWrite(unsigned timeout_ms);
 
+  /**
+   * Start reading from the device.  Must be called in the
+   * #EventLoop thread.
+   */
+  void ScheduleRead() noexcept;
+
+  /**
+   * Stop reading and close the device.  Must be called in the
+   * #EventLoop thread.
+   */
+  void Close() noexcept;
+
+  void OnReadError(int error) noexcept;
+  void OnReadEnd() noexcept;
+
   void OnSocketReady(unsigned events) noexcept;
+
+#ifdef HAVE_URING
+  /* virtual methods from class Uring::ReadStreamHandler */
+  void OnUringRead(std::span<const std::byte> src) noexcept override;
+  void OnUringReadEnd() noexcept override;
+  void OnUringReadError(int error) noexcept override;
+#endif
 };
@@ -4,6 +4,10 @@
 #pragma once
 
 #include <chrono>
+#ifdef ANDROID
+#include <cstdint>
+#include <span>
+#endif
 
 struct GeoPoint;
 class AtmosphericPressure;
@@ -31,6 +35,60 @@ public:
                                 bool hasAccuracy, double accuracy) noexcept = 0;
 
 #ifdef ANDROID
+  /**
+   * One sample from an internal sensor, as collected by
+   * NonGPSSensors.java.  The layout must match the records written
+   * there.
+   */
+  struct SensorSample {
+    enum class Type : int32_t {
+      /**
+       * values[0..2]: acceleration [m/s^2] along the device axes;
+       * values[3]: load factor [g]
+       */
+      ACCELERATION = 1,
+
+      /**
+       * values[0..2]: rotation rate [rad/s]
+       */
+      ROTATION = 2,
+
+      /**
+       * values[0..2]: magnetic field [uT]
+       */
+      MAGNETIC_FIELD = 3,
+
+      /**
+       * values[0]: static pressure [hPa]; values[1]: sensor noise
+       * variance
+       */
+      PRESSURE = 4,
+    };
+
+    /**
+     * The time of the measurement (SensorEvent.timestamp) [ns].
+     */
+    int64_t timestamp;
+
+    Type type;
+
+    float values[4];
+
+    int32_t reserved;
+  };
+
+  static_assert(sizeof(SensorSample) == 32);
+
+  /**
+   * A batch of samples from the internal sensors, to be applied at
+   * once.
+   *
+   * @param clock_offset add this to SensorSample::timestamp to obtain
+   * a std::chrono::steady_clock time point
+   */
+  virtual void OnSensorBatch(std::span<const SensorSample> samples,
+                             std::chrono::steady_clock::duration clock_offset) noexcept = 0;
+
   virtual void OnAccelerationSensor(double acceleration) noexcept = 0;
   virtual void OnAccelerationSensor(float ddx, float ddy,
                                     float ddz) noexcept = 0;
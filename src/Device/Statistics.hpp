@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "time/FloatDuration.hxx"
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * The most recent and the largest value of a delay.
+ */
+struct DelayStatistics {
+  FloatDuration last{}, max{};
+
+  /**
+   * The number of samples.
+   */
+  unsigned n = 0;
+
+  void Add(FloatDuration value) noexcept {
+    last = value;
+    max = std::max(max, value);
+    ++n;
+  }
+};
+
+/**
+ * Throughput and latency counters of one #DeviceDescriptor.  They
+ * help finding out where the time between receiving a sentence and
+ * showing its result is spent.
+ */
+struct DeviceStatistics {
+  /**
+   * The number of bytes received from the port.
+   */
+  uint_least64_t bytes_received = 0;
+
+  /**
+   * The number of lines passed to the NMEA parser.
+   */
+  uint_least64_t lines_received = 0;
+
+  /**
+   * The number of lines which neither the driver nor the generic
+   * NMEA parser understood.
+   */
+  uint_least64_t parse_failures = 0;
+
+  /**
+   * The time spent parsing lines.
+   */
+  FloatDuration parse_time{};
+
+  /**
+   * The longest time spent parsing one line.
+   */
+  FloatDuration parse_time_max{};
+
+  /**
+   * The time between receiving data and merging it in the
+   * MergeThread.
+   */
+  DelayStatistics merge_delay;
+
+  /**
+   * The time between receiving data and the CalculationThread
+   * finishing the calculation which included it.
+   */
+  DelayStatistics calculated_delay;
+
+  void AddParseTime(FloatDuration value) noexcept {
+    parse_time += value;
+    parse_time_max = std::max(parse_time_max, value);
+  }
+
+  /**
+   * The average time spent parsing one line.
+   */
+  [[gnu::pure]]
+  FloatDuration GetAverageParseTime() const noexcept {
+    return lines_received > 0
+      ? parse_time / double(lines_received)
+      : FloatDuration{};
+  }
+};
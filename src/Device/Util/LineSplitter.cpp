@@ -2,7 +2,6 @@
 // Copyright The XCSoar Project
 
 #include "LineSplitter.hpp"
-#include "util/TextFile.hxx"
 #include "util/StringStrip.hxx"
 
 #include <algorithm>
@@ -16,13 +15,27 @@ IsInsaneChar(char ch)
   return (unsigned char)ch < 0x20;
 }
 
-/**
- * Replace all control characters with a regular space character.
- */
-static void
-SanitiseLine(char *const begin, char *const end)
+bool
+PortLineSplitter::HandleLine(const char *begin, const char *end) noexcept
 {
-  std::replace_if(begin, end, IsInsaneChar, ' ');
+  /* binary garbage: a NUL byte terminates the C string, the rest of
+     the line is ignored */
+  if (const void *nul = memchr(begin, 0, end - begin))
+    end = (const char *)nul;
+
+  /* remove trailing whitespace, such as '\r' */
+  end = StripRight(begin, end);
+
+  if (std::size_t(end - begin) >= MAX_LENGTH)
+    /* too long: discard */
+    return true;
+
+  /* copy the line and replace all control characters with a regular
+     space character */
+  char line[MAX_LENGTH];
+  *std::replace_copy_if(begin, end, line, IsInsaneChar, ' ') = 0;
+
+  return LineReceived(line);
 }
 
 bool
@@ -30,48 +43,57 @@ PortLineSplitter::DataReceived(std::span<const std::byte> s) noexcept
 {
   assert(!s.empty());
 
-  const char *data = (const char *)s.data(), *end = data + s.size();
+  const char *data = (const char *)s.data(), *const end = data + s.size();
+
+  if (!buffer.empty()) {
+    /* complete the line which was split across reads */
+    const char *newline = (const char *)memchr(data, '\n', end - data);
+    const char *const chunk_end = newline != nullptr ? newline : end;
+    const std::size_t nbytes = chunk_end - data;
 
-  do {
-    /* append new data to buffer, as much as fits there */
-    auto range = buffer.Write();
-    if (range.empty()) {
-      /* overflow: reset buffer to recover quickly */
+    const auto w = buffer.Write();
+    if (nbytes >= w.size()) {
+      /* overflow: discard the line to recover quickly */
       buffer.Clear();
-      continue;
+    } else {
+      memcpy(w.data(), data, nbytes);
+      buffer.Append(nbytes);
+
+      if (newline != nullptr) {
+        const auto r = buffer.Read();
+        const bool result = HandleLine(r.data(), r.data() + r.size());
+        buffer.Clear();
+        if (!result)
+          return false;
+      }
     }
 
-    size_t nbytes = std::min(range.size(), size_t(end - data));
-    memcpy(range.data(), data, nbytes);
-    data += nbytes;
-    buffer.Append(nbytes);
-
-    while (true) {
-      /* read data from the buffer, to see if there's a newline
-         character */
-      char *line = ReadBufferedLine(buffer);
-      if (line == nullptr)
-        /* no newline here: wait for more data */
-        break;
-
-      char *end = line + strlen(line);
-
-      /* remove trailing whitespace, such as '\r' */
-      end = StripRight(line, end);
-
-      SanitiseLine(line, end);
+    if (newline == nullptr)
+      return true;
+
+    data = newline + 1;
+  }
+
+  while (data < end) {
+    const char *newline = (const char *)memchr(data, '\n', end - data);
+    if (newline == nullptr) {
+      /* no newline here: keep the beginning of the line and wait for
+         more data */
+      const std::size_t nbytes = end - data;
+      const auto w = buffer.Write();
+      if (nbytes < w.size()) {
+        memcpy(w.data(), data, nbytes);
+        buffer.Append(nbytes);
+      }
+
+      break;
+    }
 
-      /* if there are NUL bytes in the line, skip to after the last
-         one, to avoid conflicts with NUL terminated C strings due to
-         binary garbage */
-      void *nul;
-      while ((nul = memchr(line, 0, end - line)) != nullptr)
-        line = (char *)nul + 1;
+    if (!HandleLine(data, newline))
+      return false;
 
-      if (!LineReceived(line))
-        return false;
-    }
-  } while (data < end);
+    data = newline + 1;
+  }
 
   return true;
 }
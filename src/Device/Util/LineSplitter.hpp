@@ -7,11 +7,31 @@
 #include "LineHandler.hpp"
 #include "util/StaticFifoBuffer.hxx"
 
+#include <cstddef>
+
+/**
+ * Splits the received data into lines and passes them to
+ * PortLineHandler::LineReceived().  Lines which are complete in the
+ * received data are sanitised while being copied to a stack buffer;
+ * only the incomplete line at the end of the data is kept in
+ * #buffer until the next call.
+ */
 class PortLineSplitter : public DataHandler, protected PortLineHandler {
-  typedef StaticFifoBuffer<char, 256u> Buffer;
+  static constexpr std::size_t MAX_LENGTH = 256;
+
+  using Buffer = StaticFifoBuffer<char, MAX_LENGTH>;
 
+  /**
+   * The beginning of a line which was split across reads.
+   */
   Buffer buffer;
 
+  /**
+   * Sanitise the given line and pass it to LineReceived().  Lines
+   * which are too long are discarded.
+   */
+  bool HandleLine(const char *begin, const char *end) noexcept;
+
 public:
   /* virtual methods from class DataHandler */
   bool DataReceived(std::span<const std::byte> s) noexcept override;
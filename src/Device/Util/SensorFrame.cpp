@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "SensorFrame.hpp"
+#include "NMEA/Info.hpp"
+#include "Atmosphere/Pressure.hpp"
+#include "Math/Util.hpp"
+#include "util/CRC.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace SensorFrame {
+
+uint16_t
+CalculateCRC(Type type, std::span<const std::byte> payload) noexcept
+{
+  uint16_t crc = 0xffff;
+  crc = UpdateCRC16CCITT(uint8_t(type), crc);
+  crc = UpdateCRC16CCITT(uint8_t(payload.size()), crc);
+  return UpdateCRC16CCITT(payload.data(), payload.size(), crc);
+}
+
+std::size_t
+Write(std::span<std::byte> dest, Type type,
+      std::span<const std::byte> payload) noexcept
+{
+  assert(payload.size() <= MAX_PAYLOAD);
+
+  const std::size_t size = OVERHEAD + payload.size();
+  if (dest.size() < size)
+    return 0;
+
+  const uint16_t crc = CalculateCRC(type, payload);
+
+  dest[0] = SYNC;
+  dest[1] = std::byte(type);
+  dest[2] = std::byte(payload.size());
+  std::copy(payload.begin(), payload.end(), dest.begin() + 3);
+  dest[3 + payload.size()] = std::byte(crc);
+  dest[4 + payload.size()] = std::byte(crc >> 8);
+  return size;
+}
+
+/**
+ * Copy the payload to a record structure.
+ *
+ * @return false if the payload size does not match
+ */
+template<typename T>
+static bool
+ReadRecord(std::span<const std::byte> payload, T &record) noexcept
+{
+  if (payload.size() != sizeof(record))
+    return false;
+
+  std::memcpy(&record, payload.data(), sizeof(record));
+  return true;
+}
+
+[[gnu::const]]
+static Angle
+ToAngle(uint16_t value) noexcept
+{
+  return Angle::Degrees(int16_t(value) / 100.);
+}
+
+static bool
+Apply(Type type, std::span<const std::byte> payload, NMEAInfo &info) noexcept
+{
+  switch (type) {
+  case Type::ATTITUDE:
+    if (Attitude record; ReadRecord(payload, record)) {
+      info.attitude.bank_angle = ToAngle(record.bank);
+      info.attitude.bank_angle_available.Update(info.clock);
+      info.attitude.pitch_angle = ToAngle(record.pitch);
+      info.attitude.pitch_angle_available.Update(info.clock);
+
+      if (record.heading != 0xffff) {
+        info.attitude.heading = Angle::Degrees(record.heading / 100.);
+        info.attitude.heading_available.Update(info.clock);
+      }
+
+      return true;
+    }
+
+    break;
+
+  case Type::ACCELERATION:
+    if (Acceleration record; ReadRecord(payload, record)) {
+      info.acceleration.ProvideGLoad(SpaceDiagonal(int16_t(record.x),
+                                                   int16_t(record.y),
+                                                   int16_t(record.z)) / 1000.);
+      return true;
+    }
+
+    break;
+
+  case Type::STATIC_PRESSURE:
+    if (StaticPressure record; ReadRecord(payload, record)) {
+      info.ProvideStaticPressure(AtmosphericPressure::Pascal(record.pressure / 100.));
+      return true;
+    }
+
+    break;
+
+  case Type::TOTAL_ENERGY_VARIO:
+    if (TotalEnergyVario record; ReadRecord(payload, record)) {
+      info.ProvideTotalEnergyVario(int16_t(record.vario) / 100.);
+      return true;
+    }
+
+    break;
+  }
+
+  /* unknown record types are ignored, so senders may add new ones */
+  return false;
+}
+
+} // namespace SensorFrame
+
+using namespace SensorFrame;
+
+bool
+SensorFrameReader::ParseBuffer(NMEAInfo &info) noexcept
+{
+  bool result = false;
+
+  while (true) {
+    auto r = buffer.Read();
+
+    /* skip garbage until the next sync byte */
+    const auto sync = std::find(r.begin(), r.end(), SYNC);
+    buffer.Consume(std::distance(r.begin(), sync));
+    r = buffer.Read();
+
+    if (r.size() < 3)
+      break;
+
+    const std::size_t length = std::size_t(r[2]);
+    if (length > MAX_PAYLOAD) {
+      /* can't be a frame: resynchronise */
+      buffer.Consume(1);
+      continue;
+    }
+
+    if (r.size() < OVERHEAD + length)
+      /* incomplete */
+      break;
+
+    const Type type = Type(r[1]);
+    const auto payload = r.subspan(3, length);
+    const uint16_t crc = uint16_t(r[3 + length]) |
+      (uint16_t(r[4 + length]) << 8);
+
+    if (crc != CalculateCRC(type, payload)) {
+      ++crc_errors;
+      buffer.Consume(1);
+      continue;
+    }
+
+    if (Apply(type, payload, info))
+      result = true;
+
+    buffer.Consume(OVERHEAD + length);
+  }
+
+  return result;
+}
+
+bool
+SensorFrameReader::Feed(std::span<const std::byte> src,
+                        NMEAInfo &info) noexcept
+{
+  bool result = false;
+
+  while (!src.empty()) {
+    /* ParseBuffer() leaves less than one frame in the buffer, so
+       there is always room for more */
+    const std::size_t n = buffer.MoveFrom(src);
+    assert(n > 0);
+    src = src.subspan(n);
+
+    if (ParseBuffer(info))
+      result = true;
+  }
+
+  return result;
+}
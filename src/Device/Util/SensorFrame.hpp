@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "util/ByteOrder.hxx"
+#include "util/StaticFifoBuffer.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+struct NMEAInfo;
+
+/**
+ * A framed binary protocol for high-rate sensor data (attitude,
+ * acceleration, pressure), which avoids formatting and parsing
+ * numbers as text.
+ *
+ * Each frame looks like this:
+ *
+ * - #SensorFrame::SYNC
+ * - the record type (#SensorFrame::Type)
+ * - the payload length
+ * - the payload: a fixed-layout, little-endian record
+ * - the CRC16-CCITT (little-endian) of type, length and payload
+ */
+namespace SensorFrame {
+
+static constexpr std::byte SYNC{0xb5};
+
+/**
+ * The largest payload accepted by #SensorFrameReader.
+ */
+static constexpr std::size_t MAX_PAYLOAD = 32;
+
+enum class Type : uint8_t {
+  ATTITUDE = 1,
+  ACCELERATION = 2,
+  STATIC_PRESSURE = 3,
+  TOTAL_ENERGY_VARIO = 4,
+};
+
+struct Attitude {
+  /**
+   * Bank and pitch angle [1/100 degrees], signed.
+   */
+  PackedLE16 bank, pitch;
+
+  /**
+   * Heading [1/100 degrees]; 0xffff if unknown.
+   */
+  PackedLE16 heading;
+};
+
+struct Acceleration {
+  /**
+   * The acceleration along the three axes [1/1000 g], signed.
+   */
+  PackedLE16 x, y, z;
+};
+
+struct StaticPressure {
+  /**
+   * [1/100 Pa]
+   */
+  PackedLE32 pressure;
+};
+
+struct TotalEnergyVario {
+  /**
+   * [cm/s], signed.
+   */
+  PackedLE16 vario;
+};
+
+/**
+ * The number of bytes a frame adds to its payload.
+ */
+static constexpr std::size_t OVERHEAD = 5;
+
+[[gnu::pure]]
+uint16_t
+CalculateCRC(Type type, std::span<const std::byte> payload) noexcept;
+
+/**
+ * Write one frame to the given buffer.
+ *
+ * @return the number of bytes written or 0 if the buffer is too
+ * small
+ */
+std::size_t
+Write(std::span<std::byte> dest, Type type,
+      std::span<const std::byte> payload) noexcept;
+
+template<typename T>
+std::size_t
+Write(std::span<std::byte> dest, Type type, const T &record) noexcept
+{
+  return Write(dest, type, std::as_bytes(std::span{&record, 1}));
+}
+
+} // namespace SensorFrame
+
+/**
+ * Parses #SensorFrame frames from a byte stream and stores the
+ * records in a #NMEAInfo.  Drivers which opt into this protocol
+ * return true from DeviceRegister::UsesRawData() and pass the
+ * received data to Feed() from Device::DataReceived().
+ */
+class SensorFrameReader {
+  StaticFifoBuffer<std::byte, 256> buffer;
+
+  /**
+   * The number of frames with a bad CRC.
+   */
+  unsigned crc_errors = 0;
+
+public:
+  /**
+   * Parse all complete frames in the received data; an incomplete
+   * frame at the end is kept for the next call.  Bytes which do not
+   * belong to a valid frame are skipped.
+   *
+   * @return true if at least one record was stored in #info
+   */
+  bool Feed(std::span<const std::byte> src, NMEAInfo &info) noexcept;
+
+  void Clear() noexcept {
+    buffer.Clear();
+  }
+
+  unsigned GetCRCErrors() const noexcept {
+    return crc_errors;
+  }
+
+private:
+  /**
+   * Parse the frames in #buffer.
+   */
+  bool ParseBuffer(NMEAInfo &info) noexcept;
+};
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * One entry of a #NMEASentenceTable.
+ */
+template<typename T>
+struct NMEASentence {
+  std::string_view name;
+  T value;
+};
+
+/**
+ * A compile-time perfect hash table which maps NMEA sentence names
+ * (e.g. "$PFLAU" or "GGA") to a value, usually an enum which is then
+ * dispatched with a "switch".  A lookup costs one hash and one string
+ * comparison, no matter how many sentences are known.
+ *
+ * Construct it as a "static constexpr" variable from an array of
+ * #NMEASentence; a hash seed without collisions is searched at
+ * compile time.
+ */
+template<typename T, std::size_t N>
+class NMEASentenceTable {
+  /**
+   * The number of slots; more than twice the number of entries, so a
+   * seed is found quickly.
+   */
+  static constexpr unsigned BITS = [](){
+    unsigned bits = 2;
+    while ((std::size_t(1) << bits) < 2 * N)
+      ++bits;
+    return bits;
+  }();
+
+  static constexpr std::size_t SIZE = std::size_t(1) << BITS;
+
+  /**
+   * The index of each slot's entry plus one; zero means the slot is
+   * empty.
+   */
+  std::array<uint8_t, SIZE> slots{};
+
+  std::array<NMEASentence<T>, N> entries{};
+
+  uint32_t seed = 0;
+
+  static_assert(N < 256);
+
+  static constexpr std::size_t Hash(std::string_view name,
+                                    uint32_t seed) noexcept {
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+    for (const char ch : name) {
+      hash ^= static_cast<unsigned char>(ch);
+      hash *= 16777619u;
+    }
+
+    /* mix in the seed and use the upper bits, which depend on all
+       bits of the FNV hash (the lower bits of names which differ only
+       in the last character collide easily) */
+    hash = (hash ^ seed) * 2654435761u;
+    return hash >> (32 - BITS);
+  }
+
+  constexpr bool Fill(uint32_t _seed) noexcept {
+    seed = _seed;
+    slots = {};
+
+    for (std::size_t i = 0; i < N; ++i) {
+      auto &slot = slots[Hash(entries[i].name, seed)];
+      if (slot != 0)
+        return false;
+
+      slot = static_cast<uint8_t>(i + 1);
+    }
+
+    return true;
+  }
+
+public:
+  /**
+   * Searches a seed without collisions.  If there is none (which is
+   * very unlikely with the table's load factor), compilation fails
+   * because the constexpr evaluation limit is exceeded.
+   */
+  explicit consteval
+  NMEASentenceTable(const NMEASentence<T> (&_entries)[N]) noexcept {
+    for (std::size_t i = 0; i < N; ++i)
+      entries[i] = _entries[i];
+
+    for (uint32_t i = 0;; ++i)
+      if (Fill(i))
+        break;
+  }
+
+  /**
+   * Look up the given sentence name.
+   *
+   * @return a pointer to the value or nullptr if the name is unknown
+   */
+  constexpr const T *Find(std::string_view name) const noexcept {
+    const std::size_t slot = slots[Hash(name, seed)];
+    if (slot == 0)
+      return nullptr;
+
+    const auto &entry = entries[slot - 1];
+    if (entry.name != name)
+      return nullptr;
+
+    return &entry.value;
+  }
+};
@@ -92,6 +92,7 @@ public:
 
   void Reconnect();
   void TogglePause();
+  void ShowStatistics();
 
   /* virtual methods from class Widget */
 
@@ -119,6 +120,7 @@ PortMonitorWidget::CreateButtons(WidgetDialog &dialog)
   dialog.AddButton(_("Clear"), [this](){ Clear(); });
   dialog.AddButton(_("Reconnect"), [this](){ Reconnect(); });
   pause_button = dialog.AddButton(_("Pause"), [this](){ TogglePause(); });
+  dialog.AddButton(_("Statistics"), [this](){ ShowStatistics(); });
 }
 
 void
@@ -150,6 +152,35 @@ PortMonitorWidget::TogglePause()
   }
 }
 
+static constexpr double
+ToMilliseconds(FloatDuration d) noexcept
+{
+  return d.count() * 1000;
+}
+
+void
+PortMonitorWidget::ShowStatistics()
+{
+  const DeviceStatistics s = device.GetStatistics();
+
+  StaticString<512> text;
+  text.Format(_T("%s: %llu\n%s: %llu\n%s: %llu\n"
+                 "%s: %.3f ms (max %.3f ms)\n"
+                 "%s: %.1f ms (max %.1f ms)\n"
+                 "%s: %.1f ms (max %.1f ms)"),
+              _("Bytes received"), (unsigned long long)s.bytes_received,
+              _("Lines received"), (unsigned long long)s.lines_received,
+              _("Parse failures"), (unsigned long long)s.parse_failures,
+              _("Parse time"), ToMilliseconds(s.GetAverageParseTime()),
+              ToMilliseconds(s.parse_time_max),
+              _("Merge delay"), ToMilliseconds(s.merge_delay.last),
+              ToMilliseconds(s.merge_delay.max),
+              _("Calculation delay"), ToMilliseconds(s.calculated_delay.last),
+              ToMilliseconds(s.calculated_delay.max));
+
+  ShowMessageBox(text, _("Statistics"), MB_OK);
+}
+
 void
 ShowPortMonitor(DeviceDescriptor &device)
 {
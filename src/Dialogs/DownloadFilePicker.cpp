@@ -106,8 +106,9 @@ private:
  * Throws on error.
  */
 static AllocatedPath
-DownloadFile(const char *uri, const char *_base)
+DownloadFile(const AvailableFile &file)
 {
+  const char *uri = file.GetURI(), *_base = file.GetName();
   assert(Net::DownloadManager::IsAvailable());
 
   const UTF8ToWideConverter base(_base);
@@ -122,7 +123,8 @@ DownloadFile(const char *uri, const char *_base)
 
   const DownloadProgress dp(dialog, Path(base));
 
-  Net::DownloadManager::Enqueue(uri, Path(base));
+  Net::DownloadManager::Enqueue(uri, Path(base),
+                                file.HasHash() ? &file.sha256_hash : nullptr);
 
   int result = dialog.ShowModal();
   if (result != mrOK) {
@@ -300,7 +302,7 @@ DownloadFilePickerWidget::Download()
   const auto &file = items[current];
 
   try {
-    path = DownloadFile(file.GetURI(), file.GetName());
+    path = DownloadFile(file);
     if (path != nullptr)
       dialog.SetModalResult(mrOK);
   } catch (...) {
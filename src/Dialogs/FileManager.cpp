@@ -486,7 +486,9 @@ ManagedFileListWidget::Download()
   if (!base.IsValid())
     return;
 
-  Net::DownloadManager::Enqueue(remote_file.uri.c_str(), Path(base));
+  Net::DownloadManager::Enqueue(remote_file.uri.c_str(), Path(base),
+                                remote_file.HasHash()
+                                ? &remote_file.sha256_hash : nullptr);
 #endif
 }
 
@@ -572,7 +574,9 @@ ManagedFileListWidget::Add()
   if (!base.IsValid())
     return;
 
-  Net::DownloadManager::Enqueue(remote_file.GetURI(), Path(base));
+  Net::DownloadManager::Enqueue(remote_file.GetURI(), Path(base),
+                                remote_file.HasHash()
+                                ? &remote_file.sha256_hash : nullptr);
 #endif
 }
 
@@ -590,7 +594,9 @@ ManagedFileListWidget::UpdateFiles() {
         if (!base.IsValid())
           return;
 
-        Net::DownloadManager::Enqueue(remote_file->GetURI(), Path(base));
+        Net::DownloadManager::Enqueue(remote_file->GetURI(), Path(base),
+                                      remote_file->HasHash()
+                                      ? &remote_file->sha256_hash : nullptr);
       }
     }
   }
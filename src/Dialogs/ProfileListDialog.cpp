@@ -14,6 +14,7 @@
 #include "LocalPath.hpp"
 #include "Profile/Map.hpp"
 #include "Profile/File.hpp"
+#include "Profile/Profile.hpp"
 #include "UIGlobals.hpp"
 #include "Language/Language.hpp"
 #include "util/StaticString.hxx"
@@ -310,6 +311,10 @@ ProfileListWidget::DeleteClicked()
 void
 ProfileListDialog()
 {
+  /* the list operates on the files; write the current profile
+     first */
+  Profile::Flush();
+
   TWidgetDialog<ProfileListWidget>
     dialog(WidgetDialog::Full{}, UIGlobals::GetMainWindow(),
            UIGlobals::GetDialogLook(), _("Profiles"));
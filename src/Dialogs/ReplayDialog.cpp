@@ -45,9 +45,9 @@ ReplayControlWidget::Prepare([[maybe_unused]] ContainerWindow &parent,
                              [[maybe_unused]] const PixelRect &rc) noexcept
 {
   AddFile(_("File"),
-          _("Name of file to replay.  Can be an IGC file (.igc), a raw NMEA log file (.nmea), or if blank, runs the demo."),
+          _("Name of file to replay.  Can be an IGC file (.igc), a raw NMEA log file (.nmea or .nmz), or if blank, runs the demo."),
           {},
-          _T("*.nmea\0*.igc\0"),
+          _T("*.nmea\0*.nmz\0*.igc\0"),
           true);
   LoadValue(FILE, replay->GetFilename());
 
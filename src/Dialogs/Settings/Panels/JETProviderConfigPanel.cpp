@@ -27,6 +27,7 @@ Copyright_License {
 #include "Language/Language.hpp"
 #include "Profile/Keys.hpp"
 #include "Widget/RowFormWidget.hpp"
+#include "Units/Group.hpp"
 
 #include "Profile/Profile.hpp"
 #include "Form/Edit.hpp"
@@ -72,6 +73,30 @@ void JETProviderConfigPanel::Prepare(ContainerWindow &parent, const PixelRect &r
     nullptr,
     settings.radar.access_token);
   SetExpertRow(RADAR_ACCESS_TOKEN);
+
+  AddBoolean(_("Proximity alert"),
+    _("Looks for radar traffic closing in on your aircraft."),
+    settings.proximity.enabled);
+
+  AddFloat(_("Proximity range"),
+    _("The horizontal distance within which radar traffic is checked."),
+    _T("%.1f %s"), _T("%.1f"),
+    0.5, 20, 0.5, false,
+    UnitGroup::DISTANCE, settings.proximity.range);
+  SetExpertRow(PROXIMITY_RANGE);
+
+  AddFloat(_("Proximity height"),
+    _("The height band above and below your aircraft within which radar traffic is checked."),
+    _T("%.0f %s"), _T("%.0f"),
+    50, 2000, 50, false,
+    UnitGroup::ALTITUDE, settings.proximity.height);
+  SetExpertRow(PROXIMITY_HEIGHT);
+
+  AddInteger(_("Closure cone"),
+    _("Radar traffic is only reported if it is heading towards your aircraft within this angle."),
+    _T("%d°"), _T("%d"),
+    5, 90, 5, settings.proximity.cone);
+  SetExpertRow(PROXIMITY_CONE);
 }
 
 bool JETProviderConfigPanel::Save(bool &_changed) noexcept {
@@ -88,6 +113,18 @@ bool JETProviderConfigPanel::Save(bool &_changed) noexcept {
   
   changed |= SaveValue(RADAR_ACCESS_TOKEN,
     ProfileKeys::JETProviderRadarAccessToken, settings.radar.access_token);
+
+  changed |= SaveValue(PROXIMITY_ENABLED,
+    ProfileKeys::JETProviderProximityEnabled, settings.proximity.enabled);
+
+  changed |= SaveValue(PROXIMITY_RANGE, UnitGroup::DISTANCE,
+    ProfileKeys::JETProviderProximityRange, settings.proximity.range);
+
+  changed |= SaveValue(PROXIMITY_HEIGHT, UnitGroup::ALTITUDE,
+    ProfileKeys::JETProviderProximityHeight, settings.proximity.height);
+
+  changed |= SaveValueInteger(PROXIMITY_CONE,
+    ProfileKeys::JETProviderProximityCone, settings.proximity.cone);
   
   _changed |= changed;
 
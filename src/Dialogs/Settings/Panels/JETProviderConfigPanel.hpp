@@ -49,6 +49,10 @@ enum ControlIndex {
   RADAR_ENABLED,
   RADAR_INTERVAL,
   RADAR_ACCESS_TOKEN,
+  PROXIMITY_ENABLED,
+  PROXIMITY_RANGE,
+  PROXIMITY_HEIGHT,
+  PROXIMITY_CONE,
 };
 
 std::unique_ptr<Widget> CreateJETProviderConfigPanel();
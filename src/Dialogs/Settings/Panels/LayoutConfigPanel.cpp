@@ -23,6 +23,11 @@
 #include "Android/NativeView.hpp"
 #endif
 
+#ifndef ENABLE_OPENGL
+#include "Components.hpp"
+#include "DrawThread.hpp"
+#endif
+
 #ifdef USE_POLL_EVENT
 #include "ui/event/Globals.hpp"
 #include "ui/event/Queue.hpp"
@@ -47,6 +52,10 @@ enum ControlIndex {
   CursorSize,
   CursorInverted,
 #endif
+#ifndef ENABLE_OPENGL
+  MapFrameRate,
+  MapStaticScene,
+#endif
 };
 
 static constexpr StaticEnumChoice display_orientation_list[] = {
@@ -165,6 +174,21 @@ static constexpr StaticEnumChoice dark_mode_list[] = {
   nullptr
 };
 
+#ifndef ENABLE_OPENGL
+
+static constexpr StaticEnumChoice map_frame_rate_list[] = {
+  { 0, N_("Auto"),
+    N_("Limited on electronic paper displays, unlimited otherwise") },
+  { 1, _T("1/s") },
+  { 2, _T("2/s") },
+  { 5, _T("5/s") },
+  { 10, _T("10/s") },
+  { 20, _T("20/s") },
+  nullptr
+};
+
+#endif
+
 class LayoutConfigPanel final : public RowFormWidget {
 public:
   LayoutConfigPanel()
@@ -240,6 +264,18 @@ LayoutConfigPanel::Prepare(ContainerWindow &parent,
   AddBoolean(_("Invert cursor color"), _("Enable black cursor"),
              ui_settings.display.invert_cursor_colors);
 #endif
+
+#ifndef ENABLE_OPENGL
+  AddEnum(_("Map frame rate"),
+          _("The maximum number of times per second the map is redrawn for new data.  Panning and zooming are not limited.  Lower values save power."),
+          map_frame_rate_list, ui_settings.display.map_frame_rate);
+  SetExpertRow(MapFrameRate);
+
+  AddBoolean(_("Skip unchanged frames"),
+             _("Don't redraw the map for new data if nothing visible has changed, e.g. while standing on the ground."),
+             ui_settings.display.map_static_scene);
+  SetExpertRow(MapStaticScene);
+#endif
 }
 
 bool
@@ -306,6 +342,18 @@ LayoutConfigPanel::Save(bool &_changed) noexcept
   CommonInterface::main_window->SetCursorColorsInverted(ui_settings.display.invert_cursor_colors);
 #endif
 
+#ifndef ENABLE_OPENGL
+  bool frame_rate_changed =
+    SaveValueEnum(MapFrameRate, ProfileKeys::MapFrameRate,
+                  ui_settings.display.map_frame_rate);
+  frame_rate_changed |= SaveValue(MapStaticScene, ProfileKeys::MapStaticScene,
+                                  ui_settings.display.map_static_scene);
+  if (frame_rate_changed && draw_thread != nullptr)
+    draw_thread->SetFrameRate(ui_settings.display.map_frame_rate,
+                              ui_settings.display.map_static_scene);
+  changed |= frame_rate_changed;
+#endif
+
   if (orientation_changed) {
     assert(Display::RotateSupported());
 
@@ -21,8 +21,10 @@ enum ControlIndex {
   CrewWeightTemplate,
   LoggerTimeStepCruise,
   LoggerTimeStepCircling,
+  LoggerPreTakeoffDuration,
   DisableAutoLogger,
   EnableNMEALogger,
+  CompressNMEALog,
   EnableFlightLogger,
   LoggerID,
 };
@@ -73,6 +75,14 @@ LoggerConfigPanel::Prepare(ContainerWindow &parent,
               seconds{1}, seconds{30}, seconds{1}, logger.time_step_circling);
   SetExpertRow(LoggerTimeStepCircling);
 
+  AddDuration(_("Pre-takeoff log"),
+              _("How much of the time before the logger was started is "
+                "written to the IGC file, e.g. to include a winch launch "
+                "or a long ground roll."),
+              seconds{0}, minutes{10}, seconds{30},
+              logger.pre_takeoff_duration);
+  SetExpertRow(LoggerPreTakeoffDuration);
+
   AddEnum(_("Auto. logger"),
           _("Enables the automatic starting and stopping of logger on takeoff and landing "
             "respectively. Disable when flying paragliders."),
@@ -85,6 +95,13 @@ LoggerConfigPanel::Prepare(ContainerWindow &parent,
              logger.enable_nmea_logger);
   SetExpertRow(EnableNMEALogger);
 
+  AddBoolean(_("Compress NMEA log"),
+             _("Write the NMEA log in a compressed format (.nmz) which "
+               "is about ten times smaller.  It can be replayed, but not "
+               "read by other programs."),
+             logger.compress_nmea_log);
+  SetExpertRow(CompressNMEALog);
+
   AddBoolean(_("Log book"), _("Logs each start and landing."),
              logger.enable_flight_logger);
   SetExpertRow(EnableFlightLogger);
@@ -114,6 +131,10 @@ LoggerConfigPanel::Save(bool &changed) noexcept
   changed |= SaveValue(LoggerTimeStepCircling, ProfileKeys::LoggerTimeStepCircling,
                        logger.time_step_circling);
 
+  changed |= SaveValue(LoggerPreTakeoffDuration,
+                       ProfileKeys::LoggerPreTakeoffDuration,
+                       logger.pre_takeoff_duration);
+
   /* GUI label is "Enable Auto Logger" */
   changed |= SaveValueEnum(DisableAutoLogger, ProfileKeys::AutoLogger,
                            logger.auto_logger);
@@ -121,8 +142,15 @@ LoggerConfigPanel::Save(bool &changed) noexcept
   changed |= SaveValue(EnableNMEALogger, ProfileKeys::EnableNMEALogger,
                        logger.enable_nmea_logger);
 
-  if (logger.enable_nmea_logger && nmea_logger != nullptr)
-    nmea_logger->Enable();
+  changed |= SaveValue(CompressNMEALog, ProfileKeys::CompressNMEALog,
+                       logger.compress_nmea_log);
+
+  if (nmea_logger != nullptr) {
+    nmea_logger->SetCompressed(logger.compress_nmea_log);
+
+    if (logger.enable_nmea_logger)
+      nmea_logger->Enable();
+  }
 
   if (SaveValue(EnableFlightLogger, ProfileKeys::EnableFlightLogger,
                 logger.enable_flight_logger)) {
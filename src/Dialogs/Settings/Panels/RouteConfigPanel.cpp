@@ -18,6 +18,7 @@ enum ControlIndex {
   empty_spacer,
   TurningReach,
   ReachPolarMode,
+  ReachAirspace,
   FinalGlideTerrain,
 };
 
@@ -52,6 +53,7 @@ RouteConfigPanel::ShowReachControls(bool show)
 {
   SetRowVisible(FinalGlideTerrain, show);
   SetRowVisible(ReachPolarMode, show);
+  SetRowVisible(ReachAirspace, show);
 }
 
 void
@@ -137,6 +139,12 @@ RouteConfigPanel::Prepare(ContainerWindow &parent,
           reach_polar_list, (unsigned)route_planner.reach_polar_mode);
   SetExpertRow(ReachPolarMode);
 
+  AddBoolean(_("Reach airspace"),
+             _("When enabled, the reach also avoids active airspace, so the glide range shows "
+                 "where the glider can arrive without entering it."),
+             route_planner.reach_airspace);
+  SetExpertRow(ReachAirspace);
+
   static constexpr StaticEnumChoice final_glide_terrain_list[] = {
     { FeaturesSettings::FinalGlideTerrain::OFF, N_("Off"),
       N_("Disables the reach display.") },
@@ -184,6 +192,9 @@ RouteConfigPanel::Save(bool &_changed) noexcept
 
   changed |= SaveValueEnum(TurningReach, ProfileKeys::TurningReach,
                            route_planner.reach_calc_mode);
+
+  changed |= SaveValue(ReachAirspace, ProfileKeys::ReachAirspace,
+                       route_planner.reach_airspace);
   _changed |= changed;
 
   return true;
@@ -26,6 +26,7 @@ enum ControlIndex {
   SL_ROAMING,
 #endif
   SL_INTERVAL,
+  SL_BATCH_DELAY,
   SL_TRAFFIC_ENABLED,
   SL_NEAR_TRAFFIC_ENABLED,
   SL_KEY,
@@ -79,6 +80,7 @@ TrackingConfigPanel::SetSkyLinesEnabled(bool enabled)
   SetRowEnabled(SL_ROAMING, enabled);
 #endif
   SetRowEnabled(SL_INTERVAL, enabled);
+  SetRowEnabled(SL_BATCH_DELAY, enabled);
   SetRowEnabled(SL_TRAFFIC_ENABLED, enabled);
   SetRowEnabled(SL_NEAR_TRAFFIC_ENABLED,
                 enabled && GetValueBoolean(SL_TRAFFIC_ENABLED));
@@ -155,6 +157,19 @@ static constexpr StaticEnumChoice tracking_intervals[] = {
 
 #endif
 
+#ifdef HAVE_SKYLINES_TRACKING
+
+static constexpr StaticEnumChoice batch_delays[] = {
+  { 0, N_("Off") },
+  { 30, _T("30 sec") },
+  { 60, _T("1 min") },
+  { 120, _T("2 min") },
+  { 300, _T("5 min") },
+  nullptr,
+};
+
+#endif
+
 #ifdef HAVE_LIVETRACK24
 
 static constexpr StaticEnumChoice server_list[] = {
@@ -192,6 +207,10 @@ TrackingConfigPanel::Prepare(ContainerWindow &parent, const PixelRect &rc) noexc
   AddEnum(_("Tracking Interval"), nullptr, tracking_intervals,
           FindClosestTrackingInterval(settings.skylines.interval));
 
+  AddEnum(_("Batch packets"),
+          _("Send several fixes and requests in one packet to save data on expensive connections such as satellite links.  They are delayed by up to this duration.  The server must support this."),
+          batch_delays, settings.skylines.batch_delay);
+
   AddBoolean(_("Track friends"),
              _("Download the position of your friends live from the SkyLines server."),
              settings.skylines.traffic_enabled, this);
@@ -286,6 +305,9 @@ TrackingConfigPanel::Save(bool &_changed) noexcept
   changed |= SaveValueEnum(SL_INTERVAL, ProfileKeys::SkyLinesTrackingInterval,
                            settings.skylines.interval);
 
+  changed |= SaveValueEnum(SL_BATCH_DELAY, ProfileKeys::SkyLinesBatchDelay,
+                           settings.skylines.batch_delay);
+
   changed |= SaveValue(SL_TRAFFIC_ENABLED, ProfileKeys::SkyLinesTrafficEnabled,
                        settings.skylines.traffic_enabled);
   changed |= SaveValue(SL_NEAR_TRAFFIC_ENABLED,
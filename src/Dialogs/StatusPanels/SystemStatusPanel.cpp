@@ -8,11 +8,16 @@
 #include "Language/Language.hpp"
 #include "Hardware/PowerGlobal.hpp"
 #include "net/State.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Weather/Stats.hpp"
 
 #ifdef HAVE_BATTERY
 #include "Hardware/PowerInfo.hpp"
 #endif
 
+#include <algorithm>
+
 enum Controls {
   GPS,
   NumSat,
@@ -21,6 +26,16 @@ enum Controls {
   Logger,
   Battery,
   Network,
+  TerrainTiles,
+  TerrainCache,
+  TerrainLoading,
+  TerrainLock,
+  TopographyMemory,
+  WeatherSkysightNetwork,
+  WeatherSkysightDecoding,
+  WeatherRasp,
+  WeatherPCMet,
+  WeatherNOAA,
 };
 
 [[gnu::pure]]
@@ -107,6 +122,126 @@ SystemStatusPanel::Refresh() noexcept
   SetText(Battery, Temp);
 
   SetText(Network, ToString(GetNetState()));
+
+  RefreshTerrain();
+  RefreshTopography();
+  RefreshWeather();
+}
+
+void
+SystemStatusPanel::RefreshTerrain() noexcept
+{
+  if (terrain == nullptr) {
+    ClearText(TerrainTiles);
+    ClearText(TerrainCache);
+    ClearText(TerrainLoading);
+    ClearText(TerrainLock);
+    return;
+  }
+
+  using std::chrono::duration_cast;
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+
+  const auto stats = terrain->GetStats();
+
+  StaticString<80> Temp;
+
+  Temp.Format(_T("%u (%u kB)"), stats.resident_tiles,
+              unsigned(stats.resident_bytes / 1024));
+  SetText(TerrainTiles, Temp);
+
+  Temp.Format(_T("%u %% hits, %u evicted"),
+              stats.GetHitPercent(), unsigned(stats.evictions));
+  SetText(TerrainCache, Temp);
+
+  Temp.Format(_T("%u tiles, %.1f ms/tile, %u dirty"),
+              unsigned(stats.tiles_loaded),
+              duration_cast<Milliseconds>(stats.GetLoadTimePerTile()).count(),
+              unsigned(stats.dirty_polls));
+  SetText(TerrainLoading, Temp);
+
+  Temp.Format(_T("%lu waits, %.1f ms max"),
+              (unsigned long)stats.contended_leases,
+              duration_cast<Milliseconds>(stats.max_lease_wait).count());
+  SetText(TerrainLock, Temp);
+}
+
+void
+SystemStatusPanel::RefreshTopography() noexcept
+{
+  if (topography == nullptr) {
+    ClearText(TopographyMemory);
+    return;
+  }
+
+  const auto stats = topography->GetMemoryStats();
+
+  StaticString<80> Temp;
+  if (stats.budget > 0)
+    Temp.Format(_T("%u of %u kB"), unsigned(stats.used / 1024),
+                unsigned(stats.budget / 1024));
+  else
+    Temp.Format(_T("%u kB"), unsigned(stats.used / 1024));
+
+  if (stats.evicted > 0)
+    Temp.AppendFormat(_T(", %u kB evicted"),
+                      unsigned(stats.evicted / 1024));
+
+  SetText(TopographyMemory, Temp);
+}
+
+/**
+ * Sum up the counters of the given stages.
+ */
+[[gnu::pure]]
+static WeatherStats::Snapshot
+GetWeatherStats(std::initializer_list<WeatherStage> stages) noexcept
+{
+  WeatherStats::Snapshot total{};
+  for (const auto stage : stages) {
+    const auto s = WeatherStats::Get(stage);
+    total.count += s.count;
+    total.errors += s.errors;
+    total.bytes += s.bytes;
+    total.total_time += s.total_time;
+    total.max_time = std::max(total.max_time, s.max_time);
+  }
+
+  return total;
+}
+
+void
+SystemStatusPanel::RefreshWeather() noexcept
+{
+  using std::chrono::duration_cast;
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+
+  const auto Set = [this](unsigned control,
+                          const WeatherStats::Snapshot &stats){
+    if (stats.count == 0) {
+      ClearText(control);
+      return;
+    }
+
+    StaticString<80> Temp;
+    Temp.Format(_T("%u (%u failed), %u kB, %.0f ms avg"),
+                unsigned(stats.count), unsigned(stats.errors),
+                unsigned(stats.bytes / 1024),
+                duration_cast<Milliseconds>(stats.GetAverageTime()).count());
+    SetText(control, Temp);
+  };
+
+  Set(WeatherSkysightNetwork,
+      GetWeatherStats({WeatherStage::SKYSIGHT_LOGIN,
+                       WeatherStage::SKYSIGHT_FETCH}));
+  Set(WeatherSkysightDecoding,
+      GetWeatherStats({WeatherStage::SKYSIGHT_NETCDF,
+                       WeatherStage::SKYSIGHT_GEOTIFF,
+                       WeatherStage::SKYSIGHT_OVERLAY}));
+  Set(WeatherRasp,
+      GetWeatherStats({WeatherStage::RASP_SCAN, WeatherStage::RASP_LOAD}));
+  Set(WeatherPCMet, GetWeatherStats({WeatherStage::PCMET_DOWNLOAD}));
+  Set(WeatherNOAA, GetWeatherStats({WeatherStage::NOAA_DOWNLOAD}));
 }
 
 void
@@ -120,6 +255,16 @@ SystemStatusPanel::Prepare([[maybe_unused]] ContainerWindow &parent,
   AddReadOnly(_("Logger"));
   AddReadOnly(_("Supply voltage"));
   AddReadOnly(_("Network"));
+  AddReadOnly(_("Terrain tiles"));
+  AddReadOnly(_("Terrain cache"));
+  AddReadOnly(_("Terrain loading"));
+  AddReadOnly(_("Terrain lock"));
+  AddReadOnly(_("Topography memory"));
+  AddReadOnly(_("Skysight network"));
+  AddReadOnly(_("Skysight decoding"));
+  AddReadOnly(_T("RASP"));
+  AddReadOnly(_T("pc_met"));
+  AddReadOnly(_T("NOAA"));
 }
 
 void
@@ -25,6 +25,10 @@ public:
   void Hide() noexcept override;
 
 private:
+  void RefreshTerrain() noexcept;
+  void RefreshTopography() noexcept;
+  void RefreshWeather() noexcept;
+
   /* virtual methods from class BlackboardListener */
   void OnGPSUpdate(const MoreData &basic) override;
 };
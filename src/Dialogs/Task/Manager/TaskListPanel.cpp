@@ -20,6 +20,7 @@
 #include "Interface.hpp"
 #include "Renderer/TextRowRenderer.hpp"
 #include "Look/DialogLook.hpp"
+#include "Formatter/UserUnits.hpp"
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "util/StringCompare.hxx"
 #include "UIGlobals.hpp"
@@ -154,7 +155,16 @@ TaskListPanel::OnPaintItem(Canvas &canvas, const PixelRect rc,
 {
   assert(DrawListIndex <= task_store.Size());
 
-  row_renderer.DrawTextRow(canvas, rc, task_store.GetName(DrawListIndex));
+  /* the summary is only known for tasks which have been loaded
+     before; showing it does not require parsing the file */
+  PixelRect text_rc = rc;
+  if (const auto &summary = task_store.GetSummary(DrawListIndex);
+      summary.defined && summary.n_points > 0)
+    text_rc.right =
+      row_renderer.DrawRightColumn(canvas, rc,
+                                   FormatUserDistanceSmart(summary.distance));
+
+  row_renderer.DrawTextRow(canvas, text_rc, task_store.GetName(DrawListIndex));
 }
 
 void
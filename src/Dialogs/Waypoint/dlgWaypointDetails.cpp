@@ -28,6 +28,7 @@
 #include "Task/ProtectedTaskManager.hpp"
 #include "Language/Language.hpp"
 #include "Waypoint/LastUsed.hpp"
+#include "Waypoint/WaypointDetailsReader.hpp"
 #include "Profile/Current.hpp"
 #include "Profile/Map.hpp"
 #include "Profile/Keys.hpp"
@@ -656,6 +657,7 @@ dlgWaypointDetailsShowModal(WaypointPtr _waypoint,
                             bool allow_navigation, bool allow_edit)
 {
   LastUsedWaypoints::Add(*_waypoint);
+  WaypointDetails::Load(*_waypoint);
 
   const DialogLook &look = UIGlobals::GetDialogLook();
   TWidgetDialog<WaypointDetailsWidget>
@@ -315,7 +315,8 @@ WeatherMapOverlayListWidget::SetOverlay(Path path, const TCHAR *label)
 
   std::unique_ptr<MapOverlayBitmap> bmp;
   try {
-    bmp.reset(new MapOverlayBitmap(path));
+    bmp.reset(new MapOverlayBitmap(path,
+                                   MapOverlayBitmap::GetMaxImageSize(map->GetSize())));
   } catch (...) {
     ShowError(std::current_exception(), _("Weather"));
     return;
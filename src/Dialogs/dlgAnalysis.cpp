@@ -33,12 +33,15 @@
 #include "Language/Language.hpp"
 #include "Engine/Contest/Solvers/Contests.hpp"
 #include "ui/event/PeriodicTimer.hpp"
+#include "ui/window/BufferWindow.hpp"
 #include "util/StringCompare.hxx"
 
 #ifdef ENABLE_OPENGL
 #include "ui/canvas/opengl/Scissor.hpp"
 #endif
 
+#include <optional>
+
 #include <stdio.h>
 
 using namespace UI;
@@ -47,10 +50,11 @@ static AnalysisPage page = AnalysisPage::BAROGRAPH;
 
 class AnalysisWidget;
 
-class ChartControl: public PaintWindow
+class ChartControl: public BufferWindow
 {
   AnalysisWidget &analysis_widget;
 
+  const Color background_color;
   const ChartLook &chart_look;
   const CrossSectionLook &cross_section_look;
   ThermalBandRenderer thermal_band_renderer;
@@ -59,11 +63,20 @@ class ChartControl: public PaintWindow
   GestureManager gestures;
   bool dragging;
 
+  /**
+   * The page and the data generation (see GetDataGeneration()) in
+   * the buffer.  If both are unchanged, UpdateChart() does not
+   * render the chart again.
+   */
+  AnalysisPage painted_page = AnalysisPage::COUNT;
+  unsigned painted_generation;
+
   const FullBlackboard &blackboard;
   const GlideComputer &glide_computer;
 
 public:
   ChartControl(AnalysisWidget &_analysis_widget,
+               Color _background_color,
                const ChartLook &_chart_look,
                const MapLook &map_look,
                const CrossSectionLook &_cross_section_look,
@@ -75,6 +88,7 @@ public:
                const FullBlackboard &_blackboard,
                const GlideComputer &_glide_computer)
     :analysis_widget(_analysis_widget),
+     background_color(_background_color),
      chart_look(_chart_look),
      cross_section_look(_cross_section_look),
      thermal_band_renderer(_thermal_band_look, chart_look),
@@ -88,6 +102,11 @@ public:
     cross_section_renderer.SetTerrain(terrain);
   }
 
+  /**
+   * Schedule a repaint of the chart if its data has changed.
+   */
+  void UpdateChart() noexcept;
+
   void UpdateCrossSection(const MoreData &basic,
                           const DerivedInfo &calculated,
                           const GlideSettings &glide_settings,
@@ -105,8 +124,17 @@ protected:
     dragging = false;
   }
 
-  /* virtual methods from class PaintWindow */
-  void OnPaint(Canvas &canvas) noexcept override;
+  /* virtual methods from class BufferWindow */
+  void OnPaintBuffer(Canvas &canvas) noexcept override;
+
+private:
+  /**
+   * Returns a number which changes whenever the chart of the given
+   * page may look different, or std::nullopt if that cannot be
+   * determined cheaply and it must be rendered each time.
+   */
+  [[gnu::pure]]
+  std::optional<unsigned> GetDataGeneration(AnalysisPage _page) const noexcept;
 };
 
 class AnalysisWidget final : public NullWidget {
@@ -138,7 +166,7 @@ public:
     :blackboard(_blackboard), glide_computer(_glide_computer),
      dialog(_dialog),
      info(look.dialog),
-     chart(*this, look.chart, look.map, look.cross_section,
+     chart(*this, look.dialog.background_color, look.chart, look.map, look.cross_section,
            look.thermal_band, look.cross_section,
            look.map.airspace, airspaces, terrain,
            _blackboard, _glide_computer) {
@@ -309,8 +337,39 @@ AnalysisWidget::SetCalcCaption(const TCHAR *caption)
   SetCalcVisibility(!StringIsEmpty(caption));
 }
 
+std::optional<unsigned>
+ChartControl::GetDataGeneration(AnalysisPage _page) const noexcept
+{
+  switch (_page) {
+  case AnalysisPage::BAROGRAPH:
+  case AnalysisPage::CLIMB:
+  case AnalysisPage::WIND:
+  case AnalysisPage::TASK_SPEED:
+    /* these charts are drawn from FlightStatistics, which changes
+       about once a minute */
+    return glide_computer.GetFlightStats().GetGeneration();
+
+  default:
+    return std::nullopt;
+  }
+}
+
 void
-ChartControl::OnPaint(Canvas &canvas) noexcept
+ChartControl::UpdateChart() noexcept
+{
+  const auto generation = GetDataGeneration(page);
+  if (generation && page == painted_page &&
+      *generation == painted_generation)
+    /* the buffer is still up to date */
+    return;
+
+  painted_page = page;
+  painted_generation = generation.value_or(0);
+  Invalidate();
+}
+
+void
+ChartControl::OnPaintBuffer(Canvas &canvas) noexcept
 {
   const ComputerSettings &settings_computer = blackboard.GetComputerSettings();
   const MapSettings &settings_map = blackboard.GetMapSettings();
@@ -329,7 +388,7 @@ ChartControl::OnPaint(Canvas &canvas) noexcept
 
   PixelRect rcgfx = GetClientRect();
 
-  // background is painted in the base-class
+  canvas.Clear(background_color);
 
   switch (page) {
   case AnalysisPage::BAROGRAPH:
@@ -567,8 +626,7 @@ AnalysisWidget::Update()
                              settings_computer.polar.glide_polar_task,
                              blackboard.GetMapSettings());
 
-
-  chart.Invalidate();
+  chart.UpdateChart();
 }
 
 void
@@ -10,4 +10,6 @@ DisplaySettings::SetDefaults()
   cursor_size = 1;
   invert_cursor_colors = false;
   full_screen = true;
+  map_frame_rate = 0;
+  map_static_scene = false;
 }
@@ -16,6 +16,17 @@ struct DisplaySettings {
   bool invert_cursor_colors;
   bool full_screen;
 
+  /**
+   * The maximum number of map frames per second; 0 means the default
+   * for this device.  Only used without OpenGL (by the DrawThread).
+   */
+  uint8_t map_frame_rate;
+
+  /**
+   * Skip map frames for new data if nothing visible has changed?
+   */
+  bool map_static_scene;
+
   void SetDefaults();
 };
 
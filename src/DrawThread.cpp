@@ -7,6 +7,18 @@
 
 #include "MapWindow/GlueMapWindow.hpp"
 #include "Hardware/CPU.hpp"
+#include "Asset.hpp"
+
+void
+DrawThread::SetFrameRate(unsigned frame_rate, bool static_scene) noexcept
+{
+  const std::lock_guard lock{mutex};
+  pacer.SetMinInterval(FramePacer::GetMinInterval(frame_rate, HasEPaper()));
+  pacer.SetStaticScene(static_scene);
+
+  /* wake up the thread in case it waits for a longer interval */
+  command_trigger.notify_one();
+}
 
 /**
  * Main loop of the DrawThread
@@ -20,24 +32,43 @@ DrawThread::Run() noexcept
 
   // circle until application is closed
   while (!_CheckStoppedOrSuspended(lock)) {
-    if (!pending) {
+    if (!pacer.IsPending()) {
       command_trigger.wait(lock);
       continue;
     }
 
-    pending = false;
+    const auto now = FramePacer::Clock::now();
+    if (const auto delay = pacer.GetDelay(now); delay.count() > 0) {
+      /* limit the frame rate; more requests get merged into this
+         one meanwhile */
+      command_trigger.wait_for(lock, delay);
+      continue;
+    }
+
+    const auto priority = pacer.Begin(now);
+    const bool may_skip = pacer.MaySkip(priority, now);
+
+    bool painted = false;
 
-    const ScopeUnlock unlock(mutex);
+    {
+      const ScopeUnlock unlock(mutex);
 
 #ifdef HAVE_CPU_FREQUENCY
-    const ScopeLockCPU cpu;
+      const ScopeLockCPU cpu;
 #endif
 
-    // Get data from the DeviceBlackboard
-    map.ExchangeBlackboard();
+      // Get data from the DeviceBlackboard
+      map.ExchangeBlackboard();
+
+      // Draw the moving map (unless nothing visible has changed)
+      if (map.UpdateSceneKey() || !may_skip) {
+        map.Repaint();
+        painted = true;
+      }
+    }
 
-    // Draw the moving map
-    map.Repaint();
+    if (painted)
+      pacer.Painted(now);
   }
 }
 
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "thread/RecursivelySuspensibleThread.hpp"
+#include "FramePacer.hpp"
+#include "Profiler.hpp"
 
 class GlueMapWindow;
 
@@ -17,24 +19,40 @@ class GlueMapWindow;
  */
 class DrawThread final : public RecursivelySuspensibleThread {
   /**
-   * Is work pending?  This flag gets cleared by the thread as soon as
-   * it starts working.
+   * Is work pending, and when may it be done?  The request gets
+   * cleared by the thread as soon as it starts working.  Protected
+   * by the mutex.
    */
-  bool pending = true;
+  FramePacer pacer;
 
   /** Pointer to the MapWindow */
   GlueMapWindow &map;
 
 public:
   DrawThread(GlueMapWindow &_map) noexcept
-    :RecursivelySuspensibleThread("DrawThread"), map(_map) {}
+    :RecursivelySuspensibleThread("DrawThread"), map(_map) {
+    pacer.Request(FramePacer::Priority::NORMAL);
+  }
+
+  /**
+   * Configure the frame pacing.
+   *
+   * @param frame_rate the maximum number of frames per second; 0
+   * means the default for this device
+   * @param static_scene skip frames for new data if nothing visible
+   * has changed?
+   */
+  void SetFrameRate(unsigned frame_rate, bool static_scene) noexcept;
 
   /**
    * Triggers a redraw.
    */
-  void TriggerRedraw() noexcept {
+  void TriggerRedraw(FramePacer::Priority priority=FramePacer::Priority::NORMAL) noexcept {
     const std::lock_guard lock{mutex};
-    pending = true;
+    if (!pacer.Request(priority))
+      /* the previous request has not been handled yet */
+      Profiler::AddSkippedFrame();
+
     command_trigger.notify_one();
   }
 
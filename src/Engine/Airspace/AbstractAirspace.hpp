@@ -226,6 +226,13 @@ public:
     days_of_operation = mask;
   }
 
+  /**
+   * Get the days of operation of the airspace
+   */
+  const AirspaceActivity &GetDays() const noexcept {
+    return days_of_operation;
+  }
+
   /**
    * Get asclass of airspace
    *
@@ -23,6 +23,8 @@ AirspacePolygon::AirspacePolygon(const std::vector<GeoPoint> &pts) noexcept
   if (p_start != p_end)
     m_border.emplace_back(p_start);
 
+  edge_index.Build(m_border);
+
   is_convex = TriState::UNKNOWN;
 }
 
@@ -55,7 +57,7 @@ AirspacePolygon::GetCenter() const noexcept
 bool
 AirspacePolygon::Inside(const GeoPoint &loc) const noexcept
 {
-  return m_border.IsInside(loc);
+  return edge_index.IsInside(m_border, loc);
 }
 
 AirspaceIntersectionVector
@@ -67,13 +69,21 @@ AirspacePolygon::Intersects(const GeoPoint &start, const GeoPoint &end,
 
   AirspaceIntersectSort sorter(start, *this);
 
-  for (auto it = m_border.begin(); it + 1 != m_border.end(); ++it) {
-
-    const FlatRay r_seg(it->GetFlatLocation(), (it + 1)->GetFlatLocation());
+  /* only edges overlapping the latitude range of the ray can
+     intersect it; add a margin for the rounding of the flat
+     coordinates */
+  const Angle margin = projection.Unproject(FlatGeoPoint(0, 2)).latitude -
+    projection.Unproject(FlatGeoPoint(0, 0)).latitude;
+  const Angle south = std::min(start.latitude, end.latitude) - margin;
+  const Angle north = std::max(start.latitude, end.latitude) + margin;
+
+  edge_index.ForEachEdge(m_border, south, north, [&](std::size_t i){
+    const FlatRay r_seg(m_border[i].GetFlatLocation(),
+                        m_border[i + 1].GetFlatLocation());
     auto t = ray.DistinctIntersection(r_seg);
     if (t >= 0)
       sorter.add(t, projection.Unproject(ray.Parametric(t)));
-  }
+  });
 
   return sorter.all();
 }
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "AbstractAirspace.hpp"
+#include "Geo/PolygonBandIndex.hpp"
+
 #include <vector>
 
 #ifdef DO_PRINT
@@ -12,6 +14,12 @@
 
 /** General polygon form airspace */
 class AirspacePolygon final : public AbstractAirspace {
+  /**
+   * An index of the #m_border edges, which speeds up Inside() and
+   * Intersects() for polygons with many vertices.
+   */
+  PolygonBandIndex edge_index;
+
 public:
   /**
    * Constructor.  For testing, pts vector is a cloud of points,
@@ -28,6 +36,7 @@ public:
    */
   void MakeConvex() noexcept {
     m_border.PruneInterior();
+    edge_index.Build(m_border);
     is_convex = TriState::TRUE;
   }
 
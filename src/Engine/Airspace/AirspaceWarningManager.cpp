@@ -8,6 +8,11 @@
 #include "AirspaceIntersectionVisitor.hpp"
 #include "AirspaceAircraftPerformance.hpp"
 #include "Task/Stats/TaskStats.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "Math/Util.hpp"
+
+#include <array>
+#include <vector>
 
 static constexpr double CRUISE_FILTER_FACT = 0.5;
 
@@ -98,6 +103,23 @@ AirspaceWarningManager::GetNewWarningPtr(ConstAirspacePtr airspace) noexcept
   return &warnings.back();
 }
 
+/**
+ * An airspace found by a warning prediction.
+ */
+struct AirspaceWarningCandidate {
+  ConstAirspacePtr airspace;
+  AirspaceInterceptSolution solution;
+};
+
+struct AirspaceWarningManager::Prediction {
+  AirspaceWarning::State state;
+
+  std::vector<AirspaceWarningCandidate> candidates;
+
+  explicit Prediction(AirspaceWarning::State _state) noexcept
+    :state(_state) {}
+};
+
 bool 
 AirspaceWarningManager::Update(const AircraftState& state,
                                const GlidePolar &glide_polar,
@@ -118,11 +140,53 @@ AirspaceWarningManager::Update(const AircraftState& state,
   for (auto &w : warnings)
     w.SaveState();
 
-  // check from strongest to weakest alerts
-  UpdateInside(state, glide_polar);
-  UpdateGlide(state, glide_polar);
-  UpdateFilter(state, circling);
-  UpdateTask(state, glide_polar, task_stats);
+  // update both filters even though we are using only one
+  cruise_filter.Update(state);
+  circling_filter.Update(state);
+
+  /* the predictions only read the airspaces and the filters, so they
+     may run concurrently */
+  std::array<Prediction, 4> predictions{
+    Prediction{AirspaceWarning::WARNING_INSIDE},
+    Prediction{AirspaceWarning::WARNING_GLIDE},
+    Prediction{AirspaceWarning::WARNING_FILTER},
+    Prediction{AirspaceWarning::WARNING_TASK},
+  };
+
+  const std::function<void(std::size_t)> predict = [&](std::size_t i){
+    auto &prediction = predictions[i];
+
+    switch (prediction.state) {
+    case AirspaceWarning::WARNING_INSIDE:
+      PredictInside(state, glide_polar, prediction);
+      break;
+
+    case AirspaceWarning::WARNING_GLIDE:
+      PredictGlide(state, glide_polar, prediction);
+      break;
+
+    case AirspaceWarning::WARNING_FILTER:
+      PredictFilter(state, circling, prediction);
+      break;
+
+    case AirspaceWarning::WARNING_TASK:
+      PredictTask(state, glide_polar, task_stats, prediction);
+      break;
+
+    case AirspaceWarning::WARNING_CLEAR:
+      break;
+    }
+  };
+
+  if (for_each)
+    for_each(predictions.size(), predict);
+  else
+    for (std::size_t i = 0; i < predictions.size(); ++i)
+      predict(i);
+
+  // merge from strongest to weakest alerts
+  for (const auto &prediction : predictions)
+    Apply(prediction);
 
   // action changes
   for (auto it = warnings.begin(), end = warnings.end(); it != end;) {
@@ -146,6 +210,21 @@ AirspaceWarningManager::Update(const AircraftState& state,
   return changed;
 }
 
+void
+AirspaceWarningManager::Apply(const Prediction &prediction) noexcept
+{
+  for (const auto &i : prediction.candidates) {
+    AirspaceWarning *warning = GetWarningPtr(*i.airspace);
+    if (warning != nullptr && !warning->IsStateAccepted(prediction.state))
+      continue;
+
+    if (warning == nullptr)
+      warning = GetNewWarningPtr(i.airspace);
+
+    warning->UpdateSolution(prediction.state, i.solution);
+  }
+}
+
 /**
  * Class used temporarily to check intersections with warning system
  */
@@ -154,10 +233,9 @@ class AirspaceIntersectionWarningVisitor final
 {
   const AircraftState state;
   const AirspaceAircraftPerformance &perf;
-  AirspaceWarningManager &warning_manager;
-  const AirspaceWarning::State warning_state;
+  const AirspaceWarningConfig &config;
+  std::vector<AirspaceWarningCandidate> &candidates;
   const FloatDuration max_time;
-  bool found = false;
   const double max_alt;
   bool mode_inside = false;
 
@@ -167,8 +245,8 @@ public:
    *
    * @param state State of aircraft
    * @param perf Aircraft performance model
-   * @param warning_manager Warning manager to add items to
-   * @param warning_state Type of warning
+   * @param config Warning configuration
+   * @param candidates List to add intersections to
    * @param max_time Time limit of intercept
    * @param max_alt Maximum height of base to allow (optional)
    *
@@ -176,21 +254,21 @@ public:
    */
   AirspaceIntersectionWarningVisitor(const AircraftState &_state,
                                      const AirspaceAircraftPerformance &_perf,
-                                     AirspaceWarningManager &_warning_manager,
-                                     const AirspaceWarning::State _warning_state,
+                                     const AirspaceWarningConfig &_config,
+                                     std::vector<AirspaceWarningCandidate> &_candidates,
                                      const FloatDuration _max_time,
                                      const double _max_alt = -1):
     state(_state),
     perf(_perf),
-    warning_manager(_warning_manager),
-    warning_state(_warning_state),
+    config(_config),
+    candidates(_candidates),
     max_time(_max_time),
     max_alt(_max_alt)
   {
   }
 
   /**
-   * Check whether this intersection should be added to, or updated in, the warning manager
+   * Check whether this intersection should be added to the candidates
    *
    * @param airspace Airspace corresponding to current intersection
    */
@@ -199,47 +277,30 @@ public:
     if (!airspace.IsActive())
       return; // ignore inactive airspaces completely
 
-    if (!warning_manager.GetConfig().IsClassEnabled(airspace.GetClass()) ||
+    if (!config.IsClassEnabled(airspace.GetClass()) ||
         ExcludeAltitude(airspace))
       return;
 
-    AirspaceWarning *warning = warning_manager.GetWarningPtr(airspace);
-    if (warning == nullptr || warning->IsStateAccepted(warning_state)) {
-
-      AirspaceInterceptSolution solution;
-
-      if (mode_inside) {
-        solution = airspace.Intercept(state, perf,
-                                      state.location, state.location);
-      } else {
-        solution = Intercept(airspace, state, perf);
-      }
-      if (!solution.IsValid())
-        return;
-      if (solution.elapsed_time > max_time)
-        return;
+    AirspaceInterceptSolution solution;
 
-      if (warning == nullptr)
-        warning = warning_manager.GetNewWarningPtr(std::move(airspace_ptr));
-
-      warning->UpdateSolution(warning_state, solution);
-      found = true;
+    if (mode_inside) {
+      solution = airspace.Intercept(state, perf,
+                                    state.location, state.location);
+    } else {
+      solution = Intercept(airspace, state, perf);
     }
+    if (!solution.IsValid())
+      return;
+    if (solution.elapsed_time > max_time)
+      return;
+
+    candidates.push_back({std::move(airspace_ptr), solution});
   }
 
   void Visit(ConstAirspacePtr as) noexcept override {
     Intersection(as);
   }
 
-  /**
-   * Determine whether intersections for this type were found (new or modified)
-   *
-   * @return True if intersections were found
-   */
-  bool Found() const {
-    return found;
-  }
-
   void SetMode(bool m) {
     mode_inside = m;
   }
@@ -254,12 +315,31 @@ private:
 };
 
 
-bool 
-AirspaceWarningManager::UpdatePredicted(const AircraftState& state, 
-                                        const GeoPoint &location_predicted,
-                                        const AirspaceAircraftPerformance &perf,
-                                        const AirspaceWarning::State warning_state,
-                                        const FloatDuration max_time) noexcept
+/**
+ * Calculate the radius around the aircraft (in projected units)
+ * beyond which no airspace can be reached within the specified
+ * distance.
+ */
+[[gnu::pure]]
+static double
+GetInterceptHorizon(const FlatProjection &projection,
+                    const GeoPoint &location, double distance) noexcept
+{
+  /* north of the projection center, projected longitude differences
+     exceed the real ones; allow for that and for the rounding of the
+     bounding boxes */
+  const double shrink =
+    std::min(location.latitude.fastcosine() /
+             projection.GetCenter().latitude.fastcosine(), 1.);
+  return projection.ProjectRangeFloat(location, distance) / shrink + 2;
+}
+
+void
+AirspaceWarningManager::PredictIntersecting(const AircraftState& state,
+                                            const GeoPoint &location_predicted,
+                                            const AirspaceAircraftPerformance &perf,
+                                            const FloatDuration max_time,
+                                            Prediction &prediction) const noexcept
 {
   // this is the time limit of intrusions, beyond which we are not interested.
   // it can be the minimum of the user set warning time, or the time of the 
@@ -279,40 +359,58 @@ AirspaceWarningManager::UpdatePredicted(const AircraftState& state,
   const auto ceiling = state.altitude
     + std::max((unsigned)1000, config.altitude_warning_margin);
 
-  AirspaceIntersectionWarningVisitor visitor(state, perf, 
-                                             *this, 
-                                             warning_state, max_time_limit,
-                                             ceiling);
+  AirspaceIntersectionWarningVisitor visitor(state, perf, config,
+                                             prediction.candidates,
+                                             max_time_limit, ceiling);
+
+  /* no intercept can be earlier than the cruise time to the
+     airspace's bounding box; this rejects far candidates without
+     calculating their intersections */
+  const FlatProjection &projection = airspaces.GetProjection();
+  const FlatGeoPoint flat_location = projection.ProjectInteger(state.location);
+  const double horizon = perf.GetCruiseSpeed() > 0
+    ? GetInterceptHorizon(projection, state.location,
+                          perf.GetCruiseSpeed() * max_time_limit.count())
+    : -1;
+
+  for (const auto &i : airspaces.QueryIntersecting(state.location,
+                                                   location_predicted)) {
+    if (horizon >= 0 &&
+        i.SquareDistanceTo(flat_location) > Square(horizon))
+      continue;
 
-  airspaces.VisitIntersecting(state.location, location_predicted, visitor);
+    if (visitor.SetIntersections(i.Intersects(state.location,
+                                              location_predicted,
+                                              projection)))
+      visitor.Visit(i.GetAirspacePtr());
+  }
 
   visitor.SetMode(true);
 
   for (const auto &i : airspaces.QueryInside(state.location)) {
     visitor.Visit(i.GetAirspacePtr());
   }
-
-  return visitor.Found();
 }
 
 
-bool 
-AirspaceWarningManager::UpdateTask(const AircraftState &state,
-                                   const GlidePolar &glide_polar,
-                                   const TaskStats &task_stats)
+void
+AirspaceWarningManager::PredictTask(const AircraftState &state,
+                                    const GlidePolar &glide_polar,
+                                    const TaskStats &task_stats,
+                                    Prediction &prediction) const noexcept
 {
   if (!glide_polar.IsValid())
-    return false;
+    return;
 
   const ElementStat &current_leg = task_stats.current_leg;
 
   if (!task_stats.task_valid || !current_leg.location_remaining.IsValid())
-    return false;
+    return;
 
   const GlideResult &solution = current_leg.solution_remaining;
   if (!solution.IsOk() || !solution.IsAchievable())
     /* glide solver failed, cannot continue */
-    return false;
+    return;
 
   const AirspaceAircraftPerformance perf_task(glide_polar,
                                               current_leg.solution_remaining);
@@ -326,60 +424,57 @@ AirspaceWarningManager::UpdateTask(const AircraftState &state,
        the configured warning time */
     location_tp = state.location.IntermediatePoint(location_tp, max_distance);
 
-  return UpdatePredicted(state, location_tp, perf_task,
-                          AirspaceWarning::WARNING_TASK, time_remaining);
+  PredictIntersecting(state, location_tp, perf_task, time_remaining,
+                      prediction);
 }
 
 
-bool 
-AirspaceWarningManager::UpdateFilter(const AircraftState& state, const bool circling)
+void
+AirspaceWarningManager::PredictFilter(const AircraftState& state,
+                                      const bool circling,
+                                      Prediction &prediction) const noexcept
 {
-  // update both filters even though we are using only one
-  cruise_filter.Update(state);
-  circling_filter.Update(state);
+  const AircraftStateFilter &filter = circling
+    ? circling_filter
+    : cruise_filter;
 
-  const GeoPoint location_predicted = circling?
-    circling_filter.GetPredictedState(prediction_time_filter).location:
-    cruise_filter.GetPredictedState(prediction_time_filter).location;
+  const GeoPoint location_predicted =
+    filter.GetPredictedState(prediction_time_filter).location;
 
-  if (circling) 
-    return UpdatePredicted(state, location_predicted,
-                           AirspaceAircraftPerformance(circling_filter),
-                            AirspaceWarning::WARNING_FILTER, prediction_time_filter);
-  else
-    return UpdatePredicted(state, location_predicted,
-                           AirspaceAircraftPerformance(cruise_filter),
-                            AirspaceWarning::WARNING_FILTER, prediction_time_filter);
+  PredictIntersecting(state, location_predicted,
+                      AirspaceAircraftPerformance(filter),
+                      prediction_time_filter, prediction);
 }
 
 
-bool 
-AirspaceWarningManager::UpdateGlide(const AircraftState &state,
-                                    const GlidePolar &glide_polar)
+void
+AirspaceWarningManager::PredictGlide(const AircraftState &state,
+                                     const GlidePolar &glide_polar,
+                                     Prediction &prediction) const noexcept
 {
   if (!glide_polar.IsValid())
-    return false;
+    return;
 
   const GeoPoint location_predicted = 
     state.GetPredictedState(prediction_time_glide).location;
 
   const AirspaceAircraftPerformance perf_glide(glide_polar);
-  return UpdatePredicted(state, location_predicted,
-                          perf_glide,
-                          AirspaceWarning::WARNING_GLIDE, prediction_time_glide);
+  PredictIntersecting(state, location_predicted, perf_glide,
+                      prediction_time_glide, prediction);
 }
 
-bool
-AirspaceWarningManager::UpdateInside(const AircraftState& state,
-                                     const GlidePolar &glide_polar)
+void
+AirspaceWarningManager::PredictInside(const AircraftState& state,
+                                      const GlidePolar &glide_polar,
+                                      Prediction &prediction) const noexcept
 {
   if (!glide_polar.IsValid())
-    return false;
+    return;
 
-  bool found = false;
+  const AirspaceAircraftPerformance perf_glide(glide_polar);
 
   for (const auto &i : airspaces.QueryInside(state.location)) {
-    const auto airspace = i.GetAirspacePtr();
+    auto airspace = i.GetAirspacePtr();
 
     const AltitudeState &altitude = state;
     if (// ignore inactive airspaces
@@ -388,24 +483,12 @@ AirspaceWarningManager::UpdateInside(const AircraftState& state,
         !airspace->Inside(altitude))
       continue;
 
-    AirspaceWarning *warning = GetWarningPtr(*airspace);
+    GeoPoint c = airspace->ClosestPoint(state.location, GetProjection());
+    const AirspaceInterceptSolution solution =
+      airspace->Intercept(state, c, GetProjection(), perf_glide);
 
-    if (warning == nullptr ||
-        warning->IsStateAccepted(AirspaceWarning::WARNING_INSIDE)) {
-      GeoPoint c = airspace->ClosestPoint(state.location, GetProjection());
-      const AirspaceAircraftPerformance perf_glide(glide_polar);
-      const AirspaceInterceptSolution solution =
-        airspace->Intercept(state, c, GetProjection(), perf_glide);
-
-      if (warning == nullptr)
-        warning = GetNewWarningPtr(airspace);
-
-      warning->UpdateSolution(AirspaceWarning::WARNING_INSIDE, solution);
-      found = true;
-    }
+    prediction.candidates.push_back({std::move(airspace), solution});
   }
-
-  return found;
 }
 
 void
@@ -9,6 +9,8 @@
 #include "time/FloatDuration.hxx"
 #include "util/Serial.hpp"
 
+#include <cstddef>
+#include <functional>
 #include <list>
 
 class TaskStats;
@@ -29,6 +31,16 @@ class AirspaceAircraftPerformance;
  *
  */
 class AirspaceWarningManager {
+public:
+  /**
+   * A function which invokes f(i) for each i in [0, n) and returns
+   * after all calls have finished.  The calls may run concurrently.
+   */
+  using ForEachFunction =
+    std::function<void(std::size_t n,
+                       const std::function<void(std::size_t)> &f)>;
+
+private:
   AirspaceWarningConfig config;
 
   const Airspaces &airspaces;
@@ -48,6 +60,18 @@ class AirspaceWarningManager {
    */
   Serial serial;
 
+  /**
+   * Runs the independent warning predictions in Update().  If this
+   * is empty, they run one after another in the calling thread.
+   */
+  ForEachFunction for_each;
+
+  /**
+   * The result of one warning prediction, collected without
+   * modifying the warning list; see Apply().
+   */
+  struct Prediction;
+
 public:
   using const_iterator = AirspaceWarningList::const_iterator;
 
@@ -72,6 +96,16 @@ public:
 
   void SetConfig(const AirspaceWarningConfig &_config);
 
+  /**
+   * Install a function which runs the warning predictions of
+   * Update(), e.g. on a #ThreadPool.  The results do not depend on
+   * it: they are always merged into the warning list in the same
+   * order.
+   */
+  void SetForEach(ForEachFunction &&_for_each) noexcept {
+    for_each = std::move(_for_each);
+  }
+
   /**
    * Returns a serial for the current state.  The serial gets
    * incremented each time the a warning or the list of warnings is
@@ -245,15 +279,24 @@ public:
   bool IsActive(const AbstractAirspace &airspace) const noexcept;
 
 private:
-  bool UpdateTask(const AircraftState &state, const GlidePolar &glide_polar,
-                  const TaskStats &task_stats);
-  bool UpdateFilter(const AircraftState& state, const bool circling);
-  bool UpdateGlide(const AircraftState& state, const GlidePolar &glide_polar);
-  bool UpdateInside(const AircraftState& state, const GlidePolar &glide_polar);
-
-  bool UpdatePredicted(const AircraftState& state, 
-                       const GeoPoint &location_predicted,
-                       const AirspaceAircraftPerformance &perf,
-                       const AirspaceWarning::State warning_state,
-                       FloatDuration max_time) noexcept;
+  void PredictTask(const AircraftState &state, const GlidePolar &glide_polar,
+                   const TaskStats &task_stats,
+                   Prediction &prediction) const noexcept;
+  void PredictFilter(const AircraftState &state, bool circling,
+                     Prediction &prediction) const noexcept;
+  void PredictGlide(const AircraftState &state, const GlidePolar &glide_polar,
+                    Prediction &prediction) const noexcept;
+  void PredictInside(const AircraftState &state, const GlidePolar &glide_polar,
+                     Prediction &prediction) const noexcept;
+
+  void PredictIntersecting(const AircraftState &state,
+                           const GeoPoint &location_predicted,
+                           const AirspaceAircraftPerformance &perf,
+                           FloatDuration max_time,
+                           Prediction &prediction) const noexcept;
+
+  /**
+   * Merge a prediction into the warning list.
+   */
+  void Apply(const Prediction &prediction) noexcept;
 };
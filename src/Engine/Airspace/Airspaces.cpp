@@ -11,6 +11,8 @@
 #include <boost/geometry/strategies/strategies.hpp>
 #include <boost/geometry/geometries/segment.hpp>
 
+#include <algorithm>
+
 namespace bgi = boost::geometry::index;
 
 Airspaces::~Airspaces() noexcept = default;
@@ -83,9 +85,26 @@ Airspaces::Optimise() noexcept
     airspace_tree.clear();
   }
 
-  for (auto &i : tmp_as) {
-    Airspace as(std::move(i), task_projection);
-    airspace_tree.insert(as);
+  if (tmp_as.size() >= airspace_tree.size()) {
+    /* many new airspaces (e.g. after a file has been loaded): build a
+       new tree with the packing algorithm in one step; this is much
+       faster than inserting them one by one, and the resulting tree
+       is better balanced */
+    std::vector<Airspace> values;
+    values.reserve(airspace_tree.size() + tmp_as.size());
+
+    for (const auto &i : QueryAll())
+      values.push_back(i);
+
+    for (auto &i : tmp_as)
+      values.emplace_back(std::move(i), task_projection);
+
+    airspace_tree = AirspaceTree(values.begin(), values.end());
+  } else {
+    for (auto &i : tmp_as) {
+      Airspace as(std::move(i), task_projection);
+      airspace_tree.insert(as);
+    }
   }
 
   tmp_as.clear();
@@ -167,20 +186,22 @@ Airspaces::ClearClearances() noexcept
     v.ClearClearance();
 }
 
+/**
+ * Order #Airspace objects by the address of their #AbstractAirspace.
+ */
 [[gnu::pure]]
 static bool
-AirspacePointersEquals(const Airspace &a, const Airspace &b) noexcept
+AirspacePointerLess(const Airspace &a, const Airspace &b) noexcept
 {
-  return &a.GetAirspace() == &b.GetAirspace();
+  return &a.GetAirspace() < &b.GetAirspace();
 }
 
 [[gnu::pure]]
 static bool
-CompareAirspaceVectors(const AirspacesInterface::AirspaceVector &a,
-                       const AirspacesInterface::AirspaceVector &b) noexcept
+SameBoundingBox(const FlatBoundingBox &a, const FlatBoundingBox &b) noexcept
 {
-  return a.size() == b.size() &&
-    std::is_permutation(a.begin(), a.end(), b.begin(), AirspacePointersEquals);
+  return a.GetLowerLeft() == b.GetLowerLeft() &&
+    a.GetUpperRight() == b.GetUpperRight();
 }
 
 inline AirspacesInterface::AirspaceVector
@@ -210,15 +231,59 @@ Airspaces::SynchroniseInRange(const Airspaces &master,
     if (condition(i.GetAirspace()))
       contents_master.push_back(i);
 
-  if (CompareAirspaceVectors(contents_master, AsVector()))
-    return false;
+  if (airspace_tree.empty()) {
+    if (contents_master.empty())
+      return false;
 
-  for (auto &i : QueryAll())
-    i.ClearClearance();
-  airspace_tree.clear();
+    /* initial copy: bulk-load the tree */
+    airspace_tree = AirspaceTree(contents_master.begin(),
+                                 contents_master.end());
+    ++serial;
+    return true;
+  }
+
+  auto contents_local = AsVector();
+
+  /* merge both sorted lists, inserting and removing only the
+     difference; the airspaces which stay keep their clearance
+     polygons */
+  std::sort(contents_master.begin(), contents_master.end(),
+            AirspacePointerLess);
+  std::sort(contents_local.begin(), contents_local.end(),
+            AirspacePointerLess);
+
+  bool changed = false;
+
+  auto m = contents_master.begin();
+  const auto m_end = contents_master.end();
+  auto l = contents_local.begin();
+  const auto l_end = contents_local.end();
+
+  while (m != m_end || l != l_end) {
+    if (l == l_end || (m != m_end && AirspacePointerLess(*m, *l))) {
+      /* entered the range */
+      airspace_tree.insert(*m++);
+      changed = true;
+    } else if (m == m_end || AirspacePointerLess(*l, *m)) {
+      /* left the range */
+      l->ClearClearance();
+      airspace_tree.remove(*l++);
+      changed = true;
+    } else {
+      if (!SameBoundingBox(*l, *m)) {
+        /* the master has been projected again */
+        airspace_tree.remove(*l);
+        airspace_tree.insert(*m);
+        changed = true;
+      }
 
-  for (const auto &i : contents_master)
-    airspace_tree.insert(i);
+      ++m;
+      ++l;
+    }
+  }
+
+  if (!changed)
+    return false;
 
   ++serial;
 
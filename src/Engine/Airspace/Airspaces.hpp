@@ -66,6 +66,8 @@ public:
    * Re-organise the internal airspace tree after inserting/deleting.
    * Should be called after inserting/deleting airspaces prior to performing
    * any searches, but can be done once after a batch insert/delete.
+   * A large batch is bulk-loaded into a new tree, which is much faster
+   * than inserting the airspaces one by one.
    */
   void Optimise() noexcept;
 
@@ -185,7 +187,10 @@ public:
   void ClearClearances() noexcept;
 
   /**
-   * Copy/delete objects in this database based on query of master
+   * Copy/delete objects in this database based on query of master.
+   * Only the airspaces which have entered or left the range are
+   * inserted or removed, and #serial is only incremented if there
+   * was such a change.
    *
    * @param master Airspaces object to copy from
    * @param location location of aircraft, from which to search
@@ -4,17 +4,32 @@
 #include "Airspaces.hpp"
 #include "Terrain/RasterTerrain.hpp"
 
+#include <vector>
+
 void
 Airspaces::SetGroundLevels(const RasterTerrain &terrain) noexcept
 {
+  std::vector<const Airspace *> targets;
+  std::vector<GeoPoint> locations;
+
   for (auto &v : QueryAll()) {
     // If we don't need the ground level we don't have to calculate it
     if (!v.NeedGroundLevel())
       continue;
 
     FlatGeoPoint c_flat = v.GetCenter();
-    GeoPoint g = task_projection.Unproject(c_flat);
-    v.SetGroundLevel(terrain.GetTerrainHeight(g).GetValueOr0());
+    targets.push_back(&v);
+    locations.push_back(task_projection.Unproject(c_flat));
   }
-}
 
+  if (targets.empty())
+    return;
+
+  /* one bulk lookup, grouped by terrain tile, instead of one locked
+     lookup per airspace */
+  std::vector<TerrainHeight> heights(locations.size());
+  terrain.GetTerrainHeights(locations, heights);
+
+  for (std::size_t i = 0; i < targets.size(); ++i)
+    targets[i]->SetGroundLevel(heights[i].GetValueOr0());
+}
@@ -3,6 +3,8 @@
 
 #include "ContestManager.hpp"
 
+#include <algorithm>
+
 ContestManager::ContestManager(const Contest _contest,
                                const Trace &trace_full,
                                const Trace &trace_triangle,
@@ -140,6 +142,30 @@ RunContest(AbstractContest &_contest,
   return true;
 }
 
+bool
+ContestManager::Run(std::initializer_list<Job> jobs, bool exhaustive) noexcept
+{
+  if (!for_each || jobs.size() < 2) {
+    bool retval = false;
+    for (const auto &job : jobs)
+      retval |= RunContest(job.solver, stats.result[job.index],
+                           stats.solution[job.index], exhaustive);
+    return retval;
+  }
+
+  /* the solvers only read the traces, and each one writes only its
+     own slot of #stats */
+  bool found[ContestStatistics::N]{};
+  for_each(jobs.size(), [&](std::size_t i){
+    const Job &job = jobs.begin()[i];
+    found[i] = RunContest(job.solver, stats.result[job.index],
+                          stats.solution[job.index], exhaustive);
+  });
+
+  return std::any_of(found, found + jobs.size(),
+                     [](bool b){ return b; });
+}
+
 bool
 ContestManager::UpdateIdle(bool exhaustive) noexcept
 {
@@ -175,11 +201,7 @@ ContestManager::UpdateIdle(bool exhaustive) noexcept
     break;
 
   case Contest::OLC_PLUS:
-    retval = RunContest(olc_classic, stats.result[0],
-                        stats.solution[0], exhaustive);
-
-    retval |= RunContest(olc_fai, stats.result[1],
-                         stats.solution[1], exhaustive);
+    retval = Run({{olc_classic, 0}, {olc_fai, 1}}, exhaustive);
 
     if (retval) {
       olc_plus.Feed(stats.result[0], stats.solution[0],
@@ -197,17 +219,11 @@ ContestManager::UpdateIdle(bool exhaustive) noexcept
     break;
 
   case Contest::XCONTEST:
-    retval = RunContest(xcontest_free, stats.result[0],
-                        stats.solution[0], exhaustive);
-    retval |= RunContest(xcontest_triangle, stats.result[1],
-                         stats.solution[1], exhaustive);
+    retval = Run({{xcontest_free, 0}, {xcontest_triangle, 1}}, exhaustive);
     break;
 
   case Contest::DHV_XC:
-    retval = RunContest(dhv_xc_free, stats.result[0],
-                        stats.solution[0], exhaustive);
-    retval |= RunContest(dhv_xc_triangle, stats.result[1],
-                         stats.solution[1], exhaustive);
+    retval = Run({{dhv_xc_free, 0}, {dhv_xc_triangle, 1}}, exhaustive);
     break;
 
   case Contest::SIS_AT:
@@ -221,14 +237,8 @@ ContestManager::UpdateIdle(bool exhaustive) noexcept
     break;
 
   case Contest::WEGLIDE_FREE:
-    retval = RunContest(weglide_distance, stats.result[0],
-                        stats.solution[0], exhaustive);
-
-    retval |= RunContest(weglide_fai, stats.result[1],
-                         stats.solution[1], exhaustive);
-
-    retval |= RunContest(weglide_or, stats.result[2],
-                         stats.solution[2], exhaustive);
+    retval = Run({{weglide_distance, 0}, {weglide_fai, 1}, {weglide_or, 2}},
+                 exhaustive);
 
     if (retval) {
       weglide_free.Feed(stats.result[0], stats.solution[0],
@@ -294,6 +304,91 @@ ContestManager::Reset() noexcept
   charron_large.Reset();
 }
 
+void
+ContestManager::Restore(const ContestStatistics &_stats) noexcept
+{
+  stats = _stats;
+
+  const auto restore = [this](AbstractContest &solver, unsigned index){
+    solver.Restore(stats.result[index], stats.solution[index]);
+  };
+
+  switch (contest) {
+  case Contest::NONE:
+    break;
+
+  case Contest::OLC_SPRINT:
+    restore(olc_sprint, 0);
+    break;
+
+  case Contest::OLC_FAI:
+    restore(olc_fai, 0);
+    break;
+
+  case Contest::OLC_CLASSIC:
+    restore(olc_classic, 0);
+    break;
+
+  case Contest::OLC_LEAGUE:
+    restore(olc_league, 0);
+    restore(olc_classic, 1);
+    break;
+
+  case Contest::OLC_PLUS:
+    restore(olc_classic, 0);
+    restore(olc_fai, 1);
+    restore(olc_plus, 2);
+    break;
+
+  case Contest::DMST:
+    restore(dmst_quad, 0);
+    break;
+
+  case Contest::XCONTEST:
+    restore(xcontest_free, 0);
+    restore(xcontest_triangle, 1);
+    break;
+
+  case Contest::DHV_XC:
+    restore(dhv_xc_free, 0);
+    restore(dhv_xc_triangle, 1);
+    break;
+
+  case Contest::SIS_AT:
+    restore(sis_at, 0);
+    break;
+
+  case Contest::NET_COUPE:
+    restore(net_coupe, 0);
+    break;
+
+  case Contest::WEGLIDE_FREE:
+    restore(weglide_distance, 0);
+    restore(weglide_fai, 1);
+    restore(weglide_or, 2);
+    restore(weglide_free, 3);
+    break;
+
+  case Contest::WEGLIDE_DISTANCE:
+    restore(weglide_distance, 0);
+    break;
+
+  case Contest::WEGLIDE_FAI:
+    restore(weglide_fai, 0);
+    break;
+
+  case Contest::WEGLIDE_OR:
+    restore(weglide_or, 0);
+    break;
+
+  case Contest::CHARRON:
+    /* both write to the same slot */
+    restore(charron_large, 0);
+    restore(charron_small, 0);
+    break;
+  }
+}
+
 /*
 
 - SearchPointVector find self intersections (for OLC-FAI)
@@ -21,6 +21,9 @@
 #include "Solvers/Charron.hpp"
 #include "ContestStatistics.hpp"
 
+#include <functional>
+#include <initializer_list>
+
 class Trace;
 
 /**
@@ -30,8 +33,24 @@ class ContestManager
 {
   friend class PrintHelper;
 
+public:
+  /**
+   * A function which invokes f(i) for each i in [0, n) and returns
+   * after all calls have finished.  The calls may run concurrently.
+   */
+  using ForEachFunction =
+    std::function<void(std::size_t n,
+                       const std::function<void(std::size_t)> &f)>;
+
+private:
   Contest contest;
 
+  /**
+   * See SetForEach(); if empty, all solvers run in the calling
+   * thread.
+   */
+  ForEachFunction for_each;
+
   ContestStatistics stats;
 
   OLCSprint olc_sprint;
@@ -87,6 +106,16 @@ public:
 
   void SetHandicap(unsigned handicap) noexcept;
 
+  /**
+   * Install a function which runs the independent solvers of a
+   * contest (e.g. OLC Classic and OLC FAI for OLC Plus) in
+   * parallel, e.g. on a #ThreadPool.  The result does not depend on
+   * it.  The traces must not be modified during UpdateIdle().
+   */
+  void SetForEach(ForEachFunction &&_for_each) noexcept {
+    for_each = std::move(_for_each);
+  }
+
   /**
    * Update internal states (non-essential) for housework,
    * or where functions are slow and would cause loss to real-time performance.
@@ -121,7 +150,32 @@ public:
    */
   void Reset() noexcept;
 
+  /**
+   * Resume from the given statistics of the current contest (e.g.
+   * saved in a checkpoint before the program was restarted).  The
+   * solvers keep these results until they find better ones, so the
+   * search only needs to refine them.
+   */
+  void Restore(const ContestStatistics &_stats) noexcept;
+
   const ContestStatistics &GetStats() const noexcept {
     return stats;
   }
+
+private:
+  /**
+   * A solver and the slot of #stats it writes to.
+   */
+  struct Job {
+    AbstractContest &solver;
+    unsigned index;
+  };
+
+  /**
+   * Run the given solvers (which must use different #stats
+   * slots), in parallel if a #for_each function was installed.
+   *
+   * @return true if at least one of them found an improved solution
+   */
+  bool Run(std::initializer_list<Job> jobs, bool exhaustive) noexcept;
 };
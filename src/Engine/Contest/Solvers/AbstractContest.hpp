@@ -52,6 +52,17 @@ public:
     return best_solution;
   }
 
+  /**
+   * Start with the given solution (e.g. one that was found before
+   * the program was restarted), as if this solver had found it.
+   * Only a better solution will replace it.
+   */
+  void Restore(const ContestResult &result,
+               const ContestTraceVector &solution) noexcept {
+    best_result = result;
+    best_solution = solution;
+  }
+
 protected:
   /**
    * Calculate the result.
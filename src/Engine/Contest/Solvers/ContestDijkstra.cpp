@@ -5,6 +5,7 @@
 #include "../ContestResult.hpp"
 #include "Trace/Trace.hpp"
 #include "Cast.hpp"
+#include "util/Compiler.h"
 
 #include <algorithm>
 #include <cassert>
@@ -220,22 +221,31 @@ ContestDijkstra::AddEdges(const ScanTaskPoint origin,
     destination.SetPointIndex(first_finish_candidate);
 
   const auto &origin_tp = GetPoint(origin);
+  const FlatGeoPoint origin_flat = origin_tp.GetFlatLocation();
   const unsigned weight = GetStageWeight(origin.GetStageNumber());
 
+  /* read the contiguous arrays instead of the TracePoint objects */
+  const int *const xs = snapshot.GetX(), *const ys = snapshot.GetY();
+  const int *const altitudes = snapshot.GetAltitude();
+
+  /* the distances from the origin are shared by all stages */
+  const unsigned *const distances =
+    snapshot.GetDistanceRow(origin.GetPointIndex());
+
   bool previous_above = false;
   for (const ScanTaskPoint end(destination.GetStageNumber(), n_points);
        destination != end; destination.IncrementPointIndex()) {
-    const auto destination_tp = GetPoint(destination);
-    const bool above = destination_tp.GetIntegerAltitude() >= min_altitude;
+    const unsigned i = destination.GetPointIndex();
+    const bool above = altitudes[i] >= min_altitude;
 
     /* Check if the distance is withing the minimum distance.
        Also allows zero distance legs, because if a minimum distance is set not
        all solutions will use all legs. */
-    if (origin_tp.GetFlatLocation() == destination_tp.GetFlatLocation() ||
+    if ((xs[i] == origin_flat.x && ys[i] == origin_flat.y) ||
         CheckMinDistance(origin_tp.GetLocation(),
-                         destination_tp.GetLocation())) {
+                         GetPoint(destination).GetLocation())) {
       if (above) {
-        const value_type d = weight * CalcEdgeDistance(origin, destination);
+        const value_type d = weight * distances[i - origin.GetPointIndex()];
         Link(destination, origin, d);
       } else if (previous_above) {
         /* After excessive thinning, the exact TracePoint that matches
@@ -245,7 +255,7 @@ ContestDijkstra::AddEdges(const ScanTaskPoint origin,
            matches. */
 
         /* TODO: interpolate the distance */
-        const value_type d = weight * CalcEdgeDistance(origin, destination);
+        const value_type d = weight * distances[i - origin.GetPointIndex()];
         Link(destination, origin, d);
       }
     }
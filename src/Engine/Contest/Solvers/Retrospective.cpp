@@ -4,6 +4,7 @@
 #include "Retrospective.hpp"
 #include "Waypoint/Waypoints.hpp"
 #include "Engine/Waypoint/Waypoint.hpp"
+#include "Geo/Flat/TaskProjection.hpp"
 
 inline
 Retrospective::NearWaypoint::NearWaypoint(WaypointPtr &&_waypoint,
@@ -93,6 +94,59 @@ Retrospective::CalcDistances(double &d_ach, double &d_can) noexcept
   // last leg part actual_in should be distance from previous to current ac location
 }
 
+WaypointPtr
+Retrospective::LookupNearby(const GeoPoint &location) noexcept
+{
+  if (!nearby_center.IsValid() || nearby_serial != waypoints.GetSerial() ||
+      nearby_range != search_range ||
+      location.DistanceS(nearby_center) > search_range / 2) {
+    /* the aircraft has left the area covered by the list: visit the
+       quad tree once for the new area */
+    nearby.clear();
+    nearby_center = location;
+    nearby_serial = waypoints.GetSerial();
+    nearby_range = search_range;
+    waypoints.VisitWithinRange(location, 2 * search_range,
+                               [this](const WaypointPtr &wp){
+                                 nearby.push_back(wp);
+                               });
+  }
+
+  /* find the nearest one in the same (flat) metric as
+     Waypoints::GetNearest(); the flat grid is coarse, so ties are
+     resolved by the real distance instead of the quad tree's
+     (arbitrary) bucket order */
+  const auto &projection = waypoints.GetProjection();
+  const FlatGeoPoint flat_location = projection.ProjectInteger(location);
+  const unsigned range = projection.ProjectRangeInteger(location,
+                                                        search_range);
+
+  const WaypointPtr *nearest = nullptr;
+  unsigned nearest_square_distance = range * range;
+  for (const auto &wp : nearby) {
+    const unsigned square_distance =
+      wp->flat_location.DistanceSquared(flat_location);
+    if (square_distance < nearest_square_distance ||
+        (square_distance == nearest_square_distance &&
+         (nearest == nullptr ||
+          wp->location.DistanceS(location) <
+          (*nearest)->location.DistanceS(location)))) {
+      nearest = &wp;
+      nearest_square_distance = square_distance;
+    }
+  }
+
+  if (nearest == nullptr)
+    return nullptr;
+
+  const Waypoint &wp = **nearest;
+  if (wp.location == location ||
+      (search_range > 0 && wp.IsCloseTo(location, search_range)))
+    return *nearest;
+
+  return nullptr;
+}
+
 bool
 Retrospective::UpdateSample(const GeoPoint &aircraft_location) noexcept
 {
@@ -105,7 +159,7 @@ Retrospective::UpdateSample(const GeoPoint &aircraft_location) noexcept
 
   // retrospective task
 
-  auto waypoint = waypoints.LookupLocation(aircraft_location, search_range);
+  auto waypoint = LookupNearby(aircraft_location);
   // TODO actually need to find *all* in search range!
 
   // ignore if none found in search box
@@ -6,8 +6,10 @@
 #include "Geo/GeoPoint.hpp"
 #include "Engine/Waypoint/Ptr.hpp"
 #include "Math/Angle.hpp"
+#include "util/Serial.hpp"
 
 #include <list>
+#include <vector>
 
 class Waypoints;
 
@@ -39,6 +41,23 @@ protected:
 
   NearWaypointList candidate_list;
 
+  /**
+   * The waypoints within twice the #search_range around
+   * #nearby_center.  While the aircraft stays within half the
+   * #search_range of that center, the nearest waypoint is searched in
+   * this small list instead of the #Waypoints quad tree.
+   */
+  std::vector<WaypointPtr> nearby;
+
+  GeoPoint nearby_center = GeoPoint::Invalid();
+
+  /**
+   * The Waypoints::GetSerial() and the #search_range when #nearby
+   * was filled.
+   */
+  Serial nearby_serial;
+  double nearby_range;
+
   void PruneCandidates() noexcept;
 
 public:
@@ -47,6 +66,14 @@ public:
   }
 
   bool UpdateSample(const GeoPoint &aircraft_location) noexcept;
+
+  /**
+   * Like Waypoints::LookupLocation(location, #search_range), but
+   * uses (and updates) #nearby.  Of several waypoints at the same
+   * flat distance, the one nearest to the location wins.
+   */
+  WaypointPtr LookupNearby(const GeoPoint &location) noexcept;
+
   void Clear() noexcept;
   void Reset() noexcept {
     Clear();
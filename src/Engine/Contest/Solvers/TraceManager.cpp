@@ -77,6 +77,7 @@ TraceManager::ClearTrace() noexcept
   append_serial = modify_serial = Serial();
   trace_dirty = true;
   trace.clear();
+  snapshot.clear();
   n_points = 0;
   predicted = TracePoint::Invalid();
 }
@@ -88,6 +89,9 @@ TraceManager::UpdateTraceFull() noexcept
   trace_master.GetPoints(trace);
   n_points = trace.size();
 
+  snapshot.clear();
+  snapshot.Update(trace);
+
   if (n_points > 0 && predicted.IsDefined())
     predicted.Project(trace_master.GetProjection());
 
@@ -109,6 +113,7 @@ TraceManager::UpdateTraceTail() noexcept
     return false;
 
   n_points = trace.size();
+  snapshot.Update(trace);
 
   if (n_points > 0 && predicted.IsDefined())
     predicted.Project(trace_master.GetProjection());
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "TraceSnapshot.hpp"
 #include "util/Serial.hpp"
 #include "Trace/Trace.hpp"
 #include "Trace/Vector.hpp"
@@ -35,6 +36,12 @@ protected:
    */
   TracePointerVector trace;
 
+  /**
+   * A contiguous copy of #trace for the inner loops of the solvers.
+   * It is updated together with #trace.
+   */
+  TraceSnapshot snapshot;
+
   /** Number of points in current trace set */
   unsigned n_points;
 
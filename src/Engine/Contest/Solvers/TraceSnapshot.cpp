@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TraceSnapshot.hpp"
+#include "Trace/Vector.hpp"
+
+void
+TraceSnapshot::Update(const TracePointerVector &trace) noexcept
+{
+  assert(trace.size() >= size());
+
+  if (size() == 0) {
+    /* the distance matrix is laid out for the whole trace */
+    const std::size_t capacity = trace.capacity();
+    row_capacity = capacity <= MAX_CACHED_POINTS ? capacity : 0;
+  }
+
+  x.reserve(trace.capacity());
+  y.reserve(trace.capacity());
+  time.reserve(trace.capacity());
+  altitude.reserve(trace.capacity());
+
+  for (auto i = std::next(trace.begin(), size()); i != trace.end(); ++i) {
+    const TracePoint &point = **i;
+    const FlatGeoPoint &flat = point.GetFlatLocation();
+    x.push_back(flat.x);
+    y.push_back(flat.y);
+    time.push_back(point.GetTime().count());
+    altitude.push_back(point.GetIntegerAltitude());
+  }
+
+  if (size() > row_capacity)
+    /* the trace has outgrown the matrix */
+    row_capacity = 0;
+
+  row_sizes.resize(size());
+}
+
+inline void
+TraceSnapshot::FillRow(unsigned *row, std::size_t i,
+                       std::size_t begin, std::size_t end) const noexcept
+{
+  const int xi = x[i], yi = y[i];
+  for (std::size_t j = begin; j < end; ++j)
+    row[j - i] = ihypot(x[j] - xi, y[j] - yi);
+}
+
+const unsigned *
+TraceSnapshot::GetDistanceRow(std::size_t i) noexcept
+{
+  assert(i < size());
+
+  const std::size_t n = size();
+
+  if (row_capacity == 0) {
+    scratch_row.resize(n - i);
+    FillRow(scratch_row.data(), i, i, n);
+    return scratch_row.data();
+  }
+
+  if (distances.size() < GetRowOffset(row_capacity))
+    /* allocate the matrix on the first use */
+    distances.resize(GetRowOffset(row_capacity));
+
+  unsigned *const row = distances.data() + GetRowOffset(i);
+  if (row_sizes[i] < n - i) {
+    /* calculate the distances to the points which were added since
+       this row was last used */
+    FillRow(row, i, i + row_sizes[i], n);
+    row_sizes[i] = n - i;
+  }
+
+  return row;
+}
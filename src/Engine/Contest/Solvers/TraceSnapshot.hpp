@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Trace/Point.hpp"
+#include "Geo/Flat/FlatGeoPoint.hpp"
+#include "Math/FastMath.hpp"
+
+#include <cassert>
+#include <vector>
+
+class TracePointerVector;
+
+/**
+ * A contiguous copy of the #TracePoint attributes which the contest
+ * solvers read in their inner loops, stored as a structure of
+ * arrays.  Unlike a #TracePointerVector, iterating over it does not
+ * dereference pointers into the #Trace nodes.
+ */
+class TraceSnapshot {
+  std::vector<int> x, y;
+  std::vector<unsigned> time;
+  std::vector<int> altitude;
+
+  /**
+   * The flat distances from each point to all later points, stored
+   * as an upper triangular matrix: row i begins at GetRowOffset(i)
+   * and contains the distances to the points [i, #row_capacity).
+   * The rows are calculated lazily by GetDistanceRow() and are
+   * extended when points are appended, see #row_sizes.
+   *
+   * The Dijkstra solvers relax the same edges once for each stage;
+   * with this cache, each distance is calculated only once per
+   * snapshot.
+   */
+  std::vector<unsigned> distances;
+
+  /**
+   * The number of valid elements in each row of #distances.
+   */
+  std::vector<unsigned> row_sizes;
+
+  /**
+   * The capacity of #distances in points; zero if the cache is
+   * disabled (because the snapshot exceeds #MAX_CACHED_POINTS).
+   * Then GetDistanceRow() calculates into #scratch_row.
+   */
+  std::size_t row_capacity = 0;
+
+  std::vector<unsigned> scratch_row;
+
+public:
+  /**
+   * The maximum number of points for which the distance matrix is
+   * kept (2 MB for 1024 points).
+   */
+  static constexpr std::size_t MAX_CACHED_POINTS = 1024;
+
+  [[gnu::pure]]
+  std::size_t size() const noexcept {
+    return x.size();
+  }
+
+  void clear() noexcept {
+    x.clear();
+    y.clear();
+    time.clear();
+    altitude.clear();
+    row_sizes.clear();
+    row_capacity = 0;
+  }
+
+  /**
+   * Append the points of the given vector which are not yet in this
+   * snapshot.  The first size() elements must be the ones this
+   * snapshot was built from.
+   */
+  void Update(const TracePointerVector &trace) noexcept;
+
+  [[gnu::pure]]
+  const int *GetX() const noexcept {
+    return x.data();
+  }
+
+  [[gnu::pure]]
+  const int *GetY() const noexcept {
+    return y.data();
+  }
+
+  [[gnu::pure]]
+  const int *GetAltitude() const noexcept {
+    return altitude.data();
+  }
+
+  [[gnu::pure]]
+  FlatGeoPoint GetFlatLocation(std::size_t i) const noexcept {
+    assert(i < size());
+    return FlatGeoPoint(x[i], y[i]);
+  }
+
+  [[gnu::pure]]
+  TracePoint::Time GetTime(std::size_t i) const noexcept {
+    assert(i < size());
+    return TracePoint::Time{time[i]};
+  }
+
+  [[gnu::pure]]
+  int GetIntegerAltitude(std::size_t i) const noexcept {
+    assert(i < size());
+    return altitude[i];
+  }
+
+  /**
+   * Same as TracePoint::FlatDistanceTo().
+   */
+  [[gnu::pure]]
+  unsigned GetFlatDistance(std::size_t a, std::size_t b) const noexcept {
+    assert(a < size());
+    assert(b < size());
+    return ihypot(x[a] - x[b], y[a] - y[b]);
+  }
+
+  /**
+   * Returns the flat distances from the given point to the points
+   * [i, size()); element 0 is the point itself.  The pointer is
+   * valid until the snapshot or the row of another point is
+   * requested.
+   */
+  const unsigned *GetDistanceRow(std::size_t i) noexcept;
+
+private:
+  /**
+   * The offset of row i in #distances.
+   */
+  constexpr std::size_t GetRowOffset(std::size_t i) const noexcept {
+    return i * row_capacity - i * (i - 1) / 2;
+  }
+
+  void FillRow(unsigned *row, std::size_t i,
+               std::size_t begin, std::size_t end) const noexcept;
+};
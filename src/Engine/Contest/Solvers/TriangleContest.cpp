@@ -3,6 +3,7 @@
 
 #include "TriangleContest.hpp"
 #include "Cast.hpp"
+#include "util/Compiler.h"
 #include "Trace/Trace.hpp"
 #include "util/QuadTree.hxx"
 
@@ -116,6 +117,52 @@ TriangleContest::UpdateTrace(bool force) noexcept
    * the algorithm to finish in about 10 to 15 ticks in most cases.
    */
   tick_iterations = n_points * n_points / 8;
+
+  UpdateBoundingBoxes();
+}
+
+void
+TriangleContest::UpdateBoundingBoxes() noexcept
+{
+  unsigned n_levels = 1;
+  while ((2u << (n_levels - 1)) <= n_points)
+    ++n_levels;
+
+  bounding_boxes.resize(n_levels * n_points);
+
+  for (unsigned i = 0; i < n_points; ++i)
+    bounding_boxes[i] = FlatBoundingBox(snapshot.GetFlatLocation(i));
+
+  for (unsigned k = 1; k < n_levels; ++k) {
+    const unsigned half = 1u << (k - 1);
+    const FlatBoundingBox *previous = &bounding_boxes[(k - 1) * n_points];
+    FlatBoundingBox *level = &bounding_boxes[k * n_points];
+
+    for (unsigned i = 0; i + 2 * half <= n_points; ++i) {
+      level[i] = previous[i];
+      level[i].Expand(previous[i + half].GetLowerLeft());
+      level[i].Expand(previous[i + half].GetUpperRight());
+    }
+  }
+}
+
+FlatBoundingBox
+TriangleContest::GetBoundingBox(unsigned min, unsigned max) const noexcept
+{
+  assert(min < max);
+  assert(max <= n_points);
+  assert(bounding_boxes.size() >= n_points);
+
+  /* two overlapping power-of-two blocks cover the range */
+  unsigned k = 0;
+  while ((2u << k) <= max - min)
+    ++k;
+
+  const FlatBoundingBox *level = &bounding_boxes[k * n_points];
+  FlatBoundingBox box = level[min];
+  box.Expand(level[max - (1u << k)].GetLowerLeft());
+  box.Expand(level[max - (1u << k)].GetUpperRight());
+  return box;
 }
 
 SolverResult
@@ -11,6 +11,7 @@
 
 #include <map>
 #include <utility> // for std::swap()
+#include <vector>
 
 /**
  * Specialisation of AbstractContest for OLC Triangle (triangle) rules
@@ -120,6 +121,15 @@ private:
 
   ClosingPairs closing_pairs;
 
+  /**
+   * A sparse table of bounding boxes: level k contains the box around
+   * the 2^k points starting at each index.  This allows looking up
+   * the bounding box of any range in constant time; without it,
+   * creating a #TurnPointRange would have to visit all its points.
+   * It is rebuilt in UpdateTrace().
+   */
+  std::vector<FlatBoundingBox> bounding_boxes;
+
   struct Candidate {
     unsigned tp1, tp2, tp3;
     unsigned distance;
@@ -145,11 +155,7 @@ private:
     TurnPointRange(const TriangleContest &parent,
                    const unsigned min, const unsigned max) noexcept
       :index_min(min), index_max(max),
-       bounding_box(FlatBoundingBox(parent.GetPoint(min).GetFlatLocation()))
-    {
-      for (unsigned i = min + 1; i < max; ++i)
-        bounding_box.Expand(parent.GetPoint(i).GetFlatLocation());
-    }
+       bounding_box(parent.GetBoundingBox(min, max)) {}
 
     bool operator==(TurnPointRange other) const noexcept {
       return (index_min == other.index_min && index_max == other.index_max);
@@ -276,6 +282,15 @@ private:
   void UpdateTrace(bool force) noexcept override;
   void ResetBranchAndBound() noexcept;
 
+  void UpdateBoundingBoxes() noexcept;
+
+  /**
+   * Returns the bounding box of the trace points in the range
+   * [min, max).
+   */
+  [[gnu::pure]]
+  FlatBoundingBox GetBoundingBox(unsigned min, unsigned max) const noexcept;
+
   void CheckAddCandidate(unsigned worst_d,
                          const OLCTriangleValidator &validator,
                          CandidateSet candidate_set) noexcept {
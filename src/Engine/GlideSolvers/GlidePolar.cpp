@@ -242,6 +242,7 @@ GlidePolar::IsGlidePossible(const GlideState &task) const noexcept
   return true;
 }
 
+#if 0
 /**
  * Finds speed to fly for a given MacCready setting
  * Intended to be used temporarily.
@@ -301,14 +302,33 @@ public:
     return Vopt + m_head_wind;
   }
 };
+#endif
 
 double
 GlidePolar::SpeedToFly(const double stf_sink_rate,
                        const double head_wind) const noexcept
 {
   assert(IsValid());
+
+#if 0
+  // this method to be used if polar is not parabolic
   GlidePolarSpeedToFly gp_stf(*this, stf_sink_rate, head_wind, Vmin, Vmax);
   return gp_stf.solve(Vmax);
+#else
+  assert(polar.IsValid());
+
+  /* the sink rate per ground speed has a single minimum where
+     a*V^2 - 2*a*head_wind*V - (b*head_wind + c + mc + sink) = 0 */
+  const auto v_low = std::max(1. + head_wind, Vmin);
+
+  const auto s = head_wind * head_wind +
+    (mc + stf_sink_rate + polar.c + polar.b * head_wind) / polar.a;
+  if (s < 0)
+    /* increasing everywhere: fly as slow as possible */
+    return v_low;
+
+  return std::min(std::max(head_wind + sqrt(s), v_low), Vmax);
+#endif
 }
 
 double
@@ -439,6 +459,17 @@ GlidePolar::GetLDOverGround(const AircraftState &state) const noexcept
   return GetLDOverGround(state.track, state.wind);
 }
 
+double
+GlidePolar::GetMaxLDOverGround(double wind_speed) const noexcept
+{
+  assert(IsValid());
+
+  /* the best L/D in still air is at MC=0; the wind adds at most its
+     speed to the ground speed, and the sink rate is at least Smin */
+  const auto v = sqrt(polar.c / polar.a);
+  return v / SinkRate(v) + wind_speed / Smin;
+}
+
 double
 GlidePolar::GetNextLegEqThermal(double current_wind,
                                 double next_wind) const noexcept
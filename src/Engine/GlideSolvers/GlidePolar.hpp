@@ -122,6 +122,8 @@ public:
     Update();
   }
 
+  bool operator==(const GlidePolar &) const noexcept = default;
+
   /**
    * Perform basic checks on the validity of the object.
    */
@@ -467,6 +469,16 @@ public:
   [[gnu::pure]]
   double GetLDOverGround(const AircraftState &state) const noexcept;
 
+  /**
+   * An upper bound of the LD relative to ground, for any MC setting,
+   * speed and track.  This can be used to discard destinations which
+   * are out of glide range before calculating a glide solution.
+   *
+   * @param wind_speed the wind speed (m/s)
+   */
+  [[gnu::pure]]
+  double GetMaxLDOverGround(double wind_speed) const noexcept;
+
   /**
    * Calculates the thermal value of next leg that is equivalent (gives the
    * same average speed) to the current MacCready setting.
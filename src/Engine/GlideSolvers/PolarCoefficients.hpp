@@ -18,6 +18,8 @@ struct PolarCoefficients
     return PolarCoefficients(0, 0, 0);
   }
 
+  constexpr bool operator==(const PolarCoefficients &) const noexcept = default;
+
   constexpr void SetInvalid() noexcept {
     a = b = c = 0;
   }
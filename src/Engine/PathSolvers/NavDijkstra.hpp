@@ -6,6 +6,7 @@
 #include "Dijkstra.hpp"
 #include "ScanTaskPoint.hpp"
 #include "SolverResult.hpp"
+#include "util/RecyclingAllocator.hpp"
 
 #include <unordered_map>
 #include <cassert>
@@ -37,9 +38,32 @@ protected:
       }
     };
 
+    /**
+     * The nodes are recycled by a #RecyclingPool, so a search which
+     * is repeated with a similar number of edges needs no heap
+     * allocations after the first run.
+     */
     template<typename Value>
-    struct Bind : public std::unordered_map<ScanTaskPoint, Value,
-                                            Hash, Equal> {
+    struct Bind : RecyclingPool,
+                  std::unordered_map<ScanTaskPoint, Value, Hash, Equal,
+                                     RecyclingAllocator<std::pair<const ScanTaskPoint, Value>>> {
+      using Map = std::unordered_map<ScanTaskPoint, Value, Hash, Equal,
+                                     RecyclingAllocator<std::pair<const ScanTaskPoint, Value>>>;
+
+      Bind() noexcept
+        :Map(typename Map::allocator_type(static_cast<RecyclingPool &>(*this))) {}
+
+      /* the allocators point to this object's pool, which is never
+         shared with the copy */
+      Bind(const Bind &other)
+        :RecyclingPool(),
+         Map(other,
+             typename Map::allocator_type(static_cast<RecyclingPool &>(*this))) {}
+
+      Bind &operator=(const Bind &other) {
+        Map::operator=(other);
+        return *this;
+      }
     };
   };
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "util/ReservablePriorityQueue.hpp"
+#include "util/RecyclingAllocator.hpp"
 
 #include <unordered_map>
 
@@ -55,21 +56,41 @@ template <class Node, class Hash=std::hash<Node>,
           bool m_min=true>
 class AStar
 {
-  typedef std::unordered_map<Node, AStarPriorityValue, Hash, KeyEqual> node_value_map;
+  struct NodeData {
+    /** Accumulated value of the best path to this node */
+    AStarPriorityValue value;
 
-  typedef typename node_value_map::iterator node_value_iterator;
+    /** Predecessor on the best path to this node */
+    Node parent;
 
-  typedef std::unordered_map<Node, Node, Hash, KeyEqual> node_parent_map;
+    constexpr NodeData(const AStarPriorityValue &_value,
+                       const Node &_parent) noexcept
+      :value(_value), parent(_parent) {}
+  };
+
+  using node_map_value = std::pair<const Node, NodeData>;
+
+  /**
+   * The nodes are recycled by a #RecyclingPool, so a search which is
+   * repeated with a similar number of nodes needs no heap
+   * allocations after the first run.
+   */
+  using node_map = std::unordered_map<Node, NodeData, Hash, KeyEqual,
+                                      RecyclingAllocator<node_map_value>>;
 
   struct NodeValue {
     AStarPriorityValue priority;
 
-    node_value_iterator iterator;
+    /**
+     * Pointer to the map element; unlike iterators, these remain
+     * valid when the map is rehashed.
+     */
+    node_map_value *node;
 
     constexpr
     NodeValue(const AStarPriorityValue &_priority,
-              node_value_iterator _iterator) noexcept
-      :priority(_priority), iterator(_iterator) {}
+              node_map_value &_node) noexcept
+      :priority(_priority), node(&_node) {}
   };
 
   struct Rank {
@@ -79,24 +100,21 @@ class AStar
     }
   };
 
-  /**
-   * Stores the value of each node.  It is updated by push(), if a
-   * value lower than the current one is found.
-   */
-  node_value_map node_values;
+  RecyclingPool pool;
 
   /**
-   * Stores the predecessor of each node.  It is maintained by
-   * set_predecessor().
+   * Stores the value and the predecessor of each node.  It is
+   * updated by Push(), if a value lower than the current one is
+   * found.
    */
-  node_parent_map node_parents;
+  node_map nodes{typename node_map::allocator_type(pool)};
 
   /**
    * A sorted list of all possible node paths, lowest distance first.
    */
   reservable_priority_queue<NodeValue, std::vector<NodeValue>, Rank> q;
 
-  node_value_iterator cur;
+  node_map_value *cur = nullptr;
 
 public:
   static constexpr unsigned DEFAULT_QUEUE_SIZE = 1024;
@@ -126,15 +144,16 @@ public:
     Push(node, node, AStarPriorityValue(0));
   }
 
-  /** Clears the queues */
+  /**
+   * Clears the queues.  Their memory is kept for the next search.
+   */
   void Clear() noexcept {
     // Clear the search queue
     q.clear();
 
-    // Clear the node_parent_map
-    node_parents.clear();
-    // Clear the node_value_map
-    node_values.clear();
+    // Clear the node map
+    nodes.clear();
+    cur = nullptr;
   }
 
   /**
@@ -153,11 +172,11 @@ public:
    * @return Node for processing
    */
   const Node &Pop() noexcept {
-    cur = q.top().iterator;
+    cur = q.top().node;
 
     do { // remove this item
       q.pop();
-    } while (!q.empty() && (q.top().priority > q.top().iterator->second));
+    } while (!q.empty() && (q.top().priority > q.top().node->second.value));
     // and all lower rank than this
 
     return cur->first;
@@ -185,9 +204,9 @@ public:
    */
   [[gnu::pure]]
   Node GetPredecessor(const Node &node) const noexcept {
-    // Try to find the given node in the node_parent_map
-    const auto it = node_parents.find(node);
-    if (it == node_parents.end())
+    // Try to find the given node in the node map
+    const auto it = nodes.find(node);
+    if (it == nodes.end())
       // first entry
       // If the node wasn't found
       // -> Return the given node itself
@@ -195,7 +214,15 @@ public:
 
     // If the node was found
     // -> Return the parent node
-    return it->second;
+    return it->second.parent;
+  }
+
+  /**
+   * The number of nodes visited since the last Restart().
+   */
+  [[gnu::pure]]
+  std::size_t GetNodeCount() const noexcept {
+    return nodes.size();
   }
 
   /** Reserve queue size (if available) */
@@ -209,14 +236,14 @@ public:
    */
   [[gnu::pure]]
   AStarPriorityValue GetNodeValue(const Node &node) const noexcept {
-    if (cur->first == node)
-      return cur->second;
+    if (cur != nullptr && KeyEqual()(cur->first, node))
+      return cur->second.value;
 
-    const auto it = node_values.find(node);
-    if (it == node_values.end())
+    const auto it = nodes.find(node);
+    if (it == nodes.end())
       return AStarPriorityValue(0);
 
-    return it->second;
+    return it->second.value;
   }
 
 private:
@@ -229,37 +256,20 @@ private:
    */
   void Push(const Node &node, const Node &parent,
             const AStarPriorityValue &edge_value) noexcept {
-    // Try to find the given node n in the node_value_map
-    const auto [it, inserted] = node_values.try_emplace(node, edge_value);
-    if (inserted) {
-      // first entry
-      // If the node wasn't found
-      // -> Insert a new node into the node_value_map
+    // Try to find the given node n in the node map
+    // If it wasn't found, it is inserted together with its parent
+    const auto [it, inserted] = nodes.try_emplace(node, edge_value, parent);
+    if (!inserted) {
+      if (!(it->second.value > edge_value))
+        // If the node was found but the value is higher or equal
+        // -> Don't use this new leg
+        return;
 
-      // Remember the parent node
-      SetPredecessor(node, parent);
-    } else if (it->second > edge_value) {
       // If the node was found and the new value is smaller
-      // -> Replace the value with the new one
-      it->second = edge_value;
-      // replace, it's bigger
-
-      // Remember the new parent node
-      SetPredecessor(node, parent);
-    } else
-      // If the node was found but the value is higher or equal
-      // -> Don't use this new leg
-      return;
-
-    q.push(NodeValue(edge_value, it));
-  }
+      // -> Replace the value and the parent with the new ones
+      it->second = NodeData(edge_value, parent);
+    }
 
-  void SetPredecessor(const Node &node, const Node &parent) noexcept {
-    // Try to find the given node in the node_parent_map
-    auto result = node_parents.try_emplace(node, parent);
-    if (!result.second)
-      // If the node was found
-      // -> Replace the according parent node with the new one
-      result.first->second = parent;
+    q.push(NodeValue(edge_value, *it));
   }
 };
@@ -12,4 +12,5 @@ RoutePlannerConfig::SetDefaults()
   safety_height_terrain = 150;
   reach_calc_mode = ReachMode::STRAIGHT;
   reach_polar_mode = Polar::SAFETY;
+  reach_airspace = false;
 }
@@ -40,8 +40,13 @@ struct RoutePlannerConfig
   /** Whether reach/abort calculations will use the task or safety polar */
   Polar reach_polar_mode;
 
+  /** Whether the reach also treats active airspace as an obstacle */
+  bool reach_airspace;
+
   void SetDefaults();
 
+  bool operator==(const RoutePlannerConfig &) const noexcept = default;
+
   bool IsTerrainEnabled() const {
     return mode == Mode::TERRAIN || mode == Mode::BOTH;
   }
@@ -57,4 +62,8 @@ struct RoutePlannerConfig
   bool IsTurningReachEnabled() const {
     return reach_calc_mode == ReachMode::TURNING;
   }
+
+  bool IsReachAirspaceEnabled() const {
+    return IsReachEnabled() && reach_airspace;
+  }
 };
@@ -46,6 +46,22 @@ public:
   [[gnu::pure]]
   bool IsInside(FlatGeoPoint p, bool closed) const noexcept;
 
+  /**
+   * Is the point inside the polygon described by the given hull (see
+   * GetHull())?  Unlike IsInside(), this doesn't check the bounding
+   * box first.
+   */
+  [[gnu::pure]]
+  static bool IsInsideHull(std::span<const FlatGeoPoint> hull,
+                           FlatGeoPoint p) noexcept;
+
+  /**
+   * Returns the bounding box calculated by CalcBoundingBox().
+   */
+  const FlatBoundingBox &GetBoundingBox() const noexcept {
+    return bounding_box;
+  }
+
   void Clear() noexcept {
     vs.clear();
   }
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FlatTriangleFanGrid.hpp"
+#include "FlatTriangleFanTree.hpp"
+#include "ReachFanParms.hpp"
+#include "RoutePolars.hpp"
+
+#include <span>
+
+void
+FlatTriangleFanGrid::Clear() noexcept
+{
+  entries.clear();
+  vertices.clear();
+  cell_start.clear();
+  cell_entries.clear();
+}
+
+void
+FlatTriangleFanGrid::Add(const FlatTriangleFanTree &node) noexcept
+{
+  const unsigned index = entries.size();
+  const auto hull = node.fan.GetHull(node.IsRoot());
+
+  Entry &e = entries.emplace_back();
+  e.bb = node.fan.GetBoundingBox();
+  e.origin = node.fan.GetOrigin();
+  e.hull_begin = vertices.size();
+  vertices.insert(vertices.end(), hull.begin(), hull.end());
+  e.hull_end = vertices.size();
+
+  for (const auto &child : node.children)
+    Add(child);
+
+  /* "e" may have been invalidated by the recursion */
+  entries[index].subtree_end = entries.size();
+}
+
+void
+FlatTriangleFanGrid::Build(const FlatTriangleFanTree &root) noexcept
+{
+  Clear();
+  Add(root);
+
+  bounds = root.bb_children;
+  cell_width = bounds.GetWidth() / SIZE + 1;
+  cell_height = bounds.GetHeight() / SIZE + 1;
+
+  /* count the fans per cell, then fill the cells in entry order, so
+     each cell lists its fans in pre-order */
+  cell_start.assign(SIZE * SIZE + 1, 0);
+  for (const auto &e : entries)
+    for (unsigned row = GetRow(e.bb.GetBottom()),
+           row_end = GetRow(e.bb.GetTop()); row <= row_end; ++row)
+      for (unsigned column = GetColumn(e.bb.GetLeft()),
+             column_end = GetColumn(e.bb.GetRight());
+           column <= column_end; ++column)
+        ++cell_start[row * SIZE + column + 1];
+
+  for (unsigned i = 1; i < cell_start.size(); ++i)
+    cell_start[i] += cell_start[i - 1];
+
+  cell_entries.resize(cell_start.back());
+
+  std::vector<unsigned> fill(cell_start.begin(), cell_start.end() - 1);
+  for (unsigned i = 0; i < entries.size(); ++i) {
+    const auto &e = entries[i];
+    for (unsigned row = GetRow(e.bb.GetBottom()),
+           row_end = GetRow(e.bb.GetTop()); row <= row_end; ++row)
+      for (unsigned column = GetColumn(e.bb.GetLeft()),
+             column_end = GetColumn(e.bb.GetRight());
+           column <= column_end; ++column)
+        cell_entries[fill[row * SIZE + column]++] = i;
+  }
+}
+
+bool
+FlatTriangleFanGrid::FindPositiveArrival(const FlatGeoPoint n,
+                                         const ReachFanParms &parms,
+                                         int &arrival_height) const noexcept
+{
+  if (entries.empty() || !bounds.IsInside(n))
+    return false;
+
+  const unsigned cell = GetRow(n.y) * SIZE + GetColumn(n.x);
+
+  bool found = false;
+
+  /* entries below this index belong to a subtree which has already
+     been decided */
+  unsigned skip_end = 0;
+
+  for (unsigned i = cell_start[cell], end = cell_start[cell + 1];
+       i != end; ++i) {
+    const unsigned index = cell_entries[i];
+    if (index < skip_end)
+      continue;
+
+    const Entry &e = entries[index];
+    if (e.origin.altitude < arrival_height) {
+      /* can't possibly improve */
+      skip_end = e.subtree_end;
+      continue;
+    }
+
+    if (!e.bb.IsInside(n) ||
+        !FlatTriangleFan::IsInsideHull({vertices.data() + e.hull_begin,
+                                        vertices.data() + e.hull_end}, n))
+      continue;
+
+    const int h = parms.rpolars.CalcGlideArrival(e.origin, n,
+                                                 parms.projection);
+    if (h > arrival_height) {
+      arrival_height = h;
+      found = true;
+    }
+
+    /* it is impossible for a child to find a positive arrival height
+       if this one didn't */
+    skip_end = e.subtree_end;
+  }
+
+  return found;
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/Flat/FlatBoundingBox.hpp"
+#include "Geo/Flat/FlatGeoPoint.hpp"
+
+#include <vector>
+
+class FlatTriangleFanTree;
+struct ReachFanParms;
+
+/**
+ * A spatial index over all fans of a #FlatTriangleFanTree, built once
+ * per solve.  The bounding box of the tree is divided into a uniform
+ * grid, and each cell lists the fans whose bounding box overlaps it.
+ * A FindPositiveArrival() query then only tests the few fans listed
+ * in the cell of the destination, instead of descending the tree for
+ * each waypoint.
+ *
+ * The grid keeps its own copy of the hulls, so it can be copied and
+ * moved along with the tree.
+ */
+class FlatTriangleFanGrid {
+  /** the number of cells in each direction */
+  static constexpr unsigned SIZE = 32;
+
+  struct Entry {
+    FlatBoundingBox bb;
+
+    AFlatGeoPoint origin;
+
+    /** the range of this fan's hull in #vertices */
+    unsigned hull_begin, hull_end;
+
+    /**
+     * The index of the first entry after this fan's descendants (the
+     * entries are in pre-order).
+     */
+    unsigned subtree_end;
+  };
+
+  std::vector<Entry> entries;
+  std::vector<FlatGeoPoint> vertices;
+
+  /**
+   * The entries of cell i are cell_entries[cell_start[i]] up to
+   * cell_entries[cell_start[i + 1]], in ascending order.
+   */
+  std::vector<unsigned> cell_start;
+  std::vector<unsigned> cell_entries;
+
+  FlatBoundingBox bounds;
+  unsigned cell_width = 1, cell_height = 1;
+
+public:
+  [[gnu::pure]]
+  bool IsEmpty() const noexcept {
+    return entries.empty();
+  }
+
+  void Clear() noexcept;
+
+  /**
+   * Index all fans of the given tree (which must not be empty),
+   * replacing the previous contents.
+   */
+  void Build(const FlatTriangleFanTree &root) noexcept;
+
+  /**
+   * Equivalent to FlatTriangleFanTree::FindPositiveArrival() on the
+   * tree this grid was built from.
+   */
+  [[gnu::pure]]
+  bool FindPositiveArrival(FlatGeoPoint n, const ReachFanParms &parms,
+                           int &arrival_height) const noexcept;
+
+private:
+  void Add(const FlatTriangleFanTree &node) noexcept;
+
+  unsigned GetColumn(int x) const noexcept {
+    return unsigned(x - bounds.GetLeft()) / cell_width;
+  }
+
+  unsigned GetRow(int y) const noexcept {
+    return unsigned(y - bounds.GetBottom()) / cell_height;
+  }
+};
@@ -6,11 +6,20 @@
 #include "RouteLink.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "ReachFanParms.hpp"
-#include "util/GlobalSliceAllocator.hxx"
 #include "Geo/Flat/FlatProjection.hpp"
 
 #define REACH_SWEEP (ROUTEPOLAR_Q1-BUFFER)
 
+struct FlatTriangleFanTree::Gap {
+  FlatTriangleFanTree *parent;
+  RouteLink e_1, e_2;
+  std::optional<FlatTriangleFanTree> child;
+
+  Gap(FlatTriangleFanTree &_parent,
+      const RouteLink &_e_1, const RouteLink &_e_2) noexcept
+    :parent(&_parent), e_1(_e_1), e_2(_e_2) {}
+};
+
 static bool
 AlmostTheSame(const FlatGeoPoint p1, const FlatGeoPoint p2) noexcept
 {
@@ -42,16 +51,23 @@ void
 FlatTriangleFanTree::FillReach(const AFlatGeoPoint &origin,
                                ReachFanParms &parms) noexcept
 {
-  gaps_filled = false;
-
   FillReach(origin, 0, ROUTEPOLAR_POINTS, parms);
 
-  for (parms.set_depth = 0; parms.set_depth < MAX_DEPTH;
-      ++parms.set_depth)
-    if (!FillDepth(origin, parms))
+  /* expand the tree one level at a time */
+  std::vector<FlatTriangleFanTree *> level{this}, next;
+  for (parms.set_depth = 0; parms.set_depth < MAX_DEPTH && !level.empty();
+       ++parms.set_depth) {
+    if (!FillLevel(level, origin, parms))
       // stop searching
       break;
 
+    next.clear();
+    for (auto *node : level)
+      for (auto &child : node->children)
+        next.push_back(&child);
+    level.swap(next);
+  }
+
   // this boundingbox update visits the tree recursively
   CalcBoundingBox();
 }
@@ -66,25 +82,49 @@ FlatTriangleFanTree::DummyReach(const AFlatGeoPoint &ao) noexcept
 }
 
 bool
-FlatTriangleFanTree::FillDepth(const AFlatGeoPoint &origin,
+FlatTriangleFanTree::FillLevel(std::span<FlatTriangleFanTree *const> nodes,
+                               const AFlatGeoPoint &origin,
                                ReachFanParms &parms) noexcept
 {
-  if (depth == parms.set_depth) {
-    if (gaps_filled)
-      return true;
-    gaps_filled = true;
-
-    if (parms.vertex_counter > MAX_VERTICES)
-      return false;
-    if (parms.fan_counter > MAX_FANS)
+  std::vector<Gap> gaps;
+  std::vector<std::size_t> node_gaps;
+  node_gaps.reserve(nodes.size() + 1);
+  for (auto *node : nodes) {
+    node_gaps.push_back(gaps.size());
+    node->CollectGaps(origin, parms, gaps);
+  }
+  node_gaps.push_back(gaps.size());
+
+  const auto check = [&origin, &parms, &gaps](std::size_t i){
+    Gap &gap = gaps[i];
+    gap.child = gap.parent->CheckGap(origin, gap.e_1, gap.e_2, parms);
+  };
+
+  /* with a ForEachFunction, all gaps are checked in parallel, even
+     those beyond the limits, which are discarded below */
+  if (parms.for_each != nullptr)
+    (*parms.for_each)(gaps.size(), check);
+
+  /* merge the children in the order of a serial search, which checks
+     the limits before each node */
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    if (parms.vertex_counter > MAX_VERTICES || parms.fan_counter > MAX_FANS)
       return false;
 
-    FillGaps(origin, parms);
-  } else if (depth < parms.set_depth) {
-    for (auto &child : children)
-      if (!child.FillDepth(origin, parms))
-        return false; // stop searching
+    for (std::size_t j = node_gaps[i]; j < node_gaps[i + 1]; ++j) {
+      if (parms.for_each == nullptr)
+        check(j);
+
+      Gap &gap = gaps[j];
+      if (!gap.child)
+        continue;
+
+      parms.vertex_counter += gap.child->fan.GetVertices().size();
+      parms.fan_counter++;
+      nodes[i]->children.emplace_front(std::move(*gap.child));
+    }
   }
+
   return true;
 }
 
@@ -105,9 +145,13 @@ FlatTriangleFanTree::FillReach(const AFlatGeoPoint &origin, const int index_low,
       return false;
   }
 
+  FlatGeoPoint intercepts[ROUTEPOLAR_POINTS];
+  const std::span<FlatGeoPoint> xs{intercepts,
+                                   std::size_t(index_high - index_low)};
+  parms.ReachIntercepts(index_low, index_high, origin, geo_origin, xs);
+
   fan.AddOrigin(origin, index_high - index_low);
-  for (int index = index_low; index < index_high; ++index) {
-    FlatGeoPoint x = parms.ReachIntercept(index, origin, geo_origin);
+  for (FlatGeoPoint x : xs) {
     /* if ReachIntercept() did not find anything reasonable it returns
        a FlatGeoPoint that is almost the same as origin, but differs
        +/- 1 due to conversion errors. The resulting polygon can have
@@ -122,8 +166,9 @@ FlatTriangleFanTree::FillReach(const AFlatGeoPoint &origin, const int index_low,
 }
 
 void
-FlatTriangleFanTree::FillGaps(const AFlatGeoPoint &origin,
-                              ReachFanParms &parms) noexcept
+FlatTriangleFanTree::CollectGaps(const AFlatGeoPoint &origin,
+                                 const ReachFanParms &parms,
+                                 std::vector<Gap> &gaps) noexcept
 {
   // worth checking for gaps?
   if (const auto vertices = fan.GetVertices();
@@ -139,7 +184,7 @@ FlatTriangleFanTree::FillGaps(const AFlatGeoPoint &origin,
 
       const RouteLink e(RoutePoint(*x, 0), origin, parms.projection);
       // check if children need to be added
-      CheckGap(origin, e_last, e, parms);
+      gaps.emplace_back(*this, e_last, e);
 
       e_last = e;
     }
@@ -173,22 +218,19 @@ FlatTriangleFanTree::UpdateTerrainBase(const FlatGeoPoint o,
     parms.terrain_base /= parms.terrain_counter;
 }
 
-bool
+std::optional<FlatTriangleFanTree>
 FlatTriangleFanTree::CheckGap(const AFlatGeoPoint &n, const RouteLink &e_1,
                               const RouteLink &e_2,
-                              ReachFanParms &parms) noexcept
+                              const ReachFanParms &parms) const noexcept
 {
   const bool side = (e_1.d > e_2.d);
   const RouteLink &e_long = (side ? e_1 : e_2);
   const RouteLink &e_short = (side ? e_2 : e_1);
   if (e_short.d >= e_long.d)
-    return false;
+    return std::nullopt;
 
   const FlatGeoPoint &p_long = e_long.first;
 
-  // return true if this gap was caught (applicable) whether or not it generated
-  // a change
-
   const auto f0 = e_short.d * e_long.inv_d;
   const int h_loss =
     parms.rpolars.CalcGlideArrival(n, p_long, parms.projection) - n.altitude;
@@ -215,15 +257,11 @@ FlatTriangleFanTree::CheckGap(const AFlatGeoPoint &n, const RouteLink &e_1,
     const AFlatGeoPoint x(px, h);
 
     FlatTriangleFanTree child(depth + 1);
-    if (child.FillReach(x, index_left, index_right, parms)) {
-      parms.vertex_counter += child.fan.GetVertices().size();
-      parms.fan_counter++;
-      children.emplace_front(std::move(child));
-      return true;
-    }
+    if (child.FillReach(x, index_left, index_right, parms))
+      return child;
   }
 
-  return false;
+  return std::nullopt;
 }
 
 int
@@ -4,11 +4,14 @@
 #pragma once
 
 #include "Geo/Flat/FlatBoundingBox.hpp"
-#include "util/SliceAllocator.hxx"
 #include "FlatTriangleFan.hpp"
 
 #include <cstdint>
 #include <forward_list>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
 
 class FlatProjection;
 struct GeoPoint;
@@ -28,20 +31,30 @@ public:
   static constexpr unsigned MIN_STEP = 25;
   static constexpr unsigned MAX_FANS = 300;
 
+  /**
+   * A function which invokes f(i) for each i in [0, n) and returns
+   * after all calls have finished.  The calls may run concurrently.
+   */
+  using ForEachFunction =
+    std::function<void(std::size_t n,
+                       const std::function<void(std::size_t)> &f)>;
+
 private:
   FlatTriangleFan fan;
 
-  using LeafVector =
-    std::forward_list<FlatTriangleFanTree,
-                      GlobalSliceAllocator<FlatTriangleFanTree, 128u>>;
+  /* not a #GlobalSliceAllocator, because trees are built and
+     destroyed by different threads */
+  using LeafVector = std::forward_list<FlatTriangleFanTree>;
 
   FlatBoundingBox bb_children;
   LeafVector children;
   uint_least8_t depth;
-  bool gaps_filled = false;
+
+  struct Gap;
 
 public:
   friend class PrintHelper;
+  friend class FlatTriangleFanGrid;
 
   explicit FlatTriangleFanTree(const uint_least8_t _depth = 0) noexcept
     :depth(_depth) {}
@@ -107,9 +120,26 @@ private:
                  const int index_low, const int index_high,
                  const ReachFanParms &parms) noexcept;
 
-  bool FillDepth(const AFlatGeoPoint &origin, ReachFanParms &parms) noexcept;
-  void FillGaps(const AFlatGeoPoint &origin, ReachFanParms &parms) noexcept;
+  /**
+   * Fill the gaps of all nodes of one tree level (given in the order
+   * of a depth-first traversal), using ReachFanParms::for_each if
+   * available.  The result is the same as filling them one after
+   * another, stopping when a limit has been reached.
+   *
+   * @return false to stop searching
+   */
+  static bool FillLevel(std::span<FlatTriangleFanTree *const> nodes,
+                        const AFlatGeoPoint &origin,
+                        ReachFanParms &parms) noexcept;
+
+  void CollectGaps(const AFlatGeoPoint &origin, const ReachFanParms &parms,
+                   std::vector<Gap> &gaps) noexcept;
 
-  bool CheckGap(const AFlatGeoPoint &n, const RouteLink &e_1,
-                const RouteLink &e_2, ReachFanParms &parms) noexcept;
+  /**
+   * Attempt to create a child fan which fills the given gap.
+   */
+  std::optional<FlatTriangleFanTree> CheckGap(const AFlatGeoPoint &n,
+                                              const RouteLink &e_1,
+                                              const RouteLink &e_2,
+                                              const ReachFanParms &parms) const noexcept;
 };
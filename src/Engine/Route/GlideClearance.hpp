@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <type_traits>
+
+/**
+ * The clearance of a straight glide above the terrain, sampled at
+ * equidistant points from the aircraft to the destination.  It is
+ * calculated by TerrainRoute::CalcGlideClearance().
+ */
+struct GlideClearanceProfile {
+  static constexpr unsigned N_SAMPLES = 32;
+
+  /**
+   * The number of valid elements in #clearance; zero if the profile
+   * is not available.
+   */
+  unsigned n_samples;
+
+  /**
+   * The distance from the aircraft to the last sample [m].
+   */
+  double distance;
+
+  /**
+   * The height of the glide path above the terrain at each sample
+   * [m]; negative where the glide path is below the terrain.  The
+   * first sample is one step ahead of the aircraft, the last one is
+   * at the destination.
+   */
+  int clearance[N_SAMPLES];
+
+  /**
+   * The index of the lowest element of #clearance.
+   */
+  unsigned minimum;
+
+  void Clear() noexcept {
+    n_samples = 0;
+  }
+
+  constexpr bool IsDefined() const noexcept {
+    return n_samples > 0;
+  }
+
+  /**
+   * The distance from the aircraft to the given sample [m].
+   */
+  constexpr double GetSampleDistance(unsigned i) const noexcept {
+    return distance * (i + 1) / n_samples;
+  }
+
+  /**
+   * The lowest clearance along the glide path [m].
+   */
+  constexpr int GetMinimum() const noexcept {
+    return clearance[minimum];
+  }
+
+  /**
+   * The distance from the aircraft to the point with the lowest
+   * clearance [m].
+   */
+  constexpr double GetMinimumDistance() const noexcept {
+    return GetSampleDistance(minimum);
+  }
+};
+
+static_assert(std::is_trivial<GlideClearanceProfile>::value,
+              "type is not trivial");
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ReachAirspaceMask.hpp"
+#include "Airspace/Airspaces.hpp"
+#include "Airspace/AbstractAirspace.hpp"
+#include "Geo/GeoBounds.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Round the cell index down to a multiple of
+ * ReachAirspaceMask::BLOCK.
+ */
+static int
+FloorBlock(double cells) noexcept
+{
+  constexpr int block = ReachAirspaceMask::BLOCK;
+  return int(std::floor(cells / block)) * block;
+}
+
+void
+ReachAirspaceMask::Build(const Airspaces &airspaces,
+                         const AirspacePredicate &predicate,
+                         const AGeoPoint &origin) noexcept
+{
+  Clear();
+
+  west = FloorBlock(ToCells(origin.longitude)) - SIZE / 2;
+  south = FloorBlock(ToCells(origin.latitude)) - SIZE / 2;
+
+  const GeoPoint south_west(Angle::Degrees(west * CELL_SIZE),
+                            Angle::Degrees(south * CELL_SIZE));
+  const GeoPoint north_east(Angle::Degrees((west + SIZE) * CELL_SIZE),
+                            Angle::Degrees((south + SIZE) * CELL_SIZE));
+  const double range = std::max(origin.Distance(south_west),
+                                origin.Distance(north_east));
+
+  for (const auto &i : airspaces.QueryWithinRange(origin, range)) {
+    const AbstractAirspace &airspace = i.GetAirspace();
+    if (!predicate(airspace))
+      continue;
+
+    const int base = (int)airspace.GetBase().altitude;
+    const int top = (int)airspace.GetTop().altitude;
+    if (airspace.Inside(origin) &&
+        origin.altitude >= base && origin.altitude <= top)
+      continue;
+
+    const GeoBounds bounds = airspace.GetGeoBounds();
+    const int x_min = std::max(int(std::floor(ToCells(bounds.GetWest()))) - west, 0);
+    const int x_max = std::min(int(std::floor(ToCells(bounds.GetEast()))) - west,
+                               SIZE - 1);
+    const int y_min = std::max(int(std::floor(ToCells(bounds.GetSouth()))) - south, 0);
+    const int y_max = std::min(int(std::floor(ToCells(bounds.GetNorth()))) - south,
+                               SIZE - 1);
+
+    for (int y = y_min; y <= y_max; ++y) {
+      for (int x = x_min; x <= x_max; ++x) {
+        if (!airspace.Inside(GetCellCenter(x, y)))
+          continue;
+
+        if (cells.empty())
+          cells.resize(SIZE * SIZE);
+
+        Cell &cell = At(x, y);
+        if (cell.base > cell.top) {
+          cell.base = base;
+          cell.top = top;
+        } else {
+          cell.base = std::min(cell.base, base);
+          cell.top = std::max(cell.top, top);
+        }
+      }
+    }
+  }
+}
+
+GeoPoint
+ReachAirspaceMask::Intersection(const GeoPoint &origin,
+                                const double origin_altitude,
+                                const GeoPoint &dest,
+                                const double dest_altitude) const noexcept
+{
+  if (cells.empty())
+    return GeoPoint::Invalid();
+
+  const double x0 = ToCells(origin.longitude) - west;
+  const double y0 = ToCells(origin.latitude) - south;
+  const double dx = ToCells(dest.longitude) - west - x0;
+  const double dy = ToCells(dest.latitude) - south - y0;
+
+  /* sample twice per cell */
+  const unsigned n = std::min(unsigned(2 * std::max(std::fabs(dx),
+                                                    std::fabs(dy))) + 1,
+                              unsigned(4 * SIZE));
+
+  for (unsigned i = 1; i <= n; ++i) {
+    const double t = double(i) / n;
+    const double x = x0 + dx * t, y = y0 + dy * t;
+    if (x < 0 || y < 0 || x >= SIZE || y >= SIZE)
+      /* outside of the window */
+      continue;
+
+    if (At(int(x), int(y)).IsBlocked(origin_altitude +
+                                     (dest_altitude - origin_altitude) * t))
+      return origin.Interpolate(dest, double(i - 1) / n);
+  }
+
+  return GeoPoint::Invalid();
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Airspace/Predicate/AirspacePredicate.hpp"
+#include "Geo/GeoPoint.hpp"
+
+#include <vector>
+
+class Airspaces;
+
+/**
+ * A coarse raster of the airspace volumes which the reach shall
+ * treat as obstacles.  It covers a window of #SIZE x #SIZE cells of
+ * #CELL_SIZE degrees around the aircraft; each cell stores the lowest
+ * base and the highest top of all airspaces covering its centre.
+ *
+ * The window is aligned to blocks of #BLOCK cells, and therefore the
+ * mask built for a nearby origin is usually equal to the previous
+ * one.
+ */
+class ReachAirspaceMask {
+public:
+  /** the cell size [degrees] */
+  static constexpr double CELL_SIZE = 1. / 48;
+
+  /** the number of cells in each direction */
+  static constexpr int SIZE = 128;
+
+  static constexpr int BLOCK = 8;
+
+private:
+  struct Cell {
+    int base = 1, top = 0;
+
+    bool operator==(const Cell &) const noexcept = default;
+
+    constexpr bool IsBlocked(double altitude) const noexcept {
+      return altitude >= base && altitude <= top;
+    }
+  };
+
+  /** the index of the south-western cell */
+  int west = 0, south = 0;
+
+  /** empty if no airspace was found */
+  std::vector<Cell> cells;
+
+public:
+  [[gnu::pure]]
+  bool IsEmpty() const noexcept {
+    return cells.empty();
+  }
+
+  void Clear() noexcept {
+    cells.clear();
+  }
+
+  bool operator==(const ReachAirspaceMask &) const noexcept = default;
+
+  /**
+   * Rasterize all airspaces around the given origin which match the
+   * predicate.  Like #AirspaceRoute, this ignores airspaces the
+   * aircraft is inside.
+   */
+  void Build(const Airspaces &airspaces, const AirspacePredicate &predicate,
+             const AGeoPoint &origin) noexcept;
+
+  /**
+   * Follow the straight glide from #origin to #dest, with its altitude
+   * changing linearly, and find the last point before it enters an
+   * obstacle.
+   *
+   * @return the point, or an invalid point if the glide is clear
+   */
+  [[gnu::pure]]
+  GeoPoint Intersection(const GeoPoint &origin, double origin_altitude,
+                        const GeoPoint &dest,
+                        double dest_altitude) const noexcept;
+
+private:
+  Cell &At(int x, int y) noexcept {
+    return cells[y * SIZE + x];
+  }
+
+  const Cell &At(int x, int y) const noexcept {
+    return cells[y * SIZE + x];
+  }
+
+  [[gnu::const]]
+  static double ToCells(Angle angle) noexcept {
+    return angle.Degrees() / CELL_SIZE;
+  }
+
+  GeoPoint GetCellCenter(int x, int y) const noexcept {
+    return GeoPoint(Angle::Degrees((west + x + 0.5) * CELL_SIZE),
+                    Angle::Degrees((south + y + 0.5) * CELL_SIZE));
+  }
+};
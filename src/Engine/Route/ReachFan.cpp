@@ -6,18 +6,25 @@
 #include "ReachFanParms.hpp"
 #include "ReachResult.hpp"
 
+#include <algorithm>
+
 static constexpr int MIN_FLOOR_CLEARANCE = 100;
 
 void
 ReachFan::Reset() noexcept
 {
   root.Clear();
+  grid.Clear();
   terrain_base = 0;
+  solve_full = false;
+  arrival_loss = 0;
 }
 
 bool
 ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
-                const RasterMap* terrain, const bool do_solve) noexcept
+                const RasterMap* terrain, const bool do_solve,
+                const FlatTriangleFanTree::ForEachFunction *for_each,
+                const ReachAirspaceMask *airspace) noexcept
 {
   Reset();
 
@@ -30,6 +37,8 @@ ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
   const int h2 = h.GetValueOr0();
 
   ReachFanParms parms(rpolars, projection, terrain_base, terrain);
+  parms.for_each = for_each;
+  parms.airspace = airspace;
   const AFlatGeoPoint ao(projection.ProjectInteger(origin), origin.altitude);
 
   // immediate exit if starting below terrain, or starting below floor
@@ -42,10 +51,12 @@ ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
     return false;
   }
 
-  if (do_solve)
+  if (do_solve) {
     root.FillReach(ao, parms);
-  else
+    grid.Build(root);
+  } else {
     root.DummyReach(ao);
+  }
 
   if (!h.IsInvalid()) {
     parms.terrain_base = h2;
@@ -59,6 +70,58 @@ ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
     root.UpdateTerrainBase(ao, parms);
 
   terrain_base = parms.terrain_base;
+
+  if (do_solve) {
+    solve_origin = origin;
+    solve_rpolars = rpolars;
+    solve_terrain = terrain;
+    solve_full = true;
+  }
+
+  return true;
+}
+
+inline std::optional<int>
+ReachFan::IsStillValid(const AGeoPoint &origin, const RoutePolars &rpolars,
+                       const RasterMap *terrain) const noexcept
+{
+  if (!solve_full || terrain != solve_terrain ||
+      !rpolars.IsSameGlide(solve_rpolars))
+    return std::nullopt;
+
+  if (solve_origin.DistanceS(origin) > MAX_DRIFT)
+    return std::nullopt;
+
+  const FlatGeoPoint fs = projection.ProjectInteger(solve_origin);
+  const FlatGeoPoint fo = projection.ProjectInteger(origin);
+  const int h_glide =
+    solve_rpolars.CalcGlideArrival(AFlatGeoPoint(fs, solve_origin.altitude),
+                                   fo, projection);
+  if (origin.altitude < h_glide || origin.altitude > h_glide + MAX_CLIMB)
+    return std::nullopt;
+
+  /* every route from here can start by gliding back to the old
+     origin, arriving there this much lower than the fan assumes */
+  const int h_back =
+    solve_rpolars.CalcGlideArrival(AFlatGeoPoint(fo, origin.altitude),
+                                   fs, projection);
+  return std::max(int(solve_origin.altitude) - h_back, 0);
+}
+
+bool
+ReachFan::Update(const AGeoPoint origin, const RoutePolars &rpolars,
+                 const RasterMap *terrain, const bool do_solve,
+                 const FlatTriangleFanTree::ForEachFunction *for_each,
+                 const ReachAirspaceMask *airspace) noexcept
+{
+  if (do_solve) {
+    if (const auto loss = IsStillValid(origin, rpolars, terrain)) {
+      arrival_loss = *loss;
+      return false;
+    }
+  }
+
+  Solve(origin, rpolars, terrain, do_solve, for_each, airspace);
   return true;
 }
 
@@ -76,24 +139,26 @@ ReachFan::FindPositiveArrival(const AGeoPoint dest,
   result_r.Clear();
 
   // first calculate direct (terrain-independent height)
-  result_r.direct = root.DirectArrival(d, parms);
+  result_r.direct = root.DirectArrival(d, parms) - arrival_loss;
 
   if (root.IsDummy())
     /* terrain reach is not available, stop here */
     return result_r;
 
   // if can't reach even with no terrain, exit early
-  if (std::min(root.GetHeight(), result_r.direct) < dest.altitude) {
+  if (std::min(root.GetHeight() - arrival_loss, result_r.direct) <
+      dest.altitude) {
     result_r.terrain = result_r.direct;
     result_r.terrain_valid = ReachResult::Validity::UNREACHABLE;
     return result_r;
   }
 
   // now calculate turning solution
-  result_r.terrain = dest.altitude - 1;
-  result_r.terrain_valid = root.FindPositiveArrival(d, parms, result_r.terrain)
+  int arrival = dest.altitude + arrival_loss - 1;
+  result_r.terrain_valid = grid.FindPositiveArrival(d, parms, arrival)
     ? ReachResult::Validity::VALID
     : ReachResult::Validity::UNREACHABLE;
+  result_r.terrain = arrival - arrival_loss;
 
   return result_r;
 }
@@ -4,12 +4,15 @@
 #pragma once
 
 #include "Geo/Flat/FlatProjection.hpp"
+#include "Geo/GeoPoint.hpp"
 #include "FlatTriangleFanTree.hpp"
+#include "FlatTriangleFanGrid.hpp"
+#include "RoutePolars.hpp"
 
 #include <optional>
 
-class RoutePolars;
 class RasterMap;
+class ReachAirspaceMask;
 class GeoBounds;
 struct ReachResult;
 
@@ -17,9 +20,39 @@ class ReachFan
 {
   FlatProjection projection;
   FlatTriangleFanTree root;
+
+  /** an index of #root for FindPositiveArrival() */
+  FlatTriangleFanGrid grid;
+
   int terrain_base = 0;
 
+  /* the parameters of the last full Solve(), see Update() */
+  AGeoPoint solve_origin;
+  RoutePolars solve_rpolars;
+  const RasterMap *solve_terrain;
+  bool solve_full = false;
+
+  /**
+   * The solution is being reused from a different origin (see
+   * Update()); all arrival heights are lowered by this value [m],
+   * which is what it costs to glide back to #solve_origin.
+   */
+  int arrival_loss = 0;
+
 public:
+  /**
+   * Update() keeps the solution until the aircraft has moved this
+   * distance [m] from the origin of the last full solve.
+   */
+  static constexpr double MAX_DRIFT = 300;
+
+  /**
+   * Update() keeps the solution until the aircraft has climbed this
+   * height [m] above the glide path from the origin of the last full
+   * solve.
+   */
+  static constexpr int MAX_CLIMB = 25;
+
   friend class PrintHelper;
 
   bool IsEmpty() const noexcept {
@@ -32,8 +65,43 @@ public:
 
   void Reset() noexcept;
 
+  /**
+   * @param for_each an optional function which expands the fan tree
+   * in parallel (see FlatTriangleFanTree::ForEachFunction); the
+   * result doesn't depend on it
+   * @param airspace an optional mask of airspace obstacles
+   */
   bool Solve(const AGeoPoint origin, const RoutePolars &rpolars,
-             const RasterMap *terrain, const bool do_solve = true) noexcept;
+             const RasterMap *terrain, const bool do_solve = true,
+             const FlatTriangleFanTree::ForEachFunction *for_each=nullptr,
+             const ReachAirspaceMask *airspace=nullptr) noexcept;
+
+  /**
+   * Like Solve(), but keep the existing solution if it still holds
+   * for the new origin: the polar and the terrain are the same, the
+   * aircraft is within #MAX_DRIFT of the last origin, and it is not
+   * below the glide path from there (but not more than #MAX_CLIMB
+   * above it).  Arrivals are then lowered by the height it costs to
+   * glide back to the old origin, so they remain on the safe side
+   * for destinations behind or beside the aircraft.
+   *
+   * The airspace mask is not compared; the caller must Reset() this
+   * object after it has changed.
+   *
+   * @return true if the solution was recalculated
+   */
+  bool Update(const AGeoPoint origin, const RoutePolars &rpolars,
+              const RasterMap *terrain, bool do_solve,
+              const FlatTriangleFanTree::ForEachFunction *for_each=nullptr,
+              const ReachAirspaceMask *airspace=nullptr) noexcept;
+
+  /**
+   * Copy the arrival correction of a solution kept by Update() from
+   * another copy of the same solution.
+   */
+  void CopyArrivalLoss(const ReachFan &other) noexcept {
+    arrival_loss = other.arrival_loss;
+  }
 
   /**
    * Find arrival height at destination.
@@ -57,4 +125,14 @@ public:
   int GetTerrainBase() const noexcept {
     return terrain_base;
   }
+
+private:
+  /**
+   * @return the height lost on the way back to #solve_origin if the
+   * solution still holds for the given origin
+   */
+  [[gnu::pure]]
+  std::optional<int> IsStillValid(const AGeoPoint &origin,
+                                  const RoutePolars &rpolars,
+                                  const RasterMap *terrain) const noexcept;
 };
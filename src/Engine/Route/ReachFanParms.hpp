@@ -4,9 +4,11 @@
 #pragma once
 
 #include "Route/RoutePolars.hpp"
+#include "FlatTriangleFanTree.hpp"
 
 class FlatProjection;
 class RasterMap;
+class ReachAirspaceMask;
 
 struct ReachFanParms {
   const RoutePolars &rpolars;
@@ -18,6 +20,17 @@ struct ReachFanParms {
   unsigned vertex_counter = 0;
   unsigned char set_depth = 0;
 
+  /**
+   * An optional function which runs the expansion of one tree level
+   * in parallel.
+   */
+  const FlatTriangleFanTree::ForEachFunction *for_each = nullptr;
+
+  /**
+   * Optional airspace obstacles in addition to the terrain.
+   */
+  const ReachAirspaceMask *airspace = nullptr;
+
   ReachFanParms(const RoutePolars& _rpolars,
                 const FlatProjection &_projection,
                 const short _terrain_base,
@@ -29,6 +42,14 @@ struct ReachFanParms {
   FlatGeoPoint ReachIntercept(int index, const AFlatGeoPoint &flat_origin,
                               const GeoPoint &origin) const {
     return rpolars.ReachIntercept(index, flat_origin, origin,
-                                  terrain, projection);
+                                  terrain, projection, airspace);
+  }
+
+  void ReachIntercepts(int index_low, int index_high,
+                       const AFlatGeoPoint &flat_origin,
+                       const GeoPoint &origin,
+                       std::span<FlatGeoPoint> results) const {
+    rpolars.ReachIntercepts(index_low, index_high, flat_origin, origin,
+                            terrain, projection, results, airspace);
   }
 };
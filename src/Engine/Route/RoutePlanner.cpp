@@ -17,6 +17,8 @@ RoutePlanner::Reset() noexcept
   destination_last = AFlatGeoPoint(0, 0, 0);
   dirty = true;
   solution_route.clear();
+  solution_valid = false;
+  solution_repaired = false;
   planner.Clear();
   unique_links.clear();
   h_min = -1;
@@ -39,6 +41,12 @@ RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
     const AFlatGeoPoint s_destination(projection.ProjectInteger(destination),
                                       destination.altitude);
 
+    /* nothing but the destination may have changed (the planner
+       is marked dirty when the airspaces or the terrain change) */
+    const bool repairable = !dirty && solution_valid &&
+      s_origin == origin_last &&
+      rpolars_route.IsSamePerformance(rpolars_solution);
+
     if (!(s_origin == origin_last) || !(s_destination == destination_last))
       dirty = true;
 
@@ -51,6 +59,12 @@ RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
 
     h_min = std::min(s_origin.altitude, s_destination.altitude);
     h_max = rpolars_route.cruise_altitude;
+
+    solution_repaired = repairable && RepairSolution(destination);
+    if (solution_repaired)
+      return true;
+
+    solution_valid = false;
   }
 
   solution_route.clear();
@@ -116,6 +130,9 @@ RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
   }
 
   if (retval) {
+    solution_valid = true;
+    rpolars_solution = rpolars_route;
+
     // correct solution for rounding
     assert(solution_route.size()>=2);
     for (auto &i : solution_route) {
@@ -133,6 +150,7 @@ RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
     solution_route.push_back(destination);
   }
 
+  node_count = planner.GetNodeCount();
   planner.Clear();
   unique_links.clear();
   // m_search_hull.clear();
@@ -190,6 +208,41 @@ RoutePlanner::FindSolution(const RoutePoint &final_point,
   return planner.GetNodeValue(final_point).h;
 }
 
+bool
+RoutePlanner::RepairSolution(const AGeoPoint &destination) noexcept
+{
+  /* the solution starts at the origin and ends at the previous
+     destination */
+  assert(solution_route.size() >= 2);
+
+  RoutePoint previous;
+  for (std::size_t i = 0; i + 1 < solution_route.size(); ++i) {
+    const AGeoPoint &p = solution_route[i];
+    const RoutePoint point(projection.ProjectInteger(p), p.altitude);
+
+    if (i > 0 && !((FlatGeoPoint)point == (FlatGeoPoint)previous)) {
+      /* re-verify the link from the previous point */
+      const RouteLink e(previous, point, projection);
+      if (!rpolars_route.IsAchievable(e, true) || !IsClear(e))
+        return false;
+    }
+
+    previous = point;
+
+    const RouteLink e(point, destination_last, projection);
+    if (e.IsShort() ||
+        (rpolars_route.IsAchievable(e, true) &&
+         rpolars_route.CalcTime(e) != UINT_MAX &&
+         IsClear(e))) {
+      solution_route.resize(i + 1);
+      solution_route.emplace_back(destination, destination_last.altitude);
+      return true;
+    }
+  }
+
+  return false;
+}
+
 bool
 RoutePlanner::LinkCleared(const RouteLink &e) noexcept
 {
@@ -315,7 +368,7 @@ RoutePlanner::UpdatePolar(const GlideSettings &settings,
                           const SpeedVector &wind) noexcept
 {
   rpolars_route.SetConfig(config);
-  rpolars_route.Initialise(settings, task_polar, wind);
+  rpolars_route.Initialise(settings, task_polar, wind, polar_cache);
 }
 
 void
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "RoutePolars.hpp"
+#include "RoutePolarCache.hpp"
 #include "Route.hpp"
 #include "RouteLink.hpp"
 #include "AStar.hpp"
@@ -86,6 +87,11 @@ protected:
   FlatProjection projection;
   /** Aircraft performance model for route calculations */
   RoutePolars rpolars_route;
+  /**
+   * The tables of all performance models; this avoids recalculating
+   * them for small changes of the wind estimate.
+   */
+  RoutePolarCache polar_cache;
   /** Minimum height scanned during solution (m) */
   int h_min;
   /** Maxmimum height scanned during solution (m) */
@@ -110,9 +116,24 @@ private:
   /** Link candidates to be processed for intersection tests */
   RouteLinkQueue links;
 
+  /** The number of nodes visited by the last search */
+  std::size_t node_count = 0;
+
   /** Result route found by solve() method */
   Route solution_route;
 
+  /**
+   * Was #solution_route found by a search (and isn't the direct
+   * fallback)?  Only then can it be repaired.
+   */
+  bool solution_valid;
+
+  /** Was #solution_route obtained by RepairSolution()? */
+  bool solution_repaired;
+
+  /** The performance model of #solution_route */
+  RoutePolars rpolars_solution;
+
   /** Origin at last call to solve() */
   AFlatGeoPoint origin_last;
   /** Destination at last call to solve() */
@@ -141,6 +162,10 @@ public:
    * @param config Control parameters for performance model constraints
    * @param h_ceiling Imposed absolute ceiling (m)
    *
+   * If only the destination has moved since the last solution, that
+   * solution is repaired instead of searching again (see
+   * RepairSolution()).
+   *
    * @return True if new solution was found
    */
   bool Solve(const AGeoPoint &origin, const AGeoPoint &destination,
@@ -155,6 +180,23 @@ public:
     return solution_route;
   }
 
+  /**
+   * Was the current solution obtained by repairing the previous one,
+   * without a new search?
+   */
+  bool IsSolutionRepaired() const noexcept {
+    return solution_repaired;
+  }
+
+  /**
+   * The number of nodes visited by the last search (for
+   * benchmarks).
+   */
+  [[gnu::pure]]
+  std::size_t GetNodeCount() const noexcept {
+    return node_count;
+  }
+
   /**
    * Update aircraft performance model used for path planning.
    *
@@ -291,4 +333,15 @@ private:
    */
   unsigned FindSolution(const RoutePoint &final_point,
                         Route &this_route) const noexcept;
+
+  /**
+   * The destination (the aircraft) has moved, but nothing else has
+   * changed: re-verify the links of the previous solution, and
+   * connect the first of its points which has a clear and
+   * achievable link to the new destination.
+   *
+   * @return true if the solution was repaired; false if a new
+   * search is needed
+   */
+  bool RepairSolution(const AGeoPoint &destination) noexcept;
 };
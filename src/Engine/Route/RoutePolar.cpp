@@ -8,6 +8,8 @@
 #include "Geo/Flat/FlatGeoPoint.hpp"
 #include "util/Macros.hpp"
 
+#include <algorithm>
+
 GlideResult
 RoutePolar::SolveTask(const GlideSettings &settings,
                       const GlidePolar& glide_polar,
@@ -39,6 +41,13 @@ RoutePolar::Initialise(const GlideSettings &settings, const GlidePolar& polar,
   }
 }
 
+bool
+RoutePolar::operator==(const RoutePolar &other) const noexcept
+{
+  return std::equal(std::begin(points), std::end(points),
+                    std::begin(other.points));
+}
+
 static constexpr FlatGeoPoint index_to_point[] = {
   {128, 0},
   {126, 16},
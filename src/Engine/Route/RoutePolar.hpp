@@ -48,6 +48,12 @@ class RoutePolar
       else
         inv_gradient = 0;
     };
+
+    constexpr bool operator==(const RoutePolarPoint &other) const noexcept {
+      return valid == other.valid &&
+        (!valid ||
+         (slowness == other.slowness && gradient == other.gradient));
+    }
   };
 
   RoutePolarPoint points[ROUTEPOLAR_POINTS];
@@ -65,6 +71,9 @@ public:
                   const SpeedVector& wind,
                   const bool glide);
 
+  [[gnu::pure]]
+  bool operator==(const RoutePolar &other) const noexcept;
+
   /**
    * Retrieve data corresponding to a particular (backwards-time) direction.
    *
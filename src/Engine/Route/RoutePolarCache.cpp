@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "RoutePolarCache.hpp"
+#include "Geo/SpeedVector.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr unsigned N_WIND_SECTORS = 360 / RoutePolarCache::WIND_SECTOR;
+
+static unsigned
+ToWindSector(const SpeedVector &wind) noexcept
+{
+  const unsigned sector =
+    unsigned(std::lround(wind.bearing.AsBearing().Degrees() /
+                         RoutePolarCache::WIND_SECTOR));
+  return sector % N_WIND_SECTORS;
+}
+
+static unsigned
+ToWindSteps(const SpeedVector &wind) noexcept
+{
+  return unsigned(std::lround(wind.norm / RoutePolarCache::WIND_STEP));
+}
+
+static SpeedVector
+FromQuantized(unsigned sector, unsigned steps) noexcept
+{
+  return SpeedVector(Angle::Degrees(sector * RoutePolarCache::WIND_SECTOR),
+                     steps * RoutePolarCache::WIND_STEP);
+}
+
+SpeedVector
+RoutePolarCache::Quantize(const SpeedVector &wind) noexcept
+{
+  const unsigned steps = ToWindSteps(wind);
+  return FromQuantized(steps > 0 ? ToWindSector(wind) : 0, steps);
+}
+
+const RoutePolar &
+RoutePolarCache::Get(const GlideSettings &settings, const GlidePolar &polar,
+                     const SpeedVector &wind, const bool glide) noexcept
+{
+  const unsigned steps = ToWindSteps(wind);
+  /* the direction of a calm doesn't matter */
+  const unsigned sector = steps > 0 ? ToWindSector(wind) : 0;
+
+  const auto begin = items.begin();
+  for (auto i = begin, end = begin + n_items; i != end; ++i) {
+    if (i->wind_sector == sector && i->wind_steps == steps &&
+        i->glide == glide && i->polar == polar && i->settings == settings) {
+      /* move to the front */
+      std::rotate(begin, i, std::next(i));
+      return items.front().table;
+    }
+  }
+
+  /* replace the least recently used item (or use a new one), and
+     move it to the front */
+  if (n_items < SIZE)
+    ++n_items;
+  std::rotate(begin, begin + n_items - 1, begin + n_items);
+
+  Item &item = items.front();
+  item.settings = settings;
+  item.polar = polar;
+  item.wind_sector = sector;
+  item.wind_steps = steps;
+  item.glide = glide;
+  item.table.Initialise(settings, polar, FromQuantized(sector, steps), glide);
+  return item.table;
+}
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "RoutePolar.hpp"
+#include "GlideSolvers/GlidePolar.hpp"
+#include "GlideSolvers/GlideSettings.hpp"
+
+#include <array>
+
+struct SpeedVector;
+
+/**
+ * A small least-recently-used cache of #RoutePolar tables.  The wind
+ * is quantized to sectors of #WIND_SECTOR degrees and to steps of
+ * #WIND_STEP m/s, so a wind estimate which shifts a little from one
+ * cycle to the next hands out the same table, instead of solving the
+ * MacCready glides for all directions again.
+ */
+class RoutePolarCache {
+public:
+  /** the number of tables kept */
+  static constexpr unsigned SIZE = 16;
+
+  /** the width of a wind direction sector [degrees] */
+  static constexpr unsigned WIND_SECTOR = 5;
+
+  /** the wind speed step [m/s] */
+  static constexpr double WIND_STEP = 0.5;
+
+private:
+  struct Item {
+    GlideSettings settings;
+    GlidePolar polar;
+    unsigned wind_sector, wind_steps;
+    bool glide;
+
+    RoutePolar table;
+  };
+
+  /** the most recently used item first */
+  std::array<Item, SIZE> items;
+  unsigned n_items = 0;
+
+public:
+  /**
+   * Round the wind vector to the quantization used by this cache.
+   */
+  [[gnu::const]]
+  static SpeedVector Quantize(const SpeedVector &wind) noexcept;
+
+  /**
+   * Returns the table for the given parameters (see
+   * RoutePolar::Initialise()), calculated with the quantized wind.
+   * The reference is valid until the next call.
+   */
+  const RoutePolar &Get(const GlideSettings &settings,
+                        const GlidePolar &polar,
+                        const SpeedVector &wind, bool glide) noexcept;
+};
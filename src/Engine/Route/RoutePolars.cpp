@@ -3,10 +3,14 @@
 
 #include "RoutePolars.hpp"
 #include "RouteLink.hpp"
+#include "ReachAirspaceMask.hpp"
+#include "RoutePolarCache.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
 #include "Geo/Flat/FlatProjection.hpp"
 #include "Terrain/RasterMap.hpp"
 
+#include <algorithm>
+
 static constexpr double MC_CEILING_PENALTY_FACTOR = 5.0;
 
 inline FlatGeoPoint
@@ -35,6 +39,17 @@ RoutePolars::Initialise(const GlideSettings &settings, const GlidePolar &polar,
   height_min_working = std::max(0, _height_min_working - GetSafetyHeight());
 }
 
+void
+RoutePolars::Initialise(const GlideSettings &settings, const GlidePolar &polar,
+                        const SpeedVector &wind, RoutePolarCache &cache,
+                        const int _height_min_working) noexcept
+{
+  polar_glide = cache.Get(settings, polar, wind, true);
+  polar_cruise = cache.Get(settings, polar, wind, false);
+  inv_mc = MC_CEILING_PENALTY_FACTOR * polar.GetInvMC();
+  height_min_working = std::max(0, _height_min_working - GetSafetyHeight());
+}
+
 unsigned
 RoutePolars::RoundTime(const unsigned val) noexcept
 {
@@ -221,24 +236,12 @@ RoutePolars::CalcGlideArrival(const AFlatGeoPoint &origin,
   return origin.altitude - CalcVHeight(e);
 }
 
-FlatGeoPoint
-RoutePolars::ReachIntercept(const int index, const AFlatGeoPoint &flat_origin,
-                            const GeoPoint &origin,
-                            const RasterMap *map,
-                            const FlatProjection &proj) const noexcept
+inline FlatGeoPoint
+RoutePolars::ClipIntercept(const FlatGeoPoint &flat_origin,
+                           const FlatGeoPoint &flat_dest,
+                           const GeoPoint &p,
+                           const FlatProjection &proj) noexcept
 {
-  const bool valid = map && map->IsDefined();
-  const int altitude = flat_origin.altitude - GetSafetyHeight();
-  const FlatGeoPoint flat_dest = MSLIntercept(index, flat_origin,
-                                              altitude, proj);
-
-  if (!valid)
-    return flat_dest;
-
-  const GeoPoint dest = proj.Unproject(flat_dest);
-  const GeoPoint p = map->GroundIntersection(origin, altitude,
-                                             altitude, dest, height_min_working);
-
   if (!p.IsValid())
     return flat_dest;
 
@@ -248,8 +251,8 @@ RoutePolars::ReachIntercept(const int index, const AFlatGeoPoint &flat_origin,
      right next to our origin, the intersection may be deformed due to
      terrain raster rounding errors; the following code applies
      clipping to avoid degenerate polygons */
-  FlatGeoPoint delta1 = flat_dest - (FlatGeoPoint)flat_origin;
-  FlatGeoPoint delta2 = fp - (FlatGeoPoint)flat_origin;
+  FlatGeoPoint delta1 = flat_dest - flat_origin;
+  FlatGeoPoint delta2 = fp - flat_origin;
 
   if (delta1.x * delta2.x < 0)
     /* intersection is on the wrong horizontal side */
@@ -261,3 +264,100 @@ RoutePolars::ReachIntercept(const int index, const AFlatGeoPoint &flat_origin,
 
   return fp;
 }
+
+GeoPoint
+RoutePolars::AirspaceIntercept(const AFlatGeoPoint &flat_origin,
+                               const GeoPoint &origin, const GeoPoint &dest,
+                               const GeoPoint &p,
+                               const ReachAirspaceMask &airspace) const noexcept
+{
+  /* the glide arrives at the MSL intercept with the safety height */
+  const GeoPoint q = airspace.Intersection(origin, flat_origin.altitude,
+                                           dest, GetSafetyHeight());
+  if (!q.IsValid())
+    return p;
+
+  if (!p.IsValid())
+    return q;
+
+  /* both are on the same ray: return the one nearer to the origin */
+  const auto Distance = [&origin](const GeoPoint &x){
+    return (x.longitude - origin.longitude).Absolute() +
+      (x.latitude - origin.latitude).Absolute();
+  };
+
+  return Distance(q) < Distance(p) ? q : p;
+}
+
+FlatGeoPoint
+RoutePolars::ReachIntercept(const int index, const AFlatGeoPoint &flat_origin,
+                            const GeoPoint &origin,
+                            const RasterMap *map,
+                            const FlatProjection &proj,
+                            const ReachAirspaceMask *airspace) const noexcept
+{
+  const bool valid = map && map->IsDefined();
+  const int altitude = flat_origin.altitude - GetSafetyHeight();
+  const FlatGeoPoint flat_dest = MSLIntercept(index, flat_origin,
+                                              altitude, proj);
+
+  if (!valid && airspace == nullptr)
+    return flat_dest;
+
+  const GeoPoint dest = proj.Unproject(flat_dest);
+  GeoPoint p = valid
+    ? map->GroundIntersection(origin, altitude, altitude, dest,
+                              height_min_working)
+    : GeoPoint::Invalid();
+
+  if (airspace != nullptr)
+    p = AirspaceIntercept(flat_origin, origin, dest, p, *airspace);
+
+  return ClipIntercept(flat_origin, flat_dest, p, proj);
+}
+
+void
+RoutePolars::ReachIntercepts(const int index_low, const int index_high,
+                             const AFlatGeoPoint &flat_origin,
+                             const GeoPoint &origin,
+                             const RasterMap *map,
+                             const FlatProjection &proj,
+                             std::span<FlatGeoPoint> results,
+                             const ReachAirspaceMask *airspace) const noexcept
+{
+  assert(index_low <= index_high);
+  assert(results.size() == std::size_t(index_high - index_low));
+  assert(results.size() <= ROUTEPOLAR_POINTS);
+
+  const bool valid = map && map->IsDefined();
+  const int altitude = flat_origin.altitude - GetSafetyHeight();
+
+  GeoPoint destinations[ROUTEPOLAR_POINTS];
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    results[i] = MSLIntercept(index_low + int(i), flat_origin, altitude, proj);
+    if (valid || airspace != nullptr)
+      destinations[i] = proj.Unproject(results[i]);
+  }
+
+  if (!valid && airspace == nullptr)
+    return;
+
+  GeoPoint intersections[ROUTEPOLAR_POINTS];
+  if (valid)
+    map->GroundIntersections(origin, altitude, altitude,
+                             std::span{destinations, results.size()},
+                             height_min_working,
+                             std::span{intersections, results.size()});
+  else
+    std::fill_n(intersections, results.size(), GeoPoint::Invalid());
+
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    if (airspace != nullptr)
+      intersections[i] = AirspaceIntercept(flat_origin, origin,
+                                           destinations[i], intersections[i],
+                                           *airspace);
+
+    results[i] = ClipIntercept(flat_origin, results[i], intersections[i],
+                               proj);
+  }
+}
@@ -8,12 +8,15 @@
 #include "Point.hpp"
 
 #include <optional>
+#include <span>
 #include <limits.h>
 
 class GlidePolar;
 struct GlideSettings;
 class FlatProjection;
 class RasterMap;
+class ReachAirspaceMask;
+class RoutePolarCache;
 struct SpeedVector;
 struct GeoPoint;
 struct AGeoPoint;
@@ -55,6 +58,14 @@ public:
                   const SpeedVector& wind,
                   const int _height_min_working=0) noexcept;
 
+  /**
+   * Like Initialise(), but obtain the tables from the cache, which
+   * quantizes the wind (see RoutePolarCache).
+   */
+  void Initialise(const GlideSettings &settings, const GlidePolar& polar,
+                  const SpeedVector& wind, RoutePolarCache &cache,
+                  const int _height_min_working=0) noexcept;
+
   /**
    * Calculate the time required to fly the link.  Returns UINT_MAX
    * if flight is impossible.  Climbs above the cruise altitude
@@ -227,6 +238,29 @@ public:
                        const FlatGeoPoint &dest,
                        const FlatProjection &proj) const noexcept;
 
+  /**
+   * Does the other object have the same glide performance and
+   * configuration, i.e. would a reach calculation give the same
+   * result?  The altitude dependent attributes are ignored, because
+   * the reach assumes pure glide.
+   */
+  [[gnu::pure]]
+  bool IsSameGlide(const RoutePolars &other) const noexcept {
+    return polar_glide == other.polar_glide &&
+      height_min_working == other.height_min_working &&
+      config == other.config;
+  }
+
+  /**
+   * Like IsSameGlide(), but also compare the cruise-climb
+   * performance, which the route planner uses.
+   */
+  [[gnu::pure]]
+  bool IsSamePerformance(const RoutePolars &other) const noexcept {
+    return IsSameGlide(other) && polar_cruise == other.polar_cruise &&
+      inv_mc == other.inv_mc;
+  }
+
   int GetSafetyHeight() const noexcept {
     return config.safety_height_terrain;
   }
@@ -235,13 +269,53 @@ public:
     return height_min_working;
   }
 
+  /**
+   * @param airspace an optional mask of airspace obstacles, which
+   * limits the intercept just like terrain does
+   */
   [[gnu::pure]]
   FlatGeoPoint ReachIntercept(int index, const AFlatGeoPoint &flat_origin,
                               const GeoPoint &origin,
                               const RasterMap* map,
-                              const FlatProjection &proj) const noexcept;
+                              const FlatProjection &proj,
+                              const ReachAirspaceMask *airspace=nullptr) const noexcept;
+
+  /**
+   * Like ReachIntercept() for all indices from #index_low to
+   * #index_high (excluding), tracing the rays as one fan (see
+   * RasterMap::GroundIntersections()).
+   *
+   * @param results receives one point per index
+   */
+  void ReachIntercepts(int index_low, int index_high,
+                       const AFlatGeoPoint &flat_origin,
+                       const GeoPoint &origin,
+                       const RasterMap *map,
+                       const FlatProjection &proj,
+                       std::span<FlatGeoPoint> results,
+                       const ReachAirspaceMask *airspace=nullptr) const noexcept;
 
 private:
+  /**
+   * Apply the result of a terrain intersection search to the MSL
+   * intercept #flat_dest.
+   */
+  [[gnu::pure]]
+  static FlatGeoPoint ClipIntercept(const FlatGeoPoint &flat_origin,
+                                    const FlatGeoPoint &flat_dest,
+                                    const GeoPoint &p,
+                                    const FlatProjection &proj) noexcept;
+
+  /**
+   * Limit the terrain intersection #p (may be invalid) of the glide
+   * from #origin to #dest with the airspace mask.
+   */
+  [[gnu::pure]]
+  GeoPoint AirspaceIntercept(const AFlatGeoPoint &flat_origin,
+                             const GeoPoint &origin, const GeoPoint &dest,
+                             const GeoPoint &p,
+                             const ReachAirspaceMask &airspace) const noexcept;
+
   [[gnu::pure]]
   FlatGeoPoint MSLIntercept(const int index, const FlatGeoPoint &p,
                             double altitude,
@@ -4,8 +4,11 @@
 #include "TerrainRoute.hpp"
 #include "ReachResult.hpp"
 #include "ReachFan.hpp"
+#include "GlideClearance.hpp"
 #include "Terrain/RasterMap.hpp"
 
+#include <array>
+
 void
 TerrainRoute::UpdatePolar(const GlideSettings &settings,
                           const RoutePlannerConfig &config,
@@ -23,15 +26,26 @@ TerrainRoute::UpdatePolar(const GlideSettings &settings,
     break;
   case RoutePlannerConfig::Polar::SAFETY:
     rpolars_reach.SetConfig(config);
-    rpolars_reach.Initialise(settings, safety_polar, wind);
+    rpolars_reach.Initialise(settings, safety_polar, wind, polar_cache);
     break;
   }
 
   rpolars_reach_working.SetConfig(config);
-  rpolars_reach_working.Initialise(settings, task_polar, wind,
+  rpolars_reach_working.Initialise(settings, task_polar, wind, polar_cache,
                                    height_min_working);
 }
 
+RoutePolars
+TerrainRoute::PrepareReach(const AGeoPoint &origin,
+                           const RoutePlannerConfig &config,
+                           const int h_ceiling,
+                           const bool working) noexcept
+{
+  auto &rpolars = working ? rpolars_reach_working : rpolars_reach;
+  rpolars.SetConfig(config, origin.altitude, h_ceiling);
+  return rpolars;
+}
+
 ReachFan
 TerrainRoute::SolveReach(const AGeoPoint &origin,
                          const RoutePlannerConfig &config,
@@ -39,8 +53,7 @@ TerrainRoute::SolveReach(const AGeoPoint &origin,
                          const bool do_solve,
                          const bool working) noexcept
 {
-  auto &rpolars = working ? rpolars_reach_working : rpolars_reach;
-  rpolars.SetConfig(config, origin.altitude, h_ceiling);
+  const auto rpolars = PrepareReach(origin, config, h_ceiling, working);
 
   ReachFan reach;
   reach.Solve(origin, rpolars, terrain, do_solve);
@@ -69,6 +82,49 @@ TerrainRoute::Intersection(const AGeoPoint &origin,
   return rpolars_route.Intersection(origin, destination, terrain, proj);
 }
 
+void
+TerrainRoute::CalcGlideClearance(const AGeoPoint &origin,
+                                 const AGeoPoint &destination,
+                                 GlideClearanceProfile &profile) const noexcept
+{
+  profile.Clear();
+
+  if (terrain == nullptr || !terrain->IsDefined())
+    return;
+
+  const FlatProjection proj(origin);
+  const RouteLink e(RoutePoint(proj.ProjectInteger(destination),
+                               destination.altitude),
+                    RoutePoint(proj.ProjectInteger(origin), origin.altitude),
+                    proj);
+  if (e.d <= 0)
+    return;
+
+  /* the height lost on the whole glide; it is proportional to the
+     distance */
+  const double vh = rpolars_route.CalcVHeight(e);
+
+  constexpr unsigned n = GlideClearanceProfile::N_SAMPLES;
+
+  std::array<GeoPoint, n> locations;
+  for (unsigned i = 0; i < n; ++i)
+    locations[i] = origin.Interpolate(destination, double(i + 1) / n);
+
+  std::array<TerrainHeight, n> heights;
+  terrain->GetHeights(locations, heights);
+
+  profile.minimum = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    const double glide_altitude = origin.altitude - vh * (i + 1) / n;
+    profile.clearance[i] = int(glide_altitude) - heights[i].GetValueOr0();
+    if (profile.clearance[i] < profile.clearance[profile.minimum])
+      profile.minimum = i;
+  }
+
+  profile.distance = origin.Distance(destination);
+  profile.n_samples = n;
+}
+
 bool
 TerrainRoute::IsClear(const RouteLink &e) const noexcept
 {
@@ -6,6 +6,7 @@
 #include "RoutePlanner.hpp"
 
 class ReachFan;
+struct GlideClearanceProfile;
 
 /**
  * Specialization of #RoutePlanner which implements terrain avoidance.
@@ -38,6 +39,10 @@ public:
     terrain = _terrain;
   }
 
+  const RasterMap *GetTerrain() const noexcept {
+    return terrain;
+  }
+
   const auto &GetReachPolar() const noexcept {
     return rpolars_reach;
   }
@@ -49,6 +54,17 @@ public:
                    const SpeedVector &wind,
                    int height_min_working=0) noexcept;
 
+  /**
+   * Configure the reach polar for a solve from the given origin.
+   *
+   * @return a copy of the configured polar; it can be passed to
+   * ReachFan::Solve() (together with GetTerrain()) without further
+   * access to this object
+   */
+  RoutePolars PrepareReach(const AGeoPoint &origin,
+                           const RoutePlannerConfig &config,
+                           int h_ceiling, bool working) noexcept;
+
   /**
    * Solve reach footprint to terrain or working height.
    *
@@ -76,6 +92,20 @@ public:
   GeoPoint Intersection(const AGeoPoint &origin,
                         const AGeoPoint &destination) const noexcept;
 
+  /**
+   * Sample the clearance of the straight glide from origin to
+   * destination above the terrain.  The terrain heights are looked
+   * up in one batch.
+   *
+   * @param origin Aircraft location
+   * @param destination Target
+   * @param profile receives the result; it is cleared if there is
+   * no terrain
+   */
+  void CalcGlideClearance(const AGeoPoint &origin,
+                          const AGeoPoint &destination,
+                          GlideClearanceProfile &profile) const noexcept;
+
 protected:
   bool IsClear(const RouteLink &e) const noexcept override;
   void AddNearby(const RouteLink &e) noexcept override;
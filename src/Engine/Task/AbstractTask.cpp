@@ -86,7 +86,8 @@ AbstractTask::UpdateIdle(const AircraftState &state,
 
   if (stats.start.HasStarted() && task_behaviour.calc_cruise_efficiency &&
       valid) {
-    double val = 1;
+    /* start the search at the previous solution */
+    double val = stats.cruise_efficiency;
     if (CalcCruiseEfficiency(state, glide_polar, val))
       stats.cruise_efficiency = std::max(ce_lpf.Update(val), 0.);
   } else {
@@ -95,7 +96,7 @@ AbstractTask::UpdateIdle(const AircraftState &state,
 
   if (stats.start.HasStarted() && task_behaviour.calc_effective_mc &&
       valid) {
-    auto val = glide_polar.GetMC();
+    auto val = stats.effective_mc;
     if (CalcEffectiveMC(state, glide_polar, val))
       stats.effective_mc = std::max(em_lpf.Update(val), 0.);
   } else {
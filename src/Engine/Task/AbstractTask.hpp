@@ -191,7 +191,8 @@ protected:
    * task start time.
    *
    * @param state_now Aircraft state
-   * @param value Output cruise efficiency value (0-)
+   * @param val Previous cruise efficiency value as initial guess;
+   * output cruise efficiency value (0-)
    *
    * @return True if cruise efficiency is updated
    */
@@ -210,7 +211,8 @@ protected:
    * task start time.
    *
    * @param state_now Aircraft state
-   * @param val Output calculated effective mc
+   * @param val Previous effective mc as initial guess; output
+   * calculated effective mc
    *
    * @return True if cruise efficiency is updated
    */
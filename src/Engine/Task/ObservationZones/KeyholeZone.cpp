@@ -41,3 +41,12 @@ KeyholeZone::IsInSector(const GeoPoint &location) const noexcept
   return f.distance <= GetInnerRadius() ||
     (f.distance <= GetRadius() && IsAngleInSector(f.bearing));
 }
+
+bool
+KeyholeZone::HasSameBoundary(const ObservationZonePoint &other) const noexcept
+{
+  const KeyholeZone &z = (const KeyholeZone &)other;
+
+  return SymmetricSectorZone::HasSameBoundary(other) &&
+    inner_radius == z.inner_radius;
+}
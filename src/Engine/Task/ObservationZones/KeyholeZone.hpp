@@ -92,6 +92,8 @@ public:
   double ScoreAdjustment() const noexcept override;
 
   /* virtual methods from class ObservationZonePoint */
+  bool HasSameBoundary(const ObservationZonePoint &other) const noexcept override;
+
   std::unique_ptr<ObservationZonePoint> Clone(const GeoPoint &_reference) const noexcept override {
     return std::make_unique<KeyholeZone>(*this, _reference);
   }
@@ -6,6 +6,14 @@
 #include "Boundary.hpp"
 #include "Task/Points/TaskPoint.hpp"
 
+struct ObservationZoneClient::CachedBoundary {
+  const std::unique_ptr<ObservationZonePoint> oz;
+  const OZBoundary boundary;
+
+  explicit CachedBoundary(const ObservationZonePoint &_oz) noexcept
+    :oz(_oz.Clone()), boundary(_oz.GetBoundary()) {}
+};
+
 ObservationZoneClient::~ObservationZoneClient() noexcept = default;
 
 bool
@@ -38,6 +46,26 @@ ObservationZoneClient::GetBoundary() const noexcept
   return oz_point->GetBoundary();
 }
 
+const OZBoundary *
+ObservationZoneClient::GetCachedBoundary() const noexcept
+{
+  if (cached_boundary == nullptr ||
+      !cached_boundary->oz->HasSameBoundary(*oz_point))
+    return nullptr;
+
+  return &cached_boundary->boundary;
+}
+
+const OZBoundary &
+ObservationZoneClient::UpdateBoundary() noexcept
+{
+  if (const auto *boundary = GetCachedBoundary())
+    return *boundary;
+
+  cached_boundary = std::make_shared<const CachedBoundary>(*oz_point);
+  return cached_boundary->boundary;
+}
+
 bool
 ObservationZoneClient::TransitionConstraint(const GeoPoint &location,
                                             const GeoPoint &last_location) const noexcept
@@ -16,6 +16,15 @@ struct GeoPoint;
 class ObservationZoneClient {
   const std::unique_ptr<ObservationZonePoint> oz_point;
 
+  struct CachedBoundary;
+
+  /**
+   * The boundary generated by UpdateBoundary(), together with a copy
+   * of the OZ it was generated from.  It is immutable and may be
+   * shared with copies of this object.
+   */
+  std::shared_ptr<const CachedBoundary> cached_boundary;
+
 public:
   /**
    * Constructor.  Transfers ownership of the OZ to this object.
@@ -53,6 +62,28 @@ public:
   [[gnu::pure]]
   OZBoundary GetBoundary() const noexcept;
 
+  /**
+   * Like GetBoundary(), but reuse the boundary generated by the
+   * previous call if the OZ has not changed since.
+   */
+  const OZBoundary &UpdateBoundary() noexcept;
+
+  /**
+   * Returns the boundary generated by UpdateBoundary() if it is still
+   * valid, nullptr otherwise.
+   */
+  [[gnu::pure]]
+  const OZBoundary *GetCachedBoundary() const noexcept;
+
+  /**
+   * Reuse the cached boundary of another OZ client, e.g. the one this
+   * object was cloned from.  It will only be used if the OZ
+   * parameters match.
+   */
+  void ShareBoundary(const ObservationZoneClient &other) noexcept {
+    cached_boundary = other.cached_boundary;
+  }
+
   [[gnu::pure]]
   virtual double ScoreAdjustment() const noexcept;
 
@@ -53,6 +53,16 @@ public:
   [[gnu::pure]]
   virtual bool Equals(const ObservationZonePoint &other) const noexcept;
 
+  /**
+   * Test whether GetBoundary() of the other OZ returns the same
+   * points.  Unlike Equals(), this includes the orientation derived
+   * from the legs.
+   */
+  [[gnu::pure]]
+  virtual bool HasSameBoundary(const ObservationZonePoint &other) const noexcept {
+    return Equals(other);
+  }
+
   /**
    * Generate a random location inside the OZ (to be used for testing)
    *
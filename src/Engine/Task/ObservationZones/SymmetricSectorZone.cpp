@@ -41,3 +41,10 @@ SymmetricSectorZone::Equals(const ObservationZonePoint &other) const noexcept
 
   return CylinderZone::Equals(other) && sector_angle == z.GetSectorAngle();
 }
+
+bool
+SymmetricSectorZone::HasSameBoundary(const ObservationZonePoint &other) const noexcept
+{
+  /* the sector angle alone doesn't determine the orientation */
+  return SectorZone::Equals(other) && Equals(other);
+}
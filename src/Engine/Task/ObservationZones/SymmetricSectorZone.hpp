@@ -88,6 +88,7 @@ public:
   /* virtual methods from class ObservationZonePoint */
   void SetLegs(const GeoPoint *previous, const GeoPoint *next) noexcept override;
   bool Equals(const ObservationZonePoint &other) const noexcept override;
+  bool HasSameBoundary(const ObservationZonePoint &other) const noexcept override;
 
   /* virtual methods from class ObservationZonePoint */
   std::unique_ptr<ObservationZonePoint> Clone(const GeoPoint &_reference) const noexcept override {
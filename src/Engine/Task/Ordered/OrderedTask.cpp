@@ -592,8 +592,9 @@ OrderedTask::UpdateIdle(const AircraftState &state,
   if (HasStart() && task_behaviour.optimise_targets_range &&
       GetOrderedTaskSettings().aat_min_time.count() > 0) {
 
-    CalcMinTarget(state, glide_polar,
-                  GetOrderedTaskSettings().aat_min_time + task_behaviour.optimise_targets_margin);
+    min_target_hint =
+      CalcMinTarget(state, glide_polar,
+                    GetOrderedTaskSettings().aat_min_time + task_behaviour.optimise_targets_margin);
 
     if (task_behaviour.optimise_targets_bearing &&
         task_points[active_task_point]->GetType() == TaskPointType::AAT) {
@@ -603,7 +604,8 @@ OrderedTask::UpdateIdle(const AircraftState &state,
       TaskOptTarget tot(tps, active_task_point, state,
                         task_behaviour.glide, glide_polar,
                         *ap, task_projection, *taskpoint_start);
-      tot.search(0.5);
+      const auto p = tot.search(opt_target_hint);
+      opt_target_hint = p >= 0 ? p : 0.5;
     }
     retval = true;
   }
@@ -999,7 +1001,7 @@ OrderedTask::CalcCruiseEfficiency(const AircraftState &aircraft,
     TaskPointList tps(task_points);
     TaskCruiseEfficiency bce(tps, active_task_point, aircraft,
                              task_behaviour.glide, glide_polar);
-    val = bce.search(1);
+    val = bce.search(val);
     return true;
   } else {
     val = 1;
@@ -1016,7 +1018,7 @@ OrderedTask::CalcEffectiveMC(const AircraftState &aircraft,
     TaskPointList tps(task_points);
     TaskEffectiveMacCready bce(tps, active_task_point, aircraft,
                                task_behaviour.glide, glide_polar);
-    val = bce.search(glide_polar.GetMC());
+    val = bce.search(val);
     return true;
   } else {
     val = glide_polar.GetMC();
@@ -1038,7 +1040,7 @@ OrderedTask::CalcMinTarget(const AircraftState &aircraft,
     TaskMinTarget bmt(tps, active_task_point, aircraft,
                       task_behaviour.glide, glide_polar,
                       t_rem, *taskpoint_start);
-    auto p = bmt.search(0);
+    auto p = bmt.search(min_target_hint);
     return p;
   }
 
@@ -1096,6 +1098,8 @@ OrderedTask::Reset() noexcept
   stats.task_finished = false;
   stats.start.Reset();
   task_advance.Reset();
+  min_target_hint = 0;
+  opt_target_hint = 0.5;
   SetActiveTaskPoint(0);
   UpdateStatsGeometry();
 }
@@ -1203,6 +1207,14 @@ OrderedTask::HasTargets() const
 
 std::unique_ptr<OrderedTask>
 OrderedTask::Clone(const TaskBehaviour &tb) const noexcept
+{
+  auto new_task = CloneDefinition(tb);
+  new_task->UpdateGeometry();
+  return new_task;
+}
+
+std::unique_ptr<OrderedTask>
+OrderedTask::CloneDefinition(const TaskBehaviour &tb) const noexcept
 {
   auto new_task = std::make_unique<OrderedTask>(tb);
 
@@ -1210,14 +1222,15 @@ OrderedTask::Clone(const TaskBehaviour &tb) const noexcept
 
   new_task->ordered_settings = ordered_settings;
 
+  new_task->task_points.reserve(task_points.size());
   for (const auto &tp : task_points)
     new_task->Append(*tp);
 
+  new_task->optional_start_points.reserve(optional_start_points.size());
   for (const auto &tp : optional_start_points)
     new_task->AppendOptionalStart(*tp);
 
   new_task->active_task_point = active_task_point;
-  new_task->UpdateGeometry();
 
   new_task->SetName(GetName());
 
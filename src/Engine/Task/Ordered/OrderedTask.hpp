@@ -65,6 +65,12 @@ private:
 
   GeoPoint last_min_location;
 
+  /**
+   * The solutions of the previous target optimisation, used as
+   * initial guess for the next one.
+   */
+  double min_target_hint = 0, opt_target_hint = 0.5;
+
   TaskFactoryType factory_mode;
   std::unique_ptr<AbstractTaskFactory> active_factory;
   OrderedTaskSettings ordered_settings;
@@ -142,6 +148,15 @@ public:
    */
   std::unique_ptr<OrderedTask> Clone(const TaskBehaviour &tb) const noexcept;
 
+  /**
+   * Like Clone(), but the geometry of the new task is not calculated
+   * yet; the caller must call UpdateGeometry() on it before using
+   * it.  The new task does not share mutable state with this one, so
+   * this allows running the (expensive) geometry calculation after
+   * the lock protecting this task has been released.
+   */
+  std::unique_ptr<OrderedTask> CloneDefinition(const TaskBehaviour &tb) const noexcept;
+
   /**
    * Copy task into this task
    *
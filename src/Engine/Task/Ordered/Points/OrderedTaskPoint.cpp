@@ -47,7 +47,7 @@ OrderedTaskPoint::UpdateOZ(const FlatProjection &projection) noexcept
 {
   UpdateGeometry();
 
-  SampledTaskPoint::UpdateOZ(projection, GetBoundary());
+  SampledTaskPoint::UpdateOZ(projection, UpdateBoundary());
 }
 
 bool
@@ -132,39 +132,47 @@ OrderedTaskPoint::Clone(const TaskBehaviour &task_behaviour,
   if (!waypoint)
     waypoint = GetWaypointPtr();
 
+  std::unique_ptr<OrderedTaskPoint> dest;
+
   switch (GetType()) {
   case TaskPointType::START:
-    return std::make_unique<StartPoint>(GetObservationZone().Clone(waypoint->location),
+    dest = std::make_unique<StartPoint>(GetObservationZone().Clone(waypoint->location),
                                         std::move(waypoint), task_behaviour,
                                         ordered_task_settings.start_constraints);
+    break;
 
   case TaskPointType::AST: {
     const ASTPoint &src = *(const ASTPoint *)this;
-    auto dest =
+    auto ast =
       std::make_unique<ASTPoint>(GetObservationZone().Clone(waypoint->location),
                    std::move(waypoint), task_behaviour, IsBoundaryScored());
-    dest->SetScoreExit(src.GetScoreExit());
-    return dest;
+    ast->SetScoreExit(src.GetScoreExit());
+    dest = std::move(ast);
+    break;
   }
 
   case TaskPointType::AAT:
-    return std::make_unique<AATPoint>(GetObservationZone().Clone(waypoint->location),
+    dest = std::make_unique<AATPoint>(GetObservationZone().Clone(waypoint->location),
                                       std::move(waypoint), task_behaviour);
+    break;
 
   case TaskPointType::FINISH:
-    return std::make_unique<FinishPoint>(GetObservationZone().Clone(waypoint->location),
+    dest = std::make_unique<FinishPoint>(GetObservationZone().Clone(waypoint->location),
                                          std::move(waypoint), task_behaviour,
                                          ordered_task_settings.finish_constraints,
                                          IsBoundaryScored());
+    break;
 
   case TaskPointType::UNORDERED:
     /* an OrderedTaskPoint must never be UNORDERED */
     gcc_unreachable();
     assert(false);
-    break;
+    return NULL;
   }
 
-  return NULL;
+  /* the copy has the same OZ (unless the waypoint was replaced) */
+  dest->ShareBoundary(*this);
+  return dest;
 }
 
 void
@@ -172,8 +180,15 @@ OrderedTaskPoint::ScanBounds(GeoBounds &bounds) const noexcept
 {
   bounds.Extend(GetLocation());
 
-  for (const auto &i : GetBoundary())
-    bounds.Extend(i);
+  const auto Extend = [&bounds](const OZBoundary &boundary){
+    for (const auto &i : boundary)
+      bounds.Extend(i);
+  };
+
+  if (const auto *boundary = GetCachedBoundary())
+    Extend(*boundary);
+  else
+    Extend(GetBoundary());
 }
 
 void
@@ -181,7 +196,7 @@ OrderedTaskPoint::UpdateBoundingBox(const FlatProjection &projection) noexcept
 {
   flat_bb = FlatBoundingBox(projection.ProjectInteger(GetLocation()));
 
-  for (const auto &i : GetBoundary())
+  for (const auto &i : UpdateBoundary())
     flat_bb.Expand(projection.ProjectInteger(i));
 
   flat_bb.ExpandByOne(); // add 1 to fix rounding
@@ -30,9 +30,11 @@ TaskDijkstra::AddEdges(const ScanTaskPoint curNode) noexcept
   ScanTaskPoint destination(curNode.GetStageNumber() + 1, 0);
   const unsigned dsize = GetStageSize(destination.GetStageNumber());
 
+  const GeodesicOrigin origin(GetPoint(curNode).GetLocation());
+
   for (const ScanTaskPoint end(destination.GetStageNumber(), dsize);
        destination != end; destination.IncrementPointIndex())
-    Link(destination, curNode, CalcDistance(curNode, destination));
+    Link(destination, curNode, CalcDistance(origin, destination));
 }
 
 void
@@ -64,9 +66,11 @@ TaskDijkstra::AddStartEdges(unsigned stage,
   ScanTaskPoint destination(stage, 0);
   const unsigned dsize = GetStageSize(stage);
 
+  const GeodesicOrigin origin(currentLocation.GetLocation());
+
   for (const ScanTaskPoint end(stage, dsize);
        destination != end; destination.IncrementPointIndex())
-    LinkStart(destination, CalcDistance(destination, currentLocation));
+    LinkStart(destination, CalcDistance(origin, destination));
 }
 
 bool
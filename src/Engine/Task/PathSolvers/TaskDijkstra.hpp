@@ -5,6 +5,7 @@
 
 #include "PathSolvers/NavDijkstra.hpp"
 #include "Geo/SearchPoint.hpp"
+#include "Geo/Math.hpp"
 
 #include <cassert>
 
@@ -66,6 +67,12 @@ public:
   }
 
 protected:
+  const SearchPointVector &GetBoundary(unsigned stage) const noexcept {
+    assert(stage < num_stages);
+
+    return *boundaries[stage];
+  }
+
   [[gnu::pure]]
   const SearchPoint &GetPoint(ScanTaskPoint sp) const noexcept;
 
@@ -90,38 +97,22 @@ protected:
    */
   void AddStartEdges(unsigned stage, const SearchPoint &loc) noexcept;
 
-  /** 
-   * Distance function for free point
-   * 
-   * @param curNode Destination node
-   * @param currentLocation Origin location
-   * 
+  /**
+   * Distance function for edges
+   *
+   * @param origin Origin location
+   * @param destination Destination node
+   *
    * @return Distance (flat) from origin to destination
    */
   [[gnu::pure]]
-  value_type CalcDistance(const ScanTaskPoint curNode,
-                          const SearchPoint &currentLocation) const noexcept {
+  value_type CalcDistance(const GeodesicOrigin &origin,
+                          const ScanTaskPoint destination) const noexcept {
     /* using expensive floating point formulas here to avoid integer
        rounding errors */
 
-    const GeoPoint &a = GetPoint(curNode).GetLocation();
-    const GeoPoint &b = currentLocation.GetLocation();
-
-    return static_cast<value_type>(a.Distance(b));
-  }
-
-  /** 
-   * Distance function for edges
-   * 
-   * @param s1 Origin node
-   * @param s2 Destination node
-   * 
-   * @return Distance (flat) from origin to destination
-   */
-  [[gnu::pure]]
-  value_type CalcDistance(const ScanTaskPoint s1,
-                          const ScanTaskPoint s2) const noexcept {
-    return CalcDistance(s1, GetPoint(s2));
+    const GeoPoint &b = GetPoint(destination).GetLocation();
+    return static_cast<value_type>(origin.Distance(b));
   }
 
 private:
@@ -3,18 +3,108 @@
 
 #include "TaskDijkstraMin.hpp"
 
+#include <algorithm>
+#include <limits>
+
+[[gnu::pure]]
+static bool
+Equals(const SearchPointVector &a, const SearchPointVector &b) noexcept
+{
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                    [](const SearchPoint &x, const SearchPoint &y){
+                      return x.GetLocation() == y.GetLocation();
+                    });
+}
+
+inline void
+TaskDijkstraMin::Validate() noexcept
+{
+  n_valid_layers = std::min(n_valid_layers, num_stages);
+
+  /* walk from the finish towards the active task point; a change in
+     one boundary invalidates all stages before it */
+  for (unsigned i = 0; i < n_valid_layers; ++i) {
+    const unsigned stage = num_stages - 1 - i;
+    if (!Equals(layers[i].points, GetBoundary(stage))) {
+      n_valid_layers = i;
+      break;
+    }
+  }
+}
+
+inline void
+TaskDijkstraMin::UpdateLayer(const unsigned stage) noexcept
+{
+  Layer &layer = GetLayer(stage);
+  layer.points = GetBoundary(stage);
+  layer.nodes.resize(layer.points.size());
+
+  if (IsFinal(stage)) {
+    std::fill(layer.nodes.begin(), layer.nodes.end(), Node{0, 0});
+    return;
+  }
+
+  const Layer &next = GetLayer(stage + 1);
+
+  for (unsigned i = 0; i < layer.nodes.size(); ++i) {
+    const GeodesicOrigin origin(layer.points[i].GetLocation());
+
+    Node best{std::numeric_limits<value_type>::max(), 0};
+    for (unsigned j = 0; j < next.nodes.size(); ++j) {
+      const value_type distance = next.nodes[j].distance +
+        CalcDistance(origin, ScanTaskPoint(stage + 1, j));
+      if (distance < best.distance)
+        best = {distance, j};
+    }
+
+    layer.nodes[i] = best;
+  }
+}
+
 bool
 TaskDijkstraMin::DistanceMin(const SearchPoint &currentLocation) noexcept
 {
-  dijkstra.Clear();
-  dijkstra.Reserve(256);
+  if (num_stages == 0)
+    return false;
+
+  for (unsigned stage = 0; stage < num_stages; ++stage)
+    if (GetBoundary(stage).empty())
+      /* no way to reach the finish */
+      return false;
+
+  Validate();
 
-  if (currentLocation.IsValid()) {
-    AddStartEdges(0, currentLocation);
-  } else {
-    AddZeroStartEdges();
+  for (; n_valid_layers < num_stages; ++n_valid_layers)
+    UpdateLayer(num_stages - 1 - n_valid_layers);
+
+  /* the only part which depends on the aircraft location: the edges
+     to the first stage */
+  const Layer &first = GetLayer(0);
+
+  value_type best_distance = std::numeric_limits<value_type>::max();
+  unsigned best = 0;
+
+  /* without a location, add some bias preferring the first point;
+     see TaskDijkstra::AddZeroStartEdges() */
+  const GeodesicOrigin origin(currentLocation.IsValid()
+                              ? currentLocation.GetLocation()
+                              : GeoPoint::Zero());
+
+  for (unsigned i = 0; i < first.nodes.size(); ++i) {
+    const value_type start = currentLocation.IsValid()
+      ? CalcDistance(origin, ScanTaskPoint(0, i))
+      : value_type(i);
+
+    const value_type distance = start + first.nodes[i].distance;
+    if (distance < best_distance) {
+      best_distance = distance;
+      best = i;
+    }
   }
 
-  return Run();
-}
+  solution[0] = best;
+  for (unsigned stage = 0; stage + 1 < num_stages; ++stage)
+    solution[stage + 1] = GetLayer(stage).nodes[solution[stage]].next;
 
+  return true;
+}
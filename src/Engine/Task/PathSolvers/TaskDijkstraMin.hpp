@@ -4,11 +4,61 @@
 #pragma once
 
 #include "TaskDijkstra.hpp"
+#include "Geo/SearchPointVector.hpp"
+
+#include <array>
+#include <vector>
 
 /**
- * Specialisation of TaskDijkstra for minimum distance search
+ * Specialisation of TaskDijkstra for minimum distance search.
+ *
+ * The search graph is layered (each stage is only linked to the
+ * next one), and only the edges from the aircraft to the first stage
+ * depend on the aircraft location.  Therefore, this class does not
+ * run a Dijkstra search, but keeps the shortest remaining distance
+ * from each boundary point to the finish in a cache, which is
+ * computed backwards from the finish one stage at a time.  A stage
+ * is recomputed only if its boundary or the one of a later stage has
+ * changed, so a routine update (the aircraft has moved, the active
+ * sector has a new sample) costs at most one stage plus the edges
+ * from the aircraft.
  */
 class TaskDijkstraMin final : public TaskDijkstra {
+  struct Node {
+    /**
+     * The shortest distance from this point to the finish.
+     */
+    value_type distance;
+
+    /**
+     * The index of the next point on the shortest path to the
+     * finish.
+     */
+    unsigned next;
+  };
+
+  /**
+   * The cached search results of one stage.  They are indexed by the
+   * number of stages after this one, which does not change when the
+   * active task point advances.
+   */
+  struct Layer {
+    /**
+     * A copy of the boundary which #nodes has been calculated from.
+     */
+    SearchPointVector points;
+
+    std::vector<Node> nodes;
+  };
+
+  std::array<Layer, MAX_STAGES> layers;
+
+  /**
+   * The number of entries in #layers (counted from the finish) which
+   * are up to date.
+   */
+  unsigned n_valid_layers = 0;
+
 public:
   TaskDijkstraMin() noexcept
     :TaskDijkstra(true) {}
@@ -27,4 +77,23 @@ public:
    * @return True if succeeded
    */
   bool DistanceMin(const SearchPoint &location) noexcept;
+
+private:
+  Layer &GetLayer(unsigned stage) noexcept {
+    assert(stage < num_stages);
+
+    return layers[num_stages - 1 - stage];
+  }
+
+  /**
+   * Discard the cached layers whose boundary (or a later one) has
+   * changed since they were calculated.
+   */
+  void Validate() noexcept;
+
+  /**
+   * Calculate the cached distances of the specified stage; the
+   * layers of all later stages must be valid.
+   */
+  void UpdateLayer(unsigned stage) noexcept;
 };
@@ -500,6 +500,12 @@ TaskManager::Clone(const TaskBehaviour &tb) const noexcept
   return ordered_task->Clone(tb);
 }
 
+std::unique_ptr<OrderedTask>
+TaskManager::CloneDefinition(const TaskBehaviour &tb) const noexcept
+{
+  return ordered_task->CloneDefinition(tb);
+}
+
 bool
 TaskManager::Commit(const OrderedTask &other)
 {
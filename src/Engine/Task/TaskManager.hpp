@@ -268,6 +268,11 @@ public:
    */
   std::unique_ptr<OrderedTask> Clone(const TaskBehaviour &tb) const noexcept;
 
+  /**
+   * @see OrderedTask::CloneDefinition()
+   */
+  std::unique_ptr<OrderedTask> CloneDefinition(const TaskBehaviour &tb) const noexcept;
+
   /**
    * Copy task into this task
    *
@@ -6,8 +6,9 @@
 #include "AlternateList.hpp"
 #include "Navigation/Aircraft.hpp"
 #include "Task/Visitors/TaskPointVisitor.hpp"
-#include "Task/Solvers/TaskSolution.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
+#include "GlideSolvers/GlideState.hpp"
+#include "GlideSolvers/MacCready.hpp"
 #include "Waypoint/Waypoints.hpp"
 
 /** min search range in m */
@@ -112,16 +113,31 @@ AbortTask::FillReachable(const AircraftState &state,
   AlternateList q;
   q.reserve(32);
 
+  const auto max_ld = polar.GetMaxLDOverGround(state.wind.norm);
+
   for (auto v = approx_waypoints.begin(); v != approx_waypoints.end();) {
     if (only_airfield && !v->waypoint->IsAirport()) {
       ++v;
       continue;
     }
 
-    UnorderedTaskPoint t(v->waypoint, task_behaviour);
-    GlideResult result =
-        TaskSolution::GlideSolutionRemaining(t, state,
-                                             task_behaviour.glide, polar);
+    /* the solution is kept in the candidate list, to be reused by the
+       following passes */
+    if (!v->solution.IsDefined()) {
+      UnorderedTaskPoint t(v->waypoint, task_behaviour);
+      const GlideState gs = GlideState::Remaining(t, state, 0);
+
+      if (final_glide &&
+          gs.altitude_difference * max_ld < gs.vector.distance) {
+        /* out of glide range even with the most favourable wind */
+        ++v;
+        continue;
+      }
+
+      v->solution = MacCready::Solve(task_behaviour.glide, polar, gs);
+    }
+
+    const GlideResult &result = v->solution;
 
     if (IsReachable(result, final_glide)) {
       bool intersects = false;
@@ -3,36 +3,158 @@
 
 #include "Trace.hpp"
 #include "Vector.hpp"
-#include "util/GlobalSliceAllocator.hxx"
 
 #include <algorithm>
 #include <iterator>
 
 Trace::Trace(const Time _no_thin_time, const Time max_time,
              const unsigned max_size) noexcept
-  :cached_size(0),
+  :nodes(new TraceDelta[max_size]),
+   cached_size(0),
    max_time(max_time),
    no_thin_time(_no_thin_time),
    max_size(max_size),
    opt_size((3 * max_size) / 4)
 {
   assert(max_size >= 4);
+
+  free_nodes.reserve(max_size);
+  for (unsigned i = max_size; i-- > 0;)
+    free_nodes.push_back(&nodes[i]);
+
+  delta_heap.reserve(max_size);
+  suppressed.reserve(max_size);
+}
+
+inline Trace::TraceDelta &
+Trace::AllocateNode(const TracePoint &point) noexcept
+{
+  assert(!free_nodes.empty());
+
+  TraceDelta &td = *free_nodes.back();
+  free_nodes.pop_back();
+
+  td.point = point;
+  td.elim_time = null_time;
+  td.elim_distance = null_delta;
+  td.delta_distance = 0;
+  assert(td.heap_index == TraceDelta::NOT_IN_HEAP);
+  return td;
+}
+
+inline void
+Trace::FreeNode(TraceDelta &td) noexcept
+{
+  assert(td.heap_index == TraceDelta::NOT_IN_HEAP);
+
+  free_nodes.push_back(&td);
+}
+
+void
+Trace::EraseNode(TraceDelta &td) noexcept
+{
+  chronological_list.erase(chronological_list.iterator_to(td));
+  HeapErase(td);
+  FreeNode(td);
+  --cached_size;
+}
+
+void
+Trace::HeapSiftUp(TraceDelta &td) noexcept
+{
+  unsigned i = td.heap_index;
+  while (i > 0) {
+    const unsigned parent = (i - 1) / 2;
+    if (!TraceDelta::DeltaRank(td, *delta_heap[parent]))
+      break;
+
+    HeapMove(*delta_heap[parent], i);
+    i = parent;
+  }
+
+  HeapMove(td, i);
+}
+
+void
+Trace::HeapSiftDown(TraceDelta &td) noexcept
+{
+  const unsigned n = delta_heap.size();
+  unsigned i = td.heap_index;
+  while (true) {
+    unsigned child = 2 * i + 1;
+    if (child >= n)
+      break;
+
+    if (child + 1 < n &&
+        TraceDelta::DeltaRank(*delta_heap[child + 1], *delta_heap[child]))
+      ++child;
+
+    if (!TraceDelta::DeltaRank(*delta_heap[child], td))
+      break;
+
+    HeapMove(*delta_heap[child], i);
+    i = child;
+  }
+
+  HeapMove(td, i);
+}
+
+void
+Trace::HeapPush(TraceDelta &td) noexcept
+{
+  assert(td.heap_index == TraceDelta::NOT_IN_HEAP);
+
+  td.heap_index = delta_heap.size();
+  delta_heap.push_back(&td);
+  HeapSiftUp(td);
+}
+
+void
+Trace::HeapErase(TraceDelta &td) noexcept
+{
+  assert(td.heap_index < delta_heap.size());
+  assert(delta_heap[td.heap_index] == &td);
+
+  TraceDelta &last = *delta_heap.back();
+  delta_heap.pop_back();
+
+  if (&last != &td) {
+    HeapMove(last, td.heap_index);
+    HeapUpdate(last);
+  }
+
+  td.heap_index = TraceDelta::NOT_IN_HEAP;
+}
+
+void
+Trace::HeapUpdate(TraceDelta &td) noexcept
+{
+  const unsigned i = td.heap_index;
+  if (i > 0 && TraceDelta::DeltaRank(td, *delta_heap[(i - 1) / 2]))
+    HeapSiftUp(td);
+  else
+    HeapSiftDown(td);
 }
 
 void
 Trace::clear() noexcept
 {
-  assert(cached_size == delta_list.size());
+  assert(cached_size == delta_heap.size());
   assert(cached_size == chronological_list.size());
 
   average_delta_distance = 0;
   average_delta_time = {};
 
-  delta_list.clear();
-  chronological_list.clear_and_dispose(MakeDisposer());
+  for (TraceDelta *td : delta_heap)
+    td->heap_index = TraceDelta::NOT_IN_HEAP;
+  delta_heap.clear();
+
+  chronological_list.clear_and_dispose([this](TraceDelta *td){
+    FreeNode(*td);
+  });
   cached_size = 0;
 
-  assert(cached_size == delta_list.size());
+  assert(cached_size == delta_heap.size());
   assert(cached_size == chronological_list.size());
 
   ++modify_serial;
@@ -55,7 +177,7 @@ Trace::GetRecentTime(const Time t) const noexcept
 void
 Trace::UpdateDelta(TraceDelta &td) noexcept
 {
-  assert(cached_size == delta_list.size());
+  assert(cached_size == delta_heap.size() + suppressed.size());
   assert(cached_size == chronological_list.size());
 
   if (&td == &chronological_list.front() ||
@@ -66,30 +188,26 @@ Trace::UpdateDelta(TraceDelta &td) noexcept
   const TraceDelta &previous = *std::prev(ci);
   const TraceDelta &next = *std::next(ci);
 
-  delta_list.erase(delta_list.iterator_to(td));
   td.Update(previous.point, next.point);
-  delta_list.insert(td);
+
+  /* the item may have been taken out temporarily by EraseDelta() */
+  if (td.heap_index != TraceDelta::NOT_IN_HEAP)
+    HeapUpdate(td);
 }
 
 void
-Trace::EraseInside(DeltaList::iterator it) noexcept
+Trace::EraseInside(TraceDelta &td) noexcept
 {
   assert(cached_size > 0);
-  assert(cached_size == delta_list.size());
   assert(cached_size == chronological_list.size());
-  assert(it != delta_list.end());
-
-  const TraceDelta &td = *it;
   assert(!td.IsEdge());
 
   const auto ci = chronological_list.iterator_to(td);
-  TraceDelta &previous = const_cast<TraceDelta &>(*std::prev(ci));
-  TraceDelta &next = const_cast<TraceDelta &>(*std::next(ci));
+  TraceDelta &previous = *std::prev(ci);
+  TraceDelta &next = *std::next(ci);
 
   // now delete the item
-  chronological_list.erase(chronological_list.iterator_to(td));
-  delta_list.erase_and_dispose(it, MakeDisposer());
-  --cached_size;
+  EraseNode(td);
 
   // and update the deltas
   UpdateDelta(previous);
@@ -99,7 +217,7 @@ Trace::EraseInside(DeltaList::iterator it) noexcept
 bool
 Trace::EraseDelta(const unsigned target_size, const Time recent) noexcept
 {
-  assert(cached_size == delta_list.size());
+  assert(cached_size == delta_heap.size());
   assert(cached_size == chronological_list.size());
 
   if (size() <= 2)
@@ -109,19 +227,24 @@ Trace::EraseDelta(const unsigned target_size, const Time recent) noexcept
 
   const Time recent_time = GetRecentTime(recent);
 
-  auto candidate = delta_list.begin();
-  while (size() > target_size) {
-    const TraceDelta &td = *candidate;
+  assert(suppressed.empty());
+
+  while (size() > target_size && !delta_heap.empty()) {
+    TraceDelta &td = *delta_heap.front();
     if (!td.IsEdge() && td.point.GetTime() < recent_time) {
-      EraseInside(candidate);
-      candidate = delta_list.begin(); // find new top
+      EraseInside(td);
       modified = true;
     } else {
-      ++candidate;
-      // suppressed removal, skip it.
+      // suppressed removal, take it out until we're done
+      HeapErase(td);
+      suppressed.push_back(&td);
     }
   }
 
+  for (TraceDelta *td : suppressed)
+    HeapPush(*td);
+  suppressed.clear();
+
   return modified;
 }
 
@@ -133,15 +256,7 @@ Trace::EraseEarlierThan(const Time p_time) noexcept
     return false;
 
   do {
-    auto ci = chronological_list.begin();
-    TraceDelta &td = *ci;
-    chronological_list.erase(ci);
-
-    auto i = delta_list.find(td);
-    assert(i != delta_list.end());
-    delta_list.erase_and_dispose(i, MakeDisposer());
-
-    --cached_size;
+    EraseNode(GetFront());
   } while (!empty() && GetFront().point.GetTime() < p_time);
 
   // need to set deltas for first point, only one of these
@@ -160,17 +275,8 @@ Trace::EraseLaterThan(const Time min_time) noexcept
   assert(min_time.count() > 0);
   assert(!empty());
 
-  while (!empty() && GetBack().point.GetTime() > min_time) {
-    TraceDelta &td = GetBack();
-
-    chronological_list.erase(chronological_list.iterator_to(td));
-
-    auto i = delta_list.find(td);
-    assert(i != delta_list.end());
-    delta_list.erase_and_dispose(i, MakeDisposer());
-
-    --cached_size;
-  }
+  while (!empty() && GetBack().point.GetTime() > min_time)
+    EraseNode(GetBack());
 
   /* need to set deltas for first point, only one of these will occur
      (have to search for this point) */
@@ -184,18 +290,16 @@ Trace::EraseLaterThan(const Time min_time) noexcept
 void
 Trace::EraseStart(TraceDelta &td) noexcept
 {
-  delta_list.erase(delta_list.iterator_to(td));
-
   td.elim_distance = null_delta;
   td.elim_time = null_time;
 
-  delta_list.insert(td);
+  HeapUpdate(td);
 }
 
 void
 Trace::push_back(const TracePoint &point) noexcept
 {
-  assert(cached_size == delta_list.size());
+  assert(cached_size == delta_heap.size());
   assert(cached_size == chronological_list.size());
 
   const Time min_delta = std::chrono::seconds{2};
@@ -230,17 +334,16 @@ Trace::push_back(const TracePoint &point) noexcept
 
   assert(size() < max_size);
 
-  TraceDelta *td = allocator.allocate(1);
-  std::allocator_traits<Allocator>::construct(allocator, td, point);
-  td->point.Project(task_projection);
+  TraceDelta &td = AllocateNode(point);
+  td.point.Project(task_projection);
 
-  delta_list.insert(*td);
-  chronological_list.push_back(*td);
+  HeapPush(td);
+  chronological_list.push_back(td);
 
   ++cached_size;
 
-  if (td != &chronological_list.front())
-    UpdateDelta(*std::prev(chronological_list.iterator_to(*td)));
+  if (&td != &chronological_list.front())
+    UpdateDelta(*std::prev(chronological_list.iterator_to(td)));
 
   ++append_serial;
 }
@@ -323,7 +426,7 @@ Trace::Thin2() noexcept
 void
 Trace::Thin() noexcept
 {
-  assert(cached_size == delta_list.size());
+  assert(cached_size == delta_heap.size());
   assert(cached_size == chronological_list.size());
   assert(size() == max_size);
 
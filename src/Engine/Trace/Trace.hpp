@@ -5,17 +5,15 @@
 
 #include "Point.hpp"
 #include "util/NonCopyable.hpp"
-#include "util/Sanitizer.hxx"
-#include "util/SliceAllocator.hxx"
 #include "util/Serial.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 #include "time/Stamp.hpp"
 
 #include <boost/intrusive/list.hpp>
-#include <boost/intrusive/set.hpp>
 #include <algorithm>
 #include <cassert>
-#include <type_traits>
+#include <memory>
+#include <vector>
 #include <stdlib.h>
 
 class TracePointVector;
@@ -36,8 +34,7 @@ class Trace : private NonCopyable
   using Time = TracePoint::Time;
 
   struct TraceDelta
-    : boost::intrusive::set_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>>,
-      boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>> {
+    : boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>> {
 
     /**
      * Function used to points for sorting by deltas.
@@ -85,6 +82,16 @@ class Trace : private NonCopyable
     unsigned elim_distance;
     unsigned delta_distance;
 
+    static constexpr unsigned NOT_IN_HEAP = 0 - 1;
+
+    /**
+     * The position of this object in Trace::delta_heap, or
+     * #NOT_IN_HEAP.
+     */
+    unsigned heap_index = NOT_IN_HEAP;
+
+    TraceDelta() noexcept = default;
+
     explicit TraceDelta(const TracePoint &p) noexcept
       :point(p),
        elim_time(null_time), elim_distance(null_delta),
@@ -152,29 +159,36 @@ class Trace : private NonCopyable
     }
   };
 
-  /* using multiset, not because we need multiple values (we don't),
-     but to avoid set's overhead for duplicate elimination */
-  typedef boost::intrusive::multiset<TraceDelta,
-                                     boost::intrusive::compare<TraceDelta::DeltaRankOp>,
-                                     boost::intrusive::constant_time_size<false>> DeltaList;
-
   typedef boost::intrusive::list<TraceDelta,
                                  boost::intrusive::constant_time_size<false>> ChronologicalList;
 
   /**
-   * Use a SliceAllocator for allocating TraceDelta instances.  This
-   * reduces a lot of allocation overhead (both CPU and memory),
-   * because there will be lots of these objects.  Fall back to
-   * std::allocator when compiled with AddressSanitizer, because that
-   * avoids hiding memory errors.
+   * Fixed-capacity storage for all #TraceDelta instances, allocated
+   * by the constructor with #max_size elements.  This makes the
+   * memory usage predictable and avoids heap allocations while
+   * appending.
    */
-  using Allocator = std::conditional_t<HaveAddressSanitizer(),
-                                       std::allocator<TraceDelta>,
-                                       SliceAllocator<TraceDelta, 128u>>;
+  const std::unique_ptr<TraceDelta[]> nodes;
 
-  Allocator allocator;
+  /**
+   * The elements of #nodes which are currently unused.
+   */
+  std::vector<TraceDelta *> free_nodes;
+
+  /**
+   * A binary min-heap of all points, ordered by
+   * TraceDelta::DeltaRank().  Each element knows its position
+   * (TraceDelta::heap_index), so it can be repositioned or removed
+   * without searching.
+   */
+  std::vector<TraceDelta *> delta_heap;
+
+  /**
+   * Temporary storage for EraseDelta(): points which may not be
+   * removed are taken out of #delta_heap until it is done.
+   */
+  std::vector<TraceDelta *> suppressed;
 
-  DeltaList delta_list;
   ChronologicalList chronological_list;
   unsigned cached_size;
 
@@ -190,25 +204,6 @@ class Trace : private NonCopyable
 
   Serial append_serial, modify_serial;
 
-  template<typename Alloc>
-  struct Disposer {
-    Alloc &alloc;
-
-    void operator()(typename std::allocator_traits<Alloc>::pointer td) {
-      std::allocator_traits<Alloc>::destroy(alloc, td);
-      alloc.deallocate(td, 1);
-    }
-  };
-
-  template<typename Alloc>
-  static Disposer<Alloc> MakeDisposer(Alloc &alloc) {
-    return {alloc};
-  }
-
-  Disposer<decltype(allocator)> MakeDisposer() {
-    return MakeDisposer(allocator);
-  }
-
 public:
   /**
    * Constructor.  Task projection is updated after first call to append().
@@ -222,10 +217,6 @@ public:
                  const Time max_time = null_time,
                  const unsigned max_size = 1000) noexcept;
 
-  ~Trace() noexcept {
-    clear();
-  }
-
 protected:
   /**
    * Find recent time after which points should not be culled
@@ -239,25 +230,20 @@ protected:
   Time GetRecentTime(Time t) const noexcept;
 
   /**
-   * Update delta values for specified item in the delta list and the
-   * tree.  This repositions the item after into its sorted position.
+   * Update delta values for specified item.  This repositions the
+   * item in #delta_heap.
    *
-   * @param it Item to update
-   * @param tree Tree containing leaf
-   *
-   * @return Iterator to updated item
+   * @param td Item to update
    */
   void UpdateDelta(TraceDelta &td) noexcept;
 
   /**
-   * Erase a non-edge item from delta list and tree, updating
-   * deltas in the process.  This Invalidates the calling iterator.
-   *
-   * @param it Item to erase
-   * @param tree Tree to remove from
+   * Erase a non-edge item, updating the deltas of its neighbours in
+   * the process.
    *
+   * @param td Item to erase
    */
-  void EraseInside(DeltaList::iterator it) noexcept;
+  void EraseInside(TraceDelta &td) noexcept;
 
   /**
    * Erase elements based on delta metric until the size is
@@ -428,6 +414,31 @@ private:
    */
   void Thin() noexcept;
 
+  TraceDelta &AllocateNode(const TracePoint &point) noexcept;
+  void FreeNode(TraceDelta &td) noexcept;
+
+  /**
+   * Remove the given item from the #chronological_list and from the
+   * #delta_heap, and free it.
+   */
+  void EraseNode(TraceDelta &td) noexcept;
+
+  void HeapMove(TraceDelta &td, unsigned i) noexcept {
+    delta_heap[i] = &td;
+    td.heap_index = i;
+  }
+
+  void HeapSiftUp(TraceDelta &td) noexcept;
+  void HeapSiftDown(TraceDelta &td) noexcept;
+  void HeapPush(TraceDelta &td) noexcept;
+  void HeapErase(TraceDelta &td) noexcept;
+
+  /**
+   * Restore the heap order after the rank of the given item has
+   * changed.
+   */
+  void HeapUpdate(TraceDelta &td) noexcept;
+
   TraceDelta &GetFront() noexcept {
     assert(!empty());
 
@@ -5,6 +5,8 @@
 #include "util/AllocatedArray.hxx"
 #include "util/StringUtil.hpp"
 
+#include <algorithm>
+
 static constexpr std::size_t NORMALIZE_BUFFER_SIZE = 4096;
 
 inline WaypointPtr
@@ -71,6 +73,155 @@ Waypoints::WaypointNameTree::Remove(const WaypointPtr &wp) noexcept
   }
 }
 
+/**
+ * Copy the normalised form of the string into the buffer.
+ */
+static tstring_view
+Normalise(AllocatedArray<TCHAR> &buffer, tstring_view src) noexcept
+{
+  buffer.GrowDiscard(src.size() + 1);
+  NormalizeSearchString(buffer.data(), src);
+  return buffer.data();
+}
+
+static constexpr uint_least32_t
+MakeTrigramKey(const TCHAR *p) noexcept
+{
+  return (uint_least32_t(uint8_t(p[0])) << 16) |
+    (uint_least32_t(uint8_t(p[1])) << 8) |
+    uint_least32_t(uint8_t(p[2]));
+}
+
+static void
+AppendTrigramKeys(std::vector<uint_least32_t> &keys,
+                  tstring_view normalised) noexcept
+{
+  for (std::size_t i = 0; i + 3 <= normalised.size(); ++i)
+    keys.push_back(MakeTrigramKey(normalised.data() + i));
+}
+
+/**
+ * Returns the sorted and de-duplicated trigram keys of the
+ * waypoint's name and short name.
+ */
+static std::vector<uint_least32_t>
+GetTrigramKeys(const Waypoint &wp) noexcept
+{
+  std::vector<uint_least32_t> keys;
+  AllocatedArray<TCHAR> buffer;
+  AppendTrigramKeys(keys, Normalise(buffer, wp.name));
+  if (!wp.shortname.empty())
+    AppendTrigramKeys(keys, Normalise(buffer, wp.shortname));
+
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  return keys;
+}
+
+void
+Waypoints::WaypointTrigramIndex::Clear() noexcept
+{
+  slots.clear();
+  free_slots.clear();
+  postings.clear();
+}
+
+inline void
+Waypoints::WaypointTrigramIndex::Add(WaypointPtr wp) noexcept
+{
+  const auto keys = GetTrigramKeys(*wp);
+  if (keys.empty())
+    /* too short to be found by VisitNormalisedSubstring() */
+    return;
+
+  uint32_t slot;
+  if (!free_slots.empty()) {
+    slot = free_slots.back();
+    free_slots.pop_back();
+    slots[slot] = std::move(wp);
+  } else {
+    slot = slots.size();
+    slots.emplace_back(std::move(wp));
+  }
+
+  for (const auto key : keys)
+    postings[key].push_back(slot);
+}
+
+inline void
+Waypoints::WaypointTrigramIndex::Remove(const WaypointPtr &wp) noexcept
+{
+  const auto keys = GetTrigramKeys(*wp);
+  if (keys.empty())
+    return;
+
+  /* find the slot in the (short) list of one of its trigrams */
+  const auto first = postings.find(keys.front());
+  if (first == postings.end())
+    return;
+
+  const auto &first_list = first->second;
+  const auto slot_i = std::find_if(first_list.begin(), first_list.end(),
+                                   [this, &wp](uint32_t slot){
+                                     return slots[slot] == wp;
+                                   });
+  if (slot_i == first_list.end())
+    return;
+
+  const uint32_t slot = *slot_i;
+
+  for (const auto key : keys) {
+    const auto i = postings.find(key);
+    assert(i != postings.end());
+
+    auto &list = i->second;
+    list.erase(std::find(list.begin(), list.end(), slot));
+    if (list.empty())
+      postings.erase(i);
+  }
+
+  slots[slot] = nullptr;
+  free_slots.push_back(slot);
+}
+
+bool
+Waypoints::WaypointTrigramIndex::VisitNormalisedSubstring(tstring_view substring,
+                                                          const WaypointVisitor &visitor) const
+{
+  if (substring.size() >= NORMALIZE_BUFFER_SIZE)
+    return false;
+
+  TCHAR normalized[NORMALIZE_BUFFER_SIZE];
+  NormalizeSearchString(normalized, substring);
+  const tstring_view needle{normalized};
+  if (needle.size() < MIN_LENGTH)
+    return false;
+
+  /* every match contains all trigrams of the search string; check
+     only the waypoints of the rarest one */
+  const std::vector<uint32_t> *candidates = nullptr;
+  for (std::size_t i = 0; i + MIN_LENGTH <= needle.size(); ++i) {
+    const auto p = postings.find(MakeTrigramKey(needle.data() + i));
+    if (p == postings.end())
+      /* no waypoint contains this trigram */
+      return true;
+
+    if (candidates == nullptr || p->second.size() < candidates->size())
+      candidates = &p->second;
+  }
+
+  AllocatedArray<TCHAR> buffer;
+  for (const auto slot : *candidates) {
+    const auto &wp = slots[slot];
+    if (Normalise(buffer, wp->name).find(needle) != needle.npos ||
+        (!wp->shortname.empty() &&
+         Normalise(buffer, wp->shortname).find(needle) != needle.npos))
+      visitor(wp);
+  }
+
+  return true;
+}
+
 Waypoints::Waypoints() noexcept = default;
 
 void
@@ -89,6 +240,9 @@ Waypoints::Optimise() noexcept
   }
 
   waypoint_tree.Optimise();
+
+  /* the tree is rebuilt rarely, but searched often */
+  waypoint_tree.Pack();
 }
 
 void
@@ -110,6 +264,7 @@ Waypoints::Append(WaypointPtr wp) noexcept
   w.id = next_id++;
 
   waypoint_tree.Add(wp);
+  trigram_index.Add(wp);
   name_tree.Add(wp);
 
   ++serial;
@@ -243,14 +398,65 @@ Waypoints::VisitNamePrefix(tstring_view prefix,
   name_tree.VisitNormalisedPrefix(prefix, visitor);
 }
 
+void
+Waypoints::VisitNameMatches(tstring_view query,
+                            WaypointVisitor visitor) const
+{
+  if (!trigram_index.VisitNormalisedSubstring(query, visitor))
+    name_tree.VisitNormalisedPrefix(query, visitor);
+}
+
+void
+Waypoints::VisitNameMatchesWithinRange(tstring_view query,
+                                       const GeoPoint &loc, double range,
+                                       WaypointVisitor visitor) const
+{
+  if (IsEmpty())
+    return; // nothing to do
+
+  const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
+  const WaypointTree::Point point(flat_location.x, flat_location.y);
+  const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+  const auto square_range = WaypointTree::Square(mrange);
+
+  /* a search string of three or more characters usually matches far
+     fewer waypoints than the range; check the range of each */
+  if (trigram_index.VisitNormalisedSubstring(query, [&](const WaypointPtr &wp){
+        if (waypoint_tree.GetPosition(wp).SquareDistanceTo(point) <= square_range)
+          visitor(wp);
+      }))
+    return;
+
+  if (query.size() >= NORMALIZE_BUFFER_SIZE)
+    return;
+
+  TCHAR normalized[NORMALIZE_BUFFER_SIZE];
+  NormalizeSearchString(normalized, query);
+  const tstring_view prefix{normalized};
+
+  AllocatedArray<TCHAR> buffer;
+  WaypointVisitor prefix_visitor = [&](const WaypointPtr &wp){
+    if (Normalise(buffer, wp->name).starts_with(prefix) ||
+        (!wp->shortname.empty() &&
+         Normalise(buffer, wp->shortname).starts_with(prefix)))
+      visitor(wp);
+  };
+
+  waypoint_tree.VisitWithinRange(point, mrange, prefix_visitor);
+}
+
 void
 Waypoints::Clear() noexcept
 {
   ++serial;
   home = nullptr;
   name_tree.Clear();
+  trigram_index.Clear();
   waypoint_tree.clear();
   next_id = 1;
+
+  /* the old arena is freed when the last waypoint is released */
+  arena = std::make_shared<Arena>();
 }
 
 void
@@ -265,6 +471,7 @@ Waypoints::Erase(WaypointPtr &&wp) noexcept
                                        });
   assert(f.first != waypoint_tree.end());
 
+  trigram_index.Remove(wp);
   name_tree.Remove(std::move(wp));
   waypoint_tree.erase(f.first);
   ++serial;
@@ -280,6 +487,7 @@ Waypoints::EraseUserMarkers() noexcept
           home = nullptr;
 
         name_tree.Remove(wp);
+        trigram_index.Remove(wp);
         ++serial;
         return true;
       } else
@@ -293,6 +501,7 @@ Waypoints::Replace(const WaypointPtr &orig, Waypoint &&replacement) noexcept
   assert(!waypoint_tree.IsEmpty());
 
   name_tree.Remove(orig);
+  trigram_index.Remove(orig);
 
   replacement.id = orig->id;
 
@@ -305,8 +514,9 @@ Waypoints::Replace(const WaypointPtr &orig, Waypoint &&replacement) noexcept
       ScheduleOptimise();
   }
 
-  WaypointPtr new_ptr(new Waypoint(std::move(replacement)));
+  WaypointPtr new_ptr = Allocate(std::move(replacement));
   name_tree.Add(new_ptr);
+  trigram_index.Add(new_ptr);
 
   auto f = waypoint_tree.FindNearestIf(waypoint_tree.GetPosition(orig), 0,
                                        [&orig](const WaypointPtr &ptr){
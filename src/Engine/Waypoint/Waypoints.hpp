@@ -9,9 +9,13 @@
 #include "util/RadixTree.hpp"
 #include "util/QuadTree.hxx"
 #include "util/Serial.hpp"
+#include "util/ArenaAllocator.hpp"
 #include "util/tstring_view.hxx"
 
+#include <cstdint>
 #include <functional>
+#include <unordered_map>
+#include <vector>
 
 using WaypointVisitor = std::function<void(const WaypointPtr &)>;
 
@@ -53,6 +57,50 @@ class Waypoints {
     void Remove(const WaypointPtr &wp) noexcept;
   };
 
+  /**
+   * Maps each trigram (three consecutive characters) of the
+   * normalised names and short names to the waypoints containing it.
+   * A substring search only needs to check the waypoints listed for
+   * the rarest trigram of the search string instead of all names.
+   */
+  class WaypointTrigramIndex {
+    /**
+     * Three normalised characters.  NormalizeSearchString() leaves
+     * only ASCII letters and digits, so each fits into one byte.
+     */
+    using Key = uint_least32_t;
+
+    /**
+     * The indexed waypoints.  Remove() clears the slot and puts its
+     * number into #free_slots for the next Add().
+     */
+    std::vector<WaypointPtr> slots;
+    std::vector<uint32_t> free_slots;
+
+    std::unordered_map<Key, std::vector<uint32_t>> postings;
+
+  public:
+    /**
+     * Search strings shorter than this (after normalisation) cannot
+     * be looked up.
+     */
+    static constexpr std::size_t MIN_LENGTH = 3;
+
+    void Clear() noexcept;
+    void Add(WaypointPtr wp) noexcept;
+    void Remove(const WaypointPtr &wp) noexcept;
+
+    /**
+     * Call the visitor on all waypoints whose normalised name or
+     * short name contains the specified normalised string.
+     *
+     * @return false if the string is too short for this index
+     * (nothing was visited)
+     */
+    bool VisitNormalisedSubstring(tstring_view substring,
+                                  const WaypointVisitor &visitor) const;
+  };
+
   /**
    * This gets incremented each time the object is modified.
    */
@@ -62,10 +110,20 @@ class Waypoints {
 
   WaypointTree waypoint_tree;
   WaypointNameTree name_tree;
+  WaypointTrigramIndex trigram_index;
   TaskProjection task_projection;
 
   WaypointPtr home;
 
+  /**
+   * The memory of the #Waypoint objects (and their reference
+   * counters) created by this container; consecutive waypoints of a
+   * file are adjacent, which helps VisitWithinRange().  Replaced with
+   * a new one by Clear(); the old one is freed with its last
+   * #WaypointPtr.
+   */
+  std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+
 public:
   using const_iterator = WaypointTree::const_iterator;
 
@@ -85,6 +143,14 @@ public:
     return serial;
   }
 
+  /**
+   * Returns the projection of Waypoint::flat_location.  It is
+   * updated by Optimise().
+   */
+  const TaskProjection &GetProjection() const noexcept {
+    return task_projection;
+  }
+
   /**
    * Add this waypoint to internal store.
    * Optimise() must be called after inserting waypoints prior to
@@ -102,7 +168,7 @@ public:
    * @param wp Waypoint to add to internal store
    */
   WaypointPtr Append(Waypoint &&wp) noexcept {
-    WaypointPtr ptr(new Waypoint(std::move(wp)));
+    WaypointPtr ptr = Allocate(std::move(wp));
     Append(ptr);
     return ptr;
   }
@@ -284,6 +350,24 @@ public:
    */
   void VisitNamePrefix(tstring_view prefix, WaypointVisitor visitor) const;
 
+  /**
+   * Call visitor function on waypoints whose name or short name
+   * contains the specified string (ignoring case and punctuation).
+   * Strings shorter than three letters/digits are not in the trigram
+   * index; they only match name prefixes, like VisitNamePrefix().
+   */
+  void VisitNameMatches(tstring_view query, WaypointVisitor visitor) const;
+
+  /**
+   * Like VisitNameMatches(), but only visit waypoints within the
+   * range of VisitWithinRange().  Depending on the search string,
+   * either the trigram index or the spatial tree provides the
+   * candidates, and the other criterion is checked for each.
+   */
+  void VisitNameMatchesWithinRange(tstring_view query,
+                                   const GeoPoint &loc, double range,
+                                   WaypointVisitor visitor) const;
+
   /**
    * Returns a set of possible characters following the specified
    * prefix.
@@ -352,4 +436,10 @@ public:
   const_iterator end() const noexcept {
     return waypoint_tree.end();
   }
+
+private:
+  WaypointPtr Allocate(Waypoint &&wp) noexcept {
+    return std::allocate_shared<Waypoint>(ArenaAllocator<Waypoint>{arena},
+                                          std::move(wp));
+  }
 };
@@ -2,13 +2,33 @@
 // Copyright The XCSoar Project
 
 #include "Calculations.hpp"
+#include "List.hpp"
 
-double
-FlarmCalculations::Average30s(FlarmId id, TimeStamp time,
-                              double altitude) noexcept
+#include <algorithm>
+
+void
+FlarmCalculations::Average30s(TrafficList &traffic, TimeStamp time) noexcept
 {
-  ClimbAverageCalculator &item = averageCalculatorMap[id];
-  return item.GetAverage(time, altitude, std::chrono::seconds{30});
+  /* both arrays are sorted by id: walk them side by side, and insert
+     a new slot where a target has none yet */
+  std::size_t slot = 0;
+
+  for (auto &i : traffic.list) {
+    i.climb_rate_avg30s_available = i.altitude_available;
+    if (!i.climb_rate_avg30s_available)
+      continue;
+
+    while (slot < slots.size() && slots[slot].id < i.id)
+      ++slot;
+
+    if (slot == slots.size() || i.id < slots[slot].id)
+      slots.emplace(std::next(slots.begin(), slot), i.id);
+
+    i.climb_rate_avg30s =
+      slots[slot].calculator.GetAverage(time, i.altitude,
+                                        std::chrono::seconds{30});
+    ++slot;
+  }
 }
 
 void
@@ -16,11 +36,8 @@ FlarmCalculations::CleanUp(TimeStamp now) noexcept
 {
   constexpr FloatDuration MAX_AGE = std::chrono::minutes{1};
 
-  // Iterate through ClimbAverageCalculators and remove expired ones
-  for (auto it = averageCalculatorMap.begin(),
-       it_end = averageCalculatorMap.end(); it != it_end;)
-    if (it->second.Expired(now, MAX_AGE))
-      it = averageCalculatorMap.erase(it);
-    else
-      ++it;
+  // remove expired ClimbAverageCalculators, preserving the order
+  std::erase_if(slots, [now](const Slot &slot){
+    return slot.calculator.Expired(now, MAX_AGE);
+  });
 }
@@ -6,19 +6,45 @@
 #include "Id.hpp"
 #include "Computer/ClimbAverageCalculator.hpp"
 
-#include <map>
+#include <vector>
 
 class TimeStamp;
+struct TrafficList;
 
+/**
+ * Keeps the altitude history of FLARM targets for calculating their
+ * 30 second average climb rate.
+ *
+ * The histories live in a flat array of slots sorted by #FlarmId,
+ * just like #TrafficList, so updating all targets is a single linear
+ * pass over both arrays, without a lookup per target.
+ */
 class FlarmCalculations
 {
-private:
-  typedef std::map<FlarmId, ClimbAverageCalculator> AverageCalculatorMap;
-  AverageCalculatorMap averageCalculatorMap;
+  struct Slot {
+    FlarmId id;
+    ClimbAverageCalculator calculator;
+
+    explicit Slot(FlarmId _id) noexcept
+      :id(_id) {
+      calculator.Reset();
+    }
+  };
+
+  std::vector<Slot> slots;
 
 public:
-  double Average30s(FlarmId flarmId, TimeStamp curTime,
-                    double curAltitude) noexcept;
+  /**
+   * Add the current altitude of all targets with
+   * FlarmTraffic::altitude_available to their histories and update
+   * FlarmTraffic::climb_rate_avg30s.
+   */
+  void Average30s(TrafficList &traffic, TimeStamp time) noexcept;
 
   void CleanUp(TimeStamp now) noexcept;
+
+  [[gnu::pure]]
+  std::size_t size() const noexcept {
+    return slots.size();
+  }
 };
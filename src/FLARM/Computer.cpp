@@ -2,11 +2,81 @@
 // Copyright The XCSoar Project
 
 #include "Computer.hpp"
-#include "Details.hpp"
+#include "Threat.hpp"
+#include "Geo/SpeedVector.hpp"
 #include "NMEA/Info.hpp"
 #include "Geo/GeoVector.hpp"
 #include "time/Cast.hxx"
 
+/**
+ * Convert the relative positions in one pass over all targets.  The
+ * conditions are the same for all of them, so they are evaluated
+ * only once, leaving simple loops without lookups.
+ */
+template<std::size_t N>
+static void
+UpdatePositions(BasicTrafficList<N> &list, const NMEAInfo &basic,
+                double north_to_latitude, double east_to_longitude) noexcept
+{
+  for (auto &traffic : list.list) {
+    if (traffic.HasAbsolutePosition())
+      continue;
+
+    traffic.distance = hypot(traffic.relative_north, traffic.relative_east);
+    traffic.location_available = basic.location_available;
+    traffic.altitude_available = basic.gps_altitude_available;
+  }
+
+  if (basic.location_available) {
+    const GeoPoint origin = basic.location;
+    for (auto &traffic : list.list) {
+      if (traffic.HasAbsolutePosition())
+        continue;
+
+      traffic.location.latitude =
+        Angle::Degrees(traffic.relative_north * north_to_latitude) +
+        origin.latitude;
+      traffic.location.longitude =
+        Angle::Degrees(traffic.relative_east * east_to_longitude) +
+        origin.longitude;
+    }
+  }
+
+  if (basic.gps_altitude_available) {
+    const RoughAltitude gps_altitude(basic.gps_altitude);
+    for (auto &traffic : list.list)
+      if (!traffic.HasAbsolutePosition())
+        traffic.altitude = traffic.relative_altitude + gps_altitude;
+  }
+}
+
+/**
+ * The reverse of UpdatePositions(), for targets with an absolute
+ * position (GliderLink).
+ */
+template<std::size_t N>
+static void
+UpdateRelativePositions(BasicTrafficList<N> &list,
+                        const NMEAInfo &basic) noexcept
+{
+  if (!basic.location_available)
+    return;
+
+  for (auto &traffic : list.list) {
+    if (!traffic.HasAbsolutePosition())
+      continue;
+
+    const GeoVector vector = basic.location.DistanceBearing(traffic.location);
+    traffic.relative_north = vector.distance * vector.bearing.cos();
+    traffic.relative_east = vector.distance * vector.bearing.sin();
+    traffic.distance = vector.distance;
+
+    if (traffic.altitude_available && basic.gps_altitude_available)
+      traffic.relative_altitude =
+        traffic.altitude - RoughAltitude(basic.gps_altitude);
+  }
+}
+
 void
 FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
                        const NMEAInfo &basic) noexcept
@@ -16,8 +86,11 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
     flarm_calculations.CleanUp(basic.time);
 
   // if (FLARM data is available)
-  if (!flarm.IsDetected())
+  if (!flarm.IsDetected()) {
+    /* there may be GliderLink traffic without a FLARM */
+    UpdateRelativePositions(flarm.adsb_traffic, basic);
     return;
+  }
 
   double north_to_latitude(0);
   double east_to_longitude(0);
@@ -42,42 +115,24 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
     }
   }
 
-  // for each item in traffic
+  // look up the names of targets we don't know yet
   for (auto &traffic : flarm.traffic.list) {
-    // if we don't know the target's name yet
     if (!traffic.HasName()) {
-      // lookup the name of this target's id
-      const TCHAR *fname = FlarmDetails::LookupCallsign(traffic.id);
+      const TCHAR *fname = name_cache.Lookup(traffic.id);
       if (fname != NULL)
         traffic.name = fname;
     }
+  }
 
-    // Calculate distance
-    traffic.distance = hypot(traffic.relative_north, traffic.relative_east);
-
-    // Calculate Location
-    traffic.location_available = basic.location_available;
-    if (traffic.location_available) {
-      traffic.location.latitude =
-          Angle::Degrees(traffic.relative_north * north_to_latitude) +
-          basic.location.latitude;
-
-      traffic.location.longitude =
-          Angle::Degrees(traffic.relative_east * east_to_longitude) +
-          basic.location.longitude;
-    }
-
-    // Calculate absolute altitude
-    traffic.altitude_available = basic.gps_altitude_available;
-    if (traffic.altitude_available)
-      traffic.altitude = traffic.relative_altitude + RoughAltitude(basic.gps_altitude);
+  UpdatePositions(flarm.traffic, basic, north_to_latitude, east_to_longitude);
+  UpdatePositions(flarm.adsb_traffic, basic,
+                  north_to_latitude, east_to_longitude);
+  UpdateRelativePositions(flarm.adsb_traffic, basic);
 
-    // Calculate average climb rate
-    traffic.climb_rate_avg30s_available = traffic.altitude_available;
-    if (traffic.climb_rate_avg30s_available)
-      traffic.climb_rate_avg30s =
-        flarm_calculations.Average30s(traffic.id, basic.time, traffic.altitude);
+  // Calculate average climb rate
+  flarm_calculations.Average30s(flarm.traffic, basic.time);
 
+  for (auto &traffic : flarm.traffic.list) {
     // The following calculations are only relevant for targets
     // where information is missing
     if (traffic.track_received && traffic.turn_rate_received &&
@@ -136,4 +191,10 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
         traffic.speed = last_traffic->speed;
     }
   }
+
+  std::optional<SpeedVector> own_velocity;
+  if (basic.track_available && basic.ground_speed_available)
+    own_velocity = SpeedVector(basic.track, basic.ground_speed);
+
+  FlarmThreat::Update(flarm.traffic, own_velocity);
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Calculations.hpp"
+#include "NameCache.hpp"
 
 struct FlarmData;
 struct NMEAInfo;
@@ -11,6 +12,8 @@ struct NMEAInfo;
 class FlarmComputer {
   FlarmCalculations flarm_calculations;
 
+  FlarmNameCache name_cache;
+
 public:
   /**
    * Calculates location, altitude, average climb speed and
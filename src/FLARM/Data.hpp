@@ -22,6 +22,13 @@ struct FlarmData {
 
   TrafficList traffic;
 
+  /**
+   * ADS-B targets which are not a collision threat, and targets
+   * received from GliderLink (which is not a FLARM, but shares this
+   * list, so all traffic gets merged and drawn the same way).
+   */
+  AdsbTrafficList adsb_traffic;
+
   constexpr bool IsDetected() const noexcept {
     return status.available || !traffic.IsEmpty();
   }
@@ -31,6 +38,19 @@ struct FlarmData {
     version.Clear();
     status.Clear();
     traffic.Clear();
+    adsb_traffic.Clear();
+  }
+
+  /**
+   * Like the assignment operator, but copies only the used part of
+   * the traffic lists.
+   */
+  constexpr void CopyFrom(const FlarmData &src) noexcept {
+    error = src.error;
+    version = src.version;
+    status = src.status;
+    traffic.CopyFrom(src.traffic);
+    adsb_traffic.CopyFrom(src.adsb_traffic);
   }
 
   constexpr void Complement(const FlarmData &add) noexcept {
@@ -38,6 +58,7 @@ struct FlarmData {
     version.Complement(add.version);
     status.Complement(add.status);
     traffic.Complement(add.traffic);
+    adsb_traffic.Complement(add.adsb_traffic);
   }
 
   constexpr void Expire(TimeStamp clock) noexcept {
@@ -45,6 +66,7 @@ struct FlarmData {
     version.Expire(clock);
     status.Expire(clock);
     traffic.Expire(clock);
+    adsb_traffic.Expire(clock);
   }
 };
 
@@ -7,10 +7,13 @@
 #include "TrafficDatabases.hpp"
 #include "util/StringCompare.hxx"
 
+#include <atomic>
 #include <cassert>
 
 namespace FlarmDetails {
 
+static std::atomic_uint generation{1};
+
 const FlarmNetRecord *
 LookupRecord(FlarmId id) noexcept
 {
@@ -44,7 +47,9 @@ AddSecondaryItem(FlarmId id, const TCHAR *name) noexcept
   assert(id.IsDefined());
   assert(traffic_databases != nullptr);
 
-  return traffic_databases->flarm_names.Set(id, name);
+  const bool result = traffic_databases->flarm_names.Set(id, name);
+  Invalidate();
+  return result;
 }
 
 unsigned
@@ -57,4 +62,16 @@ FindIdsByCallSign(const TCHAR *cn, FlarmId array[], unsigned size) noexcept
   return traffic_databases->FindIdsByName(cn, array, size);
 }
 
+unsigned
+GetGeneration() noexcept
+{
+  return generation.load(std::memory_order_relaxed);
+}
+
+void
+Invalidate() noexcept
+{
+  generation.fetch_add(1, std::memory_order_relaxed);
+}
+
 } // namespace FlarmDetails
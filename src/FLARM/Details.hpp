@@ -53,4 +53,19 @@ AddSecondaryItem(FlarmId id, const TCHAR *name) noexcept;
 unsigned
 FindIdsByCallSign(const TCHAR *cn, FlarmId array[], unsigned size) noexcept;
 
+/**
+ * Returns a number which changes whenever the result of a lookup may
+ * change, i.e. when a database gets modified or reloaded.  Callers
+ * which cache lookup results must flush them when it changes.
+ */
+[[gnu::pure]]
+unsigned
+GetGeneration() noexcept;
+
+/**
+ * Announce that the databases have been modified or reloaded.
+ */
+void
+Invalidate() noexcept;
+
 } // namespace FlarmDetails
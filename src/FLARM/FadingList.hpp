@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Traffic.hpp"
+#include "util/TrivialArray.hxx"
+
+#include <algorithm>
+
+/**
+ * FLARM traffic which has disappeared recently, but is still shown
+ * (greyed out) for some time.  It has a fixed capacity and never
+ * allocates memory.  The targets are kept in the order they
+ * disappeared, oldest first; if the list is full, the oldest one is
+ * discarded.
+ */
+class FadingTrafficList {
+public:
+  static constexpr std::size_t MAX_COUNT = 64;
+
+private:
+  TrivialArray<FlarmTraffic, MAX_COUNT> list;
+
+public:
+  constexpr void Clear() noexcept {
+    list.clear();
+  }
+
+  constexpr bool IsEmpty() const noexcept {
+    return list.empty();
+  }
+
+  constexpr std::size_t size() const noexcept {
+    return list.size();
+  }
+
+  [[gnu::pure]]
+  constexpr const FlarmTraffic *Find(FlarmId id) const noexcept {
+    const auto i = std::find_if(list.begin(), list.end(),
+                                [id](const FlarmTraffic &traffic){
+                                  return traffic.id == id;
+                                });
+    return i != list.end() ? i : nullptr;
+  }
+
+  /**
+   * Add a target which has just disappeared.  Does nothing if it is
+   * already in the list.
+   */
+  constexpr void Add(const FlarmTraffic &traffic) noexcept {
+    if (Find(traffic.id) != nullptr)
+      return;
+
+    if (list.full())
+      list.remove(0);
+
+    list.append(traffic);
+  }
+
+  /**
+   * Remove all targets for which the given predicate returns true,
+   * preserving the order of the others.
+   */
+  template<typename P>
+  constexpr void RemoveIf(P &&p) noexcept {
+    auto dest = list.begin();
+    for (const auto &traffic : list)
+      if (!p(traffic))
+        *dest++ = traffic;
+
+    list.resize(std::distance(list.begin(), dest));
+  }
+
+  constexpr auto begin() const noexcept {
+    return list.begin();
+  }
+
+  constexpr auto end() const noexcept {
+    return list.end();
+  }
+};
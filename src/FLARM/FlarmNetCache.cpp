@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FlarmNetCache.hpp"
+#include "FlarmNetDatabase.hpp"
+#include "io/FileCache.hpp"
+#include "io/FileMapping.hpp"
+#include "io/FileOutputStream.hxx"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+static constexpr const TCHAR *CACHE_NAME = _T("flarmnet.bin");
+
+static constexpr uint32_t MAGIC = 0x464e4331; // "FNC1"
+
+static_assert(std::is_trivially_copyable_v<FlarmId>);
+static_assert(std::is_trivially_copyable_v<FlarmNetRecord>);
+static_assert(sizeof(FlarmId) == sizeof(uint32_t));
+
+/**
+ * The cache payload: this header, the ids, the records, padding to
+ * a multiple of four bytes and the callsign index.
+ */
+struct CacheHeader {
+  uint32_t magic;
+
+  /**
+   * sizeof(FlarmNetRecord), which depends on the TCHAR size.
+   */
+  uint32_t record_size;
+
+  uint32_t n_records;
+
+  uint32_t reserved;
+};
+
+static constexpr std::size_t
+PadToWord(std::size_t size) noexcept
+{
+  return (size + 3) & ~std::size_t(3);
+}
+
+/**
+ * Cast a part of the mapping to an array, checking its size and
+ * alignment.
+ */
+template<typename T>
+static bool
+CastArray(std::span<const std::byte> &data, std::size_t n,
+          std::span<const T> &result) noexcept
+{
+  const std::size_t size = n * sizeof(T);
+  if (data.size() < size ||
+      reinterpret_cast<std::uintptr_t>(data.data()) % alignof(T) != 0)
+    return false;
+
+  result = {reinterpret_cast<const T *>(data.data()), n};
+  data = data.subspan(size);
+  return true;
+}
+
+unsigned
+FlarmNetCache::Load(FileCache &cache, Path original_path,
+                    FlarmNetDatabase &database) noexcept
+{
+  std::span<const std::byte> data;
+  auto mapping = cache.Map(CACHE_NAME, original_path, data);
+  if (!mapping)
+    return 0;
+
+  CacheHeader header;
+  if (data.size() < sizeof(header))
+    return 0;
+
+  memcpy(&header, data.data(), sizeof(header));
+  if (header.magic != MAGIC ||
+      header.record_size != sizeof(FlarmNetRecord) ||
+      header.n_records == 0)
+    return 0;
+
+  data = data.subspan(sizeof(header));
+
+  const std::size_t n = header.n_records;
+  std::span<const FlarmId> ids;
+  std::span<const FlarmNetRecord> records;
+  std::span<const uint32_t> callsign_index;
+
+  if (!CastArray(data, n, ids) || !CastArray(data, n, records))
+    return 0;
+
+  const std::size_t padding =
+    PadToWord(n * sizeof(FlarmNetRecord)) - n * sizeof(FlarmNetRecord);
+  if (data.size() < padding)
+    return 0;
+
+  data = data.subspan(padding);
+  if (!CastArray(data, n, callsign_index))
+    return 0;
+
+  /* the index must not point out of the array */
+  for (const uint32_t i : callsign_index)
+    if (i >= n)
+      return 0;
+
+  database.Adopt(std::move(mapping), ids, records, callsign_index);
+  return n;
+}
+
+void
+FlarmNetCache::Save(FileCache &cache, Path original_path,
+                    const FlarmNetDatabase &database)
+{
+  const auto ids = database.GetIds();
+  const auto records = database.GetRecords();
+  const auto callsign_index = database.GetCallSignIndex();
+
+  const CacheHeader header{
+    MAGIC, sizeof(FlarmNetRecord), uint32_t(records.size()), 0,
+  };
+
+  auto os = cache.Save(CACHE_NAME, original_path);
+  os->Write(std::as_bytes(std::span{&header, 1}));
+  os->Write(std::as_bytes(ids));
+  os->Write(std::as_bytes(records));
+
+  static constexpr std::byte zero[4]{};
+  const std::size_t records_size = records.size() * sizeof(FlarmNetRecord);
+  os->Write(std::span{zero}.first(PadToWord(records_size) - records_size));
+
+  os->Write(std::as_bytes(callsign_index));
+  os->Commit();
+}
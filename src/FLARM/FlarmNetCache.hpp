@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+class Path;
+class FileCache;
+class FlarmNetDatabase;
+
+/**
+ * A binary cache of the FlarmNet.org file: the sorted arrays of a
+ * #FlarmNetDatabase, which can be mapped into memory without
+ * parsing.  The layout depends on the platform (byte order, TCHAR
+ * size); it is rebuilt whenever it doesn't match.
+ */
+namespace FlarmNetCache {
+
+/**
+ * Map the cache of the given FlarmNet.org file into the database.
+ *
+ * @return the number of records or 0 if there is no valid cache
+ */
+unsigned
+Load(FileCache &cache, Path original_path,
+     FlarmNetDatabase &database) noexcept;
+
+/**
+ * Write the database to the cache.
+ *
+ * Throws on error.
+ */
+void
+Save(FileCache &cache, Path original_path,
+     const FlarmNetDatabase &database);
+
+} // namespace FlarmNetCache
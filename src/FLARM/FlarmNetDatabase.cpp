@@ -2,46 +2,145 @@
 // Copyright The XCSoar Project
 
 #include "FlarmNetDatabase.hpp"
+#include "io/FileMapping.hpp"
 #include "util/StringAPI.hxx"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
+
+FlarmNetDatabase::FlarmNetDatabase() noexcept = default;
+FlarmNetDatabase::~FlarmNetDatabase() noexcept = default;
+
+void
+FlarmNetDatabase::Clear() noexcept
+{
+  owned_ids.clear();
+  owned_records.clear();
+  owned_callsign_index.clear();
+  mapping.reset();
+  ids = {};
+  records = {};
+  callsign_index = {};
+}
 
 void
 FlarmNetDatabase::Insert(const FlarmNetRecord &record) noexcept
 {
+  assert(mapping == nullptr);
+
   FlarmId id = record.GetId();
   if (!id.IsDefined())
     /* ignore malformed records */
     return;
 
-  map.insert(std::make_pair(id, record));
+  owned_ids.push_back(id);
+  owned_records.push_back(record);
 }
 
-const FlarmNetRecord *
-FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const noexcept
+void
+FlarmNetDatabase::Finish() noexcept
 {
-  for (const auto &[id, record] : map) {
-    assert(id.IsDefined());
+  assert(mapping == nullptr);
+  assert(owned_ids.size() == owned_records.size());
+
+  /* sort by id; of duplicate ids, the first one wins */
+  std::vector<uint32_t> order(owned_ids.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b){
+    return owned_ids[a] < owned_ids[b];
+  });
 
-    if (StringIsEqual(record.callsign, cn))
-      return &record;
+  order.erase(std::unique(order.begin(), order.end(),
+                          [this](uint32_t a, uint32_t b){
+                            return owned_ids[a] == owned_ids[b];
+                          }),
+              order.end());
+
+  std::vector<FlarmId> sorted_ids;
+  std::vector<FlarmNetRecord> sorted_records;
+  sorted_ids.reserve(order.size());
+  sorted_records.reserve(order.size());
+  for (const uint32_t i : order) {
+    sorted_ids.push_back(owned_ids[i]);
+    sorted_records.push_back(owned_records[i]);
   }
 
-  return NULL;
+  owned_ids = std::move(sorted_ids);
+  owned_records = std::move(sorted_records);
+
+  owned_callsign_index.resize(owned_records.size());
+  std::iota(owned_callsign_index.begin(), owned_callsign_index.end(), 0);
+  std::stable_sort(owned_callsign_index.begin(), owned_callsign_index.end(),
+                   [this](uint32_t a, uint32_t b){
+                     return StringCompare(owned_records[a].callsign,
+                                          owned_records[b].callsign) < 0;
+                   });
+
+  ids = owned_ids;
+  records = owned_records;
+  callsign_index = owned_callsign_index;
+}
+
+void
+FlarmNetDatabase::Adopt(std::unique_ptr<FileMapping> &&_mapping,
+                        std::span<const FlarmId> _ids,
+                        std::span<const FlarmNetRecord> _records,
+                        std::span<const uint32_t> _callsign_index) noexcept
+{
+  assert(_ids.size() == _records.size());
+
+  Clear();
+
+  mapping = std::move(_mapping);
+  ids = _ids;
+  records = _records;
+  callsign_index = _callsign_index;
+}
+
+const FlarmNetRecord *
+FlarmNetDatabase::FindRecordById(FlarmId id) const noexcept
+{
+  const auto i = std::lower_bound(ids.begin(), ids.end(), id);
+  return i != ids.end() && *i == id
+    ? &records[std::distance(ids.begin(), i)]
+    : NULL;
+}
+
+std::span<const uint32_t>
+FlarmNetDatabase::FindCallSign(const TCHAR *cn) const noexcept
+{
+  const auto [first, last] =
+    std::equal_range(callsign_index.begin(), callsign_index.end(), cn,
+                     [this](const auto &a, const auto &b){
+                       return StringCompare(GetCallSign(a),
+                                            GetCallSign(b)) < 0;
+                     });
+
+  return {first, last};
+}
+
+const FlarmNetRecord *
+FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const noexcept
+{
+  const auto range = FindCallSign(cn);
+  return range.empty()
+    ? NULL
+    : &records[range.front()];
 }
 
 unsigned
 FlarmNetDatabase::FindRecordsByCallSign(const TCHAR *cn,
                                         const FlarmNetRecord *array[],
-                                        [[maybe_unused]] unsigned size) const noexcept
+                                        unsigned size) const noexcept
 {
   unsigned count = 0;
 
-  for (const auto &[id, record] : map) {
-    assert(id.IsDefined());
+  for (const uint32_t i : FindCallSign(cn)) {
+    if (count >= size)
+      break;
 
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = &record;
+    array[count++] = &records[i];
   }
 
   return count;
@@ -49,15 +148,15 @@ FlarmNetDatabase::FindRecordsByCallSign(const TCHAR *cn,
 
 unsigned
 FlarmNetDatabase::FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
-                                    [[maybe_unused]] unsigned size) const noexcept
+                                    unsigned size) const noexcept
 {
   unsigned count = 0;
 
-  for (const auto &[id, record] : map) {
-    assert(id.IsDefined());
+  for (const uint32_t i : FindCallSign(cn)) {
+    if (count >= size)
+      break;
 
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = id;
+    array[count++] = ids[i];
   }
 
   return count;
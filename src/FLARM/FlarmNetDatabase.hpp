@@ -6,39 +6,102 @@
 #include "Id.hpp"
 #include "FlarmNetRecord.hpp"
 
-#include <map>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
 #include <tchar.h>
 
+class FileMapping;
+
 /**
  * An in-memory representation of the FlarmNet.org database.
+ *
+ * The records are stored in an array sorted by id, with a secondary
+ * index sorted by callsign; both lookups are binary searches.  The
+ * arrays are either owned by this object (after parsing the text
+ * file) or mapped from a binary cache file (see #FlarmNetCache).
  */
 class FlarmNetDatabase {
-  typedef std::map<FlarmId, FlarmNetRecord> RecordMap;
-  RecordMap map;
+  /**
+   * Owned storage, used while (and after) loading the text file.
+   */
+  std::vector<FlarmId> owned_ids;
+  std::vector<FlarmNetRecord> owned_records;
+  std::vector<uint32_t> owned_callsign_index;
+
+  /**
+   * The binary cache file which contains the arrays below, or
+   * nullptr if they point to the owned storage.
+   */
+  std::unique_ptr<FileMapping> mapping;
+
+  /**
+   * The ids of all records, sorted; each element corresponds to the
+   * element of #records with the same index.
+   */
+  std::span<const FlarmId> ids;
+
+  std::span<const FlarmNetRecord> records;
+
+  /**
+   * Indexes into #records, sorted by callsign.
+   */
+  std::span<const uint32_t> callsign_index;
 
 public:
+  FlarmNetDatabase() noexcept;
+  ~FlarmNetDatabase() noexcept;
+
+  FlarmNetDatabase(const FlarmNetDatabase &) = delete;
+  FlarmNetDatabase &operator=(const FlarmNetDatabase &) = delete;
+
   bool IsEmpty() const noexcept {
-    return map.empty();
+    return records.empty();
   }
 
-  void Clear() noexcept {
-    map.clear();
-  }
+  void Clear() noexcept;
 
+  /**
+   * Add a record.  It will not be found until Finish() is called.
+   */
   void Insert(const FlarmNetRecord &record) noexcept;
 
+  /**
+   * Sort the records inserted with Insert() and build the callsign
+   * index.  Of several records with the same id, only the first one
+   * is kept.
+   */
+  void Finish() noexcept;
+
+  /**
+   * Use arrays from a mapped cache file (instead of Insert()).  They
+   * must be sorted the way Finish() does it.
+   */
+  void Adopt(std::unique_ptr<FileMapping> &&_mapping,
+             std::span<const FlarmId> _ids,
+             std::span<const FlarmNetRecord> _records,
+             std::span<const uint32_t> _callsign_index) noexcept;
+
+  std::span<const FlarmId> GetIds() const noexcept {
+    return ids;
+  }
+
+  std::span<const FlarmNetRecord> GetRecords() const noexcept {
+    return records;
+  }
+
+  std::span<const uint32_t> GetCallSignIndex() const noexcept {
+    return callsign_index;
+  }
+
   /**
    * Finds a FLARMNetRecord object based on the given FLARM id
    * @param id FLARM id
    * @return FLARMNetRecord object
    */
   [[gnu::pure]]
-  const FlarmNetRecord *FindRecordById(FlarmId id) const noexcept {
-    auto i = map.find(id);
-    return i != map.end()
-      ? &i->second
-      : NULL;
-  }
+  const FlarmNetRecord *FindRecordById(FlarmId id) const noexcept;
 
   /**
    * Finds a FLARMNetRecord object based on the given Callsign
@@ -56,11 +119,27 @@ public:
 
   [[gnu::pure]]
   auto begin() const noexcept {
-    return map.begin();
+    return records.begin();
   }
 
   [[gnu::pure]]
   auto end() const noexcept {
-    return map.end();
+    return records.end();
+  }
+
+private:
+  const TCHAR *GetCallSign(uint32_t i) const noexcept {
+    return records[i].callsign;
+  }
+
+  static const TCHAR *GetCallSign(const TCHAR *cn) noexcept {
+    return cn;
   }
+
+  /**
+   * Returns the range of #callsign_index matching the given
+   * callsign.
+   */
+  [[gnu::pure]]
+  std::span<const uint32_t> FindCallSign(const TCHAR *cn) const noexcept;
 };
@@ -7,7 +7,8 @@
 #include "util/CharUtil.hxx"
 #include "util/StringStrip.hxx"
 #include "io/LineReader.hpp"
-#include "io/FileLineReader.hpp"
+#include "io/MappedLineReader.hpp"
+#include "system/Path.hpp"
 
 #ifndef _UNICODE
 #include "util/UTF8.hpp"
@@ -119,13 +120,14 @@ FlarmNetReader::LoadFile(NLineReader &reader, FlarmNetDatabase &database)
     }
   }
 
+  database.Finish();
   return itemCount;
 }
 
 unsigned
 FlarmNetReader::LoadFile(Path path, FlarmNetDatabase &database)
 try {
-  FileLineReaderA file(path);
+  MappedLineReaderA file(path);
   return LoadFile(file, database);
 } catch (...) {
   return 0;
@@ -5,11 +5,15 @@
 #include "Global.hpp"
 #include "TrafficDatabases.hpp"
 #include "FlarmNetReader.hpp"
+#include "FlarmNetCache.hpp"
+#include "Details.hpp"
 #include "NameFile.hpp"
 #include "Components.hpp"
 #include "MergeThread.hpp"
 #include "LocalPath.hpp"
+#include "StartupTrace.hpp"
 #include "io/DataFile.hpp"
+#include "io/FileCache.hpp"
 #include "io/LineReader.hpp"
 #include "io/FileOutputStream.hxx"
 #include "io/BufferedOutputStream.hxx"
@@ -30,9 +34,26 @@ try {
     return;
   }
 
+  if (file_cache != nullptr) {
+    unsigned num_records = FlarmNetCache::Load(*file_cache, path, db);
+    if (num_records > 0) {
+      LogFormat("%u FLARMnet ids found in cache", num_records);
+      return;
+    }
+  }
+
   unsigned num_records = FlarmNetReader::LoadFile(path, db);
-  if (num_records > 0)
+  if (num_records > 0) {
     LogFormat("%u FLARMnet ids found", num_records);
+
+    if (file_cache != nullptr) {
+      try {
+        FlarmNetCache::Save(*file_cache, path, db);
+      } catch (...) {
+        LogError(std::current_exception(), "Failed to save FLARMnet cache");
+      }
+    }
+  }
 } catch (...) {
   LogError(std::current_exception());
 }
@@ -71,10 +92,15 @@ ReloadFlarmDatabases() noexcept
      databases */
   merge_thread->Suspend();
 
-  LoadSecondary(traffic_databases->flarm_names);
-  LoadFLARMnet(traffic_databases->flarm_net);
+  {
+    const StartupTrace::Timer trace_timer{StartupStage::FLARMNET};
+    LoadSecondary(traffic_databases->flarm_names);
+    LoadFLARMnet(traffic_databases->flarm_net);
+  }
   Profile::Load(Profile::map, traffic_databases->flarm_colors);
 
+  FlarmDetails::Invalidate();
+
   merge_thread->Resume();
 }
 
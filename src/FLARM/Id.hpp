@@ -15,6 +15,7 @@
  */
 class FlarmId {
   static constexpr uint32_t UNDEFINED_VALUE = 0;
+  static constexpr uint32_t FOREIGN_FLAG = 0x80000000;
 
   uint32_t value;
 
@@ -28,6 +29,20 @@ public:
     return FlarmId(UNDEFINED_VALUE);
   }
 
+  /**
+   * Convert the id of a target received from another traffic system
+   * (e.g. GliderLink).  FLARM ids and ICAO addresses have 24 bits;
+   * these have the most significant bit set, so they never collide
+   * with them.
+   */
+  static constexpr FlarmId Foreign(uint32_t value) noexcept {
+    return FlarmId(FOREIGN_FLAG | value);
+  }
+
+  constexpr bool IsForeign() const noexcept {
+    return (value & FOREIGN_FLAG) != 0;
+  }
+
   constexpr bool IsDefined() const noexcept {
     return value != UNDEFINED_VALUE;
   }
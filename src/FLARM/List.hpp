@@ -7,14 +7,27 @@
 #include "NMEA/Validity.hpp"
 #include "util/TrivialArray.hxx"
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <type_traits>
 
 /**
  * This class keeps track of the traffic objects received from a
  * FLARM.
+ *
+ * The list is sorted by #FlarmId, which allows looking up a target
+ * with a binary search and merging two lists in linear time.  A
+ * target keeps its place relative to the others while it is
+ * visible.
+ *
+ * @param N the capacity
  */
-struct TrafficList {
-  static constexpr size_t MAX_COUNT = 25;
+template<std::size_t N>
+struct BasicTrafficList {
+  static constexpr size_t MAX_COUNT = N;
+
+  static_assert(N <= 256, "threat indexes are 8 bit");
 
   /**
    * Time stamp of the latest modification to this object.
@@ -26,13 +39,44 @@ struct TrafficList {
    */
   Validity new_traffic;
 
-  /** Flarm traffic information */
+  /** Flarm traffic information, sorted by id */
   TrivialArray<FlarmTraffic, MAX_COUNT> list;
 
+  /**
+   * Indexes into #list, the most threatening target first.  This is
+   * calculated by FlarmComputer after each merge (see
+   * FlarmThreat::Update()) and cleared by every modification of
+   * #list; check HasThreatOrder() before using it.
+   */
+  TrivialArray<uint8_t, MAX_COUNT> threats;
+
   constexpr void Clear() noexcept {
     modified.Clear();
     new_traffic.Clear();
     list.clear();
+    threats.clear();
+  }
+
+  /**
+   * Like the assignment operator, but copies only the used part of
+   * the arrays, which is usually much smaller than the capacity.
+   */
+  constexpr void CopyFrom(const BasicTrafficList &src) noexcept {
+    modified = src.modified;
+    new_traffic = src.new_traffic;
+
+    list.resize(src.list.size());
+    std::copy(src.list.begin(), src.list.end(), list.begin());
+
+    threats.resize(src.threats.size());
+    std::copy(src.threats.begin(), src.threats.end(), threats.begin());
+  }
+
+  /**
+   * Is #threats up to date with #list?
+   */
+  constexpr bool HasThreatOrder() const noexcept {
+    return !list.empty() && threats.size() == list.size();
   }
 
   constexpr bool IsEmpty() const noexcept {
@@ -43,7 +87,9 @@ struct TrafficList {
    * Adds data from the specified object, unless already present in
    * this one.
    */
-  constexpr void Complement(const TrafficList &add) noexcept {
+  constexpr void Complement(const BasicTrafficList &add) noexcept {
+    threats.clear();
+
     if (add.modified.Modified(modified))
       modified = add.modified;
 
@@ -51,19 +97,54 @@ struct TrafficList {
       new_traffic = add.new_traffic;
 
     if (list.empty() && !add.list.empty()) {
-      /* don't bother merging the two lists, we can simply memcpy()
-         it */
-      list = add.list;
+      /* don't bother merging the two lists, we can simply copy it;
+         only the used elements, not the whole array */
+      list.resize(add.list.size());
+      std::copy(add.list.begin(), add.list.end(), list.begin());
       return;
     }
 
-    // Add unique traffic from 'add' list
-    for (auto &traffic : add.list) {
-      if (FindTraffic(traffic.id) == nullptr) {
-        FlarmTraffic * new_traffic = AllocateTraffic();
-        if (new_traffic == nullptr)
-          return;
-        *new_traffic = traffic;
+    /* count the unique traffic in 'add'; if they don't all fit, the
+       ones with the highest ids are dropped */
+    std::size_t n_missing = 0;
+    for (const FlarmTraffic *i = list.begin(), *j = add.list.begin();
+         j != add.list.end();) {
+      if (i == list.end() || j->id < i->id) {
+        ++n_missing;
+        ++j;
+      } else if (i->id < j->id) {
+        ++i;
+      } else {
+        ++i;
+        ++j;
+      }
+    }
+
+    const std::size_t room = list.capacity() - list.size();
+    std::size_t n_skip = n_missing > room ? n_missing - room : 0;
+    n_missing -= n_skip;
+    if (n_missing == 0)
+      return;
+
+    /* merge from the back, so every element moves at most once */
+    std::size_t i = list.size(), j = add.list.size();
+    list.resize(list.size() + n_missing);
+    std::size_t dest = list.size();
+
+    while (j > 0 && dest > i) {
+      const FlarmTraffic &a = add.list[j - 1];
+      if (i > 0 && !(list[i - 1].id < a.id)) {
+        if (list[i - 1].id == a.id)
+          /* already present */
+          --j;
+
+        list[--dest] = list[--i];
+      } else {
+        --j;
+        if (n_skip > 0)
+          --n_skip;
+        else
+          list[--dest] = a;
       }
     }
   }
@@ -72,9 +153,15 @@ struct TrafficList {
     modified.Expire(clock, std::chrono::minutes(5));
     new_traffic.Expire(clock, std::chrono::minutes(1));
 
-    for (unsigned i = list.size(); i-- > 0;)
-      if (!list[i].Refresh(clock))
-        list.quick_remove(i);
+    threats.clear();
+
+    /* remove expired traffic, preserving the order */
+    auto dest = list.begin();
+    for (auto &traffic : list)
+      if (traffic.Refresh(clock))
+        *dest++ = traffic;
+
+    list.resize(std::distance(list.begin(), dest));
   }
 
   constexpr unsigned GetActiveTrafficCount() const noexcept {
@@ -88,11 +175,10 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   constexpr FlarmTraffic *FindTraffic(FlarmId id) noexcept {
-    for (auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    auto i = LowerBound(id);
+    return i != list.end() && i->id == id
+      ? i
+      : NULL;
   }
 
   /**
@@ -102,11 +188,10 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   constexpr const FlarmTraffic *FindTraffic(FlarmId id) const noexcept {
-    for (const auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    auto i = LowerBound(id);
+    return i != list.end() && i->id == id
+      ? i
+      : NULL;
   }
 
   /**
@@ -138,14 +223,38 @@ struct TrafficList {
   }
 
   /**
-   * Allocates a new FLARM_TRAFFIC object from the array.
+   * Allocates a new FLARM_TRAFFIC object with the given id, which
+   * must not be in the list already.  All other attributes are
+   * cleared.
    *
    * @return the FLARM_TRAFFIC pointer, NULL if the array is full
    */
-  constexpr FlarmTraffic *AllocateTraffic() noexcept {
-    return list.full()
-      ? NULL
-      : &list.append();
+  constexpr FlarmTraffic *AllocateTraffic(FlarmId id) noexcept {
+    if (list.full())
+      return NULL;
+
+    const std::size_t i = std::distance(list.begin(), LowerBound(id));
+    assert(i == list.size() || list[i].id != id);
+
+    threats.clear();
+
+    list.append();
+    std::move_backward(list.begin() + i, list.end() - 1, list.end());
+
+    FlarmTraffic &traffic = list[i];
+    traffic.Clear();
+    traffic.id = id;
+    return &traffic;
+  }
+
+  /**
+   * Removes the traffic with the given id, if present.
+   */
+  constexpr void RemoveTraffic(FlarmId id) noexcept {
+    if (const FlarmTraffic *traffic = FindTraffic(id)) {
+      threats.clear();
+      list.remove(TrafficIndex(traffic));
+    }
   }
 
   /**
@@ -180,6 +289,31 @@ struct TrafficList {
     return list.empty() ? NULL : list.end() - 1;
   }
 
+  constexpr unsigned TrafficIndex(const FlarmTraffic *t) const noexcept {
+    return t - list.begin();
+  }
+
+private:
+  constexpr FlarmTraffic *LowerBound(FlarmId id) noexcept {
+    return std::lower_bound(list.begin(), list.end(), id,
+                            [](const FlarmTraffic &traffic, FlarmId id){
+                              return traffic.id < id;
+                            });
+  }
+
+  constexpr const FlarmTraffic *LowerBound(FlarmId id) const noexcept {
+    return std::lower_bound(list.begin(), list.end(), id,
+                            [](const FlarmTraffic &traffic, FlarmId id){
+                              return traffic.id < id;
+                            });
+  }
+};
+
+/**
+ * The traffic received from a FLARM.  Targets received via ADS-B
+ * which are not a collision threat go to #AdsbTrafficList instead.
+ */
+struct TrafficList : BasicTrafficList<50> {
   /**
    * Finds the most critical alert.  Returns NULL if there is no
    * alert.
@@ -187,10 +321,6 @@ struct TrafficList {
   [[gnu::pure]]
   const FlarmTraffic *FindMaximumAlert() const noexcept;
 
-  constexpr unsigned TrafficIndex(const FlarmTraffic *t) const noexcept {
-    return t - list.begin();
-  }
-
   /**
    * Is set if traffic is present and closer than 4Km.
    */
@@ -198,3 +328,13 @@ struct TrafficList {
 };
 
 static_assert(std::is_trivial<TrafficList>::value, "type is not trivial");
+
+/**
+ * Traffic received via ADS-B, Mode-S and their rebroadcasts.  There
+ * can be many more of these than FLARM targets, so this list is
+ * larger; targets which are too far away to matter are dropped by
+ * the parser.
+ */
+using AdsbTrafficList = BasicTrafficList<100>;
+
+static_assert(std::is_trivial<AdsbTrafficList>::value, "type is not trivial");
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "NameCache.hpp"
+#include "Details.hpp"
+
+const TCHAR *
+FlarmNameCache::Lookup(FlarmId id) noexcept
+{
+  const unsigned current = FlarmDetails::GetGeneration();
+  if (current != generation || names.size() >= MAX_SIZE) {
+    names.clear();
+    generation = current;
+  }
+
+  auto [i, inserted] = names.try_emplace(id, nullptr);
+  if (inserted)
+    i->second = FlarmDetails::LookupCallsign(id);
+
+  return i->second;
+}
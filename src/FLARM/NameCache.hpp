@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Id.hpp"
+
+#include <map>
+#include <tchar.h>
+
+/**
+ * Remembers the result of FlarmDetails::LookupCallsign() for each
+ * FLARM id, including the ids which were not found, so the traffic
+ * loop doesn't search the databases again on every update.  The
+ * cache is flushed when FlarmDetails::GetGeneration() changes.
+ *
+ * This class is not thread-safe; it is owned by the thread which
+ * calls Lookup().
+ */
+class FlarmNameCache {
+  /**
+   * Flush the cache when it grows beyond this number of entries.
+   * This is much more than one can expect to see at a time.
+   */
+  static constexpr std::size_t MAX_SIZE = 256;
+
+  /**
+   * The callsign for each id which has been looked up; nullptr
+   * means the id is not in any database.  The pointers refer to the
+   * databases and become invalid when #generation changes.
+   */
+  std::map<FlarmId, const TCHAR *> names;
+
+  /**
+   * The value of FlarmDetails::GetGeneration() when #names was
+   * filled.
+   */
+  unsigned generation = 0;
+
+public:
+  /**
+   * Look up the callsign of the given FLARM id.
+   *
+   * @return the callsign or nullptr if it is unknown
+   */
+  const TCHAR *Lookup(FlarmId id) noexcept;
+};
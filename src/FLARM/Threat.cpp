@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Threat.hpp"
+#include "List.hpp"
+#include "Geo/SpeedVector.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+/**
+ * Calculate the closest point of approach of one target.  The
+ * relative position and velocity are in meters and meters per
+ * second (north, east).
+ */
+static void
+UpdateClosestApproach(FlarmTraffic &traffic,
+                      double own_north, double own_east) noexcept
+{
+  const auto sc = Angle(traffic.track).SinCos();
+  const double speed = double(traffic.speed);
+  const double v_north = speed * sc.second - own_north;
+  const double v_east = speed * sc.first - own_east;
+  const double p_north = traffic.relative_north;
+  const double p_east = traffic.relative_east;
+
+  const double v_squared = v_north * v_north + v_east * v_east;
+  const double closing = -(p_north * v_north + p_east * v_east);
+
+  /* only approaching targets have a closest point in the future */
+  const double t = v_squared > 0 && closing > 0
+    ? closing / v_squared
+    : 0;
+
+  traffic.cpa_time = t;
+  traffic.cpa_distance = hypot(p_north + v_north * t, p_east + v_east * t);
+  traffic.cpa_available = true;
+}
+
+[[gnu::const]]
+static unsigned
+GetSeverity(FlarmTraffic::AlarmType alarm_level) noexcept
+{
+  switch (alarm_level) {
+  case FlarmTraffic::AlarmType::URGENT:
+    return 3;
+
+  case FlarmTraffic::AlarmType::IMPORTANT:
+    return 2;
+
+  case FlarmTraffic::AlarmType::LOW:
+  case FlarmTraffic::AlarmType::INFO_ALERT:
+    return 1;
+
+  case FlarmTraffic::AlarmType::NONE:
+  case FlarmTraffic::AlarmType::OFFLINE:
+    break;
+  }
+
+  return 0;
+}
+
+/**
+ * The distance used for ranking targets with the same alarm level.
+ */
+[[gnu::pure]]
+static double
+GetThreatDistance(const FlarmTraffic &traffic) noexcept
+{
+  const double horizontal =
+    traffic.cpa_available && traffic.cpa_time <= FlarmThreat::HORIZON
+    ? traffic.cpa_distance
+    : double(traffic.distance);
+
+  return hypot(horizontal, double(traffic.relative_altitude));
+}
+
+void
+FlarmThreat::Update(TrafficList &traffic,
+                    std::optional<SpeedVector> own_velocity) noexcept
+{
+  double own_north = 0, own_east = 0;
+  if (own_velocity) {
+    const auto sc = own_velocity->bearing.SinCos();
+    own_north = own_velocity->norm * sc.second;
+    own_east = own_velocity->norm * sc.first;
+  }
+
+  double threat_distance[TrafficList::MAX_COUNT];
+
+  for (unsigned i = 0; i < traffic.list.size(); ++i) {
+    FlarmTraffic &target = traffic.list[i];
+
+    /* the target's velocity is only known if the FLARM sent it */
+    if (own_velocity && target.track_received && target.speed_received)
+      UpdateClosestApproach(target, own_north, own_east);
+    else
+      target.cpa_available = false;
+
+    threat_distance[i] = GetThreatDistance(target);
+  }
+
+  traffic.threats.resize(traffic.list.size());
+  std::iota(traffic.threats.begin(), traffic.threats.end(), 0);
+  std::sort(traffic.threats.begin(), traffic.threats.end(),
+            [&traffic, &threat_distance](uint8_t a, uint8_t b){
+              const unsigned severity_a =
+                GetSeverity(traffic.list[a].alarm_level);
+              const unsigned severity_b =
+                GetSeverity(traffic.list[b].alarm_level);
+              if (severity_a != severity_b)
+                return severity_a > severity_b;
+
+              return threat_distance[a] < threat_distance[b];
+            });
+}
@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <optional>
+
+struct TrafficList;
+struct SpeedVector;
+
+namespace FlarmThreat {
+
+/**
+ * Targets whose closest point of approach is further in the future
+ * are ranked by their current distance.
+ */
+static constexpr double HORIZON = 60;
+
+/**
+ * Calculate the closest point of approach of all targets and rank
+ * them by threat: FLARM's own alarm level first, then the distance
+ * at the closest point of approach (or the current distance if that
+ * isn't known or beyond #HORIZON), combined with the vertical
+ * separation.  The result is stored in TrafficList::threats.
+ *
+ * @param own_velocity our own velocity over ground, or std::nullopt
+ * if unknown (then only the current distance is used)
+ */
+void
+Update(TrafficList &traffic,
+       std::optional<SpeedVector> own_velocity) noexcept;
+
+} // namespace FlarmThreat
@@ -25,6 +25,25 @@ struct FlarmTraffic {
     OFFLINE = 5,
   };
 
+  /**
+   * Where the FLARM received this target from (PFLAA field
+   * "Source", since data port protocol 8).
+   */
+  enum class Source : uint8_t {
+    FLARM = 0,
+    ADSB = 1,
+    ADSR = 3, //!< ADS-B rebroadcast
+    TISB = 4,
+    MODES = 6,
+
+    /**
+     * Not a PFLAA value: received from the GliderLink app.  These
+     * targets have an absolute position (see HasAbsolutePosition())
+     * and a FlarmId::Foreign() id.
+     */
+    GLIDER_LINK = 0x80,
+  };
+
   /**
    * FLARM aircraft types
    * @see http://www.flarm.com/support/manual/FLARM_DataportManual_v4.06E.pdf
@@ -60,6 +79,18 @@ struct FlarmTraffic {
   /** Average climb rate over 30s */
   double climb_rate_avg30s;
 
+  /**
+   * Horizontal distance at the closest point of approach [m],
+   * assuming both aircraft keep their current track and speed.
+   */
+  double cpa_distance;
+
+  /**
+   * Time until the closest point of approach [s]; zero if the
+   * distance is not decreasing.
+   */
+  double cpa_time;
+
   /** Latitude-based distance of the FLARM target */
   double relative_north;
 
@@ -95,6 +126,8 @@ struct FlarmTraffic {
   /** Type of the aircraft */
   AircraftType type;
 
+  Source source;
+
   /** Is the target in stealth mode */
   bool stealth;
 
@@ -119,6 +152,9 @@ struct FlarmTraffic {
   /** Has the averaged climb rate of the target been calculated yet? */
   bool climb_rate_avg30s_available;
 
+  /** Have #cpa_distance and #cpa_time been calculated? */
+  bool cpa_available;
+
   bool IsDefined() const noexcept {
     return valid;
   }
@@ -144,6 +180,22 @@ struct FlarmTraffic {
     return Angle::FromXY(relative_north, relative_east);
   }
 
+  /**
+   * Was this target received by the FLARM from another system than
+   * FLARM?
+   */
+  bool IsAdsb() const noexcept {
+    return source != Source::FLARM && source != Source::GLIDER_LINK;
+  }
+
+  /**
+   * Was the absolute position of this target received (and the
+   * relative one is calculated), instead of the other way round?
+   */
+  bool HasAbsolutePosition() const noexcept {
+    return source == Source::GLIDER_LINK;
+  }
+
   bool IsPowered() const noexcept {
     return type != AircraftType::GLIDER &&
            type != AircraftType::HANG_GLIDER &&
@@ -160,7 +212,10 @@ struct FlarmTraffic {
    * @return true if the object is still valid
    */
   bool Refresh(TimeStamp Time) noexcept {
-    valid.Expire(Time, std::chrono::seconds(2));
+    /* GliderLink reports are much less frequent than FLARM's */
+    valid.Expire(Time, source == Source::GLIDER_LINK
+                 ? std::chrono::seconds(std::chrono::minutes(5))
+                 : std::chrono::seconds(2));
     return valid;
   }
 
@@ -23,6 +23,7 @@ void
 FlightStatistics::Reset() noexcept
 {
   const std::lock_guard lock{mutex};
+  ++generation;
 
   thermal_average.Reset();
   altitude.Reset();
@@ -38,6 +39,7 @@ void
 FlightStatistics::StartTask() noexcept
 {
   const std::lock_guard lock{mutex};
+  ++generation;
   // JMW clear thermal climb average on task start
   //  thermal_average.Reset();
   vario_circling_histogram.Clear();
@@ -49,6 +51,7 @@ FlightStatistics::AddAltitudeTerrain(const FloatDuration tflight,
                                      const double terrainalt) noexcept
 {
   const std::lock_guard lock{mutex};
+  ++generation;
   altitude_terrain.Update(ToNormalisedHours(tflight), terrainalt);
 }
 
@@ -59,6 +62,7 @@ FlightStatistics::AddAltitude(const FloatDuration tflight,
   const double t = ToNormalisedHours(tflight);
 
   const std::lock_guard lock{mutex};
+  ++generation;
 
   altitude.Update(t, alt);
 
@@ -96,6 +100,7 @@ FlightStatistics::AddTaskSpeed(const FloatDuration tflight,
                                const double val) noexcept
 {
   const std::lock_guard lock{mutex};
+  ++generation;
   task_speed.Update(ToHours(tflight), val);
 }
 
@@ -104,6 +109,7 @@ FlightStatistics::AddClimbBase(const FloatDuration tflight,
                                const double alt) noexcept
 {
   const std::lock_guard lock{mutex};
+  ++generation;
 
   // only add base after finished second climb, to avoid having the takeoff height
   // as the base
@@ -117,6 +123,7 @@ FlightStatistics::AddClimbCeiling(const FloatDuration tflight,
                                   const double alt) noexcept
 {
   const std::lock_guard lock{mutex};
+  ++generation;
   altitude_ceiling.UpdateConvexPositive(ToNormalisedHours(tflight), alt);
 }
 
@@ -130,6 +137,7 @@ FlightStatistics::AddThermalAverage(const FloatDuration tflight_start,
                                     const double v) noexcept
 {
   const std::lock_guard lock{mutex};
+  ++generation;
   thermal_average.Update(ToNormalisedHours(tflight_start), v,
                          ToHours(tflight_end - tflight_start));
 }
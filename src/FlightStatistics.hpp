@@ -21,6 +21,21 @@ public:
   Histogram vario_cruise_histogram;
   mutable Mutex mutex;
 
+private:
+  /**
+   * Incremented by each modification except AddClimbRate(), which
+   * happens every second while flying.  This allows charts to skip
+   * repainting if the statistics have not changed.  Protected by
+   * #mutex.
+   */
+  unsigned generation = 0;
+
+public:
+  unsigned GetGeneration() const noexcept {
+    const std::lock_guard lock{mutex};
+    return generation;
+  }
+
   void StartTask() noexcept;
 
   [[gnu::pure]]
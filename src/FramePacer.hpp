@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Decides when the #DrawThread paints the next frame.  Redraw
+ * requests are coalesced until the frame begins, and frames are
+ * spaced at least #min_interval apart unless a request comes from
+ * user input (pan, zoom), which shall feel immediate.
+ *
+ * This class is not thread-safe; the caller is responsible for
+ * locking.
+ */
+class FramePacer {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Priority : uint8_t {
+    /**
+     * New sensor or calculation data.  With the "static scene"
+     * option, the frame may be skipped if nothing visible has
+     * changed.
+     */
+    DATA,
+
+    /**
+     * The map settings, the layout or the map data have changed;
+     * this frame must be painted.
+     */
+    NORMAL,
+
+    /**
+     * User input such as panning or zooming: paint as soon as
+     * possible, ignoring the frame rate limit.
+     */
+    INPUT,
+  };
+
+  /**
+   * Even in a static scene, paint at least this often, to catch up
+   * with changes that are not part of the scene comparison.
+   */
+  static constexpr Clock::duration MAX_STATIC_INTERVAL =
+    std::chrono::seconds{10};
+
+private:
+  Clock::duration min_interval{};
+
+  /**
+   * When did the last frame begin (painted or skipped)?
+   */
+  Clock::time_point last_frame{};
+
+  /**
+   * When was the last frame painted?
+   */
+  Clock::time_point last_paint{};
+
+  Priority priority;
+
+  bool pending = false;
+
+  bool static_scene = false;
+
+public:
+  /**
+   * The minimum interval between two frames for the given frame
+   * rate, where 0 means the default for this kind of device (see
+   * GetDefaultFrameRate()).
+   */
+  [[gnu::const]]
+  static constexpr Clock::duration GetMinInterval(unsigned frame_rate,
+                                                  bool epaper) noexcept {
+    if (frame_rate == 0)
+      frame_rate = GetDefaultFrameRate(epaper);
+
+    return frame_rate > 0
+      ? Clock::duration{std::chrono::seconds{1}} / frame_rate
+      : Clock::duration{};
+  }
+
+  /**
+   * Electronic paper is slow and ghosts, so it gets two frames per
+   * second; other displays are not limited (0).
+   */
+  [[gnu::const]]
+  static constexpr unsigned GetDefaultFrameRate(bool epaper) noexcept {
+    return epaper ? 2 : 0;
+  }
+
+  void SetMinInterval(Clock::duration _min_interval) noexcept {
+    min_interval = _min_interval;
+  }
+
+  Clock::duration GetMinInterval() const noexcept {
+    return min_interval;
+  }
+
+  void SetStaticScene(bool _static_scene) noexcept {
+    static_scene = _static_scene;
+  }
+
+  bool IsPending() const noexcept {
+    return pending;
+  }
+
+  /**
+   * Request a frame.  Requests are merged until the frame begins;
+   * the merged request has the highest priority of all.
+   *
+   * @return false if a frame was already pending (i.e. this request
+   * was coalesced with an older one)
+   */
+  bool Request(Priority _priority) noexcept {
+    if (pending) {
+      priority = std::max(priority, _priority);
+      return false;
+    }
+
+    pending = true;
+    priority = _priority;
+    return true;
+  }
+
+  /**
+   * How long shall the caller wait before beginning the pending
+   * frame?  Returns zero if it may begin now.
+   */
+  [[gnu::pure]]
+  Clock::duration GetDelay(Clock::time_point now) const noexcept {
+    if (!pending || priority == Priority::INPUT)
+      return {};
+
+    const auto elapsed = now - last_frame;
+    return elapsed < min_interval
+      ? min_interval - elapsed
+      : Clock::duration{};
+  }
+
+  /**
+   * Begin the pending frame and clear the request.
+   *
+   * @return the priority of the (merged) request
+   */
+  Priority Begin(Clock::time_point now) noexcept {
+    pending = false;
+    last_frame = now;
+    return priority;
+  }
+
+  /**
+   * May the frame which was begun with the given priority be
+   * skipped?  This is only allowed for #Priority::DATA in "static
+   * scene" mode, if the caller has found the scene unchanged and the
+   * last painted frame is not too old.
+   */
+  [[gnu::pure]]
+  bool MaySkip(Priority _priority, Clock::time_point now) const noexcept {
+    return static_scene && _priority == Priority::DATA &&
+      now - last_paint < MAX_STATIC_INTERVAL;
+  }
+
+  /**
+   * The frame was painted.
+   */
+  void Painted(Clock::time_point now) noexcept {
+    last_paint = now;
+  }
+};
@@ -143,12 +143,19 @@ FlarmTrafficWindow::UpdateSelector(const FlarmId id,
 }
 
 /**
- * Iterates through the traffic array, finds the target with the highest
- * alarm level and saves it to "warning".
+ * Finds the target with the highest alarm level and saves it to
+ * "warning".  The threat ranking calculated by FlarmComputer is
+ * preferred; without it, the traffic array is searched.
  */
 void
 FlarmTrafficWindow::UpdateWarnings() noexcept
 {
+  if (data.HasThreatOrder()) {
+    const unsigned first = data.threats.front();
+    warning = data.list[first].HasAlarm() ? (int)first : -1;
+    return;
+  }
+
   const FlarmTraffic *alert = data.FindMaximumAlert();
   warning = alert != NULL
     ? (int)data.TrafficIndex(alert)
@@ -516,8 +523,11 @@ FlarmTrafficWindow::PaintRadarTraffic(Canvas &canvas) noexcept
     return;
   }
 
-  // Iterate through the traffic (normal traffic)
-  for (unsigned i = 0; i < data.list.size(); ++i) {
+  /* paint the normal traffic; with a threat ranking, the least
+     threatening first, so the most threatening ends up on top */
+  const bool ranked = data.HasThreatOrder();
+  for (unsigned n = data.list.size(), j = 0; j < n; ++j) {
+    const unsigned i = ranked ? data.threats[n - 1 - j] : j;
     const FlarmTraffic &traffic = data.list[i];
 
     if (!traffic.HasAlarm() &&
@@ -536,7 +546,8 @@ FlarmTrafficWindow::PaintRadarTraffic(Canvas &canvas) noexcept
     return;
 
   // Iterate through the traffic (alarm traffic)
-  for (unsigned i = 0; i < data.list.size(); ++i) {
+  for (unsigned n = data.list.size(), j = 0; j < n; ++j) {
+    const unsigned i = ranked ? data.threats[n - 1 - j] : j;
     const FlarmTraffic &traffic = data.list[i];
 
     if (traffic.HasAlarm())
@@ -9,6 +9,15 @@ struct GeoPoint;
 struct FlatGeoPoint;
 class SearchPoint;
 
+/**
+ * The contribution of the edge from a to b to the winding number of
+ * the point p: +1 for an upward crossing with p left of the edge, -1
+ * for a downward crossing with p right of the edge, 0 otherwise.
+ */
+[[gnu::pure]]
+int
+EdgeWinding(const GeoPoint &p, const GeoPoint &a, const GeoPoint &b) noexcept;
+
 /**
  * Note that this expects the vector to be closed, that is, starting point
  * and ending point are the same
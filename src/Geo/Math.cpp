@@ -137,18 +137,26 @@ Middle(const GeoPoint &a, const GeoPoint &b) noexcept
   return IntermediatePoint(a, b, distance / 2);
 }
 
-void
-DistanceBearing(const GeoPoint &loc1, const GeoPoint &loc2,
+/**
+ * Calculate the sine and cosine of the reduced latitude.
+ */
+static void
+CalcReducedLatitude(Angle latitude, double &sinu, double &cosu) noexcept
+{
+  const auto u = atan((1 - FLATTENING) * latitude.tan());
+  sinu = sin(u);
+  cosu = cos(u);
+}
+
+static void
+DistanceBearing(const GeoPoint &loc1, const double sinu1, const double cosu1,
+                const GeoPoint &loc2,
                 double *distance, Angle *bearing) noexcept
 {
   const auto lon21 = loc2.longitude - loc1.longitude;
 
-  auto u1 = atan((1 - FLATTENING) * loc1.latitude.tan()),
-    u2 = atan((1 - FLATTENING) * loc2.latitude.tan());
-
-  auto sinu1 = sin(u1), cosu1 = cos(u1);
-
-  auto sinu2 = sin(u2), cosu2 = cos(u2);
+  double sinu2, cosu2;
+  CalcReducedLatitude(loc2.latitude, sinu2, cosu2);
 
   auto lambda = lon21.Radians(), lambda_p = Angle::FullCircle().Radians();
 
@@ -219,6 +227,37 @@ DistanceBearing(const GeoPoint &loc1, const GeoPoint &loc2,
       cosu1 * sinu2 - sinu1 * cosu2 * cos(lambda))).AsBearing();
 }
 
+void
+DistanceBearing(const GeoPoint &loc1, const GeoPoint &loc2,
+                double *distance, Angle *bearing) noexcept
+{
+  double sinu1, cosu1;
+  CalcReducedLatitude(loc1.latitude, sinu1, cosu1);
+
+  DistanceBearing(loc1, sinu1, cosu1, loc2, distance, bearing);
+}
+
+GeodesicOrigin::GeodesicOrigin(const GeoPoint &_location) noexcept
+  :location(_location)
+{
+  CalcReducedLatitude(location.latitude, sin_u, cos_u);
+}
+
+void
+GeodesicOrigin::DistanceBearing(const GeoPoint &destination,
+                                double *distance, Angle *bearing) const noexcept
+{
+  ::DistanceBearing(location, sin_u, cos_u, destination, distance, bearing);
+}
+
+double
+GeodesicOrigin::Distance(const GeoPoint &destination) const noexcept
+{
+  double distance;
+  DistanceBearing(destination, &distance, nullptr);
+  return distance;
+}
+
 double
 ProjectedDistance(const GeoPoint &loc1, const GeoPoint &loc2,
                   const GeoPoint &loc3) noexcept
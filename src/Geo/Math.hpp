@@ -10,8 +10,7 @@
 
 #pragma once
 
-struct GeoPoint;
-class Angle;
+#include "GeoPoint.hpp"
 
 /**
  * Calculates projected distance from P3 along line P1-P2.
@@ -45,6 +44,35 @@ Distance(const GeoPoint &loc1, const GeoPoint &loc2) noexcept;
 Angle
 Bearing(const GeoPoint &loc1, const GeoPoint &loc2) noexcept;
 
+/**
+ * Calculates the distances and bearings from one origin to many
+ * locations.  The terms of the formula which depend only on the
+ * origin are calculated only once, in the constructor.  The results
+ * are the same as the ones of DistanceBearing() with the origin as
+ * first location.
+ */
+class GeodesicOrigin {
+  GeoPoint location;
+
+  /**
+   * Sine and cosine of the reduced latitude of the origin.
+   */
+  double sin_u, cos_u;
+
+public:
+  explicit GeodesicOrigin(const GeoPoint &_location) noexcept;
+
+  const GeoPoint &GetLocation() const noexcept {
+    return location;
+  }
+
+  void DistanceBearing(const GeoPoint &destination,
+                       double *distance, Angle *bearing) const noexcept;
+
+  [[gnu::pure]]
+  double Distance(const GeoPoint &destination) const noexcept;
+};
+
 /**
  * Finds the point along a distance dthis (m) between p1 and p2, which are
  * separated by dtotal.
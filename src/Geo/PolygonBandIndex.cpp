@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "PolygonBandIndex.hpp"
+#include "SearchPointVector.hpp"
+#include "ConvexHull/PolygonInterior.hpp"
+
+std::size_t
+PolygonBandIndex::GetEdgeCount(const SearchPointVector &border) noexcept
+{
+  return border.size() < 2 ? 0 : border.size() - 1;
+}
+
+std::size_t
+PolygonBandIndex::GetFirstBand(const SearchPointVector &border,
+                               std::size_t i) const noexcept
+{
+  return GetBand(std::min(border[i].GetLocation().latitude,
+                          border[i + 1].GetLocation().latitude));
+}
+
+void
+PolygonBandIndex::Build(const SearchPointVector &border) noexcept
+{
+  Clear();
+
+  const std::size_t n_edges = GetEdgeCount(border);
+  if (n_edges < MIN_EDGES)
+    return;
+
+  south = north = border.front().GetLocation().latitude;
+  for (const auto &i : border) {
+    south = std::min(south, i.GetLocation().latitude);
+    north = std::max(north, i.GetLocation().latitude);
+  }
+
+  const std::size_t n_bands =
+    std::clamp(n_edges / EDGES_PER_BAND, std::size_t(1), MAX_BANDS);
+  const double height = (north - south).Native();
+  band_scale = height > 0 ? n_bands / height : 0;
+
+  /* count the edges of each band, then fill them in */
+  offsets.assign(n_bands + 1, 0);
+
+  const auto GetLastBand = [this, &border](std::size_t i){
+    return GetBand(std::max(border[i].GetLocation().latitude,
+                            border[i + 1].GetLocation().latitude));
+  };
+
+  for (std::size_t i = 0; i < n_edges; ++i)
+    for (std::size_t b = GetFirstBand(border, i), last = GetLastBand(i);
+         b <= last; ++b)
+      ++offsets[b + 1];
+
+  for (std::size_t b = 0; b < n_bands; ++b)
+    offsets[b + 1] += offsets[b];
+
+  edges.resize(offsets.back());
+
+  std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+  for (std::size_t i = 0; i < n_edges; ++i)
+    for (std::size_t b = GetFirstBand(border, i), last = GetLastBand(i);
+         b <= last; ++b)
+      edges[fill[b]++] = i;
+}
+
+bool
+PolygonBandIndex::IsInside(const SearchPointVector &border,
+                           const GeoPoint &p) const noexcept
+{
+  if (!IsDefined())
+    return border.IsInside(p);
+
+  /* no edge crosses the latitude of a point outside of the bands */
+  if (p.latitude < south || p.latitude > north)
+    return false;
+
+  /* the winding number only depends on the edges crossing the
+     point's latitude, and all of them overlap its band */
+  const std::size_t b = GetBand(p.latitude);
+
+  int wn = 0;
+  for (std::size_t j = offsets[b]; j < offsets[b + 1]; ++j) {
+    const std::size_t i = edges[j];
+    wn += EdgeWinding(p, border[i].GetLocation(),
+                      border[i + 1].GetLocation());
+  }
+
+  return wn != 0;
+}
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Math/Angle.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct GeoPoint;
+class SearchPointVector;
+
+/**
+ * A spatial index of the edges of a closed #SearchPointVector.  The
+ * latitude range of the polygon is divided into equal bands, and each
+ * band lists the edges overlapping it.  A point-in-polygon test only
+ * needs to look at the edges of the point's band, instead of all
+ * edges.
+ *
+ * Edge number i is the line from border[i] to border[i+1].  The
+ * index refers to the geographic locations (not the flat ones), so it
+ * remains valid when the polygon is projected again; it must be
+ * rebuilt when the points are modified.
+ */
+class PolygonBandIndex {
+  /**
+   * Polygons with fewer edges are not indexed; a linear scan is
+   * just as fast.
+   */
+  static constexpr std::size_t MIN_EDGES = 32;
+
+  /**
+   * The average number of edge endpoints per band.
+   */
+  static constexpr std::size_t EDGES_PER_BAND = 4;
+
+  static constexpr std::size_t MAX_BANDS = 4096;
+
+  Angle south, north;
+
+  /**
+   * The number of bands per radian.
+   */
+  double band_scale;
+
+  /**
+   * The edges of band b are edges[offsets[b]..offsets[b+1]].  Empty
+   * if the polygon is not indexed.
+   */
+  std::vector<uint32_t> offsets;
+
+  std::vector<uint32_t> edges;
+
+public:
+  /**
+   * Build the index.  The vector must be closed, i.e. the last point
+   * equals the first one.
+   */
+  void Build(const SearchPointVector &border) noexcept;
+
+  void Clear() noexcept {
+    offsets.clear();
+    edges.clear();
+  }
+
+  bool IsDefined() const noexcept {
+    return !offsets.empty();
+  }
+
+  /**
+   * Is the given point inside the polygon?  This returns the same as
+   * SearchPointVector::IsInside().
+   *
+   * @param border the #SearchPointVector this index was built for
+   */
+  [[gnu::pure]]
+  bool IsInside(const SearchPointVector &border,
+                const GeoPoint &p) const noexcept;
+
+  /**
+   * Invoke f(i) for each edge i whose latitude range may overlap the
+   * specified range, each edge only once.  Without an index, this
+   * visits all edges.
+   */
+  template<typename F>
+  void ForEachEdge(const SearchPointVector &border,
+                   Angle range_south, Angle range_north, F &&f) const {
+    if (!IsDefined()) {
+      for (std::size_t i = 0, n = GetEdgeCount(border); i < n; ++i)
+        f(i);
+      return;
+    }
+
+    if (range_north < south || range_south > north)
+      return;
+
+    const std::size_t first = GetBand(range_south);
+    const std::size_t last = GetBand(range_north);
+    for (std::size_t b = first; b <= last; ++b) {
+      for (std::size_t j = offsets[b]; j < offsets[b + 1]; ++j) {
+        const std::size_t i = edges[j];
+
+        /* an edge spanning more than one band is listed in each of
+           them; visit it only in the first band of both ranges */
+        if (std::max(GetFirstBand(border, i), first) == b)
+          f(i);
+      }
+    }
+  }
+
+  /**
+   * Returns the number of bytes allocated by this object.
+   */
+  [[gnu::pure]]
+  std::size_t GetMemoryUsage() const noexcept {
+    return (offsets.capacity() + edges.capacity()) * sizeof(uint32_t);
+  }
+
+private:
+  [[gnu::pure]]
+  static std::size_t GetEdgeCount(const SearchPointVector &border) noexcept;
+
+  [[gnu::pure]]
+  std::size_t GetBand(Angle latitude) const noexcept {
+    const double b = (latitude - south).Native() * band_scale;
+    const std::size_t n_bands = offsets.size() - 1;
+    return b <= 0 ? 0 : std::min(std::size_t(b), n_bands - 1);
+  }
+
+  [[gnu::pure]]
+  std::size_t GetFirstBand(const SearchPointVector &border,
+                           std::size_t i) const noexcept;
+};
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "FLARM/Id.hpp"
+
 #include <cstdint>
 
 /**
@@ -26,4 +28,12 @@ public:
   bool operator<(GliderLinkId other) const {
     return value < other.value;
   }
+
+  /**
+   * The id of this target in the traffic list (see
+   * FlarmId::Foreign()).
+   */
+  constexpr FlarmId ToFlarmId() const noexcept {
+    return FlarmId::Foreign(value);
+  }
 };
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "PowerInfo.hpp"
+
+namespace Power {
+
+/**
+ * Which fraction of the nominal rate may the contest optimisation
+ * use?  Running on battery with a low charge trades its update rate
+ * for flight time; the safety relevant calculations (logger,
+ * airspace warnings, reach) are not affected.
+ *
+ * @return a value between 0.25 and 1
+ */
+constexpr double
+GetComputeScale(const Info &info) noexcept
+{
+  if (info.external.status == ExternalInfo::Status::ON ||
+      !info.battery.remaining_percent)
+    return 1;
+
+  const unsigned percent = *info.battery.remaining_percent;
+  if (percent >= 60)
+    return 1;
+  else if (percent >= 30)
+    return 0.5;
+  else
+    return 0.25;
+}
+
+} // namespace Power
@@ -11,6 +11,14 @@ struct IGCExtension {
   uint16_t start, finish;
 
   char code[4];
+
+  /**
+   * Index of the #IGCFix attribute this extension is parsed into (see
+   * IGCParseFix()), or -1 if it is not supported.  Looked up once by
+   * IGCParseExtensions(), so parsing B records does not need to
+   * compare codes.
+   */
+  int8_t field;
 };
 
 struct IGCExtensions : public TrivialArray<IGCExtension, 16> {
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "IGCIndex.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std::chrono;
+
+static constexpr IGCIndex::Duration ONE_DAY = hours{24};
+
+void
+IGCIndex::Clear() noexcept
+{
+  entries.clear();
+  last_time = day_offset = {};
+}
+
+void
+IGCIndex::Add(seconds _time, uint_least64_t offset) noexcept
+{
+  const Duration time = duration_cast<Duration>(_time);
+
+  if (!entries.empty() && time + ONE_DAY / 2 < last_time)
+    /* midnight wraparound */
+    day_offset += ONE_DAY;
+
+  last_time = time;
+
+  const Duration unwrapped = time + day_offset;
+  if (entries.empty() || unwrapped >= entries.back().time + INTERVAL)
+    entries.push_back({unwrapped, offset});
+}
+
+uint_least64_t
+IGCIndex::Find(seconds _time) const noexcept
+{
+  assert(!entries.empty());
+
+  Duration time = duration_cast<Duration>(_time);
+
+  /* a time of day earlier than the first record may refer to the
+     following day; pick the one which is nearer to the flight */
+  const Duration front = entries.front().time, back = entries.back().time;
+  if (time < front) {
+    const Duration next_day = time + ONE_DAY;
+    if (next_day <= back || next_day - back < front - time)
+      time = next_day;
+  }
+
+  auto i = std::upper_bound(entries.begin(), entries.end(), time,
+                            [](Duration t, const Entry &e){
+                              return t < e.time;
+                            });
+  if (i != entries.begin())
+    --i;
+
+  return i->offset;
+}
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Maps the time of the B records of an IGC file to their file
+ * offsets, to allow seeking in a replay without parsing every record
+ * in between.  Only one record per #INTERVAL is indexed; the caller
+ * reads forward from there.
+ *
+ * IGC times are UTC seconds of day; a flight which crosses midnight
+ * is "unwrapped" so the indexed times are always ascending.
+ */
+class IGCIndex {
+public:
+  using Duration = std::chrono::duration<uint_least32_t>;
+
+  static constexpr Duration INTERVAL = std::chrono::seconds{10};
+
+private:
+  struct Entry {
+    /**
+     * The unwrapped time since midnight of the first day.
+     */
+    Duration time;
+
+    uint_least64_t offset;
+  };
+
+  std::vector<Entry> entries;
+
+  /**
+   * The time of the previous Add() call, for detecting the midnight
+   * wraparound.
+   */
+  Duration last_time{};
+
+  Duration day_offset{};
+
+public:
+  bool empty() const noexcept {
+    return entries.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return entries.size();
+  }
+
+  void Clear() noexcept;
+
+  /**
+   * Add a B record.  Must be called in file order.
+   *
+   * @param time the UTC time of day of the record
+   * @param offset the file offset of the line
+   */
+  void Add(std::chrono::seconds time, uint_least64_t offset) noexcept;
+
+  /**
+   * Find the offset of the last indexed record at or before the
+   * specified time, or the first record if the flight begins after
+   * it.  Must not be called if the index is empty.
+   *
+   * @param time the UTC time of day
+   */
+  [[gnu::pure]]
+  uint_least64_t Find(std::chrono::seconds time) const noexcept;
+};
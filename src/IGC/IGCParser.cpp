@@ -8,11 +8,15 @@
 #include "IGCDeclaration.hpp"
 #include "time/BrokenDate.hpp"
 #include "time/BrokenTime.hpp"
+#include "util/ByteOrder.hxx"
 #include "util/CharUtil.hxx"
 #include "util/StringAPI.hxx"
 #include "util/StringCompare.hxx"
 
+#include <cstdint>
+
 #include <stdlib.h>
+#include <string.h>
 
 using std::string_view_literals::operator""sv;
 
@@ -106,6 +110,43 @@ ParseTwoDigits(const char *p)
   return (p[0] - '0') * 10 + (p[1] - '0');
 }
 
+/**
+ * The B record extensions which are stored in #IGCFix.
+ */
+static constexpr struct {
+  char code[4];
+
+  int16_t IGCFix::*value;
+
+  /**
+   * Parse only this many leading digits (0 = all).  According to
+   * LXNav, longer columns contain decimal places.
+   */
+  uint8_t max_digits;
+} extension_fields[] = {
+  { "ENL", &IGCFix::enl, 0 },
+  { "RPM", &IGCFix::rpm, 0 },
+  { "HDM", &IGCFix::hdm, 0 },
+  { "HDT", &IGCFix::hdt, 0 },
+  { "TRM", &IGCFix::trm, 0 },
+  { "TRT", &IGCFix::trt, 0 },
+  { "GSP", &IGCFix::gsp, 3 },
+  { "IAS", &IGCFix::ias, 3 },
+  { "TAS", &IGCFix::tas, 3 },
+  { "SIU", &IGCFix::siu, 0 },
+};
+
+[[gnu::pure]]
+static int8_t
+FindExtensionField(const char *code) noexcept
+{
+  for (std::size_t i = 0; i < std::size(extension_fields); ++i)
+    if (StringIsEqual(extension_fields[i].code, code))
+      return i;
+
+  return -1;
+}
+
 static bool
 CheckThreeAlphaNumeric(const char *src)
 {
@@ -151,6 +192,7 @@ IGCParseExtensions(const char *buffer, IGCExtensions &extensions)
     x.finish = finish;
     memcpy(x.code, buffer, 3);
     x.code[3] = 0;
+    x.field = FindExtensionField(x.code);
 
     buffer += 3;
   }
@@ -159,61 +201,189 @@ IGCParseExtensions(const char *buffer, IGCExtensions &extensions)
 }
 
 /**
- * Parse an unsigned integer from the given string range
- * (null-termination is not necessary).
+ * Load 8 bytes as a little-endian integer, i.e. the first character
+ * is in the least significant byte.
+ */
+[[gnu::pure]]
+static inline uint64_t
+LoadLE64(const char *p) noexcept
+{
+  uint64_t value;
+  memcpy(&value, p, sizeof(value));
+  return FromLE64(value);
+}
+
+/**
+ * Are all 8 characters in the (little-endian) word ASCII digits?
+ * This checks all of them at once (SWAR): the upper nibble of each
+ * byte must be 3, and adding 6 must not carry into it.
+ */
+static constexpr bool
+AreEightDigits(uint64_t chars) noexcept
+{
+  constexpr uint64_t high_mask = 0xf0f0f0f0f0f0f0f0;
+  constexpr uint64_t high_3 = 0x3030303030303030;
+  constexpr uint64_t six = 0x0606060606060606;
+
+  return ((chars & high_mask) == high_3) &&
+    (((chars + six) & high_mask) == high_3);
+}
+
+/**
+ * Convert 8 ASCII digits (checked by AreEightDigits()) to pairs of
+ * two-digit numbers in the low byte of each 16 bit lane.
+ */
+static constexpr uint64_t
+DigitsToPairs(uint64_t chars) noexcept
+{
+  const uint64_t digits = chars - 0x3030303030303030;
+  return (digits * 10 + (digits >> 8)) & 0x00ff00ff00ff00ff;
+}
+
+/**
+ * Convert the pairs from DigitsToPairs() to one number.
+ */
+static constexpr uint32_t
+PairsToNumber(uint64_t pairs) noexcept
+{
+  pairs = (pairs * 100 + (pairs >> 16)) & 0x0000ffff0000ffff;
+  return (pairs * 10000 + (pairs >> 32)) & 0xffffffff;
+}
+
+/**
+ * Parse exactly #n (1..8) ASCII digits in one go.  The 8 bytes
+ * ending at p+n must be readable.
  *
- * @param p the string
- * @param end the end of the string
  * @return the result, or -1 on error
  */
+[[gnu::pure]]
 static int
-ParseUnsigned(const char *p, const char *end)
+ParseDigits(const char *p, unsigned n) noexcept
 {
-  unsigned value = 0;
+  assert(n >= 1 && n <= 8);
 
-  for (; p < end; ++p) {
-    if (!IsDigitASCII(*p))
-      return -1;
+  /* load the 8 bytes ending with the last digit and replace the
+     leading ones with '0' */
+  const unsigned shift = (8 - n) * 8;
+  uint64_t chars = LoadLE64(p + n - 8) >> shift << shift;
+  if (shift > 0)
+    chars |= 0x3030303030303030 >> (64 - shift);
 
-    value = value * 10 + (*p - '0');
-  }
+  if (!AreEightDigits(chars))
+    return -1;
 
-  return value;
+  return PairsToNumber(DigitsToPairs(chars));
 }
 
-static void
-ParseExtensionValue(const char *p, const char *end, int16_t &value_r)
+/**
+ * Parse a 5 column IGC altitude, which may be negative ("-0012").
+ */
+[[gnu::pure]]
+static bool
+ParseAltitude(const char *p, int &value_r) noexcept
 {
-  int value = ParseUnsigned(p, end);
-  if (value >= 0)
-    value_r = value;
+  if (*p == '-') {
+    int value = ParseDigits(p + 1, 4);
+    if (value < 0)
+      return false;
+
+    value_r = -value;
+    return true;
+  }
+
+  int value = ParseDigits(p, 5);
+  if (value < 0)
+    return false;
+
+  value_r = value;
+  return true;
 }
 
 /**
- * Parse the first #n characters from the input string.  If the string
- * is not long enough, nothing is parsed.  This is used to account for
- * columns that are longer than specified; according to LXNav, this is
- * used for decimal places (which are ignored by this function).
+ * The fixed layout of the first 35 columns of a B record.
  */
-static void
-ParseExtensionValueN(const char *p, const char *end, size_t n,
-                     int16_t &value_r)
+static constexpr std::size_t B_RECORD_CORE_LENGTH = 35;
+
+/**
+ * Parse the first #B_RECORD_CORE_LENGTH columns of a B record with
+ * SWAR digit decoding.  This accepts only canonical records; the
+ * caller falls back to ParseFixCoreGeneric() for everything else.
+ */
+static bool
+ParseFixCoreFast(const char *line, IGCFix &fix) noexcept
 {
-  if (n > (size_t)(p - end))
-    /* string is too short */
-    return;
+  /* copy the record to a buffer with 8 bytes of padding in front, so
+     ParseDigits() may read before the first digit */
+  char buffer[8 + B_RECORD_CORE_LENGTH];
+  memset(buffer, '0', 8);
+  memcpy(buffer + 8, line, B_RECORD_CORE_LENGTH);
+  const char *const b = buffer + 8;
+
+  /* columns 1-8 are HHMMSSDD (time and latitude degrees) */
+  const uint64_t chars = LoadLE64(b + 1);
+  if (!AreEightDigits(chars))
+    return false;
 
-  int value = ParseUnsigned(p, p + n);
-  if (value >= 0)
-    value_r = value;
-}
+  const uint64_t pairs = DigitsToPairs(chars);
+  const unsigned hour = pairs & 0xff;
+  const unsigned minute = (pairs >> 16) & 0xff;
+  const unsigned second = (pairs >> 32) & 0xff;
+  const unsigned lat_degrees = (pairs >> 48) & 0xff;
 
-bool
-IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
-{
-  if (*buffer != 'B')
+  const int lat_minutes = ParseDigits(b + 9, 5);
+  const int lon_degrees = ParseDigits(b + 15, 3);
+  const int lon_minutes = ParseDigits(b + 18, 5);
+  if (lat_minutes < 0 || lon_degrees < 0 || lon_minutes < 0)
+    return false;
+
+  const char lat_char = b[14], lon_char = b[23], valid_char = b[24];
+
+  int pressure_altitude, gps_altitude;
+  if (!ParseAltitude(b + 25, pressure_altitude) ||
+      !ParseAltitude(b + 30, gps_altitude))
+    return false;
+
+  const BrokenTime time(hour, minute, second);
+  if (!time.IsPlausible())
     return false;
 
+  if (lat_degrees >= 90 || lat_minutes >= 60000 ||
+      (lat_char != 'N' && lat_char != 'S'))
+    return false;
+
+  if (lon_degrees >= 180 || lon_minutes >= 60000 ||
+      (lon_char != 'E' && lon_char != 'W'))
+    return false;
+
+  if (valid_char != 'A' && valid_char != 'V')
+    return false;
+
+  fix.time = time;
+  fix.gps_valid = valid_char == 'A';
+  fix.pressure_altitude = pressure_altitude;
+  fix.gps_altitude = gps_altitude;
+
+  fix.location.latitude = Angle::Degrees(lat_degrees +
+                                         lat_minutes / 60000.);
+  if (lat_char == 'S')
+    fix.location.latitude.Flip();
+
+  fix.location.longitude = Angle::Degrees(lon_degrees +
+                                          lon_minutes / 60000.);
+  if (lon_char == 'W')
+    fix.location.longitude.Flip();
+
+  return true;
+}
+
+/**
+ * Parse the first #B_RECORD_CORE_LENGTH columns of a B record field
+ * by field.  This is slower than ParseFixCoreFast(), but more
+ * tolerant.
+ */
+static bool
+ParseFixCoreGeneric(const char *buffer, IGCFix &fix) noexcept
+{
   BrokenTime time;
   if (!IGCParseTime(buffer + 1, time))
     return false;
@@ -239,42 +409,79 @@ IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
     return false;
 
   fix.time = time;
+  return true;
+}
 
-  fix.ClearExtensions();
+/**
+ * Parse an unsigned integer from the given string range
+ * (null-termination is not necessary).
+ *
+ * @return the result, or -1 on error
+ */
+[[gnu::pure]]
+static int
+ParseExtensionValue(const char *p, std::size_t length) noexcept
+{
+  if (length <= 8)
+    return ParseDigits(p, length);
+
+  unsigned value = 0;
+  for (const char *end = p + length; p < end; ++p) {
+    if (!IsDigitASCII(*p))
+      return -1;
+
+    value = value * 10 + (*p - '0');
+  }
+
+  return value;
+}
+
+bool
+IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
+{
+  if (*buffer != 'B')
+    return false;
 
   const size_t line_length = strlen(buffer);
-  for (auto i = extensions.begin(), end = extensions.end(); i != end; ++i) {
-    const IGCExtension &extension = *i;
+
+  if (line_length < B_RECORD_CORE_LENGTH ||
+      !ParseFixCoreFast(buffer, fix)) {
+    if (!ParseFixCoreGeneric(buffer, fix))
+      return false;
+  }
+
+  fix.ClearExtensions();
+
+  for (const IGCExtension &extension : extensions) {
     assert(extension.start > 0);
     assert(extension.finish >= extension.start);
 
+    if (extension.field < 0)
+      /* not supported */
+      continue;
+
     if (extension.finish > line_length)
       /* exceeds the input line length */
       continue;
 
-    const char *start = buffer + extension.start - 1;
-    const char *finish = buffer + extension.finish;
-
-    if (StringIsEqual(extension.code, "ENL"))
-      ParseExtensionValue(start, finish, fix.enl);
-    else if (StringIsEqual(extension.code, "RPM"))
-      ParseExtensionValue(start, finish, fix.rpm);
-    else if (StringIsEqual(extension.code, "HDM"))
-      ParseExtensionValue(start, finish, fix.hdm);
-    else if (StringIsEqual(extension.code, "HDT"))
-      ParseExtensionValue(start, finish, fix.hdt);
-    else if (StringIsEqual(extension.code, "TRM"))
-      ParseExtensionValue(start, finish, fix.trm);
-    else if (StringIsEqual(extension.code, "TRT"))
-      ParseExtensionValue(start, finish, fix.trt);
-    else if (StringIsEqual(extension.code, "GSP"))
-      ParseExtensionValueN(start, finish, 3, fix.gsp);
-    else if (StringIsEqual(extension.code, "IAS"))
-      ParseExtensionValueN(start, finish, 3, fix.ias);
-    else if (StringIsEqual(extension.code, "TAS"))
-      ParseExtensionValueN(start, finish, 3, fix.tas);
-    else if (StringIsEqual(extension.code, "SIU"))
-      ParseExtensionValue(start, finish, fix.siu);
+    const auto &field = extension_fields[extension.field];
+
+    /* IGCParseExtensions() guarantees this, and ParseDigits() may
+       read up to 7 bytes before the value */
+    assert(extension.start >= 8);
+
+    std::size_t length = extension.finish - extension.start + 1;
+    if (field.max_digits > 0) {
+      if (length < field.max_digits)
+        /* string is too short */
+        continue;
+
+      length = field.max_digits;
+    }
+
+    int value = ParseExtensionValue(buffer + extension.start - 1, length);
+    if (value >= 0)
+      fix.*field.value = value;
   }
 
   return true;
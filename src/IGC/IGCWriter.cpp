@@ -192,16 +192,17 @@ IGCWriter::LogPoint(const IGCFix &fix, int epe, int satellites)
           epe, satellites);
 
   WriteLine(b_record);
-  Flush();
 }
 
 void
 IGCWriter::LogPoint(const NMEAInfo& gps_info)
 {
-  if (fix.Apply(gps_info))
+  if (fix.Apply(gps_info)) {
     LogPoint(fix,
              gps_info.location_available ? (int)GetEPE(gps_info.gps) : 0,
              GetSIU(gps_info.gps));
+    Flush();
+  }
 }
 
 void
@@ -222,6 +223,7 @@ IGCWriter::LogEvent(const IGCFix &fix, int epe, int satellites,
 
   // tech_spec_gnss.pdf says we need a B record immediately after an E record
   LogPoint(fix, epe, satellites);
+  Flush();
 }
 
 void
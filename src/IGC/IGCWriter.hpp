@@ -5,7 +5,7 @@
 
 #include "Logger/GRecord.hpp"
 #include "IGCFix.hpp"
-#include "io/FileOutputStream.hxx"
+#include "io/AsyncFileWriter.hpp"
 #include "io/BufferedOutputStream.hxx"
 
 #include <array>
@@ -20,7 +20,11 @@ struct NMEAInfo;
 struct GeoPoint;
 
 class IGCWriter {
-  FileOutputStream file;
+  /**
+   * The file is written by a separate thread, so a slow storage
+   * device does not block the caller (the calculation thread).
+   */
+  AsyncFileWriter file;
   BufferedOutputStream buffered;
 
   GRecord grecord;
@@ -35,6 +39,10 @@ public:
    */
   explicit IGCWriter(Path path);
 
+  /**
+   * Submit all buffered lines to the writer thread.  This does not
+   * wait for the data to be written.
+   */
   void Flush() {
     buffered.Flush();
   }
@@ -52,11 +60,12 @@ private:
 
   static const char *GetHFFXARecord();
   static const char *GetIRecord();
+
+public:
   static double GetEPE(const GPSState &gps);
   /** Satellites in use if logger fix quality is a valid gps */
   static int GetSIU(const GPSState &gps);
 
-public:
   /**
    * @param logger_id the ID of the logger, consisting of exactly 3
    * alphanumeric characters (plain ASCII)
@@ -77,6 +86,10 @@ public:
 
   void LoggerNote(const TCHAR *text);
 
+  /**
+   * Write a B record.  Unlike the other methods, this does not
+   * Flush(), to allow writing many records in one go.
+   */
   void LogPoint(const IGCFix &fix, int epe, int satellites);
   void LogPoint(const NMEAInfo &gps_info);
   void LogEvent(const IGCFix &fix, int epe, int satellites, const char *event);
@@ -18,11 +18,50 @@ public:
     ibkRight = 2
   };
 
+  /**
+   * Bits describing the parts of the global state an InfoBox reads;
+   * see GetDependencies().
+   */
+  enum Dependency : unsigned {
+    /**
+     * The sensor data (CommonInterface::Basic()).
+     */
+    DEPENDS_BASIC = 0x1,
+
+    /**
+     * The results of the #GlideComputer (CommonInterface::Calculated()).
+     */
+    DEPENDS_CALCULATED = 0x2,
+
+    /**
+     * The computer and UI settings.
+     */
+    DEPENDS_SETTINGS = 0x4,
+
+    /**
+     * The #UIState (display mode, panel, ...).
+     */
+    DEPENDS_UI_STATE = 0x8,
+
+    DEPENDS_ALL = ~0u,
+  };
+
   virtual ~InfoBoxContent() noexcept;
 
   virtual void Update(InfoBoxData &data) noexcept = 0;
   virtual bool HandleKey(const InfoBoxKeyCodes keycode) noexcept;
 
+  /**
+   * Which parts of the global state does Update() read?  The
+   * #InfoBoxManager skips Update() if none of them has changed.
+   *
+   * @return a combination of #Dependency bits
+   */
+  [[gnu::pure]]
+  virtual unsigned GetDependencies() const noexcept {
+    return DEPENDS_ALL;
+  }
+
   virtual void OnCustomPaint(Canvas &canvas, const PixelRect &rc) noexcept;
 
   [[gnu::pure]]
@@ -10,6 +10,10 @@ class InfoBoxContentContest: public InfoBoxContent
 public:
   const InfoBoxPanel *GetDialogContent() noexcept override;
   void Update(InfoBoxData &data) noexcept override;
+
+  unsigned GetDependencies() const noexcept override {
+    return DEPENDS_CALCULATED | DEPENDS_SETTINGS;
+  }
 };
 
 class InfoBoxContentContestSpeed: public InfoBoxContent
@@ -17,4 +21,8 @@ class InfoBoxContentContestSpeed: public InfoBoxContent
 public:
   const InfoBoxPanel *GetDialogContent() noexcept override;
   void Update(InfoBoxData &data) noexcept override;
+
+  unsigned GetDependencies() const noexcept override {
+    return DEPENDS_CALCULATED | DEPENDS_SETTINGS;
+  }
 };
@@ -10,6 +10,10 @@ class InfoBoxContentActiveRadioFrequency : public InfoBoxContent
 public:
   const InfoBoxPanel *GetDialogContent() noexcept override;
   void Update(InfoBoxData &data) noexcept override;
+
+  unsigned GetDependencies() const noexcept override {
+    return DEPENDS_SETTINGS;
+  }
 };
 
 class InfoBoxContentStandbyRadioFrequency : public InfoBoxContent
@@ -17,6 +21,10 @@ class InfoBoxContentStandbyRadioFrequency : public InfoBoxContent
 public:
   const InfoBoxPanel *GetDialogContent() noexcept override;
   void Update(InfoBoxData &data) noexcept override;
+
+  unsigned GetDependencies() const noexcept override {
+    return DEPENDS_SETTINGS;
+  }
 };
 
 class InfoBoxContentTransponderCode : public InfoBoxContent
@@ -24,4 +32,8 @@ class InfoBoxContentTransponderCode : public InfoBoxContent
 public:
   const InfoBoxPanel *GetDialogContent() noexcept override;
   void Update(InfoBoxData &data) noexcept override;
+
+  unsigned GetDependencies() const noexcept override {
+    return DEPENDS_SETTINGS;
+  }
 };
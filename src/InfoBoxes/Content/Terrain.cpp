@@ -33,4 +33,8 @@ UpdateInfoBoxTerrainCollision(InfoBoxData &data) noexcept
   double distance =
     basic.location.DistanceS(calculated.terrain_warning_location);
   data.SetValueFromDistance(distance);
+
+  /* how far the glide path goes below the terrain */
+  if (calculated.glide_clearance.IsDefined())
+    data.SetCommentFromAltitude(calculated.glide_clearance.GetMinimum());
 }
@@ -24,14 +24,18 @@ InfoBoxLayout::Layout layout;
 static bool first;
 
 static void
-DisplayInfoBox() noexcept;
+DisplayInfoBox(unsigned changed) noexcept;
 
 static void
 InfoBoxDrawIfDirty() noexcept;
 
 } // namespace InfoBoxManager
 
-static bool infoboxes_dirty = false;
+/**
+ * The InfoBoxContent::Dependency bits which have changed since the
+ * InfoBoxes were last updated; zero if they are up to date.
+ */
+static unsigned infoboxes_dirty = 0;
 static bool infoboxes_hidden = false;
 
 static InfoBoxWindow *infoboxes[InfoBoxSettings::Panel::MAX_CONTENTS];
@@ -64,7 +68,7 @@ InfoBoxManager::Show() noexcept
 }
 
 void
-InfoBoxManager::DisplayInfoBox() noexcept
+InfoBoxManager::DisplayInfoBox(unsigned changed) noexcept
 {
   static int DisplayTypeLast[InfoBoxSettings::Panel::MAX_CONTENTS];
 
@@ -92,7 +96,10 @@ InfoBoxManager::DisplayInfoBox() noexcept
       DisplayTypeLast[i] = DisplayType;
     }
 
-    infoboxes[i]->UpdateContent();
+    /* a new content must be updated regardless of what changed */
+    infoboxes[i]->UpdateContent(needupdate
+                                ? InfoBoxContent::DEPENDS_ALL
+                                : changed);
   }
 
   first = false;
@@ -105,17 +112,17 @@ InfoBoxManager::InfoBoxDrawIfDirty() noexcept
   // This should save lots of battery power due to CPU usage
   // of drawing the screen
 
-  if (infoboxes_dirty && !infoboxes_hidden &&
+  if (infoboxes_dirty != 0 && !infoboxes_hidden &&
       !CommonInterface::GetUIState().screen_blanked) {
-    DisplayInfoBox();
-    infoboxes_dirty = false;
+    DisplayInfoBox(infoboxes_dirty);
+    infoboxes_dirty = 0;
   }
 }
 
 void
-InfoBoxManager::SetDirty() noexcept
+InfoBoxManager::SetDirty(unsigned changed) noexcept
 {
-  infoboxes_dirty = true;
+  infoboxes_dirty |= changed;
 }
 
 void
@@ -212,7 +219,7 @@ InfoBoxManager::ShowInfoBoxPicker(const int i) noexcept
   /* yes: apply and save it */
 
   panel.contents[i] = new_type;
-  DisplayInfoBox();
+  DisplayInfoBox(InfoBoxContent::DEPENDS_ALL);
 
   Profile::Save(Profile::map, panel, panel_index);
 }
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "InfoBoxes/Content/Base.hpp"
+
 struct InfoBoxLook;
 class ContainerWindow;
 
@@ -16,8 +18,14 @@ extern InfoBoxLayout::Layout layout;
 void
 ProcessTimer() noexcept;
 
+/**
+ * Schedule an update of the InfoBoxes which depend on the given
+ * state; it will be done by the next ProcessTimer() call.
+ *
+ * @param changed a combination of InfoBoxContent::Dependency bits
+ */
 void
-SetDirty() noexcept;
+SetDirty(unsigned changed=InfoBoxContent::DEPENDS_ALL) noexcept;
 
 void
 ScheduleRedraw() noexcept;
@@ -215,9 +215,9 @@ InfoBoxWindow::SetContentProvider(std::unique_ptr<InfoBoxContent> _content)
 }
 
 void
-InfoBoxWindow::UpdateContent()
+InfoBoxWindow::UpdateContent(unsigned changed)
 {
-  if (!content)
+  if (!content || (content->GetDependencies() & changed) == 0)
     return;
 
   InfoBoxData old = data;
@@ -111,7 +111,15 @@ public:
   }
 
   void SetContentProvider(std::unique_ptr<InfoBoxContent> _content);
-  void UpdateContent();
+
+  /**
+   * Update the content and invalidate the parts which have changed.
+   *
+   * @param changed the InfoBoxContent::Dependency bits which have
+   * changed since the last call; if the content depends on none of
+   * them, nothing is done
+   */
+  void UpdateContent(unsigned changed=InfoBoxContent::DEPENDS_ALL);
 
 private:
   void SetPressed(bool _pressed) {
@@ -68,6 +68,7 @@ doc/html/advanced/input/ALL  http://xcsoar.sourceforge.net/advanced/input/
 #include "Form/DataField/File.hpp"
 #include "Dialogs/FilePicker.hpp"
 #include "net/client/WeGlide/UploadIGCFile.hpp"
+#include "Profiler.hpp"
 
 #include <cassert>
 #include <tchar.h>
@@ -741,3 +742,29 @@ InputEvents::eventUploadIGCFile([[maybe_unused]] const TCHAR *misc) {
       }
   }
 }
+
+/**
+ * Controls the #Profiler overlay on the map.
+ *
+ * toggle, on, off: (de)activate it
+ * log: write the current statistics to the log file
+ */
+void
+InputEvents::eventProfiler(const TCHAR *misc)
+{
+  if (StringIsEqual(misc, _T("log"))) {
+    Profiler::Log();
+    Message::AddMessage(_("Profiler statistics logged"));
+    return;
+  }
+
+  if (StringIsEqual(misc, _T("toggle")))
+    Profiler::SetEnabled(!Profiler::IsEnabled());
+  else if (StringIsEqual(misc, _T("on")))
+    Profiler::SetEnabled(true);
+  else if (StringIsEqual(misc, _T("off")))
+    Profiler::SetEnabled(false);
+
+  if (auto *map = CommonInterface::main_window->GetMapIfActive())
+    map->QuickRedraw();
+}
@@ -0,0 +1,282 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Pool.hpp"
+#include "Job.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+/**
+ * The #JobPool worker running in this thread, or nullptr.
+ */
+static thread_local const void *current_worker = nullptr;
+
+void
+JobPool::Ticket::Cancel() noexcept
+{
+  std::function<void()> handler;
+
+  {
+    const std::lock_guard lock{mutex};
+    cancelled.store(true, std::memory_order_relaxed);
+
+    if (state == State::QUEUED)
+      /* the worker which takes it from the queue will skip it */
+      Finish();
+    else
+      /* wake up Sleep() */
+      cond.notify_all();
+
+    handler = cancel_handler;
+  }
+
+  if (handler)
+    handler();
+}
+
+bool
+JobPool::Ticket::IsDone() const noexcept
+{
+  const std::lock_guard lock{mutex};
+  return state == State::DONE;
+}
+
+void
+JobPool::Ticket::Wait()
+{
+  std::unique_lock lock{mutex};
+  cond.wait(lock, [this]{ return state == State::DONE; });
+
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
+void
+JobPool::Ticket::Execute() noexcept
+{
+  Clock::time_point start;
+
+  {
+    const std::lock_guard lock{mutex};
+    if (state != State::QUEUED)
+      /* cancelled */
+      return;
+
+    state = State::RUNNING;
+    start = Clock::now();
+    queue_time = start - submitted;
+  }
+
+  std::exception_ptr e;
+  try {
+    job.Run(*this);
+  } catch (...) {
+    e = std::current_exception();
+  }
+
+  const auto end = Clock::now();
+
+  const std::lock_guard lock{mutex};
+  run_time = end - start;
+  exception = std::move(e);
+  Finish();
+}
+
+bool
+JobPool::Ticket::IsCancelled() const noexcept
+{
+  return cancelled.load(std::memory_order_relaxed);
+}
+
+void
+JobPool::Ticket::SetCancelHandler(std::function<void()> handler) noexcept
+{
+  const std::lock_guard lock{mutex};
+  cancel_handler = std::move(handler);
+}
+
+void
+JobPool::Ticket::Sleep(std::chrono::steady_clock::duration duration) noexcept
+{
+  std::unique_lock lock{mutex};
+  cond.wait_for(lock, duration, [this]{ return IsCancelled(); });
+}
+
+void
+JobPool::Ticket::SetErrorMessage(const TCHAR *) noexcept
+{
+}
+
+void
+JobPool::Ticket::SetText(const TCHAR *) noexcept
+{
+}
+
+void
+JobPool::Ticket::SetProgressRange(unsigned) noexcept
+{
+}
+
+void
+JobPool::Ticket::SetProgressPosition(unsigned) noexcept
+{
+}
+
+JobPool::TicketPtr
+JobPool::Worker::PopBack(unsigned priority) noexcept
+{
+  const std::lock_guard lock{mutex};
+  auto &queue = queues[priority];
+  if (queue.empty())
+    return nullptr;
+
+  auto ticket = std::move(queue.back());
+  queue.pop_back();
+  --pool.n_queued;
+  return ticket;
+}
+
+JobPool::TicketPtr
+JobPool::Worker::PopFront(unsigned priority) noexcept
+{
+  const std::lock_guard lock{mutex};
+  auto &queue = queues[priority];
+  if (queue.empty())
+    return nullptr;
+
+  auto ticket = std::move(queue.front());
+  queue.pop_front();
+  --pool.n_queued;
+  return ticket;
+}
+
+void
+JobPool::Worker::Run() noexcept
+{
+  current_worker = this;
+  pool.Work(*this);
+}
+
+JobPool::JobPool(const char *_name, unsigned max_workers) noexcept
+  :name(_name)
+{
+  /* create all workers before starting the first one, because the
+     workers iterate the list */
+  workers.reserve(max_workers);
+  for (unsigned i = 0; i < max_workers; ++i)
+    workers.emplace_back(std::make_unique<Worker>(*this, name));
+
+  for (auto &worker : workers) {
+    try {
+      worker->Start();
+      ++n_running;
+    } catch (...) {
+      /* the queue of this worker will be emptied by the others */
+    }
+  }
+}
+
+JobPool::~JobPool() noexcept
+{
+  {
+    const std::lock_guard lock{mutex};
+    stop = true;
+    cond.notify_all();
+  }
+
+  CancelQueued();
+
+  for (auto &worker : workers)
+    if (worker->IsDefined())
+      worker->Join();
+
+  /* jobs which were submitted by jobs while shutting down */
+  CancelQueued();
+}
+
+void
+JobPool::CancelQueued() noexcept
+{
+  for (auto &worker : workers) {
+    const std::lock_guard lock{worker->mutex};
+    for (auto &queue : worker->queues)
+      for (auto &ticket : queue)
+        ticket->Cancel();
+  }
+}
+
+unsigned
+JobPool::GetDefaultWorkers() noexcept
+{
+  return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+JobPool::TicketPtr
+JobPool::Submit(Job &job, Priority priority) noexcept
+{
+  auto ticket = std::make_shared<Ticket>(job, priority);
+
+  if (n_running == 0) {
+    ticket->Execute();
+    return ticket;
+  }
+
+  Worker *worker = nullptr;
+  for (auto &i : workers)
+    if (i.get() == current_worker)
+      worker = i.get();
+
+  if (worker == nullptr)
+    worker = workers[next_worker++ % workers.size()].get();
+
+  {
+    const std::lock_guard lock{worker->mutex};
+    worker->queues[unsigned(priority)].push_back(ticket);
+    ++n_queued;
+  }
+
+  {
+    /* lock the mutex to avoid racing with a worker which is about
+       to sleep */
+    const std::lock_guard lock{mutex};
+    cond.notify_one();
+  }
+
+  return ticket;
+}
+
+JobPool::TicketPtr
+JobPool::Take(Worker &self) noexcept
+{
+  for (unsigned priority = N_PRIORITIES; priority-- > 0;) {
+    if (auto ticket = self.PopBack(priority))
+      return ticket;
+
+    for (auto &worker : workers)
+      if (worker.get() != &self)
+        if (auto ticket = worker->PopFront(priority))
+          return ticket;
+  }
+
+  return nullptr;
+}
+
+void
+JobPool::Work(Worker &self) noexcept
+{
+  while (true) {
+    if (auto ticket = Take(self)) {
+      ticket->Execute();
+      continue;
+    }
+
+    std::unique_lock lock{mutex};
+    if (stop)
+      break;
+
+    if (n_queued == 0)
+      cond.wait(lock);
+  }
+}
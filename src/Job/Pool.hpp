@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Operation/Operation.hpp"
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Job;
+
+/**
+ * A pool of worker threads shared by all subsystems which run
+ * background jobs.  Unlike #ThreadPool, Submit() does not wait: it
+ * returns a #Ticket which can be used to cancel the job, to wait for
+ * it and to obtain its timing.
+ *
+ * Each worker has its own queue per #Priority.  Jobs submitted from
+ * outside the pool are distributed over the workers round-robin; a
+ * job submitted by another job goes to the queue of the worker it
+ * runs on.  A worker takes jobs from the back of its own queue and,
+ * when that is empty, steals from the front of the other queues.
+ * Higher priorities are always preferred over locality.
+ */
+class JobPool {
+public:
+  enum class Priority : unsigned {
+    LOW,
+    NORMAL,
+    HIGH,
+  };
+
+  static constexpr unsigned N_PRIORITIES = 3;
+
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * The state of one submitted #Job.  It is the
+   * #OperationEnvironment passed to Job::Run(), which sees
+   * Cancel() as IsCancelled().  Progress and messages are discarded.
+   */
+  class Ticket final : public OperationEnvironment {
+    friend class JobPool;
+
+    Job &job;
+
+    const Priority priority;
+
+    const Clock::time_point submitted = Clock::now();
+
+    mutable Mutex mutex;
+    Cond cond;
+
+    enum class State {
+      QUEUED,
+      RUNNING,
+      DONE,
+    } state = State::QUEUED;
+
+    std::atomic<bool> cancelled{false};
+
+    /**
+     * Protected by #mutex.
+     */
+    std::function<void()> cancel_handler;
+
+    /**
+     * The exception thrown by Job::Run(), to be rethrown by Wait().
+     */
+    std::exception_ptr exception;
+
+    Clock::duration queue_time{}, run_time{};
+
+  public:
+    Ticket(Job &_job, Priority _priority) noexcept
+      :job(_job), priority(_priority) {}
+
+    Priority GetPriority() const noexcept {
+      return priority;
+    }
+
+    /**
+     * Request cancellation.  A job which has not been started yet
+     * is never run; a running job sees IsCancelled() and its cancel
+     * handler is invoked.  Returns immediately; call Wait() to wait
+     * for a running job to return.
+     */
+    void Cancel() noexcept;
+
+    /**
+     * Has the job returned (or been cancelled before it was started)?
+     */
+    [[gnu::pure]]
+    bool IsDone() const noexcept;
+
+    /**
+     * Wait until IsDone().  If Job::Run() threw an exception, it gets
+     * rethrown by this method.
+     */
+    void Wait();
+
+    /**
+     * How long did the job wait in the queue?  Only valid after
+     * IsDone().
+     */
+    Clock::duration GetQueueTime() const noexcept {
+      return queue_time;
+    }
+
+    /**
+     * How long did Job::Run() take?  Only valid after IsDone();
+     * zero if the job was cancelled before it was started.
+     */
+    Clock::duration GetRunTime() const noexcept {
+      return run_time;
+    }
+
+    /* virtual methods from class OperationEnvironment */
+    bool IsCancelled() const noexcept override;
+    void SetCancelHandler(std::function<void()> handler) noexcept override;
+    void Sleep(std::chrono::steady_clock::duration duration) noexcept override;
+    void SetErrorMessage(const TCHAR *text) noexcept override;
+    void SetText(const TCHAR *text) noexcept override;
+    void SetProgressRange(unsigned range) noexcept override;
+    void SetProgressPosition(unsigned position) noexcept override;
+
+  private:
+    /**
+     * Called by the worker which has taken this ticket from a queue.
+     */
+    void Execute() noexcept;
+
+    /**
+     * Mark as done.  Caller must lock the mutex.
+     */
+    void Finish() noexcept {
+      state = State::DONE;
+      cond.notify_all();
+    }
+  };
+
+  using TicketPtr = std::shared_ptr<Ticket>;
+
+private:
+  class Worker final : public Thread {
+  public:
+    JobPool &pool;
+
+    /**
+     * Protects #queues.
+     */
+    Mutex mutex;
+
+    std::array<std::deque<TicketPtr>, N_PRIORITIES> queues;
+
+    Worker(JobPool &_pool, const char *_name) noexcept
+      :Thread(_name), pool(_pool) {}
+
+    /**
+     * Take the newest ticket of the given priority from this
+     * worker's own queue.
+     */
+    TicketPtr PopBack(unsigned priority) noexcept;
+
+    /**
+     * Take the oldest ticket of the given priority (for stealing).
+     */
+    TicketPtr PopFront(unsigned priority) noexcept;
+
+  protected:
+    /* virtual methods from class Thread */
+    void Run() noexcept override;
+  };
+
+  const char *const name;
+
+  std::vector<std::unique_ptr<Worker>> workers;
+
+  /**
+   * The number of workers which have been started successfully.
+   */
+  unsigned n_running = 0;
+
+  /**
+   * The worker which receives the next job submitted from outside
+   * the pool.
+   */
+  std::atomic<unsigned> next_worker{0};
+
+  /**
+   * The number of tickets in all queues.
+   */
+  std::atomic<unsigned> n_queued{0};
+
+  /**
+   * Protects #stop; used together with #cond for putting idle
+   * workers to sleep.
+   */
+  Mutex mutex;
+  Cond cond;
+
+  bool stop = false;
+
+public:
+  /**
+   * Launches the worker threads.  If a thread cannot be launched,
+   * the pool continues with the ones it has; if none can be
+   * launched (or if max_workers is 0), Submit() runs jobs in the
+   * calling thread.
+   */
+  JobPool(const char *_name, unsigned max_workers) noexcept;
+
+  /**
+   * Stops and joins all threads.  Jobs which have not been started
+   * are cancelled.
+   */
+  ~JobPool() noexcept;
+
+  JobPool(const JobPool &) = delete;
+  JobPool &operator=(const JobPool &) = delete;
+
+  /**
+   * The number of worker threads a pool should have on this
+   * machine: one per CPU.
+   */
+  static unsigned GetDefaultWorkers() noexcept;
+
+  unsigned GetWorkerCount() const noexcept {
+    return n_running;
+  }
+
+  /**
+   * Schedule a #Job.  The #Job object must remain valid until the
+   * ticket is done.
+   */
+  TicketPtr Submit(Job &job, Priority priority=Priority::NORMAL) noexcept;
+
+private:
+  /**
+   * Cancel all tickets which are still in a queue.
+   */
+  void CancelQueued() noexcept;
+
+  /**
+   * Find a ticket, preferring higher priorities, then the queue of
+   * the specified worker.
+   */
+  TicketPtr Take(Worker &self) noexcept;
+
+  /**
+   * Run jobs until the pool is stopped.
+   */
+  void Work(Worker &self) noexcept;
+};
@@ -14,8 +14,7 @@
 #include "Renderer/FlightListRenderer.hpp"
 #include "Renderer/TextRenderer.hpp"
 #include "FlightInfo.hpp"
-#include "Logger/FlightParser.hpp"
-#include "io/FileLineReader.hpp"
+#include "Logger/FlightIndex.hpp"
 #include "io/UniqueFileDescriptor.hxx"
 #include "Resources.hpp"
 #include "Model.hpp"
@@ -133,13 +132,11 @@ DrawUserText(Canvas &canvas, PixelRect &rc) noexcept
 static void
 DrawFlights(Canvas &canvas, const PixelRect &rc)
 try {
-  FileLineReaderA file(Path("/mnt/onboard/XCSoarData/flights.log"));
-
   FlightListRenderer renderer(normal_font, bold_font);
 
-  FlightParser parser(file);
-  FlightInfo flight;
-  while (parser.Read(flight))
+  for (const auto &flight :
+         FlightIndex::LoadRecent(Path("/mnt/onboard/XCSoarData/flights.log"),
+                                 FlightListRenderer::MAX_FLIGHTS))
     renderer.AddFlight(flight);
 
   renderer.Draw(canvas, rc);
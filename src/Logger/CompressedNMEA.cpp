@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "CompressedNMEA.hpp"
+#include "lib/zlib/Error.hxx"
+#include "system/Path.hpp"
+#include "util/SpanCast.hxx"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace CompressedNMEA;
+
+/**
+ * Lines longer than this are considered corrupt.
+ */
+static constexpr std::size_t MAX_LINE_LENGTH = 4096;
+
+CompressedNMEAWriter::CompressedNMEAWriter(OutputStream &os,
+                                           std::chrono::system_clock::time_point start_time)
+  :gzip(os, Z_BEST_SPEED), buffered(gzip)
+{
+  buffered.Write(AsBytes(MAGIC));
+
+  const auto t = std::chrono::duration_cast<std::chrono::seconds>(start_time.time_since_epoch());
+  WriteVarint(std::max<int_least64_t>(t.count(), 0));
+}
+
+inline void
+CompressedNMEAWriter::WriteVarint(uint_least64_t value)
+{
+  std::byte buffer[10], *p = buffer;
+
+  while (value >= 0x80) {
+    *p++ = std::byte(value | 0x80);
+    value >>= 7;
+  }
+
+  *p++ = std::byte(value);
+
+  buffered.Write(std::span{buffer, p});
+}
+
+void
+CompressedNMEAWriter::Write(Duration time, std::string_view line)
+{
+  WriteVarint(time > last_time ? (time - last_time).count() : 0);
+  WriteVarint(line.size());
+  buffered.Write(AsBytes(line));
+
+  last_time = std::max(time, last_time);
+
+  if (last_time - last_flush >= FLUSH_INTERVAL) {
+    buffered.Flush();
+    gzip.SyncFlush();
+    last_flush = last_time;
+  }
+}
+
+void
+CompressedNMEAWriter::Finish()
+{
+  buffered.Flush();
+  gzip.Finish();
+}
+
+CompressedNMEAReader::CompressedNMEAReader(Path path)
+  :file(path), gunzip(file), buffered(gunzip)
+{
+  if (!Need(MAGIC.size()) ||
+      ToStringView(std::span<const std::byte>{buffered.Read().first(MAGIC.size())}) != MAGIC)
+    throw std::runtime_error("Not a compressed NMEA log");
+
+  buffered.Consume(MAGIC.size());
+
+  uint_least64_t t;
+  if (!ReadVarint(t))
+    throw std::runtime_error("Premature end of file");
+
+  start_time = std::chrono::system_clock::time_point{std::chrono::seconds(t)};
+}
+
+bool
+CompressedNMEAReader::Need(std::size_t size)
+{
+  while (buffered.Read().size() < size)
+    if (!buffered.Fill(true))
+      return false;
+
+  return true;
+}
+
+bool
+CompressedNMEAReader::ReadVarint(uint_least64_t &value)
+{
+  value = 0;
+
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    if (!Need(1))
+      return false;
+
+    const auto b = std::to_integer<uint_least8_t>(buffered.Read().front());
+    buffered.Consume(1);
+
+    value |= uint_least64_t(b & 0x7f) << shift;
+    if ((b & 0x80) == 0)
+      return true;
+  }
+
+  throw std::runtime_error("Malformed varint");
+}
+
+char *
+CompressedNMEAReader::ReadLine()
+try {
+  uint_least64_t delta, length;
+  if (!ReadVarint(delta) || !ReadVarint(length))
+    return nullptr;
+
+  if (length > MAX_LINE_LENGTH)
+    throw std::runtime_error("Line too long");
+
+  if (!Need(length))
+    return nullptr;
+
+  const auto src = buffered.Read().first(length);
+  line.assign(reinterpret_cast<const char *>(src.data()),
+              reinterpret_cast<const char *>(src.data()) + length);
+  line.push_back('\0');
+  buffered.Consume(length);
+
+  time += Duration(delta);
+  return line.data();
+} catch (const ZlibError &) {
+  /* the file was not finished properly (e.g. after a crash); it can
+     only be decompressed up to the last complete record */
+  return nullptr;
+}
+
+long
+CompressedNMEAReader::GetSize() const
+{
+  return file.GetSize();
+}
+
+long
+CompressedNMEAReader::Tell() const
+{
+  return file.GetPosition();
+}
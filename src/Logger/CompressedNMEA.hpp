@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "io/LineReader.hpp"
+#include "io/FileReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "lib/zlib/GunzipReader.hxx"
+#include "lib/zlib/GzipOutputStream.hxx"
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+class Path;
+class OutputStream;
+
+/*
+ * The compressed NMEA log format (file name suffix ".nmz").  It keeps
+ * every received line together with its arrival time, at a fraction
+ * of the size of a plain text log.
+ *
+ * The file is a gzip stream which contains:
+ *
+ * - the magic #CompressedNMEA::MAGIC
+ * - the UTC time when the log was started (Unix seconds, varint)
+ * - one record per line: the milliseconds since the previous record
+ *   (varint), the length of the line (varint) and the line without
+ *   line terminator
+ *
+ * Varints are little-endian base-128 (7 bits per byte, the high bit
+ * set on all but the last byte).
+ *
+ * The writer flushes the compressor periodically, so a file which
+ * was not finished properly (e.g. after a crash) can still be read
+ * up to the last flush.
+ */
+namespace CompressedNMEA {
+
+using Duration = std::chrono::duration<uint_least32_t, std::milli>;
+
+static constexpr std::string_view MAGIC{"XCNMEA1\n"};
+
+} // namespace CompressedNMEA
+
+class CompressedNMEAWriter {
+  GzipOutputStream gzip;
+  BufferedOutputStream buffered;
+
+  /**
+   * The time stamp of the previous record.
+   */
+  CompressedNMEA::Duration last_time{};
+
+  /**
+   * The time stamp of the last GzipOutputStream::SyncFlush() call.
+   */
+  CompressedNMEA::Duration last_flush{};
+
+public:
+  /**
+   * How often is the compressor flushed?  This is how much of the
+   * log a crash may lose (in addition to what the #OutputStream has
+   * not yet written).
+   */
+  static constexpr CompressedNMEA::Duration FLUSH_INTERVAL =
+    std::chrono::seconds(10);
+
+  /**
+   * Writes the header.
+   *
+   * Throws on error.
+   */
+  CompressedNMEAWriter(OutputStream &os,
+                       std::chrono::system_clock::time_point start_time);
+
+  /**
+   * Append one line.
+   *
+   * Throws on error.
+   *
+   * @param time the time since the log was started; must not be
+   * smaller than in the previous call
+   */
+  void Write(CompressedNMEA::Duration time, std::string_view line);
+
+  /**
+   * Finish the gzip stream.  After returning, this object must not
+   * be used again.
+   *
+   * Throws on error.
+   */
+  void Finish();
+
+private:
+  void WriteVarint(uint_least64_t value);
+};
+
+/**
+ * Reads a file written by #CompressedNMEAWriter and returns its lines
+ * like a plain NMEA log file.  A truncated file (which was not
+ * finished properly) ends silently at the last complete record.
+ */
+class CompressedNMEAReader final : public NLineReader {
+  FileReader file;
+  GunzipReader gunzip;
+  BufferedReader buffered;
+
+  std::chrono::system_clock::time_point start_time;
+
+  CompressedNMEA::Duration time{};
+
+  std::vector<char> line;
+
+public:
+  /**
+   * Opens the file and reads the header.
+   *
+   * Throws on error.
+   */
+  explicit CompressedNMEAReader(Path path);
+
+  /**
+   * The UTC time when the log was started.
+   */
+  std::chrono::system_clock::time_point GetStartTime() const noexcept {
+    return start_time;
+  }
+
+  /**
+   * The arrival time of the line last returned by ReadLine(),
+   * relative to GetStartTime().
+   */
+  CompressedNMEA::Duration GetTime() const noexcept {
+    return time;
+  }
+
+  /* virtual methods from class NLineReader */
+  char *ReadLine() override;
+  long GetSize() const override;
+  long Tell() const override;
+
+private:
+  /**
+   * Make sure that at least the given number of bytes are buffered.
+   * Returns false at the end of the file.
+   */
+  bool Need(std::size_t size);
+
+  bool ReadVarint(uint_least64_t &value);
+};
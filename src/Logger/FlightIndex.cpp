@@ -0,0 +1,350 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FlightIndex.hpp"
+#include "FlightParser.hpp"
+#include "FlightInfo.hpp"
+#include "io/FileReader.hxx"
+#include "io/FileLineReader.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/FileUtil.hpp"
+#include "time/BrokenDateTime.hpp"
+#include "util/ByteOrder.hxx"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+
+namespace FlightIndex {
+
+static constexpr char MAGIC[8] = {'X', 'C', 'F', 'L', 'I', 'D', 'X', '1'};
+
+/**
+ * The file format is a #Header followed by one #Record per flight
+ * (oldest first).
+ */
+struct Header {
+  char magic[sizeof(MAGIC)];
+
+  /**
+   * The size of the log file this index describes.
+   */
+  PackedLE64 log_size;
+
+  /**
+   * The most recent start which has no landing yet (year 0 if none).
+   * It is reported as a flight without landing time, just like
+   * #FlightParser does at the end of the log.
+   */
+  PackedLE16 pending_year;
+  uint8_t pending_month, pending_day;
+  uint8_t pending_hour, pending_minute, pending_second;
+  uint8_t reserved;
+};
+
+static_assert(sizeof(Header) == 24);
+
+/**
+ * A #FlightInfo in a portable format.  Invalid dates and times are
+ * stored as their invalid values.
+ */
+struct Record {
+  PackedLE16 year;
+  uint8_t month, day;
+  uint8_t start_hour, start_minute, start_second;
+  uint8_t end_hour, end_minute, end_second;
+  uint8_t reserved[2];
+
+  static Record From(const FlightInfo &flight) noexcept {
+    Record r{};
+    r.year = flight.date.year;
+    r.month = flight.date.month;
+    r.day = flight.date.day;
+    r.start_hour = flight.start_time.hour;
+    r.start_minute = flight.start_time.minute;
+    r.start_second = flight.start_time.second;
+    r.end_hour = flight.end_time.hour;
+    r.end_minute = flight.end_time.minute;
+    r.end_second = flight.end_time.second;
+    return r;
+  }
+
+  FlightInfo ToFlightInfo() const noexcept {
+    FlightInfo flight;
+    flight.date = BrokenDate(year, month, day);
+    flight.start_time = BrokenTime(start_hour, start_minute, start_second);
+    flight.end_time = BrokenTime(end_hour, end_minute, end_second);
+    return flight;
+  }
+};
+
+static_assert(sizeof(Record) == 12);
+
+/**
+ * The contents of an index file in memory.
+ */
+struct Index {
+  uint64_t log_size = 0;
+
+  BrokenDateTime pending = BrokenDateTime::Invalid();
+
+  std::vector<FlightInfo> flights;
+
+  void Add(const BrokenDate &date, const BrokenTime &start,
+           const BrokenTime &end) {
+    FlightInfo &flight = flights.emplace_back();
+    flight.date = date;
+    flight.start_time = start;
+    flight.end_time = end;
+  }
+
+  /**
+   * Apply an event in the same way as #FlightParser would interpret
+   * the log line.
+   */
+  void Apply(Event event, const BrokenDateTime &dt);
+};
+
+void
+Index::Apply(Event event, const BrokenDateTime &dt)
+{
+  switch (event) {
+  case Event::START:
+    if (pending.IsPlausible())
+      /* the previous start was never followed by a landing */
+      Add(pending, pending, BrokenTime::Invalid());
+
+    pending = dt;
+    break;
+
+  case Event::LANDING:
+    if (pending.IsPlausible()) {
+      const auto duration = dt - pending;
+      if (duration.count() >= 0 && duration <= std::chrono::hours{14}) {
+        Add(pending, pending, dt);
+      } else {
+        /* the landing does not belong to the start */
+        Add(pending, pending, BrokenTime::Invalid());
+        Add(dt, BrokenTime::Invalid(), dt);
+      }
+    } else
+      Add(dt, BrokenTime::Invalid(), dt);
+
+    pending = BrokenDateTime::Invalid();
+    break;
+  }
+}
+
+AllocatedPath
+GetIndexPath(Path log_path) noexcept
+{
+  return log_path.WithSuffix(_T(".idx"));
+}
+
+static Index
+ParseLog(Path log_path)
+{
+  Index index;
+
+  if (!File::Exists(log_path))
+    return index;
+
+  index.log_size = File::GetSize(log_path);
+
+  FileLineReaderA reader(log_path);
+  FlightParser parser(reader);
+  FlightInfo flight;
+  while (parser.Read(flight))
+    index.flights.push_back(flight);
+
+  /* a start without landing at the end of the log is the flight
+     which is still in progress */
+  if (!index.flights.empty()) {
+    const auto &last = index.flights.back();
+    if (last.start_time.IsPlausible() && !last.end_time.IsPlausible()) {
+      index.pending = BrokenDateTime(last.date, last.start_time);
+      index.flights.pop_back();
+    }
+  }
+
+  return index;
+}
+
+static Header
+MakeHeader(const Index &index) noexcept
+{
+  Header header{};
+  std::copy_n(MAGIC, sizeof(MAGIC), header.magic);
+  header.log_size = index.log_size;
+
+  if (index.pending.IsPlausible()) {
+    header.pending_year = index.pending.year;
+    header.pending_month = index.pending.month;
+    header.pending_day = index.pending.day;
+    header.pending_hour = index.pending.hour;
+    header.pending_minute = index.pending.minute;
+    header.pending_second = index.pending.second;
+  }
+
+  return header;
+}
+
+static void
+WriteIndex(Path log_path, const Index &index)
+{
+  FileOutputStream file(GetIndexPath(log_path));
+  BufferedOutputStream os(file);
+
+  os.WriteT(MakeHeader(index));
+  for (const auto &flight : index.flights)
+    os.WriteT(Record::From(flight));
+
+  os.Flush();
+  file.Commit();
+}
+
+/**
+ * Read the header and check whether the index is up to date.
+ * Returns std::nullopt if the index is missing, damaged or outdated.
+ */
+static std::optional<Header>
+ReadHeader(FileReader &file, uint64_t log_size)
+{
+  Header header;
+  if (file.GetSize() < sizeof(header) ||
+      (file.GetSize() - sizeof(header)) % sizeof(Record) != 0 ||
+      file.Read(&header, sizeof(header)) != sizeof(header) ||
+      !std::equal(MAGIC, MAGIC + sizeof(MAGIC), header.magic) ||
+      header.log_size != log_size)
+    return std::nullopt;
+
+  return header;
+}
+
+static BrokenDateTime
+GetPending(const Header &header) noexcept
+{
+  if (header.pending_year == 0)
+    return BrokenDateTime::Invalid();
+
+  return BrokenDateTime(header.pending_year, header.pending_month,
+                        header.pending_day, header.pending_hour,
+                        header.pending_minute, header.pending_second);
+}
+
+/**
+ * Read records from the current file position.
+ */
+static void
+ReadRecords(FileReader &file, std::size_t n, std::vector<FlightInfo> &dest)
+{
+  std::vector<Record> records(n);
+  const std::size_t size = n * sizeof(Record);
+  if (file.Read(records.data(), size) != size)
+    throw std::runtime_error("Short read from flight index");
+
+  for (const auto &r : records)
+    dest.push_back(r.ToFlightInfo());
+}
+
+/**
+ * Load the whole index if it is up to date.
+ */
+static std::optional<Index>
+ReadIndex(Path log_path, uint64_t log_size)
+try {
+  FileReader file(GetIndexPath(log_path));
+
+  const auto header = ReadHeader(file, log_size);
+  if (!header)
+    return std::nullopt;
+
+  Index index;
+  index.log_size = log_size;
+  index.pending = GetPending(*header);
+
+  const std::size_t n = (file.GetSize() - sizeof(Header)) / sizeof(Record);
+  index.flights.reserve(n + 1);
+  ReadRecords(file, n, index.flights);
+  return index;
+} catch (...) {
+  return std::nullopt;
+}
+
+void
+Rebuild(Path log_path)
+{
+  WriteIndex(log_path, ParseLog(log_path));
+}
+
+void
+Update(Path log_path, uint64_t old_log_size,
+       Event event, const BrokenDateTime &date_time)
+{
+  auto index = ReadIndex(log_path, old_log_size);
+  if (!index) {
+    /* missing or outdated: the log already contains the new event */
+    Rebuild(log_path);
+    return;
+  }
+
+  index->Apply(event, date_time);
+  index->log_size = File::GetSize(log_path);
+  WriteIndex(log_path, *index);
+}
+
+std::vector<FlightInfo>
+LoadRecent(Path log_path, std::size_t max_flights)
+{
+  std::vector<FlightInfo> flights;
+  if (max_flights == 0)
+    return flights;
+
+  const uint64_t log_size = File::GetSize(log_path);
+
+  try {
+    FileReader file(GetIndexPath(log_path));
+
+    if (const auto header = ReadHeader(file, log_size)) {
+      const BrokenDateTime pending = GetPending(*header);
+      const std::size_t max_records = pending.IsPlausible()
+        ? max_flights - 1
+        : max_flights;
+
+      /* read only the tail of the index */
+      const std::size_t n = (file.GetSize() - sizeof(Header)) / sizeof(Record);
+      const std::size_t skip = n > max_records ? n - max_records : 0;
+      file.Skip(skip * sizeof(Record));
+
+      flights.reserve(n - skip + 1);
+      ReadRecords(file, n - skip, flights);
+
+      if (pending.IsPlausible())
+        flights.push_back({pending, pending, BrokenTime::Invalid()});
+
+      return flights;
+    }
+  } catch (...) {
+    /* fall back to parsing the log */
+  }
+
+  Index index = ParseLog(log_path);
+
+  try {
+    WriteIndex(log_path, index);
+  } catch (...) {
+    /* the index is only a cache; loading works without it */
+  }
+
+  if (index.pending.IsPlausible())
+    index.Add(index.pending, index.pending, BrokenTime::Invalid());
+
+  const std::size_t skip = index.flights.size() > max_flights
+    ? index.flights.size() - max_flights
+    : 0;
+  flights.assign(index.flights.begin() + skip, index.flights.end());
+  return flights;
+}
+
+} // namespace FlightIndex
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "system/Path.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct FlightInfo;
+struct BrokenDateTime;
+
+/**
+ * A binary index of the flights in the log book written by
+ * #FlightLogger ("flights.idx" next to "flights.log").  It contains
+ * exactly the flights which #FlightParser would find in the log, but
+ * the most recent ones can be loaded without parsing the whole log.
+ *
+ * The index remembers the size of the log it describes; if the log
+ * was modified behind its back (or the index is missing), it is
+ * rebuilt by parsing the log.
+ */
+namespace FlightIndex {
+
+enum class Event : uint8_t {
+  START,
+  LANDING,
+};
+
+[[gnu::pure]]
+AllocatedPath
+GetIndexPath(Path log_path) noexcept;
+
+/**
+ * Parse the log and write a new index.
+ *
+ * Throws on error.
+ */
+void
+Rebuild(Path log_path);
+
+/**
+ * Update the index after #FlightLogger has appended an event to the
+ * log.
+ *
+ * Throws on error.
+ *
+ * @param old_log_size the size of the log before the event was
+ * appended
+ */
+void
+Update(Path log_path, uint64_t old_log_size,
+       Event event, const BrokenDateTime &date_time);
+
+/**
+ * Load the most recent flights (oldest first), rebuilding the index
+ * if necessary.  If the index cannot be written, the flights are
+ * still returned.
+ *
+ * Throws on error.
+ */
+std::vector<FlightInfo>
+LoadRecent(Path log_path, std::size_t max_flights);
+
+} // namespace FlightIndex
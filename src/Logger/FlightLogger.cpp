@@ -6,6 +6,7 @@
 #include "NMEA/Derived.hpp"
 #include "io/FileOutputStream.hxx"
 #include "io/BufferedOutputStream.hxx"
+#include "system/FileUtil.hpp"
 #include "LogFile.hpp"
 
 void
@@ -18,10 +19,13 @@ FlightLogger::Reset()
 }
 
 void
-FlightLogger::LogEvent(const BrokenDateTime &date_time, const char *type)
+FlightLogger::LogEvent(const BrokenDateTime &date_time, const char *type,
+                       FlightIndex::Event event)
 try {
   assert(type != nullptr);
 
+  const uint64_t old_size = File::GetSize(path);
+
   FileOutputStream file(path, FileOutputStream::Mode::APPEND_OR_CREATE);
   BufferedOutputStream writer(file);
 
@@ -34,6 +38,8 @@ try {
 
   writer.Flush();
   file.Commit();
+
+  FlightIndex::Update(path, old_size, event, date_time);
 } catch (...) {
   LogError(std::current_exception());
 }
@@ -52,7 +58,7 @@ FlightLogger::TickInternal(const MoreData &basic,
       /* start was confirmed (not on ground anymore): log it */
       seen_on_ground = false;
 
-      LogEvent(start_time, "start");
+      LogEvent(start_time, "start", FlightIndex::Event::START);
 
       start_time.Clear();
     }
@@ -66,7 +72,7 @@ FlightLogger::TickInternal(const MoreData &basic,
       /* landing was confirmed (not on ground anymore): log it */
       seen_flying = false;
 
-      LogEvent(landing_time, "landing");
+      LogEvent(landing_time, "landing", FlightIndex::Event::LANDING);
 
       landing_time.Clear();
     }
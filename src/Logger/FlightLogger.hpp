@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "FlightIndex.hpp"
 #include "time/BrokenDateTime.hpp"
 #include "time/Stamp.hpp"
 #include "system/Path.hpp"
@@ -14,7 +15,8 @@ struct DerivedInfo;
 
 /**
  * This class logs start and landing into a file, to be used as a
- * flying log book.
+ * flying log book.  It also keeps the #FlightIndex of that file up
+ * to date.
  *
  * Before first using it, this object must be initialised explicitly
  * by calling Reset().
@@ -55,7 +57,11 @@ public:
   void Tick(const MoreData &basic, const DerivedInfo &calculated);
 
 private:
-  void LogEvent(const BrokenDateTime &date_time, const char *type);
+  /**
+   * Append an event to the log and update the #FlightIndex.
+   */
+  void LogEvent(const BrokenDateTime &date_time, const char *type,
+                FlightIndex::Event event);
 
   void TickInternal(const MoreData &basic, const DerivedInfo &calculated);
 };
@@ -51,26 +51,43 @@ GRecord::AppendRecordToBuffer(std::string_view in) noexcept
 }
 
 /**
+ * Copy the characters which are part of the digest.
+ *
  * @param ignore_comma if true, then the comma is ignored, even though
  * it's a valid IGC character
+ * @return the number of characters written to #dest, which must be
+ * at least as large as #s
  */
-static void
-AppendIGCString(MD5 &md5, std::string_view s, bool ignore_comma) noexcept
+static std::size_t
+FilterIGCString(char *dest, std::string_view s, bool ignore_comma) noexcept
 {
+  char *p = dest;
+
   for (const char ch : s) {
     if (ignore_comma && ch == ',')
       continue;
 
     if (IsValidIGCChar(ch))
-      md5.Append(ch);
+      *p++ = ch;
   }
+
+  return p - dest;
 }
 
 void
 GRecord::AppendStringToBuffer(std::string_view in) noexcept
 {
-  for (auto &i : md5)
-    AppendIGCString(i, in, ignore_comma);
+  /* filter each chunk once, then feed it to all digests in bulk */
+  char buffer[256];
+
+  while (!in.empty()) {
+    const auto chunk = in.substr(0, sizeof(buffer));
+    in.remove_prefix(chunk.size());
+
+    const std::size_t length = FilterIGCString(buffer, chunk, ignore_comma);
+    for (auto &i : md5)
+      i.Append(buffer, length);
+  }
 }
 
 void
@@ -171,15 +188,29 @@ GRecord::ReadGRecordFromFile(Path path,
 void
 GRecord::VerifyGRecordInFile(Path path)
 {
-  // assumes FileName member is set
-  // Load File into Buffer (assume name is already set)
-  LoadFileToBuffer(path);
+  /* read the file only once: feed the records to the digest and
+     collect the existing G record at the same time */
+  FileLineReaderA reader(path);
 
-  // load Existing Digest "old"
   char old_g_record[DIGEST_LENGTH + 1];
-  ReadGRecordFromFile(path, old_g_record, ARRAY_SIZE(old_g_record));
+  std::size_t old_length = 0;
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    if (line[0] != 'G') {
+      AppendRecordToBuffer(line);
+      continue;
+    }
+
+    for (const char *p = line + 1; *p != '\0'; ++p) {
+      old_g_record[old_length++] = *p;
+      if (old_length >= ARRAY_SIZE(old_g_record))
+        throw std::runtime_error("G record too large");
+    }
+  }
+
+  old_g_record[old_length] = '\0';
 
-  // recalculate digest from buffer
   FinalizeBuffer();
 
   char new_g_record[DIGEST_LENGTH + 1];
@@ -17,44 +17,84 @@
 #include <tchar.h>
 #include <algorithm>
 
-const struct LoggerImpl::PreTakeoffBuffer &
-LoggerImpl::PreTakeoffBuffer::operator=(const NMEAInfo &src)
+#include <math.h>
+
+static constexpr int16_t
+ClipAltitude(double value) noexcept
 {
-  location = src.location_available
-    ? src.location
-    : GeoPoint::Invalid();
-
-  if (src.pressure_altitude_available) {
-    pressure_altitude = src.pressure_altitude;
-    pressure_altitude_available = true;
-  } else if (src.baro_altitude_available) {
-    pressure_altitude = src.baro_altitude;
-    pressure_altitude_available = true;
-  } else
-    pressure_altitude_available = false;
-
-  altitude_gps = src.gps_altitude;
-  gps_altitude_available = src.gps_altitude_available;
+  return (int16_t)std::clamp(value, -9999., 32767.);
+}
 
+const LoggerImpl::PreTakeoffFix &
+LoggerImpl::PreTakeoffFix::operator=(const NMEAInfo &src) noexcept
+{
   date_time_utc = src.date_time_utc;
-  time = src.time;
+  time_ms = std::chrono::duration_cast<std::chrono::duration<uint32_t, std::milli>>(src.time.ToDuration()).count();
 
-  fix_quality = src.gps.fix_quality;
+  location_available = src.location_available;
+  if (location_available) {
+    latitude = (int32_t)lround(src.location.latitude.Degrees() * 60000);
+    longitude = (int32_t)lround(src.location.longitude.Degrees() * 60000);
+  }
 
-  satellites_used_available = src.gps.satellites_used_available;
-  if (satellites_used_available)
-    satellites_used = src.gps.satellites_used;
+  gps_altitude_available = src.gps_altitude_available;
+  gps_altitude = gps_altitude_available
+    ? ClipAltitude(src.gps_altitude)
+    : 0;
 
-  hdop = src.gps.hdop;
-  real = src.gps.real;
+  pressure_altitude = src.pressure_altitude_available
+    ? ClipAltitude(src.pressure_altitude)
+    : (src.baro_altitude_available
+       ? ClipAltitude(src.baro_altitude)
+       : gps_altitude);
+
+  epe = location_available
+    ? (uint16_t)std::min(IGCWriter::GetEPE(src.gps), 999.)
+    : 0;
+  siu = IGCWriter::GetSIU(src.gps);
+
+  satellites_used_available = src.gps.satellites_used_available;
+  satellites_used = satellites_used_available
+    ? (uint8_t)std::min(src.gps.satellites_used, 255)
+    : 0;
 
   satellite_ids_available = src.gps.satellite_ids_available;
   if (satellite_ids_available)
-    std::copy_n(src.gps.satellite_ids, GPSState::MAXSATELLITES, satellite_ids);
+    std::copy_n(src.gps.satellite_ids, GPSState::MAXSATELLITES,
+                satellite_ids);
+
+  real = src.gps.real;
 
   return *this;
 }
 
+GeoPoint
+LoggerImpl::PreTakeoffFix::GetLocation() const noexcept
+{
+  return GeoPoint(Angle::Degrees(longitude / 60000.),
+                  Angle::Degrees(latitude / 60000.));
+}
+
+void
+LoggerImpl::PreTakeoffFix::CopyTo(GPSState &gps) const noexcept
+{
+  gps.Reset();
+
+  /* the clock is only used to set the validity to true, for which
+     "1" is sufficient */
+  const TimeStamp clock{FloatDuration{1}};
+
+  if (satellites_used_available) {
+    gps.satellites_used = satellites_used;
+    gps.satellites_used_available.Update(clock);
+  }
+
+  if (satellite_ids_available) {
+    std::copy_n(satellite_ids, GPSState::MAXSATELLITES, gps.satellite_ids);
+    gps.satellite_ids_available.Update(clock);
+  }
+}
+
 LoggerImpl::LoggerImpl() = default;
 LoggerImpl::~LoggerImpl() noexcept = default;
 
@@ -86,7 +126,7 @@ LoggerImpl::LogPointToBuffer(const NMEAInfo &gps_info) noexcept
   assert(gps_info.alive);
   assert(gps_info.time_available);
 
-  PreTakeoffBuffer item;
+  PreTakeoffFix item;
   item = gps_info;
   pre_takeoff_buffer.push(item);
 }
@@ -112,61 +152,76 @@ LoggerImpl::LogPoint(const NMEAInfo &gps_info)
     return;
   }
 
+  WritePoint(gps_info);
+}
+
+void
+LoggerImpl::TrimPreTakeoffBuffer(std::chrono::steady_clock::duration max_age) noexcept
+{
+  if (pre_takeoff_buffer.empty())
+    return;
+
+  const auto max_age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(max_age).count();
+  const uint32_t newest = pre_takeoff_buffer.last().time_ms;
+
+  while (!pre_takeoff_buffer.empty() &&
+         /* a time warp (e.g. midnight) also discards the older
+            points */
+         (pre_takeoff_buffer.peek().time_ms > newest ||
+          newest - pre_takeoff_buffer.peek().time_ms > max_age_ms))
+    pre_takeoff_buffer.shift();
+}
+
+void
+LoggerImpl::WritePreTakeoffBuffer()
+{
+  IGCFix fix;
+  fix.Clear();
+
   while (!pre_takeoff_buffer.empty()) {
-    const struct PreTakeoffBuffer &src = pre_takeoff_buffer.shift();
+    const PreTakeoffFix &src = pre_takeoff_buffer.shift();
     if (!simulator && !src.real)
       /* ignore buffered "unreal" fixes if we're logging a real
          flight; should never happen, but who knows */
       continue;
 
-    NMEAInfo tmp_info;
-    tmp_info.Reset();
+    if (!simulator) {
+      GPSState gps;
+      src.CopyTo(gps);
 
-    // NOTE: clock is only used to set the validity of valid objects to true
-    //       for which "1" is sufficient. This kludge needs to be rewritten.
-    tmp_info.clock = TimeStamp{FloatDuration{1}};
-
-    tmp_info.alive.Update(tmp_info.clock);
-
-    if (src.location.IsValid()) {
-      tmp_info.location = src.location;
-      tmp_info.location_available.Update(tmp_info.clock);
-    }
-
-    if (src.gps_altitude_available) {
-      tmp_info.gps_altitude = src.altitude_gps;
-      tmp_info.gps_altitude_available.Update(tmp_info.clock);
+      WriteFRecord(gps, TimeStamp{std::chrono::milliseconds{src.time_ms}},
+                   !src.location_available, src.date_time_utc);
     }
 
-    if (src.pressure_altitude_available) {
-      tmp_info.pressure_altitude = src.pressure_altitude;
-      tmp_info.pressure_altitude_available.Update(tmp_info.clock);
-    }
-
-    tmp_info.date_time_utc = src.date_time_utc;
-    tmp_info.time = src.time;
-    tmp_info.time_available.Update(tmp_info.clock);
+    /* see IGCFix::Apply() */
+    if (!src.location_available && !fix.IsDefined())
+      continue;
 
-    tmp_info.gps.fix_quality = src.fix_quality;
+    if (src.location_available)
+      fix.location = src.GetLocation();
 
-    if (src.satellites_used_available) {
-      tmp_info.gps.satellites_used_available.Update(tmp_info.clock);
-      tmp_info.gps.satellites_used = src.satellites_used;
-    }
+    fix.time = src.date_time_utc;
+    fix.gps_valid = src.location_available && src.gps_altitude_available;
+    fix.gps_altitude = src.gps_altitude;
+    fix.pressure_altitude = src.pressure_altitude;
 
-    tmp_info.gps.hdop = src.location.IsValid() ? src.hdop : -1;
-    tmp_info.gps.real = src.real;
+    writer->LogPoint(fix, src.epe, src.siu);
+  }
 
-    if (src.satellite_ids_available) {
-      tmp_info.gps.satellite_ids_available.Update(tmp_info.clock);
-      for (unsigned i = 0; i < GPSState::MAXSATELLITES; i++)
-        tmp_info.gps.satellite_ids[i] = src.satellite_ids[i];
-    }
+  /* submit all of them to the writer thread at once */
+  writer->Flush();
+}
 
-    WritePoint(tmp_info);
+void
+LoggerImpl::WriteFRecord(const GPSState &gps, TimeStamp time,
+                         bool nav_warning, const BrokenTime &time_utc)
+{
+  if (frecord.Update(gps, time, nav_warning)) {
+    if (gps.satellite_ids_available)
+      writer->LogFRecord(time_utc, gps.satellite_ids);
+    else
+      writer->LogEmptyFRecord(time_utc);
   }
-
-  WritePoint(gps_info);
 }
 
 void
@@ -178,13 +233,9 @@ LoggerImpl::WritePoint(const NMEAInfo &gps_info)
   if (gps_info.location_available && !gps_info.gps.real)
     simulator = true;
 
-  if (!simulator && frecord.Update(gps_info.gps, gps_info.time,
-                                   !gps_info.location_available)) {
-    if (gps_info.gps.satellite_ids_available)
-      writer->LogFRecord(gps_info.date_time_utc, gps_info.gps.satellite_ids);
-    else
-      writer->LogEmptyFRecord(gps_info.date_time_utc);
-  }
+  if (!simulator)
+    WriteFRecord(gps_info.gps, gps_info.time,
+                 !gps_info.location_available, gps_info.date_time_utc);
 
   writer->LogPoint(gps_info);
 }
@@ -280,6 +331,8 @@ LoggerImpl::StartLogger(const NMEAInfo &gps_info,
                       decl.competition_id,
                       logger_id, GetGPSDeviceName(), simulator);
 
+  TrimPreTakeoffBuffer(settings.pre_takeoff_duration);
+
   if (decl.Size()) {
     BrokenDateTime FirstDateTime = !pre_takeoff_buffer.empty()
       ? pre_takeoff_buffer.peek().date_time_utc
@@ -291,6 +344,8 @@ LoggerImpl::StartLogger(const NMEAInfo &gps_info,
 
     writer->EndDeclaration();
   }
+
+  WritePreTakeoffBuffer();
 }
 
 void
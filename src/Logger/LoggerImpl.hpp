@@ -8,8 +8,11 @@
 #include "time/Stamp.hpp"
 #include "Geo/GeoPoint.hpp"
 #include "system/Path.hpp"
+#include "NMEA/GPSState.hpp"
 #include "util/OverwritingRingBuffer.hpp"
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 
 #include <tchar.h>
@@ -26,57 +29,83 @@ class LoggerImpl
 {
 public:
   enum {
-    /** Buffer size (s) of points recorded before takeoff */
-    PRETAKEOFF_BUFFER_MAX = 60,
+    /**
+     * Number of points recorded before takeoff.  With the default
+     * cruise time step (5 s), this covers 12 minutes.
+     */
+    PRETAKEOFF_BUFFER_MAX = 150,
   };
 
-  /** Buffer for points recorded before takeoff */
-  struct PreTakeoffBuffer
+  /**
+   * A compact copy of a fix recorded before takeoff, holding only
+   * what is needed to write the B and F records later.
+   */
+  struct PreTakeoffFix
   {
-    /** Location of fix */
-    GeoPoint location;
-    /** Barometric altitude (m STD) */
-    double pressure_altitude;
-    /** GPS Altitude (m) */
-    double altitude_gps;
     /** Date and time of fix */
     BrokenDateTime date_time_utc;
+
+    /** Time of fix [ms], for the F record clock */
+    uint32_t time_ms;
+
+    /** Location of fix [1/1000 minutes of arc] */
+    int32_t latitude, longitude;
+
+    /**
+     * Barometric altitude (m STD), falling back to GPS altitude if
+     * there is none (see IGCFix::Apply())
+     */
+    int16_t pressure_altitude;
+
+    /** GPS Altitude (m) */
+    int16_t gps_altitude;
+
     /** IDs of satellites in fix */
-    int satellite_ids[GPSState::MAXSATELLITES];
-    bool satellite_ids_available;
-    /** Time of fix (s) */
-    TimeStamp time;
-    /** GPS fix quality */
-    FixQuality fix_quality;
-    /** GPS fix state */
-    int satellites_used;
-    bool satellites_used_available;
-    /** GPS Horizontal Dilution of precision */
-    double hdop;
+    uint16_t satellite_ids[GPSState::MAXSATELLITES];
+
+    /** Estimated position error [m], see IGCWriter::GetEPE() */
+    uint16_t epe;
+
+    /** Satellites in use, see IGCWriter::GetSIU() */
+    uint8_t siu;
+
+    /** Satellites used in the fix (for the F record) */
+    uint8_t satellites_used;
+
+    bool location_available:1;
+    bool gps_altitude_available:1;
+    bool satellites_used_available:1;
+    bool satellite_ids_available:1;
 
     /**
      * Is the fix real? (no replay, no simulator)
      */
-    bool real;
+    bool real:1;
 
-    bool pressure_altitude_available;
-    bool gps_altitude_available;
-
-    /** 
+    /**
      * Set buffer value from NMEA_INFO structure
-     * 
+     *
      * @param src Item to set
-     * 
+     *
      * @return Buffer value
      */
-    const struct PreTakeoffBuffer &operator=(const NMEAInfo &src);
+    const PreTakeoffFix &operator=(const NMEAInfo &src) noexcept;
+
+    [[gnu::pure]]
+    GeoPoint GetLocation() const noexcept;
+
+    /**
+     * Reconstruct the parts of #GPSState which are needed by
+     * #LoggerFRecord.
+     */
+    void CopyTo(GPSState &gps) const noexcept;
   };
 
 private:
   AllocatedPath filename;
   std::unique_ptr<IGCWriter> writer;
 
-  OverwritingRingBuffer<PreTakeoffBuffer, PRETAKEOFF_BUFFER_MAX> pre_takeoff_buffer;
+  OverwritingRingBuffer<PreTakeoffFix, PRETAKEOFF_BUFFER_MAX + 1> pre_takeoff_buffer;
 
   LoggerFRecord frecord;
 
@@ -120,5 +149,20 @@ private:
 
 private:
   void LogPointToBuffer(const NMEAInfo &gps_info) noexcept;
+
+  /**
+   * Remove buffered points which are older than the configured
+   * duration (relative to the newest one).
+   */
+  void TrimPreTakeoffBuffer(std::chrono::steady_clock::duration max_age) noexcept;
+
+  /**
+   * Write all buffered points to the new IGC file in one go and
+   * clear the buffer.
+   */
+  void WritePreTakeoffBuffer();
+
+  void WriteFRecord(const GPSState &gps, TimeStamp time,
+                    bool nav_warning, const BrokenTime &time_utc);
   void WritePoint(const NMEAInfo &gps_info);
 };
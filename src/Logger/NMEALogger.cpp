@@ -2,7 +2,8 @@
 // Copyright The XCSoar Project
 
 #include "Logger/NMEALogger.hpp"
-#include "io/FileOutputStream.hxx"
+#include "CompressedNMEA.hpp"
+#include "io/AsyncFileWriter.hpp"
 #include "LocalPath.hpp"
 #include "time/BrokenDateTime.hpp"
 #include "system/Path.hpp"
@@ -10,7 +11,16 @@
 #include "util/StaticString.hxx"
 
 NMEALogger::NMEALogger() noexcept {}
-NMEALogger::~NMEALogger() noexcept = default;
+
+NMEALogger::~NMEALogger() noexcept
+{
+  if (compressed != nullptr) {
+    try {
+      compressed->Finish();
+    } catch (...) {
+    }
+  }
+}
 
 inline void
 NMEALogger::Start()
@@ -22,15 +32,25 @@ NMEALogger::Start()
   assert(dt.IsPlausible());
 
   StaticString<64> name;
-  name.Format(_T("%04u-%02u-%02u_%02u-%02u.nmea"),
+  name.Format(_T("%04u-%02u-%02u_%02u-%02u%s"),
               dt.year, dt.month, dt.day,
-              dt.hour, dt.minute);
+              dt.hour, dt.minute,
+              compress ? _T(".nmz") : _T(".nmea"));
 
   const auto logs_path = MakeLocalPath(_T("logs"));
 
   const auto path = AllocatedPath::Build(logs_path, name);
-  file = std::make_unique<FileOutputStream>(path,
-                                            FileOutputStream::Mode::APPEND_OR_CREATE);
+  file = std::make_unique<AsyncFileWriter>(path,
+                                           compress
+                                           /* a gzip stream can't be
+                                              appended to */
+                                           ? FileOutputStream::Mode::CREATE_VISIBLE
+                                           : FileOutputStream::Mode::APPEND_OR_CREATE);
+  start_time = std::chrono::steady_clock::now();
+
+  if (compress)
+    compressed = std::make_unique<CompressedNMEAWriter>(*file,
+                                                        dt.ToTimePoint());
 }
 
 static void
@@ -52,7 +72,13 @@ NMEALogger::Log(const char *text) noexcept
 
   try {
     Start();
-    WriteLine(*file, text);
+
+    if (compressed != nullptr) {
+      const auto time = std::chrono::steady_clock::now() - start_time;
+      compressed->Write(std::chrono::duration_cast<CompressedNMEA::Duration>(time),
+                        text);
+    } else
+      WriteLine(*file, text);
   } catch (...) {
   }
 }
@@ -5,16 +5,35 @@
 
 #include "thread/Mutex.hxx"
 
+#include <chrono>
 #include <memory>
 
-class FileOutputStream;
+class AsyncFileWriter;
+class CompressedNMEAWriter;
 
 class NMEALogger {
   Mutex mutex;
-  std::unique_ptr<FileOutputStream> file;
+  std::unique_ptr<AsyncFileWriter> file;
+
+  /**
+   * Only set if the log is being compressed.
+   */
+  std::unique_ptr<CompressedNMEAWriter> compressed;
+
+  /**
+   * When was the file opened?  Used for the time stamps of the
+   * compressed log.
+   */
+  std::chrono::steady_clock::time_point start_time;
 
   bool enabled = false;
 
+  /**
+   * Write the compressed format (see #CompressedNMEAWriter) instead
+   * of plain text?
+   */
+  bool compress = false;
+
 public:
   NMEALogger() noexcept;
   ~NMEALogger() noexcept;
@@ -32,7 +51,18 @@ public:
   }
 
   /**
-   * Logs NMEA string to log file
+   * Choose the file format.  This only affects log files opened
+   * after this call.
+   */
+  void SetCompressed(bool _compress) noexcept {
+    const std::lock_guard lock{mutex};
+    compress = _compress;
+  }
+
+  /**
+   * Logs NMEA string to log file.  This only copies the line to a
+   * buffer; the file is written by a separate thread, so the port
+   * threads are not blocked by a slow storage device.
    * @param text
    */
   void Log(const char *line) noexcept;
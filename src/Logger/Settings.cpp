@@ -8,6 +8,7 @@ LoggerSettings::SetDefaults()
 {
   time_step_cruise = std::chrono::seconds{5};
   time_step_circling = std::chrono::seconds{1};
+  pre_takeoff_duration = std::chrono::minutes{3};
   auto_logger = AutoLogger::ON;
   logger_id.clear();
   pilot_name.clear();
@@ -19,4 +20,5 @@ LoggerSettings::SetDefaults()
   enable_flight_logger = false;
 
   enable_nmea_logger = false;
+  compress_nmea_log = false;
 }
@@ -21,12 +21,25 @@ struct LoggerSettings {
    */
   bool enable_nmea_logger;
 
+  /**
+   * Shall the #NMEALogger write the compressed format (see
+   * #CompressedNMEAWriter)?
+   */
+  bool compress_nmea_log;
+
   /** Logger interval in cruise mode */
   std::chrono::duration<unsigned> time_step_cruise;
 
   /** Logger interval in circling mode */
   std::chrono::duration<unsigned> time_step_circling;
 
+  /**
+   * How much of the time before the logger was started shall be
+   * written to the IGC file?  This is limited by the size of the
+   * buffer, see LoggerImpl::PRETAKEOFF_BUFFER_MAX.
+   */
+  std::chrono::duration<unsigned> pre_takeoff_duration;
+
   enum class AutoLogger: uint8_t {
     ON,
     START_ONLY,
@@ -17,6 +17,8 @@
 #include "Audio/Sound.hpp"
 #include "Components.hpp"
 #include "ProcessTimer.hpp"
+#include "StartupTrace.hpp"
+#include "CommandLine.hpp"
 #include "LogFile.hpp"
 #include "Gauge/GaugeFLARM.hpp"
 #include "Gauge/GaugeThermalAssistant.hpp"
@@ -164,7 +166,10 @@ MainWindow::Initialise()
   SetCursorColorsInverted(CommonInterface::GetDisplaySettings().invert_cursor_colors);
 #endif
 
-  Fonts::Initialize();
+  {
+    const StartupTrace::Timer trace_timer{StartupStage::FONTS};
+    Fonts::Initialize();
+  }
 
   if (look == nullptr)
     look = new Look();
@@ -706,6 +711,11 @@ MainWindow::RunTimer() noexcept
 
   ProcessTimer();
 
+  if (CommandLine::benchmark_startup && StartupTrace::IsComplete() &&
+      IsRunning() && !HasDialog())
+    /* the startup benchmark is finished */
+    UIActions::SignalShutdown(true);
+
   UpdateGaugeVisibility();
 
   if (CommonInterface::GetUISettings().thermal_assistant_position == UISettings::ThermalAssistantPosition::OFF) {
@@ -847,7 +857,10 @@ MainWindow::SetUIState(const UIState &ui_state) noexcept
 {
   if (map != nullptr) {
     map->SetUIState(ui_state);
-    map->FullRedraw();
+
+    /* this is called for each new calculation result; the map may
+       skip it if nothing visible has changed */
+    map->DataRedraw();
   }
 }
 
@@ -12,6 +12,8 @@
 #include "Topography/Thread.hpp"
 #include "Terrain/Thread.hpp"
 
+#include <cmath>
+
 GlueMapWindow::GlueMapWindow(const Look &look) noexcept
   :MapWindow(look.map, look.traffic),
    thermal_band_renderer(look.thermal_band, look.chart),
@@ -118,6 +120,54 @@ GlueMapWindow::ExchangeBlackboard() noexcept
 #endif
 }
 
+#ifndef ENABLE_OPENGL
+
+bool
+GlueMapWindow::UpdateSceneKey() noexcept
+{
+  if (!visible_projection.IsValid()) {
+    scene_key.reset();
+    return true;
+  }
+
+  const MoreData &basic = Basic();
+  const DerivedInfo &calculated = Calculated();
+
+  SceneKey key;
+  key.center = visible_projection.GetGeoLocation();
+  key.screen_angle = visible_projection.GetScreenAngle();
+  key.scale = visible_projection.GetScale();
+  key.screen_size = visible_projection.GetScreenSize();
+  key.screen_origin = visible_projection.GetScreenOrigin();
+
+  key.location = basic.location_available
+    ? basic.location
+    : GeoPoint::Invalid();
+  key.track = basic.track_available ? basic.track : Angle::Zero();
+  key.altitude = basic.NavAltitudeAvailable()
+    ? (int)std::lround(basic.nav_altitude)
+    : 0;
+  key.vario = (int)std::lround(basic.brutto_vario * 10);
+
+  if (calculated.wind_available) {
+    key.wind_speed = (int)std::lround(calculated.wind.norm * 10);
+    key.wind_bearing = (int)std::lround(calculated.wind.bearing.Degrees());
+  } else
+    key.wind_speed = key.wind_bearing = -1;
+
+  key.traffic_modified = basic.flarm.traffic.modified;
+  key.display_mode = GetUIState().display_mode;
+  key.circling = calculated.circling;
+
+  if (scene_key && *scene_key == key)
+    return false;
+
+  scene_key = key;
+  return true;
+}
+
+#endif
+
 void
 GlueMapWindow::SuspendThreads() noexcept
 {
@@ -136,18 +186,36 @@ GlueMapWindow::ResumeThreads() noexcept
 #endif
 }
 
-void
-GlueMapWindow::FullRedraw() noexcept
+inline void
+GlueMapWindow::UpdateAll() noexcept
 {
   UpdateDisplayMode();
   UpdateScreenAngle();
   UpdateProjection();
   UpdateMapScale();
   UpdateScreenBounds();
+}
 
+void
+GlueMapWindow::FullRedraw() noexcept
+{
+  UpdateAll();
   DeferRedraw();
 }
 
+void
+GlueMapWindow::DataRedraw() noexcept
+{
+  UpdateAll();
+
+#ifdef ENABLE_OPENGL
+  Invalidate();
+#else
+  /* unlike InjectRedraw(), this doesn't set #forced_redraw */
+  redraw_notify.SendNotification();
+#endif
+}
+
 void
 GlueMapWindow::PartialRedraw() noexcept
 {
@@ -156,7 +224,10 @@ GlueMapWindow::PartialRedraw() noexcept
   Invalidate();
 #else
   if (draw_thread != nullptr)
-    draw_thread->TriggerRedraw();
+    draw_thread->TriggerRedraw(forced_redraw.exchange(false,
+                                                      std::memory_order_relaxed)
+                               ? FramePacer::Priority::NORMAL
+                               : FramePacer::Priority::DATA);
 #endif
 }
 
@@ -182,7 +253,8 @@ GlueMapWindow::QuickRedraw() noexcept
 
 #ifndef ENABLE_OPENGL
   /* we suppose that the operation will need a full redraw later, so
-     trigger that now */
-  DeferRedraw();
+     trigger that now, bypassing the frame rate limit */
+  if (draw_thread != nullptr)
+    draw_thread->TriggerRedraw(FramePacer::Priority::INPUT);
 #endif
 }
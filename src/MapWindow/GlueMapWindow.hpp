@@ -20,6 +20,11 @@
 
 #include <array>
 
+#ifndef ENABLE_OPENGL
+#include <atomic>
+#include <optional>
+#endif
+
 struct Look;
 struct GestureLook;
 class TopographyThread;
@@ -113,6 +118,42 @@ class GlueMapWindow : public MapWindow {
   ComputerSettings next_settings_computer;
 
   UIState next_ui_state;
+
+  /**
+   * Was a redraw for anything other than new data (see DataRedraw())
+   * requested since the last PartialRedraw() call?
+   */
+  std::atomic_bool forced_redraw{true};
+
+  /**
+   * The visible inputs of the last frame; if none of them changes,
+   * the DrawThread may skip the frame in "static scene" mode.  Only
+   * accessed by the DrawThread.
+   */
+  struct SceneKey {
+    GeoPoint center;
+    Angle screen_angle;
+    double scale;
+    PixelSize screen_size;
+    PixelPoint screen_origin;
+
+    GeoPoint location;
+    Angle track;
+
+    /**
+     * Altitude [m], vario [dm/s] and wind [dm/s, degrees] rounded to
+     * what the overlays can show.
+     */
+    int altitude, vario, wind_speed, wind_bearing;
+
+    Validity traffic_modified;
+    DisplayMode display_mode;
+    bool circling;
+
+    bool operator==(const SceneKey &other) const noexcept = default;
+  };
+
+  std::optional<SceneKey> scene_key;
 #endif
 
   ThermalBandRenderer thermal_band_renderer;
@@ -150,6 +191,16 @@ public:
    */
   void ExchangeBlackboard() noexcept;
 
+#ifndef ENABLE_OPENGL
+  /**
+   * Compare the visible inputs of the next frame with the previous
+   * one.  Call this in the DrawThread after ExchangeBlackboard().
+   *
+   * @return true if something has changed
+   */
+  bool UpdateSceneKey() noexcept;
+#endif
+
   /**
    * Suspend threads that are owned by this object.
    */
@@ -164,6 +215,14 @@ public:
    * Trigger a full redraw of the map.
    */
   void FullRedraw() noexcept;
+
+  /**
+   * Like FullRedraw(), but for new sensor or calculation data.  The
+   * DrawThread may limit the frame rate for these, or skip them if
+   * nothing visible has changed.
+   */
+  void DataRedraw() noexcept;
+
   void PartialRedraw() noexcept;
 
   void QuickRedraw() noexcept;
@@ -175,6 +234,9 @@ public:
    * This method is thread-safe.
    */
   void InjectRedraw() noexcept {
+#ifndef ENABLE_OPENGL
+    forced_redraw.store(true, std::memory_order_relaxed);
+#endif
     redraw_notify.SendNotification();
   }
 
@@ -245,6 +307,11 @@ private:
   void DrawFlightMode(Canvas &canvas, const PixelRect &rc) const noexcept;
   void DrawGPSStatus(Canvas &canvas, const PixelRect &rc,
                      const NMEAInfo &info) const noexcept;
+
+  /**
+   * Show the statistics of the #Profiler (if enabled).
+   */
+  void DrawProfiler(Canvas &canvas, const PixelRect &rc) const noexcept;
   void DrawCrossHairs(Canvas &canvas) const noexcept;
   void DrawPanInfo(Canvas &canvas) const noexcept;
   void DrawThermalBand(Canvas &canvas, const PixelRect &rc) const noexcept;
@@ -270,6 +337,12 @@ private:
   void UpdateScreenAngle() noexcept;
   void UpdateProjection() noexcept;
 
+  /**
+   * Update display mode, projection and map scale for the next
+   * frame.
+   */
+  void UpdateAll() noexcept;
+
 public:
   void SetLocation(const GeoPoint location) noexcept;
 
@@ -5,6 +5,7 @@
 #include "Terrain/RasterTerrain.hpp"
 #include "Topography/Thread.hpp"
 #include "Terrain/Thread.hpp"
+#include "Terrain/Prefetch.hpp"
 #include "Interface.hpp"
 #include "Profile/Profile.hpp"
 #include "Screen/Layout.hpp"
@@ -103,8 +104,29 @@ GlueMapWindow::UpdateScreenBounds() noexcept
      it's used by other calculations, therefore don't check if terrain
      display is enabled */
   if (terrain_thread != nullptr &&
-      visible_projection.IsValid())
-    terrain_thread->Trigger(visible_projection);
+      visible_projection.IsValid()) {
+    const auto &basic = CommonInterface::Basic();
+    const auto &calculated = CommonInterface::Calculated();
+
+    const GeoPoint waypoint = calculated.task_stats.task_valid
+      ? calculated.task_stats.current_leg.location_remaining
+      : GeoPoint::Invalid();
+    const double ground_speed =
+      basic.track_available && basic.ground_speed_available
+      ? basic.ground_speed
+      : 0.;
+
+    /* the predicted path starts at the aircraft, which is only
+       meaningful if the map follows it */
+    const GeoPoint location = IsNearSelf() && basic.location_available
+      ? basic.location
+      : GeoPoint::Invalid();
+
+    terrain_thread->Trigger(visible_projection,
+                            TerrainPrefetch::Predict(location, basic.track,
+                                                     ground_speed, waypoint,
+                                                     calculated.circling));
+  }
 }
 
 void
@@ -13,6 +13,7 @@
 #include "Pan.hpp"
 #include "Topography/Thread.hpp"
 #include "Asset.hpp"
+#include "Profiler.hpp"
 
 #ifdef USE_X11
 #include "ui/event/Globals.hpp"
@@ -448,4 +449,7 @@ GlueMapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
     DrawVario(canvas, rc);
     DrawGPSStatus(canvas, rc, Basic());
   }
+
+  if (Profiler::IsEnabled())
+    DrawProfiler(canvas, rc);
 }
@@ -18,6 +18,8 @@
 #include "Terrain/RasterTerrain.hpp"
 #include "util/Macros.hpp"
 #include "util/StringAPI.hxx"
+#include "util/ConvertString.hpp"
+#include "Profiler.hpp"
 #include "Look/GestureLook.hpp"
 #include "Input/InputEvents.hpp"
 #include "Renderer/MapScaleRenderer.hpp"
@@ -172,6 +174,56 @@ GlueMapWindow::DrawGPSStatus(Canvas &canvas, const PixelRect &rc,
   TextInBox(canvas, txt, p, mode, rc, nullptr);
 }
 
+void
+GlueMapWindow::DrawProfiler(Canvas &canvas,
+                            const PixelRect &rc) const noexcept
+{
+  /* the number of (most expensive) layers to be shown */
+  static constexpr unsigned MAX_LAYER_LINES = 6;
+
+  Profiler::Report report = Profiler::GetReport();
+  std::sort(report.layers.begin(), report.layers.end(),
+            [](const auto &a, const auto &b){
+              return a.average > b.average;
+            });
+  if (report.layers.size() > MAX_LAYER_LINES)
+    report.layers.shrink(MAX_LAYER_LINES);
+
+  TextInBoxMode mode;
+  mode.shape = LabelShape::ROUNDED_BLACK;
+
+  const Font &font = *look.overlay.overlay_font;
+  canvas.Select(font);
+
+  const int line_height = font.GetHeight() + Layout::GetTextPadding() * 2;
+  PixelPoint p(rc.left + Layout::FastScale(2),
+               rc.top + Layout::FastScale(2));
+
+  StaticString<96> buffer;
+
+  buffer.Format(_T("frame p50=%.1f p90=%.1f p99=%.1f ms, %u skipped"),
+                report.frame_p50, report.frame_p90, report.frame_p99,
+                report.skipped_frames);
+  TextInBox(canvas, buffer, p, mode, rc, nullptr);
+  p.y += line_height;
+
+  const auto &calculation = report.GetTick(Profiler::Thread::CALCULATION);
+  const auto &merge = report.GetTick(Profiler::Thread::MERGE);
+  buffer.Format(_T("calc %.1f/%.1f ms, merge %.2f/%.2f ms"),
+                calculation.average, calculation.max,
+                merge.average, merge.max);
+  TextInBox(canvas, buffer, p, mode, rc, nullptr);
+  p.y += line_height;
+
+  for (const auto &layer : report.layers) {
+    buffer.Format(_T("%s %.2f ms"),
+                  (const TCHAR *)UTF8ToWideConverter(layer.name),
+                  layer.average);
+    TextInBox(canvas, buffer, p, mode, rc, nullptr);
+    p.y += line_height;
+  }
+}
+
 void
 GlueMapWindow::DrawFlightMode(Canvas &canvas,
                               const PixelRect &rc) const noexcept
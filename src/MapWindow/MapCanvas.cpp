@@ -42,8 +42,9 @@ void
 MapCanvas::Project(const Projection &projection,
                    const SearchPointVector &points, BulkPixelPoint *screen) noexcept
 {
+  const auto f = projection.GetFastGeoToScreen();
   for (const auto i : points)
-    *screen++ = projection.GeoToScreen(i.GetLocation());
+    *screen++ = f(i.GetLocation());
 }
 
 bool
@@ -67,8 +68,8 @@ MapCanvas::PreparePolygon(const SearchPointVector &points) noexcept
 
   /* project all GeoPoints to screen coordinates */
   raster_points.GrowDiscard(num_raster_points);
-  for (unsigned i = 0; i < num_raster_points; ++i)
-    raster_points[i] = projection.GeoToScreen(geo_points[i]);
+  projection.GeoToScreen({geo_points.data(), num_raster_points},
+                         std::span{raster_points.data(), num_raster_points});
 
   return true;
 }
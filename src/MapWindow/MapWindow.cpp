@@ -56,6 +56,7 @@ void
 MapWindow::FlushCaches() noexcept
 {
   background.Flush();
+  background_cache.Invalidate();
   if (rasp_renderer)
     rasp_renderer->Flush();
   airspace_renderer.Flush();
@@ -137,6 +138,7 @@ void
 MapWindow::SetTopography(TopographyStore *_topography) noexcept
 {
   topography = _topography;
+  background_cache.Invalidate();
 
   delete topography_renderer;
   topography_renderer = topography != nullptr
@@ -149,6 +151,7 @@ MapWindow::SetTerrain(RasterTerrain *_terrain) noexcept
 {
   terrain = _terrain;
   background.SetTerrain(_terrain);
+  background_cache.Invalidate();
 }
 
 void
@@ -14,12 +14,18 @@
 #include "MapWindowBlackboard.hpp"
 #include "Renderer/AirspaceLabelRenderer.hpp"
 #include "Renderer/BackgroundRenderer.hpp"
+#include "Renderer/OpaqueRendererCache.hpp"
 #include "Renderer/WaypointRenderer.hpp"
 #include "Renderer/TrailRenderer.hpp"
+#include "Renderer/TrafficLabelCache.hpp"
+#include "Renderer/TrafficRenderer.hpp"
+#include "Tracking/MergedTraffic.hpp"
 #include "Weather/Features.hpp"
 #include "Tracking/SkyLines/Features.hpp"
 #include "Tracking/JETProvider/JETProvider.hpp"
 #include "Engine/Task/TaskInterface.hpp"
+#include "Terrain/TerrainSettings.hpp"
+#include "util/Serial.hpp"
 
 #include <memory>
 
@@ -123,6 +129,33 @@ protected:
   const TrafficLook &traffic_look;
 
   BackgroundRenderer background;
+
+  /**
+   * The bottom layers (terrain, RASP and topography), composited by
+   * RenderBackground().  The layers above depend on the aircraft
+   * state and are drawn on top of it in each frame.
+   */
+  OpaqueRendererCache background_cache;
+
+  /**
+   * The inputs of #background_cache other than the projection; if
+   * one of them changes, the cache is rendered again.
+   */
+  struct BackgroundKey {
+    Serial terrain_serial;
+    unsigned topography_serial;
+    Angle shading_angle;
+    TerrainRendererSettings terrain_settings;
+    bool topography_enabled;
+
+    bool operator==(const BackgroundKey &other) const noexcept {
+      return terrain_serial == other.terrain_serial &&
+        topography_serial == other.topography_serial &&
+        shading_angle.CompareRoughly(other.shading_angle) &&
+        terrain_settings == other.terrain_settings &&
+        topography_enabled == other.topography_enabled;
+    }
+  } background_key;
   WaypointRenderer waypoint_renderer;
 
   AirspaceRenderer airspace_renderer;
@@ -148,6 +181,21 @@ protected:
 
   const JETProvider::Data *jet_provider_data = nullptr;
 
+  TrafficLabelCache jet_provider_labels;
+
+  /**
+   * The traffic of all sources, rebuilt by DrawTraffic() for each
+   * frame.  Only used by the DrawThread; it is a member only to
+   * reuse its allocation.
+   */
+  MergedTrafficList traffic_list;
+
+  /**
+   * Collects the traffic symbols drawn by DrawTraffic(); a member
+   * only to reuse its allocations.
+   */
+  TrafficRenderer::Batch traffic_batch;
+
   bool compass_visible = true;
 
 #ifndef ENABLE_OPENGL
@@ -296,10 +344,6 @@ protected:
   virtual void RenderTrail(Canvas &canvas, PixelPoint aircraft_pos) noexcept;
   virtual void RenderTrackBearing(Canvas &canvas, PixelPoint aircraft_pos) noexcept;
 
-#ifdef HAVE_SKYLINES_TRACKING
-  void DrawSkyLinesTraffic(Canvas &canvas) const noexcept;
-#endif
-
   void DrawTeammate(Canvas &canvas) const noexcept;
   void DrawContest(Canvas &canvas) noexcept;
   void DrawTask(Canvas &canvas) noexcept;
@@ -311,9 +355,13 @@ protected:
 
   void DrawGlideThroughTerrain(Canvas &canvas) const noexcept;
   void DrawTerrainAbove(Canvas &canvas) noexcept;
-  void DrawFLARMTraffic(Canvas &canvas, PixelPoint aircraft_pos) const noexcept;
-  void DrawGLinkTraffic(Canvas &canvas) const noexcept;
-  void DrawJETProviderTraffic(Canvas &canvas, const PixelPoint aircraft_pos) const noexcept;
+
+  /**
+   * Draws the traffic of all sources (FLARM, SkyLines and
+   * JETProvider).  Aircraft reported by more than one source are
+   * drawn only once.
+   */
+  void DrawTraffic(Canvas &canvas, PixelPoint aircraft_pos) noexcept;
 
   PixelPoint CalculatePixelPoint(PixelPoint p1, PixelPoint p2, double percent);
 
@@ -351,6 +399,16 @@ protected:
   void OnPaintBuffer(Canvas& canvas) noexcept override;
 
 private:
+  [[gnu::pure]]
+  BackgroundKey MakeBackgroundKey() const noexcept;
+
+  /**
+   * Renders terrain, RASP and topography, or copies them from
+   * #background_cache
+   * @param canvas The drawing canvas
+   */
+  void RenderBackground(Canvas &canvas) noexcept;
+
   /**
    * Renders the terrain background
    * @param canvas The drawing canvas
@@ -24,37 +24,33 @@ IsFriend(FlarmId id) noexcept
 }
 
 static void
-UpdateFadingTraffic(bool fade_traffic,
-                    std::map<FlarmId, FlarmTraffic> &dest,
+UpdateFadingTraffic(bool fade_traffic, FadingTrafficList &dest,
                     const TrafficList &old_list, const TrafficList &new_list,
                     TimeStamp now) noexcept
 {
   if (!fade_traffic) {
-    dest.clear();
+    dest.Clear();
     return;
   }
 
-  if (new_list.modified.Modified(old_list.modified)||true) {
-    /* first add all items from the old list */
-    for (const auto &traffic : old_list.list)
-      if (traffic.location_available)
-        dest.try_emplace(traffic.id, traffic);
+  /* add all items from the old list which have disappeared */
+  for (const auto &traffic : old_list.list)
+    if (traffic.location_available &&
+        new_list.FindTraffic(traffic.id) == nullptr)
+      dest.Add(traffic);
 
-    /* now remove all items that are in the new list; now only items
-       remain that have disappeared */
-    for (const auto &traffic : new_list.list)
-      if (auto i = dest.find(traffic.id); i != dest.end())
-        dest.erase(i);
-  }
+  /* remove all items which have reappeared or haven't been seen again
+     for too long */
+  dest.RemoveIf([&new_list, now](const FlarmTraffic &traffic){
+    if (new_list.FindTraffic(traffic.id) != nullptr)
+      return true;
 
-  /* remove all items that havn't been seen again for too long */
-  std::erase_if(dest, [now](const auto &i){
     /* friends expire after 10 minutes, all others after one minute */
-    const auto max_age = IsFriend(i.first)
+    const auto max_age = IsFriend(traffic.id)
       ? std::chrono::minutes{10}
       : std::chrono::minutes{1};
 
-    return i.second.valid.IsOlderThan(now, max_age);
+    return traffic.valid.IsOlderThan(now, max_age);
   });
 }
 
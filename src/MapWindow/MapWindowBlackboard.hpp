@@ -8,8 +8,7 @@
 #include "Blackboard/MapSettingsBlackboard.hpp"
 #include "thread/Debug.hpp"
 #include "UIState.hpp"
-
-#include <map>
+#include "FLARM/FadingList.hpp"
 
 /**
  * Blackboard used by map window: provides read-only access to local
@@ -27,7 +26,7 @@ class MapWindowBlackboard:
    * FLARM traffic that has disappeared, but will remain on the map
    * (greyed out) for some time.
    */
-  std::map<FlarmId, FlarmTraffic> fading_flarm_traffic;
+  FadingTrafficList fading_flarm_traffic;
 
 protected:
   MapWindowBlackboard() noexcept {
@@ -8,6 +8,8 @@
 #include "Weather/Rasp/RaspCache.hpp"
 #include "Weather/Skysight/Skysight.hpp"
 #include "Topography/CachedTopographyRenderer.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Terrain/RasterTerrain.hpp"
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/WaveRenderer.hpp"
 #include "Operation/Operation.hpp"
@@ -28,8 +30,6 @@ MapWindow::RenderTrackBearing(Canvas &canvas,
 inline void
 MapWindow::RenderTerrain(Canvas &canvas) noexcept
 {
-  background.SetShadingAngle(render_projection, GetMapSettings().terrain,
-                             Calculated());
   background.Draw(canvas, render_projection, GetMapSettings().terrain);
 }
 
@@ -93,6 +93,61 @@ MapWindow::RenderTopographyLabels(Canvas &canvas) noexcept
     topography_renderer->DrawLabels(canvas, render_projection, label_block);
 }
 
+MapWindow::BackgroundKey
+MapWindow::MakeBackgroundKey() const noexcept
+{
+  const MapSettings &settings = GetMapSettings();
+
+  BackgroundKey key;
+  key.terrain_serial = terrain != nullptr ? terrain->GetSerial() : Serial{};
+  key.topography_serial = topography != nullptr ? topography->GetSerial() : 0;
+  key.shading_angle = background.GetShadingAngle();
+  key.terrain_settings = settings.terrain;
+  key.topography_enabled = settings.topography_enabled;
+  return key;
+}
+
+inline void
+MapWindow::RenderBackground(Canvas &canvas) noexcept
+{
+  background.SetShadingAngle(render_projection, GetMapSettings().terrain,
+                             Calculated());
+
+  if (rasp_store != nullptr && GetUIState().weather.map >= 0) {
+    /* RASP follows the clock; don't bother caching it */
+    background_cache.Invalidate();
+
+    draw_sw.Mark("RenderTerrain");
+    RenderTerrain(canvas);
+
+    draw_sw.Mark("RenderRasp");
+    RenderRasp(canvas);
+
+    draw_sw.Mark("RenderTopography");
+    RenderTopography(canvas);
+    return;
+  }
+
+  const BackgroundKey key = MakeBackgroundKey();
+  if (!background_cache.Check(render_projection) || !(key == background_key)) {
+    Canvas &buffer = background_cache.Begin(canvas, render_projection);
+
+    draw_sw.Mark("RenderTerrain");
+    RenderTerrain(buffer);
+
+    /* releases the RASP renderer after it has been switched off */
+    RenderRasp(buffer);
+
+    draw_sw.Mark("RenderTopography");
+    RenderTopography(buffer);
+
+    background_key = key;
+  }
+
+  draw_sw.Mark("CopyBackground");
+  background_cache.CopyTo(canvas, render_projection);
+}
+
 inline void
 MapWindow::RenderOverlays([[maybe_unused]] Canvas &canvas) noexcept
 {
@@ -197,18 +252,11 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
   //////////////////////////////////////////////// items on ground
 
   // Render terrain, groundline and topography
-  draw_sw.Mark("RenderTerrain");
-  RenderTerrain(canvas);
-
-  draw_sw.Mark("RenderRasp");
-  RenderRasp(canvas);
+  RenderBackground(canvas);
 
   draw_sw.Mark("RenderSkysight");
   RenderSkysight(canvas); 
 
-  draw_sw.Mark("RenderTopography");
-  RenderTopography(canvas);
-
   draw_sw.Mark("RenderOverlays");
   RenderOverlays(canvas);
 
@@ -278,17 +326,9 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc) noexcept
   //////////////////////////////////////////////// traffic
   // Draw traffic
 
-#ifdef HAVE_SKYLINES_TRACKING
-  DrawSkyLinesTraffic(canvas);
-#endif
-
-  DrawGLinkTraffic(canvas);
-
   DrawTeammate(canvas);
 
-  DrawFLARMTraffic(canvas, aircraft_pos);
-
-  DrawJETProviderTraffic(canvas, aircraft_pos);
+  DrawTraffic(canvas, aircraft_pos);
 
   //////////////////////////////////////////////// own aircraft
   // Finally, draw you!
@@ -10,27 +10,22 @@
 #include "Renderer/TrafficRenderer.hpp"
 #include "FLARM/Friends.hpp"
 #include "Tracking/SkyLines/Data.hpp"
+#include "Tracking/JETProvider/Extrapolate.hpp"
 #include "util/StringCompare.hxx"
 
 #include <cassert>
+#include <ranges>
+#include <vector>
 
 static void
 DrawFlarmTraffic(Canvas &canvas, const WindowProjection &projection,
-                 const TrafficLook &look, bool fading,
+                 const TrafficLook &look, TrafficRenderer::Batch &batch,
+                 bool fading,
                  const PixelPoint aircraft_pos,
-                 const FlarmTraffic &traffic) noexcept
+                 const FlarmTraffic &traffic, const PixelPoint sc) noexcept
 {
   assert(traffic.location_available);
 
-  // Points for the screen coordinates for the icon, name and average climb
-  PixelPoint sc;
-
-  // If FLARM target not on the screen, move to the next one
-  if (auto p = projection.GeoToScreenIfVisible(traffic.location))
-    sc = *p;
-  else
-    return;
-
   TextInBoxMode mode;
   if (!fading)
     mode.shape = LabelShape::OUTLINED;
@@ -66,143 +61,325 @@ DrawFlarmTraffic(Canvas &canvas, const WindowProjection &projection,
 
   auto color = FlarmFriends::GetFriendColor(traffic.id);
 
-  TrafficRenderer::Draw(canvas, look, fading, traffic,
-                        traffic.track - projection.GetScreenAngle(),
-                        color, sc);
+  batch.Add(canvas, look, fading, traffic,
+            traffic.track - projection.GetScreenAngle(),
+            color, sc);
 }
 
 /**
- * Draws the FLARM traffic icons onto the given canvas
- * @param canvas Canvas for drawing
+ * Draw the labels of a JETProvider target.  They compete for space in
+ * the #LabelBlock, so this is called nearest first.
  */
-void
-MapWindow::DrawFLARMTraffic(Canvas &canvas,
-                            const PixelPoint aircraft_pos) const noexcept
+static void
+DrawJETProviderLabels(Canvas &canvas, const WindowProjection &projection,
+                      const PixelPoint aircraft_pos,
+                      const MergedTraffic &merged,
+                      TrafficLabelCache &labels,
+                      LabelBlock &label_block) noexcept
 {
-  // Return if FLARM icons on moving map are disabled
-  if (!GetMapSettings().show_flarm_on_map)
-    return;
+  const JETProvider::Traffic &traffic = *merged.jet_provider;
+  const bool fading = merged.fading;
+  const PixelPoint sc = merged.screen;
+  const PixelRect &map_rect = projection.GetScreenRect();
 
-  // Return if FLARM data is not available
-  const TrafficList &flarm = Basic().flarm.traffic;
+  // Draw the name 16 points below the icon
+  const PixelPoint sc_name = sc.At(-Layout::Scale(6), -Layout::Scale(20));
 
-  const WindowProjection &projection = render_projection;
+  // Draw the average climb value above the icon
+  const PixelPoint sc_bottom = sc.At(-Layout::Scale(6), Layout::Scale(10));
 
-  // if zoomed in too far out, dont draw traffic since it will be too close to
-  // the glider and so will be meaningless (serves only to clutter, cant help
-  // the pilot)
-  if (projection.GetMapScale() > 7300)
+  int dx = sc_bottom.x - aircraft_pos.x;
+  int dy = sc_bottom.y - aircraft_pos.y;
+
+  // only draw labels if not close to aircraft
+  if (dx * dx + dy * dy <= Layout::Scale(5 * 5))
     return;
 
-  canvas.Select(*traffic_look.font);
+  TextInBoxMode mode;
+  if (!fading)
+    mode.shape = LabelShape::OUTLINED;
 
-  // Circle through the FLARM targets
-  for (const auto &traffic : flarm.list) {
-    if (!traffic.location_available)
-      continue;
+  /* the LabelBlock drops labels which would overlap others */
+  if (traffic.type && !StringIsEmpty(traffic.type))
+    TextInBox(canvas, traffic.display, sc_name,
+              mode, map_rect, &label_block);
 
-    DrawFlarmTraffic(canvas, projection, traffic_look, false,
-                     aircraft_pos, traffic);
-  }
+  TextInBox(canvas,
+            labels.Get(traffic.traffic_id, merged.altitude,
+                       traffic.vspeed, fading),
+            sc_bottom, mode, map_rect, &label_block);
+}
 
-  if (const auto &fading = GetFadingFlarmTraffic(); !fading.empty()) {
-    for (const auto &[id, traffic] : fading) {
-      assert(traffic.location_available);
+static void
+DrawJETProviderTraffic(Canvas &canvas, const WindowProjection &projection,
+                       const TrafficLook &look, TrafficRenderer::Batch &batch,
+                       const MergedTraffic &merged,
+                       FlarmTraffic::AlarmType alarm_level) noexcept
+{
+  FlarmTraffic t;
+  t.alarm_level = alarm_level;
+  batch.Add(canvas, look, merged.fading, t,
+            merged.track - projection.GetScreenAngle(),
+            FlarmColor::YELLOW, merged.screen);
+}
 
-      DrawFlarmTraffic(canvas, projection, traffic_look, true,
-                       aircraft_pos, traffic);
-    }
+#ifdef HAVE_SKYLINES_TRACKING
+
+static void
+DrawSkyLinesTraffic(Canvas &canvas, const TrafficLook &look,
+                    const PixelRect &map_rect, bool show_name,
+                    const MergedTraffic &traffic) noexcept
+{
+  look.teammate_icon.Draw(canvas, traffic.screen);
+
+  if (show_name) {
+    StaticString<128> buffer;
+    buffer.Format(_T("%s [%um]"), traffic.name.c_str(),
+                  (unsigned)traffic.altitude);
+
+    TextInBoxMode mode;
+    mode.shape = LabelShape::OUTLINED;
+
+    // Draw the name 16 points below the icon
+    TextInBox(canvas, buffer, traffic.screen.At(0, -Layout::Scale(10)),
+              mode, map_rect);
   }
 }
 
+#endif
 
 /**
- * Draws the GliderLink traffic icons onto the given canvas
- * @param canvas Canvas for drawing
+ * A coarse occupancy grid in screen space.  A target whose cell is
+ * already occupied would be drawn (almost) on top of another one, so
+ * it is skipped.
  */
-void
-MapWindow::DrawGLinkTraffic([[maybe_unused]] Canvas &canvas) const noexcept
+class ScreenGrid {
+  const unsigned cell_size, columns, rows;
+  std::vector<bool> occupied;
+
+public:
+  ScreenGrid(PixelSize size, unsigned _cell_size) noexcept
+    :cell_size(_cell_size),
+     columns(size.width / cell_size + 1),
+     rows(size.height / cell_size + 1),
+     occupied(columns * rows, false) {}
+
+  /**
+   * @return true if the cell was free (and is now occupied)
+   */
+  bool Claim(PixelPoint p) noexcept {
+    const unsigned column = unsigned(p.x) / cell_size;
+    const unsigned row = unsigned(p.y) / cell_size;
+    if (column >= columns || row >= rows)
+      return true;
+
+    auto cell = occupied[row * columns + column];
+    if (cell)
+      return false;
+
+    cell = true;
+    return true;
+  }
+};
+
+static void
+CollectFlarmTraffic(MergedTrafficList &list,
+                    const WindowProjection &projection,
+                    const FlarmTraffic &traffic, bool fading) noexcept
 {
-#ifdef ANDROID
+  assert(traffic.location_available);
 
-  // Return if FLARM icons on moving map are disabled
-  if (!GetMapSettings().show_flarm_on_map)
+  // If FLARM target not on the screen, move to the next one
+  const auto p = projection.GeoToScreenIfVisible(traffic.location);
+  if (!p)
     return;
 
-  const GliderLinkTrafficList &traffic = Basic().glink_data.traffic;
-  if (traffic.IsEmpty())
-    return;
+  auto &merged = list.Add(MergedTraffic::Source::FLARM, traffic.id,
+                          traffic.location, *p);
+  merged.fading = fading;
+  merged.flarm = &traffic;
+  if (traffic.altitude_available) {
+    merged.altitude = double(traffic.altitude);
+    merged.altitude_available = true;
+  }
+}
 
-  const MoreData &basic = Basic();
+/**
+ * @return the ICAO address if the JETProvider id is one
+ */
+[[gnu::pure]]
+static FlarmId
+ParseTrafficAddress(const char *traffic_id) noexcept
+{
+  char *endptr;
+  const auto id = FlarmId::Parse(traffic_id, &endptr);
+  return endptr > traffic_id && *endptr == '\0'
+    ? id
+    : FlarmId::Undefined();
+}
 
+void
+MapWindow::DrawTraffic(Canvas &canvas, const PixelPoint aircraft_pos) noexcept
+{
   const WindowProjection &projection = render_projection;
+  const MapSettings &settings = GetMapSettings();
 
-  canvas.Select(*traffic_look.font);
-
-  // Circle through the GliderLink targets
-  for (const auto &traf : traffic.list) {
+  traffic_list.Clear();
 
-    // Points for the screen coordinates for the icon, name and average climb
-    PixelPoint sc;
+  // if zoomed in too far out, dont draw traffic since it will be too close to
+  // the glider and so will be meaningless (serves only to clutter, cant help
+  // the pilot)
+  if (settings.show_flarm_on_map && projection.GetMapScale() <= 7300) {
+    for (const auto &traffic : Basic().flarm.traffic.list)
+      if (traffic.location_available)
+        CollectFlarmTraffic(traffic_list, projection, traffic, false);
 
-    // If FLARM target not on the screen, move to the next one
-    if (auto p = projection.GeoToScreenIfVisible(traf.location))
-      sc = *p;
-    else
-      continue;
+    for (const auto &traffic : Basic().flarm.adsb_traffic.list)
+      if (traffic.location_available)
+        CollectFlarmTraffic(traffic_list, projection, traffic, false);
 
-    TextInBoxMode mode;
-    mode.shape = LabelShape::OUTLINED;
-    mode.align = TextInBoxMode::Alignment::RIGHT;
+    for (const auto &traffic : GetFadingFlarmTraffic())
+      CollectFlarmTraffic(traffic_list, projection, traffic, true);
+  }
 
-    // If callsign/name available draw it to the canvas
-    if (traf.HasName() && !StringIsEmpty(traf.name)) {
-      // Draw the callsign above the icon
-      auto sc_name = sc;
-      sc_name.x -= Layout::Scale(10);
-      sc_name.y -= Layout::Scale(15);
+#ifdef HAVE_SKYLINES_TRACKING
+  const bool show_skylines =
+    settings.skylines_traffic_map_mode != DisplaySkyLinesTrafficMapMode::OFF &&
+    skylines_data != nullptr;
+  if (show_skylines) {
+    const std::lock_guard lock{skylines_data->mutex};
+    for (const auto &[id, traffic] : skylines_data->traffic) {
+      const auto p = render_projection.GeoToScreenIfVisible(traffic.location);
+      if (!p)
+        continue;
+
+      auto &merged = traffic_list.Add(MergedTraffic::Source::SKYLINES,
+                                      FlarmId::Undefined(),
+                                      traffic.location, *p);
+      merged.altitude = traffic.altitude;
+      merged.altitude_available = true;
+
+      /* copy the name, because the mutex is released before
+         drawing */
+      if (const auto name_i = skylines_data->user_names.find(id);
+          name_i != skylines_data->user_names.end())
+        merged.name = name_i->second;
+    }
+  }
+#endif
 
-      TextInBox(canvas, traf.name, sc_name,
-                mode, GetClientRect());
+  /* the mutex is only held while obtaining the table; it is
+     immutable, and our reference keeps it alive until the traffic
+     has been drawn */
+  const auto jet_provider = jet_provider_data != nullptr
+    ? jet_provider_data->GetSnapshot()
+    : JETProvider::Data::Snapshot{};
+  if (jet_provider.table != nullptr) {
+    /* prefer the GPS clock; the system clock of some devices is not
+       reliable */
+    const auto now = Basic().time_available && Basic().date_time_utc.IsPlausible()
+      ? Basic().date_time_utc.ToTimePoint()
+      : std::chrono::system_clock::now();
+
+    /* a target is considered stale after it has missed a few polls;
+       it is then drawn faded and not extrapolated any further */
+    const std::chrono::duration<double> interval =
+      GetComputerSettings().jet_provider_setting.radar.interval;
+    const auto stale_after = JETProvider::GetStaleAfter(interval);
+    const auto expire_after = JETProvider::GetExpireAfter(stale_after);
+
+    for (const auto &traffic : *jet_provider.table) {
+      // Project the last report to the current time
+      const auto extrapolated =
+        JETProvider::Extrapolate(traffic, now, stale_after, expire_after);
+      if (!extrapolated)
+        continue;
+
+      const auto p = projection.GeoToScreenIfVisible(extrapolated->location);
+      if (!p)
+        continue;
+
+      auto &merged = traffic_list.Add(MergedTraffic::Source::JET_PROVIDER,
+                                      ParseTrafficAddress(traffic.traffic_id),
+                                      extrapolated->location, *p);
+      merged.fading = extrapolated->stale;
+      merged.altitude = extrapolated->altitude;
+      merged.altitude_available = true;
+      merged.track = Angle::Degrees(traffic.track);
+      merged.jet_provider = &traffic;
     }
+  }
 
-    if (traf.climb_rate_received) {
+  if (traffic_list.empty())
+    return;
 
-      // If average climb data available draw it to the canvas
-      TCHAR label_avg[100];
-      FormatUserVerticalSpeed(traf.climb_rate,
-                                     label_avg, false);
-      mode.align = TextInBoxMode::Alignment::LEFT;
+  /* one pass: merge duplicates, nearest first */
+  traffic_list.Finish(Basic().location_available
+                      ? Basic().location
+                      : projection.GetGeoScreenCenter());
 
-      // Draw the average climb to the right of the icon
-      auto sc_av = sc;
-      sc_av.x += Layout::Scale(10);
-      sc_av.y -= Layout::Scale(8);
+  canvas.Select(*traffic_look.font);
 
-      TextInBox(canvas, label_avg, sc_av, mode, GetClientRect());
+  const PixelRect map_rect = GetClientRect();
+
+  /* zoomed out over a busy region, most icons would overlap; draw
+     only one per cell (FLARM targets are always drawn); the cells are
+     claimed nearest first, so the nearest target of each cell wins */
+  ScreenGrid grid(map_rect.GetSize(), Layout::Scale(8));
+  std::vector<bool> free_cells;
+  free_cells.reserve(traffic_list.size());
+  for (const auto &traffic : traffic_list)
+    free_cells.push_back(grid.Claim(traffic.screen));
+
+  jet_provider_labels.BeginFrame();
+
+  const auto jet_alarm_level = jet_provider.success
+    ? FlarmTraffic::AlarmType::NONE
+    : FlarmTraffic::AlarmType::OFFLINE;
+
+  /* the labels claim their space nearest first, so the nearest
+     targets keep theirs */
+  auto cell = free_cells.begin();
+  for (const auto &traffic : traffic_list)
+    if (*cell++ &&
+        traffic.source == MergedTraffic::Source::JET_PROVIDER)
+      DrawJETProviderLabels(canvas, projection, aircraft_pos, traffic,
+                            jet_provider_labels, label_block);
+
+  /* paint farthest first, so nearer targets end up on top */
+  std::size_t i = traffic_list.size();
+  for (const auto &traffic : std::ranges::reverse_view{traffic_list}) {
+    const bool free_cell = free_cells[--i];
+
+    switch (traffic.source) {
+    case MergedTraffic::Source::FLARM:
+      DrawFlarmTraffic(canvas, projection, traffic_look, traffic_batch,
+                       traffic.fading,
+                       aircraft_pos, *traffic.flarm, traffic.screen);
+      break;
+
+    case MergedTraffic::Source::JET_PROVIDER:
+      if (free_cell)
+        DrawJETProviderTraffic(canvas, projection, traffic_look,
+                               traffic_batch, traffic, jet_alarm_level);
+      break;
+
+    case MergedTraffic::Source::SKYLINES:
+#ifdef HAVE_SKYLINES_TRACKING
+      if (free_cell)
+        DrawSkyLinesTraffic(canvas, traffic_look, map_rect,
+                            settings.skylines_traffic_map_mode ==
+                            DisplaySkyLinesTrafficMapMode::SYMBOL_NAME,
+                            traffic);
+#endif
+      break;
     }
+  }
 
-    // use GPS altitude to be consistent with GliderLink
-    if(basic.gps_altitude_available && traf.altitude_received
-        && fabs(double(traf.altitude) - basic.gps_altitude) >= 100.0) {
-      // If average climb data available draw it to the canvas
-      TCHAR label_alt[100];
-      double alt = (double(traf.altitude) - basic.gps_altitude) / 100.0;
-      FormatRelativeUserAltitude(alt, label_alt, false);
-
-      // Location of altitude label
-      auto sc_alt = sc;
-      sc_alt.x -= Layout::Scale(10);
-      sc_alt.y -= Layout::Scale(0);
-
-      mode.align = TextInBoxMode::Alignment::RIGHT;
-      TextInBox(canvas, label_alt, sc_alt, mode, GetClientRect());
-    }
+  /* all symbols at once, on top of the labels */
+  traffic_batch.Flush(canvas, traffic_look);
 
-    TrafficRenderer::Draw(canvas, traffic_look, traf,
-                          traf.track - projection.GetScreenAngle(), sc);
-  }
-#endif
+  jet_provider_labels.EndFrame();
 }
 
 /**
@@ -219,119 +396,3 @@ MapWindow::DrawTeammate(Canvas &canvas) const noexcept
       traffic_look.teammate_icon.Draw(canvas, *p);
   }
 }
-
-#ifdef HAVE_SKYLINES_TRACKING
-
-void
-MapWindow::DrawSkyLinesTraffic(Canvas &canvas) const noexcept
-{
-  if (DisplaySkyLinesTrafficMapMode::OFF == GetMapSettings().skylines_traffic_map_mode ||
-      skylines_data == nullptr)
-    return;
-
-  canvas.Select(*traffic_look.font);
-
-  const std::lock_guard lock{skylines_data->mutex};
-  for (auto &i : skylines_data->traffic) {
-    if (auto p = render_projection.GeoToScreenIfVisible(i.second.location)) {
-      traffic_look.teammate_icon.Draw(canvas, *p);
-      if (DisplaySkyLinesTrafficMapMode::SYMBOL_NAME == GetMapSettings().skylines_traffic_map_mode) {
-        const auto name_i = skylines_data->user_names.find(i.first);
-        const TCHAR *name = name_i != skylines_data->user_names.end()
-          ? name_i->second.c_str()
-          : _T("");
-
-        StaticString<128> buffer;
-        buffer.Format(_T("%s [%um]"), name, i.second.altitude);
-
-        TextInBoxMode mode;
-        mode.shape = LabelShape::OUTLINED;
-
-        // Draw the name 16 points below the icon
-        p->y -= Layout::Scale(10);
-        TextInBox(canvas, buffer, *p, mode, GetClientRect());
-      }
-    }
-  }
-}
-
-#endif
-
-void
-MapWindow::DrawJETProviderTraffic(Canvas &canvas,
-  const PixelPoint aircraft_pos) const noexcept
-{
-  if (jet_provider_data == nullptr || jet_provider_data->traffics.empty()) {
-    return;
-  }
-
-  const WindowProjection &projection = render_projection;
-
-  canvas.Select(*traffic_look.font);
-
-  // Circle through the FLARM targets
-  for (auto it = jet_provider_data->traffics.begin(),
-      end = jet_provider_data->traffics.end();
-      it != end; ++it) {
-    const auto &traffic = (*it).second;
-
-    // Save the location of the FLARM target
-    GeoPoint target_loc = traffic.location;
-
-    // Points for the screen coordinates for the icon, name and average climb
-    PixelPoint sc, sc_name, sc_bottom;
-
-    // If FLARM target not on the screen, move to the next one
-    if (auto p = projection.GeoToScreenIfVisible(target_loc))
-      sc = *p;
-    else
-      continue;
-
-    // Draw the name 16 points below the icon
-    sc_name = sc;
-    sc_name.y -= Layout::Scale(20);
-    sc_name.x -= Layout::Scale(6);
-
-    // Draw the average climb value above the icon
-    sc_bottom = sc;
-    sc_bottom.y += Layout::Scale(10);
-    sc_bottom.x -= Layout::Scale(6);
-
-    TextInBoxMode mode;
-    mode.shape = LabelShape::OUTLINED;
-
-    int dx = sc_bottom.x - aircraft_pos.x;
-    int dy = sc_bottom.y - aircraft_pos.y;
-
-    // only draw labels if not close to aircraft
-    if (dx * dx + dy * dy > Layout::Scale(5 * 5)) {
-      if (traffic.type && !StringIsEmpty(traffic.type))
-        TextInBox(canvas, traffic.display, sc_name,
-                  mode, GetClientRect());
-
-      char second_text[32];
-      TCHAR altitude_text[16];
-      FormatUserAltitude(traffic.altitude, altitude_text, false);
-      if (abs(traffic.vspeed) >= 0.1) {
-        // If average climb data available draw it to the canvas
-        TCHAR vspeed_text[16];
-        FormatUserVerticalSpeed(traffic.vspeed,vspeed_text, false, true);
-        StringFormat(second_text, 32, "%s %s", altitude_text , vspeed_text);
-      } else {
-        StringFormat(second_text, 32, "%s", altitude_text);
-      }
-      TextInBox(canvas, second_text, sc_bottom, mode, GetClientRect());
-    }
-    auto color = FlarmColor::YELLOW;
-    FlarmTraffic t;
-    if (jet_provider_data->success) {
-      t.alarm_level = FlarmTraffic::AlarmType::NONE;
-    } else {
-      t.alarm_level = FlarmTraffic::AlarmType::OFFLINE;
-    }
-    TrafficRenderer::Draw(canvas, traffic_look, false, t,
-                          Angle::Degrees(traffic.track) - projection.GetScreenAngle(),
-                          color, sc);
-  }
-
-}
\ No newline at end of file
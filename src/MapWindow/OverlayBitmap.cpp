@@ -29,10 +29,10 @@ using ClippedPolygon = boost::geometry::model::polygon<DoublePoint2D>;
 using ClippedMultiPolygon =
   boost::geometry::model::multi_polygon<ClippedPolygon>;
 
-MapOverlayBitmap::MapOverlayBitmap(Path path)
+MapOverlayBitmap::MapOverlayBitmap(Path path, unsigned max_size)
   :label((path.GetBase() != nullptr ? path.GetBase() : path).c_str())
 {
-  bounds = bitmap.LoadGeoFile(path);
+  bounds = bitmap.LoadGeoFile(path, max_size);
   simple_bounds = bounds.GetBounds();
 }
 
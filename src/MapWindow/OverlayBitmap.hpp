@@ -9,6 +9,8 @@
 #include "Geo/GeoBounds.hpp"
 #include "util/tstring.hpp"
 
+#include <algorithm>
+
 class Canvas;
 class WindowProjection;
 
@@ -42,8 +44,11 @@ public:
    * Load a GeoTIFF file.
    *
    * Throws on error.
+   *
+   * @param max_size downscale the image to this width and height
+   * (see GetMaxImageSize()); 0 loads it at full resolution
    */
-  MapOverlayBitmap(Path path);
+  explicit MapOverlayBitmap(Path path, unsigned max_size=0);
 
   /**
    * Move an existing #Bitmap with a geo reference.
@@ -54,6 +59,17 @@ public:
      simple_bounds(bounds.GetBounds()),
      label(_label) {}
 
+  /**
+   * The largest image size worth keeping for a map of the given
+   * size.  Overlays usually cover more than the visible area, but
+   * twice the screen size is enough to zoom in a bit before the
+   * loss of detail becomes visible; everything beyond that only
+   * costs memory.
+   */
+  static constexpr unsigned GetMaxImageSize(PixelSize screen) noexcept {
+    return 2 * std::max(screen.width, screen.height);
+  }
+
   template<typename T>
   void SetLabel(T &&_label) noexcept {
     label = std::forward<T>(_label);
@@ -53,8 +53,7 @@ StencilMapCanvas::DrawSearchPointVector(const SearchPointVector &points)
 
   /* draw it all */
   BulkPixelPoint *screen = pixel_points_buffer.get(size);
-  for (unsigned i = 0; i < size; ++i)
-    screen[i] = proj.GeoToScreen(geo_points[i]);
+  proj.GeoToScreen({geo_points, size}, std::span{screen, size});
 
   buffer.DrawPolygon(&screen[0], size);
   if (use_stencil)
@@ -12,11 +12,12 @@ ConvexFilter::UpdateConvex(double x, double y, int csign) noexcept
 
   Update(x, y, 1);
 
-  // check pruning of previous points
+  // check pruning of previous points; this is only possible as long
+  // as each slot holds one point
 
-  while (GetCount() > 2) {
-    const unsigned n = GetCount();
+  while (GetSlots().size() > 2 && GetSlots().size() == GetCount()) {
     const auto &s = GetSlots();
+    const unsigned n = s.size();
     const auto &next = s[n - 1];
     const auto &prev = s[n - 3];
     const double m = (next.y-prev.y)/(next.x-prev.x);
@@ -32,7 +32,7 @@ public:
   double GetLastY() const noexcept {
     assert(!IsEmpty());
 
-    return GetSlots()[GetCount() - 1].y;
+    return GetSlots().back().y;
   }
 
 private:
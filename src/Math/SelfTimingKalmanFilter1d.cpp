@@ -8,15 +8,14 @@
 
 void
 SelfTimingKalmanFilter1d::Update(const double z_abs,
-                                 const double var_z_abs) noexcept
+                                 const double var_z_abs,
+                                 const TimePoint time) noexcept
 {
-  const auto now = Clock::now();
-
   /* if we're called too quickly (less than 1us), round dt up to 1us
      to avoid problems in KalmanFilter1d::Update() */
-  const auto dt = std::max<Duration>(now - last_update_time,
+  const auto dt = std::max<Duration>(time - last_update_time,
                                      std::chrono::microseconds{1});
-  last_update_time = now;
+  last_update_time = time;
 
   if (dt > max_dt)
     filter_.Reset();
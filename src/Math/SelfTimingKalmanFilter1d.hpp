@@ -55,7 +55,16 @@ public:
    * filter resetting automatically for updates separated by large
    * time intervals as described above.
    */
-  void Update(double z_abs, double var_z_abs) noexcept;
+  void Update(double z_abs, double var_z_abs) noexcept {
+    Update(z_abs, var_z_abs, Clock::now());
+  }
+
+  /**
+   * Like Update(double, double), but with the time of the
+   * measurement specified by the caller, e.g. for samples which have
+   * been collected in a batch.
+   */
+  void Update(double z_abs, double var_z_abs, TimePoint time) noexcept;
 
   // Remaining methods are identical to their counterparts in KalmanFilter1d.
 
@@ -3,6 +3,8 @@
 
 #include "XYDataStore.hpp"
 
+#include <cassert>
+
 void
 XYDataStore::StoreReset() noexcept
 {
@@ -10,9 +12,45 @@ XYDataStore::StoreReset() noexcept
   sum_xw = 0.;
   sum_yw = 0.;
   sum_weights = 0.;
+  bucket_size = 1;
+  bucket_fill = 0;
   slots.clear();
 }
 
+/**
+ * Merge the point #b into #a, weighted by their weights.
+ */
+static constexpr void
+Merge(auto &a, const auto &b) noexcept
+{
+  const double weight = a.weight + b.weight;
+  if (weight != 0) {
+    a.x = (a.x * a.weight + b.x * b.weight) / weight;
+    a.y = (a.y * a.weight + b.y * b.weight) / weight;
+  } else {
+    a.x = (a.x + b.x) / 2;
+    a.y = (a.y + b.y) / 2;
+  }
+
+  a.weight = weight;
+}
+
+void
+XYDataStore::Decimate() noexcept
+{
+  assert(slots.size() % 2 == 0);
+
+  const unsigned n = slots.size() / 2;
+  for (unsigned i = 0; i < n; ++i) {
+    Slot slot = slots[2 * i];
+    Merge(slot, slots[2 * i + 1]);
+    slots[i] = slot;
+  }
+
+  slots.shrink(n);
+  bucket_size *= 2;
+}
+
 void
 XYDataStore::StoreAdd(double x, double y, double weight) noexcept
 {
@@ -30,9 +68,16 @@ XYDataStore::StoreAdd(double x, double y, double weight) noexcept
     x_min = x;
 
   // Add point
-  // TODO code: really should have a circular buffer here
-  if (!slots.full())
+  if (!slots.empty() && bucket_fill < bucket_size) {
+    Merge(slots.back(), Slot(x, y, weight));
+    ++bucket_fill;
+  } else {
+    if (slots.full())
+      Decimate();
+
     slots.append() = Slot(x, y, weight);
+    bucket_fill = 1;
+  }
 
   ++sum_n;
 
@@ -46,7 +91,9 @@ XYDataStore::StoreAdd(double x, double y, double weight) noexcept
 void
 XYDataStore::StoreRemove(const unsigned i) noexcept
 {
-  assert(i< sum_n);
+  assert(i < slots.size());
+  assert(bucket_size == 1);
+
   const auto &pt = slots[i];
 
   // Remove weighted point
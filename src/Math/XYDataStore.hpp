@@ -2,7 +2,13 @@
 // Copyright The XCSoar Project
 
 /**
- * Basic container class for storage of X-Y data pairs
+ * Basic container class for storage of X-Y data pairs.
+ *
+ * The sums and the minimum/maximum values cover all points, but only
+ * a limited number of slots is kept for drawing.  When they are full,
+ * adjacent slots are merged pairwise, and from then on each slot
+ * collects twice as many points; this way, the slots always span the
+ * whole series at a decreasing resolution.
  */
 
 #pragma once
@@ -26,6 +32,16 @@ private:
 
   unsigned sum_n;
 
+  /**
+   * The number of points merged into each slot.
+   */
+  unsigned bucket_size;
+
+  /**
+   * The number of points merged into the last slot so far.
+   */
+  unsigned bucket_fill;
+
   struct Slot : DoublePoint2D {
     double weight;
 
@@ -35,7 +51,10 @@ private:
       :DoublePoint2D(_x, _y), weight(_weight) {}
   };
 
-  TrivialArray<Slot, 1000> slots;
+  static constexpr std::size_t MAX_SLOTS = 1000;
+  static_assert(MAX_SLOTS % 2 == 0);
+
+  TrivialArray<Slot, MAX_SLOTS> slots;
 
 public:
   constexpr bool IsEmpty() const noexcept {
@@ -46,6 +65,10 @@ public:
     return sum_n >= 2;
   }
 
+  /**
+   * The number of points added so far; this may be larger than the
+   * number of slots.
+   */
   constexpr unsigned GetCount() const noexcept {
     return sum_n;
   }
@@ -105,9 +128,16 @@ protected:
   /**
    * Remove data point to the values.
    * If weights aren't stored, this assumes weight = 1
+   *
+   * This is only allowed as long as no slots have been merged.
    */
   void StoreRemove(const unsigned i) noexcept;
 
+private:
+  /**
+   * Merge each pair of adjacent slots into one.
+   */
+  void Decimate() noexcept;
 };
 
 static_assert(std::is_trivial<XYDataStore>::value, "type is not trivial");
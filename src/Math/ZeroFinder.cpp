@@ -106,31 +106,64 @@ ZeroFinder::solution_within_tolerance(const double x,
  ************************************************************************
  */
 
+/**
+ * Do f(a) and f(b) confine a root?
+ */
+static constexpr bool
+is_bracket(const double fa, const double fb) noexcept
+{
+  return (fa <= 0 && fb >= 0) || (fa >= 0 && fb <= 0);
+}
+
+inline double
+ZeroFinder::find_zero_whole_range() noexcept
+{
+  const auto fa = f(xmin);
+  const auto fb = f(xmax);
+  return find_zero_actual(xmin, fa, xmax, fb);
+}
+
 double
 ZeroFinder::find_zero(const double xstart) noexcept
 {
-  if ((xmin<=xstart) || (xstart<=xmax) ||
-      (f(xstart)> sqrt_epsilon))
-    return find_zero_actual(xstart);
-  return xstart;
+  if (xstart <= xmin || xstart >= xmax)
+    return find_zero_whole_range();
+
+  const auto fstart = f(xstart);
+  if (fabs(fstart) < sqrt_epsilon)
+    return xstart;
+
+  /* the hint is usually the solution of the previous cycle: look for
+     the root in a narrow bracket around it before searching the
+     whole range */
+  const auto range = xmax - xmin;
+  for (auto step = range / 64; step < range / 4; step *= 4) {
+    if (const auto lo = xstart - step; lo > xmin) {
+      const auto flo = f(lo);
+      if (is_bracket(flo, fstart))
+        return find_zero_actual(xstart, fstart, lo, flo);
+    }
+
+    if (const auto hi = xstart + step; hi < xmax) {
+      const auto fhi = f(hi);
+      if (is_bracket(fstart, fhi))
+        return find_zero_actual(xstart, fstart, hi, fhi);
+    }
+  }
+
+  return find_zero_whole_range();
 }
 
 inline double
-ZeroFinder::find_zero_actual([[maybe_unused]] const double xstart) noexcept
+ZeroFinder::find_zero_actual(double a, double fa,
+                             double b, double fb) noexcept
 {
-  double a, b, c; // Abscissae, descr. see above
-  double fa; // f(a)
-  double fb; // f(b)
-  double fc; // f(c)
+  // Abscissae, descr. see above
+  double c = a;
+  double fc = fa;
 
   bool b_best = true; // b is best and last called
 
-  c = a = xmin;  
-  fc = fa = f(a);  
-
-  b = xmax;  
-  fb = f(b);
-
   // Main iteration loop
   for (;;) {
     // Distance from the last but one to the last approximation
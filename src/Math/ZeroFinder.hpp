@@ -45,14 +45,15 @@ public:
 
   /**
    * Find closest value of x that produces f(x)=0
-   * Method used is a variant of a bisector search.
-   * To enforce search, set xstart outside range 
+   * Method used is a variant of a bisector search.  The root is
+   * first looked for in a narrow bracket around xstart, which makes
+   * the search cheap if xstart is the solution of a previous call.
+   * To enforce search of the whole range, set xstart outside range
    *
    * @param xstart Initial guess of x
    *
    * @return x value of best solution
    */
-  [[gnu::pure]]
   double find_zero(double xstart) noexcept;
 
   /**
@@ -64,14 +65,17 @@ public:
    *
    * @return x value of best solution
    */
-  [[gnu::pure]]
   double find_min(double xstart) noexcept;
 
 private:
-  [[gnu::pure]]
-  double find_zero_actual(double xstart) noexcept;
+  double find_zero_whole_range() noexcept;
+
+  /**
+   * Search a root in the range confined by a and b.  b must be the
+   * last x value passed to f().
+   */
+  double find_zero_actual(double a, double fa, double b, double fb) noexcept;
 
-  [[gnu::pure]]
   double find_min_actual(double xstart) noexcept;
 
   /**
@@ -94,7 +98,6 @@ private:
    *
    * @return true if no search required (xstart is good)
    */
-  [[gnu::pure]]
   bool solution_within_tolerance(double xstart, double tol_act) noexcept;
 
 };
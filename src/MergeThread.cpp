@@ -4,6 +4,7 @@
 #include "MergeThread.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Protection.hpp"
+#include "Profiler.hpp"
 #include "Components.hpp"
 #include "NMEA/MoreData.hpp"
 #include "Audio/VarioGlue.hpp"
@@ -50,10 +51,12 @@ MergeThread::Process()
 void
 MergeThread::Tick() noexcept
 {
+  const Profiler::ScopeTick profiler_tick{Profiler::Thread::MERGE};
+
   bool gps_updated, calculated_updated;
 
 #ifdef HAVE_PCM_PLAYER
-  bool vario_available;
+  bool vario_available, vario_fast_path;
   double vario;
   bool task_bearing_diff_available;
   Angle task_bearing_diff;
@@ -85,6 +88,14 @@ MergeThread::Tick() noexcept
     vario_available = basic.brutto_vario_available;
     vario = vario_available ? basic.brutto_vario : 0;
 
+    /* the device which supplies the total energy vario value feeds
+       the audio vario directly after parsing each sentence; the
+       value obtained here would only be older */
+    const int vario_source = device_blackboard.GetTotalEnergyVarioSource();
+    vario_fast_path = vario_source >= 0;
+    if (devices != nullptr)
+      devices->SetVarioAudioSource(vario_source);
+
     const TaskStats &task_stats = calculated.task_stats;
     const GeoVector &vector_remaining = task_stats.current_leg.vector_remaining;
     if (calculated.flight.flying && task_stats.task_valid && vector_remaining.IsValid() && basic.track_available) {
@@ -112,9 +123,10 @@ MergeThread::Tick() noexcept
   } else {
     AudioTaskBearingGlue::NoValue();
   }
-  if (vario_available)
-    AudioVarioGlue::SetValue(vario);
-  else
+  if (vario_available) {
+    if (!vario_fast_path)
+      AudioVarioGlue::SetValue(vario);
+  } else
     AudioVarioGlue::NoValue();
 #endif
 
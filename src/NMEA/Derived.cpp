@@ -14,6 +14,7 @@ TerrainInfo::Clear()
   altitude_agl = 0;
 
   terrain_warning_location.SetInvalid();
+  glide_clearance.Clear();
 }
 
 void
@@ -50,6 +51,8 @@ DerivedInfo::Reset()
 
   wave.Clear();
 
+  traffic_proximity.Clear();
+
   estimated_wind_available.Clear();
   wind_available.Clear();
   wind_source = WindSource::NONE;
@@ -97,6 +100,7 @@ DerivedInfo::Expire(TimeStamp Time) noexcept
   auto_mac_cready_available.Expire(Time, std::chrono::hours(1));
   sun_data_available.Expire(Time, std::chrono::hours(1));
   fuel_burn_time_remain_available.Expire(Time, std::chrono::seconds(3));
+  traffic_proximity.available.Expire(Time, std::chrono::seconds(10));
 }
 
 
@@ -23,7 +23,9 @@
 #include "Engine/GlideSolvers/GlidePolar.hpp"
 #include "Atmosphere/Pressure.hpp"
 #include "Engine/Route/Route.hpp"
+#include "Engine/Route/GlideClearance.hpp"
 #include "Computer/WaveResult.hpp"
+#include "Computer/TrafficProximity.hpp"
 
 #include <type_traits>
 
@@ -55,6 +57,13 @@ struct TerrainInfo
    */
   GeoPoint terrain_warning_location;
 
+  /**
+   * The clearance of the glide path to the current task point
+   * above the terrain.  It is updated together with
+   * #terrain_warning_location.
+   */
+  GlideClearanceProfile glide_clearance;
+
   void Clear();
 
   /**
@@ -144,6 +153,11 @@ struct DerivedInfo:
 
   WaveResult wave;
 
+  /**
+   * Radar traffic closing in on the aircraft.
+   */
+  TrafficProximityInfo traffic_proximity;
+
   /** Does #estimated_wind have a meaningful value? */
   Validity estimated_wind_available;
 
@@ -156,10 +156,6 @@ NMEAInfo::Reset() noexcept
   flarm.Clear();
 
   engine.Reset();
-
-#ifdef ANDROID
-  glink_data.Clear();
-#endif
 }
 
 void
@@ -181,10 +177,6 @@ NMEAInfo::ExpireWallClock() noexcept
     time_available.Clear();
     gps.Reset();
     flarm.Clear();
-
-#ifdef ANDROID
-    glink_data.Clear();
-#endif
   } else {
     time_available.Expire(clock, std::chrono::seconds(10));
   }
@@ -225,9 +217,6 @@ NMEAInfo::Expire() noexcept
   battery_level_available.Expire(clock, std::chrono::minutes(5));
   flarm.Expire(clock);
   engine.Expire(clock);
-#ifdef ANDROID
-  glink_data.Expire(clock);
-#endif
   attitude.Expire(clock);
 }
 
@@ -345,8 +334,4 @@ NMEAInfo::Complement(const NMEAInfo &add) noexcept
   flarm.Complement(add.flarm);
 
   engine.Complement(add.engine);
-
-#ifdef ANDROID
-  glink_data.Complement(add.glink_data);
-#endif
 }
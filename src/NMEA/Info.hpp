@@ -19,10 +19,6 @@
 #include "FLARM/Data.hpp"
 #include "Geo/SpeedVector.hpp"
 
-#ifdef ANDROID
-#include "GliderLink/GliderLinkData.hpp"
-#endif
-
 #include <optional>
 #include <type_traits>
 
@@ -340,10 +336,6 @@ struct NMEAInfo {
 
   FlarmData flarm;
 
-#ifdef ANDROID
-  GliderLinkData glink_data;
-#endif
-
   void UpdateClock() noexcept;
 
   /**
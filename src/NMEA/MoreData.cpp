@@ -3,6 +3,9 @@
 
 #include "NMEA/MoreData.hpp"
 
+#include <cstddef>
+#include <cstring>
+
 void
 MoreData::Reset() noexcept
 {
@@ -20,3 +23,24 @@ MoreData::Reset() noexcept
 
   NMEAInfo::Reset();
 }
+
+void
+MoreData::CopyFrom(const MoreData &src) noexcept
+{
+  if (&src == this)
+    return;
+
+  /* this is a trivial type, so everything except the FLARM data can
+     be copied byte-wise */
+  const auto *s = reinterpret_cast<const std::byte *>(&src);
+  auto *d = reinterpret_cast<std::byte *>(this);
+
+  const std::size_t flarm_begin =
+    reinterpret_cast<const std::byte *>(&src.flarm) - s;
+  const std::size_t flarm_end = flarm_begin + sizeof(flarm);
+
+  std::memcpy(d, s, flarm_begin);
+  std::memcpy(d + flarm_end, s + flarm_end, sizeof(MoreData) - flarm_end);
+
+  flarm.CopyFrom(src.flarm);
+}
@@ -38,6 +38,12 @@ struct MoreData : public NMEAInfo {
 
   void Reset() noexcept;
 
+  /**
+   * Like the assignment operator, but copies only the used part of
+   * the FLARM traffic lists, which make up most of this object.
+   */
+  void CopyFrom(const MoreData &src) noexcept;
+
   constexpr bool NavAltitudeAvailable() const noexcept {
     return baro_altitude_available || gps_altitude_available;
   }
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ParallelOperationEnvironment.hpp"
+
+#include <algorithm>
+#include <thread>
+
+ParallelOperationEnvironment::ParallelOperationEnvironment(OperationEnvironment &_other,
+                                                           unsigned n_slots) noexcept
+  :other(_other)
+{
+  slots.reserve(n_slots);
+  for (unsigned i = 0; i < n_slots; ++i)
+    slots.push_back(std::make_unique<Slot>(*this));
+
+  other.SetProgressRange(n_slots * SLOT_RANGE);
+  other.SetProgressPosition(0);
+}
+
+void
+ParallelOperationEnvironment::Post(StaticString<256> &dest,
+                                   const TCHAR *value) noexcept
+{
+  {
+    const std::lock_guard lock{mutex};
+    dest = value;
+  }
+
+  Update();
+}
+
+void
+ParallelOperationEnvironment::Flush() noexcept
+{
+  StaticString<256> new_error, new_text;
+
+  {
+    const std::lock_guard lock{mutex};
+    new_error = error;
+    error.clear();
+    new_text = text;
+    text.clear();
+  }
+
+  if (!new_error.empty())
+    other.SetErrorMessage(new_error);
+
+  if (!new_text.empty())
+    other.SetText(new_text);
+
+  unsigned position = 0;
+  for (const auto &slot : slots)
+    position += slot->GetProgress();
+
+  if (position != last_position) {
+    last_position = position;
+    other.SetProgressPosition(position);
+  }
+}
+
+unsigned
+ParallelOperationEnvironment::Slot::GetProgress() const noexcept
+{
+  const unsigned r = range.load(std::memory_order_relaxed);
+  if (r == 0)
+    return 0;
+
+  const unsigned p = std::min(position.load(std::memory_order_relaxed), r);
+  return uint64_t(p) * SLOT_RANGE / r;
+}
+
+bool
+ParallelOperationEnvironment::Slot::IsCancelled() const noexcept
+{
+  return false;
+}
+
+void
+ParallelOperationEnvironment::Slot::SetCancelHandler(std::function<void()>) noexcept
+{
+  /* this class doesn't support cancellation, so this is a no-op */
+}
+
+void
+ParallelOperationEnvironment::Slot::Sleep(std::chrono::steady_clock::duration duration) noexcept
+{
+  std::this_thread::sleep_for(duration);
+}
+
+void
+ParallelOperationEnvironment::Slot::SetErrorMessage(const TCHAR *text) noexcept
+{
+  parent.Post(parent.error, text);
+}
+
+void
+ParallelOperationEnvironment::Slot::SetText(const TCHAR *text) noexcept
+{
+  parent.Post(parent.text, text);
+}
+
+void
+ParallelOperationEnvironment::Slot::SetProgressRange(unsigned _range) noexcept
+{
+  range.store(_range, std::memory_order_relaxed);
+  parent.Update();
+}
+
+void
+ParallelOperationEnvironment::Slot::SetProgressPosition(unsigned _position) noexcept
+{
+  position.store(_position, std::memory_order_relaxed);
+  parent.Update();
+}
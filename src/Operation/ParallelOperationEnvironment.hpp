@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Operation.hpp"
+#include "thread/Id.hxx"
+#include "thread/Mutex.hxx"
+#include "util/StaticString.hxx"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * Combines the progress of several jobs which run in parallel (e.g. on
+ * a #ThreadPool) into one progress bar.  Each job reports to its own
+ * #Slot, which may be used from any thread.  The combined state is
+ * passed to the underlying #OperationEnvironment only in the thread
+ * which has constructed this object, i.e. when that thread runs one of
+ * the jobs itself, and in Flush().
+ *
+ * The jobs cannot be cancelled.
+ */
+class ParallelOperationEnvironment {
+public:
+  class Slot final : public OperationEnvironment {
+    ParallelOperationEnvironment &parent;
+
+    std::atomic<unsigned> range{0}, position{0};
+
+  public:
+    explicit Slot(ParallelOperationEnvironment &_parent) noexcept
+      :parent(_parent) {}
+
+    /**
+     * The progress of this job in units of #SLOT_RANGE.
+     */
+    [[gnu::pure]]
+    unsigned GetProgress() const noexcept;
+
+    /* virtual methods from class OperationEnvironment */
+    bool IsCancelled() const noexcept override;
+    void SetCancelHandler(std::function<void()> handler) noexcept override;
+    void Sleep(std::chrono::steady_clock::duration duration) noexcept override;
+    void SetErrorMessage(const TCHAR *text) noexcept override;
+    void SetText(const TCHAR *text) noexcept override;
+    void SetProgressRange(unsigned range) noexcept override;
+    void SetProgressPosition(unsigned position) noexcept override;
+  };
+
+  static constexpr unsigned SLOT_RANGE = 1024;
+
+private:
+  OperationEnvironment &other;
+
+  const ThreadId thread = ThreadId::GetCurrent();
+
+  std::vector<std::unique_ptr<Slot>> slots;
+
+  /**
+   * Protects #error and #text.
+   */
+  Mutex mutex;
+
+  /**
+   * The most recent message which has not yet been passed to
+   * #other.
+   */
+  StaticString<256> error{_T("")}, text{_T("")};
+
+  unsigned last_position = 0;
+
+public:
+  ParallelOperationEnvironment(OperationEnvironment &_other,
+                               unsigned n_slots) noexcept;
+
+  ParallelOperationEnvironment(const ParallelOperationEnvironment &) = delete;
+  ParallelOperationEnvironment &operator=(const ParallelOperationEnvironment &) = delete;
+
+  Slot &operator[](unsigned i) noexcept {
+    return *slots[i];
+  }
+
+  /**
+   * Pass the combined state to the underlying #OperationEnvironment.
+   * May only be called in the thread which has constructed this
+   * object.
+   */
+  void Flush() noexcept;
+
+private:
+  void Post(StaticString<256> &dest, const TCHAR *value) noexcept;
+
+  void Update() noexcept {
+    if (thread.IsInside())
+      Flush();
+  }
+};
@@ -50,6 +50,7 @@ Profile::Load(const ProfileMap &map, LoggerSettings &settings)
 {
   map.Get(ProfileKeys::LoggerTimeStepCruise, settings.time_step_cruise);
   map.Get(ProfileKeys::LoggerTimeStepCircling, settings.time_step_circling);
+  map.Get(ProfileKeys::LoggerPreTakeoffDuration, settings.pre_takeoff_duration);
 
   if (!map.GetEnum(ProfileKeys::AutoLogger, settings.auto_logger)) {
     // Legacy
@@ -66,6 +67,7 @@ Profile::Load(const ProfileMap &map, LoggerSettings &settings)
   map.Get(ProfileKeys::CrewWeightTemplate, settings.crew_mass_template);
   map.Get(ProfileKeys::EnableFlightLogger, settings.enable_flight_logger);
   map.Get(ProfileKeys::EnableNMEALogger, settings.enable_nmea_logger);
+  map.Get(ProfileKeys::CompressNMEALog, settings.compress_nmea_log);
 }
 
 void
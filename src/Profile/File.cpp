@@ -4,7 +4,7 @@
 #include "File.hpp"
 #include "Map.hpp"
 #include "io/KeyValueFileReader.hpp"
-#include "io/FileLineReader.hpp"
+#include "io/MappedLineReader.hpp"
 #include "io/FileOutputStream.hxx"
 #include "io/BufferedOutputStream.hxx"
 #include "io/KeyValueFileWriter.hpp"
@@ -14,7 +14,7 @@
 void
 Profile::LoadFile(ProfileMap &map, Path path)
 {
-  FileLineReaderA reader(path);
+  MappedLineReaderA reader(path);
   KeyValueFileReader kvreader(reader);
   KeyValuePair pair;
   while (kvreader.Read(pair))
@@ -31,10 +31,18 @@ namespace Profile {
     map.Get(ProfileKeys::JETProviderRadarInterval, settings.interval);
     map.Get(ProfileKeys::JETProviderRadarAccessToken, settings.access_token);
   }
+
+  static void Load(const ProfileMap &map, JETProviderSettings::Proximity &settings) {
+    map.Get(ProfileKeys::JETProviderProximityEnabled, settings.enabled);
+    map.Get(ProfileKeys::JETProviderProximityRange, settings.range);
+    map.Get(ProfileKeys::JETProviderProximityHeight, settings.height);
+    map.Get(ProfileKeys::JETProviderProximityCone, settings.cone);
+  }
 }
 
 void
 Profile::Load(const ProfileMap &map, JETProviderSettings &settings)
 {
   Load(map, settings.radar);
+  Load(map, settings.proximity);
 }
@@ -39,6 +39,7 @@ constexpr std::string_view DrawTerrain = "DrawTerrain";
 constexpr std::string_view SlopeShading = "SlopeShading";
 constexpr std::string_view SlopeShadingType = "SlopeShadingType";
 constexpr std::string_view TerrainContours = "TerrainContours";
+constexpr std::string_view TerrainWarmStart = "TerrainWarmStart";
 constexpr std::string_view DrawTopography = "DrawTopology";
 constexpr std::string_view FinalGlideTerrain = "FinalGlideTerrain";
 constexpr std::string_view AutoWind = "AutoWind";
@@ -128,6 +129,8 @@ constexpr std::string_view AppInfoBoxBorder = "AppInfoBoxBorder";
 constexpr std::string_view ShowMenuButton = "ShowMenuButton";
 constexpr std::string_view CursorSize = "CursorSize";
 constexpr std::string_view CursorColorsInverted = "CursorColorsInverted";
+constexpr std::string_view MapFrameRate = "MapFrameRate";
+constexpr std::string_view MapStaticScene = "MapStaticScene";
 
 constexpr std::string_view AppAveNeedle = "AppAveNeedle";
 constexpr std::string_view AppAveThermalNeedle = "AppAveThermalNeedle";
@@ -174,6 +177,7 @@ constexpr std::string_view EnableNavBaroAltitude = "EnableNavBaroAltitude";
 
 constexpr std::string_view LoggerTimeStepCruise = "LoggerTimeStepCruise";
 constexpr std::string_view LoggerTimeStepCircling = "LoggerTimeStepCircling";
+constexpr std::string_view LoggerPreTakeoffDuration = "LoggerPreTakeoffDuration";
 
 constexpr std::string_view SafetyMacCready = "SafetyMacCready";
 constexpr std::string_view AbortTaskMode = "AbortTaskMode";
@@ -200,6 +204,7 @@ constexpr std::string_view AutoLogger = "AutoLogger";
 constexpr std::string_view DisableAutoLogger = "DisableAutoLogger";
 constexpr std::string_view EnableFlightLogger = "EnableFlightLogger";
 constexpr std::string_view EnableNMEALogger = "EnableNMEALogger";
+constexpr std::string_view CompressNMEALog = "CompressNMEALog";
 constexpr std::string_view MapFile = "MapFile"; // pL
 constexpr std::string_view BallastSecsToEmpty = "BallastSecsToEmpty";
 constexpr std::string_view DialogFont = "DialogFont";
@@ -234,6 +239,7 @@ constexpr std::string_view RoutePlannerAllowClimb = "RoutePlannerAllowClimb";
 constexpr std::string_view RoutePlannerUseCeiling = "RoutePlannerUseCeiling";
 constexpr std::string_view TurningReach = "TurningReach";
 constexpr std::string_view ReachPolarMode = "ReachPolarMode";
+constexpr std::string_view ReachAirspace = "ReachAirspace";
 
 constexpr std::string_view AircraftSymbol = "AircraftSymbol";
 
@@ -242,6 +248,7 @@ constexpr std::string_view FlarmLocation = "FlarmLocation";
 constexpr std::string_view SkyLinesTrackingEnabled = "SkyLinesTrackingEnabled";
 constexpr std::string_view SkyLinesRoaming = "SkyLinesRoaming";
 constexpr std::string_view SkyLinesTrackingInterval = "SkyLinesTrackingInterval";
+constexpr std::string_view SkyLinesBatchDelay = "SkyLinesBatchDelay";
 constexpr std::string_view SkyLinesTrafficEnabled = "SkyLinesTrafficEnabled";
 constexpr std::string_view SkyLinesNearTrafficEnabled = "SkyLinesNearTrafficEnabled";
 constexpr std::string_view SkyLinesTrafficMapMode = "SkyLinesTrafficMapMode";
@@ -262,6 +269,10 @@ constexpr std::string_view LiveTrack24TrackingVehicleName = "TrackingVehicleName
 constexpr std::string_view JETProviderRadarEnabled = "JETProviderRadarEnabled";
 constexpr std::string_view JETProviderRadarInterval = "JETProviderRadarInterval";
 constexpr std::string_view JETProviderRadarAccessToken = "JETProviderRadarAccessToken";
+constexpr std::string_view JETProviderProximityEnabled = "JETProviderProximityEnabled";
+constexpr std::string_view JETProviderProximityRange = "JETProviderProximityRange";
+constexpr std::string_view JETProviderProximityHeight = "JETProviderProximityHeight";
+constexpr std::string_view JETProviderProximityCone = "JETProviderProximityCone";
 
 constexpr std::string_view PCMetUsername = "PCMetUsername";
 constexpr std::string_view PCMetPassword = "PCMetPassword";
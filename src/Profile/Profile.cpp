@@ -5,6 +5,7 @@
 #include "Map.hpp"
 #include "File.hpp"
 #include "Current.hpp"
+#include "SaveThread.hpp"
 #include "LogFile.hpp"
 #include "Asset.hpp"
 #include "LocalPath.hpp"
@@ -23,6 +24,8 @@
 
 static AllocatedPath startProfileFile = nullptr;
 
+static ProfileSaveThread save_thread;
+
 Path
 Profile::GetPath() noexcept
 {
@@ -53,7 +56,8 @@ Profile::LoadFile(Path path) noexcept
 void
 Profile::Save() noexcept
 {
-  if (!IsModified())
+  /* retry if the previous write has failed */
+  if (!IsModified() && !save_thread.CheckFailed())
     return;
 
   LogString("Saving profiles");
@@ -62,16 +66,22 @@ Profile::Save() noexcept
 
   assert(startProfileFile != nullptr);
 
-  try {
-    SaveFile(startProfileFile);
-  } catch (...) {
-    LogError(std::current_exception(), "Failed to save profile");
-  }
+  save_thread.Schedule(map, startProfileFile);
+  SetModified(false);
+}
+
+void
+Profile::Flush() noexcept
+{
+  save_thread.Stop();
 }
 
 void
 Profile::SaveFile(Path path)
 {
+  /* don't let a pending background save overwrite this file */
+  save_thread.Flush();
+
   LogFormat(_T("Saving profile to %s"), path.c_str());
   SaveFile(map, path);
 }
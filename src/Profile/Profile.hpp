@@ -35,13 +35,22 @@ void
 LoadFile(Path path) noexcept;
 
 /**
- * Saves the profile into the profile files
+ * Saves the profile into the profile files if it has been modified.
+ * The file is written by a background thread after a short delay,
+ * so several calls in a row result in only one write.
  *
- * Errors will be caught and logged.
+ * Errors will be caught and logged; the next call retries.
  */
 void
 Save() noexcept;
 
+/**
+ * Finish the pending Save() now, and wait for it.  Call this before
+ * exiting, or before accessing the profile files directly.
+ */
+void
+Flush() noexcept;
+
 /**
  * Saves the profile into the given profile file
  */
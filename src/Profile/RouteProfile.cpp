@@ -15,4 +15,5 @@ Profile::Load(const ProfileMap &map, RoutePlannerConfig &settings)
   map.Get(ProfileKeys::RoutePlannerUseCeiling, settings.use_ceiling);
   map.GetEnum(ProfileKeys::TurningReach, settings.reach_calc_mode);
   map.GetEnum(ProfileKeys::ReachPolarMode, settings.reach_polar_mode);
+  map.Get(ProfileKeys::ReachAirspace, settings.reach_airspace);
 }
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "SaveThread.hpp"
+#include "File.hpp"
+#include "LogFile.hpp"
+
+bool
+ProfileSaveThread::Write(const ProfileMap &map, Path path) noexcept
+try {
+  Profile::SaveFile(map, path);
+  return true;
+} catch (...) {
+  LogError(std::current_exception(), "Failed to save profile");
+  return false;
+}
+
+void
+ProfileSaveThread::Schedule(const ProfileMap &map, Path path) noexcept
+{
+  std::unique_lock lock{mutex};
+
+  if (pending && pending_path != path) {
+    /* the profile file has been switched: write the old snapshot to
+       the old file now */
+    due = Clock::now();
+    cond.notify_all();
+    cond.wait(lock, [this]{ return !pending; });
+  }
+
+  if (!IsDefined()) {
+    try {
+      Start();
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to start profile thread");
+      lock.unlock();
+      if (!Write(map, path)) {
+        const std::lock_guard lock2{mutex};
+        failed = true;
+      }
+
+      return;
+    }
+  }
+
+  pending_map = map;
+  pending_path = path;
+  due = Clock::now() + delay;
+  pending = true;
+  cond.notify_all();
+}
+
+void
+ProfileSaveThread::Flush() noexcept
+{
+  std::unique_lock lock{mutex};
+  if (!pending && !busy)
+    return;
+
+  due = Clock::now();
+  cond.notify_all();
+  cond.wait(lock, [this]{ return !pending && !busy; });
+}
+
+void
+ProfileSaveThread::Stop() noexcept
+{
+  {
+    const std::lock_guard lock{mutex};
+    if (!IsDefined())
+      return;
+
+    stop = true;
+    cond.notify_all();
+  }
+
+  Join();
+
+  const std::lock_guard lock{mutex};
+  stop = false;
+}
+
+bool
+ProfileSaveThread::CheckFailed() noexcept
+{
+  const std::lock_guard lock{mutex};
+  const bool result = failed;
+  failed = false;
+  return result;
+}
+
+void
+ProfileSaveThread::Run() noexcept
+{
+  std::unique_lock lock{mutex};
+
+  while (true) {
+    if (pending) {
+      const auto now = Clock::now();
+      if (now < due && !stop) {
+        cond.wait_for(lock, due - now);
+        continue;
+      }
+
+      const ProfileMap map = std::move(pending_map);
+      const AllocatedPath path = std::move(pending_path);
+      pending_map.Clear();
+      pending = false;
+      busy = true;
+
+      lock.unlock();
+      const bool success = Write(map, path);
+      lock.lock();
+
+      busy = false;
+      if (!success)
+        failed = true;
+
+      cond.notify_all();
+    } else if (stop)
+      break;
+    else
+      cond.wait(lock);
+  }
+}
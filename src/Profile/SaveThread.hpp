@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Map.hpp"
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+#include "system/Path.hpp"
+
+#include <chrono>
+
+/**
+ * Writes profile snapshots to a file in a background thread, so a
+ * slow storage device does not block the caller.  Saves are
+ * debounced: a snapshot is written once no newer one has been
+ * scheduled for the configured delay.  The file is replaced
+ * atomically by Profile::SaveFile().
+ *
+ * The thread is launched on demand.  All public methods are
+ * thread-safe.
+ */
+class ProfileSaveThread final : Thread {
+  using Clock = std::chrono::steady_clock;
+
+  const Clock::duration delay;
+
+  Mutex mutex;
+  Cond cond;
+
+  /**
+   * The snapshot to be written; only valid if #pending is set.
+   */
+  ProfileMap pending_map;
+  AllocatedPath pending_path = nullptr;
+
+  /**
+   * When shall #pending_map be written?
+   */
+  Clock::time_point due;
+
+  bool pending = false;
+
+  /**
+   * Is the thread currently writing a snapshot?
+   */
+  bool busy = false;
+
+  bool stop = false;
+
+  /**
+   * Has the last write failed?  Cleared by CheckFailed().
+   */
+  bool failed = false;
+
+public:
+  static constexpr Clock::duration DEFAULT_DELAY = std::chrono::seconds(2);
+
+  explicit ProfileSaveThread(Clock::duration _delay=DEFAULT_DELAY) noexcept
+    :Thread("ProfileSave"), delay(_delay) {}
+
+  ~ProfileSaveThread() noexcept {
+    Stop();
+  }
+
+  /**
+   * Schedule writing a copy of the given map to the given file,
+   * replacing any snapshot that has not been written yet.  If the
+   * thread cannot be launched, the file is written right away.
+   */
+  void Schedule(const ProfileMap &map, Path path) noexcept;
+
+  /**
+   * Write the pending snapshot (if any) now and wait until it is
+   * done.
+   */
+  void Flush() noexcept;
+
+  /**
+   * Flush() and stop the thread.  It will be launched again by the
+   * next Schedule() call.
+   */
+  void Stop() noexcept;
+
+  /**
+   * Has a write failed since the last call?
+   */
+  bool CheckFailed() noexcept;
+
+private:
+  /**
+   * Write a snapshot, logging errors.
+   *
+   * @return true on success
+   */
+  static bool Write(const ProfileMap &map, Path path) noexcept;
+
+  /* virtual methods from class Thread */
+  void Run() noexcept override;
+};
@@ -29,6 +29,7 @@ static void Load(const ProfileMap &map,
   map.Get(ProfileKeys::SkyLinesTrackingEnabled, settings.enabled);
   map.Get(ProfileKeys::SkyLinesRoaming, settings.roaming);
   map.Get(ProfileKeys::SkyLinesTrackingInterval, settings.interval);
+  map.Get(ProfileKeys::SkyLinesBatchDelay, settings.batch_delay);
   map.Get(ProfileKeys::SkyLinesTrafficEnabled, settings.traffic_enabled);
   map.Get(ProfileKeys::SkyLinesNearTrafficEnabled, settings.near_traffic_enabled);
 
@@ -28,6 +28,8 @@ Profile::Load(const ProfileMap &map, DisplaySettings &settings)
   map.Get(ProfileKeys::CursorSize, settings.cursor_size);
   map.Get(ProfileKeys::CursorColorsInverted, settings.invert_cursor_colors);
   map.Get(ProfileKeys::FullScreen, settings.full_screen);
+  map.Get(ProfileKeys::MapFrameRate, settings.map_frame_rate);
+  map.Get(ProfileKeys::MapStaticScene, settings.map_static_scene);
 }
 
 void
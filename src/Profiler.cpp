@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Profiler.hpp"
+#include "LogFile.hpp"
+#include "thread/Mutex.hxx"
+#include "util/StringAPI.hxx"
+
+#include <algorithm>
+#include <array>
+
+namespace Profiler {
+
+std::atomic_bool enabled{false};
+
+/**
+ * The weight of a new sample in the layer averages.
+ */
+static constexpr double LAYER_SMOOTHING = 1. / 16;
+
+struct Statistics {
+  /**
+   * A ring buffer of the most recent frame durations [ms].
+   */
+  std::array<float, MAX_FRAMES> frames;
+
+  /**
+   * The total number of frames; the position in #frames is this
+   * modulo #MAX_FRAMES.
+   */
+  unsigned n_frames;
+
+  unsigned skipped_frames;
+
+  StaticArray<Report::Layer, MAX_LAYERS> layers;
+
+  struct Tick {
+    unsigned count;
+    double total, max;
+  } ticks[N_THREADS];
+
+  void Clear() noexcept {
+    n_frames = skipped_frames = 0;
+    layers.clear();
+    for (auto &i : ticks)
+      i = {};
+  }
+};
+
+static Mutex mutex;
+static Statistics statistics;
+
+static constexpr double
+ToMilliseconds(Duration duration) noexcept
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void
+SetEnabled(bool value) noexcept
+{
+  if (value && !IsEnabled()) {
+    const std::lock_guard lock{mutex};
+    statistics.Clear();
+  }
+
+  enabled.store(value, std::memory_order_relaxed);
+}
+
+void
+AddLayer(const char *name, Duration duration) noexcept
+{
+  const double ms = ToMilliseconds(duration);
+
+  const std::lock_guard lock{mutex};
+
+  auto i = std::find_if(statistics.layers.begin(), statistics.layers.end(),
+                        [name](const Report::Layer &layer){
+                          return StringIsEqual(layer.name, name);
+                        });
+  if (i != statistics.layers.end())
+    i->average += (ms - i->average) * LAYER_SMOOTHING;
+  else if (!statistics.layers.full())
+    statistics.layers.push_back({name, ms});
+}
+
+void
+AddFrame(Duration duration) noexcept
+{
+  const std::lock_guard lock{mutex};
+  statistics.frames[statistics.n_frames++ % MAX_FRAMES] =
+    ToMilliseconds(duration);
+}
+
+void
+AddSkippedFrame() noexcept
+{
+  if (!IsEnabled())
+    return;
+
+  const std::lock_guard lock{mutex};
+  ++statistics.skipped_frames;
+}
+
+void
+AddTick(Thread thread, Duration duration) noexcept
+{
+  const double ms = ToMilliseconds(duration);
+
+  const std::lock_guard lock{mutex};
+  auto &tick = statistics.ticks[unsigned(thread)];
+  ++tick.count;
+  tick.total += ms;
+  tick.max = std::max(tick.max, ms);
+}
+
+/**
+ * @param sorted the sorted samples (not empty)
+ * @param p the percentile (0..100)
+ */
+[[gnu::pure]]
+static double
+GetPercentile(const float *sorted, unsigned n, unsigned p) noexcept
+{
+  return sorted[std::min(n * p / 100, n - 1)];
+}
+
+Report
+GetReport() noexcept
+{
+  Report report;
+  std::array<float, MAX_FRAMES> frames;
+  unsigned n;
+
+  {
+    const std::lock_guard lock{mutex};
+
+    report.n_frames = statistics.n_frames;
+    report.skipped_frames = statistics.skipped_frames;
+    report.layers = statistics.layers;
+
+    for (unsigned i = 0; i < N_THREADS; ++i) {
+      const auto &src = statistics.ticks[i];
+      auto &dest = report.ticks[i];
+      dest.count = src.count;
+      dest.average = src.count > 0 ? src.total / src.count : 0;
+      dest.max = src.max;
+    }
+
+    n = std::min(statistics.n_frames, MAX_FRAMES);
+    std::copy_n(statistics.frames.begin(), n, frames.begin());
+  }
+
+  if (n > 0) {
+    std::sort(frames.begin(), frames.begin() + n);
+    report.frame_p50 = GetPercentile(frames.data(), n, 50);
+    report.frame_p90 = GetPercentile(frames.data(), n, 90);
+    report.frame_p99 = GetPercentile(frames.data(), n, 99);
+  } else
+    report.frame_p50 = report.frame_p90 = report.frame_p99 = 0;
+
+  return report;
+}
+
+void
+Log() noexcept
+{
+  const Report report = GetReport();
+
+  LogFormat("Profiler: %u frames, %u skipped, p50=%.1fms p90=%.1fms p99=%.1fms",
+            report.n_frames, report.skipped_frames,
+            report.frame_p50, report.frame_p90, report.frame_p99);
+
+  for (const auto &layer : report.layers)
+    LogFormat("Profiler layer '%s': %.2fms", layer.name, layer.average);
+
+  static constexpr const char *thread_names[N_THREADS] = {
+    "CalculationThread",
+    "MergeThread",
+  };
+
+  for (unsigned i = 0; i < N_THREADS; ++i)
+    LogFormat("Profiler %s: %u ticks, average=%.2fms max=%.2fms",
+              thread_names[i], report.ticks[i].count,
+              report.ticks[i].average, report.ticks[i].max);
+}
+
+} // namespace Profiler
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "util/StaticArray.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Collects timing statistics of the DrawThread (per layer, see
+ * #ScreenStopWatch), the CalculationThread and the MergeThread.  It
+ * is switched on at runtime (see InputEvents::eventProfiler()) and
+ * costs next to nothing while off, so it is available in release
+ * builds.  The statistics are shown on the map and may be written to
+ * the log file.
+ */
+namespace Profiler {
+
+using Clock = std::chrono::steady_clock;
+using Duration = Clock::duration;
+
+enum class Thread : uint8_t {
+  CALCULATION,
+  MERGE,
+};
+
+static constexpr unsigned N_THREADS = 2;
+
+/**
+ * The number of frames whose duration is kept for the percentiles.
+ */
+static constexpr unsigned MAX_FRAMES = 128;
+
+static constexpr unsigned MAX_LAYERS = 32;
+
+extern std::atomic_bool enabled;
+
+static inline bool
+IsEnabled() noexcept
+{
+  return enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Switch the profiler on or off.  Switching it on clears all
+ * statistics.
+ */
+void
+SetEnabled(bool value) noexcept;
+
+/**
+ * Submit the duration of one layer of the current frame.
+ *
+ * @param name a string literal
+ */
+void
+AddLayer(const char *name, Duration duration) noexcept;
+
+void
+AddFrame(Duration duration) noexcept;
+
+/**
+ * A redraw was requested while the previous one was still pending,
+ * i.e. a frame was dropped.
+ */
+void
+AddSkippedFrame() noexcept;
+
+void
+AddTick(Thread thread, Duration duration) noexcept;
+
+/**
+ * Measures the duration of its scope as one tick of the given
+ * thread, if the profiler is enabled.
+ */
+class ScopeTick {
+  const Thread thread;
+  const bool active;
+  Clock::time_point start;
+
+public:
+  explicit ScopeTick(Thread _thread) noexcept
+    :thread(_thread), active(IsEnabled())
+  {
+    if (active)
+      start = Clock::now();
+  }
+
+  ~ScopeTick() noexcept {
+    if (active)
+      AddTick(thread, Clock::now() - start);
+  }
+
+  ScopeTick(const ScopeTick &) = delete;
+  ScopeTick &operator=(const ScopeTick &) = delete;
+};
+
+/**
+ * A snapshot of the statistics; all durations are in milliseconds.
+ */
+struct Report {
+  unsigned n_frames, skipped_frames;
+
+  double frame_p50, frame_p90, frame_p99;
+
+  struct Layer {
+    const char *name;
+
+    /**
+     * An exponential moving average.
+     */
+    double average;
+  };
+
+  /**
+   * In the order in which they were first submitted.
+   */
+  StaticArray<Layer, MAX_LAYERS> layers;
+
+  struct Tick {
+    unsigned count;
+    double average, max;
+  } ticks[N_THREADS];
+
+  const Tick &GetTick(Thread thread) const noexcept {
+    return ticks[unsigned(thread)];
+  }
+};
+
+[[gnu::pure]]
+Report
+GetReport() noexcept;
+
+/**
+ * Write the current statistics to the log file.
+ */
+void
+Log() noexcept;
+
+} // namespace Profiler
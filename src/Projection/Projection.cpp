@@ -38,19 +38,7 @@ Projection::ScreenToGeo(PixelPoint src) const noexcept
 PixelPoint
 Projection::GeoToScreen(const GeoPoint &g) const noexcept
 {
-  assert(IsValid());
-
-  const GeoPoint d = geo_location-g;
-
-  const auto p =
-    screen_rotation.Rotate(PixelPoint(int(g.latitude.fastcosine() *
-                                          AngleToPixels(d.longitude)),
-                                      (int)AngleToPixels(d.latitude)));
-
-  PixelPoint sc;
-  sc.x = screen_origin.x - p.x;
-  sc.y = screen_origin.y + p.y;
-  return sc;
+  return GetFastGeoToScreen()(g);
 }
 
 void
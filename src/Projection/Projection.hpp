@@ -8,7 +8,9 @@
 #include "Math/Util.hpp"
 #include "ui/dim/Point.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <span>
 
 /**
  * This is a class that can be used for converting geographical into screen
@@ -32,6 +34,8 @@
  * ScreenRotation: By calling SetScreenAngle() the rotation angle for the
  * conversions can be set.
  */
+class FastGeoToScreen;
+
 class Projection
 {
   /** This is the geographical location that the ScreenOrigin is mapped to */
@@ -119,6 +123,26 @@ public:
   [[gnu::pure]]
   PixelPoint GeoToScreen(const GeoPoint &g) const noexcept;
 
+  /**
+   * Converts many GeoPoints to screen coordinates.  This is faster
+   * than calling GeoToScreen() for each point, and the results are
+   * the same.
+   *
+   * @param dest the destination buffer; must be at least as large as
+   * #src
+   */
+  template<typename P, std::size_t E>
+  void GeoToScreen(std::span<const GeoPoint> src,
+                   std::span<P, E> dest) const noexcept;
+
+  /**
+   * Creates a #FastGeoToScreen object for the current settings.  Use
+   * it in loops over points which are not stored in a contiguous
+   * #GeoPoint array.
+   */
+  [[gnu::pure]]
+  FastGeoToScreen GetFastGeoToScreen() const noexcept;
+
   /**
    * Returns the origin/rotation center in screen coordinates
    * @return The origin/rotation center in screen coordinates
@@ -197,3 +221,65 @@ public:
     return FastRowRotation(screen_rotation, y);
   }
 };
+
+/**
+ * An inline implementation of Projection::GeoToScreen() with all
+ * parameters copied to the object, which allows the compiler to keep
+ * them in registers in a loop.  The object must not outlive changes
+ * to the #Projection it was created from.
+ */
+class FastGeoToScreen {
+  GeoPoint geo_location;
+  FastIntegerRotation rotation;
+  PixelPoint screen_origin;
+  double draw_scale;
+
+public:
+  constexpr FastGeoToScreen(const GeoPoint &_geo_location,
+                            FastIntegerRotation _rotation,
+                            PixelPoint _screen_origin,
+                            double _draw_scale) noexcept
+    :geo_location(_geo_location), rotation(_rotation),
+     screen_origin(_screen_origin), draw_scale(_draw_scale) {}
+
+  [[gnu::pure]]
+  PixelPoint operator()(const GeoPoint &g) const noexcept {
+    /* same as "(geo_location - g).Normalize()", but without the
+       out-of-line Angle::AsDelta() call in the common case */
+    Angle d_longitude = geo_location.longitude - g.longitude;
+    if (!(d_longitude > -Angle::HalfCircle() &&
+          d_longitude <= Angle::HalfCircle()))
+      d_longitude = d_longitude.AsDelta();
+
+    const Angle d_latitude =
+      std::clamp(geo_location.latitude - g.latitude,
+                 -Angle::QuarterCircle(), Angle::QuarterCircle());
+
+    const auto p =
+      rotation.Rotate(PixelPoint(int(g.latitude.fastcosine() *
+                                     (d_longitude.Radians() * draw_scale)),
+                                 int(d_latitude.Radians() * draw_scale)));
+
+    return {screen_origin.x - p.x, screen_origin.y + p.y};
+  }
+};
+
+inline FastGeoToScreen
+Projection::GetFastGeoToScreen() const noexcept
+{
+  assert(IsValid());
+
+  return {geo_location, screen_rotation, screen_origin, draw_scale};
+}
+
+template<typename P, std::size_t E>
+inline void
+Projection::GeoToScreen(std::span<const GeoPoint> src,
+                        std::span<P, E> dest) const noexcept
+{
+  assert(dest.size() >= src.size());
+
+  const auto f = GetFastGeoToScreen();
+  for (std::size_t i = 0; i < src.size(); ++i)
+    dest[i] = f(src[i]);
+}
@@ -90,6 +90,7 @@ CreateCalculationThread() noexcept
 
   /* copy GlideComputer results to DeviceBlackboard */
   device_blackboard->ReadBlackboard(glide_computer->Calculated());
+  device_blackboard->PublishCalculated(glide_computer->Calculated());
 
   calculation_thread = new CalculationThread(*glide_computer);
   calculation_thread->SetComputerSettings(CommonInterface::GetComputerSettings());
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#ifdef ENABLE_OPENGL
+
+#include "AirspaceMeshCache.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "ui/canvas/Color.hpp"
+#include "ui/canvas/Pen.hpp"
+#include "ui/canvas/opengl/VertexPointer.hpp"
+#include "ui/canvas/opengl/Triangulate.hpp"
+#include "ui/canvas/opengl/Geo.hpp"
+#include "ui/canvas/opengl/Program.hpp"
+#include "ui/canvas/opengl/Shaders.hpp"
+
+#include <glm/gtc/type_ptr.hpp>
+
+void
+AirspaceMeshCache::Mesh::Build(const AirspacePolygon &airspace) noexcept
+{
+  const auto &points = airspace.GetPoints();
+  assert(points.size() >= 3);
+
+  bounds = points.CalculateGeoBounds();
+  reference = bounds.GetCenter();
+
+  /* the border is closed; the closing point is implicit here */
+  n_vertices = points.size();
+  if (points.front().GetLocation() == points.back().GetLocation())
+    --n_vertices;
+
+  std::vector<FloatPoint2D> v;
+  v.reserve(n_vertices);
+  for (unsigned i = 0; i < n_vertices; ++i) {
+    const GeoPoint &p = points[i].GetLocation();
+    v.emplace_back((p.longitude - reference.longitude).AsDelta().Native(),
+                   (p.latitude - reference.latitude).AsDelta().Native());
+  }
+
+  vertices.Load(v.size() * sizeof(v.front()), v.data());
+
+  /* no thinning: the mesh is drawn at all map scales */
+  triangles.resize(3 * (n_vertices - 2));
+  triangles.resize(PolygonToTriangles(v.data(), n_vertices,
+                                      triangles.data(), 0));
+  triangles.shrink_to_fit();
+}
+
+inline void
+AirspaceMeshCache::Mesh::Bind(const WindowProjection &projection) const noexcept
+{
+  OpenGL::solid_shader->Use();
+
+  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                     glm::value_ptr(ToGLM(projection, reference)));
+
+  vertices.Bind();
+}
+
+inline void
+AirspaceMeshCache::Mesh::Unbind() const noexcept
+{
+  GLArrayBuffer::Unbind();
+
+  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                     glm::value_ptr(glm::mat4(1)));
+}
+
+void
+AirspaceMeshCache::Mesh::DrawFill(const WindowProjection &projection,
+                                  Color color) const noexcept
+{
+  if (triangles.empty())
+    return;
+
+  Bind(projection);
+  color.Bind();
+
+  {
+    const ScopeVertexPointer vp(GL_FLOAT, nullptr);
+    glDrawElements(GL_TRIANGLES, triangles.size(), GL_UNSIGNED_SHORT,
+                   triangles.data());
+  }
+
+  Unbind();
+}
+
+void
+AirspaceMeshCache::Mesh::DrawOutline(const WindowProjection &projection,
+                                     const Pen &pen) const noexcept
+{
+  assert(pen.GetWidth() <= 2);
+
+  Bind(projection);
+  pen.Bind();
+
+  {
+    const ScopeVertexPointer vp(GL_FLOAT, nullptr);
+    glDrawArrays(GL_LINE_LOOP, 0, n_vertices);
+  }
+
+  pen.Unbind();
+  Unbind();
+}
+
+void
+AirspaceMeshCache::Update(const Airspaces &_airspaces) noexcept
+{
+  if (&_airspaces == airspaces && _airspaces.GetSerial() == serial)
+    return;
+
+  /* the airspace objects may have been deleted: the stale keys must
+     not be used again */
+  meshes.clear();
+  airspaces = &_airspaces;
+  serial = _airspaces.GetSerial();
+}
+
+const AirspaceMeshCache::Mesh &
+AirspaceMeshCache::Get(const AirspacePolygon &airspace) noexcept
+{
+  auto [i, inserted] = meshes.try_emplace(&airspace);
+  if (inserted)
+    i->second.Build(airspace);
+
+  return i->second;
+}
+
+#endif /* ENABLE_OPENGL */
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "ui/canvas/opengl/Buffer.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "util/Serial.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+class Airspaces;
+class AbstractAirspace;
+class AirspacePolygon;
+class WindowProjection;
+class Color;
+class Pen;
+
+/**
+ * Caches the triangulated interior and the outline of airspace
+ * polygons in OpenGL buffers.  The vertices are stored relative to a
+ * reference point in geographic coordinates, so drawing them needs
+ * only a modelview matrix (see ToGLM()) instead of projecting,
+ * clipping and triangulating the polygon each frame.
+ *
+ * The cache is discarded when the #Airspaces object is modified.
+ */
+class AirspaceMeshCache {
+public:
+  class Mesh {
+    friend class AirspaceMeshCache;
+
+    GeoPoint reference;
+    GeoBounds bounds;
+
+    mutable GLArrayBuffer vertices;
+
+    /**
+     * The number of vertices, without the closing point.
+     */
+    unsigned n_vertices;
+
+    /**
+     * The triangle indices of the interior; empty if the
+     * triangulation has failed.
+     */
+    std::vector<GLushort> triangles;
+
+  public:
+    const GeoBounds &GetBounds() const noexcept {
+      return bounds;
+    }
+
+    /**
+     * Fill the interior with the specified color, using the current
+     * stencil and blend settings.
+     */
+    void DrawFill(const WindowProjection &projection,
+                  Color color) const noexcept;
+
+    /**
+     * Draw the outline; only suitable for pens up to 2 pixels wide.
+     */
+    void DrawOutline(const WindowProjection &projection,
+                     const Pen &pen) const noexcept;
+
+  private:
+    void Build(const AirspacePolygon &airspace) noexcept;
+
+    void Bind(const WindowProjection &projection) const noexcept;
+    void Unbind() const noexcept;
+  };
+
+private:
+  const Airspaces *airspaces = nullptr;
+  Serial serial;
+
+  std::unordered_map<const AbstractAirspace *, Mesh> meshes;
+
+public:
+  /**
+   * Discard all meshes if the specified #Airspaces object is not the
+   * one they were built from, or if it has been modified since.
+   */
+  void Update(const Airspaces &_airspaces) noexcept;
+
+  /**
+   * Return the mesh of the specified airspace, building it if
+   * necessary.
+   */
+  const Mesh &Get(const AirspacePolygon &airspace) noexcept;
+};
@@ -36,8 +36,9 @@ GetPolygonPoints(std::vector<BulkPixelPoint> &pts,
   const SearchPointVector &border = airspace.GetPoints();
 
   pts.reserve(border.size());
+  const auto f = projection.GetFastGeoToScreen();
   for (auto it = border.begin(), it_end = border.end(); it != it_end; ++it)
-    pts.push_back(projection.GeoToScreen(it->GetLocation()));
+    pts.push_back(f(it->GetLocation()));
 }
 
 bool
@@ -7,7 +7,9 @@
 #include "util/StaticArray.hxx"
 #include "Geo/GeoPoint.hpp"
 
-#ifndef ENABLE_OPENGL
+#ifdef ENABLE_OPENGL
+#include "AirspaceMeshCache.hpp"
+#else
 #include "TransparentRendererCache.hpp"
 #include "util/Serial.hpp"
 #endif
@@ -32,7 +34,12 @@ class AirspaceRenderer
 
   StaticArray<GeoPoint,32> intersections;
 
-#ifndef ENABLE_OPENGL
+#ifdef ENABLE_OPENGL
+  /**
+   * This object caches the triangulated airspace polygons.
+   */
+  AirspaceMeshCache mesh_cache;
+#else
   /**
    * This object caches the airspace fill.  This avoids drawing it
    * again and again each frame when nothing has changed.
@@ -5,6 +5,7 @@
 
 #include "AirspaceRenderer.hpp"
 #include "AirspaceRendererSettings.hpp"
+#include "AirspaceMeshCache.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "ui/canvas/Canvas.hpp"
 #include "MapWindow/MapCanvas.hpp"
@@ -19,17 +20,23 @@
 class AirspaceVisitorRenderer final
   : protected MapCanvas
 {
+  const WindowProjection &window_projection;
+  AirspaceMeshCache &meshes;
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
 
+  const Pen black_pen{1, COLOR_BLACK};
+
 public:
   AirspaceVisitorRenderer(Canvas &_canvas, const WindowProjection &_projection,
+                          AirspaceMeshCache &_meshes,
                           const AirspaceLook &_look,
                           const AirspaceWarningCopy &_warnings,
                           const AirspaceRendererSettings &_settings)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
+     window_projection(_projection), meshes(_meshes),
      look(_look), warning_manager(_warnings), settings(_settings)
   {
     glStencilMask(0xff);
@@ -80,7 +87,8 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    const auto &mesh = meshes.Get(airspace);
+    if (!window_projection.GetScreenBounds().Overlaps(mesh.GetBounds()))
       return;
 
     const AirspaceClassRendererSettings &class_settings =
@@ -91,9 +99,20 @@ private:
       class_settings.fill_mode ==
       AirspaceClassRendererSettings::FillMode::ALL;
 
-    if (!warning_manager.IsAcked(airspace) &&
-        class_settings.fill_mode !=
-        AirspaceClassRendererSettings::FillMode::NONE) {
+    const bool draw_fill = !warning_manager.IsAcked(airspace) &&
+      class_settings.fill_mode !=
+      AirspaceClassRendererSettings::FillMode::NONE;
+
+    /* the padding stencil is drawn with a thick pen, which can only
+       be done in screen coordinates */
+    bool prepared = false;
+    if (draw_fill && !fill_airspace) {
+      prepared = PreparePolygon(airspace.GetPoints());
+      if (!prepared)
+        return;
+    }
+
+    if (draw_fill) {
       const GLEnable<GL_STENCIL_TEST> stencil;
 
       if (!fill_airspace) {
@@ -107,7 +126,8 @@ private:
       {
         SetupInterior(airspace, !fill_airspace);
         const GLEnable<GL_BLEND> blend;
-        DrawPrepared();
+        mesh.DrawFill(window_projection,
+                      look.classes[airspace.GetClass()].fill_color.WithAlpha(90));
       }
 
       if (!fill_airspace) {
@@ -119,8 +139,13 @@ private:
     }
 
     // draw outline
-    if (SetupOutline(airspace))
-      DrawPrepared();
+    if (const Pen *pen = SetupOutline(airspace)) {
+      if (pen->GetWidth() <= 2)
+        mesh.DrawOutline(window_projection, *pen);
+      else if (prepared || PreparePolygon(airspace.GetPoints()))
+        /* thick lines are triangulated in screen coordinates */
+        DrawPrepared();
+    }
   }
 
 public:
@@ -137,17 +162,23 @@ public:
   }
 
 private:
-  bool SetupOutline(const AbstractAirspace &airspace) {
+  /**
+   * @return the pen which was selected, or nullptr if no outline
+   * shall be drawn
+   */
+  const Pen *SetupOutline(const AbstractAirspace &airspace) {
     AirspaceClass type = airspace.GetClass();
 
+    const Pen *pen;
     if (settings.black_outline)
-      canvas.SelectBlackPen();
+      pen = &black_pen;
     else if (settings.classes[type].border_width == 0)
       // Don't draw outlines if border_width == 0
-      return false;
+      return nullptr;
     else
-      canvas.Select(look.classes[type].border_pen);
+      pen = &look.classes[type].border_pen;
 
+    canvas.Select(*pen);
     canvas.SelectHollowBrush();
 
     // set bit 1 in stencil buffer, where an outline is drawn
@@ -155,7 +186,7 @@ private:
     glStencilMask(2);
     glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
 
-    return true;
+    return pen;
   }
 
   void SetupInterior(const AbstractAirspace &airspace,
@@ -197,17 +228,23 @@ private:
 class AirspaceFillRenderer final
   : protected MapCanvas
 {
+  const WindowProjection &window_projection;
+  AirspaceMeshCache &meshes;
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
 
+  const Pen black_pen{1, COLOR_BLACK};
+
 public:
   AirspaceFillRenderer(Canvas &_canvas, const WindowProjection &_projection,
+                       AirspaceMeshCache &_meshes,
                        const AirspaceLook &_look,
                        const AirspaceWarningCopy &_warnings,
                        const AirspaceRendererSettings &_settings)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
+     window_projection(_projection), meshes(_meshes),
      look(_look), warning_manager(_warnings), settings(_settings)
   {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -229,18 +266,25 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    const auto &mesh = meshes.Get(airspace);
+    if (!window_projection.GetScreenBounds().Overlaps(mesh.GetBounds()))
       return;
 
     if (!warning_manager.IsAcked(airspace) && SetupInterior(airspace)) {
       // fill interior without overpainting any previous outlines
       GLEnable<GL_BLEND> blend;
-      DrawPrepared();
+      mesh.DrawFill(window_projection,
+                    look.classes[airspace.GetClass()].fill_color.WithAlpha(48));
     }
 
     // draw outline
-    if (SetupOutline(airspace))
-      DrawPrepared();
+    if (const Pen *pen = SetupOutline(airspace)) {
+      if (pen->GetWidth() <= 2)
+        mesh.DrawOutline(window_projection, *pen);
+      else if (PreparePolygon(airspace.GetPoints()))
+        /* thick lines are triangulated in screen coordinates */
+        DrawPrepared();
+    }
   }
 
 public:
@@ -257,20 +301,26 @@ public:
   }
 
 private:
-  bool SetupOutline(const AbstractAirspace &airspace) {
+  /**
+   * @return the pen which was selected, or nullptr if no outline
+   * shall be drawn
+   */
+  const Pen *SetupOutline(const AbstractAirspace &airspace) {
     AirspaceClass type = airspace.GetClass();
 
+    const Pen *pen;
     if (settings.black_outline)
-      canvas.SelectBlackPen();
+      pen = &black_pen;
     else if (settings.classes[type].border_width == 0)
       // Don't draw outlines if border_width == 0
-      return false;
+      return nullptr;
     else
-      canvas.Select(look.classes[type].border_pen);
+      pen = &look.classes[type].border_pen;
 
+    canvas.Select(*pen);
     canvas.SelectHollowBrush();
 
-    return true;
+    return pen;
   }
 
   bool SetupInterior(const AbstractAirspace &airspace) {
@@ -293,20 +343,24 @@ AirspaceRenderer::DrawInternal(Canvas &canvas,
                                const AirspaceWarningCopy &awc,
                                const AirspacePredicate &visible)
 {
+  mesh_cache.Update(*airspaces);
+
   const auto range =
     airspaces->QueryWithinRange(projection.GetGeoScreenCenter(),
                                 projection.GetScreenDistanceMeters());
 
   if (settings.fill_mode == AirspaceRendererSettings::FillMode::ALL ||
       settings.fill_mode == AirspaceRendererSettings::FillMode::NONE) {
-    AirspaceFillRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceFillRenderer renderer(canvas, projection, mesh_cache,
+                                  look, awc, settings);
     for (const auto &i : range) {
       const AbstractAirspace &airspace = i.GetAirspace();
       if (visible(airspace))
         renderer.Visit(airspace);
     }
   } else {
-    AirspaceVisitorRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceVisitorRenderer renderer(canvas, projection, mesh_cache,
+                                     look, awc, settings);
     for (const auto &i : range) {
       const AbstractAirspace &airspace = i.GetAirspace();
       if (visible(airspace))
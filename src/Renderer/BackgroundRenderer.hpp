@@ -42,6 +42,14 @@ public:
                        const DerivedInfo &calculated) noexcept;
   void SetTerrain(const RasterTerrain *terrain) noexcept;
 
+  /**
+   * The light source of the slope shading, as set by
+   * SetShadingAngle().
+   */
+  Angle GetShadingAngle() const noexcept {
+    return shading_angle;
+  }
+
 private:
   void SetShadingAngle(const WindowProjection& proj, Angle angle) noexcept;
 };
@@ -6,14 +6,23 @@
 #include "util/OverwritingRingBuffer.hpp"
 #include "FlightInfo.hpp"
 
+#include <cstddef>
+
 struct PixelRect;
 class Canvas;
 class Font;
 
 class FlightListRenderer {
+public:
+  /**
+   * The maximum number of flights kept; older ones are discarded.
+   */
+  static constexpr std::size_t MAX_FLIGHTS = 128;
+
+private:
   const Font &font, &header_font;
 
-  OverwritingRingBuffer<FlightInfo, 128u> flights;
+  OverwritingRingBuffer<FlightInfo, MAX_FLIGHTS> flights;
 
 public:
   FlightListRenderer(const Font &_font, const Font &_header_font)
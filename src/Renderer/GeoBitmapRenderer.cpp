@@ -15,9 +15,9 @@
 #include "ui/dim/BulkPoint.hpp"
 
 void
-DrawGeoBitmap(const RawBitmap &bitmap, PixelSize bitmap_size,
-              const GeoBounds &bounds,
-              const Projection &projection)
+DrawGeoTexture(const GLTexture &texture, PixelSize texture_size,
+               const GeoBounds &bounds,
+               const Projection &projection)
 {
   assert(bounds.IsValid());
 
@@ -30,11 +30,10 @@ DrawGeoBitmap(const RawBitmap &bitmap, PixelSize bitmap_size,
 
   const ScopeVertexPointer vp(vertices);
 
-  const GLTexture &texture = bitmap.BindAndGetTexture();
   const PixelSize allocated = texture.GetAllocatedSize();
 
-  const GLfloat src_x = 0, src_y = 0, src_width = bitmap_size.width,
-    src_height = bitmap_size.height;
+  const GLfloat src_x = 0, src_y = 0, src_width = texture_size.width,
+    src_height = texture_size.height;
 
   GLfloat x0 = src_x / allocated.width;
   GLfloat y0 = src_y / allocated.height;
@@ -48,7 +47,6 @@ DrawGeoBitmap(const RawBitmap &bitmap, PixelSize bitmap_size,
     x1, y1,
   };
 
-  OpenGL::texture_shader->Use();
   glEnableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
   glVertexAttribPointer(OpenGL::Attribute::TEXCOORD, 2, GL_FLOAT, GL_FALSE,
                         0, coord);
@@ -58,4 +56,15 @@ DrawGeoBitmap(const RawBitmap &bitmap, PixelSize bitmap_size,
   glDisableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
 }
 
+void
+DrawGeoBitmap(const RawBitmap &bitmap, PixelSize bitmap_size,
+              const GeoBounds &bounds,
+              const Projection &projection)
+{
+  const GLTexture &texture = bitmap.BindAndGetTexture();
+
+  OpenGL::texture_shader->Use();
+  DrawGeoTexture(texture, bitmap_size, bounds, projection);
+}
+
 #endif
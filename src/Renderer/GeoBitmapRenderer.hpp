@@ -8,6 +8,10 @@ class RawBitmap;
 class GeoBounds;
 class Projection;
 
+#ifdef ENABLE_OPENGL
+class GLTexture;
+#endif
+
 #ifdef ENABLE_OPENGL
 
 /**
@@ -23,4 +27,14 @@ DrawGeoBitmap(const RawBitmap &bitmap, PixelSize bitmap_size,
               const GeoBounds &bounds,
               const Projection &projection);
 
+/**
+ * Like DrawGeoBitmap(), but draw a #GLTexture with the current
+ * shader program.  The caller is responsible for binding the texture
+ * and for setting up the program.
+ */
+void
+DrawGeoTexture(const GLTexture &texture, PixelSize texture_size,
+               const GeoBounds &bounds,
+               const Projection &projection);
+
 #endif
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "OpaqueRendererCache.hpp"
+
+#ifndef ENABLE_OPENGL
+#include "Projection/WindowProjection.hpp"
+
+bool
+OpaqueRendererCache::Check(const WindowProjection &projection) const noexcept
+{
+  assert(projection.IsValid());
+
+  return buffer.IsDefined() &&
+    buffer.GetSize() == projection.GetScreenSize() &&
+    compare_projection.Compare(projection);
+}
+
+Canvas &
+OpaqueRendererCache::Begin(Canvas &canvas,
+                           const WindowProjection &projection) noexcept
+{
+  assert(canvas.IsDefined());
+  assert(projection.IsValid());
+
+  const auto size = projection.GetScreenSize();
+  if (buffer.IsDefined())
+    buffer.Resize(size);
+  else
+    buffer.Create(canvas, size);
+
+  compare_projection = CompareProjection(projection);
+  return buffer;
+}
+
+void
+OpaqueRendererCache::CopyTo(Canvas &canvas,
+                            const WindowProjection &projection) const noexcept
+{
+  assert(buffer.IsDefined());
+
+  canvas.Copy({0, 0}, projection.GetScreenSize(), buffer, {0, 0});
+}
+
+#endif
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#ifndef ENABLE_OPENGL
+#include "Projection/CompareProjection.hpp"
+#include "ui/canvas/BufferCanvas.hpp"
+#endif
+
+class Canvas;
+class WindowProjection;
+
+/**
+ * Caches the composited output of several layers which together
+ * cover the whole screen.  Unlike #TransparentRendererCache, the
+ * cached image replaces the destination, so it costs only one plain
+ * copy per frame.
+ */
+class OpaqueRendererCache {
+#ifdef ENABLE_OPENGL
+  /* this class is a no-op on OpenGL, because the GPU composites the
+     layers cheaply */
+public:
+  void Invalidate() noexcept {
+  }
+
+  constexpr bool Check([[maybe_unused]] const WindowProjection &projection) const noexcept {
+    return false;
+  }
+
+  constexpr Canvas &Begin(Canvas &canvas,
+                          [[maybe_unused]] const WindowProjection &projection) const noexcept {
+    return canvas;
+  }
+
+  void CopyTo([[maybe_unused]] Canvas &canvas,
+              [[maybe_unused]] const WindowProjection &projection) const noexcept {
+  }
+#else
+  CompareProjection compare_projection;
+  BufferCanvas buffer;
+
+public:
+  void Invalidate() noexcept {
+    compare_projection.Clear();
+  }
+
+  /**
+   * Check if the cache can be used.
+   *
+   * @return true if the cache is valid for the given projection; the
+   * caller may skip to CopyTo()
+   */
+  [[gnu::pure]]
+  bool Check(const WindowProjection &projection) const noexcept;
+
+  /**
+   * Begin drawing to the cache.  Render all layers to the returned
+   * Canvas, then call CopyTo().
+   */
+  Canvas &Begin(Canvas &canvas, const WindowProjection &projection) noexcept;
+
+  void CopyTo(Canvas &canvas,
+              const WindowProjection &projection) const noexcept;
+#endif
+};
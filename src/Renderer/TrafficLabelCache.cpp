@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TrafficLabelCache.hpp"
+#include "Formatter/UserUnits.hpp"
+#include "Units/Units.hpp"
+
+#include <math.h>
+
+void
+TrafficLabelCache::EndFrame() noexcept
+{
+  std::erase_if(entries, [this](const auto &i){
+    return i.second.generation != generation;
+  });
+}
+
+const TCHAR *
+TrafficLabelCache::Get(const char *id, double altitude, double vspeed,
+                       bool fading) noexcept
+{
+  /* compare with the resolution of the formatted values */
+  const long user_altitude = lround(Units::ToUserAltitude(altitude));
+  const long user_vspeed = fabs(vspeed) >= 0.1
+    ? lround(Units::ToUserVSpeed(vspeed) * 10)
+    : 0;
+
+  auto [i, inserted] = entries.try_emplace(id);
+  Entry &entry = i->second;
+  entry.generation = generation;
+
+  if (!inserted && entry.altitude == user_altitude &&
+      entry.vspeed == user_vspeed && entry.fading == fading)
+    return entry.text;
+
+  entry.altitude = user_altitude;
+  entry.vspeed = user_vspeed;
+  entry.fading = fading;
+
+  TCHAR altitude_text[16];
+  FormatUserAltitude(altitude, altitude_text, false);
+
+  if (!fading && user_vspeed != 0) {
+    TCHAR vspeed_text[16];
+    FormatUserVerticalSpeed(vspeed, vspeed_text, false, true);
+    entry.text.Format(_T("%s %s"), altitude_text, vspeed_text);
+  } else
+    entry.text = altitude_text;
+
+  return entry.text;
+}
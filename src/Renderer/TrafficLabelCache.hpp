@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "util/StaticString.hxx"
+
+#include <string>
+#include <unordered_map>
+
+#include <tchar.h>
+
+/**
+ * Caches the formatted "altitude vspeed" label of each traffic across
+ * frames, so the strings are only formatted again when the displayed
+ * value changes.  Only to be used by the DrawThread.
+ */
+class TrafficLabelCache {
+  struct Entry {
+    /**
+     * The values the #text was formatted from, in user units.
+     */
+    long altitude, vspeed;
+
+    bool fading;
+
+    /**
+     * The frame this entry was last used in.
+     */
+    unsigned generation;
+
+    StaticString<32> text;
+  };
+
+  std::unordered_map<std::string, Entry> entries;
+
+  unsigned generation = 0;
+
+public:
+  /**
+   * Call before drawing a new frame.
+   */
+  void BeginFrame() noexcept {
+    ++generation;
+  }
+
+  /**
+   * Discard the labels of all traffics which were not drawn in this
+   * frame.
+   */
+  void EndFrame() noexcept;
+
+  /**
+   * Obtain the label for the given traffic.
+   *
+   * @param altitude the altitude [m]
+   * @param vspeed the vertical speed [m/s]
+   * @param fading omit the vertical speed of stale traffic
+   */
+  const TCHAR *Get(const char *id, double altitude, double vspeed,
+                   bool fading) noexcept;
+};
@@ -6,15 +6,88 @@
 #include "Screen/Layout.hpp"
 #include "Look/TrafficLook.hpp"
 #include "FLARM/Traffic.hpp"
-#include "GliderLink/Traffic.hpp"
 #include "Math/Screen.hpp"
 #include "util/Macros.hpp"
 #include "Asset.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "ui/canvas/opengl/Scope.hpp"
+#include "ui/canvas/opengl/Shaders.hpp"
+#include "ui/canvas/opengl/Program.hpp"
+#include "ui/canvas/opengl/VertexPointer.hpp"
 #endif
 
+/**
+ * Create the arrow polygon, rotated and shifted to the given
+ * position and angle.
+ */
+static void
+MakeArrow(BulkPixelPoint arrow[4], const PixelPoint pt,
+          const Angle angle) noexcept
+{
+  arrow[0] = { -4, 6 };
+  arrow[1] = { 0, -8 };
+  arrow[2] = { 4, 6 };
+  arrow[3] = { 0, 3 };
+
+  PolygonRotateShift({arrow, 4}, pt, angle, Layout::Scale(100U));
+}
+
+/**
+ * Returns the brush depending on the alarm level and the relative
+ * altitude.
+ */
+[[gnu::pure]]
+static const Brush &
+GetArrowBrush(const TrafficLook &traffic_look,
+              const FlarmTraffic &traffic) noexcept
+{
+  switch (traffic.alarm_level) {
+  case FlarmTraffic::AlarmType::LOW:
+  case FlarmTraffic::AlarmType::INFO_ALERT:
+    return traffic_look.warning_brush;
+
+  case FlarmTraffic::AlarmType::IMPORTANT:
+  case FlarmTraffic::AlarmType::URGENT:
+    return traffic_look.alarm_brush;
+
+  case FlarmTraffic::AlarmType::NONE:
+    if (traffic.relative_altitude > (const RoughAltitude)50)
+      return traffic_look.safe_above_brush;
+    else if (traffic.relative_altitude > (const RoughAltitude)-50)
+      return traffic_look.warning_in_altitude_range_brush;
+    else
+      return traffic_look.safe_below_brush;
+
+  case FlarmTraffic::AlarmType::OFFLINE:
+    break;
+  }
+
+  return traffic_look.offline_brush;
+}
+
+/**
+ * Returns the pen for the team colour circle, or nullptr if there is
+ * none.
+ */
+[[gnu::pure]]
+static const Pen *
+GetTeamPen(const TrafficLook &traffic_look, const FlarmColor color) noexcept
+{
+  switch (color) {
+  case FlarmColor::GREEN:
+    return &traffic_look.team_pen_green;
+  case FlarmColor::BLUE:
+    return &traffic_look.team_pen_blue;
+  case FlarmColor::YELLOW:
+    return &traffic_look.team_pen_yellow;
+  case FlarmColor::MAGENTA:
+    return &traffic_look.team_pen_magenta;
+  default:
+    return nullptr;
+  }
+}
+
 void
 TrafficRenderer::Draw(Canvas &canvas, const TrafficLook &traffic_look,
                       bool fading,
@@ -22,15 +95,8 @@ TrafficRenderer::Draw(Canvas &canvas, const TrafficLook &traffic_look,
                       const FlarmColor color, const PixelPoint pt) noexcept
 {
   // Create point array that will form that arrow polygon
-  BulkPixelPoint arrow[] = {
-    { -4, 6 },
-    { 0, -8 },
-    { 4, 6 },
-    { 0, 3 },
-  };
-
-  // Rotate and shift the arrow to the right position and angle
-  PolygonRotateShift(arrow, pt, angle, Layout::Scale(100U));
+  BulkPixelPoint arrow[4];
+  MakeArrow(arrow, pt, angle);
 
   if (fading) {
     canvas.Select(traffic_look.fading_pen);
@@ -49,28 +115,7 @@ TrafficRenderer::Draw(Canvas &canvas, const TrafficLook &traffic_look,
     canvas.DrawPolygon(arrow, ARRAY_SIZE(arrow));
   } else {
     // Select brush depending on AlarmLevel
-    switch (traffic.alarm_level) {
-    case FlarmTraffic::AlarmType::LOW:
-    case FlarmTraffic::AlarmType::INFO_ALERT:
-      canvas.Select(traffic_look.warning_brush);
-      break;
-    case FlarmTraffic::AlarmType::IMPORTANT:
-    case FlarmTraffic::AlarmType::URGENT:
-      canvas.Select(traffic_look.alarm_brush);
-      break;
-    case FlarmTraffic::AlarmType::NONE:
-      if (traffic.relative_altitude > (const RoughAltitude)50) {
-        canvas.Select(traffic_look.safe_above_brush);
-      } else if (traffic.relative_altitude > (const RoughAltitude)-50) {
-        canvas.Select(traffic_look.warning_in_altitude_range_brush);
-      } else {
-        canvas.Select(traffic_look.safe_below_brush);
-      }
-      break;
-    case FlarmTraffic::AlarmType::OFFLINE:
-      canvas.Select(traffic_look.offline_brush);
-      break;
-    }
+    canvas.Select(GetArrowBrush(traffic_look, traffic));
 
     // Select black pen
     canvas.SelectBlackPen();
@@ -79,56 +124,153 @@ TrafficRenderer::Draw(Canvas &canvas, const TrafficLook &traffic_look,
     canvas.DrawPolygon(arrow, ARRAY_SIZE(arrow));
   }
 
-  switch (color) {
-  case FlarmColor::GREEN:
-    canvas.Select(traffic_look.team_pen_green);
-    break;
-  case FlarmColor::BLUE:
-    canvas.Select(traffic_look.team_pen_blue);
-    break;
-  case FlarmColor::YELLOW:
-    canvas.Select(traffic_look.team_pen_yellow);
-    break;
-  case FlarmColor::MAGENTA:
-    canvas.Select(traffic_look.team_pen_magenta);
-    break;
-  default:
+  const Pen *team_pen = GetTeamPen(traffic_look, color);
+  if (team_pen == nullptr)
     return;
-  }
 
+  canvas.Select(*team_pen);
   canvas.SelectHollowBrush();
   canvas.DrawCircle(pt, Layout::FastScale(11u));
 }
 
+#ifdef ENABLE_OPENGL
+
+void
+TrafficRenderer::Batch::Add([[maybe_unused]] Canvas &canvas,
+                            const TrafficLook &traffic_look,
+                            bool fading,
+                            const FlarmTraffic &traffic, const Angle angle,
+                            const FlarmColor color,
+                            const PixelPoint pt) noexcept
+{
+  auto &dest = fading ? fading_arrows : arrows;
+  dest.resize(dest.size() + 4);
+  MakeArrow(&*std::prev(dest.end(), 4), pt, angle);
+
+  if (!fading)
+    colors.push_back(GetArrowBrush(traffic_look, traffic).GetColor());
+
+  if (const Pen *team_pen = GetTeamPen(traffic_look, color))
+    circles.push_back({pt, team_pen});
+}
+
+/**
+ * Draw the outlines of the given arrows with a pen which has already
+ * been bound.
+ */
+static void
+DrawArrowOutlines(ScopeVertexPointer &vp,
+                  std::vector<BulkPixelPoint> &vertices,
+                  const std::vector<BulkPixelPoint> &arrows) noexcept
+{
+  /* each edge as a separate line */
+  vertices.clear();
+  for (auto i = arrows.begin(); i != arrows.end(); i += 4) {
+    for (unsigned j = 0; j < 4; ++j) {
+      vertices.push_back(i[j]);
+      vertices.push_back(i[(j + 1) % 4]);
+    }
+  }
 
+  vp.Update(vertices.data());
+  glDrawArrays(GL_LINES, 0, vertices.size());
+}
+
+/**
+ * Convert the (concave) arrows to two triangles each.
+ */
+static void
+ArrowsToTriangles(std::vector<BulkPixelPoint> &vertices,
+                  const std::vector<BulkPixelPoint> &arrows) noexcept
+{
+  static constexpr unsigned indices[] = { 1, 2, 3, 1, 3, 0 };
+
+  vertices.clear();
+  for (auto i = arrows.begin(); i != arrows.end(); i += 4)
+    for (const unsigned j : indices)
+      vertices.push_back(i[j]);
+}
 
 void
-TrafficRenderer::Draw(Canvas &canvas, const TrafficLook &traffic_look,
-                      [[maybe_unused]] const GliderLinkTraffic &traffic,
-                      const Angle angle, const PixelPoint pt) noexcept
+TrafficRenderer::Batch::Flush(Canvas &canvas,
+                              const TrafficLook &traffic_look) noexcept
 {
-  // Create point array that will form that arrow polygon
-  BulkPixelPoint arrow[] = {
-    { -4, 6 },
-    { 0, -8 },
-    { 4, 6 },
-    { 0, 3 },
-  };
-
-  canvas.Select(traffic_look.safe_above_brush);
-
-  // Select black pen
-  if (IsDithered())
-    canvas.Select(Pen(Layout::FastScale(2), COLOR_BLACK));
-  else
-    canvas.SelectBlackPen();
+  OpenGL::solid_shader->Use();
 
-  // Rotate and shift the arrow to the right position and angle
-  PolygonRotateShift(arrow, pt, angle, Layout::Scale(100U));
+  if (!fading_arrows.empty()) {
+    const ScopeAlphaBlend alpha_blend;
 
-  // Draw the arrow
-  canvas.DrawPolygon(arrow, ARRAY_SIZE(arrow));
+    ArrowsToTriangles(vertices, fading_arrows);
+    ScopeVertexPointer vp(vertices.data());
+    traffic_look.fading_brush.Bind();
+    glDrawArrays(GL_TRIANGLES, 0, vertices.size());
 
-  canvas.SelectHollowBrush();
-  canvas.DrawCircle(pt, Layout::FastScale(11u));
+    const Pen &pen = traffic_look.fading_pen;
+    if (pen.GetWidth() <= 2) {
+      pen.Bind();
+      DrawArrowOutlines(vp, vertices, fading_arrows);
+      pen.Unbind();
+    } else {
+      /* wide lines need to be triangulated by the Canvas */
+      canvas.Select(pen);
+      canvas.SelectHollowBrush();
+      for (auto i = fading_arrows.begin(); i != fading_arrows.end(); i += 4)
+        canvas.DrawPolygon(&*i, 4);
+      OpenGL::solid_shader->Use();
+    }
+  }
+
+  if (!arrows.empty()) {
+    ArrowsToTriangles(vertices, arrows);
+
+    /* expand the colour of each arrow to its six vertices */
+    vertex_colors.clear();
+    for (const auto &color : colors)
+      vertex_colors.insert(vertex_colors.end(), 6, color);
+
+    ScopeVertexPointer vp(vertices.data());
+
+    {
+      const ScopeColorPointer cp(vertex_colors.data());
+      glDrawArrays(GL_TRIANGLES, 0, vertices.size());
+    }
+
+    const Pen black_pen(1, COLOR_BLACK);
+    black_pen.Bind();
+    DrawArrowOutlines(vp, vertices, arrows);
+    black_pen.Unbind();
+  }
+
+  if (!circles.empty()) {
+    canvas.SelectHollowBrush();
+    for (const auto &circle : circles) {
+      canvas.Select(*circle.pen);
+      canvas.DrawCircle(circle.center, Layout::FastScale(11u));
+    }
+  }
+
+  arrows.clear();
+  fading_arrows.clear();
+  colors.clear();
+  circles.clear();
 }
+
+#else
+
+void
+TrafficRenderer::Batch::Add(Canvas &canvas, const TrafficLook &traffic_look,
+                            bool fading,
+                            const FlarmTraffic &traffic, const Angle angle,
+                            const FlarmColor color,
+                            const PixelPoint pt) noexcept
+{
+  Draw(canvas, traffic_look, fading, traffic, angle, color, pt);
+}
+
+void
+TrafficRenderer::Batch::Flush([[maybe_unused]] Canvas &canvas,
+                              [[maybe_unused]] const TrafficLook &traffic_look) noexcept
+{
+}
+
+#endif
@@ -5,11 +5,19 @@
 
 #include "FLARM/Color.hpp"
 
+#ifdef ENABLE_OPENGL
+#include "ui/canvas/Color.hpp"
+#include "ui/dim/BulkPoint.hpp"
+#include "ui/dim/Point.hpp"
+
+#include <vector>
+#endif
+
 struct PixelPoint;
 class Canvas;
+class Pen;
 struct TrafficLook;
 struct FlarmTraffic;
-struct GliderLinkTraffic;
 class Angle;
 
 namespace TrafficRenderer
@@ -20,7 +28,59 @@ Draw(Canvas &canvas, const TrafficLook &traffic_look,
      const FlarmTraffic &traffic, Angle angle,
      FlarmColor color, PixelPoint pt) noexcept;
 
-void
-Draw(Canvas &canvas, const TrafficLook &traffic_look,
-     const GliderLinkTraffic &traffic, Angle angle, PixelPoint pt) noexcept;
+/**
+ * Collects the traffic symbols of one frame and draws them all at
+ * once.  On OpenGL, all symbols of one style end up in one vertex
+ * array, with the colour as a per-vertex attribute, and are drawn
+ * with one call; elsewhere, Add() draws immediately.
+ *
+ * The symbols are drawn on top of everything else drawn between
+ * Add() and Flush().  An instance may be reused for the next frame,
+ * retaining its allocations.
+ */
+class Batch {
+#ifdef ENABLE_OPENGL
+  /**
+   * The arrow polygons, four points each.
+   */
+  std::vector<BulkPixelPoint> arrows, fading_arrows;
+
+  /**
+   * The fill colour of each element of #arrows.
+   */
+  std::vector<Color> colors;
+
+  struct Circle {
+    PixelPoint center;
+    const Pen *pen;
+  };
+
+  /**
+   * The team colour circles.
+   */
+  std::vector<Circle> circles;
+
+  /**
+   * Scratch buffers for Flush().
+   */
+  std::vector<BulkPixelPoint> vertices;
+  std::vector<Color> vertex_colors;
+#endif
+
+public:
+  /**
+   * Like TrafficRenderer::Draw(), but the symbol is only drawn by
+   * Flush().
+   */
+  void Add(Canvas &canvas, const TrafficLook &traffic_look,
+           bool fading,
+           const FlarmTraffic &traffic, Angle angle,
+           FlarmColor color, PixelPoint pt) noexcept;
+
+  /**
+   * Draw all symbols collected by Add() and clear the batch.
+   */
+  void Flush(Canvas &canvas, const TrafficLook &traffic_look) noexcept;
+};
+
 }
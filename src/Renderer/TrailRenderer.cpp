@@ -12,11 +12,51 @@
 #include "Geo/Math.hpp"
 #include "Engine/Contest/ContestTrace.hpp"
 
+#ifdef ENABLE_OPENGL
+#include "ui/canvas/opengl/Buffer.hpp"
+#include "ui/canvas/opengl/VertexPointer.hpp"
+#include "ui/canvas/opengl/Geo.hpp"
+#include "ui/canvas/opengl/Program.hpp"
+#include "ui/canvas/opengl/Shaders.hpp"
+#include "Math/Point2D.hpp"
+
+#include <glm/gtc/type_ptr.hpp>
+#endif
+
 #include <algorithm>
+#include <cmath>
+
+#ifdef ENABLE_OPENGL
+
+struct TrailRenderer::Mesh {
+  /**
+   * Two #FloatPoint2D per segment, relative to #reference.
+   */
+  GLArrayBuffer vertices;
+
+  /**
+   * One #Color per vertex.
+   */
+  GLArrayBuffer colors;
+
+  GeoPoint reference;
+
+  unsigned n_vertices;
+};
+
+#endif
+
+TrailRenderer::TrailRenderer(const TrailLook &_look) noexcept
+  :look(_look) {}
+
+TrailRenderer::~TrailRenderer() noexcept = default;
 
 bool
 TrailRenderer::LoadTrace(const TraceComputer &trace_computer) noexcept
 {
+  loaded.valid = false;
+  colors_valid = false;
+
   trace.clear();
   trace_computer.LockedCopyTo(trace);
   return !trace.empty();
@@ -27,11 +67,30 @@ TrailRenderer::LoadTrace(const TraceComputer &trace_computer,
                          TimeStamp min_time,
                          const WindowProjection &projection) noexcept
 {
+  const int level = std::ilogb(std::max(projection.DistancePixelsToMeters(3),
+                                        1.));
+
+  /* obtain the serial before copying, so a modification during the
+     copy triggers another copy next time */
+  const Serial serial = trace_computer.LockedGetSerial();
+  if (loaded.valid && loaded.serial == serial &&
+      loaded.min_time == min_time && loaded.level == level)
+    /* unchanged; the location is not part of the key because it only
+       affects the flat projection of the distance */
+    return !trace.empty();
+
   trace.clear();
   trace_computer.LockedCopyTo(trace,
                               min_time.Cast<std::chrono::duration<unsigned>>(),
                               projection.GetGeoScreenCenter(),
-                              projection.DistancePixelsToMeters(3));
+                              std::ldexp(1., level));
+
+  loaded.serial = serial;
+  loaded.min_time = min_time;
+  loaded.level = level;
+  loaded.valid = true;
+  colors_valid = false;
+
   return !trace.empty();
 }
 
@@ -88,6 +147,105 @@ GetMinMax(TrailSettings::Type type, const TracePointVector &trace) noexcept
   return std::make_pair(value_min, value_max);
 }
 
+void
+TrailRenderer::UpdateColors(TrailSettings::Type type) noexcept
+{
+  if (colors_valid && colors_type == type)
+    return;
+
+  const auto [value_min, value_max] = GetMinMax(type, trace);
+
+  colors.clear();
+  colors.reserve(trace.size());
+
+  for (const auto &i : trace)
+    colors.push_back(type == TrailSettings::Type::ALTITUDE
+                     ? GetAltitudeColorIndex(i.GetAltitude(),
+                                             value_min, value_max)
+                     : GetSnailColorIndex(i.GetVario(),
+                                          value_min, value_max));
+
+  colors_type = type;
+  colors_valid = true;
+
+#ifdef ENABLE_OPENGL
+  mesh_valid = false;
+#endif
+}
+
+#ifdef ENABLE_OPENGL
+
+void
+TrailRenderer::UpdateMesh() noexcept
+{
+  assert(colors_valid);
+  assert(trace.size() >= 2);
+
+  if (mesh == nullptr)
+    mesh = std::make_unique<Mesh>();
+  else if (mesh_valid)
+    return;
+
+  mesh->reference = trace.front().GetLocation();
+
+  const auto ToVertex = [&reference = mesh->reference](const TracePoint &p){
+    const GeoPoint &l = p.GetLocation();
+    return FloatPoint2D((l.longitude - reference.longitude).AsDelta().Native(),
+                        (l.latitude - reference.latitude).AsDelta().Native());
+  };
+
+  std::vector<FloatPoint2D> v;
+  std::vector<Color> c;
+  v.reserve(2 * (trace.size() - 1));
+  c.reserve(v.capacity());
+
+  /* separate segments instead of a strip, because each one has the
+     colour of its end point (like the Canvas code path) */
+  for (std::size_t i = 1; i < trace.size(); ++i) {
+    const Color color = look.trail_pens[colors[i]].GetColor();
+    v.push_back(ToVertex(trace[i - 1]));
+    v.push_back(ToVertex(trace[i]));
+    c.push_back(color);
+    c.push_back(color);
+  }
+
+  mesh->n_vertices = v.size();
+  mesh->vertices.Load(v.size() * sizeof(v.front()), v.data());
+  mesh->colors.Load(c.size() * sizeof(c.front()), c.data());
+  mesh_valid = true;
+}
+
+void
+TrailRenderer::DrawMesh(const WindowProjection &projection,
+                        unsigned line_width) noexcept
+{
+  assert(mesh_valid);
+
+  OpenGL::solid_shader->Use();
+
+  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                     glm::value_ptr(ToGLM(projection, mesh->reference)));
+
+  glLineWidth(line_width);
+
+  {
+    mesh->vertices.Bind();
+    const ScopeVertexPointer vp(GL_FLOAT, nullptr);
+
+    mesh->colors.Bind();
+    const ScopeColorPointer cp(nullptr);
+
+    glDrawArrays(GL_LINES, 0, mesh->n_vertices);
+
+    GLArrayBuffer::Unbind();
+  }
+
+  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                     glm::value_ptr(glm::mat4(1)));
+}
+
+#endif
+
 void
 TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
                     const WindowProjection &projection,
@@ -113,18 +271,39 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
     traildrift = basic.location - tp1;
   }
 
-  auto minmax = GetMinMax(settings.type, trace);
-  auto value_min = minmax.first;
-  auto value_max = minmax.second;
+  UpdateColors(settings.type);
 
   bool scaled_trail = settings.scaling_enabled &&
                       projection.GetMapScale() <= 6000;
 
+#ifdef ENABLE_OPENGL
+  if (!enable_traildrift &&
+      (settings.type == TrailSettings::Type::ALTITUDE ||
+       (!scaled_trail &&
+        (settings.type == TrailSettings::Type::VARIO_1 ||
+         settings.type == TrailSettings::Type::VARIO_2))) &&
+      look.trail_pens[0].GetWidth() <= 2) {
+    /* plain lines with the fixed-width pens: draw the whole trail
+       with one call from the cached buffers; wider lines need to be
+       triangulated by the Canvas */
+    if (trace.size() >= 2) {
+      UpdateMesh();
+      DrawMesh(projection, look.trail_pens[0].GetWidth());
+    }
+
+    canvas.Select(look.trail_pens[colors.back()]);
+    canvas.DrawLine(projection.GeoToScreen(trace.back().GetLocation()), pos);
+    return;
+  }
+#endif
+
   const GeoBounds bounds = projection.GetScreenBounds().Scale(4);
+  const auto geo_to_screen = projection.GetFastGeoToScreen();
 
   PixelPoint last_point(0, 0);
   bool last_valid = false;
-  for (const auto &i : trace) {
+  for (std::size_t n = 0; n < trace.size(); ++n) {
+    const auto &i = trace[n];
     const GeoPoint gp = enable_traildrift
       ? i.GetLocation().Parametric(traildrift, i.CalculateDrift(basic.time))
       : i.GetLocation();
@@ -134,17 +313,14 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
       continue;
     }
 
-    auto pt = projection.GeoToScreen(gp);
+    auto pt = geo_to_screen(gp);
 
     if (last_valid) {
+      const unsigned color_index = colors[n];
       if (settings.type == TrailSettings::Type::ALTITUDE) {
-        unsigned index = GetAltitudeColorIndex(i.GetAltitude(),
-                                               value_min, value_max);
-        canvas.Select(look.trail_pens[index]);
+        canvas.Select(look.trail_pens[color_index]);
         canvas.DrawLinePiece(last_point, pt);
       } else {
-        unsigned color_index = GetSnailColorIndex(i.GetVario(),
-                                                  value_min, value_max);
         if (i.GetVario() < 0 &&
             (settings.type == TrailSettings::Type::VARIO_1_DOTS ||
              settings.type == TrailSettings::Type::VARIO_2_DOTS ||
@@ -225,8 +401,9 @@ TrailRenderer::DrawTraceVector(Canvas &canvas, const Projection &projection,
 {
   const unsigned n = trace.size();
 
-  std::transform(trace.begin(), trace.end(), Prepare(n), [&projection](const auto &i){
-    return projection.GeoToScreen(i.GetLocation());
+  const auto f = projection.GetFastGeoToScreen();
+  std::transform(trace.begin(), trace.end(), Prepare(n), [&f](const auto &i){
+    return f(i.GetLocation());
   });
 
   DrawPreparedPolyline(canvas, n);
@@ -254,8 +431,9 @@ TrailRenderer::DrawTraceVector(Canvas &canvas, const Projection &projection,
 {
   const unsigned n = trace.size();
 
-  std::transform(trace.begin(), trace.end(), Prepare(n), [&projection](const auto &i){
-    return projection.GeoToScreen(i.GetLocation());
+  const auto f = projection.GetFastGeoToScreen();
+  std::transform(trace.begin(), trace.end(), Prepare(n), [&f](const auto &i){
+    return f(i.GetLocation());
   });
 
   DrawPreparedPolyline(canvas, n);
@@ -4,9 +4,18 @@
 #pragma once
 
 #include "util/AllocatedArray.hxx"
+#include "util/Serial.hpp"
 #include "Engine/Trace/Point.hpp"
 #include "Engine/Trace/Vector.hpp"
 #include "time/Stamp.hpp"
+#include "MapSettings.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#ifdef ENABLE_OPENGL
+#include <memory>
+#endif
 
 struct PixelPoint;
 struct BulkPixelPoint;
@@ -19,7 +28,6 @@ struct ContestTracePoint;
 struct TrailLook;
 struct NMEAInfo;
 struct DerivedInfo;
-struct TrailSettings;
 
 /**
  * Trail renderer
@@ -32,8 +40,52 @@ class TrailRenderer {
   TracePointVector trace;
   AllocatedArray<BulkPixelPoint> points;
 
+  /**
+   * Describes which part of the trace was loaded into #trace by the
+   * filtered LoadTrace(), to avoid copying it again (while holding
+   * the #TraceComputer lock) if nothing has changed.
+   */
+  struct {
+    Serial serial;
+
+    TimeStamp min_time;
+
+    /**
+     * The detail level: the minimum distance between two points is
+     * 2^level meters.
+     */
+    int level;
+
+    bool valid = false;
+  } loaded;
+
+  /**
+   * The #TrailLook colour index of each point in #trace, calculated
+   * by UpdateColors() only after the trace or the trail type have
+   * changed.
+   */
+  std::vector<uint8_t> colors;
+
+  TrailSettings::Type colors_type;
+
+  bool colors_valid = false;
+
+#ifdef ENABLE_OPENGL
+  /**
+   * The segments of #trace in an OpenGL buffer, see UpdateMesh().
+   */
+  struct Mesh;
+  std::unique_ptr<Mesh> mesh;
+
+  bool mesh_valid = false;
+#endif
+
 public:
-  TrailRenderer(const TrailLook &_look) noexcept:look(_look) {}
+  explicit TrailRenderer(const TrailLook &_look) noexcept;
+  ~TrailRenderer() noexcept;
+
+  TrailRenderer(const TrailRenderer &) = delete;
+  TrailRenderer &operator=(const TrailRenderer &) = delete;
 
   /**
    * Load the full trace into this object.
@@ -41,7 +93,10 @@ public:
   bool LoadTrace(const TraceComputer &trace_computer) noexcept;
 
   /**
-   * Load a filtered trace into this object.
+   * Load a filtered trace into this object.  The minimum distance
+   * between two points is rounded down to a power of two (a "level
+   * of detail"), so the trace needs to be loaded again only after the
+   * trace or the level have changed.
    */
   bool LoadTrace(const TraceComputer &trace_computer,
                  TimeStamp min_time,
@@ -87,6 +142,25 @@ public:
                     const ContestTraceVector &trace) noexcept;
 
 private:
+  /**
+   * Calculate #colors (if not already done) for the trace loaded by
+   * LoadTrace().
+   */
+  void UpdateColors(TrailSettings::Type type) noexcept;
+
+#ifdef ENABLE_OPENGL
+  /**
+   * Upload the coloured segments of #trace to #mesh (if not already
+   * done), as geographic offsets relative to a reference point, so
+   * drawing needs only a modelview matrix instead of projecting
+   * every point.
+   */
+  void UpdateMesh() noexcept;
+
+  void DrawMesh(const WindowProjection &projection,
+                unsigned line_width) noexcept;
+#endif
+
   void DrawTraceVector(Canvas &canvas, const Projection &projection,
                        const TracePointVector &trace) noexcept;
 };
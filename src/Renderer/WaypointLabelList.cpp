@@ -46,7 +46,18 @@ MapWaypointLabelListCompare(const WaypointLabelList::Label &e1,
 }
 
 void
-WaypointLabelList::Add(const TCHAR *Name, PixelPoint p,
+WaypointLabelList::BeginUpdate(PixelRect _rect) noexcept
+{
+  clip_rect = _rect;
+  clip_rect.Grow(WPCIRCLESIZE);
+  clip_rect.right += WPCIRCLESIZE * 2;
+
+  for (auto &l : labels)
+    l.updated = false;
+}
+
+void
+WaypointLabelList::Add(unsigned id, const TCHAR *Name, PixelPoint p,
                        TextInBoxMode Mode, bool bold,
                        int AltArivalAGL, bool inTask,
                        bool isLandable, bool isAirport,
@@ -55,10 +66,18 @@ WaypointLabelList::Add(const TCHAR *Name, PixelPoint p,
   if (!clip_rect.Contains(p))
     return;
 
-  if (labels.full())
+  auto i = std::find_if(labels.begin(), labels.end(),
+                        [id](const Label &l){ return l.id == id; });
+  if (i == labels.end()) {
+    if (labels.full())
+      return;
+
+    labels.append().id = id;
+    i = std::prev(labels.end());
+  } else if (i->updated)
     return;
 
-  auto &l = labels.append();
+  auto &l = *i;
 
   CopyString(l.Name, ARRAY_SIZE(l.Name), Name);
   l.Pos = p;
@@ -69,11 +88,27 @@ WaypointLabelList::Add(const TCHAR *Name, PixelPoint p,
   l.isLandable = isLandable;
   l.isAirport  = isAirport;
   l.isWatchedWaypoint = isWatchedWaypoint;
+  l.updated = true;
 }
 
 void
-WaypointLabelList::Sort() noexcept
+WaypointLabelList::EndUpdate() noexcept
 {
-  std::sort(labels.begin(), labels.end(),
-            MapWaypointLabelListCompare);
+  labels.shrink(std::distance(labels.begin(),
+                              std::remove_if(labels.begin(), labels.end(),
+                                             [](const Label &l){
+                                               return !l.updated;
+                                             })));
+
+  if (std::is_sorted(labels.begin(), labels.end(),
+                     MapWaypointLabelListCompare))
+    return;
+
+  /* the list is mostly sorted already (only a few labels have
+     entered the view or changed their class), which makes insertion
+     sort cheaper than std::sort() */
+  for (auto i = std::next(labels.begin()); i != labels.end(); ++i)
+    std::rotate(std::upper_bound(labels.begin(), i, *i,
+                                 MapWaypointLabelListCompare),
+                i, std::next(i));
 }
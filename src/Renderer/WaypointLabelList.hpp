@@ -12,6 +12,17 @@
 
 #include <tchar.h>
 
+/**
+ * The labels of the visible waypoints in the order in which they are
+ * drawn (i.e. by priority).
+ *
+ * The list is kept from one frame to the next: each frame submits
+ * all labels between BeginUpdate() and EndUpdate(), which updates
+ * existing labels in place, appends new ones and removes the ones
+ * which were not submitted, without disturbing the order of the
+ * others.  Usually the previous order is still valid, and sorting is
+ * skipped.
+ */
 class WaypointLabelList : private NonCopyable {
   static constexpr int WPCIRCLESIZE = 2;
 
@@ -21,11 +32,22 @@ public:
     PixelPoint Pos;
     TextInBoxMode Mode;
     int AltArivalAGL;
+
+    /**
+     * The Waypoint::id this label belongs to.
+     */
+    unsigned id;
+
     bool inTask;
     bool isLandable;
     bool isAirport;
     bool isWatchedWaypoint;
     bool bold;
+
+    /**
+     * Was this label submitted since the last BeginUpdate() call?
+     */
+    bool updated;
   };
 
 protected:
@@ -34,19 +56,37 @@ protected:
   StaticArray<Label, 256u> labels;
 
 public:
-  explicit WaypointLabelList(PixelRect _rect) noexcept
-    :clip_rect(_rect)
-  {
-    clip_rect.Grow(WPCIRCLESIZE);
-    clip_rect.right += WPCIRCLESIZE * 2;
-  }
+  WaypointLabelList() noexcept = default;
+
+  /**
+   * Start submitting the labels of a new frame.
+   */
+  void BeginUpdate(PixelRect _rect) noexcept;
 
-  void Add(const TCHAR *name, PixelPoint p,
+  /**
+   * Submit a label.  If a label for the same waypoint has already
+   * been submitted in this frame, the first one wins.
+   */
+  void Add(unsigned id, const TCHAR *name, PixelPoint p,
            TextInBoxMode Mode, bool bold,
            int AltArivalAGL,
            bool inTask, bool isLandable, bool isAirport,
            bool isWatchedWaypoint) noexcept;
-  void Sort() noexcept;
+
+  /**
+   * Remove the labels which were not submitted in this frame and
+   * restore the order.
+   */
+  void EndUpdate() noexcept;
+
+  void Clear() noexcept {
+    labels.clear();
+  }
+
+  [[gnu::pure]]
+  unsigned size() const noexcept {
+    return labels.size();
+  }
 
   auto begin() const noexcept {
     return labels.begin();
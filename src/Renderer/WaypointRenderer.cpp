@@ -148,8 +148,7 @@ class WaypointVisitorMap final
 
   WaypointIconRenderer icon_renderer;
 
-public:
-  WaypointLabelList labels;
+  WaypointLabelList &labels;
 
 public:
   WaypointVisitorMap(Canvas &_canvas,
@@ -157,7 +156,8 @@ public:
                      const WaypointRendererSettings &_settings,
                      const WaypointLook &_look,
                      const TaskBehaviour &_task_behaviour,
-                     const MoreData &_basic) noexcept
+                     const MoreData &_basic,
+                     WaypointLabelList &_labels) noexcept
     :projection(_projection),
      settings(_settings), look(_look), task_behaviour(_task_behaviour),
      basic(_basic),
@@ -166,7 +166,7 @@ public:
                    _canvas,
                    projection.GetMapScale() > 4000,
                    projection.GetScreenAngle()),
-     labels(projection.GetScreenRect())
+     labels(_labels)
   {
     _tcscpy(altitude_unit, Units::GetAltitudeName());
   }
@@ -354,7 +354,7 @@ protected:
       // make space for the green circle
       sc.x += 5;
 
-    labels.Add(buffer, sc, text_mode, bold,
+    labels.Add(way_point.id, buffer, sc, text_mode, bold,
                vwp.reachable != WaypointReachability::INVALID ? vwp.reach.direct : INT_MIN,
                vwp.in_task, way_point.IsLandable(), way_point.IsAirport(),
                watchedWaypoint);
@@ -439,19 +439,21 @@ public:
   }
 
   void Draw() noexcept {
+    labels.BeginUpdate(projection.GetScreenRect());
+
     for (const VisibleWaypoint &vwp : waypoints)
       DrawWaypoint(vwp);
+
+    labels.EndUpdate();
   }
 };
 
 static void
 MapWaypointLabelRender(Canvas &canvas, PixelSize clip_size,
                        LabelBlock &label_block,
-                       WaypointLabelList &labels,
+                       const WaypointLabelList &labels,
                        const WaypointLook &look) noexcept
 {
-  labels.Sort();
-
   for (const auto &l : labels) {
     canvas.Select(l.bold ? *look.bold_font : *look.font);
 
@@ -459,6 +461,40 @@ MapWaypointLabelRender(Canvas &canvas, PixelSize clip_size,
   }
 }
 
+/**
+ * The radius of the range query relative to the screen distance.
+ */
+static constexpr double CANDIDATE_RANGE_FACTOR = 1.5;
+
+WaypointRenderer::~WaypointRenderer() noexcept = default;
+
+void
+WaypointRenderer::UpdateCandidates(const MapWindowProjection &projection) noexcept
+{
+  const GeoPoint center = projection.GetGeoScreenCenter();
+  const double screen_distance = projection.GetScreenDistanceMeters();
+
+  if (candidate_center.IsValid() &&
+      candidate_serial == way_points->GetSerial() &&
+      candidate_scale == projection.GetMapScale() &&
+      /* zoomed in too far, the list would be mostly useless */
+      candidate_radius <= screen_distance * CANDIDATE_RANGE_FACTOR * 2 &&
+      center.Distance(candidate_center) + screen_distance <= candidate_radius)
+    return;
+
+  candidate_center = center;
+  candidate_radius = screen_distance * CANDIDATE_RANGE_FACTOR;
+  candidate_scale = projection.GetMapScale();
+  candidate_serial = way_points->GetSerial();
+
+  candidates.clear();
+  way_points->VisitWithinRange(candidate_center, candidate_radius,
+                               [this, &projection](const auto &w){
+                                 if (projection.WaypointInScaleFilter(*w))
+                                   candidates.push_back(w);
+                               });
+}
+
 void
 WaypointRenderer::Render(Canvas &canvas, LabelBlock &label_block,
                          const MapWindowProjection &projection,
@@ -469,10 +505,15 @@ WaypointRenderer::Render(Canvas &canvas, LabelBlock &label_block,
                          const ProtectedTaskManager *task,
                          const ProtectedRoutePlanner *route_planner) noexcept
 {
-  if (way_points == nullptr || way_points->IsEmpty())
+  if (way_points == nullptr || way_points->IsEmpty()) {
+    labels.Clear();
     return;
+  }
+
+  UpdateCandidates(projection);
 
-  WaypointVisitorMap v(canvas, projection, settings, look, task_behaviour, basic);
+  WaypointVisitorMap v(canvas, projection, settings, look, task_behaviour, basic,
+                       labels);
 
   if (task != nullptr) {
     ProtectedTaskManager::Lease task_manager(*task);
@@ -489,14 +530,13 @@ WaypointRenderer::Render(Canvas &canvas, LabelBlock &label_block,
       atask->AcceptTaskPointVisitor(v);
   }
 
-  way_points->VisitWithinRange(projection.GetGeoScreenCenter(),
-                               projection.GetScreenDistanceMeters(),
-                               [&v](const auto &w){ v.Add(w); });
+  for (const auto &w : candidates)
+    v.Add(w);
 
   v.Calculate(route_planner, polar_settings, task_behaviour, calculated);
 
   v.Draw();
 
   MapWaypointLabelRender(canvas, projection.GetScreenSize(),
-                         label_block, v.labels, look);
+                         label_block, labels, look);
 }
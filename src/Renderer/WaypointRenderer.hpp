@@ -3,7 +3,13 @@
 
 #pragma once
 
+#include "WaypointLabelList.hpp"
+#include "Engine/Waypoint/Ptr.hpp"
+#include "Geo/GeoPoint.hpp"
 #include "util/NonCopyable.hpp"
+#include "util/Serial.hpp"
+
+#include <vector>
 
 struct WaypointRendererSettings;
 struct WaypointLook;
@@ -26,17 +32,48 @@ class WaypointRenderer : private NonCopyable {
 
   const WaypointLook &look;
 
+  /**
+   * The waypoints near the screen which pass the scale filter (see
+   * MapWindowProjection::WaypointInScaleFilter()).  The range query
+   * covers a circle larger than the screen, which allows reusing
+   * this list in the following frames as long as the screen stays
+   * inside the circle, instead of visiting the whole #Waypoints
+   * range each time.
+   */
+  std::vector<WaypointPtr> candidates;
+
+  GeoPoint candidate_center = GeoPoint::Invalid();
+  double candidate_radius, candidate_scale;
+  Serial candidate_serial;
+
+  /**
+   * The labels of the previous frame; see #WaypointLabelList.
+   */
+  WaypointLabelList labels;
+
 public:
   WaypointRenderer(const Waypoints *_way_points,
                    const WaypointLook &_look) noexcept
     :way_points(_way_points), look(_look) {}
 
+  ~WaypointRenderer() noexcept;
+
   const WaypointLook &GetLook() const noexcept {
     return look;
   }
 
   void SetWaypoints(const Waypoints *_way_points) noexcept {
     way_points = _way_points;
+    Invalidate();
+  }
+
+  /**
+   * Discard the cached waypoint list and labels.
+   */
+  void Invalidate() noexcept {
+    candidates.clear();
+    candidate_center.SetInvalid();
+    labels.Clear();
   }
 
   void Render(Canvas &canvas, LabelBlock &label_block,
@@ -47,4 +84,11 @@ public:
               const MoreData &basic, const DerivedInfo &calculated,
               const ProtectedTaskManager *task,
               const ProtectedRoutePlanner *route_planner) noexcept;
+
+private:
+  /**
+   * Refresh #candidates unless the current ones still cover the
+   * screen.
+   */
+  void UpdateCandidates(const MapWindowProjection &projection) noexcept;
 };
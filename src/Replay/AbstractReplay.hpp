@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "time/Stamp.hpp"
+
 struct NMEAInfo;
 
 class AbstractReplay 
@@ -11,4 +13,17 @@ public:
   virtual ~AbstractReplay() {}
 
   virtual bool Update(NMEAInfo &data) = 0;
+
+  /**
+   * Continue the replay at the specified time of day (or at a record
+   * shortly before it), in either direction.  The next Update() call
+   * returns the first record after the jump.
+   *
+   * Throws on I/O error.
+   *
+   * @return false if this replay does not support seeking
+   */
+  virtual bool Seek([[maybe_unused]] TimeStamp time) {
+    return false;
+  }
 };
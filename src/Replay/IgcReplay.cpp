@@ -4,11 +4,11 @@
 #include "Replay/IgcReplay.hpp"
 #include "IGC/IGCParser.hpp"
 #include "IGC/IGCFix.hpp"
-#include "io/LineReader.hpp"
+#include "io/FileLineReader.hpp"
 #include "NMEA/Info.hpp"
 #include "Units/System.hpp"
 
-IgcReplay::IgcReplay(std::unique_ptr<NLineReader> &&_reader)
+IgcReplay::IgcReplay(std::unique_ptr<FileLineReaderA> &&_reader)
   :reader(std::move(_reader))
 {
   extensions.clear();
@@ -24,7 +24,6 @@ IgcReplay::ScanBuffer(const char *buffer, IGCFix &fix, NMEAInfo &basic)
   if (IGCParseFix(buffer, extensions, fix) && fix.gps_valid)
     return true;
 
-  BrokenDate date;
   if (IGCParseDateRecord(buffer, date))
     basic.ProvideDate(date);
   else
@@ -46,11 +45,51 @@ IgcReplay::ReadPoint(IGCFix &fix, NMEAInfo &basic)
   return false;
 }
 
+void
+IgcReplay::BuildIndex()
+{
+  index.Clear();
+  reader->Rewind();
+
+  while (true) {
+    const long offset = reader->Tell();
+    const char *line = reader->ReadLine();
+    if (line == nullptr)
+      break;
+
+    BrokenTime time;
+    if (line[0] == 'B') {
+      if (IGCParseTime(line + 1, time))
+        index.Add(time.DurationSinceMidnight(), offset);
+    } else if (!IGCParseDateRecord(line, date))
+      IGCParseExtensions(line, extensions);
+  }
+}
+
+bool
+IgcReplay::Seek(TimeStamp time)
+{
+  if (index.empty()) {
+    BuildIndex();
+    if (index.empty())
+      return false;
+  }
+
+  reader->Seek(index.Find(time.Cast<std::chrono::seconds>()));
+  provide_date = date.IsPlausible();
+  return true;
+}
+
 bool
 IgcReplay::Update(NMEAInfo &basic)
 {
   IGCFix fix;
 
+  if (provide_date) {
+    provide_date = false;
+    basic.ProvideDate(date);
+  }
+
   while (true) {
     if (!ReadPoint(fix, basic))
       return false;
@@ -5,23 +5,39 @@
 
 #include "AbstractReplay.hpp"
 #include "IGC/IGCExtensions.hpp"
+#include "IGC/IGCIndex.hpp"
+#include "time/BrokenDate.hpp"
 
 #include <memory>
 
-class NLineReader;
+class FileLineReaderA;
 struct IGCFix;
 
 class IgcReplay: public AbstractReplay
 {
-  std::unique_ptr<NLineReader> reader;
+  std::unique_ptr<FileLineReaderA> reader;
 
   IGCExtensions extensions;
 
+  /**
+   * Built by the first Seek() call.
+   */
+  IGCIndex index;
+
+  /**
+   * The date from the file header, to be passed again after a
+   * Seek() has skipped it.  Invalid if not (yet) known.
+   */
+  BrokenDate date = BrokenDate::Invalid();
+
+  bool provide_date = false;
+
 public:
-  IgcReplay(std::unique_ptr<NLineReader> &&_reader);
+  IgcReplay(std::unique_ptr<FileLineReaderA> &&_reader);
   ~IgcReplay() override;
 
   bool Update(NMEAInfo &data) override;
+  bool Seek(TimeStamp time) override;
 
 private:
   /**
@@ -37,4 +53,10 @@ private:
    * @return false on end-of-file
    */
   bool ReadPoint(IGCFix &fix, NMEAInfo &basic);
+
+  /**
+   * Scan the whole file (only the time of each B record is parsed)
+   * and fill #index.  Leaves the file position undefined.
+   */
+  void BuildIndex();
 };
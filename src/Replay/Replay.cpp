@@ -5,6 +5,7 @@
 #include "IgcReplay.hpp"
 #include "NmeaReplay.hpp"
 #include "DemoReplayGlue.hpp"
+#include "Logger/CompressedNMEA.hpp"
 #include "io/FileLineReader.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Logger/Logger.hpp"
@@ -55,6 +56,9 @@ Replay::Start(Path _path)
 
     cli = new CatmullRomInterpolator(FloatDuration{0.98});
     cli->Reset();
+  } else if (path.EndsWithIgnoreCase(_T(".nmz"))) {
+    replay = new NmeaReplay(std::make_unique<CompressedNMEAReader>(path),
+                            CommonInterface::GetSystemSettings().devices[0]);
   } else {
     replay = new NmeaReplay(std::make_unique<FileLineReaderA>(path),
                             CommonInterface::GetSystemSettings().devices[0]);
@@ -70,6 +74,28 @@ Replay::Start(Path _path)
   timer.Schedule(std::chrono::milliseconds(100));
 }
 
+bool
+Replay::Seek(TimeStamp time)
+{
+  if (replay == nullptr || !replay->Seek(time))
+    return false;
+
+  /* start over with the first record after the jump, just like
+     Start() does */
+  if (cli != nullptr)
+    cli->Reset();
+
+  virtual_time = TimeStamp::Undefined();
+  fast_forward = TimeStamp::Undefined();
+  next_data.Reset();
+
+  if (logger != nullptr)
+    logger->ClearBuffer();
+
+  timer.Schedule(std::chrono::milliseconds(100));
+  return true;
+}
+
 bool
 Replay::Update()
 {
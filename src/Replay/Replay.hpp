@@ -111,6 +111,18 @@ public:
     }
   }
 
+  /**
+   * Jump to the specified time of day (forward or backward) without
+   * replaying the records in between; the computer sees a gap in the
+   * data.  Only IGC replays support this; they build an index on the
+   * first call.
+   *
+   * Throws on I/O error.
+   *
+   * @return false if the replay cannot seek
+   */
+  bool Seek(TimeStamp time);
+
   TimeStamp GetVirtualTime() const noexcept {
     return virtual_time;
   }
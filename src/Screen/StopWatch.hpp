@@ -3,9 +3,10 @@
 
 #pragma once
 
+#include "util/StaticArray.hxx"
+
 #ifdef STOP_WATCH
 
-#include "util/StaticArray.hxx"
 #include "LogFile.hpp"
 
 #ifdef HAVE_POSIX
@@ -18,14 +19,17 @@
 
 #endif /* STOP_WATCH */
 
+#include "Profiler.hpp"
+
 #ifdef ENABLE_OPENGL
 #include "ui/opengl/System.hpp"
 #endif
 
 /**
  * A stop watch which measures the time needed to perform an
- * operation, and writes it to the log file.  It is a no-op if the
- * macro STOP_WATCH is not defined.
+ * operation, and writes it to the log file.  Without the macro
+ * STOP_WATCH, it only measures while the #Profiler is enabled and
+ * submits the layer durations to it instead of logging them.
  */
 class ScreenStopWatch {
 #ifdef STOP_WATCH
@@ -130,12 +134,62 @@ public:
               (unsigned long)(end.clock - start.clock),
               (unsigned long)(end.cpu - start.cpu));
 
+    if (Profiler::IsEnabled()) {
+      for (unsigned i = 0; markers[i + 1].text != nullptr; ++i)
+        Profiler::AddLayer(markers[i].text,
+                           std::chrono::microseconds(markers[i + 1].clock -
+                                                     markers[i].clock));
+
+      Profiler::AddFrame(std::chrono::microseconds(end.clock - start.clock));
+    }
+
     markers.clear();
   }
 
 #else /* !STOP_WATCH */
+  struct Marker {
+    const char *text;
+    Profiler::Clock::time_point time;
+  };
+
+  StaticArray<Marker, 64u> markers;
+
+  static void FlushScreen() noexcept {
+#ifdef ENABLE_OPENGL
+    /* without this, the GPU time would be attributed to whichever
+       layer happens to block */
+    glFinish();
+#endif
+  }
+
 public:
-  void Mark([[maybe_unused]] const char *text) {}
-  void Finish() {}
+  void Mark(const char *text) noexcept {
+    if (!Profiler::IsEnabled()) {
+      markers.clear();
+      return;
+    }
+
+    if (markers.full())
+      return;
+
+    FlushScreen();
+    markers.push_back({text, Profiler::Clock::now()});
+  }
+
+  void Finish() noexcept {
+    if (markers.empty())
+      return;
+
+    FlushScreen();
+    const auto now = Profiler::Clock::now();
+
+    for (unsigned i = 0; i < markers.size(); ++i)
+      Profiler::AddLayer(markers[i].text,
+                         (i + 1 < markers.size() ? markers[i + 1].time : now)
+                         - markers[i].time);
+
+    Profiler::AddFrame(now - markers.front().time);
+    markers.clear();
+  }
 #endif /* !STOP_WATCH */
 };
@@ -52,7 +52,9 @@
 #include "CalculationThread.hpp"
 #include "Replay/Replay.hpp"
 #include "LocalPath.hpp"
+#include "system/ConvertPathName.hpp"
 #include "io/FileCache.hpp"
+#include "Job/Pool.hpp"
 #include "io/async/AsioThread.hpp"
 #include "io/async/GlobalAsioThread.hpp"
 #include "net/http/Init.hpp"
@@ -77,9 +79,13 @@
 #include "Operation/VerboseOperationEnvironment.hpp"
 #include "Operation/PluggableOperationEnvironment.hpp"
 #include "Operation/SubOperationEnvironment.hpp"
+#include "Operation/ParallelOperationEnvironment.hpp"
+#include "thread/ThreadPool.hpp"
 #include "Widget/ProgressWidget.hpp"
 #include "PageActions.hpp"
 #include "Weather/Features.hpp"
+#include "Weather/Stats.hpp"
+#include "StartupTrace.hpp"
 #include "Weather/NOAAGlue.hpp"
 #include "Weather/NOAAStore.hpp"
 #include "Plane/PlaneGlue.hpp"
@@ -111,15 +117,28 @@ static GlideComputerEvents *glide_computer_events;
 static AllMonitors *all_monitors;
 static GlideComputerTaskEvents *task_events;
 
+/**
+ * When Startup() and the terrain overview loader were started, for
+ * #StartupTrace.
+ */
+static std::chrono::steady_clock::time_point startup_time, terrain_start_time;
+
 static bool
 LoadProfile()
 {
-  if (Profile::GetPath() == nullptr &&
-      !dlgStartupShowModal())
-    return false;
+  if (Profile::GetPath() == nullptr) {
+    if (CommandLine::benchmark_startup)
+      /* no dialog: use the default profile */
+      Profile::SetFiles(nullptr);
+    else if (!dlgStartupShowModal())
+      return false;
+  }
 
-  Profile::Load();
-  Profile::Use(Profile::map);
+  {
+    const StartupTrace::Timer trace_timer{StartupStage::PROFILE};
+    Profile::Load();
+    Profile::Use(Profile::map);
+  }
 
   Units::SetConfig(CommonInterface::GetUISettings().format.units);
   SetUserCoordinateFormat(CommonInterface::GetUISettings().format.coordinate_format);
@@ -131,6 +150,7 @@ static void
 AfterStartup()
 {
   try {
+    const StartupTrace::Timer trace_timer{StartupStage::LUA};
     const auto lua_path = LocalPath(_T("lua"));
     Lua::StartFile(AllocatedPath::Build(lua_path, _T("init.lua")));
   } catch (...) {
@@ -162,6 +182,34 @@ AfterStartup()
   ForceCalculation();
 }
 
+/**
+ * Write the #StartupTrace report once Startup() has finished and the
+ * terrain overview has been loaded.
+ */
+static void
+CheckStartupTraceComplete() noexcept
+{
+  if (!StartupTrace::IsEnabled() || StartupTrace::IsComplete() ||
+      !global_running || terrain_loader != nullptr)
+    return;
+
+  if (CommandLine::benchmark_startup)
+    /* normally loaded on demand; include it in the benchmark */
+    LoadFlarmDatabases();
+
+  StartupTrace::Complete(std::chrono::steady_clock::now() - startup_time);
+
+  try {
+    const auto path = CommandLine::startup_trace_path != nullptr
+      ? AllocatedPath{PathName{CommandLine::startup_trace_path}}
+      : LocalPath(_T("startup-trace.txt"));
+    StartupTrace::WriteReport(path);
+    LogFormat(_T("Startup trace written to %s"), path.c_str());
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to write the startup trace");
+  }
+}
+
 void
 MainWindow::LoadTerrain() noexcept
 {
@@ -174,14 +222,18 @@ MainWindow::LoadTerrain() noexcept
       path != nullptr) {
     LogString("LoadTerrain");
     terrain_loader = new AsyncTerrainOverviewLoader();
+    terrain_start_time = std::chrono::steady_clock::now();
 
     terrain_loader_env = std::make_unique<PluggableOperationEnvironment>();
     auto *progress = new ProgressWidget(*terrain_loader_env,
                                         _("Loading Terrain File..."));
     SetTopWidget(progress);
 
-    terrain_loader->Start(file_cache, path, *terrain_loader_env,
-                          terrain_loader_notify);
+    bool warm_start = true;
+    Profile::Get(ProfileKeys::TerrainWarmStart, warm_start);
+
+    terrain_loader->Start(file_cache, path, warm_start,
+                          *terrain_loader_env, terrain_loader_notify);
   } else if (terrain != nullptr) {
     /* the map file has been disabled - remove the terrain from all
        subsystems and dispose the object */
@@ -204,6 +256,12 @@ try {
   auto new_terrain = loader->Wait();
   loader.reset();
 
+  if (StartupTrace::IsEnabled() && !StartupTrace::IsComplete())
+    /* the loader runs in a background job; only its duration is
+       known */
+    StartupTrace::Add(StartupStage::TERRAIN_OVERVIEW,
+                      std::chrono::steady_clock::now() - terrain_start_time);
+
   SetTopWidget(nullptr);
   terrain_loader_env.reset();
 
@@ -213,9 +271,90 @@ try {
   DataGlobals::SetTerrain(std::move(new_terrain));
   DataGlobals::UpdateHome(false);
 
+  /* the waypoints were loaded before the terrain was available */
+  if (const unsigned n = WaypointGlue::FillElevations(way_points, *terrain);
+      n > 0)
+    LogFormat("Waypoint elevations from terrain: %u", n);
+
   SetAirspaceGroundLevels(airspace_database, *terrain);
+
+  CheckStartupTraceComplete();
 } catch (...) {
   LogError(std::current_exception(), "LoadTerrain failed");
+  CheckStartupTraceComplete();
+}
+
+/**
+ * Load the topography, waypoint (with airfield details) and airspace
+ * files.  They do not depend on each other, so they are loaded in
+ * parallel.  The terrain is usually not available yet; the waypoint
+ * elevations are filled in by MainWindow::OnTerrainLoaded().
+ */
+static void
+LoadDataFiles(OperationEnvironment &operation,
+              const ComputerSettings &computer_settings) noexcept
+{
+  enum Job : unsigned {
+    WAYPOINTS,
+    AIRSPACE,
+    TOPOGRAPHY,
+    N_JOBS,
+  };
+
+  ParallelOperationEnvironment parallel(operation, N_JOBS);
+  ThreadPool pool{"Startup", ThreadPool::GetDefaultWorkers(N_JOBS - 1)};
+
+  pool.ForEach(N_JOBS, [&](std::size_t i){
+    auto &env = parallel[i];
+    env.SetProgressRange(1024);
+
+    try {
+      switch (Job(i)) {
+      case WAYPOINTS:
+        LogString("ReadWaypoints");
+        {
+          const StartupTrace::Timer trace_timer{StartupStage::WAYPOINTS};
+          SubOperationEnvironment sub_env(env, 0, 512);
+          sub_env.SetText(_("Loading Waypoints..."));
+          WaypointGlue::LoadWaypoints(way_points, terrain, file_cache,
+                                      sub_env);
+        }
+
+        // Read and parse the airfield info file
+        {
+          const StartupTrace::Timer trace_timer{StartupStage::WAYPOINT_DETAILS};
+          SubOperationEnvironment sub_env(env, 512, 1024);
+          sub_env.SetText(_("Loading Airfield Details File..."));
+          WaypointDetails::ReadFileFromProfile(way_points, sub_env);
+        }
+        break;
+
+      case AIRSPACE:
+        {
+          const StartupTrace::Timer trace_timer{StartupStage::AIRSPACE};
+          ReadAirspace(airspace_database, file_cache,
+                       computer_settings.pressure, env);
+        }
+        break;
+
+      case TOPOGRAPHY:
+        {
+          const StartupTrace::Timer trace_timer{StartupStage::TOPOGRAPHY};
+          LoadConfiguredTopography(*topography, env);
+        }
+        break;
+
+      case N_JOBS:
+        break;
+      }
+    } catch (...) {
+      LogError(std::current_exception());
+    }
+
+    env.SetProgressPosition(1024);
+  });
+
+  parallel.Flush();
 }
 
 /**
@@ -226,6 +365,11 @@ try {
 bool
 Startup(UI::Display &display)
 {
+  startup_time = std::chrono::steady_clock::now();
+  if (CommandLine::startup_trace_path != nullptr ||
+      CommandLine::benchmark_startup)
+    StartupTrace::Enable();
+
   VerboseOperationEnvironment operation;
   operation.SetProgressRange(1024);
 
@@ -330,6 +474,8 @@ Startup(UI::Display &display)
 
   file_cache = new FileCache(GetCachePath());
 
+  job_pool = new JobPool("JobPool", JobPool::GetDefaultWorkers());
+
   ReadLanguageFile();
 
   InputEvents::readFile();
@@ -385,27 +531,9 @@ Startup(UI::Display &display)
                          CommonInterface::SetComputerSettings(), gp);
   task_manager->SetGlidePolar(gp);
 
-  // Read the topography file(s)
+  // Read the topography, waypoint and airspace files
   topography = new TopographyStore();
-  {
-    SubOperationEnvironment sub_env(operation, 0, 256);
-    LoadConfiguredTopography(*topography, sub_env);
-  }
-
-  // Read the waypoint files
-  LogString("ReadWaypoints");
-  {
-    SubOperationEnvironment sub_env(operation, 256, 512);
-    sub_env.SetText(_("Loading Waypoints..."));
-    WaypointGlue::LoadWaypoints(way_points, terrain, sub_env);
-  }
-
-  // Read and parse the airfield info file
-  {
-    SubOperationEnvironment sub_env(operation, 512, 768);
-    sub_env.SetText(_("Loading Airfield Details File..."));
-    WaypointDetails::ReadFileFromProfile(way_points, sub_env);
-  }
+  LoadDataFiles(operation, computer_settings);
 
   // Set the home waypoint
   WaypointGlue::SetHome(way_points, terrain,
@@ -425,13 +553,6 @@ Startup(UI::Display &display)
   LogFormat("Skysight load");
   auto skysight = std::make_shared<Skysight>(*Net::curl);
 
-  // Reads the airspace files
-  {
-    SubOperationEnvironment sub_env(operation, 768, 1024);
-    ReadAirspace(airspace_database, computer_settings.pressure,
-                 sub_env);
-  }
-
   if (terrain != nullptr)
     SetAirspaceGroundLevels(airspace_database, *terrain);
 
@@ -498,6 +619,8 @@ Startup(UI::Display &display)
   // Create the drawing thread
 #ifndef ENABLE_OPENGL
   draw_thread = new DrawThread(*map_window);
+  draw_thread->SetFrameRate(ui_settings.display.map_frame_rate,
+                            ui_settings.display.map_static_scene);
   draw_thread->Start(true);
 #endif
 
@@ -518,6 +641,7 @@ Startup(UI::Display &display)
     flight_logger->SetPath(LocalPath(_T("flights.log")));
   }
 
+  nmea_logger->SetCompressed(computer_settings.logger.compress_nmea_log);
   if (computer_settings.logger.enable_nmea_logger)
     nmea_logger->Enable();
 
@@ -528,6 +652,7 @@ Startup(UI::Display &display)
 
   // Start calculation thread
   merge_thread->Start();
+  calculation_thread->LoadContestCheckpoint();
   calculation_thread->Start();
 
   PageActions::Update();
@@ -542,6 +667,7 @@ Startup(UI::Display &display)
 #endif
   if (map_window != nullptr)
     map_window->SetJETProviderData(&tracking->GetJETProviderData());
+  glide_computer->SetJETProviderData(&tracking->GetJETProviderData());
 
 #endif
 
@@ -560,6 +686,8 @@ Startup(UI::Display &display)
 
   main_window->FinishStartup();
 
+  CheckStartupTraceComplete();
+
   return true;
 }
 
@@ -611,6 +739,7 @@ Shutdown()
   // Save settings to profile
   operation.SetText(_("Shutdown, saving profile..."));
   Profile::Save();
+  Profile::Flush();
 
   operation.SetText(_("Shutdown, please wait..."));
 
@@ -648,6 +777,11 @@ Shutdown()
     calculation_thread = nullptr;
   }
 
+  /* wait for the reach calculation, which may still use the terrain
+     deleted below */
+  if (glide_computer != nullptr)
+    glide_computer->SetTerrain(nullptr);
+
   //  Wait for the drawing thread to finish
 #ifndef ENABLE_OPENGL
   LogString("Waiting for draw thread");
@@ -687,6 +821,19 @@ Shutdown()
 
   delete terrain_loader;
   terrain_loader = nullptr;
+
+  if (terrain != nullptr)
+    terrain->LogStats();
+
+  WeatherStats::Log();
+
+  if (terrain != nullptr && file_cache != nullptr) {
+    bool warm_start = true;
+    Profile::Get(ProfileKeys::TerrainWarmStart, warm_start);
+    if (warm_start)
+      terrain->SaveTiles(*file_cache);
+  }
+
   delete terrain;
   terrain = nullptr;
   delete topography;
@@ -748,6 +895,9 @@ Shutdown()
   // Destroy FlarmNet records
   DeinitTrafficGlobals();
 
+  delete job_pool;
+  job_pool = nullptr;
+
   delete file_cache;
   file_cache = nullptr;
 
@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "StartupTrace.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "thread/Mutex.hxx"
+#include "system/Path.hpp"
+#include "util/StringAPI.hxx"
+#include "util/StringCompare.hxx"
+#include "util/NumberParser.hpp"
+
+#ifdef __linux__
+#include "io/UniqueFileDescriptor.hxx"
+#endif
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace StartupTrace {
+
+/**
+ * The number of "operator new" calls in this thread.  A plain
+ * integer; the replacement operator below must be as cheap as
+ * possible because it is also used when the trace is disabled.
+ */
+static thread_local uint_least64_t thread_allocations;
+
+static std::atomic_bool enabled{false};
+
+struct StageData {
+  unsigned count = 0;
+  Duration duration{};
+  Counters counters{};
+  bool have_counters = true;
+};
+
+static Mutex mutex;
+static std::array<StageData, std::size_t(StartupStage::COUNT)> stages;
+static bool complete = false;
+static Duration total_duration{};
+
+static constexpr const char *stage_names[] = {
+  "Profile",
+  "Fonts",
+  "Terrain overview",
+  "Topography",
+  "Waypoints",
+  "Waypoint details",
+  "Airspace",
+  "FlarmNet",
+  "Lua init",
+};
+
+static_assert(std::size(stage_names) == std::size_t(StartupStage::COUNT));
+
+void
+Enable() noexcept
+{
+  enabled.store(true, std::memory_order_relaxed);
+}
+
+bool
+IsEnabled() noexcept
+{
+  return enabled.load(std::memory_order_relaxed);
+}
+
+#ifdef __linux__
+
+/**
+ * Parse the value of a "name: value" line of /proc/PID/io.
+ */
+static uint_least64_t
+FindIOValue(const char *data, const char *name) noexcept
+{
+  const char *p = StringFind(data, name);
+  if (p == nullptr)
+    return 0;
+
+  p = StringAfterPrefix(p, name);
+  if (p == nullptr || *p != ':')
+    return 0;
+
+  return ParseUint64(p + 1);
+}
+
+#endif
+
+Counters
+GetThreadCounters() noexcept
+{
+  Counters c{};
+  c.allocations = thread_allocations;
+
+#ifdef __linux__
+  UniqueFileDescriptor fd;
+  if (fd.OpenReadOnly("/proc/thread-self/io")) {
+    char buffer[512];
+    const auto nbytes = fd.Read(buffer, sizeof(buffer) - 1);
+    if (nbytes > 0) {
+      buffer[nbytes] = 0;
+      c.read_bytes = FindIOValue(buffer, "rchar");
+      c.storage_bytes = FindIOValue(buffer, "read_bytes");
+      c.have_io = true;
+    }
+  }
+#endif
+
+  return c;
+}
+
+void
+Add(StartupStage stage, Duration duration, const Counters &counters) noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+  auto &s = stages[std::size_t(stage)];
+
+  ++s.count;
+  s.duration += duration;
+  s.counters.read_bytes += counters.read_bytes;
+  s.counters.storage_bytes += counters.storage_bytes;
+  s.counters.allocations += counters.allocations;
+  s.counters.have_io = s.count == 1
+    ? counters.have_io
+    : s.counters.have_io && counters.have_io;
+}
+
+void
+Add(StartupStage stage, Duration duration) noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+  auto &s = stages[std::size_t(stage)];
+
+  ++s.count;
+  s.duration += duration;
+  s.have_counters = false;
+}
+
+Snapshot
+Get(StartupStage stage) noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+  const auto &s = stages[std::size_t(stage)];
+
+  Snapshot snapshot;
+  snapshot.count = s.count;
+  snapshot.duration = s.duration;
+  snapshot.counters = s.counters;
+  snapshot.have_counters = s.have_counters;
+  return snapshot;
+}
+
+const char *
+GetStageName(StartupStage stage) noexcept
+{
+  return stage_names[std::size_t(stage)];
+}
+
+void
+Complete(Duration total) noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+  complete = true;
+  total_duration = total;
+}
+
+bool
+IsComplete() noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+  return complete;
+}
+
+static constexpr unsigned long
+ToMilliseconds(Duration d) noexcept
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+}
+
+void
+WriteReport(Path path)
+{
+  FileOutputStream file(path);
+  BufferedOutputStream os(file);
+
+  Duration total;
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    total = total_duration;
+  }
+
+  os.Fmt("# XCSoar startup trace\n"
+         "# total {} ms\n"
+         "# stage\tcount\tms\tread kB\tstorage kB\tallocations\n",
+         ToMilliseconds(total));
+
+  for (std::size_t i = 0; i < std::size_t(StartupStage::COUNT); ++i) {
+    const auto stage = StartupStage(i);
+    const auto s = Get(stage);
+
+    os.Fmt("{}\t{}\t{}", GetStageName(stage), s.count,
+           ToMilliseconds(s.duration));
+
+    if (s.count > 0 && s.have_counters && s.counters.have_io)
+      os.Fmt("\t{}\t{}", s.counters.read_bytes / 1024,
+             s.counters.storage_bytes / 1024);
+    else
+      os.Write("\t-\t-");
+
+    if (s.count > 0 && s.have_counters)
+      os.Fmt("\t{}\n", s.counters.allocations);
+    else
+      os.Write("\t-\n");
+  }
+
+  os.Flush();
+  file.Commit();
+}
+
+} // namespace StartupTrace
+
+/* count allocations for StartupTrace::GetThreadCounters(); the other
+   variants (nothrow, arrays) of the standard library call this one */
+
+void *
+operator new(std::size_t size)
+{
+  ++StartupTrace::thread_allocations;
+
+  if (size == 0)
+    size = 1;
+
+  while (true) {
+    if (void *p = std::malloc(size))
+      return p;
+
+    auto handler = std::get_new_handler();
+    if (handler == nullptr)
+      throw std::bad_alloc{};
+
+    handler();
+  }
+}
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+class Path;
+
+/**
+ * The loading stages of Startup() which are measured by
+ * #StartupTrace.
+ */
+enum class StartupStage : uint8_t {
+  PROFILE,
+  FONTS,
+
+  /**
+   * Opening the terrain file and loading its overview.  This runs in
+   * a background job; only its duration is known.
+   */
+  TERRAIN_OVERVIEW,
+
+  TOPOGRAPHY,
+  WAYPOINTS,
+  WAYPOINT_DETAILS,
+  AIRSPACE,
+  FLARMNET,
+  LUA,
+
+  COUNT
+};
+
+/**
+ * Records the duration, bytes read and allocations of each startup
+ * stage, to find out where the startup time goes on a device.
+ * Nothing is recorded unless Enable() was called (command line
+ * option "-startup-trace").
+ *
+ * Bytes and allocations are counted for the thread which runs the
+ * stage (stages may run in parallel): bytes read by system calls
+ * (Linux only, from /proc/thread-self/io, which does not include
+ * memory-mapped files) and "operator new" calls (not malloc()).
+ *
+ * All functions are thread-safe.
+ */
+namespace StartupTrace {
+
+using Duration = std::chrono::steady_clock::duration;
+
+/**
+ * Per-thread counters, see GetThreadCounters().
+ */
+struct Counters {
+  /**
+   * Bytes returned by read() and similar system calls, and the
+   * part of it which had to be fetched from the storage device.
+   */
+  uint_least64_t read_bytes, storage_bytes;
+
+  uint_least64_t allocations;
+
+  /**
+   * False if the I/O counters are not available on this platform.
+   */
+  bool have_io;
+
+  constexpr Counters operator-(const Counters &other) const noexcept {
+    return {
+      read_bytes - other.read_bytes,
+      storage_bytes - other.storage_bytes,
+      allocations - other.allocations,
+      have_io && other.have_io,
+    };
+  }
+};
+
+struct Snapshot {
+  /**
+   * How often this stage was run (e.g. fonts are reloaded when a
+   * display scale is configured).
+   */
+  unsigned count;
+
+  Duration duration;
+
+  Counters counters;
+
+  /**
+   * False if the counters are not known because the stage was run
+   * by a thread which could not be measured.
+   */
+  bool have_counters;
+};
+
+void
+Enable() noexcept;
+
+[[gnu::pure]]
+bool
+IsEnabled() noexcept;
+
+[[gnu::pure]]
+Counters
+GetThreadCounters() noexcept;
+
+void
+Add(StartupStage stage, Duration duration, const Counters &counters) noexcept;
+
+/**
+ * Record a stage whose counters are not known.
+ */
+void
+Add(StartupStage stage, Duration duration) noexcept;
+
+[[gnu::pure]]
+Snapshot
+Get(StartupStage stage) noexcept;
+
+/**
+ * Returns a short untranslated name for the report.
+ */
+[[gnu::const]]
+const char *
+GetStageName(StartupStage stage) noexcept;
+
+/**
+ * Mark the startup as complete (all stages have been recorded) and
+ * remember its total duration.
+ */
+void
+Complete(Duration total) noexcept;
+
+[[gnu::pure]]
+bool
+IsComplete() noexcept;
+
+/**
+ * Write the report to the specified file.
+ *
+ * Throws on error.
+ */
+void
+WriteReport(Path path);
+
+/**
+ * Measures one run of a stage in the current thread from
+ * construction to destruction.  Does nothing if the trace is not
+ * enabled.
+ */
+class Timer {
+  const StartupStage stage;
+  const bool enabled;
+  std::chrono::steady_clock::time_point start;
+  Counters start_counters;
+
+public:
+  explicit Timer(StartupStage _stage) noexcept
+    :stage(_stage), enabled(IsEnabled())
+  {
+    if (enabled) {
+      start_counters = GetThreadCounters();
+      start = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~Timer() noexcept {
+    if (enabled)
+      Add(stage, std::chrono::steady_clock::now() - start,
+          GetThreadCounters() - start_counters);
+  }
+
+  Timer(const Timer &) = delete;
+  Timer &operator=(const Timer &) = delete;
+};
+
+} // namespace StartupTrace
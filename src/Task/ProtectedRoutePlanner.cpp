@@ -41,22 +41,62 @@ ProtectedRoutePlanner::SolveReach(const AGeoPoint &origin,
                                   const int h_ceiling,
                                   const bool do_solve) noexcept
 {
-  /* these local variables help avoid locking both mutexes at the same
-     time */
-  ReachFan rt, rw;
+  /* these local variables help avoid locking route_mutex together
+     with the others */
+  RoutePolars rpolars_terrain, rpolars_working;
+  const RasterTerrain *terrain;
 
   {
+    /* only copy the configured polars while holding this lock; the
+       expensive reach calculation below doesn't need the planner, and
+       would block SolveRoute() and SetPolars() */
     const std::scoped_lock lock{route_mutex};
-    rt = route_planner.SolveReach(origin, config, h_ceiling, do_solve, false);
-    rw = route_planner.SolveReach(origin, config, h_ceiling, do_solve, true);
-    rpolars_reach = route_planner.GetReachPolar();
+    rpolars_terrain = route_planner.PrepareReach(origin, config, h_ceiling,
+                                                 false);
+    rpolars_working = route_planner.PrepareReach(origin, config, h_ceiling,
+                                                 true);
+    terrain = route_planner.GetTerrain();
   }
 
+  const std::scoped_lock solve_lock{solve_mutex};
+
+  /* the mask is rebuilt each time (its cost is bounded by its size),
+     but a new solve is only needed if it has changed */
+  ReachAirspaceMask airspace;
+  if (do_solve && config.IsReachAirspaceEnabled())
+    RoutePlannerGlue::BuildReachAirspace(airspace, airspaces, warnings,
+                                         origin);
+
+  if (airspace != solve_airspace) {
+    solve_airspace = std::move(airspace);
+    solve_terrain.Reset();
+    solve_working.Reset();
+  }
+
+  const auto *for_each = reach_for_each ? &reach_for_each : nullptr;
+  const auto *mask = solve_airspace.IsEmpty() ? nullptr : &solve_airspace;
+  const bool modified_terrain =
+    RoutePlannerGlue::UpdateReach(solve_terrain, terrain, origin,
+                                  rpolars_terrain, do_solve, for_each, mask);
+  const bool modified_working =
+    RoutePlannerGlue::UpdateReach(solve_working, terrain, origin,
+                                  rpolars_working, do_solve, for_each, mask);
+
   /* we lock this mutex not during the expensive reach calculation,
-     but only for moving the result to the mutex-protected fields */
+     but only for copying the result to the mutex-protected fields */
   const std::scoped_lock lock{reach_mutex};
-  reach_terrain = std::move(rt);
-  reach_working = std::move(rw);
+  if (!modified_terrain && !modified_working && !reach_terrain.IsEmpty()) {
+    /* unchanged and already published (not cleared by
+       ClearReach()); only the arrival correction for the new
+       origin needs to be copied */
+    reach_terrain.CopyArrivalLoss(solve_terrain);
+    reach_working.CopyArrivalLoss(solve_working);
+    return;
+  }
+
+  reach_terrain = solve_terrain;
+  reach_working = solve_working;
+  rpolars_reach = rpolars_terrain;
 }
 
 const FlatProjection
@@ -5,6 +5,7 @@
 
 #include "RoutePlannerGlue.hpp"
 #include "Engine/Route/ReachFan.hpp"
+#include "Engine/Route/ReachAirspaceMask.hpp"
 #include "Engine/Route/RoutePolars.hpp"
 #include "thread/Mutex.hxx"
 
@@ -37,6 +38,26 @@ class ProtectedRoutePlanner
   ReachFan reach_terrain;
   ReachFan reach_working;
 
+  /**
+   * This mutex protects the solver's copies of the reach, which are
+   * updated incrementally by SolveReach() and then published to the
+   * "reach" fields.
+   */
+  Mutex solve_mutex;
+  ReachFan solve_terrain;
+  ReachFan solve_working;
+
+  /**
+   * The airspace obstacles of the solver's reach (see
+   * RoutePlannerConfig::reach_airspace).  Protected by #solve_mutex.
+   */
+  ReachAirspaceMask solve_airspace;
+
+  /**
+   * See SetReachForEach().  Protected by #solve_mutex.
+   */
+  FlatTriangleFanTree::ForEachFunction reach_for_each;
+
 public:
   ProtectedRoutePlanner(RoutePlannerGlue &route, const Airspaces &_airspaces,
                         const ProtectedAirspaceWarningManager *_warnings) noexcept
@@ -46,6 +67,13 @@ public:
   void Reset() noexcept {
     ClearReach();
 
+    {
+      const std::scoped_lock lock{solve_mutex};
+      solve_terrain.Reset();
+      solve_working.Reset();
+      solve_airspace.Clear();
+    }
+
     const std::scoped_lock lock{route_mutex};
     route_planner.Reset();
   }
@@ -64,6 +92,16 @@ public:
 
   void SetTerrain(const RasterTerrain *terrain) noexcept;
 
+  /**
+   * Install a function which expands the reach fan trees of
+   * SolveReach() in parallel, e.g. on a #ThreadPool.  The result
+   * does not depend on it.
+   */
+  void SetReachForEach(FlatTriangleFanTree::ForEachFunction &&for_each) noexcept {
+    const std::scoped_lock lock{solve_mutex};
+    reach_for_each = std::move(for_each);
+  }
+
   void SetPolars(const GlideSettings &settings,
                  const RoutePlannerConfig &config,
                  const GlidePolar &glide_polar, const GlidePolar &safety_polar,
@@ -74,6 +112,10 @@ public:
                   const RoutePlannerConfig &config,
                   int h_ceiling) noexcept;
 
+  /**
+   * Update the reach from the given origin.  The previous solution
+   * is kept while it is still valid (see ReachFan::Update()).
+   */
   void SolveReach(const AGeoPoint &origin, const RoutePlannerConfig &config,
                   int h_ceiling, bool do_solve) noexcept;
 
@@ -116,8 +116,18 @@ ProtectedTaskManager::DoGoto(WaypointPtr &&wp)
 std::unique_ptr<OrderedTask>
 ProtectedTaskManager::TaskClone() const noexcept
 {
-  Lease lease(*this);
-  return lease->Clone(task_behaviour);
+  std::unique_ptr<OrderedTask> task;
+
+  {
+    /* copy only the task definition while holding the lock; the
+       calculation thread doesn't need to wait for the geometry of
+       the copy to be calculated */
+    Lease lease(*this);
+    task = lease->CloneDefinition(task_behaviour);
+  }
+
+  task->UpdateGeometry();
+  return task;
 }
 
 bool
@@ -7,6 +7,7 @@
 #include "Engine/Airspace/Predicate/AirspacePredicate.hpp"
 #include "Engine/Route/ReachResult.hpp"
 #include "Route/ReachFan.hpp"
+#include "Route/ReachAirspaceMask.hpp"
 
 void
 RoutePlannerGlue::SetTerrain(const RasterTerrain *_terrain)
@@ -45,20 +46,37 @@ RoutePlannerGlue::Solve(const AGeoPoint &origin,
   return planner.Solve(origin, destination, config, h_ceiling);
 }
 
-ReachFan
-RoutePlannerGlue::SolveReach(const AGeoPoint &origin,
-                             const RoutePlannerConfig &config,
-                             const int h_ceiling, const bool do_solve,
-                             const bool working) noexcept
+bool
+RoutePlannerGlue::UpdateReach(ReachFan &reach, const RasterTerrain *terrain,
+                              const AGeoPoint &origin,
+                              const RoutePolars &rpolars,
+                              const bool do_solve,
+                              const FlatTriangleFanTree::ForEachFunction *for_each,
+                              const ReachAirspaceMask *airspace) noexcept
 {
   if (terrain) {
     RasterTerrain::Lease lease(*terrain);
-    return planner.SolveReach(origin, config, h_ceiling, do_solve, working);
+    return reach.Update(origin, rpolars, &terrain->map, do_solve, for_each,
+                        airspace);
   } else {
-    return planner.SolveReach(origin, config, h_ceiling, do_solve, working);
+    return reach.Update(origin, rpolars, nullptr, do_solve, for_each,
+                        airspace);
   }
 }
 
+void
+RoutePlannerGlue::BuildReachAirspace(ReachAirspaceMask &mask,
+                                     const Airspaces &master,
+                                     const ProtectedAirspaceWarningManager *warnings,
+                                     const AGeoPoint &origin) noexcept
+{
+  /* ignore acked airspaces (if we have an AirspaceWarningManager) */
+  const auto predicate =
+    WrapAirspacePredicate(ActiveAirspacePredicate(warnings));
+
+  mask.Build(master, predicate, origin);
+}
+
 GeoPoint
 RoutePlannerGlue::Intersection(const AGeoPoint &origin,
                                const AGeoPoint &destination) const
@@ -66,3 +84,12 @@ RoutePlannerGlue::Intersection(const AGeoPoint &origin,
   RasterTerrain::Lease lease(*terrain);
   return planner.Intersection(origin, destination);
 }
+
+void
+RoutePlannerGlue::CalcGlideClearance(const AGeoPoint &origin,
+                                     const AGeoPoint &destination,
+                                     GlideClearanceProfile &profile) const
+{
+  RasterTerrain::Lease lease(*terrain);
+  planner.CalcGlideClearance(origin, destination, profile);
+}
@@ -4,10 +4,12 @@
 #pragma once
 
 #include "Route/AirspaceRoute.hpp"
+#include "Route/FlatTriangleFanTree.hpp"
 
 struct GlideSettings;
 class RasterTerrain;
 class ProtectedAirspaceWarningManager;
+class ReachAirspaceMask;
 
 class RoutePlannerGlue {
   const RasterTerrain *terrain = nullptr;
@@ -43,9 +45,41 @@ public:
     return planner.GetSolution();
   }
 
-  [[gnu::pure]]
-  ReachFan SolveReach(const AGeoPoint &origin, const RoutePlannerConfig &config,
-                      int h_ceiling, bool do_solve, bool working) noexcept;
+  const RasterTerrain *GetTerrain() const noexcept {
+    return terrain;
+  }
+
+  /**
+   * @see TerrainRoute::PrepareReach()
+   */
+  RoutePolars PrepareReach(const AGeoPoint &origin,
+                           const RoutePlannerConfig &config,
+                           int h_ceiling, bool working) noexcept {
+    return planner.PrepareReach(origin, config, h_ceiling, working);
+  }
+
+  /**
+   * Update the reach (see ReachFan::Update()) with a polar obtained
+   * from PrepareReach().  This doesn't access the planner, so its
+   * lock doesn't need to be held, only the terrain is locked.
+   *
+   * @return true if the reach was recalculated
+   */
+  static bool UpdateReach(ReachFan &reach, const RasterTerrain *terrain,
+                          const AGeoPoint &origin,
+                          const RoutePolars &rpolars,
+                          bool do_solve,
+                          const FlatTriangleFanTree::ForEachFunction *for_each,
+                          const ReachAirspaceMask *airspace) noexcept;
+
+  /**
+   * Rasterize the airspaces which the reach shall avoid: the same
+   * ones as Synchronise() passes to the route planner.
+   */
+  static void BuildReachAirspace(ReachAirspaceMask &mask,
+                                 const Airspaces &master,
+                                 const ProtectedAirspaceWarningManager *warnings,
+                                 const AGeoPoint &origin) noexcept;
 
   const auto &GetReachPolar() const noexcept {
     return planner.GetReachPolar();
@@ -54,4 +88,8 @@ public:
   [[gnu::pure]]
   GeoPoint Intersection(const AGeoPoint &origin,
                         const AGeoPoint &destination) const;
+
+  void CalcGlideClearance(const AGeoPoint &origin,
+                          const AGeoPoint &destination,
+                          GlideClearanceProfile &profile) const;
 };
@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TaskIndex.hpp"
+#include "system/Path.hpp"
+#include "system/FileUtil.hpp"
+#include "io/FileMapping.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "util/tstring_view.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+static constexpr uint32_t MAGIC = 0x54534931; // "TSI1"
+
+/**
+ * The file starts with this header, followed by the entries.  Each
+ * entry is: path (string), size (uint64_t), modification time
+ * (int64_t microseconds), number of tasks (uint16_t) and the tasks.
+ * Each task is: name (string), flags (uint8_t), factory type
+ * (uint8_t), number of turn points (uint16_t) and the nominal
+ * distance (double).  A string is a uint16_t length followed by
+ * that many TCHARs.
+ */
+struct IndexHeader {
+  uint32_t magic;
+
+  /**
+   * sizeof(TCHAR), which depends on the platform.
+   */
+  uint32_t char_size;
+
+  uint32_t n_entries;
+
+  uint32_t reserved;
+};
+
+static constexpr uint8_t FLAG_SUMMARY = 0x1;
+
+using Microseconds = std::chrono::duration<int64_t, std::micro>;
+
+namespace {
+
+class IndexReader {
+  std::span<const std::byte> data;
+
+public:
+  explicit IndexReader(std::span<const std::byte> _data) noexcept
+    :data(_data) {}
+
+  template<typename T>
+  T Read() {
+    if (data.size() < sizeof(T))
+      throw std::runtime_error("Truncated task index");
+
+    T value;
+    memcpy(&value, data.data(), sizeof(value));
+    data = data.subspan(sizeof(value));
+    return value;
+  }
+
+  tstring ReadString() {
+    const std::size_t length = Read<uint16_t>();
+    if (data.size() < length * sizeof(TCHAR))
+      throw std::runtime_error("Truncated task index");
+
+    tstring value(length, _T('\0'));
+    memcpy(value.data(), data.data(), length * sizeof(TCHAR));
+    data = data.subspan(length * sizeof(TCHAR));
+    return value;
+  }
+};
+
+} // anonymous namespace
+
+static void
+WriteString(BufferedOutputStream &os, tstring_view value)
+{
+  if (value.size() > 0xffff)
+    throw std::runtime_error("String too long");
+
+  os.WriteT(uint16_t(value.size()));
+  os.Write(std::as_bytes(std::span{value.data(), value.size()}));
+}
+
+static std::chrono::system_clock::time_point
+TruncateTime(std::chrono::system_clock::time_point t) noexcept
+{
+  /* the file stores microseconds; truncate so the comparison in
+     Lookup() works with values which have been saved and loaded */
+  return std::chrono::system_clock::time_point{
+    std::chrono::duration_cast<std::chrono::system_clock::duration>(
+      std::chrono::duration_cast<Microseconds>(t.time_since_epoch()))
+  };
+}
+
+void
+TaskIndex::Load(Path path) noexcept
+{
+  entries.clear();
+  modified = false;
+
+  try {
+    FileMapping mapping(path);
+    IndexReader r(mapping);
+
+    const auto header = r.Read<IndexHeader>();
+    if (header.magic != MAGIC || header.char_size != sizeof(TCHAR))
+      return;
+
+    for (unsigned i = 0; i < header.n_entries; ++i) {
+      auto key = r.ReadString();
+
+      Entry entry;
+      entry.size = r.Read<uint64_t>();
+      entry.mtime = TruncateTime(std::chrono::system_clock::time_point{
+          std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            Microseconds(r.Read<int64_t>()))});
+      entry.used = false;
+
+      const unsigned n_tasks = r.Read<uint16_t>();
+      entry.tasks.reserve(n_tasks);
+      for (unsigned j = 0; j < n_tasks; ++j) {
+        Task task;
+        task.name = r.ReadString();
+
+        const auto flags = r.Read<uint8_t>();
+        const auto type = r.Read<uint8_t>();
+        task.summary.n_points = r.Read<uint16_t>();
+        task.summary.distance = r.Read<double>();
+        task.summary.defined = (flags & FLAG_SUMMARY) != 0 &&
+          type < unsigned(TaskFactoryType::COUNT);
+        task.summary.type = TaskFactoryType(type);
+
+        entry.tasks.emplace_back(std::move(task));
+      }
+
+      entries.insert_or_assign(std::move(key), std::move(entry));
+    }
+  } catch (...) {
+    /* no (valid) index file: start from scratch */
+    entries.clear();
+  }
+}
+
+void
+TaskIndex::Save(Path path)
+{
+  FileOutputStream file(path);
+  BufferedOutputStream os(file);
+
+  const IndexHeader header{
+    MAGIC, sizeof(TCHAR), uint32_t(entries.size()), 0,
+  };
+  os.WriteT(header);
+
+  for (const auto &[key, entry] : entries) {
+    WriteString(os, key);
+    os.WriteT(entry.size);
+    const auto mtime = std::chrono::duration_cast<Microseconds>(entry.mtime.time_since_epoch());
+    os.WriteT(int64_t(mtime.count()));
+
+    os.WriteT(uint16_t(entry.tasks.size()));
+    for (const auto &task : entry.tasks) {
+      WriteString(os, task.name);
+      os.WriteT(uint8_t(task.summary.defined ? FLAG_SUMMARY : 0));
+      os.WriteT(uint8_t(task.summary.defined
+                        ? task.summary.type
+                        : TaskFactoryType::COUNT));
+      os.WriteT(uint16_t(task.summary.defined
+                         ? std::min(task.summary.n_points, 0xffffu)
+                         : 0));
+      os.WriteT(task.summary.defined ? task.summary.distance : 0.);
+    }
+  }
+
+  os.Flush();
+  file.Commit();
+
+  modified = false;
+}
+
+const TaskIndex::Entry *
+TaskIndex::Lookup(Path path, uint64_t size,
+                  std::chrono::system_clock::time_point mtime) noexcept
+{
+  auto i = entries.find(tstring_view{path.c_str()});
+  if (i == entries.end())
+    return nullptr;
+
+  auto &entry = i->second;
+  if (entry.size != size || entry.mtime != TruncateTime(mtime))
+    return nullptr;
+
+  entry.used = true;
+  return &entry;
+}
+
+void
+TaskIndex::Put(Path path, uint64_t size,
+               std::chrono::system_clock::time_point mtime,
+               std::vector<tstring> &&names) noexcept
+{
+  Entry entry;
+  entry.size = size;
+  entry.mtime = TruncateTime(mtime);
+  entry.used = true;
+
+  /* the file format has a 16 bit task counter */
+  if (names.size() > 0xffff)
+    names.resize(0xffff);
+
+  entry.tasks.reserve(names.size());
+  for (auto &name : names)
+    entry.tasks.push_back({std::move(name), {}});
+
+  entries.insert_or_assign(tstring{path.c_str()}, std::move(entry));
+  modified = true;
+}
+
+void
+TaskIndex::SetSummary(Path path, unsigned index,
+                      const Summary &summary) noexcept
+{
+  auto i = entries.find(tstring_view{path.c_str()});
+  if (i == entries.end() || index >= i->second.tasks.size())
+    return;
+
+  i->second.tasks[index].summary = summary;
+  modified = true;
+}
+
+void
+TaskIndex::RemoveUnused() noexcept
+{
+  modified |= std::erase_if(entries, [](const auto &i){
+    return !i.second.used && !File::Exists(Path{i.first.c_str()});
+  }) > 0;
+}
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Task/Factory/TaskFactoryType.hpp"
+#include "util/tstring.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+class Path;
+
+/**
+ * A compact binary cache of the tasks contained in each task file,
+ * which allows #TaskStore to list unchanged files without parsing
+ * them.  Each task may also carry a summary which is filled in the
+ * first time the task gets parsed (i.e. selected).
+ *
+ * Entries are keyed by the absolute path and validated with the file
+ * size and modification time.
+ */
+class TaskIndex {
+public:
+  struct Summary {
+    bool defined = false;
+
+    TaskFactoryType type;
+
+    /**
+     * The number of turn points.
+     */
+    unsigned n_points;
+
+    /**
+     * The nominal task distance [m].
+     */
+    double distance;
+  };
+
+  struct Task {
+    tstring name;
+
+    Summary summary;
+  };
+
+  struct Entry {
+    uint64_t size;
+
+    std::chrono::system_clock::time_point mtime;
+
+    std::vector<Task> tasks;
+
+    /**
+     * Was this entry looked up or updated since Load()?
+     */
+    bool used;
+  };
+
+private:
+  std::map<tstring, Entry, std::less<>> entries;
+
+  bool modified = false;
+
+public:
+  bool IsModified() const noexcept {
+    return modified;
+  }
+
+  /**
+   * Load the index from a file.  A missing or malformed file results
+   * in an empty index.
+   */
+  void Load(Path path) noexcept;
+
+  /**
+   * Throws on error.
+   */
+  void Save(Path path);
+
+  /**
+   * Look up the given task file.
+   *
+   * @return nullptr if the file is not in the index or if it has
+   * been modified since
+   */
+  const Entry *Lookup(Path path, uint64_t size,
+                      std::chrono::system_clock::time_point mtime) noexcept;
+
+  /**
+   * Add or replace the given task file, discarding all summaries.
+   */
+  void Put(Path path, uint64_t size,
+           std::chrono::system_clock::time_point mtime,
+           std::vector<tstring> &&names) noexcept;
+
+  /**
+   * Store the summary of a task which has been parsed.  This is
+   * ignored if the file is not in the index.
+   */
+  void SetSummary(Path path, unsigned index, const Summary &summary) noexcept;
+
+  /**
+   * Delete all entries which have not been used since Load() and
+   * whose file does not exist anymore.  Files which were merely not
+   * scanned this time (e.g. *.cup) are kept.
+   */
+  void RemoveUnused() noexcept;
+};
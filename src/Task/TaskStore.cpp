@@ -14,48 +14,80 @@
 #include <algorithm>
 #include <memory>
 
+static constexpr const TCHAR *INDEX_NAME = _T("tasks.idx");
+
+[[gnu::pure]]
+static AllocatedPath
+GetIndexPath() noexcept
+{
+  const auto cache_path = GetCachePath();
+  if (cache_path == nullptr)
+    return nullptr;
+
+  return AllocatedPath::Build(cache_path, INDEX_NAME);
+}
+
 class TaskFileVisitor: public File::Visitor
 {
 private:
   TaskStore::ItemVector &store;
+  TaskIndex &index;
 
 public:
-  TaskFileVisitor(TaskStore::ItemVector &_store):
-    store(_store) {}
+  TaskFileVisitor(TaskStore::ItemVector &_store, TaskIndex &_index):
+    store(_store), index(_index) {}
 
   void Visit(Path path, Path base_name) override
   try {
+    const auto size = File::GetSize(path);
+    const auto mtime = File::GetLastModification(path);
+
+    // Use the cached list if the file has not been modified
+    if (const auto *entry = index.Lookup(path, size, mtime)) {
+      const unsigned count = entry->tasks.size();
+      for (unsigned i = 0; i < count; i++)
+        Add(path, base_name, i, count, entry->tasks[i].name,
+            entry->tasks[i].summary);
+      return;
+    }
+
     // Create a TaskFile instance to determine how many
     // tasks are inside of this task file
     const auto task_file = TaskFile::Create(path);
     if (!task_file)
       return;
 
-    const auto list = task_file->GetList();
+    auto list = task_file->GetList();
 
     // Count the tasks in the task file
     unsigned count = list.size();
     // For each task in the task file
-    for (unsigned i = 0; i < count; i++) {
-      // Copy base name of the file into task name
-      StaticString<256> name(base_name.c_str());
-
-      // If the task file holds more than one task
-      const auto &saved_name = list[i];
-      if (!saved_name.empty()) {
-        name += _T(": ");
-        name += saved_name.c_str();
-      } else if (count > 1) {
-        // .. append " - Task #[n]" suffix to the task name
-        name.AppendFormat(_T(": %s #%d"), _("Task"), i + 1);
-      }
-
-      // Add the task to the TaskStore
-      store.emplace_back(path, name.empty() ? path.c_str() : name, i);
-    }
+    for (unsigned i = 0; i < count; i++)
+      Add(path, base_name, i, count, list[i], {});
+
+    index.Put(path, size, mtime, std::move(list));
   } catch (...) {
     LogError(std::current_exception());
   }
+
+private:
+  void Add(Path path, Path base_name, unsigned i, unsigned count,
+           const tstring &saved_name, const TaskIndex::Summary &summary) {
+    // Copy base name of the file into task name
+    StaticString<256> name(base_name.c_str());
+
+    // If the task file holds more than one task
+    if (!saved_name.empty()) {
+      name += _T(": ");
+      name += saved_name.c_str();
+    } else if (count > 1) {
+      // .. append " - Task #[n]" suffix to the task name
+      name.AppendFormat(_T(": %s #%d"), _("Task"), i + 1);
+    }
+
+    // Add the task to the TaskStore
+    store.emplace_back(path, name.empty() ? path.c_str() : name, i, summary);
+  }
 };
 
 void
@@ -70,8 +102,12 @@ TaskStore::Scan(bool extra)
 {
   Clear();
 
+  const auto index_path = GetIndexPath();
+  if (index_path != nullptr)
+    file_index.Load(index_path);
+
   // scan files
-  TaskFileVisitor tfv(store);
+  TaskFileVisitor tfv(store, file_index);
   VisitDataFiles(_T("*.tsk"), tfv);
 
   if (extra) {
@@ -80,6 +116,27 @@ TaskStore::Scan(bool extra)
   }
 
   std::sort(store.begin(), store.end());
+
+  file_index.RemoveUnused();
+  SaveIndex();
+}
+
+void
+TaskStore::SaveIndex() noexcept
+{
+  if (!file_index.IsModified())
+    return;
+
+  const auto index_path = GetIndexPath();
+  if (index_path == nullptr)
+    return;
+
+  try {
+    Directory::Create(GetCachePath());
+    file_index.Save(index_path);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to save the task index");
+  }
 }
 
 TaskStore::Item::~Item() noexcept = default;
@@ -94,11 +151,17 @@ TaskStore::Item::GetTask(const TaskBehaviour &task_behaviour) noexcept
     task = TaskFile::GetTask(filename, task_behaviour,
                              &way_points, task_index);
 
-  if (task == nullptr)
+  if (task == nullptr) {
     valid = false;
-  else
+  } else {
     task->UpdateGeometry();
 
+    summary.defined = true;
+    summary.type = task->GetFactoryType();
+    summary.n_points = task->TaskSize();
+    summary.distance = task->GetStats().distance_nominal;
+  }
+
   return task.get();
 }
 
@@ -117,5 +180,14 @@ TaskStore::GetPath(unsigned index) const
 const OrderedTask *
 TaskStore::GetTask(unsigned index, const TaskBehaviour &task_behaviour)
 {
-  return store[index].GetTask(task_behaviour);
+  auto &item = store[index];
+  const bool was_defined = item.summary.defined;
+  const auto *task = item.GetTask(task_behaviour);
+
+  if (task != nullptr && !was_defined) {
+    file_index.SetSummary(item.filename, item.task_index, item.summary);
+    SaveIndex();
+  }
+
+  return task;
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "TaskIndex.hpp"
 #include "system/Path.hpp"
 #include "util/tstring.hpp"
 
@@ -26,13 +27,21 @@ public:
     std::unique_ptr<OrderedTask> task;
     bool valid;
 
+    /**
+     * A summary of the task; this is known without parsing the file
+     * if the task has been loaded before (see #TaskIndex).
+     */
+    TaskIndex::Summary summary;
+
     Item(Path the_filename,
          tstring::const_pointer _task_name,
-         unsigned _task_index = 0)
+         unsigned _task_index = 0,
+         const TaskIndex::Summary &_summary = {})
       :task_name(_task_name),
        filename(the_filename),
        task_index(_task_index),
-       valid(true) {}
+       valid(true),
+       summary(_summary) {}
 
     ~Item() noexcept;
 
@@ -65,6 +74,12 @@ private:
    */
   ItemVector store;
 
+  /**
+   * The names and summaries of all task files, which allows Scan()
+   * to skip files which have not been modified.
+   */
+  TaskIndex file_index;
+
 public:
   /**
    * Scan the XCSoarData folder for .tsk files and add them to the TaskStore
@@ -107,10 +122,24 @@ public:
   Path GetPath(unsigned index) const;
 
   /**
-   * Return the task defined by the given index
+   * Return the summary of the task defined by the given index
+   * without loading it; it is undefined if the task has never been
+   * loaded.
+   */
+  [[gnu::pure]]
+  const TaskIndex::Summary &GetSummary(unsigned index) const {
+    return store[index].summary;
+  }
+
+  /**
+   * Return the task defined by the given index.  The file is parsed
+   * on the first call, and the summary is stored in the index.
    * @param index TaskStore index of the desired Task
    * @return The task defined by the given index
    */
   const OrderedTask *GetTask(unsigned index,
                              const TaskBehaviour &task_behaviour);
+
+private:
+  void SaveIndex() noexcept;
 };
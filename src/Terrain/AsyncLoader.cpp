@@ -9,11 +9,12 @@
 class AsyncTerrainOverviewLoader::LoaderJob final : public Job {
   FileCache *const cache;
   const AllocatedPath path;
+  const bool restore_tiles;
   std::unique_ptr<RasterTerrain> terrain;
 
 public:
-  LoaderJob(FileCache *_cache, Path _path) noexcept
-    :cache(_cache), path(_path) {}
+  LoaderJob(FileCache *_cache, Path _path, bool _restore_tiles) noexcept
+    :cache(_cache), path(_path), restore_tiles(_restore_tiles) {}
 
   std::unique_ptr<RasterTerrain> &&Finish() noexcept {
     return std::move(terrain);
@@ -21,6 +22,11 @@ public:
 
   void Run(OperationEnvironment &env) override {
     terrain = RasterTerrain::OpenTerrain(cache, path, env);
+
+    /* install the tiles around the last known position before
+       anybody gets to see the terrain */
+    if (terrain != nullptr && restore_tiles && cache != nullptr)
+      terrain->RestoreTiles(*cache);
   }
 };
 
@@ -39,10 +45,11 @@ AsyncTerrainOverviewLoader::~AsyncTerrainOverviewLoader() noexcept
 
 void
 AsyncTerrainOverviewLoader::Start(FileCache *cache, Path path,
+                                  bool restore_tiles,
                                   OperationEnvironment &env,
                                   UI::Notify &notify) noexcept
 {
-  job = std::make_unique<LoaderJob>(cache, path);
+  job = std::make_unique<LoaderJob>(cache, path, restore_tiles);
   async.Start(job.get(), env, &notify);
 }
 
@@ -26,8 +26,12 @@ public:
   AsyncTerrainOverviewLoader() noexcept;
   ~AsyncTerrainOverviewLoader() noexcept;
 
-  void Start(FileCache *cache, Path path, OperationEnvironment &env,
-             UI::Notify &notify) noexcept;
+  /**
+   * @param restore_tiles restore the tiles saved by
+   * RasterTerrain::SaveTiles() before the terrain is returned
+   */
+  void Start(FileCache *cache, Path path, bool restore_tiles,
+             OperationEnvironment &env, UI::Notify &notify) noexcept;
 
   /**
    * Throws on error.
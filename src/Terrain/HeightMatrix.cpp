@@ -10,7 +10,11 @@
 #include "Projection/WindowProjection.hpp"
 #endif
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+
+#include <string.h>
 
 void
 HeightMatrix::SetSize(std::size_t _size) noexcept
@@ -60,20 +64,178 @@ HeightMatrix::Fill(const RasterMap &map, const GeoBounds &bounds,
 
 #else
 
+/**
+ * The minimum number of cells passed to RasterMap::ScanLine(), which
+ * needs at least two cells within the map bounds.  Narrower strips
+ * are widened into the region which is already known.
+ */
+static constexpr unsigned MIN_STRIP = 8;
+
+/**
+ * How far (in cells) may a scrolled row be away from the new
+ * projection?  Rows beyond that are sampled again; this happens
+ * after a zoom or a rotation, but also where the projection's
+ * (table based) cosine steps.
+ */
+static constexpr double MAX_DEVIATION = 0.5;
+
+/**
+ * Express a geographic delta in cells.
+ */
+[[gnu::pure]]
+static DoublePoint2D
+ToCell(const GeoPoint &d,
+       const GeoPoint &column, const GeoPoint &row) noexcept
+{
+  const double det = column.longitude.Native() * row.latitude.Native() -
+    row.longitude.Native() * column.latitude.Native();
+  if (det == 0)
+    return {0, 0};
+
+  return {
+    (d.longitude.Native() * row.latitude.Native() -
+     row.longitude.Native() * d.latitude.Native()) / det,
+    (column.longitude.Native() * d.latitude.Native() -
+     d.longitude.Native() * column.latitude.Native()) / det,
+  };
+}
+
+[[gnu::pure]]
+static bool
+IsNear(const GeoPoint &a, const GeoPoint &b,
+       const GeoPoint &column, const GeoPoint &row) noexcept
+{
+  const auto d = ToCell(a - b, column, row);
+  return std::abs(d.x) <= MAX_DEVIATION && std::abs(d.y) <= MAX_DEVIATION;
+}
+
+HeightMatrix::RowLine
+HeightMatrix::GetRowLine(const WindowProjection &projection,
+                         unsigned y) const noexcept
+{
+  y *= quantisation_pixels;
+
+  return {
+    projection.ScreenToGeo({0, (int)y}),
+    projection.ScreenToGeo({(int)screen_size.width, (int)y}),
+  };
+}
+
+void
+HeightMatrix::ScanRow(const RasterMap &map, unsigned y,
+                      unsigned start, unsigned n) noexcept
+{
+  assert(start + n <= size.x);
+
+  const auto &line = rows[y];
+  map.ScanLine(line.At(double(start) / size.x),
+               line.At(double(start + n) / size.x),
+               data.data() + y * size.x + start, n, interpolate);
+}
+
 void
 HeightMatrix::Fill(const RasterMap &map, const WindowProjection &projection,
-                   unsigned quantisation_pixels, bool interpolate) noexcept
+                   unsigned _quantisation_pixels, bool _interpolate) noexcept
 {
-  const auto screen_size = projection.GetScreenSize();
+  screen_size = projection.GetScreenSize();
+  quantisation_pixels = _quantisation_pixels;
+  interpolate = _interpolate;
 
   SetSize((UnsignedPoint2D)screen_size, quantisation_pixels);
+  rows.GrowDiscard(size.y);
+
+  for (unsigned y = 0; y < size.y; ++y) {
+    rows[y] = GetRowLine(projection, y);
+    ScanRow(map, y, 0, size.x);
+  }
+}
 
-  auto p = data.data();
-  for (unsigned y = 0; y < screen_size.height;
-       y += quantisation_pixels, p += size.x) {
-    map.ScanLine(projection.ScreenToGeo({0, (int)y}),
-                 projection.ScreenToGeo({(int)screen_size.width, (int)y}),
-                 p, size.x, interpolate);
+void
+HeightMatrix::Update(const RasterMap &map, const WindowProjection &projection,
+                     unsigned _quantisation_pixels, bool _interpolate) noexcept
+{
+  if (quantisation_pixels == 0 || size.y < 2 ||
+      projection.GetScreenSize() != screen_size ||
+      _quantisation_pixels != quantisation_pixels ||
+      _interpolate != interpolate) {
+    Fill(map, projection, _quantisation_pixels, _interpolate);
+    return;
+  }
+
+  /* locate the new top-left cell in the old matrix */
+  const GeoPoint column = (rows[0].end - rows[0].start) * (1. / size.x);
+  const GeoPoint row = rows[1].start - rows[0].start;
+  const auto top_left = ToCell(projection.ScreenToGeo({0, 0}) - rows[0].start,
+                               column, row);
+
+  const int dx = (int)std::lround(top_left.x);
+  const int dy = (int)std::lround(top_left.y);
+  if ((unsigned)std::abs(dx) >= size.x || (unsigned)std::abs(dy) >= size.y) {
+    /* nothing to keep */
+    Fill(map, projection, quantisation_pixels, interpolate);
+    return;
+  }
+
+  Scroll(map, projection, dx, dy, column, row);
+}
+
+void
+HeightMatrix::Scroll(const RasterMap &map, const WindowProjection &projection,
+                     const int dx, const int dy,
+                     const GeoPoint &column, const GeoPoint &row) noexcept
+{
+  assert((unsigned)std::abs(dx) < size.x);
+  assert((unsigned)std::abs(dy) < size.y);
+
+  /* the columns which are kept in each row */
+  const unsigned n_keep = size.x - std::abs(dx);
+  const unsigned src_x = std::max(dx, 0), dest_x = std::max(-dx, 0);
+
+  /* the new columns at the left or the right edge */
+  const unsigned n_strip = std::min(size.x, std::max<unsigned>(std::abs(dx),
+                                                               MIN_STRIP));
+  const unsigned strip_x = dx > 0 ? size.x - n_strip : 0;
+
+  /* iterate in the direction which doesn't overwrite rows which are
+     still needed */
+  const int first = dy >= 0 ? 0 : size.y - 1;
+  const int last = dy >= 0 ? size.y : -1;
+  const int direction = dy >= 0 ? 1 : -1;
+
+  for (int y = first; y != last; y += direction) {
+    const auto expected = GetRowLine(projection, y);
+
+    const int src_y = y + dy;
+    if (src_y < 0 || (unsigned)src_y >= size.y) {
+      /* a new row */
+      rows[y] = expected;
+      ScanRow(map, y, 0, size.x);
+      continue;
+    }
+
+    const RowLine shifted{
+      rows[src_y].At(double(dx) / size.x),
+      rows[src_y].At(double(dx + (int)size.x) / size.x),
+    };
+
+    if (!IsNear(shifted.start, expected.start, column, row) ||
+        !IsNear(shifted.end, expected.end, column, row)) {
+      rows[y] = expected;
+      ScanRow(map, y, 0, size.x);
+      continue;
+    }
+
+    rows[y] = shifted;
+
+    if (dx == 0 && dy == 0)
+      continue;
+
+    TerrainHeight *dest = data.data() + y * size.x;
+    memmove(dest + dest_x, data.data() + src_y * size.x + src_x,
+            n_keep * sizeof(*dest));
+
+    if (dx != 0)
+      ScanRow(map, y, strip_x, n_strip);
   }
 }
 
@@ -7,6 +7,11 @@
 #include "Math/Point2D.hpp"
 #include "util/AllocatedArray.hxx"
 
+#ifndef ENABLE_OPENGL
+#include "Geo/GeoPoint.hpp"
+#include "ui/dim/Size.hpp"
+#endif
+
 class RasterMap;
 
 #ifdef ENABLE_OPENGL
@@ -19,6 +24,35 @@ class HeightMatrix {
   AllocatedArray<TerrainHeight> data;
   UnsignedPoint2D size;
 
+#ifndef ENABLE_OPENGL
+  /**
+   * The geographic line of one row: cell x is at
+   * start + (end - start) * x / size.x.
+   */
+  struct RowLine {
+    GeoPoint start, end;
+
+    [[gnu::pure]]
+    GeoPoint At(double fraction) const noexcept {
+      return start + (end - start) * fraction;
+    }
+  };
+
+  /**
+   * The line of each row, as filled by the last Fill() or Update()
+   * call.
+   */
+  AllocatedArray<RowLine> rows;
+
+  /**
+   * The parameters of the last Fill() call; Update() falls back to
+   * Fill() if they are different.
+   */
+  PixelSize screen_size;
+  unsigned quantisation_pixels = 0;
+  bool interpolate;
+#endif
+
 public:
   HeightMatrix() noexcept = default;
 
@@ -44,6 +78,41 @@ public:
    */
   void Fill(const RasterMap &map, const WindowProjection &map_projection,
             unsigned quantisation_pixels, bool interpolate) noexcept;
+
+  /**
+   * Like Fill(), but if the new projection is the one of the
+   * previous call scrolled by a whole number of cells (same scale
+   * and rotation), then the overlapping region is kept and only the
+   * newly exposed rows and columns are sampled.
+   *
+   * The caller must ensure that the #RasterMap has not changed since
+   * the previous call; after loading new tiles, use Fill().
+   */
+  void Update(const RasterMap &map, const WindowProjection &map_projection,
+              unsigned quantisation_pixels, bool interpolate) noexcept;
+
+private:
+  /**
+   * Move the existing values, so that cell (x,y) gets the value of
+   * cell (x+dx,y+dy), and sample the cells which were not known
+   * before.  Rows which do not match the new projection closely
+   * enough are sampled again completely.
+   *
+   * @param column the distance between two adjacent cells in one row
+   * @param row the distance between two adjacent rows
+   */
+  void Scroll(const RasterMap &map, const WindowProjection &projection,
+              int dx, int dy,
+              const GeoPoint &column, const GeoPoint &row) noexcept;
+
+  [[gnu::pure]]
+  RowLine GetRowLine(const WindowProjection &projection,
+                     unsigned y) const noexcept;
+
+  void ScanRow(const RasterMap &map, unsigned y,
+               unsigned start, unsigned n) noexcept;
+
+public:
 #endif
 
   UnsignedPoint2D GetSize() const noexcept {
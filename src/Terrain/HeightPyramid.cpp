@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "HeightPyramid.hpp"
+#include "Height.hpp"
+#include "jasper/jas_seq.h"
+#include "io/BufferedOutputStream.hxx"
+#include "io/BufferedReader.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <span>
+
+void
+HeightPyramid::Reset() noexcept
+{
+  for (unsigned i = 0; i < n_levels; ++i)
+    levels[i].Reset();
+
+  n_levels = 0;
+}
+
+void
+HeightPyramid::Resize(RasterLocation map_size,
+                      RasterLocation tile_size) noexcept
+{
+  Reset();
+
+  /* blocks may be at most half as large as a tile, and they must
+     be aligned to tile boundaries */
+  while (n_levels < MAX_LEVELS) {
+    const unsigned parent_size = 2u << (BASE_BITS + n_levels);
+    if (tile_size.x % parent_size != 0 || tile_size.y % parent_size != 0)
+      break;
+
+    const unsigned bits = BASE_BITS + n_levels;
+    const unsigned block_size = 1u << bits;
+    auto &level = levels[n_levels++];
+    level.GrowDiscard((map_size.x + block_size - 1) >> bits,
+                      (map_size.y + block_size - 1) >> bits);
+    std::fill(level.begin(), level.end(), UNKNOWN);
+  }
+}
+
+void
+HeightPyramid::PutTile(RasterLocation start,
+                       const struct jas_matrix &m) noexcept
+{
+  if (!IsDefined())
+    return;
+
+  auto &base = levels[0];
+
+  const RasterLocation cell_start = start >> BASE_BITS;
+  if (cell_start.x >= base.GetWidth() || cell_start.y >= base.GetHeight())
+    return;
+
+  const unsigned width = std::min<unsigned>(m.numcols_,
+                                            (base.GetWidth() << BASE_BITS) - start.x);
+  const unsigned height = std::min<unsigned>(m.numrows_,
+                                             (base.GetHeight() << BASE_BITS) - start.y);
+  if (width == 0 || height == 0)
+    return;
+
+  const RasterLocation cell_end{
+    cell_start.x + ((width + (1u << BASE_BITS) - 1) >> BASE_BITS),
+    cell_start.y + ((height + (1u << BASE_BITS) - 1) >> BASE_BITS),
+  };
+
+  for (unsigned cy = cell_start.y; cy < cell_end.y; ++cy)
+    std::fill_n(base.GetPointerAt(cell_start.x, cy),
+                cell_end.x - cell_start.x, INT16_MIN);
+
+  for (unsigned y = 0; y < height; ++y) {
+    const jas_seqent_t *src = m.rows_[y];
+    int16_t *row = base.GetPointerAt(cell_start.x,
+                                     cell_start.y + (y >> BASE_BITS));
+
+    for (unsigned x = 0; x < width; ++x) {
+      const TerrainHeight h(src[x]);
+
+      /* "invalid" is the only value which TerrainHeight and
+         GetValueOr0() disagree about; map it to UNKNOWN */
+      const int16_t value = h.IsInvalid() ? UNKNOWN : h.GetValueOr0();
+      int16_t &cell = row[x >> BASE_BITS];
+      cell = std::max(cell, value);
+    }
+  }
+
+  RasterLocation level_start = cell_start, level_end = cell_end;
+  for (unsigned level = 1; level < n_levels; ++level) {
+    level_start = level_start >> 1;
+    level_end = (level_end + RasterLocation{1, 1}) >> 1;
+    UpdateLevel(level, level_start, level_end);
+  }
+}
+
+void
+HeightPyramid::UpdateLevel(unsigned level,
+                           RasterLocation start, RasterLocation end) noexcept
+{
+  assert(level > 0);
+  assert(level < n_levels);
+
+  const auto &below = levels[level - 1];
+  auto &dest = levels[level];
+
+  end.x = std::min(end.x, dest.GetWidth());
+  end.y = std::min(end.y, dest.GetHeight());
+
+  for (unsigned y = start.y; y < end.y; ++y) {
+    for (unsigned x = start.x; x < end.x; ++x) {
+      const unsigned x0 = 2 * x, y0 = 2 * y;
+      const unsigned x1 = std::min(x0 + 1, below.GetWidth() - 1);
+      const unsigned y1 = std::min(y0 + 1, below.GetHeight() - 1);
+
+      dest.Get(x, y) = std::max({
+          below.Get(x0, y0), below.Get(x1, y0),
+          below.Get(x0, y1), below.Get(x1, y1),
+        });
+    }
+  }
+}
+
+HeightPyramid::Block
+HeightPyramid::FindBlock(RasterLocation p, int h) const noexcept
+{
+  for (unsigned level = n_levels; level-- > 0;) {
+    const unsigned bits = BASE_BITS + level;
+    const RasterLocation cell = p >> bits;
+    const auto &grid = levels[level];
+    if (cell.x >= grid.GetWidth() || cell.y >= grid.GetHeight())
+      break;
+
+    const int max_height = grid.Get(cell.x, cell.y);
+    if (max_height <= h) {
+      const RasterLocation start = cell << bits;
+      return {start, start + RasterLocation{1u << bits, 1u << bits},
+              max_height};
+    }
+  }
+
+  return {p, p, 0};
+}
+
+void
+HeightPyramid::Save(BufferedOutputStream &os) const
+{
+  if (!IsDefined())
+    return;
+
+  os.Write(std::as_bytes(std::span{levels[0].begin(), levels[0].GetSize()}));
+}
+
+void
+HeightPyramid::Load(BufferedReader &r)
+{
+  if (!IsDefined())
+    return;
+
+  auto &base = levels[0];
+  r.ReadFull(std::as_writable_bytes(std::span{base.begin(), base.GetSize()}));
+
+  for (unsigned level = 1; level < n_levels; ++level)
+    UpdateLevel(level, {0, 0},
+                {levels[level].GetWidth(), levels[level].GetHeight()});
+}
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "RasterLocation.hpp"
+#include "util/AllocatedGrid.hxx"
+
+#include <array>
+#include <cstdint>
+
+struct jas_matrix;
+class BufferedOutputStream;
+class BufferedReader;
+
+/**
+ * A mip pyramid of maximum heights below the tile level.  Level 0
+ * covers blocks of 2^#BASE_BITS pixels; each following level doubles
+ * the block size, up to half the tile size (the tile itself is
+ * summarised by RasterTile::GetMaxHeight()).  This allows intersection
+ * searches to clear long stretches without looking at the terrain.
+ *
+ * Each value is the maximum of TerrainHeight::GetValueOr0() of the
+ * block's pixels, or #UNKNOWN if the block has not been scanned or
+ * contains invalid pixels.
+ */
+class HeightPyramid {
+public:
+  static constexpr unsigned BASE_BITS = 5;
+  static constexpr unsigned MAX_LEVELS = 8;
+  static constexpr int16_t UNKNOWN = INT16_MAX;
+
+  struct Block {
+    RasterLocation start, end;
+    int max_height;
+  };
+
+private:
+  unsigned n_levels = 0;
+
+  std::array<AllocatedGrid<int16_t>, MAX_LEVELS> levels;
+
+public:
+  bool IsDefined() const noexcept {
+    return n_levels > 0;
+  }
+
+  unsigned GetLevelCount() const noexcept {
+    return n_levels;
+  }
+
+  void Reset() noexcept;
+
+  /**
+   * Allocate the pyramid for a map and mark all blocks unknown.  The
+   * blocks must not cross tile boundaries; if the tile size is not a
+   * multiple of twice the base block size, the pyramid remains
+   * undefined.
+   */
+  void Resize(RasterLocation map_size, RasterLocation tile_size) noexcept;
+
+  /**
+   * Scan a decoded tile.
+   *
+   * @param start the position of the tile within the map
+   */
+  void PutTile(RasterLocation start, const struct jas_matrix &m) noexcept;
+
+  /**
+   * Find the largest block containing #p whose maximum height is not
+   * above #h.
+   *
+   * @return the block, or an empty block (start==end) if there is
+   * none
+   */
+  [[gnu::pure]]
+  Block FindBlock(RasterLocation p, int h) const noexcept;
+
+  /**
+   * Save level 0; the other levels are calculated by Load().
+   *
+   * Throws on error.
+   */
+  void Save(BufferedOutputStream &os) const;
+
+  /**
+   * Throws on error.
+   */
+  void Load(BufferedReader &r);
+
+private:
+  /**
+   * Recalculate the specified cells of #level from the level below.
+   */
+  void UpdateLevel(unsigned level,
+                   RasterLocation start, RasterLocation end) noexcept;
+};
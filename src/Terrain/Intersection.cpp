@@ -84,6 +84,9 @@ RasterTileCache::FirstIntersection(const SignedRasterLocation origin,
   RasterLocation last_clear_location = location;
   int last_clear_h = h_origin;
 
+  // the area most recently found by IsClear()
+  ClearArea clear;
+
   while (true) {
 
     if (!step_counter) {
@@ -91,13 +94,6 @@ RasterTileCache::FirstIntersection(const SignedRasterLocation origin,
       if (!IsInside(location))
         break; // outside bounds
 
-      const auto field_direct = GetFieldDirect(location);
-      if (field_direct.first.IsInvalid())
-        break;
-
-      const int h_terrain = field_direct.first.GetValueOr0() + h_safety;
-      step_counter = field_direct.second ? step_fine : step_coarse;
-
       // calculate height of glide so far
       const int dh = (total_steps * slope_fact) >> RASTER_SLOPE_FACT;
 
@@ -107,12 +103,29 @@ RasterTileCache::FirstIntersection(const SignedRasterLocation origin,
         h_int = std::min(h_int, h_dest);
       }
 
+      // this point has intersected if aircraft is below terrain height
+      bool this_intersecting;
+      int h_terrain;
+
+      if (IsClear(clear, location, h_int - h_safety)) {
+        /* all terrain around is below the aircraft, no need to look
+           at it */
+        step_counter = clear.loaded ? step_fine : step_coarse;
+        this_intersecting = false;
+      } else {
+        const auto field_direct = GetFieldDirect(location);
+        if (field_direct.first.IsInvalid())
+          break;
+
+        h_terrain = field_direct.first.GetValueOr0() + h_safety;
+        step_counter = field_direct.second ? step_fine : step_coarse;
+
 #ifdef DEBUG_TILE
-      printf("%d %d %d %d %d # fint\n", location.x, location.y, h_int, h_terrain, h_ceiling);
+        printf("%d %d %d %d %d # fint\n", location.x, location.y, h_int, h_terrain, h_ceiling);
 #endif
 
-      // this point has intersected if aircraft is below terrain height
-      const bool this_intersecting = (h_int< h_terrain);
+        this_intersecting = h_int < h_terrain;
+      }
 
       if (this_intersecting) {
         intersect_counter = 1;
@@ -221,90 +234,155 @@ RasterTileCache::GetFieldDirect(RasterLocation p) const noexcept
   return std::make_pair(overview.Get(p_overview), false);
 }
 
-SignedRasterLocation
-RasterTileCache::GroundIntersection(const SignedRasterLocation origin,
-                                    const SignedRasterLocation destination,
-                                    const int h_origin,
-                                    const int slope_fact,
-                                    const int height_floor) const noexcept
+RasterTileCache::ClearArea
+RasterTileCache::FindClearArea(RasterLocation p, int h) const noexcept
 {
-  SignedRasterLocation location = origin;
+  const RasterTile &tile = tiles.Get(p.x / tile_size.x, p.y / tile_size.y);
+  if (tile.GetMaxHeight() <= h)
+    return {tile.start, tile.end, tile.GetMaxHeight(), tile.IsLoaded()};
 
-  if (!IsInside(location))
-    // origin is outside overall bounds
-    return {-1, -1};
+  const auto block = pyramid.FindBlock(p, h);
+  return {block.start, block.end, block.max_height, tile.IsLoaded()};
+}
+
+inline bool
+RasterTileCache::IsClear(ClearArea &area, RasterLocation p,
+                         int h) const noexcept
+{
+  if (area.Contains(p) && area.max_height <= h)
+    return true;
+
+  area = FindClearArea(p, h);
+  return area.Contains(p);
+}
+
+/**
+ * The state of one GroundIntersection() search.  Each Next() call
+ * examines one sample, which allows GroundIntersections() to
+ * interleave the rays of a fan.
+ */
+class RasterTileCache::GroundWalker {
+  SignedRasterLocation location;
 
   // line algorithm parameters
-  const int dx = abs(destination.x - origin.x);
-  const int dy = abs(destination.y - origin.y);
-  int err = dx-dy;
-  const int sx = origin.x < destination.x ? 1 : -1;
-  const int sy = origin.y < destination.y ? 1 : -1;
+  int dx, dy, err, sx, sy;
 
   // max number of steps to walk
-  const int max_steps = (dx+dy);
-  // calculate number of fine steps to produce a step on the overview field
+  int max_steps;
 
   // step size at selected refinement level
-  const int refine_step = max_steps >> 5;
+  int refine_step;
 
   // number of steps for update to the fine map
-  const int step_fine = std::max(1, refine_step);
+  int step_fine;
+
   // number of steps for update to the overview map
-  const int step_coarse = std::max(1 << RasterTraits::OVERVIEW_BITS, step_fine);
+  int step_coarse;
 
   // counter for steps to reach next position to be checked on the field.
-  unsigned step_counter = 0;
-  // total counter of fine steps
-  int total_steps = 0;
-
-#ifdef DEBUG_TILE
-  printf("# max steps %d\n", max_steps);
-  printf("# step coarse %d\n", step_coarse);
-  printf("# step fine %d\n", step_fine);
-#endif
+  unsigned step_counter;
 
-  RasterLocation last_clear_location = location;
-  int last_clear_h = h_origin;
+  // total counter of fine steps
+  int total_steps;
+
+  int h_origin, slope_fact;
+
+  RasterLocation last_clear_location;
+  int last_clear_h;
+
+  /**
+   * The area most recently found by RasterTileCache::IsClear().
+   */
+  ClearArea clear;
+
+public:
+  /**
+   * Valid after Next() has returned false; {-1,-1} if no
+   * intersection was found.
+   */
+  SignedRasterLocation result;
+
+  GroundWalker() noexcept = default;
+
+  GroundWalker(const SignedRasterLocation origin,
+               const SignedRasterLocation destination,
+               const int _h_origin, const int _slope_fact) noexcept
+    :location(origin),
+     dx(abs(destination.x - origin.x)),
+     dy(abs(destination.y - origin.y)),
+     err(dx - dy),
+     sx(origin.x < destination.x ? 1 : -1),
+     sy(origin.y < destination.y ? 1 : -1),
+     max_steps(dx + dy),
+     refine_step(max_steps >> 5),
+     step_fine(std::max(1, refine_step)),
+     step_coarse(std::max(1 << RasterTraits::OVERVIEW_BITS, step_fine)),
+     step_counter(0), total_steps(0),
+     h_origin(_h_origin), slope_fact(_slope_fact),
+     last_clear_location(origin), last_clear_h(_h_origin),
+     result(-1, -1) {}
+
+  /**
+   * Examine the current sample and advance to the next one.
+   *
+   * @return false if the search is finished (see #result)
+   */
+  bool Next(const RasterTileCache &cache, int height_floor) noexcept;
+};
+
+inline bool
+RasterTileCache::GroundWalker::Next(const RasterTileCache &cache,
+                                    const int height_floor) noexcept
+{
+  assert(step_counter == 0);
 
-  while (true) {
+  const RasterLocation p = location;
+  if (!cache.IsInside(p))
+    return false;
 
-    if (!step_counter) {
+  // calculate height of glide so far
+  const int dh = (total_steps * slope_fact) >> RASTER_SLOPE_FACT;
 
-      if (!IsInside(location))
-        break;
+  // current aircraft height
+  const int h_int = h_origin - dh;
 
-      const auto field_direct = GetFieldDirect(location);
-      if (field_direct.first.IsInvalid())
-        break;
+  bool loaded;
 
-      const int h_terrain = field_direct.first.GetValueOr0();
-      step_counter = field_direct.second ? step_fine : step_coarse;
+  /* if all terrain around is below the aircraft, there is no need
+     to look at it */
+  if (h_int >= height_floor && cache.IsClear(clear, p, h_int)) {
+    loaded = clear.loaded;
+  } else {
+    const auto field_direct = cache.GetFieldDirect(p);
+    if (field_direct.first.IsInvalid())
+      return false;
 
-      // calculate height of glide so far
-      const int dh = (total_steps * slope_fact) >> RASTER_SLOPE_FACT;
-
-      // current aircraft height
-      const int h_int = h_origin - dh;
-
-      if (h_int < std::max(h_terrain, height_floor)) {
-        if (refine_step<3) // can't refine any further
-          return RasterLocation(last_clear_location.x, last_clear_location.y);
+    loaded = field_direct.second;
 
+    const int h_terrain = field_direct.first.GetValueOr0();
+    if (h_int < std::max(h_terrain, height_floor)) {
+      if (refine_step<3) // can't refine any further
+        result = RasterLocation(last_clear_location.x, last_clear_location.y);
+      else
         // refine solution
-        return GroundIntersection(last_clear_location, location,
-                                  last_clear_h, slope_fact, height_floor);
-      }
+        result = cache.GroundIntersection(last_clear_location, location,
+                                          last_clear_h, slope_fact,
+                                          height_floor);
+      return false;
+    }
+  }
 
-      if (h_int <= 0)
-        break; // reached max range
+  if (h_int <= 0)
+    return false; // reached max range
 
-      last_clear_location = location;
-      last_clear_h = h_int;
-    }
+  step_counter = loaded ? step_fine : step_coarse;
 
+  last_clear_location = location;
+  last_clear_h = h_int;
+
+  do {
     if (total_steps > max_steps)
-      break;
+      return false;
 
     const int e2 = 2*err;
     if (e2 > -dy) {
@@ -321,8 +399,62 @@ RasterTileCache::GroundIntersection(const SignedRasterLocation origin,
         step_counter--;
       total_steps++;
     }
-  }
+  } while (step_counter > 0);
+
+  return true;
+}
+
+SignedRasterLocation
+RasterTileCache::GroundIntersection(const SignedRasterLocation origin,
+                                    const SignedRasterLocation destination,
+                                    const int h_origin,
+                                    const int slope_fact,
+                                    const int height_floor) const noexcept
+{
+  GroundWalker walker(origin, destination, h_origin, slope_fact);
+  while (walker.Next(*this, height_floor)) {}
 
   // if we reached invalid terrain, assume we can hit MSL
-  return {-1, -1};
+  return walker.result;
+}
+
+void
+RasterTileCache::GroundIntersections(const SignedRasterLocation origin,
+                                     const int h_origin,
+                                     const int height_floor,
+                                     std::span<GroundRay> rays) const noexcept
+{
+  /* the fans of ReachFan have at most ROUTEPOLAR_POINTS rays; larger
+     batches are split */
+  static constexpr std::size_t MAX_RAYS = 64;
+
+  while (!rays.empty()) {
+    const auto batch = rays.first(std::min(rays.size(), MAX_RAYS));
+    rays = rays.subspan(batch.size());
+
+    GroundWalker walkers[MAX_RAYS];
+    uint8_t active[MAX_RAYS];
+    std::size_t n_active = 0;
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      walkers[i] = {origin, batch[i].destination,
+                    h_origin, batch[i].slope_fact};
+      active[n_active++] = i;
+    }
+
+    while (n_active > 0) {
+      /* one sample of each ray per round; finished rays are removed
+         from the list */
+      std::size_t n = 0;
+      for (std::size_t j = 0; j < n_active; ++j) {
+        const unsigned i = active[j];
+        if (walkers[i].Next(*this, height_floor))
+          active[n++] = i;
+        else
+          batch[i].result = walkers[i].result;
+      }
+
+      n_active = n;
+    }
+  }
 }
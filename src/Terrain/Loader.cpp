@@ -3,6 +3,7 @@
 
 #include "Loader.hpp"
 #include "RasterTileCache.hpp"
+#include "RasterTileFile.hpp"
 #include "RasterProjection.hpp"
 #include "ZzipStream.hpp"
 #include "WorldFile.hpp"
@@ -16,6 +17,9 @@ extern "C" {
 #include "jasper/jpc/jpc_t1cod.h"
 }
 
+#include <stdexcept>
+#include <vector>
+
 #include <string.h>
 
 long
@@ -161,9 +165,44 @@ TerrainLoader::PutTileData(unsigned index,
     raster_tile_cache.PutOverviewTile(index, start, end, m);
 
   if (scan_tiles) {
+    /* copy the data while readers may still access the map; the
+       exclusive lock is only needed to install the new buffer */
+    auto buffer = raster_tile_cache.MakeTileBuffer(index, m);
+    if (buffer.IsDefined()) {
+      const std::lock_guard lock{mutex};
+      raster_tile_cache.PutTileBuffer(index, std::move(buffer));
+      ++n_loaded;
+    }
+  }
+}
+
+inline bool
+TerrainLoader::PollTiles(SignedRasterLocation p, unsigned radius,
+                         SignedRasterLocation ahead) noexcept
+{
+  const bool result = raster_tile_cache.PollTiles(p, radius, ahead);
+  if (!raster_tile_cache.HasDiscardedTiles())
+    return result;
+
+  std::vector<RasterBuffer> garbage;
+
+  {
     const std::lock_guard lock{mutex};
-    raster_tile_cache.PutTileData(index, m);
+    raster_tile_cache.DiscardTiles(garbage);
   }
+
+  /* the discarded buffers are freed here, after the lock has been
+     released */
+  return result;
+}
+
+void
+TerrainLoader::FinishTileUpdate(std::chrono::steady_clock::time_point start) noexcept
+{
+  raster_tile_cache.FinishTileUpdate();
+  raster_tile_cache.GetStats().AddLoadPass(n_loaded,
+                                           std::chrono::steady_clock::now() - start);
+  n_loaded = 0;
 }
 
 /**
@@ -291,22 +330,102 @@ LoadTerrainOverview(struct zzip_dir *dir,
 
 inline void
 TerrainLoader::UpdateTiles(struct zzip_dir *dir, const char *path,
-                           SignedRasterLocation p, unsigned radius)
+                           SignedRasterLocation p, unsigned radius,
+                           SignedRasterLocation ahead)
 {
   assert(!scan_overview);
 
-  {
-    /* this write lock is necessary because
-       RasterTileCache::PollTiles() calls RasterTile::Unload() */
-    const std::lock_guard lock{mutex};
+  if (!PollTiles(p, radius, ahead))
+    /* nothing to do */
+    return;
+
+  const auto start = std::chrono::steady_clock::now();
+  AtScopeExit(this, start) { FinishTileUpdate(start); };
+  LoadJPG2000(dir, path);
+}
+
+void
+TerrainLoader::UpdateTiles(const RasterTileFile &file,
+                           SignedRasterLocation p, unsigned radius,
+                           SignedRasterLocation ahead) noexcept
+{
+  assert(!scan_overview);
+
+  if (!PollTiles(p, radius, ahead))
+    /* nothing to do */
+    return;
+
+  const auto start = std::chrono::steady_clock::now();
 
-    if (!raster_tile_cache.PollTiles(p, radius))
-      /* nothing to do */
-      return;
+  for (const unsigned i : raster_tile_cache.request_tiles) {
+    const auto &tile = raster_tile_cache.tiles.GetLinear(i);
+    if (!tile.IsRequested())
+      continue;
+
+    const auto data = file.GetTile(i, tile.size);
+    if (data.empty())
+      continue;
+
+    /* this may page in the tile from the file; do it before taking
+       the exclusive lock */
+    auto buffer = raster_tile_cache.MakeTileBuffer(i, data);
+
+    const std::lock_guard lock{mutex};
+    raster_tile_cache.PutTileBuffer(i, std::move(buffer));
+    ++n_loaded;
   }
 
-  AtScopeExit(this) { raster_tile_cache.FinishTileUpdate(); };
-  LoadJPG2000(dir, path);
+  FinishTileUpdate(start);
+}
+
+inline void
+TerrainLoader::WriteTileFile(struct zzip_dir *dir, const char *path,
+                             const RasterTileFile::Source &source,
+                             BufferedOutputStream &os,
+                             OperationEnvironment &progress)
+{
+  assert(!scan_overview);
+
+  auto &tiles = raster_tile_cache.tiles;
+
+  std::vector<RasterLocation> sizes;
+  sizes.reserve(tiles.GetSize());
+  for (const auto &tile : tiles)
+    sizes.push_back(tile.IsDefined() ? tile.size : RasterLocation{0, 0});
+
+  RasterTileFileWriter writer(os, raster_tile_cache.GetSize(),
+                              raster_tile_cache.GetTileCount(), sizes,
+                              source);
+
+  progress.SetProgressRange(tiles.GetSize());
+
+  for (unsigned i = 0; i < tiles.GetSize(); ++i) {
+    progress.SetProgressPosition(i);
+
+    if (sizes[i].x == 0)
+      continue;
+
+    auto &tile = tiles.GetLinear(i);
+
+    /* loading a tile also loads its neighbours (up to 16 per pass),
+       so most tiles are already there when we get to them */
+    const SignedRasterLocation center{
+      int(tile.start.x + tile.size.x / 2),
+      int(tile.start.y + tile.size.y / 2),
+    };
+    while (tile.IsDefined() && !tile.IsLoaded())
+      UpdateTiles(dir, path, center, 0, center);
+
+    if (tile.IsLoaded()) {
+      writer.WriteTile({tile.buffer.GetData(), tile.size.Area()});
+    } else {
+      /* the tile failed to decode; its size is already in the index,
+         so fill it with "invalid" */
+      const std::vector<TerrainHeight> invalid(sizes[i].Area(),
+                                               TerrainHeight::Invalid());
+      writer.WriteTile(invalid);
+    }
+  }
 }
 
 void
@@ -319,18 +438,57 @@ UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
 
   NullOperationEnvironment env;
   TerrainLoader loader(mutex, raster_tile_cache, false, true, env);
-  loader.UpdateTiles(dir, path, p, radius);
+  loader.UpdateTiles(dir, path, p, radius, p);
 }
 
 void
 UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
                    const RasterProjection &projection,
-                   const GeoPoint &location, double radius)
+                   const GeoPoint &location, double radius,
+                   const GeoPoint &ahead)
+{
+  if (!raster_tile_cache.IsValid())
+    return;
+
+  const auto p = projection.ProjectCoarse(location);
+
+  NullOperationEnvironment env;
+  TerrainLoader loader(mutex, raster_tile_cache, false, true, env);
+  loader.UpdateTiles(dir, path, p, projection.DistancePixelsCoarse(radius),
+                     ahead.IsValid() ? projection.ProjectCoarse(ahead) : p);
+}
+
+void
+UpdateTerrainTiles(const RasterTileFile &file,
+                   RasterTileCache &raster_tile_cache, SharedMutex &mutex,
+                   const RasterProjection &projection,
+                   const GeoPoint &location, double radius,
+                   const GeoPoint &ahead) noexcept
+{
+  if (!raster_tile_cache.IsValid())
+    return;
+
+  const auto p = projection.ProjectCoarse(location);
+
+  NullOperationEnvironment env;
+  TerrainLoader loader(mutex, raster_tile_cache, false, true, env);
+  loader.UpdateTiles(file, p, projection.DistancePixelsCoarse(radius),
+                     ahead.IsValid() ? projection.ProjectCoarse(ahead) : p);
+}
+
+void
+WriteTerrainTileFile(struct zzip_dir *dir, const char *path,
+                     const RasterTileFile::Source &source,
+                     RasterTileCache &raster_tile_cache,
+                     BufferedOutputStream &os,
+                     OperationEnvironment &env)
 {
-  const auto raster_location = projection.ProjectCoarse(location);
+  if (!raster_tile_cache.IsValid())
+    throw std::runtime_error("Terrain invalid");
 
-  UpdateTerrainTiles(dir, path, raster_tile_cache, mutex,
-                     raster_location,
-                     projection.DistancePixelsCoarse(radius));
+  SharedMutex mutex;
+  NullOperationEnvironment null_env;
+  TerrainLoader loader(mutex, raster_tile_cache, false, true, null_env);
+  loader.WriteTileFile(dir, path, source, os, env);
 }
@@ -4,13 +4,16 @@
 #pragma once
 
 #include "RasterLocation.hpp"
+#include "RasterTileFile.hpp"
+#include "Geo/GeoPoint.hpp"
 #include "thread/SharedMutex.hpp"
 
+#include <chrono>
 #include <cstdint>
 
 struct zzip_dir;
-struct GeoPoint;
 class RasterTileCache;
+class BufferedOutputStream;
 class RasterProjection;
 class OperationEnvironment;
 
@@ -28,6 +31,12 @@ class TerrainLoader {
    */
   mutable unsigned remaining_segments = 0;
 
+  /**
+   * The number of tiles installed by the current UpdateTiles() call,
+   * for #TerrainStats.
+   */
+  unsigned n_loaded = 0;
+
 public:
   TerrainLoader(SharedMutex &_mutex, RasterTileCache &_rtc,
                 bool _scan_overview, bool _scan_all,
@@ -47,7 +56,28 @@ public:
    * Throws on error.
    */
   void UpdateTiles(struct zzip_dir *dir, const char *path,
-                   SignedRasterLocation p, unsigned radius);
+                   SignedRasterLocation p, unsigned radius,
+                   SignedRasterLocation ahead);
+
+  /**
+   * Like UpdateTiles(), but copy the tiles from a pre-decoded
+   * #RasterTileFile instead of decoding the JPEG2000 file.
+   */
+  void UpdateTiles(const RasterTileFile &file,
+                   SignedRasterLocation p, unsigned radius,
+                   SignedRasterLocation ahead) noexcept;
+
+  /**
+   * Decode all tiles and write them to a #RasterTileFile.
+   *
+   * @param source the map file being decoded
+   *
+   * Throws on error.
+   */
+  void WriteTileFile(struct zzip_dir *dir, const char *path,
+                     const RasterTileFile::Source &source,
+                     BufferedOutputStream &os,
+                     OperationEnvironment &progress);
 
   /* callback methods for libjasper (via jas_rtc.cpp) */
 
@@ -67,6 +97,19 @@ public:
                    const struct jas_matrix &m);
 
 private:
+  /**
+   * Call RasterTileCache::PollTiles() and unload the tiles it has
+   * discarded.  Only the unloading needs the exclusive lock.
+   */
+  bool PollTiles(SignedRasterLocation p, unsigned radius,
+                 SignedRasterLocation ahead) noexcept;
+
+  /**
+   * Call RasterTileCache::FinishTileUpdate() and record the pass in
+   * #TerrainStats.
+   */
+  void FinishTileUpdate(std::chrono::steady_clock::time_point start) noexcept;
+
   /**
    * Throws on error.
    */
@@ -114,18 +157,60 @@ UpdateTerrainTiles(struct zzip_dir *dir,
   UpdateTerrainTiles(dir, "terrain.jp2", tile_cache, mutex, p, radius);
 }
 
+/**
+ * Throws on error.
+ *
+ * @param ahead the end of the predicted flight path (see
+ * TerrainPrefetch::Predict()); tiles along the path are loaded first
+ * and discarded last; may be invalid
+ */
 void
 UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
                    const RasterProjection &projection,
-                   const GeoPoint &location, double radius);
+                   const GeoPoint &location, double radius,
+                   const GeoPoint &ahead=GeoPoint::Invalid());
+
+void
+UpdateTerrainTiles(const RasterTileFile &file,
+                   RasterTileCache &raster_tile_cache, SharedMutex &mutex,
+                   const RasterProjection &projection,
+                   const GeoPoint &location, double radius,
+                   const GeoPoint &ahead=GeoPoint::Invalid()) noexcept;
 
 static inline void
 UpdateTerrainTiles(struct zzip_dir *dir,
                    RasterTileCache &tile_cache, SharedMutex &mutex,
                    const RasterProjection &projection,
-                   const GeoPoint &location, double radius)
+                   const GeoPoint &location, double radius,
+                   const GeoPoint &ahead=GeoPoint::Invalid())
 {
   UpdateTerrainTiles(dir, "terrain.jp2", tile_cache, mutex,
-                     projection, location, radius);
+                     projection, location, radius, ahead);
+}
+
+/**
+ * Decode all tiles of the JPEG2000 file and write them to a
+ * #RasterTileFile.  The overview must have been loaded already (see
+ * LoadTerrainOverview()).
+ *
+ * @param source the map file, see RasterTileFile::Source::FromFile()
+ *
+ * Throws on error.
+ */
+void
+WriteTerrainTileFile(struct zzip_dir *dir, const char *path,
+                     const RasterTileFile::Source &source,
+                     RasterTileCache &raster_tile_cache,
+                     BufferedOutputStream &os,
+                     OperationEnvironment &env);
+
+static inline void
+WriteTerrainTileFile(struct zzip_dir *dir,
+                     const RasterTileFile::Source &source,
+                     RasterTileCache &tile_cache,
+                     BufferedOutputStream &os,
+                     OperationEnvironment &env)
+{
+  WriteTerrainTileFile(dir, "terrain.jp2", source, tile_cache, os, env);
 }
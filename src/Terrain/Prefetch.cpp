@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Prefetch.hpp"
+#include "Geo/GeoVector.hpp"
+
+#include <algorithm>
+
+namespace TerrainPrefetch {
+
+GeoPoint
+Predict(const GeoPoint &location, Angle track, double ground_speed,
+        const GeoPoint &waypoint, bool circling) noexcept
+{
+  if (!location.IsValid())
+    return GeoPoint::Invalid();
+
+  const GeoVector to_waypoint = waypoint.IsValid()
+    ? location.DistanceBearing(waypoint)
+    : GeoVector::Invalid();
+
+  if (!circling && ground_speed >= MIN_GROUND_SPEED) {
+    const double distance = std::min(ground_speed * LOOK_AHEAD,
+                                     MAX_DISTANCE);
+
+    /* if the track leads (roughly) to the waypoint, the path ends
+       there, because we don't know where the aircraft will go
+       next */
+    if (to_waypoint.IsValid() &&
+        track.CompareRoughly(to_waypoint.bearing, Angle::Degrees(30)))
+      return GeoVector(std::min(distance, to_waypoint.distance),
+                       to_waypoint.bearing).EndPoint(location);
+
+    return GeoVector(distance, track).EndPoint(location);
+  }
+
+  if (to_waypoint.IsValid())
+    return GeoVector(std::min(WAYPOINT_DISTANCE, to_waypoint.distance),
+                     to_waypoint.bearing).EndPoint(location);
+
+  return GeoPoint::Invalid();
+}
+
+} // namespace TerrainPrefetch
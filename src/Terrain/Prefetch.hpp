@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoPoint.hpp"
+
+/**
+ * Predict the location the aircraft is heading to, for loading
+ * terrain tiles along its path before the map gets there.
+ */
+namespace TerrainPrefetch {
+
+/**
+ * How far ahead (in seconds of flight) tiles are prefetched.
+ */
+static constexpr double LOOK_AHEAD = 300;
+
+/**
+ * The upper limit for the prefetch distance [m].
+ */
+static constexpr double MAX_DISTANCE = 50000;
+
+/**
+ * Below this ground speed [m/s], the track is not used.
+ */
+static constexpr double MIN_GROUND_SPEED = 8;
+
+/**
+ * The prefetch distance [m] towards the next waypoint when the
+ * ground speed is not meaningful (e.g. while circling).
+ */
+static constexpr double WAYPOINT_DISTANCE = 20000;
+
+/**
+ * @param location the current location (may be invalid)
+ * @param track the current track; only used if #ground_speed is
+ * positive
+ * @param ground_speed the current ground speed [m/s]; zero if unknown
+ * @param waypoint the target of the active task leg (may be invalid)
+ * @param circling is the aircraft circling?  In that case, the track
+ * is meaningless and only #waypoint is used
+ * @return the end of the predicted path or GeoPoint::Invalid() if
+ * there is no prediction
+ */
+[[gnu::pure]]
+GeoPoint
+Predict(const GeoPoint &location, Angle track, double ground_speed,
+        const GeoPoint &waypoint, bool circling) noexcept;
+
+} // namespace TerrainPrefetch
@@ -17,8 +17,8 @@ public:
   RasterBuffer(unsigned _width, unsigned _height) noexcept
     :data(_width, _height) {}
 
-  RasterBuffer(const RasterBuffer &) = delete;
-  RasterBuffer &operator=(const RasterBuffer &) = delete;
+  RasterBuffer(RasterBuffer &&) noexcept = default;
+  RasterBuffer &operator=(RasterBuffer &&) noexcept = default;
 
   bool IsDefined() const noexcept {
     return data.IsDefined();
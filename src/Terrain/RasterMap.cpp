@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <vector>
 
 void
 RasterMap::UpdateProjection() noexcept
@@ -28,6 +29,20 @@ RasterMap::GetHeight(const GeoPoint &location) const noexcept
   return raster_tile_cache.GetHeight(pt);
 }
 
+void
+RasterMap::GetHeights(std::span<const GeoPoint> locations,
+                      std::span<TerrainHeight> heights) const noexcept
+{
+  assert(heights.size() == locations.size());
+
+  std::vector<RasterLocation> points;
+  points.reserve(locations.size());
+  for (const auto &location : locations)
+    points.push_back(projection.ProjectCoarse(location));
+
+  raster_tile_cache.GetHeights(points, heights);
+}
+
 TerrainHeight
 RasterMap::GetInterpolatedHeight(const GeoPoint &location) const noexcept
 {
@@ -163,3 +178,47 @@ RasterMap::GroundIntersection(const GeoPoint &origin,
 
   return projection.UnprojectCoarse(c_int);
 }
+
+void
+RasterMap::GroundIntersections(const GeoPoint &origin,
+                               const int h_origin, const int h_glide,
+                               std::span<const GeoPoint> destinations,
+                               const int height_floor,
+                               std::span<GeoPoint> results) const noexcept
+{
+  assert(results.size() == destinations.size());
+
+  const auto c_origin = projection.ProjectCoarseRound(origin);
+
+  static constexpr std::size_t MAX_RAYS = 64;
+  RasterTileCache::GroundRay rays[MAX_RAYS];
+  std::size_t indices[MAX_RAYS];
+
+  for (std::size_t start = 0; start < destinations.size();) {
+    const std::size_t end = std::min(destinations.size(), start + MAX_RAYS);
+
+    std::size_t n = 0;
+    for (std::size_t i = start; i < end; ++i) {
+      results[i] = GeoPoint::Invalid();
+
+      const auto c_destination = projection.ProjectCoarseRound(destinations[i]);
+      const int c_diff = ManhattanDistance(c_origin, c_destination);
+      if (c_diff == 0)
+        continue;
+
+      rays[n].destination = c_destination;
+      rays[n].slope_fact = (((int)h_glide) << RASTER_SLOPE_FACT) / c_diff;
+      indices[n] = i;
+      ++n;
+    }
+
+    raster_tile_cache.GroundIntersections(c_origin, h_origin, height_floor,
+                                          std::span{rays, n});
+
+    for (std::size_t j = 0; j < n; ++j)
+      if (rays[j].result.x >= 0)
+        results[indices[j]] = projection.UnprojectCoarse(rays[j].result);
+
+    start = end;
+  }
+}
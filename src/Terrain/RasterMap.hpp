@@ -7,6 +7,8 @@
 #include "RasterTileCache.hpp"
 #include "Geo/GeoPoint.hpp"
 
+#include <span>
+
 class OperationEnvironment;
 
 class RasterMap {
@@ -23,6 +25,10 @@ public:
     return raster_tile_cache;
   }
 
+  const RasterTileCache &GetTileCache() const noexcept {
+    return raster_tile_cache;
+  }
+
   void UpdateProjection() noexcept;
 
   /**
@@ -37,6 +43,22 @@ public:
    */
   void LoadCache(BufferedReader &r);
 
+  /**
+   * Throws on error.
+   */
+  void SaveTiles(BufferedOutputStream &os, unsigned max_tiles) const {
+    raster_tile_cache.SaveTiles(os, max_tiles);
+  }
+
+  /**
+   * Throws on error.
+   *
+   * @return the number of tiles which were restored
+   */
+  unsigned LoadTiles(BufferedReader &r) {
+    return raster_tile_cache.LoadTiles(r);
+  }
+
   bool IsDefined() const noexcept {
     return raster_tile_cache.IsValid();
   }
@@ -89,6 +111,16 @@ public:
   [[gnu::pure]]
   TerrainHeight GetHeight(const GeoPoint &location) const noexcept;
 
+  /**
+   * Determine the non-interpolated heights at many locations at
+   * once; see RasterTileCache::GetHeights().
+   *
+   * @param heights receives the heights; must have the same size as
+   * #locations
+   */
+  void GetHeights(std::span<const GeoPoint> locations,
+                  std::span<TerrainHeight> heights) const noexcept;
+
   /**
    * Determine the interpolated height at the specified location.
    */
@@ -141,4 +173,17 @@ public:
                               int h_origin, int h_glide,
                               const GeoPoint &destination,
                               const int height_floor) const noexcept;
+
+  /**
+   * Like GroundIntersection() for a fan of destinations which share
+   * one origin, see RasterTileCache::GroundIntersections().
+   *
+   * @param results receives one location (or GeoPoint::Invalid())
+   * per destination
+   */
+  void GroundIntersections(const GeoPoint &origin,
+                           int h_origin, int h_glide,
+                           std::span<const GeoPoint> destinations,
+                           int height_floor,
+                           std::span<GeoPoint> results) const noexcept;
 };
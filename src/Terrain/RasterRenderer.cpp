@@ -3,6 +3,7 @@
 
 #include "Terrain/RasterRenderer.hpp"
 #include "Terrain/RasterMap.hpp"
+#include "Terrain/SlopeShading.hpp"
 #include "Math/Constants.hpp"
 #include "Screen/Layout.hpp"
 #include "ui/canvas/Ramp.hpp"
@@ -12,6 +13,13 @@
 #include "Projection/WindowProjection.hpp"
 #include "ui/event/Idle.hpp"
 
+#ifdef ENABLE_OPENGL
+#include "ui/canvas/opengl/Texture.hpp"
+#include "ui/canvas/opengl/Shaders.hpp"
+#include "ui/canvas/opengl/Program.hpp"
+#include "util/ByteOrder.hxx"
+#endif
+
 #include <algorithm> // for std::clamp()
 #include <cassert>
 #include <cstdint>
@@ -85,6 +93,12 @@ RasterRenderer::~RasterRenderer() noexcept
   delete[] color_table;
   delete image;
   delete[] contour_column_base;
+  delete[] slope_row;
+
+#ifdef ENABLE_OPENGL
+  delete height_texture;
+  delete color_bitmap;
+#endif
 }
 
 #ifdef ENABLE_OPENGL
@@ -112,17 +126,48 @@ RasterRenderer::UpdateQuantisation() noexcept
   return quantisation_pixels < last_quantisation_pixels;
 }
 
+/**
+ * Checks if the size difference of any dimension is more than a
+ * factor of two.  This is used to check whether the terrain has to be
+ * redrawn after zooming in.
+ */
+static bool
+IsLargeSizeDifference(const GeoBounds &a, const GeoBounds &b)
+{
+  assert(a.IsValid());
+  assert(b.IsValid());
+
+  return a.GetWidth().Native() > 2 * b.GetWidth().Native() ||
+    a.GetHeight().Native() > 2 * b.GetHeight().Native();
+}
+
+bool
+RasterRenderer::Covers(const GeoBounds &new_bounds) const noexcept
+{
+  return bounds.IsValid() && bounds.IsInside(new_bounds) &&
+    !IsLargeSizeDifference(bounds, new_bounds);
+}
+
 const GLTexture &
 RasterRenderer::BindAndGetTexture() const noexcept
 {
   return image->BindAndGetTexture();
 }
 
+bool
+RasterRenderer::HaveGPUShading() noexcept
+{
+  /* the texture is uploaded as bytes, and the shader expects the low
+     byte first */
+  return IsLittleEndian() && OpenGL::terrain_shader != nullptr;
+}
+
 #endif
 
 void
 RasterRenderer::ScanMap(const RasterMap &map,
-                        const WindowProjection &projection) noexcept
+                        const WindowProjection &projection,
+                        [[maybe_unused]] bool unchanged) noexcept
 {
   // Coordinates of the MapWindow center
   const auto p = projection.GetScreenCenter();
@@ -166,7 +211,10 @@ RasterRenderer::ScanMap(const RasterMap &map,
 
   last_quantisation_pixels = quantisation_pixels;
 #else
-  height_matrix.Fill(map, projection, quantisation_pixels, true);
+  if (unchanged)
+    height_matrix.Update(map, projection, quantisation_pixels, true);
+  else
+    height_matrix.Fill(map, projection, quantisation_pixels, true);
 #endif
 }
 
@@ -177,6 +225,16 @@ RasterRenderer::GenerateImage(bool do_shading,
                               const Angle sunazimuth,
                               bool do_contour) noexcept
 {
+#ifdef ENABLE_OPENGL
+  if (HaveGPUShading()) {
+    /* the shader does the rest */
+    UploadHeightMatrix();
+    UpdateShading(do_shading, height_scale, contrast, brightness,
+                  sunazimuth, do_contour);
+    return;
+  }
+#endif
+
   if (image == nullptr ||
       height_matrix.GetSize().x > image->GetSize().width ||
       height_matrix.GetSize().y > image->GetSize().height) {
@@ -185,6 +243,9 @@ RasterRenderer::GenerateImage(bool do_shading,
 
     delete[] contour_column_base;
     contour_column_base = new unsigned char[height_matrix.GetSize().x];
+
+    delete[] slope_row;
+    slope_row = new int8_t[height_matrix.GetSize().x];
   }
 
   if (quantisation_effective == 0) {
@@ -250,21 +311,32 @@ RasterRenderer::GenerateUnshadedImage(const unsigned height_scale,
 }
 
 /**
- * Clip the difference between two adjacent terrain height values to
- * sane bounds.  This works around integer overflows in the
- * GenerateSlopeImage() formula when the map file is broken, avoiding
- * the sqrt() call with a negative argument.
+ * Calculate the light source vector for GenerateSlopeImage().
  */
-static constexpr int
-ClipHeightDelta(int d) noexcept
+[[gnu::pure]]
+static SlopeShading::Light
+MakeLight(int contrast, int brightness, const Angle sunazimuth) noexcept
 {
-  return std::clamp(d, -512, 512);
+  const Angle fudgeelevation = Angle::Degrees(10) +
+    Angle::Degrees(80.0 / 255.0) * brightness;
+
+  const int sx = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastsine());
+  const int sy = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastcosine());
+  const int sz = (int)(255 * fudgeelevation.fastsine());
+
+  return {sx, sy, sz, contrast};
 }
 
-static constexpr int
-ClipHeightDelta(TerrainHeight a, TerrainHeight b) noexcept
+[[gnu::const]]
+static unsigned
+CalcHeightSlopeFactor(double pixel_size,
+                      unsigned quantisation_effective) noexcept
 {
-  return ClipHeightDelta(a.GetValue() - b.GetValue());
+  return std::clamp((unsigned)pixel_size, 1u,
+                    /* this upper limit avoids integer overflows in the
+                       "mag" formula; it effectively limits "dd2" so
+                       calculating its square will not overflow */
+                    8192u / (quantisation_effective * quantisation_effective));
 }
 
 // JMW: if zoomed right in (e.g. one unit is larger than terrain
@@ -284,12 +356,10 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
     .WithPadding(quantisation_effective);
 
   const unsigned height_slope_factor =
-    std::clamp((unsigned)pixel_size, 1u,
-               /* this upper limit avoids integer overflows in the
-                  "mag" formula; it effectively limits "dd2" so
-                  calculating its square will not overflow */
-               8192u / (quantisation_effective * quantisation_effective));
-  
+    CalcHeightSlopeFactor(pixel_size, quantisation_effective);
+
+  const SlopeShading::Light light{sx, sy, sz, contrast};
+
   const auto *src = height_matrix.GetData();
   const RawColor *oColorBuf = color_table + 64 * 256;
 
@@ -307,6 +377,13 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
 
     const unsigned p31 = row_plus_index + row_minus_index;
 
+    /* calculate the shading of the whole row first, which allows
+       vectorising the formula; "special" pixels are skipped below */
+    SlopeShading::CalcRow(src, height_matrix.GetSize().x,
+                          row_minus_offset, row_plus_offset, p31,
+                          quantisation_effective, height_slope_factor,
+                          light, slope_row);
+
     RawColor *p = dest;
     dest = image->GetNextRow(dest);
 
@@ -366,25 +443,7 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
           continue;
         }
 
-        const int p32 = ClipHeightDelta(h_above, h_below);
-        const int p22 = ClipHeightDelta(h_right, h_left);
-
-        const unsigned p20 = column_plus_index + column_minus_index;
-
-        const int dd0 = p22 * int(p31);
-        const int dd1 = int(p20) * p32;
-        const unsigned dd2 = p20 * p31 * height_slope_factor;
-        const int num = (int(dd2) * sz + dd0 * sx + dd1 * sy);
-        const unsigned square_mag = dd0 * dd0 + dd1 * dd1 + dd2 * dd2;
-        const unsigned mag = (unsigned)sqrt(square_mag);
-        /* this is a workaround for a SIGFPE (division by zero)
-           observed by our users on some Android devices (e.g. Nexus
-           7), even though we did our best to make sure that the
-           integer arithmetics above can't overflow */
-        /* TODO: debug this problem and replace this workaround */
-        const int sval = num / int(mag|1);
-        const int sindex = (sval - sz) * contrast / 128;
-        *p++ = oColorBuf[int(h) + 256 * std::clamp(sindex, -63, 63)];
+        *p++ = oColorBuf[int(h) + 256 * slope_row[x]];
       } else if (e.IsWater()) {
         // we're in the water, so look up the color for water
         *p++ = oColorBuf[255];
@@ -404,15 +463,10 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
                                    const Angle sunazimuth,
                                    const unsigned contour_height_scale) noexcept
 {
-  const Angle fudgeelevation = Angle::Degrees(10) +
-    Angle::Degrees(80.0 / 255.0) * brightness;
-
-  const int sx = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastsine());
-  const int sy = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastcosine());
-  const int sz = (int)(255 * fudgeelevation.fastsine());
+  const auto light = MakeLight(contrast, brightness, sunazimuth);
 
   GenerateSlopeImage(height_scale, contrast,
-                     sx, sy, sz, contour_height_scale);
+                     light.sx, light.sy, light.sz, contour_height_scale);
 }
 
 void
@@ -447,6 +501,16 @@ RasterRenderer::PrepareColorTable(const ColorRamp *color_ramp, bool do_water,
       color_table[i + (mag + 64) * 256] = color;
     }
   }
+
+#ifdef ENABLE_OPENGL
+  if (HaveGPUShading()) {
+    if (color_bitmap == nullptr)
+      color_bitmap = new RawBitmap(PixelSize{256, 128});
+
+    std::copy_n(color_table, 256 * 128, color_bitmap->GetBuffer());
+    color_bitmap->SetDirty();
+  }
+#endif
 }
 
 void
@@ -465,7 +529,12 @@ RasterRenderer::Draw([[maybe_unused]] Canvas &canvas,
                      [[maybe_unused]] bool transparent_white) const noexcept
 {
 #ifdef ENABLE_OPENGL
-  if (bounds.IsValid() && bounds.Overlaps(projection.GetScreenBounds()))
+  if (!bounds.IsValid() || !bounds.Overlaps(projection.GetScreenBounds()))
+    return;
+
+  if (height_texture != nullptr)
+    DrawShaded(projection);
+  else
     DrawGeoBitmap(*image,
                   PixelSize{height_matrix.GetSize()},
                   bounds,
@@ -476,3 +545,101 @@ RasterRenderer::Draw([[maybe_unused]] Canvas &canvas,
                    transparent_white);
 #endif
 }
+
+#ifdef ENABLE_OPENGL
+
+void
+RasterRenderer::UpdateShading(bool do_shading,
+                              unsigned height_scale,
+                              int contrast, int brightness,
+                              const Angle sunazimuth,
+                              bool do_contour) noexcept
+{
+  assert(HaveGPUShading());
+
+  if (quantisation_effective == 0) {
+    do_shading = false;
+    do_contour = false;
+  }
+
+  gpu.do_shading = do_shading;
+  gpu.height_scale = height_scale;
+  gpu.contour_height_scale = do_contour ? height_scale * 2 : 16;
+
+  if (do_shading) {
+    const auto light = MakeLight(contrast, brightness, sunazimuth);
+    gpu.sx = light.sx;
+    gpu.sy = light.sy;
+    gpu.sz = light.sz;
+    gpu.contrast = light.contrast;
+    gpu.step = quantisation_effective;
+    gpu.height_slope_factor =
+      CalcHeightSlopeFactor(pixel_size, quantisation_effective);
+  }
+}
+
+void
+RasterRenderer::UploadHeightMatrix() noexcept
+{
+  const PixelSize size{height_matrix.GetSize()};
+
+  if (height_texture == nullptr ||
+      size.width > height_texture->GetWidth() ||
+      size.height > height_texture->GetHeight()) {
+    delete height_texture;
+    height_texture = new GLTexture(GL_LUMINANCE_ALPHA, size,
+                                   GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE);
+
+    /* interpolating the two bytes of a height separately would be
+       meaningless */
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  } else
+    height_texture->Bind();
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.width, size.height,
+                  GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE,
+                  height_matrix.GetData());
+}
+
+void
+RasterRenderer::DrawShaded(const WindowProjection &projection) const noexcept
+{
+  assert(height_texture != nullptr);
+  assert(color_bitmap != nullptr);
+
+  glActiveTexture(GL_TEXTURE1);
+  color_bitmap->BindAndGetTexture();
+  /* exact lookups, see PrepareColorTable() */
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glActiveTexture(GL_TEXTURE0);
+
+  height_texture->Bind();
+
+  const PixelSize size{height_matrix.GetSize()};
+  const PixelSize allocated = height_texture->GetAllocatedSize();
+  const GLfloat texel_x = 1.f / allocated.width;
+  const GLfloat texel_y = 1.f / allocated.height;
+
+  OpenGL::terrain_shader->Use();
+  glUniform2f(OpenGL::terrain_texel, texel_x, texel_y);
+  glUniform2f(OpenGL::terrain_max_coord,
+              (size.width - 0.5f) * texel_x, (size.height - 0.5f) * texel_y);
+  glUniform1f(OpenGL::terrain_height_divisor, 1u << gpu.height_scale);
+  glUniform1f(OpenGL::terrain_contour_divisor,
+              1u << gpu.contour_height_scale);
+  glUniform1i(OpenGL::terrain_shading, gpu.do_shading);
+
+  if (gpu.do_shading) {
+    glUniform1f(OpenGL::terrain_sample_step, gpu.step);
+    glUniform3f(OpenGL::terrain_light, gpu.sx, gpu.sy, gpu.sz);
+    glUniform1f(OpenGL::terrain_contrast, gpu.contrast / 128.f);
+    glUniform1f(OpenGL::terrain_slope_factor, gpu.height_slope_factor);
+  }
+
+  DrawGeoTexture(*height_texture, size, bounds, projection);
+}
+
+#endif
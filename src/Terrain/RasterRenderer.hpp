@@ -5,6 +5,8 @@
 
 #include "Terrain/HeightMatrix.hpp"
 
+#include <cstdint>
+
 #ifdef ENABLE_OPENGL
 #include "Geo/GeoBounds.hpp"
 #endif
@@ -55,10 +57,39 @@ class RasterRenderer {
 
   unsigned char *contour_column_base = nullptr;
 
+  /**
+   * The shading indices of the current row, see
+   * SlopeShading::CalcRow().
+   */
+  int8_t *slope_row = nullptr;
+
   double pixel_size;
 
   RawColor *color_table = nullptr;
 
+#ifdef ENABLE_OPENGL
+  /**
+   * The raw #HeightMatrix for OpenGL::terrain_shader.  This is only
+   * used (and #image is not) if HaveGPUShading() returns true.
+   */
+  GLTexture *height_texture = nullptr;
+
+  /**
+   * A copy of #color_table for OpenGL::terrain_shader.
+   */
+  RawBitmap *color_bitmap = nullptr;
+
+  /**
+   * The parameters for OpenGL::terrain_shader, see UpdateShading().
+   */
+  struct {
+    int sx, sy, sz, contrast;
+    unsigned height_scale, contour_height_scale;
+    unsigned step, height_slope_factor;
+    bool do_shading;
+  } gpu;
+#endif
+
 public:
   RasterRenderer() noexcept;
   ~RasterRenderer() noexcept;
@@ -91,7 +122,33 @@ public:
     return bounds;
   }
 
+  /**
+   * Does the area rendered previously contain the given (visible)
+   * area, at a resolution which is still good enough?
+   */
+  [[gnu::pure]]
+  bool Covers(const GeoBounds &new_bounds) const noexcept;
+
   const GLTexture &BindAndGetTexture() const noexcept;
+
+  /**
+   * Are shading, contours and the colour ramp applied by
+   * OpenGL::terrain_shader instead of GenerateImage()?  In that
+   * case, UpdateShading() can change the shading parameters without
+   * generating a new image.
+   */
+  [[gnu::pure]]
+  static bool HaveGPUShading() noexcept;
+
+  /**
+   * Change the parameters of the GPU shading path.  Only valid if
+   * HaveGPUShading() returns true and GenerateImage() has been called
+   * at least once.  The parameters are the same as GenerateImage()'s.
+   */
+  void UpdateShading(bool do_shading,
+                     unsigned height_scale, int contrast, int brightness,
+                     const Angle sunazimuth,
+                     bool do_contour) noexcept;
 #endif
 
   /**
@@ -104,9 +161,15 @@ public:
 
   /**
    * Scan the map and fill the height matrix.
+   *
+   * @param unchanged true if the map has not changed since the
+   * previous call; this allows reusing parts of the height matrix
+   * after the projection has been scrolled (only without OpenGL,
+   * which has its own cache, see #bounds)
    */
   void ScanMap(const RasterMap &map,
-               const WindowProjection &projection) noexcept;
+               const WindowProjection &projection,
+               bool unchanged=false) noexcept;
 
   /**
    * Convert the height matrix into the image.
@@ -147,4 +210,13 @@ protected:
 
 private:
   void ContourStart(unsigned contour_height_scale) noexcept;
+
+#ifdef ENABLE_OPENGL
+  /**
+   * Copy the #HeightMatrix into #height_texture.
+   */
+  void UploadHeightMatrix() noexcept;
+
+  void DrawShaded(const WindowProjection &projection) const noexcept;
+#endif
 };
@@ -3,19 +3,25 @@
 
 #include "RasterTerrain.hpp"
 #include "Loader.hpp"
+#include "RasterTileCache.hpp"
 #include "Profile/Profile.hpp"
 #include "io/ZipArchive.hpp"
+#include "io/ZipArchiveCache.hpp"
 #include "io/FileCache.hpp"
 #include "io/FileOutputStream.hxx"
 #include "io/BufferedOutputStream.hxx"
 #include "io/Reader.hxx"
 #include "io/BufferedReader.hxx"
 #include "system/ConvertPathName.hpp"
+#include "system/FileUtil.hpp"
 #include "Operation/Operation.hpp"
 #include "util/ConvertString.hpp"
 #include "LogFile.hpp"
 
+#include <chrono>
+
 static const TCHAR *const terrain_cache_name = _T("terrain");
+static const TCHAR *const tiles_cache_name = _T("terrain_tiles");
 
 inline bool
 RasterTerrain::LoadCache(FileCache &cache, Path path)
@@ -56,7 +62,7 @@ RasterTerrain::Load(Path path, FileCache *cache,
     LogError(std::current_exception(), "Failed to load terrain cache");
   }
 
-  LoadTerrainOverview(archive.get(), map.GetTileCache(), operation);
+  LoadTerrainOverview(archive->get(), map.GetTileCache(), operation);
 
   map.UpdateProjection();
 
@@ -69,12 +75,72 @@ RasterTerrain::Load(Path path, FileCache *cache,
   }
 }
 
+inline void
+RasterTerrain::WriteTileFile(Path tile_path,
+                             const RasterTileFile::Source &source,
+                             OperationEnvironment &operation) const
+{
+  /* decode into a separate cache, so the tiles don't stay in
+     memory */
+  auto rtc = std::make_unique<RasterTileCache>();
+  LoadTerrainOverview(archive->get(), *rtc, operation);
+
+  FileOutputStream file(tile_path);
+  BufferedOutputStream bos(file);
+  WriteTerrainTileFile(archive->get(), source, *rtc, bos, operation);
+  bos.Flush();
+  file.Commit();
+}
+
+inline void
+RasterTerrain::OpenTileFile(Path path,
+                            OperationEnvironment &operation) noexcept
+{
+  const auto tile_path = path.WithSuffix(_T(".tiles"));
+  if (!File::Exists(tile_path))
+    return;
+
+  const auto source = RasterTileFile::Source::FromFile(path);
+  const auto &tile_cache = map.GetTileCache();
+
+  try {
+    auto file = std::make_unique<RasterTileFile>(tile_path);
+    if (file->IsCompatible(tile_cache.GetSize(), tile_cache.GetTileCount(),
+                           source)) {
+      tile_file = std::move(file);
+      return;
+    }
+
+    LogFormat(_T("Terrain tile file %s does not match the map"),
+              tile_path.c_str());
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to open terrain tile file");
+  }
+
+  /* the file was generated from a different (older) map file; the
+     user wants one, so rebuild it */
+  try {
+    WriteTileFile(tile_path, source, operation);
+
+    auto file = std::make_unique<RasterTileFile>(tile_path);
+    if (file->IsCompatible(tile_cache.GetSize(), tile_cache.GetTileCount(),
+                           source))
+      tile_file = std::move(file);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to rebuild terrain tile file");
+  }
+}
+
 std::unique_ptr<RasterTerrain>
 RasterTerrain::OpenTerrain(FileCache *cache, Path path,
                            OperationEnvironment &operation)
 {
-  auto rt = std::make_unique<RasterTerrain>(ZipArchive{path});
+  auto rt = std::make_unique<RasterTerrain>(path, OpenSharedZipArchive(path));
   rt->Load(path, cache, operation);
+
+  if (rt->map.GetTileCache().IsValid())
+    rt->OpenTileFile(path, operation);
+
   return rt;
 }
 
@@ -92,18 +158,83 @@ try {
 }
 
 bool
-RasterTerrain::UpdateTiles(const GeoPoint &location, double radius) noexcept
+RasterTerrain::UpdateTiles(const GeoPoint &location, double radius,
+                           const GeoPoint &ahead) noexcept
 {
   auto &tile_cache = map.GetTileCache();
   if (!tile_cache.IsValid())
     return false;
 
+  if (tile_file != nullptr) {
+    UpdateTerrainTiles(*tile_file, tile_cache, mutex,
+                       map.GetProjection(), location, radius, ahead);
+    return map.IsDirty();
+  }
+
   try {
-    UpdateTerrainTiles(archive.get(), tile_cache, mutex,
-                       map.GetProjection(), location, radius);
+    UpdateTerrainTiles(archive->get(), tile_cache, mutex,
+                       map.GetProjection(), location, radius, ahead);
   } catch (...) {
     LogError(std::current_exception(), "Failed to update terrain tiles");
   }
 
   return map.IsDirty();
 }
+
+void
+RasterTerrain::LogStats() const noexcept
+{
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+
+  const auto s = GetStats();
+
+  LogFormat("Terrain: %u tiles resident (%zu kB), %u loaded, %u evicted",
+            s.resident_tiles, s.resident_bytes / 1024,
+            (unsigned)s.tiles_loaded, (unsigned)s.evictions);
+  LogFormat("Terrain: %u%% tile hits, %u polls, %u busy, %u dirty",
+            s.GetHitPercent(), (unsigned)s.polls,
+            (unsigned)s.busy_polls, (unsigned)s.dirty_polls);
+  LogFormat("Terrain: %u load passes, %lu us per tile, %lu us max pass",
+            (unsigned)s.load_passes,
+            (unsigned long)duration_cast<microseconds>(s.GetLoadTimePerTile()).count(),
+            (unsigned long)duration_cast<microseconds>(s.max_load_time).count());
+  LogFormat("Terrain: %lu leases, %lu contended, %lu us wait, %lu us max wait",
+            (unsigned long)s.leases, (unsigned long)s.contended_leases,
+            (unsigned long)duration_cast<microseconds>(s.lease_wait).count(),
+            (unsigned long)duration_cast<microseconds>(s.max_lease_wait).count());
+}
+
+void
+RasterTerrain::SaveTiles(FileCache &cache) const noexcept
+try {
+  auto os = cache.Save(tiles_cache_name, path);
+  BufferedOutputStream bos(*os);
+
+  {
+    Lease lease(*this);
+    lease->SaveTiles(bos, MAX_SAVED_TILES);
+  }
+
+  bos.Flush();
+  os->Commit();
+} catch (...) {
+  LogError(std::current_exception(), "Failed to save terrain tiles");
+}
+
+void
+RasterTerrain::RestoreTiles(FileCache &cache) noexcept
+try {
+  if (!map.IsDefined())
+    return;
+
+  auto r = cache.Load(tiles_cache_name, path);
+  if (!r)
+    return;
+
+  BufferedReader br(*r);
+  const unsigned n = map.LoadTiles(br);
+  LogFormat("Restored %u terrain tiles", n);
+} catch (...) {
+  LogError(std::current_exception(), "Failed to restore terrain tiles");
+}
@@ -4,13 +4,15 @@
 #pragma once
 
 #include "RasterMap.hpp"
+#include "RasterTileFile.hpp"
 #include "Geo/GeoPoint.hpp"
 #include "thread/Guard.hpp"
 #include "io/ZipArchive.hpp"
+#include "system/Path.hpp"
 
+#include <chrono>
 #include <memory>
 
-class Path;
 class FileCache;
 class OperationEnvironment;
 
@@ -24,17 +26,78 @@ public:
   friend class ProtectedTaskManager; // for intersection
   friend class WaypointVisitorMap; // for intersection rendering
 
+  /**
+   * The maximum number of tiles saved by SaveTiles().
+   */
+  static constexpr unsigned MAX_SAVED_TILES = 16;
+
+  /**
+   * Like Guard::Lease, but records the time spent waiting for the
+   * lock in #TerrainStats.
+   */
+  class Lease {
+    const RasterTerrain &terrain;
+
+  public:
+    explicit Lease(const RasterTerrain &_terrain) noexcept
+      :terrain(_terrain) {
+      if (terrain.mutex.try_lock_shared())
+        terrain.map.GetTileCache().GetStats().AddLease();
+      else
+        WaitLock();
+    }
+
+    Lease(const Lease &) = delete;
+
+    ~Lease() noexcept {
+      terrain.mutex.unlock_shared();
+    }
+
+    operator const RasterMap&() const noexcept {
+      return terrain.map;
+    }
+
+    const RasterMap *operator->() const noexcept {
+      return &terrain.map;
+    }
+
+  private:
+    void WaitLock() noexcept {
+      const auto start = std::chrono::steady_clock::now();
+      terrain.mutex.lock_shared();
+      terrain.map.GetTileCache().GetStats()
+        .AddContendedLease(std::chrono::steady_clock::now() - start);
+    }
+  };
+
 private:
-  ZipArchive archive;
+  /**
+   * The path of the map file, which is the key for the #FileCache
+   * entries.
+   */
+  const AllocatedPath path;
+
+  /**
+   * Shared with the other loaders which read the map file (see
+   * OpenSharedZipArchive()).
+   */
+  const std::shared_ptr<ZipArchive> archive;
 
   RasterMap map;
 
+  /**
+   * The optional pre-decoded tiles (a "*.tiles" file next to the map
+   * file).  If present, tiles are copied from there instead of being
+   * decoded from the JPEG2000 file.
+   */
+  std::unique_ptr<RasterTileFile> tile_file;
+
 public:
   /**
    * Constructor.  Returns uninitialised object.
    */
-  explicit RasterTerrain(ZipArchive &&_archive) noexcept
-    :Guard<RasterMap>(map), archive(std::move(_archive)) {}
+  RasterTerrain(Path _path, std::shared_ptr<ZipArchive> &&_archive) noexcept
+    :Guard<RasterMap>(map), path(_path), archive(std::move(_archive)) {}
 
   const Serial &GetSerial() const noexcept {
     return map.GetSerial();
@@ -59,14 +122,54 @@ public:
     return lease->GetHeight(location);
   }
 
+  /**
+   * Look up the heights of many locations while holding the lock
+   * only once; see RasterMap::GetHeights().
+   */
+  void GetTerrainHeights(std::span<const GeoPoint> locations,
+                         std::span<TerrainHeight> heights) const noexcept {
+    Lease lease(*this);
+    lease->GetHeights(locations, heights);
+  }
+
   GeoPoint GetTerrainCenter() const noexcept {
     return map.GetMapCenter();
   }
 
   /**
+   * @param ahead the end of the predicted flight path (see
+   * TerrainPrefetch::Predict()); may be invalid
    * @return true if the method shall be called again
    */
-  bool UpdateTiles(const GeoPoint &location, double radius) noexcept;
+  bool UpdateTiles(const GeoPoint &location, double radius,
+                   const GeoPoint &ahead=GeoPoint::Invalid()) noexcept;
+
+  /**
+   * Obtain a copy of the instrumentation counters.
+   */
+  TerrainStats::Snapshot GetStats() const noexcept {
+    Lease lease(*this);
+    return lease->GetTileCache().GetStatsSnapshot();
+  }
+
+  /**
+   * Write the instrumentation counters to the log file.
+   */
+  void LogStats() const noexcept;
+
+  /**
+   * Save the loaded tiles nearest to the aircraft, so RestoreTiles()
+   * can install them right after the next start.  Errors are
+   * logged.
+   */
+  void SaveTiles(FileCache &cache) const noexcept;
+
+  /**
+   * Restore the tiles saved by SaveTiles().  This must be called
+   * before the object is shared with other threads.  Errors are
+   * logged.
+   */
+  void RestoreTiles(FileCache &cache) noexcept;
 
 private:
   /**
@@ -89,4 +192,18 @@ private:
    */
   void Load(Path path, FileCache *cache,
             OperationEnvironment &operation);
+
+  /**
+   * Decode all tiles of the map file into a new "*.tiles" file.
+   *
+   * Throws on error.
+   */
+  void WriteTileFile(Path tile_path, const RasterTileFile::Source &source,
+                     OperationEnvironment &operation) const;
+
+  /**
+   * Open the "*.tiles" file next to the map file if there is one; if
+   * it was generated from a different map file, rebuild it.
+   */
+  void OpenTileFile(Path path, OperationEnvironment &operation) noexcept;
 };
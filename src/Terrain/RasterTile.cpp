@@ -8,6 +8,7 @@
 
 #include <algorithm>
 
+#include <math.h>
 #include <stdlib.h>
 
 void
@@ -16,6 +17,7 @@ RasterTile::SaveCache(BufferedOutputStream &os) const
   MetaData data;
   data.start = start;
   data.end = end;
+  data.max_height = max_height;
 
   os.Write(std::as_bytes(std::span{&data, 1}));
 }
@@ -25,15 +27,41 @@ RasterTile::LoadCache(BufferedReader &r)
 {
   const auto data = r.ReadFullT<MetaData>();
   Set(data.start, data.end);
+
+  max_height = data.max_height >= INT16_MIN && data.max_height <= INT16_MAX
+    ? int16_t(data.max_height)
+    : UNKNOWN_MAX_HEIGHT;
 }
 
 void
-RasterTile::CopyFrom(const struct jas_matrix &m) noexcept
+RasterTile::UpdateMaxHeight(const struct jas_matrix &m) noexcept
+{
+  int result = 0;
+
+  for (unsigned y = 0, height = m.numrows_; y != height; ++y) {
+    const jas_seqent_t *gcc_restrict src = m.rows_[y];
+
+    for (unsigned i = 0, width = m.numcols_; i < width; ++i) {
+      const TerrainHeight h(src[i]);
+      if (h.IsInvalid()) {
+        max_height = UNKNOWN_MAX_HEIGHT;
+        return;
+      }
+
+      result = std::max(result, int(h.GetValueOr0()));
+    }
+  }
+
+  max_height = result;
+}
+
+RasterBuffer
+RasterTile::MakeBuffer(const struct jas_matrix &m) const noexcept
 {
   if (!IsDefined())
-    return;
+    return {};
 
-  buffer.Resize(size);
+  RasterBuffer buffer{size.x, size.y};
 
   auto *gcc_restrict dest = buffer.GetData();
   assert(dest != nullptr);
@@ -46,6 +74,21 @@ RasterTile::CopyFrom(const struct jas_matrix &m) noexcept
     for (unsigned i = 0; i < width; ++i)
       *dest++ = TerrainHeight(src[i]);
   }
+
+  return buffer;
+}
+
+RasterBuffer
+RasterTile::MakeBuffer(std::span<const TerrainHeight> src) const noexcept
+{
+  if (!IsDefined())
+    return {};
+
+  assert(src.size() == size.Area());
+
+  RasterBuffer buffer{size.x, size.y};
+  std::copy(src.begin(), src.end(), buffer.GetData());
+  return buffer;
 }
 
 TerrainHeight
@@ -92,8 +135,36 @@ RasterTile::CalcDistanceTo(IntPoint2D p) const noexcept
   return std::max(std::min(dx1, dx2), std::min(dy1, dy2));
 }
 
+unsigned
+RasterTile::CalcPathDistanceTo(IntPoint2D p, IntPoint2D ahead) const noexcept
+{
+  const unsigned direct = CalcDistanceTo(p);
+  if (ahead == p)
+    return direct;
+
+  /* project the tile center on the path */
+  const IntPoint2D center{
+    int(start.x + end.x) / 2,
+    int(start.y + end.y) / 2,
+  };
+
+  const double dx = ahead.x - p.x, dy = ahead.y - p.y;
+  const double length = hypot(dx, dy);
+  const double along = std::clamp(((center.x - p.x) * dx +
+                                   (center.y - p.y) * dy) / length,
+                                  0., length);
+
+  const IntPoint2D nearest{
+    p.x + int(dx * along / length),
+    p.y + int(dy * along / length),
+  };
+
+  return std::min(direct,
+                  CalcDistanceTo(nearest) + unsigned(along / 2));
+}
+
 inline bool
-RasterTile::CheckTileVisibility(IntPoint2D view,
+RasterTile::CheckTileVisibility(IntPoint2D view, IntPoint2D ahead,
                                 unsigned view_radius) noexcept
 {
   if (!IsDefined()) {
@@ -101,14 +172,14 @@ RasterTile::CheckTileVisibility(IntPoint2D view,
     return false;
   }
 
-  distance = CalcDistanceTo(view);
+  distance = CalcPathDistanceTo(view, ahead);
   return distance <= view_radius || IsLoaded();
 }
 
 bool
-RasterTile::VisibilityChanged(IntPoint2D view,
+RasterTile::VisibilityChanged(IntPoint2D view, IntPoint2D ahead,
                               unsigned view_radius) noexcept
 {
   request = false;
-  return CheckTileVisibility(view, view_radius);
+  return CheckTileVisibility(view, ahead, view_radius);
 }
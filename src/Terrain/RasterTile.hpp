@@ -7,6 +7,9 @@
 #include "RasterLocation.hpp"
 #include "RasterBuffer.hpp"
 
+#include <cstdint>
+#include <span>
+
 struct jas_matrix;
 class BufferedOutputStream;
 class BufferedReader;
@@ -14,19 +17,33 @@ class BufferedReader;
 class RasterTile {
   struct MetaData {
     RasterLocation start, end;
+    int32_t max_height;
   };
 
 public:
   RasterLocation start{0, 0}, end, size{0, 0};
 
   /**
-   * The distance of this tile to the center of the screen.  This
-   * attribute is used to determine which tiles should be loaded.
+   * The distance of this tile to the center of the screen or to the
+   * predicted path (see CalcPathDistanceTo()).  This attribute is used
+   * to determine which tiles should be loaded and which ones should be
+   * discarded.
    */
   unsigned distance;
 
   bool request;
 
+  static constexpr int16_t UNKNOWN_MAX_HEIGHT = INT16_MAX;
+
+  /**
+   * The maximum of TerrainHeight::GetValueOr0() of all pixels of
+   * this tile.  This is also an upper bound for the overview samples
+   * within the tile.  It is #UNKNOWN_MAX_HEIGHT if the tile has not
+   * been scanned yet or if it contains invalid pixels; this disables
+   * all shortcuts based on it.
+   */
+  int16_t max_height = UNKNOWN_MAX_HEIGHT;
+
   RasterBuffer buffer;
 
 public:
@@ -53,6 +70,19 @@ public:
     return size.x > 0 && size.y > 0;
   }
 
+  int GetMaxHeight() const noexcept {
+    return max_height;
+  }
+
+  /**
+   * Calculate #max_height from the decoded tile.
+   */
+  void UpdateMaxHeight(const struct jas_matrix &m) noexcept;
+
+  void ClearMaxHeight() noexcept {
+    max_height = UNKNOWN_MAX_HEIGHT;
+  }
+
   int GetDistance() const noexcept {
     return distance;
   }
@@ -75,17 +105,57 @@ public:
   [[gnu::pure]]
   unsigned CalcDistanceTo(IntPoint2D p) const noexcept;
 
-  bool CheckTileVisibility(IntPoint2D view, unsigned view_radius) noexcept;
+  /**
+   * Like CalcDistanceTo(), but tiles along the path from #p to #ahead
+   * appear nearer: the distance along the path counts only half.
+   * Tiles behind #p are unaffected.
+   */
+  [[gnu::pure]]
+  unsigned CalcPathDistanceTo(IntPoint2D p, IntPoint2D ahead) const noexcept;
+
+  bool CheckTileVisibility(IntPoint2D view, IntPoint2D ahead,
+                           unsigned view_radius) noexcept;
 
   void Unload() noexcept {
     buffer.Reset();
   }
 
+  /**
+   * Unload this tile, but return the buffer instead of freeing it,
+   * so the caller can free it after releasing the lock.
+   */
+  RasterBuffer StealBuffer() noexcept {
+    RasterBuffer result = std::move(buffer);
+    buffer.Reset();
+    return result;
+  }
+
+  /**
+   * Install a buffer obtained from MakeBuffer().
+   */
+  void SetBuffer(RasterBuffer &&_buffer) noexcept {
+    buffer = std::move(_buffer);
+  }
+
   bool IsLoaded() const noexcept {
     return buffer.IsDefined();
   }
 
-  void CopyFrom(const struct jas_matrix &m) noexcept;
+  /**
+   * Copy the decoded tile data into a new buffer, to be installed
+   * with SetBuffer().  This does not modify the tile, so it may run
+   * while readers access it.
+   *
+   * @return an undefined buffer if this tile is not defined
+   */
+  RasterBuffer MakeBuffer(const struct jas_matrix &m) const noexcept;
+
+  /**
+   * Like MakeBuffer(), but copy pre-decoded rows (from a
+   * #RasterTileFile).  The span must contain exactly one value per
+   * pixel of this tile.
+   */
+  RasterBuffer MakeBuffer(std::span<const TerrainHeight> src) const noexcept;
 
   /**
    * Determine the non-interpolated height at the specified pixel
@@ -110,7 +180,8 @@ public:
   TerrainHeight GetInterpolatedHeight(unsigned x, unsigned y,
                                       unsigned ix, unsigned iy) const noexcept;
 
-  bool VisibilityChanged(IntPoint2D view, unsigned view_radius) noexcept;
+  bool VisibilityChanged(IntPoint2D view, IntPoint2D ahead,
+                         unsigned view_radius) noexcept;
 
   void ScanLine(RasterLocation a, RasterLocation b,
                 TerrainHeight *dest, unsigned dest_size,
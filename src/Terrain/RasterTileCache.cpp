@@ -29,15 +29,31 @@ RasterTileCache::PutOverviewTile(unsigned index,
                                  RasterLocation start, RasterLocation end,
                                  const struct jas_matrix &m) noexcept
 {
-  tiles.GetLinear(index).Set(start, end);
+  RasterTile &tile = tiles.GetLinear(index);
+  tile.Set(start, end);
 
   const unsigned dest_pitch = overview.GetSize().x;
 
+  /* the maximum is an upper bound for the overview samples only if
+     they are all taken from this tile */
+  const unsigned overview_mask = (1u << RasterTraits::OVERVIEW_BITS) - 1;
+  const bool aligned = (start.x & overview_mask) == 0 &&
+    (start.y & overview_mask) == 0;
+
   start.x = RasterTraits::ToOverview(start.x);
   start.y = RasterTraits::ToOverview(start.y);
 
-  if (start.x >= overview.GetSize().x || start.y >= overview.GetSize().y)
+  if (start.x >= overview.GetSize().x || start.y >= overview.GetSize().y) {
+    tile.ClearMaxHeight();
     return;
+  }
+
+  if (aligned)
+    tile.UpdateMaxHeight(m);
+  else
+    tile.ClearMaxHeight();
+
+  pyramid.PutTile(tile.start, m);
 
   unsigned width = RasterTraits::ToOverviewCeil(m.numcols_);
   if (start.x + width > overview.GetSize().x)
@@ -56,15 +72,44 @@ RasterTileCache::PutOverviewTile(unsigned index,
     CopyOverviewRow(dest, m.rows_[y], width, skip);
 }
 
+RasterBuffer
+RasterTileCache::MakeTileBuffer(unsigned index,
+                                const struct jas_matrix &m) const noexcept
+{
+  const auto &tile = tiles.GetLinear(index);
+  if (!tile.IsRequested())
+    return {};
+
+  return tile.MakeBuffer(m);
+}
+
+RasterBuffer
+RasterTileCache::MakeTileBuffer(unsigned index,
+                                std::span<const TerrainHeight> data) const noexcept
+{
+  const auto &tile = tiles.GetLinear(index);
+  if (!tile.IsRequested())
+    return {};
+
+  return tile.MakeBuffer(data);
+}
+
 void
-RasterTileCache::PutTileData(unsigned index,
-                             const struct jas_matrix &m) noexcept
+RasterTileCache::PutTileBuffer(unsigned index, RasterBuffer &&buffer) noexcept
 {
   auto &tile = tiles.GetLinear(index);
-  if (!tile.IsRequested())
-    return;
+  if (tile.IsRequested())
+    tile.SetBuffer(std::move(buffer));
+}
 
-  tile.CopyFrom(m);
+void
+RasterTileCache::DiscardTiles(std::vector<RasterBuffer> &garbage) noexcept
+{
+  for (const unsigned i : discard_tiles)
+    garbage.emplace_back(tiles.GetLinear(i).StealBuffer());
+
+  stats.AddEvictions(discard_tiles.size());
+  discard_tiles.clear();
 }
 
 struct RTDistanceSort {
@@ -82,7 +127,8 @@ struct RTDistanceSort {
 };
 
 bool
-RasterTileCache::PollTiles(SignedRasterLocation p, unsigned radius) noexcept
+RasterTileCache::PollTiles(SignedRasterLocation p, unsigned radius,
+                           SignedRasterLocation ahead) noexcept
 {
   /* tiles are usually 256 pixels wide; with a radius smaller than
      that, the (optimized) tile distance calculations may fail;
@@ -103,21 +149,24 @@ RasterTileCache::PollTiles(SignedRasterLocation p, unsigned radius) noexcept
 
   request_tiles.clear();
   for (int i = tiles.GetSize() - 1; i >= 0 && !request_tiles.full(); --i)
-    if (tiles.GetLinear(i).VisibilityChanged(p, radius))
+    if (tiles.GetLinear(i).VisibilityChanged(p, ahead, radius))
       request_tiles.append(i);
 
-  /* reduce if there are too many */
+  /* sort by distance, so the nearest tiles (including the ones along
+     the predicted path) are loaded first and the farthest ones are
+     discarded */
+  const RTDistanceSort sort(*this);
+  std::sort(request_tiles.begin(), request_tiles.end(), sort);
+
+  /* reduce if there are too many; the tiles which are out of range
+     are only marked here, because unloading them requires the
+     exclusive lock (see DiscardTiles()) */
 
+  discard_tiles.clear();
   if (request_tiles.size() > MAX_ACTIVE_TILES) {
-    /* sort by distance */
-    const RTDistanceSort sort(*this);
-    std::sort(request_tiles.begin(), request_tiles.end(), sort);
-
-    /* dispose all tiles which are out of range */
-    for (unsigned i = MAX_ACTIVE_TILES; i < request_tiles.size(); ++i) {
-      RasterTile &tile = tiles.GetLinear(request_tiles[i]);
-      tile.Unload();
-    }
+    for (unsigned i = MAX_ACTIVE_TILES; i < request_tiles.size(); ++i)
+      if (tiles.GetLinear(request_tiles[i]).IsLoaded())
+        discard_tiles.append(request_tiles[i]);
 
     request_tiles.shrink(MAX_ACTIVE_TILES);
   }
@@ -126,11 +175,13 @@ RasterTileCache::PollTiles(SignedRasterLocation p, unsigned radius) noexcept
 
   dirty = false;
 
-  unsigned num_activate = 0;
+  unsigned num_loaded = 0, num_activate = 0;
   for (unsigned i = 0; i < request_tiles.size(); ++i) {
     RasterTile &tile = tiles.GetLinear(request_tiles[i]);
-    if (tile.IsLoaded())
+    if (tile.IsLoaded()) {
+      ++num_loaded;
       continue;
+    }
 
     if (++num_activate <= MAX_ACTIVATE)
       /* request the tile in the current iteration */
@@ -140,6 +191,8 @@ RasterTileCache::PollTiles(SignedRasterLocation p, unsigned radius) noexcept
       dirty = true;
   }
 
+  stats.AddPoll(num_activate > 0, dirty, num_loaded, num_activate);
+
   return num_activate > 0;
 }
 
@@ -158,6 +211,50 @@ RasterTileCache::GetHeight(RasterLocation p) const noexcept
   return overview.GetInterpolated(p << (RasterTraits::SUBPIXEL_BITS - RasterTraits::OVERVIEW_BITS));
 }
 
+void
+RasterTileCache::GetHeights(std::span<const RasterLocation> points,
+                            std::span<TerrainHeight> heights) const noexcept
+{
+  assert(heights.size() == points.size());
+
+  /* sort the point indices by tile, keeping the tile index in the
+     upper half so the pairs sort without a custom comparison */
+  std::vector<uint64_t> order;
+  order.reserve(points.size());
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const auto p = points[i];
+    if (p.x >= size.x || p.y >= size.y) {
+      // outside overall bounds
+      heights[i] = TerrainHeight::Invalid();
+      continue;
+    }
+
+    const uint64_t tile_index = (p.y / tile_size.y) * tiles.GetWidth()
+      + p.x / tile_size.x;
+    order.push_back((tile_index << 32) | i);
+  }
+
+  std::sort(order.begin(), order.end());
+
+  const RasterTile *tile = nullptr;
+  uint64_t current_tile = UINT64_MAX;
+
+  for (const uint64_t o : order) {
+    const std::size_t i = o & UINT32_MAX;
+    const uint64_t tile_index = o >> 32;
+    if (tile_index != current_tile) {
+      current_tile = tile_index;
+      tile = &tiles.GetLinear(tile_index);
+    }
+
+    const auto p = points[i];
+    heights[i] = tile->IsLoaded()
+      ? tile->GetHeight(p)
+      : overview.GetInterpolated(p << (RasterTraits::SUBPIXEL_BITS - RasterTraits::OVERVIEW_BITS));
+  }
+}
+
 TerrainHeight
 RasterTileCache::GetInterpolatedHeight(RasterLocation l) const noexcept
 {
@@ -189,6 +286,8 @@ RasterTileCache::SetSize(UnsignedPoint2D _size,
   overview.Resize({RasterTraits::ToOverviewCeil(size.x), RasterTraits::ToOverviewCeil(size.y)});
   overview_size_fine = size << RasterTraits::SUBPIXEL_BITS;
 
+  pyramid.Resize(size, {tile_size.x, tile_size.y});
+
   tiles.GrowDiscard(_n_tiles.x, _n_tiles.y);
 }
 
@@ -213,11 +312,15 @@ RasterTileCache::Reset() noexcept
   size = {0, 0};
   bounds.SetInvalid();
   segments.clear();
+  discard_tiles.clear();
 
   overview.Reset();
+  pyramid.Reset();
 
-  for (auto &i : tiles)
+  for (auto &i : tiles) {
     i.Unload();
+    i.ClearMaxHeight();
+  }
 }
 
 const RasterTileCache::MarkerSegmentInfo *
@@ -245,6 +348,21 @@ RasterTileCache::FinishTileUpdate() noexcept
   ++serial;
 }
 
+TerrainStats::Snapshot
+RasterTileCache::GetStatsSnapshot() const noexcept
+{
+  auto s = stats.GetSnapshot();
+
+  for (const auto &tile : tiles) {
+    if (tile.IsLoaded()) {
+      ++s.resident_tiles;
+      s.resident_bytes += tile.size.Area() * sizeof(TerrainHeight);
+    }
+  }
+
+  return s;
+}
+
 void
 RasterTileCache::SaveCache(BufferedOutputStream &os) const
 {
@@ -285,6 +403,8 @@ RasterTileCache::SaveCache(BufferedOutputStream &os) const
   /* save overview */
   size_t overview_size = overview.GetSize().Area();
   os.Write(std::as_bytes(std::span{overview.GetData(), overview_size}));
+
+  pyramid.Save(os);
 }
 
 void
@@ -336,4 +456,72 @@ RasterTileCache::LoadCache(BufferedReader &r)
         overview.GetData(),
         overview_size,
       }));
+
+  pyramid.Load(r);
+}
+
+void
+RasterTileCache::SaveTiles(BufferedOutputStream &os, unsigned max_tiles) const
+{
+  std::vector<unsigned> indices;
+  for (unsigned i = 0; i < tiles.GetSize(); ++i)
+    if (tiles.GetLinear(i).IsLoaded())
+      indices.push_back(i);
+
+  std::sort(indices.begin(), indices.end(), [this](unsigned a, unsigned b){
+    return tiles.GetLinear(a).GetDistance() < tiles.GetLinear(b).GetDistance();
+  });
+
+  if (indices.size() > max_tiles)
+    indices.resize(max_tiles);
+
+  TilesHeader header;
+  memset(&header, 0, sizeof(header));
+  header.version = TilesHeader::VERSION;
+  header.size = size;
+  header.n_tiles = {tiles.GetWidth(), tiles.GetHeight()};
+  header.n_saved = indices.size();
+  os.WriteT(header);
+
+  for (const unsigned i : indices) {
+    const auto &tile = tiles.GetLinear(i);
+    os.WriteT(i);
+    os.Write(std::as_bytes(std::span{
+          tile.buffer.GetData(),
+          tile.buffer.GetSize().Area(),
+        }));
+  }
+}
+
+unsigned
+RasterTileCache::LoadTiles(BufferedReader &r)
+{
+  const auto header = r.ReadFullT<TilesHeader>();
+  if (header.version != TilesHeader::VERSION ||
+      header.size != size ||
+      header.n_tiles != UnsignedPoint2D{tiles.GetWidth(), tiles.GetHeight()} ||
+      header.n_saved > MAX_ACTIVE_TILES)
+    throw std::runtime_error("Malformed terrain tiles cache header");
+
+  for (unsigned n = 0; n < header.n_saved; ++n) {
+    const auto i = r.ReadFullT<unsigned>();
+    if (i >= tiles.GetSize())
+      throw std::runtime_error("Bad tile index");
+
+    auto &tile = tiles.GetLinear(i);
+    if (!tile.IsDefined() || tile.IsLoaded())
+      throw std::runtime_error("Bad tile");
+
+    RasterBuffer buffer{tile.size.x, tile.size.y};
+    r.ReadFull(std::as_writable_bytes(std::span{
+          buffer.GetData(),
+          tile.size.Area(),
+        }));
+    tile.SetBuffer(std::move(buffer));
+  }
+
+  if (header.n_saved > 0)
+    ++serial;
+
+  return header.n_saved;
 }
@@ -5,6 +5,8 @@
 
 #include "RasterTraits.hpp"
 #include "RasterTile.hpp"
+#include "HeightPyramid.hpp"
+#include "TerrainStats.hpp"
 #include "RasterLocation.hpp"
 #include "Geo/GeoBounds.hpp"
 #include "util/StaticArray.hxx"
@@ -13,6 +15,8 @@
 #include <cassert>
 #include <cstdint>
 #include <optional>
+#include <span>
+#include <vector>
 
 static constexpr unsigned  RASTER_SLOPE_FACT = 12;
 
@@ -76,7 +80,7 @@ protected:
   };
 
   struct CacheHeader {
-    static constexpr unsigned VERSION = 0xb;
+    static constexpr unsigned VERSION = 0xd;
 
     unsigned version;
     UnsignedPoint2D size;
@@ -86,6 +90,18 @@ protected:
     GeoBounds bounds;
   };
 
+  /**
+   * The header of the file written by SaveTiles().
+   */
+  struct TilesHeader {
+    static constexpr unsigned VERSION = 1;
+
+    unsigned version;
+    UnsignedPoint2D size;
+    UnsignedPoint2D n_tiles;
+    unsigned n_saved;
+  };
+
   bool dirty;
 
   /**
@@ -98,6 +114,13 @@ protected:
   Point2D<uint_least16_t> tile_size;
 
   RasterBuffer overview;
+
+  /**
+   * Maximum heights of blocks within the tiles, built while the
+   * overview is being loaded.
+   */
+  HeightPyramid pyramid;
+
   RasterLocation size;
   RasterLocation overview_size_fine;
 
@@ -112,6 +135,18 @@ protected:
    */
   StaticArray<uint16_t, MAX_RTC_TILES> request_tiles;
 
+  /**
+   * The loaded tiles which PollTiles() has selected for unloading.
+   * See DiscardTiles().
+   */
+  StaticArray<uint16_t, MAX_RTC_TILES> discard_tiles;
+
+  /**
+   * Instrumentation counters.  This is mutable because readers
+   * update some of them (see RasterTerrain::Lease).
+   */
+  mutable TerrainStats stats;
+
 public:
   RasterTileCache() noexcept {
     Reset();
@@ -141,6 +176,19 @@ public:
   [[gnu::pure]]
   TerrainHeight GetHeight(RasterLocation p) const noexcept;
 
+  /**
+   * Determine the non-interpolated heights at many pixel locations;
+   * the result is the same as calling GetHeight() for each of them.
+   * The points are visited tile by tile, so each tile's data is
+   * looked up only once.
+   *
+   * @param points the pixel positions; may be out of range
+   * @param heights receives the heights; must have the same size as
+   * #points
+   */
+  void GetHeights(std::span<const RasterLocation> points,
+                  std::span<TerrainHeight> heights) const noexcept;
+
   /**
    * Determine the interpolated height at the specified sub-pixel
    * location.
@@ -184,7 +232,69 @@ public:
                      int h_origin, const int slope_fact,
                      int height_floor) const noexcept;
 
+  /**
+   * One ray of a fan passed to GroundIntersections().
+   */
+  struct GroundRay {
+    SignedRasterLocation destination;
+    int slope_fact;
+
+    /**
+     * The result, as returned by GroundIntersection().
+     */
+    SignedRasterLocation result;
+  };
+
+  /**
+   * Like GroundIntersection(), but for a fan of rays sharing one
+   * origin.  The rays are advanced one sample at a time in turn, so
+   * neighbouring rays examine the same tiles at about the same time.
+   * Samples in tiles or #HeightPyramid blocks whose maximum height is
+   * below the ray are cleared without reading the tile data.
+   *
+   * The results are the same as with one GroundIntersection() call
+   * per ray.
+   */
+  void GroundIntersections(SignedRasterLocation origin,
+                           int h_origin, int height_floor,
+                           std::span<GroundRay> rays) const noexcept;
+
 private:
+  class GroundWalker;
+
+  /**
+   * An area in which no terrain is higher than #max_height.
+   */
+  struct ClearArea {
+    RasterLocation start{0, 0}, end{0, 0};
+    int max_height;
+
+    /**
+     * Is the tile containing this area loaded?
+     */
+    bool loaded;
+
+    constexpr bool Contains(RasterLocation p) const noexcept {
+      return p.x >= start.x && p.x < end.x && p.y >= start.y && p.y < end.y;
+    }
+  };
+
+  /**
+   * Find the largest area containing #p (within one tile) in which
+   * no terrain is higher than #h.
+   *
+   * @return the area, or an empty one if there is none
+   */
+  [[gnu::pure]]
+  ClearArea FindClearArea(RasterLocation p, int h) const noexcept;
+
+  /**
+   * Is no terrain at #p higher than #h?  Checks #area first and
+   * replaces it with a new one from FindClearArea() if it does not
+   * answer the question.
+   */
+  bool IsClear(ClearArea &area, RasterLocation p, int h) const noexcept;
+
   /**
    * Get field (not interpolated) directly, without bringing tiles to front.
    * @param p position/256
@@ -206,6 +316,26 @@ public:
    */
   void LoadCache(BufferedReader &r);
 
+  /**
+   * Save up to #max_tiles of the loaded tiles (nearest to the most
+   * recent PollTiles() location first), to be restored by
+   * LoadTiles() after the next start.
+   *
+   * Throws on error.
+   */
+  void SaveTiles(BufferedOutputStream &os, unsigned max_tiles) const;
+
+  /**
+   * Restore the tiles saved by SaveTiles().  The overview must have
+   * been loaded already.  The caller must hold the exclusive lock
+   * (or have the only reference to this object).
+   *
+   * Throws on error.
+   *
+   * @return the number of tiles which were restored
+   */
+  unsigned LoadTiles(BufferedReader &r);
+
   /**
    * Determines if there are still tiles scheduled to be loaded.  Call
    * this after UpdateTiles() to determine if UpdateTiles() should be
@@ -258,13 +388,68 @@ public:
                        RasterLocation start, RasterLocation end,
                        const struct jas_matrix &m) noexcept;
 
-  bool PollTiles(SignedRasterLocation p, unsigned radius) noexcept;
+  /**
+   * Determine which tiles shall be loaded and which ones shall be
+   * discarded, ordered by RasterTile::CalcPathDistanceTo().  This
+   * modifies nothing readers access, so it does not need the
+   * exclusive lock; call DiscardTiles() afterwards.
+   *
+   * @param p the center of the area to be loaded
+   * @param ahead the end of the predicted path (equal to #p if there
+   * is none); tiles along this path are loaded first and discarded
+   * last
+   * @return true if tiles have been requested
+   */
+  bool PollTiles(SignedRasterLocation p, unsigned radius,
+                 SignedRasterLocation ahead) noexcept;
 
-  void PutTileData(unsigned index, const struct jas_matrix &m) noexcept;
+  bool PollTiles(SignedRasterLocation p, unsigned radius) noexcept {
+    return PollTiles(p, radius, p);
+  }
+
+  /**
+   * Copy the tile data into a new buffer if the tile was requested
+   * (or return an undefined buffer).  This modifies nothing readers
+   * access, so it may run while they hold the shared lock; install
+   * the result with PutTileBuffer().
+   */
+  RasterBuffer MakeTileBuffer(unsigned index,
+                              const struct jas_matrix &m) const noexcept;
+
+  RasterBuffer MakeTileBuffer(unsigned index,
+                              std::span<const TerrainHeight> data) const noexcept;
+
+  /**
+   * Install a buffer returned by MakeTileBuffer().  The caller must
+   * hold the exclusive lock.
+   */
+  void PutTileBuffer(unsigned index, RasterBuffer &&buffer) noexcept;
+
+  /**
+   * Unload the tiles which PollTiles() has selected.  The caller must
+   * hold the exclusive lock.  The buffers are moved to #garbage, so
+   * they can be freed after the lock has been released.
+   */
+  void DiscardTiles(std::vector<RasterBuffer> &garbage) noexcept;
+
+  bool HasDiscardedTiles() const noexcept {
+    return !discard_tiles.empty();
+  }
 
   void FinishTileUpdate() noexcept;
 
 public:
+  TerrainStats &GetStats() const noexcept {
+    return stats;
+  }
+
+  /**
+   * Copy the counters and count the loaded tiles.  The caller must
+   * hold at least the shared lock.
+   */
+  [[gnu::pure]]
+  TerrainStats::Snapshot GetStatsSnapshot() const noexcept;
+
   TerrainHeight GetMaxElevation() const noexcept {
     return overview.GetMaximum();
   }
@@ -280,6 +465,10 @@ public:
     return size;
   }
 
+  UnsignedPoint2D GetTileCount() const noexcept {
+    return {tiles.GetWidth(), tiles.GetHeight()};
+  }
+
   RasterLocation GetFineSize() const noexcept {
     return size << RasterTraits::SUBPIXEL_BITS;
   }
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "RasterTileFile.hpp"
+#include "io/FileMapping.hpp"
+#include "io/BufferedOutputStream.hxx"
+#include "system/Path.hpp"
+#include "system/FileUtil.hpp"
+
+#include <stdexcept>
+
+#include <string.h>
+
+RasterTileFile::Source
+RasterTileFile::Source::FromFile(Path path) noexcept
+{
+  using namespace std::chrono;
+
+  return {
+    File::GetSize(path),
+    duration_cast<seconds>(File::GetLastModification(path).time_since_epoch()).count(),
+  };
+}
+
+RasterTileFile::RasterTileFile(std::span<const std::byte> _data)
+  :data(_data)
+{
+  Open();
+}
+
+RasterTileFile::RasterTileFile(Path path)
+  :mapping(new FileMapping(path)),
+   data(*mapping)
+{
+  Open();
+}
+
+RasterTileFile::~RasterTileFile() noexcept = default;
+
+void
+RasterTileFile::Open()
+{
+  if (data.size() < sizeof(header))
+    throw std::runtime_error("Terrain tile file too small");
+
+  memcpy(&header, data.data(), sizeof(header));
+
+  if (header.magic != Header::MAGIC ||
+      header.endian_marker != Header::ENDIAN_MARKER)
+    throw std::runtime_error("Not a terrain tile file");
+
+  if (header.version != Header::VERSION)
+    throw std::runtime_error("Unsupported terrain tile file version");
+
+  if (header.columns < 1 || header.columns > 1024 ||
+      header.rows < 1 || header.rows > 1024)
+    throw std::runtime_error("Malformed terrain tile file header");
+
+  /* the index (and the tile data) are accessed in place */
+  if (reinterpret_cast<std::uintptr_t>(data.data()) % ALIGNMENT != 0)
+    throw std::runtime_error("Misaligned terrain tile file");
+
+  const std::size_t n_tiles = header.columns * header.rows;
+  if (data.size() < sizeof(header) + n_tiles * sizeof(IndexEntry))
+    throw std::runtime_error("Truncated terrain tile file index");
+
+  index = {
+    reinterpret_cast<const IndexEntry *>(data.data() + sizeof(header)),
+    n_tiles,
+  };
+}
+
+std::span<const TerrainHeight>
+RasterTileFile::GetTile(unsigned i, RasterLocation size) const noexcept
+{
+  if (i >= index.size())
+    return {};
+
+  const auto &entry = index[i];
+  if (entry.offset == 0 || entry.offset % ALIGNMENT != 0 ||
+      entry.width != size.x || entry.height != size.y)
+    return {};
+
+  const std::size_t n = std::size_t(entry.width) * entry.height;
+  if (entry.offset > data.size() ||
+      (data.size() - entry.offset) / sizeof(TerrainHeight) < n)
+    return {};
+
+  return {
+    reinterpret_cast<const TerrainHeight *>(data.data() + entry.offset),
+    n,
+  };
+}
+
+RasterTileFileWriter::RasterTileFileWriter(BufferedOutputStream &_os,
+                                           RasterLocation size,
+                                           UnsignedPoint2D n_tiles,
+                                           std::span<const RasterLocation> tile_sizes,
+                                           const RasterTileFile::Source &source)
+  :os(_os)
+{
+  if (tile_sizes.size() != std::size_t(n_tiles.x) * n_tiles.y)
+    throw std::invalid_argument("Wrong number of tiles");
+
+  RasterTileFile::Header header;
+  /* zero-fill all implicit padding bytes */
+  memset(&header, 0, sizeof(header));
+  header.magic = RasterTileFile::Header::MAGIC;
+  header.version = RasterTileFile::Header::VERSION;
+  header.endian_marker = RasterTileFile::Header::ENDIAN_MARKER;
+  header.width = size.x;
+  header.height = size.y;
+  header.columns = n_tiles.x;
+  header.rows = n_tiles.y;
+  header.source = source;
+  os.WriteT(header);
+
+  position = sizeof(header) + tile_sizes.size() *
+    sizeof(RasterTileFile::IndexEntry);
+
+  /* the tile data begins after the (padded) index */
+  std::size_t offset = (position + RasterTileFile::ALIGNMENT - 1) &
+    ~(RasterTileFile::ALIGNMENT - 1);
+
+  for (const auto &i : tile_sizes) {
+    RasterTileFile::IndexEntry entry{};
+    if (i.x > 0 && i.y > 0) {
+      entry.offset = offset;
+      entry.width = i.x;
+      entry.height = i.y;
+
+      offset += std::size_t(i.x) * i.y * sizeof(TerrainHeight);
+      offset = (offset + RasterTileFile::ALIGNMENT - 1) &
+        ~(RasterTileFile::ALIGNMENT - 1);
+    }
+
+    os.WriteT(entry);
+  }
+
+  Pad();
+}
+
+void
+RasterTileFileWriter::Pad()
+{
+  static constexpr std::byte zero[RasterTileFile::ALIGNMENT]{};
+
+  const std::size_t n = -position % RasterTileFile::ALIGNMENT;
+  os.Write(std::span{zero, n});
+  position += n;
+}
+
+void
+RasterTileFileWriter::WriteTile(std::span<const TerrainHeight> data)
+{
+  os.Write(std::as_bytes(data));
+  position += data.size_bytes();
+  Pad();
+}
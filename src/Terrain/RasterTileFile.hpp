@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Height.hpp"
+#include "RasterLocation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+class Path;
+class FileMapping;
+class BufferedOutputStream;
+
+/**
+ * A container with pre-decoded terrain tiles.  It is generated once
+ * from the JPEG2000 image of a map file (see WriteTerrainTileFile())
+ * and is mapped into memory, so loading a tile is a plain copy
+ * instead of a jasper decoder pass.
+ *
+ * The file consists of a #Header, one #IndexEntry per tile and the
+ * raw #TerrainHeight rows of each tile, aligned to #ALIGNMENT bytes.
+ * All integers are in host byte order; #Header::ENDIAN_MARKER
+ * rejects files which were generated on a different
+ * architecture.
+ */
+class RasterTileFile {
+public:
+  static constexpr std::size_t ALIGNMENT = 16;
+
+  /**
+   * Identifies the map file a tile file was generated from.  A tile
+   * file whose source doesn't match the map file is out of date.
+   */
+  struct Source {
+    uint64_t size;
+
+    /**
+     * The modification time in seconds since the epoch.
+     */
+    int64_t mtime;
+
+    bool operator==(const Source &) const noexcept = default;
+
+    /**
+     * Obtain the size and modification time of the given file.
+     */
+    [[gnu::pure]]
+    static Source FromFile(Path path) noexcept;
+  };
+
+  static_assert(sizeof(Source) == 16);
+
+  struct Header {
+    static constexpr uint32_t MAGIC = 0x4c544358; // "XCTL"
+    static constexpr uint16_t VERSION = 2;
+    static constexpr uint16_t ENDIAN_MARKER = 0x0102;
+
+    uint32_t magic;
+    uint16_t version;
+    uint16_t endian_marker;
+
+    /**
+     * The size of the whole map in pixels.
+     */
+    uint32_t width, height;
+
+    /**
+     * The number of tile columns and rows.
+     */
+    uint32_t columns, rows;
+
+    Source source;
+  };
+
+  static_assert(sizeof(Header) == 40);
+
+  struct IndexEntry {
+    /**
+     * The position of the tile data within the file.  Zero if this
+     * tile is not available.
+     */
+    uint64_t offset;
+
+    uint32_t width, height;
+  };
+
+  static_assert(sizeof(IndexEntry) == 16);
+
+private:
+  std::unique_ptr<FileMapping> mapping;
+
+  std::span<const std::byte> data;
+
+  Header header;
+
+  std::span<const IndexEntry> index;
+
+public:
+  /**
+   * Throws on error.
+   */
+  explicit RasterTileFile(std::span<const std::byte> _data);
+
+  /**
+   * Throws on error.
+   */
+  explicit RasterTileFile(Path path);
+
+  ~RasterTileFile() noexcept;
+
+  RasterTileFile(const RasterTileFile &) = delete;
+  RasterTileFile &operator=(const RasterTileFile &) = delete;
+
+  /**
+   * Was this file generated from the specified map file, and does it
+   * describe a map with the specified dimensions?
+   */
+  [[gnu::pure]]
+  bool IsCompatible(RasterLocation size, UnsignedPoint2D n_tiles,
+                    const Source &source) const noexcept {
+    return header.width == size.x && header.height == size.y &&
+      header.columns == n_tiles.x && header.rows == n_tiles.y &&
+      header.source == source;
+  }
+
+  /**
+   * Returns the rows of the specified tile, or an empty span if the
+   * tile is not available or its size is not the expected one.
+   */
+  [[gnu::pure]]
+  std::span<const TerrainHeight> GetTile(unsigned i,
+                                         RasterLocation size) const noexcept;
+
+private:
+  void Open();
+};
+
+/**
+ * Sequential writer for #RasterTileFile.  The tile sizes must be
+ * known in advance (they are part of the index at the beginning of
+ * the file), and the tiles must be written in index order.
+ */
+class RasterTileFileWriter {
+  BufferedOutputStream &os;
+
+  std::size_t position;
+
+public:
+  /**
+   * Writes the header and the index.  Tiles with a zero size are
+   * marked as not available.
+   *
+   * @param tile_sizes the size of each tile
+   * @param source the map file the tiles were decoded from
+   *
+   * Throws on error.
+   */
+  RasterTileFileWriter(BufferedOutputStream &_os,
+                       RasterLocation size, UnsignedPoint2D n_tiles,
+                       std::span<const RasterLocation> tile_sizes,
+                       const RasterTileFile::Source &source);
+
+  /**
+   * Throws on error.
+   */
+  void WriteTile(std::span<const TerrainHeight> data);
+
+private:
+  void Pad();
+};
@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "SlopeShading.hpp"
+#include "util/Compiler.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define HAVE_SLOPE_SIMD
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+/* 32 bit NEON has no vector square root and division */
+#include <arm_neon.h>
+#define HAVE_SLOPE_SIMD
+#endif
+
+#include <cassert>
+
+#include <string.h>
+
+namespace SlopeShading {
+
+#ifdef HAVE_SLOPE_SIMD
+
+/**
+ * Parameters of CalcBlock4() which are constant within one row.
+ */
+struct RowConstants {
+  int p20, p31;
+
+  /**
+   * dd2 * sz
+   */
+  int num0;
+
+  /**
+   * dd2 * dd2
+   */
+  float square_mag0;
+
+  int sx, sy, sz;
+
+  float contrast;
+
+  RowConstants(unsigned _p20, unsigned _p31,
+               unsigned height_slope_factor, Light light) noexcept
+    :p20(_p20), p31(_p31),
+     sx(light.sx), sy(light.sy), sz(light.sz),
+     contrast(light.contrast / 128.f) {
+    const unsigned dd2 = _p20 * _p31 * height_slope_factor;
+    num0 = int(dd2) * light.sz;
+    square_mag0 = float(dd2) * float(dd2);
+  }
+};
+
+#endif
+
+#ifdef __SSE2__
+
+static inline __m128i
+Load4(const TerrainHeight *p) noexcept
+{
+  return _mm_loadl_epi64((const __m128i *)p);
+}
+
+/**
+ * Calculate four pixels at #src, which must not be near the left or
+ * right edge (i.e. both column offsets are #step).
+ */
+[[gnu::always_inline]]
+static inline void
+CalcBlock4(const TerrainHeight *gcc_restrict src,
+           unsigned row_minus_offset, unsigned row_plus_offset,
+           unsigned step, const RowConstants &c,
+           int8_t *gcc_restrict dest) noexcept
+{
+  const __m128i min_delta = _mm_set1_epi16(-512);
+  const __m128i max_delta = _mm_set1_epi16(512);
+
+  /* saturating subtraction, so broken map files can't overflow */
+  __m128i p32 = _mm_subs_epi16(Load4(src - row_minus_offset),
+                               Load4(src + row_plus_offset));
+  __m128i p22 = _mm_subs_epi16(Load4(src + step), Load4(src - step));
+  p32 = _mm_min_epi16(_mm_max_epi16(p32, min_delta), max_delta);
+  p22 = _mm_min_epi16(_mm_max_epi16(p22, min_delta), max_delta);
+
+  /* both products are below 2^15: 512 * 2 * 25 */
+  const __m128i dd0 = _mm_mullo_epi16(p22, _mm_set1_epi16(c.p31));
+  const __m128i dd1 = _mm_mullo_epi16(p32, _mm_set1_epi16(c.p20));
+
+  /* interleave (dd0, dd1) pairs; _mm_madd_epi16() then calculates
+     dd0*a + dd1*b in each 32 bit lane */
+  const __m128i pairs = _mm_unpacklo_epi16(dd0, dd1);
+
+  const __m128i light = _mm_set1_epi32(int((unsigned(c.sy) << 16) |
+                                            (unsigned(c.sx) & 0xffff)));
+  const __m128i num = _mm_add_epi32(_mm_madd_epi16(pairs, light),
+                                    _mm_set1_epi32(c.num0));
+
+  const __m128 square_mag =
+    _mm_add_ps(_mm_cvtepi32_ps(_mm_madd_epi16(pairs, pairs)),
+               _mm_set1_ps(c.square_mag0));
+  const __m128i mag = _mm_or_si128(_mm_cvttps_epi32(_mm_sqrt_ps(square_mag)),
+                                   _mm_set1_epi32(1));
+
+  const __m128i sval =
+    _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(num), _mm_cvtepi32_ps(mag)));
+  const __m128i sindex =
+    _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(sval,
+                                                              _mm_set1_epi32(c.sz))),
+                                _mm_set1_ps(c.contrast)));
+
+  /* clamp to -63..63 and narrow to 8 bit */
+  __m128i result = _mm_packs_epi32(sindex, sindex);
+  result = _mm_min_epi16(_mm_max_epi16(result, _mm_set1_epi16(-63)),
+                         _mm_set1_epi16(63));
+  result = _mm_packs_epi16(result, result);
+
+  const int32_t packed = _mm_cvtsi128_si32(result);
+  memcpy(dest, &packed, sizeof(packed));
+}
+
+#elif defined(HAVE_SLOPE_SIMD)
+
+static inline int16x4_t
+Load4(const TerrainHeight *p) noexcept
+{
+  return vld1_s16((const int16_t *)p);
+}
+
+/**
+ * Calculate four pixels at #src, which must not be near the left or
+ * right edge (i.e. both column offsets are #step).
+ */
+[[gnu::always_inline]]
+static inline void
+CalcBlock4(const TerrainHeight *gcc_restrict src,
+           unsigned row_minus_offset, unsigned row_plus_offset,
+           unsigned step, const RowConstants &c,
+           int8_t *gcc_restrict dest) noexcept
+{
+  const int16x4_t min_delta = vdup_n_s16(-512);
+  const int16x4_t max_delta = vdup_n_s16(512);
+
+  /* saturating subtraction, so broken map files can't overflow */
+  int16x4_t p32 = vqsub_s16(Load4(src - row_minus_offset),
+                            Load4(src + row_plus_offset));
+  int16x4_t p22 = vqsub_s16(Load4(src + step), Load4(src - step));
+  p32 = vmin_s16(vmax_s16(p32, min_delta), max_delta);
+  p22 = vmin_s16(vmax_s16(p22, min_delta), max_delta);
+
+  /* both products are below 2^15: 512 * 2 * 25 */
+  const int16x4_t dd0 = vmul_n_s16(p22, int16_t(c.p31));
+  const int16x4_t dd1 = vmul_n_s16(p32, int16_t(c.p20));
+
+  const int32x4_t num =
+    vaddq_s32(vmlal_n_s16(vmull_n_s16(dd0, int16_t(c.sx)),
+                          dd1, int16_t(c.sy)),
+              vdupq_n_s32(c.num0));
+
+  const float32x4_t square_mag =
+    vaddq_f32(vcvtq_f32_s32(vmlal_s16(vmull_s16(dd0, dd0), dd1, dd1)),
+              vdupq_n_f32(c.square_mag0));
+  const int32x4_t mag = vorrq_s32(vcvtq_s32_f32(vsqrtq_f32(square_mag)),
+                                  vdupq_n_s32(1));
+
+  const int32x4_t sval =
+    vcvtq_s32_f32(vdivq_f32(vcvtq_f32_s32(num), vcvtq_f32_s32(mag)));
+  int32x4_t sindex =
+    vcvtq_s32_f32(vmulq_n_f32(vcvtq_f32_s32(vsubq_s32(sval,
+                                                      vdupq_n_s32(c.sz))),
+                              c.contrast));
+
+  /* clamp to -63..63 and narrow to 8 bit */
+  sindex = vminq_s32(vmaxq_s32(sindex, vdupq_n_s32(-63)), vdupq_n_s32(63));
+  const int16x4_t narrow = vmovn_s32(sindex);
+  const int8x8_t result = vmovn_s16(vcombine_s16(narrow, narrow));
+
+  const int32_t packed = vget_lane_s32(vreinterpret_s32_s8(result), 0);
+  memcpy(dest, &packed, sizeof(packed));
+}
+
+#endif
+
+void
+CalcRow(const TerrainHeight *gcc_restrict src, const unsigned width,
+        const unsigned row_minus_offset, const unsigned row_plus_offset,
+        const unsigned p31, const unsigned step,
+        const unsigned height_slope_factor, const Light light,
+        int8_t *gcc_restrict dest) noexcept
+{
+  assert(step > 0);
+
+  /* the columns where both horizontal samples are #step pixels
+     away */
+  const unsigned left = step;
+  const unsigned right = width > step ? width - step : 0;
+
+  const auto Portable = [&](unsigned x){
+    const unsigned column_plus_index = x < right
+      ? step
+      : width - 1 - x;
+    const unsigned column_minus_index = x >= left
+      ? step : x;
+
+    const auto *p = src + x;
+    dest[x] = CalcIndex(p[-(int)row_minus_offset].GetValue() -
+                        p[row_plus_offset].GetValue(),
+                        p[column_plus_index].GetValue() -
+                        p[-(int)column_minus_index].GetValue(),
+                        column_plus_index + column_minus_index,
+                        p31, height_slope_factor, light);
+  };
+
+  unsigned x = 0;
+
+#ifdef HAVE_SLOPE_SIMD
+  for (; x < left && x < width; ++x)
+    Portable(x);
+
+  const RowConstants c(2 * step, p31, height_slope_factor, light);
+  for (; x + 4 <= right; x += 4)
+    CalcBlock4(src + x, row_minus_offset, row_plus_offset, step, c,
+               dest + x);
+#endif
+
+  for (; x < width; ++x)
+    Portable(x);
+}
+
+} // namespace SlopeShading
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Height.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include <math.h>
+
+/**
+ * The slope shading formula of RasterRenderer::GenerateSlopeImage(),
+ * evaluated for a whole row at a time.  On SSE2 and ARM64 NEON, four
+ * pixels are calculated in parallel; everything else uses the
+ * portable implementation.
+ */
+namespace SlopeShading {
+
+/**
+ * The light source, see RasterRenderer::GenerateSlopeImage().
+ */
+struct Light {
+  int sx, sy, sz;
+  int contrast;
+};
+
+/**
+ * Clip the difference between two adjacent terrain height values to
+ * sane bounds.  This works around integer overflows in the formula
+ * when the map file is broken, avoiding the sqrt() call with a
+ * negative argument.
+ */
+static constexpr int
+ClipHeightDelta(int d) noexcept
+{
+  return std::clamp(d, -512, 512);
+}
+
+/**
+ * The portable implementation for one pixel.
+ *
+ * @param p32 the height difference in Y direction (above minus below)
+ * @param p22 the height difference in X direction (right minus left)
+ * @param p20 the distance between the left and the right sample
+ * @param p31 the distance between the upper and the lower sample
+ * @return the shading index (-63..63)
+ */
+[[gnu::const]]
+static inline int
+CalcIndex(int p32, int p22, unsigned p20, unsigned p31,
+          unsigned height_slope_factor, Light light) noexcept
+{
+  p32 = ClipHeightDelta(p32);
+  p22 = ClipHeightDelta(p22);
+
+  const int dd0 = p22 * int(p31);
+  const int dd1 = int(p20) * p32;
+  const unsigned dd2 = p20 * p31 * height_slope_factor;
+  const int num = (int(dd2) * light.sz + dd0 * light.sx + dd1 * light.sy);
+  const unsigned square_mag = dd0 * dd0 + dd1 * dd1 + dd2 * dd2;
+  const unsigned mag = (unsigned)sqrt(square_mag);
+  /* this is a workaround for a SIGFPE (division by zero)
+     observed by our users on some Android devices (e.g. Nexus
+     7), even though we did our best to make sure that the
+     integer arithmetics above can't overflow */
+  /* TODO: debug this problem and replace this workaround */
+  const int sval = num / int(mag|1);
+  const int sindex = (sval - light.sz) * light.contrast / 128;
+  return std::clamp(sindex, -63, 63);
+}
+
+/**
+ * Calculate the shading index of each pixel in one row of a
+ * #HeightMatrix.  The result for pixels which are "special" or have
+ * "special" neighbours is undefined; the caller must check that
+ * before using it.
+ *
+ * The SIMD implementations use floating point for the square root
+ * and the division, so the index may differ by one from CalcIndex().
+ *
+ * @param src the first pixel of the row
+ * @param width the number of pixels in the row
+ * @param row_minus_offset the offset of the upper sample
+ * @param row_plus_offset the offset of the lower sample
+ * @param p31 the distance between the upper and the lower sample (in
+ * rows)
+ * @param step the step size (RasterRenderer::quantisation_effective)
+ * @param dest a buffer for #width indices
+ */
+void
+CalcRow(const TerrainHeight *src, unsigned width,
+        unsigned row_minus_offset, unsigned row_plus_offset,
+        unsigned p31, unsigned step, unsigned height_slope_factor,
+        Light light, int8_t *dest) noexcept;
+
+} // namespace SlopeShading
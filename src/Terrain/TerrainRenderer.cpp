@@ -260,29 +260,25 @@ TerrainRenderer::TerrainRenderer(const RasterTerrain &_terrain)
   settings.SetDefaults();
 }
 
-#ifdef ENABLE_OPENGL
-/**
- * Checks if the size difference of any dimension is more than a
- * factor of two.  This is used to check whether the terrain has to be
- * redrawn after zooming in.
- */
-static bool
-IsLargeSizeDifference(const GeoBounds &a, const GeoBounds &b)
+void
+TerrainRenderer::PrepareColorTable() noexcept
 {
-  assert(a.IsValid());
-  assert(b.IsValid());
+  const bool do_water = true;
+  const int interp_levels = 2;
 
-  return a.GetWidth().Native() > 2 * b.GetWidth().Native() ||
-    a.GetHeight().Native() > 2 * b.GetHeight().Native();
+  const ColorRamp *const color_ramp = &terrain_colors[settings.ramp][0];
+  if (color_ramp != last_color_ramp) {
+    raster_renderer.PrepareColorTable(color_ramp, do_water,
+                                      HEIGHT_SCALE, interp_levels);
+    last_color_ramp = color_ramp;
+  }
 }
-#endif
 
 bool
 TerrainRenderer::Generate(const WindowProjection &map_projection,
                           const Angle sunazimuth)
 {
 #ifdef ENABLE_OPENGL
-  const GeoBounds &old_bounds = raster_renderer.GetBounds();
   GeoBounds new_bounds = map_projection.GetScreenBounds();
   assert(new_bounds.IsValid());
 
@@ -293,14 +289,30 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
       return false;
   }
 
-  if (old_bounds.IsValid() && old_bounds.IsInside(new_bounds) &&
-      !IsLargeSizeDifference(old_bounds, new_bounds) &&
+  if (raster_renderer.Covers(new_bounds) &&
       terrain_serial == terrain.GetSerial() &&
-      sunazimuth.CompareRoughly(last_sun_azimuth) &&
-      !raster_renderer.UpdateQuantisation())
-    /* no change since previous frame */
-    return true;
+      !raster_renderer.UpdateQuantisation()) {
+    if (RasterRenderer::HaveGPUShading()) {
+      /* the height matrix is still good; the light source, the
+         colour ramp and the other settings are applied by the
+         shader */
+      last_sun_azimuth = sunazimuth;
+      PrepareColorTable();
+      raster_renderer.UpdateShading(IsShadingEnabled(), HEIGHT_SCALE,
+                                    settings.contrast, settings.brightness,
+                                    sunazimuth, IsContourEnabled());
+      return true;
+    }
 
+    if (sunazimuth.CompareRoughly(last_sun_azimuth))
+      /* no change since previous frame */
+      return true;
+  }
+
+  /* the height matrix covers more than the screen (see
+     RasterRenderer::ScanMap()), and is filled again only after
+     leaving it */
+  const bool unchanged = false;
 #else
   if (compare_projection.Compare(map_projection) &&
       terrain_serial == terrain.GetSerial() &&
@@ -308,6 +320,11 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
     /* no change since previous frame */
     return true;
 
+  /* without new terrain tiles (and without Flush()), the previous
+     height matrix may be scrolled instead of being filled again */
+  const bool unchanged = compare_projection.IsDefined() &&
+    terrain_serial == terrain.GetSerial();
+
   compare_projection = CompareProjection(map_projection);
 #endif
 
@@ -315,30 +332,16 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
 
   last_sun_azimuth = sunazimuth;
 
-  const bool do_water = true;
-  const unsigned height_scale = 4;
-  const int interp_levels = 2;
-  const bool is_terrain = true;
-  const bool do_shading = is_terrain &&
-                          settings.slope_shading != SlopeShading::OFF;
-  const bool do_contour = is_terrain &&
-                          settings.contours != Contours::OFF;
-
-  const ColorRamp *const color_ramp = &terrain_colors[settings.ramp][0];
-  if (color_ramp != last_color_ramp) {
-    raster_renderer.PrepareColorTable(color_ramp, do_water,
-                                      height_scale, interp_levels);
-    last_color_ramp = color_ramp;
-  }
+  PrepareColorTable();
 
   {
     RasterTerrain::Lease map(terrain);
-    raster_renderer.ScanMap(map, map_projection);
+    raster_renderer.ScanMap(map, map_projection, unchanged);
   }
 
-  raster_renderer.GenerateImage(do_shading, height_scale,
+  raster_renderer.GenerateImage(IsShadingEnabled(), HEIGHT_SCALE,
                                 settings.contrast, settings.brightness,
                                 sunazimuth,
-                                do_contour);
+                                IsContourEnabled());
   return true;
 }
@@ -17,6 +17,8 @@ class RasterTerrain;
 struct ColorRamp;
 
 class TerrainRenderer {
+  static constexpr unsigned HEIGHT_SCALE = 4;
+
   const RasterTerrain &terrain;
 
   Serial terrain_serial;
@@ -71,4 +73,15 @@ public:
   void Draw(Canvas &canvas, const WindowProjection &projection) const {
     raster_renderer.Draw(canvas, projection);
   }
+
+private:
+  bool IsShadingEnabled() const noexcept {
+    return settings.slope_shading != SlopeShading::OFF;
+  }
+
+  bool IsContourEnabled() const noexcept {
+    return settings.contours != Contours::OFF;
+  }
+
+  void PrepareColorTable() noexcept;
 };
@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Counters describing how the terrain tile cache behaves.  They are
+ * meant for tuning RasterTileCache::MAX_ACTIVE_TILES and the terrain
+ * packages for a device class.
+ *
+ * Some counters are updated by reader threads which hold only the
+ * shared lock, therefore all of them are relaxed atomics; a
+ * #Snapshot is not guaranteed to be consistent.
+ */
+class TerrainStats {
+public:
+  using Duration = std::chrono::steady_clock::duration;
+
+  struct Snapshot {
+    /**
+     * The number of RasterTileCache::PollTiles() calls, the number of
+     * calls which requested tiles, and the number of calls which left
+     * tiles for the next call (IsDirty()).
+     */
+    uint_least32_t polls, busy_polls, dirty_polls;
+
+    /**
+     * The number of tiles within range found to be loaded already
+     * (hits) or not yet loaded (misses) by PollTiles().  A tile
+     * which is deferred to the next call is counted again.
+     */
+    uint_least64_t tile_hits, tile_misses;
+
+    /**
+     * The number of tiles which were decoded (or copied from a
+     * #RasterTileFile) and installed.
+     */
+    uint_least32_t tiles_loaded;
+
+    /**
+     * The number of loaded tiles discarded by PollTiles().
+     */
+    uint_least32_t evictions;
+
+    /**
+     * The number of passes which loaded tiles, their total and
+     * their longest duration.
+     */
+    uint_least32_t load_passes;
+    Duration load_time, max_load_time;
+
+    /**
+     * The number of RasterTerrain::Lease objects created, the number
+     * of those which had to wait for the lock, and the total and
+     * longest wait.
+     */
+    uint_least64_t leases, contended_leases;
+    Duration lease_wait, max_lease_wait;
+
+    /**
+     * The loaded tiles at the time of the snapshot.
+     */
+    unsigned resident_tiles;
+    std::size_t resident_bytes;
+
+    /**
+     * @return the percentage of tiles in range which were already
+     * loaded
+     */
+    constexpr unsigned GetHitPercent() const noexcept {
+      const auto total = tile_hits + tile_misses;
+      return total > 0
+        ? unsigned(tile_hits * 100 / total)
+        : 100;
+    }
+
+    constexpr Duration GetLoadTimePerTile() const noexcept {
+      return tiles_loaded > 0
+        ? load_time / tiles_loaded
+        : Duration::zero();
+    }
+  };
+
+private:
+  using Rep = Duration::rep;
+
+  std::atomic<uint_least32_t> polls{0}, busy_polls{0}, dirty_polls{0};
+  std::atomic<uint_least64_t> tile_hits{0}, tile_misses{0};
+  std::atomic<uint_least32_t> tiles_loaded{0}, evictions{0};
+  std::atomic<uint_least32_t> load_passes{0};
+  std::atomic<Rep> load_time{0}, max_load_time{0};
+  std::atomic<uint_least64_t> leases{0}, contended_leases{0};
+  std::atomic<Rep> lease_wait{0}, max_lease_wait{0};
+
+public:
+  void AddPoll(bool busy, bool dirty,
+               unsigned hits, unsigned misses) noexcept {
+    Add(polls, 1);
+    if (busy)
+      Add(busy_polls, 1);
+    if (dirty)
+      Add(dirty_polls, 1);
+    Add(tile_hits, hits);
+    Add(tile_misses, misses);
+  }
+
+  void AddEvictions(unsigned n) noexcept {
+    Add(evictions, n);
+  }
+
+  void AddLoadPass(unsigned n_tiles, Duration duration) noexcept {
+    Add(load_passes, 1);
+    Add(tiles_loaded, n_tiles);
+    Add(load_time, duration.count());
+    UpdateMax(max_load_time, duration.count());
+  }
+
+  /**
+   * A lease was obtained without waiting.
+   */
+  void AddLease() noexcept {
+    Add(leases, 1);
+  }
+
+  void AddContendedLease(Duration wait) noexcept {
+    Add(leases, 1);
+    Add(contended_leases, 1);
+    Add(lease_wait, wait.count());
+    UpdateMax(max_lease_wait, wait.count());
+  }
+
+  /**
+   * Copy the counters.  The "resident" attributes are left zero;
+   * they are filled by RasterTileCache::GetStatsSnapshot().
+   */
+  Snapshot GetSnapshot() const noexcept {
+    Snapshot s{};
+    s.polls = Get(polls);
+    s.busy_polls = Get(busy_polls);
+    s.dirty_polls = Get(dirty_polls);
+    s.tile_hits = Get(tile_hits);
+    s.tile_misses = Get(tile_misses);
+    s.tiles_loaded = Get(tiles_loaded);
+    s.evictions = Get(evictions);
+    s.load_passes = Get(load_passes);
+    s.load_time = Duration{Get(load_time)};
+    s.max_load_time = Duration{Get(max_load_time)};
+    s.leases = Get(leases);
+    s.contended_leases = Get(contended_leases);
+    s.lease_wait = Duration{Get(lease_wait)};
+    s.max_lease_wait = Duration{Get(max_lease_wait)};
+    return s;
+  }
+
+private:
+  template<typename T>
+  static void Add(std::atomic<T> &counter,
+                  std::type_identity_t<T> value) noexcept {
+    counter.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  template<typename T>
+  static T Get(const std::atomic<T> &counter) noexcept {
+    return counter.load(std::memory_order_relaxed);
+  }
+
+  static void UpdateMax(std::atomic<Rep> &counter, Rep value) noexcept {
+    Rep old = Get(counter);
+    while (value > old &&
+           !counter.compare_exchange_weak(old, value,
+                                          std::memory_order_relaxed)) {}
+  }
+};
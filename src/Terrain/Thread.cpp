@@ -11,8 +11,25 @@ TerrainThread::TerrainThread(RasterTerrain &_terrain,
   :StandbyThread("Terrain"), terrain(_terrain),
    callback(std::move(_callback)) {}
 
+/**
+ * Has the predicted path moved so little that reloading tiles is not
+ * worth it?
+ */
+[[gnu::pure]]
+static bool
+IsSameAhead(const GeoPoint &a, const GeoPoint &b) noexcept
+{
+  if (!a.IsValid() || !b.IsValid())
+    return a.IsValid() == b.IsValid();
+
+  /* the predicted location is far away, and small track changes
+     move it a lot; be more tolerant than with the center */
+  return a.DistanceS(b) < 2000;
+}
+
 void
-TerrainThread::Trigger(const WindowProjection &projection)
+TerrainThread::Trigger(const WindowProjection &projection,
+                       const GeoPoint &ahead)
 {
   assert(projection.IsValid());
 
@@ -21,11 +38,13 @@ TerrainThread::Trigger(const WindowProjection &projection)
   GeoPoint center = projection.GetGeoScreenCenter();
   auto radius = projection.GetScreenWidthMeters() / 2;
   if (last_center.IsValid() && last_radius >= radius &&
-      last_center.DistanceS(center) < 1000)
+      last_center.DistanceS(center) < 1000 &&
+      IsSameAhead(last_ahead, ahead))
     return;
 
   next_center = center;
   next_radius = radius;
+  next_ahead = ahead;
   StandbyThread::Trigger();
 }
 
@@ -38,14 +57,16 @@ TerrainThread::Tick() noexcept
   while (next_center.IsValid() && again && !IsStopped()) {
     const GeoPoint center = next_center;
     const auto radius = next_radius;
+    const GeoPoint ahead = next_ahead;
 
     {
       const ScopeUnlock unlock(mutex);
-      again = terrain.UpdateTiles(center, radius);
+      again = terrain.UpdateTiles(center, radius, ahead);
     }
 
     last_center = center;
     last_radius = radius;
+    last_ahead = ahead;
   }
 
   /* notify the client */
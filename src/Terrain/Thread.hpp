@@ -22,15 +22,24 @@ class TerrainThread final : private StandbyThread {
   GeoPoint last_center = GeoPoint::Invalid();
   double last_radius;
 
+  GeoPoint last_ahead = GeoPoint::Invalid();
+
   GeoPoint next_center;
   double next_radius;
+  GeoPoint next_ahead;
 
 public:
   TerrainThread(RasterTerrain &_terrain, std::function<void()> &&_callback);
 
   using StandbyThread::LockStop;
 
-  void Trigger(const WindowProjection &projection);
+  /**
+   * @param ahead the end of the predicted flight path (see
+   * TerrainPrefetch::Predict()); tiles along the path are loaded
+   * first; may be invalid
+   */
+  void Trigger(const WindowProjection &projection,
+               const GeoPoint &ahead=GeoPoint::Invalid());
 
 private:
   /* virtual methods from class StandbyThread*/
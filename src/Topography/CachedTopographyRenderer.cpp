@@ -3,6 +3,7 @@
 
 #include "CachedTopographyRenderer.hpp"
 #include "TopographyStore.hpp"
+#include "Projection/WindowProjection.hpp"
 
 #ifndef ENABLE_OPENGL
 
@@ -10,10 +11,22 @@ void
 CachedTopographyRenderer::Draw(Canvas &canvas,
                                const WindowProjection &projection) noexcept
 {
-  if (renderer.GetStore().GetSerial() != last_serial ||
-      !cache.Check(projection)) {
+  if (renderer.GetStore().GetSerial() != last_serial) {
     last_serial = renderer.GetStore().GetSerial();
+    tile_cache.Invalidate();
+    cache.Invalidate();
+  }
+
+  /* a zoom level is worth rendering tiles for only if it has been
+     used for more than one frame; this skips the intermediate
+     levels of smooth zooming */
+  const bool stable_scale = projection.GetScale() == last_scale;
+  last_scale = projection.GetScale();
+
+  if (stable_scale && tile_cache.Draw(canvas, projection, renderer))
+    return;
 
+  if (!cache.Check(projection)) {
     Canvas &buffer_canvas = cache.Begin(canvas, projection);
     buffer_canvas.ClearWhite();
     renderer.Draw(buffer_canvas, projection);
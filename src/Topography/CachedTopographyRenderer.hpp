@@ -6,6 +6,10 @@
 #include "TopographyRenderer.hpp"
 #include "Renderer/TransparentRendererCache.hpp"
 
+#ifndef ENABLE_OPENGL
+#include "TopographyTileCache.hpp"
+#endif
+
 /**
  * Class used to manage and render vector topography layers
  */
@@ -13,9 +17,23 @@ class CachedTopographyRenderer {
   TopographyRenderer renderer;
 
 #ifndef ENABLE_OPENGL
+  /**
+   * Used for north-up projections at a stable zoom level.
+   */
+  TopographyTileCache tile_cache;
+
+  /**
+   * A full-screen cache which is used while #tile_cache is not
+   * usable, i.e. while the map is rotated or zooming.
+   */
   TransparentRendererCache cache;
 
   unsigned last_serial = 0;
+
+  /**
+   * The projection scale of the previous Draw() call.
+   */
+  double last_scale = -1;
 #endif
 
 public:
@@ -26,6 +44,7 @@ public:
 
   void Flush() noexcept {
 #ifndef ENABLE_OPENGL
+    tile_cache.Invalidate();
     cache.Invalidate();
 #endif
   }
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ShapeBufferAllocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+unsigned
+ShapeBufferAllocator::GetFreeSize() const noexcept
+{
+  unsigned result = 0;
+  for (const auto &i : free_list)
+    result += i.size;
+  return result;
+}
+
+void
+ShapeBufferAllocator::Reset(unsigned _capacity) noexcept
+{
+  capacity = _capacity;
+  free_list.clear();
+  if (capacity > 0)
+    free_list.push_back({0, capacity});
+}
+
+unsigned
+ShapeBufferAllocator::Allocate(unsigned size) noexcept
+{
+  assert(size > 0);
+
+  const auto i = std::find_if(free_list.begin(), free_list.end(),
+                              [size](const Range &r){
+                                return r.size >= size;
+                              });
+  if (i == free_list.end())
+    return NONE;
+
+  const unsigned offset = i->offset;
+  if (i->size == size)
+    free_list.erase(i);
+  else {
+    i->offset += size;
+    i->size -= size;
+  }
+
+  return offset;
+}
+
+void
+ShapeBufferAllocator::Free(unsigned offset, unsigned size) noexcept
+{
+  assert(size > 0);
+  assert(offset + size <= capacity);
+
+  auto next = std::lower_bound(free_list.begin(), free_list.end(), offset,
+                               [](const Range &r, unsigned o){
+                                 return r.offset < o;
+                               });
+  assert(next == free_list.end() || next->offset >= offset + size);
+
+  if (next != free_list.begin()) {
+    auto prev = std::prev(next);
+    assert(prev->offset + prev->size <= offset);
+
+    if (prev->offset + prev->size == offset) {
+      /* merge with the previous range */
+      prev->size += size;
+
+      if (next != free_list.end() && prev->offset + prev->size == next->offset) {
+        prev->size += next->size;
+        free_list.erase(next);
+      }
+
+      return;
+    }
+  }
+
+  if (next != free_list.end() && offset + size == next->offset) {
+    /* merge with the next range */
+    next->offset = offset;
+    next->size += size;
+    return;
+  }
+
+  free_list.insert(next, {offset, size});
+}
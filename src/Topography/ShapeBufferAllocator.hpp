@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <vector>
+
+/**
+ * Manages the space in a long-lived vertex buffer with a first-fit
+ * free list.  It only does the bookkeeping; the units are chosen by
+ * the caller (e.g. #ShapePoint elements).
+ */
+class ShapeBufferAllocator {
+  struct Range {
+    unsigned offset, size;
+  };
+
+  unsigned capacity = 0;
+
+  /**
+   * The free ranges, sorted by offset.  Adjacent ranges are always
+   * merged.
+   */
+  std::vector<Range> free_list;
+
+public:
+  static constexpr unsigned NONE = ~0u;
+
+  unsigned GetCapacity() const noexcept {
+    return capacity;
+  }
+
+  [[gnu::pure]]
+  unsigned GetFreeSize() const noexcept;
+
+  /**
+   * Discard all allocations and start over with the specified
+   * capacity.
+   */
+  void Reset(unsigned _capacity) noexcept;
+
+  /**
+   * @return the offset of the new range, or #NONE if there is no
+   * free range large enough
+   */
+  unsigned Allocate(unsigned size) noexcept;
+
+  /**
+   * Return a range obtained from Allocate().
+   */
+  void Free(unsigned offset, unsigned size) noexcept;
+};
@@ -36,12 +36,14 @@ public:
     return obj.bounds;
   }
 
-  int WhichShapes(struct zzip_dir *dir, rectObj rect) noexcept {
-    return msShapefileWhichShapes(&obj, dir, rect, 0);
-  }
-
-  ms_const_bitarray GetStatus() const noexcept {
-    return obj.status;
+  /**
+   * Read the bounds of one shape.
+   *
+   * @return false if the shape is a NULL shape or if it could not be
+   * read
+   */
+  bool ReadBounds(std::size_t i, rectObj &bounds) noexcept {
+    return msSHPReadBounds(obj.hSHP, i, &bounds) == MS_SUCCESS;
   }
 
   /**
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ShapeIndex.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+/**
+ * A node with up to this many shapes is not split.
+ */
+static constexpr std::size_t LEAF_SIZE = 16;
+
+static constexpr unsigned MAX_DEPTH = 12;
+
+ShapeIndex::Rect
+ShapeIndex::Rect::Outward(double left, double bottom,
+                          double right, double top) noexcept
+{
+  constexpr float inf = std::numeric_limits<float>::infinity();
+
+  const auto down = [](double value){
+    const float f = float(value);
+    return double(f) > value ? std::nextafter(f, -inf) : f;
+  };
+
+  const auto up = [](double value){
+    const float f = float(value);
+    return double(f) < value ? std::nextafter(f, inf) : f;
+  };
+
+  return {down(left), down(bottom), up(right), up(top)};
+}
+
+ShapeIndex::ShapeIndex(std::vector<Rect> &&_rects) noexcept
+  :rects(std::move(_rects))
+{
+  std::vector<uint32_t> items;
+  items.reserve(rects.size());
+
+  Rect bounds = Rect::Empty();
+  for (std::size_t i = 0; i < rects.size(); ++i) {
+    const Rect &r = rects[i];
+    if (r.IsEmpty())
+      continue;
+
+    if (items.empty())
+      bounds = r;
+    else
+      bounds = {
+        std::min(bounds.left, r.left),
+        std::min(bounds.bottom, r.bottom),
+        std::max(bounds.right, r.right),
+        std::max(bounds.top, r.top),
+      };
+
+    items.push_back(i);
+  }
+
+  ids.reserve(items.size());
+  Build(bounds, items, 0);
+}
+
+uint32_t
+ShapeIndex::Build(const Rect &bounds, std::span<uint32_t> items,
+                  unsigned depth) noexcept
+{
+  const uint32_t index = nodes.size();
+  nodes.push_back({bounds, 0, 0, {}});
+
+  const float mid_x = (bounds.left + bounds.right) / 2;
+  const float mid_y = (bounds.bottom + bounds.top) / 2;
+  const Rect quadrants[4] = {
+    {bounds.left, mid_y, mid_x, bounds.top},
+    {mid_x, mid_y, bounds.right, bounds.top},
+    {bounds.left, bounds.bottom, mid_x, mid_y},
+    {mid_x, bounds.bottom, bounds.right, mid_y},
+  };
+
+  /* move the items which fit in a quadrant to the end, sorted by
+     quadrant, and keep the others in this node */
+  auto first_child_item = items.end();
+  if (items.size() > LEAF_SIZE && depth < MAX_DEPTH) {
+    first_child_item = std::stable_partition(items.begin(), items.end(),
+                                             [&](uint32_t i){
+      const Rect &r = rects[i];
+      return std::none_of(std::begin(quadrants), std::end(quadrants),
+                          [&r](const Rect &q){ return q.Contains(r); });
+    });
+  }
+
+  nodes[index].begin = ids.size();
+  ids.insert(ids.end(), items.begin(), first_child_item);
+  nodes[index].end = ids.size();
+
+  for (unsigned q = 0; q < 4 && first_child_item != items.end(); ++q) {
+    const auto end = std::stable_partition(first_child_item, items.end(),
+                                           [&](uint32_t i){
+      return quadrants[q].Contains(rects[i]);
+    });
+
+    if (end != first_child_item) {
+      const uint32_t child =
+        Build(quadrants[q], {first_child_item, end}, depth + 1);
+      nodes[index].children[q] = child;
+    }
+
+    first_child_item = end;
+  }
+
+  return index;
+}
+
+void
+ShapeIndex::Query(const Node &node, const Rect &query,
+                  std::vector<uint32_t> &result) const noexcept
+{
+  if (!node.bounds.Overlaps(query))
+    return;
+
+  if (query.Contains(node.bounds)) {
+    /* everything in this subtree is a hit */
+    for (uint32_t i = node.begin; i < node.end; ++i)
+      result.push_back(ids[i]);
+  } else {
+    for (uint32_t i = node.begin; i < node.end; ++i)
+      if (rects[ids[i]].Overlaps(query))
+        result.push_back(ids[i]);
+  }
+
+  for (const uint32_t child : node.children)
+    if (child != 0)
+      Query(nodes[child], query, result);
+}
+
+void
+ShapeIndex::Query(const Rect &query,
+                  std::vector<uint32_t> &result) const noexcept
+{
+  result.clear();
+
+  assert(!nodes.empty());
+  if (!query.IsEmpty())
+    Query(nodes.front(), query, result);
+
+  std::sort(result.begin(), result.end());
+}
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * An in-memory quadtree over the bounding boxes of the shapes of one
+ * file.  It is built once, and each node refers to a range of shape
+ * numbers; a shape is stored in the smallest node which contains it
+ * completely.
+ */
+class ShapeIndex {
+public:
+  struct Rect {
+    float left, bottom, right, top;
+
+    /**
+     * A rectangle which does not overlap anything, e.g. for shapes
+     * without bounds.
+     */
+    static constexpr Rect Empty() noexcept {
+      return {1, 1, -1, -1};
+    }
+
+    /**
+     * Convert from double, rounding outwards, so the result contains
+     * the original rectangle.
+     */
+    [[gnu::const]]
+    static Rect Outward(double left, double bottom,
+                        double right, double top) noexcept;
+
+    constexpr bool IsEmpty() const noexcept {
+      return left > right || bottom > top;
+    }
+
+    /**
+     * Edges touching counts as overlap.
+     */
+    constexpr bool Overlaps(const Rect &other) const noexcept {
+      return left <= other.right && other.left <= right &&
+        bottom <= other.top && other.bottom <= top;
+    }
+
+    constexpr bool Contains(const Rect &other) const noexcept {
+      return left <= other.left && other.right <= right &&
+        bottom <= other.bottom && other.top <= top;
+    }
+  };
+
+private:
+  struct Node {
+    Rect bounds;
+
+    /**
+     * The range of #ids stored in this node.
+     */
+    uint32_t begin, end;
+
+    /**
+     * The indices of the child nodes in #nodes, 0 if there is none
+     * (the root is never a child).
+     */
+    uint32_t children[4];
+  };
+
+  /**
+   * The bounds of each shape.
+   */
+  std::vector<Rect> rects;
+
+  /**
+   * The root is the first node.
+   */
+  std::vector<Node> nodes;
+
+  /**
+   * Shape numbers, grouped by node.
+   */
+  std::vector<uint32_t> ids;
+
+public:
+  /**
+   * @param rects the bounds of each shape; an empty rectangle means
+   * the shape is never found
+   */
+  explicit ShapeIndex(std::vector<Rect> &&_rects) noexcept;
+
+  std::size_t size() const noexcept {
+    return rects.size();
+  }
+
+  /**
+   * Find all shapes overlapping the given rectangle.
+   *
+   * @param result the shape numbers are stored here, in ascending
+   * order (after clearing it)
+   */
+  void Query(const Rect &query, std::vector<uint32_t> &result) const noexcept;
+
+private:
+  uint32_t Build(const Rect &bounds, std::span<uint32_t> items,
+                 unsigned depth) noexcept;
+
+  void Query(const Node &node, const Rect &query,
+             std::vector<uint32_t> &result) const noexcept;
+};
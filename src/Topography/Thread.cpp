@@ -9,6 +9,7 @@ TopographyThread::TopographyThread(TopographyStore &_store,
   :StandbyThread("Topography"),
    store(_store),
    callback(std::move(_callback)),
+   pool("TopographyPool", ThreadPool::GetDefaultWorkers(3), true),
    last_bounds(GeoBounds::Invalid()) {}
 
 TopographyThread::~TopographyThread()
@@ -53,7 +54,7 @@ TopographyThread::Tick() noexcept
     const WindowProjection projection = next_projection;
 
     const ScopeUnlock unlock(mutex);
-    again = store.ScanVisibility(projection, 1) > 0;
+    again = store.ScanVisibility(projection, pool, callback) > 0;
   }
 
   /* notify the client that we have updated the topography cache */
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "thread/StandbyThread.hpp"
+#include "thread/ThreadPool.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Geo/GeoBounds.hpp"
 
@@ -12,13 +13,17 @@
 class TopographyStore;
 
 /**
- * A thread that loads topography files asynchronously.
+ * A thread that loads topography files asynchronously.  The files are
+ * updated in parallel on a small #ThreadPool, and the callback is
+ * invoked as soon as each one is ready.
  */
 class TopographyThread final : private StandbyThread {
   TopographyStore &store;
 
   const std::function<void()> callback;
 
+  ThreadPool pool;
+
   WindowProjection next_projection;
 
   GeoBounds last_bounds;
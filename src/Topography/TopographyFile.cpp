@@ -10,7 +10,9 @@
 #include <zzip/lib.h>
 
 #include <algorithm>
+#include <bit>
 #include <stdexcept>
+#include <vector>
 
 TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
                                double _threshold,
@@ -21,14 +23,49 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
                                ResourceId _icon, ResourceId _big_icon,
                                unsigned _pen_width)
   :dir(_dir),
-   file(dir, filename),
+   file(std::in_place, dir, filename),
    label_field(_label_field), icon(_icon), big_icon(_big_icon),
    pen_width(_pen_width),
    color(_color), scale_threshold(_threshold),
    label_threshold(_label_threshold),
    important_label_threshold(_important_label_threshold)
 {
-  const std::size_t n_shapes = file.size();
+  Init(file->size(), ImportRect(file->GetBounds()));
+
+  if (label_field >= 0)
+    label_cache = std::make_unique<LabelCache>();
+
+  if (dir != nullptr)
+    ++dir->refcount;
+}
+
+TopographyFile::TopographyFile(const TopographyPackage::Layer &layer,
+                               double _threshold,
+                               double _label_threshold,
+                               double _important_label_threshold,
+                               const BGRA8Color _color,
+                               ResourceId _icon, ResourceId _big_icon,
+                               unsigned _pen_width)
+  :dir(nullptr),
+   package_layer(&layer),
+   label_field(-1), icon(_icon), big_icon(_big_icon),
+   pen_width(_pen_width),
+   color(_color), scale_threshold(_threshold),
+   label_threshold(_label_threshold),
+   important_label_threshold(_important_label_threshold)
+{
+  Init(layer.size(), layer.GetBounds());
+
+  /* the points are relative to the center which was used by
+     the converter */
+  center = layer.GetCenter();
+
+  package_status.ResizeDiscard((layer.size() + 31) / 32);
+}
+
+void
+TopographyFile::Init(std::size_t n_shapes, const GeoBounds &file_bounds)
+{
   constexpr std::size_t MAX_SHAPES = 16 * 1024 * 1024;
   if (n_shapes == 0)
     throw std::runtime_error{"Empty shapefile"};
@@ -36,7 +73,6 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
   if (n_shapes > MAX_SHAPES)
     throw std::runtime_error{"Too many shapes in shapefile"};
 
-  const auto file_bounds = ImportRect(file.GetBounds());
   if (!file_bounds.Check())
     throw std::runtime_error{"Malformed shapefile bounds"};
 
@@ -44,9 +80,6 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
 
   shapes.ResizeDiscard(n_shapes);
 
-  if (dir != nullptr)
-    ++dir->refcount;
-
   ++serial;
 }
 
@@ -61,103 +94,291 @@ TopographyFile::~TopographyFile() noexcept
 void
 TopographyFile::ClearCache() noexcept
 {
-  for (auto &i : shapes)
+  {
+    const std::lock_guard lock{mutex};
+    list.clear();
+    if (label_cache)
+      label_cache->Clear();
+    labels_loaded = false;
+    ++serial;
+  }
+
+  for (auto &i : shapes) {
     i.shape.reset();
+    i.evicted = false;
+  }
+
+  evicted_shapes.clear();
+  memory_usage = evicted_memory = 0;
+}
 
-  list.clear();
+const TCHAR *
+TopographyFile::GetLabel(const_iterator i) const noexcept
+{
+  if (!label_cache)
+    return i->GetLabel();
+
+  const auto *label = label_cache->Get(GetIndex(i));
+  return label != nullptr
+    ? label->c_str()
+    : nullptr;
+}
+
+BasicAllocatedString<TCHAR>
+TopographyFile::ReadLabel(std::size_t i, Mutex *io_mutex) noexcept
+{
+  if (label_field < 0)
+    return nullptr;
+
+  std::unique_lock<Mutex> lock;
+  if (io_mutex != nullptr)
+    lock = std::unique_lock{*io_mutex};
+
+  /* the DBF returns a pointer to its own buffer; convert it before
+     the next read */
+  return XShape::ImportLabel(file->ReadLabel(i, label_field));
+}
+
+bool
+TopographyFile::LoadLabels(Mutex *io_mutex)
+{
+  assert(label_cache);
+
+  /* the shapes are only modified by this thread, but the cache is
+     used by the renderers, too */
+  std::vector<std::size_t> missing;
+  {
+    const std::lock_guard lock{mutex};
+    for (const auto &i : list) {
+      const std::size_t index = std::size_t(&i - shapes.data());
+      /* Get() also marks the loaded labels as recently used */
+      if (label_cache->Get(index) == nullptr)
+        missing.push_back(index);
+    }
+  }
+
+  if (missing.empty())
+    return false;
+
+  std::vector<BasicAllocatedString<TCHAR>> labels;
+  labels.reserve(missing.size());
+  for (const std::size_t index : missing)
+    labels.emplace_back(ReadLabel(index, io_mutex));
+
+  const std::lock_guard lock{mutex};
+  for (std::size_t j = 0; j < missing.size(); ++j)
+    label_cache->Put(missing[j], std::move(labels[j]));
+
+  /* evicted labels may still be referenced by a renderer */
+  ++serial;
+  return true;
 }
 
 static std::unique_ptr<XShape>
-LoadShape(ShapeFile &file, GeoPoint &center, std::size_t i, int label_field)
+LoadShape(ShapeFile &file, GeoPoint &center, std::size_t i, Mutex *io_mutex)
 {
   shapeObj shape;
   msInitShape(&shape);
   AtScopeExit(&shape) { msFreeShape(&shape); };
-  file.ReadShape(shape, i);
 
-  const char *label = label_field >= 0
-    ? file.ReadLabel(i, label_field)
-    : nullptr;
+  {
+    std::unique_lock<Mutex> lock;
+    if (io_mutex != nullptr)
+      lock = std::unique_lock{*io_mutex};
+
+    file.ReadShape(shape, i);
+  }
+
+  return std::make_unique<XShape>(shape, center);
+}
+
+std::unique_ptr<XShape>
+TopographyFile::LoadShape(std::size_t i, Mutex *io_mutex)
+{
+  if (package_layer == nullptr)
+    return ::LoadShape(*file, center, i, io_mutex);
+
+  /* use the precomputed index lists only if they were built for the
+     thresholds of this layer */
+  unsigned index_levels = 0;
+#ifdef ENABLE_OPENGL
+  for (unsigned level = 0; level < TopographyPackage::MAX_LEVELS; ++level)
+    if (package_layer->GetMinimumPointDistance(level) ==
+        GetMinimumPointDistance(level))
+      index_levels |= 1u << level;
+#endif
 
-  return std::make_unique<XShape>(shape, center, label);
+  return std::make_unique<XShape>(package_layer->GetShape(i), center,
+                                  index_levels);
+}
+
+/**
+ * Collect the numbers of the shapes which have their bit set.
+ */
+static void
+CollectBits(std::span<const uint32_t> status, std::size_t n,
+            std::vector<uint32_t> &result) noexcept
+{
+  result.clear();
+
+  for (std::size_t w = 0; w < status.size(); ++w) {
+    for (uint32_t bits = status[w]; bits != 0; bits &= bits - 1) {
+      const std::size_t i = w * 32 + std::countr_zero(bits);
+      if (i < n)
+        result.push_back(i);
+    }
+  }
+}
+
+[[gnu::const]]
+static ShapeIndex::Rect
+ToIndexRect(const rectObj &r) noexcept
+{
+  return ShapeIndex::Rect::Outward(r.minx, r.miny, r.maxx, r.maxy);
+}
+
+void
+TopographyFile::BuildShapeIndex(Mutex *io_mutex) noexcept
+{
+  assert(file);
+
+  std::vector<ShapeIndex::Rect> rects;
+  rects.reserve(shapes.size());
+
+  for (std::size_t i = 0; i < shapes.size(); ++i) {
+    std::unique_lock<Mutex> lock;
+    if (io_mutex != nullptr)
+      lock = std::unique_lock{*io_mutex};
+
+    rectObj bounds;
+    rects.push_back(file->ReadBounds(i, bounds)
+                    ? ToIndexRect(bounds)
+                    : ShapeIndex::Rect::Empty());
+  }
+
+  shape_index.emplace(std::move(rects));
 }
 
 bool
-TopographyFile::Update(const WindowProjection &map_projection)
+TopographyFile::Update(const WindowProjection &map_projection,
+                       Mutex *io_mutex)
 {
-  if (map_projection.GetMapScale() > scale_threshold)
+  const double map_scale = map_projection.GetMapScale();
+  if (map_scale > scale_threshold)
     /* not visible, don't update cache now */
     return false;
 
+  /* labels are read only when they are going to be drawn */
+  const bool want_labels = label_cache && IsLabelVisible(map_scale);
+
   const GeoBounds screenRect =
     map_projection.GetScreenBounds();
-  if (cache_bounds.IsValid() && cache_bounds.IsInside(screenRect))
+  if (cache_bounds.IsValid() && cache_bounds.IsInside(screenRect)) {
     /* the cache is still fresh */
-    return false;
+    if (!want_labels || labels_loaded)
+      return false;
 
-  cache_bounds = screenRect.Scale(2);
-
-  // Test which shapes are inside the given bounds and save the
-  // status to file.status
-  switch (file.WhichShapes(dir, ConvertRect(cache_bounds))) {
-  case MS_FAILURE:
-    ClearCache();
-    throw std::runtime_error{"Failed to update shapefile"};
+    /* ... but the labels have just become visible */
+    labels_loaded = true;
+    return LoadLabels(io_mutex);
+  }
 
-  case MS_DONE:
-    /* screen is outside of map bounds */
-    return false;
+  cache_bounds = screenRect.Scale(2);
 
-  case MS_SUCCESS:
-    break;
+  /* the shapes within the new cache bounds, in ascending order */
+  std::vector<uint32_t> visible;
+  if (package_layer != nullptr) {
+    if (!package_layer->GetBounds().Overlaps(cache_bounds))
+      /* screen is outside of map bounds */
+      return false;
+
+    package_layer->WhichShapes(cache_bounds, package_status);
+    CollectBits(package_status, shapes.size(), visible);
+  } else {
+    const rectObj rect = ConvertRect(cache_bounds);
+    if (msRectOverlap(&file->GetBounds(), &rect) != MS_TRUE)
+      /* screen is outside of map bounds */
+      return false;
+
+    if (!shape_index)
+      BuildShapeIndex(io_mutex);
+
+    shape_index->Query(ToIndexRect(rect), visible);
   }
 
-  const auto status = file.GetStatus();
-  assert(status != nullptr);
-
-  // Iterate through the shapefile entries
-  auto prev = list.before_begin();
-  auto it = shapes.begin();
-  for (std::size_t i = 0; i < file.size(); ++i, ++it) {
-    if (!msGetBit(status, i)) {
-      // If the shape is outside the bounds
-      // delete the shape from the cache
-      if (it->shape != nullptr) {
-        assert(&*std::next(prev) == &*it);
-
-        /* remove from linked list (protected) */
-        {
-          const std::lock_guard lock{mutex};
-          list.erase_after(prev);
-          ++serial;
-        }
-
-        /* now it's unreachable, and we can delete the XShape without
-           holding a lock */
-        it->shape.reset();
-      }
-    } else {
-      // is inside the bounds
-      if (it->shape == nullptr) {
-        assert(&*std::next(prev) != &*it);
-
-        // shape isn't cached yet -> cache the shape
-        it->shape = LoadShape(file, center, i, label_field);
-
-        /* insert into linked list (protected) */
-        {
-          const std::lock_guard lock{mutex};
-          prev = list.insert_after(prev, *it);
-          ++serial;
-        }
-      } else {
+  /* evicted shapes which have left the cache bounds may be loaded
+     again when they come back */
+  std::erase_if(evicted_shapes, [&](uint32_t i){
+    if (std::binary_search(visible.begin(), visible.end(), i))
+      return false;
+
+    shapes[i].evicted = false;
+    evicted_memory -= shapes[i].memory_usage;
+    return true;
+  });
+
+  /* load the shapes which have become visible; they are not yet
+     reachable from the list, so this needs no lock */
+  std::vector<std::unique_ptr<const XShape>> loaded;
+  for (const uint32_t i : visible)
+    if (shapes[i].shape == nullptr && !shapes[i].evicted)
+      loaded.emplace_back(LoadShape(i, io_mutex));
+
+  /* publish all changes to this file at once; the list and #visible
+     are both sorted by shape number, so merging them touches only
+     the shapes which were or are visible */
+  std::vector<std::unique_ptr<const XShape>> discarded;
+  {
+    const std::lock_guard lock{mutex};
+
+    auto next_loaded = loaded.begin();
+    auto prev = list.before_begin();
+
+    /* delete the shape after #prev from the cache; it's unreachable
+       then, and the XShape is deleted after the lock has been
+       released */
+    const auto discard_next = [&]{
+      ShapeEnvelope &e = *std::next(prev);
+      list.erase_after(prev);
+      memory_usage -= e.memory_usage;
+      discarded.emplace_back(std::move(e.shape));
+    };
+
+    for (const uint32_t i : visible) {
+      ShapeEnvelope &e = shapes[i];
+
+      while (std::next(prev) != list.end() && &*std::next(prev) < &e)
+        /* outside of the bounds */
+        discard_next();
+
+      if (std::next(prev) != list.end() && &*std::next(prev) == &e) {
+        /* still visible */
         ++prev;
-        assert(&*prev == &*it);
+      } else if (e.evicted) {
+        /* dropped by Evict(), wait for Restore() */
+        assert(e.shape == nullptr);
+      } else {
+        assert(e.shape == nullptr);
+        assert(next_loaded != loaded.end());
+        e.shape = std::move(*next_loaded++);
+        e.memory_usage = e.shape->GetMemoryUsage();
+        memory_usage += e.memory_usage;
+        prev = list.insert_after(prev, e);
       }
     }
+
+    while (std::next(prev) != list.end())
+      discard_next();
+
+    assert(next_loaded == loaded.end());
+
+    if (!loaded.empty() || !discarded.empty())
+      ++serial;
   }
 
-  assert(std::next(prev) == list.end());
+  labels_loaded = want_labels;
+  if (want_labels)
+    LoadLabels(io_mutex);
 
   return true;
 }
@@ -165,14 +386,18 @@ TopographyFile::Update(const WindowProjection &map_projection)
 void
 TopographyFile::LoadAll()
 {
+  Restore();
+
   // Iterate through the shapefile entries
   auto prev = list.before_begin();
   auto it = shapes.begin();
-  for (std::size_t i = 0; i < file.size(); ++i, ++it) {
+  for (std::size_t i = 0; i < shapes.size(); ++i, ++it) {
     if (it->shape == nullptr) {
       assert(&*std::next(prev) != &*it);
       // shape isn't cached yet -> cache the shape
-      it->shape = LoadShape(file, center, i, label_field);
+      it->shape = LoadShape(i);
+      it->memory_usage = it->shape->GetMemoryUsage();
+      memory_usage += it->memory_usage;
       // update list pointer
       prev = list.insert_after(prev, *it);
     } else {
@@ -186,6 +411,75 @@ TopographyFile::LoadAll()
   ++serial;
 }
 
+void
+TopographyFile::UnlinkEvicted(std::vector<std::unique_ptr<const XShape>> &discarded) noexcept
+{
+  for (auto prev = list.before_begin(); std::next(prev) != list.end();) {
+    ShapeEnvelope &i = *std::next(prev);
+    if (i.evicted) {
+      list.erase_after(prev);
+      discarded.emplace_back(std::move(i.shape));
+    } else
+      ++prev;
+  }
+}
+
+std::size_t
+TopographyFile::Evict(std::size_t goal, GeoPoint location) noexcept
+{
+  std::vector<std::pair<double, ShapeEnvelope *>> candidates;
+  for (auto &i : list)
+    candidates.emplace_back(location.DistanceS(i.shape->get_bounds().GetCenter()),
+                            &i);
+
+  if (candidates.empty())
+    return 0;
+
+  /* farthest first */
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto &a, const auto &b){ return a.first > b.first; });
+
+  std::size_t freed = 0;
+  for (const auto &[distance, i] : candidates) {
+    if (freed >= goal)
+      break;
+
+    i->evicted = true;
+    evicted_shapes.push_back(i - shapes.data());
+    freed += i->memory_usage;
+  }
+
+  std::sort(evicted_shapes.begin(), evicted_shapes.end());
+
+  std::vector<std::unique_ptr<const XShape>> discarded;
+  {
+    const std::lock_guard lock{mutex};
+    UnlinkEvicted(discarded);
+    ++serial;
+  }
+
+  memory_usage -= freed;
+  evicted_memory += freed;
+  return freed;
+}
+
+bool
+TopographyFile::Restore() noexcept
+{
+  if (evicted_memory == 0)
+    return false;
+
+  for (const uint32_t i : evicted_shapes)
+    shapes[i].evicted = false;
+
+  evicted_shapes.clear();
+  evicted_memory = 0;
+
+  /* let the next Update() load them */
+  cache_bounds = GeoBounds::Invalid();
+  return true;
+}
+
 unsigned
 TopographyFile::GetSkipSteps(double map_scale) const noexcept
 {
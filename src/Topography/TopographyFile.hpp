@@ -4,20 +4,27 @@
 #pragma once
 
 #include "ShapeFile.hpp"
+#include "ShapeIndex.hpp"
+#include "TopographyPackage.hpp"
 #include "Geo/GeoBounds.hpp"
 #include "util/AllocatedArray.hxx"
+#include "util/AllocatedString.hxx"
+#include "util/StaticCache.hxx"
 #include "util/IntrusiveForwardList.hxx"
 #include "util/Serial.hpp"
 #include "ui/canvas/PortableColor.hpp"
 #include "ResourceId.hpp"
 #include "thread/Mutex.hxx"
 
-#ifdef ENABLE_OPENGL
 #include "XShapePoint.hpp"
-#endif
 
 #include <cassert>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <vector>
+
+#include <tchar.h>
 
 class WindowProjection;
 class XShape;
@@ -26,6 +33,19 @@ struct zzip_dir;
 class TopographyFile {
   struct ShapeEnvelope final : IntrusiveForwardListHook {
     std::unique_ptr<const XShape> shape;
+
+    /**
+     * XShape::GetMemoryUsage() of the shape, measured when it was
+     * loaded.  Kept when it is evicted.
+     */
+    std::size_t memory_usage = 0;
+
+    /**
+     * Was this shape dropped by Evict() while it is visible?  It is
+     * not loaded again until Restore() is called or until it leaves
+     * the cache bounds.
+     */
+    bool evicted = false;
   };
 
   /**
@@ -35,7 +55,28 @@ class TopographyFile {
 
   zzip_dir *const dir;
 
-  ShapeFile file;
+  /**
+   * The shapefile, unless this layer is loaded from a
+   * #TopographyPackage.
+   */
+  std::optional<ShapeFile> file;
+
+  /**
+   * The spatial index of #file, built by the first Update() call.
+   */
+  std::optional<ShapeIndex> shape_index;
+
+  /**
+   * The #TopographyPackage layer, or nullptr if this layer is loaded
+   * from a shapefile.
+   */
+  const TopographyPackage::Layer *const package_layer = nullptr;
+
+  /**
+   * The visibility bits of #package_layer, see
+   * TopographyPackage::Layer::WhichShapes().
+   */
+  AllocatedArray<uint32_t> package_status;
 
   /**
    * The center of shapefileObj::bounds.
@@ -49,6 +90,40 @@ class TopographyFile {
 
   const int label_field;
 
+  /**
+   * The labels of a shapefile layer, keyed by shape number.  They
+   * are read by Update() only while labels are visible, and only the
+   * most recently used ones are kept.  Allocated only if there is a
+   * #label_field.  Protected by #mutex.
+   */
+  using LabelCache = StaticCache<std::size_t, BasicAllocatedString<TCHAR>,
+                                 512, 373>;
+  std::unique_ptr<LabelCache> label_cache;
+
+  /**
+   * Have the labels of all loaded shapes been read into
+   * #label_cache?
+   */
+  bool labels_loaded = false;
+
+  /**
+   * The sum of ShapeEnvelope::memory_usage of all loaded shapes and
+   * of all evicted shapes.  Only accessed by the thread which calls
+   * Update().
+   */
+  std::size_t memory_usage = 0, evicted_memory = 0;
+
+  /**
+   * The shapes which have the "evicted" flag, in ascending order.
+   */
+  std::vector<uint32_t> evicted_shapes;
+
+  /**
+   * A value chosen by the #TopographyStore which tells when this
+   * file was visible last.
+   */
+  unsigned last_visible = 0;
+
   const ResourceId icon, big_icon;
 
   const unsigned pen_width;
@@ -82,7 +157,7 @@ class TopographyFile {
 
 public:
   /**
-   * Protects #serial, #shapes, #first.
+   * Protects #serial, #shapes, #first, #label_cache.
    * The caller is responsible for locking it.
    */
   mutable Mutex mutex;
@@ -143,6 +218,21 @@ public:
                  ResourceId big_icon=ResourceId::Null(),
                  unsigned pen_width=1);
 
+  /**
+   * Load the layer from a #TopographyPackage, which must outlive
+   * this object.  The other parameters are the same as above (the
+   * labels are already contained in the package).
+   *
+   * Throws on error.
+   */
+  TopographyFile(const TopographyPackage::Layer &layer,
+                 double threshold, double label_threshold,
+                 double important_label_threshold,
+                 const BGRA8Color color,
+                 ResourceId icon=ResourceId::Null(),
+                 ResourceId big_icon=ResourceId::Null(),
+                 unsigned pen_width=1);
+
   TopographyFile(const TopographyFile &) = delete;
 
   /**
@@ -158,6 +248,10 @@ public:
     return center;
   }
 
+  double GetScaleThreshold() const noexcept {
+    return scale_threshold;
+  }
+
   bool IsVisible(double map_scale) const noexcept {
     return map_scale <= scale_threshold;
   }
@@ -216,16 +310,57 @@ public:
     return const_iterator{list.end()};
   }
 
+  /**
+   * Returns the shape number of a loaded shape.  It identifies the
+   * shape for its whole lifetime, even if it is discarded and loaded
+   * again.
+   */
+  [[gnu::pure]]
+  std::size_t GetIndex(const_iterator i) const noexcept {
+    return std::size_t(&*i.i - shapes.data());
+  }
+
+  /**
+   * Returns the label of a loaded shape, or nullptr if it has none or
+   * if it has not been read yet (see Update()).  The caller is
+   * responsible for locking #mutex.  The pointer is valid until the
+   * serial changes.
+   */
+  const TCHAR *GetLabel(const_iterator i) const noexcept;
+
+  /**
+   * Read the label of the specified shape, bypassing the cache.  Only
+   * the thread calling Update() may call this.
+   *
+   * @param io_mutex see Update()
+   */
+  BasicAllocatedString<TCHAR> ReadLabel(std::size_t i,
+                                        Mutex *io_mutex=nullptr) noexcept;
+
   [[gnu::pure]]
   unsigned GetSkipSteps(double map_scale) const noexcept;
 
-#ifdef ENABLE_OPENGL
+  std::size_t GetShapeCount() const noexcept {
+    return shapes.size();
+  }
+
+  /**
+   * Returns the specified shape, or nullptr if it is not loaded.
+   * The caller is responsible for locking #mutex (unless it is the
+   * thread calling Update()).
+   */
+  const XShape *GetShape(std::size_t i) const noexcept {
+    return shapes[i].shape.get();
+  }
+
   [[gnu::pure]]
   GeoPoint ToGeoPoint(const ShapePoint &p) const noexcept {
     return GeoPoint(center.longitude + Angle::Native(p.x),
                     center.latitude + Angle::Native(p.y));
   }
 
+#ifdef ENABLE_OPENGL
+
   /**
    * @return thinning level, range: 0 .. XShape::THINNING_LEVELS-1
    */
@@ -240,11 +375,20 @@ public:
 #endif
 
   /**
+   * Load the shapes which are visible in the given projection and
+   * discard the others.  The changes are published to the list with
+   * one #mutex lock.  If the labels are visible at the projection's
+   * scale, the missing ones are read as well.
+   *
    * Throws on error.
    *
+   * @param io_mutex if not nullptr, this mutex is held while reading
+   * from the shapefile; this allows updating several files which
+   * share one ZIP archive in parallel
    * @return true if new data from the topography file has been loaded
    */
-  bool Update(const WindowProjection &map_projection);
+  bool Update(const WindowProjection &map_projection,
+              Mutex *io_mutex=nullptr);
 
   /**
    * Throws on error.
@@ -253,6 +397,77 @@ public:
    */
   void LoadAll();
 
+  /**
+   * The memory occupied by the loaded shapes, see
+   * XShape::GetMemoryUsage().  Only the thread which calls Update()
+   * may call this.
+   */
+  std::size_t GetMemoryUsage() const noexcept {
+    return memory_usage;
+  }
+
+  /**
+   * The memory which the shapes dropped by Evict() would occupy.
+   */
+  std::size_t GetEvictedMemory() const noexcept {
+    return evicted_memory;
+  }
+
+  unsigned GetLastVisible() const noexcept {
+    return last_visible;
+  }
+
+  void SetLastVisible(unsigned value) noexcept {
+    last_visible = value;
+  }
+
+  /**
+   * Drop loaded shapes until at least the specified amount of memory
+   * has been freed (or until none is left), the ones farthest from
+   * the given location first.  The evicted shapes which are still
+   * visible are not loaded again by Update() until Restore() is
+   * called.
+   *
+   * @return the amount of memory which was freed
+   */
+  std::size_t Evict(std::size_t goal, GeoPoint location) noexcept;
+
+  /**
+   * Allow Update() to load the shapes dropped by Evict() again.
+   *
+   * @return true if there were evicted shapes
+   */
+  bool Restore() noexcept;
+
 protected:
   void ClearCache() noexcept;
+
+private:
+  void Init(std::size_t n_shapes, const GeoBounds &bounds);
+
+  /**
+   * Throws on error.
+   */
+  std::unique_ptr<XShape> LoadShape(std::size_t i,
+                                    Mutex *io_mutex=nullptr);
+
+  /**
+   * Read the bounds of all shapes of #file and build #shape_index.
+   */
+  void BuildShapeIndex(Mutex *io_mutex) noexcept;
+
+  /**
+   * Unlink the shapes which have the "evicted" flag from #list.
+   *
+   * Caller must lock #mutex.
+   */
+  void UnlinkEvicted(std::vector<std::unique_ptr<const XShape>> &discarded) noexcept;
+
+  /**
+   * Read the labels of all loaded shapes which are not in
+   * #label_cache.
+   *
+   * @return true if the cache was modified
+   */
+  bool LoadLabels(Mutex *io_mutex);
 };
@@ -12,7 +12,7 @@
 #include "Screen/Layout.hpp"
 #include "shapelib/mapserver.h"
 #include "util/AllocatedArray.hxx"
-#include "util/tstring.hpp"
+#include "util/tstring_view.hxx"
 #include "Geo/GeoClip.hpp"
 #include "Geo/FAISphere.hpp"
 
@@ -29,6 +29,7 @@
 #endif
 
 #include <algorithm>
+#include <climits>
 #include <numeric>
 #include <set>
 
@@ -58,11 +59,13 @@ TopographyFileRenderer::UpdateVisibleShapes(const WindowProjection &projection)
 
   visible_serial = file.GetSerial();
   visible_bounds = projection.GetScreenBounds().Scale(1.2);
+  ++visible_generation;
   visible_shapes.clear();
   visible_points.clear();
   visible_labels.clear();
 
-  for (const XShape &shape : file) {
+  for (auto i = file.begin(), end = file.end(); i != end; ++i) {
+    const XShape &shape = *i;
     if (!visible_bounds.Overlaps(shape.get_bounds()))
       continue;
 
@@ -72,58 +75,113 @@ TopographyFileRenderer::UpdateVisibleShapes(const WindowProjection &projection)
           const auto *points = shape.GetPoints();
           for (const unsigned line_size : shape.GetLines()) {
             const auto *end = points + line_size;
-            for (; points < end; ++points) {
-#ifdef ENABLE_OPENGL
+            for (; points < end; ++points)
               visible_points.push_back(file.ToGeoPoint(*points));
-#else
-              visible_points.push_back(*points);
-#endif
-            }
           }
         }
       } else
-        visible_shapes.push_back(&shape);
+        visible_shapes.push_back({&shape, file.GetIndex(i)});
     }
 
-    if (shape.GetLabel() != nullptr)
-      visible_labels.push_back(&shape);
+    if (const TCHAR *label = file.GetLabel(i); label != nullptr)
+      visible_labels.push_back({&shape, label});
   }
 }
 
 #ifdef ENABLE_OPENGL
 
+[[gnu::pure]]
+static unsigned
+GetPointCount(const XShape &shape) noexcept
+{
+  const auto lines = shape.GetLines();
+  return std::accumulate(lines.begin(), lines.end(), 0u);
+}
+
+void
+TopographyFileRenderer::RebuildArrayBuffer() noexcept
+{
+  unsigned n = 0;
+  for (const auto &shape : file)
+    n += GetPointCount(shape);
+
+  /* leave room for the shapes which will be loaded next */
+  const unsigned capacity =
+    std::max({n + n / 2, 2 * buffer_allocator.GetCapacity(), 4096u});
+  buffer_allocator.Reset(capacity);
+
+  for (auto &slot : buffer_slots)
+    slot = {};
+
+  ShapePoint *const p = (ShapePoint *)
+    array_buffer->BeginWrite(capacity * sizeof(*p));
+  assert(p != nullptr);
+
+  for (auto i = file.begin(), end = file.end(); i != end; ++i) {
+    auto &slot = buffer_slots[file.GetIndex(i)];
+    slot.size = GetPointCount(*i);
+    slot.offset = slot.size > 0 ? buffer_allocator.Allocate(slot.size) : 0;
+    assert(slot.offset != ShapeBufferAllocator::NONE);
+
+    std::copy_n(i->GetPoints(), slot.size, p + slot.offset);
+  }
+
+  array_buffer->CommitWrite(capacity * sizeof(*p), p);
+}
+
 inline void
 TopographyFileRenderer::UpdateArrayBuffer() noexcept
 {
-  if (array_buffer == nullptr)
-    array_buffer = std::make_unique<GLArrayBuffer>();
-  else if (file.GetSerial() == array_buffer_serial)
+  if (array_buffer == nullptr) {
+    array_buffer = std::make_unique<GLDynamicArrayBuffer>();
+    buffer_slots.resize(file.GetShapeCount());
+  } else if (file.GetSerial() == array_buffer_serial)
     return;
 
   array_buffer_serial = file.GetSerial();
 
-  unsigned n = 0;
-  for (auto &shape : file) {
-    shape.SetOffset(n);
-
-    const auto lines = shape.GetLines();
-    n = std::accumulate(lines.begin(), lines.end(), n);
+  /* release the space of the shapes which were discarded */
+  std::vector<bool> loaded(buffer_slots.size());
+  for (auto i = file.begin(), end = file.end(); i != end; ++i)
+    loaded[file.GetIndex(i)] = true;
+
+  for (std::size_t i = 0; i < buffer_slots.size(); ++i) {
+    auto &slot = buffer_slots[i];
+    if (slot.offset != ShapeBufferAllocator::NONE && !loaded[i]) {
+      if (slot.size > 0)
+        buffer_allocator.Free(slot.offset, slot.size);
+      slot = {};
+    }
   }
 
-  ShapePoint *p = (ShapePoint *)
-    array_buffer->BeginWrite(n * sizeof(*p));
-  assert (p != nullptr);
+  /* upload only the shapes which were loaded */
+  array_buffer->Bind();
 
-  for (const auto &shape : file) {
-    const auto lines = shape.GetLines();
-    const ShapePoint *src = shape.GetPoints();
-    for (const auto n_points : lines) {
-      p = std::copy_n(src, n_points, p);
-      src += n_points;
+  for (auto i = file.begin(), end = file.end(); i != end; ++i) {
+    auto &slot = buffer_slots[file.GetIndex(i)];
+    if (slot.offset != ShapeBufferAllocator::NONE)
+      continue;
+
+    slot.size = GetPointCount(*i);
+    if (slot.size == 0) {
+      slot.offset = 0;
+      continue;
     }
+
+    slot.offset = buffer_allocator.Allocate(slot.size);
+    if (slot.offset == ShapeBufferAllocator::NONE) {
+      /* no room left: start over with a larger buffer */
+      GLDynamicArrayBuffer::Unbind();
+      RebuildArrayBuffer();
+      return;
+    }
+
+    GLDynamicArrayBuffer::SubData(slot.offset * sizeof(ShapePoint),
+                                  slot.size * sizeof(ShapePoint),
+                                  i->GetPoints());
   }
 
-  array_buffer->CommitWrite(n * sizeof(*p), p - n);
+  GLDynamicArrayBuffer::Unbind();
 }
 
 #endif
@@ -140,11 +198,11 @@ TopographyFileRenderer::PaintPoints(Canvas &canvas,
 
 void
 TopographyFileRenderer::Paint(Canvas &canvas,
-                              const WindowProjection &projection) noexcept
+                              const WindowProjection &projection,
+                              double map_scale) noexcept
 {
   const std::lock_guard lock{file.mutex};
 
-  const auto map_scale = projection.GetMapScale();
   if (!file.IsVisible(map_scale))
     return;
 
@@ -183,6 +241,7 @@ TopographyFileRenderer::Paint(Canvas &canvas,
                      glm::value_ptr(ToGLM(projection, file.GetCenter())));
 #else // !ENABLE_OPENGL
   const GeoClip clip(projection.GetScreenBounds().Scale(1.1));
+  const auto geo_to_screen = projection.GetFastGeoToScreen();
   AllocatedArray<GeoPoint> geo_points;
 
   const unsigned iskip = file.GetSkipSteps(map_scale);
@@ -197,14 +256,15 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 #endif
 #endif
 
-  for (const XShape *shape_p : visible_shapes) {
-    const XShape &shape = *shape_p;
+  for (const auto &visible : visible_shapes) {
+    const XShape &shape = *visible.shape;
 
     const auto lines = shape.GetLines();
 #ifdef ENABLE_OPENGL
-    const ShapePoint *points = buffer + shape.GetOffset();
+    const unsigned offset = buffer_slots[visible.index].offset;
+    const ShapePoint *points = buffer + offset;
 #else // !ENABLE_OPENGL
-    const GeoPoint *points = shape.GetPoints();
+    const ShapePoint *points = shape.GetPoints();
 #endif
 
     switch (shape.get_type()) {
@@ -236,12 +296,12 @@ TopographyFileRenderer::Paint(Canvas &canvas,
         for (unsigned msize : lines) {
         shape_renderer.Begin(msize);
 
-        const GeoPoint *end = points + msize - 1;
+        const ShapePoint *end = points + msize - 1;
         for (; points < end; ++points)
-          shape_renderer.AddPointIfDistant(projection.GeoToScreen(*points));
+          shape_renderer.AddPointIfDistant(geo_to_screen(file.ToGeoPoint(*points)));
 
         // make sure we always draw the last point
-        shape_renderer.AddPoint(projection.GeoToScreen(*points));
+        shape_renderer.AddPoint(geo_to_screen(file.ToGeoPoint(*points)));
 
         shape_renderer.FinishPolyline(canvas);
       }
@@ -256,7 +316,6 @@ TopographyFileRenderer::Paint(Canvas &canvas,
         const unsigned n = *triangles.count;
 
 #ifdef GL_EXT_multi_draw_arrays
-        const unsigned offset = shape.GetOffset();
         if (GLExt::HaveMultiDrawElements() && offset + n < 0x10000) {
           /* postpone, draw many polygons with a single
              glMultiDrawElements() call */
@@ -275,7 +334,7 @@ TopographyFileRenderer::Paint(Canvas &canvas,
       }
 #else // !ENABLE_OPENGL
       {
-        const GeoPoint *src = &points[0];
+        const ShapePoint *src = &points[0];
         for (const unsigned n : lines) {
           unsigned msize = n / iskip;
 
@@ -285,7 +344,7 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 
           geo_points.GrowDiscard(msize * 3);
           for (unsigned i = 0; i < msize; ++i)
-            geo_points[i] = src[i * iskip];
+            geo_points[i] = file.ToGeoPoint(src[i * iskip]);
 
           msize = clip.ClipPolygon(geo_points.data(),
                                    geo_points.data(), msize);
@@ -296,7 +355,7 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 
           for (unsigned i = 0; i < msize; ++i) {
             GeoPoint g = geo_points[i];
-            shape_renderer.AddPointIfDistant(projection.GeoToScreen(g));
+            shape_renderer.AddPointIfDistant(geo_to_screen(g));
           }
 
           shape_renderer.FinishPolygon(canvas);
@@ -368,58 +427,90 @@ TopographyFileRenderer::PaintLabels(Canvas &canvas,
 
   // get drawing info
 
-  int iskip = file.GetSkipSteps(map_scale);
+  const unsigned iskip = file.GetSkipSteps(map_scale);
+  UpdateLabelPlacements(canvas, projection, iskip);
+
+  const PixelPoint offset =
+    projection.GeoToScreen(label_origin) - label_origin_position;
+  const int width = canvas.GetWidth(), height = canvas.GetHeight();
+
+  std::set<tstring_view> drawn_labels;
+
+  for (const auto &placement : label_placements) {
+    /* labels of lines entirely right of the screen are moved to the
+       bottom right corner */
+    PixelPoint p{width, height};
+    if (placement.position.x != INT_MAX &&
+        placement.position.x + offset.x <= width)
+      p = placement.position + offset;
+
+    p.x += 2;
+    p.y += 2;
+
+    PixelRect brect;
+    brect.left = p.x;
+    brect.right = brect.left + placement.size.width;
+    brect.top = p.y;
+    brect.bottom = brect.top + placement.size.height;
+
+    if (!label_block.check(brect))
+      continue;
+
+    if (!drawn_labels.insert(placement.text).second)
+      continue;
+
+    canvas.DrawText(p, placement.text);
+  }
+}
+
+void
+TopographyFileRenderer::UpdateLabelPlacements(const Canvas &canvas,
+                                              const WindowProjection &projection,
+                                              unsigned iskip) noexcept
+{
+  const auto map_scale = projection.GetMapScale();
+  if (label_generation == visible_generation &&
+      label_map_scale == map_scale &&
+      label_angle == projection.GetScreenAngle() &&
+      label_origin.IsValid())
+    /* only translated (or not changed at all) */
+    return;
 
-  std::set<tstring> drawn_labels;
+  label_generation = visible_generation;
+  label_map_scale = map_scale;
+  label_angle = projection.GetScreenAngle();
+  label_origin = projection.GetGeoLocation();
+  label_origin_position = projection.GeoToScreen(label_origin);
 
-  // Iterate over all shapes in the file
-  for (const XShape *shape_p : visible_labels) {
-    const XShape &shape = *shape_p;
+  label_placements.clear();
 
-    // Skip shapes without a label
-    const TCHAR *label = shape.GetLabel();
+  const auto geo_to_screen = projection.GetFastGeoToScreen();
+
+  for (const auto &visible : visible_labels) {
+    const XShape &shape = *visible.shape;
+
+    const TCHAR *label = visible.text;
     assert(label != nullptr);
 
+    const PixelSize size = canvas.CalcTextSize(label);
+
     const auto lines = shape.GetLines();
     const auto *points = shape.GetPoints();
 
     for (const unsigned n : lines) {
-      int minx = canvas.GetWidth();
-      int miny = canvas.GetHeight();
+      PixelPoint leftmost{INT_MAX, INT_MAX};
 
       const auto *end = points + n;
       for (; points < end; points += iskip) {
-#ifdef ENABLE_OPENGL
-        auto pt = projection.GeoToScreen(file.ToGeoPoint(*points));
-#else
-        auto pt = projection.GeoToScreen(*points);
-#endif
+        auto pt = geo_to_screen(file.ToGeoPoint(*points));
 
-        if (pt.x <= minx) {
-          minx = pt.x;
-          miny = pt.y;
-        }
+        if (pt.x <= leftmost.x)
+          leftmost = pt;
       }
 
       points = end;
 
-      minx += 2;
-      miny += 2;
-
-      PixelSize tsize = canvas.CalcTextSize(label);
-      PixelRect brect;
-      brect.left = minx;
-      brect.right = brect.left + tsize.width;
-      brect.top = miny;
-      brect.bottom = brect.top + tsize.height;
-
-      if (!label_block.check(brect))
-        continue;
-
-      if (!drawn_labels.insert(label).second)
-        continue;
-
-      canvas.DrawText({minx, miny}, label);
+      label_placements.push_back({label, leftmost, size});
     }
   }
 }
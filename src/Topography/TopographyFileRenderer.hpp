@@ -7,8 +7,14 @@
 #include "ui/canvas/Icon.hpp"
 #include "util/Serial.hpp"
 #include "Geo/GeoBounds.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "ui/dim/Point.hpp"
+#include "ui/dim/Size.hpp"
+
+#include <tchar.h>
 
 #ifdef ENABLE_OPENGL
+#include "Topography/ShapeBufferAllocator.hpp"
 #else
 #include "ui/canvas/Brush.hpp"
 #include "Topography/ShapeRenderer.hpp"
@@ -19,7 +25,7 @@
 
 class TopographyFile;
 class Canvas;
-class GLArrayBuffer;
+class GLDynamicArrayBuffer;
 class WindowProjection;
 class LabelBlock;
 class XShape;
@@ -50,13 +56,87 @@ class TopographyFileRenderer final
   Serial visible_serial;
   GeoBounds visible_bounds;
 
-  std::vector<const XShape *> visible_shapes, visible_labels;
+  struct VisibleShape {
+    const XShape *shape;
+
+    /**
+     * The shape number, see TopographyFile::GetIndex().
+     */
+    std::size_t index;
+  };
+
+  std::vector<VisibleShape> visible_shapes;
+
+  struct VisibleLabel {
+    const XShape *shape;
+
+    /**
+     * See TopographyFile::GetLabel().
+     */
+    const TCHAR *text;
+  };
+
+  std::vector<VisibleLabel> visible_labels;
 
   std::vector<GeoPoint> visible_points;
 
+  /**
+   * Incremented each time UpdateVisibleShapes() rebuilds the lists
+   * above.
+   */
+  unsigned visible_generation = 0;
+
+  struct LabelPlacement {
+    const TCHAR *text;
+
+    /**
+     * The leftmost point of the line in the screen coordinates of
+     * the projection the placement was calculated for, or INT_MAX
+     * if the line is empty.
+     */
+    PixelPoint position;
+
+    PixelSize size;
+  };
+
+  /**
+   * One placement per labelled line of #visible_labels.  While the
+   * projection is only translated, they are reused by adding the
+   * screen offset of #label_origin.
+   */
+  std::vector<LabelPlacement> label_placements;
+
+  /**
+   * The state #label_placements was calculated for.
+   */
+  unsigned label_generation = 0;
+  double label_map_scale = -1;
+  Angle label_angle = Angle::Zero();
+  GeoPoint label_origin = GeoPoint::Invalid();
+  PixelPoint label_origin_position;
+
 #ifdef ENABLE_OPENGL
-  std::unique_ptr<GLArrayBuffer> array_buffer;
+  /**
+   * The points of all loaded shapes.  Each shape is uploaded once
+   * when it is loaded, and its space is reused when it is discarded.
+   */
+  std::unique_ptr<GLDynamicArrayBuffer> array_buffer;
   Serial array_buffer_serial;
+
+  /**
+   * Manages the space in #array_buffer (in #ShapePoint units).
+   */
+  ShapeBufferAllocator buffer_allocator;
+
+  struct BufferSlot {
+    unsigned offset = ShapeBufferAllocator::NONE, size = 0;
+  };
+
+  /**
+   * The location of each shape in #array_buffer, indexed by shape
+   * number; #ShapeBufferAllocator::NONE if it is not uploaded.
+   */
+  std::vector<BufferSlot> buffer_slots;
 #endif
 
 public:
@@ -72,8 +152,12 @@ public:
    * @param canvas The canvas to paint on
    * @param bitmap_canvas Temporary canvas for the icon
    * @param projection
+   * @param map_scale the map scale which selects the visible files
+   * and the level of detail; usually WindowProjection::GetMapScale(),
+   * but a tile of a larger screen passes the scale of that screen
    */
-  void Paint(Canvas &canvas, const WindowProjection &projection) noexcept;
+  void Paint(Canvas &canvas, const WindowProjection &projection,
+             double map_scale) noexcept;
 
   /**
    * Paints a topography label if the space is available in the LabelBlock
@@ -90,7 +174,22 @@ private:
 
 #ifdef ENABLE_OPENGL
   void UpdateArrayBuffer() noexcept;
+
+  /**
+   * Reallocate #array_buffer with enough space for all loaded shapes
+   * and upload them again.
+   */
+  void RebuildArrayBuffer() noexcept;
 #endif
 
   void PaintPoints(Canvas &canvas, const WindowProjection &projection) noexcept;
+
+  /**
+   * Recalculate #label_placements unless only the screen position
+   * of the projection has changed.  The label font must be selected
+   * already.
+   */
+  void UpdateLabelPlacements(const Canvas &canvas,
+                             const WindowProjection &projection,
+                             unsigned iskip) noexcept;
 };
@@ -3,6 +3,7 @@
 
 #include "Topography/TopographyGlue.hpp"
 #include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyPackage.hpp"
 #include "Language/Language.hpp"
 #include "Profile/Profile.hpp"
 #include "LogFile.hpp"
@@ -11,6 +12,28 @@
 #include "io/ZipArchive.hpp"
 #include "io/ZipLineReader.hpp"
 #include "system/Path.hpp"
+#include "system/FileUtil.hpp"
+
+/**
+ * Open the optional pre-converted topography (a "*.topo" file next
+ * to the map file).
+ */
+static std::unique_ptr<TopographyPackage>
+OpenTopographyPackage() noexcept
+try {
+  const auto map_path = Profile::GetPath(ProfileKeys::MapFile);
+  if (map_path == nullptr)
+    return nullptr;
+
+  const auto path = map_path.WithSuffix(_T(".topo"));
+  if (!File::Exists(path))
+    return nullptr;
+
+  return std::make_unique<TopographyPackage>(path);
+} catch (...) {
+  LogError(std::current_exception(), "Failed to open topography package");
+  return nullptr;
+}
 
 /**
  * Load topography from the map file (ZIP), load the other files from
@@ -25,7 +48,8 @@ try {
     return false;
 
   ZipLineReaderA reader(archive->get(), "topology.tpl");
-  store.Load(operation, reader, nullptr, archive->get());
+  store.Load(operation, reader, nullptr, archive->get(),
+             OpenTopographyPackage());
   return true;
 } catch (...) {
   LogError(std::current_exception(), "No topography in map file");
@@ -0,0 +1,411 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TopographyPackage.hpp"
+#include "io/FileMapping.hpp"
+#include "io/BufferedOutputStream.hxx"
+#include "system/Path.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <string.h>
+
+/**
+ * The maximum number of grid columns and rows of a layer.
+ */
+static constexpr unsigned MAX_GRID = 64;
+
+/**
+ * Map a coordinate to a grid column or row.
+ */
+[[gnu::const]]
+static unsigned
+ToCell(double value, double min, double max, unsigned n) noexcept
+{
+  if (!(max > min))
+    return 0;
+
+  const double f = (value - min) / (max - min) * n;
+  if (!(f > 0))
+    return 0;
+
+  return std::min(unsigned(f), n - 1);
+}
+
+[[gnu::pure]]
+static constexpr bool
+Overlaps(const TopographyPackage::ShapeRecord &r,
+         double west, double south, double east, double north) noexcept
+{
+  return r.west <= east && r.east >= west &&
+    r.south <= north && r.north >= south;
+}
+
+TopographyPackage::Layer::Layer(std::string_view _name,
+                                std::span<const std::byte> _data)
+  :name(_name), data(_data)
+{
+  if (data.size() < sizeof(header))
+    throw std::runtime_error("Truncated topography layer");
+
+  memcpy(&header, data.data(), sizeof(header));
+
+  if (header.columns < 1 || header.columns > MAX_GRID ||
+      header.rows < 1 || header.rows > MAX_GRID)
+    throw std::runtime_error("Malformed topography layer header");
+
+  records = GetArray<ShapeRecord>(sizeof(header), header.n_shapes);
+
+  const std::size_t n_cells = header.columns * header.rows;
+  grid = GetArray<uint32_t>(header.grid_offset, n_cells + 1);
+
+  if (!std::is_sorted(grid.begin(), grid.end()) || grid.front() != 0)
+    throw std::runtime_error("Malformed topography layer index");
+
+  cell_shapes = GetArray<uint32_t>(header.grid_offset +
+                                   grid.size_bytes(),
+                                   grid.back());
+
+  for (const uint32_t i : cell_shapes)
+    if (i >= records.size())
+      throw std::runtime_error("Malformed topography layer index");
+}
+
+template<typename T>
+std::span<const T>
+TopographyPackage::Layer::GetArray(uint32_t offset, std::size_t n) const
+{
+  if (n == 0)
+    return {};
+
+  if (offset % alignof(T) != 0 || offset > data.size() ||
+      (data.size() - offset) / sizeof(T) < n)
+    throw std::runtime_error("Malformed topography layer");
+
+  return {reinterpret_cast<const T *>(data.data() + offset), n};
+}
+
+TopographyPackage::Shape
+TopographyPackage::Layer::GetShape(std::size_t i) const
+{
+  const auto &r = records[i];
+
+  Shape shape;
+  shape.bounds = GeoBounds{
+    {Angle::Radians(r.west), Angle::Radians(r.north)},
+    {Angle::Radians(r.east), Angle::Radians(r.south)},
+  };
+  if (!shape.bounds.Check())
+    throw std::runtime_error("Malformed shape bounds");
+
+  shape.type = r.type;
+  shape.lines = GetArray<uint16_t>(r.lines_offset, r.n_lines);
+  shape.points = GetArray<ShapePoint>(r.points_offset, r.n_points);
+
+  std::size_t n_points = 0;
+  for (const auto l : shape.lines)
+    n_points += l;
+
+  if (n_points != shape.points.size())
+    throw std::runtime_error("Malformed shape");
+
+  shape.label = nullptr;
+  if (r.label_offset != 0) {
+    if (r.label_offset >= data.size() ||
+        memchr(data.data() + r.label_offset, 0,
+               data.size() - r.label_offset) == nullptr)
+      throw std::runtime_error("Malformed shape label");
+
+    shape.label = reinterpret_cast<const char *>(data.data() + r.label_offset);
+  }
+
+  for (unsigned level = 0; level < MAX_LEVELS; ++level)
+    shape.indices[level] = GetArray<uint16_t>(r.indices_offset[level],
+                                              r.indices_size[level]);
+
+  return shape;
+}
+
+std::size_t
+TopographyPackage::Layer::WhichShapes(const GeoBounds &bounds,
+                                      std::span<uint32_t> status) const noexcept
+{
+  std::fill(status.begin(), status.end(), 0);
+
+  const double west = bounds.GetWest().Radians();
+  const double east = bounds.GetEast().Radians();
+  const double south = bounds.GetSouth().Radians();
+  const double north = bounds.GetNorth().Radians();
+
+  if (west > header.east || east < header.west ||
+      south > header.north || north < header.south)
+    return 0;
+
+  const unsigned x0 = ToCell(west, header.west, header.east, header.columns);
+  const unsigned x1 = ToCell(east, header.west, header.east, header.columns);
+  const unsigned y0 = ToCell(south, header.south, header.north, header.rows);
+  const unsigned y1 = ToCell(north, header.south, header.north, header.rows);
+
+  std::size_t n = 0;
+  for (unsigned y = y0; y <= y1; ++y) {
+    for (unsigned x = x0; x <= x1; ++x) {
+      const unsigned cell = y * header.columns + x;
+      for (unsigned j = grid[cell]; j < grid[cell + 1]; ++j) {
+        const uint32_t i = cell_shapes[j];
+        uint32_t &word = status[i / 32];
+        const uint32_t bit = uint32_t(1) << (i % 32);
+        if ((word & bit) == 0 && Overlaps(records[i], west, south, east, north)) {
+          word |= bit;
+          ++n;
+        }
+      }
+    }
+  }
+
+  return n;
+}
+
+TopographyPackage::TopographyPackage(std::span<const std::byte> _data)
+  :data(_data)
+{
+  Open();
+}
+
+TopographyPackage::TopographyPackage(Path path)
+  :mapping(new FileMapping(path)),
+   data(*mapping)
+{
+  Open();
+}
+
+TopographyPackage::~TopographyPackage() noexcept = default;
+
+void
+TopographyPackage::Open()
+{
+  Header header;
+  if (data.size() < sizeof(header))
+    throw std::runtime_error("Topography package too small");
+
+  memcpy(&header, data.data(), sizeof(header));
+
+  if (header.magic != Header::MAGIC ||
+      header.endian_marker != Header::ENDIAN_MARKER)
+    throw std::runtime_error("Not a topography package");
+
+  if (header.version != Header::VERSION)
+    throw std::runtime_error("Unsupported topography package version");
+
+  /* the layers are accessed in place */
+  if (reinterpret_cast<std::uintptr_t>(data.data()) % ALIGNMENT != 0)
+    throw std::runtime_error("Misaligned topography package");
+
+  if (header.n_layers > 256 ||
+      data.size() < sizeof(header) + header.n_layers * sizeof(LayerEntry))
+    throw std::runtime_error("Truncated topography package index");
+
+  const auto *entries =
+    reinterpret_cast<const LayerEntry *>(data.data() + sizeof(header));
+
+  layers.reserve(header.n_layers);
+  for (const auto &entry : std::span{entries, header.n_layers}) {
+    const char *end = (const char *)memchr(entry.name, 0, sizeof(entry.name));
+    if (end == nullptr || entry.offset % ALIGNMENT != 0 ||
+        entry.offset > data.size() ||
+        entry.size > data.size() - entry.offset)
+      throw std::runtime_error("Malformed topography package index");
+
+    layers.emplace_back(std::string_view{entry.name, end},
+                        data.subspan(entry.offset, entry.size));
+  }
+}
+
+const TopographyPackage::Layer *
+TopographyPackage::FindLayer(std::string_view name) const noexcept
+{
+  for (const auto &i : layers)
+    if (i.GetName() == name)
+      return &i;
+
+  return nullptr;
+}
+
+/**
+ * Append #src to #dest, aligned to #alignment bytes.
+ *
+ * @return the offset of the new data
+ */
+static uint32_t
+Append(std::vector<std::byte> &dest, std::span<const std::byte> src,
+       std::size_t alignment)
+{
+  dest.resize((dest.size() + alignment - 1) / alignment * alignment);
+  const std::size_t offset = dest.size();
+  if (offset + src.size() > UINT32_MAX)
+    throw std::runtime_error("Topography layer too large");
+
+  dest.insert(dest.end(), src.begin(), src.end());
+  return offset;
+}
+
+template<typename T>
+static uint32_t
+AppendArray(std::vector<std::byte> &dest, std::span<const T> src)
+{
+  if (src.empty())
+    return 0;
+
+  return Append(dest, std::as_bytes(src), alignof(T));
+}
+
+void
+TopographyPackageWriter::AddLayer(std::string_view name, GeoPoint center,
+                                  std::span<const unsigned, TopographyPackage::MAX_LEVELS> min_distance,
+                                  std::span<const TopographyPackage::Shape> shapes)
+{
+  using Package = TopographyPackage;
+
+  if (name.size() >= sizeof(Package::LayerEntry::name))
+    throw std::invalid_argument("Topography layer name too long");
+
+  if (shapes.size() > UINT32_MAX / sizeof(Package::ShapeRecord))
+    throw std::invalid_argument("Too many shapes");
+
+  std::vector<Package::ShapeRecord> records(shapes.size());
+
+  Package::LayerHeader header{};
+  header.n_shapes = shapes.size();
+  std::copy(min_distance.begin(), min_distance.end(), header.min_distance);
+  header.center_longitude = center.longitude.Radians();
+  header.center_latitude = center.latitude.Radians();
+
+  if (shapes.empty()) {
+    header.west = header.east = header.center_longitude;
+    header.south = header.north = header.center_latitude;
+  } else {
+    header.west = header.south = INFINITY;
+    header.east = header.north = -INFINITY;
+  }
+
+  for (std::size_t i = 0; i < shapes.size(); ++i) {
+    const auto &bounds = shapes[i].bounds;
+    auto &r = records[i];
+    r.west = bounds.GetWest().Radians();
+    r.south = bounds.GetSouth().Radians();
+    r.east = bounds.GetEast().Radians();
+    r.north = bounds.GetNorth().Radians();
+
+    header.west = std::min(header.west, r.west);
+    header.south = std::min(header.south, r.south);
+    header.east = std::max(header.east, r.east);
+    header.north = std::max(header.north, r.north);
+  }
+
+  /* the spatial index: a grid with about four shapes per cell */
+  header.columns = header.rows =
+    std::clamp(unsigned(std::sqrt(shapes.size() / 4.)), 1u, MAX_GRID);
+
+  const unsigned n_cells = header.columns * header.rows;
+  std::vector<std::vector<uint32_t>> cells(n_cells);
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    const auto &r = records[i];
+    const unsigned x0 = ToCell(r.west, header.west, header.east, header.columns);
+    const unsigned x1 = ToCell(r.east, header.west, header.east, header.columns);
+    const unsigned y0 = ToCell(r.south, header.south, header.north, header.rows);
+    const unsigned y1 = ToCell(r.north, header.south, header.north, header.rows);
+
+    for (unsigned y = y0; y <= y1; ++y)
+      for (unsigned x = x0; x <= x1; ++x)
+        cells[y * header.columns + x].push_back(i);
+  }
+
+  std::vector<uint32_t> grid, cell_shapes;
+  grid.reserve(n_cells + 1);
+  for (const auto &cell : cells) {
+    grid.push_back(cell_shapes.size());
+    cell_shapes.insert(cell_shapes.end(), cell.begin(), cell.end());
+  }
+  grid.push_back(cell_shapes.size());
+
+  /* reserve space for the header and the records, which are filled
+     in after the data offsets are known */
+  std::vector<std::byte> data(sizeof(header) +
+                              records.size() * sizeof(Package::ShapeRecord));
+
+  header.grid_offset = AppendArray(data, std::span<const uint32_t>{grid});
+  AppendArray(data, std::span<const uint32_t>{cell_shapes});
+
+  for (std::size_t i = 0; i < shapes.size(); ++i) {
+    const auto &shape = shapes[i];
+    auto &r = records[i];
+
+    if (shape.lines.size() > UINT8_MAX)
+      throw std::invalid_argument("Too many lines");
+
+    r.type = shape.type;
+    r.n_lines = shape.lines.size();
+    r.n_points = shape.points.size();
+    r.lines_offset = AppendArray(data, shape.lines);
+    r.points_offset = AppendArray(data, shape.points);
+
+    if (shape.label != nullptr)
+      r.label_offset = Append(data,
+                              std::as_bytes(std::span{shape.label,
+                                                      strlen(shape.label) + 1}),
+                              1);
+
+    for (unsigned level = 0; level < Package::MAX_LEVELS; ++level) {
+      r.indices_offset[level] = AppendArray(data, shape.indices[level]);
+      r.indices_size[level] = shape.indices[level].size();
+    }
+  }
+
+  memcpy(data.data(), &header, sizeof(header));
+  memcpy(data.data() + sizeof(header), records.data(),
+         records.size() * sizeof(Package::ShapeRecord));
+
+  layers.push_back({std::string{name}, std::move(data)});
+}
+
+void
+TopographyPackageWriter::Finish(BufferedOutputStream &os) const
+{
+  using Package = TopographyPackage;
+
+  static constexpr std::byte zero[Package::ALIGNMENT]{};
+
+  Package::Header header{};
+  header.magic = Package::Header::MAGIC;
+  header.version = Package::Header::VERSION;
+  header.endian_marker = Package::Header::ENDIAN_MARKER;
+  header.n_layers = layers.size();
+  os.WriteT(header);
+
+  std::size_t position = sizeof(header) +
+    layers.size() * sizeof(Package::LayerEntry);
+
+  for (const auto &layer : layers) {
+    position = (position + Package::ALIGNMENT - 1) & ~(Package::ALIGNMENT - 1);
+
+    Package::LayerEntry entry{};
+    memcpy(entry.name, layer.name.data(), layer.name.size());
+    entry.offset = position;
+    entry.size = layer.data.size();
+    os.WriteT(entry);
+
+    position += layer.data.size();
+  }
+
+  position = sizeof(header) + layers.size() * sizeof(Package::LayerEntry);
+
+  for (const auto &layer : layers) {
+    const std::size_t n = -position % Package::ALIGNMENT;
+    os.Write(std::span{zero, n});
+    position += n;
+
+    os.Write(std::span{layer.data});
+    position += layer.data.size();
+  }
+}
@@ -0,0 +1,307 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "XShapePoint.hpp"
+#include "Geo/GeoBounds.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Path;
+class FileMapping;
+class BufferedOutputStream;
+
+/**
+ * A container with pre-converted topography layers.  It is generated
+ * once from the shapefiles of a map file (see ConvertTopography) and
+ * is mapped into memory, so opening a layer is an index walk instead
+ * of a shapelib parser pass, and the shapes are read in place.
+ *
+ * The file consists of a #Header and one #LayerEntry per layer,
+ * followed by the layers.  Each layer starts with a #LayerHeader,
+ * followed by one #ShapeRecord per shape, a uniform grid of shape
+ * numbers (the spatial index) and the shape data: line lengths,
+ * #ShapePoint coordinates relative to the layer center, labels and
+ * the precomputed OpenGL index lists of each thinning level.  All
+ * offsets within a layer are relative to the layer start.  All
+ * integers are in host byte order; #Header::ENDIAN_MARKER rejects
+ * files which were generated on a different architecture.
+ */
+class TopographyPackage {
+public:
+  static constexpr std::size_t ALIGNMENT = 16;
+
+  /**
+   * The number of precomputed thinning levels (see
+   * XShape::GetIndices()).
+   */
+  static constexpr unsigned MAX_LEVELS = 4;
+
+  struct Header {
+    static constexpr uint32_t MAGIC = 0x50544358; // "XCTP"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t ENDIAN_MARKER = 0x0102;
+
+    uint32_t magic;
+    uint16_t version;
+    uint16_t endian_marker;
+
+    uint32_t n_layers;
+    uint32_t reserved;
+  };
+
+  static_assert(sizeof(Header) == 16);
+
+  struct LayerEntry {
+    /**
+     * The shapefile name from "topology.tpl" (without the ".shp"
+     * suffix), null-terminated.
+     */
+    char name[48];
+
+    uint64_t offset, size;
+  };
+
+  static_assert(sizeof(LayerEntry) == 64);
+
+  struct LayerHeader {
+    uint32_t n_shapes;
+
+    /**
+     * The dimensions of the spatial index grid.
+     */
+    uint32_t columns, rows;
+
+    /**
+     * The minimum point distance which was used to build the index
+     * lists of each level (or 0 if they were not built); see
+     * TopographyFile::GetMinimumPointDistance().
+     */
+    uint32_t min_distance[MAX_LEVELS];
+
+    /**
+     * The offset of the grid: (columns*rows+1) offsets into the
+     * shape number array which follows immediately.
+     */
+    uint32_t grid_offset;
+
+    /**
+     * The layer center (radians); all #ShapePoint coordinates are
+     * relative to it.
+     */
+    double center_longitude, center_latitude;
+
+    /**
+     * The area covered by the grid (radians).
+     */
+    double west, south, east, north;
+  };
+
+  static_assert(sizeof(LayerHeader) == 80);
+
+  struct ShapeRecord {
+    /**
+     * The shape bounds (radians).
+     */
+    double west, south, east, north;
+
+    uint8_t type;
+    uint8_t n_lines;
+    uint16_t reserved;
+
+    uint32_t n_points;
+
+    /**
+     * The offset of #n_lines uint16_t line lengths.
+     */
+    uint32_t lines_offset;
+
+    /**
+     * The offset of #n_points #ShapePoint values.
+     */
+    uint32_t points_offset;
+
+    /**
+     * The offset of a null-terminated UTF-8 label, or 0 if the shape
+     * has no label.
+     */
+    uint32_t label_offset;
+
+    /**
+     * The offset and the number of uint16_t elements of the index
+     * list of each level (in the layout of XShape::GetIndices()), or
+     * 0 if it was not precomputed.
+     */
+    uint32_t indices_offset[MAX_LEVELS];
+    uint32_t indices_size[MAX_LEVELS];
+
+    uint32_t padding;
+  };
+
+  static_assert(sizeof(ShapeRecord) == 88);
+
+  /**
+   * A shape, pointing into the mapped file.
+   */
+  struct Shape {
+    GeoBounds bounds;
+
+    uint8_t type;
+
+    std::span<const uint16_t> lines;
+    std::span<const ShapePoint> points;
+
+    /**
+     * The label, or nullptr.
+     */
+    const char *label;
+
+    std::array<std::span<const uint16_t>, MAX_LEVELS> indices;
+  };
+
+  class Layer {
+    friend class TopographyPackage;
+
+    std::string name;
+
+    std::span<const std::byte> data;
+
+    LayerHeader header;
+
+    std::span<const ShapeRecord> records;
+
+    /**
+     * The start of each grid cell in #cell_shapes, plus the end of
+     * the last one.
+     */
+    std::span<const uint32_t> grid;
+
+    std::span<const uint32_t> cell_shapes;
+
+  public:
+    /**
+     * Throws on error.
+     */
+    Layer(std::string_view _name, std::span<const std::byte> _data);
+
+    const std::string &GetName() const noexcept {
+      return name;
+    }
+
+    std::size_t size() const noexcept {
+      return records.size();
+    }
+
+    GeoPoint GetCenter() const noexcept {
+      return {
+        Angle::Radians(header.center_longitude),
+        Angle::Radians(header.center_latitude),
+      };
+    }
+
+    GeoBounds GetBounds() const noexcept {
+      return {
+        {Angle::Radians(header.west), Angle::Radians(header.north)},
+        {Angle::Radians(header.east), Angle::Radians(header.south)},
+      };
+    }
+
+    /**
+     * The minimum point distance the index lists of the specified
+     * level were built for, or 0 if there are none.
+     */
+    unsigned GetMinimumPointDistance(unsigned level) const noexcept {
+      return level < MAX_LEVELS ? header.min_distance[level] : 0;
+    }
+
+    /**
+     * Throws on error (if the record is malformed).
+     */
+    Shape GetShape(std::size_t i) const;
+
+    /**
+     * Set a bit (in the layout of msGetBit()) for each shape which
+     * overlaps the specified bounds, and clear all others.
+     *
+     * @param status an array of at least (size()+31)/32 elements
+     * @return the number of shapes found
+     */
+    std::size_t WhichShapes(const GeoBounds &bounds,
+                            std::span<uint32_t> status) const noexcept;
+
+  private:
+    template<typename T>
+    std::span<const T> GetArray(uint32_t offset, std::size_t n) const;
+  };
+
+private:
+  std::unique_ptr<FileMapping> mapping;
+
+  std::span<const std::byte> data;
+
+  std::vector<Layer> layers;
+
+public:
+  /**
+   * Throws on error.
+   */
+  explicit TopographyPackage(std::span<const std::byte> _data);
+
+  /**
+   * Throws on error.
+   */
+  explicit TopographyPackage(Path path);
+
+  ~TopographyPackage() noexcept;
+
+  TopographyPackage(const TopographyPackage &) = delete;
+  TopographyPackage &operator=(const TopographyPackage &) = delete;
+
+  /**
+   * @return the layer or nullptr if there is no such layer
+   */
+  [[gnu::pure]]
+  const Layer *FindLayer(std::string_view name) const noexcept;
+
+private:
+  void Open();
+};
+
+/**
+ * Writer for #TopographyPackage.  The layers are collected in memory
+ * and written by Finish().
+ */
+class TopographyPackageWriter {
+  struct LayerBuffer {
+    std::string name;
+    std::vector<std::byte> data;
+  };
+
+  std::vector<LayerBuffer> layers;
+
+public:
+  /**
+   * Add a layer.  The #Shape::bounds attributes must be valid.
+   *
+   * @param min_distance the minimum point distance which was used
+   * for the index lists of each level (0 if there are none)
+   *
+   * Throws on error.
+   */
+  void AddLayer(std::string_view name, GeoPoint center,
+                std::span<const unsigned, TopographyPackage::MAX_LEVELS> min_distance,
+                std::span<const TopographyPackage::Shape> shapes);
+
+  /**
+   * Throws on error.
+   */
+  void Finish(BufferedOutputStream &os) const;
+};
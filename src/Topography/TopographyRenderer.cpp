@@ -5,6 +5,7 @@
 #include "Topography/TopographyFileRenderer.hpp"
 #include "TopographyStore.hpp"
 #include "TopographyFile.hpp"
+#include "Projection/WindowProjection.hpp"
 
 TopographyRenderer::TopographyRenderer(const TopographyStore &_store,
                                        const TopographyLook &look) noexcept
@@ -20,9 +21,17 @@ TopographyRenderer::~TopographyRenderer() noexcept = default;
 void
 TopographyRenderer::Draw(Canvas &canvas,
                          const WindowProjection &projection) noexcept
+{
+  Draw(canvas, projection, projection.GetMapScale());
+}
+
+void
+TopographyRenderer::Draw(Canvas &canvas,
+                         const WindowProjection &projection,
+                         double map_scale) noexcept
 {
   for (auto &i : files)
-    i.Paint(canvas, projection);
+    i.Paint(canvas, projection, map_scale);
 }
 
 void
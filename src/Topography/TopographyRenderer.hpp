@@ -41,6 +41,14 @@ public:
    */
   void Draw(Canvas &canvas, const WindowProjection &projection) noexcept;
 
+  /**
+   * Draws the topography which is visible at the given map scale
+   * (instead of the projection's own map scale).  This is used to
+   * draw a part of a larger screen.
+   */
+  void Draw(Canvas &canvas, const WindowProjection &projection,
+            double map_scale) noexcept;
+
   void DrawLabels(Canvas &canvas, const WindowProjection &projection,
                   LabelBlock &label_block) noexcept;
 };
@@ -3,6 +3,8 @@
 
 #include "Topography/TopographyStore.hpp"
 #include "Index.hpp"
+#include "thread/ThreadPool.hpp"
+#include "Projection/WindowProjection.hpp"
 #include "util/StringAPI.hxx"
 #include "util/StringCompare.hxx"
 #include "io/LineReader.hpp"
@@ -12,7 +14,10 @@
 #include "Compatibility/path.h"
 #include "LogFile.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <vector>
 
 #include <windef.h> // for MAX_PATH
 
@@ -54,23 +59,136 @@ TopographyStore::ScanVisibility(const WindowProjection &m_projection,
     }
   }
 
+  if (EnforceMemoryBudget(m_projection) && num_updated == 0)
+    /* make the caller come back to load the restored shapes */
+    num_updated = 1;
+
   serial += num_updated;
   return num_updated;
 }
 
+unsigned
+TopographyStore::ScanVisibility(const WindowProjection &m_projection,
+                                ThreadPool &pool,
+                                const std::function<void()> &updated) noexcept
+{
+  std::vector<TopographyFile *> tasks;
+  for (auto &file : files)
+    tasks.push_back(&file);
+
+  std::atomic<unsigned> num_updated{0};
+  pool.ForEach(tasks.size(), [&](std::size_t i){
+    try {
+      if (tasks[i]->Update(m_projection, &io_mutex)) {
+        num_updated.fetch_add(1, std::memory_order_relaxed);
+        if (updated)
+          updated();
+      }
+    } catch (...) {
+      LogError(std::current_exception());
+    }
+  });
+
+  unsigned result = num_updated;
+  if (EnforceMemoryBudget(m_projection) && result == 0)
+    /* make the caller come back to load the restored shapes */
+    result = 1;
+
+  serial += result;
+  return result;
+}
+
+bool
+TopographyStore::EnforceMemoryBudget(const WindowProjection &projection) noexcept
+{
+  const double map_scale = projection.GetMapScale();
+  ++memory_tick;
+
+  std::vector<TopographyFile *> hidden, visible;
+  std::size_t used = 0;
+  for (auto &file : files) {
+    used += file.GetMemoryUsage();
+
+    if (file.IsVisible(map_scale)) {
+      file.SetLastVisible(memory_tick);
+      visible.push_back(&file);
+    } else if (file.GetMemoryUsage() > 0)
+      hidden.push_back(&file);
+  }
+
+  bool restored = false;
+
+  if (memory_budget > 0 && used > memory_budget) {
+    std::sort(hidden.begin(), hidden.end(), [](const auto *a, const auto *b){
+      return a->GetLastVisible() < b->GetLastVisible();
+    });
+
+    std::sort(visible.begin(), visible.end(), [](const auto *a, const auto *b){
+      return a->GetScaleThreshold() < b->GetScaleThreshold();
+    });
+
+    const GeoPoint location = projection.GetGeoScreenCenter();
+
+    for (auto *v : {&hidden, &visible}) {
+      for (TopographyFile *file : *v) {
+        if (used <= memory_budget)
+          break;
+
+        used -= file->Evict(used - memory_budget, location);
+      }
+    }
+  } else {
+    /* the most important files first */
+    std::sort(visible.begin(), visible.end(), [](const auto *a, const auto *b){
+      return a->GetScaleThreshold() > b->GetScaleThreshold();
+    });
+
+    std::size_t planned = used;
+    for (TopographyFile *file : visible) {
+      const std::size_t evicted = file->GetEvictedMemory();
+      if (evicted == 0)
+        continue;
+
+      if (memory_budget > 0 && planned + evicted > memory_budget)
+        break;
+
+      file->Restore();
+      planned += evicted;
+      restored = true;
+    }
+  }
+
+  std::size_t evicted = 0;
+  for (const auto &file : files)
+    evicted += file.GetEvictedMemory();
+
+  evicted_memory.store(evicted, std::memory_order_relaxed);
+  used_memory.store(used, std::memory_order_relaxed);
+
+  return restored;
+}
+
 void
 TopographyStore::LoadAll() noexcept
 {
-  for (auto &i : files)
+  std::size_t used = 0;
+  for (auto &i : files) {
     i.LoadAll();
+    used += i.GetMemoryUsage();
+  }
+
+  used_memory.store(used, std::memory_order_relaxed);
 }
 
 void
 TopographyStore::Load(OperationEnvironment &operation, NLineReader &reader,
-                      Path directory, struct zzip_dir *zdir) noexcept
+                      Path directory, struct zzip_dir *zdir,
+                      std::unique_ptr<TopographyPackage> _package) noexcept
 {
   Reset();
 
+  package = std::move(_package);
+
   // Create buffer for the shape filenames
   // (shape_filename will be modified with the shape_filename_end pointer)
   char shape_filename[MAX_PATH];
@@ -99,6 +217,25 @@ TopographyStore::Load(OperationEnvironment &operation, NLineReader &reader,
     if (!entry)
       continue;
 
+    if (const auto *layer = package != nullptr
+          ? package->FindLayer(entry->name)
+          : nullptr) {
+      try {
+        i = files.emplace_after(i, *layer,
+                                entry->shape_range,
+                                entry->label_range,
+                                entry->important_label_range,
+                                entry->color,
+                                entry->icon, entry->big_icon,
+                                entry->pen_width);
+      } catch (...) {
+        LogError(std::current_exception());
+      }
+
+      operation.SetProgressPosition((reader.Tell() * 100) / filesize);
+      continue;
+    }
+
     // Extract filename and append it to the shape_filename buffer
     memcpy(shape_filename_end, entry->name.data(), entry->name.size());
     // Append ".shp" file extension to the shape_filename buffer
@@ -128,4 +265,8 @@ void
 TopographyStore::Reset() noexcept
 {
   files.clear();
+  package.reset();
+
+  used_memory.store(0, std::memory_order_relaxed);
+  evicted_memory.store(0, std::memory_order_relaxed);
 }
@@ -6,9 +6,14 @@
 #include "TopographyFile.hpp"
 #include "util/NonCopyable.hpp"
 
+#include <atomic>
+#include <cstddef>
 #include <forward_list>
+#include <functional>
+#include <memory>
 
 class Path;
+class ThreadPool;
 class WindowProjection;
 class NLineReader;
 class OperationEnvironment;
@@ -18,13 +23,69 @@ struct zzip_dir;
  * Class used to manage and render vector topography layers
  */
 class TopographyStore : private NonCopyable {
+public:
+  /**
+   * The default for SetMemoryBudget().
+   */
+#ifdef KOBO
+  static constexpr std::size_t DEFAULT_MEMORY_BUDGET = 16 * 1024 * 1024;
+#else
+  static constexpr std::size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+#endif
+
+  struct MemoryStats {
+    /**
+     * The memory occupied by the loaded shapes of all files.
+     */
+    std::size_t used;
+
+    /**
+     * The memory the shapes which were evicted to stay within the
+     * budget would occupy.
+     */
+    std::size_t evicted;
+
+    std::size_t budget;
+  };
+
+private:
+  /**
+   * The pre-converted layers; the #TopographyFile instances which
+   * were loaded from here point into it.
+   */
+  std::unique_ptr<TopographyPackage> package;
+
   std::forward_list<TopographyFile> files;
 
+  /**
+   * Serialises the shapefile reads of parallel updates, because
+   * the files share one ZIP archive handle.
+   */
+  Mutex io_mutex;
+
   /**
    * This number is incremented each time this object is modified.
    */
   unsigned serial = 0;
 
+  /**
+   * The maximum amount of memory the loaded shapes of all files may
+   * occupy; 0 means unlimited.
+   */
+  std::size_t memory_budget = DEFAULT_MEMORY_BUDGET;
+
+  /**
+   * Incremented by each EnforceMemoryBudget() call, for
+   * TopographyFile::SetLastVisible().
+   */
+  unsigned memory_tick = 0;
+
+  /**
+   * Copies of the #MemoryStats attributes for GetMemoryStats(), which
+   * may be called by any thread.
+   */
+  std::atomic<std::size_t> used_memory{0}, evicted_memory{0};
+
 public:
   TopographyStore() noexcept;
   ~TopographyStore() noexcept;
@@ -59,13 +120,69 @@ public:
   unsigned ScanVisibility(const WindowProjection &m_projection,
                           unsigned max_update=1024) noexcept;
 
+  /**
+   * Like ScanVisibility() above, but update all files in parallel on
+   * the given #ThreadPool, one task per file.
+   *
+   * @param updated an optional function which is invoked (in an
+   * arbitrary thread) each time a file has been updated, i.e. when
+   * its new shapes have been published
+   * @return the number of files which were updated
+   */
+  unsigned ScanVisibility(const WindowProjection &m_projection,
+                          ThreadPool &pool,
+                          const std::function<void()> &updated) noexcept;
+
+  /**
+   * Change the maximum amount of memory the loaded shapes may occupy.
+   * It is applied by the next ScanVisibility() call.  Only the thread
+   * which calls ScanVisibility() may call this.
+   *
+   * @param budget the budget in bytes; 0 means unlimited
+   */
+  void SetMemoryBudget(std::size_t budget) noexcept {
+    memory_budget = budget;
+  }
+
+  /**
+   * May be called by any thread.
+   */
+  [[gnu::pure]]
+  MemoryStats GetMemoryStats() const noexcept {
+    return {
+      used_memory.load(std::memory_order_relaxed),
+      evicted_memory.load(std::memory_order_relaxed),
+      memory_budget,
+    };
+  }
+
   /**
    * Load all shapes of all files into memory.  For debugging
    * purposes.
    */
   void LoadAll() noexcept;
 
+  /**
+   * @param _package an optional #TopographyPackage; the layers it
+   * contains are loaded from there instead of the shapefiles
+   */
   void Load(OperationEnvironment &operation, NLineReader &reader,
-            Path directory, struct zzip_dir *zdir = nullptr) noexcept;
+            Path directory, struct zzip_dir *zdir = nullptr,
+            std::unique_ptr<TopographyPackage> _package = {}) noexcept;
   void Reset() noexcept;
+
+private:
+  /**
+   * Evict shapes until the loaded shapes fit in #memory_budget.  The
+   * files which are not visible at the current scale go first (the
+   * least recently visible one first), followed by the visible files
+   * with the lowest scale threshold (i.e. the most detailed layers).
+   * Within a file, the shapes farthest from the screen center go
+   * first.  Shapes evicted earlier are restored as soon as they fit
+   * again, the most important files first.
+   *
+   * @return true if shapes were restored; the next ScanVisibility()
+   * call will load them
+   */
+  bool EnforceMemoryBudget(const WindowProjection &projection) noexcept;
 };
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TopographyTileCache.hpp"
+
+#ifndef ENABLE_OPENGL
+
+#include "TopographyRenderer.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "ui/canvas/Canvas.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr int
+FloorDiv(int a, int b) noexcept
+{
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/**
+ * How many pixels does a grid anchored at the given location shear
+ * against the screen projection?  This is the difference of the
+ * horizontal offset between the grid and the screen in the northmost
+ * and the southmost screen row.
+ */
+[[gnu::pure]]
+static double
+GetShear(const WindowProjection &projection, GeoPoint anchor) noexcept
+{
+  const auto &bounds = projection.GetScreenBounds();
+  const double cos_north = bounds.GetNorth().fastcosine();
+  const double cos_south = bounds.GetSouth().fastcosine();
+
+  /* the cosine is largest at the equator */
+  const double max_cos =
+    bounds.GetSouth().Native() < 0 && bounds.GetNorth().Native() > 0
+    ? 1.
+    : std::max(cos_north, cos_south);
+  const double min_cos = std::min(cos_north, cos_south);
+
+  const Angle delta =
+    (projection.GetGeoLocation().longitude - anchor.longitude).AsDelta();
+  return projection.AngleToPixels(delta.Absolute()) * (max_cos - min_cos);
+}
+
+TopographyTileCache::Tile &
+TopographyTileCache::GetTile(Canvas &canvas, const Projection &grid,
+                             int x, int y, std::size_t max_tiles,
+                             double map_scale,
+                             TopographyRenderer &renderer) noexcept
+{
+  const double scale = grid.GetScale();
+
+  for (auto i = tiles.begin(); i != tiles.end(); ++i) {
+    if (i->scale == scale && i->x == x && i->y == y) {
+      tiles.splice(tiles.begin(), tiles, i);
+      i->frame = frame;
+      return *i;
+    }
+  }
+
+  constexpr unsigned BUFFER_SIZE = TILE_SIZE + 2 * TILE_MARGIN;
+
+  if (tiles.size() >= max_tiles && tiles.back().frame != frame) {
+    /* recycle the least recently used tile */
+    tiles.splice(tiles.begin(), tiles, std::prev(tiles.end()));
+  } else {
+    tiles.emplace_front();
+    tiles.front().buffer.Create(canvas, {BUFFER_SIZE, BUFFER_SIZE});
+  }
+
+  Tile &tile = tiles.front();
+  tile.scale = scale;
+  tile.x = x;
+  tile.y = y;
+  tile.frame = frame;
+
+  WindowProjection tile_projection;
+  static_cast<Projection &>(tile_projection) = grid;
+  tile_projection.SetScreenOrigin(int(TILE_MARGIN) - x * int(TILE_SIZE),
+                                  int(TILE_MARGIN) - y * int(TILE_SIZE));
+  tile_projection.SetScreenSize({BUFFER_SIZE, BUFFER_SIZE});
+  tile_projection.UpdateScreenBounds();
+
+  tile.buffer.ClearWhite();
+  renderer.Draw(tile.buffer, tile_projection, map_scale);
+
+  return tile;
+}
+
+bool
+TopographyTileCache::Draw(Canvas &canvas, const WindowProjection &projection,
+                          TopographyRenderer &renderer) noexcept
+{
+  if (projection.GetScreenAngle() != Angle::Zero())
+    return false;
+
+  const auto size = projection.GetScreenSize();
+  if (size != screen_size) {
+    screen_size = size;
+    Invalidate();
+  }
+
+  if (!anchor.IsValid() || GetShear(projection, anchor) >= 1) {
+    tiles.clear();
+    anchor = projection.GetGeoLocation();
+  }
+
+  /* the grid is an unrotated projection which maps the anchor to
+     pixel (0,0) */
+  Projection grid;
+  grid.SetScale(projection.GetScale());
+  grid.SetGeoLocation(anchor);
+
+  /* screen = grid + offset */
+  const GeoPoint center = projection.GetGeoScreenCenter();
+  const PixelPoint offset =
+    projection.GeoToScreen(center) - grid.GeoToScreen(center);
+
+  constexpr int T = TILE_SIZE;
+  const int x_min = FloorDiv(-offset.x, T);
+  const int x_max = FloorDiv(int(size.width) - 1 - offset.x, T);
+  const int y_min = FloorDiv(-offset.y, T);
+  const int y_max = FloorDiv(int(size.height) - 1 - offset.y, T);
+
+  /* keep the tiles of about one more screen, e.g. for zooming back */
+  const std::size_t max_tiles =
+    2 * std::size_t(x_max - x_min + 1) * std::size_t(y_max - y_min + 1);
+
+  const double map_scale = projection.GetMapScale();
+
+  ++frame;
+
+  for (int y = y_min; y <= y_max; ++y) {
+    for (int x = x_min; x <= x_max; ++x) {
+      const Tile &tile = GetTile(canvas, grid, x, y, max_tiles,
+                                 map_scale, renderer);
+      canvas.CopyTransparentWhite({x * T + offset.x, y * T + offset.y},
+                                  {TILE_SIZE, TILE_SIZE},
+                                  tile.buffer, {TILE_MARGIN, TILE_MARGIN});
+    }
+  }
+
+  while (tiles.size() > max_tiles)
+    tiles.pop_back();
+
+  return true;
+}
+
+#endif
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#ifndef ENABLE_OPENGL
+
+#include "Geo/GeoPoint.hpp"
+#include "ui/canvas/BufferCanvas.hpp"
+#include "ui/dim/Size.hpp"
+
+#include <list>
+
+class Canvas;
+class Projection;
+class WindowProjection;
+class TopographyRenderer;
+
+/**
+ * A tile cache for the topography of the non-OpenGL map.  Each tile is
+ * rendered once for one zoom level (projection scale).  Every frame, the
+ * cached tiles are copied to the screen, with white as the
+ * transparent color.  When panning, only the tiles which come into view
+ * are rendered.
+ *
+ * The tiles are a grid in an unrotated projection around an "anchor"
+ * location.  Projection::GeoToScreen() scales longitudes with the
+ * cosine of each point's own latitude.  This makes the grid shear
+ * against the screen when the screen center moves east or west of the
+ * anchor.  Before the shear reaches one pixel, the anchor is moved and
+ * all tiles are discarded.
+ */
+class TopographyTileCache {
+public:
+  static constexpr unsigned TILE_SIZE = 256;
+
+  /**
+   * Each tile is rendered with this many extra pixels on every side.
+   * This keeps icons and wide lines crossing a tile edge complete.
+   */
+  static constexpr unsigned TILE_MARGIN = 32;
+
+private:
+  struct Tile {
+    double scale;
+    int x, y;
+
+    /**
+     * The Draw() call which last used this tile.
+     */
+    unsigned frame;
+
+    BufferCanvas buffer;
+  };
+
+  /**
+   * The most recently used tile first.
+   */
+  std::list<Tile> tiles;
+
+  GeoPoint anchor = GeoPoint::Invalid();
+
+  /**
+   * The map scale (which selects the visible layers) depends on the
+   * screen size, so the tiles are discarded when it changes.
+   */
+  PixelSize screen_size{0, 0};
+
+  unsigned frame = 0;
+
+public:
+  void Invalidate() noexcept {
+    tiles.clear();
+    anchor = GeoPoint::Invalid();
+  }
+
+  /**
+   * Draw the topography to the canvas, and render the tiles which are
+   * missing.
+   *
+   * @return false if the tiles cannot be used for this projection
+   * (because it is rotated); the caller must draw it without the
+   * cache
+   */
+  bool Draw(Canvas &canvas, const WindowProjection &projection,
+            TopographyRenderer &renderer) noexcept;
+
+private:
+  Tile &GetTile(Canvas &canvas, const Projection &grid,
+                int x, int y, std::size_t max_tiles,
+                double map_scale, TopographyRenderer &renderer) noexcept;
+};
+
+#endif
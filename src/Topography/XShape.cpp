@@ -23,8 +23,8 @@
 
 #include <tchar.h>
 
-static BasicAllocatedString<TCHAR>
-ImportLabel(const char *src) noexcept
+BasicAllocatedString<TCHAR>
+XShape::ImportLabel(const char *src) noexcept
 {
   if (src == nullptr)
     return nullptr;
@@ -77,14 +77,14 @@ ToGeoPoint(const pointObj &src) noexcept
   };
 }
 
+/**
+ * Convert a shapefile point to a #ShapePoint relative to the map's
+ * boundary center.
+ */
 [[gnu::pure]]
-static auto
-ImportShapePoint(const pointObj &src, [[maybe_unused]] const GeoPoint &file_center) noexcept
+static ShapePoint
+ImportShapePoint(const pointObj &src, const GeoPoint &file_center) noexcept
 {
-#ifdef ENABLE_OPENGL
-  /* OpenGL: convert GeoPoints to ShapePoints, make them relative to
-     the map's boundary center */
-
   const GeoPoint vertex = ToGeoPoint(src);
   const GeoPoint relative = vertex - file_center;
 
@@ -92,15 +92,9 @@ ImportShapePoint(const pointObj &src, [[maybe_unused]] const GeoPoint &file_cent
     ShapeScalar(relative.longitude.Native()),
     ShapeScalar(relative.latitude.Native()),
   };
-#else
-  /* convert all points of all lines to GeoPoints */
-  return ToGeoPoint(src);
-#endif
 }
 
-XShape::XShape(const shapeObj &shape, const GeoPoint &file_center,
-               const char *_label)
-  :label(ImportLabel(_label))
+XShape::XShape(const shapeObj &shape, const GeoPoint &file_center)
 {
   bounds = ImportRect(shape.bounds);
   if (!bounds.Check())
@@ -129,8 +123,9 @@ XShape::XShape(const shapeObj &shape, const GeoPoint &file_center,
     ++num_lines;
   }
 
-  points = std::make_unique<Point[]>(num_points);
-  auto *p = points.get();
+  point_buffer = std::make_unique<Point[]>(num_points);
+  points = point_buffer.get();
+  auto *p = point_buffer.get();
   for (std::size_t l = 0; l < num_lines; ++l) {
     const pointObj *src = shape.line[l].point;
     p = std::transform(src, src + lines[l], p,
@@ -140,8 +135,115 @@ XShape::XShape(const shapeObj &shape, const GeoPoint &file_center,
   }
 }
 
+#ifdef ENABLE_OPENGL
+
+/**
+ * Check whether a precomputed index list refers only to existing
+ * points and is consistent with its counts.
+ */
+[[gnu::pure]]
+static bool
+CheckIndexBlock(int type, std::span<const uint16_t> lines,
+                std::size_t num_points,
+                std::span<const uint16_t> block) noexcept
+{
+  std::size_t n_counts;
+  if (type == MS_SHAPE_LINE)
+    n_counts = lines.size();
+  else if (type == MS_SHAPE_POLYGON)
+    n_counts = 1;
+  else
+    return false;
+
+  if (block.size() < n_counts)
+    return false;
+
+  std::size_t n_indices = 0;
+  for (std::size_t i = 0; i < n_counts; ++i)
+    n_indices += block[i];
+
+  if (block.size() - n_counts < n_indices)
+    return false;
+
+  return std::all_of(block.begin() + n_counts,
+                     block.begin() + n_counts + n_indices,
+                     [num_points](uint16_t i){ return i < num_points; });
+}
+
+#endif
+
+XShape::XShape(const TopographyPackage::Shape &shape,
+               [[maybe_unused]] const GeoPoint &file_center,
+               [[maybe_unused]] unsigned index_levels)
+  :bounds(shape.bounds), type(shape.type), num_lines(0),
+   label(ImportLabel(shape.label))
+{
+  const int min_points = GetMinPointsForShapeType(type);
+  if (min_points < 0)
+    /* not supported, leave an empty XShape object */
+    return;
+
+  if (shape.lines.size() > lines.size())
+    throw std::runtime_error{"Too many lines in shape"};
+
+  for (const auto l : shape.lines) {
+    if (l < min_points)
+      throw std::runtime_error{"Malformed shape"};
+
+    lines[num_lines++] = l;
+  }
+
+  /* the package contains exactly the in-memory representation; use
+     it in place */
+  points = shape.points.data();
+
+#ifdef ENABLE_OPENGL
+  for (unsigned level = 0; level < THINNING_LEVELS; ++level) {
+    const auto block = shape.indices[level];
+    if ((index_levels & (1u << level)) == 0 || block.empty() ||
+        !CheckIndexBlock(type, shape.lines, shape.points.size(), block))
+      /* will be built by GetIndices() */
+      continue;
+
+    index_count[level] = block.data();
+    indices[level] = block.data() +
+      (type == MS_SHAPE_LINE ? num_lines : 1);
+  }
+#endif
+}
+
 XShape::~XShape() noexcept = default;
 
+std::size_t
+XShape::GetMemoryUsage() const noexcept
+{
+  std::size_t num_points = 0;
+  for (const auto l : GetLines())
+    num_points += l;
+
+  std::size_t result = sizeof(*this);
+  if (point_buffer)
+    result += num_points * sizeof(Point);
+  if (label != nullptr)
+    result += (StringLength(label.c_str()) + 1) * sizeof(TCHAR);
+
+#ifdef ENABLE_OPENGL
+  /* the buffer sizes allocated by BuildIndices() (an upper bound,
+     because CompactIndices() may shrink or share them) */
+  std::size_t index_size = 0;
+  if (type == MS_SHAPE_LINE && num_points > 2)
+    index_size = num_lines + num_points;
+  else if (type == MS_SHAPE_POLYGON && num_lines > 0 && num_points > 2)
+    index_size = 1 + 3 * (num_points - 2) + 2 * (num_lines - 1);
+
+  for (unsigned level = 0; level < THINNING_LEVELS; ++level)
+    if (index_buffers[level] || indices[level] == nullptr)
+      result += index_size * sizeof(uint16_t);
+#endif
+
+  return result;
+}
+
 #ifdef ENABLE_OPENGL
 
 inline bool
@@ -152,18 +254,20 @@ XShape::BuildIndices(unsigned thinning_level, ShapeScalar min_distance) noexcept
   uint16_t *idx, *idx_count;
   std::size_t num_points = 0;
 
+  auto &buffer = index_buffers[thinning_level];
+
   for (std::size_t i=0; i < num_lines; i++)
     num_points += lines[i];
 
   if (type == MS_SHAPE_LINE) {
     if (num_points <= 2)
       return false;  // line cannot be simplified, so don't create indices
-    index_count[thinning_level] = std::make_unique<GLushort[]>(num_lines + num_points);
-    idx_count = index_count[thinning_level].get();
+    buffer = std::make_unique<GLushort[]>(num_lines + num_points);
+    index_count[thinning_level] = idx_count = buffer.get();
     indices[thinning_level] = idx = idx_count + num_lines;
 
     const auto end_l = std::next(lines.begin(), num_lines);
-    const ShapePoint *p = points.get();
+    const ShapePoint *p = points;
     unsigned i = 0;
     for (auto l = lines.begin(); l != end_l; ++l) {
       assert(*l >= 2);
@@ -185,20 +289,23 @@ XShape::BuildIndices(unsigned thinning_level, ShapeScalar min_distance) noexcept
       p++; i++;
       *idx_count++ = idx - after_first_idx + 1;
     }
-    // TODO: free memory saved by thinning (use malloc/realloc or some class?)
+
+    CompactIndices(thinning_level, num_lines + num_points);
     return true;
   } else if (type == MS_SHAPE_POLYGON) {
-    index_count[thinning_level] = std::make_unique<GLushort[]>(1 + 3 * (num_points - 2) + 2 * (num_lines - 1));
-    idx_count = index_count[thinning_level].get();
+    const std::size_t buffer_size =
+      1 + 3 * (num_points - 2) + 2 * (num_lines - 1);
+    buffer = std::make_unique<GLushort[]>(buffer_size);
+    index_count[thinning_level] = idx_count = buffer.get();
     indices[thinning_level] = idx = idx_count + 1;
 
     *idx_count = 0;
-    const ShapePoint *pt = points.get();
+    const ShapePoint *pt = points;
     for (std::size_t i=0; i < num_lines; i++) {
       std::size_t count = PolygonToTriangles(pt, lines[i], idx + *idx_count,
                                              min_distance);
       if (i > 0) {
-        const GLushort offset = pt - points.get();
+        const GLushort offset = pt - points;
         const std::size_t max_idx_count = *idx_count + count;
         for (std::size_t j = *idx_count; j < max_idx_count; j++)
           idx[j] += offset;
@@ -207,13 +314,49 @@ XShape::BuildIndices(unsigned thinning_level, ShapeScalar min_distance) noexcept
       pt += lines[i];
     }
     *idx_count = TriangleToStrip(idx, *idx_count, num_points, num_lines);
-    // TODO: free memory saved by thinning (use malloc/realloc or some class?)
+
+    CompactIndices(thinning_level, buffer_size);
     return true;
   } else {
     gcc_unreachable();
   }
 }
 
+void
+XShape::CompactIndices(unsigned thinning_level,
+                       std::size_t buffer_size) noexcept
+{
+  const auto block = GetIndexBlock(thinning_level);
+  const std::size_t n_counts = type == MS_SHAPE_LINE ? num_lines : 1;
+
+  /* with a small minimum distance, thinning often doesn't remove any
+     point, and then neighbouring levels are identical */
+  for (unsigned level = 0; level < THINNING_LEVELS; ++level) {
+    if (level == thinning_level)
+      continue;
+
+    const auto other = GetIndexBlock(level);
+    if (other.data() != nullptr &&
+        std::equal(block.begin(), block.end(), other.begin(), other.end())) {
+      index_count[thinning_level] = index_count[level];
+      indices[thinning_level] = indices[level];
+      index_buffers[thinning_level].reset();
+      return;
+    }
+  }
+
+  if (block.size() == buffer_size)
+    return;
+
+  auto &buffer = index_buffers[thinning_level];
+  auto compact = std::make_unique<uint16_t[]>(block.size());
+  std::copy(block.begin(), block.end(), compact.get());
+  buffer = std::move(compact);
+
+  index_count[thinning_level] = buffer.get();
+  indices[thinning_level] = buffer.get() + n_counts;
+}
+
 XShape::Indices
 XShape::GetIndices(int thinning_level, ShapeScalar min_distance) const noexcept
 {
@@ -223,7 +366,22 @@ XShape::GetIndices(int thinning_level, ShapeScalar min_distance) const noexcept
       return {};
   }
 
-  return {indices[thinning_level], index_count[thinning_level].get()};
+  return {indices[thinning_level], index_count[thinning_level]};
+}
+
+std::span<const uint16_t>
+XShape::GetIndexBlock(unsigned thinning_level) const noexcept
+{
+  const uint16_t *counts = index_count[thinning_level];
+  if (counts == nullptr)
+    return {};
+
+  const std::size_t n_counts = type == MS_SHAPE_LINE ? num_lines : 1;
+  std::size_t n_indices = 0;
+  for (std::size_t i = 0; i < n_counts; ++i)
+    n_indices += counts[i];
+
+  return {counts, n_counts + n_indices};
 }
 
 #endif // ENABLE_OPENGL
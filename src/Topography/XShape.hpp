@@ -7,9 +7,8 @@
 #include "Geo/GeoBounds.hpp"
 #include "shapelib/mapserver.h"
 #include "shapelib/mapshape.h"
-#ifdef ENABLE_OPENGL
+#include "Topography/TopographyPackage.hpp"
 #include "Topography/XShapePoint.hpp"
-#endif
 
 #include <array>
 #include <cstddef>
@@ -43,22 +42,31 @@ class XShape {
    */
   std::array<uint16_t, MAX_LINES> lines;
 
-#ifdef ENABLE_OPENGL
+  /**
+   * The points are stored relative to the center of the
+   * #TopographyFile (see TopographyFile::ToGeoPoint()).  This is what
+   * OpenGL needs for its vertex buffers, and it takes half the memory
+   * of a #GeoPoint, so the non-OpenGL renderer uses it as well.
+   */
   using Point = ShapePoint;
-#else
-  using Point = GeoPoint;
-#endif
+
+  /**
+   * The #points array, unless it points into a #TopographyPackage.
+   */
+  std::unique_ptr<Point[]> point_buffer;
 
   /**
    * All points of all lines.
    */
-  std::unique_ptr<Point[]> points;
+  const Point *points = nullptr;
 
 #ifdef ENABLE_OPENGL
+  static_assert(THINNING_LEVELS == TopographyPackage::MAX_LEVELS);
+
   /**
    * Indices of polygon triangles or lines with reduced number of vertices.
    */
-  std::array<uint16_t *, THINNING_LEVELS> indices{};
+  std::array<const uint16_t *, THINNING_LEVELS> indices{};
 
   /**
    * For polygons this will contain the total number of triangle vertices
@@ -66,23 +74,40 @@ class XShape {
    * For lines there will be an array of size num_lines for each thinning
    * level, which contains the number of points for each line.
    */
-  std::array<std::unique_ptr<uint16_t[]>, THINNING_LEVELS> index_count;
+  std::array<const uint16_t *, THINNING_LEVELS> index_count{};
 
   /**
-   * The start offset in the #GLArrayBuffer (vertex buffer object).
-   * It is managed by #TopographyFileRenderer.
+   * The memory of #index_count and #indices of each level, unless they
+   * point into a #TopographyPackage.
    */
-  mutable unsigned offset;
+  std::array<std::unique_ptr<uint16_t[]>, THINNING_LEVELS> index_buffers;
 #endif
 
+  /**
+   * The label of a #TopographyPackage shape.  Shapefile labels are
+   * managed by TopographyFile, see TopographyFile::GetLabel().
+   */
   BasicAllocatedString<TCHAR> label;
 
 public:
   /**
    * Throws on error.
    */
-  XShape(const shapeObj &shape, const GeoPoint &file_center,
-         const char *label);
+  XShape(const shapeObj &shape, const GeoPoint &file_center);
+
+  /**
+   * Construct from a #TopographyPackage shape.  The points and (on
+   * OpenGL) the precomputed index lists are used in place, so the
+   * package must outlive this object.
+   *
+   * Throws on error.
+   *
+   * @param index_levels a bit mask of thinning levels whose
+   * precomputed index lists may be used (because they were built with
+   * the same minimum point distance)
+   */
+  XShape(const TopographyPackage::Shape &shape, const GeoPoint &file_center,
+         unsigned index_levels);
 
   ~XShape() noexcept;
 
@@ -90,18 +115,20 @@ public:
   XShape &operator=(const XShape &) = delete;
 
 #ifdef ENABLE_OPENGL
-  void SetOffset(unsigned _offset) const noexcept {
-    offset = _offset;
-  }
-
-  unsigned GetOffset() const noexcept {
-    return offset;
-  }
-
 protected:
   bool BuildIndices(unsigned thinning_level,
                     ShapeScalar min_distance) noexcept;
 
+private:
+  /**
+   * Called by BuildIndices() after a level has been built into a
+   * buffer of the specified size: if another level has the same
+   * index list, share that one and free the buffer; or else shrink
+   * the buffer to the size which is really used.
+   */
+  void CompactIndices(unsigned thinning_level,
+                      std::size_t buffer_size) noexcept;
+
 public:
   struct Indices {
     const uint16_t *indices;
@@ -111,6 +138,14 @@ public:
   [[gnu::pure]]
   Indices GetIndices(int thinning_level,
                      ShapeScalar min_distance) const noexcept;
+
+  /**
+   * Returns the index list of the specified level (the counts
+   * followed by the indices) as one array, for TopographyPackageWriter,
+   * or an empty span if it has not been built.
+   */
+  [[gnu::pure]]
+  std::span<const uint16_t> GetIndexBlock(unsigned thinning_level) const noexcept;
 #endif
 
   const GeoBounds &get_bounds() const noexcept {
@@ -126,10 +161,27 @@ public:
   }
 
   const Point *GetPoints() const noexcept {
-    return points.get();
+    return points;
   }
 
   const TCHAR *GetLabel() const noexcept {
     return label.c_str();
   }
+
+  /**
+   * Estimate the memory occupied by this object, including the point
+   * and index lists it owns.  On OpenGL, the index lists which
+   * GetIndices() has not built yet are included, so the result does
+   * not grow while the shape is being rendered.
+   */
+  [[gnu::pure]]
+  std::size_t GetMemoryUsage() const noexcept;
+
+  /**
+   * Convert a label string from the file, and filter out the ones
+   * which shall not be displayed.
+   *
+   * @return the label or nullptr
+   */
+  static BasicAllocatedString<TCHAR> ImportLabel(const char *src) noexcept;
 };
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Delta.hpp"
+#include "TrafficTable.hpp"
+#include "RadarParser.hpp"
+
+#include <algorithm>
+
+#include <string.h>
+
+namespace JETProvider {
+
+[[gnu::pure]]
+static std::size_t
+StringSize(const char *s) noexcept
+{
+  return s != nullptr ? strlen(s) + 1 : 0;
+}
+
+[[gnu::pure]]
+static std::size_t
+StringsSize(const Traffic &traffic) noexcept
+{
+  return StringSize(traffic.traffic_id) + StringSize(traffic.display) +
+    StringSize(traffic.code) + StringSize(traffic.type);
+}
+
+static const char *
+CopyString(char *&p, const char *s) noexcept
+{
+  if (s == nullptr)
+    return nullptr;
+
+  const char *result = p;
+  p = std::copy_n(s, strlen(s) + 1, p);
+  return result;
+}
+
+static void
+CopyStrings(char *&p, Traffic &traffic) noexcept
+{
+  traffic.traffic_id = CopyString(p, traffic.traffic_id);
+  traffic.display = CopyString(p, traffic.display);
+  traffic.code = CopyString(p, traffic.code);
+  traffic.type = CopyString(p, traffic.type);
+}
+
+void
+ApplyDelta(const TrafficTable &previous,
+           const RadarParser::Radar &delta,
+           std::vector<Traffic> &traffics, StringPool &strings) noexcept
+{
+  /* mark the previous traffics which are removed or replaced by the
+     delta */
+  std::vector<bool> skip(previous.size(), false);
+
+  const auto Mark = [&previous, &skip](const char *id){
+    if (const Traffic *t = previous.Find(id))
+      skip[t - &*previous.begin()] = true;
+  };
+
+  for (const char *id : delta.removed)
+    Mark(id);
+
+  for (const auto &traffic : delta.traffics)
+    Mark(traffic.traffic_id);
+
+  /* collect the remaining traffics and allocate one pool for all
+     strings */
+  std::size_t size = 0;
+  std::size_t i = 0;
+  for (const auto &traffic : previous)
+    if (!skip[i++])
+      size += StringsSize(traffic);
+
+  for (const auto &traffic : delta.traffics)
+    size += StringsSize(traffic);
+
+  strings.ResizeDiscard(std::max<std::size_t>(size, 1));
+  char *p = strings.data();
+
+  traffics.clear();
+  traffics.reserve(previous.size() + delta.traffics.size());
+
+  i = 0;
+  for (Traffic traffic : previous) {
+    if (skip[i++])
+      continue;
+
+    CopyStrings(p, traffic);
+    traffics.push_back(traffic);
+  }
+
+  for (Traffic traffic : delta.traffics) {
+    CopyStrings(p, traffic);
+    traffics.push_back(traffic);
+  }
+}
+
+} // namespace JETProvider
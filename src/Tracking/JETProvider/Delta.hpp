@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Traffic.hpp"
+
+#include <vector>
+
+namespace RadarParser { struct Radar; }
+
+namespace JETProvider {
+
+class TrafficTable;
+
+/**
+ * Apply a delta response on the given table and collect the
+ * resulting traffics.  All strings are copied to one new pool, so
+ * the previous table and the delta may be freed afterwards.
+ *
+ * @param previous the current snapshot; it is not modified
+ * @param delta a delta response (RadarParser::Radar::IsDelta())
+ * @param traffics the new snapshot (output)
+ * @param strings the pool which will own the strings referenced by
+ * the new snapshot (output)
+ */
+void
+ApplyDelta(const TrafficTable &previous,
+           const RadarParser::Radar &delta,
+           std::vector<Traffic> &traffics, StringPool &strings) noexcept;
+
+} // namespace JETProvider
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Extrapolate.hpp"
+#include "Traffic.hpp"
+#include "Geo/Math.hpp"
+
+#include <algorithm>
+
+namespace JETProvider {
+
+std::optional<ExtrapolatedTraffic>
+Extrapolate(const Traffic &traffic,
+            std::chrono::system_clock::time_point now,
+            std::chrono::duration<double> stale_after,
+            std::chrono::duration<double> expire_after) noexcept
+{
+  ExtrapolatedTraffic result{
+    traffic.location,
+    double(traffic.altitude),
+    std::chrono::duration<double>::zero(),
+    false,
+  };
+
+  if (traffic.epoch == 0)
+    /* no time stamp: show it as it is */
+    return result;
+
+  const auto report = std::chrono::system_clock::time_point{
+    std::chrono::seconds{traffic.epoch}};
+
+  /* a report from the future (clock skew between server and
+     device) is treated as current */
+  result.age = std::max(std::chrono::duration<double>{now - report},
+                        std::chrono::duration<double>::zero());
+  if (result.age >= expire_after)
+    return std::nullopt;
+
+  result.stale = result.age >= stale_after;
+
+  const double dt = std::min(result.age, stale_after).count();
+
+  if (traffic.speed > 0 && traffic.track >= 0)
+    result.location = FindLatitudeLongitude(traffic.location,
+                                            Angle::Degrees(traffic.track),
+                                            traffic.speed * dt);
+
+  if (traffic.altitude >= 0)
+    result.altitude = std::max(result.altitude + traffic.vspeed * dt, 0.);
+
+  return result;
+}
+
+} // namespace JETProvider
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoPoint.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+namespace JETProvider {
+
+struct Traffic;
+
+/**
+ * The state of a #Traffic projected to the render time.
+ */
+struct ExtrapolatedTraffic {
+  GeoPoint location;
+
+  /**
+   * The altitude [m]; negative if unknown.
+   */
+  double altitude;
+
+  /**
+   * The age of the last report.
+   */
+  std::chrono::duration<double> age;
+
+  /**
+   * Is the last report older than the staleness threshold?  Such a
+   * traffic is not extrapolated any further, and should be drawn
+   * faded.
+   */
+  bool stale;
+};
+
+/**
+ * The age after which a traffic is considered stale, i.e. it has
+ * missed a few polls of the given interval.
+ */
+constexpr std::chrono::duration<double>
+GetStaleAfter(std::chrono::duration<double> interval) noexcept
+{
+  return std::max<std::chrono::duration<double>>(3 * interval,
+                                                 std::chrono::seconds{30});
+}
+
+/**
+ * The age after which a stale traffic is not displayed anymore.
+ */
+constexpr std::chrono::duration<double>
+GetExpireAfter(std::chrono::duration<double> stale_after) noexcept
+{
+  return 3 * stale_after;
+}
+
+/**
+ * Dead-reckon the traffic's last report (#Traffic::epoch) to the
+ * given time, using its track, ground speed and vertical speed.
+ *
+ * @param now the current (UTC) time
+ * @param stale_after the age after which the traffic is considered
+ * stale; the position is not extrapolated beyond this age
+ * @param expire_after the age after which the traffic shall not be
+ * displayed anymore
+ * @return nullopt if the traffic has expired
+ */
+[[gnu::pure]]
+std::optional<ExtrapolatedTraffic>
+Extrapolate(const Traffic &traffic,
+            std::chrono::system_clock::time_point now,
+            std::chrono::duration<double> stale_after,
+            std::chrono::duration<double> expire_after) noexcept;
+
+} // namespace JETProvider
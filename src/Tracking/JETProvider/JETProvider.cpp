@@ -26,6 +26,7 @@ Copyright_License {
 #include "lib/curl/Easy.hxx"
 #include "lib/curl/Setup.hxx"
 #include "lib/curl/CoRequest.hxx"
+#include "lib/curl/Slist.hxx"
 #include "co/Task.hxx"
 #include "co/InjectTask.hxx"
 #include "RadarParser.hpp"
@@ -34,22 +35,72 @@ Copyright_License {
 #include "UIGlobals.hpp"
 #include "Interface.hpp"
 #include "LogFile.hpp"
+#include "util/StaticString.hxx"
+
+#include <stdexcept>
 
 // #define API_ENTPOINT_URL "http://192.168.42.113:3000/api/1/radar"
 #define API_ENTPOINT_URL "http://xcsoar.imjim.im/api/1/radar"
 
 class EventLoop;
 
+/**
+ * @param etag the "ETag" of the previous response, to be sent as
+ * "If-None-Match"; may be empty
+ */
 static Co::Task<Curl::CoResponse>
-CoGet(CurlGlobal &curl, const char *url)
+CoGet(CurlGlobal &curl, const char *url, const std::string &etag)
 {
   CurlEasy easy{url};
   Curl::Setup(easy);
   easy.SetFailOnError();
 
+  /* let libcurl negotiate and transparently decode all compression
+     formats it was built with (gzip, deflate, brotli, zstd) */
+  easy.SetOption(CURLOPT_ACCEPT_ENCODING, "");
+
+  /* connections are cached by the shared CurlMulti and reused for
+     the next poll; HTTP/2 (where the server offers it over TLS) and
+     TCP keepalive help keeping that connection open between polls */
+  easy.SetOption(CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+  easy.SetOption(CURLOPT_TCP_KEEPALIVE, 1L);
+
+  CurlSlist request_headers;
+  request_headers.Append("Accept: application/x-jet-radar, text/plain;q=0.5");
+  if (!etag.empty()) {
+    const std::string header = "If-None-Match: " + etag;
+    request_headers.Append(header.c_str());
+  }
+  easy.SetRequestHeaders(request_headers.Get());
+
   co_return co_await Curl::CoRequest(curl, std::move(easy));
 }
 
+/**
+ * Parse the response body according to its "Content-Type".
+ */
+static bool
+ParseRadarResponse(const NMEAInfo &basic, const Curl::CoResponse &response,
+                   RadarParser::Radar &radar) noexcept
+{
+  if (auto i = response.headers.find("content-type");
+      i != response.headers.end() &&
+      i->second.starts_with(RadarParser::BINARY_CONTENT_TYPE))
+    return RadarParser::ParseRadarBinary(basic,
+                                         std::as_bytes(std::span{response.body}),
+                                         radar);
+
+  return RadarParser::ParseRadarBuffer(basic, response.body, radar);
+}
+
+[[gnu::pure]]
+static bool
+SameBounds(const GeoBounds &a, const GeoBounds &b) noexcept
+{
+  return a.GetNorthWest() == b.GetNorthWest() &&
+    a.GetSouthEast() == b.GetSouthEast();
+}
+
 JETProvider::Glue::Glue(CurlGlobal &_curl, Handler *_handler)
   :curl(_curl),
    handler(_handler),
@@ -64,51 +115,101 @@ JETProvider::Glue::OnTimer(const NMEAInfo &basic, __attribute__((unused)) const
     return;
   }
 
-  if (!clock.CheckUpdate(std::chrono::seconds(settings.radar.interval)))
+  if (inject_task)
     return;
 
-  if (inject_task)
+  const GlueMapWindow *map = UIGlobals::GetMap();
+  if (map == nullptr)
+    return;
+
+  const MapWindowProjection &projection = map->VisibleProjection();
+  if (!projection.IsValid())
+    return;
+
+  scheduler.SetNominalInterval(settings.radar.interval);
+  const auto request_bounds =
+    scheduler.Check(projection.GetScreenBounds(),
+                    Scheduler::Clock::now());
+  if (!request_bounds)
     return;
 
-  inject_task.Start(CoTick(basic), BIND_THIS_METHOD(OnCompletion));
+  inject_task.Start(CoTick(basic, *request_bounds),
+                    BIND_THIS_METHOD(OnCompletion));
 }
 
 Co::InvokeTask
-JETProvider::Glue::CoTick(const NMEAInfo &basic) noexcept
+JETProvider::Glue::CoTick(const NMEAInfo &basic,
+                          GeoBounds request_bounds) noexcept
 {
-  const GlueMapWindow *map = UIGlobals::GetMap();
-  if (map == nullptr)
-    co_return;
-  MapWindowProjection projection = map->VisibleProjection();
-  if (!projection.IsValid()) {
-    co_return;
+  if (!SameBounds(request_bounds, bounds)) {
+    /* the server can only send a delta for the same area */
+    bounds = request_bounds;
+    ResetSequence();
   }
-  GeoBounds screen_bounds = projection.GetScreenBounds();
 
-  char url[256];
-  StringFormat(url, 256, "%s?access_token=%s&bounds=%f,%f,%f,%f", API_ENTPOINT_URL,
+  StaticString<256> url;
+  url.Format("%s?access_token=%s&bounds=%f,%f,%f,%f", API_ENTPOINT_URL,
     access_token,
-    screen_bounds.GetNorth().Degrees(),
-    screen_bounds.GetSouth().Degrees(),
-    screen_bounds.GetWest().Degrees(),
-    screen_bounds.GetEast().Degrees()
+    request_bounds.GetNorth().Degrees(),
+    request_bounds.GetSouth().Degrees(),
+    request_bounds.GetWest().Degrees(),
+    request_bounds.GetEast().Degrees()
     );
+  if (sequence != 0)
+    url.AppendFormat("&since=%u", (unsigned)sequence);
+
+  const auto start_time = Scheduler::Clock::now();
+  auto response = co_await CoGet(curl, url, etag);
+  scheduler.OnSuccess(Scheduler::Clock::now() - start_time);
+
+  if (response.status == 304 || response.body.empty()) {
+    /* fast path: nothing has changed */
+    handler->OnJETTrafficUnchanged();
+    co_return;
+  }
 
-  auto response = co_await CoGet(curl, url);
-  
   RadarParser::Radar radar;
-  if (!RadarParser::ParseRadarBuffer(basic, response.body.c_str(), radar) || !radar.validity.IsValid()) {
-    handler->OnJETTraffic(std::vector<JETProvider::Data::Traffic>(), false);
-  } else {
-    handler->OnJETTraffic(radar.traffics, true);
+  if (!ParseRadarResponse(basic, response, radar) || !radar.validity.IsValid()) {
+    ResetSequence();
+    handler->OnJETProviderError(std::make_exception_ptr(std::runtime_error("Malformed radar response")));
+    co_return;
+  }
+
+  if (radar.IsDelta() &&
+      (radar.base_sequence != sequence || table == nullptr)) {
+    /* the sequence is broken (e.g. the server has been restarted or
+       has dropped our state); discard the delta and fetch a full
+       snapshot as soon as possible */
+    LogFormat("JETProvider: delta %u does not apply on %u",
+              (unsigned)radar.base_sequence, (unsigned)sequence);
+    ResetSequence();
+    scheduler.Expedite();
+    co_return;
   }
+
+  sequence = radar.sequence;
+  if (auto i = response.headers.find("etag"); i != response.headers.end())
+    etag = i->second;
+  else
+    etag.clear();
+
+  /* build the new table here, before the handler locks anything */
+  if (radar.IsDelta())
+    table = std::make_shared<const TrafficTable>(*table, radar);
+  else
+    table = std::make_shared<const TrafficTable>(std::move(radar));
+
+  scheduler.UpdateTraffic(*table, basic);
+
+  handler->OnJETTraffic(table);
 }
 
 void
 JETProvider::Glue::OnCompletion(std::exception_ptr error) noexcept
 {
   if (error) {
-    LogError(error, "JETProvider error");
-    handler->OnJETTraffic(std::vector<JETProvider::Data::Traffic>(), false);
+    ResetSequence();
+    scheduler.OnFailure();
+    handler->OnJETProviderError(error);
   }
 }
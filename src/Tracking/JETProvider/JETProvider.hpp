@@ -26,13 +26,17 @@ Copyright_License {
 
 #include "NMEA/Info.hpp"
 #include "NMEA/Derived.hpp"
-#include "time/PeriodClock.hpp"
 #include "Language/Language.hpp"
 #include "thread/Mutex.hxx"
-#include "lib/curl/Request.hxx"
 #include "co/InjectTask.hxx"
+#include "Geo/GeoBounds.hpp"
+#include "TrafficTable.hpp"
+#include "Scheduler.hpp"
 
-#include <map>
+#include <memory>
+#include <string>
+
+class CurlGlobal;
 
 /**
  * API JET XCSOAR provider
@@ -43,43 +47,48 @@ namespace JETProvider
 struct Data {
   mutable Mutex mutex;
 
-  struct Traffic {
-    const char *traffic_id = nullptr;
-    const char *display = nullptr;
-    const char *code = nullptr;
-    uint32_t epoch = 0;
-    GeoPoint location;
-    int track = -1;
-    int altitude = -1;
-    double speed = -1;
-    double vspeed = -1;
-    const char *type = nullptr;
-
-    Traffic() = default;
-    Traffic(const char *_traffic_id, const char *_display,
-      const char *_code, uint32_t _epoch, GeoPoint _location,
-      int _track, int _altitude, int _speed, int _vspeed,
-      const char *_type)
-    :traffic_id(_traffic_id), display(_display),
-      code(_code), epoch(_epoch), location(_location),
-      track(_track), altitude(_altitude),
-      speed(_speed), vspeed(_vspeed), type(_type) {}
-  };
+  /**
+   * The current traffic table; nullptr if none has been received
+   * yet.  Protected by #mutex, but only for replacing the pointer;
+   * a reader which has obtained a reference may iterate the table
+   * without holding the mutex.
+   */
+  std::shared_ptr<const TrafficTable> table;
+
+  /**
+   * Was the last request successful?  Protected by #mutex.
+   */
+  bool success = false;
 
-  struct cmp_str {
-    bool operator()(char const *a, char const *b) const {
-      return std::strcmp(a, b) < 0;
-    }
+  struct Snapshot {
+    std::shared_ptr<const TrafficTable> table;
+    bool success;
   };
 
-  std::map<const char*, Traffic, cmp_str> traffics;
-  bool success = false;
-
+  /**
+   * Obtain the current table.  The mutex is only locked while the
+   * pointer is copied.
+   */
+  Snapshot GetSnapshot() const noexcept {
+    const std::lock_guard<Mutex> lock(mutex);
+    return {table, success};
+  }
 };
 
 class Handler {
 public:
-  virtual void OnJETTraffic(std::vector<JETProvider::Data::Traffic> traffics, bool success) = 0;
+  /**
+   * A new traffic table has been built from a radar response.  The
+   * handler shall publish it.
+   */
+  virtual void OnJETTraffic(std::shared_ptr<const TrafficTable> table) = 0;
+
+  /**
+   * The server has reported that nothing has changed since the
+   * previous response.
+   */
+  virtual void OnJETTrafficUnchanged() = 0;
+
   virtual void OnJETProviderError(std::exception_ptr e) = 0;
 };
 
@@ -89,20 +98,56 @@ class Glue final
 CurlGlobal &curl;
 Handler *const handler;
 Co::InjectTask inject_task;
-PeriodClock clock;
+Scheduler scheduler;
 
 const char *access_token;
 
+/**
+ * The sequence number of the snapshot we have received last (full
+ * or delta), or 0 if there is none.  It is sent to the server to
+ * request a delta instead of a full snapshot.
+ */
+uint32_t sequence = 0;
+
+/**
+ * The "ETag" response header of the last response.  Sent back as
+ * "If-None-Match", which allows the server to reply "304 Not
+ * Modified".
+ */
+std::string etag;
+
+/**
+ * The bounds of the last request (as chosen by the #scheduler).  A
+ * delta is only meaningful if the bounds did not change.
+ */
+GeoBounds bounds = GeoBounds::Invalid();
+
+/**
+ * The table which was built from the last response.  Deltas are
+ * applied on it.
+ */
+std::shared_ptr<const TrafficTable> table;
+
 public:
   Glue(CurlGlobal &curl, Handler *_handler);
 
   void OnTimer(const NMEAInfo &basic, const DerivedInfo &calculated);
 
 protected:
-  Co::InvokeTask CoTick(const NMEAInfo &basic) noexcept;
+  Co::InvokeTask CoTick(const NMEAInfo &basic,
+                        GeoBounds request_bounds) noexcept;
 
   void OnCompletion(std::exception_ptr error) noexcept;
 
+  /**
+   * Forget the state of the last response; the next request will
+   * fetch a full snapshot.
+   */
+  void ResetSequence() noexcept {
+    sequence = 0;
+    etag.clear();
+  }
+
 };
 
 }
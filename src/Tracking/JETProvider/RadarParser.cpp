@@ -22,93 +22,337 @@ Copyright_License {
 */
 
 #include "RadarParser.hpp"
-#include "Interface.hpp"
-#include "Units/Units.hpp"
+#include "Units/System.hpp"
+#include "util/NumberParser.hpp"
 #include "LogFile.hpp"
+#include "util/ByteOrder.hxx"
 
-#include <boost/algorithm/string.hpp>
-#include <sstream>
-#include <string>
-#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+#include <math.h>
+#include <string.h>
 
 namespace RadarParser {
 
-bool ParseHeader(std::string, Radar &radar);
-bool ParseTraffic(std::string line, Radar &radar);
-const char *to_c_str(std::string str);
+/**
+ * Cut the next comma-separated column off the given (writable) line
+ * and null-terminate it in place.
+ *
+ * @param p the start of the remaining line; updated to point to the
+ * next column, or nullptr after the last column has been returned
+ * @return the column, or nullptr if there are no more columns
+ */
+static char *
+NextColumn(char *&p) noexcept
+{
+  char *column = p;
+  if (column == nullptr)
+    return nullptr;
 
-bool ParseRadarBuffer(const NMEAInfo &basic, const char *buffer, Radar &radar) {
-  std::istringstream istr{buffer};
+  char *comma = strchr(column, ',');
+  if (comma != nullptr) {
+    *comma = '\0';
+    p = comma + 1;
+  } else
+    p = nullptr;
 
-  std::string line;
-  std::getline(istr, line);
+  return column;
+}
 
-  if (!ParseHeader(line, radar)) {
+/**
+ * Split the line into exactly #N columns.
+ *
+ * @return false if the line has more or fewer columns
+ */
+template<std::size_t N>
+static bool
+SplitColumns(char *line, char *(&columns)[N]) noexcept
+{
+  for (auto &i : columns)
+    if ((i = NextColumn(line)) == nullptr)
       return false;
-  }
 
-  while(std::getline(istr, line)) {
-      if (line.size() == 0) continue;
-      if (line[0] == '#') continue;
-      if (!ParseTraffic(line, radar)) {
-          return false;
-      }
+  return line == nullptr;
+}
+
+static bool
+ParseHeader(char *line, Radar &radar) noexcept
+{
+  char *columns[4];
+  std::size_t n = 0;
+  while (n < std::size(columns) &&
+         (columns[n] = NextColumn(line)) != nullptr)
+    ++n;
+
+  if (line != nullptr || (n != 2 && n != 4))
+    return false;
+
+  radar.count = ParseUnsigned(columns[0]);
+  radar.total_count = ParseUnsigned(columns[1]);
+
+  if (n == 4) {
+    radar.sequence = ParseUnsigned(columns[2]);
+    radar.base_sequence = ParseUnsigned(columns[3]);
+  } else
+    radar.sequence = radar.base_sequence = 0;
+
+  return true;
+}
+
+static bool
+ParseTraffic(char *line, Radar &radar) noexcept
+{
+  // a1,deadbeef,code,50.869501,0.010864,42,1500,300,2,1615771825,744
+  // uid,name,code,lat,long,track,alt,spd,vspd,epoch,type
+
+  char *columns[11];
+  if (!SplitColumns(line, columns)) {
+    LogFormat("RadarParser received invalid line");
+    return false;
   }
 
-  radar.validity.Update(basic.clock);
+  JETProvider::Traffic traffic;
+  traffic.traffic_id = columns[0];
+  traffic.display = columns[1];
+  traffic.code = columns[2];
+  const double latitude = ParseDouble(columns[3]);
+  const double longitude = ParseDouble(columns[4]);
+  traffic.location = GeoPoint(Angle::Degrees(longitude),
+                              Angle::Degrees(latitude));
+  traffic.track = ParseInt(columns[5]);
+  traffic.altitude = lround(Units::ToSysUnit(ParseInt(columns[6]),
+                                             Unit::FEET));
+  traffic.speed = Units::ToSysUnit(ParseDouble(columns[7]), Unit::KNOTS);
+  traffic.vspeed = Units::ToSysUnit(ParseDouble(columns[8]),
+                                    Unit::FEET_PER_MINUTE);
+  traffic.epoch = ParseUnsigned(columns[9]);
+  traffic.type = columns[10];
+
+  radar.traffics.push_back(traffic);
   return true;
 }
 
-bool ParseHeader(std::string line, Radar &radar) {
-    std::vector<std::string> items;
-    boost::split(items, line, boost::is_any_of(","));
-    if (items.size() != 2) {
+/**
+ * Cut the next line off the (writable) buffer and null-terminate it
+ * in place.  A trailing carriage return is removed.
+ *
+ * @return the line, or nullptr at the end of the buffer
+ */
+static char *
+NextLine(char *&p, char *end) noexcept
+{
+  if (p >= end)
+    return nullptr;
+
+  char *line = p;
+  char *newline = std::find(line, end, '\n');
+  p = newline < end ? newline + 1 : end;
+
+  if (newline > line && newline[-1] == '\r')
+    --newline;
+  *newline = '\0';
+  return line;
+}
+
+bool
+ParseRadarBuffer(const NMEAInfo &basic, std::string_view buffer,
+                 Radar &radar) noexcept
+{
+  /* copy the whole response into one block which will own all
+     strings referenced by the parsed traffics; the columns are
+     null-terminated in place, which saves one allocation per
+     string */
+  radar.validity.Clear();
+  radar.strings.ResizeDiscard(buffer.size() + 1);
+  char *p = std::copy(buffer.begin(), buffer.end(), radar.strings.data());
+  char *const end = p;
+  *end = '\0';
+  p = radar.strings.data();
+
+  char *line = NextLine(p, end);
+  if (line == nullptr || !ParseHeader(line, radar))
+    return false;
+
+  radar.traffics.clear();
+  /* the count comes from the (untrusted) header; don't let it
+     allocate more than the remaining lines can fill, each having at
+     least the 10 column separators */
+  radar.traffics.reserve(std::min<std::size_t>(radar.count,
+                                               std::size_t(end - p) / 10));
+  radar.removed.clear();
+
+  while ((line = NextLine(p, end)) != nullptr) {
+    if (*line == '\0' || *line == '#')
+      continue;
+
+    if (*line == '-') {
+      if (!radar.IsDelta() || line[1] == '\0')
         return false;
+
+      radar.removed.push_back(line + 1);
+      continue;
     }
-    radar.count = atoi(items[0].c_str());
-    radar.total_count = atoi(items[1].c_str());
 
-    return true;
+    if (!ParseTraffic(line, radar))
+      return false;
+  }
+
+  radar.validity.Update(basic.clock);
+  return true;
 }
 
-bool ParseTraffic(std::string line, Radar &radar) {
-    std::vector<std::string> items;
-    boost::split(items, line, boost::is_any_of(","));
-    if (items.size() != 11) {
-        LogFormat("RadarParser received invalid items.size()=%d", (int) items.size());
+namespace {
+
+struct BinaryHeader {
+  char magic[4];
+  PackedLE16 version;
+  PackedLE16 reserved;
+  PackedLE32 count, total_count;
+  PackedLE32 sequence, base_sequence;
+};
+
+static_assert(sizeof(BinaryHeader) == 24);
+
+struct BinaryTraffic {
+  PackedLE32 latitude, longitude;
+  PackedLE32 altitude;
+  PackedLE32 epoch;
+  PackedLE16 track, speed, vspeed;
+};
+
+static_assert(sizeof(BinaryTraffic) == 22);
+
+/**
+ * Sequential reader for the binary encoding which copies strings
+ * into the Radar::strings block.
+ */
+class BinaryReader {
+  const std::byte *p;
+  const std::byte *const end;
+
+  char *out;
+
+public:
+  BinaryReader(std::span<const std::byte> buffer, char *_out) noexcept
+    :p(buffer.data()), end(p + buffer.size()), out(_out) {}
+
+  bool IsEnd() const noexcept {
+    return p == end;
+  }
+
+  template<typename T>
+  const T *Read() noexcept {
+    if (std::size_t(end - p) < sizeof(T))
+      return nullptr;
+
+    const auto *result = reinterpret_cast<const T *>(p);
+    p += sizeof(T);
+    return result;
+  }
+
+  /**
+   * Copy a length-prefixed string into the output block and
+   * null-terminate it.  The length byte is replaced by the
+   * terminator, therefore the output never grows beyond the input.
+   */
+  const char *ReadString() noexcept {
+    const auto *length = Read<uint8_t>();
+    if (length == nullptr || std::size_t(end - p) < *length)
+      return nullptr;
+
+    const char *result = out;
+    out = std::copy_n(reinterpret_cast<const char *>(p), *length, out);
+    *out++ = '\0';
+    p += *length;
+    return result;
+  }
+};
+
+}
+
+static bool
+ReadBinaryTraffic(BinaryReader &reader, Radar &radar) noexcept
+{
+  const auto *src = reader.Read<BinaryTraffic>();
+  if (src == nullptr)
+    return false;
+
+  JETProvider::Traffic traffic;
+  traffic.location =
+    GeoPoint(Angle::Degrees(int32_t(uint32_t(src->longitude)) / 1e7),
+             Angle::Degrees(int32_t(uint32_t(src->latitude)) / 1e7));
+  traffic.altitude =
+    lround(Units::ToSysUnit(int32_t(uint32_t(src->altitude)), Unit::FEET));
+  traffic.epoch = src->epoch;
+  traffic.track = uint16_t(src->track);
+  traffic.speed = Units::ToSysUnit(uint16_t(src->speed), Unit::KNOTS);
+  traffic.vspeed = Units::ToSysUnit(int16_t(uint16_t(src->vspeed)),
+                                    Unit::FEET_PER_MINUTE);
+
+  if ((traffic.traffic_id = reader.ReadString()) == nullptr ||
+      (traffic.display = reader.ReadString()) == nullptr ||
+      (traffic.code = reader.ReadString()) == nullptr ||
+      (traffic.type = reader.ReadString()) == nullptr)
+    return false;
+
+  radar.traffics.push_back(traffic);
+  return true;
+}
+
+bool
+ParseRadarBinary(const NMEAInfo &basic, std::span<const std::byte> buffer,
+                 Radar &radar) noexcept
+{
+  radar.validity.Clear();
+  radar.strings.ResizeDiscard(buffer.size());
+
+  BinaryReader reader(buffer, radar.strings.data());
+
+  const auto *header = reader.Read<BinaryHeader>();
+  if (header == nullptr || memcmp(header->magic, "JETR", 4) != 0 ||
+      header->version != 1)
+    return false;
+
+  radar.count = header->count;
+  radar.total_count = header->total_count;
+  radar.sequence = header->sequence;
+  radar.base_sequence = header->base_sequence;
+
+  radar.traffics.clear();
+  radar.traffics.reserve(std::min<std::size_t>(radar.count,
+                                               buffer.size() /
+                                               sizeof(BinaryTraffic)));
+  radar.removed.clear();
+
+  while (!reader.IsEnd()) {
+    const auto *type = reader.Read<char>();
+
+    switch (*type) {
+    case 'T':
+      if (!ReadBinaryTraffic(reader, radar))
+        return false;
+      break;
+
+    case 'R':
+      if (!radar.IsDelta())
         return false;
+
+      if (const char *id = reader.ReadString();
+          id != nullptr && *id != '\0')
+        radar.removed.push_back(id);
+      else
+        return false;
+      break;
+
+    default:
+      return false;
     }
-    // a1,deadbeef,50.869501,0.010864,42,1500,300,2,1615771825,744
-    // uid,name,lat,long,track,alt,spd,vspd,epoch,type
-
-    JETProvider::Data::Traffic traffic;
-    traffic.traffic_id = to_c_str(items[0]);
-    traffic.display = to_c_str(items[1]);
-    traffic.code = to_c_str(items[2]);
-    double latitude = atof(items[3].c_str());
-    double longitude = atof(items[4].c_str());
-    traffic.location = GeoPoint(Angle::Degrees(longitude), Angle::Degrees(latitude));
-    traffic.track = atoi(items[5].c_str());
-    traffic.altitude = atoi(items[6].c_str());
-    traffic.speed = atof(items[7].c_str());
-    traffic.vspeed = atof(items[8].c_str());
-    traffic.epoch = atoi(items[9].c_str());
-    traffic.type = to_c_str(items[10]);
-
-    traffic.altitude = round(Units::ToSysUnit(traffic.altitude, Unit::FEET));
-    traffic.speed = Units::ToSysUnit(traffic.speed, Unit::KNOTS);
-    traffic.vspeed = Units::ToSysUnit(traffic.vspeed, Unit::FEET_PER_MINUTE);
-
-    radar.traffics.push_back(traffic);
-
-    return true;
-}
+  }
 
-const char *to_c_str(std::string str) {
-    char *buf = new char[str.size() +1];
-    std::copy(str.begin(), str.end(), buf);
-    buf[str.size()] = '\0';
-    return buf;
+  radar.validity.Update(basic.clock);
+  return true;
 }
 
 }
@@ -24,24 +24,99 @@ Copyright_License {
 #ifndef RADAR_PARSER_HPP
 #define RADAR_PARSER_HPP
 
-#include "JETProvider.hpp"
+#include "Traffic.hpp"
+#include "NMEA/Info.hpp"
 #include "Geo/GeoPoint.hpp"
 #include "NMEA/Validity.hpp"
 
+#include <cstddef>
+#include <span>
+#include <string_view>
 #include <vector>
 
 namespace RadarParser {
 
 struct Radar {
-  unsigned count;
-  unsigned total_count;
+  unsigned count = 0;
+  unsigned total_count = 0;
+
+  /**
+   * The sequence number of this response, to be sent back with the
+   * next request; 0 if the server does not support deltas.
+   */
+  uint32_t sequence = 0;
+
+  /**
+   * If non-zero, then this response is a delta which must be applied
+   * on the snapshot with this sequence number.
+   */
+  uint32_t base_sequence = 0;
 
   Validity validity;
 
-  std::vector<JETProvider::Data::Traffic> traffics;
+  /**
+   * All traffics of a full snapshot; the new and changed traffics of
+   * a delta.
+   */
+  std::vector<JETProvider::Traffic> traffics;
+
+  /**
+   * The ids of traffics which have disappeared (only in a delta).
+   */
+  std::vector<const char *> removed;
+
+  /**
+   * The per-response string pool which owns all strings referenced
+   * by #traffics.  It must be kept alive (and moved) together with
+   * them.
+   */
+  JETProvider::StringPool strings;
+
+  bool IsDelta() const noexcept {
+    return base_sequence != 0;
+  }
 };
 
-bool ParseRadarBuffer(const NMEAInfo &basic, const char *buffer, Radar &radar);
+/**
+ * Parse a radar response.
+ * The first line is the header "count,total_count" of a full
+ * snapshot, optionally followed by ",sequence,base_sequence".  A
+ * non-zero "base_sequence" denotes a delta; in a delta, a line
+ * "-id" removes a traffic, and all other lines add or replace one.
+ *  The buffer is copied once into
+ * Radar::strings, and all strings are referenced from there; no
+ * other allocation is made for each traffic.
+ */
+bool
+ParseRadarBuffer(const NMEAInfo &basic, std::string_view buffer,
+                 Radar &radar) noexcept;
+
+/**
+ * The MIME type of the compact binary radar encoding.
+ */
+static constexpr char BINARY_CONTENT_TYPE[] = "application/x-jet-radar";
+
+/**
+ * Parse a radar response in the compact binary encoding.  All
+ * integers are little-endian.  The response begins with a 24 byte
+ * header: the magic "JETR", a 16 bit version (1), 16 reserved bits,
+ * and the 32 bit fields "count", "total_count", "sequence" and
+ * "base_sequence" (see ParseRadarBuffer()).  Each record begins with
+ * a type byte: 'T' adds or replaces a traffic, 'R' removes one (only
+ * in a delta).  A traffic record consists of the signed 32 bit
+ * latitude and longitude [1e-7 degrees], the signed 32 bit altitude
+ * [ft], the 32 bit epoch, the 16 bit track [degrees], speed [kt] and
+ * signed vertical speed [ft/min], followed by the strings "id",
+ * "display", "code" and "type".  A removal record contains only the
+ * id.  Each string is encoded as one length byte followed by the
+ * characters.
+ *
+ * Like ParseRadarBuffer(), this copies all strings into one
+ * Radar::strings block no larger than the input.
+ */
+bool
+ParseRadarBinary(const NMEAInfo &basic, std::span<const std::byte> buffer,
+                 Radar &radar) noexcept;
 
 }
 
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Scheduler.hpp"
+#include "TrafficTable.hpp"
+#include "NMEA/Info.hpp"
+#include "Geo/GeoVector.hpp"
+
+#include <algorithm>
+
+namespace JETProvider {
+
+/**
+ * Targets farther away than this are not considered for the closure
+ * rate [m].
+ */
+static constexpr double CLOSURE_RANGE = 20000;
+
+/**
+ * Poll faster while a target may be closer than a few hundred metres
+ * within this time [s].
+ */
+static constexpr double URGENT_TIME = 120;
+
+auto
+Scheduler::GetInterval() const noexcept -> Duration
+{
+  auto interval = std::chrono::duration_cast<Duration>(nominal * traffic_factor);
+
+  /* exponential back-off on a failing link */
+  interval *= 1u << std::min(failures, 5u);
+
+  /* a slow link must not be flooded */
+  interval = std::max(interval, 2 * latency);
+
+  return std::clamp(interval, MIN_INTERVAL, MAX_INTERVAL);
+}
+
+std::optional<GeoBounds>
+Scheduler::Check(const GeoBounds &screen, Clock::time_point now) noexcept
+{
+  if (!region.IsValid() || !region.IsInside(screen)) {
+    /* the screen has left the area of the last request */
+    if (last_request && now < *last_request + MIN_INTERVAL)
+      return std::nullopt;
+
+    region = screen.Scale(1 + 2 * PADDING);
+  } else if (last_request && now < *last_request + GetInterval())
+    return std::nullopt;
+
+  last_request = now;
+  return region;
+}
+
+void
+Scheduler::UpdateTraffic(const TrafficTable &table,
+                         const NMEAInfo &basic) noexcept
+{
+  if (table.empty()) {
+    /* nothing around: poll slowly until something appears */
+    traffic_factor = 4;
+    return;
+  }
+
+  if (!basic.location_available) {
+    traffic_factor = 1;
+    return;
+  }
+
+  /* find the shortest time until a target may reach us, from the
+     closure rate along the line of sight */
+
+  const auto [own_sin, own_cos] = basic.track.SinCos();
+  const double own_speed =
+    basic.track_available && basic.ground_speed_available
+    ? basic.ground_speed
+    : 0.;
+
+  double min_time = -1;
+  for (const auto &traffic : table) {
+    const auto vector = basic.location.DistanceBearing(traffic.location);
+    if (vector.distance > CLOSURE_RANGE)
+      continue;
+
+    const auto [los_sin, los_cos] = vector.bearing.SinCos();
+
+    double closure = own_speed * (own_sin * los_sin + own_cos * los_cos);
+    if (traffic.speed > 0 && traffic.track >= 0) {
+      const auto [sin, cos] = Angle::Degrees(traffic.track).SinCos();
+      closure -= traffic.speed * (sin * los_sin + cos * los_cos);
+    }
+
+    if (closure <= 0)
+      continue;
+
+    const double time = vector.distance / closure;
+    if (min_time < 0 || time < min_time)
+      min_time = time;
+  }
+
+  if (min_time >= 0 && min_time < URGENT_TIME)
+    traffic_factor = 0.5;
+  else if (min_time >= 0)
+    traffic_factor = 1;
+  else
+    /* there is traffic, but none is closing in */
+    traffic_factor = 2;
+}
+
+} // namespace JETProvider
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoBounds.hpp"
+
+#include <chrono>
+#include <optional>
+
+struct NMEAInfo;
+
+namespace JETProvider {
+
+class TrafficTable;
+
+/**
+ * Decides when the next radar request is due and which area it
+ * covers.
+ *
+ * The requested area is the screen area padded on all sides.  As
+ * long as the screen stays inside that area, panning and zooming
+ * do not cause a new request, and the server can keep sending
+ * deltas for the same area.
+ *
+ * The polling interval adapts to the situation: it is shortened
+ * when a target is closing in, stretched when there is no traffic
+ * around, and backs off when the link is slow or failing.
+ */
+class Scheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+
+  /**
+   * The requested area extends the screen by this fraction of its
+   * size on each side.
+   */
+  static constexpr double PADDING = 0.25;
+
+  /**
+   * Never send requests more often than this, not even while the
+   * user is panning.
+   */
+  static constexpr Duration MIN_INTERVAL = std::chrono::seconds{1};
+
+  static constexpr Duration MAX_INTERVAL = std::chrono::minutes{2};
+
+private:
+  /**
+   * The configured polling interval; the effective one is derived
+   * from it.
+   */
+  Duration nominal = std::chrono::seconds{5};
+
+  /**
+   * The padded area of the last request.
+   */
+  GeoBounds region = GeoBounds::Invalid();
+
+  std::optional<Clock::time_point> last_request;
+
+  /**
+   * Multiplier for #nominal reflecting the traffic situation.
+   */
+  double traffic_factor = 1;
+
+  /**
+   * The number of consecutive failed requests.
+   */
+  unsigned failures = 0;
+
+  /**
+   * The duration of the last successful request.
+   */
+  Duration latency = Duration::zero();
+
+public:
+  void SetNominalInterval(Duration _nominal) noexcept {
+    nominal = _nominal;
+  }
+
+  /**
+   * Calculate the current effective polling interval.
+   */
+  [[gnu::pure]]
+  Duration GetInterval() const noexcept;
+
+  /**
+   * Check whether a request is due.
+   *
+   * @param screen the area currently visible on the screen
+   * @return the area to be requested, or nullopt if no request is
+   * due yet
+   */
+  std::optional<GeoBounds> Check(const GeoBounds &screen,
+                                 Clock::time_point now) noexcept;
+
+  /**
+   * Make the next Check() call return the area without waiting for
+   * the interval, e.g. after the delta sequence has been broken.
+   */
+  void Expedite() noexcept {
+    last_request.reset();
+  }
+
+  /**
+   * A request has completed successfully.
+   *
+   * @param duration the time it took
+   */
+  void OnSuccess(Duration duration) noexcept {
+    failures = 0;
+    latency = duration;
+  }
+
+  void OnFailure() noexcept {
+    ++failures;
+  }
+
+  /**
+   * Adapt the interval to the received traffic.
+   */
+  void UpdateTraffic(const TrafficTable &table,
+                     const NMEAInfo &basic) noexcept;
+};
+
+} // namespace JETProvider
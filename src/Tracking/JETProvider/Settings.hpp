@@ -43,8 +43,42 @@ struct JETProviderSettings {
 
   Radar radar;
 
+  /**
+   * Proximity alerting for the radar traffic.
+   */
+  struct Proximity {
+    bool enabled;
+
+    /**
+     * The horizontal search radius [m].
+     */
+    double range;
+
+    /**
+     * The vertical search band above and below the aircraft [m].
+     */
+    double height;
+
+    /**
+     * Half the opening angle of the closure cone [degrees]: an
+     * intruder is only reported if its velocity relative to us points
+     * at us within this angle.
+     */
+    unsigned cone;
+
+    void SetDefaults() {
+      enabled = true;
+      range = 5000;
+      height = 300;
+      cone = 30;
+    }
+  };
+
+  Proximity proximity;
+
   void SetDefaults() {
     radar.SetDefaults();
+    proximity.SetDefaults();
   }
 };
 
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoPoint.hpp"
+#include "util/AllocatedArray.hxx"
+
+#include <cstdint>
+
+namespace JETProvider {
+
+/**
+ * A buffer which owns the characters of all strings of one radar
+ * response.  Each #Traffic points into it.
+ */
+using StringPool = AllocatedArray<char>;
+
+struct Traffic {
+  const char *traffic_id = nullptr;
+  const char *display = nullptr;
+  const char *code = nullptr;
+  uint32_t epoch = 0;
+  GeoPoint location;
+  int track = -1;
+  int altitude = -1;
+  double speed = -1;
+  double vspeed = -1;
+  const char *type = nullptr;
+
+  Traffic() = default;
+  Traffic(const char *_traffic_id, const char *_display,
+    const char *_code, uint32_t _epoch, GeoPoint _location,
+    int _track, int _altitude, int _speed, int _vspeed,
+    const char *_type)
+  :traffic_id(_traffic_id), display(_display),
+    code(_code), epoch(_epoch), location(_location),
+    track(_track), altitude(_altitude),
+    speed(_speed), vspeed(_vspeed), type(_type) {}
+};
+
+} // namespace JETProvider
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TrafficTable.hpp"
+#include "Delta.hpp"
+#include "RadarParser.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace JETProvider {
+
+/**
+ * The FNV-1a hash function.
+ */
+[[gnu::pure]]
+static std::size_t
+Hash(std::string_view s) noexcept
+{
+  uint32_t hash = 2166136261u;
+  for (const char ch : s) {
+    hash ^= (unsigned char)ch;
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+void
+TrafficTable::ResizeIndex(std::size_t n) noexcept
+{
+  index.assign(std::bit_ceil(std::max<std::size_t>(n * 2, 16)), 0);
+}
+
+std::size_t
+TrafficTable::FindSlot(std::string_view id) const noexcept
+{
+  const std::size_t mask = index.size() - 1;
+
+  /* linear probing; the index is never full, so this terminates */
+  for (std::size_t slot = Hash(id) & mask;; slot = (slot + 1) & mask) {
+    const uint32_t i = index[slot];
+    if (i == 0 || id == traffics[i - 1].traffic_id)
+      return slot;
+  }
+}
+
+void
+TrafficTable::Insert(const Traffic &traffic) noexcept
+{
+  uint32_t &i = index[FindSlot(traffic.traffic_id)];
+  if (i != 0) {
+    traffics[i - 1] = traffic;
+  } else {
+    traffics.push_back(traffic);
+    i = traffics.size();
+  }
+}
+
+const Traffic *
+TrafficTable::Find(std::string_view id) const noexcept
+{
+  if (index.empty())
+    return nullptr;
+
+  const uint32_t i = index[FindSlot(id)];
+  return i != 0 ? &traffics[i - 1] : nullptr;
+}
+
+TrafficTable::TrafficTable(RadarParser::Radar &&radar) noexcept
+  :strings(std::move(radar.strings))
+{
+  traffics.reserve(radar.traffics.size());
+  ResizeIndex(radar.traffics.size());
+
+  for (const auto &traffic : radar.traffics)
+    Insert(traffic);
+}
+
+TrafficTable::TrafficTable(const TrafficTable &previous,
+                           const RadarParser::Radar &delta) noexcept
+{
+  std::vector<Traffic> merged;
+  ApplyDelta(previous, delta, merged, strings);
+
+  traffics.reserve(merged.size());
+  ResizeIndex(merged.size());
+
+  for (const auto &traffic : merged)
+    Insert(traffic);
+}
+
+} // namespace JETProvider
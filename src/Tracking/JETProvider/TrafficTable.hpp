@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Traffic.hpp"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace RadarParser { struct Radar; }
+
+namespace JETProvider {
+
+/**
+ * An immutable table of radar traffics.  The traffics are stored
+ * contiguously, and an open-addressing hash index allows looking
+ * them up by id.  The table owns all strings referenced by its
+ * traffics.
+ *
+ * A new table is built by the network code for each radar response
+ * without holding a lock, and is then published by swapping a
+ * pointer; readers keep the old one alive while they iterate it.
+ */
+class TrafficTable {
+  std::vector<Traffic> traffics;
+
+  /**
+   * The hash index.  Each slot contains the position in #traffics
+   * plus one, or 0 if the slot is empty.  Its size is a power of two
+   * and at least twice the number of traffics.
+   */
+  std::vector<uint32_t> index;
+
+  StringPool strings;
+
+public:
+  /**
+   * Build a table from a full snapshot.  Takes over its traffics and
+   * its string pool.  If an id occurs more than once, the last one
+   * wins.
+   */
+  explicit TrafficTable(RadarParser::Radar &&radar) noexcept;
+
+  /**
+   * Build a table by applying a delta response
+   * (RadarParser::Radar::IsDelta()) on the previous table.  All
+   * strings are copied into one new pool, so neither the previous
+   * table nor the delta needs to be kept.
+   */
+  TrafficTable(const TrafficTable &previous,
+               const RadarParser::Radar &delta) noexcept;
+
+  TrafficTable(const TrafficTable &) = delete;
+  TrafficTable &operator=(const TrafficTable &) = delete;
+
+  bool empty() const noexcept {
+    return traffics.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return traffics.size();
+  }
+
+  auto begin() const noexcept {
+    return traffics.begin();
+  }
+
+  auto end() const noexcept {
+    return traffics.end();
+  }
+
+  /**
+   * Look up a traffic by its id.
+   *
+   * @return the traffic or nullptr if there is no such traffic
+   */
+  [[gnu::pure]]
+  const Traffic *Find(std::string_view id) const noexcept;
+
+private:
+  /**
+   * Clear the index and size it for the given number of traffics.
+   */
+  void ResizeIndex(std::size_t n) noexcept;
+
+  /**
+   * Find the index slot for the given id: either the one which
+   * refers to it, or the empty slot where it shall be inserted.
+   */
+  [[gnu::pure]]
+  std::size_t FindSlot(std::string_view id) const noexcept;
+
+  /**
+   * Append a traffic or replace the one with the same id.  The
+   * index must have been sized for it.
+   */
+  void Insert(const Traffic &traffic) noexcept;
+};
+
+} // namespace JETProvider
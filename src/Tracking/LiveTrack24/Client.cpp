@@ -150,6 +150,10 @@ Client::SendRequest(CurlEasy easy)
   Curl::Setup(easy);
   easy.SetFailOnError();
 
+  /* libcurl reuses the connection for the following requests; keep
+     it alive during coverage gaps */
+  easy.SetOption(CURLOPT_TCP_KEEPALIVE, 1L);
+
   const auto _response = co_await Curl::CoRequest(curl, std::move(easy));
   std::string_view response{_response.body};
   if (response.starts_with("OK"sv))
@@ -11,6 +11,9 @@
 #include "lib/curl/Global.hxx"
 #include "util/Macros.hpp"
 
+#include <algorithm>
+#include <utility>
+
 namespace LiveTrack24 {
 
 static VehicleType
@@ -77,98 +80,163 @@ Glue::OnTimer(const MoreData &basic, const DerivedInfo &calculated)
     /* later */
     return;
 
+  const bool last_flying = flying;
+  flying = calculated.flight.flying;
+
+  {
+    const std::lock_guard lock{mutex};
+
+    if (flying) {
+      BrokenDateTime date_time = basic.date_time_utc;
+      if (!date_time.IsDatePlausible())
+        /* use "today" if the GPS didn't provide a date */
+        (BrokenDate &)date_time = BrokenDate::TodayUTC();
+
+      Fix fix;
+      fix.time = date_time.ToTimePoint();
+      fix.location = basic.location;
+      /* XXX use nav_altitude? */
+      fix.altitude = basic.NavAltitudeAvailable() && basic.nav_altitude > 0
+        ? (unsigned)basic.nav_altitude
+        : 0u;
+      fix.ground_speed = basic.ground_speed_available
+        ? (unsigned)Units::ToUserUnit(basic.ground_speed, Unit::KILOMETER_PER_HOUR)
+        : 0u;
+      fix.track = basic.track_available
+        ? basic.track
+        : Angle::Zero();
+      fix.serial = next_serial++;
+
+      queue.push(fix);
+      end_pending = false;
+    } else if (last_flying)
+      /* landing: end the tracking session after the queue has been
+         submitted */
+      end_pending = true;
+
+    if ((queue.empty() && !end_pending) ||
+        std::chrono::steady_clock::now() < retry_time)
+      /* nothing to do, or waiting after an error */
+      return;
+  }
+
   if (inject_task)
-    /* still running, skip this submission */
+    /* still running; it will submit the new fix as well */
     return;
 
-  date_time = basic.date_time_utc;
-  if (!date_time.IsDatePlausible())
-    /* use "today" if the GPS didn't provide a date */
-    (BrokenDate &)date_time = BrokenDate::TodayUTC();
-
-  location = basic.location;
-  /* XXX use nav_altitude? */
-  altitude = basic.NavAltitudeAvailable() && basic.nav_altitude > 0
-    ? (unsigned)basic.nav_altitude
-    : 0u;
-  ground_speed = basic.ground_speed_available
-    ? (unsigned)Units::ToUserUnit(basic.ground_speed, Unit::KILOMETER_PER_HOUR)
-    : 0u;
-  track = basic.track_available
-    ? basic.track
-    : Angle::Zero();
-
-  last_flying = flying;
-  flying = calculated.flight.flying;
-
   inject_task.Start(Tick(settings), BIND_THIS_METHOD(OnCompletion));
 }
 
-Co::InvokeTask
-Glue::Tick(Settings settings)
+bool
+Glue::PeekFix(Fix &fix) noexcept
 {
-  assert(settings.enabled);
+  const std::lock_guard lock{mutex};
+  if (queue.empty())
+    return false;
 
-  if (!flying) {
-    if (last_flying && state.HasSession()) {
-      /* landing: end tracking session */
-      co_await client.EndTracking(state.session_id, state.packet_id);
-      state.ResetSession();
-      last_timestamp = {};
-    }
+  fix = queue.peek();
+  return true;
+}
 
-    /* don't track if not flying */
-    co_return;
-  }
+void
+Glue::PopFix(const Fix &fix) noexcept
+{
+  const std::lock_guard lock{mutex};
+  if (!queue.empty() && queue.peek().serial == fix.serial)
+    queue.shift();
+}
 
-  const auto current_timestamp = date_time.ToTimePoint();
+Co::Task<void>
+Glue::StartSession(const Settings &_settings)
+{
+  Settings settings = _settings;
 
-  if (state.HasSession() &&
-      current_timestamp + std::chrono::minutes(1) < last_timestamp) {
-    /* time warp: create a new session */
-    const auto old_state = state;
-    state.ResetSession();
-    co_await client.EndTracking(old_state.session_id, old_state.packet_id);
+  UserID user_id = 0;
+  if (!settings.username.empty() && !settings.password.empty())
+    user_id = co_await client.GetUserID(settings.username, settings.password);
+
+  if (user_id == 0) {
+    settings.username.clear();
+    settings.password.clear();
+    state.session_id = GenerateSessionID();
+  } else {
+    state.session_id = GenerateSessionID(user_id);
   }
 
-  last_timestamp = current_timestamp;
+  try {
+    co_await client.StartTracking(state.session_id, settings.username,
+                                  settings.password, settings.interval,
+                                  MapVehicleTypeToLivetrack24(settings.vehicleType),
+                                  settings.vehicle_name);
+  } catch (...) {
+    state.ResetSession();
+    throw;
+  }
 
-  if (!state.HasSession()) {
-    UserID user_id = 0;
-    if (!settings.username.empty() && !settings.password.empty())
-      user_id = co_await client.GetUserID(settings.username, settings.password);
+  state.packet_id = 2;
+}
 
-    if (user_id == 0) {
-      settings.username.clear();
-      settings.password.clear();
-      state.session_id = GenerateSessionID();
-    } else {
-      state.session_id = GenerateSessionID(user_id);
-    }
+Co::InvokeTask
+Glue::Tick(Settings settings)
+{
+  assert(settings.enabled);
 
-    try {
-      co_await client.StartTracking(state.session_id, settings.username,
-                                    settings.password, settings.interval,
-                                    MapVehicleTypeToLivetrack24(settings.vehicleType),
-                                    settings.vehicle_name);
-    } catch (...) {
+  /* submit the whole queue in one run; the requests share the
+     server connection */
+  Fix fix;
+  while (PeekFix(fix)) {
+    if (state.HasSession() &&
+        fix.time + std::chrono::minutes(1) < last_timestamp) {
+      /* time warp: create a new session */
+      const auto old_state = state;
       state.ResetSession();
-      throw;
+      co_await client.EndTracking(old_state.session_id, old_state.packet_id);
     }
 
-    state.packet_id = 2;
+    if (!state.HasSession())
+      co_await StartSession(settings);
+
+    co_await client.SendPosition(state.session_id, state.packet_id,
+                                 fix.location, fix.altitude,
+                                 fix.ground_speed, fix.track,
+                                 fix.time);
+    ++state.packet_id;
+    last_timestamp = fix.time;
+    PopFix(fix);
   }
 
-  co_await client.SendPosition(state.session_id, state.packet_id++,
-                               location, altitude, ground_speed, track,
-                               current_timestamp);
+  bool end;
+  {
+    const std::lock_guard lock{mutex};
+    end = std::exchange(end_pending, false);
+  }
+
+  if (end && state.HasSession()) {
+    /* landing: end tracking session */
+    const auto old_state = state;
+    state.ResetSession();
+    last_timestamp = {};
+    co_await client.EndTracking(old_state.session_id, old_state.packet_id);
+  }
 }
 
 void
 Glue::OnCompletion(std::exception_ptr error) noexcept
 {
-  if (error)
+  const std::lock_guard lock{mutex};
+
+  if (error) {
     LogError(error, "LiveTrack24 error");
+
+    /* exponential backoff; the failed fix remains queued */
+    backoff = backoff.count() == 0
+      ? MIN_BACKOFF
+      : std::min(backoff * 2, MAX_BACKOFF);
+    retry_time = std::chrono::steady_clock::now() + backoff;
+  } else {
+    backoff = {};
+    retry_time = {};
+  }
 }
 
 } // namespace Livetrack24
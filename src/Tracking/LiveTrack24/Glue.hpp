@@ -8,7 +8,10 @@
 #include "time/PeriodClock.hpp"
 #include "Geo/GeoPoint.hpp"
 #include "co/InjectTask.hxx"
-#include "time/BrokenDateTime.hpp"
+#include "thread/Mutex.hxx"
+#include "util/OverwritingRingBuffer.hpp"
+
+#include <chrono>
 
 struct MoreData;
 struct DerivedInfo;
@@ -31,6 +34,32 @@ class Glue final {
     }
   };
 
+  /**
+   * One position waiting to be submitted.
+   */
+  struct Fix {
+    std::chrono::system_clock::time_point time;
+    GeoPoint location;
+    unsigned altitude;
+    unsigned ground_speed;
+    Angle track;
+
+    /**
+     * A serial number which allows the task to identify the fix it
+     * has sent, even if the queue has overflowed meanwhile.
+     */
+    unsigned serial;
+  };
+
+  /**
+   * After the first failure, wait this long before retrying; the
+   * delay doubles with each further failure.
+   */
+  static constexpr std::chrono::steady_clock::duration MIN_BACKOFF =
+    std::chrono::seconds(10);
+  static constexpr std::chrono::steady_clock::duration MAX_BACKOFF =
+    std::chrono::minutes(10);
+
   PeriodClock clock;
 
   Settings settings;
@@ -45,12 +74,38 @@ class Glue final {
    */
   std::chrono::system_clock::time_point last_timestamp{};
 
-  BrokenDateTime date_time;
-  GeoPoint location;
-  unsigned altitude;
-  unsigned ground_speed;
-  Angle track;
-  bool flying = false, last_flying;
+  bool flying = false;
+
+  /**
+   * Protects #queue, #next_serial, #end_pending, #backoff,
+   * #retry_time.
+   */
+  Mutex mutex;
+
+  /**
+   * Fixes which have not been submitted yet, e.g. because the
+   * connection is down.  When it is full, the oldest fix is
+   * discarded.
+   */
+  OverwritingRingBuffer<Fix, 256> queue;
+
+  unsigned next_serial = 0;
+
+  /**
+   * Has the aircraft landed, and the session shall be ended after
+   * the queue has been submitted?
+   */
+  bool end_pending = false;
+
+  /**
+   * The current retry delay; zero after a successful submission.
+   */
+  std::chrono::steady_clock::duration backoff{};
+
+  /**
+   * Don't start a new submission before this time.
+   */
+  std::chrono::steady_clock::time_point retry_time{};
 
   Co::InjectTask inject_task;
 
@@ -61,8 +116,29 @@ public:
   void OnTimer(const MoreData &basic, const DerivedInfo &calculated);
 
 protected:
+  /**
+   * Submit all queued fixes (and end the session after landing).
+   * Each fix is removed from the queue only after the server has
+   * accepted it.
+   */
   Co::InvokeTask Tick(Settings settings);
   void OnCompletion(std::exception_ptr error) noexcept;
+
+private:
+  /**
+   * Obtain a copy of the oldest queued fix.
+   *
+   * @return false if the queue is empty
+   */
+  bool PeekFix(Fix &fix) noexcept;
+
+  /**
+   * Remove the specified fix from the queue after it has been
+   * submitted.
+   */
+  void PopFix(const Fix &fix) noexcept;
+
+  Co::Task<void> StartSession(const Settings &settings);
 };
 
 } // namespace Livetrack24
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "MergedTraffic.hpp"
+
+#include <algorithm>
+
+void
+MergedTrafficList::Finish(GeoPoint origin) noexcept
+{
+  /* bring duplicates together, with the preferred source first */
+  std::sort(list.begin(), list.end(),
+            [](const MergedTraffic &a, const MergedTraffic &b){
+              if (a.id != b.id)
+                return a.id < b.id;
+              return a.source < b.source;
+            });
+
+  /* keep only the first entry of each defined id */
+  auto dest = list.begin();
+  for (auto i = list.begin(); i != list.end(); ++i) {
+    if (dest != list.begin() && i->id.IsDefined() &&
+        std::prev(dest)->id == i->id) {
+      std::prev(dest)->sources |= i->sources;
+      continue;
+    }
+
+    if (dest != i)
+      *dest = std::move(*i);
+    ++dest;
+  }
+
+  list.erase(dest, list.end());
+
+  if (origin.IsValid())
+    for (auto &i : list)
+      i.distance = origin.DistanceS(i.location);
+
+  std::sort(list.begin(), list.end(),
+            [](const MergedTraffic &a, const MergedTraffic &b){
+              return a.distance < b.distance;
+            });
+}
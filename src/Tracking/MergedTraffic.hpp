@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "FLARM/Id.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Math/Angle.hpp"
+#include "ui/dim/Point.hpp"
+#include "util/StaticString.hxx"
+
+#include <cstdint>
+#include <vector>
+
+struct FlarmTraffic;
+namespace JETProvider { struct Traffic; }
+
+/**
+ * One aircraft reported by one or more traffic sources (FLARM,
+ * JETProvider, SkyLines).
+ */
+struct MergedTraffic {
+  /**
+   * The traffic sources, in the order of precedence: if an aircraft
+   * is reported by more than one source, the data of the first one
+   * is used.
+   */
+  enum class Source : uint8_t {
+    FLARM,
+    JET_PROVIDER,
+    SKYLINES,
+  };
+
+  static constexpr uint8_t SourceMask(Source source) noexcept {
+    return 1u << unsigned(source);
+  }
+
+  /**
+   * The source whose data is used.
+   */
+  Source source;
+
+  /**
+   * A bit mask of all sources which have reported this aircraft
+   * (see SourceMask()).
+   */
+  uint8_t sources;
+
+  /**
+   * Is this a target which has not been updated recently?
+   */
+  bool fading = false;
+
+  /**
+   * The FLARM id or the ICAO address; undefined if the source does
+   * not know it.  Aircraft with the same id are merged.
+   */
+  FlarmId id = FlarmId::Undefined();
+
+  GeoPoint location;
+
+  /**
+   * The position on the screen (as calculated by the caller).
+   */
+  PixelPoint screen;
+
+  /**
+   * Altitude [m MSL]; only valid if #altitude_available is set.
+   */
+  double altitude;
+  bool altitude_available = false;
+
+  Angle track = Angle::Zero();
+
+  /**
+   * The distance from the origin passed to
+   * MergedTrafficList::Finish() [m].
+   */
+  double distance = 0;
+
+  StaticString<32> name;
+
+  /**
+   * The source specific data.  It is owned by the source and is only
+   * valid as long as the caller keeps it alive.
+   */
+  const FlarmTraffic *flarm = nullptr;
+  const JETProvider::Traffic *jet_provider = nullptr;
+
+  MergedTraffic(Source _source, FlarmId _id, GeoPoint _location,
+                PixelPoint _screen) noexcept
+    :source(_source), sources(SourceMask(_source)),
+     id(_id), location(_location), screen(_screen) {
+    name.clear();
+  }
+};
+
+/**
+ * Collects the traffic of all sources, merges aircraft reported by
+ * more than one source and sorts them by distance, so each aircraft
+ * is processed only once per frame.
+ */
+class MergedTrafficList {
+  std::vector<MergedTraffic> list;
+
+public:
+  using const_iterator = std::vector<MergedTraffic>::const_iterator;
+
+  void Clear() noexcept {
+    list.clear();
+  }
+
+  MergedTraffic &Add(MergedTraffic::Source source, FlarmId id,
+                     GeoPoint location, PixelPoint screen) noexcept {
+    return list.emplace_back(source, id, location, screen);
+  }
+
+  /**
+   * Merge all aircraft with the same id (keeping the data of the
+   * source with the highest precedence) and sort the list by
+   * distance from the given location (nearest first).
+   */
+  void Finish(GeoPoint origin) noexcept;
+
+  bool empty() const noexcept {
+    return list.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return list.size();
+  }
+
+  const_iterator begin() const noexcept {
+    return list.begin();
+  }
+
+  const_iterator end() const noexcept {
+    return list.end();
+  }
+};
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Batch.hpp"
+#include "util/CRC.hpp"
+
+#include <algorithm>
+
+bool
+SkyLinesTracking::BatchBuilder::Add(std::span<const std::byte> packet) noexcept
+{
+  const std::size_t padded = (packet.size() + 7) & ~std::size_t(7);
+  if (n_packets >= 0xff || MAX_SIZE - size < sizeof(BatchEntry) + padded)
+    return false;
+
+  auto &entry = *(BatchEntry *)(buffer.data() + size);
+  entry.length = ToBE16(packet.size());
+  entry.reserved1 = 0;
+  entry.reserved2 = 0;
+  size += sizeof(entry);
+
+  std::copy(packet.begin(), packet.end(), buffer.begin() + size);
+  std::fill(buffer.begin() + size + packet.size(),
+            buffer.begin() + size + padded, std::byte{});
+  size += padded;
+
+  ++n_packets;
+  return true;
+}
+
+std::span<const std::byte>
+SkyLinesTracking::BatchBuilder::Finish(uint64_t key) noexcept
+{
+  auto &packet = *(BatchPacket *)buffer.data();
+  packet.header.magic = ToBE32(MAGIC);
+  packet.header.crc = 0;
+  packet.header.type = ToBE16(Type::BATCH);
+  packet.header.key = ToBE64(key);
+  packet.reserved1 = 0;
+  packet.reserved2 = 0;
+  packet.packet_count = n_packets;
+  packet.reserved3 = 0;
+
+  packet.header.crc = ToBE16(UpdateCRC16CCITT(buffer.data(), size, 0));
+  return {buffer.data(), size};
+}
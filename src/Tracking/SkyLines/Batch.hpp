@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Protocol.hpp"
+#include "util/ByteOrder.hxx"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace SkyLinesTracking {
+
+/**
+ * Collects client-to-server packets for one #BatchPacket.
+ */
+class BatchBuilder {
+public:
+  /**
+   * The maximum datagram size.  This stays well below the usual MTU,
+   * so the datagram does not get fragmented.
+   */
+  static constexpr std::size_t MAX_SIZE = 1024;
+
+private:
+  alignas(BatchPacket) std::array<std::byte, MAX_SIZE> buffer;
+
+  std::size_t size = sizeof(BatchPacket);
+
+  unsigned n_packets = 0;
+
+public:
+  bool IsEmpty() const noexcept {
+    return n_packets == 0;
+  }
+
+  void Clear() noexcept {
+    size = sizeof(BatchPacket);
+    n_packets = 0;
+  }
+
+  /**
+   * Append a packet.
+   *
+   * @return false if the packet does not fit; the caller should send
+   * and clear the batch and try again
+   */
+  bool Add(std::span<const std::byte> packet) noexcept;
+
+  /**
+   * Fill in the #BatchPacket header and return the datagram.  It
+   * remains valid until the next Add() or Clear() call.
+   */
+  std::span<const std::byte> Finish(uint64_t key) noexcept;
+};
+
+/**
+ * Invoke a function for each packet embedded in a #BatchPacket.  The
+ * CRC of the datagram is not checked.
+ *
+ * @param f a function accepting a std::span<std::byte> which is
+ * suitably aligned for all packet structs
+ * @return false if the datagram is malformed (the function may have
+ * been invoked for the packets preceding the defect)
+ */
+template<typename F>
+bool
+ForEachBatchEntry(std::span<std::byte> datagram, F &&f)
+{
+  if (datagram.size() < sizeof(BatchPacket))
+    return false;
+
+  const auto &header = *(const BatchPacket *)datagram.data();
+  std::size_t position = sizeof(header);
+
+  for (unsigned i = 0; i < header.packet_count; ++i) {
+    if (datagram.size() - position < sizeof(BatchEntry))
+      return false;
+
+    const auto &entry = *(const BatchEntry *)(datagram.data() + position);
+    position += sizeof(entry);
+
+    const std::size_t length = FromBE16(entry.length);
+    if (datagram.size() - position < length)
+      return false;
+
+    f(datagram.subspan(position, length));
+
+    /* padding */
+    position += (length + 7) & ~std::size_t(7);
+    if (position > datagram.size())
+      position = datagram.size();
+  }
+
+  return true;
+}
+
+} /* namespace SkyLinesTracking */
@@ -64,6 +64,7 @@ SkyLinesTracking::Client::InternalClose() noexcept
   const std::lock_guard lock{mutex};
   socket_event.Close();
   resolver.reset();
+  batch.Clear();
 }
 
 void
@@ -72,6 +73,68 @@ SkyLinesTracking::Client::Close()
   BlockingCall(GetEventLoop(), [this](){ InternalClose(); });
 }
 
+void
+SkyLinesTracking::Client::SetBatchDelay(std::chrono::steady_clock::duration delay)
+{
+  const std::lock_guard lock{mutex};
+  batch_delay = delay;
+
+  if (batch_delay.count() == 0 && !batch.IsEmpty())
+    SendBatch();
+}
+
+void
+SkyLinesTracking::Client::FlushBatch(bool force)
+{
+  const std::lock_guard lock{mutex};
+
+  if (!batch.IsEmpty() &&
+      (force ||
+       std::chrono::steady_clock::now() >= batch_start + batch_delay))
+    SendBatch();
+}
+
+inline bool
+SkyLinesTracking::Client::SendBatch() noexcept
+{
+  assert(!batch.IsEmpty());
+
+  const auto datagram = batch.Finish(key);
+  const bool success = socket_event.IsDefined() &&
+    GetSocket().Write(datagram.data(), datagram.size(), address) ==
+    (ssize_t)datagram.size();
+  batch.Clear();
+  return success;
+}
+
+bool
+SkyLinesTracking::Client::SendBuffer(std::span<const std::byte> buffer)
+{
+  const std::lock_guard lock{mutex};
+
+  if (batch_delay.count() == 0)
+    return GetSocket().Write(buffer.data(), buffer.size(), address) ==
+      (ssize_t)buffer.size();
+
+  const auto now = std::chrono::steady_clock::now();
+
+  if (!batch.IsEmpty() && !batch.Add(buffer))
+    /* full: send what we have and start a new batch */
+    SendBatch();
+
+  if (batch.IsEmpty()) {
+    if (!batch.Add(buffer))
+      return false;
+
+    batch_start = now;
+  }
+
+  if (now >= batch_start + batch_delay)
+    return SendBatch();
+
+  return true;
+}
+
 void
 SkyLinesTracking::Client::SendFix(const NMEAInfo &basic)
 {
@@ -235,6 +298,7 @@ SkyLinesTracking::Client::OnDatagramReceived(void *data, size_t length)
   case WAVE_REQUEST:
   case THERMAL_SUBMIT:
   case THERMAL_REQUEST:
+  case BATCH:
     break;
 
   case ACK:
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "Batch.hpp"
 #include "event/SocketEvent.hxx"
 #include "net/AllocatedSocketAddress.hxx"
 #include "event/net/cares/SimpleResolver.hxx"
@@ -10,6 +11,7 @@
 #include "util/Cancellable.hxx"
 #include "util/Compiler.h"
 
+#include <chrono>
 #include <cstdint>
 #include <optional>
 
@@ -30,7 +32,7 @@ class Client final : Cares::SimpleHandler {
   Handler *const handler;
 
   /**
-   * Protects #resolving, #resolver, #socket.
+   * Protects #resolving, #resolver, #socket, #batch.
    */
   mutable Mutex mutex;
 
@@ -41,6 +43,19 @@ class Client final : Cares::SimpleHandler {
   AllocatedSocketAddress address;
   SocketEvent socket_event;
 
+  /**
+   * If non-zero, packets are collected in #batch and sent as one
+   * #BatchPacket when the oldest one has waited this long.
+   */
+  std::chrono::steady_clock::duration batch_delay{};
+
+  /**
+   * The time the first packet was added to #batch.
+   */
+  std::chrono::steady_clock::time_point batch_start;
+
+  BatchBuilder batch;
+
 public:
   explicit Client(EventLoop &event_loop,
                   Handler *_handler=nullptr)
@@ -83,14 +98,28 @@ public:
     key = _key;
   }
 
+  /**
+   * Enable (or disable with zero) batching: packets are held back
+   * for up to the specified duration and sent together in one
+   * datagram.  The server must support #BatchPacket.
+   */
+  void SetBatchDelay(std::chrono::steady_clock::duration delay);
+
+  /**
+   * Send the pending batch if its delay has expired (or if #force is
+   * true).  Must be called periodically while batching is enabled.
+   */
+  void FlushBatch(bool force=false);
+
   void Open(Cares::Channel &cares, const char *server);
   bool Open(SocketAddress _address);
   void Close();
 
+  bool SendBuffer(std::span<const std::byte> buffer);
+
   template<typename P>
   bool SendPacket(const P &packet) {
-    const std::lock_guard lock{mutex};
-    return GetSocket().Write(&packet, sizeof(packet), address) == sizeof(packet);
+    return SendBuffer(std::as_bytes(std::span{&packet, 1}));
   }
 
   void SendFix(const NMEAInfo &basic);
@@ -112,6 +141,11 @@ private:
 
   void InternalClose() noexcept;
 
+  /**
+   * Send and clear the batch.  Caller must lock the mutex.
+   */
+  bool SendBatch() noexcept;
+
   void OnTrafficReceived(const TrafficResponsePacket &packet, size_t length);
   void OnUserNameReceived(const UserNameResponsePacket &packet,
                           size_t length);
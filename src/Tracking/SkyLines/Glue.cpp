@@ -157,6 +157,8 @@ SkyLinesTracking::Glue::Tick(const NMEAInfo &basic,
     if (traffic_enabled &&
         traffic_clock.CheckAdvance(basic.clock, minutes(1)))
       client.SendTrafficRequest(true, true, near_traffic_enabled);
+
+    client.FlushBatch();
   }
 
   if (cloud_client.IsConnected()) {
@@ -191,6 +193,7 @@ SkyLinesTracking::Glue::SetSettings(const Settings &settings)
   client.SetKey(settings.key);
 
   interval = seconds(settings.interval);
+  client.SetBatchDelay(seconds(settings.batch_delay));
 
   if (!client.IsDefined()) {
     client.Open(*global_cares_channel, "tracking.skylines.aero");
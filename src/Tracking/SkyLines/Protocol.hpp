@@ -72,6 +72,11 @@ enum Type {
    * @see #ThermalResponsePacket
    */
   THERMAL_RESPONSE = 13,
+
+  /**
+   * @see #BatchPacket
+   */
+  BATCH = 14,
 };
 
 /**
@@ -586,4 +591,50 @@ struct ThermalResponsePacket {
   /* followed by a number of #Thermal instances */
 };
 
+/**
+ * Several client-to-server packets in one datagram, to save the
+ * per-datagram overhead on expensive links.  The CRC of this header
+ * covers all of them; the CRC of the embedded packets is ignored.
+ * Their key must be the same as the key of this header, and they
+ * must not be #BATCH packets.
+ */
+struct BatchPacket {
+  Header header;
+
+  uint16_t reserved1;
+  uint8_t reserved2;
+
+  /**
+   * The number of #BatchEntry instances following this struct.
+   */
+  uint8_t packet_count;
+
+  uint32_t reserved3;
+
+  /* followed by a number of #BatchEntry instances */
+};
+
+#ifdef __cplusplus
+static_assert(sizeof(BatchPacket) == 24, "Wrong struct size");
+#endif
+
+/**
+ * Packet fragment which precedes each packet embedded in a
+ * #BatchPacket.
+ */
+struct BatchEntry {
+  /**
+   * The size of the packet following this struct.  The next
+   * #BatchEntry follows the packet, padded to a multiple of 8 bytes.
+   */
+  uint16_t length;
+
+  uint16_t reserved1;
+  uint32_t reserved2;
+};
+
+#ifdef __cplusplus
+static_assert(sizeof(BatchEntry) == 8, "Wrong struct size");
+#endif
+
 } /* namespace SkyLinesTracking */
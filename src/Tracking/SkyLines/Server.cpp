@@ -3,6 +3,7 @@
 
 #include "Server.hpp"
 #include "Assemble.hpp"
+#include "Batch.hpp"
 #include "Protocol.hpp"
 #include "Import.hpp"
 #include "util/ByteOrder.hxx"
@@ -10,13 +11,23 @@
 #include "net/UniqueSocketDescriptor.hxx"
 #include "util/CRC.hpp"
 
+#include <algorithm>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
 static UniqueSocketDescriptor
-CreateBindUDP(SocketAddress address)
+CreateBindUDP(SocketAddress address, bool reuse_port)
 {
   UniqueSocketDescriptor s;
   if (!s.Create(address.GetFamily(), SOCK_DGRAM, 0))
     throw MakeSocketError("Failed to create socket");
 
+  if (reuse_port && !s.SetReusePort())
+    throw MakeSocketError("Failed to set SO_REUSEPORT");
+
   if (!s.Bind(address))
     throw MakeSocketError("Failed to connect socket");
 
@@ -26,9 +37,10 @@ CreateBindUDP(SocketAddress address)
 namespace SkyLinesTracking {
 
 Server::Server(EventLoop &event_loop,
-               SocketAddress server_address)
+               SocketAddress server_address, bool reuse_port)
   :socket(event_loop, BIND_THIS_METHOD(OnSocketReady),
-          CreateBindUDP(server_address).Release())
+          CreateBindUDP(server_address, reuse_port).Release()),
+   outgoing(std::make_unique<std::array<OutgoingDatagram, MAX_DATAGRAMS>>())
 {
   socket.ScheduleRead();
 }
@@ -42,8 +54,20 @@ void
 Server::SendBuffer(SocketAddress address,
                    std::span<const std::byte> buffer) noexcept
 {
+  if (queue_outgoing && buffer.size() <= MAX_SEND_SIZE) {
+    if (n_outgoing == MAX_DATAGRAMS)
+      FlushOutgoing();
+
+    auto &datagram = (*outgoing)[n_outgoing++];
+    datagram.address = address;
+    datagram.size = buffer.size();
+    std::copy(buffer.begin(), buffer.end(), datagram.data.begin());
+    return;
+  }
+
   try {
-    ssize_t nbytes = socket.GetSocket().Write(buffer.data(), buffer.size());
+    ssize_t nbytes = socket.GetSocket().Write(buffer.data(), buffer.size(),
+                                              address);
     if (nbytes < 0)
       throw MakeSocketError("Failed to send");
   } catch (...) {
@@ -51,6 +75,49 @@ Server::SendBuffer(SocketAddress address,
   }
 }
 
+void
+Server::FlushOutgoing() noexcept
+{
+#ifdef __linux__
+  struct iovec iov[MAX_DATAGRAMS];
+  struct mmsghdr msgs[MAX_DATAGRAMS];
+
+  for (unsigned i = 0; i < n_outgoing; ++i) {
+    auto &datagram = (*outgoing)[i];
+    iov[i] = {datagram.data.data(), datagram.size};
+
+    msgs[i] = {};
+    msgs[i].msg_hdr.msg_name = (struct sockaddr *)datagram.address;
+    msgs[i].msg_hdr.msg_namelen = datagram.address.GetSize();
+    msgs[i].msg_hdr.msg_iov = &iov[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  unsigned position = 0;
+  while (position < n_outgoing) {
+    int n = sendmmsg(socket.GetSocket().Get(), msgs + position,
+                     n_outgoing - position, MSG_DONTWAIT);
+    if (n <= 0) {
+      /* report the failed one and continue with the rest */
+      OnSendError((*outgoing)[position].address,
+                  std::make_exception_ptr(MakeSocketError("Failed to send")));
+      n = 1;
+    }
+
+    position += n;
+  }
+#else
+  for (unsigned i = 0; i < n_outgoing; ++i) {
+    const auto &datagram = (*outgoing)[i];
+    const bool was_queueing = std::exchange(queue_outgoing, false);
+    SendBuffer(datagram.address, {datagram.data.data(), datagram.size});
+    queue_outgoing = was_queueing;
+  }
+#endif
+
+  n_outgoing = 0;
+}
+
 void
 Server::OnPing(const Client &client, unsigned id)
 {
@@ -74,6 +141,17 @@ Server::OnDatagramReceived(Client &&client,
 
   client.key = FromBE64(header.key);
 
+  OnPacketReceived(client, data, length, false);
+}
+
+void
+Server::OnPacketReceived(const Client &client, void *data, size_t length,
+                         bool nested)
+{
+  const auto &header = *(const Header *)data;
+  if (length < sizeof(header))
+    return;
+
   const auto &ping = *(const PingPacket *)data;
   const auto &fix = *(const FixPacket *)data;
   const auto &traffic = *(const TrafficRequestPacket *)data;
@@ -152,6 +230,21 @@ Server::OnDatagramReceived(Client &&client,
     OnThermalRequest(client);
     break;
 
+  case BATCH:
+    if (nested)
+      /* no recursion */
+      return;
+
+    ForEachBatchEntry({(std::byte *)data, length},
+                      [this, &client](std::span<std::byte> packet){
+      const auto &nested_header = *(const Header *)packet.data();
+      if (packet.size() >= sizeof(nested_header) &&
+          nested_header.magic == ToBE32(MAGIC) &&
+          FromBE64(nested_header.key) == client.key)
+        OnPacketReceived(client, packet.data(), packet.size(), true);
+    });
+    break;
+
   case ACK:
   case TRAFFIC_RESPONSE:
   case USER_NAME_RESPONSE:
@@ -165,11 +258,45 @@ Server::OnDatagramReceived(Client &&client,
 void
 Server::OnSocketReady(unsigned) noexcept
 try {
-  // TODO: use recvmmsg() on Linux
+#ifdef __linux__
+  alignas(8) static thread_local std::byte buffers[MAX_DATAGRAMS][MAX_RECEIVE_SIZE];
+  Client clients[MAX_DATAGRAMS];
+  struct iovec iov[MAX_DATAGRAMS];
+  struct mmsghdr msgs[MAX_DATAGRAMS];
+
+  for (unsigned i = 0; i < MAX_DATAGRAMS; ++i) {
+    iov[i] = {buffers[i], sizeof(buffers[i])};
+
+    msgs[i] = {};
+    msgs[i].msg_hdr.msg_name = (struct sockaddr *)clients[i].address;
+    msgs[i].msg_hdr.msg_namelen = clients[i].address.GetCapacity();
+    msgs[i].msg_hdr.msg_iov = &iov[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int n = recvmmsg(socket.GetSocket().Get(), msgs, MAX_DATAGRAMS,
+                   MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    if (errno == EAGAIN || errno == EINTR)
+      return;
+
+    throw MakeSocketError("Failed to receive");
+  }
+
+  /* queue all responses and send them with one sendmmsg() call */
+  queue_outgoing = true;
+
+  for (int i = 0; i < n; ++i) {
+    clients[i].address.SetSize(msgs[i].msg_hdr.msg_namelen);
+    OnDatagramReceived(std::move(clients[i]), buffers[i], msgs[i].msg_len);
+  }
 
+  queue_outgoing = false;
+  FlushOutgoing();
+#else
   Client client;
   socklen_t address_size = sizeof(client.address);
-  char buffer[4096];
+  alignas(8) char buffer[MAX_RECEIVE_SIZE];
 
   ssize_t nbytes = recvfrom(socket.GetSocket().Get(), buffer, sizeof(buffer),
                             MSG_DONTWAIT,
@@ -178,10 +305,12 @@ try {
     throw MakeSocketError("Failed to receive");
 
   client.address.SetSize(address_size);
-  // TODO: set client.key
 
   OnDatagramReceived(std::move(client), buffer, nbytes);
+#endif
 } catch (...) {
+  queue_outgoing = false;
+  n_outgoing = 0;
   socket.Close();
   OnError(std::current_exception());
 }
@@ -6,9 +6,12 @@
 #include "event/SocketEvent.hxx"
 #include "net/StaticSocketAddress.hxx"
 
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <memory>
 #include <span>
 
 struct GeoPoint;
@@ -24,6 +27,34 @@ namespace SkyLinesTracking {
 class Server {
   SocketEvent socket;
 
+  /**
+   * The number of datagrams received (and sent) with one system
+   * call.
+   */
+  static constexpr unsigned MAX_DATAGRAMS = 32;
+
+  static constexpr std::size_t MAX_RECEIVE_SIZE = 4096;
+
+  /**
+   * Responses larger than this are never queued.
+   */
+  static constexpr std::size_t MAX_SEND_SIZE = 2048;
+
+  struct OutgoingDatagram {
+    StaticSocketAddress address;
+    std::size_t size;
+    alignas(8) std::array<std::byte, MAX_SEND_SIZE> data;
+  };
+
+  /**
+   * While the datagrams received by one OnSocketReady() call are
+   * being handled, responses are queued here and sent with one
+   * system call afterwards.
+   */
+  std::unique_ptr<std::array<OutgoingDatagram, MAX_DATAGRAMS>> outgoing;
+  unsigned n_outgoing = 0;
+  bool queue_outgoing = false;
+
 public:
   struct Client {
     StaticSocketAddress address;
@@ -31,7 +62,12 @@ public:
   };
 
 public:
-  Server(EventLoop &event_loop, SocketAddress server_address);
+  /**
+   * @param reuse_port set SO_REUSEPORT, allowing several instances
+   * (e.g. one per thread) to share the port
+   */
+  Server(EventLoop &event_loop, SocketAddress server_address,
+         bool reuse_port=false);
 
   ~Server();
 
@@ -58,6 +94,19 @@ public:
   }
 
 private:
+  /**
+   * Send all queued responses.
+   */
+  void FlushOutgoing() noexcept;
+
+  /**
+   * Dispatch one packet whose CRC has already been verified.
+   *
+   * @param nested true if the packet was embedded in a #BatchPacket
+   */
+  void OnPacketReceived(const Client &client, void *data, size_t length,
+                        bool nested);
+
   void OnDatagramReceived(Client &&client, void *data, size_t length);
   void OnSocketReady(unsigned events) noexcept;
 
@@ -36,6 +36,13 @@ struct Settings {
    */
   unsigned interval;
 
+  /**
+   * Hold packets back for up to this number of seconds and send
+   * them together in one datagram.  0 disables batching.  This
+   * requires server support.
+   */
+  unsigned batch_delay;
+
   uint64_t key;
 
   CloudSettings cloud;
@@ -46,6 +53,7 @@ struct Settings {
     traffic_enabled = false;
     near_traffic_enabled = false;
     interval = 5;
+    batch_delay = 0;
     key = 0;
     cloud.SetDefaults();
   }
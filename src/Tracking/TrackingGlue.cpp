@@ -58,20 +58,29 @@ TrackingGlue::OnTraffic(uint32_t pilot_id, unsigned time_of_day_ms,
     skylines.RequestUserName(pilot_id);
 }
 
-void TrackingGlue::OnJETTraffic(std::vector<JETProvider::Data::Traffic> traffics, bool success)
+void
+TrackingGlue::OnJETTraffic(std::shared_ptr<const JETProvider::TrafficTable> table)
 {
-  const std::lock_guard<Mutex> lock(jet_provider_data.mutex);
+  const std::size_t size = table->size();
 
-  jet_provider_data.success = success;
-  if (success) {
-    jet_provider_data.traffics.clear();
-    for (JETProvider::Data::Traffic traffic : traffics) {
-      jet_provider_data.traffics[traffic.traffic_id] = traffic;
-    }
+  {
+    const std::lock_guard<Mutex> lock(jet_provider_data.mutex);
+    jet_provider_data.success = true;
+    jet_provider_data.table.swap(table);
   }
 
-  LogFormat("OnJETTraffic size:%d success:%d",
-    (int) jet_provider_data.traffics.size(), success);
+  /* the old table (if no reader holds it anymore) is freed here,
+     after the mutex was released */
+  table.reset();
+
+  LogFormat("OnJETTraffic size:%d", (int)size);
+}
+
+void
+TrackingGlue::OnJETTrafficUnchanged()
+{
+  const std::lock_guard<Mutex> lock(jet_provider_data.mutex);
+  jet_provider_data.success = true;
 }
 
 void
@@ -123,4 +132,7 @@ void
 TrackingGlue::OnJETProviderError(std::exception_ptr e)
 {
   LogError(e, "JETProvider error");
+
+  const std::lock_guard<Mutex> lock(jet_provider_data.mutex);
+  jet_provider_data.success = false;
 }
@@ -67,7 +67,8 @@ private:
                  const AGeoPoint &bottom, const AGeoPoint &top,
                  double lift) override;
   void OnSkyLinesError(std::exception_ptr e) override;
-  void OnJETTraffic(std::vector<JETProvider::Data::Traffic> traffics, bool success) override;
+  void OnJETTraffic(std::shared_ptr<const JETProvider::TrafficTable> table) override;
+  void OnJETTrafficUnchanged() override;
   void OnJETProviderError(std::exception_ptr e) override;
 
 public:
@@ -58,13 +58,20 @@ UIReceiveSensorData(OperationEnvironment &env)
   bool modified = ApplyExternalSettings(env);
 
   /*
-   * Update the infoboxes if no location is available
+   * Update the infoboxes showing sensor data if no location is
+   * available
    *
    * (if the location is available the CalculationThread will send the
    * Command::CALCULATED_UPDATE message which will update them)
    */
-  if (modified || !CommonInterface::Basic().location_available) {
-    InfoBoxManager::SetDirty();
+  unsigned changed = 0;
+  if (modified)
+    changed |= InfoBoxContent::DEPENDS_SETTINGS;
+  if (!CommonInterface::Basic().location_available)
+    changed |= InfoBoxContent::DEPENDS_BASIC;
+
+  if (changed != 0) {
+    InfoBoxManager::SetDirty(changed);
     InfoBoxManager::ProcessTimer();
   }
 }
@@ -74,6 +81,12 @@ UIReceiveCalculatedData()
 {
   XCSoarInterface::ReceiveCalculated();
 
+  /* settings may be modified in many places without notifying the
+     InfoBoxManager; they are picked up with each calculation result */
+  InfoBoxManager::SetDirty(InfoBoxContent::DEPENDS_BASIC |
+                           InfoBoxContent::DEPENDS_CALCULATED |
+                           InfoBoxContent::DEPENDS_SETTINGS);
+
   ActionInterface::UpdateDisplayMode();
   ActionInterface::SendUIState();
 
@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "WaypointCache.hpp"
+#include "Engine/Waypoint/Waypoint.hpp"
+#include "io/BufferedOutputStream.hxx"
+#include "io/BufferedReader.hxx"
+#include "util/tstring_view.hxx"
+
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include <string.h>
+
+namespace {
+
+struct CacheHeader {
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t version;
+
+  /**
+   * The length of the key string following this header.
+   */
+  uint32_t key_length;
+
+  uint32_t n_waypoints;
+};
+
+/**
+ * One waypoint.  It is followed by its short name, name, comment and
+ * details (as TCHAR strings without null terminator) and by its
+ * embedded and external file names (each preceded by its length as
+ * uint32_t).
+ */
+struct WaypointRecord {
+  GeoPoint location;
+  double elevation;
+
+  uint32_t original_id;
+
+  uint32_t shortname_length, name_length, comment_length, details_length;
+
+  uint32_t n_files_embed, n_files_external;
+
+  Runway runway;
+  RadioFrequency radio_frequency;
+
+  Waypoint::Flags flags;
+  Waypoint::Type type;
+  WaypointOrigin origin;
+  uint8_t has_elevation;
+};
+
+/* the snapshot is a copy of the objects' memory */
+static_assert(std::is_trivially_copyable_v<WaypointRecord>);
+
+/* sanity limits for reading */
+static constexpr uint32_t MAX_KEY_LENGTH = 4096;
+static constexpr uint32_t MAX_WAYPOINTS = 1024 * 1024;
+static constexpr uint32_t MAX_STRING_LENGTH = 64 * 1024;
+static constexpr uint32_t MAX_FILES = 256;
+
+} // anonymous namespace
+
+static void
+WriteString(BufferedOutputStream &os, const tstring_view s)
+{
+  os.Write(std::as_bytes(std::span{s}));
+}
+
+static void
+WriteFiles(BufferedOutputStream &os, const std::forward_list<tstring> &files)
+{
+  for (const auto &i : files) {
+    const uint32_t length = i.size();
+    os.Write(std::as_bytes(std::span{&length, 1}));
+    WriteString(os, i);
+  }
+}
+
+[[gnu::pure]]
+static uint32_t
+CountFiles(const std::forward_list<tstring> &files) noexcept
+{
+  return std::distance(files.begin(), files.end());
+}
+
+void
+SaveWaypointCache(BufferedOutputStream &os, std::string_view key,
+                  const std::vector<WaypointPtr> &waypoints)
+{
+  CacheHeader header;
+  memset(&header, 0, sizeof(header));
+  header.version = CacheHeader::VERSION;
+  header.key_length = key.size();
+  header.n_waypoints = waypoints.size();
+
+  os.Write(std::as_bytes(std::span{&header, 1}));
+  os.Write(std::as_bytes(std::span{key}));
+
+  for (const auto &i : waypoints) {
+    const Waypoint &wp = *i;
+
+    WaypointRecord record;
+
+    /* zero-fill all implicit padding bytes (to make valgrind happy) */
+    memset(static_cast<void *>(&record), 0, sizeof(record));
+
+    record.location = wp.location;
+    record.elevation = wp.has_elevation ? wp.elevation : 0.;
+    record.original_id = wp.original_id;
+    record.shortname_length = wp.shortname.size();
+    record.name_length = wp.name.size();
+    record.comment_length = wp.comment.size();
+    record.details_length = wp.details.size();
+    record.n_files_embed = CountFiles(wp.files_embed);
+#ifdef HAVE_RUN_FILE
+    record.n_files_external = CountFiles(wp.files_external);
+#endif
+    record.runway = wp.runway;
+    record.radio_frequency = wp.radio_frequency;
+    record.flags = wp.flags;
+    record.type = wp.type;
+    record.origin = wp.origin;
+    record.has_elevation = wp.has_elevation;
+
+    os.Write(std::as_bytes(std::span{&record, 1}));
+    WriteString(os, wp.shortname);
+    WriteString(os, wp.name);
+    WriteString(os, wp.comment);
+    WriteString(os, wp.details);
+    WriteFiles(os, wp.files_embed);
+#ifdef HAVE_RUN_FILE
+    WriteFiles(os, wp.files_external);
+#endif
+  }
+}
+
+static tstring
+ReadString(BufferedReader &r, std::size_t length)
+{
+  if (length > MAX_STRING_LENGTH)
+    throw std::runtime_error("Malformed waypoint cache string");
+
+  tstring s(length, _T('\0'));
+  r.ReadFull(std::as_writable_bytes(std::span{s}));
+  return s;
+}
+
+static std::forward_list<tstring>
+ReadFiles(BufferedReader &r, uint32_t n)
+{
+  std::forward_list<tstring> files;
+  auto tail = files.before_begin();
+
+  for (uint32_t i = 0; i < n; ++i)
+    tail = files.insert_after(tail, ReadString(r, r.ReadFullT<uint32_t>()));
+
+  return files;
+}
+
+std::vector<Waypoint>
+LoadWaypointCache(BufferedReader &r, std::string_view key)
+{
+  const auto header = r.ReadFullT<CacheHeader>();
+  if (header.version != CacheHeader::VERSION ||
+      header.key_length > MAX_KEY_LENGTH ||
+      header.n_waypoints > MAX_WAYPOINTS)
+    throw std::runtime_error("Malformed waypoint cache header");
+
+  std::string old_key(header.key_length, '\0');
+  r.ReadFull(std::as_writable_bytes(std::span{old_key}));
+  if (old_key != key)
+    throw std::runtime_error("Waypoint cache is for another file");
+
+  std::vector<Waypoint> waypoints;
+  waypoints.reserve(header.n_waypoints);
+
+  for (uint32_t i = 0; i < header.n_waypoints; ++i) {
+    const auto record = r.ReadFullT<WaypointRecord>();
+    if (!record.location.Check() || !std::isfinite(record.elevation) ||
+        record.type > Waypoint::Type::PGLANDING ||
+        record.origin > WaypointOrigin::MAP ||
+        record.has_elevation > 1 ||
+        record.n_files_embed > MAX_FILES ||
+        record.n_files_external > MAX_FILES)
+      throw std::runtime_error("Malformed waypoint cache record");
+
+    Waypoint &wp = waypoints.emplace_back(record.location);
+    wp.elevation = record.elevation;
+    wp.original_id = record.original_id;
+    wp.runway = record.runway;
+    wp.radio_frequency = record.radio_frequency;
+    wp.flags = record.flags;
+    wp.type = record.type;
+    wp.origin = record.origin;
+    wp.has_elevation = record.has_elevation;
+
+    wp.shortname = ReadString(r, record.shortname_length);
+    wp.name = ReadString(r, record.name_length);
+    wp.comment = ReadString(r, record.comment_length);
+    wp.details = ReadString(r, record.details_length);
+    wp.files_embed = ReadFiles(r, record.n_files_embed);
+
+    auto files_external = ReadFiles(r, record.n_files_external);
+#ifdef HAVE_RUN_FILE
+    wp.files_external = std::move(files_external);
+#endif
+  }
+
+  return waypoints;
+}
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Engine/Waypoint/Ptr.hpp"
+
+#include <string_view>
+#include <vector>
+
+struct Waypoint;
+class BufferedOutputStream;
+class BufferedReader;
+
+/*
+ * A binary snapshot of the waypoints parsed from one file, to be
+ * stored in the #FileCache.  It is only valid on the machine which
+ * wrote it.
+ */
+
+/**
+ * Write a snapshot of the specified waypoints.  Their ids and
+ * projected locations are not saved; Waypoints::Append() assigns
+ * them.
+ *
+ * Throws on error.
+ *
+ * @param key identifies the source (e.g. its path);
+ * LoadWaypointCache() refuses a snapshot written with a different key
+ */
+void
+SaveWaypointCache(BufferedOutputStream &os, std::string_view key,
+                  const std::vector<WaypointPtr> &waypoints);
+
+/**
+ * Read a snapshot written by SaveWaypointCache().
+ *
+ * Throws on error (e.g. a malformed or incompatible snapshot).
+ *
+ * @return the waypoints in the order they were saved
+ */
+std::vector<Waypoint>
+LoadWaypointCache(BufferedReader &r, std::string_view key);
@@ -9,15 +9,52 @@
 #include "io/ConfiguredFile.hpp"
 #include "io/LineReader.hpp"
 #include "Operation/ProgressListener.hpp"
+#include "thread/Mutex.hxx"
+#include "util/StringAPI.hxx"
+#include "LogFile.hpp"
+
+#include <map>
 
 namespace WaypointDetails {
 
+/**
+ * The line number of each section header in the airfield details
+ * file, by the id of the waypoint it belongs to.  Filled by
+ * ReadFileFromProfile(); an entry is removed once Load() has applied
+ * it.
+ */
+static Mutex index_mutex;
+static std::map<unsigned, unsigned> index;
+
 static WaypointPtr
 FindWaypoint(Waypoints &way_points, const TCHAR *name)
 {
   return way_points.LookupName(name);
 }
 
+/**
+ * Extract the waypoint name from a section header line ("[name]").
+ */
+static void
+ParseSectionName(const TCHAR *line, TCHAR name[201]) noexcept
+{
+  int i;
+  for (i = 1; i < 201; i++) {
+    if (line[i] == _T(']') || line[i] == _T('\0'))
+      break;
+
+    name[i - 1] = line[i];
+  }
+  name[i - 1] = 0;
+}
+
+[[gnu::pure]]
+static bool
+IsSectionHeader(const TCHAR *line) noexcept
+{
+  return line[0] == _T('[');
+}
+
 struct WaypointDetailsBuilder {
   TCHAR name[201];
   tstring details;
@@ -34,18 +71,42 @@ struct WaypointDetailsBuilder {
     files_embed.clear();
   }
 
+  /**
+   * Parse one line of the section body.
+   */
+  void ParseLine(const TCHAR *line) noexcept;
+
+  void Apply(const Waypoint &wp) noexcept;
   void Commit(Waypoints &way_points) noexcept;
 };
 
 inline void
-WaypointDetailsBuilder::Commit(Waypoints &way_points) noexcept
+WaypointDetailsBuilder::ParseLine(const TCHAR *line) noexcept
 {
-  auto wp = FindWaypoint(way_points, name);
-  if (wp == nullptr)
-    return;
+  const TCHAR *filename;
 
+  if ((filename =
+       StringAfterPrefixIgnoreCase(line, _T("image="))) != nullptr) {
+    files_embed.emplace_front(filename);
+  } else if ((filename =
+              StringAfterPrefixIgnoreCase(line, _T("file="))) != nullptr) {
+#ifdef HAVE_RUN_FILE
+    files_external.emplace_front(filename);
+#endif
+  } else {
+    // append text to details string
+    if (!StringIsEmpty(line)) {
+      details += line;
+      details += _T('\n');
+    }
+  }
+}
+
+inline void
+WaypointDetailsBuilder::Apply(const Waypoint &wp) noexcept
+{
   // TODO: eliminate this const_cast hack
-  Waypoint &new_wp = const_cast<Waypoint &>(*wp);
+  Waypoint &new_wp = const_cast<Waypoint &>(wp);
   new_wp.details = std::move(details);
 
   files_embed.reverse();
@@ -57,6 +118,14 @@ WaypointDetailsBuilder::Commit(Waypoints &way_points) noexcept
 #endif
 }
 
+inline void
+WaypointDetailsBuilder::Commit(Waypoints &way_points) noexcept
+{
+  auto wp = FindWaypoint(way_points, name);
+  if (wp != nullptr)
+    Apply(*wp);
+}
+
 /**
  * Parses the data provided by the airfield details file handle
  */
@@ -65,55 +134,75 @@ ParseAirfieldDetails(Waypoints &way_points, TLineReader &reader,
                      ProgressListener &progress)
 {
   WaypointDetailsBuilder builder;
-  const TCHAR *filename;
 
   bool in_details = false;
-  int i;
 
   const long filesize = std::max(reader.GetSize(), 1l);
   progress.SetProgressRange(100);
 
   TCHAR *line;
   while ((line = reader.ReadLine()) != nullptr) {
-    if (line[0] == _T('[')) { // Look for start
+    if (IsSectionHeader(line)) { // Look for start
       if (in_details)
         builder.Commit(way_points);
 
       builder.Reset();
-
-      // extract name
-      for (i = 1; i < 201; i++) {
-        if (line[i] == _T(']'))
-          break;
-
-        builder.name[i - 1] = line[i];
-      }
-      builder.name[i - 1] = 0;
+      ParseSectionName(line, builder.name);
 
       in_details = true;
 
       progress.SetProgressPosition(reader.Tell() * 100 / filesize);
-    } else if ((filename =
-                StringAfterPrefixIgnoreCase(line, _T("image="))) != nullptr) {
-      builder.files_embed.emplace_front(filename);
-    } else if ((filename =
-                StringAfterPrefixIgnoreCase(line, _T("file="))) != nullptr) {
-#ifdef HAVE_RUN_FILE
-      builder.files_external.emplace_front(filename);
-#endif
-    } else {
-      // append text to details string
-      if (!StringIsEmpty(line)) {
-        builder.details += line;
-        builder.details += _T('\n');
-      }
-    }
+    } else
+      builder.ParseLine(line);
   }
 
   if (in_details)
     builder.Commit(way_points);
 }
 
+/**
+ * Scan the section headers of the airfield details file and fill the
+ * #index, without parsing the section bodies.
+ */
+static void
+IndexAirfieldDetails(Waypoints &way_points, TLineReader &reader,
+                     ProgressListener &progress)
+{
+  std::map<unsigned, unsigned> new_index;
+
+  const long filesize = std::max(reader.GetSize(), 1l);
+  progress.SetProgressRange(100);
+
+  TCHAR name[201];
+  unsigned line_number = 0;
+
+  TCHAR *line;
+  for (; (line = reader.ReadLine()) != nullptr; ++line_number) {
+    if (!IsSectionHeader(line))
+      continue;
+
+    ParseSectionName(line, name);
+
+    /* like ParseAirfieldDetails(), a later section overrides an
+       earlier one with the same name */
+    if (const auto wp = FindWaypoint(way_points, name))
+      new_index[wp->id] = line_number;
+
+    progress.SetProgressPosition(reader.Tell() * 100 / filesize);
+  }
+
+  const std::lock_guard lock{index_mutex};
+  index = std::move(new_index);
+}
+
+static std::unique_ptr<TLineReader>
+OpenAirfieldDetails() noexcept
+{
+  return OpenConfiguredTextFile(ProfileKeys::AirfieldFile,
+                                "airfields.txt",
+                                Charset::AUTO);
+}
+
 /**
  * Opens the airfield details file and parses it
  */
@@ -128,11 +217,55 @@ void
 ReadFileFromProfile(Waypoints &way_points,
                     ProgressListener &progress)
 {
-  auto reader = OpenConfiguredTextFile(ProfileKeys::AirfieldFile,
-                                       "airfields.txt",
-                                       Charset::AUTO);
+  {
+    const std::lock_guard lock{index_mutex};
+    index.clear();
+  }
+
+  auto reader = OpenAirfieldDetails();
   if (reader)
-    ReadFile(*reader, way_points, progress);
+    IndexAirfieldDetails(way_points, *reader, progress);
+}
+
+void
+Load(const Waypoint &waypoint) noexcept
+try {
+  unsigned line_number;
+
+  {
+    const std::lock_guard lock{index_mutex};
+    const auto i = index.find(waypoint.id);
+    if (i == index.end())
+      return;
+
+    line_number = i->second;
+    index.erase(i);
+  }
+
+  auto reader = OpenAirfieldDetails();
+  if (!reader)
+    return;
+
+  const TCHAR *line = nullptr;
+  for (unsigned i = 0; i <= line_number; ++i)
+    if ((line = reader->ReadLine()) == nullptr)
+      return;
+
+  WaypointDetailsBuilder builder;
+  if (!IsSectionHeader(line))
+    /* the file has been modified since it was indexed */
+    return;
+
+  ParseSectionName(line, builder.name);
+  if (!StringIsEqual(builder.name, waypoint.name.c_str()))
+    return;
+
+  while ((line = reader->ReadLine()) != nullptr && !IsSectionHeader(line))
+    builder.ParseLine(line);
+
+  builder.Apply(waypoint);
+} catch (...) {
+  LogError(std::current_exception());
 }
 
 } // namespace WaypointDetails
@@ -4,17 +4,37 @@
 #pragma once
 
 class Waypoints;
+struct Waypoint;
 class ProgressListener;
 class TLineReader;
 
 namespace WaypointDetails {
 
+/**
+ * Parse the whole airfield details file and attach the details to
+ * the waypoints.
+ */
 void
 ReadFile(TLineReader &reader, Waypoints &way_points,
          ProgressListener &progress);
 
+/**
+ * Index the airfield details file configured in the profile: only
+ * remember which waypoints have details, and where.  Load() reads
+ * them when they are needed.
+ */
 void
 ReadFileFromProfile(Waypoints &way_points,
                     ProgressListener &progress);
 
+/**
+ * Read the details of this waypoint from the airfield details file
+ * and attach them, unless this has already been done or the file
+ * has no details for it.  Call this before accessing
+ * Waypoint::details, Waypoint::files_embed or
+ * Waypoint::files_external.
+ */
+void
+Load(const Waypoint &waypoint) noexcept;
+
 } // namespace WaypointDetails
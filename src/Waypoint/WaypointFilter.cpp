@@ -82,23 +82,10 @@ WaypointFilter::CompareDirection(const Waypoint &waypoint,
   return CompareDirection(waypoint, direction, location);
 }
 
-inline bool
-WaypointFilter::CompareName(const Waypoint &waypoint, const TCHAR *name)
-{
-  return StringIsEqualIgnoreCase(waypoint.name.c_str(), name, _tcslen(name));
-}
-
-inline bool
-WaypointFilter::CompareName(const Waypoint &waypoint) const
-{
-  return CompareName(waypoint, name);
-}
-
 bool
 WaypointFilter::Matches(const Waypoint &waypoint, GeoPoint location,
                         const FAITrianglePointValidator &triangle_validator) const
 {
   return CompareType(waypoint, triangle_validator) &&
-         (distance <= 0 || CompareName(waypoint)) &&
          CompareDirection(waypoint, location);
 }
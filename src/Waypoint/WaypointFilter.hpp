@@ -46,6 +46,11 @@ struct WaypointFilter
     type_index = TypeFilter::ALL;
   }
 
+  /**
+   * Check the type and direction filters.  The name and distance
+   * filters are not checked here; they select the candidates (see
+   * WaypointListBuilder::Visit()).
+   */
   [[gnu::pure]]
   bool Matches(const Waypoint &waypoint, GeoPoint location,
                const FAITrianglePointValidator &triangle_validator) const;
@@ -61,8 +66,4 @@ private:
                                GeoPoint location);
 
   bool CompareDirection(const Waypoint &waypoint, GeoPoint location) const;
-
-  static bool CompareName(const Waypoint &waypoint, const TCHAR *name);
-
-  bool CompareName(const Waypoint &waypoint) const;
 };
@@ -14,88 +14,201 @@
 #include "system/Path.hpp"
 #include "io/MapFile.hpp"
 #include "io/ZipArchive.hpp"
+#include "io/FileCache.hpp"
+#include "io/BufferedOutputStream.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/Reader.hxx"
+#include "io/FileOutputStream.hxx"
+#include "WaypointCache.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
 
 namespace WaypointGlue {
 
+static std::vector<Waypoint>
+LoadCache(FileCache &cache, const TCHAR *name, Path original_path,
+          std::string_view key)
+{
+  auto r = cache.Load(name, original_path);
+  if (!r)
+    return {};
+
+  BufferedReader br(*r);
+  return LoadWaypointCache(br, key);
+}
+
+static void
+SaveCache(FileCache &cache, const TCHAR *name, Path original_path,
+          std::string_view key, const std::vector<WaypointPtr> &waypoints)
+{
+  auto os = cache.Save(name, original_path);
+  BufferedOutputStream bos(*os);
+  SaveWaypointCache(bos, key, waypoints);
+  bos.Flush();
+  os->Commit();
+}
+
+/**
+ * Append a waypoint from the cache, looking up its elevation in the
+ * terrain if the file has none.  That fallback is not part of the
+ * snapshot, because it depends on the terrain file.
+ */
+static void
+AppendWaypoint(Waypoints &waypoints, Waypoint &&wp,
+               const WaypointFactory &factory) noexcept
+{
+  if (!wp.has_elevation)
+    factory.FallbackElevation(wp);
+
+  waypoints.Append(std::move(wp));
+}
+
+/**
+ * Load the waypoints of one file from the #FileCache, or parse the
+ * file and store the result in the cache.
+ *
+ * @param cache_name the name of the cache file for this source
+ * @param original_path the file whose modification time and size
+ * validate the cache
+ * @param key identifies the source within the cache file (a change
+ * of the configured path invalidates the cache)
+ * @param parse parses the file into the given #Waypoints object with
+ * the given #WaypointFactory; throws on error
+ */
+template<typename P>
 static bool
-LoadWaypointFile(Waypoints &waypoints, Path path,
-                 WaypointFileType file_type,
-                 WaypointOrigin origin,
-                 const RasterTerrain *terrain,
-                 ProgressListener &progress) noexcept
+LoadWaypointFile(Waypoints &waypoints, FileCache *cache,
+                 const TCHAR *cache_name, Path original_path,
+                 const std::string &key, WaypointOrigin origin,
+                 const RasterTerrain *terrain, P &&parse)
 try {
-  ReadWaypointFile(path, file_type, waypoints,
-                   WaypointFactory(origin, terrain),
-                   progress);
+  const WaypointFactory factory(origin, terrain);
+
+  if (cache == nullptr) {
+    parse(waypoints, factory);
+    return true;
+  }
+
+  try {
+    auto cached = LoadCache(*cache, cache_name, original_path, key);
+    if (!cached.empty()) {
+      for (auto &i : cached)
+        AppendWaypoint(waypoints, std::move(i), factory);
+      return true;
+    }
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to load waypoint cache");
+  }
+
+  /* parse without terrain into a separate container to collect this
+     file's waypoints for the cache */
+  Waypoints parsed;
+  parse(parsed, WaypointFactory(origin));
+
+  /* restore the file order, so the waypoint ids are the same as
+     without the cache */
+  std::vector<WaypointPtr> result{parsed.begin(), parsed.end()};
+  std::sort(result.begin(), result.end(),
+            [](const WaypointPtr &a, const WaypointPtr &b){
+              return a->id < b->id;
+            });
+
+  if (!result.empty()) {
+    try {
+      SaveCache(*cache, cache_name, original_path, key, result);
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to save waypoint cache");
+    }
+  }
+
+  for (const auto &i : result)
+    AppendWaypoint(waypoints, Waypoint{*i}, factory);
+
   return true;
 } catch (...) {
-  LogFormat(_T("Failed to read waypoint file: %s"), path.c_str());
+  LogFormat("Failed to read waypoint file: %s", key.c_str());
   LogError(std::current_exception());
   return false;
 }
 
 static bool
-LoadWaypointFile(Waypoints &waypoints, Path path,
+LoadWaypointFile(Waypoints &waypoints, FileCache *cache,
+                 const TCHAR *cache_name, Path path,
+                 WaypointFileType file_type, WaypointOrigin origin,
+                 const RasterTerrain *terrain,
+                 ProgressListener &progress) noexcept
+{
+  return LoadWaypointFile(waypoints, cache, cache_name, path,
+                          path.ToUTF8(), origin, terrain,
+                          [&](Waypoints &dest, WaypointFactory factory){
+                            ReadWaypointFile(path, file_type, dest,
+                                             factory, progress);
+                          });
+}
+
+static bool
+LoadWaypointFile(Waypoints &waypoints, FileCache *cache,
+                 const TCHAR *cache_name, Path path,
                  WaypointOrigin origin,
                  const RasterTerrain *terrain,
                  ProgressListener &progress) noexcept
-try {
-  ReadWaypointFile(path, waypoints,
-                   WaypointFactory(origin, terrain),
-                   progress);
-  return true;
-} catch (...) {
-  LogFormat(_T("Failed to read waypoint file: %s"), path.c_str());
-  LogError(std::current_exception());
-  return false;
+{
+  return LoadWaypointFile(waypoints, cache, cache_name, path,
+                          DetermineWaypointFileType(path), origin,
+                          terrain, progress);
 }
 
 static bool
-LoadWaypointFile(Waypoints &waypoints, struct zzip_dir *dir, const char *path,
+LoadWaypointFile(Waypoints &waypoints, FileCache *cache,
+                 const TCHAR *cache_name, Path map_path,
+                 struct zzip_dir *dir, const char *path,
                  WaypointFileType file_type,
                  WaypointOrigin origin,
                  const RasterTerrain *terrain,
-                 ProgressListener &progressg) noexcept
-try {
-  ReadWaypointFile(dir, path, file_type, waypoints,
-                   WaypointFactory(origin, terrain),
-                   progressg);
-  return true;
-} catch (...) {
-  LogFormat(_T("Failed to read waypoint file: %s"), path);
-  LogError(std::current_exception());
-  return false;
+                 ProgressListener &progress) noexcept
+{
+  return LoadWaypointFile(waypoints, cache, cache_name, map_path,
+                          map_path.ToUTF8() + "/" + path, origin, terrain,
+                          [&](Waypoints &dest, WaypointFactory factory){
+                            ReadWaypointFile(dir, path, file_type, dest,
+                                             factory, progress);
+                          });
 }
 
 bool
 LoadWaypoints(Waypoints &way_points, const RasterTerrain *terrain,
-              ProgressListener &progress)
+              FileCache *cache, ProgressListener &progress)
 {
   bool found = false;
 
   // Delete old waypoints
   way_points.Clear();
 
-  LoadWaypointFile(way_points, LocalPath(_T("user.cup")),
+  LoadWaypointFile(way_points, cache, _T("waypoints_user"),
+                   LocalPath(_T("user.cup")),
                    WaypointFileType::SEEYOU,
                    WaypointOrigin::USER, terrain, progress);
 
   // ### FIRST FILE ###
   auto path = Profile::GetPath(ProfileKeys::WaypointFile);
   if (path != nullptr)
-    found |= LoadWaypointFile(way_points, path, WaypointOrigin::PRIMARY,
-                              terrain, progress);
+    found |= LoadWaypointFile(way_points, cache, _T("waypoints"), path,
+                              WaypointOrigin::PRIMARY, terrain, progress);
 
   // ### SECOND FILE ###
   path = Profile::GetPath(ProfileKeys::AdditionalWaypointFile);
   if (path != nullptr)
-    found |= LoadWaypointFile(way_points, path, WaypointOrigin::ADDITIONAL,
+    found |= LoadWaypointFile(way_points, cache, _T("waypoints_additional"),
+                              path, WaypointOrigin::ADDITIONAL,
                               terrain, progress);
 
   // ### WATCHED WAYPOINT/THIRD FILE ###
   path = Profile::GetPath(ProfileKeys::WatchedWaypointFile);
   if (path != nullptr)
-    found |= LoadWaypointFile(way_points, path, WaypointOrigin::WATCHED,
+    found |= LoadWaypointFile(way_points, cache, _T("waypoints_watched"),
+                              path, WaypointOrigin::WATCHED,
                               terrain, progress);
 
   // ### MAP/FOURTH FILE ###
@@ -104,12 +217,16 @@ LoadWaypoints(Waypoints &way_points, const RasterTerrain *terrain,
   if (!found) {
     try {
       if (auto archive = OpenMapFile()) {
-        found |= LoadWaypointFile(way_points, archive->get(), "waypoints.xcw",
+        const auto map_path = Profile::GetPath(ProfileKeys::MapFile);
+
+        found |= LoadWaypointFile(way_points, cache, _T("waypoints_map_xcw"),
+                                  map_path, archive->get(), "waypoints.xcw",
                                   WaypointFileType::WINPILOT,
                                   WaypointOrigin::MAP,
                                   terrain, progress);
 
-        found |= LoadWaypointFile(way_points, archive->get(), "waypoints.cup",
+        found |= LoadWaypointFile(way_points, cache, _T("waypoints_map_cup"),
+                                  map_path, archive->get(), "waypoints.cup",
                                   WaypointFileType::SEEYOU,
                                   WaypointOrigin::MAP,
                                   terrain, progress);
@@ -127,4 +244,30 @@ LoadWaypoints(Waypoints &way_points, const RasterTerrain *terrain,
   return found;
 }
 
+unsigned
+FillElevations(Waypoints &way_points, const RasterTerrain &terrain) noexcept
+{
+  /* collect them first, because Replace() modifies the tree */
+  std::vector<WaypointPtr> missing;
+  for (const auto &wp : way_points)
+    if (!wp->has_elevation)
+      missing.push_back(wp);
+
+  const WaypointFactory factory(WaypointOrigin::NONE, &terrain);
+
+  unsigned n = 0;
+  for (const auto &wp : missing) {
+    Waypoint copy = *wp;
+    if (factory.FallbackElevation(copy)) {
+      way_points.Replace(wp, std::move(copy));
+      ++n;
+    }
+  }
+
+  if (n > 0)
+    way_points.Optimise();
+
+  return n;
+}
+
 } // namespace WaypointGlue
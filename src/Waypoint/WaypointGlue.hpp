@@ -12,6 +12,7 @@ struct PlacesOfInterestSettings;
 struct TeamCodeSettings;
 class DeviceBlackboard;
 class ProfileMap;
+class FileCache;
 
 /**
  * This class is used to parse different waypoint files
@@ -86,12 +87,25 @@ SaveHome(ProfileMap &profile,
  * specified waypoint list
  * @param way_points The waypoint list to fill
  * @param terrain RasterTerrain (for automatic waypoint height)
+ * @param cache an optional #FileCache for binary snapshots of the
+ * parsed files
  */
 bool
 LoadWaypoints(Waypoints &way_points,
               const RasterTerrain *terrain,
+              FileCache *cache,
               ProgressListener &progress);
 
+/**
+ * Look up the elevation of all waypoints which have none in the
+ * terrain.  This is used when the waypoints have been loaded before
+ * the terrain was available.
+ *
+ * @return the number of waypoints which were updated
+ */
+unsigned
+FillElevations(Waypoints &way_points, const RasterTerrain &terrain) noexcept;
+
 /**
  * Append one waypoint to the file "user.cup".
  *
@@ -10,9 +10,10 @@ void
 WaypointListBuilder::Visit(const Waypoints &waypoints) noexcept
 {
   if (filter.distance > 0)
-    waypoints.VisitWithinRange(location, filter.distance, *this);
+    waypoints.VisitNameMatchesWithinRange(filter.name, location,
+                                          filter.distance, *this);
   else
-    waypoints.VisitNamePrefix(filter.name, *this);
+    waypoints.VisitNameMatches(filter.name, *this);
 }
 
 inline void
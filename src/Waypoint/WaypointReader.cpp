@@ -10,7 +10,8 @@
 #include "WaypointReaderCompeGPS.hpp"
 #include "WaypointFileType.hpp"
 #include "io/ZipLineReader.hpp"
-#include "io/FileLineReader.hpp"
+#include "io/MappedLineReader.hpp"
+#include "system/Path.hpp"
 
 #include <memory>
 
@@ -53,7 +54,7 @@ ReadWaypointFile(Path path, WaypointFileType file_type,
   if (!reader)
     throw std::runtime_error{"Unrecognised waypoint file"};
 
-  FileLineReader line_reader(path, Charset::AUTO);
+  MappedFileLineReader line_reader(path, Charset::AUTO);
   reader->Parse(way_points, line_reader, progress);
 }
 
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "NOAABatch.hpp"
+#include "time/BrokenDateTime.hpp"
+#include "time/Calendar.hxx"
+#include "util/CharUtil.hxx"
+#include "util/StringStrip.hxx"
+
+#include <algorithm>
+
+namespace NOAABatch {
+
+std::string_view
+RecordSplitter::Next() noexcept
+{
+  /* skip empty lines */
+  while (!rest.empty() && IsWhitespaceOrNull(rest.front()))
+    rest.remove_prefix(1);
+
+  std::size_t end = 0;
+  while (end < rest.size()) {
+    const auto newline = rest.find('\n', end);
+    if (newline == rest.npos) {
+      end = rest.size();
+      break;
+    }
+
+    end = newline + 1;
+
+    /* a line which does not begin with a blank starts a new report;
+       an empty line ends the report */
+    if (end >= rest.size() || rest[end] == '\n' || rest[end] == '\r' ||
+        (rest[end] != ' ' && rest[end] != '\t'))
+      break;
+  }
+
+  const auto record = StripRight(rest.substr(0, end));
+  rest.remove_prefix(end);
+  return record;
+}
+
+bool
+Header::IsSameTime(const BrokenDateTime &t) const noexcept
+{
+  return t.day == day && t.hour == hour && t.minute == minute;
+}
+
+BrokenDateTime
+Header::ToDateTime(const BrokenDateTime &now) const noexcept
+{
+  unsigned year = now.year, month = now.month;
+  if (day > now.day) {
+    /* issued last month */
+    if (--month == 0) {
+      month = 12;
+      --year;
+    }
+  }
+
+  return BrokenDateTime(year, month,
+                        std::min(day, DaysInMonth(month, year)),
+                        hour, minute, 0);
+}
+
+/**
+ * Cut the first white space separated token off the string.
+ */
+static std::string_view
+NextToken(std::string_view &s) noexcept
+{
+  s = StripLeft(s);
+
+  const auto end = std::find_if(s.begin(), s.end(), IsWhitespaceOrNull);
+  const std::string_view token{s.begin(), end};
+  s = {end, s.end()};
+  return token;
+}
+
+static constexpr bool
+IsCodeChar(char ch) noexcept
+{
+  return IsUpperAlphaASCII(ch) || IsDigitASCII(ch);
+}
+
+bool
+ParseHeader(std::string_view record, Header &header) noexcept
+{
+  std::string_view token;
+
+  /* skip the report type and modifiers */
+  do {
+    token = NextToken(record);
+  } while (token == "METAR" || token == "SPECI" || token == "TAF" ||
+           token == "AMD" || token == "COR");
+
+  if (token.size() != 4 || !std::all_of(token.begin(), token.end(), IsCodeChar))
+    return false;
+
+  std::copy(token.begin(), token.end(), header.code);
+  header.code[4] = 0;
+
+  /* the issue time "DDHHMMZ" */
+  token = NextToken(record);
+  if (token.size() != 7 || token[6] != 'Z' ||
+      !std::all_of(token.begin(), token.begin() + 6, IsDigitASCII))
+    return false;
+
+  header.day = (token[0] - '0') * 10 + (token[1] - '0');
+  header.hour = (token[2] - '0') * 10 + (token[3] - '0');
+  header.minute = (token[4] - '0') * 10 + (token[5] - '0');
+
+  return header.day >= 1 && header.day <= 31 &&
+    header.hour < 24 && header.minute < 60;
+}
+
+} // namespace NOAABatch
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <string_view>
+
+struct BrokenDateTime;
+
+/**
+ * Helpers for responses which contain the raw reports of many
+ * stations, one per record (e.g. from the aviationweather.gov data
+ * API with "format=raw").
+ */
+namespace NOAABatch {
+
+/**
+ * Splits a response into reports.  A report starts at a line which
+ * does not begin with white space; indented lines (e.g. the groups of
+ * a multi-line TAF) belong to the preceding report.
+ */
+class RecordSplitter {
+  std::string_view rest;
+
+public:
+  explicit constexpr RecordSplitter(std::string_view body) noexcept
+    :rest(body) {}
+
+  /**
+   * @return the next report without trailing white space, or an
+   * empty string at the end
+   */
+  std::string_view Next() noexcept;
+};
+
+/**
+ * The station and the issue time of a report.
+ */
+struct Header {
+  char code[5];
+
+  unsigned day, hour, minute;
+
+  /**
+   * Does the given time (UTC) match this report's issue time?
+   */
+  [[gnu::pure]]
+  bool IsSameTime(const BrokenDateTime &t) const noexcept;
+
+  /**
+   * Convert the issue time to a full date, assuming the report was
+   * issued at most one month before #now.
+   */
+  [[gnu::pure]]
+  BrokenDateTime ToDateTime(const BrokenDateTime &now) const noexcept;
+};
+
+/**
+ * Parse the station code and the issue time of a METAR or TAF, e.g.
+ * "EDDL 201950Z 22009KT ..." or "TAF AMD EDDL 011100Z 0112/0218 ...".
+ */
+bool
+ParseHeader(std::string_view record, Header &header) noexcept;
+
+} // namespace NOAABatch
@@ -4,6 +4,7 @@
 #include "NOAADownloader.hpp"
 #include "METAR.hpp"
 #include "TAF.hpp"
+#include "Stats.hpp"
 #include "net/http/Progress.hpp"
 #include "lib/curl/Easy.hxx"
 #include "lib/curl/CoRequest.hxx"
@@ -21,8 +22,12 @@ CoGet(CurlGlobal &curl, const char *url, ProgressListener &progress)
   const Net::ProgressAdapter progress_adapter{easy, progress};
   easy.SetFailOnError();
 
+  WeatherStats::Timer timer{WeatherStage::NOAA_DOWNLOAD};
+
   // TODO limit the response body size
-  co_return co_await Curl::CoRequest(curl, std::move(easy));
+  auto response = co_await Curl::CoRequest(curl, std::move(easy));
+  timer.Succeed(response.body.size());
+  co_return response;
 }
 
 namespace NOAADownloader {
@@ -295,3 +300,43 @@ NOAADownloader::DownloadTAF(const char *code, CurlGlobal &curl,
 
   co_return taf;
 }
+
+/**
+ * Download the raw reports of the given stations from the
+ * aviationweather.gov data API.
+ */
+static Co::Task<std::string>
+DownloadBatch(const char *product, std::span<const char *const> codes,
+              CurlGlobal &curl, ProgressListener &progress)
+{
+  assert(!codes.empty());
+
+  std::string url = "https://aviationweather.gov/api/data/";
+  url += product;
+  url += "?format=raw&ids=";
+
+  for (const char *code : codes) {
+    assert(strlen(code) == 4);
+
+    if (url.back() != '=')
+      url += ',';
+    url += code;
+  }
+
+  auto response = co_await CoGet(curl, url.c_str(), progress);
+  co_return std::move(response.body);
+}
+
+Co::Task<std::string>
+NOAADownloader::DownloadMETARs(std::span<const char *const> codes,
+                               CurlGlobal &curl, ProgressListener &progress)
+{
+  return DownloadBatch("metar", codes, curl, progress);
+}
+
+Co::Task<std::string>
+NOAADownloader::DownloadTAFs(std::span<const char *const> codes,
+                             CurlGlobal &curl, ProgressListener &progress)
+{
+  return DownloadBatch("taf", codes, curl, progress);
+}
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <span>
+#include <string>
+
 struct METAR;
 struct TAF;
 class CurlGlobal;
@@ -32,4 +35,28 @@ Co::Task<TAF>
 DownloadTAF(const char *code, CurlGlobal &curl,
             ProgressListener &progress);
 
+/**
+ * Downloads the raw METARs of all given stations with one request.
+ * The response contains one report per line (see #NOAABatch); it may
+ * lack stations which have no recent METAR.
+ *
+ * Throws on error.
+ *
+ * @param codes Four letter codes of the airports (upper case)
+ */
+Co::Task<std::string>
+DownloadMETARs(std::span<const char *const> codes, CurlGlobal &curl,
+               ProgressListener &progress);
+
+/**
+ * Downloads the raw TAFs of all given stations with one request.
+ *
+ * Throws on error.
+ *
+ * @param codes Four letter codes of the airports (upper case)
+ */
+Co::Task<std::string>
+DownloadTAFs(std::span<const char *const> codes, CurlGlobal &curl,
+             ProgressListener &progress);
+
 } // namespace NOAADownloader
@@ -3,46 +3,144 @@
 
 #include "NOAAUpdater.hpp"
 #include "NOAADownloader.hpp"
+#include "NOAABatch.hpp"
 #include "METARParser.hpp"
 #include "co/Task.hxx"
 #include "LogFile.hpp"
 
-Co::Task<bool>
-NOAAUpdater::Update(NOAAStore::Item &item,
-                    CurlGlobal &curl, ProgressListener &progress) noexcept
-{
-  bool metar_downloaded = false, taf_downloaded = false;
+#include <map>
+#include <string>
+#include <vector>
 
+static Co::Task<bool>
+UpdateMETAR(NOAAStore::Item &item,
+            CurlGlobal &curl, ProgressListener &progress) noexcept
+{
   try {
     item.metar = co_await NOAADownloader::DownloadMETAR(item.code,
                                                         curl, progress);
     item.metar_available = true;
-    metar_downloaded = true;
 
     if (METARParser::Parse(item.metar, item.parsed_metar))
       item.parsed_metar_available = true;
+
+    co_return true;
   } catch (...) {
     LogError(std::current_exception());
+    co_return false;
   }
+}
 
+static Co::Task<bool>
+UpdateTAF(NOAAStore::Item &item,
+          CurlGlobal &curl, ProgressListener &progress) noexcept
+{
   try {
     item.taf = co_await NOAADownloader::DownloadTAF(item.code, curl, progress);
     item.taf_available = true;
-    taf_downloaded = true;
+    co_return true;
   } catch (...) {
     LogError(std::current_exception());
+    co_return false;
   }
+}
 
+Co::Task<bool>
+NOAAUpdater::Update(NOAAStore::Item &item,
+                    CurlGlobal &curl, ProgressListener &progress) noexcept
+{
+  const bool metar_downloaded = co_await UpdateMETAR(item, curl, progress);
+  const bool taf_downloaded = co_await UpdateTAF(item, curl, progress);
   co_return metar_downloaded && taf_downloaded;
 }
 
+/**
+ * Parse a batch response.
+ *
+ * @return the reports by station code
+ */
+static std::map<std::string, std::pair<NOAABatch::Header, std::string_view>,
+                std::less<>>
+ParseBatch(std::string_view body) noexcept
+{
+  std::map<std::string, std::pair<NOAABatch::Header, std::string_view>,
+           std::less<>> result;
+
+  NOAABatch::RecordSplitter records{body};
+  std::string_view record;
+  while (!(record = records.Next()).empty()) {
+    NOAABatch::Header header;
+    if (NOAABatch::ParseHeader(record, header))
+      /* the API lists the newest report first */
+      result.try_emplace(header.code, header, record);
+  }
+
+  return result;
+}
+
 Co::Task<bool>
 NOAAUpdater::Update(NOAAStore &store, CurlGlobal &curl,
                     ProgressListener &progress) noexcept
 {
+  std::vector<const char *> codes;
+  for (const auto &i : store)
+    codes.push_back(i.code);
+
+  if (codes.empty())
+    co_return true;
+
   bool result = true;
-  for (auto &i : store)
-    result = co_await Update(i, curl, progress) && result;
+
+  /* the batch only tells which METARs have changed; these are then
+     downloaded one by one, because only the per-station file has the
+     decoded text with the station name and location */
+  std::string metars;
+  try {
+    metars = co_await NOAADownloader::DownloadMETARs(codes, curl, progress);
+  } catch (...) {
+    LogError(std::current_exception());
+  }
+
+  const auto new_metars = ParseBatch(metars);
+  for (auto &i : store) {
+    if (i.metar_available) {
+      auto m = new_metars.find(std::string_view{i.code});
+      if (m != new_metars.end() &&
+          m->second.first.IsSameTime(i.metar.last_update))
+        /* unchanged */
+        continue;
+    }
+
+    result = co_await UpdateMETAR(i, curl, progress) && result;
+  }
+
+  /* the raw TAF is all we need; the per-station file is only a
+     fallback for stations which were not in the batch response */
+  std::string tafs;
+  try {
+    tafs = co_await NOAADownloader::DownloadTAFs(codes, curl, progress);
+  } catch (...) {
+    LogError(std::current_exception());
+  }
+
+  const auto new_tafs = ParseBatch(tafs);
+  const auto now = BrokenDateTime::NowUTC();
+  for (auto &i : store) {
+    auto t = new_tafs.find(std::string_view{i.code});
+    if (t == new_tafs.end()) {
+      result = co_await UpdateTAF(i, curl, progress) && result;
+      continue;
+    }
+
+    const auto &[header, content] = t->second;
+    if (i.taf_available && header.IsSameTime(i.taf.last_update))
+      /* unchanged */
+      continue;
+
+    i.taf.last_update = header.ToDateTime(now);
+    i.taf.content.SetASCII(content);
+    i.taf_available = true;
+  }
 
   co_return result;
 }
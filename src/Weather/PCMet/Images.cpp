@@ -3,6 +3,7 @@
 
 #include "Images.hpp"
 #include "Settings.hpp"
+#include "Weather/Stats.hpp"
 #include "net/http/CoDownloadToFile.hpp"
 #include "net/http/Progress.hpp"
 #include "lib/curl/CoRequest.hxx"
@@ -102,8 +103,12 @@ CoGet(CurlGlobal &curl, const char *url,
   if (password != nullptr)
     easy.SetOption(CURLOPT_PASSWORD, password);
 
+  WeatherStats::Timer timer{WeatherStage::PCMET_DOWNLOAD};
+
   // TODO limit the response body size
-  co_return co_await Curl::CoRequest(curl, std::move(easy));
+  auto response = co_await Curl::CoRequest(curl, std::move(easy));
+  timer.Succeed(response.body.size());
+  co_return response;
 }
 
 Co::Task<AllocatedPath>
@@ -152,9 +157,11 @@ PCMet::DownloadLatestImage(const char *type, const char *area,
     // to the latest image and the namelist array of all stored images
     snprintf(url, sizeof(url), PCMET_URI "%.*s", int(src.size()), src.data());
 
+    WeatherStats::Timer timer{WeatherStage::PCMET_DOWNLOAD};
     const auto ignored_response = co_await
       Net::CoDownloadToFile(curl, url, username, password,
                             path, nullptr, progress);
+    timer.Succeed(File::GetSize(path));
   }
 
   co_return std::move(path);
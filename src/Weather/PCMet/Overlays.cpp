@@ -3,6 +3,7 @@
 
 #include "Overlays.hpp"
 #include "Settings.hpp"
+#include "Weather/Stats.hpp"
 #include "ui/canvas/Bitmap.hpp"
 #include "net/http/CoDownloadToFile.hpp"
 #include "Job/Runner.hpp"
@@ -135,11 +136,13 @@ PCMet::DownloadOverlay(const OverlayInfo &info, BrokenDateTime now_utc,
     const WideToUTF8Converter username(settings.ftp_credentials.username);
     const WideToUTF8Converter password(settings.ftp_credentials.password);
 
+    WeatherStats::Timer timer{WeatherStage::PCMET_DOWNLOAD};
     const auto ignored_response = co_await
       Net::CoDownloadToFile(curl, url,
                             username, password,
                             path, nullptr,
                             progress);
+    timer.Succeed(File::GetSize(path));
   }
 
   BrokenDateTime run_time(now_utc.GetDate(), BrokenTime(run_hour, 0));
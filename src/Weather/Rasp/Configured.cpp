@@ -6,6 +6,7 @@
 #include "Profile/Keys.hpp"
 #include "Profile/Profile.hpp"
 #include "LocalPath.hpp"
+#include "Components.hpp"
 
 std::shared_ptr<RaspStore>
 LoadConfiguredRasp() noexcept
@@ -17,6 +18,6 @@ LoadConfiguredRasp() noexcept
     path = LocalPath(_T(RASP_FILENAME));
 
   auto rasp = std::make_shared<RaspStore>(std::move(path));
-  rasp->ScanAll();
+  rasp->ScanAll(file_cache);
   return rasp;
 }
@@ -5,25 +5,98 @@
 #include "RaspStore.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "Terrain/Loader.hpp"
+#include "Weather/SampleGrid.hpp"
+#include "Weather/Stats.hpp"
+#include "util/tstring.hpp"
 #include "Language/Language.hpp"
 #include "system/Path.hpp"
 #include "io/ZipArchive.hpp"
 #include "LogFile.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include <cassert>
 #include <windef.h> // for MAX_PATH
 
 RaspCache::RaspCache(const RaspStore &_store, unsigned _parameter) noexcept
   :store(_store), parameter(_parameter) {}
 
-RaspCache::~RaspCache() noexcept = default;
-
 static constexpr unsigned
 ToQuarterHours(BrokenTime t)
 {
   return t.hour * 4u + t.minute / 15;
 }
 
+static tstring
+MakeSampleKey(const RaspStore &store, unsigned parameter) noexcept
+{
+  return tstring{_T("rasp/")} + store.GetItemInfo(parameter).name.c_str();
+}
+
+/**
+ * Sample the map into a #WeatherSampleGrid, at most #MAX_SIZE cells
+ * in each direction (RASP grids are usually much smaller).
+ */
+static std::shared_ptr<const WeatherSampleGrid>
+MakeSampleGrid(const RasterMap &map,
+               std::chrono::system_clock::time_point time) noexcept
+{
+  static constexpr unsigned MAX_SIZE = 256;
+
+  const auto size = map.GetTileCache().GetSize();
+  const unsigned width = std::clamp(size.x, 1u, MAX_SIZE);
+  const unsigned height = std::clamp(size.y, 1u, MAX_SIZE);
+
+  const GeoBounds &bounds = map.GetBounds();
+  const Angle cell_width = bounds.GetWidth() / width;
+  const Angle cell_height = bounds.GetHeight() / height;
+
+  std::vector<GeoPoint> locations;
+  locations.reserve(std::size_t(width) * height);
+  for (unsigned y = 0; y < height; ++y)
+    for (unsigned x = 0; x < width; ++x)
+      locations.emplace_back(bounds.GetWest() + cell_width * (x + 0.5),
+                             bounds.GetNorth() - cell_height * (y + 0.5));
+
+  std::vector<TerrainHeight> heights(locations.size());
+  map.GetHeights(locations, heights);
+
+  std::vector<int16_t> values;
+  values.reserve(heights.size());
+  for (const auto h : heights)
+    values.push_back(h.IsSpecial()
+                     ? TerrainHeight::Invalid().GetValue()
+                     : h.GetValue());
+
+  return std::make_shared<WeatherSampleGrid>(bounds, width, height,
+                                             std::move(values), 1, 0,
+                                             TerrainHeight::Invalid().GetValue(),
+                                             time);
+}
+
+/**
+ * Convert a time index to a time point, assuming it refers to the
+ * current day.
+ */
+[[gnu::pure]]
+static std::chrono::system_clock::time_point
+ToTimePoint(unsigned time_index, BrokenTime time_local) noexcept
+{
+  const auto now = std::chrono::system_clock::now();
+  if (!time_local.IsPlausible())
+    return now;
+
+  return now + std::chrono::minutes{15} *
+    (int(time_index) - int(ToQuarterHours(time_local)));
+}
+
+RaspCache::~RaspCache() noexcept
+{
+  if (!maps.empty())
+    WeatherSamples::Remove(MakeSampleKey(store, parameter).c_str());
+}
+
 const TCHAR *
 RaspCache::GetMapName() const
 {
@@ -85,7 +158,19 @@ RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
   if (effective_time == RaspStore::MAX_WEATHER_TIMES)
     return;
 
-  map.reset();
+  map = nullptr;
+
+  for (auto i = maps.begin(); i != maps.end(); ++i) {
+    if (i->time == effective_time) {
+      /* move to the front */
+      maps.splice(maps.begin(), maps, i);
+      map = i->map.get();
+      map_time = effective_time;
+      WeatherSamples::Publish(MakeSampleKey(store, parameter).c_str(),
+                              i->grid);
+      return;
+    }
+  }
 
   auto archive = store.OpenArchive();
   if (!archive)
@@ -97,9 +182,11 @@ RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
 
   auto new_map = std::make_unique<RasterMap>();
   try {
+    WeatherStats::Timer timer{WeatherStage::RASP_LOAD};
     LoadTerrainOverview(archive->get(), new_name, nullptr,
                         new_map->GetTileCache(),
                         true, operation);
+    timer.Succeed();
   } catch (...) {
     LogError(std::current_exception(), "Failed to load RASP file");
     return;
@@ -107,5 +194,14 @@ RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
 
   new_map->UpdateProjection();
 
-  map = std::move(new_map);
+  if (maps.size() >= MAX_MAPS)
+    maps.pop_back();
+
+  auto grid = MakeSampleGrid(*new_map,
+                             ToTimePoint(effective_time, time_local));
+  WeatherSamples::Publish(MakeSampleKey(store, parameter).c_str(), grid);
+
+  map = new_map.get();
+  map_time = effective_time;
+  maps.push_front({effective_time, std::move(new_map), std::move(grid)});
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
 
 #include <tchar.h>
@@ -11,13 +12,22 @@ struct BrokenTime;
 struct GeoPoint;
 class RaspStore;
 class RasterMap;
+class WeatherSampleGrid;
 class OperationEnvironment;
 
 /**
  * Class to manage the raster weather map, to be loaded/selected from
  * a #RaspStore instance.
+ *
+ * The most recently used maps are kept, so paging through the times
+ * does not load the same file again.
  */
 class RaspCache {
+  /**
+   * The number of maps kept in memory.
+   */
+  static constexpr std::size_t MAX_MAPS = 4;
+
   const RaspStore &store;
 
   const unsigned parameter;
@@ -25,7 +35,35 @@ class RaspCache {
   unsigned time = 0;
   unsigned last_time = 0;
 
-  std::unique_ptr<RasterMap> map;
+  struct Item {
+    /**
+     * The time index of the file.
+     */
+    unsigned time;
+
+    std::unique_ptr<RasterMap> map;
+
+    /**
+     * The values of #map, published to #WeatherSamples when this
+     * becomes the current map.
+     */
+    std::shared_ptr<const WeatherSampleGrid> grid;
+  };
+
+  /**
+   * The loaded maps, the most recently used one first.
+   */
+  std::list<Item> maps;
+
+  /**
+   * The current map (an element of #maps) or nullptr.
+   */
+  const RasterMap *map = nullptr;
+
+  /**
+   * The time index of #map.
+   */
+  unsigned map_time = 0;
 
 public:
   RaspCache(const RaspStore &_store, unsigned _parameter) noexcept;
@@ -37,7 +75,16 @@ public:
 
   [[gnu::pure]]
   const RasterMap *GetMap() const {
-    return map.get();
+    return map;
+  }
+
+  /**
+   * Returns the time index of the file GetMap() was loaded from.
+   * Two maps with the same time index have the same contents.
+   */
+  [[gnu::pure]]
+  unsigned GetMapTime() const {
+    return map_time;
   }
 
   /**
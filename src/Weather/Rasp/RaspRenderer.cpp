@@ -21,6 +21,23 @@ LookupWeatherTerrainStyle(const TCHAR *name)
   return *i;
 }
 
+RaspRenderer::Frame &
+RaspRenderer::MakeFrame(unsigned time) noexcept
+{
+  for (auto i = frames.begin(); i != frames.end(); ++i) {
+    if (i->time == time) {
+      /* move to the front */
+      frames.splice(frames.begin(), frames, i);
+      return *i;
+    }
+  }
+
+  if (frames.size() >= MAX_FRAMES)
+    frames.pop_back();
+
+  return frames.emplace_front(time);
+}
+
 bool
 RaspRenderer::Generate(const WindowProjection &projection,
                        const TerrainRendererSettings &settings)
@@ -35,16 +52,40 @@ RaspRenderer::Generate(const WindowProjection &projection,
   if (map == nullptr)
     return false;
 
-  if (!map->GetBounds().Overlaps(projection.GetScreenBounds()))
+  GeoBounds new_bounds = projection.GetScreenBounds();
+  if (!new_bounds.IntersectWith(map->GetBounds()))
     /* not visible */
     return false;
 
-  if (color_ramp != last_color_ramp) {
+  Frame &frame = MakeFrame(cache.GetMapTime());
+  RasterRenderer &raster_renderer = frame.raster_renderer;
+
+  const bool same_style = color_ramp == frame.color_ramp &&
+    settings.contrast == frame.contrast &&
+    settings.brightness == frame.brightness;
+
+#ifdef ENABLE_OPENGL
+  if (same_style && raster_renderer.Covers(new_bounds) &&
+      !raster_renderer.UpdateQuantisation())
+    /* the image of this time is still good */
+    return true;
+#else
+  if (same_style && frame.compare_projection.Compare(projection))
+    /* no change since this time was shown last */
+    return true;
+
+  frame.compare_projection = CompareProjection(projection);
+#endif
+
+  if (color_ramp != frame.color_ramp) {
     raster_renderer.PrepareColorTable(color_ramp, do_water,
                                       height_scale, interp_levels);
-    last_color_ramp = color_ramp;
+    frame.color_ramp = color_ramp;
   }
 
+  frame.contrast = settings.contrast;
+  frame.brightness = settings.brightness;
+
   raster_renderer.ScanMap(*map, projection);
 
   raster_renderer.GenerateImage(false, height_scale,
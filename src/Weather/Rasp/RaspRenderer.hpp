@@ -11,18 +11,60 @@
 #include "Projection/CompareProjection.hpp"
 #endif
 
+#include <list>
+
 struct TerrainRendererSettings;
 
 class RaspRenderer {
+  /**
+   * The number of colour-mapped images kept for recently shown
+   * times.
+   */
+  static constexpr std::size_t MAX_FRAMES = 3;
+
   RaspCache cache;
 
-  RasterRenderer raster_renderer;
+  /**
+   * The image of one RASP time.  It is kept while the map is panned
+   * and zoomed a little and while other times are shown, and is
+   * generated again only if it does not cover the screen anymore.
+   */
+  struct Frame {
+    /**
+     * See RaspCache::GetMapTime().
+     */
+    unsigned time;
+
+    RasterRenderer raster_renderer;
 
 #ifndef ENABLE_OPENGL
-  CompareProjection compare_projection;
+    CompareProjection compare_projection;
+#endif
+
+    const ColorRamp *color_ramp = nullptr;
+
+    int contrast = 0, brightness = 0;
+
+    explicit Frame(unsigned _time) noexcept:time(_time) {}
+
+    void Invalidate() noexcept {
+#ifdef ENABLE_OPENGL
+      raster_renderer.Invalidate();
+#else
+      compare_projection.Clear();
 #endif
+    }
+  };
+
+  /**
+   * The most recently used frame first.
+   */
+  std::list<Frame> frames;
 
-  const ColorRamp *last_color_ramp = nullptr;
+  /**
+   * Obtain the frame for the given time, creating it if necessary.
+   */
+  Frame &MakeFrame(unsigned time) noexcept;
 
 public:
   RaspRenderer(const RaspStore &_store, unsigned parameter)
@@ -32,11 +74,8 @@ public:
    * Flush the cache.
    */
   void Flush() {
-#ifdef ENABLE_OPENGL
-    raster_renderer.Invalidate();
-#else
-    compare_projection.Clear();
-#endif
+    for (auto &i : frames)
+      i.Invalidate();
   }
 
   unsigned GetParameter() const {
@@ -72,7 +111,10 @@ public:
   bool Generate(const WindowProjection &projection,
                 const TerrainRendererSettings &settings);
 
+  /**
+   * Draw the image prepared by the last successful Generate() call.
+   */
   void Draw(Canvas &canvas, const WindowProjection &projection) const {
-    raster_renderer.Draw(canvas, projection, true);
+    frames.front().raster_renderer.Draw(canvas, projection, true);
   }
 };
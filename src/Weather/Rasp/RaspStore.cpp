@@ -7,13 +7,21 @@
 #include "system/ConvertPathName.hpp"
 #include "system/Path.hpp"
 #include "io/ZipArchive.hpp"
+#include "io/FileCache.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/FileMapping.hpp"
+#include "Weather/Stats.hpp"
+#include "util/CharUtil.hxx"
 #include "util/StringCompare.hxx"
 #include "util/Macros.hpp"
-#include "util/tstring.hpp"
-#include "zzip/zzip.h"
 #include "LogFile.hpp"
 
-#include <set>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string_view>
+#include <vector>
 
 #include <cassert>
 #include <tchar.h>
@@ -125,78 +133,240 @@ RaspStore::OpenArchive() const
   return std::make_unique<ZipArchive>(path);
 }
 
-bool
-RaspStore::ExistsItem(const ZipArchive &archive, Path name, unsigned time_index)
+/**
+ * Parse a file name generated by RaspStore::NarrowWeatherFilename().
+ *
+ * @param map_name receives the map name
+ * @return the time index or #RaspStore::MAX_WEATHER_TIMES if the name
+ * does not match
+ */
+static unsigned
+ParseWeatherFilename(std::string_view name,
+                     std::string_view &map_name) noexcept
 {
-  char filename[MAX_PATH];
-  if (!NarrowWeatherFilename(filename, name, time_index))
-    return false;
+  static constexpr std::string_view prefix = ".curr.";
+  static constexpr std::string_view suffix = "lst.d2.jp2";
+
+  const auto dot = name.find('.');
+  if (dot == name.npos || dot == 0)
+    return RaspStore::MAX_WEATHER_TIMES;
+
+  map_name = name.substr(0, dot);
+
+  const auto rest = name.substr(dot);
+  if (rest.size() != prefix.size() + 4 + suffix.size() ||
+      !rest.starts_with(prefix) || !rest.ends_with(suffix))
+    return RaspStore::MAX_WEATHER_TIMES;
+
+  const char *digits = rest.data() + prefix.size();
+  for (unsigned i = 0; i < 4; ++i)
+    if (!IsDigitASCII(digits[i]))
+      return RaspStore::MAX_WEATHER_TIMES;
 
-  return archive.Exists(filename);
+  const unsigned hour = (digits[0] - '0') * 10 + (digits[1] - '0');
+  const unsigned minute = (digits[2] - '0') * 10 + (digits[3] - '0');
+  if (hour >= 24 || minute >= 60 || minute % 15 != 0)
+    return RaspStore::MAX_WEATHER_TIMES;
+
+  return hour * 4 + minute / 15;
 }
 
-bool
-RaspStore::ScanMapItem(const ZipArchive &archive, MapItem &item)
+[[gnu::pure]]
+static const RaspStore::MapInfo *
+FindWeatherDescriptor(const TCHAR *name) noexcept
 {
-  bool found = false;
-  for (unsigned i = 0; i < MAX_WEATHER_TIMES; i++)
-    if (ExistsItem(archive, Path(item.name), i))
-      found = item.times[i] = true;
+  for (const auto &i : WeatherDescriptors)
+    if (StringIsEqual(i.name, name))
+      return &i;
 
-  return found;
+  return nullptr;
 }
 
 void
-RaspStore::ScanAll()
-try {
-  /* not holding the lock here, because this method is only called
-     during startup, when the other threads aren't running yet */
+RaspStore::ScanArchive(ZipArchive &archive)
+{
+  /* collect the times of all maps in one pass over the archive
+     directory; the order of first appearance is kept for the maps
+     which have no descriptor */
+  std::map<std::string, MapItem, std::less<>> found;
+  std::vector<std::string> order;
 
-  auto archive = OpenArchive();
-  if (!archive)
-    return;
+  std::string name;
+  while (!(name = archive.NextName()).empty()) {
+    std::string_view map_name;
+    const unsigned time_index = ParseWeatherFilename(name, map_name);
+    if (time_index >= MAX_WEATHER_TIMES ||
+        map_name.size() >= decltype(MapItem::name)::capacity())
+      continue;
 
-  maps.clear();
+    auto i = found.find(map_name);
+    if (i == found.end()) {
+      MapItem item(_T(""));
+      item.name.SetASCII(map_name);
+      i = found.emplace(map_name, item).first;
+      order.emplace_back(i->first);
+    }
 
-  std::set<tstring> names;
+    i->second.times[time_index] = true;
+  }
 
   for (const auto &i : WeatherDescriptors) {
     if (maps.full())
       break;
 
-    MapItem item(i.name);
+    const NarrowPathName narrow_name{Path{i.name}};
+    auto f = found.find(std::string_view{(const char *)narrow_name});
+    if (f == found.end())
+      continue;
+
+    MapItem &item = maps.append();
+    item = f->second;
     item.label = i.label;
     item.help = i.help;
-    if (ScanMapItem(*archive, item))
-      maps.push_back(item);
-
-    names.insert(i.name);
+    found.erase(f);
   }
 
-  std::string name;
-  while (!maps.full() && !(name = archive->NextName()).empty()) {
-    if (!StringEndsWith(name.c_str(), ".jp2"))
-      continue;
-
-    MapItem item(_T(""));
+  for (const auto &map_name : order) {
+    if (maps.full())
+      break;
 
-    auto dot = name.find('.');
-    if (dot == name.npos || dot == 0 ||
-        dot >= item.name.capacity())
+    auto f = found.find(map_name);
+    if (f == found.end())
+      /* already added by the loop above */
       continue;
 
-    item.name.SetASCII(std::string_view{name}.substr(0, dot));
+    MapItem &item = maps.append();
+    item = f->second;
     item.label = nullptr;
     item.help = nullptr;
+  }
+}
 
-    if (!names.insert(item.name.c_str()).second)
-      continue;
+static constexpr const TCHAR *CACHE_NAME = _T("rasp.bin");
+
+static constexpr uint32_t CACHE_MAGIC = 0x52534331; // "RSC1"
+
+struct RaspCacheHeader {
+  uint32_t magic;
+
+  /**
+   * sizeof(RaspCacheItem), which depends on the TCHAR size.
+   */
+  uint32_t item_size;
+
+  uint32_t n_items;
+
+  uint32_t reserved;
+};
+
+struct RaspCacheItem {
+  TCHAR name[32];
+
+  /**
+   * One bit per time index.
+   */
+  uint8_t times[RaspStore::MAX_WEATHER_TIMES / 8];
+};
+
+static_assert(RaspStore::MAX_WEATHER_TIMES % 8 == 0);
+
+bool
+RaspStore::LoadCache(FileCache &cache) noexcept
+{
+  std::span<const std::byte> data;
+  const auto mapping = cache.Map(CACHE_NAME, path, data);
+  if (!mapping)
+    return false;
+
+  RaspCacheHeader header;
+  if (data.size() < sizeof(header))
+    return false;
+
+  memcpy(&header, data.data(), sizeof(header));
+  data = data.subspan(sizeof(header));
+
+  if (header.magic != CACHE_MAGIC ||
+      header.item_size != sizeof(RaspCacheItem) ||
+      header.n_items == 0 || header.n_items > maps.capacity() ||
+      data.size() != header.n_items * sizeof(RaspCacheItem))
+    return false;
+
+  for (unsigned i = 0; i < header.n_items; ++i) {
+    RaspCacheItem ci;
+    memcpy(&ci, data.data() + i * sizeof(ci), sizeof(ci));
+
+    if (std::find(std::begin(ci.name), std::end(ci.name),
+                  _T('\0')) == std::end(ci.name)) {
+      maps.clear();
+      return false;
+    }
+
+    MapItem &item = maps.append();
+    item = MapItem(ci.name);
+    for (unsigned t = 0; t < MAX_WEATHER_TIMES; ++t)
+      item.times[t] = (ci.times[t / 8] >> (t % 8)) & 1;
 
-    if (ScanMapItem(*archive, item))
-      maps.push_back(item);
+    const auto *info = FindWeatherDescriptor(ci.name);
+    item.label = info != nullptr ? info->label : nullptr;
+    item.help = info != nullptr ? info->help : nullptr;
   }
 
-  // TODO: scan the rest
+  return true;
+}
+
+void
+RaspStore::SaveCache(FileCache &cache) const
+{
+  const RaspCacheHeader header{
+    CACHE_MAGIC, sizeof(RaspCacheItem), uint32_t(maps.size()), 0,
+  };
+
+  auto os = cache.Save(CACHE_NAME, path);
+  os->Write(std::as_bytes(std::span{&header, 1}));
+
+  for (const auto &item : maps) {
+    RaspCacheItem ci{};
+    std::copy_n(item.name.c_str(), item.name.length(), ci.name);
+
+    for (unsigned t = 0; t < MAX_WEATHER_TIMES; ++t)
+      if (item.times[t])
+        ci.times[t / 8] |= 1 << (t % 8);
+
+    os->Write(std::as_bytes(std::span{&ci, 1}));
+  }
+
+  os->Commit();
+}
+
+void
+RaspStore::ScanAll(FileCache *cache)
+try {
+  /* not holding the lock here, because this method is only called
+     during startup, when the other threads aren't running yet */
+
+  WeatherStats::Timer timer{WeatherStage::RASP_SCAN};
+
+  maps.clear();
+
+  if (cache != nullptr && LoadCache(*cache)) {
+    timer.Succeed();
+    return;
+  }
+
+  auto archive = OpenArchive();
+  if (!archive)
+    return;
+
+  ScanArchive(*archive);
+  timer.Succeed();
+
+  if (cache != nullptr && !maps.empty()) {
+    try {
+      SaveCache(*cache);
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to save RASP cache");
+    }
+  }
 } catch (...) {
   LogError(std::current_exception(), "No rasp data file");
 }
@@ -16,6 +16,7 @@
 #define RASP_FILENAME "xcsoar-rasp.dat"
 
 class Path;
+class FileCache;
 class RasterMap;
 class ZipArchive;
 struct GeoPoint;
@@ -91,8 +92,12 @@ public:
 
   /**
    * Load a list of RASP maps from the file "xcsoar-rasp.dat".
+   *
+   * @param cache if not nullptr, then the list is loaded from (or
+   * saved to) this cache, so the archive directory needs to be
+   * scanned only when the file has changed
    */
-  void ScanAll();
+  void ScanAll(FileCache *cache=nullptr);
 
   bool IsTimeAvailable(unsigned item_index, unsigned time_index) const {
     assert(item_index < maps.size());
@@ -131,9 +136,11 @@ public:
                                     unsigned time_index);
 
 private:
-  [[gnu::pure]]
-  static bool ExistsItem(const ZipArchive &archive, Path name,
-                         unsigned time_index);
+  /**
+   * Build the list from the archive's directory in one pass.
+   */
+  void ScanArchive(ZipArchive &archive);
 
-  static bool ScanMapItem(const ZipArchive &archive, MapItem &item);
+  bool LoadCache(FileCache &cache) noexcept;
+  void SaveCache(FileCache &cache) const;
 };
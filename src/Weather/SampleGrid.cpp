@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "SampleGrid.hpp"
+#include "thread/Mutex.hxx"
+#include "util/tstring.hpp"
+
+#include <algorithm>
+#include <map>
+
+std::optional<double>
+WeatherSampleGrid::Sample(const GeoPoint &location) const noexcept
+{
+  if (!bounds.IsInside(location))
+    return std::nullopt;
+
+  const double x = (location.longitude - bounds.GetWest()).Native() /
+    bounds.GetWidth().Native() * width;
+  const double y = (bounds.GetNorth() - location.latitude).Native() /
+    bounds.GetHeight().Native() * height;
+
+  /* IsInside() includes the east and south edges */
+  const unsigned column = std::min(unsigned(x), width - 1);
+  const unsigned row = std::min(unsigned(y), height - 1);
+
+  const int16_t value = values[std::size_t(row) * width + column];
+  if (value == fill_value)
+    return std::nullopt;
+
+  return double(value) * scale + offset;
+}
+
+namespace WeatherSamples {
+
+static Mutex mutex;
+static std::map<tstring, std::shared_ptr<const WeatherSampleGrid>,
+                std::less<>> grids;
+
+[[gnu::pure]]
+static std::chrono::system_clock::duration
+DistanceFromNow(const WeatherSampleGrid &grid,
+                std::chrono::system_clock::time_point now) noexcept
+{
+  const auto t = grid.GetTime();
+  return t > now ? t - now : now - t;
+}
+
+void
+Publish(const TCHAR *key, std::shared_ptr<const WeatherSampleGrid> grid) noexcept
+{
+  const auto now = std::chrono::system_clock::now();
+
+  const std::lock_guard lock{mutex};
+
+  auto &slot = grids[key];
+  if (slot == nullptr ||
+      DistanceFromNow(*grid, now) <= DistanceFromNow(*slot, now))
+    slot = std::move(grid);
+}
+
+void
+Remove(const TCHAR *key) noexcept
+{
+  const std::lock_guard lock{mutex};
+
+  if (auto i = grids.find(key); i != grids.end())
+    grids.erase(i);
+}
+
+std::shared_ptr<const WeatherSampleGrid>
+Get(const TCHAR *key) noexcept
+{
+  const std::lock_guard lock{mutex};
+
+  auto i = grids.find(key);
+  return i != grids.end() ? i->second : nullptr;
+}
+
+} // namespace WeatherSamples
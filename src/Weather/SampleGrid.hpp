@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Geo/GeoBounds.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <tchar.h>
+
+/**
+ * A georeferenced grid of forecast values (e.g. one Skysight or RASP
+ * parameter at one time), which can be sampled without touching the
+ * map renderer.  The values are stored packed as 16 bit integers, as
+ * they come from the source; Sample() unpacks them.
+ *
+ * Instances are immutable once published, so they can be shared
+ * between threads.
+ */
+class WeatherSampleGrid {
+  GeoBounds bounds;
+
+  unsigned width, height;
+
+  /**
+   * Row by row, starting at the north-west corner.
+   */
+  std::vector<int16_t> values;
+
+  float scale, offset;
+
+  /**
+   * The packed value which marks a cell without data.
+   */
+  int16_t fill_value;
+
+  /**
+   * The time for which this forecast is valid.
+   */
+  std::chrono::system_clock::time_point time;
+
+public:
+  WeatherSampleGrid(const GeoBounds &_bounds,
+                    unsigned _width, unsigned _height,
+                    std::vector<int16_t> &&_values,
+                    float _scale, float _offset, int16_t _fill_value,
+                    std::chrono::system_clock::time_point _time) noexcept
+    :bounds(_bounds), width(_width), height(_height),
+     values(std::move(_values)),
+     scale(_scale), offset(_offset), fill_value(_fill_value),
+     time(_time) {}
+
+  const GeoBounds &GetBounds() const noexcept {
+    return bounds;
+  }
+
+  std::chrono::system_clock::time_point GetTime() const noexcept {
+    return time;
+  }
+
+  /**
+   * Look up the value of the cell containing the given location.
+   *
+   * @return the value, or nothing if the location is outside of the
+   * grid or the cell has no data
+   */
+  [[gnu::pure]]
+  std::optional<double> Sample(const GeoPoint &location) const noexcept;
+};
+
+/**
+ * The sampling grids of the active weather parameters, published by
+ * the decoders for other threads (e.g. the glide computer or Lua
+ * scripts).  The keys are "skysight/" or "rasp/" followed by the
+ * parameter name.
+ *
+ * All functions are thread-safe; the lock is held only for copying
+ * the pointer.
+ */
+namespace WeatherSamples {
+
+/**
+ * Publish a new grid.  If there is already one for the key, the grid
+ * which is valid closer to the current time wins.
+ */
+void
+Publish(const TCHAR *key, std::shared_ptr<const WeatherSampleGrid> grid) noexcept;
+
+void
+Remove(const TCHAR *key) noexcept;
+
+[[gnu::pure]]
+std::shared_ptr<const WeatherSampleGrid>
+Get(const TCHAR *key) noexcept;
+
+} // namespace WeatherSamples
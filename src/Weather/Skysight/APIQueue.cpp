@@ -40,94 +40,156 @@ void
 SkysightAPIQueue::AddRequest(std::unique_ptr<SkysightAsyncRequest> request,
 			     bool append_end)
 {
-  if (!append_end) {
-    //Login requests jump to the front of the queue
-    request_queue.insert(request_queue.begin(), std::move(request));
-  } else {
-    request_queue.emplace_back(std::move(request));
+  {
+    const std::lock_guard lock{mutex};
+    if (!append_end) {
+      //Login requests jump to the front of the queue
+      request_queue.insert(request_queue.begin(), std::move(request));
+    } else {
+      request_queue.emplace_back(std::move(request));
+    }
   }
-  if (!is_busy)
-    Process();
+
+  notify.SendNotification();
 }
 
 void SkysightAPIQueue::AddDecodeJob(std::unique_ptr<CDFDecoder> &&job) {
-  decode_queue.emplace_back(std::move(job));
-  if(!is_busy)
-    Process();
+  {
+    const std::lock_guard lock{mutex};
+    decode_queue.emplace_back(std::move(job));
+  }
+
+  notify.SendNotification();
 }
 
 void SkysightAPIQueue::Process()
 {
-  is_busy = true;
-
-  if(is_clearing) {
-    DoClearingQueue();
-  } else if (!request_queue.empty()) {
-    auto job = request_queue.begin();
-    switch ((*job)->GetStatus()) {
-    case SkysightRequest::Status::Idle:
-      //Provide the job with the very latest API key just prior to execution
-      if ((*job)->GetType() == SkysightCallType::Login) {
-        (*job)->SetCredentials("XCSoar", email.c_str(), password.c_str());
-        (*job)->Process();
-      } else {
-        if (!IsLoggedIn()) {
+  /* the finished jobs are stopped after the mutex has been
+     released */
+  std::vector<std::unique_ptr<SkysightAsyncRequest>> finished_requests;
+  std::vector<std::unique_ptr<CDFDecoder>> finished_decoders;
+  bool need_login = false, more;
+
+  {
+    const std::lock_guard lock{mutex};
+
+    if (is_clearing) {
+      DoClearingQueue(finished_requests);
+    } else {
+      unsigned n_busy = 0;
+      bool login_pending = false;
+
+      for (auto i = request_queue.begin(); i != request_queue.end();) {
+        switch ((*i)->GetStatus()) {
+        case SkysightRequest::Status::Complete:
+        case SkysightRequest::Status::Error:
+          finished_requests.emplace_back(std::move(*i));
+          i = request_queue.erase(i);
+          continue;
+
+        case SkysightRequest::Status::Busy:
+          ++n_busy;
+          break;
+
+        case SkysightRequest::Status::Idle:
+          break;
+        }
+
+        if ((*i)->GetType() == SkysightCallType::Login)
+          login_pending = true;
+
+        ++i;
+      }
+
+      for (auto &job : request_queue) {
+        if (n_busy >= MAX_CONCURRENT_REQUESTS)
+          break;
+
+        if (job->GetStatus() != SkysightRequest::Status::Idle)
+          continue;
+
+        //Provide the job with the very latest API key just prior to execution
+        if (job->GetType() == SkysightCallType::Login) {
+          job->SetCredentials("XCSoar", email.c_str(), password.c_str());
+        } else if (login_pending) {
+          // all other requests wait for the new key
+          continue;
+        } else if (!IsLoggedInLocked()) {
           // inject a login request at the front of the queue
-          SkysightAPI::GenerateLoginRequest();
+          need_login = true;
+          break;
         } else {
-          (*job)->SetCredentials(key.c_str());
-          (*job)->Process();
+          job->SetCredentials(key.c_str());
         }
-      }
 
-      if (!timer.IsActive())
-	      timer.Schedule(std::chrono::milliseconds(300));
-      break;
-    case SkysightRequest::Status::Complete:
-    case SkysightRequest::Status::Error:
-      (*job)->Done();
-      request_queue.erase(job);
-      break;
-    case SkysightRequest::Status::Busy:
-      break;
+        job->Process();
+        ++n_busy;
+      }
     }
-  }
 
-  if (!empty(decode_queue)) {
-    auto &&decode_job = decode_queue.begin();
-    switch ((*decode_job)->GetStatus()) {
-    case CDFDecoder::Status::Idle:
-      (*decode_job)->DecodeAsync();
-      if (!timer.IsActive())
-	      timer.Schedule(std::chrono::milliseconds(300));
-      break;
-    case CDFDecoder::Status::Complete:
-    case CDFDecoder::Status::Error:
-      (*decode_job)->Done();
-      decode_queue.erase(decode_job);
-      break;
-    case CDFDecoder::Status::Busy:
-      break;
+    unsigned n_decoding = 0;
+    for (auto i = decode_queue.begin(); i != decode_queue.end();) {
+      switch ((*i)->GetStatus()) {
+      case CDFDecoder::Status::Complete:
+      case CDFDecoder::Status::Error:
+        finished_decoders.emplace_back(std::move(*i));
+        i = decode_queue.erase(i);
+        continue;
+
+      case CDFDecoder::Status::Busy:
+        ++n_decoding;
+        break;
+
+      case CDFDecoder::Status::Idle:
+        /* the status changes only when the thread has started;
+           DecodeAsync() ignores decoders which have been triggered
+           already, but they still count */
+        if (n_decoding < MAX_CONCURRENT_DECODES) {
+          (*i)->DecodeAsync();
+          ++n_decoding;
+        }
+        break;
+      }
+
+      ++i;
     }
+
+    more = !request_queue.empty() || !decode_queue.empty();
   }
 
-  if (empty(request_queue) && empty(decode_queue))
-    timer.Cancel();
+  for (auto &i : finished_requests)
+    i->Done();
+
+  for (auto &i : finished_decoders)
+    i->Done();
 
-  is_busy = false;
+  if (need_login)
+    SkysightAPI::GenerateLoginRequest();
+
+  if (!more)
+    timer.Cancel();
+  else if (!timer.IsActive())
+    timer.Schedule(std::chrono::milliseconds(300));
 }
 
 void
 SkysightAPIQueue::Clear(const tstring msg)
 {
   LogFormat("SkysightAPIQueue::Clear %s", msg.c_str());
-  is_clearing = true;
+
+  {
+    const std::lock_guard lock{mutex};
+    is_clearing = true;
+  }
+
+  notify.SendNotification();
 }
 
 void
 SkysightAPIQueue::SetCredentials(const tstring _email,
 				 const tstring _pass)
 {
+  const std::lock_guard lock{mutex};
   password = _pass;
   email = _email;
 }
@@ -136,12 +198,20 @@ void
 SkysightAPIQueue::SetKey(const tstring _key,
 			 const uint64_t _key_expiry_time)
 {
+  const std::lock_guard lock{mutex};
   key = _key;
   key_expiry_time = _key_expiry_time;
 }
 
 bool
 SkysightAPIQueue::IsLoggedIn()
+{
+  const std::lock_guard lock{mutex};
+  return IsLoggedInLocked();
+}
+
+bool
+SkysightAPIQueue::IsLoggedInLocked() const noexcept
 {
   uint64_t now = (uint64_t) std::chrono::system_clock::to_time_t(
     BrokenDateTime::NowUTC().ToTimePoint());
@@ -151,14 +221,15 @@ SkysightAPIQueue::IsLoggedIn()
 }
 
 void
-SkysightAPIQueue::DoClearingQueue()
+SkysightAPIQueue::DoClearingQueue(std::vector<std::unique_ptr<SkysightAsyncRequest>> &finished)
 {
-  for (auto &&i = request_queue.begin(); i<request_queue.end(); ++i) {
+  for (auto i = request_queue.begin(); i != request_queue.end();) {
     if ((*i)->GetStatus() != SkysightRequest::Status::Busy) {
-      (*i)->Done();
-      request_queue.erase(i);
-    }
+      finished.emplace_back(std::move(*i));
+      i = request_queue.erase(i);
+    } else
+      ++i;
   }
-  timer.Cancel();
+
   is_clearing = false;
 }
@@ -27,12 +27,35 @@ Copyright_License {
 #include "CDFDecoder.hpp"
 #include "Metrics.hpp"
 #include "ui/event/PeriodicTimer.hpp"
+#include "ui/event/Notify.hpp"
+#include "thread/Mutex.hxx"
 #include <vector>
 
+/**
+ * Runs the Skysight requests and decoders.  Up to
+ * #MAX_CONCURRENT_REQUESTS downloads share the global curl multi
+ * handle (each request waits for its transfer in its own thread),
+ * and up to #MAX_CONCURRENT_DECODES NetCDF files are decoded at the
+ * same time.  Requests only wait for each other while logging in.
+ *
+ * Jobs may be added from any thread; they are started by Process(),
+ * which runs in the main thread.
+ */
 class SkysightAPIQueue final {
+  static constexpr unsigned MAX_CONCURRENT_REQUESTS = 4;
+
+  /**
+   * Decoding needs a lot of memory, so only few run in parallel.
+   */
+  static constexpr unsigned MAX_CONCURRENT_DECODES = 2;
+
+  /**
+   * Protects all attributes below.
+   */
+  mutable Mutex mutex;
+
   std::vector<std::unique_ptr<SkysightAsyncRequest>> request_queue;
   std::vector<std::unique_ptr<CDFDecoder>> decode_queue;
-  bool is_busy = false;
   bool is_clearing = false;
   tstring key;
   uint64_t key_expiry_time = 0;
@@ -42,6 +65,12 @@ class SkysightAPIQueue final {
   void Process();
   UI::PeriodicTimer timer{[this]{ Process(); }};
 
+  /**
+   * Schedules Process() in the main thread after a job was added
+   * from another thread.
+   */
+  UI::Notify notify{[this]{ Process(); }};
+
 public:
   SkysightAPIQueue() {};
   ~SkysightAPIQueue();
@@ -53,7 +82,19 @@ public:
 		  bool append_end = true);
   void AddDecodeJob(std::unique_ptr<CDFDecoder> &&job);
   void Clear(const tstring msg);
-  void DoClearingQueue();
+
+private:
+  /**
+   * Caller must lock the mutex.
+   */
+  [[gnu::pure]]
+  bool IsLoggedInLocked() const noexcept;
+
+  /**
+   * Move the requests which are not busy to #finished.  Caller must
+   * lock the mutex.
+   */
+  void DoClearingQueue(std::vector<std::unique_ptr<SkysightAsyncRequest>> &finished);
 };
 
 #endif
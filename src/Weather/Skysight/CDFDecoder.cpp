@@ -30,9 +30,18 @@ Copyright_License {
 #endif
 
 #include "SkysightAPI.hpp"
+#include "ColorRamp.hpp"
+#include "ImageCache.hpp"
+#include "Weather/SampleGrid.hpp"
+#include "Weather/Stats.hpp"
 #include "system/FileUtil.hpp"
+#include "util/AllocatedArray.hxx"
 #include "LogFile.hpp"
 
+#include <memory>
+#include <optional>
+#include <vector>
+
 static void tiff_errorhandler(const char* module, const char* fmt, va_list ap)
 {
   LogFormat("%s", module);
@@ -42,6 +51,8 @@ static void tiff_errorhandler(const char* module, const char* fmt, va_list ap)
 void CDFDecoder::DecodeAsync()
 {
   std::lock_guard<Mutex> lock(mutex);
+  if (IsBusy() || status != Status::Idle)
+    return;
 
   Trigger();
 }
@@ -93,6 +104,10 @@ bool CDFDecoder::DecodeSuccess()
 
 bool CDFDecoder::Decode()
 {
+  /* counted as a failure if one of the early returns is taken */
+  std::optional<WeatherStats::Timer> netcdf_timer;
+  netcdf_timer.emplace(WeatherStage::SKYSIGHT_NETCDF);
+
 #ifdef ANDROID
   NcFile data_file(path.c_str(), NcFile::FileMode::ReadOnly);
   if (!data_file.is_valid())
@@ -111,7 +126,10 @@ bool CDFDecoder::Decode()
 
   AllocatedArray<double>lat_vals(lat_size);
   AllocatedArray<double>lon_vals(lon_size);
-  AllocatedArray<double>var_vals(lat_size * lon_size);
+
+  /* read the packed values as they are stored in the file; they are
+     unpacked and colour-mapped in one pass by SkysightColorize() */
+  std::vector<int16_t> var_vals(lat_size * lon_size);
 
 #ifdef ANDROID
   data_file.get_var("lat")->get(&lat_vals[0], lat_size);
@@ -151,7 +169,18 @@ bool CDFDecoder::Decode()
   data_var.getAtt("scale_factor").getValues(&var_scale);
 #endif
 
+  data_file.close();
+
+  netcdf_timer->Succeed(var_vals.size() * sizeof(var_vals[0]));
+  netcdf_timer.reset();
+
+  const std::size_t pitch = lon_size * 4;
+  std::unique_ptr<uint8_t[]> rgba(new uint8_t[pitch * lat_size]);
+  SkysightColorize({var_vals.data(), lat_size * lon_size}, rgba.get(),
+                   legend, var_scale, var_offset, (int)fill_value);
+
   //Generate GeoTiff
+  WeatherStats::Timer geotiff_timer{WeatherStage::SKYSIGHT_GEOTIFF};
   TIFF *tf = XTIFFOpen(output_path.c_str(), "w");
   if (!tf) {
     throw std::runtime_error("can't XTIFFOpen");
@@ -187,41 +216,14 @@ bool CDFDecoder::Decode()
   GTIFKeySet(gt, GeogLinearUnitsGeoKey, TYPE_SHORT, 1, Linear_Meter);
   GTIFKeySet(gt, GeogAngularUnitsGeoKey, TYPE_SHORT, 1, Angular_Degree);
 
-  tsize_t linebytes = samplesperpixel * lon_size;
-  unsigned char *row;
-
-  row = (TIFFScanlineSize(tf) > linebytes) ?
-    (unsigned char *)_TIFFmalloc(linebytes) :
-    (unsigned char *)_TIFFmalloc(TIFFScanlineSize(tf));
-  if (!row)
-    return DecodeError();
-
-  TIFFSetField(tf, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tf, linebytes));
+  TIFFSetField(tf, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tf, pitch));
 
-  int rb;
-  unsigned int index = 0;
+  /* the NetCDF rows go from north to south, the GeoTIFF rows from
+     south to north */
   bool success = true;
-  double point_value;
-  for (int y = (int)lat_size - 1; y >= 0; y--) {
-    memset(row, 0, linebytes * sizeof(unsigned char)); //ensures unused data points are transparent
-    for (unsigned int x = 0; x < lon_size; x++) {
-      index = ((unsigned int)y * lon_size) + x;
-      rb = x * samplesperpixel;
-      if (var_vals[index] != fill_value) {
-        point_value = (var_vals[index] * var_scale) + var_offset;
-        if (point_value > legend.begin()->first) {
-          auto color_index = legend.lower_bound(point_value);
-          color_index--;
-
-          row[rb] = color_index->second.Red;
-          row[rb+1] = color_index->second.Green;
-          row[rb+2] = color_index->second.Blue;
-          row[rb+3] = (unsigned char)255;
-        }
-      }
-    }
-
-    if (TIFFWriteScanline(tf, row, (uint32_t)(lat_size - (y + 1)), 0) != 1) {
+  for (unsigned y = 0; y < lat_size; ++y) {
+    uint8_t *row = rgba.get() + (lat_size - 1 - y) * pitch;
+    if (TIFFWriteScanline(tf, row, y, 0) != 1) {
       success = false;
       break;
     }
@@ -232,16 +234,48 @@ bool CDFDecoder::Decode()
 
   (void)TIFFClose(tf);
 
-  if (row)
-    _TIFFfree(row);
-
   GTIFFree(gt);
 
-  data_file.close();
+  if (success)
+    geotiff_timer.Succeed(pitch * lat_size);
+
   File::Delete(path);
-  return (success) ? DecodeSuccess() : DecodeError();
 
-  return false;
+  if (!success)
+    return DecodeError();
+
+  /* pass the image to the overlay without reading back the file;
+     this is what LoadGeoTiff() would return for it */
+  GeoQuadrilateral bounds;
+  bounds.top_left = GeoPoint(Angle::Degrees(lon_min),
+                             Angle::Degrees(lat_min));
+  bounds.top_right = GeoPoint(Angle::Degrees(lon_min + lon_size * lon_scale),
+                              Angle::Degrees(lat_min));
+  bounds.bottom_left = GeoPoint(Angle::Degrees(lon_min),
+                                Angle::Degrees(lat_min + lat_size * lat_scale));
+  bounds.bottom_right = GeoPoint(bounds.top_right.longitude,
+                                 bounds.bottom_left.latitude);
+
+  /* publish the values for the glide computer; the NetCDF rows
+     begin in the north, like WeatherSampleGrid's */
+  const GeoBounds grid_bounds(GeoPoint(bounds.top_left.longitude,
+                                       bounds.bottom_left.latitude),
+                              GeoPoint(bounds.top_right.longitude,
+                                       bounds.top_left.latitude));
+  auto grid = std::make_shared<WeatherSampleGrid>(
+    grid_bounds, lon_size, lat_size, std::move(var_vals),
+    var_scale, var_offset, (int16_t)fill_value,
+    std::chrono::system_clock::from_time_t(time_index));
+  WeatherSamples::Publish((_T("skysight/") + data_varname).c_str(),
+                          std::move(grid));
+
+  SkysightImageCache::Put(output_path,
+                          UncompressedImage(UncompressedImage::Format::RGBA,
+                                            pitch, lon_size, lat_size,
+                                            std::move(rgba), true),
+                          bounds);
+
+  return DecodeSuccess();
 }
 
 void CDFDecoder::MakeCallback(bool result)
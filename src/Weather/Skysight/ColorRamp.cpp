@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ColorRamp.hpp"
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using RGBA = std::array<uint8_t, 4>;
+
+static constexpr RGBA TRANSPARENT{};
+
+/**
+ * Look up the colour of one unpacked value.  The floating point
+ * conversions are the same as in the old per-pixel code, so the
+ * boundaries do not move.
+ */
+[[gnu::pure]]
+static RGBA
+LookupColor(const std::map<float, LegendColor> &legend,
+            double value) noexcept
+{
+  if (legend.empty() || !(value > legend.begin()->first))
+    return TRANSPARENT;
+
+  auto i = legend.lower_bound(value);
+  --i;
+
+  return {i->second.Red, i->second.Green, i->second.Blue, 0xff};
+}
+
+void
+SkysightColorize(std::span<const int16_t> src, uint8_t *dest,
+                 const std::map<float, LegendColor> &legend,
+                 float scale, float offset, int fill_value) noexcept
+{
+  /* determine the range of packed values, skipping the fill value
+     which is usually far away from the data */
+  int min_value = INT16_MAX, max_value = INT16_MIN;
+  for (const int v : src) {
+    if (v != fill_value) {
+      min_value = std::min(min_value, v);
+      max_value = std::max(max_value, v);
+    }
+  }
+
+  std::vector<RGBA> table;
+  if (min_value <= max_value) {
+    table.resize(max_value - min_value + 1);
+    for (int v = min_value; v <= max_value; ++v)
+      table[v - min_value] = LookupColor(legend, double(v) * scale + offset);
+  }
+
+  RGBA *out = reinterpret_cast<RGBA *>(dest);
+  for (const int v : src)
+    *out++ = v != fill_value ? table[v - min_value] : TRANSPARENT;
+}
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <span>
+
+struct LegendColor;
+
+/**
+ * Convert packed NetCDF values (integers which are unpacked with the
+ * "scale_factor" and "add_offset" attributes) to RGBA pixels with the
+ * colours of a Skysight legend.
+ *
+ * A value gets the colour of the largest legend key below it; values
+ * not above the first key and the fill value are transparent.
+ *
+ * Instead of looking up the legend for each pixel, a table of all
+ * packed values which occur in the source is built first, which turns
+ * the conversion into one linear pass.
+ *
+ * @param dest a buffer of 4 bytes per element of #src (R, G, B, A)
+ */
+void
+SkysightColorize(std::span<const int16_t> src, uint8_t *dest,
+                 const std::map<float, LegendColor> &legend,
+                 float scale, float offset, int fill_value) noexcept;
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FrameIndex.hpp"
+
+#include <algorithm>
+
+void
+SkysightFrameIndex::Add(const tstring &metric, uint64_t time,
+                        uint64_t mtime) noexcept
+{
+  metrics[metric][time] = mtime;
+}
+
+void
+SkysightFrameIndex::Remove(const tstring &metric, uint64_t time) noexcept
+{
+  auto i = metrics.find(metric);
+  if (i == metrics.end())
+    return;
+
+  i->second.erase(time);
+  if (i->second.empty())
+    metrics.erase(i);
+}
+
+inline const std::map<uint64_t, uint64_t> *
+SkysightFrameIndex::Find(const tstring &metric) const noexcept
+{
+  auto i = metrics.find(metric);
+  return i != metrics.end() ? &i->second : nullptr;
+}
+
+bool
+SkysightFrameIndex::Contains(const tstring &metric,
+                             uint64_t time) const noexcept
+{
+  const auto *frames = Find(metric);
+  return frames != nullptr && frames->contains(time);
+}
+
+bool
+SkysightFrameIndex::GetRange(const tstring &metric,
+                             Range &range) const noexcept
+{
+  const auto *frames = Find(metric);
+  if (frames == nullptr)
+    return false;
+
+  range.from = frames->begin()->first;
+  range.to = frames->rbegin()->first;
+  range.mtime = 0;
+  for (const auto &[time, mtime] : *frames)
+    range.mtime = std::max(range.mtime, mtime);
+
+  return true;
+}
+
+uint64_t
+SkysightFrameIndex::FindNearest(const tstring &metric, uint64_t time,
+                                uint64_t max_offset) const noexcept
+{
+  const auto *frames = Find(metric);
+  if (frames == nullptr)
+    return 0;
+
+  if (frames->contains(time))
+    return time;
+
+  for (uint64_t offset = SLOT_DURATION; offset <= max_offset;
+       offset += SLOT_DURATION) {
+    if (offset <= time && frames->contains(time - offset))
+      return time - offset;
+
+    if (frames->contains(time + offset))
+      return time + offset;
+  }
+
+  return 0;
+}
+
+unsigned
+SkysightFrameIndex::CountMissing(const tstring &metric, uint64_t from,
+                                 unsigned n_slots) const noexcept
+{
+  const auto *frames = Find(metric);
+  if (frames == nullptr)
+    return n_slots;
+
+  unsigned n = 0;
+  for (unsigned i = 0; i < n_slots; ++i)
+    if (!frames->contains(from + i * SLOT_DURATION))
+      ++n;
+
+  return n;
+}
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "util/tstring.hpp"
+
+#include <cstdint>
+#include <map>
+
+/**
+ * An in-memory index of the Skysight forecast frames (GeoTIFF files)
+ * in the local cache directory, so looking up the frame for a
+ * forecast time does not have to scan the directory.
+ *
+ * Times are UNIX time stamps; frames are #SLOT_DURATION apart.
+ *
+ * This class is not thread-safe.
+ */
+class SkysightFrameIndex {
+public:
+  static constexpr uint64_t SLOT_DURATION = 30 * 60;
+
+  struct Range {
+    uint64_t from, to;
+
+    /**
+     * The modification time of the newest frame.
+     */
+    uint64_t mtime;
+  };
+
+private:
+  /**
+   * Metric id to (forecast time to file modification time).
+   */
+  std::map<tstring, std::map<uint64_t, uint64_t>, std::less<>> metrics;
+
+public:
+  void Clear() noexcept {
+    metrics.clear();
+  }
+
+  void Add(const tstring &metric, uint64_t time, uint64_t mtime) noexcept;
+  void Remove(const tstring &metric, uint64_t time) noexcept;
+
+  [[gnu::pure]]
+  bool Contains(const tstring &metric, uint64_t time) const noexcept;
+
+  /**
+   * Determine the range of forecast times available for the given
+   * metric.
+   *
+   * @return false if there is no frame
+   */
+  bool GetRange(const tstring &metric, Range &range) const noexcept;
+
+  /**
+   * Find the frame closest to the given time, looking back before
+   * looking forward at each distance, up to #max_offset seconds.
+   *
+   * @return the forecast time of the frame, or 0 if none was found
+   */
+  [[gnu::pure]]
+  uint64_t FindNearest(const tstring &metric, uint64_t time,
+                       uint64_t max_offset) const noexcept;
+
+  /**
+   * Count the slots from #from (inclusive) which have no frame.
+   */
+  [[gnu::pure]]
+  unsigned CountMissing(const tstring &metric, uint64_t from,
+                        unsigned n_slots) const noexcept;
+
+private:
+  [[gnu::pure]]
+  const std::map<uint64_t, uint64_t> *Find(const tstring &metric) const noexcept;
+};
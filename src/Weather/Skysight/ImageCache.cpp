@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ImageCache.hpp"
+#include "system/Path.hpp"
+#include "thread/Mutex.hxx"
+
+#include <list>
+
+namespace SkysightImageCache {
+
+/**
+ * A download decodes all forecast times of a metric, but only one of
+ * them will be displayed soon; none of them is displayed yet, so do
+ * not let them occupy more than this many bytes (a few full-screen
+ * RGBA images) on small devices.
+ */
+static constexpr std::size_t MAX_BYTES = 16 * 1024 * 1024;
+
+struct Item {
+  AllocatedPath path;
+  UncompressedImage image;
+  GeoQuadrilateral bounds;
+};
+
+static Mutex mutex;
+static std::list<Item> items;
+static std::size_t total_bytes = 0;
+
+[[gnu::pure]]
+static std::size_t
+GetImageBytes(const UncompressedImage &image) noexcept
+{
+  return image.GetPitch() * image.GetHeight();
+}
+
+static void
+Erase(std::list<Item>::iterator i) noexcept
+{
+  total_bytes -= GetImageBytes(i->image);
+  items.erase(i);
+}
+
+void
+Put(Path path, UncompressedImage &&image,
+    const GeoQuadrilateral &bounds) noexcept
+{
+  const std::size_t size = GetImageBytes(image);
+
+  const std::lock_guard lock{mutex};
+
+  for (auto i = items.begin(); i != items.end();) {
+    auto next = std::next(i);
+    if (i->path == path)
+      Erase(i);
+    i = next;
+  }
+
+  if (size > MAX_BYTES)
+    /* the overlay loader will read the file instead */
+    return;
+
+  /* evict the oldest images */
+  while (total_bytes + size > MAX_BYTES)
+    Erase(items.begin());
+
+  items.push_back({path, std::move(image), bounds});
+  total_bytes += size;
+}
+
+std::optional<std::pair<UncompressedImage, GeoQuadrilateral>>
+Take(Path path) noexcept
+{
+  const std::lock_guard lock{mutex};
+
+  for (auto i = items.begin(); i != items.end(); ++i) {
+    if (i->path == path) {
+      total_bytes -= GetImageBytes(i->image);
+      auto result = std::make_pair(std::move(i->image), i->bounds);
+      items.erase(i);
+      return result;
+    }
+  }
+
+  return std::nullopt;
+}
+
+} // namespace SkysightImageCache
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "ui/canvas/custom/UncompressedImage.hpp"
+#include "Geo/Quadrilateral.hpp"
+
+#include <optional>
+#include <utility>
+
+class Path;
+
+/**
+ * Keeps the most recently decoded Skysight images in memory, so the
+ * overlay can be created without reading back the GeoTIFF file which
+ * #CDFDecoder has just written.  The file remains the persistent
+ * cache.  The memory is limited to a fixed budget; the oldest images
+ * are evicted first.
+ *
+ * All functions are thread-safe.
+ */
+namespace SkysightImageCache {
+
+/**
+ * Add an image, evicting the oldest ones if the budget would be
+ * exceeded.  An image larger than the whole budget is discarded.
+ */
+void
+Put(Path path, UncompressedImage &&image,
+    const GeoQuadrilateral &bounds) noexcept;
+
+/**
+ * Remove the image of the given file from the cache and return it.
+ */
+std::optional<std::pair<UncompressedImage, GeoQuadrilateral>>
+Take(Path path) noexcept;
+
+} // namespace SkysightImageCache
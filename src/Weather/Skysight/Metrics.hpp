@@ -27,6 +27,7 @@ Copyright_License {
 #include "util/tstring.hpp"
 #include "time/BrokenDateTime.hpp"
 #include <map>
+#include <tchar.h>
 
 struct LegendColor {
   unsigned char Red;
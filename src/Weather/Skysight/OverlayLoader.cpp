@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "OverlayLoader.hpp"
+#include "MapWindow/OverlayBitmap.hpp"
+#include "MapWindow/GlueMapWindow.hpp"
+#include "UIGlobals.hpp"
+#include "ImageCache.hpp"
+#include "Weather/Stats.hpp"
+#include "LogFile.hpp"
+
+#ifdef USE_GEOTIFF
+#include "ui/canvas/custom/LibTiff.hpp"
+#include "ui/canvas/custom/ScaleImage.hpp"
+#endif
+
+#include <memory>
+#include <stdexcept>
+
+SkysightOverlayLoader::SkysightOverlayLoader() noexcept
+  :StandbyThread("SkysightOverlay") {}
+
+SkysightOverlayLoader::~SkysightOverlayLoader() noexcept
+{
+  LockStop();
+}
+
+void
+SkysightOverlayLoader::Load(Path _path, const tstring &_label) noexcept
+{
+  const auto *map = UIGlobals::GetMap();
+
+  const std::lock_guard lock{mutex};
+  path = _path;
+  label = _label;
+  max_size = map != nullptr
+    ? MapOverlayBitmap::GetMaxImageSize(map->GetSize())
+    : 0;
+  ++serial;
+  Trigger();
+}
+
+void
+SkysightOverlayLoader::Cancel() noexcept
+{
+  const std::lock_guard lock{mutex};
+  path = nullptr;
+  ++serial;
+  image_ready = false;
+}
+
+void
+SkysightOverlayLoader::Tick() noexcept
+{
+  while (path != nullptr && !IsStopped()) {
+    AllocatedPath current_path = std::move(path);
+    path = nullptr;
+    tstring current_label = std::move(label);
+    const unsigned current_serial = serial;
+    const unsigned current_max_size = max_size;
+
+#ifdef USE_GEOTIFF
+    std::pair<UncompressedImage, GeoQuadrilateral> result;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      WeatherStats::Timer timer{WeatherStage::SKYSIGHT_OVERLAY};
+      try {
+        /* use the image which has just been decoded by CDFDecoder,
+           or else load the file */
+        if (auto cached = SkysightImageCache::Take(current_path))
+          result = std::move(*cached);
+        else
+          result = LoadGeoTiff(current_path);
+
+        if (const unsigned level = GetMipLevel(result.first.GetSize(),
+                                               current_max_size);
+            level > 0) {
+          auto scaled = DownscaleImage(result.first, level);
+          if (scaled.IsDefined())
+            result.first = std::move(scaled);
+        }
+
+        timer.Succeed(result.first.GetPitch() * result.first.GetHeight());
+      } catch (...) {
+        LogError(std::current_exception(), "Skysight overlay load error");
+        continue;
+      }
+    }
+
+    /* a newer request has arrived meanwhile; discard this one */
+    if (current_serial != serial)
+      continue;
+
+    image = std::move(result.first);
+    bounds = result.second;
+#else
+    /* no GeoTIFF decoder for this platform; let MapOverlayBitmap
+       load the file in the main thread */
+    image_path = std::move(current_path);
+    image_max_size = current_max_size;
+#endif
+
+    image_label = std::move(current_label);
+    image_serial = current_serial;
+    image_ready = true;
+    notify.SendNotification();
+  }
+}
+
+void
+SkysightOverlayLoader::OnNotification() noexcept
+{
+  std::unique_ptr<MapOverlayBitmap> bmp;
+
+  {
+    const std::lock_guard lock{mutex};
+    if (!image_ready || image_serial != serial)
+      return;
+
+    image_ready = false;
+
+    try {
+#ifdef USE_GEOTIFF
+      Bitmap bitmap;
+      if (!bitmap.Load(std::move(image)))
+        throw std::runtime_error("Failed to use geo image file");
+
+      bmp = std::make_unique<MapOverlayBitmap>(std::move(bitmap), bounds,
+                                               image_label.c_str());
+#else
+      bmp = std::make_unique<MapOverlayBitmap>(image_path, image_max_size);
+      bmp->SetLabel(std::move(image_label));
+#endif
+    } catch (...) {
+      LogError(std::current_exception(), "MapOverlayBitmap load error");
+      return;
+    }
+  }
+
+  auto *map = UIGlobals::GetMap();
+  if (map == nullptr)
+    return;
+
+  bmp->SetAlpha(0.6);
+  map->SetOverlay(std::move(bmp));
+  map->FullRedraw();
+}
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "thread/StandbyThread.hpp"
+#include "ui/event/Notify.hpp"
+#include "system/Path.hpp"
+#include "util/tstring.hpp"
+
+#ifdef USE_GEOTIFF
+#include "ui/canvas/custom/UncompressedImage.hpp"
+#include "Geo/Quadrilateral.hpp"
+#endif
+
+/**
+ * Decodes Skysight GeoTIFF overlays in a separate thread, so the
+ * draw thread never blocks on the file.  The texture upload needs the
+ * main thread, so the decoded image is passed there with a
+ * #UI::Notify, and only then replaces the map overlay.  Until that
+ * happens, the previous overlay remains visible.
+ */
+class SkysightOverlayLoader final : StandbyThread {
+  UI::Notify notify{[this]{ OnNotification(); }};
+
+  /**
+   * The file which shall be decoded next; empty if there is no
+   * pending request.  Protected by #mutex.
+   */
+  AllocatedPath path = nullptr;
+
+  tstring label;
+
+  /**
+   * Downscale images to this size; see
+   * MapOverlayBitmap::GetMaxImageSize().  Protected by #mutex.
+   */
+  unsigned max_size = 0;
+
+  /**
+   * Incremented by each Load() and Cancel() call.  A decoded image
+   * is only used if the serial has not changed meanwhile.
+   */
+  unsigned serial = 0;
+
+#ifdef USE_GEOTIFF
+  /**
+   * The most recently decoded image, waiting for OnNotification().
+   * Protected by #mutex.
+   */
+  UncompressedImage image;
+  GeoQuadrilateral bounds;
+#else
+  AllocatedPath image_path = nullptr;
+  unsigned image_max_size = 0;
+#endif
+
+  tstring image_label;
+  unsigned image_serial = 0;
+  bool image_ready = false;
+
+public:
+  SkysightOverlayLoader() noexcept;
+  ~SkysightOverlayLoader() noexcept;
+
+  /**
+   * Start decoding the given GeoTIFF file.  A request which is
+   * still pending is discarded.
+   */
+  void Load(Path _path, const tstring &_label) noexcept;
+
+  /**
+   * Discard all pending requests; the map overlay will not be
+   * replaced by them.
+   */
+  void Cancel() noexcept;
+
+private:
+  /**
+   * Runs in the main thread: upload the image and install it in the
+   * map window.
+   */
+  void OnNotification() noexcept;
+
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override;
+};
@@ -271,10 +271,13 @@ SkysightRequest::RequestToFile()
   request.SetRequestHeaders(request_headers.Get());
   request.SetVerifyPeer(false);
 
+  WeatherStats::Timer timer{GetStatsStage()};
   try {
     request.StartIndirect();
     handler.Wait();
+    timer.Succeed(handler.GetReceived());
   } catch (const std::exception &exc) {
+    timer.Fail(handler.GetReceived());
     success = false;
   }
 
@@ -326,10 +329,13 @@ SkysightRequest::RequestToBuffer(tstring &response)
   request.SetRequestHeaders(request_headers.Get());
   request.SetVerifyPeer(false);
 
+  WeatherStats::Timer timer{GetStatsStage()};
   try {
     request.StartIndirect();
     handler.Wait();
+    timer.Succeed(handler.GetReceived());
   } catch (const std::exception &exc) {
+    timer.Fail(handler.GetReceived());
     success = false;
   }
 
@@ -24,6 +24,7 @@ Copyright_License {
 #define WEATHER_SKYSIGHTREQUEST_HPP
 
 #include "APIGlue.hpp"
+#include "Weather/Stats.hpp"
 #include "thread/StandbyThread.hpp"
 #include "util/tstring.hpp"
 
@@ -64,6 +65,9 @@ public:
 
   public:
     FileHandler(FILE *_file): file(_file) {};
+    size_t GetReceived() const noexcept {
+      return received;
+    }
     // void DataReceived(const void *data, size_t length) override;
     // void ResponseReceived(int64_t content_length) override;
     void OnData(std::span<const std::byte> data) override;
@@ -102,6 +106,13 @@ protected:
   tstring key, username, password;
   bool RequestToFile();
   bool RequestToBuffer(tstring &response);
+
+  [[gnu::pure]]
+  WeatherStage GetStatsStage() const noexcept {
+    return args.calltype == SkysightCallType::Login
+      ? WeatherStage::SKYSIGHT_LOGIN
+      : WeatherStage::SKYSIGHT_FETCH;
+  }
 };
 
 struct SkysightAsyncRequest final:
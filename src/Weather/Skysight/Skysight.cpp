@@ -45,6 +45,7 @@ Copyright_License {
 #include "MapWindow/OverlayBitmap.hpp"
 #include "MapWindow/GlueMapWindow.hpp"
 #include "thread/Debug.hpp"
+#include "net/State.hpp"
 
 /**
  * TODO:
@@ -346,76 +347,67 @@ Skysight::APIInited(__attribute__((unused)) const tstring details, __attribute__
 bool
 Skysight::GetActiveMetricState(tstring metric_name, SkysightActiveMetric &m)
 {
-  tstring search_pattern = region + "-" + metric_name + "*";
-  std::vector<SkysightImageFile> img_files = ScanFolder(search_pattern);
-
-  if (img_files.size() > 0) {
-    uint64_t min_date = (uint64_t)std::numeric_limits<uint64_t>::max;
-    uint64_t max_date = 0;
-    uint64_t updated = 0;
-
-    for (auto &i: img_files) {
-      min_date = std::min(min_date, i.datetime);
-      max_date = std::max(max_date, i.datetime);
-      updated  = std::max(updated, i.mtime);
-    }
-    if (MetricExists(metric_name)) {
-      m.metric =new SkysightMetric(GetMetric(metric_name));
-      m.from = min_date;
-      m.to = max_date;
-      m.mtime = updated;
+  SkysightFrameIndex::Range range;
 
-      return true;
-    }
+  {
+    const std::lock_guard lock{frames_mutex};
+    if (!frames.GetRange(metric_name, range))
+      return false;
   }
 
-  return false;
+  if (!MetricExists(metric_name))
+    return false;
+
+  m.metric =new SkysightMetric(GetMetric(metric_name));
+  m.from = range.from;
+  m.to = range.to;
+  m.mtime = range.mtime;
+  return true;
 }
 
-std::vector<SkysightImageFile>
-Skysight::ScanFolder(tstring search_string = "*.tif")
+void
+Skysight::AddFrame(Path path)
 {
-  //start by checking for output files
-  std::vector<SkysightImageFile> file_list;
-
-  struct SkysightFileVisitor: public File::Visitor {
-    std::vector<SkysightImageFile> &file_list;
-    explicit SkysightFileVisitor(std::vector<SkysightImageFile> &_file_list):
-      file_list(_file_list) {}
-
-    void Visit(Path path, Path filename) override {
-      //is this a tif filename
-      if (filename.EndsWithIgnoreCase(".tif")) {
-        SkysightImageFile img_file = SkysightImageFile(filename, path);
-        if (img_file.is_valid)
-          file_list.emplace_back(img_file);
-      }
-    }
+  const Path filename = path.GetBase();
+  if (filename == nullptr)
+    return;
 
-  } visitor(file_list);
+  const SkysightImageFile img_file(filename, path);
+  if (!img_file.is_valid || img_file.region != region)
+    return;
 
-  Directory::VisitSpecificFiles(GetLocalPath(), _T(search_string.c_str()),
-				visitor);
-  return file_list;
+  const std::lock_guard lock{frames_mutex};
+  frames.Add(img_file.metric, img_file.datetime, img_file.mtime);
 }
 
 void
 Skysight::CleanupFiles()
 {
   struct SkysightFileVisitor: public File::Visitor {
-    explicit SkysightFileVisitor(const uint64_t _to): to(_to) {}
+    SkysightFileVisitor(const uint64_t _to, const tstring &_region,
+                        SkysightFrameIndex &_frames)
+      :to(_to), region(_region), frames(_frames) {}
     const uint64_t to;
+    const tstring &region;
+    SkysightFrameIndex &frames;
     void Visit(Path path, Path filename) override {
       if (filename.EndsWithIgnoreCase(".tif")) {
         SkysightImageFile img_file = SkysightImageFile(filename, path);
         if ((img_file.mtime <= (to - (60*60*24*5))) ||
 	    (img_file.datetime < (to - (60*60*24))) ) {
           File::Delete(path);
+        } else if (img_file.is_valid && img_file.region == region) {
+          frames.Add(img_file.metric, img_file.datetime, img_file.mtime);
         }
       }
     }
-  } visitor(std::chrono::system_clock::to_time_t(Skysight::GetNow().ToTimePoint()));
+  } visitor(std::chrono::system_clock::to_time_t(Skysight::GetNow().ToTimePoint()),
+            region, frames);
 
+  /* this is the only directory scan; afterwards, the index is
+     updated by DownloadComplete() */
+  const std::lock_guard lock{frames_mutex};
+  frames.Clear();
   Directory::VisitSpecificFiles(GetLocalPath(), _T("*.tif"), visitor);
 }
 
@@ -445,6 +437,54 @@ Skysight::Render(bool force_update)
 		     DownloadComplete);
     }
   }
+
+  PrefetchFrames();
+}
+
+void
+Skysight::PrefetchFrames()
+{
+  /* downloading frames nobody has asked for yet is only acceptable on
+     a connection which is not expensive, and while nothing else is
+     being downloaded */
+  switch (GetNetState()) {
+  case NetState::DISCONNECTED:
+  case NetState::ROAMING:
+    return;
+
+  case NetState::UNKNOWN:
+  case NetState::CONNECTED:
+    break;
+  }
+
+  if (!IsReady() || ActiveMetricsUpdating())
+    return;
+
+  const auto now_clock = std::chrono::steady_clock::now();
+  if (now_clock < next_prefetch)
+    return;
+
+  next_prefetch = now_clock + PREFETCH_INTERVAL;
+
+  const BrokenDateTime from = GetForecastTime(Skysight::GetNow());
+  const BrokenDateTime to = from +
+    std::chrono::seconds(SkysightFrameIndex::SLOT_DURATION * (PREFETCH_SLOTS - 1));
+  const uint64_t from_index =
+    std::chrono::system_clock::to_time_t(from.ToTimePoint());
+
+  for (auto &i : active_metrics) {
+    unsigned missing;
+    {
+      const std::lock_guard lock{frames_mutex};
+      missing = frames.CountMissing(i.metric->id, from_index, PREFETCH_SLOTS);
+    }
+
+    if (missing == 0)
+      continue;
+
+    i.updating = true;
+    api->GetImageAt(i.metric->id.c_str(), from, to, DownloadComplete);
+  }
 }
 
 BrokenDateTime
@@ -480,12 +520,15 @@ Skysight::SetDisplayedMetric(const TCHAR *const id,
 }
 
 void
-Skysight::DownloadComplete(__attribute__((unused)) const tstring details, const bool success,
+Skysight::DownloadComplete(const tstring details, const bool success,
                 const tstring layer_id, __attribute__((unused)) const uint64_t time_index)
 {
   if (!self)
     return;
 
+  if (success)
+    self->AddFrame(Path(details.c_str()));
+
   self->SetActveMetricUpdateState(layer_id, false);
   self->RefreshActiveMetric(layer_id);
 
@@ -535,6 +578,8 @@ Skysight::DisplayActiveMetric(const TCHAR *const id)
 
   if (!id) {
     displayed_metric.clear();
+    overlay_loader.Cancel();
+
     auto *map = UIGlobals::GetMap();
     if (map == nullptr)
       return false;
@@ -551,47 +596,27 @@ Skysight::DisplayActiveMetric(const TCHAR *const id)
 
   BrokenDateTime now = GetForecastTime(Skysight::GetNow());
 
-  int offset = 0;
   uint64_t n = std::chrono::system_clock::to_time_t(now.ToTimePoint());
 
-  uint64_t test_time;
-  bool found = false;
-  NarrowString<256> filename;
-  BrokenDateTime bdt;
-  int max_offset = (60*60);
-
-  //TODO: We're only searching w a max offset of 1 hr, simplify this!
-  while (!found) {
-    //look back for closest forecast first, then look forward
-    for (int j=0; j <= 1; ++j) {
-      test_time = n + ( offset * ((2*j)-1) );
-
-      bdt = FromUnixTime(test_time);
-      filename.Format("%s-%s-%04u%02u%02u%02u%02u.tif",
-            region.c_str(), id,
-            bdt.year, bdt.month,
-            bdt.day, bdt.hour, bdt.minute);
-
-      if (File::Exists(AllocatedPath::Build(GetLocalPath(),
-					    filename.c_str()))) {
-        found = true;
-        break;
-      }
-      if (offset == 0)
-	break;
-    }
-    if (!found)
-      offset += (60*30);
-
-    if (offset > max_offset)
-      break;
+  //look back for closest forecast first, then look forward
+  uint64_t frame_time;
+  {
+    const std::lock_guard lock{frames_mutex};
+    frame_time = frames.FindNearest(id, n, 60*60);
   }
 
-  if (!found) {
+  if (frame_time == 0) {
     SetDisplayedMetric(id);
     return false;
   }
 
+  const BrokenDateTime bdt = FromUnixTime(frame_time);
+  NarrowString<256> filename;
+  filename.Format("%s-%s-%04u%02u%02u%02u%02u.tif",
+                  region.c_str(), id,
+                  bdt.year, bdt.month,
+                  bdt.day, bdt.hour, bdt.minute);
+
   if (!SetDisplayedMetric(id, bdt))
     return false;
 
@@ -607,16 +632,9 @@ Skysight::DisplayActiveMetric(const TCHAR *const id)
     return false;
 
   LogFormat("Skysight::DisplayActiveMetric %s", path.c_str());
-  std::unique_ptr<MapOverlayBitmap> bmp;
-  try {
-    bmp.reset(new MapOverlayBitmap(path));
-  } catch (...) {
-    LogError(std::current_exception(), "MapOverlayBitmap load error");
-    return false;
-  }
 
-  bmp->SetAlpha(0.6);
-  bmp->SetLabel(label);
-  map->SetOverlay(std::move(bmp));
+  /* the current overlay remains visible until the new one has been
+     decoded */
+  overlay_loader.Load(path, label);
   return true;
 }
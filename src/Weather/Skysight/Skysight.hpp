@@ -27,6 +27,7 @@ Copyright_License {
 #include "util/StaticString.hxx"
 #include "system/Path.hpp"
 #include "LocalPath.hpp"
+#include <chrono>
 #include <map>
 #include <vector>
 #include <tchar.h>
@@ -38,6 +39,9 @@ Copyright_License {
 
 #include "Weather/Skysight/Metrics.hpp"
 #include "Weather/Skysight/SkysightAPI.hpp"
+#include "Weather/Skysight/OverlayLoader.hpp"
+#include "Weather/Skysight/FrameIndex.hpp"
+#include "thread/Mutex.hxx"
 #include "Blackboard/BlackboardListener.hpp"
 
 #define SKYSIGHT_MAX_METRICS 5
@@ -137,6 +141,33 @@ private:
   bool update_flag = false;
   BrokenDateTime curr_time;
 
+  /**
+   * Decodes the overlay images without blocking the draw thread.
+   */
+  SkysightOverlayLoader overlay_loader;
+
+  /**
+   * How many forecast slots from now shall be downloaded in advance
+   * for each active metric?
+   */
+  static constexpr unsigned PREFETCH_SLOTS = 6;
+
+  static constexpr std::chrono::steady_clock::duration PREFETCH_INTERVAL =
+    std::chrono::minutes(5);
+
+  std::chrono::steady_clock::time_point next_prefetch{};
+
+  /**
+   * Protects #frames, which is updated by DownloadComplete() in the
+   * decoder thread.
+   */
+  Mutex frames_mutex;
+
+  /**
+   * The frames in the local cache directory of the current region.
+   */
+  SkysightFrameIndex frames;
+
   /* virtual methods from class BlackboardListener */
   virtual void OnCalculatedUpdate(const MoreData &basic,
                                   const DerivedInfo &calculated) override;
@@ -146,7 +177,21 @@ private:
   BrokenDateTime GetForecastTime(BrokenDateTime curr_time);
   std::vector<SkysightActiveMetric> active_metrics;
 
-  std::vector<SkysightImageFile> ScanFolder(tstring search_pattern);
+  /**
+   * Add a new GeoTIFF file to the frame index.
+   */
+  void AddFrame(Path path);
+
+  /**
+   * Download the upcoming forecast slots of all active metrics which
+   * are not cached yet.
+   */
+  void PrefetchFrames();
+
+  /**
+   * Delete outdated files and build the frame index from the
+   * others.
+   */
   void CleanupFiles();
 };
 
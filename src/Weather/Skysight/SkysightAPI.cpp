@@ -40,11 +40,15 @@ Copyright_License {
 #include "io/FileLineReader.hpp"
 #include "time/BrokenDateTime.hpp"
 #include "Metrics.hpp"
+#include "thread/Mutex.hxx"
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <sstream>
 #include "io/BufferedReader.hxx"
+#include "io/FileReader.hxx"
+#include "json/StreamParser.hxx"
+#include "util/SpanCast.hxx"
 
 #include "Operation/Operation.hpp"
 
@@ -226,6 +230,14 @@ SkysightAPI::IsInited()
   return inited_regions && inited_layers && inited_lastupdates;
 }
 
+/**
+ * Responses arrive in several request threads at once, and parsing
+ * modifies the metric list, so they are parsed one at a time.  This
+ * is recursive because parsing may issue a request which is answered
+ * from the cache right away.
+ */
+static RecursiveMutex parse_mutex;
+
 void
 SkysightAPI::ParseResponse(const tstring &&result, const bool success,
 			   const SkysightRequestArgs req)
@@ -233,6 +245,8 @@ SkysightAPI::ParseResponse(const tstring &&result, const bool success,
   if (!self)
     return;
 
+  const std::lock_guard lock{parse_mutex};
+
   if (!success) {
     if (req.calltype == SkysightCallType::Login) {
       self->queue.Clear(_T("Login error"));
@@ -268,31 +282,57 @@ SkysightAPI::ParseResponse(const tstring &&result, const bool success,
   }
 }
 
+/**
+ * Collects the regions from a "regions" response:
+ * [{"id": ..., "name": ...}, ...]
+ */
+class SkysightRegionsHandler final : public Json::StreamHandler {
+  std::map<tstring, tstring> &regions;
+  tstring id, name;
+
+public:
+  explicit SkysightRegionsHandler(std::map<tstring, tstring> &_regions)
+    :regions(_regions) {}
+
+  void OnBegin(unsigned depth, std::string_view, bool) override {
+    if (depth == 1) {
+      id.clear();
+      name.clear();
+    }
+  }
+
+  void OnEnd(unsigned depth, bool) override {
+    if (depth == 1 && !id.empty())
+      regions.emplace(std::move(id), std::move(name));
+  }
+
+  void OnValue(unsigned depth, std::string_view key,
+	       const Json::StreamValue &value) override {
+    if (depth != 2)
+      return;
+
+    if (key == "id")
+      id = value.string;
+    else if (key == "name")
+      name = value.string;
+  }
+};
+
 bool
 SkysightAPI::ParseRegions(const SkysightRequestArgs &args,
 			  const tstring &result)
 {
-  boost::property_tree::ptree details;
-  
-  if (!GetResult(args, result.c_str(), details)) {
+  std::map<tstring, tstring> new_regions;
+  SkysightRegionsHandler handler(new_regions);
+
+  if (!GetResult(args, result, handler)) {
     LoadDefaultRegions();
     return false;
   }
 
-  regions.clear();
+  regions = std::move(new_regions);
 
-  bool success = false;
-  
-  for (auto &i: details) {
-    boost::property_tree::ptree &node = i.second;
-    auto id = node.find("id");
-    auto name = node.find("name");
-    if (id != node.not_found()) {
-      regions.insert(std::pair<tstring, tstring>(id->second.data(),
-						 name->second.data()));
-      success = true;
-    }
-  }
+  bool success = !regions.empty();
 
   if (success) {
     inited_regions = true;
@@ -328,50 +368,128 @@ SkysightAPI::LoadDefaultRegions()
     regions.emplace(std::pair<tstring, tstring>(r->id, r->name));
 }
 
+/**
+ * Collects the metrics from a "layers" response, which is the
+ * largest one.  Only the attributes used by #SkysightMetric are
+ * kept:
+ *
+ * [{"id": ..., "name": ..., "description": ...,
+ *   "legend": {"colors": [{"value": ..., "color": [r, g, b]}, ...]}},
+ *  ...]
+ */
+class SkysightLayersHandler final : public Json::StreamHandler {
+  std::vector<SkysightMetric> &metrics;
+
+  tstring id, name, desc;
+  std::map<float, LegendColor> legend;
+  bool has_colors;
+
+  enum class State : uint8_t {
+    LAYER,
+    LEGEND,
+    COLORS,
+    COLOR_ENTRY,
+    COLOR_ARRAY,
+  } state = State::LAYER;
+
+  float value;
+  bool has_value;
+  unsigned char rgb[3];
+  unsigned n_rgb;
+
+public:
+  explicit SkysightLayersHandler(std::vector<SkysightMetric> &_metrics)
+    :metrics(_metrics) {}
+
+  void OnBegin(unsigned depth, std::string_view key, bool array) override {
+    if (depth == 1) {
+      id.clear();
+      name.clear();
+      desc.clear();
+      legend.clear();
+      has_colors = false;
+      state = State::LAYER;
+    } else if (depth == 2 && state == State::LAYER && key == "legend") {
+      state = State::LEGEND;
+    } else if (depth == 3 && state == State::LEGEND && key == "colors" &&
+	       array) {
+      state = State::COLORS;
+      has_colors = true;
+    } else if (depth == 4 && state == State::COLORS) {
+      state = State::COLOR_ENTRY;
+      has_value = false;
+      n_rgb = 0;
+    } else if (depth == 5 && state == State::COLOR_ENTRY &&
+	       key == "color" && array) {
+      state = State::COLOR_ARRAY;
+    }
+  }
+
+  void OnEnd(unsigned depth, bool) override {
+    switch (depth) {
+    case 1:
+      if (!id.empty() && has_colors)
+	metrics.emplace_back(std::move(id), std::move(name), std::move(desc))
+	  .legend = std::move(legend);
+      break;
+
+    case 2:
+      if (state == State::LEGEND)
+	state = State::LAYER;
+      break;
+
+    case 3:
+      if (state == State::COLORS)
+	state = State::LEGEND;
+      break;
+
+    case 4:
+      if (state == State::COLOR_ENTRY) {
+	if (has_value && n_rgb == 3)
+	  legend.emplace(value, LegendColor{rgb[0], rgb[1], rgb[2]});
+	state = State::COLORS;
+      }
+      break;
+
+    case 5:
+      if (state == State::COLOR_ARRAY)
+	state = State::COLOR_ENTRY;
+      break;
+    }
+  }
+
+  void OnValue(unsigned depth, std::string_view key,
+	       const Json::StreamValue &v) override {
+    if (depth == 2 && state == State::LAYER) {
+      if (key == "id")
+	id = v.string;
+      else if (key == "name")
+	name = v.string;
+      else if (key == "description")
+	desc = v.string;
+    } else if (depth == 5 && state == State::COLOR_ENTRY && key == "value") {
+      value = static_cast<float>(v.ToDouble());
+      has_value = true;
+    } else if (depth == 6 && state == State::COLOR_ARRAY && n_rgb < 3) {
+      rgb[n_rgb++] = static_cast<unsigned char>(v.ToDouble());
+    }
+  }
+};
+
 bool
 SkysightAPI::ParseLayers(const SkysightRequestArgs &args,
 			 const tstring &result)
 {
-  boost::property_tree::ptree details;
+  std::vector<SkysightMetric> new_metrics;
+  SkysightLayersHandler handler(new_metrics);
 
-  if (!GetResult(args, result.c_str(), details)) {
+  if (!GetResult(args, result, handler)) {
     MakeCallback(args.cb, _T(""), false, _T(""), 0);
     return false;
   }
 
-  metrics.clear();
-  bool success = false;
-
-  for (auto &i: details) {
-    boost::property_tree::ptree &node = i.second;
-    auto id = node.find("id");
-    auto legend = node.find("legend");
-    if (id != node.not_found() && legend != node.not_found()) {
-      SkysightMetric m = SkysightMetric(
-        tstring(id->second.data()), 
-        tstring(node.find("name")->second.data()),
-        tstring(node.find("description")->second.data())
-      );
-
-      auto colours = legend->second.find("colors");
-      if (colours != legend->second.not_found()) {
-        success = true;
-        for (auto &j: colours->second) {
-          auto c = j.second.get_child("color").begin();
-          m.legend.insert(
-	    std::pair<float, LegendColor>(
-	      std::stof(j.second.find("value")->second.data()),
-	      {
-		static_cast<unsigned char>(std::stoi(c->second.data())),
-		  static_cast<unsigned char>(std::stoi(std::next(c, 1)->second.data())),
-		  static_cast<unsigned char>(std::stoi(std::next(c, 2)->second.data()))
-		  }
-	      ));
-        }
-        metrics.push_back(m);
-      }
-    }
-  }
+  metrics = std::move(new_metrics);
+  bool success = !metrics.empty();
 
   if (success) {
     if (!inited_lastupdates)
@@ -593,6 +711,26 @@ SkysightAPI::GetResult(const SkysightRequestArgs &args, const tstring result,
   return true;
 }
 
+bool
+SkysightAPI::GetResult(const SkysightRequestArgs &args, const tstring &result,
+		       Json::StreamHandler &handler)
+{
+  try {
+    if (args.to_file) {
+      FileReader reader(Path(result.c_str()));
+      Json::ParseStream(reader, handler);
+    } else {
+      Json::StreamParser parser(handler);
+      parser.Write(AsBytes(std::string_view(result)));
+      parser.Finish();
+    }
+  } catch (...) {
+    LogError(std::current_exception(), "SkysightAPI: failed to parse JSON");
+    return false;
+  }
+  return true;
+}
+
 bool
 SkysightAPI::GetImageAt(const TCHAR *const layer, BrokenDateTime fctime,
 			BrokenDateTime maxtime,
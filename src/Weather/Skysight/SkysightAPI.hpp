@@ -42,6 +42,7 @@ Copyright_License {
 #define SKYSIGHTAPI_BASE_URL "https://skysight.io/api"
 
 struct BrokenDateTime;
+namespace Json { class StreamHandler; }
 
 class SkysightAPI final {
   friend struct SkysightRequest;
@@ -96,6 +97,8 @@ protected:
 
   bool GetResult(const SkysightRequestArgs &args, const tstring result,
 		 boost::property_tree::ptree &output);
+  bool GetResult(const SkysightRequestArgs &args, const tstring &result,
+		 Json::StreamHandler &handler);
   bool CacheAvailable(Path path, SkysightCallType calltype,
 		      const TCHAR *const layer = nullptr);
 
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Stats.hpp"
+#include "LogFile.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace WeatherStats {
+
+using Rep = Duration::rep;
+
+struct Counters {
+  std::atomic<uint_least32_t> count{0}, errors{0};
+  std::atomic<uint_least64_t> bytes{0};
+  std::atomic<Rep> total_time{0}, max_time{0};
+};
+
+static std::array<Counters, std::size_t(WeatherStage::COUNT)> counters;
+
+static constexpr const char *stage_names[] = {
+  "Skysight login",
+  "Skysight fetch",
+  "Skysight NetCDF decode",
+  "Skysight GeoTIFF write",
+  "Skysight overlay load",
+  "RASP scan",
+  "RASP map load",
+  "pc_met download",
+  "NOAA download",
+};
+
+static_assert(std::size(stage_names) == std::size_t(WeatherStage::COUNT));
+
+void
+Add(WeatherStage stage, Duration duration, uint_least64_t bytes,
+    bool success) noexcept
+{
+  auto &c = counters[std::size_t(stage)];
+  const Rep value = duration.count();
+
+  c.count.fetch_add(1, std::memory_order_relaxed);
+  if (!success)
+    c.errors.fetch_add(1, std::memory_order_relaxed);
+  c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  c.total_time.fetch_add(value, std::memory_order_relaxed);
+
+  Rep old = c.max_time.load(std::memory_order_relaxed);
+  while (value > old &&
+         !c.max_time.compare_exchange_weak(old, value,
+                                           std::memory_order_relaxed)) {}
+}
+
+Snapshot
+Get(WeatherStage stage) noexcept
+{
+  const auto &c = counters[std::size_t(stage)];
+
+  Snapshot s;
+  s.count = c.count.load(std::memory_order_relaxed);
+  s.errors = c.errors.load(std::memory_order_relaxed);
+  s.bytes = c.bytes.load(std::memory_order_relaxed);
+  s.total_time = Duration{c.total_time.load(std::memory_order_relaxed)};
+  s.max_time = Duration{c.max_time.load(std::memory_order_relaxed)};
+  return s;
+}
+
+const char *
+GetStageName(WeatherStage stage) noexcept
+{
+  return stage_names[std::size_t(stage)];
+}
+
+void
+Log() noexcept
+{
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+
+  for (std::size_t i = 0; i < std::size_t(WeatherStage::COUNT); ++i) {
+    const auto stage = WeatherStage(i);
+    const auto s = Get(stage);
+    if (s.count == 0)
+      continue;
+
+    LogFormat("Weather: %s: %u (%u failed), %lu kB, %lu ms avg, %lu ms max",
+              GetStageName(stage),
+              (unsigned)s.count, (unsigned)s.errors,
+              (unsigned long)(s.bytes / 1024),
+              (unsigned long)duration_cast<milliseconds>(s.GetAverageTime()).count(),
+              (unsigned long)duration_cast<milliseconds>(s.max_time).count());
+  }
+}
+
+} // namespace WeatherStats
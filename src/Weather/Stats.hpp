@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <tchar.h>
+
+/**
+ * The stages of the weather pipelines which are measured by
+ * #WeatherStats.
+ */
+enum class WeatherStage : uint8_t {
+  SKYSIGHT_LOGIN,
+
+  /**
+   * Skysight API requests other than the login (regions, layers,
+   * forecast data).
+   */
+  SKYSIGHT_FETCH,
+
+  SKYSIGHT_NETCDF,
+  SKYSIGHT_GEOTIFF,
+
+  /**
+   * Reading a Skysight GeoTIFF for the map overlay (or taking it
+   * from the in-memory cache).
+   */
+  SKYSIGHT_OVERLAY,
+
+  RASP_SCAN,
+  RASP_LOAD,
+
+  PCMET_DOWNLOAD,
+
+  NOAA_DOWNLOAD,
+
+  COUNT
+};
+
+/**
+ * Timing and byte counters for the weather downloads and decoders,
+ * meant for tuning the update intervals for metered data plans.
+ *
+ * All functions are thread-safe; the counters are relaxed atomics, so
+ * a #Snapshot is not guaranteed to be consistent.
+ */
+namespace WeatherStats {
+
+using Duration = std::chrono::steady_clock::duration;
+
+struct Snapshot {
+  /**
+   * The number of operations, and how many of them failed.
+   */
+  uint_least32_t count, errors;
+
+  /**
+   * The number of bytes downloaded or decoded.
+   */
+  uint_least64_t bytes;
+
+  Duration total_time, max_time;
+
+  constexpr Duration GetAverageTime() const noexcept {
+    return count > 0
+      ? total_time / count
+      : Duration::zero();
+  }
+};
+
+void
+Add(WeatherStage stage, Duration duration, uint_least64_t bytes,
+    bool success=true) noexcept;
+
+[[gnu::pure]]
+Snapshot
+Get(WeatherStage stage) noexcept;
+
+/**
+ * Returns a short untranslated name for log messages.
+ */
+[[gnu::const]]
+const char *
+GetStageName(WeatherStage stage) noexcept;
+
+/**
+ * Write all counters of stages which were used to the log file.
+ */
+void
+Log() noexcept;
+
+/**
+ * Measures one operation from construction to destruction.  Call
+ * Succeed() before it goes out of scope, or else it is counted as
+ * an error.
+ */
+class Timer {
+  const WeatherStage stage;
+  const std::chrono::steady_clock::time_point start;
+  uint_least64_t bytes = 0;
+  bool success = false;
+
+public:
+  explicit Timer(WeatherStage _stage) noexcept
+    :stage(_stage), start(std::chrono::steady_clock::now()) {}
+
+  ~Timer() noexcept {
+    Add(stage, std::chrono::steady_clock::now() - start, bytes, success);
+  }
+
+  Timer(const Timer &) = delete;
+  Timer &operator=(const Timer &) = delete;
+
+  void Succeed(uint_least64_t _bytes=0) noexcept {
+    bytes = _bytes;
+    success = true;
+  }
+
+  void Fail(uint_least64_t _bytes=0) noexcept {
+    bytes = _bytes;
+    success = false;
+  }
+};
+
+} // namespace WeatherStats
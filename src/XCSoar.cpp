@@ -50,6 +50,8 @@ static const char *const Usage = "\n"
   "  -fly            bypass startup-screen, use fly mode directly\n"
 #endif
   "  -profile=fname  load profile from file fname\n"
+  "  -startup-trace=fname  write startup timings to file fname\n"
+  "  -benchmark-startup  write startup timings and quit\n"
   "  -WIDTHxHEIGHT   use screen resolution WIDTH x HEIGHT\n"
   "  -portrait       use a 480x640 screen resolution\n"
   "  -square         use a 480x480 screen resolution\n"
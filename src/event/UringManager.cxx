@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "UringManager.hxx"
+#include "util/PrintException.hxx"
+
+namespace Uring {
+
+Manager::Manager(EventLoop &event_loop, unsigned entries)
+	:Queue(entries),
+	 event(event_loop, BIND_THIS_METHOD(OnReady),
+	       SocketDescriptor::FromFileDescriptor(GetFileDescriptor())),
+	 defer_submit_event(event_loop, BIND_THIS_METHOD(DeferredSubmit))
+{
+	event.ScheduleRead();
+}
+
+void
+Manager::OnReady(unsigned) noexcept
+{
+	DispatchCompletions();
+}
+
+void
+Manager::DeferredSubmit() noexcept
+{
+	try {
+		Queue::Submit();
+	} catch (...) {
+		PrintException(std::current_exception());
+	}
+}
+
+} // namespace Uring
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "SocketEvent.hxx"
+#include "DeferEvent.hxx"
+#include "io/uring/Queue.hxx"
+
+namespace Uring {
+
+/**
+ * Integrates a #Queue into the #EventLoop: completions are
+ * dispatched when the io_uring file descriptor becomes readable,
+ * and submissions are collected and passed to the kernel in one
+ * system call when the #EventLoop is idle.
+ */
+class Manager final : public Queue {
+	SocketEvent event;
+
+	DeferEvent defer_submit_event;
+
+public:
+	/**
+	 * Throws on error.
+	 */
+	explicit Manager(EventLoop &event_loop, unsigned entries=64);
+
+	/* virtual methods from class Queue */
+	void Submit() override {
+		defer_submit_event.ScheduleIdle();
+	}
+
+private:
+	void OnReady(unsigned events) noexcept;
+	void DeferredSubmit() noexcept;
+};
+
+} // namespace Uring
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "AsyncFileWriter.hpp"
+#include "system/Path.hpp"
+
+AsyncFileWriter::AsyncFileWriter(Path path, FileOutputStream::Mode mode,
+                                 Duration _sync_interval)
+  :Thread("FileWriter"),
+   file(path, mode),
+   sync_interval(_sync_interval)
+{
+  Start();
+}
+
+AsyncFileWriter::~AsyncFileWriter() noexcept
+{
+  StopThread();
+}
+
+void
+AsyncFileWriter::StopThread() noexcept
+{
+  if (!IsDefined())
+    return;
+
+  {
+    const std::lock_guard lock{mutex};
+    stop = true;
+    cond.notify_one();
+  }
+
+  Join();
+}
+
+void
+AsyncFileWriter::Write(std::span<const std::byte> src)
+{
+  std::unique_lock lock{mutex};
+
+  if (error)
+    std::rethrow_exception(error);
+
+  if (pending.size() + src.size() > MAX_PENDING && busy)
+    /* the storage is too slow: throttle the caller instead of
+       buffering without limit */
+    done_cond.wait(lock, [this]{ return !busy || error; });
+
+  const bool was_empty = pending.empty();
+  pending.insert(pending.end(), src.begin(), src.end());
+
+  if (was_empty)
+    cond.notify_one();
+}
+
+inline void
+AsyncFileWriter::WaitIdle(std::unique_lock<Mutex> &lock)
+{
+  done_cond.wait(lock, [this]{
+    return error || (!busy && pending.empty() && !sync_requested);
+  });
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void
+AsyncFileWriter::Flush()
+{
+  std::unique_lock lock{mutex};
+  WaitIdle(lock);
+}
+
+void
+AsyncFileWriter::Sync()
+{
+  std::unique_lock lock{mutex};
+  sync_requested = true;
+  cond.notify_one();
+  WaitIdle(lock);
+}
+
+void
+AsyncFileWriter::Commit()
+{
+  Sync();
+  StopThread();
+
+  if (error)
+    std::rethrow_exception(error);
+
+  file.Commit();
+}
+
+void
+AsyncFileWriter::Run() noexcept
+{
+  using Clock = std::chrono::steady_clock;
+
+  /* is there data which has not been synced yet? */
+  bool dirty = false;
+  Clock::time_point sync_time;
+
+  std::unique_lock lock{mutex};
+
+  while (true) {
+    /* sync periodically, and once more before exiting */
+    const bool sync_due = dirty &&
+      (stop || (sync_interval > Duration::zero() &&
+                Clock::now() >= sync_time));
+
+    if (pending.empty() && !sync_requested && !sync_due) {
+      if (stop)
+        break;
+
+      if (dirty && sync_interval > Duration::zero())
+        cond.wait_for(lock, sync_time - Clock::now());
+      else
+        cond.wait(lock);
+      continue;
+    }
+
+    std::swap(pending, writing);
+    const bool sync = sync_requested || sync_due || stop;
+    sync_requested = false;
+    busy = true;
+    lock.unlock();
+
+    std::exception_ptr new_error;
+    try {
+      if (!writing.empty()) {
+        file.Write(writing);
+
+        if (!dirty) {
+          dirty = true;
+          sync_time = Clock::now() + sync_interval;
+        }
+      }
+
+      if (sync && dirty) {
+        file.Sync();
+        dirty = false;
+      }
+    } catch (...) {
+      new_error = std::current_exception();
+    }
+
+    writing.clear();
+
+    lock.lock();
+    busy = false;
+
+    if (new_error) {
+      error = std::move(new_error);
+      pending.clear();
+      dirty = false;
+    }
+
+    done_cond.notify_all();
+  }
+}
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "OutputStream.hxx"
+#include "FileOutputStream.hxx"
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+class Path;
+
+/**
+ * An #OutputStream which writes to a file in a dedicated thread.
+ * Write() only copies the data into a memory buffer, so the caller
+ * is never blocked by slow storage (unless the buffer is full).  The
+ * thread writes the buffer out as soon as possible and calls
+ * FileOutputStream::Sync() periodically, so not more than the data
+ * of one sync interval can be lost when power fails.
+ *
+ * Errors are reported by the next Write(), Flush() or Commit() call;
+ * data written after an error is discarded.
+ */
+class AsyncFileWriter final : public OutputStream, Thread {
+public:
+  using Duration = std::chrono::steady_clock::duration;
+
+private:
+  /**
+   * If the buffer grows beyond this size, Write() waits for the
+   * thread.
+   */
+  static constexpr std::size_t MAX_PENDING = 256 * 1024;
+
+  /**
+   * Only accessed by the thread while it is running.
+   */
+  FileOutputStream file;
+
+  /**
+   * Call FileOutputStream::Sync() this long after the first unsynced
+   * write.  Zero disables periodic syncing.
+   */
+  const Duration sync_interval;
+
+  Mutex mutex;
+
+  /**
+   * Wakes up the thread.
+   */
+  Cond cond;
+
+  /**
+   * Signalled by the thread after it has finished a chunk.
+   */
+  Cond done_cond;
+
+  /**
+   * Data submitted by Write() which the thread has not yet picked
+   * up.
+   */
+  std::vector<std::byte> pending;
+
+  /**
+   * The buffer which is being written by the thread; it is swapped
+   * with #pending to avoid copying and allocating.
+   */
+  std::vector<std::byte> writing;
+
+  std::exception_ptr error;
+
+  /**
+   * Is the thread currently writing #writing?
+   */
+  bool busy = false;
+
+  /**
+   * Has Sync() requested an immediate sync?
+   */
+  bool sync_requested = false;
+
+  bool stop = false;
+
+public:
+  /**
+   * Open the file and launch the thread.
+   *
+   * Throws on error.
+   */
+  AsyncFileWriter(Path path, FileOutputStream::Mode mode,
+                  Duration _sync_interval=std::chrono::seconds(30));
+
+  /**
+   * Writes all pending data and stops the thread.  Unless Commit()
+   * was called, the file is then rolled back as documented by
+   * FileOutputStream::Cancel().
+   */
+  ~AsyncFileWriter() noexcept;
+
+  /* virtual methods from class OutputStream */
+  void Write(std::span<const std::byte> src) override;
+
+  /**
+   * Wait until all data has been written to the file.
+   *
+   * Throws on error.
+   */
+  void Flush();
+
+  /**
+   * Like Flush(), but also sync the file to the storage device.
+   *
+   * Throws on error.
+   */
+  void Sync();
+
+  /**
+   * Write and sync all pending data, stop the thread and commit the
+   * file (see FileOutputStream::Commit()).  After returning, this
+   * object must not be used again.
+   *
+   * Throws on error.
+   */
+  void Commit();
+
+private:
+  /**
+   * Caller must lock the mutex.
+   */
+  void WaitIdle(std::unique_lock<Mutex> &lock);
+
+  void StopThread() noexcept;
+
+  /* virtual methods from class Thread */
+  void Run() noexcept override;
+};
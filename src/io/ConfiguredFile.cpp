@@ -3,7 +3,7 @@
 
 #include "ConfiguredFile.hpp"
 #include "MapFile.hpp"
-#include "FileLineReader.hpp"
+#include "MappedLineReader.hpp"
 #include "ZipArchive.hpp"
 #include "ZipLineReader.hpp"
 #include "ConvertLineReader.hpp"
@@ -23,7 +23,7 @@ try {
   if (path == nullptr)
     return nullptr;
 
-  return std::make_unique<FileLineReaderA>(path);
+  return std::make_unique<MappedLineReaderA>(path);
 } catch (...) {
   LogError(std::current_exception());
   return nullptr;
@@ -31,12 +31,15 @@ try {
 
 std::unique_ptr<TLineReader>
 OpenConfiguredTextFile(std::string_view profile_key, Charset cs)
-{
-  auto reader = OpenConfiguredTextFileA(profile_key);
-  if (!reader)
+try {
+  const auto path = Profile::GetPath(profile_key);
+  if (path == nullptr)
     return nullptr;
 
-  return std::make_unique<ConvertLineReader>(std::move(reader), cs);
+  return std::make_unique<MappedFileLineReader>(path, cs);
+} catch (...) {
+  LogError(std::current_exception());
+  return nullptr;
 }
 
 static std::unique_ptr<NLineReader>
@@ -26,6 +26,18 @@ protected:
     return *source;
   }
 
+  const LineReader<char> &GetSource() const {
+    return *source;
+  }
+
+  /**
+   * Override the charset, e.g. after it has been determined for the
+   * whole file.
+   */
+  void SetCharset(Charset cs) noexcept {
+    converter.SetCharset(cs);
+  }
+
 public:
   /* virtual methods from class LineReader */
   TCHAR *ReadLine() override;
@@ -3,8 +3,7 @@
 
 #include "DataFile.hpp"
 #include "FileReader.hxx"
-#include "FileLineReader.hpp"
-#include "ConvertLineReader.hpp"
+#include "MappedLineReader.hpp"
 #include "LocalPath.hpp"
 #include "system/Path.hpp"
 #include "util/StringCompare.hxx"
@@ -24,7 +23,11 @@ OpenDataFile(const TCHAR *name)
 std::unique_ptr<TLineReader>
 OpenDataTextFile(const TCHAR *name, Charset cs)
 {
-  return std::make_unique<ConvertLineReader>(OpenDataTextFileA(name), cs);
+  assert(name != nullptr);
+  assert(!StringIsEmpty(name));
+
+  const auto path = LocalPath(name);
+  return std::make_unique<MappedFileLineReader>(path, cs);
 }
 
 std::unique_ptr<NLineReader>
@@ -34,5 +37,5 @@ OpenDataTextFileA(const TCHAR *name)
   assert(!StringIsEmpty(name));
 
   const auto path = LocalPath(name);
-  return std::make_unique<FileLineReaderA>(path);
+  return std::make_unique<MappedLineReaderA>(path);
 }
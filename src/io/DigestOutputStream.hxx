@@ -28,6 +28,14 @@ public:
 		return state.Final();
 	}
 
+	/**
+	 * Add data to the digest without writing it to the next
+	 * stream, e.g. data which was written earlier.
+	 */
+	void UpdateDigest(std::span<const std::byte> src) noexcept {
+		state.Update(src);
+	}
+
 	/* virtual methods from class OutputStream */
 	void Write(std::span<const std::byte> src) override {
 		next.Write(src);
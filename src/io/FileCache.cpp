@@ -4,6 +4,7 @@
 #include "FileCache.hpp"
 #include "FileReader.hxx"
 #include "FileOutputStream.hxx"
+#include "FileMapping.hpp"
 #include "system/FileUtil.hpp"
 
 #ifdef _WIN32
@@ -119,6 +120,50 @@ FileCache::Load(const TCHAR *name, Path original_path) noexcept
   return nullptr;
 }
 
+std::unique_ptr<FileMapping>
+FileCache::Map(const TCHAR *name, Path original_path,
+               std::span<const std::byte> &payload_r) noexcept
+{
+  FileInfo original_info;
+  if (!GetRegularFileInfo(original_path, original_info))
+    return nullptr;
+
+  const auto path = MakeCachePath(name);
+
+  FileInfo cached_info;
+  if (!GetRegularFileInfo(path, cached_info))
+    return nullptr;
+
+  /* see Load() */
+  if (original_info.mtime > cached_info.mtime && !original_info.IsFuture()) {
+    File::Delete(path);
+    return nullptr;
+  }
+
+  try {
+    auto mapping = std::make_unique<FileMapping>(path);
+    std::span<const std::byte> data = *mapping;
+
+    unsigned magic;
+    struct FileInfo old_info;
+
+    if (data.size() >= sizeof(magic) + sizeof(old_info)) {
+      memcpy(&magic, data.data(), sizeof(magic));
+      memcpy(&old_info, data.data() + sizeof(magic), sizeof(old_info));
+
+      if (magic == FILE_CACHE_MAGIC &&
+          old_info == original_info) {
+        payload_r = data.subspan(sizeof(magic) + sizeof(old_info));
+        return mapping;
+      }
+    }
+  } catch (...) {
+  }
+
+  File::Delete(path);
+  return nullptr;
+}
+
 std::unique_ptr<FileOutputStream>
 FileCache::Save(const TCHAR *name, Path original_path)
 {
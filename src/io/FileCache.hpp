@@ -6,11 +6,13 @@
 #include "system/Path.hpp"
 
 #include <memory>
+#include <span>
 #include <stdio.h>
 #include <tchar.h>
 
 class Reader;
 class FileOutputStream;
+class FileMapping;
 
 class FileCache {
   AllocatedPath cache_path;
@@ -32,6 +34,17 @@ public:
    */
   std::unique_ptr<Reader> Load(const TCHAR *name, Path original_path) noexcept;
 
+  /**
+   * Like Load(), but map the cache file into memory instead of
+   * reading it.
+   *
+   * @param payload_r on success, receives the file contents following
+   * the cache header
+   * @return nullptr on error
+   */
+  std::unique_ptr<FileMapping> Map(const TCHAR *name, Path original_path,
+                                   std::span<const std::byte> &payload_r) noexcept;
+
   /**
    * Throws on error.
    */
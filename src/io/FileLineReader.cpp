@@ -18,5 +18,7 @@ FileLineReaderA::GetSize() const
 long
 FileLineReaderA::Tell() const
 {
-  return file.GetPosition();
+  /* subtract the data which has been read from the file but not yet
+     consumed, so the result is the offset of the next line */
+  return file.GetPosition() - buffered.Read().size();
 }
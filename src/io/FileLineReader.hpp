@@ -30,6 +30,17 @@ public:
     buffered.Reset();
   }
 
+  /**
+   * Continue reading at the specified file offset, e.g. one obtained
+   * from Tell() earlier.
+   *
+   * Throws on error.
+   */
+  void Seek(off_t offset) {
+    file.Seek(offset);
+    buffered.Reset();
+  }
+
 public:
   /* virtual methods from class NLineReader */
   char *ReadLine() override;
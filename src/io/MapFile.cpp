@@ -2,17 +2,17 @@
 // Copyright The XCSoar Project
 
 #include "MapFile.hpp"
-#include "ZipArchive.hpp"
+#include "ZipArchiveCache.hpp"
 #include "Profile/Profile.hpp"
 #include "system/ConvertPathName.hpp"
 #include "system/Path.hpp"
 
-std::optional<ZipArchive>
+std::shared_ptr<ZipArchive>
 OpenMapFile()
 {
   auto path = Profile::GetPath(ProfileKeys::MapFile);
   if (path == nullptr)
-    return std::nullopt;
+    return nullptr;
 
-  return ZipArchive{path};
+  return OpenSharedZipArchive(path);
 }
@@ -3,17 +3,18 @@
 
 #pragma once
 
-#include <optional>
+#include <memory>
 
 class ZipArchive;
 
 /**
  * Obtain the configured map file path from the profile and open it as
- * a ZIP file.
+ * a ZIP file.  The archive is shared with all other loaders which
+ * have it open (see OpenSharedZipArchive()).
  *
  * Throws on error.
  *
- * @return std::nullopt if no mpa file is configured
+ * @return nullptr if no map file is configured
  */
-std::optional<ZipArchive>
+std::shared_ptr<ZipArchive>
 OpenMapFile();
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "MappedLineReader.hpp"
+#include "FileMapping.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "util/UTF8.hpp"
+
+#include <cstring>
+
+MappedLineReaderA::MappedLineReaderA(Path path)
+{
+  /* FileMapping refuses empty files, but to us, that is just a file
+     without lines */
+  if (File::Exists(path) && File::GetSize(path) == 0)
+    return;
+
+  mapping = std::make_unique<FileMapping>(path);
+
+  const std::span<const std::byte> raw = *mapping;
+  data = {(const char *)raw.data(), raw.size()};
+  if (data.starts_with(utf8_byte_order_mark))
+    data.remove_prefix(utf8_byte_order_mark.size());
+
+  remaining = data;
+}
+
+MappedLineReaderA::~MappedLineReaderA() noexcept = default;
+
+char *
+MappedLineReaderA::ReadLine()
+{
+  if (remaining.empty())
+    return nullptr;
+
+  std::string_view src = remaining;
+  const auto newline = remaining.find('\n');
+  if (newline != remaining.npos) {
+    src = remaining.substr(0, newline);
+    remaining.remove_prefix(newline + 1);
+  } else
+    remaining = {};
+
+  if (src.ends_with('\r'))
+    src.remove_suffix(1);
+
+  char *dest = line.get(src.size() + 1);
+  std::memcpy(dest, src.data(), src.size());
+  dest[src.size()] = '\0';
+  return dest;
+}
+
+long
+MappedLineReaderA::GetSize() const
+{
+  return data.size();
+}
+
+long
+MappedLineReaderA::Tell() const
+{
+  return data.size() - remaining.size();
+}
+
+MappedFileLineReader::MappedFileLineReader(Path path, Charset cs)
+  :ConvertLineReader(std::make_unique<MappedLineReaderA>(path), cs)
+{
+  if (cs == Charset::ISO_LATIN_1)
+    return;
+
+  const auto &source = (const MappedLineReaderA &)GetSource();
+  utf8 = ValidateUTF8(source.GetData());
+
+  if (utf8)
+    SetCharset(Charset::UTF8);
+  else if (cs == Charset::AUTO)
+    SetCharset(Charset::ISO_LATIN_1);
+
+  /* with an invalid UTF-8 file and Charset::UTF8, the converter
+     throws at the first offending line, like FileLineReader */
+}
+
+TCHAR *
+MappedFileLineReader::ReadLine()
+{
+#ifndef _UNICODE
+  if (utf8)
+    /* fast path: already validated, nothing to convert */
+    return GetSource().ReadLine();
+#endif
+
+  return ConvertLineReader::ReadLine();
+}
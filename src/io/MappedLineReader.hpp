@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "ConvertLineReader.hpp"
+#include "util/ReusableArray.hpp"
+
+#include <memory>
+#include <string_view>
+
+class Path;
+class FileMapping;
+
+/**
+ * A #NLineReader which reads a file mapped into memory with
+ * #FileMapping.  There are no read() calls and no buffer refills;
+ * each line is only copied once, because #LineReader promises a
+ * writable and null-terminated buffer.  A UTF-8 byte order mark is
+ * skipped.
+ */
+class MappedLineReaderA : public NLineReader {
+  /**
+   * nullptr if the file is empty.
+   */
+  std::unique_ptr<FileMapping> mapping;
+
+  /**
+   * The whole file (without the byte order mark).
+   */
+  std::string_view data;
+
+  /**
+   * The portion of #data which has not been read yet.
+   */
+  std::string_view remaining;
+
+  ReusableArray<char> line;
+
+public:
+  /**
+   * Throws on error.
+   */
+  explicit MappedLineReaderA(Path path);
+
+  ~MappedLineReaderA() noexcept override;
+
+  std::string_view GetData() const noexcept {
+    return data;
+  }
+
+  /**
+   * Rewind the file to the beginning.
+   */
+  void Rewind() noexcept {
+    remaining = data;
+  }
+
+public:
+  /* virtual methods from class NLineReader */
+  char *ReadLine() override;
+  long GetSize() const override;
+  long Tell() const override;
+};
+
+/**
+ * A #TLineReader for files mapped into memory.  Unlike
+ * #FileLineReader, the charset is detected once for the whole file
+ * instead of line by line.  If the file is valid UTF-8 (which
+ * includes plain ASCII), lines are passed through without conversion
+ * or validation (except on Windows, where they need to be converted
+ * to wide characters).
+ */
+class MappedFileLineReader : public ConvertLineReader {
+  /**
+   * Was the whole file found to be valid UTF-8?
+   */
+  bool utf8 = false;
+
+public:
+  /**
+   * Throws on error.
+   *
+   * @param cs the character set of the file; #Charset::AUTO means
+   * UTF-8 if the whole file is valid UTF-8 and ISO-Latin-1 otherwise
+   */
+  explicit MappedFileLineReader(Path path, Charset cs=Charset::UTF8);
+
+  bool IsUTF8() const noexcept {
+    return utf8;
+  }
+
+  /**
+   * Rewind the file to the beginning.
+   */
+  void Rewind() noexcept {
+    ((MappedLineReaderA &)GetSource()).Rewind();
+  }
+
+public:
+  /* virtual methods from class LineReader */
+  TCHAR *ReadLine() override;
+};
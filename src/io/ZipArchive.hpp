@@ -43,6 +43,10 @@ public:
    * Obtain the next directory entry name.  Can be used to iterate
    * over all files in the archive.  Returns an empty string after the
    * last entry.
+   *
+   * The position is stored in the archive, therefore this must not
+   * be used on an archive which is shared between threads (see
+   * OpenSharedZipArchive()).
    */
   std::string NextName() noexcept;
 };
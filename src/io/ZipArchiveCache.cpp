@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ZipArchiveCache.hpp"
+#include "ZipArchive.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "thread/Mutex.hxx"
+
+#include <zzip/lib.h>
+
+#include <list>
+
+#ifdef ZZIP_HAVE_PREAD
+
+namespace {
+
+struct Item {
+  AllocatedPath path;
+  std::weak_ptr<ZipArchive> archive;
+
+  std::chrono::system_clock::time_point mtime;
+  uint64_t size;
+};
+
+} // anonymous namespace
+
+static Mutex mutex;
+static std::list<Item> items;
+
+std::shared_ptr<ZipArchive>
+OpenSharedZipArchive(Path path)
+{
+  const auto mtime = File::GetLastModification(path);
+  const auto size = File::GetSize(path);
+
+  const std::lock_guard lock{mutex};
+
+  for (auto i = items.begin(); i != items.end();) {
+    auto next = std::next(i);
+
+    if (i->path == path) {
+      if (auto archive = i->archive.lock();
+          archive && i->mtime == mtime && i->size == size)
+        return archive;
+
+      /* closed or replaced: users of the old archive keep it open
+         until they are done */
+      items.erase(i);
+    } else if (i->archive.expired())
+      items.erase(i);
+
+    i = next;
+  }
+
+  auto archive = std::make_shared<ZipArchive>(path);
+  items.push_back({path, archive, mtime, size});
+  return archive;
+}
+
+#else
+
+std::shared_ptr<ZipArchive>
+OpenSharedZipArchive(Path path)
+{
+  /* all ZZIP_FILEs of one ZZIP_DIR share its file position, therefore
+     the ZZIP_DIR must not be used by more than one thread */
+  return std::make_shared<ZipArchive>(path);
+}
+
+#endif
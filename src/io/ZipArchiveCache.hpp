@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <memory>
+
+class Path;
+class ZipArchive;
+
+/**
+ * Open a ZIP archive, sharing the handle (and its parsed central
+ * directory) with everybody else who has the same file open.  The
+ * archive is closed when the last reference is released.  A file
+ * which has been modified since it was opened is opened again.
+ *
+ * With pread(), entries of the shared archive may be read by several
+ * threads simultaneously, as long as each thread uses its own
+ * #ZipReader; the directory iterator ZipArchive::NextName() is not
+ * thread-safe.  Without pread(), each call returns a new private
+ * archive.
+ *
+ * This function is thread-safe.  Throws on error.
+ */
+std::shared_ptr<ZipArchive>
+OpenSharedZipArchive(Path path);
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "BufferRing.hxx"
+#include "Queue.hxx"
+#include "system/Error.hxx"
+
+#include <atomic>
+#include <cassert>
+
+#include <sys/mman.h>
+
+namespace Uring {
+
+static constexpr std::size_t
+RoundUp(std::size_t size, std::size_t alignment) noexcept
+{
+	return (size + alignment - 1) & ~(alignment - 1);
+}
+
+BufferRing::BufferRing(Queue &_queue, unsigned _n_buffers,
+		       std::size_t _buffer_size)
+	:queue(_queue),
+	 buffer_size(_buffer_size), n_buffers(_n_buffers),
+	 group(queue.AllocateBufferGroup())
+{
+	assert(n_buffers > 0);
+	assert((n_buffers & (n_buffers - 1)) == 0);
+
+	/* the ring must be page aligned; the buffers follow it in
+	   the same anonymous mapping */
+	const std::size_t ring_size =
+		RoundUp(n_buffers * sizeof(struct io_uring_buf), 4096);
+	mapping_size = ring_size + n_buffers * buffer_size;
+
+	void *p = mmap(nullptr, mapping_size, PROT_READ|PROT_WRITE,
+		       MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED) {
+		queue.ReleaseBufferGroup(group);
+		throw MakeErrno("Failed to allocate io_uring buffers");
+	}
+
+	ring = static_cast<struct io_uring_buf *>(p);
+	buffers = static_cast<std::byte *>(p) + ring_size;
+
+	struct io_uring_buf_reg reg{};
+	reg.ring_addr = reinterpret_cast<std::uintptr_t>(ring);
+	reg.ring_entries = n_buffers;
+	reg.bgid = group;
+
+	try {
+		queue.GetRing().Register(IORING_REGISTER_PBUF_RING, &reg, 1);
+	} catch (...) {
+		munmap(p, mapping_size);
+		queue.ReleaseBufferGroup(group);
+		throw;
+	}
+
+	for (unsigned i = 0; i < n_buffers; ++i)
+		Add(i);
+	Publish();
+}
+
+BufferRing::~BufferRing() noexcept
+{
+	struct io_uring_buf_reg reg{};
+	reg.bgid = group;
+
+	try {
+		queue.GetRing().Register(IORING_UNREGISTER_PBUF_RING, &reg, 1);
+	} catch (...) {
+		/* the kernel frees it along with the ring */
+	}
+
+	munmap(ring, mapping_size);
+	queue.ReleaseBufferGroup(group);
+}
+
+inline void
+BufferRing::Add(unsigned id) noexcept
+{
+	auto &buf = ring[tail & (n_buffers - 1)];
+	buf.addr = reinterpret_cast<std::uintptr_t>(buffers + id * buffer_size);
+	buf.len = buffer_size;
+	buf.bid = id;
+	++tail;
+}
+
+inline void
+BufferRing::Publish() noexcept
+{
+	/* the tail overlays the "resv" field of the first entry */
+	std::atomic_ref<__u16>{ring[0].resv}.store(tail,
+						   std::memory_order_release);
+}
+
+void
+BufferRing::Recycle(unsigned id) noexcept
+{
+	Add(id);
+	Publish();
+}
+
+} // namespace Uring
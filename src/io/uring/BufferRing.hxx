@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+struct io_uring_buf;
+
+namespace Uring {
+
+class Queue;
+
+/**
+ * A set of equally sized buffers registered with the kernel as a
+ * "provided buffer ring" (Linux 5.19).  Operations submitted with
+ * IOSQE_BUFFER_SELECT and this buffer group pick a buffer when data
+ * arrives, and the completion carries its id; the buffer must be
+ * given back with Recycle() after the data has been consumed.
+ */
+class BufferRing {
+	Queue &queue;
+
+	/**
+	 * The ring shared with the kernel.  This is really a
+	 * "struct io_uring_buf_ring", but its flexible array member
+	 * is misplaced when <linux/io_uring.h> is compiled as C++.
+	 */
+	struct io_uring_buf *ring;
+
+	std::byte *buffers;
+
+	/**
+	 * The size of the memory mapping containing #ring and
+	 * #buffers.
+	 */
+	std::size_t mapping_size;
+
+	const std::size_t buffer_size;
+
+	const unsigned n_buffers;
+
+	uint_least16_t tail = 0;
+
+	const uint_least16_t group;
+
+public:
+	/**
+	 * Throws on error.
+	 *
+	 * @param n_buffers the number of buffers; must be a power of
+	 * two
+	 */
+	BufferRing(Queue &_queue, unsigned _n_buffers, std::size_t _buffer_size);
+	~BufferRing() noexcept;
+
+	BufferRing(const BufferRing &) = delete;
+	BufferRing &operator=(const BufferRing &) = delete;
+
+	uint_least16_t GetGroup() const noexcept {
+		return group;
+	}
+
+	std::size_t GetBufferSize() const noexcept {
+		return buffer_size;
+	}
+
+	std::span<const std::byte> Get(unsigned id,
+				       std::size_t length) const noexcept {
+		return {buffers + id * buffer_size, length};
+	}
+
+	/**
+	 * Give a buffer back to the kernel.
+	 */
+	void Recycle(unsigned id) noexcept;
+
+private:
+	void Add(unsigned id) noexcept;
+	void Publish() noexcept;
+};
+
+} // namespace Uring
@@ -1 +1,7 @@
-// empty file, because XCSoar doesn't use io_uring
+#pragma once
+
+/* io_uring is optional; it is enabled with "make USE_URING=y", which
+   defines ENABLE_URING */
+#if defined(__linux__) && defined(ENABLE_URING)
+#define HAVE_URING
+#endif
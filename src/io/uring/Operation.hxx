@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "util/IntrusiveList.hxx"
+
+namespace Uring {
+
+/**
+ * An operation submitted to a #Queue, which gets notified about its
+ * completions.
+ */
+class Operation : public IntrusiveListHook<IntrusiveHookMode::TRACK> {
+public:
+	Operation() = default;
+
+	Operation(const Operation &) = delete;
+	Operation &operator=(const Operation &) = delete;
+
+	/**
+	 * Has this operation been submitted and is still waiting
+	 * for its final completion?
+	 */
+	bool IsUringPending() const noexcept {
+		return is_linked();
+	}
+
+	/**
+	 * A completion was received.
+	 *
+	 * @param res the result (a negative errno value on error)
+	 * @param flags the IORING_CQE_F_* flags; if IORING_CQE_F_MORE
+	 * is set, more completions will follow; if not, this operation
+	 * is no longer pending and may be destroyed or submitted again
+	 */
+	virtual void OnUringCompletion(int res, unsigned flags) noexcept = 0;
+
+protected:
+	~Operation() noexcept = default;
+};
+
+} // namespace Uring
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Queue.hxx"
+
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+
+namespace Uring {
+
+static bool
+ProbeOperation(Ring &ring, uint8_t op) noexcept
+{
+	static constexpr unsigned n_ops = 256;
+	alignas(struct io_uring_probe)
+		std::byte buffer[sizeof(struct io_uring_probe) +
+				 n_ops * sizeof(struct io_uring_probe_op)]{};
+	auto &probe = *reinterpret_cast<struct io_uring_probe *>(buffer);
+
+	try {
+		/* Linux 5.6 */
+		ring.Register(IORING_REGISTER_PROBE, &probe, n_ops);
+	} catch (...) {
+		return false;
+	}
+
+	return op < probe.ops_len &&
+		(probe.ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+}
+
+Queue::Queue(unsigned entries, unsigned flags)
+	:ring(entries, flags),
+	 multishot_read(ProbeOperation(ring, OP_READ_MULTISHOT))
+{
+}
+
+Queue::~Queue() noexcept
+{
+	CancelAll();
+}
+
+uint_least16_t
+Queue::AllocateBufferGroup()
+{
+	if (!free_buffer_groups.empty()) {
+		const auto id = free_buffer_groups.back();
+		free_buffer_groups.pop_back();
+		return id;
+	}
+
+	if (next_buffer_group == UINT16_MAX)
+		throw std::runtime_error("Too many io_uring buffer groups");
+
+	return next_buffer_group++;
+}
+
+struct io_uring_sqe &
+Queue::RequireSubmitEntry()
+{
+	auto *sqe = ring.GetSubmitEntry();
+	if (sqe == nullptr) {
+		/* the submission queue is full: flush it */
+		ring.Submit();
+
+		sqe = ring.GetSubmitEntry();
+		if (sqe == nullptr)
+			throw std::runtime_error("io_uring submission queue is full");
+	}
+
+	return *sqe;
+}
+
+void
+Queue::Push(struct io_uring_sqe &sqe, Operation &operation)
+{
+	if (closing) {
+		/* CancelAll() is waiting for the pending operations
+		   to finish; don't let them submit new ones */
+		sqe.opcode = IORING_OP_NOP;
+		sqe.flags = 0;
+		sqe.user_data = 0;
+		operation.OnUringCompletion(-ECANCELED, 0);
+		return;
+	}
+
+	sqe.user_data = reinterpret_cast<std::uintptr_t>(&operation);
+
+	if (!operation.IsUringPending())
+		operations.push_back(operation);
+
+	Submit();
+}
+
+void
+Queue::Cancel(Operation &operation)
+{
+	assert(operation.IsUringPending());
+
+	auto &sqe = RequireSubmitEntry();
+	sqe.opcode = IORING_OP_ASYNC_CANCEL;
+	sqe.addr = reinterpret_cast<std::uintptr_t>(&operation);
+	/* the completion of the cancel request itself is ignored */
+	sqe.user_data = 0;
+	Submit();
+}
+
+void
+Queue::DispatchCompletions() noexcept
+{
+	while (const auto *cqe = ring.PeekCompletion()) {
+		const auto user_data = cqe->user_data;
+		const int res = cqe->res;
+		const unsigned flags = cqe->flags;
+		ring.SeenCompletion();
+
+		if (user_data == 0)
+			continue;
+
+		auto &operation = *reinterpret_cast<Operation *>(user_data);
+		if ((flags & IORING_CQE_F_MORE) == 0)
+			operations.erase(operations.iterator_to(operation));
+
+		operation.OnUringCompletion(res, flags);
+	}
+}
+
+void
+Queue::CancelAll() noexcept
+{
+	closing = true;
+
+	try {
+		for (auto &operation : operations) {
+			auto &sqe = RequireSubmitEntry();
+			sqe.opcode = IORING_OP_ASYNC_CANCEL;
+			sqe.addr = reinterpret_cast<std::uintptr_t>(&operation);
+		}
+
+		ring.Submit();
+
+		/* cancelling a request which waits for a file to
+		   become readable completes right away */
+		while (HasPending()) {
+			ring.WaitCompletion();
+			DispatchCompletions();
+		}
+	} catch (...) {
+		/* give up waiting; the kernel will cancel the
+		   remaining requests when the ring is closed */
+		operations.clear_and_dispose([](Operation *operation){
+			operation->OnUringCompletion(-ECANCELED, 0);
+		});
+	}
+}
+
+} // namespace Uring
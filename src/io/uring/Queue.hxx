@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Ring.hxx"
+#include "Operation.hxx"
+
+#include <cstdint>
+#include <vector>
+
+namespace Uring {
+
+/**
+ * An io_uring instance which dispatches completions to #Operation
+ * instances.
+ *
+ * This class is not thread-safe.
+ */
+class Queue {
+	Ring ring;
+
+	/**
+	 * All operations which have been submitted and are waiting
+	 * for their final completion.
+	 */
+	IntrusiveList<Operation> operations;
+
+	/**
+	 * Buffer group ids which have been released by
+	 * ReleaseBufferGroup() and can be reused.
+	 */
+	std::vector<uint_least16_t> free_buffer_groups;
+
+	uint_least16_t next_buffer_group = 0;
+
+	/**
+	 * Does the kernel support IORING_OP_READ_MULTISHOT?
+	 */
+	bool multishot_read = false;
+
+	/**
+	 * Set by CancelAll(); from now on, Push() cancels new
+	 * operations right away.
+	 */
+	bool closing = false;
+
+public:
+	/**
+	 * Throws on error.
+	 */
+	explicit Queue(unsigned entries, unsigned flags=0);
+
+	/**
+	 * Cancels all pending operations and waits for their final
+	 * completions.
+	 */
+	virtual ~Queue() noexcept;
+
+	Queue(const Queue &) = delete;
+	Queue &operator=(const Queue &) = delete;
+
+	FileDescriptor GetFileDescriptor() const noexcept {
+		return ring.GetFileDescriptor();
+	}
+
+	Ring &GetRing() noexcept {
+		return ring;
+	}
+
+	bool HasMultishotRead() const noexcept {
+		return multishot_read;
+	}
+
+	/**
+	 * Allocate a buffer group id for a provided buffer ring.
+	 *
+	 * Throws if all ids are in use.
+	 */
+	uint_least16_t AllocateBufferGroup();
+
+	void ReleaseBufferGroup(uint_least16_t id) noexcept {
+		free_buffer_groups.push_back(id);
+	}
+
+	bool HasPending() const noexcept {
+		return !operations.empty();
+	}
+
+	/**
+	 * Obtain a submission queue entry, submitting the queue
+	 * first if it is full.
+	 *
+	 * Throws on error.
+	 */
+	struct io_uring_sqe &RequireSubmitEntry();
+
+	/**
+	 * Attach the given operation to the submission queue entry
+	 * and submit it.
+	 *
+	 * Throws on error.
+	 */
+	void Push(struct io_uring_sqe &sqe, Operation &operation);
+
+	/**
+	 * Ask the kernel to cancel the given pending operation.  It
+	 * remains pending until its final completion (usually with
+	 * -ECANCELED) has been dispatched.
+	 *
+	 * Throws on error.
+	 */
+	void Cancel(Operation &operation);
+
+	/**
+	 * Pass all entries obtained by RequireSubmitEntry() to the
+	 * kernel.  This may be overridden to defer the system call.
+	 *
+	 * Throws on error.
+	 */
+	virtual void Submit() {
+		ring.Submit();
+	}
+
+	/**
+	 * Invoke the #Operation for all completions which are
+	 * available now (without blocking).
+	 */
+	void DispatchCompletions() noexcept;
+
+private:
+	void CancelAll() noexcept;
+};
+
+} // namespace Uring
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ReadStream.hxx"
+#include "Queue.hxx"
+
+#include <cassert>
+#include <cerrno>
+
+namespace Uring {
+
+/**
+ * Serial devices deliver a few kilobytes per second at most; eight
+ * buffers give the kernel room for a burst while we're busy.
+ */
+static constexpr unsigned N_BUFFERS = 8;
+static constexpr std::size_t BUFFER_SIZE = 4096;
+
+ReadStream::ReadStream(Queue &_queue, FileDescriptor _fd,
+		       ReadStreamHandler &_handler)
+	:queue(_queue), handler(&_handler),
+	 buffers(_queue, N_BUFFERS, BUFFER_SIZE),
+	 fd(_fd),
+	 multishot(queue.HasMultishotRead())
+{
+}
+
+ReadStream *
+ReadStream::Start(Queue &queue, FileDescriptor fd,
+		  ReadStreamHandler &handler) noexcept
+{
+	ReadStream *stream;
+
+	try {
+		stream = new ReadStream(queue, fd, handler);
+	} catch (...) {
+		/* probably no provided buffer rings (Linux 5.19) */
+		return nullptr;
+	}
+
+	try {
+		stream->Submit();
+	} catch (...) {
+		delete stream;
+		return nullptr;
+	}
+
+	return stream;
+}
+
+void
+ReadStream::Cancel() noexcept
+{
+	assert(handler != nullptr);
+
+	handler = nullptr;
+
+	/* if it's not pending, we're being called from
+	   OnUringCompletion(), which will destroy this object */
+	if (IsUringPending()) {
+		try {
+			queue.Cancel(*this);
+		} catch (...) {
+			/* the final completion will arrive when the
+			   Queue is destroyed */
+		}
+	}
+}
+
+void
+ReadStream::Submit()
+{
+	auto &sqe = queue.RequireSubmitEntry();
+	sqe.opcode = multishot ? OP_READ_MULTISHOT : uint8_t(IORING_OP_READ);
+	sqe.flags = IOSQE_BUFFER_SELECT;
+	sqe.fd = fd.Get();
+	/* read from the current position */
+	sqe.off = ~__u64{};
+	sqe.len = multishot ? 0 : buffers.GetBufferSize();
+	sqe.buf_group = buffers.GetGroup();
+
+	/* this may invoke OnUringCompletion() right away if the
+	   Queue is being destroyed */
+	queue.Push(sqe, *this);
+}
+
+void
+ReadStream::Fail(int error) noexcept
+{
+	auto &_handler = *handler;
+	delete this;
+	_handler.OnUringReadError(error);
+}
+
+void
+ReadStream::OnUringCompletion(int res, unsigned flags) noexcept
+{
+	const bool more = flags & IORING_CQE_F_MORE;
+
+	if (res > 0) {
+		assert(flags & IORING_CQE_F_BUFFER);
+
+		const unsigned id = flags >> IORING_CQE_BUFFER_SHIFT;
+		if (handler != nullptr)
+			handler->OnUringRead(buffers.Get(id, res));
+		buffers.Recycle(id);
+	} else if (flags & IORING_CQE_F_BUFFER)
+		buffers.Recycle(flags >> IORING_CQE_BUFFER_SHIFT);
+
+	if (more)
+		return;
+
+	if (handler == nullptr) {
+		/* cancelled */
+		delete this;
+		return;
+	}
+
+	if (res == 0) {
+		auto &_handler = *handler;
+		delete this;
+		_handler.OnUringReadEnd();
+		return;
+	}
+
+	if (res < 0) {
+		switch (-res) {
+		case ENOBUFS:
+			/* all buffers were in use when data arrived;
+			   they have been recycled meanwhile */
+		case EINTR:
+		case EAGAIN:
+			break;
+
+		case EINVAL:
+		case EOPNOTSUPP:
+		case EBADFD:
+			if (multishot) {
+				/* this file doesn't support
+				   multishot reads */
+				multishot = false;
+				break;
+			}
+
+			Fail(-res);
+			return;
+
+		default:
+			Fail(-res);
+			return;
+		}
+	}
+
+	try {
+		Submit();
+	} catch (...) {
+		Fail(EBUSY);
+	}
+}
+
+} // namespace Uring
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "Operation.hxx"
+#include "BufferRing.hxx"
+#include "io/FileDescriptor.hxx"
+
+#include <span>
+
+namespace Uring {
+
+class Queue;
+
+class ReadStreamHandler {
+public:
+	/**
+	 * Data has been received.
+	 */
+	virtual void OnUringRead(std::span<const std::byte> src) noexcept = 0;
+
+	/**
+	 * The end of the stream has been reached.  The #ReadStream
+	 * has been destroyed.
+	 */
+	virtual void OnUringReadEnd() noexcept = 0;
+
+	/**
+	 * Reading has failed.  The #ReadStream has been destroyed.
+	 *
+	 * @param error an errno value; ECANCELED if the #Queue is
+	 * being destroyed
+	 */
+	virtual void OnUringReadError(int error) noexcept = 0;
+};
+
+/**
+ * Reads continuously from a pollable file descriptor (a tty, a pipe
+ * or a socket) into a provided buffer ring.
+ *
+ * With IORING_OP_READ_MULTISHOT (Linux 6.7), one submission keeps
+ * delivering data until cancelled; older kernels get a single-shot
+ * read which is submitted again after each completion, together
+ * with other submissions in the next io_uring_enter() call.
+ *
+ * Instances are created with Start() and destroy themselves: either
+ * after reporting the end of the stream or an error to the handler,
+ * or after Cancel().
+ */
+class ReadStream final : Operation {
+	Queue &queue;
+
+	ReadStreamHandler *handler;
+
+	BufferRing buffers;
+
+	const FileDescriptor fd;
+
+	bool multishot;
+
+	ReadStream(Queue &_queue, FileDescriptor _fd,
+		   ReadStreamHandler &_handler);
+	~ReadStream() noexcept = default;
+
+public:
+	/**
+	 * Start reading from the given file descriptor.  It must
+	 * remain open until the handler reports the end of the
+	 * stream or an error, or until Cancel() is called.
+	 *
+	 * @return the new instance or nullptr if this kernel lacks
+	 * the required io_uring features
+	 */
+	static ReadStream *Start(Queue &queue, FileDescriptor fd,
+				 ReadStreamHandler &handler) noexcept;
+
+	/**
+	 * Stop reading and destroy this object (possibly later, when
+	 * the kernel has released the buffers).  The handler will
+	 * not be invoked again.
+	 */
+	void Cancel() noexcept;
+
+private:
+	/**
+	 * Throws on error.
+	 */
+	void Submit();
+
+	/**
+	 * Invoke the handler's OnUringReadError() and destroy this
+	 * object.
+	 */
+	void Fail(int error) noexcept;
+
+	/* virtual methods from class Operation */
+	void OnUringCompletion(int res, unsigned flags) noexcept override;
+};
+
+} // namespace Uring
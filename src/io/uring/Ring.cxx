@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Ring.hxx"
+#include "system/Error.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace Uring {
+
+template<typename T>
+static T *
+At(void *base, std::size_t offset) noexcept
+{
+	return reinterpret_cast<T *>(static_cast<std::byte *>(base) + offset);
+}
+
+static unsigned
+LoadAcquire(unsigned *p) noexcept
+{
+	return std::atomic_ref<unsigned>{*p}.load(std::memory_order_acquire);
+}
+
+static void
+StoreRelease(unsigned *p, unsigned value) noexcept
+{
+	std::atomic_ref<unsigned>{*p}.store(value, std::memory_order_release);
+}
+
+static int
+Enter(FileDescriptor fd, unsigned to_submit, unsigned min_complete,
+      unsigned flags) noexcept
+{
+	return syscall(__NR_io_uring_enter, fd.Get(), to_submit, min_complete,
+		       flags, nullptr, 0);
+}
+
+Ring::Ring(unsigned entries, unsigned flags)
+{
+	struct io_uring_params params{};
+	params.flags = flags;
+
+	const int _fd = syscall(__NR_io_uring_setup, entries, &params);
+	if (_fd < 0)
+		throw MakeErrno("io_uring_setup() failed");
+
+	fd = UniqueFileDescriptor{_fd};
+
+	/* Linux 5.4 */
+	if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0)
+		throw std::runtime_error("io_uring is too old");
+
+	ring_size = std::max(params.sq_off.array +
+			     params.sq_entries * sizeof(unsigned),
+			     params.cq_off.cqes +
+			     params.cq_entries * sizeof(struct io_uring_cqe));
+	ring = mmap(nullptr, ring_size, PROT_READ|PROT_WRITE,
+		    MAP_SHARED|MAP_POPULATE, fd.Get(), IORING_OFF_SQ_RING);
+	if (ring == MAP_FAILED)
+		throw MakeErrno("Failed to map io_uring");
+
+	sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+	void *_sqes = mmap(nullptr, sqes_size, PROT_READ|PROT_WRITE,
+			   MAP_SHARED|MAP_POPULATE, fd.Get(), IORING_OFF_SQES);
+	if (_sqes == MAP_FAILED) {
+		const int e = errno;
+		munmap(ring, ring_size);
+		throw MakeErrno(e, "Failed to map io_uring");
+	}
+
+	sqes = static_cast<struct io_uring_sqe *>(_sqes);
+
+	sq_head = At<unsigned>(ring, params.sq_off.head);
+	sq_tail = At<unsigned>(ring, params.sq_off.tail);
+	sq_mask = *At<unsigned>(ring, params.sq_off.ring_mask);
+	sq_entries = *At<unsigned>(ring, params.sq_off.ring_entries);
+	sqe_tail = *sq_tail;
+
+	/* submission queue entries are always used in order, so the
+	   indirection array is the identity */
+	unsigned *sq_array = At<unsigned>(ring, params.sq_off.array);
+	for (unsigned i = 0; i < sq_entries; ++i)
+		sq_array[i] = i;
+
+	cq_head = At<unsigned>(ring, params.cq_off.head);
+	cq_tail = At<unsigned>(ring, params.cq_off.tail);
+	cq_mask = *At<unsigned>(ring, params.cq_off.ring_mask);
+	cqes = At<struct io_uring_cqe>(ring, params.cq_off.cqes);
+}
+
+Ring::~Ring() noexcept
+{
+	munmap(sqes, sqes_size);
+	munmap(ring, ring_size);
+}
+
+struct io_uring_sqe *
+Ring::GetSubmitEntry() noexcept
+{
+	if (sqe_tail - LoadAcquire(sq_head) >= sq_entries)
+		return nullptr;
+
+	auto *sqe = &sqes[sqe_tail & sq_mask];
+	++sqe_tail;
+
+	memset(sqe, 0, sizeof(*sqe));
+	return sqe;
+}
+
+void
+Ring::Submit()
+{
+	StoreRelease(sq_tail, sqe_tail);
+
+	const unsigned n = sqe_tail - LoadAcquire(sq_head);
+	if (n == 0)
+		return;
+
+	if (Enter(fd, n, 0, 0) < 0 && errno != EINTR)
+		throw MakeErrno("io_uring_enter() failed");
+}
+
+void
+Ring::WaitCompletion()
+{
+	if (Enter(fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+		throw MakeErrno("io_uring_enter() failed");
+}
+
+struct io_uring_cqe *
+Ring::PeekCompletion() noexcept
+{
+	const unsigned head = *cq_head;
+	if (head == LoadAcquire(cq_tail))
+		return nullptr;
+
+	return &cqes[head & cq_mask];
+}
+
+void
+Ring::SeenCompletion() noexcept
+{
+	StoreRelease(cq_head, *cq_head + 1);
+}
+
+void
+Ring::Register(unsigned opcode, const void *arg, unsigned nr_args)
+{
+	if (syscall(__NR_io_uring_register, fd.Get(), opcode,
+		    arg, nr_args) < 0)
+		throw MakeErrno("io_uring_register() failed");
+}
+
+} // namespace Uring
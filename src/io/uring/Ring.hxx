@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "io/UniqueFileDescriptor.hxx"
+
+#include <linux/io_uring.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Uring {
+
+/**
+ * IORING_OP_READ_MULTISHOT (Linux 6.7), which is missing in older
+ * kernel headers.
+ */
+static constexpr uint8_t OP_READ_MULTISHOT = 49;
+
+/**
+ * A thin wrapper for an io_uring instance, talking to the kernel
+ * with the raw system calls (no liburing).
+ *
+ * This class is not thread-safe.
+ */
+class Ring {
+	UniqueFileDescriptor fd;
+
+	/**
+	 * The shared mapping of the submission and completion
+	 * queue rings (IORING_FEAT_SINGLE_MMAP).
+	 */
+	void *ring;
+	std::size_t ring_size;
+
+	struct io_uring_sqe *sqes;
+	std::size_t sqes_size;
+
+	unsigned *sq_head, *sq_tail;
+	unsigned sq_mask, sq_entries;
+
+	/**
+	 * The tail of the submission queue including entries
+	 * returned by GetSubmitEntry() which have not yet been
+	 * passed to the kernel by Submit().
+	 */
+	unsigned sqe_tail;
+
+	unsigned *cq_head, *cq_tail;
+	unsigned cq_mask;
+	struct io_uring_cqe *cqes;
+
+public:
+	/**
+	 * Throws on error.
+	 */
+	explicit Ring(unsigned entries, unsigned flags=0);
+
+	~Ring() noexcept;
+
+	Ring(const Ring &) = delete;
+	Ring &operator=(const Ring &) = delete;
+
+	FileDescriptor GetFileDescriptor() const noexcept {
+		return fd;
+	}
+
+	/**
+	 * Obtain a cleared submission queue entry.
+	 *
+	 * @return nullptr if the submission queue is full
+	 */
+	struct io_uring_sqe *GetSubmitEntry() noexcept;
+
+	/**
+	 * Pass all entries obtained by GetSubmitEntry() to the
+	 * kernel.
+	 *
+	 * Throws on error.
+	 */
+	void Submit();
+
+	/**
+	 * Wait until at least one completion is available.
+	 *
+	 * Throws on error.
+	 */
+	void WaitCompletion();
+
+	/**
+	 * @return the oldest completion queue entry or nullptr if
+	 * there is none; call SeenCompletion() after processing it
+	 */
+	struct io_uring_cqe *PeekCompletion() noexcept;
+
+	void SeenCompletion() noexcept;
+
+	/**
+	 * A wrapper for io_uring_register().
+	 *
+	 * Throws on error.
+	 */
+	void Register(unsigned opcode, const void *arg, unsigned nr_args);
+};
+
+} // namespace Uring
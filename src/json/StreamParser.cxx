@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "StreamParser.hxx"
+#include "io/Reader.hxx"
+#include "util/SpanCast.hxx"
+
+#include <boost/json/basic_parser_impl.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+namespace Json {
+
+double
+StreamValue::ToDouble() const noexcept
+{
+	switch (type) {
+	case Type::NUMBER:
+	case Type::BOOLEAN:
+		return number;
+
+	case Type::STRING:
+		break;
+
+	case Type::NULL_:
+		return 0;
+	}
+
+	/* copy to a null-terminated buffer for strtod() */
+	char buffer[64];
+	if (string.empty() || string.size() >= sizeof(buffer))
+		return 0;
+
+	*std::copy(string.begin(), string.end(), buffer) = 0;
+	char *endptr;
+	const double value = std::strtod(buffer, &endptr);
+	return endptr == buffer ? 0 : value;
+}
+
+/**
+ * The handler for boost::json::basic_parser which forwards events to
+ * a #StreamHandler.  Partial keys, strings and numbers are collected
+ * in buffers which are reused.
+ */
+struct StreamParser::Handler {
+	static constexpr std::size_t max_object_size = std::size_t(-1);
+	static constexpr std::size_t max_array_size = std::size_t(-1);
+	static constexpr std::size_t max_key_size = std::size_t(-1);
+	static constexpr std::size_t max_string_size = std::size_t(-1);
+
+	using error_code = boost::json::error_code;
+	using string_view = boost::json::string_view;
+
+	StreamHandler &handler;
+
+	std::string key, string, number;
+
+	unsigned depth = 0;
+
+	explicit Handler(StreamHandler &_handler) noexcept
+		:handler(_handler) {}
+
+	void Value(StreamValue::Type type, std::string_view s,
+		   double n) {
+		handler.OnValue(depth, key, StreamValue{type, s, n});
+
+		/* the key belongs to this value only */
+		key.clear();
+	}
+
+	void Number(string_view s, double n) {
+		number.append(s);
+		Value(StreamValue::Type::NUMBER, number, n);
+		number.clear();
+	}
+
+	bool on_document_begin(error_code &) noexcept {
+		return true;
+	}
+
+	bool on_document_end(error_code &) noexcept {
+		return true;
+	}
+
+	bool on_object_begin(error_code &) {
+		handler.OnBegin(depth++, key, false);
+		key.clear();
+		return true;
+	}
+
+	bool on_object_end(std::size_t, error_code &) {
+		handler.OnEnd(--depth, false);
+		return true;
+	}
+
+	bool on_array_begin(error_code &) {
+		handler.OnBegin(depth++, key, true);
+		key.clear();
+		return true;
+	}
+
+	bool on_array_end(std::size_t, error_code &) {
+		handler.OnEnd(--depth, true);
+		return true;
+	}
+
+	bool on_key_part(string_view s, std::size_t, error_code &) {
+		key.append(s);
+		return true;
+	}
+
+	bool on_key(string_view s, std::size_t, error_code &) {
+		key.append(s);
+		return true;
+	}
+
+	bool on_string_part(string_view s, std::size_t, error_code &) {
+		string.append(s);
+		return true;
+	}
+
+	bool on_string(string_view s, std::size_t, error_code &) {
+		string.append(s);
+		Value(StreamValue::Type::STRING, string, 0);
+		string.clear();
+		return true;
+	}
+
+	bool on_number_part(string_view s, error_code &) {
+		number.append(s);
+		return true;
+	}
+
+	bool on_int64(int64_t i, string_view s, error_code &) {
+		Number(s, i);
+		return true;
+	}
+
+	bool on_uint64(uint64_t u, string_view s, error_code &) {
+		Number(s, u);
+		return true;
+	}
+
+	bool on_double(double d, string_view s, error_code &) {
+		Number(s, d);
+		return true;
+	}
+
+	bool on_bool(bool b, error_code &) {
+		Value(StreamValue::Type::BOOLEAN,
+		      b ? "true" : "false", b);
+		return true;
+	}
+
+	bool on_null(error_code &) {
+		Value(StreamValue::Type::NULL_, "null", 0);
+		return true;
+	}
+
+	bool on_comment_part(string_view, error_code &) noexcept {
+		return true;
+	}
+
+	bool on_comment(string_view, error_code &) noexcept {
+		return true;
+	}
+};
+
+struct StreamParser::Parser {
+	boost::json::basic_parser<Handler> parser;
+
+	explicit Parser(StreamHandler &handler)
+		:parser(boost::json::parse_options{}, handler) {}
+
+	void Write(bool more, const char *data, std::size_t size) {
+		boost::json::error_code ec;
+		parser.write_some(more, data, size, ec);
+		if (ec)
+			throw boost::system::system_error(ec);
+	}
+};
+
+StreamParser::StreamParser(StreamHandler &handler)
+	:parser(std::make_unique<Parser>(handler)) {}
+
+StreamParser::~StreamParser() noexcept = default;
+
+void
+StreamParser::Write(std::span<const std::byte> src)
+{
+	const auto s = ToStringView(src);
+	parser->Write(true, s.data(), s.size());
+}
+
+void
+StreamParser::Finish()
+{
+	parser->Write(false, nullptr, 0);
+}
+
+void
+ParseStream(Reader &r, StreamHandler &handler)
+{
+	StreamParser p(handler);
+
+	while (true) {
+		/* reserve one more byte; see the comment in Parse() */
+		std::byte buffer[BOOST_JSON_STACK_BUFFER_SIZE + 1];
+
+		const std::size_t nbytes = r.Read(buffer,
+						  BOOST_JSON_STACK_BUFFER_SIZE);
+		if (nbytes == 0)
+			break;
+
+		p.Write({buffer, nbytes});
+	}
+
+	p.Finish();
+}
+
+} // namespace Json
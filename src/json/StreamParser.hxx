@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "io/OutputStream.hxx"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+class Reader;
+
+namespace Json {
+
+/**
+ * A scalar value passed to StreamHandler::OnValue().
+ */
+struct StreamValue {
+	enum class Type : uint8_t {
+		STRING,
+		NUMBER,
+		BOOLEAN,
+		NULL_,
+	} type;
+
+	/**
+	 * The (unescaped) string or the textual representation of
+	 * the number.  Valid only during the OnValue() call.
+	 */
+	std::string_view string;
+
+	/**
+	 * The number; for #BOOLEAN, this is 0 or 1.
+	 */
+	double number;
+
+	bool IsString() const noexcept {
+		return type == Type::STRING;
+	}
+
+	bool IsNumber() const noexcept {
+		return type == Type::NUMBER;
+	}
+
+	/**
+	 * Convert a number or a string containing a number.
+	 *
+	 * @return the number or 0 if the value is not a number
+	 */
+	[[gnu::pure]]
+	double ToDouble() const noexcept;
+};
+
+/**
+ * Receives events from #StreamParser.  Methods may throw, which
+ * aborts parsing.
+ *
+ * Each event gets the nesting depth (0 for the root value) and the
+ * key of the value in its parent object (empty for array elements
+ * and for the root value).
+ */
+class StreamHandler {
+public:
+	/**
+	 * An object or an array begins.
+	 */
+	virtual void OnBegin([[maybe_unused]] unsigned depth,
+			     [[maybe_unused]] std::string_view key,
+			     [[maybe_unused]] bool array) {}
+
+	/**
+	 * An object or an array ends.
+	 */
+	virtual void OnEnd([[maybe_unused]] unsigned depth,
+			   [[maybe_unused]] bool array) {}
+
+	/**
+	 * A string, number, boolean or null.
+	 */
+	virtual void OnValue(unsigned depth, std::string_view key,
+			     const StreamValue &value) = 0;
+};
+
+/**
+ * An #OutputStream implementation which parses all incoming data as
+ * JSON and passes events to a #StreamHandler, without building a
+ * tree of values.  Only the current key and string are buffered, so
+ * memory usage does not depend on the document size.
+ */
+class StreamParser final : public OutputStream {
+	struct Handler;
+	struct Parser;
+
+	const std::unique_ptr<Parser> parser;
+
+public:
+	explicit StreamParser(StreamHandler &handler);
+	~StreamParser() noexcept;
+
+	StreamParser(const StreamParser &) = delete;
+	StreamParser &operator=(const StreamParser &) = delete;
+
+	/**
+	 * Signal the end of the document.
+	 *
+	 * Throws if the document is incomplete.
+	 */
+	void Finish();
+
+	/* virtual methods from class OutputStream */
+	void Write(std::span<const std::byte> src) override;
+};
+
+/**
+ * Parse a JSON document from a #Reader (e.g. a file) with a
+ * #StreamParser.
+ *
+ * Throws on error.
+ */
+void
+ParseStream(Reader &r, StreamHandler &handler);
+
+} // namespace Json
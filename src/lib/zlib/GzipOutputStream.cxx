@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// author: Max Kellermann <max.kellermann@gmail.com>
+
+#include "GzipOutputStream.hxx"
+#include "Error.hxx"
+
+GzipOutputStream::GzipOutputStream(OutputStream &_next, int level)
+	:next(_next)
+{
+	z.next_in = nullptr;
+	z.avail_in = 0;
+	z.zalloc = Z_NULL;
+	z.zfree = Z_NULL;
+	z.opaque = Z_NULL;
+
+	constexpr int windowBits = 16 + MAX_WBITS;
+	constexpr int memLevel = 8;
+	int result = deflateInit2(&z, level, Z_DEFLATED,
+				  windowBits, memLevel,
+				  Z_DEFAULT_STRATEGY);
+	if (result != Z_OK)
+		throw ZlibError(result);
+}
+
+GzipOutputStream::~GzipOutputStream() noexcept
+{
+	deflateEnd(&z);
+}
+
+void
+GzipOutputStream::Deflate(int flush)
+{
+	while (true) {
+		Bytef output[16384];
+
+		z.next_out = output;
+		z.avail_out = sizeof(output);
+
+		int result = deflate(&z, flush);
+		if (result != Z_OK && result != Z_STREAM_END &&
+		    result != Z_BUF_ERROR)
+			throw ZlibError(result);
+
+		const std::size_t nbytes = sizeof(output) - z.avail_out;
+		if (nbytes > 0)
+			next.Write(std::as_bytes(std::span{output, nbytes}));
+
+		/* deflate() is done when it did not fill the whole
+		   output buffer (and, when finishing, when the stream
+		   end was reached) */
+		if (result == Z_STREAM_END ||
+		    (flush != Z_FINISH && z.avail_out > 0))
+			break;
+	}
+}
+
+void
+GzipOutputStream::SyncFlush()
+{
+	z.next_in = nullptr;
+	z.avail_in = 0;
+
+	Deflate(Z_SYNC_FLUSH);
+}
+
+void
+GzipOutputStream::Finish()
+{
+	z.next_in = nullptr;
+	z.avail_in = 0;
+
+	Deflate(Z_FINISH);
+}
+
+void
+GzipOutputStream::Write(std::span<const std::byte> src)
+{
+	/* zlib's API requires non-const input pointer */
+	z.next_in = const_cast<Bytef *>(reinterpret_cast<const Bytef *>(src.data()));
+	z.avail_in = src.size();
+
+	while (z.avail_in > 0) {
+		Bytef output[16384];
+
+		z.next_out = output;
+		z.avail_out = sizeof(output);
+
+		int result = deflate(&z, Z_NO_FLUSH);
+		if (result != Z_OK)
+			throw ZlibError(result);
+
+		const std::size_t nbytes = sizeof(output) - z.avail_out;
+		if (nbytes > 0)
+			next.Write(std::as_bytes(std::span{output, nbytes}));
+	}
+}
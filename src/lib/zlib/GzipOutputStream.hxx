@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// author: Max Kellermann <max.kellermann@gmail.com>
+
+#pragma once
+
+#include "io/OutputStream.hxx"
+
+#include <zlib.h>
+
+/**
+ * A filter that compresses data written to it using zlib, forwarding
+ * compressed data in the "gzip" format.
+ *
+ * Don't forget to call Finish()!
+ */
+class GzipOutputStream final : public OutputStream {
+	OutputStream &next;
+
+	z_stream z;
+
+public:
+	/**
+	 * Construct the filter.
+	 *
+	 * Throws on error.
+	 *
+	 * @param level the zlib compression level (0..9)
+	 */
+	explicit GzipOutputStream(OutputStream &_next,
+				  int level=Z_DEFAULT_COMPRESSION);
+	~GzipOutputStream() noexcept;
+
+	/**
+	 * Forward all pending data to the next stream, so it can be
+	 * decompressed by a reader even if Finish() is never called
+	 * (e.g. after a crash).  This costs a few bytes of
+	 * compression ratio, so don't call it too often.
+	 *
+	 * Throws on error.
+	 */
+	void SyncFlush();
+
+	/**
+	 * Finish the file and write all data remaining in zlib's
+	 * output buffer.
+	 *
+	 * Throws on error.
+	 */
+	void Finish();
+
+	/* virtual methods from class OutputStream */
+	void Write(std::span<const std::byte> src) override;
+
+private:
+	void Deflate(int flush);
+};
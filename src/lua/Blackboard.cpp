@@ -4,9 +4,8 @@
 #include "Blackboard.hpp"
 #include "Chrono.hpp"
 #include "Geo.hpp"
-#include "MetaTable.hxx"
+#include "FieldTable.hpp"
 #include "Util.hxx"
-#include "util/StringAPI.hxx"
 #include "Interface.hpp"
 
 namespace Lua {
@@ -41,69 +40,129 @@ static void PushOptional(lua_State *L, bool available, V &&value) {
 
 }
 
-static int
-l_blackboard_index(lua_State *L)
-{
-  const auto &basic = CommonInterface::Basic();
-  const auto &calculated = CommonInterface::Calculated();
-
-  const char *name = lua_tostring(L, 2);
-  if (name == nullptr)
-    return 0;
-  else if (StringIsEqual(name, "clock"))
+/**
+ * The fields of "xcsoar.blackboard".  Unavailable values are nil.
+ */
+static constexpr Lua::Field blackboard_fields[] = {
+  {"clock", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::Push(L, basic.clock);
-  else if (StringIsEqual(name, "time"))
+    return 1;
+  }},
+  {"time", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.time_available, basic.time);
-  else if (StringIsEqual(name, "date_time_utc"))
+    return 1;
+  }},
+  {"date_time_utc", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.time_available, basic.date_time_utc);
-  else if (StringIsEqual(name, "location"))
+    return 1;
+  }},
+  {"location", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.location_available, basic.location);
-  else if (StringIsEqual(name, "altitude"))
+    return 1;
+  }},
+  {"altitude", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.NavAltitudeAvailable(), basic.nav_altitude);
-  else if (StringIsEqual(name, "altitude_agl"))
+    return 1;
+  }},
+  {"altitude_agl", [](lua_State *L){
+    const auto &calculated = CommonInterface::Calculated();
     Lua::PushOptional(L, calculated.altitude_agl_valid, calculated.altitude_agl);
-  else if (StringIsEqual(name, "track"))
+    return 1;
+  }},
+  {"track", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.track_available, basic.track);
-  else if (StringIsEqual(name, "ground_speed"))
+    return 1;
+  }},
+  {"ground_speed", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.ground_speed_available, basic.ground_speed);
-  else if (StringIsEqual(name, "air_speed"))
+    return 1;
+  }},
+  {"air_speed", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.airspeed_available, basic.true_airspeed);
-  else if (StringIsEqual(name, "bank_angle"))
+    return 1;
+  }},
+  {"bank_angle", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.attitude.bank_angle_available,
                       basic.attitude.bank_angle);
-  else if (StringIsEqual(name, "pitch_angle"))
+    return 1;
+  }},
+  {"pitch_angle", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.attitude.pitch_angle_available,
                       basic.attitude.pitch_angle);
-  else if (StringIsEqual(name, "heading"))
+    return 1;
+  }},
+  {"heading", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.attitude.heading_available, basic.attitude.heading);
-  else if (StringIsEqual(name, "g_load"))
+    return 1;
+  }},
+  {"g_load", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.acceleration.available, basic.acceleration.g_load);
-  else if (StringIsEqual(name, "static_pressure"))
+    return 1;
+  }},
+  {"static_pressure", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.static_pressure_available, basic.static_pressure.GetPascal());
-  else if (StringIsEqual(name, "pitot_pressure"))
+    return 1;
+  }},
+  {"pitot_pressure", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.pitot_pressure_available, basic.pitot_pressure.GetPascal());
-  else if (StringIsEqual(name, "dynamic_pressure"))
+    return 1;
+  }},
+  {"dynamic_pressure", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.dyn_pressure_available, basic.dyn_pressure.GetPascal());
-  else if (StringIsEqual(name, "temperature"))
+    return 1;
+  }},
+  {"temperature", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.temperature_available,
                       basic.temperature.ToKelvin());
-  else if (StringIsEqual(name, "humidity"))
+    return 1;
+  }},
+  {"humidity", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.humidity_available, basic.humidity);
-  else if (StringIsEqual(name, "voltage"))
+    return 1;
+  }},
+  {"voltage", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.voltage_available, basic.voltage);
-  else if (StringIsEqual(name, "battery_level"))
+    return 1;
+  }},
+  {"battery_level", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.battery_level_available, basic.battery_level);
-  else if (StringIsEqual(name, "noncomp_vario"))
+    return 1;
+  }},
+  {"noncomp_vario", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.noncomp_vario_available, basic.noncomp_vario);
-  else if (StringIsEqual(name, "total_energy_vario"))
+    return 1;
+  }},
+  {"total_energy_vario", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.total_energy_vario_available, basic.total_energy_vario);
-  else if (StringIsEqual(name, "netto_vario"))
+    return 1;
+  }},
+  {"netto_vario", [](lua_State *L){
+    const auto &basic = CommonInterface::Basic();
     Lua::PushOptional(L, basic.netto_vario_available, basic.netto_vario);
-  else
-    return 0;
-
-  return 1;
-}
+    return 1;
+  }},
+};
 
 void
 Lua::InitBlackboard(lua_State *L)
@@ -112,7 +171,7 @@ Lua::InitBlackboard(lua_State *L)
 
   lua_newtable(L);
 
-  MakeIndexMetaTableFor(L, RelativeStackIndex{-1}, l_blackboard_index);
+  InitFieldTable(L, blackboard_fields);
 
   lua_setfield(L, -2, "blackboard");
 
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Devices.hpp"
+#include "Chrono.hpp"
+#include "Util.hxx"
+#include "Components.hpp"
+#include "Device/MultipleDevices.hpp"
+#include "Device/Descriptor.hpp"
+
+extern "C" {
+#include <lauxlib.h>
+}
+
+using namespace Lua;
+
+/**
+ * Check the device index (1 for device "A") at the given stack
+ * position.
+ */
+static DeviceDescriptor &
+CheckDevice(lua_State *L, int arg)
+{
+  if (devices == nullptr)
+    luaL_error(L, "No devices");
+
+  const lua_Integer index = luaL_checkinteger(L, arg);
+  luaL_argcheck(L, index >= 1 && index <= NUMDEV, arg,
+                "Invalid device index");
+
+  return (*devices)[index - 1];
+}
+
+static void
+PushDelay(lua_State *L, const DelayStatistics &delay)
+{
+  lua_newtable(L);
+  SetField(L, RelativeStackIndex{-1}, "last", delay.last);
+  SetField(L, RelativeStackIndex{-1}, "max", delay.max);
+  SetField(L, RelativeStackIndex{-1}, "count", lua_Integer(delay.n));
+}
+
+static int
+l_devices_statistics(lua_State *L)
+{
+  if (lua_gettop(L) != 1)
+    return luaL_error(L, "Invalid parameters");
+
+  const DeviceStatistics s = CheckDevice(L, 1).GetStatistics();
+
+  lua_newtable(L);
+  SetField(L, RelativeStackIndex{-1}, "bytes_received",
+           lua_Integer(s.bytes_received));
+  SetField(L, RelativeStackIndex{-1}, "lines_received",
+           lua_Integer(s.lines_received));
+  SetField(L, RelativeStackIndex{-1}, "parse_failures",
+           lua_Integer(s.parse_failures));
+  SetField(L, RelativeStackIndex{-1}, "parse_time", s.parse_time);
+  SetField(L, RelativeStackIndex{-1}, "parse_time_max", s.parse_time_max);
+
+  PushDelay(L, s.merge_delay);
+  lua_setfield(L, -2, "merge_delay");
+
+  PushDelay(L, s.calculated_delay);
+  lua_setfield(L, -2, "calculated_delay");
+
+  return 1;
+}
+
+static int
+l_devices_reset_statistics(lua_State *L)
+{
+  if (lua_gettop(L) != 1)
+    return luaL_error(L, "Invalid parameters");
+
+  CheckDevice(L, 1).ResetStatistics();
+  return 0;
+}
+
+static constexpr struct luaL_Reg devices_funcs[] = {
+  {"statistics", l_devices_statistics},
+  {"reset_statistics", l_devices_reset_statistics},
+  {nullptr, nullptr}
+};
+
+void
+Lua::InitDevices(lua_State *L)
+{
+  lua_getglobal(L, "xcsoar");
+
+  lua_newtable(L);
+  luaL_setfuncs(L, devices_funcs, 0);
+  lua_setfield(L, -2, "devices");
+
+  lua_pop(L, 1);
+}
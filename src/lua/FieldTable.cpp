@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FieldTable.hpp"
+#include "Util.hxx"
+
+/* the upvalues of the closures created by InitFieldTable() */
+static constexpr int NAMES_UPVALUE = 1;
+static constexpr int FIELDS_UPVALUE = 2;
+static constexpr int N_FIELDS_UPVALUE = 3;
+
+/**
+ * Look up the key at the top of the stack (and pop it).
+ *
+ * @return the #Lua::Field or nullptr if there is none with this name
+ */
+static const Lua::Field *
+PopField(lua_State *L) noexcept
+{
+  if (lua_rawget(L, lua_upvalueindex(NAMES_UPVALUE)) != LUA_TNUMBER) {
+    lua_pop(L, 1);
+    return nullptr;
+  }
+
+  const auto i = lua_tointeger(L, -1);
+  lua_pop(L, 1);
+
+  const auto *fields = (const Lua::Field *)
+    lua_touserdata(L, lua_upvalueindex(FIELDS_UPVALUE));
+  return &fields[i];
+}
+
+static int
+l_field_index(lua_State *L)
+{
+  lua_pushvalue(L, 2);
+  const auto *field = PopField(L);
+  if (field == nullptr)
+    return 0;
+
+  return field->push(L);
+}
+
+static int
+l_field_snapshot(lua_State *L)
+{
+  const bool named = lua_istable(L, 1) && lua_rawlen(L, 1) > 0;
+
+  lua_newtable(L);
+  const int result = lua_gettop(L);
+
+  if (named) {
+    for (lua_Integer j = 1; lua_rawgeti(L, 1, j) != LUA_TNIL; ++j) {
+      /* the name stays on the stack as key for lua_settable() */
+      lua_pushvalue(L, -1);
+      const auto *field = PopField(L);
+      if (field != nullptr && field->push(L) > 0)
+        lua_settable(L, result);
+      else
+        lua_pop(L, 1);
+    }
+
+    /* pop the nil which has ended the loop */
+    lua_pop(L, 1);
+  } else {
+    const auto *fields = (const Lua::Field *)
+      lua_touserdata(L, lua_upvalueindex(FIELDS_UPVALUE));
+    const auto n = lua_tointeger(L, lua_upvalueindex(N_FIELDS_UPVALUE));
+
+    for (lua_Integer i = 0; i < n; ++i)
+      if (fields[i].push(L) > 0)
+        lua_setfield(L, result, fields[i].name);
+  }
+
+  return 1;
+}
+
+/**
+ * Push a closure with the upvalues expected by PopField().
+ *
+ * @param names the stack index of the name table
+ */
+static void
+PushFieldClosure(lua_State *L, int names, std::span<const Lua::Field> fields,
+                 lua_CFunction function) noexcept
+{
+  lua_pushvalue(L, names);
+  lua_pushlightuserdata(L, const_cast<Lua::Field *>(fields.data()));
+  lua_pushinteger(L, fields.size());
+  lua_pushcclosure(L, function, 3);
+}
+
+void
+Lua::InitFieldTable(lua_State *L, std::span<const Field> fields) noexcept
+{
+  const int table = lua_gettop(L);
+
+  /* map each name to its position in the array */
+  lua_createtable(L, 0, fields.size());
+  const int names = lua_gettop(L);
+  for (std::size_t i = 0; i < fields.size(); ++i) {
+    lua_pushinteger(L, i);
+    lua_setfield(L, names, fields[i].name);
+  }
+
+  PushFieldClosure(L, names, fields, l_field_snapshot);
+  lua_setfield(L, table, "snapshot");
+
+  lua_newtable(L);
+  PushFieldClosure(L, names, fields, l_field_index);
+  lua_setfield(L, -2, "__index");
+  lua_setmetatable(L, table);
+
+  /* pop the name table */
+  lua_pop(L, 1);
+}
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <span>
+
+struct lua_State;
+
+namespace Lua {
+
+/**
+ * A read-only field of a table provided by #InitFieldTable().
+ */
+struct Field {
+  const char *name;
+
+  /**
+   * Push the value of this field.
+   *
+   * @return the number of values pushed (0 if the value is not
+   * available)
+   */
+  int (*push)(lua_State *L);
+};
+
+/**
+ * Turn the table at the top of the stack into a view of the given
+ * fields.  Its "__index" function finds a field with one hash lookup
+ * of the (interned) key in a name table which is built here, instead
+ * of comparing it with each name.
+ *
+ * The table also gets a function "snapshot", which returns a new
+ * table with the values of all available fields, or of the fields
+ * named in its optional array argument.  One call replaces many
+ * "__index" calls in scripts which read several fields at a time.
+ *
+ * @param fields the fields; the array must remain valid as long as
+ * the Lua state exists
+ */
+void
+InitFieldTable(lua_State *L, std::span<const Field> fields) noexcept;
+
+}
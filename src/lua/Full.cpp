@@ -23,6 +23,7 @@
 #include "Wind.hpp"
 #include "Logger.hpp"
 #include "Tracking.hpp"
+#include "Devices.hpp"
 #include "Replay.hpp"
 #include "InputEvent.hpp"
 
@@ -46,6 +47,7 @@ Lua::NewFullState()
   InitWind(L);
   InitLogger(L);
   InitTracking(L);
+  InitDevices(L);
   InitReplay(L);
   InitInputEvent(L);
 
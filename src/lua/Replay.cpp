@@ -54,6 +54,23 @@ l_replay_fastforward(lua_State *L)
   return !replay->FastForward(delta_s);
 }
 
+static int
+l_replay_seek(lua_State *L)
+{
+  if (lua_gettop(L) != 1)
+    return luaL_error(L, "Invalid parameters");
+
+  const TimeStamp time{FloatDuration{luaL_checknumber(L, 1)}};
+
+  try {
+    Lua::Push(L, replay->Seek(time));
+    return 1;
+  } catch (...) {
+  }
+
+  return luaL_error(L, "Replay");
+}
+
 static int
 l_replay_start(lua_State *L)
 {
@@ -83,6 +100,7 @@ l_replay_stop([[maybe_unused]] lua_State *L)
 static constexpr struct luaL_Reg settings_funcs[] = {
   {"set_time_scale", l_replay_settimescale},
   {"fast_forward", l_replay_fastforward},
+  {"seek", l_replay_seek},
   {"start", l_replay_start},
   {"stop", l_replay_stop},
   {nullptr, nullptr}
@@ -40,4 +40,13 @@ ResponseToException(unsigned status, const boost::json::value &body)
   return FmtRuntimeError("WeGlide status {}", status);
 }
 
+std::runtime_error
+ResponseToException(unsigned status, std::string_view message)
+{
+  if (message.empty())
+    return FmtRuntimeError("WeGlide status {}", status);
+
+  return FmtRuntimeError("WeGlide status {}: {}", status, message);
+}
+
 } // namespace WeGlide
@@ -6,6 +6,7 @@
 #include <boost/json/fwd.hpp>
 
 #include <stdexcept>
+#include <string_view>
 
 namespace WeGlide {
 
@@ -13,4 +14,12 @@ namespace WeGlide {
 std::runtime_error
 ResponseToException(unsigned status, const boost::json::value &body);
 
+/**
+ * Like the other overload, but with a message which was already
+ * extracted from the response body (may be empty).
+ */
+[[gnu::pure]]
+std::runtime_error
+ResponseToException(unsigned status, std::string_view message);
+
 } // namespace WeGlide
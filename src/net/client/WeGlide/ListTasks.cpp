@@ -4,7 +4,7 @@
 #include "ListTasks.hpp"
 #include "Error.hpp"
 #include "Settings.hpp"
-#include "json/ParserOutputStream.hxx"
+#include "json/StreamParser.hxx"
 #include "net/http/Progress.hpp"
 #include "lib/curl/CoStreamRequest.hxx"
 #include "lib/curl/Easy.hxx"
@@ -12,24 +12,137 @@
 #include "lib/fmt/ToBuffer.hxx"
 #include "co/Task.hxx"
 
-#include <boost/json.hpp>
+using std::string_view_literals::operator""sv;
 
 namespace WeGlide {
 
-static auto
-tag_invoke(boost::json::value_to_tag<TaskInfo>,
-           const boost::json::value &jv)
+/**
+ * Parses the task list directly into #TaskInfo objects, without
+ * building a JSON tree first.  The response to a failed request is an
+ * object; its error message is collected instead.
+ */
+class TaskListHandler final : public Json::StreamHandler {
+  std::vector<TaskInfo> tasks;
+
+  TaskInfo task;
+
+  /**
+   * Which of the #TaskInfo attributes have been seen?
+   */
+  unsigned char seen = 0;
+
+  /**
+   * Inside the "user" object of a task?
+   */
+  bool in_user = false;
+
+  /**
+   * Inside the "detail" array of an error response, or inside its
+   * first element?
+   */
+  bool in_detail_array = false, in_detail = false;
+
+  std::string error_message;
+
+  static constexpr unsigned char SEEN_ID = 0x1, SEEN_NAME = 0x2,
+    SEEN_DISTANCE = 0x4, SEEN_ALL = 0x7;
+
+public:
+  std::vector<TaskInfo> &&GetTasks() noexcept {
+    return std::move(tasks);
+  }
+
+  std::string_view GetErrorMessage() const noexcept {
+    return error_message;
+  }
+
+  /* virtual methods from class Json::StreamHandler */
+  void OnBegin(unsigned depth, std::string_view key, bool array) override {
+    if (depth == 1 && !array) {
+      task = {};
+      seen = 0;
+    } else if (depth == 1 && array && key == "detail"sv)
+      in_detail_array = true;
+    else if (depth == 2 && !array && key == "user"sv)
+      in_user = true;
+    else if (depth == 2 && !array && in_detail_array && error_message.empty())
+      /* the first validation error */
+      in_detail = true;
+  }
+
+  void OnEnd(unsigned depth, [[maybe_unused]] bool array) override {
+    if (depth == 1) {
+      if (seen == SEEN_ALL)
+        tasks.emplace_back(std::move(task));
+      seen = 0;
+      in_detail_array = false;
+    } else if (depth == 2) {
+      in_user = false;
+      in_detail = false;
+    }
+  }
+
+  void OnValue(unsigned depth, std::string_view key,
+               const Json::StreamValue &value) override {
+    if (depth == 1) {
+      if (key == "error_description"sv && value.IsString())
+        error_message = value.string;
+      else if (key == "error"sv && value.IsString() && error_message.empty())
+        error_message = value.string;
+      return;
+    }
+
+    if (depth == 3 && in_detail && key == "msg"sv && value.IsString()) {
+      error_message = value.string;
+      return;
+    }
+
+    if (depth == 3 && in_user && key == "name"sv && value.IsString()) {
+      task.user_name = value.string;
+      return;
+    }
+
+    if (depth != 2)
+      return;
+
+    if (key == "id"sv && value.IsNumber()) {
+      task.id = static_cast<uint_least64_t>(value.number);
+      seen |= SEEN_ID;
+    } else if (key == "name"sv && value.IsString()) {
+      task.name = value.string;
+      seen |= SEEN_NAME;
+    } else if (key == "distance"sv && value.IsNumber()) {
+      // convert km to m
+      task.distance = value.number * 1000;
+      seen |= SEEN_DISTANCE;
+    }
+  }
+};
+
+static Co::Task<std::vector<TaskInfo>>
+ListTasks(CurlGlobal &curl, const char *url, ProgressListener &progress)
 {
-  const auto &json = jv.as_object();
+  CurlEasy easy{url};
+  Curl::Setup(easy);
+  const Net::ProgressAdapter progress_adapter{easy, progress};
+
+  TaskListHandler handler;
+  Json::StreamParser parser{handler};
+  const auto response =
+    co_await Curl::CoStreamRequest(curl, std::move(easy), parser);
 
-  TaskInfo info;
-  info.id = json.at("id").to_number<uint_least64_t>();
-  info.name = json.at("name").as_string();
-  info.user_name = json.at("user").at("name").as_string();
+  if (response.status != 200) {
+    try {
+      parser.Finish();
+    } catch (...) {
+      /* not JSON; ignore */
+    }
 
-  // convert km to m
-  info.distance = json.at("distance").to_number<double>() * 1000;
-  return info;
+    throw ResponseToException(response.status, handler.GetErrorMessage());
+  }
+
+  parser.Finish();
+  co_return handler.GetTasks();
 }
 
 Co::Task<std::vector<TaskInfo>>
@@ -40,19 +153,7 @@ ListTasksByUser(CurlGlobal &curl, const WeGlideSettings &settings,
   const auto url = FmtBuffer<256>("{}/task?user_id_in={}",
                                   settings.default_url, user_id);
 
-  CurlEasy easy{url};
-  Curl::Setup(easy);
-  const Net::ProgressAdapter progress_adapter{easy, progress};
-
-  Json::ParserOutputStream parser;
-  const auto response =
-    co_await Curl::CoStreamRequest(curl, std::move(easy), parser);
-  auto body = parser.Finish();
-
-  if (response.status != 200)
-    throw ResponseToException(response.status, body);
-
-  co_return boost::json::value_to<std::vector<TaskInfo>>(body);
+  co_return co_await ListTasks(curl, url, progress);
 }
 
 Co::Task<std::vector<TaskInfo>>
@@ -62,19 +163,7 @@ ListDeclaredTasks(CurlGlobal &curl, const WeGlideSettings &settings,
   const auto url = FmtBuffer<256>("{}/task/declaration",
                                   settings.default_url);
 
-  CurlEasy easy{url};
-  Curl::Setup(easy);
-  const Net::ProgressAdapter progress_adapter{easy, progress};
-
-  Json::ParserOutputStream parser;
-  const auto response =
-    co_await Curl::CoStreamRequest(curl, std::move(easy), parser);
-  auto body = parser.Finish();
-
-  if (response.status != 200)
-    throw ResponseToException(response.status, body);
-
-  co_return boost::json::value_to<std::vector<TaskInfo>>(body);
+  co_return co_await ListTasks(curl, url, progress);
 }
 
 } // namespace WeGlide
@@ -6,12 +6,17 @@
 #include "lib/curl/Setup.hxx"
 #include "lib/curl/CoStreamRequest.hxx"
 #include "io/DigestOutputStream.hxx"
+#include "lib/curl/Error.hxx"
 #include "io/FileOutputStream.hxx"
+#include "io/FileReader.hxx"
+#include "system/FileUtil.hpp"
 #include "system/Path.hpp"
 #include "lib/sodium/SHA256.hxx"
+#include "Operation/ProgressListener.hpp"
 
 #include <cassert>
 #include <optional>
+#include <stdexcept>
 
 namespace Net {
 
@@ -50,4 +55,151 @@ CoDownloadToFile(CurlGlobal &curl, const char *url,
   co_return response;
 }
 
+[[gnu::pure]]
+static AllocatedPath
+GetPartialPath(Path path) noexcept
+{
+  return path + _T(".part");
+}
+
+void
+DeletePartialDownload(Path path) noexcept
+{
+  File::Delete(GetPartialPath(path));
+}
+
+/**
+ * Forwards progress to another #ProgressListener, adding the number
+ * of bytes which were downloaded by a previous attempt.
+ */
+class OffsetProgressListener final : public ProgressListener {
+  ProgressListener &next;
+  const unsigned offset;
+
+public:
+  OffsetProgressListener(ProgressListener &_next, unsigned _offset) noexcept
+    :next(_next), offset(_offset) {}
+
+  void SetProgressRange(unsigned range) noexcept override {
+    next.SetProgressRange(range + offset);
+  }
+
+  void SetProgressPosition(unsigned position) noexcept override {
+    next.SetProgressPosition(position + offset);
+  }
+};
+
+/**
+ * Feed the contents of a file into the digest.
+ */
+static void
+HashFile(Path path, DigestOutputStream<SHA256State> &digest)
+{
+  FileReader reader{path};
+
+  std::byte buffer[16384];
+  std::size_t nbytes;
+  while ((nbytes = reader.Read(buffer, sizeof(buffer))) > 0)
+    digest.UpdateDigest({buffer, nbytes});
+}
+
+static Co::Task<Curl::CoResponse>
+DownloadToPartialFile(CurlGlobal &curl, const char *url,
+                      Path path, Path part_path,
+                      const std::array<std::byte, 32> *expected_sha256,
+                      ProgressListener &progress)
+{
+  const uint64_t offset = File::GetSize(part_path);
+
+  FileOutputStream file(part_path, FileOutputStream::Mode::APPEND_OR_CREATE);
+  OutputStream *os = &file;
+
+  std::optional<DigestOutputStream<SHA256State>> digest;
+  if (expected_sha256 != nullptr) {
+    os = &digest.emplace(*os);
+
+    if (offset > 0)
+      HashFile(part_path, *digest);
+  }
+
+  CurlEasy easy{url};
+  Curl::Setup(easy);
+  OffsetProgressListener offset_progress{progress, unsigned(offset)};
+  const Net::ProgressAdapter progress_adapter{easy, offset_progress};
+  easy.SetFailOnError();
+
+  if (offset > 0)
+    easy.SetOption(CURLOPT_RESUME_FROM_LARGE, curl_off_t(offset));
+
+  auto response = co_await Curl::CoStreamRequest(curl, std::move(easy), *os);
+  file.Commit();
+
+  if (expected_sha256 != nullptr) {
+    std::array<std::byte, 32> actual;
+    digest->Final(actual.data());
+
+    if (actual != *expected_sha256) {
+      File::Delete(part_path);
+      throw std::runtime_error("SHA256 mismatch");
+    }
+  }
+
+  if (!File::Replace(part_path, path))
+    throw std::runtime_error("Failed to rename the downloaded file");
+
+  co_return response;
+}
+
+/**
+ * Did resuming fail because the server did not accept the range
+ * request?  This is CURLE_RANGE_ERROR if the server ignored the
+ * range, or an HTTP error such as "416 Range Not Satisfiable" if the
+ * file on the server has changed.
+ */
+[[gnu::pure]]
+static bool
+IsResumeError(std::exception_ptr error) noexcept
+{
+  try {
+    std::rethrow_exception(error);
+  } catch (const std::system_error &e) {
+    return e.code().category() == Curl::error_category &&
+      (e.code().value() == CURLE_RANGE_ERROR ||
+       e.code().value() == CURLE_HTTP_RETURNED_ERROR);
+  } catch (...) {
+    return false;
+  }
+}
+
+Co::EagerTask<Curl::CoResponse>
+CoResumableDownloadToFile(CurlGlobal &curl, const char *url, Path path,
+                          const std::array<std::byte, 32> *expected_sha256,
+                          ProgressListener &progress)
+{
+  assert(url != nullptr);
+  assert(path != nullptr);
+
+  const auto part_path = GetPartialPath(path);
+
+  if (File::GetSize(part_path) > 0) {
+    std::exception_ptr error;
+
+    try {
+      co_return co_await DownloadToPartialFile(curl, url, path, part_path,
+                                               expected_sha256, progress);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    if (!IsResumeError(error))
+      std::rethrow_exception(error);
+
+    /* start over */
+    File::Delete(part_path);
+  }
+
+  co_return co_await DownloadToPartialFile(curl, url, path, part_path,
+                                           expected_sha256, progress);
+}
+
 } // namespace Net
@@ -25,4 +25,33 @@ CoDownloadToFile(CurlGlobal &curl, const char *url,
                  Path path, std::array<std::byte, 32> *sha256,
                  ProgressListener &progress);
 
+/**
+ * Download a URL into the specified file, resuming a previous
+ * attempt if possible.
+ *
+ * The data is written to a file with the suffix ".part" first, which
+ * is kept if the download fails or gets canceled.  The next call
+ * continues where it stopped with a HTTP range request; if the
+ * server does not support that, the download starts over.  Once the
+ * download is complete, the ".part" file is renamed to #path.
+ *
+ * Throws on error.
+ *
+ * @param expected_sha256 if not nullptr, then the SHA256 of the
+ * file is calculated while it is being downloaded and compared with
+ * this value; on mismatch, the partial file is deleted and an
+ * exception is thrown
+ */
+Co::EagerTask<Curl::CoResponse>
+CoResumableDownloadToFile(CurlGlobal &curl, const char *url, Path path,
+                          const std::array<std::byte, 32> *expected_sha256,
+                          ProgressListener &progress);
+
+/**
+ * Delete the partial file left behind by
+ * CoResumableDownloadToFile().
+ */
+void
+DeletePartialDownload(Path path) noexcept;
+
 } // namespace Net
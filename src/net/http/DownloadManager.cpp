@@ -74,7 +74,8 @@ Net::DownloadManager::Enumerate(DownloadListener &listener) noexcept
 }
 
 void
-Net::DownloadManager::Enqueue(const char *uri, Path relative_path) noexcept
+Net::DownloadManager::Enqueue(const char *uri, Path relative_path,
+                              [[maybe_unused]] const std::array<std::byte, 32> *sha256) noexcept
 {
   assert(download_manager != nullptr);
 
@@ -93,6 +94,7 @@ Net::DownloadManager::Cancel(Path relative_path) noexcept
 
 #include "Init.hpp"
 #include "CoDownloadToFile.hpp"
+#include "lib/curl/Error.hxx"
 #include "lib/curl/Global.hxx"
 #include "Operation/ProgressListener.hpp"
 #include "LocalPath.hpp"
@@ -100,51 +102,107 @@ Net::DownloadManager::Cancel(Path relative_path) noexcept
 #include "thread/SafeList.hxx"
 #include "co/InjectTask.hxx"
 
+#include <array>
+#include <optional>
 #include <string>
 #include <list>
 #include <algorithm>
 
 #include <string.h>
 
-class DownloadManagerThread final
-  : ProgressListener {
-  struct Item {
-    std::string uri;
-    AllocatedPath path_relative;
+class DownloadManagerThread final {
+  /**
+   * The maximum number of files downloaded at the same time.
+   */
+  static constexpr unsigned MAX_ACTIVE = 3;
 
-    Item(const Item &other) = delete;
+  /**
+   * How often is a download attempted if it fails with a network
+   * error?  Each attempt resumes the previous one.
+   */
+  static constexpr unsigned MAX_ATTEMPTS = 3;
 
-    Item(Item &&other) noexcept = default;
+  struct Item final : ProgressListener {
+    DownloadManagerThread &thread;
+
+    std::string uri;
+    AllocatedPath path_relative;
 
-    Item(const char *_uri, Path _path_relative) noexcept
-      :uri(_uri), path_relative(_path_relative) {}
+    std::optional<std::array<std::byte, 32>> sha256;
+
+    /**
+     * The coroutine performing this download.
+     */
+    Co::InjectTask task{Net::curl->GetEventLoop()};
+
+    /**
+     * Protected by DownloadManagerThread::mutex.
+     */
+    int64_t size = -1, position = -1;
+
+    unsigned attempts = 0;
+
+    /**
+     * Has this download been started (and not finished yet)?
+     * Protected by DownloadManagerThread::mutex.
+     */
+    bool active = false;
+
+    /**
+     * Is Cancel() about to delete this item?  Protected by
+     * DownloadManagerThread::mutex.
+     */
+    bool canceled = false;
+
+    Item(DownloadManagerThread &_thread,
+         const char *_uri, Path _path_relative,
+         const std::array<std::byte, 32> *_sha256) noexcept
+      :thread(_thread), uri(_uri), path_relative(_path_relative)
+    {
+      if (_sha256 != nullptr)
+        sha256 = *_sha256;
+    }
 
+    Item(const Item &other) = delete;
     Item &operator=(const Item &other) = delete;
 
     [[gnu::pure]]
     bool operator==(Path other) const noexcept {
       return path_relative == other;
     }
-  };
 
-  /**
-   * The coroutine performing the current download.
-   */
-  Co::InjectTask task{Net::curl->GetEventLoop()};
+    void Start() noexcept;
+    void OnCompletion(std::exception_ptr error) noexcept;
 
-  Mutex mutex;
+    /* methods from class ProgressListener */
+    void SetProgressRange(unsigned range) noexcept override {
+      const std::lock_guard lock{thread.mutex};
+      size = range;
+    }
+
+    void SetProgressPosition(unsigned _position) noexcept override {
+      const std::lock_guard lock{thread.mutex};
+      position = _position;
+    }
+  };
 
   /**
-   * Information about the current download, i.e. queue.front().
-   * Protected by #mutex.
+   * Protects #queue and the #Item attributes documented to be
+   * protected by it.
    */
-  int64_t current_size = -1, current_position = -1;
+  Mutex mutex;
 
   std::list<Item> queue;
 
   ThreadSafeList<Net::DownloadListener *> listeners;
 
 public:
+  ~DownloadManagerThread() noexcept {
+    /* cancel all coroutines before the items get destroyed */
+    for (auto &item : queue)
+      item.task.Cancel();
+  }
+
   void AddListener(Net::DownloadListener &listener) noexcept {
     listeners.Add(&listener);
   }
@@ -154,109 +212,176 @@ public:
   }
 
   void Enumerate(Net::DownloadListener &listener) noexcept {
-    for (auto i = queue.begin(), end = queue.end(); i != end; ++i) {
-      const Item &item = *i;
-
-      int64_t size = -1, position = -1;
-      if (i == queue.begin()) {
-        const std::lock_guard lock{mutex};
-        size = current_size;
-        position = current_position;
-      }
-
-      listener.OnDownloadAdded(item.path_relative, size, position);
+    struct Snapshot {
+      AllocatedPath path_relative;
+      int64_t size, position;
+    };
+
+    /* copy the queue, so the listener is invoked without holding
+       the mutex */
+    std::list<Snapshot> snapshot;
+
+    {
+      const std::lock_guard lock{mutex};
+      for (const auto &item : queue)
+        if (!item.canceled)
+          snapshot.push_back({AllocatedPath{Path{item.path_relative}},
+                              item.size, item.position});
     }
+
+    for (const auto &i : snapshot)
+      listener.OnDownloadAdded(i.path_relative, i.size, i.position);
   }
 
-  void Enqueue(const char *uri, Path path_relative) noexcept {
-    queue.emplace_back(uri, path_relative);
+  void Enqueue(const char *uri, Path path_relative,
+               const std::array<std::byte, 32> *sha256) noexcept {
+    {
+      const std::lock_guard lock{mutex};
+      queue.emplace_back(*this, uri, path_relative, sha256);
+    }
 
     listeners.ForEach([path_relative](auto *listener){
       listener->OnDownloadAdded(path_relative, -1, -1);
     });
 
-    if (!task)
-      Start();
+    StartQueued();
   }
 
   void Cancel(Path relative_path) noexcept {
-    auto i = std::find(queue.begin(), queue.end(), relative_path);
-    if (i == queue.end())
-      return;
+    Item *item;
+
+    {
+      const std::lock_guard lock{mutex};
+      auto i = std::find(queue.begin(), queue.end(), relative_path);
+      if (i == queue.end() || i->canceled)
+        return;
+
+      item = &*i;
+
+      /* from now on, OnCompletion() leaves the item alone */
+      item->canceled = true;
+    }
 
-    if (i == queue.begin()) {
-      /* current download; stop the thread to cancel the current file
-         and restart the thread to continue downloading the following
-         files */
+    /* stop the coroutine (outside of the mutex, because its
+       completion callback may be waiting for it) */
+    item->task.Cancel();
 
-      task.Cancel();
-      current_size = current_position = -1;
+    Net::DeletePartialDownload(LocalPath(item->path_relative));
 
-      if (!queue.empty())
-        Start();
-    } else {
-      /* queued download; simply remove it from the list */
-      queue.erase(i);
+    {
+      const std::lock_guard lock{mutex};
+      queue.remove_if([item](const Item &i){ return &i == item; });
     }
 
     listeners.ForEach([relative_path](auto *listener){
       listener->OnDownloadError(relative_path, {});
     });
+
+    StartQueued();
   }
 
 private:
-  void Start() noexcept;
-  void OnCompletion(std::exception_ptr error) noexcept;
-
-  /* methods from class ProgressListener */
-  void SetProgressRange(unsigned range) noexcept override {
-    const std::lock_guard lock{mutex};
-    current_size = range;
-  }
+  /**
+   * Start queued downloads until #MAX_ACTIVE are running.
+   */
+  void StartQueued() noexcept;
 
-  void SetProgressPosition(unsigned position) noexcept override {
-    const std::lock_guard lock{mutex};
-    current_position = position;
-  }
+  void OnCompletion(Item &item, std::exception_ptr error) noexcept;
 };
 
 static Co::InvokeTask
 DownloadToFile(CurlGlobal &curl,
                const char *url, AllocatedPath path,
-               std::array<std::byte, 32> *sha256,
+               const std::array<std::byte, 32> *sha256,
                ProgressListener &progress)
 {
   const auto ignored_response = co_await
-    Net::CoDownloadToFile(curl, url, nullptr, nullptr,
-                          path, sha256, progress);
+    Net::CoResumableDownloadToFile(curl, url, path, sha256, progress);
 }
 
 void
-DownloadManagerThread::Start() noexcept
+DownloadManagerThread::Item::Start() noexcept
 {
-  assert(!queue.empty());
-  assert(!task);
-  assert(current_size == -1);
-  assert(current_position == -1);
+  ++attempts;
 
-  const Item &item = queue.front();
-  current_position = 0;
-
-  task.Start(DownloadToFile(*Net::curl, item.uri.c_str(),
-                            LocalPath(item.path_relative.c_str()),
-                            nullptr, *this),
+  task.Start(DownloadToFile(*Net::curl, uri.c_str(),
+                            LocalPath(path_relative.c_str()),
+                            sha256 ? &*sha256 : nullptr, *this),
              BIND_THIS_METHOD(OnCompletion));
 }
 
 void
-DownloadManagerThread::OnCompletion(std::exception_ptr error) noexcept
+DownloadManagerThread::Item::OnCompletion(std::exception_ptr error) noexcept
+{
+  thread.OnCompletion(*this, std::move(error));
+}
+
+void
+DownloadManagerThread::StartQueued() noexcept
+{
+  const std::lock_guard lock{mutex};
+
+  unsigned n_active = 0;
+  for (auto &item : queue) {
+    if (item.canceled)
+      continue;
+
+    if (!item.active) {
+      if (n_active >= MAX_ACTIVE)
+        break;
+
+      item.active = true;
+      item.position = 0;
+      item.Start();
+    }
+
+    ++n_active;
+  }
+}
+
+/**
+ * Is this a (possibly temporary) network error which justifies
+ * another attempt?
+ */
+[[gnu::pure]]
+static bool
+IsRetryableError(std::exception_ptr error) noexcept
+{
+  try {
+    std::rethrow_exception(error);
+  } catch (const std::system_error &e) {
+    return e.code().category() == Curl::error_category &&
+      e.code().value() != CURLE_HTTP_RETURNED_ERROR;
+  } catch (...) {
+    return false;
+  }
+}
+
+void
+DownloadManagerThread::OnCompletion(Item &item,
+                                    std::exception_ptr error) noexcept
 {
-  assert(!queue.empty());
+  AllocatedPath path_relative;
+
+  {
+    /* check, move and erase in one locked section, or else a
+       Cancel() in between would delete the item under our feet */
+    const std::lock_guard lock{mutex};
+
+    if (item.canceled)
+      /* Cancel() will delete it */
+      return;
 
-  const AllocatedPath path_relative = std::move(queue.front().path_relative);
-  queue.pop_front();
+    if (error && item.attempts < MAX_ATTEMPTS &&
+        IsRetryableError(error)) {
+      LogError(error, "Download failed, resuming");
+      item.Start();
+      return;
+    }
 
-  current_size = current_position = -1;
+    path_relative = std::move(item.path_relative);
+    queue.remove_if([&item](const Item &i){ return &i == &item; });
+  }
 
   if (error) {
     LogError(error);
@@ -270,8 +395,7 @@ DownloadManagerThread::OnCompletion(std::exception_ptr error) noexcept
   }
 
   // start the next download
-  if (!queue.empty())
-    Start();
+  StartQueued();
 }
 
 static DownloadManagerThread *thread;
@@ -331,11 +455,12 @@ Net::DownloadManager::Enumerate(DownloadListener &listener) noexcept
 }
 
 void
-Net::DownloadManager::Enqueue(const char *uri, Path relative_path) noexcept
+Net::DownloadManager::Enqueue(const char *uri, Path relative_path,
+                              const std::array<std::byte, 32> *sha256) noexcept
 {
   assert(thread != nullptr);
 
-  thread->Enqueue(uri, relative_path);
+  thread->Enqueue(uri, relative_path, sha256);
 }
 
 void
@@ -5,6 +5,8 @@
 
 #include "Features.hpp"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 
@@ -59,7 +61,16 @@ void RemoveListener(DownloadListener &listener) noexcept;
  */
 void Enumerate(DownloadListener &listener) noexcept;
 
-void Enqueue(const char *uri, Path relative_path) noexcept;
+/**
+ * Add a download to the queue.  Several downloads may run at the
+ * same time, and an interrupted download is resumed (not supported
+ * by all implementations).
+ *
+ * @param sha256 if not nullptr, then the download fails if the
+ * file's SHA256 differs from this value (ignored on Android)
+ */
+void Enqueue(const char *uri, Path relative_path,
+             const std::array<std::byte, 32> *sha256=nullptr) noexcept;
 
 /**
  * Cancel the download.  The download may however be already
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "TaskGraph.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+unsigned
+TaskGraph::AddTask(const char *name, Function function,
+                   std::initializer_list<unsigned> dependencies) noexcept
+{
+  assert(tasks.size() < MAX_TASKS);
+
+  const unsigned i = tasks.size();
+
+  uint_least32_t mask = 0;
+  for (const unsigned d : dependencies) {
+    assert(d < i);
+    mask |= uint_least32_t(1) << d;
+    tasks[d].dependents |= uint_least32_t(1) << i;
+  }
+
+  tasks.push_back({name, std::move(function), mask});
+  return i;
+}
+
+TaskGraph::Duration
+TaskGraph::GetWork() const noexcept
+{
+  Duration sum{};
+  for (const auto &task : tasks)
+    sum += task.duration;
+  return sum;
+}
+
+std::vector<unsigned>
+TaskGraph::GetCriticalPath() const noexcept
+{
+  std::vector<unsigned> path;
+  for (int i = critical_end; i >= 0; i = tasks[i].critical_predecessor)
+    path.push_back(i);
+
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+inline void
+TaskGraph::RunTask(Task &task) noexcept
+{
+  const auto start = std::chrono::steady_clock::now();
+  task.function();
+  task.duration = std::chrono::steady_clock::now() - start;
+}
+
+void
+TaskGraph::Work(std::unique_lock<Mutex> &lock) noexcept
+{
+  while (pending != 0 && !IsExpired()) {
+    if (ready == 0) {
+      cond.wait(lock);
+      continue;
+    }
+
+    const unsigned i = std::countr_zero(ready);
+    ready &= ~(uint_least32_t(1) << i);
+    ++n_started;
+
+    lock.unlock();
+    RunTask(tasks[i]);
+    lock.lock();
+
+    pending &= ~(uint_least32_t(1) << i);
+
+    for (auto d = tasks[i].dependents; d != 0; d &= d - 1) {
+      const unsigned j = std::countr_zero(d);
+      assert(tasks[j].n_waiting > 0);
+      if (--tasks[j].n_waiting == 0)
+        ready |= uint_least32_t(1) << j;
+    }
+
+    cond.notify_all();
+  }
+}
+
+bool
+TaskGraph::Run(ThreadPool *pool, TimePoint _deadline) noexcept
+{
+  if (tasks.empty())
+    return true;
+
+  if (pending == 0)
+    /* start a new round */
+    pending = (uint_least32_t(1) << (tasks.size() - 1) << 1) - 1;
+
+  deadline = _deadline;
+  n_started = 0;
+
+  ready = 0;
+  for (std::size_t i = 0; i < tasks.size(); ++i) {
+    auto &task = tasks[i];
+    task.n_waiting = std::popcount(task.dependencies & pending);
+    if (task.n_waiting == 0 && (pending & (uint_least32_t(1) << i)) != 0)
+      ready |= uint_least32_t(1) << i;
+  }
+
+  if (pool == nullptr || pool->GetMaxWorkers() == 0 ||
+      std::popcount(pending) < 2) {
+    /* the tasks were added in topological order, therefore the
+       lowest ready task can always be run */
+    std::unique_lock lock{mutex};
+    Work(lock);
+  } else {
+    /* each thread of the pool executes tasks until all are done */
+    const std::size_t n_threads =
+      std::min<std::size_t>(std::popcount(pending),
+                            pool->GetMaxWorkers() + 1);
+    pool->ForEach(n_threads, [this](std::size_t){
+      std::unique_lock lock{mutex};
+      Work(lock);
+    });
+  }
+
+  if (pending != 0)
+    return false;
+
+  UpdateCriticalPath();
+  return true;
+}
+
+void
+TaskGraph::UpdateCriticalPath() noexcept
+{
+  critical_end = -1;
+
+  for (std::size_t i = 0; i < tasks.size(); ++i) {
+    auto &task = tasks[i];
+
+    task.critical_predecessor = -1;
+    Duration longest{};
+    for (auto d = task.dependencies; d != 0; d &= d - 1) {
+      const unsigned j = std::countr_zero(d);
+      if (task.critical_predecessor < 0 ||
+          tasks[j].critical_length > longest) {
+        task.critical_predecessor = j;
+        longest = tasks[j].critical_length;
+      }
+    }
+
+    task.critical_length = longest + task.duration;
+
+    if (critical_end < 0 ||
+        task.critical_length > tasks[critical_end].critical_length)
+      critical_end = i;
+  }
+}
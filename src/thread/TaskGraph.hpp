@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * A fixed set of tasks with dependencies between them.  Run()
+ * executes all tasks, starting each one as soon as the tasks it
+ * depends on have finished, distributed over the threads of a
+ * #ThreadPool.
+ *
+ * Run() may be given a deadline; tasks which have not been started
+ * by then are left for the next Run() call, which continues the
+ * round.  Tasks which are already running are not interrupted.
+ *
+ * After each complete round, the duration of each task and the
+ * critical path (the chain of dependent tasks which took longest) are
+ * available; the latter is the lower bound for the duration of a
+ * round on a machine with enough CPUs.
+ */
+class TaskGraph {
+public:
+  using Function = std::function<void()>;
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+  using TimePoint = Clock::time_point;
+
+  static constexpr std::size_t MAX_TASKS = 32;
+
+private:
+  struct Task {
+    const char *name;
+    Function function;
+
+    /**
+     * A bit mask of the tasks which must finish before this one may
+     * start.
+     */
+    uint_least32_t dependencies;
+
+    /**
+     * A bit mask of the tasks which depend on this one.
+     */
+    uint_least32_t dependents = 0;
+
+    /**
+     * The duration of this task in the last round.
+     */
+    Duration duration{};
+
+    /**
+     * The predecessor on the critical path leading to this task, or
+     * -1.
+     */
+    int critical_predecessor = -1;
+
+    /**
+     * The length of the critical path ending with this task.
+     */
+    Duration critical_length{};
+
+    /**
+     * The number of dependencies which have not yet finished in the
+     * current Run().  Protected by #mutex.
+     */
+    unsigned n_waiting;
+  };
+
+  std::vector<Task> tasks;
+
+  Mutex mutex;
+
+  /**
+   * Signalled when a task has finished.
+   */
+  Cond cond;
+
+  /**
+   * A bit mask of the tasks which have not yet finished in the
+   * current round; zero if no round is in progress.  Protected by
+   * #mutex while Run() is in progress.
+   */
+  uint_least32_t pending = 0;
+
+  /**
+   * Tasks whose dependencies have all finished.  Protected by
+   * #mutex.
+   */
+  uint_least32_t ready;
+
+  /**
+   * The deadline of the current Run() call.
+   */
+  TimePoint deadline;
+
+  /**
+   * The number of tasks which have been started in the current Run().
+   * Protected by #mutex.
+   */
+  std::size_t n_started;
+
+  /**
+   * The last task of the critical path of the last complete round,
+   * or -1.
+   */
+  int critical_end = -1;
+
+public:
+  /**
+   * Add a task.  It may only depend on tasks which were added
+   * before, which rules out cycles.
+   *
+   * @param name a string literal describing the task
+   * @param dependencies the indices returned by previous AddTask()
+   * calls of the tasks which must finish before this one may start
+   * @return the index of the new task
+   */
+  unsigned AddTask(const char *name, Function function,
+                   std::initializer_list<unsigned> dependencies={}) noexcept;
+
+  std::size_t size() const noexcept {
+    return tasks.size();
+  }
+
+  const char *GetName(std::size_t i) const noexcept {
+    return tasks[i].name;
+  }
+
+  /**
+   * The duration of the given task in the last complete round.
+   */
+  Duration GetDuration(std::size_t i) const noexcept {
+    return tasks[i].duration;
+  }
+
+  /**
+   * The sum of all task durations in the last complete round, i.e.
+   * the time it would take in one thread.
+   */
+  [[gnu::pure]]
+  Duration GetWork() const noexcept;
+
+  /**
+   * The length of the critical path of the last complete round.
+   */
+  Duration GetCriticalLength() const noexcept {
+    return critical_end >= 0
+      ? tasks[critical_end].critical_length
+      : Duration::zero();
+  }
+
+  /**
+   * The indices of the tasks on the critical path of the last
+   * complete round, first task first.
+   */
+  std::vector<unsigned> GetCriticalPath() const noexcept;
+
+  /**
+   * Is a round in progress, i.e. did the last Run() call stop at its
+   * deadline?
+   */
+  bool IsPending() const noexcept {
+    return pending != 0;
+  }
+
+  /**
+   * Run the tasks of the current round (or start a new one) and
+   * return when all have finished or when the deadline has passed.
+   * At least one task is run per call, even if the deadline has
+   * already passed.
+   *
+   * The functions must not throw.
+   *
+   * @param pool the pool to run the tasks on; nullptr runs all tasks
+   * in the calling thread in the order they were added
+   * @return true if the round is complete
+   */
+  bool Run(ThreadPool *pool,
+           TimePoint _deadline=TimePoint::max()) noexcept;
+
+private:
+  void RunTask(Task &task) noexcept;
+
+  /**
+   * Execute ready tasks until all tasks have finished or the
+   * deadline has passed.  Called by each thread of the pool.
+   *
+   * Caller must lock the mutex.
+   */
+  void Work(std::unique_lock<Mutex> &lock) noexcept;
+
+  /**
+   * Has the deadline passed?  Always false until the first task has
+   * been started.
+   */
+  bool IsExpired() const noexcept {
+    return n_started > 0 && deadline != TimePoint::max() &&
+      Clock::now() >= deadline;
+  }
+
+  void UpdateCriticalPath() noexcept;
+};
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+ThreadPool::~ThreadPool() noexcept
+{
+  {
+    const std::lock_guard lock{mutex};
+    assert(job == nullptr);
+    stop = true;
+    work_cond.notify_all();
+  }
+
+  for (auto &worker : workers)
+    worker.Join();
+}
+
+unsigned
+ThreadPool::GetDefaultWorkers(unsigned limit) noexcept
+{
+  const unsigned n_cpus = std::thread::hardware_concurrency();
+  return n_cpus > 1
+    ? std::min(n_cpus - 1, limit)
+    : 0;
+}
+
+void
+ThreadPool::StartWorkers() noexcept
+{
+  if (started)
+    return;
+
+  started = true;
+
+  for (unsigned i = 0; i < max_workers; ++i) {
+    auto &worker = workers.emplace_front(*this, name);
+    try {
+      worker.Start();
+    } catch (...) {
+      workers.pop_front();
+      break;
+    }
+  }
+}
+
+void
+ThreadPool::RunTasks(std::unique_lock<Mutex> &lock) noexcept
+{
+  assert(lock.owns_lock());
+
+  while (job != nullptr && next_task < n_tasks) {
+    const std::size_t i = next_task++;
+    const auto &f = *job;
+
+    lock.unlock();
+    f(i);
+    lock.lock();
+
+    assert(n_pending > 0);
+    if (--n_pending == 0)
+      done_cond.notify_one();
+  }
+}
+
+void
+ThreadPool::ForEach(std::size_t n,
+                    const std::function<void(std::size_t)> &f) noexcept
+{
+  if (n == 0)
+    return;
+
+  if (n > 1)
+    StartWorkers();
+
+  std::unique_lock lock{mutex};
+  assert(job == nullptr);
+
+  job = &f;
+  n_tasks = n;
+  next_task = 0;
+  n_pending = n;
+
+  if (n > 1)
+    work_cond.notify_all();
+
+  RunTasks(lock);
+
+  /* wait for the tasks which are still running in worker threads */
+  done_cond.wait(lock, [this]{ return n_pending == 0; });
+
+  job = nullptr;
+}
+
+void
+ThreadPool::Worker::Run() noexcept
+{
+  if (pool.idle_priority)
+    SetIdlePriority();
+
+  std::unique_lock lock{pool.mutex};
+  while (!pool.stop) {
+    if (pool.job != nullptr && pool.next_task < pool.n_tasks)
+      pool.RunTasks(lock);
+    else
+      pool.work_cond.wait(lock);
+  }
+}
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+
+#include <cstddef>
+#include <forward_list>
+#include <functional>
+
+/**
+ * A small pool of threads which runs a batch of independent tasks in
+ * parallel.  The threads are launched on the first ForEach() call
+ * and live until the pool is destructed.
+ */
+class ThreadPool {
+  class Worker final : public Thread {
+    ThreadPool &pool;
+
+  public:
+    Worker(ThreadPool &_pool, const char *_name) noexcept
+      :Thread(_name), pool(_pool) {}
+
+  protected:
+    /* virtual methods from class Thread */
+    void Run() noexcept override;
+  };
+
+  const char *const name;
+
+  const unsigned max_workers;
+
+  const bool idle_priority;
+
+  Mutex mutex;
+
+  /**
+   * Wakes up the workers when a batch is submitted or when they
+   * shall stop.
+   */
+  Cond work_cond;
+
+  /**
+   * Wakes up ForEach() when the last task has finished.
+   */
+  Cond done_cond;
+
+  std::forward_list<Worker> workers;
+
+  /**
+   * Has StartWorkers() been called already?
+   */
+  bool started = false;
+
+  /**
+   * The current batch, or nullptr.  Protected by #mutex.
+   */
+  const std::function<void(std::size_t)> *job = nullptr;
+
+  std::size_t n_tasks = 0, next_task = 0, n_pending = 0;
+
+  bool stop = false;
+
+public:
+  /**
+   * @param max_workers the number of threads in addition to the one
+   * which calls ForEach(); 0 runs everything in that thread
+   * @param idle_priority run the threads with idle priority
+   */
+  ThreadPool(const char *_name, unsigned _max_workers,
+             bool _idle_priority=false) noexcept
+    :name(_name), max_workers(_max_workers),
+     idle_priority(_idle_priority) {}
+
+  /**
+   * Stops and joins all threads.  Must not be called while a
+   * ForEach() call is in progress.
+   */
+  ~ThreadPool() noexcept;
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * The number of threads in addition to the one which calls
+   * ForEach().
+   */
+  unsigned GetMaxWorkers() const noexcept {
+    return max_workers;
+  }
+
+  /**
+   * The number of worker threads a pool should have on this machine:
+   * one less than the number of CPUs (the caller participates),
+   * limited to the specified value.
+   */
+  static unsigned GetDefaultWorkers(unsigned limit) noexcept;
+
+  /**
+   * Call f(i) for each i in 0..n-1, distributed over the calling
+   * thread and the worker threads, and return when all calls have
+   * finished.  The tasks are started in ascending order.
+   *
+   * The function must not throw, and it must not call ForEach() on
+   * the same pool.  Only one thread may call ForEach() at a time.
+   */
+  void ForEach(std::size_t n,
+               const std::function<void(std::size_t)> &f) noexcept;
+
+private:
+  /**
+   * Launch the worker threads (if not already running).  If a thread
+   * cannot be launched, the pool continues with the ones it has.
+   */
+  void StartWorkers() noexcept;
+
+  /**
+   * Run tasks of the current batch until there are none left.
+   *
+   * Caller must lock the mutex.
+   */
+  void RunTasks(std::unique_lock<Mutex> &lock) noexcept;
+};
@@ -161,8 +161,11 @@ public:
   /**
    * Load a georeferenced image (e.g. GeoTIFF) and return its bounds.
    * Throws a std::runtime_error on error.
+   *
+   * @param max_size if the image is larger than this (width or
+   * height), it is downscaled by powers of two; 0 means no limit
    */
-  GeoQuadrilateral LoadGeoFile(Path path);
+  GeoQuadrilateral LoadGeoFile(Path path, unsigned max_size=0);
 
   void Reset() noexcept;
 
@@ -24,6 +24,9 @@ class GLTexture;
 #include <tchar.h>
 
 #ifdef USE_FREETYPE
+#include <cstdint>
+#include <memory>
+
 typedef struct FT_FaceRec_ *FT_Face;
 #endif
 
@@ -121,6 +124,51 @@ public:
   }
 #endif
 
+#ifdef USE_FREETYPE
+  /**
+   * The placement of a glyph rendered by RasterizeGlyph(), relative to
+   * the pen position.  Placing the glyphs of a string this way
+   * yields the same layout as Render().
+   */
+  struct GlyphMetrics {
+    /**
+     * The position of the bitmap's top left corner relative to the
+     * pen position and the top of the line.
+     */
+    int left, top;
+
+    unsigned width, height;
+
+    /**
+     * How far the pen moves after this glyph.
+     */
+    unsigned advance;
+  };
+
+  /**
+   * @return the glyph index of the given Unicode character, or 0 if
+   * the font doesn't have it
+   */
+  [[gnu::pure]]
+  unsigned GetGlyphIndex(unsigned ch) const noexcept;
+
+  /**
+   * Returns the horizontal kerning [pixels] between two glyphs.
+   */
+  [[gnu::pure]]
+  int GetKerning(unsigned previous, unsigned current) const noexcept;
+
+  /**
+   * Render one glyph into a new 8 bit alpha bitmap of
+   * metrics.width * metrics.height pixels.
+   *
+   * @return false on error; the bitmap is nullptr if the glyph is
+   * empty (e.g. a space)
+   */
+  bool RasterizeGlyph(unsigned index, GlyphMetrics &metrics,
+                      std::unique_ptr<uint8_t[]> &bitmap) const noexcept;
+#endif
+
   unsigned GetHeight() const noexcept {
     return height;
   }
@@ -3,6 +3,7 @@
 
 #include "ui/canvas/Bitmap.hpp"
 #include "UncompressedImage.hpp"
+#include "ScaleImage.hpp"
 #include "Geo/Quadrilateral.hpp"
 #include "system/Path.hpp"
 
@@ -19,12 +20,21 @@
 #endif
 
 GeoQuadrilateral
-Bitmap::LoadGeoFile([[maybe_unused]] Path path)
+Bitmap::LoadGeoFile([[maybe_unused]] Path path,
+                    [[maybe_unused]] unsigned max_size)
 {
 #ifdef USE_GEOTIFF
   if (path.EndsWithIgnoreCase(_T(".tif")) ||
       path.EndsWithIgnoreCase(_T(".tiff"))) {
     auto result = LoadGeoTiff(path);
+
+    if (const unsigned level = GetMipLevel(result.first.GetSize(), max_size);
+        level > 0) {
+      auto scaled = DownscaleImage(result.first, level);
+      if (scaled.IsDefined())
+        result.first = std::move(scaled);
+    }
+
     if (!Load(std::move(result.first)))
       throw std::runtime_error("Failed to use geo image file");
 
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ScaleImage.hpp"
+#include "UncompressedImage.hpp"
+
+#include <algorithm>
+
+[[gnu::const]]
+static unsigned
+GetBytesPerPixel(UncompressedImage::Format format) noexcept
+{
+  switch (format) {
+  case UncompressedImage::Format::INVALID:
+    break;
+
+  case UncompressedImage::Format::RGB:
+    return 3;
+
+  case UncompressedImage::Format::RGBA:
+    return 4;
+
+  case UncompressedImage::Format::GRAY:
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * Halve the image once.
+ */
+static void
+Halve(const uint8_t *src, std::size_t src_pitch,
+      unsigned src_width, unsigned src_height,
+      uint8_t *dest, std::size_t dest_pitch,
+      unsigned bpp) noexcept
+{
+  const unsigned dest_width = (src_width + 1) / 2;
+  const unsigned dest_height = (src_height + 1) / 2;
+
+  for (unsigned y = 0; y < dest_height; ++y) {
+    const uint8_t *row0 = src + 2 * y * src_pitch;
+    const uint8_t *row1 = src + std::min(2 * y + 1, src_height - 1) * src_pitch;
+    uint8_t *out = dest + y * dest_pitch;
+
+    for (unsigned x = 0; x < dest_width; ++x) {
+      const unsigned x0 = 2 * x * bpp;
+      const unsigned x1 = std::min(2 * x + 1, src_width - 1) * bpp;
+
+      const uint8_t *p[4]{row0 + x0, row0 + x1, row1 + x0, row1 + x1};
+
+      if (bpp == 4) {
+        /* weight the colour by alpha, so transparent pixels (which
+           are usually black) do not darken the edges */
+        const unsigned alpha = p[0][3] + p[1][3] + p[2][3] + p[3][3];
+        for (unsigned c = 0; c < 3; ++c)
+          *out++ = alpha > 0
+            ? (p[0][c] * p[0][3] + p[1][c] * p[1][3] +
+               p[2][c] * p[2][3] + p[3][c] * p[3][3] + alpha / 2) / alpha
+            : 0;
+        *out++ = (alpha + 2) / 4;
+      } else {
+        for (unsigned c = 0; c < bpp; ++c)
+          *out++ = (p[0][c] + p[1][c] + p[2][c] + p[3][c] + 2) / 4;
+      }
+    }
+  }
+}
+
+UncompressedImage
+DownscaleImage(const UncompressedImage &src, unsigned level) noexcept
+{
+  const unsigned bpp = GetBytesPerPixel(src.GetFormat());
+  if (bpp == 0 || !src.IsDefined() || level == 0)
+    return {};
+
+  unsigned width = src.GetWidth(), height = src.GetHeight();
+  const uint8_t *data = static_cast<const uint8_t *>(src.GetData());
+  std::size_t pitch = src.GetPitch();
+
+  std::unique_ptr<uint8_t[]> buffer;
+  for (unsigned i = 0; i < level && (width > 1 || height > 1); ++i) {
+    const unsigned new_width = (width + 1) / 2;
+    const unsigned new_height = (height + 1) / 2;
+    const std::size_t new_pitch = std::size_t(new_width) * bpp;
+
+    auto new_buffer = std::make_unique<uint8_t[]>(new_pitch * new_height);
+    Halve(data, pitch, width, height, new_buffer.get(), new_pitch, bpp);
+
+    buffer = std::move(new_buffer);
+    data = buffer.get();
+    pitch = new_pitch;
+    width = new_width;
+    height = new_height;
+  }
+
+  return UncompressedImage(src.GetFormat(), pitch, width, height,
+                           std::move(buffer), src.IsFlipped());
+}
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "ui/dim/Size.hpp"
+
+class UncompressedImage;
+
+/**
+ * Determine how often an image of the given size needs to be halved
+ * so neither dimension exceeds #max_size.
+ *
+ * @param max_size the maximum width and height; 0 means no limit
+ */
+constexpr unsigned
+GetMipLevel(PixelSize size, unsigned max_size) noexcept
+{
+  /* round up like DownscaleImage() does */
+  constexpr auto scaled = [](unsigned value, unsigned level){
+    return (value + (1u << level) - 1) >> level;
+  };
+
+  unsigned level = 0;
+  if (max_size > 0)
+    while (scaled(size.width, level) > max_size ||
+           scaled(size.height, level) > max_size)
+      ++level;
+
+  return level;
+}
+
+/**
+ * Halve the image size #level times, averaging each 2x2 block of
+ * pixels (a mipmap level).  Odd columns and rows at the right and
+ * bottom edges are averaged with themselves, so the image still
+ * covers the same area.
+ *
+ * Returns an undefined image if the format is not supported.
+ */
+UncompressedImage
+DownscaleImage(const UncompressedImage &src, unsigned level) noexcept;
@@ -34,6 +34,11 @@
 
 #include <cstdint>
 
+#ifdef KOBO
+#include <chrono>
+#include <memory>
+#endif
+
 #ifdef SOFTWARE_ROTATE_DISPLAY
 enum class DisplayOrientation : uint8_t;
 #endif
@@ -42,6 +47,7 @@ struct SDL_Window;
 struct SDL_Renderer;
 struct SDL_Texture;
 class Canvas;
+struct PixelRect;
 struct PixelSize;
 namespace UI { class Display; }
 
@@ -123,6 +129,24 @@ class TopCanvas
    * this flag can be set true for don't wait eInk Update complete for faster responce time.
    */
   bool frame_sync = false;
+
+  /**
+   * The last two frames in the frame buffer's pixel format; Flip()
+   * exports into #frames[0] and compares it with #frames[1] to send
+   * only the damaged regions to the e-ink controller.
+   */
+  std::unique_ptr<std::byte[]> frames[2];
+
+  /**
+   * When was the last full-screen refresh?  All other updates are
+   * partial; the full ones clear e-ink ghosting.
+   */
+  std::chrono::steady_clock::time_point last_full_refresh;
+
+  /**
+   * Shall the next Flip() refresh the whole screen?
+   */
+  bool full_refresh_pending = true;
 #endif // KOBO
 
 public:
@@ -235,8 +259,19 @@ public:
   void Wait() noexcept;
 
   void SetEnableDither(bool _enable_dither) noexcept {
+    if (_enable_dither != enable_dither)
+      full_refresh_pending = true;
+
     enable_dither = _enable_dither;
   }
+
+  /**
+   * Refresh the whole screen with the next Flip() call, to clear
+   * ghost images.
+   */
+  void ScheduleFullRefresh() noexcept {
+    full_refresh_pending = true;
+  }
 #endif
 
 #ifdef SOFTWARE_ROTATE_DISPLAY
@@ -248,6 +283,16 @@ private:
   PixelSize SetupViewport(PixelSize native_size) noexcept;
 #endif
 
+#ifdef KOBO
+  void AllocateFrames() noexcept;
+
+  /**
+   * Send an update of the given region (or the whole screen) to the
+   * e-ink controller.
+   */
+  void SendUpdate(const PixelRect &rc, bool full) noexcept;
+#endif
+
 #ifdef USE_EGL
   void CreateSurface(EGLNativeWindowType native_window);
 #endif
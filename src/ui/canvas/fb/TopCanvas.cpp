@@ -14,12 +14,23 @@
 #endif
 
 #if defined(KOBO) && defined(USE_FB)
+#include "ui/canvas/memory/Damage.hpp"
 #include "Kobo/Model.hpp"
 #include "mxcfb.h"
 #endif
 
 #include <algorithm>
 
+#if defined(KOBO) && defined(USE_FB)
+#include <array>
+
+/**
+ * Refresh the whole screen at least this often to clear e-ink ghost
+ * images; all other updates are partial.
+ */
+static constexpr std::chrono::seconds FULL_REFRESH_INTERVAL{60};
+#endif
+
 #ifdef USE_FB
 #include <linux/fb.h>
 #include <sys/ioctl.h>
@@ -175,6 +186,10 @@ TopCanvas::TopCanvas(UI::Display &_display)
                            vinfo.width, vinfo.height);
 
   buffer.Allocate(new_size.width, new_size.height);
+
+#ifdef KOBO
+  AllocateFrames();
+#endif
 }
 
 inline PixelSize
@@ -225,6 +240,11 @@ TopCanvas::CheckResize(const PixelSize new_native_size) noexcept
 
   buffer.Free();
   buffer.Allocate(new_size.width, new_size.height);
+
+#if defined(KOBO) && defined(USE_FB)
+  AllocateFrames();
+#endif
+
   return true;
 }
 
@@ -244,6 +264,14 @@ TopCanvas::Flip()
 {
 #ifdef USE_FB
 
+#ifdef KOBO
+  /* export into RAM first: reading back from the frame buffer would
+     be slow, and the result is compared with the previous frame */
+  void *const dest = frames[0].get();
+#else
+  void *const dest = map;
+#endif
+
 #ifdef GREYSCALE
   CopyFromGreyscale(
 #ifdef DITHER
@@ -252,23 +280,82 @@ TopCanvas::Flip()
 #ifdef KOBO
                     enable_dither,
 #endif
-                    map, map_pitch, map_bpp,
+                    dest, map_pitch, map_bpp,
                     buffer);
 #else
-  CopyFromBGRA(map, map_pitch, map_bpp, buffer);
+  CopyFromBGRA(dest, map_pitch, map_bpp, buffer);
+#endif
+
+
+#ifdef KOBO
+  const auto now = std::chrono::steady_clock::now();
+  const std::size_t frame_size = std::size_t(map_pitch) * buffer.height;
+
+  if (full_refresh_pending || now - last_full_refresh >= FULL_REFRESH_INTERVAL) {
+    memcpy(map, frames[0].get(), frame_size);
+
+    if (frame_sync)
+      Wait();
+
+    SendUpdate(PixelRect{PixelSize{buffer.width, buffer.height}}, true);
+
+    full_refresh_pending = false;
+    last_full_refresh = now;
+  } else {
+    std::array<PixelRect, 4> damage;
+    const std::size_t n = FindDamage(damage, frames[1].get(), frames[0].get(),
+                                     map_pitch, buffer.width, buffer.height,
+                                     map_bpp);
+    if (n == 0)
+      /* nothing has changed */
+      return;
+
+    for (std::size_t i = 0; i < n; ++i) {
+      const PixelRect &rc = damage[i];
+      const std::size_t offset = std::size_t(rc.left) * map_bpp;
+      const std::size_t row_size = std::size_t(rc.GetWidth()) * map_bpp;
+
+      for (int y = rc.top; y < rc.bottom; ++y) {
+        const std::size_t row = std::size_t(y) * map_pitch + offset;
+        memcpy((std::byte *)map + row, frames[0].get() + row, row_size);
+      }
+    }
+
+    if (frame_sync)
+      Wait();
+
+    for (std::size_t i = 0; i < n; ++i)
+      SendUpdate(damage[i], false);
+  }
+
+  std::swap(frames[0], frames[1]);
 #endif
 
+#endif /* USE_FB */
+}
 
 #ifdef KOBO
-  if (frame_sync)
-    Wait();
 
+void
+TopCanvas::AllocateFrames() noexcept
+{
+  const std::size_t frame_size = std::size_t(map_pitch) * buffer.height;
+  for (auto &i : frames)
+    i = std::make_unique<std::byte[]>(frame_size);
+
+  full_refresh_pending = true;
+}
+
+void
+TopCanvas::SendUpdate(const PixelRect &rc, bool full) noexcept
+{
   epd_update_marker++;
 
   KoboModel kobo_model = DetectKoboModel();
   struct mxcfb_update_data epd_update_data = {
     {
-      0, 0, buffer.width, buffer.height
+      uint32_t(rc.top), uint32_t(rc.left),
+      uint32_t(rc.GetWidth()), uint32_t(rc.GetHeight()),
     },
 
     uint32_t(enable_dither &&
@@ -282,20 +369,18 @@ TopCanvas::Flip()
               kobo_model == KoboModel::CLARA_2E)
              ? WAVEFORM_MODE_A2
              : WAVEFORM_MODE_AUTO),
-    UPDATE_MODE_FULL, // PARTIAL
+
+    /* a partial update changes only the pixels which differ, which
+       is faster and doesn't flash */
+    uint32_t(full ? UPDATE_MODE_FULL : UPDATE_MODE_PARTIAL),
     epd_update_marker,
     TEMP_USE_AMBIENT,
     enable_dither ? EPDC_FLAG_FORCE_MONOCHROME : 0,
   };
 
   ioctl(fd, MXCFB_SEND_UPDATE, &epd_update_data);
-#endif
-
-#endif /* USE_FB */
 }
 
-#ifdef KOBO
-
 void
 TopCanvas::Wait() noexcept
 {
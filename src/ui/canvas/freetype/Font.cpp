@@ -392,3 +392,75 @@ Font::Render(tstring_view text, const PixelSize size,
                   x, y);
     });
 }
+
+unsigned
+Font::GetGlyphIndex(unsigned ch) const noexcept
+{
+#ifndef ENABLE_OPENGL
+  const std::lock_guard lock{freetype_mutex};
+#endif
+
+  return FT_Get_Char_Index(face, ch);
+}
+
+int
+Font::GetKerning(unsigned previous, unsigned current) const noexcept
+{
+  if (!FT_HAS_KERNING(face) || previous == 0 || current == 0)
+    return 0;
+
+#ifndef ENABLE_OPENGL
+  const std::lock_guard lock{freetype_mutex};
+#endif
+
+  FT_Vector delta;
+  if (FT_Get_Kerning(face, previous, current, ft_kerning_default, &delta))
+    return 0;
+
+  return delta.x >> 6;
+}
+
+bool
+Font::RasterizeGlyph(unsigned index, GlyphMetrics &metrics,
+                     std::unique_ptr<uint8_t[]> &bitmap) const noexcept
+{
+#ifndef ENABLE_OPENGL
+  const std::lock_guard lock{freetype_mutex};
+#endif
+
+  if (FT_Load_Glyph(face, index, load_flags))
+    return false;
+
+  const FT_GlyphSlot glyph = face->glyph;
+
+  /* same placement as ForEachGlyph() */
+  metrics.left = FT_FLOOR(glyph->metrics.horiBearingX);
+  metrics.top = int(ascent_height) - FT_FLOOR(glyph->metrics.horiBearingY);
+  metrics.advance = FT_CEIL(glyph->metrics.horiAdvance);
+
+  if (FT_Render_Glyph(glyph, render_mode))
+    return false;
+
+  const FT_Bitmap &src = glyph->bitmap;
+  metrics.width = src.width;
+  metrics.height = src.rows;
+
+  if (metrics.width == 0 || metrics.height == 0) {
+    bitmap.reset();
+    return true;
+  }
+
+  bitmap.reset(new uint8_t[metrics.width * metrics.height]);
+
+  uint8_t *dest = bitmap.get();
+  const uint8_t *s = src.buffer;
+  for (unsigned y = 0; y < metrics.height;
+       ++y, s += src.pitch, dest += metrics.width) {
+    if (IsMono())
+      ConvertMono(dest, s, metrics.width);
+    else
+      std::copy_n(s, metrics.width, dest);
+  }
+
+  return true;
+}
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Damage.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include <string.h>
+
+std::size_t
+FindDamage(std::span<PixelRect> dest,
+           const void *_a, const void *_b, std::size_t pitch,
+           unsigned width, unsigned height, unsigned bpp,
+           unsigned merge_rows) noexcept
+{
+  if (dest.empty())
+    return 0;
+
+  const auto *a = static_cast<const std::byte *>(_a);
+  const auto *b = static_cast<const std::byte *>(_b);
+  const std::size_t row_size = std::size_t(width) * bpp;
+
+  std::size_t n = 0;
+
+  for (unsigned y = 0; y < height; ++y, a += pitch, b += pitch) {
+    if (memcmp(a, b, row_size) == 0)
+      continue;
+
+    /* find the first and the last differing pixel in this row */
+    const auto first = std::mismatch(a, a + row_size, b).first - a;
+    const auto last = row_size -
+      (std::mismatch(std::make_reverse_iterator(a + row_size),
+                     std::make_reverse_iterator(a),
+                     std::make_reverse_iterator(b + row_size)).first
+       - std::make_reverse_iterator(a + row_size));
+
+    const int left = first / bpp;
+    const int right = (last + bpp - 1) / bpp;
+
+    if (n > 0 &&
+        (unsigned(dest[n - 1].bottom) + merge_rows >= y || n == dest.size())) {
+      /* grow the previous rectangle */
+      PixelRect &r = dest[n - 1];
+      r.left = std::min(r.left, left);
+      r.right = std::max(r.right, right);
+      r.bottom = y + 1;
+    } else
+      dest[n++] = PixelRect{left, int(y), right, int(y) + 1};
+  }
+
+  return n;
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "ui/dim/Rect.hpp"
+
+#include <cstddef>
+#include <span>
+
+/**
+ * Compare two frames and collect the bounding boxes of the areas
+ * which differ.  Damaged rows which are at most #merge_rows apart
+ * are combined into one rectangle; if there are more areas than
+ * #dest can hold, the last rectangle grows to include the rest.
+ *
+ * @param a the previous frame
+ * @param b the new frame, with the same layout
+ * @param pitch the distance between two rows [bytes]
+ * @param width the width of the frames [pixels]
+ * @param bpp the number of bytes per pixel
+ * @return the number of rectangles written to #dest
+ */
+std::size_t
+FindDamage(std::span<PixelRect> dest,
+           const void *a, const void *b, std::size_t pitch,
+           unsigned width, unsigned height, unsigned bpp,
+           unsigned merge_rows=16) noexcept;
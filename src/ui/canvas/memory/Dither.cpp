@@ -3,8 +3,57 @@
 
 #include "Dither.hpp"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 #include <algorithm>
 
+/**
+ * The number of pixels checked at a time by the fast path for black
+ * and white areas.
+ */
+static constexpr unsigned SATURATED_BLOCK = 16;
+
+/**
+ * Are all pixels of the block either black or white?
+ */
+[[gnu::pure]]
+static inline bool
+IsSaturatedBlock(const uint8_t *p) noexcept
+{
+#if defined(__SSE2__)
+  const __m128i v = _mm_loadu_si128((const __m128i *)p);
+  const __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_setzero_si128()),
+                                 _mm_cmpeq_epi8(v, _mm_set1_epi8(-1)));
+  return _mm_movemask_epi8(m) == 0xffff;
+#elif defined(__ARM_NEON__)
+  const uint8x16_t v = vld1q_u8(p);
+  const uint8x16_t m = vorrq_u8(vceqq_u8(v, vdupq_n_u8(0)),
+                                vceqq_u8(v, vdupq_n_u8(0xff)));
+  const uint8x8_t m8 = vand_u8(vget_low_u8(m), vget_high_u8(m));
+  return vget_lane_u64(vreinterpret_u64_u8(m8), 0) == ~uint64_t(0);
+#else
+  for (unsigned i = 0; i < SATURATED_BLOCK; ++i)
+    if (p[i] != 0 && p[i] != 0xff)
+      return false;
+  return true;
+#endif
+}
+
+template<typename T>
+[[gnu::pure]]
+static inline bool
+IsZeroBlock(const T *p) noexcept
+{
+  T x = 0;
+  for (unsigned i = 0; i < SATURATED_BLOCK; ++i)
+    x |= p[i];
+  return x == 0;
+}
+
 // Code adapted from imx.60 linux kernel EPD driver by Daiyu Ko <dko@freescale.com>
 //
 
@@ -31,6 +80,22 @@ Dither::DitherGreyscale(const uint8_t *gcc_restrict src,
 
     /* scan the line and convert the Y8 to BW */
     for (unsigned column = 0; column < width; ++column) {
+      /* fast path: black and white pixels without pending errors
+         are copied and leave no error behind; this is common on the
+         map (background, lines, labels) */
+      while (e0 == 0 && e1 == 0 && column + SATURATED_BLOCK <= width &&
+             IsSaturatedBlock(src + column) &&
+             IsZeroBlock(err_dist_l0)) {
+        std::copy_n(src + column, SATURATED_BLOCK, dest + column);
+        std::fill_n(err_dist_l1, SATURATED_BLOCK, 0);
+        err_dist_l0 += SATURATED_BLOCK;
+        err_dist_l1 += SATURATED_BLOCK;
+        column += SATURATED_BLOCK;
+      }
+
+      if (column == width)
+        break;
+
       ErrorDistType bwPix = e0 + src[column];
 
       uint8_t color = 0;
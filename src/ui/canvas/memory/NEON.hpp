@@ -163,6 +163,64 @@ public:
   }
 };
 
+#ifndef GREYSCALE
+
+/**
+ * Implementation of AlphaPixelOperations for 32 bit pixels using ARM
+ * NEON instructions.  Each byte is blended on its own.
+ */
+class NEONAlpha32PixelOperations {
+  uint8_t alpha;
+
+public:
+  using PixelTraits = BGRAPixelTraits;
+  using SourcePixelTraits = BGRAPixelTraits;
+
+  constexpr NEONAlpha32PixelOperations(uint8_t _alpha):alpha(_alpha) {}
+
+  [[gnu::hot]] [[gnu::flatten]] [[gnu::nonnull]]
+  void FillPixels(BGRA8Color *_p, unsigned n, BGRA8Color c) const {
+    const uint8_t color[8] = {
+      c.Blue(), c.Green(), c.Red(), c.Alpha(),
+      c.Blue(), c.Green(), c.Red(), c.Alpha(),
+    };
+
+    const uint8x8_t v_alpha = vdup_n_u8(~alpha);
+    const uint16x8_t v_color = vmull_u8(vld1_u8(color), vdup_n_u8(alpha));
+
+    uint8_t *p = (uint8_t *)_p;
+    for (unsigned i = 0; i < n / 4; ++i, p += 16) {
+      const uint8x16_t x = vld1q_u8(p);
+      const uint8x8_t lo = vraddhn_u16(vmull_u8(vget_low_u8(x), v_alpha),
+                                       v_color);
+      const uint8x8_t hi = vraddhn_u16(vmull_u8(vget_high_u8(x), v_alpha),
+                                       v_color);
+      vst1q_u8(p, vcombine_u8(lo, hi));
+    }
+  }
+
+  [[gnu::flatten]]
+  void CopyPixels(BGRA8Color *_p, const BGRA8Color *_q, unsigned n) const {
+    const uint8x8_t v_alpha = vdup_n_u8(alpha);
+    const uint8x8_t inverse_alpha = vdup_n_u8(~alpha);
+
+    uint8_t *gcc_restrict p = (uint8_t *)_p;
+    const uint8_t *gcc_restrict q = (const uint8_t *)_q;
+    for (unsigned i = 0; i < n / 4; ++i, p += 16, q += 16) {
+      const uint8x16_t pv = vld1q_u8(p), qv = vld1q_u8(q);
+
+      const uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(pv), inverse_alpha),
+                                     vget_low_u8(qv), v_alpha);
+      const uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(pv), inverse_alpha),
+                                     vget_high_u8(qv), v_alpha);
+
+      vst1q_u8(p, vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8)));
+    }
+  }
+};
+
+#endif /* !GREYSCALE */
+
 /**
  * Read bytes and emit each byte twice.  This class reads 16 bytes at
  * a time, and writes 32 bytes at a time.
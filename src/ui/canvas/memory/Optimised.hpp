@@ -10,7 +10,9 @@
 #include "NEON.hpp"
 #endif
 
-#ifdef __MMX__
+#ifdef __SSE2__
+#include "SSE2.hpp"
+#elif defined(__MMX__)
 #include "MMX.hpp"
 #endif
 
@@ -101,6 +103,24 @@ struct TransparentPixelOperations<GreyscalePixelTraits>
     :SelectOptimisedPixelOperations(key) {}
 };
 
+#elif defined(__SSE2__)
+
+template<>
+struct BitOrPixelOperations<GreyscalePixelTraits>
+  : SelectOptimisedPixelOperations<SSE2BitOrPixelOperations, 16,
+                                   PortableBitOrPixelOperations<GreyscalePixelTraits>> {
+};
+
+template<>
+struct TransparentPixelOperations<GreyscalePixelTraits>
+  : public SelectOptimisedPixelOperations<SSE2TransparentPixelOperations, 16,
+                                          PortableTransparentPixelOperations<GreyscalePixelTraits>> {
+  typedef typename PixelTraits::color_type color_type;
+
+  explicit constexpr TransparentPixelOperations(const color_type key)
+    :SelectOptimisedPixelOperations(key) {}
+};
+
 #endif
 
 template<AnyPixelTraits PixelTraits>
@@ -122,9 +142,50 @@ public:
     :SelectOptimisedPixelOperations(alpha) {}
 };
 
-#endif
+#ifndef GREYSCALE
+
+template<>
+class AlphaPixelOperations<BGRAPixelTraits>
+  : public SelectOptimisedPixelOperations<NEONAlpha32PixelOperations, 4,
+                                          PortableAlphaPixelOperations<BGRAPixelTraits>> {
+public:
+  using typename SelectOptimisedPixelOperations::PixelTraits;
+  using typename SelectOptimisedPixelOperations::SourcePixelTraits;
+
+  explicit constexpr AlphaPixelOperations(const uint8_t alpha)
+    :SelectOptimisedPixelOperations(alpha) {}
+};
+
+#endif /* !GREYSCALE */
+
+#elif defined(__SSE2__)
+
+template<>
+class AlphaPixelOperations<GreyscalePixelTraits>
+  : public SelectOptimisedPixelOperations<SSE2Alpha8PixelOperations, 16,
+                                          PortableAlphaPixelOperations<GreyscalePixelTraits>> {
+public:
+  explicit constexpr AlphaPixelOperations(const uint8_t alpha)
+    :SelectOptimisedPixelOperations(alpha) {}
+};
+
+#ifndef GREYSCALE
+
+template<>
+class AlphaPixelOperations<BGRAPixelTraits>
+  : public SelectOptimisedPixelOperations<SSE2Alpha32PixelOperations, 4,
+                                          PortableAlphaPixelOperations<BGRAPixelTraits>> {
+public:
+  using typename SelectOptimisedPixelOperations::PixelTraits;
+  using typename SelectOptimisedPixelOperations::SourcePixelTraits;
+
+  explicit constexpr AlphaPixelOperations(const uint8_t alpha)
+    :SelectOptimisedPixelOperations(alpha) {}
+};
+
+#endif /* !GREYSCALE */
 
-#ifdef __MMX__
+#elif defined(__MMX__)
 
 template<>
 class AlphaPixelOperations<GreyscalePixelTraits>
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "PixelTraits.hpp"
+#include "ui/canvas/PortableColor.hpp"
+
+#ifndef __SSE2__
+#error SSE2 required
+#endif
+
+#include <emmintrin.h>
+
+/**
+ * Implementation of BitOrPixelOperations using Intel SSE2
+ * instructions.
+ */
+class SSE2BitOrPixelOperations {
+public:
+  using PixelTraits = GreyscalePixelTraits;
+  using SourcePixelTraits = GreyscalePixelTraits;
+
+  [[gnu::flatten]]
+  void CopyPixels(uint8_t *gcc_restrict p,
+                  const uint8_t *gcc_restrict q, unsigned n) const {
+    for (unsigned i = 0; i < n / 16; ++i, p += 16, q += 16) {
+      const __m128i pv = _mm_loadu_si128((const __m128i *)p);
+      const __m128i qv = _mm_loadu_si128((const __m128i *)q);
+      _mm_storeu_si128((__m128i *)p, _mm_or_si128(pv, qv));
+    }
+  }
+
+  void CopyPixels(Luminosity8 *p, const Luminosity8 *q, unsigned n) const {
+    CopyPixels((uint8_t *)p, (const uint8_t *)q, n);
+  }
+};
+
+/**
+ * Implementation of TransparentPixelOperations using Intel SSE2
+ * instructions.
+ */
+class SSE2TransparentPixelOperations {
+  uint8_t key;
+
+public:
+  using PixelTraits = GreyscalePixelTraits;
+  using SourcePixelTraits = GreyscalePixelTraits;
+
+  constexpr SSE2TransparentPixelOperations(Luminosity8 _key)
+    :key(_key.GetLuminosity()) {}
+
+  [[gnu::flatten]]
+  void CopyPixels(uint8_t *gcc_restrict p,
+                  const uint8_t *gcc_restrict q, unsigned n) const {
+    const __m128i v_key = _mm_set1_epi8(key);
+
+    for (unsigned i = 0; i < n / 16; ++i, p += 16, q += 16) {
+      const __m128i pv = _mm_loadu_si128((const __m128i *)p);
+      const __m128i qv = _mm_loadu_si128((const __m128i *)q);
+
+      /* keep the destination where the source is the key colour */
+      const __m128i mask = _mm_cmpeq_epi8(qv, v_key);
+      const __m128i r = _mm_or_si128(_mm_and_si128(mask, pv),
+                                     _mm_andnot_si128(mask, qv));
+      _mm_storeu_si128((__m128i *)p, r);
+    }
+  }
+
+  void CopyPixels(Luminosity8 *p, const Luminosity8 *q, unsigned n) const {
+    CopyPixels((uint8_t *)p, (const uint8_t *)q, n);
+  }
+};
+
+/**
+ * Implementation of AlphaPixelOperations using Intel SSE2
+ * instructions.  Each byte is blended on its own, which works for
+ * all pixel formats with 8 bit channels.
+ */
+class SSE2AlphaPixelOperations {
+protected:
+  uint8_t alpha;
+
+public:
+  constexpr SSE2AlphaPixelOperations(uint8_t _alpha):alpha(_alpha) {}
+
+  [[gnu::hot]] [[gnu::always_inline]]
+  static __m128i FillPixel(__m128i x, __m128i v_alpha, __m128i v_color) {
+    x = _mm_mullo_epi16(x, v_alpha);
+    x = _mm_add_epi16(x, v_color);
+    return _mm_srli_epi16(x, 8);
+  }
+
+  /**
+   * @param n the number of 16 byte blocks
+   * @param v_color the colour of 8 bytes multiplied with #alpha
+   */
+  [[gnu::hot]] [[gnu::flatten]] [[gnu::nonnull]]
+  void _FillPixels(uint8_t *p, unsigned n, __m128i v_color) const {
+    const __m128i v_alpha = _mm_set1_epi16(alpha ^ 0xff);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (unsigned i = 0; i < n; ++i, p += 16) {
+      const __m128i x = _mm_loadu_si128((const __m128i *)p);
+
+      const __m128i lo = FillPixel(_mm_unpacklo_epi8(x, zero),
+                                   v_alpha, v_color);
+      const __m128i hi = FillPixel(_mm_unpackhi_epi8(x, zero),
+                                   v_alpha, v_color);
+
+      _mm_storeu_si128((__m128i *)p, _mm_packus_epi16(lo, hi));
+    }
+  }
+
+  [[gnu::hot]] [[gnu::always_inline]]
+  static __m128i AlphaBlend8(__m128i p, __m128i q,
+                             __m128i alpha, __m128i inverse_alpha) {
+    p = _mm_mullo_epi16(p, inverse_alpha);
+    q = _mm_mullo_epi16(q, alpha);
+    return _mm_srli_epi16(_mm_add_epi16(p, q), 8);
+  }
+
+  /**
+   * @param n the number of bytes
+   */
+  [[gnu::flatten]]
+  void _CopyPixels(uint8_t *gcc_restrict p,
+                   const uint8_t *gcc_restrict q, unsigned n) const {
+    const __m128i v_alpha = _mm_set1_epi16(alpha);
+    const __m128i inverse_alpha = _mm_set1_epi16(alpha ^ 0xff);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (unsigned i = 0; i < n / 16; ++i, p += 16, q += 16) {
+      const __m128i pv = _mm_loadu_si128((const __m128i *)p);
+      const __m128i qv = _mm_loadu_si128((const __m128i *)q);
+
+      const __m128i lo = AlphaBlend8(_mm_unpacklo_epi8(pv, zero),
+                                     _mm_unpacklo_epi8(qv, zero),
+                                     v_alpha, inverse_alpha);
+
+      const __m128i hi = AlphaBlend8(_mm_unpackhi_epi8(pv, zero),
+                                     _mm_unpackhi_epi8(qv, zero),
+                                     v_alpha, inverse_alpha);
+
+      _mm_storeu_si128((__m128i *)p, _mm_packus_epi16(lo, hi));
+    }
+  }
+};
+
+class SSE2Alpha8PixelOperations : SSE2AlphaPixelOperations {
+public:
+  using PixelTraits = GreyscalePixelTraits;
+  using SourcePixelTraits = GreyscalePixelTraits;
+
+  using SSE2AlphaPixelOperations::SSE2AlphaPixelOperations;
+
+  [[gnu::hot]] [[gnu::flatten]] [[gnu::nonnull]]
+  void FillPixels(Luminosity8 *p, unsigned n, Luminosity8 c) const {
+    _FillPixels((uint8_t *)p, n / 16,
+                _mm_set1_epi16(c.GetLuminosity() * alpha));
+  }
+
+  void CopyPixels(Luminosity8 *p, const Luminosity8 *q, unsigned n) const {
+    _CopyPixels((uint8_t *)p, (const uint8_t *)q, n);
+  }
+};
+
+#ifndef GREYSCALE
+
+class SSE2Alpha32PixelOperations : SSE2AlphaPixelOperations {
+public:
+  using PixelTraits = BGRAPixelTraits;
+  using SourcePixelTraits = BGRAPixelTraits;
+
+  using SSE2AlphaPixelOperations::SSE2AlphaPixelOperations;
+
+  [[gnu::hot]]
+  void FillPixels(BGRA8Color *p, unsigned n, BGRA8Color c) const {
+    const __m128i v_alpha = _mm_set1_epi16(alpha);
+    const __m128i v_color = _mm_setr_epi16(c.Blue(), c.Green(),
+                                           c.Red(), c.Alpha(),
+                                           c.Blue(), c.Green(),
+                                           c.Red(), c.Alpha());
+
+    _FillPixels((uint8_t *)p, n / 4, _mm_mullo_epi16(v_color, v_alpha));
+  }
+
+  void CopyPixels(BGRA8Color *p, const BGRA8Color *q, unsigned n) const {
+    _CopyPixels((uint8_t *)p, (const uint8_t *)q, n * 4);
+  }
+};
+
+#endif /* !GREYSCALE */
@@ -62,6 +62,14 @@ public:
     glBufferData(target, size, data, usage);
   }
 
+  /**
+   * Replaces a part of the buffer's data.  The buffer must be bound.
+   */
+  static void SubData(GLintptr offset, GLsizeiptr size,
+                      const GLvoid *data) noexcept {
+    glBufferSubData(target, offset, size, data);
+  }
+
   void Load(GLsizeiptr size, const GLvoid *data) noexcept {
     Bind();
     Data(size, data);
@@ -125,3 +133,9 @@ public:
 
 class GLArrayBuffer : public GLBuffer<GL_ARRAY_BUFFER, GL_STATIC_DRAW> {
 };
+
+/**
+ * An array buffer which is modified partially with SubData().
+ */
+class GLDynamicArrayBuffer : public GLBuffer<GL_ARRAY_BUFFER, GL_DYNAMIC_DRAW> {
+};
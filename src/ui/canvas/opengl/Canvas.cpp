@@ -22,6 +22,10 @@
 #include "Shaders.hpp"
 #include "Program.hpp"
 
+#ifdef USE_FREETYPE
+#include "GlyphAtlas.hpp"
+#endif
+
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -571,6 +575,47 @@ PrepareColoredAlphaTexture(Color color) noexcept
   color.Bind();
 }
 
+#ifdef USE_FREETYPE
+
+/**
+ * Returns the rectangle covered by a text at the given position,
+ * which is where Font::Render() clips the glyphs; its width is
+ * unlimited.
+ */
+[[gnu::pure]]
+static PixelRect
+GetUnclippedTextRect(const Font &font, PixelPoint p) noexcept
+{
+  /* the vertex coordinates are 16 bit integers */
+  return PixelRect{p, PixelSize{0x4000u, font.GetHeight()}};
+}
+
+/**
+ * Draw a text with the prepared alpha shader, preferably from the
+ * #GlyphAtlas.
+ */
+static void
+DrawGlyphs(const Font &font, std::string_view text, PixelPoint p,
+           const PixelRect &clip) noexcept
+{
+  if (GlyphAtlas::Draw(font, text, p, clip))
+    return;
+
+  GLTexture *texture = TextCache::Get(font, text);
+  if (texture == nullptr)
+    return;
+
+  const PixelSize size{
+    std::min(texture->GetWidth(), unsigned(clip.right - p.x)),
+    std::min(texture->GetHeight(), unsigned(clip.bottom - p.y)),
+  };
+
+  texture->Bind();
+  texture->Draw({p, size}, PixelRect{size});
+}
+
+#endif
+
 void
 Canvas::DrawText(PixelPoint p, tstring_view text) noexcept
 {
@@ -590,6 +635,17 @@ Canvas::DrawText(PixelPoint p, tstring_view text) noexcept
   if (text3.empty())
     return;
 
+#ifdef USE_FREETYPE
+  if (background_mode == OPAQUE)
+    DrawFilledRectangle({p, TextCache::GetSize(*font, text3)},
+                        background_color);
+
+  PrepareColoredAlphaTexture(text_color);
+
+  const ScopeAlphaBlend alpha_blend;
+
+  DrawGlyphs(*font, text3, p, GetUnclippedTextRect(*font, p));
+#else
   GLTexture *texture = TextCache::Get(*font, text3);
   if (texture == nullptr)
     return;
@@ -603,6 +659,7 @@ Canvas::DrawText(PixelPoint p, tstring_view text) noexcept
 
   texture->Bind();
   texture->Draw(p);
+#endif
 }
 
 void
@@ -624,6 +681,13 @@ Canvas::DrawTransparentText(PixelPoint p, tstring_view text) noexcept
   if (text3.empty())
     return;
 
+#ifdef USE_FREETYPE
+  PrepareColoredAlphaTexture(text_color);
+
+  const ScopeAlphaBlend alpha_blend;
+
+  DrawGlyphs(*font, text3, p, GetUnclippedTextRect(*font, p));
+#else
   GLTexture *texture = TextCache::Get(*font, text3);
   if (texture == nullptr)
     return;
@@ -634,6 +698,7 @@ Canvas::DrawTransparentText(PixelPoint p, tstring_view text) noexcept
 
   texture->Bind();
   texture->Draw(p);
+#endif
 }
 
 void
@@ -656,6 +721,17 @@ Canvas::DrawClippedText(PixelPoint p, PixelSize size,
   if (text3.empty())
     return;
 
+#ifdef USE_FREETYPE
+  PrepareColoredAlphaTexture(text_color);
+
+  const ScopeAlphaBlend alpha_blend;
+
+  PixelRect clip = GetUnclippedTextRect(*font, p);
+  clip.right = p.x + size.width;
+  clip.bottom = std::min(clip.bottom, p.y + int(size.height));
+
+  DrawGlyphs(*font, text3, p, clip);
+#else
   GLTexture *texture = TextCache::Get(*font, text3);
   if (texture == nullptr)
     return;
@@ -671,6 +747,7 @@ Canvas::DrawClippedText(PixelPoint p, PixelSize size,
 
   texture->Bind();
   texture->Draw({p, size}, PixelRect{size});
+#endif
 }
 
 void
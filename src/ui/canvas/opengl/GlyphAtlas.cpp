@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "GlyphAtlas.hpp"
+#include "Texture.hpp"
+#include "Debug.hpp"
+#include "VertexPointer.hpp"
+#include "Attribute.hpp"
+#include "ui/canvas/Font.hpp"
+#include "ui/dim/BulkPoint.hpp"
+#include "util/UTF8.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace GlyphAtlas {
+
+/**
+ * The width and height of the atlas texture.  This is a power of
+ * two, which is supported by all OpenGL implementations.
+ */
+static constexpr unsigned ATLAS_SIZE = 1024;
+
+/**
+ * Empty pixels between two glyphs in the atlas.
+ */
+static constexpr unsigned GLYPH_SPACING = 1;
+
+struct GlyphKey {
+  const Font *font;
+
+  /**
+   * The Unicode character.
+   */
+  unsigned ch;
+
+  constexpr bool operator==(const GlyphKey &other) const noexcept {
+    return font == other.font && ch == other.ch;
+  }
+
+  struct Hash {
+    [[gnu::pure]]
+    std::size_t operator()(const GlyphKey &key) const noexcept {
+      return std::size_t(key.font) ^ (std::size_t(key.ch) * 31);
+    }
+  };
+};
+
+struct Glyph {
+  /**
+   * The FreeType glyph index; 0 means the font doesn't have this
+   * character and it will be skipped.
+   */
+  unsigned index;
+
+  /**
+   * The position of the bitmap in the atlas texture.
+   */
+  unsigned x, y;
+
+  Font::GlyphMetrics metrics;
+};
+
+static std::unique_ptr<GLTexture> texture;
+static std::unordered_map<GlyphKey, Glyph, GlyphKey::Hash> glyphs;
+
+/**
+ * The "shelf" packing state: glyphs are placed from left to right in
+ * rows; a new row starts below the tallest glyph of the current one.
+ */
+static unsigned cursor_x, cursor_y, row_height;
+
+/**
+ * Buffers for the vertices of the string being drawn; they are kept
+ * to avoid allocating them again for each string.
+ */
+static std::vector<BulkPixelPoint> vertices;
+static std::vector<GLfloat> coords;
+
+static void
+Clear() noexcept
+{
+  glyphs.clear();
+  cursor_x = cursor_y = row_height = 0;
+}
+
+static void
+CreateTexture() noexcept
+{
+  /* start with a blank texture, so the spacing between glyphs is
+     transparent */
+  const std::unique_ptr<uint8_t[]> blank{new uint8_t[ATLAS_SIZE * ATLAS_SIZE]()};
+  texture = std::make_unique<GLTexture>(GL_ALPHA,
+                                        PixelSize{ATLAS_SIZE, ATLAS_SIZE},
+                                        GL_ALPHA, GL_UNSIGNED_BYTE,
+                                        blank.get());
+}
+
+/**
+ * Find room for a bitmap of the given size.
+ *
+ * @return false if the atlas is full
+ */
+static bool
+Allocate(unsigned width, unsigned height, unsigned &x, unsigned &y) noexcept
+{
+  if (width > ATLAS_SIZE || height > ATLAS_SIZE)
+    return false;
+
+  if (cursor_x + width > ATLAS_SIZE) {
+    /* start a new row */
+    cursor_x = 0;
+    cursor_y += row_height;
+    row_height = 0;
+  }
+
+  if (cursor_y + height > ATLAS_SIZE)
+    return false;
+
+  x = cursor_x;
+  y = cursor_y;
+
+  cursor_x += width + GLYPH_SPACING;
+  row_height = std::max(row_height, height + GLYPH_SPACING);
+  return true;
+}
+
+/**
+ * Look up a glyph, and rasterize it into the atlas if it's not there
+ * yet.
+ *
+ * @return nullptr if the atlas is full
+ */
+static const Glyph *
+LookupGlyph(const Font &font, unsigned ch) noexcept
+{
+  const GlyphKey key{&font, ch};
+  if (auto i = glyphs.find(key); i != glyphs.end())
+    return &i->second;
+
+  Glyph glyph{};
+  glyph.index = font.GetGlyphIndex(ch);
+
+  std::unique_ptr<uint8_t[]> bitmap;
+  if (glyph.index != 0 &&
+      !font.RasterizeGlyph(glyph.index, glyph.metrics, bitmap))
+    glyph.index = 0;
+
+  if (bitmap) {
+    if (!Allocate(glyph.metrics.width, glyph.metrics.height,
+                  glyph.x, glyph.y))
+      return nullptr;
+
+    texture->Bind();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, glyph.x, glyph.y,
+                    glyph.metrics.width, glyph.metrics.height,
+                    GL_ALPHA, GL_UNSIGNED_BYTE, bitmap.get());
+  } else {
+    /* nothing to draw (e.g. a space) */
+    glyph.metrics.width = glyph.metrics.height = 0;
+  }
+
+  return &glyphs.emplace(key, glyph).first->second;
+}
+
+/**
+ * Append a quad for a glyph, clipped to the given rectangle.
+ */
+static void
+AddQuad(PixelRect dest, unsigned src_x, unsigned src_y,
+        const PixelRect &clip) noexcept
+{
+  PixelRect clipped = dest;
+  clipped.left = std::max(clipped.left, clip.left);
+  clipped.top = std::max(clipped.top, clip.top);
+  clipped.right = std::min(clipped.right, clip.right);
+  clipped.bottom = std::min(clipped.bottom, clip.bottom);
+  if (clipped.left >= clipped.right || clipped.top >= clipped.bottom)
+    return;
+
+  const GLfloat x0 = GLfloat(int(src_x) + clipped.left - dest.left) / ATLAS_SIZE;
+  const GLfloat y0 = GLfloat(int(src_y) + clipped.top - dest.top) / ATLAS_SIZE;
+  const GLfloat x1 = GLfloat(int(src_x) + clipped.right - dest.left) / ATLAS_SIZE;
+  const GLfloat y1 = GLfloat(int(src_y) + clipped.bottom - dest.top) / ATLAS_SIZE;
+
+  /* two triangles */
+  const BulkPixelPoint top_left = clipped.GetTopLeft();
+  const BulkPixelPoint top_right = clipped.GetTopRight();
+  const BulkPixelPoint bottom_left = clipped.GetBottomLeft();
+  const BulkPixelPoint bottom_right = clipped.GetBottomRight();
+
+  vertices.insert(vertices.end(), {
+      top_left, top_right, bottom_left,
+      top_right, bottom_right, bottom_left,
+    });
+
+  coords.insert(coords.end(), {
+      x0, y0, x1, y0, x0, y1,
+      x1, y0, x1, y1, x0, y1,
+    });
+}
+
+/**
+ * Generate the quads of all glyphs into #vertices and #coords.
+ *
+ * @return false if the atlas is full
+ */
+static bool
+Layout(const Font &font, std::string_view text, PixelPoint p,
+       const PixelRect &clip) noexcept
+{
+  vertices.clear();
+  coords.clear();
+
+  int x = p.x;
+  unsigned previous = 0;
+
+  for (const char *s = text.data(), *end = s + text.size(); s < end;) {
+    const auto [ch, next] = NextUTF8(s);
+    if (next == nullptr)
+      break;
+    s = next;
+
+    const Glyph *glyph = LookupGlyph(font, ch);
+    if (glyph == nullptr)
+      return false;
+
+    if (glyph->index == 0)
+      continue;
+
+    x += font.GetKerning(previous, glyph->index);
+    previous = glyph->index;
+
+    const auto &metrics = glyph->metrics;
+    if (metrics.width > 0)
+      AddQuad(PixelRect{PixelPoint{x + metrics.left, p.y + metrics.top},
+                        PixelSize{metrics.width, metrics.height}},
+              glyph->x, glyph->y, clip);
+
+    x += metrics.advance;
+  }
+
+  return true;
+}
+
+bool
+Draw(const Font &font, std::string_view text, PixelPoint p,
+     const PixelRect &clip) noexcept
+{
+  assert(pthread_equal(pthread_self(), OpenGL::thread));
+  assert(font.IsDefined());
+
+  if (texture == nullptr)
+    CreateTexture();
+
+  if (!Layout(font, text, p, clip)) {
+    /* the atlas is full: start over; the next strings will fill
+       it with the glyphs which are currently being used */
+    Clear();
+    return false;
+  }
+
+  if (vertices.empty())
+    return true;
+
+  texture->Bind();
+
+  const ScopeVertexPointer vp(vertices.data());
+
+  glEnableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+  glVertexAttribPointer(OpenGL::Attribute::TEXCOORD, 2, GL_FLOAT, GL_FALSE,
+                        0, coords.data());
+
+  glDrawArrays(GL_TRIANGLES, 0, vertices.size());
+
+  glDisableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+  return true;
+}
+
+void
+Flush() noexcept
+{
+  Clear();
+  texture.reset();
+}
+
+} // namespace GlyphAtlas
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include "ui/dim/Rect.hpp"
+
+#include <string_view>
+
+class Font;
+
+/**
+ * Renders text from a texture which contains each glyph that has
+ * been used so far (rasterized only once, with FreeType).  A string
+ * is drawn as a batch of textured quads with one draw call, so texts
+ * with changing contents (e.g. altitudes and distances) don't need
+ * to be rasterized each time, unlike with #TextCache.
+ *
+ * This library may only be used from the OpenGL thread.
+ */
+namespace GlyphAtlas {
+
+/**
+ * Draw a string with the currently active alpha shader (the text
+ * color must be set already) and alpha blending.
+ *
+ * @param text the UTF-8 string
+ * @param p the top left corner of the text
+ * @param clip the text is clipped to this rectangle
+ * @return false if the glyphs do not fit into the atlas; the caller
+ * should then fall back to #TextCache
+ */
+bool
+Draw(const Font &font, std::string_view text, PixelPoint p,
+     const PixelRect &clip) noexcept;
+
+/**
+ * Discard all glyphs and the texture.
+ */
+void
+Flush() noexcept;
+
+} // namespace GlyphAtlas
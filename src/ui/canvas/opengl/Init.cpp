@@ -9,6 +9,9 @@
 #include "Dynamic.hpp"
 #include "FBO.hpp"
 #include "ui/canvas/custom/Cache.hpp"
+#ifdef USE_FREETYPE
+#include "GlyphAtlas.hpp"
+#endif
 #include "ui/opengl/Features.hpp"
 #include "Math/Point2D.hpp"
 #include "Asset.hpp"
@@ -240,4 +243,7 @@ OpenGL::Deinitialise() noexcept
   DeinitShaders();
 
   TextCache::Flush();
+#ifdef USE_FREETYPE
+  GlyphAtlas::Flush();
+#endif
 }
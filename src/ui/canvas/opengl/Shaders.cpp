@@ -42,6 +42,12 @@ GLint filled_circle_projection, filled_circle_translate,
   filled_circle_center, filled_circle_radius1, filled_circle_radius2,
   filled_circle_color1, filled_circle_color2;
 
+GLProgram *terrain_shader;
+GLint terrain_projection, terrain_translate,
+  terrain_heights, terrain_colors, terrain_texel, terrain_max_coord,
+  terrain_sample_step, terrain_light, terrain_contrast, terrain_slope_factor,
+  terrain_height_divisor, terrain_contour_divisor, terrain_shading;
+
 } // namespace OpenGL
 
 #define GLSL_VERSION "#version 100\n"
@@ -240,6 +246,102 @@ static constexpr char filled_circle_fragment_shader[] =
     }
 )glsl";
 
+static const char *const terrain_vertex_shader = texture_vertex_shader;
+
+/* this is the formula of RasterRenderer::GenerateSlopeImage();
+   "mediump" cannot represent 16 bit heights, and without "highp",
+   compiling fails and RasterRenderer falls back to the CPU */
+static constexpr char terrain_fragment_shader[] =
+  GLSL_VERSION
+  R"glsl(
+    #ifndef GL_FRAGMENT_PRECISION_HIGH
+    #error No highp support
+    #endif
+    precision highp float;
+    uniform sampler2D heights;
+    uniform sampler2D colors;
+    uniform vec2 texel;
+    uniform vec2 max_coord;
+    uniform float sample_step;
+    uniform vec3 light;
+    uniform float contrast;
+    uniform float slope_factor;
+    uniform float height_divisor;
+    uniform float contour_divisor;
+    uniform bool shading;
+    varying vec2 texcoordvar;
+
+    float Height(vec2 p) {
+      vec2 la = floor(texture2D(heights, clamp(p, texel * 0.5, max_coord)).ra
+                      * 255.0 + 0.5);
+      float h = la.x + la.y * 256.0;
+      return h >= 32768.0 ? h - 65536.0 : h;
+    }
+
+    bool IsSpecial(float h) {
+      return h <= -30000.0;
+    }
+
+    float ContourInterval(float h) {
+      return h <= 0.0 ? 0.0 : min(254.0, floor(h / contour_divisor));
+    }
+
+    float Trunc(float x) {
+      return x < 0.0 ? ceil(x) : floor(x);
+    }
+
+    vec4 Color(float index, float illumination) {
+      vec3 c = texture2D(colors, vec2((index + 0.5) / 256.0,
+                                      (illumination + 64.5) / 128.0)).rgb;
+      return vec4(c, 1.0);
+    }
+
+    void main() {
+      vec2 p = (floor(texcoordvar / texel) + 0.5) * texel;
+      float h = Height(p);
+      if (IsSpecial(h)) {
+        if (h == -32768.0)
+          /* outside the terrain file bounds: white background */
+          gl_FragColor = vec4(1.0);
+        else
+          gl_FragColor = Color(255.0, 0.0);
+        return;
+      }
+
+      float index = min(254.0, floor(max(h, 0.0) / height_divisor));
+
+      vec2 dx = vec2(texel.x * sample_step, 0.0);
+      vec2 dy = vec2(0.0, texel.y * sample_step);
+      float above = Height(p - dy), below = Height(p + dy);
+      float left = Height(p - dx), right = Height(p + dx);
+      if (shading && (IsSpecial(above) || IsSpecial(below) ||
+                      IsSpecial(left) || IsSpecial(right))) {
+        gl_FragColor = Color(index, 0.0);
+        return;
+      }
+
+      float contour = ContourInterval(h);
+      if (contour != ContourInterval(Height(p - vec2(texel.x, 0.0))) ||
+          contour != ContourInterval(Height(p - vec2(0.0, texel.y)))) {
+        gl_FragColor = Color(index, -64.0);
+        return;
+      }
+
+      if (!shading) {
+        gl_FragColor = Color(index, 0.0);
+        return;
+      }
+
+      float d = 2.0 * sample_step;
+      vec3 n = vec3(clamp(right - left, -512.0, 512.0) * d,
+                    clamp(above - below, -512.0, 512.0) * d,
+                    d * d * slope_factor);
+      float sval = Trunc(dot(n, light) / length(n));
+      float sindex = Trunc((sval - light.z) * contrast);
+      gl_FragColor = Color(index, clamp(sindex, -63.0, 63.0));
+    }
+)glsl";
+
 static void
 CompileAttachShader(GLProgram &program, GLenum type, const char *code)
 {
@@ -383,11 +485,46 @@ OpenGL::InitShaders()
   filled_circle_radius2 = filled_circle_shader->GetUniformLocation("radius2");
   filled_circle_color1 = filled_circle_shader->GetUniformLocation("color1");
   filled_circle_color2 = filled_circle_shader->GetUniformLocation("color2");
+
+  try {
+    terrain_shader = CompileProgram(terrain_vertex_shader,
+                                    terrain_fragment_shader);
+    terrain_shader->BindAttribLocation(Attribute::POSITION, "position");
+    terrain_shader->BindAttribLocation(Attribute::TEXCOORD, "texcoord");
+    LinkProgram(*terrain_shader);
+  } catch (...) {
+    /* optional; RasterRenderer renders on the CPU instead */
+    delete terrain_shader;
+    terrain_shader = nullptr;
+    return;
+  }
+
+  terrain_projection = terrain_shader->GetUniformLocation("projection");
+  terrain_translate = terrain_shader->GetUniformLocation("translate");
+  terrain_heights = terrain_shader->GetUniformLocation("heights");
+  terrain_colors = terrain_shader->GetUniformLocation("colors");
+  terrain_texel = terrain_shader->GetUniformLocation("texel");
+  terrain_max_coord = terrain_shader->GetUniformLocation("max_coord");
+  terrain_sample_step = terrain_shader->GetUniformLocation("sample_step");
+  terrain_light = terrain_shader->GetUniformLocation("light");
+  terrain_contrast = terrain_shader->GetUniformLocation("contrast");
+  terrain_slope_factor = terrain_shader->GetUniformLocation("slope_factor");
+  terrain_height_divisor =
+    terrain_shader->GetUniformLocation("height_divisor");
+  terrain_contour_divisor =
+    terrain_shader->GetUniformLocation("contour_divisor");
+  terrain_shading = terrain_shader->GetUniformLocation("shading");
+
+  terrain_shader->Use();
+  glUniform1i(terrain_heights, 0);
+  glUniform1i(terrain_colors, 1);
 }
 
 void
 OpenGL::DeinitShaders() noexcept
 {
+  delete terrain_shader;
+  terrain_shader = nullptr;
   delete filled_circle_shader;
   filled_circle_shader = nullptr;
   delete circle_outline_shader;
@@ -441,6 +578,12 @@ OpenGL::UpdateShaderProjectionMatrix() noexcept
   filled_circle_shader->Use();
   glUniformMatrix4fv(filled_circle_projection, 1, GL_FALSE,
                      glm::value_ptr(projection_matrix));
+
+  if (terrain_shader != nullptr) {
+    terrain_shader->Use();
+    glUniformMatrix4fv(terrain_projection, 1, GL_FALSE,
+                       glm::value_ptr(projection_matrix));
+  }
 }
 
 void
@@ -471,4 +614,9 @@ OpenGL::UpdateShaderTranslate() noexcept
 
   filled_circle_shader->Use();
   glUniform2f(filled_circle_translate, t.x, t.y);
+
+  if (terrain_shader != nullptr) {
+    terrain_shader->Use();
+    glUniform2f(terrain_translate, t.x, t.y);
+  }
 }
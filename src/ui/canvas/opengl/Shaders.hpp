@@ -64,6 +64,21 @@ extern GLint filled_circle_projection, filled_circle_translate,
   filled_circle_center, filled_circle_radius1, filled_circle_radius2,
   filled_circle_color1, filled_circle_color2;
 
+/**
+ * A shader that renders terrain from a #HeightMatrix texture
+ * (GL_LUMINANCE_ALPHA, the two bytes of a little-endian 16 bit
+ * integer) with slope shading, contour lines and a colour table
+ * (RasterRenderer::PrepareColorTable()) in texture unit 1.
+ *
+ * This is nullptr if the GPU does not support it (e.g. no "highp"
+ * float in fragment shaders).
+ */
+extern GLProgram *terrain_shader;
+extern GLint terrain_projection, terrain_translate,
+  terrain_heights, terrain_colors, terrain_texel, terrain_max_coord,
+  terrain_sample_step, terrain_light, terrain_contrast, terrain_slope_factor,
+  terrain_height_divisor, terrain_contour_divisor, terrain_shading;
+
 /**
  * Throws on error.
  */
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <forward_list>
+#include <memory>
+#include <new>
+
+/**
+ * Carves memory sequentially out of large chunks, so objects which
+ * are allocated one after another are adjacent in memory.  Memory is
+ * never released individually; all chunks are freed when the arena
+ * is destructed.
+ *
+ * Allocation is not thread-safe.
+ */
+class Arena {
+  static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+  struct ChunkDeleter {
+    void operator()(std::byte *p) const noexcept {
+      ::operator delete(p);
+    }
+  };
+
+  std::forward_list<std::unique_ptr<std::byte, ChunkDeleter>> chunks;
+
+  std::byte *position = nullptr;
+  std::size_t available = 0;
+
+  std::size_t n_chunks = 0, total_bytes = 0;
+
+public:
+  Arena() noexcept = default;
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  void *Allocate(std::size_t size, std::size_t alignment) {
+    const std::size_t padding =
+      -reinterpret_cast<std::uintptr_t>(position) & (alignment - 1);
+
+    if (padding + size > available) {
+      if (size > CHUNK_SIZE / 4)
+        /* a large object gets its own chunk, so the remainder of
+           the current one is not wasted */
+        return AddChunk(size);
+
+      position = static_cast<std::byte *>(AddChunk(CHUNK_SIZE));
+      available = CHUNK_SIZE;
+      return Allocate(size, alignment);
+    }
+
+    std::byte *result = position + padding;
+    position = result + size;
+    available -= padding + size;
+    return result;
+  }
+
+  std::size_t GetChunkCount() const noexcept {
+    return n_chunks;
+  }
+
+  /**
+   * The number of bytes obtained from the heap.
+   */
+  std::size_t GetTotalBytes() const noexcept {
+    return total_bytes;
+  }
+
+private:
+  void *AddChunk(std::size_t size) {
+    static_assert(CHUNK_SIZE % __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0);
+
+    auto *p = static_cast<std::byte *>(::operator new(size));
+    chunks.emplace_front(p);
+    ++n_chunks;
+    total_bytes += size;
+    return p;
+  }
+};
+
+/**
+ * A standard allocator which obtains memory from a shared #Arena.
+ * Deallocation is a no-op.  Each copy (including rebound ones and the
+ * one which std::allocate_shared() stores in the control block) keeps
+ * the arena alive, so objects may outlive the container which has
+ * created them.
+ */
+template<typename T>
+class ArenaAllocator {
+  template<typename U>
+  friend class ArenaAllocator;
+
+  std::shared_ptr<Arena> arena;
+
+public:
+  using value_type = T;
+
+  explicit ArenaAllocator(std::shared_ptr<Arena> _arena) noexcept
+    :arena(std::move(_arena)) {}
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other) noexcept
+    :arena(other.arena) {}
+
+  T *allocate(std::size_t n) {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+    return static_cast<T *>(arena->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *, std::size_t) noexcept {}
+
+  template<typename U>
+  bool operator==(const ArenaAllocator<U> &other) const noexcept {
+    return arena == other.arena;
+  }
+};
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <span>
+
+/**
+ * A FIFO ring buffer for exactly one producer thread and one
+ * consumer thread which does not need a lock.  It copies trivial
+ * objects in and out, wrapping around at the end of the array.
+ *
+ * Write() may only be called by the producer; Read(), IsEmpty() and
+ * Clear() may only be called by the consumer.
+ */
+template<typename T, std::size_t N>
+class LockFreeFifoBuffer {
+  static_assert((N & (N - 1)) == 0, "size must be a power of two");
+
+  /**
+   * The total number of elements consumed; only written by the
+   * consumer.
+   */
+  alignas(64) std::atomic_size_t head{0};
+
+  /**
+   * The total number of elements produced; only written by the
+   * producer.
+   */
+  alignas(64) std::atomic_size_t tail{0};
+
+  T data[N];
+
+public:
+  static constexpr std::size_t capacity() noexcept {
+    return N;
+  }
+
+  /**
+   * Copy as much of the given data as fits into the buffer.
+   *
+   * @return the number of elements copied
+   */
+  std::size_t Write(std::span<const T> src) noexcept {
+    const std::size_t t = tail.load(std::memory_order_relaxed);
+    const std::size_t h = head.load(std::memory_order_acquire);
+
+    const std::size_t n = std::min(src.size(), N - (t - h));
+    const std::size_t offset = t & (N - 1);
+    const std::size_t first = std::min(n, N - offset);
+
+    std::copy_n(src.begin(), first, data + offset);
+    std::copy_n(src.begin() + first, n - first, data);
+
+    /* a sequentially consistent store, so the producer's following
+       check for a blocked consumer can't be reordered before it */
+    tail.store(t + n, std::memory_order_seq_cst);
+    return n;
+  }
+
+  [[gnu::pure]]
+  bool IsEmpty() const noexcept {
+    return tail.load(std::memory_order_seq_cst) ==
+      head.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Move data from the buffer to the given destination.
+   *
+   * @return the number of elements copied
+   */
+  std::size_t Read(std::span<T> dest) noexcept {
+    const std::size_t h = head.load(std::memory_order_relaxed);
+    const std::size_t t = tail.load(std::memory_order_acquire);
+
+    const std::size_t n = std::min(dest.size(), t - h);
+    const std::size_t offset = h & (N - 1);
+    const std::size_t first = std::min(n, N - offset);
+
+    std::copy_n(data + offset, first, dest.begin());
+    std::copy_n(data, n - first, dest.begin() + first);
+
+    head.store(h + n, std::memory_order_release);
+    return n;
+  }
+
+  /**
+   * Discard all data which is currently in the buffer.
+   */
+  void Clear() noexcept {
+    head.store(tail.load(std::memory_order_acquire),
+               std::memory_order_release);
+  }
+};
@@ -111,10 +111,21 @@ MD5::Append(uint8_t ch) noexcept
 void
 MD5::Append(const void *data, size_t length) noexcept
 {
-  const uint8_t *i = (const uint8_t *)data, *const end = i + length;
+  const uint8_t *p = (const uint8_t *)data;
 
-  while (i != end)
-    Append(*i++);
+  while (length > 0) {
+    /* copy as much as fits into the current block */
+    const std::size_t position = message_length % buff512bits.size();
+    const std::size_t n = std::min(length, buff512bits.size() - position);
+    std::copy_n(p, n, std::next(buff512bits.begin(), position));
+
+    message_length += n;
+    p += n;
+    length -= n;
+
+    if (position + n == buff512bits.size())
+      Process512();
+  }
 }
 
 /**
@@ -6,6 +6,7 @@
 #include <utility>
 #include <limits>
 #include <memory>
+#include <functional>
 
 #include <cassert>
 
@@ -273,6 +274,50 @@ protected:
 
 	using LeafAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Leaf>;
 
+	/**
+	 * Allocates Leaf objects one by one, except for those which were
+	 * moved into one contiguous "packed" array by Pack().  That array
+	 * is freed when its last Leaf has been deleted.
+	 */
+	struct LeafPool {
+		LeafAllocator allocator;
+
+		Leaf *packed = nullptr;
+		unsigned packed_capacity = 0, packed_live = 0;
+
+		template<typename U>
+		Leaf *New(U &&value) noexcept {
+			Leaf *leaf = allocator.allocate(1);
+			std::allocator_traits<LeafAllocator>::construct(allocator, leaf,
+									std::forward<U>(value));
+			return leaf;
+		}
+
+		[[gnu::pure]]
+		bool IsPacked(const Leaf *leaf) const noexcept {
+			return packed != nullptr &&
+				!std::less<const Leaf *>{}(leaf, packed) &&
+				std::less<const Leaf *>{}(leaf, packed + packed_capacity);
+		}
+
+		void Delete(Leaf *leaf) noexcept {
+			const bool is_packed = IsPacked(leaf);
+			std::allocator_traits<LeafAllocator>::destroy(allocator, leaf);
+
+			if (!is_packed) {
+				allocator.deallocate(leaf, 1);
+				return;
+			}
+
+			assert(packed_live > 0);
+			if (--packed_live == 0) {
+				allocator.deallocate(packed, packed_capacity);
+				packed = nullptr;
+				packed_capacity = 0;
+			}
+		}
+	};
+
 	struct LeafList {
 		/* a linked list of values, or nullptr if this is a splitted bucket */
 		Leaf *head = nullptr;
@@ -341,12 +386,11 @@ protected:
 		/**
 		 * Remove and free all Leaf objects in the list.
 		 */
-		void Clear(LeafAllocator &allocator) noexcept {
+		void Clear(LeafPool &pool) noexcept {
 			Leaf *leaf = head;
 			while (leaf != nullptr) {
 				Leaf *next = leaf->next;
-				std::allocator_traits<LeafAllocator>::destroy(allocator, leaf);
-				allocator.deallocate(leaf, 1);
+				pool.Delete(leaf);
 				leaf = next;
 			}
 
@@ -356,7 +400,7 @@ protected:
 
 		template<class P>
 		void EraseIf(const P &predicate,
-			     LeafAllocator &leaf_allocator) noexcept {
+			     LeafPool &leaf_pool) noexcept {
 			Leaf **p = &head;
 			while (true) {
 				Leaf *leaf = *p;
@@ -368,8 +412,7 @@ protected:
 					--size;
 
 					*p = leaf->next;
-					std::allocator_traits<LeafAllocator>::destroy(leaf_allocator, leaf);
-					leaf_allocator.deallocate(leaf, 1);
+					leaf_pool.Delete(leaf);
 				} else
 					p = &leaf->next;
 			}
@@ -496,17 +539,17 @@ protected:
 		 * Dispose all child buckets and values.
 		 */
 		void Clear(BucketAllocator &bucket_allocator,
-			   LeafAllocator &leaf_allocator) noexcept {
+			   LeafPool &leaf_pool) noexcept {
 			assert(children == nullptr || leaves.IsEmpty());
 
 			if (IsSplitted()) {
-				children->Clear(bucket_allocator, leaf_allocator);
+				children->Clear(bucket_allocator, leaf_pool);
 				std::allocator_traits<BucketAllocator>::destroy(bucket_allocator,
 										children);
 				bucket_allocator.deallocate(children, 1);
 				children = nullptr;
 			} else
-				leaves.Clear(leaf_allocator);
+				leaves.Clear(leaf_pool);
 		}
 
 		/**
@@ -574,19 +617,17 @@ protected:
 		}
 
 		void Erase(const Leaf *cleaf,
-			   LeafAllocator &leaf_allocator) noexcept {
-			Leaf *leaf = Remove(cleaf);
-			std::allocator_traits<LeafAllocator>::destroy(leaf_allocator, leaf);
-			leaf_allocator.deallocate(leaf, 1);
+			   LeafPool &leaf_pool) noexcept {
+			leaf_pool.Delete(Remove(cleaf));
 		}
 
 		template<class P>
 		void EraseIf(const P &predicate,
-			     LeafAllocator &leaf_allocator) noexcept {
-			leaves.EraseIf(predicate, leaf_allocator);
+			     LeafPool &leaf_pool) noexcept {
+			leaves.EraseIf(predicate, leaf_pool);
 
 			if (children != nullptr)
-				children->EraseIf(predicate, leaf_allocator);
+				children->EraseIf(predicate, leaf_pool);
 		}
 
 		/**
@@ -633,6 +674,35 @@ protected:
 			children->Optimise(bounds, bucket_allocator);
 		}
 
+		/**
+		 * Move all values of this bucket and its children into
+		 * consecutive Leaf objects starting at #dest, keeping the order
+		 * of each list.
+		 */
+		void Pack(Leaf *&dest, LeafPool &leaf_pool) noexcept {
+			if (IsSplitted()) {
+				children->Pack(dest, leaf_pool);
+				return;
+			}
+
+			Leaf **tail = &leaves.head;
+			for (Leaf *leaf = leaves.head; leaf != nullptr;) {
+				Leaf *next = leaf->next;
+
+				Leaf *moved = dest++;
+				std::allocator_traits<LeafAllocator>::construct(leaf_pool.allocator,
+										moved,
+										std::move(leaf->value));
+				leaf_pool.Delete(leaf);
+
+				*tail = moved;
+				tail = &moved->next;
+				leaf = next;
+			}
+
+			*tail = nullptr;
+		}
+
 		/**
 		 * Find the first Bucket in the tree that has at least one Leaf.
 		 */
@@ -771,16 +841,16 @@ protected:
 		}
 
 		void Clear(BucketAllocator &bucket_allocator,
-			   LeafAllocator &leaf_allocator) noexcept {
+			   LeafPool &leaf_pool) noexcept {
 			for (unsigned i = 0; i < N; ++i)
-				buckets[i].Clear(bucket_allocator, leaf_allocator);
+				buckets[i].Clear(bucket_allocator, leaf_pool);
 		}
 
 		template<class P>
 		void EraseIf(const P &predicate,
-			     LeafAllocator &leaf_allocator) noexcept {
+			     LeafPool &leaf_pool) noexcept {
 			for (unsigned i = 0; i < N; ++i)
-				buckets[i].EraseIf(predicate, leaf_allocator);
+				buckets[i].EraseIf(predicate, leaf_pool);
 		}
 
 		constexpr
@@ -817,6 +887,15 @@ protected:
 			buckets[3].Optimise(GetBottomRight(bounds, middle), bucket_allocator);
 		}
 
+		/**
+		 * Pack the four children in the order top-left, top-right,
+		 * bottom-left, bottom-right, i.e. along the Z-order curve.
+		 */
+		void Pack(Leaf *&dest, LeafPool &leaf_pool) noexcept {
+			for (unsigned i = 0; i < N; ++i)
+				buckets[i].Pack(dest, leaf_pool);
+		}
+
 		template<class P>
 		[[gnu::pure]]
 		std::pair<const_iterator, distance_type>
@@ -905,7 +984,7 @@ protected:
 		return const_cast<Leaf *>(leaf);
 	}
 
-	LeafAllocator leaf_allocator;
+	LeafPool leaf_pool;
 	BucketAllocator bucket_allocator;
 
 	Rectangle bounds;
@@ -1011,11 +1090,36 @@ public:
 			root.Optimise(bounds, bucket_allocator);
 	}
 
+	/**
+	 * Move all values into one contiguous array, ordered by bucket
+	 * depth-first (Z-order), so lookups in neighbouring buckets
+	 * traverse neighbouring memory.  This is best called after
+	 * Optimise(), once the tree has settled.  Values added later are
+	 * allocated one by one as usual.
+	 *
+	 * All references and iterators are invalidated.
+	 */
+	void Pack() noexcept {
+		const unsigned n = size();
+		if (n == 0)
+			return;
+
+		Leaf *const array = leaf_pool.allocator.allocate(n);
+		Leaf *dest = array;
+		root.Pack(dest, leaf_pool);
+		assert(dest == array + n);
+
+		/* the previous array has been freed by moving its last value */
+		assert(leaf_pool.packed == nullptr);
+		leaf_pool.packed = array;
+		leaf_pool.packed_capacity = leaf_pool.packed_live = n;
+	}
+
 	/**
 	 * Remove all values.
 	 */
 	void Clear() noexcept {
-		root.Clear(bucket_allocator, leaf_allocator);
+		root.Clear(bucket_allocator, leaf_pool);
 		bounds.Clear();
 	}
 
@@ -1024,16 +1128,14 @@ public:
 	 * bounds.
 	 *
 	 * @return a reference to the new value in the QuadTree; it remains
-	 * valid until the value is removed
+	 * valid until the value is removed or Pack() is called
 	 */
 	template<typename U>
 	const T &AddQuick(U &&value) noexcept {
 		assert(IsFlat());
 		assert(bounds.IsEmpty());
 
-		Leaf *leaf = leaf_allocator.allocate(1);
-		std::allocator_traits<LeafAllocator>::construct(leaf_allocator,
-								leaf, std::forward<U>(value));
+		Leaf *leaf = leaf_pool.New(std::forward<U>(value));
 
 		root.AddHere(leaf);
 
@@ -1045,15 +1147,13 @@ public:
 	 * bounds.
 	 *
 	 * @return a reference to the new value in the QuadTree; it remains
-	 * valid until the value is removed
+	 * valid until the value is removed or Pack() is called
 	 */
 	template<typename U>
 	const T &AddScan(U &&value) noexcept {
 		assert(IsFlat());
 
-		Leaf *leaf = leaf_allocator.allocate(1);
-		std::allocator_traits<LeafAllocator>::construct(leaf_allocator,
-								leaf, std::forward<U>(value));
+		Leaf *leaf = leaf_pool.New(std::forward<U>(value));
 
 		bounds.Scan(GetPosition(leaf->value));
 		root.AddHere(leaf);
@@ -1065,15 +1165,13 @@ public:
 	 * Add a new value to the tree.  It must fit inside the bounds.
 	 *
 	 * @return a reference to the new value in the QuadTree; it
-	 * remains valid until the value is removed
+	 * remains valid until the value is removed or Pack() is called
 	 */
 	template<typename U>
 	const T &AddDeep(U &&value) noexcept {
 		assert(IsWithinBounds(value));
 
-		Leaf *leaf = leaf_allocator.allocate(1);
-		std::allocator_traits<LeafAllocator>::construct(leaf_allocator,
-								leaf, std::forward<U>(value));
+		Leaf *leaf = leaf_pool.New(std::forward<U>(value));
 
 		Rectangle bounds = this->bounds;
 		root.Add(bounds, leaf, bucket_allocator);
@@ -1085,7 +1183,7 @@ public:
 	 * Add a new value.
 	 *
 	 * @return a reference to the new value in the QuadTree; it remains
-	 * valid until the value is removed
+	 * valid until the value is removed or Pack() is called
 	 */
 	template<typename U>
 	const T &Add(U &&value) noexcept {
@@ -1293,7 +1391,7 @@ public:
 		assert(it.leaf != nullptr);
 
 		Bucket *bucket = DeconstifyBucket(it.bucket);
-		bucket->Erase(it.leaf, leaf_allocator);
+		bucket->Erase(it.leaf, leaf_pool);
 
 		if (IsEmpty())
 			ClearBounds();
@@ -1304,7 +1402,7 @@ public:
 	 */
 	template<class P>
 	void EraseIf(const P &predicate) noexcept {
-		root.EraseIf(predicate, leaf_allocator);
+		root.EraseIf(predicate, leaf_pool);
 
 		if (IsEmpty())
 			ClearBounds();
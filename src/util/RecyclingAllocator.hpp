@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+/**
+ * Keeps the memory of released single objects in a free list, to be
+ * reused by the next allocation of the same size.  Unlike
+ * #SliceAllocator, this is meant for node based containers which
+ * also allocate arrays (e.g. the bucket array of
+ * std::unordered_map); these are passed through to the heap.
+ *
+ * Only the size of the first object released is recycled, which is
+ * the container node.  The memory is freed when the pool is
+ * destructed.
+ */
+class RecyclingPool {
+  struct FreeNode {
+    FreeNode *next;
+  };
+
+  FreeNode *head = nullptr;
+
+  std::size_t node_size = 0;
+
+public:
+  RecyclingPool() noexcept = default;
+
+  ~RecyclingPool() noexcept {
+    while (head != nullptr) {
+      FreeNode *node = head;
+      head = node->next;
+      ::operator delete(node);
+    }
+  }
+
+  RecyclingPool(const RecyclingPool &) = delete;
+  RecyclingPool &operator=(const RecyclingPool &) = delete;
+
+  void *Allocate(std::size_t size) {
+    if (size == node_size && head != nullptr) {
+      FreeNode *node = head;
+      head = node->next;
+      return node;
+    }
+
+    return ::operator new(size);
+  }
+
+  void Deallocate(void *p, std::size_t size) noexcept {
+    if (node_size == 0 && size >= sizeof(FreeNode))
+      node_size = size;
+
+    if (size != node_size) {
+      ::operator delete(p);
+      return;
+    }
+
+    FreeNode *node = static_cast<FreeNode *>(p);
+    node->next = head;
+    head = node;
+  }
+};
+
+/**
+ * A standard allocator which obtains single objects from a
+ * #RecyclingPool.  Copies (including rebound ones) share the pool;
+ * the pool must outlive the container.
+ */
+template<typename T>
+class RecyclingAllocator {
+  template<typename U>
+  friend class RecyclingAllocator;
+
+  RecyclingPool *pool;
+
+public:
+  using value_type = T;
+
+  explicit constexpr RecyclingAllocator(RecyclingPool &_pool) noexcept
+    :pool(&_pool) {}
+
+  template<typename U>
+  constexpr RecyclingAllocator(const RecyclingAllocator<U> &other) noexcept
+    :pool(other.pool) {}
+
+  T *allocate(std::size_t n) {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+    if (n != 1)
+      return std::allocator<T>().allocate(n);
+
+    return static_cast<T *>(pool->Allocate(sizeof(T)));
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    if (n != 1) {
+      std::allocator<T>().deallocate(p, n);
+      return;
+    }
+
+    pool->Deallocate(p, sizeof(T));
+  }
+
+  template<typename U>
+  constexpr bool operator==(const RecyclingAllocator<U> &other) const noexcept {
+    return pool == other.pool;
+  }
+};
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <atomic>
+
+/**
+ * Passes the latest version of an object from exactly one writer
+ * thread to exactly one reader thread without a lock.  There are
+ * three instances: the writer fills the "back" one, the reader uses
+ * the "front" one, and Publish() and Acquire() swap them with the
+ * "middle" one.  Neither side ever waits for the other; versions the
+ * reader doesn't pick up in time are skipped.
+ *
+ * GetBack() and Publish() may only be called by the writer;
+ * Acquire(), GetFront() and GetFrontVersion() may only be called by
+ * the reader.
+ */
+template<typename T>
+class TripleBuffer {
+  static constexpr unsigned INDEX_MASK = 0x3;
+
+  /**
+   * This flag is set in #middle by Publish() and cleared by
+   * Acquire().
+   */
+  static constexpr unsigned FRESH = 0x4;
+
+  struct Slot {
+    T value;
+
+    /**
+     * The version number assigned by Publish().
+     */
+    unsigned version = 0;
+  };
+
+  Slot slots[3];
+
+  /**
+   * The index of the middle slot, plus the #FRESH flag.
+   */
+  std::atomic_uint middle{1};
+
+  /**
+   * The index of the slot owned by the writer.
+   */
+  unsigned back = 0;
+
+  /**
+   * The index of the slot owned by the reader.
+   */
+  unsigned front = 2;
+
+  /**
+   * The version of the most recent Publish() call; only used by the
+   * writer.
+   */
+  unsigned last_version = 0;
+
+public:
+  /**
+   * Returns the instance to be filled by the writer.  It may contain
+   * an old version.
+   */
+  T &GetBack() noexcept {
+    return slots[back].value;
+  }
+
+  /**
+   * Make the back instance available to the reader.
+   */
+  void Publish() noexcept {
+    slots[back].version = ++last_version;
+    back = middle.exchange(back | FRESH, std::memory_order_acq_rel)
+      & INDEX_MASK;
+  }
+
+  /**
+   * Obtain the most recently published version.
+   *
+   * @return true if a new version is available from GetFront(),
+   * false if nothing was published since the last call
+   */
+  bool Acquire() noexcept {
+    if ((middle.load(std::memory_order_relaxed) & FRESH) == 0)
+      return false;
+
+    front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+    return true;
+  }
+
+  /**
+   * Returns the instance obtained by the last Acquire() call.  It
+   * stays valid until the next Acquire() call.
+   */
+  const T &GetFront() const noexcept {
+    return slots[front].value;
+  }
+
+  /**
+   * Returns the version number of GetFront(); 0 means nothing has
+   * been published yet.
+   */
+  unsigned GetFrontVersion() const noexcept {
+    return slots[front].version;
+  }
+};
@@ -51,6 +51,19 @@ zzip_file_close(ZZIP_FILE * fp)
     if (fp->method)
         inflateEnd(&fp->d_stream);      /* inflateEnd() can be called many times */
 
+#ifdef ZZIP_HAVE_PREAD
+    /* the cache is not thread-safe; nothing else in the ZZIP_DIR is
+       modified by a ZZIP_FILE */
+    (void)self;
+    if (fp->buf32k)
+        free(fp->buf32k);
+    free(fp);
+
+    if (! __atomic_sub_fetch(&dir->refcount, 1, __ATOMIC_ACQ_REL))
+        return zzip_dir_close(dir);
+    else
+        return 0;
+#else
     if (dir->cache.locked == NULL)
         dir->cache.locked = &self;
 
@@ -81,9 +94,11 @@ zzip_file_close(ZZIP_FILE * fp)
         return zzip_dir_close(dir);
     else
         return 0;
+#endif
 }
 
 
+#ifndef ZZIP_HAVE_PREAD
 static int
 zzip_file_saveoffset(ZZIP_FILE * fp)
 {
@@ -99,6 +114,18 @@ zzip_file_saveoffset(ZZIP_FILE * fp)
     }
     return 0;
 }
+#else
+/* read from the current position of this file without touching the
+   seek pointer of the shared dir->fd */
+static zzip_ssize_t
+zzip_file_read_fd(ZZIP_FILE * fp, void *buf, zzip_size_t len)
+{
+    zzip_ssize_t rv = pread(fp->dir->fd, buf, len, fp->offset);
+    if (rv > 0)
+        fp->offset += rv;
+    return rv;
+}
+#endif
 
 
 /* user-definition */
@@ -181,15 +208,17 @@ zzip_file_open(ZZIP_DIR * dir, zzip_char_t * name, int o_mode)
     auto int self;
     zzip_error_t err = 0;
     struct zzip_file *fp = 0;
-    struct zzip_dir_hdr *hdr = dir->hdr0;
+    struct zzip_dir_hdr *hdr;
     int (*filename_strcmp) (zzip_char_t *, zzip_char_t *);
     zzip_char_t* (*filename_basename)(zzip_char_t*);
 
+    if (! dir)
+        return NULL;
+
+    hdr = dir->hdr0;
     filename_strcmp = (o_mode & ZZIP_CASELESS) ? dirsep_strcasecmp : strcmp;
     filename_basename = (o_mode & ZZIP_CASELESS) ? dirsep_basename : strrchr_basename;
 
-    if (! dir)
-        return NULL;
     if (! dir->fd || dir->fd == -1)
         { /* dir->errcode = EBADF; */ return NULL; }
     if (! hdr)
@@ -198,6 +227,14 @@ zzip_file_open(ZZIP_DIR * dir, zzip_char_t * name, int o_mode)
     if (o_mode & ZZIP_NOPATHS)
         name = filename_basename(name);
 
+    if (! (o_mode & (ZZIP_CASELESS | ZZIP_NOPATHS)))
+    {
+        /* exact match: use the hash table instead of the loop below */
+        hdr = __zzip_dir_find(dir, name);
+        if (! hdr)
+            { /* dir->errcode = ENOENT; */ return NULL; }
+    }
+
     while (1)
     {
         register zzip_char_t *hdr_name = hdr->d_name;
@@ -219,6 +256,37 @@ zzip_file_open(ZZIP_DIR * dir, zzip_char_t * name, int o_mode)
                 { /*err = ZZIP_UNSUPP_COMPR; */ goto error; }
             }
 
+#ifdef ZZIP_HAVE_PREAD
+            (void)self;
+            if (! (fp = (ZZIP_FILE *) calloc(1, sizeof(*fp))))
+                { /* err =  ZZIP_OUTOFMEM; */ goto error; }
+
+            fp->dir = dir;
+            fp->io = dir->io;
+            __atomic_add_fetch(&dir->refcount, 1, __ATOMIC_RELAXED);
+
+            if (! (fp->buf32k = (char *) malloc(ZZIP_32K)))
+                { /* err = ZZIP_OUTOFMEM; */ goto error; }
+
+            fp->offset = hdr->d_off;
+
+            {
+                /* skip local header - should test tons of other info,
+                 * but trust that those are correct */
+                struct zzip_file_header *p = (void *) fp->buf32k;
+
+                if (zzip_file_read_fd(fp, (void *) p, sizeof(*p))
+                    < (zzip_ssize_t) sizeof(*p))
+                    { /* err = ZZIP_DIR_READ; */ goto error; }
+                if (! zzip_file_header_check_magic(p))   /* PK\3\4 */
+                    { /* err = ZZIP_CORRUPTED; */ goto error; }
+
+                fp->offset += zzip_file_header_sizeof_tail(p);
+                fp->dataoffset = fp->offset;
+                fp->usize = hdr->d_usize;
+                fp->csize = hdr->d_csize;
+            }
+#else
             if (dir->cache.locked == NULL)
                 dir->cache.locked = &self;
 
@@ -285,6 +353,7 @@ zzip_file_open(ZZIP_DIR * dir, zzip_char_t * name, int o_mode)
                 fp->usize = hdr->d_usize;
                 fp->csize = hdr->d_csize;
             }
+#endif
 
             err = zzip_inflate_init(fp, hdr);
             if (err)
@@ -394,6 +463,9 @@ zzip_file_read(ZZIP_FILE * fp, void *buf, zzip_size_t len)
     if (fp->restlen == 0)
         return 0;
 
+#ifdef ZZIP_HAVE_PREAD
+    (void)dir;
+#else
     /*
      * If this is other handle than previous, save current seek pointer
      * and read the file position of `this' handle.
@@ -406,6 +478,7 @@ zzip_file_read(ZZIP_FILE * fp, void *buf, zzip_size_t len)
         else
             { dir->currentfp = fp; }
     }
+#endif
 
     /* if more methods is to be supported, change this to `switch ()' */
     if (fp->method)             /* method != 0   == 8, inflate */
@@ -425,7 +498,11 @@ zzip_file_read(ZZIP_FILE * fp, void *buf, zzip_size_t len)
                 /*  zzip_size_t cl =
                  *      fp->crestlen > 128 ? 128 : fp->crestlen;
                  */
+#ifdef ZZIP_HAVE_PREAD
+                zzip_ssize_t i = zzip_file_read_fd(fp, fp->buf32k, cl);
+#else
                 zzip_ssize_t i = fp->io->fd.read(dir->fd, fp->buf32k, cl);
+#endif
 
                 if (i <= 0)
                 {
@@ -455,7 +532,11 @@ zzip_file_read(ZZIP_FILE * fp, void *buf, zzip_size_t len)
         return l - fp->d_stream.avail_out;
     } else
     {                           /* method == 0 -- unstore */
+#ifdef ZZIP_HAVE_PREAD
+        rv = zzip_file_read_fd(fp, buf, l);
+#else
         rv = fp->io->fd.read(dir->fd, buf, l);
+#endif
         if (rv > 0)
             { fp->restlen-= rv; }
 #ifdef ZZIP_DISABLED
@@ -508,10 +589,6 @@ zzip_pread_fallback(ZZIP_FILE *file, void *ptr, zzip_size_t size,
     return zzip_read(file, ptr, size);
 }
 
-#ifdef __linux__
-#define ZZIP_HAVE_PREAD
-#endif
-
 zzip_size_t
 zzip_pread(ZZIP_FILE *file, void *ptr, zzip_size_t size, zzip_off_t offset)
 {
@@ -990,6 +1067,9 @@ zzip_rewind(ZZIP_FILE * fp)
     }
 
     dir = fp->dir;
+#ifdef ZZIP_HAVE_PREAD
+    (void)dir;
+#else
     /*
      * If this is other handle than previous, save current seek pointer
      */
@@ -1004,6 +1084,7 @@ zzip_rewind(ZZIP_FILE * fp)
     /* seek to beginning of this file */
     if (fp->io->fd.seeks(dir->fd, fp->dataoffset, SEEK_SET) < 0)
         return -1;
+#endif
 
     /* reset the inflate init stuff */
     fp->restlen = fp->usize;
@@ -1100,6 +1181,9 @@ zzip_seek(ZZIP_FILE * fp, zzip_off_t offset, int whence)
         return cur_pos;
 
     dir = fp->dir;
+#ifdef ZZIP_HAVE_PREAD
+    (void)dir;
+#else
     /*
      * If this is other handle than previous, save current seek pointer
      * and read the file position of `this' handle.
@@ -1112,10 +1196,16 @@ zzip_seek(ZZIP_FILE * fp, zzip_off_t offset, int whence)
         else
             { dir->currentfp = fp; }
     }
+#endif
 
     if (fp->method == 0)
     {                           /* unstore, just lseek relatively */
+#ifdef ZZIP_HAVE_PREAD
+        fp->offset += read_size;
+        ofs = fp->offset;
+#else
         ofs = fp->io->fd.seeks(dir->fd, read_size, SEEK_CUR);
+#endif
         if (ofs > 0)
         {                       /* readjust from beginning of file */
             ofs -= fp->dataoffset;
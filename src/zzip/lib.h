@@ -21,6 +21,15 @@
 extern "C" {
 #endif
 
+/*
+ * XCSoar: with pread(), every => ZZIP_FILE keeps its own position in
+ * the archive and never moves the shared file descriptor, so several
+ * threads may read different entries of one ZZIP_DIR concurrently.
+ */
+#if defined(__linux__) && !defined(ZZIP_HAVE_PREAD)
+#define ZZIP_HAVE_PREAD
+#endif
+
 /*
  * this structure cannot be wildly enlarged... (see zzip-zip.c)
  */
@@ -55,6 +64,8 @@ struct zzip_dir
         char * volatile buf32k; 
     } cache;
     struct zzip_dir_hdr * hdr0;  /* zfi; */
+    struct zzip_dir_hdr ** hash; /* open addressing table of hdr0 by name */
+    unsigned hash_mask;          /* table size - 1 (a power of two) */
     struct zzip_dir_hdr * hdr;   /* zdp; directory pointer, for dirent stuff */
     struct zzip_file * currentfp; /* last fp used... */
     struct zzip_dirent dirent;
@@ -74,6 +85,10 @@ ZZIP_DIR*
 zzip_dir_fdopen_ext_io(int fd, zzip_error_t * errorcode_p,
                        zzip_strings_t* ext, const zzip_plugin_io_t io);
 
+/* look up an entry by its exact name, using the hash table */
+struct zzip_dir_hdr*
+__zzip_dir_find (ZZIP_DIR* dir, zzip_char_t* name);
+
 ZZIP_DIR* /*deprecated*/
 zzip_dir_alloc_ext_io (zzip_strings_t* ext, const zzip_plugin_io_t io);
 
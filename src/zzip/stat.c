@@ -52,6 +52,13 @@ zzip_dir_stat(ZZIP_DIR * dir, zzip_char_t * name, ZZIP_STAT * zs, int flags)
         if (n)
             name = n + 1;
     }
+    else if (! (flags & ZZIP_CASELESS))
+    {
+        /* exact match: use the hash table instead of the loop below */
+        hdr = __zzip_dir_find(dir, name);
+        if (! hdr)
+            return -1;
+    }
 
     while (1)
     {
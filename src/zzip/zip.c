@@ -605,6 +605,91 @@ __zzip_parse_root_directory(int fd,
 #  endif
 }
 
+/* ---------------------------- name lookup ------------------------------- */
+
+/* FNV-1a */
+static uint32_t
+__zzip_name_hash(zzip_char_t * name)
+{
+    uint32_t hash = 2166136261u;
+    for (; *name; ++name)
+        hash = (hash ^ (unsigned char) *name) * 16777619u;
+    return hash;
+}
+
+/** internal.
+ * This function builds the name hash table after the central
+ * directory has been parsed, so that => zzip_file_open and
+ * => zzip_dir_stat do not need to scan all entries.  On allocation
+ * failure, dir->hash remains NULL and lookups fall back to a linear
+ * scan.  Duplicate names keep their first entry, which is the one the
+ * linear scan would have found.
+ */
+static void
+__zzip_dir_hash(ZZIP_DIR * dir)
+{
+    struct zzip_dir_hdr *hdr = dir->hdr0;
+    unsigned entries = 1, size = 2;
+
+    if (! hdr)
+        return;
+
+    while (hdr->d_reclen)
+    {
+        hdr = (struct zzip_dir_hdr *) ((char *) hdr + hdr->d_reclen);
+        entries++;
+    }
+
+    /* keep the load factor at or below 1/2 */
+    while (size < entries * 2)
+        size <<= 1;
+
+    dir->hash = (struct zzip_dir_hdr **) calloc(size, sizeof(*dir->hash));
+    if (! dir->hash)
+        return;
+    dir->hash_mask = size - 1;
+
+    for (hdr = dir->hdr0; ;
+         hdr = (struct zzip_dir_hdr *) ((char *) hdr + hdr->d_reclen))
+    {
+        unsigned i = __zzip_name_hash(hdr->d_name) & dir->hash_mask;
+        while (dir->hash[i] && strcmp(dir->hash[i]->d_name, hdr->d_name))
+            i = (i + 1) & dir->hash_mask;
+        if (! dir->hash[i])
+            dir->hash[i] = hdr;
+
+        if (! hdr->d_reclen)
+            break;
+    }
+}
+
+struct zzip_dir_hdr *
+__zzip_dir_find(ZZIP_DIR * dir, zzip_char_t * name)
+{
+    struct zzip_dir_hdr *hdr = dir->hdr0;
+
+    if (! hdr)
+        return NULL;
+
+    if (dir->hash)
+    {
+        unsigned i = __zzip_name_hash(name) & dir->hash_mask;
+        for (; dir->hash[i]; i = (i + 1) & dir->hash_mask)
+            if (! strcmp(dir->hash[i]->d_name, name))
+                return dir->hash[i];
+        return NULL;
+    }
+
+    while (strcmp(hdr->d_name, name))
+    {
+        if (! hdr->d_reclen)
+            return NULL;
+        hdr = (struct zzip_dir_hdr *) ((char *) hdr + hdr->d_reclen);
+    }
+
+    return hdr;
+}
+
 /* ------------------------- high-level interface ------------------------- */
 
 #ifndef O_BINARY
@@ -681,6 +766,8 @@ zzip_dir_free(ZZIP_DIR * dir)
         dir->io->fd.close(dir->fd);
     if (dir->hdr0)
         free(dir->hdr0);
+    if (dir->hash)
+        free(dir->hash);
     if (dir->cache.fp)
         free(dir->cache.fp);
     if (dir->cache.buf32k)
@@ -699,7 +786,13 @@ zzip_dir_free(ZZIP_DIR * dir)
 int
 zzip_dir_close(ZZIP_DIR * dir)
 {
+#ifdef ZZIP_HAVE_PREAD
+    /* the last zzip_file_close() may run in another thread */
+    if (__atomic_and_fetch(&dir->refcount, ~0x10000000L, __ATOMIC_ACQ_REL))
+        return 1;               /* still open files attached */
+#else
     dir->refcount &= ~0x10000000;       /* explicit dir close */
+#endif
     return zzip_dir_free(dir);
 }
 
@@ -780,6 +873,8 @@ __zzip_dir_parse(ZZIP_DIR * dir)
     if ((rv = __zzip_parse_root_directory(dir->fd, &trailer, &dir->hdr0,
                                           dir->io, filesize)) != 0)
         { goto error; }
+
+    __zzip_dir_hash(dir);
   error:
     return rv;
 }
@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Analyses many IGC files in parallel (one file per CPU core) and
+ * prints flight phases, performance, contest and task statistics of
+ * all flights as one JSON array, for comparing flights of a
+ * competition day.
+ */
+
+#include "FlightAnalysis.hpp"
+#include "DebugReplayIGC.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Task/LoadFile.hpp"
+#include "NMEA/Aircraft.hpp"
+#include "Navigation/Aircraft.hpp"
+#include "Formatter/TimeFormatter.hpp"
+#include "io/StdioOutputStream.hxx"
+#include "json/Serialize.hxx"
+#include "thread/ThreadPool.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "time/BrokenDateTime.hpp"
+#include "util/Exception.hxx"
+#include "util/NumberParser.hpp"
+#include "util/StringCompare.hxx"
+#include "util/PrintException.hxx"
+
+#include <boost/json.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+struct BatchOptions {
+  FlightAnalysisOptions analysis;
+
+  /**
+   * The task all flights are checked against (optional).  It is
+   * shared by all workers and never modified; each flight flies its
+   * own clone.
+   */
+  std::unique_ptr<const OrderedTask> task;
+};
+
+/**
+ * Flies the (shared) task with the fixes of one flight.
+ */
+class TaskAnalysis {
+  const Waypoints waypoints;
+  TaskManager task_manager;
+
+  AircraftState last_state;
+  bool have_last_state = false;
+
+  BrokenDateTime start_time = BrokenDateTime::Invalid();
+
+public:
+  TaskAnalysis(const TaskBehaviour &task_behaviour,
+               const OrderedTask &task) noexcept
+    :task_manager(task_behaviour, waypoints)
+  {
+    task_manager.SetGlidePolar(GlidePolar(1));
+    task_manager.Commit(task);
+  }
+
+  void Update(const DebugReplay &replay) noexcept {
+    const MoreData &basic = replay.Basic();
+    const AircraftState state = ToAircraftState(basic, replay.Calculated());
+
+    task_manager.Update(state, have_last_state ? last_state : state);
+    task_manager.UpdateIdle(state);
+
+    last_state = state;
+    have_last_state = true;
+
+    if (!start_time.IsPlausible() &&
+        task_manager.GetStats().start.HasStarted() &&
+        basic.time_available && basic.date_time_utc.IsPlausible())
+      start_time = basic.date_time_utc;
+  }
+
+  boost::json::object ToJSON() const noexcept {
+    const TaskStats &stats = task_manager.GetStats();
+
+    boost::json::object o;
+    o.emplace("valid", stats.task_valid);
+    o.emplace("finished", stats.task_finished);
+
+    if (stats.start.HasStarted()) {
+      if (start_time.IsPlausible()) {
+        char buffer[64];
+        FormatISO8601(buffer, start_time);
+        o.emplace("start", buffer);
+      }
+
+      o.emplace("distance", stats.distance_scored);
+      o.emplace("duration", stats.total.time_elapsed.count());
+      o.emplace("speed", stats.total.travelled.GetSpeed());
+    }
+
+    return o;
+  }
+};
+
+/**
+ * Analyse one flight.  Everything the computation modifies is owned
+ * by this function, so several flights can be analysed in parallel.
+ *
+ * Throws on error.
+ */
+static boost::json::object
+AnalyseFile(Path path, const BatchOptions &options,
+            const TaskBehaviour &task_behaviour)
+{
+  const std::unique_ptr<DebugReplay> replay(DebugReplayIGC::Create(path));
+
+  std::unique_ptr<TaskAnalysis> task;
+  if (options.task)
+    task = std::make_unique<TaskAnalysis>(task_behaviour, *options.task);
+
+  unsigned n_fixes = 0;
+  auto o = AnalyseFlight(*replay, options.analysis,
+                         [&task, &n_fixes](const DebugReplay &r){
+                           ++n_fixes;
+                           if (task)
+                             task->Update(r);
+                         });
+
+  o.emplace("fixes", n_fixes);
+
+  if (task)
+    o.emplace("task", task->ToJSON());
+
+  return o;
+}
+
+static unsigned
+ParsePoints(Args &args, const char *value)
+{
+  char *endptr;
+  unsigned points = ParseUnsigned(value, &endptr);
+  if (endptr == value || *endptr != 0 || points == 0) {
+    fputs("The points parameter could not be parsed correctly.\n", stderr);
+    args.UsageError();
+  }
+
+  return points;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[options] FILE.igc ...\n"
+            "Options:\n"
+            "  --jobs=N                 Number of flights analysed in parallel (default = number of CPUs)\n"
+            "  --task=FILE              Task file to check the flights against\n"
+            "  --full-points=512        Maximum number of full trace points (default = 512)\n"
+            "  --triangle-points=1024   Maximum number of triangle trace points (default = 1024)\n"
+            "  --sprint-points=64       Maximum number of sprint trace points (default = 64)");
+
+  BatchOptions options;
+  Path task_path = nullptr;
+  unsigned n_jobs = 0;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--jobs=")) != nullptr) {
+      char *endptr;
+      n_jobs = ParseUnsigned(value, &endptr);
+      if (endptr == value || *endptr != 0 || n_jobs == 0) {
+        fputs("The jobs parameter could not be parsed correctly.\n", stderr);
+        args.UsageError();
+      }
+    } else if ((value = StringAfterPrefix(arg, "--task=")) != nullptr) {
+      task_path = Path(value);
+    } else if ((value = StringAfterPrefix(arg, "--full-points=")) != nullptr) {
+      options.analysis.full_max_points = ParsePoints(args, value);
+    } else if ((value = StringAfterPrefix(arg, "--triangle-points=")) != nullptr) {
+      options.analysis.triangle_max_points = ParsePoints(args, value);
+    } else if ((value = StringAfterPrefix(arg, "--sprint-points=")) != nullptr) {
+      options.analysis.sprint_max_points = ParsePoints(args, value);
+    } else {
+      args.UsageError();
+    }
+  }
+
+  std::vector<Path> paths;
+  do {
+    paths.push_back(args.ExpectNextPath());
+  } while (!args.IsEmpty());
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  /* parse the task only once, not once per flight */
+  if (task_path != nullptr) {
+    options.task = LoadTask(task_path, task_behaviour);
+    if (!options.task) {
+      fprintf(stderr, "Failed to load task %s\n", task_path.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  /* the calling thread is a worker, too */
+  ThreadPool pool("AnalyseFlights",
+                  n_jobs > 0
+                  ? n_jobs - 1
+                  : ThreadPool::GetDefaultWorkers(paths.size()));
+
+  std::vector<boost::json::object> results(paths.size());
+  pool.ForEach(paths.size(),
+               [&paths, &options, &task_behaviour, &results](std::size_t i){
+    auto &o = results[i];
+
+    try {
+      o = AnalyseFile(paths[i], options, task_behaviour);
+    } catch (...) {
+      o.clear();
+      o.emplace("error", GetFullMessage(std::current_exception()));
+    }
+
+    o.emplace("file", paths[i].c_str());
+  });
+
+  boost::json::array root;
+  for (auto &i : results)
+    root.emplace_back(std::move(i));
+
+  StdioOutputStream os(stdout);
+  Json::Serialize(os, root);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Loads an airspace file and replays a flight (NMEA or IGC) through
+ * the airspace queries and the warning manager.  For each stage
+ * (Airspaces::QueryInside(), Airspaces::VisitIntersecting(),
+ * Airspaces::SynchroniseInRange() and AirspaceWarningManager::Update()),
+ * it reports the latency percentiles per fix and the number of heap
+ * allocations per fix.
+ */
+
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceIntersectionVisitor.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Engine/Airspace/AirspaceWarningConfig.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/Task/Stats/TaskStats.hpp"
+#include "NMEA/Aircraft.hpp"
+#include "Geo/GeoVector.hpp"
+#include "Operation/Operation.hpp"
+#include "io/FileLineReader.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+#include "DebugReplay.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <stdio.h>
+
+static std::atomic_size_t n_allocations;
+
+void *
+operator new(std::size_t size)
+{
+  ++n_allocations;
+
+  if (void *p = malloc(size))
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+  free(p);
+}
+
+using Clock = std::chrono::steady_clock;
+using Microseconds = std::chrono::duration<double, std::micro>;
+
+/**
+ * The search radius of SynchroniseInRange() [m].
+ */
+static constexpr double SYNCHRONISE_RANGE = 50000;
+
+/**
+ * How far ahead VisitIntersecting() looks.
+ */
+static constexpr std::chrono::seconds LOOK_AHEAD{300};
+
+class Stage {
+  const char *name;
+
+  struct Sample {
+    Microseconds duration;
+    std::size_t allocations;
+  };
+
+  std::vector<Sample> samples;
+
+public:
+  explicit Stage(const char *_name) noexcept:name(_name) {}
+
+  template<typename F>
+  void Measure(F &&f) {
+    const std::size_t allocations_start = n_allocations;
+    const auto start = Clock::now();
+    f();
+    const Microseconds duration = Clock::now() - start;
+    samples.push_back({duration, n_allocations - allocations_start});
+  }
+
+  void Print() const;
+};
+
+void
+Stage::Print() const
+{
+  if (samples.empty())
+    return;
+
+  std::vector<double> durations;
+  durations.reserve(samples.size());
+
+  std::size_t total_allocations = 0, max_allocations = 0;
+  for (const auto &i : samples) {
+    durations.push_back(i.duration.count());
+    total_allocations += i.allocations;
+    max_allocations = std::max(max_allocations, i.allocations);
+  }
+
+  std::sort(durations.begin(), durations.end());
+
+  const auto Percentile = [&durations](double p){
+    return durations[std::min(durations.size() - 1,
+                              std::size_t(p * durations.size()))];
+  };
+
+  printf("%-20s %9.1f %9.1f %9.1f %9.1f %9.1f %7zu\n",
+         name, Percentile(0.5), Percentile(0.9), Percentile(0.99),
+         durations.back(), double(total_allocations) / samples.size(),
+         max_allocations);
+}
+
+/**
+ * Counts the airspaces intersecting a line, like the warning
+ * manager's glide prediction does.
+ */
+class CountIntersectionVisitor final : public AirspaceIntersectionVisitor {
+public:
+  unsigned n = 0;
+
+  void Visit(ConstAirspacePtr) noexcept override {
+    ++n;
+  }
+};
+
+static void
+LoadAirspaces(Airspaces &airspaces, Path path)
+{
+  const auto start = Clock::now();
+
+  FileLineReader reader(path, Charset::AUTO);
+  NullOperationEnvironment operation;
+  ParseAirspaceFile(airspaces, reader, operation);
+  airspaces.Optimise();
+
+  const std::chrono::duration<double, std::milli> duration =
+    Clock::now() - start;
+  printf("loaded %u airspaces in %.1f ms\n\n",
+         airspaces.GetSize(), duration.count());
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "AIRSPACE DRIVER FILE");
+  const auto airspace_path = args.ExpectNextPath();
+  std::unique_ptr<DebugReplay> replay(CreateDebugReplay(args));
+  if (!replay)
+    return EXIT_FAILURE;
+
+  args.ExpectEnd();
+
+  Airspaces airspaces;
+  LoadAirspaces(airspaces, airspace_path);
+
+  Airspaces nearby;
+
+  AirspaceWarningConfig config;
+  config.SetDefaults();
+
+  AirspaceWarningManager warnings(config, airspaces);
+
+  const GlidePolar glide_polar(1);
+  const TaskStats task_stats{};
+
+  Stage query_inside("QueryInside"), visit_intersecting("VisitIntersecting"),
+    synchronise("SynchroniseInRange"), warning_update("WarningUpdate");
+
+  unsigned n_fixes = 0, n_inside = 0, n_intersecting = 0, max_warnings = 0;
+  TimeStamp last_time = TimeStamp::Undefined();
+
+  while (replay->Next()) {
+    const MoreData &basic = replay->Basic();
+    if (!basic.location_available || !basic.time_available)
+      continue;
+
+    const AircraftState state = ToAircraftState(basic, replay->Calculated());
+
+    if (!last_time.IsDefined()) {
+      warnings.Reset(state);
+      last_time = basic.time;
+      continue;
+    }
+
+    const auto dt =
+      std::chrono::duration_cast<std::chrono::duration<unsigned>>(basic.time - last_time);
+    if (dt.count() == 0)
+      continue;
+
+    last_time = basic.time;
+    ++n_fixes;
+
+    query_inside.Measure([&]{
+      for ([[maybe_unused]] const auto &i : airspaces.QueryInside(state))
+        ++n_inside;
+    });
+
+    visit_intersecting.Measure([&]{
+      const GeoPoint end =
+        GeoVector(state.ground_speed * LOOK_AHEAD.count(), state.track)
+        .EndPoint(state.location);
+
+      CountIntersectionVisitor visitor;
+      airspaces.VisitIntersecting(state.location, end, visitor);
+      n_intersecting += visitor.n;
+    });
+
+    synchronise.Measure([&]{
+      nearby.SynchroniseInRange(airspaces, state.location, SYNCHRONISE_RANGE,
+                                [](const AbstractAirspace &){ return true; });
+    });
+
+    warning_update.Measure([&]{
+      warnings.Update(state, glide_polar, task_stats,
+                      replay->Calculated().circling, dt);
+    });
+
+    max_warnings = std::max(max_warnings, unsigned(warnings.size()));
+  }
+
+  printf("%u fixes, %u inside, %u intersecting, up to %u warnings\n\n",
+         n_fixes, n_inside, n_intersecting, max_warnings);
+
+  printf("%-20s %9s %9s %9s %9s %9s %7s\n",
+         "stage", "p50[us]", "p90[us]", "p99[us]", "max[us]",
+         "allocs", "max");
+  query_inside.Print();
+  visit_intersecting.Print();
+  synchronise.Print();
+  warning_update.Print();
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Replays a set of flights (e.g. a short local flight, a 500 km and
+ * a 1000 km flight and a multi-day wave flight) through the solvers
+ * of every contest, the way the ContestComputer does: one
+ * incremental ContestManager::UpdateIdle() call per fix, and one
+ * exhaustive search after landing.  For each contest, it reports the
+ * time spent in both phases, the number of incremental iterations
+ * and the scores.  The gap is the difference between the online
+ * score and the exhaustive one.
+ */
+
+#include "Engine/Contest/ContestManager.hpp"
+#include "Engine/Contest/Solvers/Contests.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+#include "DebugReplay.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <stdio.h>
+
+using Clock = std::chrono::steady_clock;
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+struct ContestBenchmark {
+  ContestManager manager;
+
+  Milliseconds online_duration{}, exhaustive_duration{};
+
+  /**
+   * The number of UpdateIdle() calls, and how many of them changed
+   * the result.
+   */
+  unsigned n_iterations = 0, n_improvements = 0;
+
+  ContestStatistics online;
+
+  ContestBenchmark(Contest contest, const Trace &full,
+                   const Trace &triangle, const Trace &sprint) noexcept
+    :manager(contest, full, triangle, sprint) {}
+
+  void UpdateIdle() noexcept {
+    const auto start = Clock::now();
+    const bool modified = manager.UpdateIdle();
+    online_duration += Clock::now() - start;
+
+    ++n_iterations;
+    if (modified)
+      ++n_improvements;
+  }
+
+  void SolveExhaustive() noexcept {
+    online = manager.GetStats();
+
+    const auto start = Clock::now();
+    manager.SolveExhaustive();
+    exhaustive_duration = Clock::now() - start;
+  }
+
+  void Print(Contest contest) const;
+};
+
+void
+ContestBenchmark::Print(Contest contest) const
+{
+  printf("%-20s %10.1f %10.1f %7u %5u",
+         ContestToString(contest),
+         online_duration.count(), exhaustive_duration.count(),
+         n_iterations, n_improvements);
+
+  const ContestStatistics &stats = manager.GetStats();
+  for (unsigned i = 0; i < ContestStatistics::N; ++i) {
+    const double score = stats.GetResult(i).score;
+    if (score <= 0)
+      continue;
+
+    const double online_score = online.GetResult(i).score;
+    printf("  %8.2f %8.2f %5.1f%%", online_score, score,
+           100 * (score - online_score) / score);
+  }
+
+  putchar('\n');
+}
+
+/**
+ * Replay one flight through the solvers of all contests.
+ */
+static void
+BenchmarkFlight(DebugReplay &replay)
+{
+  /* the same trace sizes as in TraceComputer */
+  Trace full_trace(std::chrono::minutes{2}, Trace::null_time, 1024);
+  Trace triangle_trace({}, Trace::null_time, 256);
+  Trace sprint_trace({}, std::chrono::minutes{150}, 128);
+
+  std::vector<std::unique_ptr<ContestBenchmark>> benchmarks;
+  for (unsigned i = 0; i < unsigned(Contest::NONE); ++i)
+    benchmarks.emplace_back(std::make_unique<ContestBenchmark>(Contest(i),
+                                                               full_trace,
+                                                               triangle_trace,
+                                                               sprint_trace));
+
+  bool released = false;
+  unsigned n_fixes = 0;
+
+  const auto start = Clock::now();
+
+  while (replay.Next()) {
+    const MoreData &basic = replay.Basic();
+    if (!basic.time_available || !basic.location_available ||
+        !basic.NavAltitudeAvailable())
+      continue;
+
+    if (!released && replay.Calculated().flight.release_time.IsDefined()) {
+      released = true;
+
+      const auto release_time = replay.Calculated().flight.release_time;
+      full_trace.EraseEarlierThan(release_time);
+      triangle_trace.EraseEarlierThan(release_time);
+      sprint_trace.EraseEarlierThan(release_time);
+    }
+
+    const TracePoint point(basic);
+    full_trace.push_back(point);
+    triangle_trace.push_back(point);
+    sprint_trace.push_back(point);
+    ++n_fixes;
+
+    for (auto &i : benchmarks)
+      i->UpdateIdle();
+  }
+
+  for (auto &i : benchmarks)
+    i->SolveExhaustive();
+
+  const Milliseconds duration = Clock::now() - start;
+  printf("%u fixes, %.1f ms\n\n", n_fixes, duration.count());
+
+  printf("%-20s %10s %10s %7s %5s  %8s %8s %6s\n",
+         "contest", "online[ms]", "final[ms]", "iter", "impr",
+         "online", "final", "gap");
+
+  for (unsigned i = 0; i < benchmarks.size(); ++i)
+    benchmarks[i]->Print(Contest(i));
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE.igc ...");
+  if (args.IsEmpty())
+    args.UsageError();
+
+  do {
+    printf("%s\n", args.PeekNext());
+
+    std::unique_ptr<DebugReplay> replay(CreateDebugReplay(args));
+    if (!replay)
+      return EXIT_FAILURE;
+
+    BenchmarkFlight(*replay);
+    putchar('\n');
+  } while (!args.IsEmpty());
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,255 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Replays synthetic FLARM traffic through the traffic pipeline and
+ * reports the cost of each stage per frame (one second of PFLAU and
+ * PFLAA sentences): parsing, merging the devices (like
+ * DeviceBlackboard::Merge()), FlarmComputer::Process() and the
+ * per-frame work of MapWindow::DrawTraffic() without the actual
+ * drawing (collecting and merging).
+ *
+ * The first 40 targets of each scenario are FLARM targets, the rest
+ * are ADS-B targets.
+ */
+
+#include "Device/Parser.hpp"
+#include "NMEA/Info.hpp"
+#include "NMEA/Checksum.hpp"
+#include "FLARM/Computer.hpp"
+#include "Tracking/MergedTraffic.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+
+static std::atomic_size_t n_allocations;
+
+void *
+operator new(std::size_t size)
+{
+  ++n_allocations;
+
+  if (void *p = malloc(size))
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+  free(p);
+}
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr unsigned N_FRAMES = 256;
+static constexpr unsigned N_FLARM_TARGETS = 40;
+
+/**
+ * The FLARM is connected to the first device, a GPS to the second
+ * one.
+ */
+static constexpr unsigned N_DEVICES = 2;
+
+static const GeoPoint origin(Angle::Degrees(7.5), Angle::Degrees(51.5));
+
+static void
+AppendSentence(std::vector<std::string> &frame, char *buffer)
+{
+  AppendNMEAChecksum(buffer);
+  frame.emplace_back(buffer);
+}
+
+/**
+ * Generate the sentences of one second: the targets circle around
+ * the origin.
+ */
+static std::vector<std::string>
+GenerateFrame(unsigned n_targets, unsigned second)
+{
+  std::vector<std::string> frame;
+  frame.reserve(n_targets + 1);
+
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer), "$PFLAU,%u,1,2,1,0,,0,,",
+           std::min(n_targets, N_FLARM_TARGETS));
+  AppendSentence(frame, buffer);
+
+  for (unsigned i = 0; i < n_targets; ++i) {
+    const bool flarm = i < N_FLARM_TARGETS;
+    const double radius = flarm ? 500 + 60 * i : 2000 + 70 * i;
+    const Angle angle = Angle::Degrees(i * 37 + second * 3);
+    const auto [sin, cos] = angle.SinCos();
+
+    snprintf(buffer, sizeof(buffer),
+             "$PFLAA,0,%d,%d,%d,%u,%06X,%u,,%u,%.1f,%X,0,%u",
+             int(radius * cos), int(radius * sin), int(i % 20) * 20 - 200,
+             flarm ? 2 : 1, (flarm ? 0xDD0000 : 0x3C0000) + i,
+             unsigned(angle.Degrees() + 90) % 360, 25 + i % 10,
+             (int(i % 7) - 3) * 0.5, flarm ? 1 : 8, flarm ? 0 : 1);
+    AppendSentence(frame, buffer);
+  }
+
+  return frame;
+}
+
+static NMEAInfo
+MakeGPS(TimeStamp clock) noexcept
+{
+  NMEAInfo info;
+  info.Reset();
+  info.clock = clock;
+  info.alive.Update(clock);
+  info.time = clock;
+  info.time_available.Update(clock);
+  info.location = origin;
+  info.location_available.Update(clock);
+  info.gps_altitude = 1000;
+  info.gps_altitude_available.Update(clock);
+  info.track = Angle::Degrees(90);
+  info.track_available.Update(clock);
+  info.ground_speed = 30;
+  info.ground_speed_available.Update(clock);
+  return info;
+}
+
+/**
+ * Accumulates the duration and the allocations of one stage.
+ */
+struct Stage {
+  std::chrono::duration<double, std::micro> duration{};
+  std::size_t allocations = 0;
+
+  template<typename F>
+  void Measure(F &&f) noexcept {
+    const std::size_t allocations_start = n_allocations;
+    const auto start = Clock::now();
+    f();
+    duration += Clock::now() - start;
+    allocations += n_allocations - allocations_start;
+  }
+
+  double GetMicroseconds() const noexcept {
+    return duration.count() / N_FRAMES;
+  }
+
+  double GetAllocations() const noexcept {
+    return double(allocations) / N_FRAMES;
+  }
+};
+
+static void
+Benchmark(unsigned n_targets)
+{
+  /* generate all frames before measuring */
+  std::vector<std::vector<std::string>> frames;
+  frames.reserve(N_FRAMES);
+  for (unsigned i = 0; i < N_FRAMES; ++i)
+    frames.push_back(GenerateFrame(n_targets, i));
+
+  NMEAParser parser;
+  std::array<NMEAInfo, N_DEVICES> per_device;
+  for (auto &i : per_device)
+    i.Reset();
+
+  NMEAInfo basic, last_basic;
+  basic.Reset();
+  last_basic.Reset();
+
+  FlarmComputer computer;
+  MergedTrafficList list;
+
+  Stage parse, merge, compute, frame;
+
+  for (unsigned i = 0; i < N_FRAMES; ++i) {
+    const TimeStamp clock{std::chrono::seconds{100 + i}};
+
+    per_device[1] = MakeGPS(clock);
+
+    NMEAInfo &flarm_info = per_device[0];
+    flarm_info.clock = clock;
+    flarm_info.alive.Update(clock);
+
+    parse.Measure([&]{
+      for (const auto &sentence : frames[i])
+        parser.ParseLine(sentence.c_str(), flarm_info);
+    });
+
+    /* like DeviceBlackboard::Merge() */
+    merge.Measure([&]{
+      basic.Reset();
+      for (auto &device : per_device) {
+        device.Expire();
+        basic.Complement(device);
+      }
+    });
+
+    /* like BlackboardGlue and the calculation thread */
+    compute.Measure([&]{
+      computer.Process(basic.flarm, last_basic.flarm, basic);
+    });
+
+    /* the per-frame work of MapWindow::DrawTraffic() */
+    frame.Measure([&]{
+      list.Clear();
+      for (const auto &traffic : basic.flarm.traffic.list)
+        if (traffic.location_available)
+          list.Add(MergedTraffic::Source::FLARM, traffic.id,
+                   traffic.location, {});
+
+      for (const auto &traffic : basic.flarm.adsb_traffic.list)
+        if (traffic.location_available)
+          list.Add(MergedTraffic::Source::FLARM, traffic.id,
+                   traffic.location, {});
+
+      list.Finish(basic.location);
+    });
+
+    last_basic = basic;
+  }
+
+  printf("%6u %6u %6u %9.1f %7.1f %9.1f %7.1f %9.1f %7.1f %9.1f %7.1f\n",
+         n_targets,
+         basic.flarm.traffic.GetActiveTrafficCount(),
+         basic.flarm.adsb_traffic.GetActiveTrafficCount(),
+         parse.GetMicroseconds(), parse.GetAllocations(),
+         merge.GetMicroseconds(), merge.GetAllocations(),
+         compute.GetMicroseconds(), compute.GetAllocations(),
+         frame.GetMicroseconds(), frame.GetAllocations());
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "");
+  args.ExpectEnd();
+
+  printf("%6s %6s %6s %9s %7s %9s %7s %9s %7s %9s %7s\n",
+         "n", "flarm", "adsb",
+         "parse[us]", "allocs", "merge[us]", "allocs",
+         "comp[us]", "allocs", "frame[us]", "allocs");
+
+  for (unsigned n : {10, 50, 200})
+    Benchmark(n);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
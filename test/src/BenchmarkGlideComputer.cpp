@@ -0,0 +1,377 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Replays a fixed set of IGC/NMEA files through the complete
+ * #GlideComputer with default settings and reports the CPU time per
+ * fix spent in each subsystem as a histogram.  All calculations run
+ * once per fix (independent of the wall clock), so the work done is
+ * the same on every run and the numbers of different code versions
+ * (or devices) can be compared.
+ *
+ * The tasks of GlideComputer::ProcessIdle() run in one thread, unless
+ * "--parallel" is given (which disables the per-subsystem profiler).
+ * Either way, the critical path of the task graph is reported: the
+ * latency of ProcessIdle() on a machine with enough CPUs.
+ */
+
+#include "DebugReplayIGC.hpp"
+#include "DebugReplayNMEA.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Computer/ComputerProfiler.hpp"
+#include "Computer/Settings.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Task/LoadFile.hpp"
+#include "Operation/Operation.hpp"
+#include "io/FileLineReader.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "thread/TaskGraph.hpp"
+#include "util/NumberParser.hpp"
+#include "util/StringAPI.hxx"
+#include "util/StringCompare.hxx"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <memory>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std::chrono;
+
+/* fake symbols: */
+
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+
+void
+ConditionMonitors::Update([[maybe_unused]] const NMEAInfo &basic,
+                          [[maybe_unused]] const DerivedInfo &calculated,
+                          [[maybe_unused]] const ComputerSettings &settings) noexcept
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent([[maybe_unused]] const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent([[maybe_unused]] const NMEAInfo &gps_info) {}
+void Logger::LogPoint([[maybe_unused]] const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+using Subsystem = ComputerProfiler::Subsystem;
+
+/**
+ * The rows of the report: the subsystems of #ComputerProfiler, plus
+ * parsing the input ("replay"), the critical path of
+ * GlideComputer::ProcessIdle() ("idle_cp") and the sum of all
+ * ("total").
+ */
+static constexpr std::size_t STAGE_REPLAY = ComputerProfiler::N_SUBSYSTEMS;
+static constexpr std::size_t STAGE_IDLE_CRITICAL = STAGE_REPLAY + 1;
+static constexpr std::size_t STAGE_TOTAL = STAGE_IDLE_CRITICAL + 1;
+static constexpr std::size_t N_STAGES = STAGE_TOTAL + 1;
+
+static const char *
+GetStageName(std::size_t stage) noexcept
+{
+  switch (stage) {
+  case STAGE_REPLAY:
+    return "replay";
+
+  case STAGE_IDLE_CRITICAL:
+    return "idle_cp";
+
+  case STAGE_TOTAL:
+    return "total";
+
+  default:
+    return ComputerProfiler::GetName(Subsystem(stage));
+  }
+}
+
+/**
+ * The per-fix times of one stage.  The histogram has power-of-two
+ * buckets: bucket 0 counts times below 1 µs, bucket n times in
+ * [2^(n-1), 2^n) µs.
+ */
+class StageHistogram {
+  static constexpr std::size_t N_BUCKETS = 24;
+
+  std::vector<nanoseconds::rep> samples;
+  std::array<unsigned, N_BUCKETS> buckets{};
+
+public:
+  void Add(nanoseconds t) noexcept {
+    samples.push_back(t.count());
+
+    const auto us = uint64_t(t.count()) / 1000;
+    const std::size_t bucket = std::min<std::size_t>(std::bit_width(us),
+                                                     N_BUCKETS - 1);
+    ++buckets[bucket];
+  }
+
+  nanoseconds::rep GetSum() const noexcept {
+    nanoseconds::rep sum = 0;
+    for (const auto i : samples)
+      sum += i;
+    return sum;
+  }
+
+  /**
+   * Print one line of the report.  Sorts the samples.
+   */
+  void Print(const char *name, nanoseconds::rep grand_total) noexcept {
+    if (samples.empty())
+      return;
+
+    std::sort(samples.begin(), samples.end());
+
+    const auto sum = GetSum();
+    const auto Percentile = [this](unsigned p){
+      return double(samples[(samples.size() - 1) * p / 100]) / 1000;
+    };
+
+    printf("%-9s %8.2f %8.2f %8.2f %8.2f %9.2f %5.1f%% ",
+           name,
+           double(sum) / samples.size() / 1000,
+           Percentile(50), Percentile(90), Percentile(99),
+           double(samples.back()) / 1000,
+           grand_total > 0 ? 100. * sum / grand_total : 0.);
+
+    /* omit the trailing empty buckets */
+    std::size_t n = N_BUCKETS;
+    while (n > 1 && buckets[n - 1] == 0)
+      --n;
+
+    for (std::size_t i = 0; i < n; ++i)
+      printf(i == 0 ? "%u" : ",%u", buckets[i]);
+
+    putchar('\n');
+  }
+};
+
+struct BenchmarkOptions {
+  Path task_path = nullptr, airspace_path = nullptr;
+  unsigned iterations = 1;
+  bool parallel = false;
+};
+
+/**
+ * How often each task of GlideComputer::ProcessIdle() was on the
+ * critical path.
+ */
+struct CriticalPathStatistics {
+  /**
+   * The task names (string literals, which outlive the graph).
+   */
+  std::array<const char *, TaskGraph::MAX_TASKS> names;
+  std::size_t n_tasks = 0;
+
+  std::array<unsigned, TaskGraph::MAX_TASKS> counts{};
+  unsigned n_runs = 0;
+
+  void Add(const TaskGraph &graph) noexcept {
+    n_tasks = graph.size();
+    for (std::size_t i = 0; i < n_tasks; ++i)
+      names[i] = graph.GetName(i);
+
+    ++n_runs;
+    for (const unsigned i : graph.GetCriticalPath())
+      ++counts[i];
+  }
+
+  void Print() const noexcept {
+    if (n_runs == 0)
+      return;
+
+    fputs("idle critical path:", stdout);
+    for (std::size_t i = 0; i < n_tasks; ++i)
+      printf(" %s=%.1f%%", names[i], 100. * counts[i] / n_runs);
+    putchar('\n');
+  }
+};
+
+static DebugReplay *
+OpenReplay(Path path)
+{
+  if (StringEndsWithIgnoreCase(path.c_str(), ".igc"))
+    return DebugReplayIGC::Create(path);
+  else
+    return DebugReplayNMEA::Create(path, "nmea");
+}
+
+/**
+ * Replay one file through a fresh #GlideComputer.
+ *
+ * Throws on error.
+ *
+ * @return the number of fixes
+ */
+static unsigned
+ReplayFile(Path path, const BenchmarkOptions &options,
+           std::array<StageHistogram, N_STAGES> &histograms,
+           CriticalPathStatistics &critical_path)
+{
+  ComputerSettings settings;
+  settings.SetDefaults();
+  settings.polar.glide_polar_task = GlidePolar(1);
+
+  const Waypoints waypoints;
+
+  TaskManager task_manager(settings.task, waypoints);
+  task_manager.SetGlidePolar(settings.polar.glide_polar_task);
+
+  GlideComputerTaskEvents task_events;
+  task_manager.SetTaskEvents(task_events);
+
+  ProtectedTaskManager protected_task_manager(task_manager, settings.task);
+
+  if (options.task_path != nullptr) {
+    auto task = LoadTask(options.task_path, settings.task);
+    if (task)
+      protected_task_manager.TaskCommit(*task);
+  }
+
+  Airspaces airspaces;
+  if (options.airspace_path != nullptr) {
+    FileLineReader reader(options.airspace_path, Charset::AUTO);
+    NullOperationEnvironment operation;
+    ParseAirspaceFile(airspaces, reader, operation);
+    airspaces.Optimise();
+  }
+
+  GlideComputer glide_computer(settings, waypoints, airspaces,
+                               protected_task_manager, task_events);
+  glide_computer.SetContestIncremental(false);
+  glide_computer.Initialise();
+
+  ComputerProfiler profiler;
+  if (!options.parallel)
+    glide_computer.SetProfiler(&profiler);
+
+  const std::unique_ptr<DebugReplay> replay(OpenReplay(path));
+
+  unsigned n_fixes = 0;
+
+  while (true) {
+    /* parsing and BasicComputer/FlyingComputer, like the MergeThread
+       does in the real program */
+    const auto replay_start = steady_clock::now();
+    if (!replay->Next())
+      break;
+    const auto replay_time = steady_clock::now() - replay_start;
+
+    profiler.Reset();
+
+    const auto start = steady_clock::now();
+    glide_computer.ReadBlackboard(replay->Basic());
+    glide_computer.ProcessGPS();
+
+    /* always run the idle calculations, not only every 500ms (wall
+       clock) like the CalculationThread, to make the results
+       reproducible */
+    glide_computer.ProcessIdle();
+    const auto total_time = steady_clock::now() - start;
+
+    if (!options.parallel) {
+      const auto &totals = profiler.GetTotals();
+      for (std::size_t i = 0; i < totals.size(); ++i)
+        histograms[i].Add(duration_cast<nanoseconds>(totals[i]));
+    }
+
+    const TaskGraph &idle_graph = glide_computer.GetIdleGraph();
+    histograms[STAGE_IDLE_CRITICAL].Add(
+      duration_cast<nanoseconds>(idle_graph.GetCriticalLength()));
+    critical_path.Add(idle_graph);
+
+    histograms[STAGE_REPLAY].Add(duration_cast<nanoseconds>(replay_time));
+    histograms[STAGE_TOTAL].Add(duration_cast<nanoseconds>(replay_time +
+                                                           total_time));
+
+    ++n_fixes;
+  }
+
+  glide_computer.SetProfiler(nullptr);
+  return n_fixes;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[options] FILE ...\n"
+            "Files ending with .igc are IGC files, all others are NMEA logs.\n"
+            "Options:\n"
+            "  --iterations=N      Replay all files N times (default = 1)\n"
+            "  --parallel          Run the idle calculations on a thread pool\n"
+            "  --task=FILE         Task file to fly\n"
+            "  --airspace=FILE     Airspace file to check for warnings");
+
+  BenchmarkOptions options;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--iterations=")) != nullptr) {
+      char *endptr;
+      options.iterations = ParseUnsigned(value, &endptr);
+      if (endptr == value || *endptr != 0 || options.iterations == 0) {
+        fputs("The iterations parameter could not be parsed correctly.\n",
+              stderr);
+        args.UsageError();
+      }
+    } else if (StringIsEqual(arg, "--parallel")) {
+      options.parallel = true;
+    } else if ((value = StringAfterPrefix(arg, "--task=")) != nullptr) {
+      options.task_path = Path(value);
+    } else if ((value = StringAfterPrefix(arg, "--airspace=")) != nullptr) {
+      options.airspace_path = Path(value);
+    } else {
+      args.UsageError();
+    }
+  }
+
+  std::vector<Path> paths;
+  do {
+    paths.push_back(args.ExpectNextPath());
+  } while (!args.IsEmpty());
+
+  std::array<StageHistogram, N_STAGES> histograms;
+  CriticalPathStatistics critical_path;
+  unsigned n_fixes = 0;
+
+  for (unsigned i = 0; i < options.iterations; ++i)
+    for (const Path path : paths)
+      n_fixes += ReplayFile(path, options, histograms, critical_path);
+
+  printf("%zu files, %u iterations, %u fixes\n",
+         paths.size(), options.iterations, n_fixes);
+  printf("%-9s %8s %8s %8s %8s %9s %6s buckets (log2 us)\n",
+         "stage", "mean_us", "p50_us", "p90_us", "p99_us", "max_us",
+         "share");
+
+  const auto grand_total = histograms[STAGE_TOTAL].GetSum();
+  for (std::size_t i = 0; i < N_STAGES; ++i)
+    histograms[i].Print(GetStageName(i), grand_total);
+
+  critical_path.Print();
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
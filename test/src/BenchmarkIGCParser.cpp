@@ -0,0 +1,277 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Compares IGCParseFix() with the old field-by-field (sscanf) B
+ * record parser: both must return identical results for every
+ * record, and the time per record of each is reported.
+ *
+ * IGC files may be passed on the command line; without arguments,
+ * a synthetic flight with extensions is generated.
+ */
+
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCFix.hpp"
+#include "IGC/IGCExtensions.hpp"
+#include "io/FileLineReader.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringAPI.hxx"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr unsigned N_ITERATIONS = 16;
+
+static void
+ParseReferenceExtensionValue(const char *p, const char *end,
+                             int16_t &value_r) noexcept
+{
+  unsigned value = 0;
+  for (; p < end; ++p) {
+    if (*p < '0' || *p > '9')
+      return;
+
+    value = value * 10 + (*p - '0');
+  }
+
+  value_r = value;
+}
+
+/**
+ * Parse a B record field by field with sscanf(), like IGCParseFix()
+ * did before it got the SWAR fast path.
+ */
+static bool
+ReferenceParseFix(const char *buffer, const IGCExtensions &extensions,
+                  IGCFix &fix) noexcept
+{
+  if (*buffer != 'B')
+    return false;
+
+  BrokenTime time;
+  if (!IGCParseTime(buffer + 1, time))
+    return false;
+
+  char valid_char;
+  int gps_altitude, pressure_altitude;
+
+  if (sscanf(buffer + 24, "%c%05d%05d",
+             &valid_char, &pressure_altitude, &gps_altitude) != 3)
+    return false;
+
+  if (valid_char == 'A')
+    fix.gps_valid = true;
+  else if (valid_char == 'V')
+    fix.gps_valid = false;
+  else
+    return false;
+
+  fix.gps_altitude = gps_altitude;
+  fix.pressure_altitude = pressure_altitude;
+
+  if (!IGCParseLocation(buffer + 7, fix.location))
+    return false;
+
+  fix.time = time;
+
+  fix.ClearExtensions();
+
+  const size_t line_length = strlen(buffer);
+  for (const IGCExtension &extension : extensions) {
+    if (extension.finish > line_length)
+      continue;
+
+    const char *start = buffer + extension.start - 1;
+    const char *finish = buffer + extension.finish;
+
+    /* GSP, IAS and TAS are limited to 3 digits */
+    const bool three = StringIsEqual(extension.code, "GSP") ||
+      StringIsEqual(extension.code, "IAS") ||
+      StringIsEqual(extension.code, "TAS");
+    if (three) {
+      if (finish - start < 3)
+        continue;
+      finish = start + 3;
+    }
+
+    if (StringIsEqual(extension.code, "ENL"))
+      ParseReferenceExtensionValue(start, finish, fix.enl);
+    else if (StringIsEqual(extension.code, "RPM"))
+      ParseReferenceExtensionValue(start, finish, fix.rpm);
+    else if (StringIsEqual(extension.code, "HDM"))
+      ParseReferenceExtensionValue(start, finish, fix.hdm);
+    else if (StringIsEqual(extension.code, "HDT"))
+      ParseReferenceExtensionValue(start, finish, fix.hdt);
+    else if (StringIsEqual(extension.code, "TRM"))
+      ParseReferenceExtensionValue(start, finish, fix.trm);
+    else if (StringIsEqual(extension.code, "TRT"))
+      ParseReferenceExtensionValue(start, finish, fix.trt);
+    else if (StringIsEqual(extension.code, "GSP"))
+      ParseReferenceExtensionValue(start, finish, fix.gsp);
+    else if (StringIsEqual(extension.code, "IAS"))
+      ParseReferenceExtensionValue(start, finish, fix.ias);
+    else if (StringIsEqual(extension.code, "TAS"))
+      ParseReferenceExtensionValue(start, finish, fix.tas);
+    else if (StringIsEqual(extension.code, "SIU"))
+      ParseReferenceExtensionValue(start, finish, fix.siu);
+  }
+
+  return true;
+}
+
+struct Flight {
+  IGCExtensions extensions;
+  std::vector<std::string> records;
+};
+
+static Flight
+LoadFlight(Path path)
+{
+  Flight flight;
+  flight.extensions.clear();
+
+  FileLineReaderA reader(path);
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    if (*line == 'I')
+      IGCParseExtensions(line, flight.extensions);
+    else if (*line == 'B')
+      flight.records.emplace_back(line);
+  }
+
+  return flight;
+}
+
+static Flight
+GenerateFlight()
+{
+  Flight flight;
+  IGCParseExtensions("I063638FXA3941ENL4246GSP4749TRT5051SIU5254RPM",
+                     flight.extensions);
+
+  char line[128];
+  for (unsigned i = 0; i < 10 * 3600; ++i) {
+    snprintf(line, sizeof(line),
+             "B%02u%02u%02u%02u%05uN%03u%05uEA%05u%05u%03u%03u%05u%03u%02u%03u",
+             8 + i / 3600, i / 60 % 60, i % 60,
+             51, i * 7 % 60000, 7, i * 13 % 60000,
+             500 + i % 2000, 520 + i % 2000,
+             i % 50, i % 999, i % 25000, i % 360, i % 13, i % 999);
+    flight.records.emplace_back(line);
+  }
+
+  return flight;
+}
+
+static bool
+operator==(const IGCFix &a, const IGCFix &b) noexcept
+{
+  return a.time == b.time && a.location == b.location &&
+    a.gps_valid == b.gps_valid &&
+    a.gps_altitude == b.gps_altitude &&
+    a.pressure_altitude == b.pressure_altitude &&
+    a.enl == b.enl && a.rpm == b.rpm &&
+    a.hdm == b.hdm && a.hdt == b.hdt && a.trm == b.trm && a.trt == b.trt &&
+    a.gsp == b.gsp && a.ias == b.ias && a.tas == b.tas &&
+    a.siu == b.siu;
+}
+
+/**
+ * @return the number of mismatches
+ */
+static unsigned
+Compare(const Flight &flight) noexcept
+{
+  unsigned n_mismatches = 0;
+
+  for (const auto &record : flight.records) {
+    IGCFix a, b;
+    a.Clear();
+    b.Clear();
+
+    const bool ok_a = IGCParseFix(record.c_str(), flight.extensions, a);
+    const bool ok_b = ReferenceParseFix(record.c_str(), flight.extensions, b);
+    if (ok_a != ok_b || (ok_a && !(a == b))) {
+      fprintf(stderr, "Mismatch: %s\n", record.c_str());
+      ++n_mismatches;
+    }
+  }
+
+  return n_mismatches;
+}
+
+template<typename F>
+static double
+Measure(const Flight &flight, F &&parse) noexcept
+{
+  unsigned n_valid = 0;
+
+  const auto start = Clock::now();
+
+  for (unsigned i = 0; i < N_ITERATIONS; ++i) {
+    for (const auto &record : flight.records) {
+      IGCFix fix;
+      if (parse(record.c_str(), flight.extensions, fix))
+        ++n_valid;
+    }
+  }
+
+  const std::chrono::duration<double, std::nano> duration =
+    Clock::now() - start;
+
+  /* make sure the loop is not optimised away */
+  if (n_valid == 0 && !flight.records.empty())
+    fputs("No valid records\n", stderr);
+
+  return duration.count() / (N_ITERATIONS * flight.records.size());
+}
+
+static bool
+Run(const char *name, const Flight &flight)
+{
+  if (flight.records.empty()) {
+    printf("%s: no B records\n", name);
+    return true;
+  }
+
+  const unsigned n_mismatches = Compare(flight);
+
+  const double reference = Measure(flight, ReferenceParseFix);
+  const double fast = Measure(flight, IGCParseFix);
+
+  printf("%s: %zu records, reference %.1f ns, IGCParseFix %.1f ns (%.1fx)%s\n",
+         name, flight.records.size(), reference, fast, reference / fast,
+         n_mismatches > 0 ? ", MISMATCH" : "");
+
+  return n_mismatches == 0;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[FILE.igc ...]");
+
+  bool success = true;
+
+  if (args.IsEmpty()) {
+    success = Run("synthetic", GenerateFlight());
+  } else {
+    do {
+      const char *path = args.GetNext();
+      success &= Run(path, LoadFlight(Path(path)));
+    } while (!args.IsEmpty());
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
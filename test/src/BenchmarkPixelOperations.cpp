@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Measures the span operations of the memory canvas (see
+ * Optimised.hpp) and the e-paper dithering, comparing the SIMD
+ * implementations with the portable ones.  The buffer has the size
+ * of a Kobo Glo HD screen.
+ */
+
+#include "ui/canvas/memory/Optimised.hpp"
+#include "ui/canvas/memory/Dither.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+#include <stdio.h>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr unsigned WIDTH = 1072, HEIGHT = 1448;
+static constexpr unsigned N_ROUNDS = 20;
+
+/**
+ * Call the function for each row of the buffer, #N_ROUNDS times, and
+ * print the average duration per megapixel.
+ */
+template<typename F>
+static void
+Measure(const char *name, F &&f) noexcept
+{
+  const auto start = Clock::now();
+
+  for (unsigned round = 0; round < N_ROUNDS; ++round)
+    for (unsigned y = 0; y < HEIGHT; ++y)
+      f(y);
+
+  const std::chrono::duration<double, std::milli> duration =
+    Clock::now() - start;
+  printf("%-28s %8.2f ms/Mpixel\n", name,
+         duration.count() * 1e6 / (double(N_ROUNDS) * WIDTH * HEIGHT));
+}
+
+template<typename PixelTraits, typename Optimised, typename Portable>
+static void
+BenchmarkSpans(const char *name, const Optimised &optimised,
+               const Portable &portable)
+{
+  using color_type = typename PixelTraits::color_type;
+
+  std::vector<color_type> dest(WIDTH * HEIGHT), src(WIDTH * HEIGHT);
+  for (auto &i : src)
+    i = color_type(rand(), rand(), rand());
+
+  const color_type color(0x20, 0x80, 0xe0);
+
+  char buffer[64];
+
+  snprintf(buffer, sizeof(buffer), "%s fill", name);
+  Measure(buffer, [&](unsigned y){
+    optimised.FillPixels(&dest[y * WIDTH], WIDTH, color);
+  });
+
+  snprintf(buffer, sizeof(buffer), "%s fill (portable)", name);
+  Measure(buffer, [&](unsigned y){
+    portable.FillPixels(&dest[y * WIDTH], WIDTH, color);
+  });
+
+  snprintf(buffer, sizeof(buffer), "%s copy", name);
+  Measure(buffer, [&](unsigned y){
+    optimised.CopyPixels(&dest[y * WIDTH], &src[y * WIDTH], WIDTH);
+  });
+
+  snprintf(buffer, sizeof(buffer), "%s copy (portable)", name);
+  Measure(buffer, [&](unsigned y){
+    portable.CopyPixels(&dest[y * WIDTH], &src[y * WIDTH], WIDTH);
+  });
+}
+
+static void
+BenchmarkDither()
+{
+  std::vector<uint8_t> map(WIDTH * HEIGHT, 0xff), grey(WIDTH * HEIGHT);
+  std::vector<uint8_t> dest(WIDTH * HEIGHT);
+
+  /* a map: white background with black lines */
+  for (unsigned y = 0; y < HEIGHT; ++y)
+    for (unsigned x = y % 64; x < WIDTH; x += 64)
+      map[y * WIDTH + x] = 0;
+
+  /* terrain: grey everywhere */
+  for (auto &i : grey)
+    i = 0x40 + rand() % 0x80;
+
+  Dither dither;
+
+  Measure("dither map", [&](unsigned y){
+    if (y == 0)
+      dither.DitherGreyscale(map.data(), WIDTH, dest.data(), WIDTH,
+                             WIDTH, HEIGHT);
+  });
+
+  Measure("dither terrain", [&](unsigned y){
+    if (y == 0)
+      dither.DitherGreyscale(grey.data(), WIDTH, dest.data(), WIDTH,
+                             WIDTH, HEIGHT);
+  });
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "");
+  args.ExpectEnd();
+
+  BenchmarkSpans<GreyscalePixelTraits>("grey alpha",
+                                       AlphaPixelOperations<GreyscalePixelTraits>(0x80),
+                                       PortableAlphaPixelOperations<GreyscalePixelTraits>(0x80));
+
+#ifndef GREYSCALE
+  BenchmarkSpans<BGRAPixelTraits>("bgra alpha",
+                                  AlphaPixelOperations<BGRAPixelTraits>(0x80),
+                                  PortableAlphaPixelOperations<BGRAPixelTraits>(0x80));
+#endif
+
+  BenchmarkDither();
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -4,8 +4,17 @@
 #include "Projection/Projection.hpp"
 #include "Screen/Layout.hpp"
 
+#include <array>
+#include <chrono>
+
+#include <stdio.h>
+
 unsigned Layout::scale_1024 = 1024;
 
+using Clock = std::chrono::steady_clock;
+
+static constexpr unsigned N_POINTS = 64 * 1024 * 1024;
+
 class TestProjection : public Projection {
 public:
   TestProjection() {
@@ -16,6 +25,14 @@ public:
   }
 };
 
+static void
+Print(const char *name, Clock::time_point start) noexcept
+{
+  const std::chrono::duration<double, std::nano> duration =
+    Clock::now() - start;
+  printf("%-8s %6.2f ns/point\n", name, duration.count() / N_POINTS);
+}
+
 int main()
 {
   TestProjection projection;
@@ -23,13 +40,29 @@ int main()
   GeoPoint gp = GeoPoint(Angle::Degrees(7.7061111111111114),
                          Angle::Degrees(51.051944444444445));
   long x = 0, y = 0;
-  for (unsigned i = 64 * 1024 * 1024; i-- > 0;) {
+
+  auto start = Clock::now();
+  for (unsigned i = N_POINTS; i-- > 0;) {
     auto rp = projection.GeoToScreen(gp);
 
     /* prevent gcc from optimizing this loop away */
     x += rp.x;
     y += rp.y;
   }
+  Print("single", start);
+
+  std::array<GeoPoint, 1024> src;
+  src.fill(gp);
+  std::array<PixelPoint, src.size()> dest;
+
+  start = Clock::now();
+  for (unsigned i = N_POINTS / src.size(); i-- > 0;) {
+    projection.GeoToScreen(src, std::span{dest});
+
+    x += dest[i % dest.size()].x;
+    y += dest[i % dest.size()].y;
+  }
+  Print("batch", start);
 
   return x + y;
 }
@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Replays radar responses through the JETProvider pipeline and
+ * reports the cost of each stage: parsing, building the traffic
+ * table, publishing it (the time the mutex is held, like
+ * TrackingGlue::OnJETTraffic()) and the per-frame work of
+ * MapWindow::DrawTraffic() without the actual drawing (extrapolation
+ * and merging).
+ *
+ * Recorded responses (text or binary) may be passed on the command
+ * line; without arguments, synthetic responses with 10 to 5000
+ * targets are generated.
+ */
+
+#include "Tracking/JETProvider/RadarParser.hpp"
+#include "Tracking/JETProvider/TrafficTable.hpp"
+#include "Tracking/JETProvider/Extrapolate.hpp"
+#include "Tracking/JETProvider/JETProvider.hpp"
+#include "Tracking/MergedTraffic.hpp"
+#include "io/FileReader.hxx"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "util/PrintException.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <stdio.h>
+#include <string.h>
+
+static std::atomic_size_t n_allocations;
+
+void *
+operator new(std::size_t size)
+{
+  ++n_allocations;
+
+  if (void *p = malloc(size))
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+  free(p);
+}
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr unsigned N_ITERATIONS = 64;
+
+static std::string
+ReadFile(Path path)
+{
+  FileReader reader(path);
+
+  std::string result;
+  result.resize(reader.GetSize());
+
+  std::size_t position = 0;
+  while (position < result.size()) {
+    const std::size_t nbytes = reader.Read(result.data() + position,
+                                           result.size() - position);
+    if (nbytes == 0)
+      break;
+    position += nbytes;
+  }
+
+  result.resize(position);
+  return result;
+}
+
+static std::string
+GenerateResponse(unsigned n_targets)
+{
+  std::string result = std::to_string(n_targets) + "," +
+    std::to_string(n_targets) + "\n";
+
+  /* spread the targets over one square degree */
+  unsigned seed = 42;
+  const auto random = [&seed](){
+    seed = seed * 1103515245 + 12345;
+    return double((seed >> 8) & 0xffff) / 0x10000;
+  };
+
+  char line[256];
+  for (unsigned i = 0; i < n_targets; ++i) {
+    snprintf(line, sizeof(line),
+             "%06X,D-%04u,%u,%f,%f,%u,%u,%u,%d,1615771825,A320\n",
+             0x3c0000 + i, i, i,
+             51 + random(), 7 + random(),
+             unsigned(random() * 360), unsigned(random() * 40000),
+             unsigned(random() * 480), int(random() * 4000) - 2000);
+    result += line;
+  }
+
+  return result;
+}
+
+static bool
+Parse(const NMEAInfo &basic, const std::string &response,
+      RadarParser::Radar &radar) noexcept
+{
+  if (response.starts_with("JETR"))
+    return RadarParser::ParseRadarBinary(basic,
+                                         std::as_bytes(std::span{response}),
+                                         radar);
+
+  return RadarParser::ParseRadarBuffer(basic, response, radar);
+}
+
+template<typename F>
+static double
+Measure(F &&f) noexcept
+{
+  const auto start = Clock::now();
+  for (unsigned i = 0; i < N_ITERATIONS; ++i)
+    f();
+
+  const std::chrono::duration<double, std::micro> d = Clock::now() - start;
+  return d.count() / N_ITERATIONS;
+}
+
+static void
+Benchmark(const char *name, const std::string &response)
+{
+  NMEAInfo basic{};
+  basic.clock = TimeStamp{FloatDuration{100}};
+
+  RadarParser::Radar radar;
+  if (!Parse(basic, response, radar)) {
+    fprintf(stderr, "%s: malformed radar response\n", name);
+    return;
+  }
+
+  const std::size_t n_targets = radar.traffics.size();
+
+  /* parse */
+  const double parse_us = Measure([&]{
+    RadarParser::Radar r;
+    Parse(basic, response, r);
+  });
+
+  /* parse and build the table, counting allocations */
+  const std::size_t allocations_start = n_allocations;
+  const double table_us = Measure([&]{
+    RadarParser::Radar r;
+    Parse(basic, response, r);
+    JETProvider::TrafficTable table(std::move(r));
+  });
+  const double allocations =
+    double(n_allocations - allocations_start) / N_ITERATIONS;
+
+  /* publish, like TrackingGlue::OnJETTraffic() */
+  JETProvider::Data data;
+  std::chrono::duration<double, std::micro> lock_duration{};
+  for (unsigned i = 0; i < N_ITERATIONS; ++i) {
+    RadarParser::Radar r;
+    Parse(basic, response, r);
+    auto table = std::make_shared<const JETProvider::TrafficTable>(std::move(r));
+
+    const auto start = Clock::now();
+    {
+      const std::lock_guard<Mutex> lock(data.mutex);
+      data.table.swap(table);
+      data.success = true;
+    }
+    lock_duration += Clock::now() - start;
+
+    /* the old table is freed after the mutex has been released */
+    table.reset();
+  }
+
+  /* the per-frame work of MapWindow::DrawTraffic() */
+  const auto snapshot = data.GetSnapshot();
+  const auto now =
+    std::chrono::system_clock::from_time_t(1615771825) + std::chrono::seconds{5};
+  const GeoPoint origin(Angle::Degrees(7.5), Angle::Degrees(51.5));
+  MergedTrafficList list;
+  const double frame_us = Measure([&]{
+    list.Clear();
+    for (const auto &traffic : *snapshot.table) {
+      const auto extrapolated =
+        JETProvider::Extrapolate(traffic, now, std::chrono::seconds{30},
+                                 std::chrono::seconds{90});
+      if (extrapolated)
+        list.Add(MergedTraffic::Source::JET_PROVIDER, FlarmId::Undefined(),
+                 extrapolated->location, {});
+    }
+
+    list.Finish(origin);
+  });
+
+  printf("%-20s %6zu %9zu %10.1f %10.1f %8.1f %9.2f %10.1f\n",
+         name, n_targets, response.size(), parse_us, table_us,
+         allocations, lock_duration.count() / N_ITERATIONS, frame_us);
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[PATH...]");
+
+  printf("%-20s %6s %9s %10s %10s %8s %9s %10s\n",
+         "response", "n", "bytes", "parse[us]", "table[us]",
+         "allocs", "lock[us]", "frame[us]");
+
+  if (args.IsEmpty()) {
+    for (unsigned n : {10, 100, 500, 1000, 2000, 5000}) {
+      char name[32];
+      snprintf(name, sizeof(name), "synthetic-%u", n);
+      Benchmark(name, GenerateResponse(n));
+    }
+  } else {
+    while (!args.IsEmpty()) {
+      const char *path = args.GetNext();
+      Benchmark(path, ReadFile(Path(path)));
+    }
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
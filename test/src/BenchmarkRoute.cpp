@@ -0,0 +1,305 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Loads a terrain file and replays a flight (NMEA or IGC) through
+ * the route planner.  For each stage (ReachFan::Solve(),
+ * ReachFan::FindPositiveArrival() and RoutePlanner::Solve() back to
+ * the take-off location), it reports the latency percentiles per fix
+ * and the number of heap allocations per fix.  Use a mountain flight
+ * over a matching terrain file to get realistic numbers.
+ */
+
+#include "Engine/Route/TerrainRoute.hpp"
+#include "Engine/Route/ReachFan.hpp"
+#include "Engine/Route/ReachResult.hpp"
+#include "Engine/Route/Config.hpp"
+#include "Engine/GlideSolvers/GlideSettings.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "NMEA/Aircraft.hpp"
+#include "Geo/GeoVector.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "Operation/Operation.hpp"
+#include "thread/SharedMutex.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+#include "DebugReplay.hpp"
+
+#include <zzip/zzip.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <stdio.h>
+
+static std::atomic_size_t n_allocations;
+
+void *
+operator new(std::size_t size)
+{
+  ++n_allocations;
+
+  if (void *p = malloc(size))
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+  free(p);
+}
+
+using Clock = std::chrono::steady_clock;
+using Microseconds = std::chrono::duration<double, std::micro>;
+
+/**
+ * The radius of the terrain tiles loaded around the aircraft [m].
+ */
+static constexpr unsigned TERRAIN_RADIUS = 50000;
+
+/**
+ * The number and the distance of the destinations passed to
+ * FindPositiveArrival().
+ */
+static constexpr unsigned N_ARRIVALS = 16;
+static constexpr double ARRIVAL_DISTANCE = 20000;
+
+/**
+ * The height above terrain of the route destination (the take-off
+ * location) [m].
+ */
+static constexpr int ARRIVAL_HEIGHT = 300;
+
+class Stage {
+  const char *name;
+
+  struct Sample {
+    Microseconds duration;
+    std::size_t allocations;
+  };
+
+  std::vector<Sample> samples;
+
+public:
+  explicit Stage(const char *_name) noexcept:name(_name) {}
+
+  template<typename F>
+  void Measure(F &&f) {
+    const std::size_t allocations_start = n_allocations;
+    const auto start = Clock::now();
+    f();
+    const Microseconds duration = Clock::now() - start;
+    samples.push_back({duration, n_allocations - allocations_start});
+  }
+
+  void Print() const;
+};
+
+void
+Stage::Print() const
+{
+  if (samples.empty())
+    return;
+
+  std::vector<double> durations;
+  durations.reserve(samples.size());
+
+  std::size_t total_allocations = 0, max_allocations = 0;
+  for (const auto &i : samples) {
+    durations.push_back(i.duration.count());
+    total_allocations += i.allocations;
+    max_allocations = std::max(max_allocations, i.allocations);
+  }
+
+  std::sort(durations.begin(), durations.end());
+
+  const auto Percentile = [&durations](double p){
+    return durations[std::min(durations.size() - 1,
+                              std::size_t(p * durations.size()))];
+  };
+
+  printf("%-20s %9.1f %9.1f %9.1f %9.1f %9.1f %7zu\n",
+         name, Percentile(0.5), Percentile(0.9), Percentile(0.99),
+         durations.back(), double(total_allocations) / samples.size(),
+         max_allocations);
+}
+
+class TerrainFile {
+  ZZIP_DIR *dir;
+
+  SharedMutex mutex;
+
+public:
+  RasterMap map;
+
+  explicit TerrainFile(Path path);
+
+  ~TerrainFile() noexcept {
+    zzip_dir_close(dir);
+  }
+
+  TerrainFile(const TerrainFile &) = delete;
+  TerrainFile &operator=(const TerrainFile &) = delete;
+
+  /**
+   * Load the tiles around the given location, like the
+   * #TerrainLoader does in the application.
+   */
+  void Update(const GeoPoint &location) {
+    do {
+      UpdateTerrainTiles(dir, map.GetTileCache(), mutex,
+                         map.GetProjection(), location, TERRAIN_RADIUS);
+    } while (map.IsDirty());
+  }
+};
+
+TerrainFile::TerrainFile(Path path)
+{
+  const auto start = Clock::now();
+
+  dir = zzip_dir_open(path.c_str(), nullptr);
+  if (dir == nullptr)
+    throw std::runtime_error("Failed to open terrain file");
+
+  try {
+    NullOperationEnvironment operation;
+    LoadTerrainOverview(dir, map.GetTileCache(), operation);
+  } catch (...) {
+    zzip_dir_close(dir);
+    throw;
+  }
+
+  map.UpdateProjection();
+
+  const std::chrono::duration<double, std::milli> duration =
+    Clock::now() - start;
+  printf("loaded terrain in %.1f ms\n\n", duration.count());
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "TERRAIN DRIVER FILE");
+  const auto terrain_path = args.ExpectNextPath();
+  std::unique_ptr<DebugReplay> replay(CreateDebugReplay(args));
+  if (!replay)
+    return EXIT_FAILURE;
+
+  args.ExpectEnd();
+
+  TerrainFile terrain(terrain_path);
+
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+  config.mode = RoutePlannerConfig::Mode::TERRAIN;
+
+  const GlidePolar glide_polar(1);
+
+  TerrainRoute route;
+  route.SetTerrain(&terrain.map);
+  route.UpdatePolar(settings, config, glide_polar, glide_polar,
+                    SpeedVector::Zero());
+
+  ReachFan reach;
+
+  Stage reach_solve("ReachSolve"),
+    find_arrival("FindPositiveArrival"),
+    route_solve("RouteSolve");
+
+  unsigned n_fixes = 0, n_reachable = 0, n_searches = 0, n_repaired = 0;
+  std::size_t n_nodes = 0, max_nodes = 0;
+  std::optional<AGeoPoint> home;
+
+  while (replay->Next()) {
+    const MoreData &basic = replay->Basic();
+    if (!basic.location_available || !basic.NavAltitudeAvailable())
+      continue;
+
+    terrain.Update(basic.location);
+
+    const auto terrain_height = terrain.map.GetHeight(basic.location);
+    if (terrain_height.IsSpecial())
+      continue;
+
+    if (!home) {
+      /* route back to where the flight started */
+      home = AGeoPoint(basic.location,
+                       terrain_height.GetValue() + ARRIVAL_HEIGHT);
+      continue;
+    }
+
+    const AGeoPoint aircraft(basic.location, basic.nav_altitude);
+    ++n_fixes;
+
+    reach_solve.Measure([&]{
+      reach.Solve(aircraft, route.GetReachPolar(), &terrain.map);
+    });
+
+    find_arrival.Measure([&]{
+      for (unsigned i = 0; i < N_ARRIVALS; ++i) {
+        const GeoPoint location =
+          GeoVector(ARRIVAL_DISTANCE, Angle::FullCircle() * i / N_ARRIVALS)
+          .EndPoint(basic.location);
+        const AGeoPoint dest(location, terrain.map.GetHeight(location)
+                             .GetValueOr0());
+        const auto result =
+          reach.FindPositiveArrival(dest, route.GetReachPolar());
+        if (result && result->IsReachableTerrain())
+          ++n_reachable;
+      }
+    });
+
+    bool solved;
+    route_solve.Measure([&]{
+      solved = route.Solve(*home, aircraft, config);
+    });
+
+    if (!solved) {
+      /* trivial: the direct path is clear */
+    } else if (route.IsSolutionRepaired()) {
+      ++n_repaired;
+    } else {
+      ++n_searches;
+      n_nodes += route.GetNodeCount();
+      max_nodes = std::max(max_nodes, route.GetNodeCount());
+    }
+  }
+
+  printf("%u fixes, %u/%u destinations reachable\n",
+         n_fixes, n_reachable, n_fixes * N_ARRIVALS);
+  printf("%u searches, %u repaired, %.1f nodes per search (max %zu)\n\n",
+         n_searches, n_repaired,
+         n_searches > 0 ? double(n_nodes) / n_searches : 0.,
+         max_nodes);
+
+  printf("%-20s %9s %9s %9s %9s %9s %7s\n",
+         "stage", "p50[us]", "p90[us]", "p99[us]", "max[us]",
+         "allocs", "max");
+  reach_solve.Print();
+  find_arrival.Print();
+  route_solve.Print();
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
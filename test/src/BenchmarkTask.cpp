@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Flies random tasks (generated like test_randomtask does) of each
+ * task type with the autopilot and reports the latency percentiles
+ * of the per-cycle task engine calls: TaskManager::Update() (which
+ * includes the min/max distance scans), TaskManager::UpdateIdle()
+ * (TaskOptTarget and the AAT minimum time target search) and
+ * TaskManager::UpdateAutoMC() (TaskBestMc in final glide).
+ */
+
+#include "harness_flight.hpp"
+#include "harness_wind.hpp"
+#include "test_debug.hpp"
+#include "Engine/Task/Factory/AbstractTaskFactory.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Replay/TaskAutoPilot.hpp"
+#include "Replay/AircraftSim.hpp"
+#include "Replay/TaskAccessor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+using Microseconds = std::chrono::duration<double, std::micro>;
+
+/**
+ * The number of random tasks flown per task type.
+ */
+static constexpr unsigned NUM_FLIGHTS = 8;
+
+/**
+ * Give up a flight after this number of cycles (one per simulated
+ * second); the autopilot doesn't always find its way around a random
+ * task.
+ */
+static constexpr unsigned MAX_CYCLES = 6 * 3600;
+
+class Stage {
+  const char *name;
+
+  std::vector<double> samples;
+
+public:
+  explicit Stage(const char *_name) noexcept:name(_name) {}
+
+  template<typename F>
+  void Measure(F &&f) {
+    const auto start = Clock::now();
+    f();
+    const Microseconds duration = Clock::now() - start;
+    samples.push_back(duration.count());
+  }
+
+  void Print(const char *type);
+};
+
+void
+Stage::Print(const char *type)
+{
+  if (samples.empty())
+    return;
+
+  std::sort(samples.begin(), samples.end());
+
+  const auto Percentile = [this](double p){
+    return samples[std::min(samples.size() - 1,
+                            std::size_t(p * samples.size()))];
+  };
+
+  printf("%-8s %-14s %8zu %9.1f %9.1f %9.1f %9.1f\n",
+         type, name, samples.size(),
+         Percentile(0.5), Percentile(0.9), Percentile(0.99),
+         samples.back());
+}
+
+struct TaskTypeStages {
+  Stage update{"Update"};
+  Stage update_idle{"UpdateIdle"};
+  Stage update_auto_mc{"UpdateAutoMC"};
+};
+
+static void
+Fly(TaskManager &task_manager, TaskTypeStages &stages, int n_wind)
+{
+  TaskAccessor ta(task_manager, 300);
+  TaskAutoPilot autopilot(autopilot_parms);
+  AircraftSim aircraft;
+
+  autopilot.SetDefaultLocation(GeoPoint(Angle::Degrees(1), Angle::Degrees(0)));
+
+  if (n_wind)
+    aircraft.SetWind(wind_to_mag(n_wind), wind_to_dir(n_wind));
+
+  autopilot.Start(ta);
+  aircraft.Start(autopilot.location_start, autopilot.location_previous,
+                 autopilot_parms.start_alt);
+
+  unsigned n_cycles = 0;
+  do {
+    autopilot.UpdateState(ta, aircraft.GetState());
+    aircraft.Update(autopilot.heading);
+
+    const AircraftState state = aircraft.GetState();
+    const AircraftState state_last = aircraft.GetLastState();
+
+    stages.update.Measure([&]{
+      task_manager.Update(state, state_last);
+    });
+
+    stages.update_idle.Measure([&]{
+      task_manager.UpdateIdle(state);
+    });
+
+    stages.update_auto_mc.Measure([&]{
+      task_manager.UpdateAutoMC(state, 0);
+    });
+  } while (autopilot.UpdateAutopilot(ta, aircraft.GetState()) &&
+           ++n_cycles < MAX_CYCLES);
+}
+
+static void
+Run(TaskFactoryType type, const char *type_name)
+{
+  TaskTypeStages stages;
+
+  for (unsigned i = 0; i < NUM_FLIGHTS;) {
+    GlidePolar glide_polar(2);
+    Waypoints waypoints;
+    SetupWaypoints(waypoints);
+
+    TaskBehaviour task_behaviour;
+    task_behaviour.SetDefaults();
+    task_behaviour.auto_mc = true;
+    task_behaviour.auto_mc_mode = TaskBehaviour::AutoMCMode::BOTH;
+
+    TaskManager task_manager(task_behaviour, waypoints);
+    task_manager.SetGlidePolar(glide_polar);
+
+    /* retry until the random generator has found a valid task */
+    if (!test_task_random_type(task_manager, waypoints, type,
+                               rand() % 8 + 1))
+      continue;
+
+    /* like TaskManager::Commit() would */
+    task_manager.GetFactory().UpdateGeometry();
+
+    waypoints.Clear(); // clear waypoints so abort wont do anything
+
+    autopilot_parms.goto_target = type == TaskFactoryType::AAT;
+    Fly(task_manager, stages, rand() % NUM_WIND);
+    ++i;
+  }
+
+  stages.update.Print(type_name);
+  stages.update_idle.Print(type_name);
+  stages.update_auto_mc.Print(type_name);
+}
+
+int
+main(int argc, char **argv)
+{
+  autopilot_parms.SetIdeal();
+
+  if (!ParseArgs(argc, argv))
+    return EXIT_FAILURE;
+
+  printf("%-8s %-14s %8s %9s %9s %9s %9s\n",
+         "type", "stage", "cycles", "p50[us]", "p90[us]", "p99[us]",
+         "max[us]");
+
+  Run(TaskFactoryType::RACING, "racing");
+  Run(TaskFactoryType::AAT, "aat");
+  Run(TaskFactoryType::FAI_GENERAL, "fai");
+  Run(TaskFactoryType::MAT, "mat");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,320 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program loads the topography of a map file and replays a
+ * scripted sequence of zooms and pans.  For each frame, it prints
+ * the time needed to update the topography cache
+ * (TopographyStore::ScanVisibility()), to build the OpenGL index
+ * lists (XShape::GetIndices()) and to paint the shapes and labels,
+ * followed by a summary and the peak memory usage.
+ */
+
+#define ENABLE_SCREEN
+#define ENABLE_CMDLINE
+#define USAGE "FILE.xcm [LONGITUDE LATITUDE]"
+
+#include "Main.hpp"
+#include "ui/window/SingleWindow.hpp"
+#include "ui/canvas/Canvas.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyFile.hpp"
+#include "Topography/TopographyRenderer.hpp"
+#include "Topography/XShape.hpp"
+#include "Look/TopographyLook.hpp"
+#include "Renderer/LabelBlock.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "Geo/FAISphere.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "io/ZipArchive.hpp"
+#include "io/ZipLineReader.hpp"
+#include "util/NumberParser.hpp"
+
+#ifdef ENABLE_OPENGL
+#include "ui/opengl/System.hpp"
+#endif
+
+#ifdef HAVE_POSIX
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+static AllocatedPath map_path = nullptr;
+static GeoPoint location = GeoPoint::Invalid();
+
+static void
+ParseCommandLine(Args &args)
+{
+  map_path = args.ExpectNextPath();
+
+  if (!args.IsEmpty()) {
+    const auto longitude = ParseDouble(args.ExpectNext());
+    const auto latitude = ParseDouble(args.ExpectNext());
+    location = GeoPoint(Angle::Degrees(longitude), Angle::Degrees(latitude));
+  }
+}
+
+struct Frame {
+  /**
+   * The radius of the visible area [m].
+   */
+  double radius;
+
+  /**
+   * The offset of the screen center from the start location, in
+   * multiples of the radius of the first frame.
+   */
+  double east, north;
+
+  Angle angle;
+};
+
+/**
+ * Zoom in, pan east, pan north on a rotated map, zoom out.
+ */
+static std::vector<Frame>
+MakeScript() noexcept
+{
+  std::vector<Frame> script;
+
+  constexpr double max_radius = 100000, min_radius = 2500;
+  constexpr unsigned n_zoom = 20, n_pan = 40;
+
+  const double zoom_step = std::pow(min_radius / max_radius, 1. / n_zoom);
+
+  double radius = max_radius;
+  for (unsigned i = 0; i < n_zoom; ++i, radius *= zoom_step)
+    script.push_back({radius, 0, 0, Angle::Zero()});
+
+  /* each pan step moves the screen by 1/10 of its size */
+  double east = 0, north = 0;
+  for (unsigned i = 0; i < n_pan; ++i, east += radius / max_radius / 5)
+    script.push_back({radius, east, north, Angle::Zero()});
+
+  for (unsigned i = 0; i < n_pan; ++i, north += radius / max_radius / 5)
+    script.push_back({radius, east, north, Angle::Degrees(30)});
+
+  for (unsigned i = 0; i <= n_zoom; ++i, radius /= zoom_step)
+    script.push_back({radius, east, north, Angle::Zero()});
+
+  return script;
+}
+
+struct Result {
+  double radius;
+  Milliseconds update, indices, paint;
+  std::size_t memory;
+};
+
+/**
+ * Move the location by the specified distances [m].
+ */
+[[gnu::pure]]
+static GeoPoint
+Offset(GeoPoint p, double east, double north) noexcept
+{
+  return GeoPoint(p.longitude +
+                  FAISphere::EarthDistanceToAngle(east / p.latitude.cos()),
+                  p.latitude + FAISphere::EarthDistanceToAngle(north));
+}
+
+#ifdef ENABLE_OPENGL
+
+/**
+ * Build the index lists which TopographyFileRenderer::Paint() would
+ * build for this projection, so they can be measured separately.
+ */
+static void
+BuildIndices(const TopographyStore &store,
+             const WindowProjection &projection) noexcept
+{
+  const double map_scale = projection.GetMapScale();
+  const GeoBounds screen_bounds = projection.GetScreenBounds();
+
+  for (const auto &file : store) {
+    if (!file.IsVisible(map_scale))
+      continue;
+
+    const unsigned level = file.GetThinningLevel(map_scale);
+    const ShapeScalar min_distance(file.GetMinimumPointDistance(level));
+
+    const std::lock_guard lock{file.mutex};
+    for (const XShape &shape : file)
+      if ((shape.get_type() == MS_SHAPE_LINE ||
+           shape.get_type() == MS_SHAPE_POLYGON) &&
+          screen_bounds.Overlaps(shape.get_bounds()))
+        shape.GetIndices(level, min_distance);
+  }
+}
+
+#endif
+
+static void
+Flush() noexcept
+{
+#ifdef ENABLE_OPENGL
+  glFinish();
+#endif
+}
+
+static std::size_t
+GetPeakResidentMemory() noexcept
+{
+#ifdef HAVE_POSIX
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    /* kilobytes on Linux */
+    return std::size_t(usage.ru_maxrss) * 1024;
+#endif
+  return 0;
+}
+
+class BenchmarkWindow final : public UI::SingleWindow {
+  TopographyStore &store;
+  TopographyRenderer renderer;
+
+  bool done = false;
+
+public:
+  BenchmarkWindow(UI::Display &display, TopographyStore &_store,
+                  const TopographyLook &look) noexcept
+    :UI::SingleWindow(display), store(_store), renderer(store, look) {}
+
+protected:
+  void OnPaint(Canvas &canvas) noexcept override {
+    if (!done) {
+      done = true;
+      Run(canvas);
+      Close();
+    }
+
+    SingleWindow::OnPaint(canvas);
+  }
+
+private:
+  void Run(Canvas &canvas) noexcept;
+};
+
+void
+BenchmarkWindow::Run(Canvas &canvas) noexcept
+{
+  const auto script = MakeScript();
+  const double unit = script.front().radius;
+
+  WindowProjection projection;
+  projection.SetMapRect(PixelRect{canvas.GetSize()});
+  projection.SetScreenOrigin(PixelRect{canvas.GetSize()}.GetCenter());
+
+  std::vector<Result> results;
+  results.reserve(script.size());
+
+  std::size_t peak_store_memory = 0;
+
+  printf("frame\tradius\tupdate\tindices\tpaint\tshapes\n");
+
+  for (const Frame &frame : script) {
+    projection.SetGeoLocation(Offset(location, frame.east * unit,
+                                     frame.north * unit));
+    projection.SetScreenAngle(frame.angle);
+    projection.SetScaleFromRadius(frame.radius);
+    projection.UpdateScreenBounds();
+
+    Result &result = results.emplace_back();
+    result.radius = frame.radius;
+
+    auto start = Clock::now();
+    store.ScanVisibility(projection);
+    auto end = Clock::now();
+    result.update = end - start;
+
+#ifdef ENABLE_OPENGL
+    start = Clock::now();
+    BuildIndices(store, projection);
+    end = Clock::now();
+    result.indices = end - start;
+#else
+    result.indices = {};
+#endif
+
+    start = Clock::now();
+    canvas.ClearWhite();
+    renderer.Draw(canvas, projection);
+
+    LabelBlock label_block;
+    label_block.reset();
+    renderer.DrawLabels(canvas, projection, label_block);
+    Flush();
+    end = Clock::now();
+    result.paint = end - start;
+
+    result.memory = store.GetMemoryStats().used;
+    peak_store_memory = std::max(peak_store_memory, result.memory);
+
+    printf("%u\t%.0f\t%.2f\t%.2f\t%.2f\t%zu\n",
+           unsigned(results.size() - 1), frame.radius,
+           result.update.count(), result.indices.count(),
+           result.paint.count(), result.memory / 1024);
+  }
+
+  const auto Summarize = [&results](const char *name,
+                                    Milliseconds Result::*p){
+    Milliseconds total{}, max{};
+    for (const auto &r : results) {
+      total += r.*p;
+      max = std::max(max, r.*p);
+    }
+
+    printf("%s: %.2f ms average, %.2f ms max\n", name,
+           total.count() / results.size(), max.count());
+  };
+
+  printf("\n");
+  Summarize("update", &Result::update);
+#ifdef ENABLE_OPENGL
+  Summarize("indices", &Result::indices);
+#endif
+  Summarize("paint", &Result::paint);
+
+  printf("peak shape memory: %zu kB\n", peak_store_memory / 1024);
+  if (const std::size_t rss = GetPeakResidentMemory(); rss > 0)
+    printf("peak resident memory: %zu kB\n", rss / 1024);
+}
+
+static void
+Main(UI::Display &display)
+{
+  TopographyStore store;
+
+  {
+    ZipArchive archive(map_path);
+    ZipLineReaderA reader(archive.get(), "topology.tpl");
+
+    ConsoleOperationEnvironment operation;
+    store.Load(operation, reader, nullptr, archive.get());
+  }
+
+  if (!location.IsValid()) {
+    if (store.begin() == store.end()) {
+      fprintf(stderr, "No topography\n");
+      return;
+    }
+
+    location = store.begin()->GetCenter();
+  }
+
+  TopographyLook look;
+  look.Initialise();
+
+  BenchmarkWindow window{display, store, look};
+  window.Create(_T("BenchmarkTopography"), {640, 480});
+  window.Show();
+
+  window.RunEventLoop();
+}
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program decodes all terrain tiles of a map file and writes
+ * them to a pre-decoded tile file ("*.tiles" next to the map file),
+ * which is then used by RasterTerrain instead of the JPEG2000 image.
+ */
+
+#include "Terrain/RasterTileCache.hpp"
+#include "Terrain/Loader.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "system/Args.hpp"
+#include "io/ZipArchive.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "util/PrintException.hxx"
+
+#include <stdio.h>
+#include <tchar.h>
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "MAP [OUTPUT]");
+  const auto map_path = args.ExpectNextPath();
+  const auto output_path = args.IsEmpty()
+    ? map_path.WithSuffix(_T(".tiles"))
+    : AllocatedPath(args.ExpectNextPath());
+  args.ExpectEnd();
+
+  ZipArchive archive(map_path);
+
+  RasterTileCache rtc;
+
+  ConsoleOperationEnvironment operation;
+  LoadTerrainOverview(archive.get(), rtc, operation);
+
+  FileOutputStream file(output_path);
+  BufferedOutputStream bos(file);
+  WriteTerrainTileFile(archive.get(),
+                       RasterTileFile::Source::FromFile(map_path),
+                       rtc, bos, operation);
+  bos.Flush();
+  file.Commit();
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
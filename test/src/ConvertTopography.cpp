@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * This program converts the topography shapefiles of a map file to a
+ * topography package ("*.topo" next to the map file), which is then
+ * used by TopographyStore instead of the shapefiles.
+ */
+
+#include "Topography/TopographyFile.hpp"
+#include "Topography/TopographyPackage.hpp"
+#include "Topography/XShape.hpp"
+#include "Topography/Index.hpp"
+#include "system/Args.hpp"
+#include "io/ZipArchive.hpp"
+#include "io/ZipLineReader.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "util/AllocatedString.hxx"
+#include "util/PrintException.hxx"
+
+#ifdef _UNICODE
+#include "util/ConvertString.hpp"
+#endif
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <tchar.h>
+
+static void
+AddLayer(TopographyPackageWriter &writer, std::string_view name,
+         TopographyFile &file)
+{
+  file.LoadAll();
+
+  std::array<unsigned, TopographyPackage::MAX_LEVELS> min_distance{};
+#ifdef ENABLE_OPENGL
+  for (unsigned level = 0; level < min_distance.size(); ++level)
+    min_distance[level] = file.GetMinimumPointDistance(level);
+#endif
+
+  /* the labels are not loaded with the shapes */
+  std::vector<BasicAllocatedString<TCHAR>> labels(file.GetShapeCount());
+#ifdef _UNICODE
+  std::vector<std::string> utf8_labels(file.GetShapeCount());
+#endif
+
+  std::vector<TopographyPackage::Shape> shapes;
+  shapes.reserve(file.GetShapeCount());
+
+  for (std::size_t i = 0; i < file.GetShapeCount(); ++i) {
+    const XShape &src = *file.GetShape(i);
+
+    std::size_t n_points = 0;
+    for (const auto l : src.GetLines())
+      n_points += l;
+
+    auto &shape = shapes.emplace_back();
+    shape.bounds = src.get_bounds();
+    shape.type = src.get_type();
+    shape.lines = src.GetLines();
+    labels[i] = file.ReadLabel(i);
+#ifdef _UNICODE
+    if (labels[i] != nullptr) {
+      utf8_labels[i] = WideToUTF8Converter(labels[i].c_str()).c_str();
+      shape.label = utf8_labels[i].c_str();
+    } else
+      shape.label = nullptr;
+#else
+    shape.label = labels[i].c_str();
+#endif
+
+    shape.points = {src.GetPoints(), n_points};
+
+#ifdef ENABLE_OPENGL
+    if (shape.type == MS_SHAPE_LINE || shape.type == MS_SHAPE_POLYGON) {
+      for (unsigned level = 0; level < min_distance.size(); ++level) {
+        src.GetIndices(level, min_distance[level]);
+        shape.indices[level] = src.GetIndexBlock(level);
+      }
+    }
+#endif
+  }
+
+  writer.AddLayer(name, file.GetCenter(), min_distance, shapes);
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "MAP [OUTPUT]");
+  const auto map_path = args.ExpectNextPath();
+  const auto output_path = args.IsEmpty()
+    ? map_path.WithSuffix(_T(".topo"))
+    : AllocatedPath(args.ExpectNextPath());
+  args.ExpectEnd();
+
+  ZipArchive archive(map_path);
+  ZipLineReaderA reader(archive.get(), "topology.tpl");
+
+  TopographyPackageWriter writer;
+
+  while (char *line = reader.ReadLine()) {
+    const auto entry = ParseTopographyIndexLine(line);
+    if (!entry)
+      continue;
+
+    const std::string name{entry->name};
+
+    try {
+      TopographyFile file(archive.get(), (name + ".shp").c_str(),
+                          entry->shape_range,
+                          entry->label_range,
+                          entry->important_label_range,
+                          entry->color,
+                          entry->shape_field,
+                          entry->icon, entry->big_icon,
+                          entry->pen_width);
+      AddLayer(writer, name, file);
+      printf("%s: %zu shapes\n", name.c_str(), file.GetShapeCount());
+    } catch (...) {
+      fprintf(stderr, "%s: ", name.c_str());
+      PrintException(std::current_exception());
+    }
+  }
+
+  FileOutputStream file(output_path);
+  BufferedOutputStream bos(file);
+  writer.Finish(bos);
+  bos.Flush();
+  file.Commit();
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -8,10 +8,10 @@
 
 class DebugReplayFile : public DebugReplay {
 protected:
-  FileLineReaderA *reader;
+  NLineReader *reader;
 
 public:
-  DebugReplayFile(FileLineReaderA *_reader)
+  DebugReplayFile(NLineReader *_reader)
     : reader(_reader) {
   }
 
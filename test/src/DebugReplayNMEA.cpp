@@ -2,6 +2,7 @@
 // Copyright The XCSoar Project
 
 #include "DebugReplayNMEA.hpp"
+#include "Logger/CompressedNMEA.hpp"
 #include "io/FileLineReader.hpp"
 #include "Device/Driver.hpp"
 #include "Device/Register.hpp"
@@ -12,7 +13,7 @@
 static DeviceConfig config;
 static NullPort port;
 
-DebugReplayNMEA::DebugReplayNMEA(FileLineReaderA *_reader,
+DebugReplayNMEA::DebugReplayNMEA(NLineReader *_reader,
                                  const DeviceRegister *driver)
   :DebugReplayFile(_reader),
    device(driver->CreateOnPort != NULL
@@ -31,7 +32,11 @@ DebugReplayNMEA::Create(Path input_file, const tstring &driver_name)
     return nullptr;
   }
 
-  FileLineReaderA *reader = new FileLineReaderA(input_file);
+  NLineReader *reader;
+  if (input_file.EndsWithIgnoreCase(_T(".nmz")))
+    reader = new CompressedNMEAReader(input_file);
+  else
+    reader = new FileLineReaderA(input_file);
   return new DebugReplayNMEA(reader, driver);
 }
 
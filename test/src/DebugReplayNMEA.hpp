@@ -9,7 +9,7 @@
 
 #include <memory>
 
-class FileLineReaderA;
+class NLineReader;
 class Device;
 struct DeviceRegister;
 
@@ -22,7 +22,7 @@ class DebugReplayNMEA : public DebugReplayFile {
   ReplayClock clock;
 
 private:
-  DebugReplayNMEA(FileLineReaderA *_reader, const DeviceRegister *driver);
+  DebugReplayNMEA(NLineReader *_reader, const DeviceRegister *driver);
 
 public:
   virtual bool Next();
@@ -3,12 +3,21 @@
 
 #include "Terrain/RasterTerrain.hpp"
 
+#include <algorithm>
+
 TerrainHeight
 RasterMap::GetHeight([[maybe_unused]] const GeoPoint &location) const noexcept
 {
   return TerrainHeight::Invalid();
 }
 
+void
+RasterMap::GetHeights([[maybe_unused]] std::span<const GeoPoint> locations,
+                      std::span<TerrainHeight> heights) const noexcept
+{
+  std::fill(heights.begin(), heights.end(), TerrainHeight::Invalid());
+}
+
 GeoPoint
 RasterMap::GroundIntersection([[maybe_unused]] const GeoPoint &origin,
                               [[maybe_unused]] const int h_origin,
@@ -19,6 +28,17 @@ RasterMap::GroundIntersection([[maybe_unused]] const GeoPoint &origin,
   return GeoPoint::Invalid();
 }
 
+void
+RasterMap::GroundIntersections([[maybe_unused]] const GeoPoint &origin,
+                               [[maybe_unused]] int h_origin,
+                               [[maybe_unused]] int h_glide,
+                               [[maybe_unused]] std::span<const GeoPoint> destinations,
+                               [[maybe_unused]] int height_floor,
+                               std::span<GeoPoint> results) const noexcept
+{
+  std::fill(results.begin(), results.end(), GeoPoint::Invalid());
+}
+
 RasterMap::Intersection
 RasterMap::FirstIntersection([[maybe_unused]] const GeoPoint &origin,
                              [[maybe_unused]] const int h_origin,
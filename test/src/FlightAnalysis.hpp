@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#pragma once
+
+#include <boost/json/fwd.hpp>
+
+#include <functional>
+
+class DebugReplay;
+
+struct FlightAnalysisOptions {
+  /**
+   * Maximum number of points of the traces used by the contest
+   * solvers.
+   */
+  unsigned full_max_points = 512,
+    triangle_max_points = 1024,
+    sprint_max_points = 64;
+};
+
+/**
+ * Called for each fix of the analysed part of the flight.
+ */
+using FixCallback = std::function<void(const DebugReplay &replay)>;
+
+/**
+ * Analyse one flight: takeoff/release/landing events, flight phases,
+ * performance and OLC/DMSt contests.  All state is local, so several
+ * flights can be analysed in parallel.
+ *
+ * @param on_fix an optional callback for additional per-fix
+ * calculations
+ */
+boost::json::object
+AnalyseFlight(DebugReplay &replay, const FlightAnalysisOptions &options,
+              const FixCallback &on_fix=nullptr);
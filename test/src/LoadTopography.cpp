@@ -74,6 +74,7 @@ try {
   }
 
   topography.LoadAll();
+  printf("%zu kB\n", topography.GetMemoryStats().used / 1024);
 
 #ifdef ENABLE_OPENGL
   TriangulateAll(topography);
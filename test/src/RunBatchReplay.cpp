@@ -0,0 +1,426 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Replays many IGC files through a headless #GlideComputer (task,
+ * contest, wind, thermals, airspace warnings) as fast as the CPU
+ * allows, one file per CPU core, and prints the results of all
+ * flights as one JSON array.
+ */
+
+#include "DebugReplayIGC.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceWarning.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Airspace/ProtectedAirspaceWarningManager.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Contest/Solvers/Contests.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Computer/Settings.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Task/LoadFile.hpp"
+#include "Operation/Operation.hpp"
+#include "Formatter/TimeFormatter.hpp"
+#include "io/FileLineReader.hpp"
+#include "io/StdioOutputStream.hxx"
+#include "json/Geo.hpp"
+#include "json/Serialize.hxx"
+#include "thread/ThreadPool.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "time/BrokenDateTime.hpp"
+#include "util/Exception.hxx"
+#include "util/NumberParser.hpp"
+#include "util/StringCompare.hxx"
+#include "util/PrintException.hxx"
+
+#include <boost/json.hpp>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std::chrono;
+
+/* fake symbols: */
+
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+
+void
+ConditionMonitors::Update([[maybe_unused]] const NMEAInfo &basic,
+                          [[maybe_unused]] const DerivedInfo &calculated,
+                          [[maybe_unused]] const ComputerSettings &settings) noexcept
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent([[maybe_unused]] const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent([[maybe_unused]] const NMEAInfo &gps_info) {}
+void Logger::LogPoint([[maybe_unused]] const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+struct BatchOptions {
+  Path task_path = nullptr, airspace_path = nullptr;
+};
+
+/**
+ * Converts a #TimeStamp of the replayed flight to an absolute time,
+ * based on the date and time of the first fix.
+ */
+class FlightClock {
+  BrokenDateTime origin = BrokenDateTime::Invalid();
+  TimeStamp origin_time = TimeStamp::Undefined();
+
+public:
+  void Update(const NMEAInfo &basic) noexcept {
+    if (!origin_time.IsDefined() && basic.time_available &&
+        basic.date_time_utc.IsPlausible()) {
+      origin = basic.date_time_utc;
+      origin_time = basic.time;
+    }
+  }
+
+  BrokenDateTime ToDateTime(TimeStamp t) const noexcept {
+    if (!origin_time.IsDefined() || !t.IsDefined())
+      return BrokenDateTime::Invalid();
+
+    return origin +
+      duration_cast<system_clock::duration>(t - origin_time);
+  }
+};
+
+/**
+ * Collects the airspace warnings issued during the flight.
+ */
+struct WarningLog {
+  Validity latest;
+
+  /**
+   * How often a new warning was issued.
+   */
+  unsigned n_events = 0;
+
+  /**
+   * Names of all airspaces which were warned about, and of those
+   * which were entered.
+   */
+  std::set<std::string> warned, entered;
+
+  WarningLog() noexcept {
+    latest.Clear();
+  }
+
+  void Update(const GlideComputer &glide_computer) noexcept {
+    const auto &info = glide_computer.Calculated().airspace_warnings;
+    if (!info.latest.Modified(latest))
+      return;
+
+    latest = info.latest;
+    ++n_events;
+
+    const ProtectedAirspaceWarningManager::Lease lease{glide_computer.GetAirspaceWarnings()};
+    const AirspaceWarningManager &manager = lease;
+    for (const auto &warning : manager) {
+      if (warning.GetWarningState() == AirspaceWarning::WARNING_CLEAR)
+        continue;
+
+      const char *name = warning.GetAirspace().GetName();
+      warned.emplace(name);
+      if (warning.IsInside())
+        entered.emplace(name);
+    }
+  }
+};
+
+static boost::json::object
+WriteEvent(const FlightClock &clock,
+           TimeStamp time, const GeoPoint &location) noexcept
+{
+  boost::json::object o;
+  if (location.IsValid())
+    o = boost::json::value_from(location).as_object();
+
+  const auto date_time = clock.ToDateTime(time);
+  if (date_time.IsPlausible()) {
+    char buffer[64];
+    FormatISO8601(buffer, date_time);
+    o.emplace("time", buffer);
+  }
+
+  return o;
+}
+
+static boost::json::object
+WriteEvents(const FlyingState &flight, const FlightClock &clock) noexcept
+{
+  boost::json::object o;
+
+  if (flight.takeoff_time.IsDefined())
+    o.emplace("takeoff", WriteEvent(clock, flight.takeoff_time,
+                                    flight.takeoff_location));
+
+  if (flight.release_time.IsDefined())
+    o.emplace("release", WriteEvent(clock, flight.release_time,
+                                    flight.release_location));
+
+  if (flight.landing_time.IsDefined())
+    o.emplace("landing", WriteEvent(clock, flight.landing_time,
+                                    flight.landing_location));
+
+  return o;
+}
+
+static boost::json::object
+WriteContest(Contest contest, const ContestStatistics &stats) noexcept
+{
+  boost::json::object o;
+  o.emplace("rules", ContestToString(contest));
+
+  boost::json::array results;
+  for (const auto &result : stats.result) {
+    if (!result.IsDefined())
+      continue;
+
+    results.emplace_back(boost::json::object{
+      {"score", result.score},
+      {"distance", result.distance},
+      {"duration", result.time.count()},
+      {"speed", result.GetSpeed()},
+    });
+  }
+
+  o.emplace("results", std::move(results));
+
+  const auto &best = stats.GetResult();
+  if (best.IsDefined())
+    o.emplace("score", best.score);
+
+  return o;
+}
+
+static boost::json::object
+WriteThermals(const DerivedInfo &calculated) noexcept
+{
+  boost::json::object o;
+
+  o.emplace("time_circling", calculated.time_circling.count());
+  o.emplace("time_cruise", calculated.time_cruise.count());
+  o.emplace("circling_percentage", calculated.circling_percentage);
+  o.emplace("total_height_gain", calculated.total_height_gain);
+  o.emplace("max_height_gain", calculated.max_height_gain);
+
+  if (calculated.time_climb_circling.count() > 0)
+    o.emplace("average_climb", calculated.total_height_gain /
+              calculated.time_climb_circling.count());
+
+  return o;
+}
+
+static boost::json::object
+WriteTask(const TaskStats &stats, const FlightClock &clock) noexcept
+{
+  boost::json::object o;
+
+  o.emplace("valid", stats.task_valid);
+  o.emplace("finished", stats.task_finished);
+
+  if (stats.start.HasStarted()) {
+    o.emplace("start", WriteEvent(clock, stats.start.time,
+                                  GeoPoint::Invalid()));
+    o.emplace("distance", stats.distance_scored);
+    o.emplace("duration", stats.total.time_elapsed.count());
+    o.emplace("speed", stats.total.travelled.GetSpeed());
+  }
+
+  return o;
+}
+
+static boost::json::array
+ToJSON(const std::set<std::string> &names) noexcept
+{
+  boost::json::array a;
+  for (const auto &i : names)
+    a.emplace_back(i);
+  return a;
+}
+
+/**
+ * Replay one flight and return its results.  Everything the
+ * computation modifies is owned by this function, so several flights
+ * can be replayed in parallel.
+ *
+ * Throws on error.
+ */
+static boost::json::object
+ReplayFlight(Path path, const BatchOptions &options)
+{
+  ComputerSettings settings;
+  settings.SetDefaults();
+  settings.polar.glide_polar_task = GlidePolar(1);
+
+  const Waypoints waypoints;
+
+  TaskManager task_manager(settings.task, waypoints);
+  task_manager.SetGlidePolar(settings.polar.glide_polar_task);
+
+  GlideComputerTaskEvents task_events;
+  task_manager.SetTaskEvents(task_events);
+
+  ProtectedTaskManager protected_task_manager(task_manager, settings.task);
+
+  if (options.task_path != nullptr) {
+    auto task = LoadTask(options.task_path, settings.task);
+    if (task)
+      protected_task_manager.TaskCommit(*task);
+  }
+
+  /* the warning manager modifies the airspaces, therefore each
+     flight gets its own copy */
+  Airspaces airspaces;
+  if (options.airspace_path != nullptr) {
+    FileLineReader reader(options.airspace_path, Charset::AUTO);
+    NullOperationEnvironment operation;
+    ParseAirspaceFile(airspaces, reader, operation);
+    airspaces.Optimise();
+  }
+
+  GlideComputer glide_computer(settings, waypoints, airspaces,
+                               protected_task_manager, task_events);
+  glide_computer.SetContestIncremental(false);
+  glide_computer.Initialise();
+
+  const std::unique_ptr<DebugReplay> replay(DebugReplayIGC::Create(path));
+
+  FlightClock clock;
+  WarningLog warnings;
+  unsigned n_fixes = 0;
+
+  while (replay->Next()) {
+    clock.Update(replay->Basic());
+
+    glide_computer.ReadBlackboard(replay->Basic());
+    glide_computer.ProcessGPS();
+
+    /* the CalculationThread runs the idle calculations every 500ms
+       (wall clock); for 1 Hz logs this is once per fix */
+    glide_computer.ProcessIdle();
+    warnings.Update(glide_computer);
+
+    ++n_fixes;
+  }
+
+  glide_computer.ProcessExhaustive();
+  warnings.Update(glide_computer);
+
+  const DerivedInfo &calculated = glide_computer.Calculated();
+
+  boost::json::object o;
+  o.emplace("fixes", n_fixes);
+  o.emplace("events", WriteEvents(calculated.flight, clock));
+  o.emplace("contest", WriteContest(settings.contest.contest,
+                                    calculated.contest_stats));
+  o.emplace("thermals", WriteThermals(calculated));
+
+  if (calculated.estimated_wind_available)
+    o.emplace("wind", boost::json::object{
+      {"speed", calculated.estimated_wind.norm},
+      {"bearing", calculated.estimated_wind.bearing.Degrees()},
+    });
+
+  if (options.task_path != nullptr)
+    o.emplace("task", WriteTask(calculated.ordered_task_stats, clock));
+
+  if (options.airspace_path != nullptr)
+    o.emplace("airspace", boost::json::object{
+      {"warnings", warnings.n_events},
+      {"warned", ToJSON(warnings.warned)},
+      {"entered", ToJSON(warnings.entered)},
+    });
+
+  return o;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[options] FILE.igc ...\n"
+            "Options:\n"
+            "  --jobs=N            Number of flights replayed in parallel (default = number of CPUs)\n"
+            "  --task=FILE         Task file to fly\n"
+            "  --airspace=FILE     Airspace file to check for warnings");
+
+  BatchOptions options;
+  unsigned n_jobs = 0;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--jobs=")) != nullptr) {
+      char *endptr;
+      n_jobs = ParseUnsigned(value, &endptr);
+      if (endptr == value || *endptr != 0 || n_jobs == 0) {
+        fputs("The jobs parameter could not be parsed correctly.\n", stderr);
+        args.UsageError();
+      }
+    } else if ((value = StringAfterPrefix(arg, "--task=")) != nullptr) {
+      options.task_path = Path(value);
+    } else if ((value = StringAfterPrefix(arg, "--airspace=")) != nullptr) {
+      options.airspace_path = Path(value);
+    } else {
+      args.UsageError();
+    }
+  }
+
+  std::vector<Path> paths;
+  do {
+    paths.push_back(args.ExpectNextPath());
+  } while (!args.IsEmpty());
+
+  /* the calling thread is a worker, too */
+  ThreadPool pool("BatchReplay",
+                  n_jobs > 0
+                  ? n_jobs - 1
+                  : ThreadPool::GetDefaultWorkers(paths.size()));
+
+  std::vector<boost::json::object> results(paths.size());
+  pool.ForEach(paths.size(), [&paths, &options, &results](std::size_t i){
+    auto &o = results[i];
+
+    try {
+      o = ReplayFlight(paths[i], options);
+    } catch (...) {
+      o.clear();
+      o.emplace("error", GetFullMessage(std::current_exception()));
+    }
+
+    o.emplace("file", paths[i].c_str());
+  });
+
+  boost::json::array root;
+  for (auto &i : results)
+    root.emplace_back(std::move(i));
+
+  StdioOutputStream os(stdout);
+  Json::Serialize(os, root);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
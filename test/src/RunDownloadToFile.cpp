@@ -7,6 +7,8 @@
 #include "system/Args.hpp"
 #include "Operation/ConsoleOperationEnvironment.hpp"
 #include "util/PrintException.hxx"
+#include "util/HexString.hpp"
+#include "util/StringAPI.hxx"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -35,17 +37,48 @@ Run(CurlGlobal &curl, const char *url, Path path,
   printf("\n");
 }
 
+static Co::InvokeTask
+RunResumable(CurlGlobal &curl, const char *url, Path path,
+             const std::array<std::byte, 32> *expected_sha256,
+             ProgressListener &progress)
+{
+  const auto response =
+    co_await Net::CoResumableDownloadToFile(curl, url, path,
+                                            expected_sha256, progress);
+  printf("status: %u\n", response.status);
+}
+
 int
 main(int argc, char **argv) noexcept
 try {
-  Args args(argc, argv, "URL PATH");
+  Args args(argc, argv, "[--resume [SHA256]] URL PATH");
+
+  bool resume = false;
+  std::array<std::byte, 32> expected_sha256;
+  bool have_sha256 = false;
+
   const char *url = args.ExpectNext();
+  if (StringIsEqual(url, "--resume")) {
+    resume = true;
+    url = args.ExpectNext();
+    if (std::string_view{url}.size() == 64) {
+      expected_sha256 = ParseHexString<32>(std::string_view{url});
+      have_sha256 = true;
+      url = args.ExpectNext();
+    }
+  }
+
   const auto path = args.ExpectNextPath();
   args.ExpectEnd();
 
   Instance instance;
   ConsoleOperationEnvironment env;
-  instance.Run(Run(*Net::curl, url, path, env));
+  if (resume)
+    instance.Run(RunResumable(*Net::curl, url, path,
+                              have_sha256 ? &expected_sha256 : nullptr,
+                              env));
+  else
+    instance.Run(Run(*Net::curl, url, path, env));
   return EXIT_SUCCESS;
 } catch (...) {
   PrintException(std::current_exception());
@@ -56,6 +56,26 @@ try {
               false);
 #else
   matrix.Fill(map, projection, 1, false);
+
+  /* scroll and compare with a full Fill() */
+  for (const PixelPoint delta : {PixelPoint{3, 0}, PixelPoint{0, -7},
+                                 PixelPoint{-20, 11}}) {
+    projection.SetGeoLocation(projection.ScreenToGeo(projection.GetScreenOrigin()
+                                                     + delta));
+    matrix.Update(map, projection, 1, false);
+
+    HeightMatrix expected;
+    expected.Fill(map, projection, 1, false);
+
+    const auto n = matrix.GetSize().Area();
+    unsigned mismatches = 0;
+    for (unsigned i = 0; i < n; ++i)
+      if (matrix.GetData()[i].GetValue() != expected.GetData()[i].GetValue())
+        ++mismatches;
+
+    printf("scrolled by %d,%d: %u of %u values differ\n",
+           delta.x, delta.y, mismatches, n);
+  }
 #endif
 
   return EXIT_SUCCESS;
@@ -74,9 +74,12 @@ private:
   void OnNextTimer() noexcept {
     if (replay->Next()) {
       client.SendFix(replay->Basic());
+      client.FlushBatch();
       next_timer.Schedule(std::chrono::milliseconds(100));
-    } else
+    } else {
+      client.FlushBatch(true);
       event_loop.Break();
+    }
   }
 };
 
@@ -102,15 +105,24 @@ Handler::OnSkyLinesReady()
 
     next_timer.Schedule(std::chrono::seconds(0));
   }
+
+  /* don't hold back a single request */
+  client.FlushBatch(true);
 }
 
 int
 main(int argc, char *argv[])
 try {
-  Args args(argc, argv, "HOST KEY");
+  Args args(argc, argv, "HOST KEY [--batch]");
   const char *host = args.ExpectNext();
   const char *key = args.ExpectNext();
 
+  /* collect packets for one second */
+  const bool batch = !args.IsEmpty() &&
+    StringIsEqual(args.PeekNext(), "--batch");
+  if (batch)
+    args.Skip();
+
   const auto address_list = Resolve(host,
                                     SkyLinesTracking::Client::GetDefaultPort(),
                                     0, SOCK_DGRAM);
@@ -121,6 +133,8 @@ try {
 
   auto &client = handler.GetClient();
   client.SetKey(ParseUint64(key, NULL, 16));
+  if (batch)
+    client.SetBatchDelay(std::chrono::seconds(1));
   client.Open(address_list.GetBest());
 
   event_loop.Run();
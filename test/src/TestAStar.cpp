@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Route/AStar.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+static std::size_t n_allocations;
+
+void *
+operator new(std::size_t size)
+{
+  ++n_allocations;
+
+  if (void *p = malloc(size))
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+  free(p);
+}
+
+static constexpr unsigned SIZE = 24;
+
+struct GridPoint {
+  unsigned x, y;
+
+  constexpr bool operator==(const GridPoint &other) const noexcept {
+    return x == other.x && y == other.y;
+  }
+};
+
+struct GridPointHasher {
+  constexpr std::size_t operator()(const GridPoint &p) const noexcept {
+    return p.x * std::size_t(104729) + p.y;
+  }
+};
+
+static unsigned weights[SIZE][SIZE];
+
+static unsigned seed = 42;
+
+static unsigned
+Random() noexcept
+{
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 8) & 0xffff;
+}
+
+/**
+ * The cost of entering the given cell.
+ */
+static unsigned
+GetWeight(GridPoint p) noexcept
+{
+  return weights[p.y][p.x];
+}
+
+/**
+ * The distance of the cheapest path, calculated by relaxing all
+ * edges until nothing changes.
+ */
+static unsigned
+BruteForce(GridPoint start, GridPoint goal) noexcept
+{
+  static unsigned distance[SIZE][SIZE];
+  for (auto &row : distance)
+    std::fill(std::begin(row), std::end(row),
+              std::numeric_limits<unsigned>::max());
+  distance[start.y][start.x] = 0;
+
+  bool modified;
+  do {
+    modified = false;
+    for (unsigned y = 0; y < SIZE; ++y) {
+      for (unsigned x = 0; x < SIZE; ++x) {
+        if (distance[y][x] == std::numeric_limits<unsigned>::max())
+          continue;
+
+        const GridPoint neighbours[] = {
+          {x - 1, y}, {x + 1, y}, {x, y - 1}, {x, y + 1},
+        };
+
+        for (const auto n : neighbours) {
+          if (n.x >= SIZE || n.y >= SIZE)
+            continue;
+
+          const unsigned d = distance[y][x] + GetWeight(n);
+          if (d < distance[n.y][n.x]) {
+            distance[n.y][n.x] = d;
+            modified = true;
+          }
+        }
+      }
+    }
+  } while (modified);
+
+  return distance[goal.y][goal.x];
+}
+
+static unsigned
+Heuristic(GridPoint p, GridPoint goal) noexcept
+{
+  /* all weights are at least 1, so this never overestimates */
+  return (p.x > goal.x ? p.x - goal.x : goal.x - p.x) +
+    (p.y > goal.y ? p.y - goal.y : goal.y - p.y);
+}
+
+using GridAStar = AStar<GridPoint, GridPointHasher>;
+
+/**
+ * Run a search and verify the result.
+ */
+static bool
+Search(GridAStar &astar, GridPoint start, GridPoint goal) noexcept
+{
+  astar.Restart(start);
+
+  while (!astar.IsEmpty()) {
+    const GridPoint node = astar.Pop();
+    if (node == goal)
+      break;
+
+    const GridPoint neighbours[] = {
+      {node.x - 1, node.y}, {node.x + 1, node.y},
+      {node.x, node.y - 1}, {node.x, node.y + 1},
+    };
+
+    for (const auto n : neighbours)
+      if (n.x < SIZE && n.y < SIZE)
+        astar.Link(n, node,
+                   AStarPriorityValue(GetWeight(n), Heuristic(n, goal)));
+  }
+
+  const unsigned value = astar.GetNodeValue(goal).g;
+  if (value != BruteForce(start, goal))
+    return false;
+
+  /* walk the predecessors back to the start */
+  unsigned path_value = 0;
+  GridPoint p = goal;
+  for (unsigned i = 0; !(p == start); ++i) {
+    if (i > SIZE * SIZE)
+      return false;
+
+    path_value += GetWeight(p);
+    p = astar.GetPredecessor(p);
+  }
+
+  return path_value == value;
+}
+
+int
+main()
+{
+  plan_tests(4);
+
+  for (auto &row : weights)
+    for (auto &w : row)
+      w = 1 + Random() % 9;
+
+  GridAStar astar(64);
+
+  ok1(Search(astar, {0, 0}, {SIZE - 1, SIZE - 1}));
+  ok1(Search(astar, {SIZE - 1, 3}, {2, SIZE - 2}));
+
+  /* the second search of the same size reuses the memory of the
+     first one */
+  const std::size_t allocations_start = n_allocations;
+  const bool success = Search(astar, {0, 0}, {SIZE - 1, SIZE - 1});
+  const std::size_t allocations = n_allocations - allocations_start;
+
+  ok1(success);
+  ok1(allocations == 0);
+
+  return exit_status();
+}
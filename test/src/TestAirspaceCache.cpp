@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Airspace/AirspaceCache.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "io/StringOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/MemoryReader.hxx"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+#include <stdexcept>
+#include <string>
+
+static AirspaceAltitude
+MakeAltitude(AltitudeReference reference, double value)
+{
+  AirspaceAltitude altitude{};
+  altitude.reference = reference;
+  altitude.altitude = value;
+  altitude.flight_level = value / 30;
+  altitude.altitude_above_terrain = value / 2;
+  return altitude;
+}
+
+static std::vector<AirspacePtr>
+MakeAirspaces()
+{
+  std::vector<AirspacePtr> airspaces;
+
+  auto circle = std::make_shared<AirspaceCircle>(GeoPoint(Angle::Degrees(7),
+                                                          Angle::Degrees(51)),
+                                                 5000);
+  circle->SetProperties(_T("Circle"), CTR, _T("CTR"),
+                        MakeAltitude(AltitudeReference::AGL, 0),
+                        MakeAltitude(AltitudeReference::MSL, 1500));
+  circle->SetRadioFrequency(RadioFrequency::FromMegaKiloHertz(123, 450));
+  circle->SetDays(AirspaceActivity(3));
+  airspaces.push_back(std::move(circle));
+
+  std::vector<GeoPoint> points;
+  for (unsigned i = 0; i < 100; ++i)
+    points.emplace_back(Angle::Degrees(8 + (i % 10) * 0.01),
+                        Angle::Degrees(50 + (i / 10) * 0.01 + (i % 2) * 0.003));
+
+  auto polygon = std::make_shared<AirspacePolygon>(points);
+  polygon->SetProperties(_T("Polygon"), RESTRICT, _T(""),
+                         MakeAltitude(AltitudeReference::STD, 3000),
+                         MakeAltitude(AltitudeReference::STD, 6000));
+  polygon->SetRadioFrequency(RadioFrequency::Null());
+  airspaces.push_back(std::move(polygon));
+
+  return airspaces;
+}
+
+static bool
+Equals(const AirspaceAltitude &a, const AirspaceAltitude &b)
+{
+  return a.reference == b.reference && a.altitude == b.altitude &&
+    a.flight_level == b.flight_level &&
+    a.altitude_above_terrain == b.altitude_above_terrain;
+}
+
+static bool
+Equals(const AbstractAirspace &a, const AbstractAirspace &b)
+{
+  if (a.GetShape() != b.GetShape() || a.GetClass() != b.GetClass() ||
+      !StringIsEqual(a.GetName(), b.GetName()) ||
+      !StringIsEqual(a.GetType(), b.GetType()) ||
+      !Equals(a.GetBase(), b.GetBase()) || !Equals(a.GetTop(), b.GetTop()) ||
+      a.GetRadioFrequency() != b.GetRadioFrequency() ||
+      !a.GetDays().equals(b.GetDays()) ||
+      a.GetPoints().size() != b.GetPoints().size())
+    return false;
+
+  for (std::size_t i = 0; i < a.GetPoints().size(); ++i)
+    if (a.GetPoints()[i].GetLocation() != b.GetPoints()[i].GetLocation())
+      return false;
+
+  if (a.GetShape() == AbstractAirspace::Shape::CIRCLE) {
+    const auto &ca = static_cast<const AirspaceCircle &>(a);
+    const auto &cb = static_cast<const AirspaceCircle &>(b);
+    return ca.GetCenter() == cb.GetCenter() &&
+      ca.GetRadius() == cb.GetRadius();
+  }
+
+  return true;
+}
+
+static std::string
+Save(const std::vector<AirspacePtr> &airspaces, std::string_view key)
+{
+  StringOutputStream sos;
+  BufferedOutputStream bos(sos);
+  SaveAirspaceCache(bos, key, airspaces);
+  bos.Flush();
+  return sos.GetValue();
+}
+
+static std::vector<AirspacePtr>
+Load(std::string_view data, std::string_view key)
+{
+  MemoryReader reader(std::as_bytes(std::span{data}));
+  BufferedReader br(reader);
+  return LoadAirspaceCache(br, key);
+}
+
+static bool
+Throws(std::string_view data, std::string_view key)
+{
+  try {
+    Load(data, key);
+    return false;
+  } catch (const std::runtime_error &) {
+    return true;
+  }
+}
+
+int
+main()
+{
+  plan_tests(7);
+
+  const auto airspaces = MakeAirspaces();
+  const std::string data = Save(airspaces, "/path/airspace.txt");
+
+  const auto loaded = Load(data, "/path/airspace.txt");
+  ok1(loaded.size() == airspaces.size());
+  ok1(Equals(*loaded[0], *airspaces[0]));
+  ok1(Equals(*loaded[1], *airspaces[1]));
+
+  /* the snapshot of another file is refused */
+  ok1(Throws(data, "/path/other.txt"));
+
+  /* malformed snapshots */
+  ok1(Throws(std::string_view{data}.substr(0, data.size() - 1),
+             "/path/airspace.txt"));
+
+  std::string bad_version = data;
+  bad_version[0] ^= 0x40;
+  ok1(Throws(bad_version, "/path/airspace.txt"));
+
+  /* an empty list */
+  ok1(Load(Save({}, "x"), "x").empty());
+
+  return exit_status();
+}
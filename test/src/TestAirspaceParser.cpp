@@ -11,6 +11,8 @@
 #include "util/StringAPI.hxx"
 #include "util/PrintException.hxx"
 #include "io/FileLineReader.hpp"
+#include "io/FileMapping.hpp"
+#include "util/UTF8.hpp"
 #include "Operation/Operation.hpp"
 #include "TestUtil.hpp"
 
@@ -284,13 +286,112 @@ TestOpenAirExtended()
   }
 }
 
+[[gnu::pure]]
+static bool
+Equals(const AbstractAirspace &a, const AbstractAirspace &b) noexcept
+{
+  if (a.GetShape() != b.GetShape() || a.GetClass() != b.GetClass() ||
+      !StringIsEqual(a.GetName(), b.GetName()) ||
+      !StringIsEqual(a.GetType(), b.GetType()) ||
+      a.GetBase().altitude != b.GetBase().altitude ||
+      a.GetTop().altitude != b.GetTop().altitude ||
+      a.GetPoints().size() != b.GetPoints().size())
+    return false;
+
+  for (std::size_t i = 0; i < a.GetPoints().size(); ++i)
+    if (a.GetPoints()[i].GetLocation() != b.GetPoints()[i].GetLocation())
+      return false;
+
+  return true;
+}
+
+/**
+ * Does parsing the mapped file give the same airspaces as the
+ * #TLineReader?
+ */
+static bool
+TestMapped(Path path)
+try {
+  Airspaces expected;
+  FileLineReader reader(path, Charset::AUTO);
+  NullOperationEnvironment operation;
+  ParseAirspaceFile(expected, reader, operation);
+  expected.Optimise();
+
+  const FileMapping mapping(path);
+  const std::span<const std::byte> raw = mapping;
+  const std::string_view data{(const char *)raw.data(), raw.size()};
+  if (!ValidateUTF8(data))
+    return false;
+
+  Airspaces airspaces;
+  ParseAirspaceFile(airspaces, data, operation);
+  airspaces.Optimise();
+
+  if (airspaces.GetSize() != expected.GetSize())
+    return false;
+
+  /* the airspaces were added in the same order */
+  auto i = expected.QueryAll().begin();
+  for (const auto &as : airspaces.QueryAll())
+    if (!Equals(as.GetAirspace(), (i++)->GetAirspace()))
+      return false;
+
+  return true;
+} catch (...) {
+  PrintException(std::current_exception());
+  return false;
+}
+
+static void
+TestInMemory()
+{
+  ok1(TestMapped(Path(_T("test/data/airspace/openair.txt"))));
+  ok1(TestMapped(Path(_T("test/data/airspace/tnp.sua"))));
+  ok1(TestMapped(Path(_T("test/data/airspace/openair_extended.txt"))));
+
+  /* the same errors as with the line reader */
+  Airspaces airspaces;
+  NullOperationEnvironment operation;
+
+  try {
+    ParseAirspaceFile(airspaces, "\xef\xbb\xbfHello\nWorld\n", operation);
+    ok1(false);
+  } catch (const std::runtime_error &) {
+    ok1(true);
+  }
+
+  try {
+    ParseAirspaceFile(airspaces, "AC R\nAN Test\nDP 51:00:00 N 007:00:00 E\n",
+                      operation);
+    ok1(false);
+  } catch (const std::runtime_error &) {
+    ok1(true);
+  }
+
+  ParseAirspaceFile(airspaces,
+                    "\xef\xbb\xbf* comment\r\n"
+                    "AC R\r\n"
+                    "AN Test \r\n"
+                    "AL GND\r\n"
+                    "AH 1000ft\r\n"
+                    "V X=51:00:00 N 007:00:00 E\r\n"
+                    "DC 2",
+                    operation);
+  airspaces.Optimise();
+  ok1(airspaces.GetSize() == 1);
+  ok1(StringIsEqual(airspaces.QueryAll().begin()->GetAirspace().GetName(),
+                    _T("Test")));
+}
+
 int main()
 try {
-  plan_tests(109);
+  plan_tests(116);
 
   TestOpenAir();
   TestTNP();
   TestOpenAirExtended();
+  TestInMemory();
 
   return exit_status();
 } catch (const std::runtime_error &e) {
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Geo/GeoVector.hpp"
+#include "Task/Stats/TaskStats.hpp"
+#include "thread/ThreadPool.hpp"
+#include "TestUtil.hpp"
+
+#include <memory>
+
+static const GeoPoint origin(Angle::Degrees(7), Angle::Degrees(51));
+
+static AirspaceAltitude
+MakeAltitude(AltitudeReference reference, double value)
+{
+  AirspaceAltitude altitude{};
+  altitude.reference = reference;
+  altitude.altitude = value;
+  return altitude;
+}
+
+/**
+ * Airspaces along the parallel of #origin, some of which overlap,
+ * and some with a base above the aircraft.
+ */
+static void
+MakeAirspaces(Airspaces &airspaces)
+{
+  for (unsigned i = 0; i < 20; ++i) {
+    const GeoPoint center(origin.longitude + Angle::Degrees(0.02 * i),
+                          origin.latitude + Angle::Degrees(0.003 * (i % 3)));
+    auto circle = std::make_shared<AirspaceCircle>(center, 500 + 100 * (i % 4));
+    circle->SetProperties(_T("Circle"), i % 2 ? CTR : RESTRICT, _T(""),
+                          MakeAltitude(AltitudeReference::MSL, 200 * (i % 5)),
+                          MakeAltitude(AltitudeReference::MSL, 3000));
+    airspaces.Add(std::move(circle));
+  }
+
+  std::vector<GeoPoint> points;
+  points.emplace_back(origin.longitude + Angle::Degrees(0.1),
+                      origin.latitude - Angle::Degrees(0.01));
+  points.emplace_back(origin.longitude + Angle::Degrees(0.3),
+                      origin.latitude - Angle::Degrees(0.01));
+  points.emplace_back(origin.longitude + Angle::Degrees(0.3),
+                      origin.latitude + Angle::Degrees(0.01));
+  points.emplace_back(origin.longitude + Angle::Degrees(0.1),
+                      origin.latitude + Angle::Degrees(0.01));
+  auto polygon = std::make_shared<AirspacePolygon>(points);
+  polygon->SetProperties(_T("Polygon"), DANGER, _T(""),
+                         MakeAltitude(AltitudeReference::MSL, 0),
+                         MakeAltitude(AltitudeReference::MSL, 1500));
+  airspaces.Add(std::move(polygon));
+
+  airspaces.Optimise();
+}
+
+static bool
+Equals(const AirspaceWarningManager &a, const AirspaceWarningManager &b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (auto i = a.begin(), j = b.begin(); i != a.end(); ++i, ++j) {
+    if (&i->GetAirspace() != &j->GetAirspace() ||
+        i->GetWarningState() != j->GetWarningState() ||
+        i->GetSolution().elapsed_time != j->GetSolution().elapsed_time ||
+        i->GetSolution().distance != j->GetSolution().distance)
+      return false;
+  }
+
+  return true;
+}
+
+int
+main()
+{
+  plan_tests(4);
+
+  Airspaces airspaces;
+  MakeAirspaces(airspaces);
+
+  AirspaceWarningConfig config;
+  config.SetDefaults();
+
+  AircraftState state;
+  state.Reset();
+  state.time = TimeStamp{FloatDuration{36000}};
+  state.location = GeoPoint(origin.longitude - Angle::Degrees(0.02),
+                            origin.latitude);
+  state.altitude = 500;
+  state.ground_speed = state.true_airspeed = 30;
+  state.vario = 0.5;
+  state.track = Angle::QuarterCircle();
+  state.flying = true;
+
+  const GlidePolar glide_polar(1);
+
+  /* a slow task leg towards the east, which lets the task
+     prediction reject far airspaces */
+  TaskStats task_stats{};
+  task_stats.task_valid = true;
+  task_stats.current_leg.location_remaining =
+    GeoPoint(origin.longitude + Angle::Degrees(1), origin.latitude);
+
+  GlideResult &leg_solution = task_stats.current_leg.solution_remaining;
+  leg_solution.validity = GlideResult::Validity::OK;
+  leg_solution.height_climb = 0;
+  leg_solution.height_glide = 300;
+
+  /* the reference runs the predictions one after another */
+  AirspaceWarningManager serial(config, airspaces);
+  serial.Reset(state);
+
+  /* this one runs them in reverse order */
+  AirspaceWarningManager reverse(config, airspaces);
+  reverse.SetForEach([](std::size_t n,
+                        const std::function<void(std::size_t)> &f){
+    for (std::size_t i = n; i-- > 0;)
+      f(i);
+  });
+  reverse.Reset(state);
+
+  /* this one runs them concurrently */
+  ThreadPool pool("Test", 3);
+  AirspaceWarningManager parallel(config, airspaces);
+  parallel.SetForEach([&pool](std::size_t n,
+                              const std::function<void(std::size_t)> &f){
+    pool.ForEach(n, f);
+  });
+  parallel.Reset(state);
+
+  bool equal = true, found = false, inside = false;
+
+  for (unsigned i = 0; i < 1200; ++i) {
+    const bool circling = (i / 100) % 2;
+    constexpr std::chrono::duration<unsigned> dt{1};
+
+    leg_solution.vector = GeoVector(state.location,
+                                    task_stats.current_leg.location_remaining);
+    leg_solution.time_elapsed = FloatDuration{leg_solution.vector.distance / 15};
+
+    serial.Update(state, glide_polar, task_stats, circling, dt);
+    reverse.Update(state, glide_polar, task_stats, circling, dt);
+    parallel.Update(state, glide_polar, task_stats, circling, dt);
+
+    if (!Equals(serial, reverse) || !Equals(serial, parallel))
+      equal = false;
+
+    if (!serial.empty())
+      found = true;
+
+    for (const auto &w : serial)
+      if (w.GetWarningState() == AirspaceWarning::WARNING_INSIDE)
+        inside = true;
+
+    state = state.GetPredictedState(FloatDuration{1});
+    state.time += FloatDuration{1};
+  }
+
+  ok1(found);
+  ok1(inside);
+  ok1(equal);
+  ok1(serial.GetSerial() == parallel.GetSerial());
+
+  return exit_status();
+}
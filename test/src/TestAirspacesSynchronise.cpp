@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/Predicate/AirspacePredicate.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <set>
+
+static const GeoPoint origin(Angle::Degrees(7), Angle::Degrees(51));
+
+/**
+ * A row of small circles along the parallel of #origin, one every
+ * 0.1 degrees of longitude.
+ */
+static void
+MakeRow(Airspaces &airspaces)
+{
+  for (unsigned i = 0; i < 50; ++i) {
+    const GeoPoint center(origin.longitude + Angle::Degrees(0.1 * i),
+                          origin.latitude);
+    airspaces.Add(std::make_shared<AirspaceCircle>(center, 1000));
+  }
+
+  airspaces.Optimise();
+}
+
+static std::set<const AbstractAirspace *>
+GetContents(const Airspaces &airspaces)
+{
+  std::set<const AbstractAirspace *> result;
+  for (const auto &i : airspaces.QueryAll())
+    result.insert(&i.GetAirspace());
+  return result;
+}
+
+static std::set<const AbstractAirspace *>
+GetContents(const Airspaces &master, const GeoPoint &location, double range)
+{
+  std::set<const AbstractAirspace *> result;
+  for (const auto &i : master.QueryWithinRange(location, range))
+    result.insert(&i.GetAirspace());
+  return result;
+}
+
+int
+main()
+{
+  plan_tests(15);
+
+  Airspaces master;
+  MakeRow(master);
+  ok1(master.GetSize() == 50);
+
+  /* a small batch is inserted into the bulk-loaded tree */
+  const GeoPoint extra_center(origin.longitude,
+                              origin.latitude + Angle::Degrees(0.1));
+  master.Add(std::make_shared<AirspaceCircle>(extra_center, 1000));
+  master.Optimise();
+  ok1(master.GetSize() == 51);
+  ok1(GetContents(master, extra_center, 100).size() == 1);
+
+  Airspaces local;
+  constexpr double range = 10000;
+
+  GeoPoint location = origin;
+  ok1(local.SynchroniseInRange(master, location, range, AirspacePredicateTrue));
+  ok1(!local.IsEmpty());
+  ok1(GetContents(local) == GetContents(master, location, range));
+
+  /* no change: no new serial */
+  Serial serial = local.GetSerial();
+  ok1(!local.SynchroniseInRange(master, location, range, AirspacePredicateTrue));
+  ok1(local.GetSerial() == serial);
+
+  /* a small move east: some airspaces enter and leave the range */
+  location.longitude += Angle::Degrees(0.3);
+  ok1(local.SynchroniseInRange(master, location, range, AirspacePredicateTrue));
+  ok1(local.GetSerial() != serial);
+  ok1(GetContents(local) == GetContents(master, location, range));
+
+  /* the result does not depend on the history */
+  Airspaces fresh;
+  fresh.SynchroniseInRange(master, location, range, AirspacePredicateTrue);
+  ok1(GetContents(local) == GetContents(fresh));
+
+  /* the predicate removes airspaces */
+  serial = local.GetSerial();
+  ok1(local.SynchroniseInRange(master, location, range,
+                               [](const AbstractAirspace &){ return false; }));
+  ok1(local.IsEmpty());
+  ok1(local.GetSerial() != serial);
+
+  return exit_status();
+}
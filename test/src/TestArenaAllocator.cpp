@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "util/ArenaAllocator.hpp"
+#include "TestUtil.hpp"
+
+#include <cstdint>
+#include <string>
+
+struct Object {
+  double value;
+  std::string name;
+
+  Object(double _value, const char *_name) noexcept
+    :value(_value), name(_name) {}
+};
+
+static void
+TestAllocate()
+{
+  Arena arena;
+
+  /* consecutive allocations are adjacent */
+  auto *a = static_cast<std::byte *>(arena.Allocate(24, 8));
+  auto *b = static_cast<std::byte *>(arena.Allocate(24, 8));
+  ok1(b == a + 24);
+  ok1(arena.GetChunkCount() == 1);
+
+  /* alignment */
+  auto *c = arena.Allocate(1, 1);
+  auto *d = arena.Allocate(8, 8);
+  ok1(c == b + 24);
+  ok1(reinterpret_cast<std::uintptr_t>(d) % 8 == 0);
+
+  /* a large object gets its own chunk and does not waste the
+     current one */
+  auto *large = static_cast<std::byte *>(arena.Allocate(100000, 8));
+  ok1(large != nullptr);
+  ok1(arena.GetChunkCount() == 2);
+  auto *e = arena.Allocate(8, 8);
+  ok1(e == static_cast<std::byte *>(d) + 8);
+
+  /* fill the first chunk */
+  for (unsigned i = 0; i < 10000; ++i)
+    arena.Allocate(16, 8);
+  ok1(arena.GetChunkCount() > 3);
+}
+
+static void
+TestSharedPtr()
+{
+  std::shared_ptr<const Object> a, b;
+
+  {
+    auto arena = std::make_shared<Arena>();
+    const ArenaAllocator<Object> allocator{arena};
+    a = std::allocate_shared<Object>(allocator, 1., "a");
+    b = std::allocate_shared<Object>(allocator, 2., "a long name which is not inline");
+    /* the local variable, the allocator and one per object */
+    ok1(arena.use_count() == 4);
+  }
+
+  /* the objects keep the arena alive */
+  ok1(a->value == 1);
+  ok1(a->name == "a");
+  ok1(b->name == "a long name which is not inline");
+
+  a.reset();
+  ok1(b->value == 2);
+  b.reset();
+}
+
+int
+main()
+{
+  plan_tests(13);
+
+  TestAllocate();
+  TestSharedPtr();
+
+  return exit_status();
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "io/AsyncFileWriter.hpp"
+#include "io/BufferedOutputStream.hxx"
+#include "io/FileReader.hxx"
+#include "system/Path.hpp"
+#include "system/FileUtil.hpp"
+#include "util/PrintException.hxx"
+#include "util/SpanCast.hxx"
+#include "TestUtil.hpp"
+
+#include <string>
+
+#include <stdlib.h>
+
+static std::string
+ReadFile(Path path)
+{
+  FileReader reader(path);
+
+  std::string result;
+  char buffer[4096];
+  std::size_t nbytes;
+  while ((nbytes = reader.Read(buffer, sizeof(buffer))) > 0)
+    result.append(buffer, nbytes);
+
+  return result;
+}
+
+static void
+TestFlush(Path path)
+{
+  AsyncFileWriter writer(path, FileOutputStream::Mode::CREATE_VISIBLE,
+                         std::chrono::milliseconds(10));
+
+  writer.Write(AsBytes(std::string_view{"foo\n"}));
+  writer.Flush();
+  ok1(ReadFile(path) == "foo\n");
+
+  writer.Write(AsBytes(std::string_view{"bar\n"}));
+  writer.Sync();
+  ok1(ReadFile(path) == "foo\nbar\n");
+
+  /* the destructor writes the rest */
+  writer.Write(AsBytes(std::string_view{"baz\n"}));
+}
+
+static void
+TestLarge(Path path)
+{
+  std::string expected;
+
+  {
+    AsyncFileWriter writer(path, FileOutputStream::Mode::APPEND_EXISTING);
+    BufferedOutputStream os(writer);
+
+    /* more than the writer buffers, to exercise throttling */
+    for (unsigned i = 0; i < 100000; ++i) {
+      os.Fmt("B{:06}\n", i);
+      expected += "B";
+      expected += std::to_string(1000000 + i).substr(1);
+      expected += "\n";
+    }
+
+    os.Flush();
+    writer.Commit();
+  }
+
+  ok1(ReadFile(path) == "foo\nbar\nbaz\n" + expected);
+}
+
+int
+main()
+try {
+  plan_tests(4);
+
+  const Path path("output/TestAsyncFileWriter.txt");
+  File::Delete(path);
+
+  TestFlush(path);
+  ok1(ReadFile(path) == "foo\nbar\nbaz\n");
+
+  TestLarge(path);
+
+  File::Delete(path);
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
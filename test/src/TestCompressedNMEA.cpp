@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Logger/CompressedNMEA.hpp"
+#include "io/FileOutputStream.hxx"
+#include "system/Path.hpp"
+#include "system/FileUtil.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+
+using namespace std::chrono;
+
+static constexpr const char *lines[] = {
+  "$GPRMC,082310,A,5103.5403,N,00741.5742,E,055.3,022.4,230610,000.0,W*7E",
+  "$PGRMZ,2447,F,2*0F",
+  "",
+  "$LXWP0,Y,222.3,1665.5,1.71,,,,,,239,174,10.1*47",
+  "$GPGGA,082311,5103.5403,N,00741.5742,E,1,12,1.0,100.0,M,0.0,M,,*6E",
+};
+
+static void
+Write(Path path, bool finish)
+{
+  FileOutputStream file(path, FileOutputStream::Mode::CREATE_VISIBLE);
+  CompressedNMEAWriter writer(file,
+                              system_clock::time_point{seconds{1277281390}});
+
+  CompressedNMEA::Duration time{};
+  for (const char *line : lines) {
+    writer.Write(time, line);
+    time += milliseconds(50);
+  }
+
+  /* this one triggers a flush, so it is kept even if the stream is
+     not finished */
+  writer.Write(CompressedNMEA::Duration{seconds{20}}, "$PFLAU,3,1,2,1*4E");
+
+  /* this one is lost if the stream is not finished */
+  writer.Write(CompressedNMEA::Duration{seconds{21}}, "$PFLAA,0,0,0*00");
+
+  if (finish)
+    writer.Finish();
+
+  file.Commit();
+}
+
+static void
+TestRead(Path path, bool finished)
+{
+  CompressedNMEAReader reader(path);
+  ok1(reader.GetStartTime() == system_clock::time_point{seconds{1277281390}});
+
+  bool lines_ok = true;
+  CompressedNMEA::Duration time{};
+  for (const char *expected : lines) {
+    const char *line = reader.ReadLine();
+    if (line == nullptr || !StringIsEqual(line, expected) ||
+        reader.GetTime() != time)
+      lines_ok = false;
+    time += milliseconds(50);
+  }
+
+  ok1(lines_ok);
+
+  const char *line = reader.ReadLine();
+  ok1(line != nullptr && StringIsEqual(line, "$PFLAU,3,1,2,1*4E"));
+  ok1(reader.GetTime() == CompressedNMEA::Duration{seconds{20}});
+
+  line = reader.ReadLine();
+  if (finished)
+    ok1(line != nullptr && StringIsEqual(line, "$PFLAA,0,0,0*00"));
+  else
+    ok1(line == nullptr);
+
+  ok1(reader.ReadLine() == nullptr);
+}
+
+int
+main()
+try {
+  plan_tests(12);
+
+  const Path path("output/TestCompressedNMEA.nmz");
+
+  Write(path, true);
+  TestRead(path, true);
+
+  /* a log which was not finished, e.g. after a crash */
+  Write(path, false);
+  TestRead(path, false);
+
+  File::Delete(path);
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
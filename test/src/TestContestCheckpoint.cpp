@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Computer/ContestCheckpoint.hpp"
+#include "Engine/Contest/ContestManager.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "io/StringOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/MemoryReader.hxx"
+#include "TestUtil.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace std::chrono;
+
+/**
+ * A flight of two hours along an out-and-return course with
+ * wiggles.
+ */
+static void
+FillTrace(Trace &trace)
+{
+  static constexpr GeoPoint start{Angle::Degrees(7), Angle::Degrees(51)};
+  static constexpr GeoPoint turn{Angle::Degrees(7.8), Angle::Degrees(51.3)};
+
+  static constexpr unsigned N = 600;
+  for (unsigned i = 0; i < N; ++i) {
+    const double f = 2. * i / N;
+    GeoPoint p = f < 1
+      ? start.Interpolate(turn, f)
+      : turn.Interpolate(start, f - 1);
+    p.latitude += Angle::Degrees(0.01 * std::sin(i * 0.3));
+
+    trace.push_back(TracePoint(p, duration<unsigned>(12 * i),
+                               1000 + 400 * std::sin(i * 0.05), 0, 0));
+  }
+}
+
+static std::string
+Save(const ContestCheckpoint &checkpoint)
+{
+  StringOutputStream sos;
+  BufferedOutputStream bos(sos);
+  SaveContestCheckpoint(bos, checkpoint);
+  bos.Flush();
+  return sos.GetValue();
+}
+
+static ContestCheckpoint
+Load(std::string_view data)
+{
+  MemoryReader reader(std::as_bytes(std::span{data}));
+  BufferedReader br(reader);
+  return LoadContestCheckpoint(br);
+}
+
+static bool
+Throws(std::string_view data)
+{
+  try {
+    Load(data);
+    return false;
+  } catch (const std::runtime_error &) {
+    return true;
+  }
+}
+
+static bool
+Equals(const ContestResult &a, const ContestResult &b) noexcept
+{
+  return a.score == b.score && a.distance == b.distance &&
+    a.time == b.time;
+}
+
+int
+main()
+{
+  plan_tests(11);
+
+  Trace trace;
+  FillTrace(trace);
+
+  ContestManager manager(Contest::OLC_PLUS, trace, trace, trace);
+  manager.SolveExhaustive();
+
+  ContestCheckpoint checkpoint;
+  checkpoint.contest = Contest::OLC_PLUS;
+  checkpoint.date = BrokenDate(2024, 6, 1);
+  trace.GetPoints(checkpoint.trace);
+  checkpoint.stats = manager.GetStats();
+
+  const std::string data = Save(checkpoint);
+  const auto loaded = Load(data);
+  ok1(loaded.contest == Contest::OLC_PLUS);
+  ok1(loaded.date == checkpoint.date);
+  ok1(loaded.trace.size() == checkpoint.trace.size() &&
+      loaded.trace.back().GetTime() == checkpoint.trace.back().GetTime() &&
+      loaded.trace.back().GetLocation() ==
+      checkpoint.trace.back().GetLocation());
+  ok1(Equals(loaded.stats.GetResult(0), checkpoint.stats.GetResult(0)) &&
+      loaded.stats.GetSolution(0).size() ==
+      checkpoint.stats.GetSolution(0).size());
+
+  /* only the same flight may be resumed, shortly after the program
+     was stopped */
+  const auto last = checkpoint.trace.back().GetTime();
+  ok1(loaded.IsResumable(checkpoint.date, last + minutes{5}));
+  ok1(!loaded.IsResumable(BrokenDate(2024, 6, 2), last + minutes{5}));
+  ok1(!loaded.IsResumable(checkpoint.date, last + hours{1}));
+  ok1(!loaded.IsResumable(checkpoint.date, last - minutes{1}));
+
+  /* malformed checkpoints */
+  ok1(Throws(std::string_view{data}.substr(0, data.size() - 1)));
+  ok1(Throws(std::string_view{data}.substr(1)));
+
+  /* a restored manager keeps the result until it finds a better
+     one */
+  ContestManager restored(Contest::OLC_PLUS, trace, trace, trace);
+  restored.Restore(loaded.stats);
+  ok1(Equals(restored.GetStats().GetResult(0),
+             checkpoint.stats.GetResult(0)));
+
+  return exit_status();
+}
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Contest/ContestManager.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "thread/ThreadPool.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+
+using namespace std::chrono;
+
+/**
+ * A flight of three hours along a triangle with wiggles, so the
+ * free distance, triangle and out-and-return solvers all find
+ * something.
+ */
+static void
+FillTrace(Trace &trace)
+{
+  static constexpr GeoPoint corners[] = {
+    {Angle::Degrees(7), Angle::Degrees(51)},
+    {Angle::Degrees(7.9), Angle::Degrees(51.2)},
+    {Angle::Degrees(7.4), Angle::Degrees(51.7)},
+    {Angle::Degrees(7), Angle::Degrees(51)},
+  };
+
+  static constexpr unsigned N = 1000;
+  for (unsigned i = 0; i < N; ++i) {
+    const double t = 3. * i / N;
+    const unsigned leg = std::min(unsigned(t), 2u);
+    const double f = t - leg;
+
+    GeoPoint p = corners[leg].Interpolate(corners[leg + 1], f);
+    p.latitude += Angle::Degrees(0.02 * std::sin(i * 0.3));
+
+    trace.push_back(TracePoint(p, duration<unsigned>(10 * i),
+                               1000 + 500 * std::sin(i * 0.05), 0, 0));
+  }
+}
+
+static bool
+operator==(const ContestResult &a, const ContestResult &b) noexcept
+{
+  return a.score == b.score && a.distance == b.distance &&
+    a.time == b.time;
+}
+
+/**
+ * Solve the contest exhaustively, optionally with the given
+ * #ContestManager::ForEachFunction.
+ */
+static ContestStatistics
+Solve(const Trace &trace, Contest contest,
+      ContestManager::ForEachFunction &&for_each)
+{
+  ContestManager manager(contest, trace, trace, trace);
+  if (for_each)
+    manager.SetForEach(std::move(for_each));
+
+  manager.SolveExhaustive();
+  return manager.GetStats();
+}
+
+static bool
+Compare(const ContestStatistics &a, const ContestStatistics &b) noexcept
+{
+  for (unsigned i = 0; i < ContestStatistics::N; ++i)
+    if (!(a.result[i] == b.result[i]) ||
+        a.solution[i].size() != b.solution[i].size())
+      return false;
+
+  return true;
+}
+
+/**
+ * The independent solvers may run in any order or concurrently; the
+ * result must be the same as running them serially.
+ */
+static void
+TestParallel(const Trace &trace, ThreadPool &pool, Contest contest,
+             unsigned n_results)
+{
+  const auto expected = Solve(trace, contest, {});
+
+  bool defined = true;
+  for (unsigned i = 0; i < n_results; ++i)
+    if (!expected.result[i].IsDefined())
+      defined = false;
+  ok1(defined);
+
+  ok1(Compare(Solve(trace, contest,
+                    [](std::size_t n,
+                       const std::function<void(std::size_t)> &f){
+                      for (std::size_t i = n; i-- > 0;)
+                        f(i);
+                    }),
+              expected));
+
+  ok1(Compare(Solve(trace, contest,
+                    [&pool](std::size_t n,
+                            const std::function<void(std::size_t)> &f){
+                      pool.ForEach(n, f);
+                    }),
+              expected));
+}
+
+int
+main()
+{
+  plan_tests(12);
+
+  Trace trace;
+  FillTrace(trace);
+
+  ThreadPool pool("Test", 2);
+
+  TestParallel(trace, pool, Contest::OLC_PLUS, 3);
+  TestParallel(trace, pool, Contest::XCONTEST, 2);
+  TestParallel(trace, pool, Contest::DHV_XC, 2);
+  TestParallel(trace, pool, Contest::WEGLIDE_FREE, 4);
+
+  return exit_status();
+}
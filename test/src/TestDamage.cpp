@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ui/canvas/memory/Damage.hpp"
+#include "TestUtil.hpp"
+
+#include <array>
+#include <cstdint>
+
+static constexpr unsigned WIDTH = 40, HEIGHT = 100, PITCH = 48;
+
+using Frame = std::array<uint8_t, PITCH * HEIGHT>;
+
+static constexpr bool
+Equals(const PixelRect &r, int left, int top, int right, int bottom) noexcept
+{
+  return r.left == left && r.top == top &&
+    r.right == right && r.bottom == bottom;
+}
+
+static void
+TestUnchanged()
+{
+  Frame a{}, b{};
+
+  /* the padding at the end of each row is ignored */
+  b[WIDTH] = 0xff;
+
+  std::array<PixelRect, 4> damage;
+  ok1(FindDamage(damage, a.data(), b.data(), PITCH, WIDTH, HEIGHT, 1) == 0);
+}
+
+static void
+TestRegions()
+{
+  Frame a{}, b{};
+
+  /* two pixels in adjacent rows: one rectangle */
+  b[10 * PITCH + 5] = 1;
+  b[12 * PITCH + 20] = 1;
+
+  /* a distant row */
+  b[80 * PITCH + 39] = 1;
+
+  std::array<PixelRect, 4> damage;
+  ok1(FindDamage(damage, a.data(), b.data(), PITCH, WIDTH, HEIGHT, 1) == 2);
+  ok1(Equals(damage[0], 5, 10, 21, 13));
+  ok1(Equals(damage[1], 39, 80, 40, 81));
+
+  /* without merging, the first two are separate */
+  ok1(FindDamage(damage, a.data(), b.data(), PITCH, WIDTH, HEIGHT, 1, 0) == 3);
+  ok1(Equals(damage[0], 5, 10, 6, 11));
+  ok1(Equals(damage[1], 20, 12, 21, 13));
+
+  /* too many regions: the last one grows */
+  std::array<PixelRect, 2> small;
+  ok1(FindDamage(small, a.data(), b.data(), PITCH, WIDTH, HEIGHT, 1, 0) == 2);
+  ok1(Equals(small[0], 5, 10, 6, 11));
+  ok1(Equals(small[1], 20, 12, 40, 81));
+}
+
+static void
+TestBytesPerPixel()
+{
+  Frame a{}, b{};
+
+  /* 2 bytes per pixel: 20 pixels per row; byte 11 is in pixel 5 */
+  b[3 * PITCH + 11] = 1;
+
+  std::array<PixelRect, 4> damage;
+  ok1(FindDamage(damage, a.data(), b.data(), PITCH, WIDTH / 2, HEIGHT, 2) == 1);
+  ok1(Equals(damage[0], 5, 3, 6, 4));
+}
+
+int
+main()
+{
+  plan_tests(12);
+
+  TestUnchanged();
+  TestRegions();
+  TestBytesPerPixel();
+
+  return exit_status();
+}
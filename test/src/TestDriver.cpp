@@ -230,9 +230,32 @@ TestFLARM()
     ok1(traffic->climb_rate_received);
     ok1(traffic->type == FlarmTraffic::AircraftType::AIRSHIP);
     ok1(!traffic->stealth);
+    ok1(traffic->source == FlarmTraffic::Source::FLARM);
   } else {
-    skip(15, 0, "traffic == NULL");
+    skip(16, 0, "traffic == NULL");
   }
+
+  /* ADS-B targets go to a separate list */
+  ok1(parser.ParseLine("$PFLAA,0,2000,1000,300,1,4B1234,90,0,120,0.0,9,0,1,-80*20",
+                       nmea_info));
+  ok1(nmea_info.flarm.traffic.GetActiveTrafficCount() == 3);
+  ok1(nmea_info.flarm.adsb_traffic.GetActiveTrafficCount() == 1);
+
+  id = FlarmId::Parse("4B1234", NULL);
+  traffic = nmea_info.flarm.adsb_traffic.FindTraffic(id);
+  ok1(traffic != NULL && traffic->source == FlarmTraffic::Source::ADSB);
+
+  /* far away ADS-B targets are dropped */
+  ok1(parser.ParseLine("$PFLAA,0,50000,0,300,1,4B5678,90,0,220,0.0,9,0,1*24",
+                       nmea_info));
+  ok1(nmea_info.flarm.adsb_traffic.GetActiveTrafficCount() == 1);
+
+  /* an ADS-B target with an alarm moves to the FLARM list */
+  ok1(parser.ParseLine("$PFLAA,2,2000,1000,300,1,4B1234,90,0,120,0.0,9,0,1*2b",
+                       nmea_info));
+  ok1(nmea_info.flarm.adsb_traffic.GetActiveTrafficCount() == 0);
+  ok1(nmea_info.flarm.traffic.GetActiveTrafficCount() == 4);
+  ok1(nmea_info.flarm.traffic.FindTraffic(id) != NULL);
 }
 
 static void
@@ -1631,7 +1654,7 @@ TestFlightList(const struct DeviceRegister &driver)
 
 int main()
 {
-  plan_tests(843);
+  plan_tests(858);
 
   TestGeneric();
   TestTasman();
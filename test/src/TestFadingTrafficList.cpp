@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FLARM/FadingList.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+static FlarmTraffic
+MakeTraffic(uint32_t value)
+{
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%06X", value);
+
+  FlarmTraffic traffic;
+  traffic.Clear();
+  traffic.id = FlarmId::Parse(buffer, nullptr);
+  traffic.valid.Update(TimeStamp{std::chrono::seconds{value}});
+  return traffic;
+}
+
+int main()
+{
+  plan_tests(10);
+
+  FadingTrafficList list;
+  list.Clear();
+  ok1(list.IsEmpty());
+
+  list.Add(MakeTraffic(1));
+  list.Add(MakeTraffic(2));
+  list.Add(MakeTraffic(1));
+  ok1(list.size() == 2);
+  ok1(list.Find(MakeTraffic(2).id) != nullptr);
+  ok1(list.Find(MakeTraffic(3).id) == nullptr);
+
+  /* when full, the oldest one is discarded */
+  for (unsigned i = 3; i <= FadingTrafficList::MAX_COUNT + 1; ++i)
+    list.Add(MakeTraffic(i));
+
+  ok1(list.size() == FadingTrafficList::MAX_COUNT);
+  ok1(list.Find(MakeTraffic(1).id) == nullptr);
+  ok1(list.Find(MakeTraffic(2).id) != nullptr);
+  ok1(list.begin()->id == MakeTraffic(2).id);
+
+  /* the order of the remaining ones is preserved */
+  list.RemoveIf([](const FlarmTraffic &traffic){
+    return traffic.valid.IsOlderThan(TimeStamp{std::chrono::seconds{100}},
+                                     std::chrono::seconds{70});
+  });
+
+  ok1(list.size() == FadingTrafficList::MAX_COUNT + 1 - 30 + 1);
+  ok1(list.begin()->id == MakeTraffic(30).id);
+
+  return exit_status();
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FLARM/Calculations.hpp"
+#include "FLARM/List.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+static FlarmId
+MakeId(uint32_t value)
+{
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%06X", value);
+  return FlarmId::Parse(buffer, nullptr);
+}
+
+static FlarmTraffic &
+Add(TrafficList &list, uint32_t id, bool altitude_available)
+{
+  FlarmTraffic &traffic = *list.AllocateTraffic(MakeId(id));
+  traffic.altitude_available = altitude_available;
+  traffic.altitude = RoughAltitude(1000);
+  /* the climb rate used by Climb() */
+  traffic.climb_rate = id;
+  return traffic;
+}
+
+static TimeStamp
+Seconds(unsigned s)
+{
+  return TimeStamp{std::chrono::seconds{s}};
+}
+
+/**
+ * Let each target climb with its FlarmTraffic::climb_rate.
+ */
+static void
+Climb(FlarmCalculations &calculations, TrafficList &list,
+      unsigned first, unsigned last)
+{
+  for (unsigned t = first; t <= last; ++t) {
+    for (auto &traffic : list.list)
+      traffic.altitude = RoughAltitude(1000. + t * traffic.climb_rate);
+
+    calculations.Average30s(list, Seconds(t));
+  }
+}
+
+int main()
+{
+  plan_tests(14);
+
+  FlarmCalculations calculations;
+  TrafficList list;
+  list.Clear();
+
+  Add(list, 3, true);
+  Add(list, 1, true);
+  Add(list, 2, false);
+
+  Climb(calculations, list, 1, 40);
+
+  ok1(calculations.size() == 2);
+  ok1(list.FindTraffic(MakeId(1))->climb_rate_avg30s_available);
+  ok1(equals(list.FindTraffic(MakeId(1))->climb_rate_avg30s, 1));
+  ok1(!list.FindTraffic(MakeId(2))->climb_rate_avg30s_available);
+  ok1(list.FindTraffic(MakeId(3))->climb_rate_avg30s_available);
+  ok1(equals(list.FindTraffic(MakeId(3))->climb_rate_avg30s, 3));
+
+  /* a new target before all others gets a fresh history */
+  Add(list, 0, true);
+  list.FindTraffic(MakeId(2))->altitude_available = true;
+  Climb(calculations, list, 41, 41);
+  ok1(calculations.size() == 4);
+  ok1(equals(list.FindTraffic(MakeId(0))->climb_rate_avg30s, 0));
+  ok1(equals(list.FindTraffic(MakeId(2))->climb_rate_avg30s, 0));
+  ok1(equals(list.FindTraffic(MakeId(1))->climb_rate_avg30s, 1));
+  ok1(equals(list.FindTraffic(MakeId(3))->climb_rate_avg30s, 3));
+
+  Climb(calculations, list, 42, 50);
+  ok1(equals(list.FindTraffic(MakeId(2))->climb_rate_avg30s, 2));
+
+  /* nothing expires while it is being updated */
+  calculations.CleanUp(Seconds(50));
+  ok1(calculations.size() == 4);
+
+  calculations.CleanUp(Seconds(200));
+  ok1(calculations.size() == 0);
+
+  return exit_status();
+}
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FLARM/NameCache.hpp"
+#include "FLARM/Details.hpp"
+#include "FLARM/Global.hpp"
+#include "FLARM/TrafficDatabases.hpp"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+int main()
+{
+  plan_tests(9);
+
+  TrafficDatabases databases;
+  traffic_databases = &databases;
+
+  const FlarmId known = FlarmId::Parse("DDA85C", nullptr);
+  const FlarmId unknown = FlarmId::Parse("DDA896", nullptr);
+  databases.flarm_names.Set(known, _T("TH"));
+
+  FlarmNameCache cache;
+
+  const TCHAR *name = cache.Lookup(known);
+  ok1(name != nullptr && StringIsEqual(name, _T("TH")));
+  ok1(cache.Lookup(unknown) == nullptr);
+
+  /* a database modification behind the cache's back is not noticed:
+     the negative result is cached */
+  databases.flarm_names.Set(unknown, _T("XY"));
+  ok1(cache.Lookup(unknown) == nullptr);
+
+  /* after invalidation, the database is consulted again */
+  FlarmDetails::Invalidate();
+  name = cache.Lookup(unknown);
+  ok1(name != nullptr && StringIsEqual(name, _T("XY")));
+
+  /* AddSecondaryItem() flushes the cache */
+  ok1(FlarmDetails::AddSecondaryItem(known, _T("AB")));
+  name = cache.Lookup(known);
+  ok1(name != nullptr && StringIsEqual(name, _T("AB")));
+
+  /* without databases, nothing is found */
+  traffic_databases = nullptr;
+  FlarmDetails::Invalidate();
+  ok1(cache.Lookup(known) == nullptr);
+
+  traffic_databases = &databases;
+  ok1(cache.Lookup(known) == nullptr);
+  FlarmDetails::Invalidate();
+  ok1(cache.Lookup(known) != nullptr);
+
+  return exit_status();
+}
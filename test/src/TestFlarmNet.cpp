@@ -4,19 +4,16 @@
 #include "FLARM/FlarmNetDatabase.hpp"
 #include "FLARM/FlarmNetReader.hpp"
 #include "FLARM/FlarmNetRecord.hpp"
+#include "FLARM/FlarmNetCache.hpp"
 #include "FLARM/Id.hpp"
+#include "io/FileCache.hpp"
 #include "system/Path.hpp"
+#include "system/FileUtil.hpp"
 #include "TestUtil.hpp"
 
-int main()
+static void
+TestLookups(const FlarmNetDatabase &db)
 {
-  plan_tests(15);
-
-  FlarmNetDatabase db;
-  int count = FlarmNetReader::LoadFile(Path(_T("test/data/flarmnet/data.fln")),
-                                       db);
-  ok1(count == 6);
-
   FlarmId id = FlarmId::Parse("DDA85C", NULL);
 
   const FlarmNetRecord *record = db.FindRecordById(id);
@@ -30,6 +27,8 @@ int main()
   ok1(StringIsEqual(record->callsign, _T("TH")));
   ok1(StringIsEqual(record->frequency, _T("130.625")));
 
+  ok1(db.FindRecordById(FlarmId::Parse("000001", NULL)) == NULL);
+
   const FlarmNetRecord *array[3];
   ok1(db.FindRecordsByCallSign(_T("TH"), array, 3) == 2);
 
@@ -44,6 +43,9 @@ int main()
   ok1(found4449);
   ok1(found5799);
 
+  /* the result array size is respected */
+  ok1(db.FindRecordsByCallSign(_T("TH"), array, 1) == 1);
+
   FlarmId ids[3];
   ok1(db.FindIdsByCallSign(_T("TH"), ids, 3) == 2);
 
@@ -59,5 +61,43 @@ int main()
   ok1(foundDDA85C);
   ok1(foundDDA896);
 
+  /* records are sorted by id */
+  bool sorted = true;
+  const FlarmNetRecord *previous = nullptr;
+  for (const auto &i : db) {
+    if (previous != nullptr && !(previous->GetId() < i.GetId()))
+      sorted = false;
+    previous = &i;
+  }
+  ok1(sorted);
+}
+
+int main()
+{
+  plan_tests(38);
+
+  const Path path(_T("test/data/flarmnet/data.fln"));
+
+  FlarmNetDatabase db;
+  int count = FlarmNetReader::LoadFile(path, db);
+  ok1(count == 6);
+
+  TestLookups(db);
+
+  /* round trip through the binary cache */
+  const Path cache_path(_T("output/results"));
+  Directory::Create(cache_path);
+  FileCache cache{AllocatedPath{cache_path}};
+  cache.Flush(_T("flarmnet.bin"));
+
+  FlarmNetDatabase cached;
+  ok1(FlarmNetCache::Load(cache, path, cached) == 0);
+  ok1(cached.IsEmpty());
+
+  FlarmNetCache::Save(cache, path, db);
+  ok1(FlarmNetCache::Load(cache, path, cached) == 6);
+
+  TestLookups(cached);
+
   return exit_status();
 }
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FLARM/Threat.hpp"
+#include "FLARM/List.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+static FlarmId
+MakeId(uint32_t value)
+{
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%06X", value);
+  return FlarmId::Parse(buffer, nullptr);
+}
+
+static FlarmTraffic &
+Add(TrafficList &list, uint32_t id, double north, double east)
+{
+  FlarmTraffic &traffic = *list.AllocateTraffic(MakeId(id));
+  traffic.relative_north = north;
+  traffic.relative_east = east;
+  traffic.relative_altitude = RoughAltitude(0);
+  traffic.distance = hypot(north, east);
+  traffic.alarm_level = FlarmTraffic::AlarmType::NONE;
+  traffic.track_received = traffic.speed_received = false;
+  return traffic;
+}
+
+static void
+SetVelocity(FlarmTraffic &traffic, double bearing, double speed)
+{
+  traffic.track = Angle::Degrees(bearing);
+  traffic.speed = speed;
+  traffic.track_received = traffic.speed_received = true;
+}
+
+static const FlarmTraffic &
+GetThreat(const TrafficList &list, unsigned i)
+{
+  return list.list[list.threats[i]];
+}
+
+int main()
+{
+  plan_tests(21);
+
+  TrafficList list;
+  list.Clear();
+
+  /* head-on, 1 km ahead */
+  FlarmTraffic &a = Add(list, 1, 1000, 0);
+  SetVelocity(a, 180, 30);
+
+  /* 300 m to the right, flying in formation */
+  FlarmTraffic &b = Add(list, 2, 0, 300);
+  SetVelocity(b, 0, 30);
+
+  /* 200 m behind, velocity unknown */
+  Add(list, 3, -200, 0);
+
+  const SpeedVector own(Angle::Zero(), 30);
+  FlarmThreat::Update(list, own);
+
+  ok1(list.HasThreatOrder());
+
+  const FlarmTraffic *t = list.FindTraffic(MakeId(1));
+  ok1(t->cpa_available);
+  ok1(equals(t->cpa_time, 1000. / 60));
+  ok1(fabs(t->cpa_distance) < 1);
+
+  t = list.FindTraffic(MakeId(2));
+  ok1(t->cpa_available);
+  ok1(equals(t->cpa_time, 0));
+  ok1(fabs(t->cpa_distance - 300) < 2);
+
+  ok1(!list.FindTraffic(MakeId(3))->cpa_available);
+
+  /* the head-on target wins despite being the furthest away */
+  ok1(GetThreat(list, 0).id == MakeId(1));
+  ok1(GetThreat(list, 1).id == MakeId(3));
+  ok1(GetThreat(list, 2).id == MakeId(2));
+
+  /* FLARM's alarm level is ranked first */
+  list.FindTraffic(MakeId(2))->alarm_level = FlarmTraffic::AlarmType::LOW;
+  list.FindTraffic(MakeId(3))->alarm_level = FlarmTraffic::AlarmType::URGENT;
+  FlarmThreat::Update(list, own);
+  ok1(GetThreat(list, 0).id == MakeId(3));
+  ok1(GetThreat(list, 1).id == MakeId(2));
+  ok1(GetThreat(list, 2).id == MakeId(1));
+
+  /* without our own velocity, only the distance counts */
+  list.FindTraffic(MakeId(2))->alarm_level = FlarmTraffic::AlarmType::NONE;
+  list.FindTraffic(MakeId(3))->alarm_level = FlarmTraffic::AlarmType::NONE;
+  FlarmThreat::Update(list, std::nullopt);
+  ok1(!list.FindTraffic(MakeId(1))->cpa_available);
+  ok1(GetThreat(list, 0).id == MakeId(3));
+  ok1(GetThreat(list, 1).id == MakeId(2));
+  ok1(GetThreat(list, 2).id == MakeId(1));
+
+  /* a closest approach beyond the horizon is ignored */
+  list.FindTraffic(MakeId(1))->relative_north = 10000;
+  list.FindTraffic(MakeId(1))->distance = 10000;
+  FlarmThreat::Update(list, own);
+  ok1(GetThreat(list, 2).id == MakeId(1));
+
+  /* modifying the list invalidates the ranking */
+  ok1(list.HasThreatOrder());
+  Add(list, 4, 0, 0);
+  ok1(!list.HasThreatOrder());
+
+  return exit_status();
+}
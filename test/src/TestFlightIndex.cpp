@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Logger/FlightIndex.hpp"
+#include "Logger/FlightParser.hpp"
+#include "FlightInfo.hpp"
+#include "io/FileLineReader.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/FileUtil.hpp"
+#include "time/BrokenDateTime.hpp"
+#include "util/PrintException.hxx"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+
+using Event = FlightIndex::Event;
+
+static const Path log_path("output/TestFlightIndex.log");
+
+/**
+ * Append an event like #FlightLogger does.
+ */
+static void
+Log(const BrokenDateTime &dt, Event event, bool update_index=true)
+{
+  const uint64_t old_size = File::GetSize(log_path);
+
+  {
+    FileOutputStream file(log_path, FileOutputStream::Mode::APPEND_OR_CREATE);
+    BufferedOutputStream writer(file);
+    writer.Format("%04u-%02u-%02uT%02u:%02u:%02u %s\n",
+                  dt.year, dt.month, dt.day,
+                  dt.hour, dt.minute, dt.second,
+                  event == Event::START ? "start" : "landing");
+    writer.Flush();
+    file.Commit();
+  }
+
+  if (update_index)
+    FlightIndex::Update(log_path, old_size, event, dt);
+}
+
+static std::vector<FlightInfo>
+Parse()
+{
+  std::vector<FlightInfo> flights;
+
+  FileLineReaderA reader(log_path);
+  FlightParser parser(reader);
+  FlightInfo flight;
+  while (parser.Read(flight))
+    flights.push_back(flight);
+
+  return flights;
+}
+
+static bool
+operator==(const FlightInfo &a, const FlightInfo &b) noexcept
+{
+  return a.date == b.date && a.start_time == b.start_time &&
+    a.end_time == b.end_time;
+}
+
+/**
+ * Does the index return the same flights as the parser?
+ */
+static bool
+MatchesParser(std::size_t max=1000)
+{
+  auto expected = Parse();
+  if (expected.size() > max)
+    expected.erase(expected.begin(), expected.end() - max);
+
+  return FlightIndex::LoadRecent(log_path, max) == expected;
+}
+
+static void
+TestUpdate()
+{
+  /* a normal flight */
+  Log({2023, 6, 1, 10, 0, 0}, Event::START);
+  ok1(MatchesParser());
+  Log({2023, 6, 1, 12, 30, 15}, Event::LANDING);
+  ok1(MatchesParser());
+
+  /* a start without landing, followed by another flight */
+  Log({2023, 6, 2, 9, 0, 0}, Event::START);
+  Log({2023, 6, 2, 11, 0, 0}, Event::START);
+  Log({2023, 6, 2, 13, 0, 0}, Event::LANDING);
+  ok1(MatchesParser());
+
+  /* a landing without start */
+  Log({2023, 6, 3, 14, 0, 0}, Event::LANDING);
+  ok1(MatchesParser());
+
+  /* a landing too long after the start */
+  Log({2023, 6, 4, 8, 0, 0}, Event::START);
+  Log({2023, 6, 5, 8, 0, 0}, Event::LANDING);
+  ok1(MatchesParser());
+
+  /* a flight across midnight (UTC) */
+  Log({2023, 6, 6, 23, 0, 0}, Event::START);
+  Log({2023, 6, 7, 1, 0, 0}, Event::LANDING);
+
+  const auto flights = FlightIndex::LoadRecent(log_path, 1000);
+  ok1(flights.size() == 7);
+  ok1(flights.back().Duration() == std::chrono::hours{2});
+  ok1(MatchesParser());
+
+  /* only the most recent flights */
+  ok1(MatchesParser(3));
+  ok1(FlightIndex::LoadRecent(log_path, 0).empty());
+
+  /* the flight in progress is included */
+  Log({2023, 6, 8, 10, 0, 0}, Event::START);
+  ok1(MatchesParser(2));
+}
+
+static void
+TestOutdated()
+{
+  /* the log is modified without updating the index: it must be
+     rebuilt */
+  Log({2023, 6, 8, 16, 0, 0}, Event::LANDING, false);
+  ok1(MatchesParser());
+
+  /* ... and then it can be updated again */
+  Log({2023, 6, 9, 10, 0, 0}, Event::START);
+  Log({2023, 6, 9, 10, 30, 0}, Event::LANDING);
+  ok1(MatchesParser());
+
+  /* a missing index is rebuilt */
+  File::Delete(FlightIndex::GetIndexPath(log_path));
+  ok1(MatchesParser(4));
+  ok1(File::Exists(FlightIndex::GetIndexPath(log_path)));
+}
+
+int
+main()
+try {
+  plan_tests(16);
+
+  File::Delete(log_path);
+  File::Delete(FlightIndex::GetIndexPath(log_path));
+
+  /* no log yet */
+  ok1(FlightIndex::LoadRecent(log_path, 10).empty());
+
+  TestUpdate();
+  TestOutdated();
+
+  File::Delete(log_path);
+  File::Delete(FlightIndex::GetIndexPath(log_path));
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FramePacer.hpp"
+#include "TestUtil.hpp"
+
+using namespace std::chrono;
+using Priority = FramePacer::Priority;
+
+static constexpr FramePacer::Clock::time_point start{seconds{1000}};
+
+static void
+TestMinInterval()
+{
+  ok1(FramePacer::GetMinInterval(0, false) == FramePacer::Clock::duration{});
+  ok1(FramePacer::GetMinInterval(0, true) == milliseconds{500});
+  ok1(FramePacer::GetMinInterval(5, false) == milliseconds{200});
+  ok1(FramePacer::GetMinInterval(10, true) == milliseconds{100});
+}
+
+static void
+TestCoalesce()
+{
+  FramePacer pacer;
+  ok1(!pacer.IsPending());
+  ok1(pacer.GetDelay(start) == FramePacer::Clock::duration{});
+
+  ok1(pacer.Request(Priority::DATA));
+  ok1(!pacer.Request(Priority::NORMAL));
+  ok1(!pacer.Request(Priority::DATA));
+  ok1(pacer.IsPending());
+
+  /* the merged request has the highest priority */
+  ok1(pacer.Begin(start) == Priority::NORMAL);
+  ok1(!pacer.IsPending());
+}
+
+static void
+TestRateLimit()
+{
+  FramePacer pacer;
+  pacer.SetMinInterval(milliseconds{200});
+
+  pacer.Request(Priority::DATA);
+  ok1(pacer.GetDelay(start) == FramePacer::Clock::duration{});
+  pacer.Begin(start);
+
+  pacer.Request(Priority::DATA);
+  ok1(pacer.GetDelay(start + milliseconds{50}) == milliseconds{150});
+  ok1(pacer.GetDelay(start + milliseconds{200}) == FramePacer::Clock::duration{});
+
+  /* user input is not limited */
+  pacer.Request(Priority::INPUT);
+  ok1(pacer.GetDelay(start + milliseconds{50}) == FramePacer::Clock::duration{});
+  ok1(pacer.Begin(start + milliseconds{50}) == Priority::INPUT);
+}
+
+static void
+TestStaticScene()
+{
+  FramePacer pacer;
+
+  pacer.Painted(start);
+
+  /* disabled by default */
+  ok1(!pacer.MaySkip(Priority::DATA, start + seconds{1}));
+
+  pacer.SetStaticScene(true);
+  ok1(pacer.MaySkip(Priority::DATA, start + seconds{1}));
+  ok1(!pacer.MaySkip(Priority::NORMAL, start + seconds{1}));
+  ok1(!pacer.MaySkip(Priority::INPUT, start + seconds{1}));
+
+  /* paint at least every MAX_STATIC_INTERVAL */
+  ok1(!pacer.MaySkip(Priority::DATA,
+                     start + FramePacer::MAX_STATIC_INTERVAL));
+}
+
+int
+main()
+{
+  plan_tests(22);
+
+  TestMinInterval();
+  TestCoalesce();
+  TestRateLimit();
+  TestStaticScene();
+
+  return exit_status();
+}
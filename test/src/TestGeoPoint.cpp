@@ -10,7 +10,7 @@
 
 int main()
 {
-  plan_tests(80);
+  plan_tests(86);
 
   // test constructor
   GeoPoint p1(Angle::Degrees(345.32), Angle::Degrees(-6.332));
@@ -85,6 +85,19 @@ int main()
   ok1(equals(p1.Distance(p11), 1.561761));
   ok1(equals(p1.Distance(p12), 18599361.600));
 
+  // test GeodesicOrigin: exactly the same as Distance() and Bearing()
+  const GeodesicOrigin origin(p1);
+  ok1(origin.Distance(p3) == p1.Distance(p3));
+  ok1(origin.Distance(p11) == p1.Distance(p11));
+  ok1(origin.Distance(p12) == p1.Distance(p12));
+  ok1(origin.Distance(p1) == 0);
+
+  double origin_distance;
+  Angle origin_bearing;
+  origin.DistanceBearing(p5, &origin_distance, &origin_bearing);
+  ok1(origin_distance == p1.Distance(p5));
+  ok1(origin_bearing == p1.Bearing(p5));
+
   ok1(equals(p2.DistanceS(p6), 869326.653160));
   ok1(equals(p6.DistanceS(p2), 869326.653160));
   ok1(equals(p1.DistanceS(p5), 309562.219016));
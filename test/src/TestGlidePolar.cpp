@@ -3,6 +3,11 @@
 
 #include "TestUtil.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
+#include "GlideSolvers/GlideSettings.hpp"
+#include "GlideSolvers/GlideState.hpp"
+#include "GlideSolvers/GlideResult.hpp"
+#include "GlideSolvers/MacCready.hpp"
+#include "Geo/SpeedVector.hpp"
 #include "Units/System.hpp"
 
 #include <cstdio>
@@ -20,6 +25,8 @@ private:
   void TestBallast();
   void TestBugs();
   void TestMC();
+  void TestSpeedToFly();
+  void TestMaxLDOverGround();
 };
 
 void
@@ -145,6 +152,88 @@ GlidePolarTest::TestMC()
   ok1(equals(polar.GetVBestLD(), 25.830434162));
 }
 
+/**
+ * Find the speed to fly by scanning the whole speed range.
+ */
+[[gnu::pure]]
+static double
+ScanSpeedToFly(const GlidePolar &polar, double sink_rate, double head_wind)
+{
+  double best_v = polar.GetVMax(), best_f = 1e10;
+  for (double v = std::max(1. + head_wind, polar.GetVMin());
+       v <= polar.GetVMax(); v += 0.001) {
+    const double f = (polar.MSinkRate(v) + sink_rate) / (v - head_wind);
+    if (f < best_f) {
+      best_f = f;
+      best_v = v;
+    }
+  }
+
+  return best_v;
+}
+
+void
+GlidePolarTest::TestSpeedToFly()
+{
+  polar.SetMC(1);
+  ok1(equals(polar.SpeedToFly(0, 0), polar.GetVBestLD()));
+
+  static constexpr struct {
+    double mc, sink_rate, head_wind;
+  } cases[] = {
+    { 0, 0, 0 },
+    { 2, 0, 0 },
+    { 1, 2, 0 },
+    { 1, -0.5, 0 },
+    { 0, 0, 10 },
+    { 1.5, 1, -8 },
+    { 0.5, -3, 0 },
+  };
+
+  for (const auto &i : cases) {
+    polar.SetMC(i.mc);
+    ok(fabs(polar.SpeedToFly(i.sink_rate, i.head_wind) -
+            ScanSpeedToFly(polar, i.sink_rate, i.head_wind)) < 0.01,
+       "speed to fly mc=%g sink=%g wind=%g",
+       i.mc, i.sink_rate, i.head_wind);
+  }
+
+  polar.SetMC(0);
+}
+
+void
+GlidePolarTest::TestMaxLDOverGround()
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+
+  const GeoVector vector(50000, Angle::Zero());
+
+  /* no glide solution may be better than the bound */
+  bool success = true;
+  for (const double mc : {0., 1., 3.}) {
+    polar.SetMC(mc);
+
+    for (const double wind_speed : {0., 10., 25.}) {
+      const double bound = polar.GetMaxLDOverGround(wind_speed);
+
+      for (unsigned i = 0; i < 8; ++i) {
+        const SpeedVector wind(Angle::FullCircle() * i / 8, wind_speed);
+        const GlideState state(vector, 0, 5000, wind);
+        const GlideResult result = MacCready::Solve(settings, polar, state);
+        if (result.IsOk() && result.height_glide > 0 &&
+            result.vector.distance / result.height_glide > bound)
+          success = false;
+      }
+    }
+  }
+
+  ok1(success);
+
+  polar.SetMC(0);
+  ok1(polar.GetMaxLDOverGround(0) >= polar.GetBestLD());
+}
+
 void
 GlidePolarTest::Run()
 {
@@ -153,11 +242,13 @@ GlidePolarTest::Run()
   TestBallast();
   TestBugs();
   TestMC();
+  TestSpeedToFly();
+  TestMaxLDOverGround();
 }
 
 int main()
 {
-  plan_tests(46);
+  plan_tests(56);
 
   GlidePolarTest test;
   test.Run();
@@ -0,0 +1,408 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Terrain/RasterTileCache.hpp"
+#include "Terrain/jasper/jas_seq.h"
+#include "TestUtil.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+#include <math.h>
+
+static constexpr unsigned MAP_SIZE = 1024, TILE_SIZE = 256;
+static constexpr unsigned N_TILES = MAP_SIZE / TILE_SIZE;
+
+/**
+ * The number of tiles (in index order) which are loaded; the others
+ * are only available in the overview.
+ */
+static constexpr unsigned N_LOADED = 9;
+
+[[gnu::const]]
+static TerrainHeight
+MakeHeight(unsigned x, unsigned y) noexcept
+{
+  /* a few pixels of "invalid" in one tile */
+  if (x >= 900 && x < 904 && y >= 100 && y < 104)
+    return TerrainHeight::Invalid();
+
+  /* a lake */
+  if (x >= 300 && x < 400 && y >= 600 && y < 700)
+    return TerrainHeight(-30001);
+
+  /* a mountain in the tile south-east of the center */
+  if (x >= 600 && x < 700 && y >= 600 && y < 700)
+    return TerrainHeight(2000 + int16_t((x * 7 + y * 13) % 500));
+
+  /* rolling hills */
+  return TerrainHeight(int16_t(100 + (x * 3 + y * 5) % 400 +
+                               ((x / 32 + y / 64) % 3) * 200));
+}
+
+class TestCache : public RasterTileCache {
+public:
+  TestCache() noexcept {
+    SetSize({MAP_SIZE, MAP_SIZE}, {TILE_SIZE, TILE_SIZE},
+            {N_TILES, N_TILES});
+
+    std::vector<jas_seqent_t> data(TILE_SIZE * TILE_SIZE);
+    std::vector<jas_seqent_t *> rows(TILE_SIZE);
+    std::vector<TerrainHeight> heights(TILE_SIZE * TILE_SIZE);
+
+    for (unsigned i = 0; i < N_TILES * N_TILES; ++i) {
+      const RasterLocation start{i % N_TILES * TILE_SIZE,
+                                 i / N_TILES * TILE_SIZE};
+
+      for (unsigned y = 0; y < TILE_SIZE; ++y) {
+        rows[y] = data.data() + y * TILE_SIZE;
+        for (unsigned x = 0; x < TILE_SIZE; ++x) {
+          const auto h = MakeHeight(start.x + x, start.y + y);
+          rows[y][x] = h.GetValue();
+          heights[y * TILE_SIZE + x] = h;
+        }
+      }
+
+      jas_matrix m{};
+      m.numrows_ = m.numcols_ = TILE_SIZE;
+      m.rows_ = rows.data();
+
+      PutOverviewTile(i, start, start + RasterLocation{TILE_SIZE, TILE_SIZE},
+                      m);
+
+      if (i < N_LOADED) {
+        tiles.GetLinear(i).SetRequest();
+        PutTileBuffer(i, MakeTileBuffer(i, heights));
+      }
+    }
+  }
+
+  int GetTileMaxHeight(unsigned i) const noexcept {
+    return tiles.GetLinear(i).GetMaxHeight();
+  }
+
+  const HeightPyramid &GetPyramid() const noexcept {
+    return pyramid;
+  }
+
+  /**
+   * Forget the tile maxima and the #HeightPyramid, so all searches
+   * look at every sample.
+   */
+  void DisableShortcuts() noexcept {
+    for (auto &tile : tiles)
+      tile.ClearMaxHeight();
+    pyramid.Reset();
+  }
+
+  bool IsTileLoaded(RasterLocation p) const noexcept {
+    return tiles.Get(p.x / TILE_SIZE, p.y / TILE_SIZE).IsLoaded();
+  }
+};
+
+/**
+ * What RasterTileCache::GetFieldDirect() returns for the test map.
+ */
+static std::pair<TerrainHeight, bool>
+GetFieldDirect(const TestCache &cache, RasterLocation p) noexcept
+{
+  if (cache.IsTileLoaded(p))
+    return {MakeHeight(p.x, p.y), true};
+
+  const unsigned mask = ~((1u << RasterTraits::OVERVIEW_BITS) - 1);
+  return {MakeHeight(p.x & mask, p.y & mask), false};
+}
+
+/**
+ * RasterTileCache::GroundIntersection() before the tile maxima and
+ * GroundIntersections() existed.
+ */
+static SignedRasterLocation
+Reference(const TestCache &cache,
+          const SignedRasterLocation origin,
+          const SignedRasterLocation destination,
+          const int h_origin, const int slope_fact,
+          const int height_floor) noexcept
+{
+  SignedRasterLocation location = origin;
+
+  if (!cache.IsInside(location))
+    return {-1, -1};
+
+  const int dx = abs(destination.x - origin.x);
+  const int dy = abs(destination.y - origin.y);
+  int err = dx-dy;
+  const int sx = origin.x < destination.x ? 1 : -1;
+  const int sy = origin.y < destination.y ? 1 : -1;
+
+  const int max_steps = (dx+dy);
+  const int refine_step = max_steps >> 5;
+  const int step_fine = std::max(1, refine_step);
+  const int step_coarse = std::max(1 << RasterTraits::OVERVIEW_BITS, step_fine);
+
+  unsigned step_counter = 0;
+  int total_steps = 0;
+
+  RasterLocation last_clear_location = location;
+  int last_clear_h = h_origin;
+
+  while (true) {
+    if (!step_counter) {
+      if (!cache.IsInside(location))
+        break;
+
+      const auto field_direct = GetFieldDirect(cache, location);
+      if (field_direct.first.IsInvalid())
+        break;
+
+      const int h_terrain = field_direct.first.GetValueOr0();
+      step_counter = field_direct.second ? step_fine : step_coarse;
+
+      const int dh = (total_steps * slope_fact) >> RASTER_SLOPE_FACT;
+      const int h_int = h_origin - dh;
+
+      if (h_int < std::max(h_terrain, height_floor)) {
+        if (refine_step<3)
+          return RasterLocation(last_clear_location.x, last_clear_location.y);
+
+        return Reference(cache, last_clear_location, location,
+                         last_clear_h, slope_fact, height_floor);
+      }
+
+      if (h_int <= 0)
+        break;
+
+      last_clear_location = location;
+      last_clear_h = h_int;
+    }
+
+    if (total_steps > max_steps)
+      break;
+
+    const int e2 = 2*err;
+    if (e2 > -dy) {
+      err -= dy;
+      location.x += sx;
+      if (step_counter>0)
+        step_counter--;
+      total_steps++;
+    }
+    if (e2 < dx) {
+      err += dx;
+      location.y += sy;
+      if (step_counter>0)
+        step_counter--;
+      total_steps++;
+    }
+  }
+
+  return {-1, -1};
+}
+
+/**
+ * Trace a fan of #n rays from #origin with GroundIntersections() and
+ * GroundIntersection(), and compare both with Reference().
+ */
+static void
+TestFan(const TestCache &cache, SignedRasterLocation origin,
+        unsigned n, int radius, int h_origin, int h_glide, int height_floor)
+{
+  std::vector<RasterTileCache::GroundRay> rays;
+  for (unsigned i = 0; i < n; ++i) {
+    const double angle = 2 * M_PI * i / n;
+    const SignedRasterLocation destination{
+      origin.x + int(radius * cos(angle)),
+      origin.y + int(radius * sin(angle)),
+    };
+    const int c_diff = ManhattanDistance(origin, destination);
+    if (c_diff == 0)
+      continue;
+
+    rays.push_back({destination, (h_glide << RASTER_SLOPE_FACT) / c_diff,
+                    {0, 0}});
+  }
+
+  cache.GroundIntersections(origin, h_origin, height_floor, rays);
+
+  bool batch_ok = true, single_ok = true;
+  for (const auto &ray : rays) {
+    const auto expected = Reference(cache, origin, ray.destination,
+                                    h_origin, ray.slope_fact, height_floor);
+    if (ray.result != expected)
+      batch_ok = false;
+
+    if (cache.GroundIntersection(origin, ray.destination, h_origin,
+                                 ray.slope_fact, height_floor) != expected)
+      single_ok = false;
+  }
+
+  ok1(batch_ok);
+  ok1(single_ok);
+}
+
+/**
+ * Compare FirstIntersection() on a fan of rays with and without the
+ * shortcuts.
+ */
+static bool
+TestFirstIntersection(const TestCache &cache, const TestCache &slow,
+                      SignedRasterLocation origin, int radius,
+                      int h_origin, int h_dest, int h_virt,
+                      int h_ceiling, int h_safety)
+{
+  static constexpr unsigned n = 48;
+
+  for (unsigned i = 0; i < n; ++i) {
+    const double angle = 2 * M_PI * i / n;
+    const SignedRasterLocation destination{
+      origin.x + int(radius * cos(angle)),
+      origin.y + int(radius * sin(angle)),
+    };
+    const int c_diff = ManhattanDistance(origin, destination);
+    const int slope_fact = (h_virt << RASTER_SLOPE_FACT) / c_diff;
+    const bool can_climb = h_dest < h_virt;
+
+    const auto a = cache.FirstIntersection(origin, destination,
+                                           h_origin, h_dest, slope_fact,
+                                           h_ceiling, h_safety, can_climb);
+    const auto b = slow.FirstIntersection(origin, destination,
+                                          h_origin, h_dest, slope_fact,
+                                          h_ceiling, h_safety, can_climb);
+    if (a.has_value() != b.has_value() ||
+        (a && (a->location != b->location || a->height != b->height)))
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * Check HeightPyramid::FindBlock() against the pixels of the test
+ * map.
+ */
+[[gnu::pure]]
+static int
+CalcMaxHeight(RasterLocation start, RasterLocation end)
+{
+  int max_height = INT16_MIN;
+  for (unsigned y = start.y; y < end.y && y < MAP_SIZE; ++y) {
+    for (unsigned x = start.x; x < end.x && x < MAP_SIZE; ++x) {
+      const auto height = MakeHeight(x, y);
+      max_height = std::max(max_height,
+                            height.IsInvalid()
+                            ? int(HeightPyramid::UNKNOWN)
+                            : int(height.GetValueOr0()));
+    }
+  }
+
+  return max_height;
+}
+
+static bool
+TestFindBlock(const HeightPyramid &pyramid, RasterLocation p, int h)
+{
+  const auto block = pyramid.FindBlock(p, h);
+  if (block.start == block.end) {
+    /* nothing found: the base block must be too high */
+    const unsigned mask = ~((1u << HeightPyramid::BASE_BITS) - 1);
+    const RasterLocation start(p.x & mask, p.y & mask);
+    return CalcMaxHeight(start,
+                         start + RasterLocation(1u << HeightPyramid::BASE_BITS,
+                                                1u << HeightPyramid::BASE_BITS)) > h;
+  }
+
+  return block.max_height <= h &&
+    p.x >= block.start.x && p.x < block.end.x &&
+    p.y >= block.start.y && p.y < block.end.y &&
+    CalcMaxHeight(block.start, block.end) == block.max_height;
+}
+
+int
+main()
+{
+  plan_tests(4 + 8 * 2 + 2 + 3 + 5);
+
+  const TestCache cache;
+
+  /* tile 0 has rolling hills */
+  ok1(cache.GetTileMaxHeight(0) > 100);
+  ok1(cache.GetTileMaxHeight(0) < 900);
+
+  /* the mountain */
+  ok1(cache.GetTileMaxHeight(2 * N_TILES + 2) >= 2000);
+
+  /* invalid pixels disable the summary */
+  ok1(cache.GetTileMaxHeight(3) == RasterTile::UNKNOWN_MAX_HEIGHT);
+
+  const SignedRasterLocation center{512, 512};
+
+  /* high above everything: the rays reach MSL or leave the map */
+  TestFan(cache, center, 49, 2000, 3000, 3000, 0);
+
+  /* the mountain and some hills are in the way */
+  TestFan(cache, center, 49, 600, 1500, 1500, 0);
+  TestFan(cache, center, 49, 400, 900, 900, 0);
+  TestFan(cache, center, 49, 300, 700, 700, 300);
+
+  /* above the lake and the invalid pixels */
+  TestFan(cache, {350, 650}, 49, 500, 1200, 1200, 0);
+  TestFan(cache, {902, 200}, 36, 300, 1000, 1000, 0);
+
+  /* more rays than one batch, and very short rays */
+  TestFan(cache, center, 150, 800, 2500, 2500, 500);
+  TestFan(cache, {10, 10}, 100, 3, 800, 800, 0);
+
+  /* origin outside of the map */
+  {
+    RasterTileCache::GroundRay rays[2]{
+      {{100, 100}, 100, {0, 0}},
+      {{200, 100}, 100, {0, 0}},
+    };
+    cache.GroundIntersections({-5, 100}, 1000, 0, rays);
+    ok1(rays[0].result.x < 0 && rays[1].result.x < 0);
+  }
+
+  /* an empty fan */
+  cache.GroundIntersections(center, 1000, 0, {});
+  ok1(true);
+
+  /* the pyramid */
+  const auto &pyramid = cache.GetPyramid();
+  ok1(pyramid.GetLevelCount() == 3);
+
+  bool find_ok = true;
+  srand(42);
+  for (unsigned i = 0; i < 200; ++i) {
+    const RasterLocation p(rand() % MAP_SIZE, rand() % MAP_SIZE);
+    if (!TestFindBlock(pyramid, p, rand() % 2600))
+      find_ok = false;
+  }
+  ok1(find_ok);
+
+  /* blocks containing invalid pixels are never clear */
+  ok1(pyramid.FindBlock({901, 101}, 30000).start ==
+      pyramid.FindBlock({901, 101}, 30000).end);
+
+  TestCache slow;
+  slow.DisableShortcuts();
+
+  /* a glide towards the mountain */
+  ok1(TestFirstIntersection(cache, slow, center, 300, 1200, 1000, 300,
+                            2200, 100));
+
+  /* climbing is allowed */
+  ok1(TestFirstIntersection(cache, slow, center, 500, 400, 900, 1200,
+                            3000, 50));
+
+  /* the ceiling is in the way */
+  ok1(TestFirstIntersection(cache, slow, center, 400, 600, 600, 500,
+                            1000, 100));
+
+  /* across the lake and the invalid pixels */
+  ok1(TestFirstIntersection(cache, slow, {350, 650}, 400, 900, 700, 400,
+                            2000, 0));
+  ok1(TestFirstIntersection(cache, slow, {902, 200}, 200, 1500, 1200, 200,
+                            4000, 150));
+
+  return exit_status();
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "IGC/IGCIndex.hpp"
+#include "IGC/IGCParser.hpp"
+#include "io/FileLineReader.hpp"
+#include "system/Path.hpp"
+#include "time/BrokenTime.hpp"
+#include "util/PrintException.hxx"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+using namespace std::chrono;
+
+static constexpr seconds
+HMS(unsigned h, unsigned m, unsigned s) noexcept
+{
+  return hours{h} + minutes{m} + seconds{s};
+}
+
+static void
+TestSynthetic()
+{
+  IGCIndex index;
+  ok1(index.empty());
+
+  /* one record per second from 23:59:00 to 00:01:00 (midnight
+     wraparound); only every tenth is indexed */
+  uint_least64_t offset = 1000;
+  for (unsigned i = 0; i <= 120; ++i, offset += 37) {
+    const seconds t = (HMS(23, 59, 0) + seconds{i}) % hours{24};
+    index.Add(t, offset);
+  }
+
+  ok1(index.size() == 13);
+
+  /* before the flight: the first record */
+  ok1(index.Find(HMS(12, 0, 0)) == 1000);
+  ok1(index.Find(HMS(23, 59, 0)) == 1000);
+
+  /* between two indexed records: the earlier one */
+  ok1(index.Find(HMS(23, 59, 5)) == 1000);
+  ok1(index.Find(HMS(23, 59, 10)) == 1000 + 10 * 37);
+  ok1(index.Find(HMS(23, 59, 19)) == 1000 + 10 * 37);
+
+  /* after midnight */
+  ok1(index.Find(HMS(0, 0, 0)) == 1000 + 60 * 37);
+  ok1(index.Find(HMS(0, 0, 35)) == 1000 + 90 * 37);
+
+  /* after the flight: the last indexed record */
+  ok1(index.Find(HMS(0, 5, 0)) == 1000 + 120 * 37);
+
+  index.Clear();
+  ok1(index.empty());
+}
+
+static void
+TestFile()
+{
+  FileLineReaderA reader(Path(_T("test/data/apf-bug554.igc")));
+
+  IGCIndex index;
+  unsigned n_fixes = 0;
+
+  while (true) {
+    const long offset = reader.Tell();
+    const char *line = reader.ReadLine();
+    if (line == nullptr)
+      break;
+
+    BrokenTime time;
+    if (line[0] == 'B' && IGCParseTime(line + 1, time)) {
+      index.Add(time.DurationSinceMidnight(), offset);
+      ++n_fixes;
+    }
+  }
+
+  ok1(n_fixes == 4872);
+  ok1(!index.empty());
+  ok1(index.size() < n_fixes);
+
+  /* seek into the middle of the flight and verify that the reader
+     continues at a B record shortly before the requested time */
+  const seconds target = HMS(10, 0, 0);
+  reader.Seek(index.Find(target));
+
+  const char *line = reader.ReadLine();
+  ok1(line != nullptr && line[0] == 'B');
+
+  BrokenTime time;
+  ok1(line != nullptr && IGCParseTime(line + 1, time));
+  ok1(time.DurationSinceMidnight() <= target);
+  ok1(time.DurationSinceMidnight() + IGCIndex::INTERVAL > target);
+
+  /* seek back to the first fix */
+  reader.Seek(index.Find(HMS(0, 0, 0)));
+  line = reader.ReadLine();
+  ok1(line != nullptr && strncmp(line, "B085705", 7) == 0);
+}
+
+int
+main()
+try {
+  plan_tests(19);
+
+  TestSynthetic();
+  TestFile();
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -169,6 +169,46 @@ TestFix()
   ok1(equals(fix.location, -51.05195, -7.70611667));
   ok1(fix.pressure_altitude == 10490);
   ok1(fix.gps_altitude == 7);
+
+  /* negative altitude */
+  ok1(IGCParseFix("B1122385103117N00742367EA-0012-0003", extensions, fix));
+  ok1(fix.pressure_altitude == -12);
+  ok1(fix.gps_altitude == -3);
+
+  /* not canonical, but accepted by the generic parser */
+  ok1(IGCParseFix("B1122385103117N00742367EA+049000487", extensions, fix));
+  ok1(fix.pressure_altitude == 490);
+  ok1(fix.gps_altitude == 487);
+}
+
+static void
+TestFixExtensions()
+{
+  IGCExtensions extensions;
+  ok1(IGCParseExtensions("I063638FXA3941ENL4246GSP4749TRT5051SIU5253XYZ",
+                         extensions));
+  ok1(extensions[0].field < 0);
+  ok1(extensions[1].field >= 0);
+  ok1(extensions[5].field < 0);
+
+  IGCFix fix;
+  ok1(IGCParseFix("B1122385103117N00742367EA0049000487"
+                  "012" "345" "07821" "123" "09" "99",
+                  extensions, fix));
+  ok1(fix.enl == 345);
+  ok1(fix.gsp == 78);
+  ok1(fix.trt == 123);
+  ok1(fix.siu == 9);
+  ok1(fix.rpm == -1);
+
+  /* truncated and malformed extensions are ignored */
+  ok1(IGCParseFix("B1122385103117N00742367EA0049000487"
+                  "012" "3x5" "07821" "12",
+                  extensions, fix));
+  ok1(fix.enl == -1);
+  ok1(fix.gsp == 78);
+  ok1(fix.trt == -1);
+  ok1(fix.siu == -1);
 }
 
 static void
@@ -251,13 +291,14 @@ TestDeclarationTurnpoint()
 
 int main()
 {
-  plan_tests(148);
+  plan_tests(169);
 
   TestHeader();
   TestDate();
   TestLocation();
   TestExtensions();
   TestFix();
+  TestFixExtensions();
   TestFixTime();
   TestDeclarationHeader();
   TestDeclarationTurnpoint();
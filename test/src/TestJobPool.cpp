@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Job/Pool.hpp"
+#include "Job/Job.hpp"
+#include "Operation/Operation.hpp"
+#include "TestUtil.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+/**
+ * A job which records the order in which jobs have run.
+ */
+class OrderJob final : public Job {
+  std::atomic<unsigned> &counter;
+
+public:
+  unsigned order = 0;
+
+  explicit OrderJob(std::atomic<unsigned> &_counter) noexcept
+    :counter(_counter) {}
+
+  void Run(OperationEnvironment &) override {
+    order = ++counter;
+  }
+};
+
+/**
+ * A job which sleeps until it gets cancelled.
+ */
+class SleepJob final : public Job {
+public:
+  std::atomic<bool> started{false}, handler_called{false};
+
+  void Run(OperationEnvironment &env) override {
+    env.SetCancelHandler([this]{ handler_called = true; });
+    started = true;
+
+    while (!env.IsCancelled())
+      env.Sleep(seconds{10});
+  }
+};
+
+class ThrowJob final : public Job {
+public:
+  void Run(OperationEnvironment &) override {
+    throw std::runtime_error("error");
+  }
+};
+
+/**
+ * A job which submits more jobs to the same pool.
+ */
+class ForkJob final : public Job {
+  JobPool &pool;
+  std::atomic<unsigned> counter{0};
+  std::vector<OrderJob> children;
+
+public:
+  std::vector<JobPool::TicketPtr> tickets;
+
+  ForkJob(JobPool &_pool, unsigned n) noexcept
+    :pool(_pool), children(n, OrderJob{counter}) {}
+
+  void Run(OperationEnvironment &) override {
+    for (auto &child : children)
+      tickets.push_back(pool.Submit(child));
+  }
+};
+
+static void
+TestPriority()
+{
+  JobPool pool("TestJobPool", 1);
+
+  /* block the only worker while the other jobs are being queued */
+  SleepJob blocker;
+  auto blocker_ticket = pool.Submit(blocker);
+  while (!blocker.started)
+    std::this_thread::sleep_for(milliseconds{1});
+
+  std::atomic<unsigned> counter{0};
+  OrderJob low{counter}, normal{counter}, high{counter};
+  auto low_ticket = pool.Submit(low, JobPool::Priority::LOW);
+  auto normal_ticket = pool.Submit(normal);
+  auto high_ticket = pool.Submit(high, JobPool::Priority::HIGH);
+
+  blocker_ticket->Cancel();
+  blocker_ticket->Wait();
+  ok1(blocker.handler_called);
+
+  low_ticket->Wait();
+  normal_ticket->Wait();
+  high_ticket->Wait();
+
+  ok1(high.order == 1);
+  ok1(normal.order == 2);
+  ok1(low.order == 3);
+
+  /* the blocker ran until it was cancelled */
+  ok1(blocker_ticket->GetRunTime() > milliseconds{0});
+  ok1(low_ticket->GetQueueTime() > normal_ticket->GetQueueTime());
+}
+
+static void
+TestCancelQueued()
+{
+  JobPool pool("TestJobPool", 1);
+
+  SleepJob blocker;
+  auto blocker_ticket = pool.Submit(blocker);
+  while (!blocker.started)
+    std::this_thread::sleep_for(milliseconds{1});
+
+  std::atomic<unsigned> counter{0};
+  OrderJob job{counter};
+  auto ticket = pool.Submit(job);
+
+  ticket->Cancel();
+  ok1(ticket->IsDone());
+
+  blocker_ticket->Cancel();
+  blocker_ticket->Wait();
+  ticket->Wait();
+
+  ok1(counter == 0);
+  ok1(ticket->GetRunTime() == JobPool::Clock::duration::zero());
+}
+
+static void
+TestException()
+{
+  JobPool pool("TestJobPool", 2);
+
+  ThrowJob job;
+  auto ticket = pool.Submit(job);
+
+  bool caught = false;
+  try {
+    ticket->Wait();
+  } catch (const std::runtime_error &) {
+    caught = true;
+  }
+
+  ok1(caught);
+}
+
+static void
+TestMany(unsigned n_workers)
+{
+  JobPool pool("TestJobPool", n_workers);
+  ok1(pool.GetWorkerCount() == n_workers);
+
+  std::atomic<unsigned> counter{0};
+  std::vector<OrderJob> jobs(1000, OrderJob{counter});
+  std::vector<JobPool::TicketPtr> tickets;
+  for (auto &job : jobs)
+    tickets.push_back(pool.Submit(job));
+
+  for (auto &ticket : tickets)
+    ticket->Wait();
+
+  ok1(counter == jobs.size());
+
+  /* jobs submitted by jobs */
+  ForkJob fork(pool, 100);
+  pool.Submit(fork)->Wait();
+
+  for (auto &ticket : fork.tickets)
+    ticket->Wait();
+
+  ok1(fork.tickets.size() == 100);
+}
+
+int
+main()
+{
+  plan_tests(16);
+
+  TestPriority();
+  TestCancelQueued();
+  TestException();
+
+  /* without workers, Submit() runs the job */
+  TestMany(0);
+  TestMany(4);
+
+  return exit_status();
+}
@@ -63,12 +63,44 @@ LSTest1(double w)
   return true;
 }
 
+/**
+ * Add more points than there are slots: the fit and the extremes
+ * must cover all of them, and the slots must span the whole series.
+ */
+static void
+TestDecimate()
+{
+  LeastSquares ls;
+  ls.Reset();
+
+  constexpr unsigned n = 5000;
+  for (unsigned i = 0; i < n; ++i)
+    ls.Update(i, 2 * i + 1);
+
+  ok1(ls.GetCount() == n);
+  ok1(equals(ls.GetGradient(), 2));
+  ok1(equals(ls.GetYAt(0), 1));
+  ok1(equals(ls.GetMaxX(), double(n - 1)));
+
+  const auto slots = ls.GetSlots();
+  ok1(slots.size() > 250 && slots.size() <= 1000);
+  ok1(slots.front().x < 8);
+  ok1(slots.back().x > n - 8);
+
+  bool all_ok = true;
+  for (std::size_t i = 1; i < slots.size(); ++i)
+    all_ok = slots[i].x > slots[i - 1].x &&
+      equals(slots[i].y, 2 * slots[i].x + 1) && all_ok;
+  ok1(all_ok);
+}
+
 int main()
 {
-  plan_tests(2);
+  plan_tests(10);
 
   ok1(LSTest1(1));
   ok1(LSTest1(2));
+  TestDecimate();
 
   return exit_status();
 }
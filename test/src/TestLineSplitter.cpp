@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Device/Util/LineSplitter.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using std::string_view_literals::operator""sv;
+
+class TestSplitter final : public PortLineSplitter {
+public:
+  std::vector<std::string> lines;
+
+  void Feed(std::string_view data) noexcept {
+    DataReceived(std::as_bytes(std::span{data}));
+  }
+
+  bool Expect(std::initializer_list<std::string_view> expected) noexcept {
+    const bool result = std::equal(lines.begin(), lines.end(),
+                                   expected.begin(), expected.end());
+    lines.clear();
+    return result;
+  }
+
+protected:
+  bool LineReceived(const char *line) noexcept override {
+    lines.emplace_back(line);
+    return true;
+  }
+};
+
+int
+main()
+{
+  plan_tests(7);
+
+  TestSplitter splitter;
+
+  /* complete lines */
+  splitter.Feed("$GPGGA,1\r\n$GPRMC,2\r\n"sv);
+  ok1(splitter.Expect({"$GPGGA,1"sv, "$GPRMC,2"sv}));
+
+  /* a line split across reads */
+  splitter.Feed("$PFLAU,"sv);
+  ok1(splitter.Expect({}));
+  splitter.Feed("3,4\r"sv);
+  ok1(splitter.Expect({}));
+  splitter.Feed("\n$PFLAA,5\n$LX"sv);
+  ok1(splitter.Expect({"$PFLAU,3,4"sv, "$PFLAA,5"sv}));
+  splitter.Feed("WP0\n"sv);
+  ok1(splitter.Expect({"$LXWP0"sv}));
+
+  /* control characters are replaced, trailing ones are stripped;
+     a NUL byte ends the line */
+  splitter.Feed("a\tb\x01" "c\x01 \nd\0e\n"sv);
+  ok1(splitter.Expect({"a b c"sv, "d"sv}));
+
+  /* lines which are too long are discarded */
+  splitter.Feed(std::string(300, 'x') + "\n$GPGSA\n");
+  splitter.Feed(std::string(200, 'y'));
+  splitter.Feed(std::string(100, 'y') + "\n$GPGLL\n");
+  ok1(splitter.Expect({"$GPGSA"sv, "$GPGLL"sv}));
+
+  return exit_status();
+}
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "util/LockFreeFifoBuffer.hpp"
+#include "TestUtil.hpp"
+
+#include <thread>
+
+static void
+TestWrapAround()
+{
+  LockFreeFifoBuffer<unsigned, 8> buffer;
+  ok1(buffer.IsEmpty());
+
+  const unsigned a[] = {1, 2, 3, 4, 5, 6};
+  ok1(buffer.Write(a) == 6);
+  ok1(!buffer.IsEmpty());
+
+  unsigned b[8];
+  ok1(buffer.Read(std::span{b}.first(4)) == 4);
+  ok1(b[0] == 1 && b[3] == 4);
+
+  /* this wraps around; the last element doesn't fit */
+  const unsigned c[] = {7, 8, 9, 10, 11, 12, 13};
+  ok1(buffer.Write(c) == 6);
+
+  ok1(buffer.Read(b) == 8);
+  ok1(b[0] == 5 && b[1] == 6 && b[2] == 7 && b[7] == 12);
+  ok1(buffer.IsEmpty());
+  ok1(buffer.Read(b) == 0);
+
+  ok1(buffer.Write(c) == 7);
+  buffer.Clear();
+  ok1(buffer.IsEmpty());
+}
+
+/**
+ * One thread writes a sequence of numbers, the other one reads them
+ * and verifies that nothing was lost or reordered.
+ */
+static void
+TestThreads()
+{
+  static constexpr unsigned N = 100000;
+
+  LockFreeFifoBuffer<unsigned, 64> buffer;
+
+  std::thread producer([&buffer](){
+    unsigned next = 0;
+    while (next < N) {
+      unsigned chunk[7];
+      unsigned n = 0;
+      for (; n < std::size(chunk) && next + n < N; ++n)
+        chunk[n] = next + n;
+
+      const std::size_t written = buffer.Write(std::span{chunk}.first(n));
+      if (written == 0)
+        /* full: let the consumer run */
+        std::this_thread::yield();
+
+      next += written;
+    }
+  });
+
+  bool sequential = true;
+  unsigned expected = 0;
+  while (expected < N) {
+    unsigned chunk[5];
+    const std::size_t n = buffer.Read(chunk);
+    if (n == 0)
+      std::this_thread::yield();
+
+    for (std::size_t i = 0; i < n; ++i)
+      if (chunk[i] != expected++)
+        sequential = false;
+  }
+
+  producer.join();
+
+  ok1(sequential);
+  ok1(buffer.IsEmpty());
+}
+
+int
+main()
+{
+  plan_tests(14);
+
+  TestWrapAround();
+  TestThreads();
+
+  return exit_status();
+}
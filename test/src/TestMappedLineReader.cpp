@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "io/MappedLineReader.hpp"
+#include "system/Path.hpp"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+#include <string_view>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * A temporary file which is deleted by the destructor.
+ */
+class TempFile {
+  char path[64] = "/tmp/TestMappedLineReader.XXXXXX";
+
+public:
+  explicit TempFile(std::string_view contents) {
+    const int fd = mkstemp(path);
+    if (fd >= 0) {
+      [[maybe_unused]] auto nbytes =
+        write(fd, contents.data(), contents.size());
+      close(fd);
+    }
+  }
+
+  ~TempFile() noexcept {
+    unlink(path);
+  }
+
+  Path GetPath() const noexcept {
+    return Path{path};
+  }
+};
+
+static void
+TestLines()
+{
+  const TempFile file{"\xef\xbb\xbf" "first\r\nsecond\n\nlast"};
+  MappedLineReaderA reader{file.GetPath()};
+
+  /* the byte order mark is not part of the data */
+  ok1(reader.GetSize() == 19);
+  ok1(reader.Tell() == 0);
+
+  char *line = reader.ReadLine();
+  ok1(line != nullptr && StringIsEqual(line, "first"));
+  ok1(reader.Tell() == 7);
+
+  /* the buffer is writable */
+  line[0] = 'F';
+
+  line = reader.ReadLine();
+  ok1(line != nullptr && StringIsEqual(line, "second"));
+  line = reader.ReadLine();
+  ok1(line != nullptr && StringIsEqual(line, ""));
+  line = reader.ReadLine();
+  ok1(line != nullptr && StringIsEqual(line, "last"));
+  ok1(reader.ReadLine() == nullptr);
+  ok1(reader.Tell() == reader.GetSize());
+
+  reader.Rewind();
+  line = reader.ReadLine();
+  ok1(line != nullptr && StringIsEqual(line, "first"));
+}
+
+static void
+TestEmpty()
+{
+  const TempFile file{""};
+  MappedLineReaderA reader{file.GetPath()};
+  ok1(reader.GetSize() == 0);
+  ok1(reader.ReadLine() == nullptr);
+}
+
+static void
+TestMissing()
+{
+  bool thrown = false;
+  try {
+    MappedLineReaderA reader{Path{"/tmp/TestMappedLineReader.doesnotexist"}};
+  } catch (...) {
+    thrown = true;
+  }
+
+  ok1(thrown);
+}
+
+static void
+TestUTF8()
+{
+  const TempFile file{"Gr\xc3\xbc\xc3\x9f""e\nabc\n"};
+  MappedFileLineReader reader{file.GetPath(), Charset::AUTO};
+  ok1(reader.IsUTF8());
+
+  const TCHAR *line = reader.ReadLine();
+  ok1(line != nullptr && StringIsEqual(line, "Gr\xc3\xbc\xc3\x9f""e"));
+  line = reader.ReadLine();
+  ok1(line != nullptr && StringIsEqual(line, "abc"));
+  ok1(reader.ReadLine() == nullptr);
+}
+
+static void
+TestLatin1()
+{
+  /* the invalid sequence is in the last line, but the whole file is
+     converted */
+  const TempFile file{"\xe4sch\nabc\nM\xfcnchen\n"};
+  MappedFileLineReader reader{file.GetPath(), Charset::AUTO};
+  ok1(!reader.IsUTF8());
+
+  const TCHAR *line = reader.ReadLine();
+  ok1(line != nullptr && StringIsEqual(line, "\xc3\xa4sch"));
+  line = reader.ReadLine();
+  ok1(line != nullptr && StringIsEqual(line, "abc"));
+  line = reader.ReadLine();
+  ok1(line != nullptr && StringIsEqual(line, "M\xc3\xbcnchen"));
+  ok1(reader.ReadLine() == nullptr);
+}
+
+static void
+TestInvalidUTF8()
+{
+  const TempFile file{"abc\nM\xfcnchen\n"};
+  MappedFileLineReader reader{file.GetPath(), Charset::UTF8};
+  ok1(!reader.IsUTF8());
+
+  const TCHAR *line = reader.ReadLine();
+  ok1(line != nullptr && StringIsEqual(line, "abc"));
+
+  bool thrown = false;
+  try {
+    reader.ReadLine();
+  } catch (...) {
+    thrown = true;
+  }
+
+  ok1(thrown);
+}
+
+int
+main()
+{
+  plan_tests(25);
+
+  TestLines();
+  TestEmpty();
+  TestMissing();
+  TestUTF8();
+  TestLatin1();
+  TestInvalidUTF8();
+
+  return exit_status();
+}
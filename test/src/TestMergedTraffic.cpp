@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Tracking/MergedTraffic.hpp"
+#include "TestUtil.hpp"
+
+static FlarmId
+MakeId(const char *s)
+{
+  return FlarmId::Parse(s, nullptr);
+}
+
+static GeoPoint
+MakePoint(double longitude, double latitude)
+{
+  return GeoPoint(Angle::Degrees(longitude), Angle::Degrees(latitude));
+}
+
+int
+main()
+{
+  plan_tests(12);
+
+  using Source = MergedTraffic::Source;
+
+  const GeoPoint origin = MakePoint(7, 51);
+
+  MergedTrafficList list;
+  list.Add(Source::JET_PROVIDER, MakeId("DDA5BA"),
+           MakePoint(7.01, 51), {}).name = "jet";
+  list.Add(Source::SKYLINES, FlarmId::Undefined(),
+           MakePoint(7.5, 51), {});
+  list.Add(Source::FLARM, MakeId("DDA5BA"),
+           MakePoint(7.02, 51), {}).name = "flarm";
+  list.Add(Source::JET_PROVIDER, MakeId("3C6444"),
+           MakePoint(7.1, 51), {});
+  list.Add(Source::SKYLINES, FlarmId::Undefined(),
+           MakePoint(7.2, 51), {});
+
+  list.Finish(origin);
+
+  /* the JETProvider duplicate of the FLARM target is gone, SkyLines
+     traffic without an id is never merged */
+  ok1(list.size() == 4);
+
+  auto i = list.begin();
+  ok1(i->source == Source::FLARM);
+  ok1(i->name == "flarm");
+  ok1(i->sources == (MergedTraffic::SourceMask(Source::FLARM) |
+                     MergedTraffic::SourceMask(Source::JET_PROVIDER)));
+  ok1(i->distance > 1000 && i->distance < 2000);
+
+  /* sorted by distance */
+  ++i;
+  ok1(i->source == Source::JET_PROVIDER);
+  ok1(i->sources == MergedTraffic::SourceMask(Source::JET_PROVIDER));
+  ++i;
+  ok1(i->source == Source::SKYLINES && equals(i->location.longitude, 7.2));
+  ++i;
+  ok1(i->source == Source::SKYLINES && equals(i->location.longitude, 7.5));
+  ++i;
+  ok1(i == list.end());
+
+  list.Clear();
+  ok1(list.empty());
+  list.Finish(origin);
+  ok1(list.empty());
+
+  return exit_status();
+}
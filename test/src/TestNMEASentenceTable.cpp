@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Device/Util/SentenceTable.hpp"
+#include "TestUtil.hpp"
+
+using std::string_view_literals::operator""sv;
+
+/* names which differ only in the last character */
+static constexpr NMEASentence<unsigned> sentence_list[] = {
+  {"$PFLAA"sv, 1},
+  {"$PFLAE"sv, 2},
+  {"$PFLAU"sv, 3},
+  {"$PFLAV"sv, 4},
+  {"$PFLAC"sv, 5},
+  {"$PFLAQ"sv, 6},
+  {"$PFLAO"sv, 7},
+  {"$PFLAI"sv, 8},
+  {"$LXWP0"sv, 9},
+  {"$LXWP1"sv, 10},
+};
+
+static constexpr NMEASentenceTable sentences{sentence_list};
+
+static_assert(*sentences.Find("$PFLAU"sv) == 3);
+static_assert(sentences.Find("$PFLAX"sv) == nullptr);
+
+int
+main()
+{
+  plan_tests(std::size(sentence_list) + 5);
+
+  for (const auto &i : sentence_list) {
+    const unsigned *value = sentences.Find(i.name);
+    ok1(value != nullptr && *value == i.value);
+  }
+
+  ok1(sentences.Find(""sv) == nullptr);
+  ok1(sentences.Find("$PFLA"sv) == nullptr);
+  ok1(sentences.Find("$PFLAUX"sv) == nullptr);
+  ok1(sentences.Find("$LXWP2"sv) == nullptr);
+  ok1(sentences.Find("PFLAU"sv) == nullptr);
+
+  return exit_status();
+}
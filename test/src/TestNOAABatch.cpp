@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Weather/NOAABatch.hpp"
+#include "time/BrokenDateTime.hpp"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+using namespace NOAABatch;
+
+static void
+TestSplitter()
+{
+  RecordSplitter records{
+    "EDDL 201950Z 22009KT 9999 FEW035 BKN038 16/11 Q1023 NOSIG\n"
+    "EDDK 201950Z 23008KT CAVOK 17/10 Q1022\r\n"
+    "\n"
+    "TAF EDDL 011100Z 0112/0218 32010KT 9999 SCT040\n"
+    "      TEMPO 0112/0119 4000 SHRA\n"
+    "      BECMG 0118/0121 32005KT\n"
+    "TAF EDDK 011100Z 0112/0218 VRB03KT CAVOK"
+  };
+
+  ok1(records.Next() ==
+      "EDDL 201950Z 22009KT 9999 FEW035 BKN038 16/11 Q1023 NOSIG");
+  ok1(records.Next() == "EDDK 201950Z 23008KT CAVOK 17/10 Q1022");
+  ok1(records.Next() ==
+      "TAF EDDL 011100Z 0112/0218 32010KT 9999 SCT040\n"
+      "      TEMPO 0112/0119 4000 SHRA\n"
+      "      BECMG 0118/0121 32005KT");
+  ok1(records.Next() == "TAF EDDK 011100Z 0112/0218 VRB03KT CAVOK");
+  ok1(records.Next().empty());
+  ok1(records.Next().empty());
+
+  ok1(RecordSplitter{""}.Next().empty());
+  ok1(RecordSplitter{"\n\n  \n"}.Next().empty());
+}
+
+static void
+TestHeader()
+{
+  Header header;
+
+  ok1(ParseHeader("EDDL 201950Z 22009KT 9999", header));
+  ok1(StringIsEqual(header.code, "EDDL"));
+  ok1(header.day == 20);
+  ok1(header.hour == 19);
+  ok1(header.minute == 50);
+
+  ok1(ParseHeader("METAR KTTN 051853Z 04011KT", header));
+  ok1(StringIsEqual(header.code, "KTTN"));
+  ok1(header.day == 5);
+
+  ok1(ParseHeader("TAF AMD EDDK 011105Z 0112/0218 VRB03KT", header));
+  ok1(StringIsEqual(header.code, "EDDK"));
+  ok1(header.day == 1);
+  ok1(header.hour == 11);
+  ok1(header.minute == 5);
+
+  ok1(!ParseHeader("", header));
+  ok1(!ParseHeader("No data", header));
+  ok1(!ParseHeader("EDDL 2019Z 22009KT", header));
+  ok1(!ParseHeader("EDDL 201960Z 22009KT", header));
+  ok1(!ParseHeader("eddl 201950Z 22009KT", header));
+}
+
+static void
+TestTime()
+{
+  Header header;
+  ParseHeader("EDDL 201950Z", header);
+
+  ok1(header.IsSameTime(BrokenDateTime(2011, 9, 20, 19, 50)));
+  ok1(!header.IsSameTime(BrokenDateTime(2011, 9, 20, 19, 20)));
+  ok1(!header.IsSameTime(BrokenDateTime(2011, 9, 21, 19, 50)));
+
+  /* same month */
+  ok1(header.ToDateTime(BrokenDateTime(2011, 9, 20, 20, 5)) ==
+      BrokenDateTime(2011, 9, 20, 19, 50));
+
+  /* previous month */
+  ok1(header.ToDateTime(BrokenDateTime(2011, 10, 1, 0, 5)) ==
+      BrokenDateTime(2011, 9, 20, 19, 50));
+
+  /* previous year */
+  ok1(header.ToDateTime(BrokenDateTime(2012, 1, 2, 0, 5)) ==
+      BrokenDateTime(2011, 12, 20, 19, 50));
+
+  /* clamped to the length of the previous month */
+  ParseHeader("EDDL 311950Z", header);
+  ok1(header.ToDateTime(BrokenDateTime(2011, 3, 1, 0, 5)) ==
+      BrokenDateTime(2011, 2, 28, 19, 50));
+}
+
+int
+main()
+{
+  plan_tests(33);
+
+  TestSplitter();
+  TestHeader();
+  TestTime();
+
+  return exit_status();
+}
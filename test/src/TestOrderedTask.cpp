@@ -9,6 +9,9 @@
 #include "Engine/Task/Ordered/Points/FinishPoint.hpp"
 #include "Engine/Task/Ordered/Points/ASTPoint.hpp"
 #include "Engine/Task/ObservationZones/LineSectorZone.hpp"
+#include "Engine/Task/ObservationZones/Boundary.hpp"
+
+#include <algorithm>
 
 #define ACCURACY 500
 
@@ -387,6 +390,68 @@ TestLowTPFinal()
   CheckTotal(aircraft, stats, tp1, tp2, tp3);
 }
 
+static bool
+IsFreshBoundary(const OrderedTaskPoint &tp)
+{
+  const OZBoundary *cached = tp.GetCachedBoundary();
+  if (cached == nullptr)
+    return false;
+
+  const OZBoundary fresh = tp.GetBoundary();
+  return std::equal(cached->begin(), cached->end(),
+                    fresh.begin(), fresh.end());
+}
+
+static void
+TestBoundaryCache()
+{
+  OrderedTask task(task_behaviour);
+  const StartPoint tp1(std::make_unique<LineSectorZone>(wp1->location),
+                       WaypointPtr(wp1), task_behaviour,
+                       ordered_task_settings.start_constraints);
+  task.Append(tp1);
+  const ASTPoint tp2(SymmetricSectorZone::CreateFAISectorZone(wp3->location),
+                     WaypointPtr(wp3), task_behaviour);
+  task.Append(tp2);
+  const FinishPoint tp3(std::make_unique<LineSectorZone>(wp4->location),
+                        WaypointPtr(wp4), task_behaviour,
+                        ordered_task_settings.finish_constraints, false);
+  task.Append(tp3);
+  task.UpdateGeometry();
+
+  const OrderedTaskPoint &tp = task.GetTaskPoint(1);
+  const OZBoundary *boundary = tp.GetCachedBoundary();
+  ok1(IsFreshBoundary(tp));
+
+  /* nothing has changed: the boundary is reused */
+  task.UpdateGeometry();
+  ok1(tp.GetCachedBoundary() == boundary);
+
+  /* a copy of the task shares the boundary */
+  const auto copy = task.Clone(task_behaviour);
+  ok1(copy->GetTaskPoint(1).GetCachedBoundary() == boundary);
+
+  /* so does a copy whose geometry is calculated later */
+  const auto definition = task.CloneDefinition(task_behaviour);
+  definition->UpdateGeometry();
+  ok1(definition->GetTaskPoint(1).GetCachedBoundary() == boundary);
+  ok1(definition->GetStats().distance_nominal ==
+      copy->GetStats().distance_nominal);
+  ok1(definition->GetStats().distance_min == copy->GetStats().distance_min);
+
+  /* moving the finish rotates the sector */
+  const FinishPoint tp4(std::make_unique<LineSectorZone>(wp5->location),
+                        WaypointPtr(wp5), task_behaviour,
+                        ordered_task_settings.finish_constraints, false);
+  task.Replace(tp4, 2);
+  task.UpdateGeometry();
+  ok1(tp.GetCachedBoundary() != boundary);
+  ok1(IsFreshBoundary(tp));
+
+  /* the copy still has the old one */
+  ok1(copy->GetTaskPoint(1).GetCachedBoundary() == boundary);
+}
+
 static void
 TestAll()
 {
@@ -401,10 +466,12 @@ TestAll()
 
 int main()
 {
-  plan_tests(728);
+  plan_tests(737);
 
   task_behaviour.SetDefaults();
 
+  TestBoundaryCache();
+
   TestAll();
 
   glide_polar.SetMC(1);
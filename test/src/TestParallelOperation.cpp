@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Operation/ParallelOperationEnvironment.hpp"
+#include "TestUtil.hpp"
+
+#include <thread>
+
+#include <string.h>
+
+class RecordingOperationEnvironment final : public NullOperationEnvironment {
+public:
+  StaticString<256> error{_T("")}, text{_T("")};
+  unsigned range = 0, position = 0, n_positions = 0;
+
+  void SetErrorMessage(const TCHAR *_error) noexcept override {
+    error = _error;
+  }
+
+  void SetText(const TCHAR *_text) noexcept override {
+    text = _text;
+  }
+
+  void SetProgressRange(unsigned _range) noexcept override {
+    range = _range;
+  }
+
+  void SetProgressPosition(unsigned _position) noexcept override {
+    position = _position;
+    ++n_positions;
+  }
+};
+
+static constexpr unsigned SLOT_RANGE =
+  ParallelOperationEnvironment::SLOT_RANGE;
+
+static void
+TestCombined()
+{
+  RecordingOperationEnvironment main;
+  ParallelOperationEnvironment parallel(main, 3);
+  ok1(main.range == 3 * SLOT_RANGE);
+  ok1(main.position == 0);
+
+  /* calls in this thread are forwarded right away */
+  parallel[0].SetProgressRange(10);
+  parallel[0].SetProgressPosition(5);
+  ok1(main.position == SLOT_RANGE / 2);
+
+  parallel[1].SetText(_T("foo"));
+  ok1(strcmp(main.text, _T("foo")) == 0);
+
+  parallel[2].SetProgressRange(4);
+  parallel[2].SetProgressPosition(8);
+  ok1(main.position == SLOT_RANGE / 2 + SLOT_RANGE);
+
+  /* unchanged progress is not forwarded again */
+  const unsigned n = main.n_positions;
+  parallel[1].SetProgressRange(0);
+  ok1(main.n_positions == n);
+}
+
+static void
+TestOtherThread()
+{
+  RecordingOperationEnvironment main;
+  ParallelOperationEnvironment parallel(main, 2);
+
+  std::thread thread([&parallel]{
+    auto &env = parallel[1];
+    env.SetProgressRange(2);
+    env.SetProgressPosition(1);
+    env.SetText(_T("bar"));
+    env.SetErrorMessage(_T("error"));
+  });
+  thread.join();
+
+  /* nothing is forwarded from the other thread ... */
+  ok1(main.position == 0);
+  ok1(main.text.empty());
+  ok1(main.error.empty());
+
+  /* ... until Flush() */
+  parallel.Flush();
+  ok1(main.position == SLOT_RANGE / 2);
+  ok1(strcmp(main.text, _T("bar")) == 0);
+  ok1(strcmp(main.error, _T("error")) == 0);
+
+  /* messages are passed only once */
+  main.error.clear();
+  parallel.Flush();
+  ok1(main.error.empty());
+}
+
+int
+main()
+{
+  plan_tests(13);
+
+  TestCombined();
+  TestOtherThread();
+
+  return exit_status();
+}
@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+/*
+ * Compare the SIMD implementations of the memory canvas pixel
+ * operations (see Optimised.hpp) with the portable ones.
+ */
+
+#include "ui/canvas/memory/Optimised.hpp"
+#include "ui/canvas/memory/Dither.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+/* not a multiple of the SIMD block size, to check the remainder */
+static constexpr unsigned N = 77;
+
+using GreyBuffer = std::array<Luminosity8, N>;
+
+static void
+Randomize(GreyBuffer &b) noexcept
+{
+  for (auto &i : b)
+    i = Luminosity8(rand());
+}
+
+static bool
+Near(uint8_t a, uint8_t b, unsigned tolerance) noexcept
+{
+  return unsigned(std::abs(int(a) - int(b))) <= tolerance;
+}
+
+static bool
+Near(const GreyBuffer &a, const GreyBuffer &b, unsigned tolerance) noexcept
+{
+  for (unsigned i = 0; i < N; ++i)
+    if (!Near(a[i].GetLuminosity(), b[i].GetLuminosity(), tolerance))
+      return false;
+  return true;
+}
+
+static bool
+Equals(const GreyBuffer &a, const GreyBuffer &b) noexcept
+{
+  return Near(a, b, 0);
+}
+
+static void
+TestGreyscale()
+{
+  GreyBuffer src, dest;
+  Randomize(src);
+  Randomize(dest);
+
+  GreyBuffer a = dest, b = dest;
+  BitOrPixelOperations<GreyscalePixelTraits>().CopyPixels(a.data(),
+                                                          src.data(), N);
+  PortableBitOrPixelOperations<GreyscalePixelTraits>().CopyPixels(b.data(),
+                                                                  src.data(), N);
+  ok1(Equals(a, b));
+
+  /* make some source pixels transparent */
+  for (unsigned i = 0; i < N; i += 3)
+    src[i] = Luminosity8(0xff);
+
+  a = b = dest;
+  TransparentPixelOperations<GreyscalePixelTraits>(Luminosity8(0xff))
+    .CopyPixels(a.data(), src.data(), N);
+  PortableTransparentPixelOperations<GreyscalePixelTraits>(Luminosity8(0xff))
+    .CopyPixels(b.data(), src.data(), N);
+  ok1(Equals(a, b));
+
+  /* the SIMD alpha blending rounds differently */
+  for (const uint8_t alpha : {0x00, 0x40, 0x80, 0xff}) {
+    a = b = dest;
+    AlphaPixelOperations<GreyscalePixelTraits>(alpha)
+      .CopyPixels(a.data(), src.data(), N);
+    PortableAlphaPixelOperations<GreyscalePixelTraits>(alpha)
+      .CopyPixels(b.data(), src.data(), N);
+    ok1(Near(a, b, 2));
+
+    a = b = dest;
+    AlphaPixelOperations<GreyscalePixelTraits>(alpha)
+      .FillPixels(a.data(), N, Luminosity8(0xc0));
+    PortableAlphaPixelOperations<GreyscalePixelTraits>(alpha)
+      .FillPixels(b.data(), N, Luminosity8(0xc0));
+    ok1(Near(a, b, 2));
+  }
+}
+
+#ifndef GREYSCALE
+
+using BGRABuffer = std::array<BGRA8Color, N>;
+
+static void
+Randomize(BGRABuffer &b) noexcept
+{
+  for (auto &i : b)
+    i = BGRA8Color(rand(), rand(), rand());
+}
+
+/**
+ * Compare the colour channels; the SIMD implementations blend the
+ * alpha channel, too.
+ */
+static bool
+Near(const BGRABuffer &a, const BGRABuffer &b, unsigned tolerance) noexcept
+{
+  for (unsigned i = 0; i < N; ++i)
+    if (!Near(a[i].Red(), b[i].Red(), tolerance) ||
+        !Near(a[i].Green(), b[i].Green(), tolerance) ||
+        !Near(a[i].Blue(), b[i].Blue(), tolerance))
+      return false;
+  return true;
+}
+
+static void
+TestBGRA()
+{
+  BGRABuffer src, dest;
+  Randomize(src);
+  Randomize(dest);
+
+  for (const uint8_t alpha : {0x00, 0x40, 0x80, 0xff}) {
+    BGRABuffer a = dest, b = dest;
+    AlphaPixelOperations<BGRAPixelTraits>(alpha)
+      .CopyPixels(a.data(), src.data(), N);
+    PortableAlphaPixelOperations<BGRAPixelTraits>(alpha)
+      .CopyPixels(b.data(), src.data(), N);
+    ok1(Near(a, b, 2));
+
+    const BGRA8Color color(0x20, 0x80, 0xe0);
+    a = b = dest;
+    AlphaPixelOperations<BGRAPixelTraits>(alpha)
+      .FillPixels(a.data(), N, color);
+    PortableAlphaPixelOperations<BGRAPixelTraits>(alpha)
+      .FillPixels(b.data(), N, color);
+    ok1(Near(a, b, 2));
+  }
+}
+
+#endif
+
+/**
+ * The plain Sierra Lite error diffusion, without the fast path for
+ * black and white areas.
+ */
+static void
+ReferenceDither(const uint8_t *src, uint8_t *dest,
+                unsigned width, unsigned height) noexcept
+{
+  const unsigned width_2 = width + 2;
+  std::vector<int> buffer(width_2 * 2);
+
+  for (; height; --height) {
+    int *l0 = buffer.data() + ((height & 1) ? width_2 : 0) + 1;
+    int *l1 = buffer.data() + ((height & 1) ? 0 : width_2);
+
+    int e0 = *l0++;
+    int e1 = *l1;
+
+    for (unsigned column = 0; column < width; ++column) {
+      int bw = e0 + src[column];
+      uint8_t color = 0;
+      if (bw >= 128) {
+        color = 0xff;
+        bw -= 255;
+      }
+
+      dest[column] = color;
+
+      bw >>= 1;
+      e0 = *l0 + bw;
+      *l0++ = e0;
+      bw >>= 1;
+      *l1++ = e1 + bw;
+      e1 = bw;
+    }
+
+    *l1 = e1;
+
+    src += width;
+    dest += width;
+  }
+}
+
+static void
+TestDither()
+{
+  constexpr unsigned WIDTH = 100, HEIGHT = 40;
+
+  /* white background with black lines and a few grey areas */
+  std::vector<uint8_t> src(WIDTH * HEIGHT, 0xff);
+  for (unsigned y = 0; y < HEIGHT; ++y)
+    for (unsigned x = 0; x < WIDTH; ++x)
+      if (x == y || x == 50)
+        src[y * WIDTH + x] = 0;
+      else if (x > 70 && y > 10 && y < 20)
+        src[y * WIDTH + x] = 0x80;
+      else if (y == 30 && x < 20)
+        src[y * WIDTH + x] = rand();
+
+  std::vector<uint8_t> expected(src.size()), actual(src.size());
+  ReferenceDither(src.data(), expected.data(), WIDTH, HEIGHT);
+
+  Dither dither;
+  dither.DitherGreyscale(src.data(), WIDTH, actual.data(), WIDTH,
+                         WIDTH, HEIGHT);
+  ok1(actual == expected);
+
+  /* again, with a dirty error buffer */
+  std::fill(src.begin(), src.end(), 0x7f);
+  ReferenceDither(src.data(), expected.data(), WIDTH, HEIGHT);
+  dither.DitherGreyscale(src.data(), WIDTH, actual.data(), WIDTH,
+                         WIDTH, HEIGHT);
+  ok1(actual == expected);
+}
+
+int
+main()
+{
+#ifdef GREYSCALE
+  plan_tests(12);
+#else
+  plan_tests(20);
+#endif
+
+  TestGreyscale();
+#ifndef GREYSCALE
+  TestBGRA();
+#endif
+  TestDither();
+
+  return exit_status();
+}
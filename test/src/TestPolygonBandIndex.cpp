@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Geo/PolygonBandIndex.hpp"
+#include "Geo/SearchPointVector.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+static double
+Random(double min, double max)
+{
+  return min + (max - min) * (rand() / (double)RAND_MAX);
+}
+
+/**
+ * A closed star-shaped polygon with a ragged border, similar to a
+ * coastline-following airspace.
+ */
+static SearchPointVector
+MakeStar(unsigned n)
+{
+  SearchPointVector border;
+  for (unsigned i = 0; i < n; ++i) {
+    const double angle = 2 * M_PI * i / n;
+    const double radius = Random(0.2, 1);
+    border.emplace_back(GeoPoint(Angle::Degrees(10 + radius * std::cos(angle)),
+                                 Angle::Degrees(47 + radius * std::sin(angle))));
+  }
+
+  border.emplace_back(border.front().GetLocation());
+  return border;
+}
+
+static bool
+CheckInside(const SearchPointVector &border, const PolygonBandIndex &index)
+{
+  for (unsigned i = 0; i < 5000; ++i) {
+    const GeoPoint p(Angle::Degrees(Random(8.8, 11.2)),
+                     Angle::Degrees(Random(45.8, 48.2)));
+    if (index.IsInside(border, p) != border.IsInside(p))
+      return false;
+  }
+
+  /* points on the latitude of a vertex are the tricky ones */
+  for (const auto &i : border) {
+    const GeoPoint p(Angle::Degrees(Random(8.8, 11.2)),
+                     i.GetLocation().latitude);
+    if (index.IsInside(border, p) != border.IsInside(p))
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * Check that ForEachEdge() visits each edge overlapping the range
+ * exactly once.
+ */
+static bool
+CheckForEachEdge(const SearchPointVector &border,
+                 const PolygonBandIndex &index,
+                 Angle south, Angle north)
+{
+  std::vector<unsigned> visits(border.size() - 1, 0);
+  index.ForEachEdge(border, south, north, [&visits](std::size_t i){
+    ++visits[i];
+  });
+
+  for (std::size_t i = 0; i + 1 < border.size(); ++i) {
+    const Angle a = border[i].GetLocation().latitude;
+    const Angle b = border[i + 1].GetLocation().latitude;
+    const bool overlaps = std::max(a, b) >= south && std::min(a, b) <= north;
+
+    if (visits[i] > 1 || (overlaps && visits[i] == 0))
+      return false;
+  }
+
+  return true;
+}
+
+int
+main()
+{
+  plan_tests(9);
+
+  srand(42);
+
+  const auto star = MakeStar(2000);
+  PolygonBandIndex index;
+  index.Build(star);
+  ok1(index.IsDefined());
+  ok1(CheckInside(star, index));
+
+  ok1(CheckForEachEdge(star, index, Angle::Degrees(46.5), Angle::Degrees(46.6)));
+  ok1(CheckForEachEdge(star, index, Angle::Degrees(46), Angle::Degrees(48)));
+  ok1(CheckForEachEdge(star, index, Angle::Degrees(47.9), Angle::Degrees(50)));
+
+  /* small polygons are not indexed, but the results are the same */
+  const auto small = MakeStar(10);
+  PolygonBandIndex small_index;
+  small_index.Build(small);
+  ok1(!small_index.IsDefined());
+  ok1(CheckInside(small, small_index));
+  ok1(CheckForEachEdge(small, small_index,
+                       Angle::Degrees(46.5), Angle::Degrees(46.6)));
+
+  /* rebuilding a modified polygon */
+  auto pruned = star;
+  pruned.PruneInterior();
+  index.Build(pruned);
+  ok1(CheckInside(pruned, index));
+
+  return exit_status();
+}
@@ -2,8 +2,11 @@
 // Copyright The XCSoar Project
 
 #include "Profile/Profile.hpp"
+#include "Profile/SaveThread.hpp"
+#include "Profile/File.hpp"
 #include "io/FileLineReader.hpp"
 #include "system/Path.hpp"
+#include "system/FileUtil.hpp"
 #include "TestUtil.hpp"
 #include "util/StringAPI.hxx"
 #include "util/StaticString.hxx"
@@ -91,6 +94,67 @@ TestWriter()
   ok1(found2);
 }
 
+static void
+TestSaveThread()
+{
+  const Path path(_T("output/TestProfileSaveThread.prf"));
+  File::Delete(path);
+
+  ProfileMap map;
+
+  {
+    /* a long delay: nothing is written before Flush() */
+    ProfileSaveThread thread{std::chrono::hours(1)};
+
+    map.Set("key", 1);
+    thread.Schedule(map, path);
+    map.Set("key", 2);
+    thread.Schedule(map, path);
+    ok1(!File::Exists(path));
+
+    thread.Flush();
+    ok1(!thread.CheckFailed());
+
+    ProfileMap loaded;
+    Profile::LoadFile(loaded, path);
+    int value;
+    ok1(loaded.Get("key", value) && value == 2);
+
+    /* Stop() writes the pending snapshot, too */
+    map.Set("key", 3);
+    thread.Schedule(map, path);
+    thread.Stop();
+
+    loaded.Clear();
+    Profile::LoadFile(loaded, path);
+    ok1(loaded.Get("key", value) && value == 3);
+
+    /* the thread can be relaunched */
+    map.Set("key", 4);
+    thread.Schedule(map, path);
+  }
+
+  /* ... and the destructor stops it */
+  ProfileMap loaded;
+  Profile::LoadFile(loaded, path);
+  int value;
+  ok1(loaded.Get("key", value) && value == 4);
+
+  /* writing to a directory which does not exist fails */
+  {
+    ProfileSaveThread thread{std::chrono::seconds(0)};
+    thread.Schedule(map, Path(_T("output/does/not/exist.prf")));
+    thread.Flush();
+    ok1(thread.CheckFailed());
+    ok1(!thread.CheckFailed());
+  }
+
+  /* removing a key is a modification */
+  map.SetModified(false);
+  map.Remove("key");
+  ok1(map.IsModified());
+}
+
 static void
 TestReader()
 {
@@ -121,10 +185,11 @@ TestReader()
 
 int main()
 try {
-  plan_tests(31);
+  plan_tests(39);
 
   TestMap();
   TestWriter();
+  TestSaveThread();
   TestReader();
 
   return exit_status();
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Profiler.hpp"
+#include "TestUtil.hpp"
+#include "util/StringAPI.hxx"
+
+using std::chrono::milliseconds;
+
+static void
+TestDisabled()
+{
+  Profiler::SetEnabled(false);
+  ok1(!Profiler::IsEnabled());
+
+  Profiler::AddSkippedFrame();
+
+  {
+    const Profiler::ScopeTick tick{Profiler::Thread::MERGE};
+  }
+
+  const auto report = Profiler::GetReport();
+  ok1(report.skipped_frames == 0);
+  ok1(report.GetTick(Profiler::Thread::MERGE).count == 0);
+}
+
+static void
+TestFrames()
+{
+  Profiler::SetEnabled(true);
+
+  for (unsigned i = 1; i <= 100; ++i)
+    Profiler::AddFrame(milliseconds(i));
+
+  Profiler::AddSkippedFrame();
+  Profiler::AddSkippedFrame();
+
+  auto report = Profiler::GetReport();
+  ok1(report.n_frames == 100);
+  ok1(report.skipped_frames == 2);
+  ok1(equals(report.frame_p50, 51));
+  ok1(equals(report.frame_p90, 91));
+  ok1(equals(report.frame_p99, 100));
+
+  /* the ring buffer keeps only the most recent frames */
+  for (unsigned i = 0; i < Profiler::MAX_FRAMES; ++i)
+    Profiler::AddFrame(milliseconds(10));
+
+  report = Profiler::GetReport();
+  ok1(equals(report.frame_p50, 10));
+  ok1(equals(report.frame_p99, 10));
+
+  /* enabling again clears the statistics */
+  Profiler::SetEnabled(false);
+  Profiler::SetEnabled(true);
+  report = Profiler::GetReport();
+  ok1(report.n_frames == 0);
+  ok1(report.skipped_frames == 0);
+  ok1(equals(report.frame_p50, 0));
+}
+
+static void
+TestLayers()
+{
+  Profiler::SetEnabled(false);
+  Profiler::SetEnabled(true);
+
+  Profiler::AddLayer("B", milliseconds(4));
+  Profiler::AddLayer("A", milliseconds(2));
+  Profiler::AddLayer("B", milliseconds(20));
+
+  const auto report = Profiler::GetReport();
+  ok1(report.layers.size() == 2);
+  ok1(StringIsEqual(report.layers[0].name, "B"));
+  ok1(equals(report.layers[0].average, 5));
+  ok1(StringIsEqual(report.layers[1].name, "A"));
+  ok1(equals(report.layers[1].average, 2));
+}
+
+static void
+TestTicks()
+{
+  Profiler::SetEnabled(false);
+  Profiler::SetEnabled(true);
+
+  Profiler::AddTick(Profiler::Thread::CALCULATION, milliseconds(10));
+  Profiler::AddTick(Profiler::Thread::CALCULATION, milliseconds(30));
+
+  {
+    const Profiler::ScopeTick tick{Profiler::Thread::MERGE};
+  }
+
+  const auto report = Profiler::GetReport();
+  const auto &calculation = report.GetTick(Profiler::Thread::CALCULATION);
+  ok1(calculation.count == 2);
+  ok1(equals(calculation.average, 20));
+  ok1(equals(calculation.max, 30));
+  ok1(report.GetTick(Profiler::Thread::MERGE).count == 1);
+}
+
+int
+main()
+{
+  plan_tests(22);
+
+  TestDisabled();
+  TestFrames();
+  TestLayers();
+  TestTicks();
+
+  return exit_status();
+}
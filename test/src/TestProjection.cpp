@@ -4,6 +4,8 @@
 #include "Projection/Projection.hpp"
 #include "TestUtil.hpp"
 
+#include <array>
+
 static void
 TestGeoScreenCouple(const Projection prj, const GeoPoint geo,
                     int x, int y)
@@ -27,11 +29,65 @@ test_simple()
                                     Angle::Zero()), 0, 0);
 }
 
+/**
+ * The original GeoToScreen() implementation, to verify the inline
+ * one in #FastGeoToScreen.
+ */
+static PixelPoint
+ReferenceGeoToScreen(const Projection &prj, const GeoPoint &g)
+{
+  const GeoPoint d = prj.GetGeoLocation() - g;
+  const FastIntegerRotation rotation(prj.GetScreenAngle());
+  const auto p =
+    rotation.Rotate(PixelPoint(int(g.latitude.fastcosine() *
+                                   prj.AngleToPixels(d.longitude)),
+                               (int)prj.AngleToPixels(d.latitude)));
+
+  return {prj.GetScreenOrigin().x - p.x, prj.GetScreenOrigin().y + p.y};
+}
+
+static void
+TestBatch(GeoPoint location, Angle angle)
+{
+  Projection prj;
+  prj.SetScreenOrigin(320, 240);
+  prj.SetScale(0.01);
+  prj.SetGeoLocation(location);
+  prj.SetScreenAngle(angle);
+
+  std::array<GeoPoint, 64> src;
+  for (unsigned i = 0; i < src.size(); ++i)
+    src[i] = location + GeoPoint(Angle::Degrees(int(i % 8) * 0.7 - 2.5),
+                                 Angle::Degrees(int(i / 8) * 0.3 - 1.1));
+
+  std::array<PixelPoint, src.size()> dest;
+  prj.GeoToScreen(src, std::span{dest});
+
+  bool equal = true;
+  for (unsigned i = 0; i < src.size(); ++i)
+    if (dest[i] != ReferenceGeoToScreen(prj, src[i]) ||
+        prj.GeoToScreen(src[i]) != dest[i])
+      equal = false;
+
+  ok1(equal);
+}
+
 int main()
 {
-  plan_tests(4);
+  plan_tests(4 + 4);
 
   test_simple();
 
+  TestBatch(GeoPoint(Angle::Degrees(7.7), Angle::Degrees(51.0)),
+            Angle::Zero());
+  TestBatch(GeoPoint(Angle::Degrees(7.7), Angle::Degrees(51.0)),
+            Angle::Degrees(123));
+
+  /* across the date line */
+  TestBatch(GeoPoint(Angle::Degrees(179.5), Angle::Degrees(-45.0)),
+            Angle::Degrees(10));
+  TestBatch(GeoPoint(Angle::Degrees(-179.5), Angle::Degrees(-45.0)),
+            Angle::Degrees(-200));
+
   return exit_status();
 }
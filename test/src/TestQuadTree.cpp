@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "util/QuadTree.hxx"
+#include "TestUtil.hpp"
+
+#include <cstdint>
+#include <vector>
+
+struct Item {
+  int x, y;
+  unsigned id;
+};
+
+struct ItemAccessor {
+  int GetX(const Item &item) const noexcept {
+    return item.x;
+  }
+
+  int GetY(const Item &item) const noexcept {
+    return item.y;
+  }
+};
+
+using Tree = QuadTree<Item, ItemAccessor>;
+
+static constexpr unsigned N = 2000;
+
+static void
+Fill(Tree &tree)
+{
+  uint32_t seed = 42;
+  for (unsigned i = 0; i < N; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const int x = int(seed >> 8) % 30000;
+    seed = seed * 1103515245 + 12345;
+    const int y = int(seed >> 8) % 30000;
+    tree.Add(Item{x, y, i});
+  }
+
+  tree.Optimise();
+}
+
+static std::vector<unsigned>
+FindNearest(const Tree &tree)
+{
+  std::vector<unsigned> result;
+  for (int x = 0; x < 30000; x += 2371) {
+    for (int y = 0; y < 30000; y += 2053) {
+      const auto nearest = tree.FindNearest(Tree::Point{x, y}, 10000);
+      result.push_back(nearest.first != tree.end()
+                       ? nearest.first->id
+                       : unsigned(-1));
+    }
+  }
+
+  return result;
+}
+
+static unsigned
+CountWithinRange(const Tree &tree, int x, int y, unsigned range)
+{
+  unsigned n = 0;
+  auto visitor = [&n](const Item &){ ++n; };
+  tree.VisitWithinRange(Tree::Point{x, y}, range, visitor);
+  return n;
+}
+
+static bool
+IsContiguous(const Tree &tree)
+{
+  uintptr_t min = UINTPTR_MAX, max = 0;
+  for (const auto &item : tree) {
+    const auto p = reinterpret_cast<uintptr_t>(&item);
+    min = std::min(min, p);
+    max = std::max(max, p);
+  }
+
+  /* each Leaf is a pointer plus the value, padded to the pointer
+     alignment; individually allocated ones are further apart */
+  constexpr std::size_t align = alignof(void *);
+  constexpr std::size_t leaf_size =
+    (sizeof(void *) + sizeof(Item) + align - 1) / align * align;
+  return max - min < tree.size() * leaf_size;
+}
+
+static void
+TestPack()
+{
+  Tree tree;
+  Fill(tree);
+
+  const auto nearest = FindNearest(tree);
+  const unsigned in_range = CountWithinRange(tree, 15000, 15000, 5000);
+  ok1(in_range > 0);
+
+  tree.Pack();
+  ok1(tree.size() == N);
+  ok1(IsContiguous(tree));
+
+  /* lookups give the same results */
+  ok1(FindNearest(tree) == nearest);
+  ok1(CountWithinRange(tree, 15000, 15000, 5000) == in_range);
+
+  /* erase some packed values */
+  tree.EraseIf([](const Item &item){ return item.id % 2 == 0; });
+  ok1(tree.size() == N / 2);
+  tree.erase(tree.begin());
+  ok1(tree.size() == N / 2 - 1);
+
+  /* values added after packing are allocated individually */
+  tree.Add(Item{15000, 15000, N});
+  ok1(tree.size() == N / 2);
+  const auto n = tree.FindNearest(Tree::Point{15000, 15000}, 10);
+  ok1(n.first != tree.end() && n.first->id == N);
+
+  /* packing again frees the previous array */
+  tree.Pack();
+  ok1(tree.size() == N / 2);
+  ok1(IsContiguous(tree));
+  const auto n2 = tree.FindNearest(Tree::Point{15000, 15000}, 10);
+  ok1(n2.first != tree.end() && n2.first->id == N);
+
+  /* rebuilding a packed tree */
+  tree.Flatten();
+  tree.Add(Item{-1000, -1000, N + 1});
+  tree.Optimise();
+  ok1(tree.size() == N / 2 + 1);
+  ok1(CountWithinRange(tree, -1000, -1000, 1) == 1);
+
+  tree.Clear();
+  ok1(tree.IsEmpty());
+
+  /* packing an empty tree is a no-op */
+  tree.Pack();
+  ok1(tree.IsEmpty());
+}
+
+int
+main()
+{
+  plan_tests(16);
+
+  TestPack();
+
+  return exit_status();
+}
@@ -0,0 +1,407 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Tracking/JETProvider/RadarParser.hpp"
+#include "Tracking/JETProvider/TrafficTable.hpp"
+#include "Tracking/JETProvider/Extrapolate.hpp"
+#include "Tracking/JETProvider/Scheduler.hpp"
+#include "Geo/Math.hpp"
+#include "Units/System.hpp"
+#include "TestUtil.hpp"
+
+#include <span>
+#include <string>
+
+#include <string.h>
+
+static NMEAInfo
+MakeBasic()
+{
+  NMEAInfo basic{};
+  basic.clock = TimeStamp{FloatDuration{100}};
+  return basic;
+}
+
+static void
+TestValid()
+{
+  const NMEAInfo basic = MakeBasic();
+
+  RadarParser::Radar radar;
+  ok1(RadarParser::ParseRadarBuffer(basic,
+                                    "2,5\n"
+                                    "# comment\n"
+                                    "a1,deadbeef,D-1234,50.869501,0.010864,42,1500,300,200,1615771825,744\r\n"
+                                    "\n"
+                                    "b2,,,-10.5,-20.25,180,0,0,0,1615771826,\n",
+                                    radar));
+  ok1(radar.validity.IsValid());
+  ok1(radar.count == 2);
+  ok1(radar.total_count == 5);
+  if (!ok1(radar.traffics.size() == 2))
+    return;
+
+  const auto &a = radar.traffics[0];
+  ok1(strcmp(a.traffic_id, "a1") == 0);
+  ok1(strcmp(a.display, "deadbeef") == 0);
+  ok1(strcmp(a.code, "D-1234") == 0);
+  ok1(equals(a.location.latitude, 50.869501));
+  ok1(equals(a.location.longitude, 0.010864));
+  ok1(a.track == 42);
+  ok1(a.altitude == 457);
+  ok1(equals(a.speed, Units::ToSysUnit(300, Unit::KNOTS)));
+  ok1(equals(a.vspeed, Units::ToSysUnit(200, Unit::FEET_PER_MINUTE)));
+  ok1(a.epoch == 1615771825);
+  ok1(strcmp(a.type, "744") == 0);
+
+  const auto &b = radar.traffics[1];
+  ok1(strcmp(b.traffic_id, "b2") == 0);
+  ok1(*b.display == '\0');
+  ok1(equals(b.location.latitude, -10.5));
+  ok1(equals(b.location.longitude, -20.25));
+  ok1(*b.type == '\0');
+
+  /* all strings point into the per-response pool */
+  const char *begin = radar.strings.data();
+  const char *end = begin + radar.strings.size();
+  ok1(a.traffic_id >= begin && a.type < end);
+  ok1(b.traffic_id >= begin && b.type < end);
+}
+
+static void
+TestInvalid()
+{
+  const NMEAInfo basic = MakeBasic();
+
+  RadarParser::Radar radar;
+  ok1(!RadarParser::ParseRadarBuffer(basic, "", radar));
+  ok1(!RadarParser::ParseRadarBuffer(basic, "1\n", radar));
+  ok1(!RadarParser::ParseRadarBuffer(basic, "1,2,3\n", radar));
+  ok1(!RadarParser::ParseRadarBuffer(basic, "1,1\na1,b,c,1,2,3\n", radar));
+  ok1(!RadarParser::ParseRadarBuffer(basic,
+                                     "1,1\na1,b,c,1,2,3,4,5,6,7,8,9\n",
+                                     radar));
+  ok1(!radar.validity.IsValid());
+
+  ok1(RadarParser::ParseRadarBuffer(basic, "0,0", radar));
+  ok1(radar.traffics.empty());
+
+  /* a bogus count in the header must not allocate that many slots */
+  ok1(RadarParser::ParseRadarBuffer(basic,
+                                    "4000000000,1\n"
+                                    "a1,,,1,2,3,4,5,6,7,\n",
+                                    radar));
+  ok1(radar.traffics.size() == 1);
+}
+
+static void
+TestDelta()
+{
+  const NMEAInfo basic = MakeBasic();
+
+  RadarParser::Radar full;
+  ok1(RadarParser::ParseRadarBuffer(basic,
+                                    "2,2,7,0\n"
+                                    "a1,A,,1,2,0,0,0,0,1,x\n"
+                                    "b2,B,,3,4,0,0,0,0,1,y\n",
+                                    full));
+  ok1(!full.IsDelta());
+  ok1(full.sequence == 7);
+
+  /* removing traffic is only allowed in a delta */
+  RadarParser::Radar bad;
+  ok1(!RadarParser::ParseRadarBuffer(basic, "0,0\n-a1\n", bad));
+
+  RadarParser::Radar delta;
+  ok1(RadarParser::ParseRadarBuffer(basic,
+                                    "2,2,8,7\n"
+                                    "-a1\n"
+                                    "b2,B2,,5,6,0,0,0,0,2,y\n"
+                                    "c3,C,,7,8,0,0,0,0,2,z\n",
+                                    delta));
+  ok1(delta.IsDelta());
+  ok1(delta.sequence == 8);
+  ok1(delta.base_sequence == 7);
+  ok1(delta.removed.size() == 1);
+  ok1(delta.traffics.size() == 2);
+
+  const JETProvider::TrafficTable *previous =
+    new JETProvider::TrafficTable(std::move(full));
+  ok1(previous->size() == 2);
+  ok1(previous->Find("a1") != nullptr);
+  ok1(previous->Find("x") == nullptr);
+
+  const JETProvider::TrafficTable table(*previous, delta);
+
+  /* the previous table and the delta are not needed anymore */
+  delete previous;
+  delta = {};
+
+  ok1(table.size() == 2);
+  ok1(table.Find("a1") == nullptr);
+
+  const auto *b = table.Find("b2");
+  if (ok1(b != nullptr)) {
+    ok1(strcmp(b->display, "B2") == 0);
+    ok1(b->epoch == 2);
+    ok1(strcmp(b->traffic_id, "b2") == 0);
+  }
+
+  const auto *c = table.Find("c3");
+  if (ok1(c != nullptr))
+    ok1(strcmp(c->type, "z") == 0);
+}
+
+static void
+TestTable()
+{
+  const NMEAInfo basic = MakeBasic();
+
+  /* duplicate ids: the last one wins */
+  RadarParser::Radar radar;
+  ok1(RadarParser::ParseRadarBuffer(basic,
+                                    "3,3\n"
+                                    "a1,A,,1,2,0,0,0,0,1,x\n"
+                                    "b2,B,,3,4,0,0,0,0,1,y\n"
+                                    "a1,A2,,1,2,0,0,0,0,1,x\n",
+                                    radar));
+
+  const JETProvider::TrafficTable table(std::move(radar));
+  ok1(table.size() == 2);
+  const auto *a = table.Find("a1");
+  ok1(a != nullptr && strcmp(a->display, "A2") == 0);
+
+  /* many traffics, to exercise collisions in the index */
+  std::string buffer = "500,500\n";
+  for (unsigned i = 0; i < 500; ++i)
+    buffer += "id" + std::to_string(i) + ",,,1,2,0,0,0,0," +
+      std::to_string(i) + ",\n";
+
+  RadarParser::Radar big;
+  ok1(RadarParser::ParseRadarBuffer(basic, buffer, big));
+
+  const JETProvider::TrafficTable big_table(std::move(big));
+  ok1(big_table.size() == 500);
+
+  bool all_found = true;
+  for (unsigned i = 0; i < 500; ++i) {
+    const auto *t = big_table.Find("id" + std::to_string(i));
+    all_found = all_found && t != nullptr && t->epoch == i;
+  }
+  ok1(all_found);
+  ok1(big_table.Find("id500") == nullptr);
+}
+
+static void
+TestExtrapolate()
+{
+  using namespace std::chrono;
+
+  JETProvider::Traffic traffic;
+  traffic.location = GeoPoint(Angle::Degrees(7), Angle::Degrees(51));
+  traffic.track = 90;
+  traffic.speed = 50;
+  traffic.altitude = 1000;
+  traffic.vspeed = 2;
+  traffic.epoch = 1000000;
+
+  const system_clock::time_point report{seconds{traffic.epoch}};
+  const duration<double> stale_after = seconds{30};
+  const duration<double> expire_after = seconds{90};
+
+  auto e = JETProvider::Extrapolate(traffic, report + seconds{10},
+                                    stale_after, expire_after);
+  if (ok1(e)) {
+    ok1(!e->stale);
+    ok1(equals(e->age.count(), 10));
+    ok1(equals(e->altitude, 1020));
+    ok1(fabs(traffic.location.Distance(e->location) - 500) < 1);
+    ok1(equals(traffic.location.Bearing(e->location), 90));
+  }
+
+  /* stale: not extrapolated beyond the threshold */
+  e = JETProvider::Extrapolate(traffic, report + seconds{60},
+                               stale_after, expire_after);
+  if (ok1(e)) {
+    ok1(e->stale);
+    ok1(equals(e->altitude, 1060));
+    ok1(fabs(traffic.location.Distance(e->location) - 1500) < 1);
+  }
+
+  /* expired */
+  ok1(!JETProvider::Extrapolate(traffic, report + seconds{90},
+                                stale_after, expire_after));
+
+  /* report from the future */
+  e = JETProvider::Extrapolate(traffic, report - seconds{5},
+                               stale_after, expire_after);
+  ok1(e && e->location == traffic.location && !e->stale);
+}
+
+static void
+AppendLE(std::string &s, uint32_t value, unsigned n=4)
+{
+  for (unsigned i = 0; i < n; ++i)
+    s.push_back(char(value >> (8 * i)));
+}
+
+static void
+AppendString(std::string &s, const char *value)
+{
+  s.push_back(char(strlen(value)));
+  s.append(value);
+}
+
+static std::string
+MakeBinaryHeader(uint32_t count, uint32_t sequence, uint32_t base_sequence)
+{
+  std::string s = "JETR";
+  AppendLE(s, 1, 2);
+  AppendLE(s, 0, 2);
+  AppendLE(s, count);
+  AppendLE(s, count);
+  AppendLE(s, sequence);
+  AppendLE(s, base_sequence);
+  return s;
+}
+
+static bool
+ParseBinary(const NMEAInfo &basic, const std::string &s,
+            RadarParser::Radar &radar)
+{
+  return RadarParser::ParseRadarBinary(basic,
+                                       std::as_bytes(std::span{s}),
+                                       radar);
+}
+
+static void
+TestBinary()
+{
+  const NMEAInfo basic = MakeBasic();
+
+  std::string s = MakeBinaryHeader(1, 7, 0);
+  s.push_back('T');
+  AppendLE(s, uint32_t(int32_t(508695010)));
+  AppendLE(s, uint32_t(int32_t(-108640)));
+  AppendLE(s, 1500);
+  AppendLE(s, 1615771825);
+  AppendLE(s, 42, 2);
+  AppendLE(s, 300, 2);
+  AppendLE(s, uint16_t(int16_t(-200)), 2);
+  AppendString(s, "a1");
+  AppendString(s, "deadbeef");
+  AppendString(s, "");
+  AppendString(s, "744");
+
+  RadarParser::Radar radar;
+  ok1(ParseBinary(basic, s, radar));
+  ok1(radar.validity.IsValid());
+  ok1(radar.count == 1);
+  ok1(radar.sequence == 7);
+  ok1(!radar.IsDelta());
+  ok1(radar.strings.size() <= s.size());
+  if (ok1(radar.traffics.size() == 1)) {
+    const auto &a = radar.traffics.front();
+    ok1(strcmp(a.traffic_id, "a1") == 0);
+    ok1(strcmp(a.display, "deadbeef") == 0);
+    ok1(*a.code == '\0');
+    ok1(strcmp(a.type, "744") == 0);
+    ok1(equals(a.location.latitude, 50.869501));
+    ok1(equals(a.location.longitude, -0.010864));
+    ok1(a.altitude == 457);
+    ok1(a.track == 42);
+    ok1(equals(a.vspeed, Units::ToSysUnit(-200, Unit::FEET_PER_MINUTE)));
+    ok1(a.epoch == 1615771825);
+  }
+
+  /* truncated */
+  ok1(!ParseBinary(basic, s.substr(0, s.size() - 1), radar));
+  ok1(!ParseBinary(basic, s.substr(0, 10), radar));
+
+  /* removal records only in a delta */
+  std::string r = MakeBinaryHeader(0, 9, 0);
+  r.push_back('R');
+  AppendString(r, "a1");
+  ok1(!ParseBinary(basic, r, radar));
+
+  r = MakeBinaryHeader(0, 9, 7);
+  r.push_back('R');
+  AppendString(r, "a1");
+  ok1(ParseBinary(basic, r, radar));
+  ok1(radar.IsDelta());
+  ok1(radar.removed.size() == 1 && strcmp(radar.removed.front(), "a1") == 0);
+
+  /* bad magic */
+  r[0] = 'X';
+  ok1(!ParseBinary(basic, r, radar));
+}
+
+static void
+TestScheduler()
+{
+  using namespace std::chrono;
+  using JETProvider::Scheduler;
+
+  const NMEAInfo basic = MakeBasic();
+
+  Scheduler scheduler;
+  scheduler.SetNominalInterval(seconds{5});
+
+  const GeoBounds screen(GeoPoint(Angle::Degrees(7), Angle::Degrees(52)),
+                         GeoPoint(Angle::Degrees(8), Angle::Degrees(51)));
+  const Scheduler::Clock::time_point t0{};
+
+  const auto region = scheduler.Check(screen, t0);
+  if (!ok1(region))
+    return;
+
+  ok1(region->IsInside(screen));
+  ok1(equals(region->GetWidth(), 1.5));
+
+  /* not due yet */
+  ok1(!scheduler.Check(screen, t0 + seconds{1}));
+
+  /* panning inside the padded region costs no request */
+  const GeoBounds panned(GeoPoint(Angle::Degrees(7.2), Angle::Degrees(52.2)),
+                         GeoPoint(Angle::Degrees(8.2), Angle::Degrees(51.2)));
+  ok1(!scheduler.Check(panned, t0 + seconds{2}));
+
+  /* the interval has elapsed: the same region is requested again */
+  auto next = scheduler.Check(panned, t0 + seconds{5});
+  ok1(next && next->GetNorthWest() == region->GetNorthWest());
+
+  /* leaving the region fetches a new one immediately */
+  const GeoBounds far(GeoPoint(Angle::Degrees(9), Angle::Degrees(52)),
+                      GeoPoint(Angle::Degrees(10), Angle::Degrees(51)));
+  next = scheduler.Check(far, t0 + seconds{6});
+  ok1(next && next->IsInside(far));
+
+  /* no traffic: poll slowly */
+  RadarParser::Radar radar;
+  RadarParser::ParseRadarBuffer(basic, "0,0\n", radar);
+  scheduler.UpdateTraffic(JETProvider::TrafficTable(std::move(radar)),
+                          basic);
+  ok1(scheduler.GetInterval() == seconds{20});
+
+  /* failures back off */
+  scheduler.OnFailure();
+  ok1(scheduler.GetInterval() == seconds{40});
+  scheduler.OnSuccess(seconds{1});
+  ok1(scheduler.GetInterval() == seconds{20});
+}
+
+int
+main()
+{
+  plan_tests(107);
+
+  TestValid();
+  TestInvalid();
+  TestDelta();
+  TestTable();
+  TestExtrapolate();
+  TestScheduler();
+  TestBinary();
+
+  return exit_status();
+}
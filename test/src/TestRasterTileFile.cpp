@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Terrain/RasterTileFile.hpp"
+#include "io/StringOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static std::vector<TerrainHeight>
+MakeTile(unsigned n, int16_t first)
+{
+  std::vector<TerrainHeight> result;
+  for (unsigned i = 0; i < n; ++i)
+    result.emplace_back(int16_t(first + i));
+  return result;
+}
+
+static bool
+Equals(std::span<const TerrainHeight> a, std::span<const TerrainHeight> b)
+{
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                    [](TerrainHeight x, TerrainHeight y){
+                      return x.GetValue() == y.GetValue();
+                    });
+}
+
+static bool
+Throws(std::span<const std::byte> data)
+{
+  try {
+    RasterTileFile file(data);
+    return false;
+  } catch (const std::runtime_error &) {
+    return true;
+  }
+}
+
+int
+main()
+{
+  plan_tests(16);
+
+  /* a 2x2 tile grid; tile 2 is not available */
+  const RasterLocation sizes[] = {{3, 2}, {2, 2}, {0, 0}, {3, 1}};
+  const auto tile0 = MakeTile(6, 100);
+  const auto tile1 = MakeTile(4, -200);
+  const auto tile3 = MakeTile(3, 3000);
+
+  const RasterTileFile::Source source{123456, 1700000000};
+
+  StringOutputStream sos;
+  {
+    BufferedOutputStream bos(sos);
+    RasterTileFileWriter writer(bos, {5, 3}, {2, 2}, sizes, source);
+    writer.WriteTile(tile0);
+    writer.WriteTile(tile1);
+    writer.WriteTile(tile3);
+    bos.Flush();
+  }
+
+  const std::string &value = sos.GetValue();
+  const auto data = std::as_bytes(std::span{value});
+  ok1(data.size() % RasterTileFile::ALIGNMENT == 0);
+
+  const RasterTileFile file(data);
+  ok1(file.IsCompatible({5, 3}, {2, 2}, source));
+  ok1(!file.IsCompatible({5, 4}, {2, 2}, source));
+  ok1(!file.IsCompatible({5, 3}, {1, 2}, source));
+
+  /* the map file has been replaced */
+  ok1(!file.IsCompatible({5, 3}, {2, 2}, {123457, 1700000000}));
+  ok1(!file.IsCompatible({5, 3}, {2, 2}, {123456, 1700000001}));
+
+  const auto t0 = file.GetTile(0, {3, 2});
+  ok1(Equals(t0, tile0));
+  ok1(reinterpret_cast<std::uintptr_t>(t0.data()) %
+      RasterTileFile::ALIGNMENT == 0);
+
+  ok1(Equals(file.GetTile(1, {2, 2}), tile1));
+  ok1(file.GetTile(2, {0, 0}).empty());
+  ok1(Equals(file.GetTile(3, {3, 1}), tile3));
+
+  /* size mismatch and out of range */
+  ok1(file.GetTile(3, {2, 1}).empty());
+  ok1(file.GetTile(4, {3, 1}).empty());
+
+  /* malformed files */
+  std::string bad_magic = value;
+  bad_magic[0] = 'Z';
+  ok1(Throws(std::as_bytes(std::span{bad_magic})));
+  ok1(Throws(data.first(sizeof(RasterTileFile::Header) + 8)));
+
+  /* a truncated file only loses the tiles which are cut off */
+  const RasterTileFile truncated(data.first(data.size() - 12));
+  ok1(truncated.GetTile(3, {3, 1}).empty());
+
+  return exit_status();
+}
@@ -0,0 +1,438 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Route/ReachFan.hpp"
+#include "Engine/Route/TerrainRoute.hpp"
+#include "Engine/Route/GlideClearance.hpp"
+#include "Engine/Route/ReachFanParms.hpp"
+#include "Engine/Route/FlatTriangleFanGrid.hpp"
+#include "Engine/Route/ReachAirspaceMask.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "Engine/Route/ReachResult.hpp"
+#include "Engine/Route/RoutePolars.hpp"
+#include "Engine/Route/FlatTriangleFanVisitor.hpp"
+#include "GlideSolvers/GlideSettings.hpp"
+#include "GlideSolvers/GlidePolar.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Operation/Operation.hpp"
+#include "thread/SharedMutex.hpp"
+#include "thread/ThreadPool.hpp"
+#include "TestUtil.hpp"
+
+#include <zzip/zzip.h>
+
+#include <vector>
+
+#include <limits.h>
+
+static const GeoPoint location(Angle::Degrees(7), Angle::Degrees(51));
+static constexpr int ALTITUDE = 1500;
+
+static RoutePolars
+MakePolars(double mc, bool turning=false) noexcept
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+  if (turning)
+    config.reach_calc_mode = RoutePlannerConfig::ReachMode::TURNING;
+
+  RoutePolars rpolars;
+  rpolars.SetConfig(config);
+  rpolars.Initialise(settings, GlidePolar(mc),
+                     SpeedVector(Angle::Zero(), 0));
+  rpolars.SetConfig(config, ALTITUDE, INT_MAX);
+  return rpolars;
+}
+
+/**
+ * Move the given distance north, and glide there.
+ */
+static AGeoPoint
+Glide(const AGeoPoint &origin, const RoutePolars &rpolars,
+      double distance) noexcept
+{
+  const GeoPoint p(origin.longitude,
+                   origin.latitude + Angle::Degrees(distance / 111200.));
+  const FlatProjection projection(origin);
+  const AFlatGeoPoint fo(projection.ProjectInteger(origin), origin.altitude);
+  return AGeoPoint(p, rpolars.CalcGlideArrival(fo,
+                                               projection.ProjectInteger(p),
+                                               projection));
+}
+
+static int
+GetDirectArrival(const ReachFan &reach, const RoutePolars &rpolars,
+                 double north=0) noexcept
+{
+  const AGeoPoint dest(GeoPoint(location.longitude + Angle::Degrees(0.2),
+                                location.latitude + Angle::Degrees(north)),
+                       0);
+  const auto result = reach.FindPositiveArrival(dest, rpolars);
+  return result ? result->direct : INT_MIN;
+}
+
+static bool
+IsReachable(const ReachFan &reach, const RoutePolars &rpolars,
+            double north) noexcept
+{
+  const AGeoPoint dest(GeoPoint(location.longitude,
+                                location.latitude + Angle::Degrees(north)),
+                       0);
+  const auto result = reach.FindPositiveArrival(dest, rpolars);
+  return result &&
+    result->terrain_valid == ReachResult::Validity::VALID;
+}
+
+/**
+ * An airspace band from #south to #north (relative to #location).
+ */
+static void
+AddBand(Airspaces &airspaces, double south, double north,
+        double base, double top)
+{
+  std::vector<GeoPoint> points;
+  points.emplace_back(location.longitude - Angle::Degrees(0.5),
+                      location.latitude + Angle::Degrees(south));
+  points.emplace_back(location.longitude + Angle::Degrees(0.5),
+                      location.latitude + Angle::Degrees(south));
+  points.emplace_back(location.longitude + Angle::Degrees(0.5),
+                      location.latitude + Angle::Degrees(north));
+  points.emplace_back(location.longitude - Angle::Degrees(0.5),
+                      location.latitude + Angle::Degrees(north));
+
+  AirspaceAltitude altitude_base{}, altitude_top{};
+  altitude_base.reference = altitude_top.reference = AltitudeReference::MSL;
+  altitude_base.altitude = base;
+  altitude_top.altitude = top;
+
+  auto polygon = std::make_shared<AirspacePolygon>(points);
+  polygon->SetProperties(_T("Band"), RESTRICT, _T(""),
+                         altitude_base, altitude_top);
+  airspaces.Add(std::move(polygon));
+}
+
+/**
+ * The reach with a #ReachAirspaceMask ends at the airspace.
+ */
+static void
+TestAirspace()
+{
+  const RoutePolars rpolars = MakePolars(1);
+  const AGeoPoint origin(location, ALTITUDE);
+
+  ReachFan reach;
+  reach.Solve(origin, rpolars, nullptr);
+  ok1(IsReachable(reach, rpolars, 0.3));
+  ok1(IsReachable(reach, rpolars, -0.3));
+
+  Airspaces airspaces;
+  AddBand(airspaces, 0.1, 0.2, 0, 5000);
+  airspaces.Optimise();
+
+  ReachAirspaceMask mask;
+  mask.Build(airspaces, AirspacePredicateTrue, origin);
+  ok1(!mask.IsEmpty());
+
+  reach.Solve(origin, rpolars, nullptr, true, nullptr, &mask);
+  ok1(IsReachable(reach, rpolars, 0.05));
+  ok1(!IsReachable(reach, rpolars, 0.3));
+  ok1(IsReachable(reach, rpolars, -0.3));
+
+  /* a nearby origin gets the same mask */
+  ReachAirspaceMask mask2;
+  mask2.Build(airspaces, AirspacePredicateTrue,
+              Glide(origin, rpolars, 100));
+  ok1(mask2 == mask);
+
+  /* the glide passes below an airspace with a high base */
+  Airspaces high;
+  AddBand(high, 0.1, 0.2, 2500, 5000);
+  high.Optimise();
+  mask.Build(high, AirspacePredicateTrue, origin);
+  reach.Solve(origin, rpolars, nullptr, true, nullptr, &mask);
+  ok1(IsReachable(reach, rpolars, 0.3));
+
+  /* the airspace the aircraft is in is ignored */
+  Airspaces inside;
+  AddBand(inside, -0.1, 0.1, 0, 5000);
+  inside.Optimise();
+  mask.Build(inside, AirspacePredicateTrue, origin);
+  ok1(mask.IsEmpty());
+}
+
+/**
+ * Collects all fans of a #ReachFan in visiting order.
+ */
+struct FanCollector final : FlatTriangleFanVisitor {
+  std::vector<std::vector<FlatGeoPoint>> fans;
+
+  void VisitFan(FlatGeoPoint origin,
+                std::span<const FlatGeoPoint> fan) noexcept override {
+    auto &v = fans.emplace_back();
+    v.push_back(origin);
+    v.insert(v.end(), fan.begin(), fan.end());
+  }
+};
+
+static std::vector<std::vector<FlatGeoPoint>>
+GetFans(const ReachFan &reach, const GeoPoint &center) noexcept
+{
+  GeoBounds bounds(center);
+  bounds.Extend(GeoPoint(center.longitude - Angle::Degrees(2),
+                         center.latitude - Angle::Degrees(2)));
+  bounds.Extend(GeoPoint(center.longitude + Angle::Degrees(2),
+                         center.latitude + Angle::Degrees(2)));
+
+  FanCollector collector;
+  reach.AcceptInRange(bounds, collector);
+  return std::move(collector.fans);
+}
+
+/**
+ * Expand a reach with turns around the terrain serially, in reverse
+ * order and on a #ThreadPool; the results must be the same.
+ */
+static void
+TestParallel(const RasterMap &map)
+{
+  const RoutePolars rpolars = MakePolars(1, true);
+  const GeoPoint center = map.GetMapCenter();
+  const AGeoPoint origin(center,
+                         map.GetHeight(center).GetValueOr0() + 1000);
+
+  ReachFan serial;
+  serial.Solve(origin, rpolars, &map);
+  const auto expected = GetFans(serial, center);
+
+  /* there are sub-fans around the obstacles */
+  ok1(expected.size() > 1);
+
+  const FlatTriangleFanTree::ForEachFunction reverse =
+    [](std::size_t n, const std::function<void(std::size_t)> &f){
+      for (std::size_t i = n; i-- > 0;)
+        f(i);
+    };
+
+  ReachFan reach;
+  reach.Solve(origin, rpolars, &map, true, &reverse);
+  ok1(GetFans(reach, center) == expected);
+
+  ThreadPool pool("Test", 3);
+  const FlatTriangleFanTree::ForEachFunction parallel =
+    [&pool](std::size_t n, const std::function<void(std::size_t)> &f){
+      pool.ForEach(n, f);
+    };
+
+  reach.Solve(origin, rpolars, &map, true, &parallel);
+  ok1(GetFans(reach, center) == expected);
+}
+
+/**
+ * The #FlatTriangleFanGrid must give the same arrival heights as the
+ * tree it was built from.
+ */
+static void
+TestGrid(const RasterMap &map)
+{
+  const RoutePolars rpolars = MakePolars(1, true);
+  const GeoPoint center = map.GetMapCenter();
+  const AGeoPoint origin(center,
+                         map.GetHeight(center).GetValueOr0() + 1000);
+
+  const FlatProjection projection(origin);
+  ReachFanParms parms(rpolars, projection, 0, &map);
+  const AFlatGeoPoint ao(projection.ProjectInteger(origin), origin.altitude);
+
+  FlatTriangleFanTree tree;
+  tree.FillReach(ao, parms);
+
+  FlatTriangleFanGrid grid;
+  grid.Build(tree);
+
+  /* the copy owns its hulls */
+  const FlatTriangleFanGrid copy = grid;
+  grid.Clear();
+  grid.Build(tree);
+
+  unsigned n_reachable = 0, n_mismatch = 0;
+  for (int i = -50; i <= 50; ++i) {
+    for (int j = -50; j <= 50; ++j) {
+      const GeoPoint p(center.longitude + Angle::Degrees(0.012 * i),
+                       center.latitude + Angle::Degrees(0.012 * j));
+      const FlatGeoPoint n = projection.ProjectInteger(p);
+      const int h = map.GetHeight(p).GetValueOr0() - 1;
+
+      int tree_height = h, grid_height = h, copy_height = h;
+      const bool tree_found = tree.FindPositiveArrival(n, parms,
+                                                       tree_height);
+      const bool grid_found = grid.FindPositiveArrival(n, parms,
+                                                       grid_height);
+      const bool copy_found = copy.FindPositiveArrival(n, parms,
+                                                       copy_height);
+
+      if (tree_found)
+        ++n_reachable;
+
+      if (grid_found != tree_found || grid_height != tree_height ||
+          copy_found != tree_found || copy_height != tree_height)
+        ++n_mismatch;
+    }
+  }
+
+  ok1(n_reachable > 0);
+  ok1(n_mismatch == 0);
+}
+
+/**
+ * The #GlideClearanceProfile which TerrainRoute::CalcGlideClearance()
+ * samples must agree with the terrain and with
+ * TerrainRoute::Intersection().
+ */
+static void
+TestGlideClearance(const RasterMap &map)
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+
+  const GlidePolar polar(1);
+  TerrainRoute route;
+  route.UpdatePolar(settings, config, polar, polar, SpeedVector::Zero());
+
+  const GeoPoint center = map.GetMapCenter();
+  const GeoPoint target(center.longitude + Angle::Degrees(0.3),
+                        center.latitude);
+  const int ground = map.GetHeight(center).GetValueOr0();
+
+  GlideClearanceProfile profile;
+
+  /* no terrain */
+  route.CalcGlideClearance(AGeoPoint(center, ground + 1000),
+                           AGeoPoint(target, 0), profile);
+  ok1(!profile.IsDefined());
+
+  route.SetTerrain(&map);
+
+  /* high above the terrain */
+  const AGeoPoint high(center, ground + 5000);
+  route.CalcGlideClearance(high, AGeoPoint(target, 0), profile);
+  ok1(profile.IsDefined() && profile.GetMinimum() > 0 &&
+      !route.Intersection(high, AGeoPoint(target, 0)).IsValid());
+
+  /* the last sample is at the target, below the glide path by the
+     arrival height */
+  const int target_height = map.GetHeight(target).GetValueOr0();
+  const int last = profile.clearance[profile.n_samples - 1];
+  ok1(last > 0 && last < 5000 + ground - target_height);
+
+  bool minimum_ok = true;
+  for (unsigned i = 0; i < profile.n_samples; ++i)
+    if (profile.clearance[i] < profile.GetMinimum())
+      minimum_ok = false;
+  ok1(minimum_ok);
+
+  /* too low for the distance */
+  const AGeoPoint low(center, ground + 50);
+  route.CalcGlideClearance(low, AGeoPoint(target, 0), profile);
+  ok1(profile.IsDefined() && profile.GetMinimum() < 0 &&
+      route.Intersection(low, AGeoPoint(target, 0)).IsValid());
+}
+
+int
+main()
+{
+  plan_tests(31);
+
+  const RoutePolars rpolars = MakePolars(1);
+  const AGeoPoint origin(location, ALTITUDE);
+
+  ReachFan reach;
+  ok1(reach.Update(origin, rpolars, nullptr, true));
+  const int arrival = GetDirectArrival(reach, rpolars);
+
+  /* nothing has changed */
+  ok1(!reach.Update(origin, rpolars, nullptr, true));
+
+  /* the aircraft has followed the glide path: keep the solution */
+  const AGeoPoint on_path = Glide(origin, rpolars, 150);
+  ok1(!reach.Update(on_path, rpolars, nullptr, true));
+
+  /* ... but the arrivals must not be higher than those of a new
+     solution, not even behind the aircraft */
+  {
+    ReachFan fresh;
+    fresh.Solve(on_path, rpolars, nullptr);
+    ok1(GetDirectArrival(reach, rpolars) < arrival);
+    ok1(GetDirectArrival(reach, rpolars) <=
+        GetDirectArrival(fresh, rpolars));
+    ok1(GetDirectArrival(reach, rpolars, -0.1) <=
+        GetDirectArrival(fresh, rpolars, -0.1));
+
+    const AGeoPoint behind(GeoPoint(location.longitude,
+                                    location.latitude - Angle::Degrees(0.2)),
+                           0);
+    const auto kept = reach.FindPositiveArrival(behind, rpolars);
+    const auto expected = fresh.FindPositiveArrival(behind, rpolars);
+    ok1(kept && expected &&
+        kept->terrain_valid == ReachResult::Validity::VALID &&
+        kept->terrain <= expected->terrain);
+  }
+
+  /* below the glide path */
+  ok1(reach.Update(AGeoPoint(on_path, on_path.altitude - 10),
+                   rpolars, nullptr, true));
+
+  /* climbed */
+  ok1(reach.Update(AGeoPoint(origin, ALTITUDE + 100),
+                   rpolars, nullptr, true));
+
+  /* drifted too far */
+  reach.Update(origin, rpolars, nullptr, true);
+  ok1(reach.Update(Glide(origin, rpolars, 2 * ReachFan::MAX_DRIFT),
+                   rpolars, nullptr, true));
+
+  /* a different polar */
+  reach.Update(origin, rpolars, nullptr, true);
+  ok1(reach.Update(origin, MakePolars(3), nullptr, true));
+
+  /* a dummy reach is never kept */
+  reach.Solve(origin, rpolars, nullptr, false);
+  ok1(reach.Update(origin, rpolars, nullptr, true));
+
+  TestAirspace();
+
+  ZZIP_DIR *dir = zzip_dir_open("test/data/benalla9.xcm", nullptr);
+  if (dir == nullptr)
+    return EXIT_FAILURE;
+
+  RasterMap map;
+
+  {
+    NullOperationEnvironment operation;
+    LoadTerrainOverview(dir, map.GetTileCache(), operation);
+  }
+
+  map.UpdateProjection();
+
+  SharedMutex mutex;
+  do {
+    UpdateTerrainTiles(dir, map.GetTileCache(), mutex,
+                       map.GetProjection(),
+                       map.GetMapCenter(), 50000);
+  } while (map.IsDirty());
+  zzip_dir_close(dir);
+
+  TestParallel(map);
+  TestGrid(map);
+  TestGlideClearance(map);
+
+  return exit_status();
+}
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Contest/Solvers/Retrospective.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Waypoint/Waypoint.hpp"
+#include "Geo/GeoVector.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+
+static const GeoPoint center(Angle::Degrees(7), Angle::Degrees(51));
+
+/**
+ * A grid of waypoints, 2 km apart.
+ */
+static void
+FillWaypoints(Waypoints &waypoints)
+{
+  unsigned id = 0;
+  for (int x = -20; x <= 20; ++x) {
+    for (int y = -20; y <= 20; ++y) {
+      const GeoPoint location(center.longitude + Angle::Degrees(0.028 * x),
+                              center.latitude + Angle::Degrees(0.018 * y));
+      Waypoint waypoint{location};
+      waypoint.original_id = ++id;
+      waypoint.name = _T("Waypoint");
+      waypoints.Append(std::move(waypoint));
+    }
+  }
+
+  waypoints.Optimise();
+}
+
+/**
+ * Is the waypoint found by Retrospective::LookupNearby() the one found
+ * by Waypoints::LookupLocation(), or one at the same flat distance
+ * which is at least as near?
+ */
+static bool
+IsAsNear(const WaypointPtr &found, const WaypointPtr &expected,
+         const GeoPoint &location) noexcept
+{
+  if (found == expected)
+    return true;
+
+  return found && expected &&
+    found->location.DistanceS(location) <=
+    expected->location.DistanceS(location);
+}
+
+/**
+ * Fly a spiral through the waypoint grid and compare each lookup
+ * with Waypoints::LookupLocation().
+ */
+static bool
+TestLookups(Retrospective &retrospective, const Waypoints &waypoints,
+            unsigned *n_found)
+{
+  bool equal = true;
+  *n_found = 0;
+
+  for (unsigned i = 0; i < 20000; ++i) {
+    const GeoPoint location =
+      GeoVector(10 + 1.5 * i, Angle::Degrees(0.4 * i)).EndPoint(center);
+
+    const auto expected = waypoints.LookupLocation(location,
+                                                   retrospective.search_range);
+    const auto found = retrospective.LookupNearby(location);
+    if (!IsAsNear(found, expected, location))
+      equal = false;
+
+    if (found)
+      ++*n_found;
+  }
+
+  return equal;
+}
+
+int
+main()
+{
+  plan_tests(7);
+
+  Waypoints waypoints;
+  FillWaypoints(waypoints);
+
+  Retrospective retrospective(waypoints);
+
+  unsigned n_found;
+  ok1(TestLookups(retrospective, waypoints, &n_found));
+  ok1(n_found > 0);
+
+  /* a different range fills a new list */
+  retrospective.search_range = 3000;
+  ok1(TestLookups(retrospective, waypoints, &n_found));
+  ok1(n_found > 0);
+
+  /* a waypoint exactly at the aircraft location */
+  const GeoPoint location = waypoints.LookupId(1)->location;
+  ok1(retrospective.LookupNearby(location) == waypoints.LookupId(1));
+
+  /* new waypoints are found, too */
+  const GeoPoint far = GeoVector(100000, Angle::Degrees(45)).EndPoint(center);
+  ok1(retrospective.LookupNearby(far) == nullptr);
+
+  Waypoint waypoint{far};
+  waypoint.name = _T("Far");
+  waypoints.Append(std::move(waypoint));
+  waypoints.Optimise();
+  ok1(retrospective.LookupNearby(far) != nullptr);
+
+  return exit_status();
+}
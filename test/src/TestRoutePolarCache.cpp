@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Route/RoutePolarCache.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "TestUtil.hpp"
+
+static RoutePolar
+MakeTable(const GlideSettings &settings, const GlidePolar &polar,
+          const SpeedVector &wind, bool glide) noexcept
+{
+  RoutePolar table;
+  table.Initialise(settings, polar, wind, glide);
+  return table;
+}
+
+int
+main()
+{
+  plan_tests(9);
+
+  GlideSettings settings;
+  settings.SetDefaults();
+  const GlidePolar polar(1);
+
+  const SpeedVector wind(Angle::Degrees(92), 3.1);
+  const SpeedVector quantized = RoutePolarCache::Quantize(wind);
+  ok1(equals(quantized.bearing.Degrees(), 90));
+  ok1(equals(quantized.norm, 3));
+
+  RoutePolarCache cache;
+
+  /* the table is calculated with the quantized wind */
+  const RoutePolar &table = cache.Get(settings, polar, wind, true);
+  ok1(table == MakeTable(settings, polar, quantized, true));
+
+  /* a slightly different wind gets the same table */
+  ok1(&cache.Get(settings, polar, SpeedVector(Angle::Degrees(89), 2.9),
+                 true) == &table);
+
+  /* the mode and the polar are part of the key */
+  ok1(!(cache.Get(settings, polar, wind, false) ==
+        MakeTable(settings, polar, quantized, true)));
+  ok1(cache.Get(settings, GlidePolar(2), wind, true) ==
+      MakeTable(settings, GlidePolar(2), quantized, true));
+
+  /* the direction of a calm doesn't matter */
+  const RoutePolar &calm = cache.Get(settings, polar,
+                                     SpeedVector(Angle::Degrees(45), 0.1),
+                                     true);
+  ok1(&cache.Get(settings, polar, SpeedVector(Angle::Zero(), 0), true) ==
+      &calm);
+
+  /* evict the first table and calculate it again */
+  for (unsigned i = 0; i < RoutePolarCache::SIZE; ++i)
+    cache.Get(settings, polar, SpeedVector(Angle::Degrees(180), 10 + i),
+              true);
+
+  ok1(cache.Get(settings, polar, wind, true) ==
+      MakeTable(settings, polar, quantized, true));
+  ok1(cache.Get(settings, polar, SpeedVector(Angle::Degrees(180), 10),
+                true) ==
+      MakeTable(settings, polar, SpeedVector(Angle::Degrees(180), 10), true));
+
+  return exit_status();
+}
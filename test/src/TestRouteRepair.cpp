@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Route/AirspaceRoute.hpp"
+#include "Engine/Route/Config.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "Engine/Airspace/Predicate/AirspacePredicate.hpp"
+#include "GlideSolvers/GlideSettings.hpp"
+#include "GlideSolvers/GlidePolar.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <vector>
+
+static const GeoPoint location(Angle::Degrees(7), Angle::Degrees(51));
+
+static GeoPoint
+MakePoint(double east, double north) noexcept
+{
+  return GeoPoint(location.longitude + Angle::Degrees(east),
+                  location.latitude + Angle::Degrees(north));
+}
+
+/**
+ * A square airspace from the ground up to FL300 around the given
+ * point.
+ */
+static void
+AddBlock(Airspaces &airspaces, double east, double north, double radius)
+{
+  std::vector<GeoPoint> points;
+  points.push_back(MakePoint(east - radius, north - radius));
+  points.push_back(MakePoint(east + radius, north - radius));
+  points.push_back(MakePoint(east + radius, north + radius));
+  points.push_back(MakePoint(east - radius, north + radius));
+
+  AirspaceAltitude base{}, top{};
+  base.reference = top.reference = AltitudeReference::MSL;
+  base.altitude = 0;
+  top.altitude = 9000;
+
+  auto polygon = std::make_shared<AirspacePolygon>(points);
+  polygon->SetProperties(_T("Block"), RESTRICT, _T(""), base, top);
+  airspaces.Add(std::move(polygon));
+}
+
+static bool
+Solve(AirspaceRoute &route, const Airspaces &airspaces,
+      const RoutePlannerConfig &config,
+      const AGeoPoint &target, const AGeoPoint &aircraft)
+{
+  route.Synchronise(airspaces, AirspacePredicateTrue, target, aircraft);
+  return route.Solve(target, aircraft, config);
+}
+
+/**
+ * Does the solution avoid the block in front of the aircraft?
+ */
+static bool
+HasDetour(const AirspaceRoute &route) noexcept
+{
+  /* the direct line (north/south) is blocked, so the route must
+     have at least one intermediate point */
+  return route.GetSolution().size() > 2;
+}
+
+int
+main()
+{
+  plan_tests(11);
+
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+  config.mode = RoutePlannerConfig::Mode::AIRSPACE;
+
+  const GlidePolar polar(1);
+  const SpeedVector wind(Angle::Zero(), 0);
+
+  Airspaces airspaces;
+  AddBlock(airspaces, 0, 0.1, 0.02);
+  airspaces.Optimise();
+
+  AirspaceRoute route;
+  route.UpdatePolar(settings, config, polar, polar, wind);
+
+  const AGeoPoint target(MakePoint(0, 0.2), 500);
+  AGeoPoint aircraft(MakePoint(0.001, 0), 2500);
+
+  /* the first solution needs a search */
+  ok1(Solve(route, airspaces, config, target, aircraft));
+  ok1(!route.IsSolutionRepaired() && HasDetour(route));
+  const Route first = route.GetSolution();
+
+  /* the aircraft has moved a bit: the path is repaired, keeping
+     (some of) the detour points */
+  aircraft = AGeoPoint(MakePoint(0.003, 0.005), 2450);
+  ok1(Solve(route, airspaces, config, target, aircraft));
+  ok1(route.IsSolutionRepaired());
+
+  const Route &repaired = route.GetSolution();
+  ok1(HasDetour(route) && repaired.size() <= first.size() &&
+      std::equal(repaired.begin(), repaired.end() - 1, first.begin()) &&
+      repaired.back().Distance(aircraft) < 10);
+
+  /* the aircraft has flown around the block: the detour is
+     dropped, it can fly directly to the target */
+  aircraft = AGeoPoint(MakePoint(0.08, 0.03), 2300);
+  ok1(Solve(route, airspaces, config, target, aircraft));
+  ok1(route.IsSolutionRepaired() && route.GetSolution().size() == 2);
+
+  /* a new target requires a new search */
+  aircraft = AGeoPoint(MakePoint(0.001, 0), 2500);
+  const AGeoPoint target2(MakePoint(0.01, 0.2), 500);
+  ok1(Solve(route, airspaces, config, target2, aircraft));
+  ok1(!route.IsSolutionRepaired() && HasDetour(route));
+
+  /* a new airspace requires a new search, even though the aircraft
+     hasn't moved */
+  AddBlock(airspaces, 0.03, 0.05, 0.01);
+  airspaces.Optimise();
+  Solve(route, airspaces, config, target2, aircraft);
+  ok1(!route.IsSolutionRepaired());
+
+  /* a different polar, too */
+  route.UpdatePolar(settings, config, GlidePolar(2), GlidePolar(2), wind);
+  Solve(route, airspaces, config, target2, aircraft);
+  ok1(!route.IsSolutionRepaired());
+
+  return exit_status();
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "ui/canvas/custom/ScaleImage.hpp"
+#include "ui/canvas/custom/UncompressedImage.hpp"
+#include "TestUtil.hpp"
+
+#include <cstring>
+
+static UncompressedImage
+MakeImage(UncompressedImage::Format format, unsigned bpp,
+          unsigned width, unsigned height, const uint8_t *pixels)
+{
+  const std::size_t size = std::size_t(width) * height * bpp;
+  auto data = std::make_unique<uint8_t[]>(size);
+  memcpy(data.get(), pixels, size);
+  return UncompressedImage(format, width * bpp, width, height,
+                           std::move(data), true);
+}
+
+static const uint8_t *
+GetPixel(const UncompressedImage &image, unsigned bpp,
+         unsigned x, unsigned y)
+{
+  return static_cast<const uint8_t *>(image.GetData()) +
+    y * image.GetPitch() + x * bpp;
+}
+
+static void
+TestMipLevel()
+{
+  ok1(GetMipLevel({1000, 500}, 0) == 0);
+  ok1(GetMipLevel({1000, 500}, 1000) == 0);
+  ok1(GetMipLevel({1001, 500}, 1000) == 1);
+  ok1(GetMipLevel({500, 4000}, 1000) == 2);
+  ok1(GetMipLevel({4001, 10}, 1000) == 3);
+}
+
+static void
+TestGray()
+{
+  static constexpr uint8_t pixels[] = {
+    0, 4, 8,
+    4, 8, 100,
+    20, 20, 30,
+  };
+
+  const auto src = MakeImage(UncompressedImage::Format::GRAY, 1, 3, 3, pixels);
+
+  ok1(!DownscaleImage(src, 0).IsDefined());
+
+  const auto half = DownscaleImage(src, 1);
+  ok1(half.IsDefined());
+  ok1(half.GetFormat() == UncompressedImage::Format::GRAY);
+  ok1(half.IsFlipped());
+  ok1(half.GetWidth() == 2);
+  ok1(half.GetHeight() == 2);
+  ok1(*GetPixel(half, 1, 0, 0) == 4);
+  /* the odd column is averaged with itself */
+  ok1(*GetPixel(half, 1, 1, 0) == 54);
+  ok1(*GetPixel(half, 1, 0, 1) == 20);
+  ok1(*GetPixel(half, 1, 1, 1) == 30);
+
+  const auto quarter = DownscaleImage(src, 5);
+  ok1(quarter.GetWidth() == 1);
+  ok1(quarter.GetHeight() == 1);
+}
+
+static void
+TestRGBA()
+{
+  static constexpr uint8_t pixels[] = {
+    200, 100, 0, 0xff,  0, 0, 0, 0,
+    0, 0, 0, 0,  0, 0, 0, 0,
+  };
+
+  const auto src = MakeImage(UncompressedImage::Format::RGBA, 4, 2, 2, pixels);
+  const auto half = DownscaleImage(src, 1);
+  ok1(half.GetWidth() == 1);
+  ok1(half.GetHeight() == 1);
+
+  /* transparent pixels do not darken the colour */
+  const uint8_t *p = GetPixel(half, 4, 0, 0);
+  ok1(p[0] == 200);
+  ok1(p[1] == 100);
+  ok1(p[2] == 0);
+  ok1(p[3] == 64);
+}
+
+int
+main()
+{
+  plan_tests(23);
+
+  TestMipLevel();
+  TestGray();
+  TestRGBA();
+
+  return exit_status();
+}
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Device/Util/SensorFrame.hpp"
+#include "NMEA/Info.hpp"
+#include "TestUtil.hpp"
+
+#include <array>
+#include <vector>
+
+using namespace SensorFrame;
+
+static NMEAInfo
+MakeInfo()
+{
+  NMEAInfo info;
+  info.Reset();
+  info.clock = TimeStamp{std::chrono::seconds{1}};
+  return info;
+}
+
+/**
+ * Append one frame to the stream.
+ */
+template<typename T>
+static void
+Append(std::vector<std::byte> &stream, Type type, const T &record)
+{
+  std::array<std::byte, OVERHEAD + MAX_PAYLOAD> buffer;
+  const std::size_t n = Write(buffer, type, record);
+  stream.insert(stream.end(), buffer.begin(), buffer.begin() + n);
+}
+
+static void
+TestRecords()
+{
+  std::vector<std::byte> stream;
+
+  Attitude attitude;
+  attitude.bank = uint16_t(-1234);
+  attitude.pitch = 500;
+  attitude.heading = 0xffff;
+  Append(stream, Type::ATTITUDE, attitude);
+
+  Acceleration acceleration;
+  acceleration.x = 0;
+  acceleration.y = 0;
+  acceleration.z = 1500;
+  Append(stream, Type::ACCELERATION, acceleration);
+
+  StaticPressure pressure;
+  pressure.pressure = 10132500;
+  Append(stream, Type::STATIC_PRESSURE, pressure);
+
+  TotalEnergyVario vario;
+  vario.vario = uint16_t(-250);
+  Append(stream, Type::TOTAL_ENERGY_VARIO, vario);
+
+  NMEAInfo info = MakeInfo();
+  SensorFrameReader reader;
+  ok1(reader.Feed(stream, info));
+
+  ok1(info.attitude.bank_angle_available);
+  ok1(equals(info.attitude.bank_angle.Degrees(), -12.34));
+  ok1(equals(info.attitude.pitch_angle.Degrees(), 5));
+  ok1(!info.attitude.heading_available);
+
+  ok1(info.acceleration.available);
+  ok1(equals(info.acceleration.g_load, 1.5));
+
+  ok1(info.static_pressure_available);
+  ok1(equals(info.static_pressure.GetHectoPascal(), 1013.25));
+
+  ok1(info.total_energy_vario_available);
+  ok1(equals(info.total_energy_vario, -2.5));
+
+  ok1(reader.GetCRCErrors() == 0);
+}
+
+/**
+ * Frames split into single bytes, mixed with garbage and a corrupt
+ * frame.
+ */
+static void
+TestStream()
+{
+  TotalEnergyVario vario;
+  vario.vario = 123;
+
+  std::vector<std::byte> stream;
+  stream.push_back(std::byte{'$'});
+  stream.push_back(SYNC);
+  Append(stream, Type::TOTAL_ENERGY_VARIO, vario);
+
+  /* a corrupt frame */
+  const std::size_t corrupt = stream.size();
+  Append(stream, Type::TOTAL_ENERGY_VARIO, vario);
+  stream[corrupt + 3] ^= std::byte{0x01};
+
+  /* an unknown record type */
+  Append(stream, Type(0x7f), vario);
+
+  vario.vario = 456;
+  Append(stream, Type::TOTAL_ENERGY_VARIO, vario);
+
+  NMEAInfo info = MakeInfo();
+  SensorFrameReader reader;
+
+  bool first = false;
+  for (std::size_t i = 0; i < stream.size(); ++i) {
+    if (reader.Feed(std::span{stream}.subspan(i, 1), info) && !first) {
+      first = true;
+      ok1(equals(info.total_energy_vario, 1.23));
+    }
+  }
+
+  ok1(first);
+  ok1(equals(info.total_energy_vario, 4.56));
+  ok1(reader.GetCRCErrors() >= 1);
+}
+
+int
+main()
+{
+  plan_tests(16);
+
+  TestRecords();
+  TestStream();
+
+  return exit_status();
+}
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Topography/ShapeBufferAllocator.hpp"
+#include "TestUtil.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+static constexpr unsigned NONE = ShapeBufferAllocator::NONE;
+
+struct Allocation {
+  unsigned offset, size;
+};
+
+static bool
+Overlaps(const Allocation &a, const Allocation &b)
+{
+  return a.offset < b.offset + b.size && b.offset < a.offset + a.size;
+}
+
+/**
+ * Allocate and free random ranges and verify that no two allocations
+ * overlap and that freeing everything restores one free range.
+ */
+static bool
+RandomTest(unsigned capacity)
+{
+  ShapeBufferAllocator allocator;
+  allocator.Reset(capacity);
+
+  std::vector<Allocation> allocations;
+  for (unsigned i = 0; i < 2000; ++i) {
+    if (!allocations.empty() && rand() % 3 == 0) {
+      const std::size_t j = rand() % allocations.size();
+      allocator.Free(allocations[j].offset, allocations[j].size);
+      allocations.erase(allocations.begin() + j);
+      continue;
+    }
+
+    const Allocation a{0, 1 + unsigned(rand() % 50)};
+    const unsigned offset = allocator.Allocate(a.size);
+    if (offset == NONE)
+      continue;
+
+    const Allocation b{offset, a.size};
+    if (b.offset + b.size > capacity)
+      return false;
+
+    for (const auto &other : allocations)
+      if (Overlaps(b, other))
+        return false;
+
+    allocations.push_back(b);
+  }
+
+  for (const auto &a : allocations)
+    allocator.Free(a.offset, a.size);
+
+  return allocator.GetFreeSize() == capacity &&
+    allocator.Allocate(capacity) == 0;
+}
+
+int
+main()
+{
+  plan_tests(12);
+
+  ShapeBufferAllocator allocator;
+  ok1(allocator.Allocate(1) == NONE);
+
+  allocator.Reset(100);
+  ok1(allocator.GetFreeSize() == 100);
+
+  const unsigned a = allocator.Allocate(30);
+  const unsigned b = allocator.Allocate(30);
+  const unsigned c = allocator.Allocate(30);
+  ok1(a == 0 && b == 30 && c == 60);
+  ok1(allocator.Allocate(20) == NONE);
+
+  /* the freed space is reused */
+  allocator.Free(b, 30);
+  ok1(allocator.Allocate(20) == 30);
+  ok1(allocator.Allocate(20) == NONE);
+  ok1(allocator.Allocate(10) == 50);
+
+  /* neighbouring free ranges are merged */
+  allocator.Free(a, 30);
+  allocator.Free(c, 30);
+  allocator.Free(30, 20);
+  allocator.Free(50, 10);
+  ok1(allocator.GetFreeSize() == 100);
+  ok1(allocator.Allocate(100) == 0);
+
+  allocator.Reset(50);
+  ok1(allocator.Allocate(50) == 0);
+
+  srand(1);
+  ok1(RandomTest(500));
+  ok1(RandomTest(4096));
+
+  return exit_status();
+}
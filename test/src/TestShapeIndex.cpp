@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Topography/ShapeIndex.hpp"
+#include "TestUtil.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+using Rect = ShapeIndex::Rect;
+
+static double
+Random(double min, double max)
+{
+  return min + (max - min) * (rand() / (double)RAND_MAX);
+}
+
+static std::vector<Rect>
+MakeRects(unsigned n)
+{
+  std::vector<Rect> rects;
+  for (unsigned i = 0; i < n; ++i) {
+    if (i % 50 == 7) {
+      /* a NULL shape */
+      rects.push_back(Rect::Empty());
+      continue;
+    }
+
+    /* mostly small shapes, and a few large ones which end up in the
+       upper nodes */
+    const double size = i % 20 == 0 ? Random(0, 3) : Random(0, 0.05);
+    const double x = Random(5, 15), y = Random(45, 50);
+    rects.push_back(Rect::Outward(x, y, x + size, y + size));
+  }
+
+  return rects;
+}
+
+/**
+ * Compare Query() with a brute force search.
+ */
+static bool
+CheckQuery(const ShapeIndex &index, const std::vector<Rect> &rects,
+           const Rect &query)
+{
+  std::vector<uint32_t> expected;
+  for (std::size_t i = 0; i < rects.size(); ++i)
+    if (!rects[i].IsEmpty() && rects[i].Overlaps(query))
+      expected.push_back(i);
+
+  std::vector<uint32_t> result{42};
+  index.Query(query, result);
+  return result == expected;
+}
+
+int
+main()
+{
+  plan_tests(12);
+
+  /* rounding outwards */
+  const Rect r = Rect::Outward(0.1, 0.2, 0.3, 0.4);
+  ok1(double(r.left) <= 0.1 && double(r.bottom) <= 0.2 &&
+      double(r.right) >= 0.3 && double(r.top) >= 0.4);
+  ok1(Rect::Empty().IsEmpty());
+  ok1(!Rect::Empty().Overlaps(r));
+
+  /* touching edges overlap */
+  ok1(Rect({0, 0, 1, 1}).Overlaps({1, 1, 2, 2}));
+
+  srand(42);
+  const auto rects = MakeRects(5000);
+  const ShapeIndex index{std::vector<Rect>{rects}};
+  ok1(index.size() == rects.size());
+
+  ok1(CheckQuery(index, rects, {8, 46, 8.5, 46.5}));
+  ok1(CheckQuery(index, rects, {5, 45, 18, 53}));
+  ok1(CheckQuery(index, rects, {0, 0, 100, 100}));
+  ok1(CheckQuery(index, rects, {10, 47.5, 10, 47.5}));
+  ok1(CheckQuery(index, rects, {20, 60, 21, 61}));
+  ok1(CheckQuery(index, rects, Rect::Empty()));
+
+  /* many identical shapes must not make the tree degenerate */
+  const std::vector<Rect> same(300, Rect{1, 1, 1.5f, 1.5f});
+  const ShapeIndex same_index{std::vector<Rect>{same}};
+  ok1(CheckQuery(same_index, same, {1.2f, 1.2f, 3, 3}));
+
+  return exit_status();
+}
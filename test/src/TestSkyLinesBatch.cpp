@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Tracking/SkyLines/Batch.hpp"
+#include "Tracking/SkyLines/Assemble.hpp"
+#include "util/CRC.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace SkyLinesTracking;
+
+static constexpr uint64_t KEY = 0x1234;
+
+template<typename P>
+static std::span<const std::byte>
+ToBytes(const P &packet)
+{
+  return std::as_bytes(std::span{&packet, 1});
+}
+
+static void
+TestRoundTrip()
+{
+  const auto ping = MakePing(KEY, 42);
+  const auto request = MakeTrafficRequest(KEY, true, false, true);
+
+  BatchBuilder builder;
+  ok1(builder.IsEmpty());
+  ok1(builder.Add(ToBytes(ping)));
+  ok1(builder.Add(ToBytes(request)));
+  ok1(!builder.IsEmpty());
+
+  const auto finished = builder.Finish(KEY);
+  alignas(8) std::byte datagram[BatchBuilder::MAX_SIZE];
+  std::copy(finished.begin(), finished.end(), datagram);
+  const std::span<std::byte> span{datagram, finished.size()};
+
+  /* the CRC covers the whole datagram */
+  auto &header = *(Header *)datagram;
+  ok1(FromBE16(header.type) == BATCH);
+  const uint16_t crc = FromBE16(header.crc);
+  header.crc = 0;
+  ok1(crc == UpdateCRC16CCITT(datagram, span.size(), 0));
+
+  std::vector<std::span<std::byte>> packets;
+  ok1(ForEachBatchEntry(span, [&packets](std::span<std::byte> packet){
+    packets.push_back(packet);
+  }));
+
+  ok1(packets.size() == 2);
+  ok1(packets.size() == 2 &&
+      std::equal(packets[0].begin(), packets[0].end(),
+                 ToBytes(ping).begin(), ToBytes(ping).end()) &&
+      std::equal(packets[1].begin(), packets[1].end(),
+                 ToBytes(request).begin(), ToBytes(request).end()));
+
+  /* the embedded packets are aligned */
+  ok1(packets.size() == 2 &&
+      (uintptr_t)packets[0].data() % 8 == 0 &&
+      (uintptr_t)packets[1].data() % 8 == 0);
+
+  /* a truncated datagram is rejected */
+  packets.clear();
+  ok1(!ForEachBatchEntry(span.first(span.size() - 4),
+                         [&packets](std::span<std::byte> packet){
+                           packets.push_back(packet);
+                         }));
+  ok1(packets.size() == 1);
+}
+
+static void
+TestFull()
+{
+  const auto ping = MakePing(KEY, 1);
+
+  BatchBuilder builder;
+  unsigned n = 0;
+  while (builder.Add(ToBytes(ping)))
+    ++n;
+
+  ok1(n == (BatchBuilder::MAX_SIZE - sizeof(BatchPacket)) /
+      (sizeof(BatchEntry) + sizeof(ping)));
+  ok1(builder.Finish(KEY).size() <= BatchBuilder::MAX_SIZE);
+
+  builder.Clear();
+  ok1(builder.IsEmpty());
+  ok1(builder.Finish(KEY).size() == sizeof(BatchPacket));
+}
+
+int
+main()
+{
+  plan_tests(16);
+
+  TestRoundTrip();
+  TestFull();
+
+  return exit_status();
+}
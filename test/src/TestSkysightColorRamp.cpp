@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Weather/Skysight/ColorRamp.hpp"
+#include "Weather/Skysight/Metrics.hpp"
+#include "TestUtil.hpp"
+
+#include <array>
+
+static constexpr int FILL = -32767;
+
+static const std::map<float, LegendColor> legend{
+  {0, {10, 20, 30}},
+  {1, {40, 50, 60}},
+  {2, {70, 80, 90}},
+};
+
+static bool
+IsColor(const uint8_t *p, uint8_t r, uint8_t g, uint8_t b, uint8_t a=0xff)
+{
+  return p[0] == r && p[1] == g && p[2] == b && p[3] == a;
+}
+
+static bool
+IsTransparent(const uint8_t *p)
+{
+  return IsColor(p, 0, 0, 0, 0);
+}
+
+static void
+TestLegend()
+{
+  /* scale 0.1: the packed values are tenths */
+  static constexpr std::array<int16_t, 8> src{
+    -5, 0, 1, 10, 11, 25, FILL, 1000,
+  };
+
+  uint8_t dest[src.size() * 4];
+  SkysightColorize(src, dest, legend, 0.1, 0, FILL);
+
+  /* not above the first key */
+  ok1(IsTransparent(dest));
+  ok1(IsTransparent(dest + 4));
+
+  /* the colour of the largest key below the value */
+  ok1(IsColor(dest + 8, 10, 20, 30));
+  ok1(IsColor(dest + 16, 40, 50, 60));
+  ok1(IsColor(dest + 20, 70, 80, 90));
+
+  ok1(IsTransparent(dest + 24));
+  ok1(IsColor(dest + 28, 70, 80, 90));
+}
+
+static void
+TestOffset()
+{
+  static constexpr std::array<int16_t, 3> src{-150, -50, 50};
+
+  uint8_t dest[src.size() * 4];
+  SkysightColorize(src, dest, legend, 0.01, 1.0, FILL);
+
+  /* unpacked: -0.5, 0.5, 1.5 */
+  ok1(IsTransparent(dest));
+  ok1(IsColor(dest + 4, 10, 20, 30));
+  ok1(IsColor(dest + 8, 40, 50, 60));
+}
+
+static void
+TestFillOnly()
+{
+  static constexpr std::array<int16_t, 2> src{FILL, FILL};
+
+  uint8_t dest[src.size() * 4];
+  SkysightColorize(src, dest, legend, 1, 0, FILL);
+
+  ok1(IsTransparent(dest));
+  ok1(IsTransparent(dest + 4));
+}
+
+int
+main()
+{
+  plan_tests(12);
+
+  TestLegend();
+  TestOffset();
+  TestFillOnly();
+
+  return exit_status();
+}
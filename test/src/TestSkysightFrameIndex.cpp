@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Weather/Skysight/FrameIndex.hpp"
+#include "TestUtil.hpp"
+
+static constexpr uint64_t SLOT = SkysightFrameIndex::SLOT_DURATION;
+static constexpr uint64_t T0 = 1700000000 / SLOT * SLOT;
+
+static void
+TestRange()
+{
+  SkysightFrameIndex index;
+
+  SkysightFrameIndex::Range range;
+  ok1(!index.GetRange("wstar", range));
+
+  index.Add("wstar", T0 + SLOT, 100);
+  index.Add("wstar", T0, 300);
+  index.Add("wstar", T0 + 4 * SLOT, 200);
+  index.Add("wstar_bsratio", T0 + 10 * SLOT, 400);
+
+  ok1(index.GetRange("wstar", range));
+  ok1(range.from == T0);
+  ok1(range.to == T0 + 4 * SLOT);
+  ok1(range.mtime == 300);
+
+  index.Remove("wstar", T0);
+  ok1(index.GetRange("wstar", range));
+  ok1(range.from == T0 + SLOT);
+
+  index.Remove("wstar", T0 + SLOT);
+  index.Remove("wstar", T0 + 4 * SLOT);
+  ok1(!index.GetRange("wstar", range));
+  ok1(index.Contains("wstar_bsratio", T0 + 10 * SLOT));
+}
+
+static void
+TestFindNearest()
+{
+  SkysightFrameIndex index;
+  ok1(index.FindNearest("wstar", T0, 2 * SLOT) == 0);
+
+  index.Add("wstar", T0, 0);
+  ok1(index.FindNearest("wstar", T0, 2 * SLOT) == T0);
+
+  /* look back first */
+  index.Add("wstar", T0 + 2 * SLOT, 0);
+  ok1(index.FindNearest("wstar", T0 + SLOT, 2 * SLOT) == T0);
+  ok1(index.FindNearest("wstar", T0 + 3 * SLOT, 2 * SLOT) == T0 + 2 * SLOT);
+
+  /* then forward */
+  ok1(index.FindNearest("wstar", T0 - SLOT, 2 * SLOT) == T0);
+
+  /* beyond the maximum offset */
+  ok1(index.FindNearest("wstar", T0 + 5 * SLOT, 2 * SLOT) == 0);
+  ok1(index.FindNearest("other", T0, 2 * SLOT) == 0);
+}
+
+static void
+TestCountMissing()
+{
+  SkysightFrameIndex index;
+  ok1(index.CountMissing("wstar", T0, 6) == 6);
+
+  index.Add("wstar", T0, 0);
+  index.Add("wstar", T0 + SLOT, 0);
+  index.Add("wstar", T0 + 3 * SLOT, 0);
+  ok1(index.CountMissing("wstar", T0, 2) == 0);
+  ok1(index.CountMissing("wstar", T0, 6) == 3);
+  ok1(index.CountMissing("wstar", T0 + SLOT, 3) == 1);
+}
+
+int
+main()
+{
+  plan_tests(20);
+
+  TestRange();
+  TestFindNearest();
+  TestCountMissing();
+
+  return exit_status();
+}
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Terrain/SlopeShading.hpp"
+#include "TestUtil.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+static constexpr unsigned WIDTH = 37, HEIGHT = 3;
+
+/**
+ * The per-pixel loop which RasterRenderer::GenerateSlopeImage() used
+ * before SlopeShading::CalcRow() existed.
+ */
+static int
+Reference(const TerrainHeight *row, unsigned x,
+          unsigned row_offset, unsigned step,
+          unsigned height_slope_factor, SlopeShading::Light light)
+{
+  const unsigned column_plus_index = x + step < WIDTH
+    ? step
+    : WIDTH - 1 - x;
+  const unsigned column_minus_index = x >= step ? step : x;
+
+  const auto *p = row + x;
+  return SlopeShading::CalcIndex(p[-(int)row_offset].GetValue() -
+                                 p[row_offset].GetValue(),
+                                 p[column_plus_index].GetValue() -
+                                 p[-(int)column_minus_index].GetValue(),
+                                 column_plus_index + column_minus_index,
+                                 2, height_slope_factor, light);
+}
+
+/**
+ * Compare CalcRow() with the reference for the middle row of
+ * #heights.
+ *
+ * @return the largest difference
+ */
+static int
+MaxDifference(const std::vector<TerrainHeight> &heights, unsigned step,
+              unsigned height_slope_factor, SlopeShading::Light light)
+{
+  const TerrainHeight *row = heights.data() + WIDTH;
+
+  int8_t result[WIDTH];
+  SlopeShading::CalcRow(row, WIDTH, WIDTH, WIDTH, 2, step,
+                        height_slope_factor, light, result);
+
+  int max_difference = 0;
+  for (unsigned x = 0; x < WIDTH; ++x) {
+    const int index = result[x];
+    if (index < -63 || index > 63)
+      return 999;
+
+    const int expected = Reference(row, x, WIDTH, step,
+                                   height_slope_factor, light);
+    max_difference = std::max(max_difference, std::abs(index - expected));
+  }
+
+  return max_difference;
+}
+
+static std::vector<TerrainHeight>
+MakeRandom(int min, int max)
+{
+  std::vector<TerrainHeight> heights;
+  for (unsigned i = 0; i < WIDTH * HEIGHT; ++i)
+    heights.emplace_back(int16_t(min + rand() % (max - min + 1)));
+  return heights;
+}
+
+int
+main()
+{
+  plan_tests(8);
+
+  static constexpr SlopeShading::Light light{-120, 180, 90, 160};
+  static constexpr SlopeShading::Light steep_light{200, -30, 150, 64};
+
+  /* flat terrain: the integer and the floating point versions agree
+     exactly */
+  const std::vector<TerrainHeight> flat(WIDTH * HEIGHT, TerrainHeight{500});
+  ok1(MaxDifference(flat, 1, 8, light) == 0);
+
+  srand(42);
+
+  /* gentle hills */
+  const auto hills = MakeRandom(200, 260);
+  ok1(MaxDifference(hills, 1, 8, light) <= 1);
+  ok1(MaxDifference(hills, 3, 8, steep_light) <= 1);
+
+  /* mountains */
+  const auto mountains = MakeRandom(0, 3000);
+  ok1(MaxDifference(mountains, 1, 1, light) <= 1);
+  ok1(MaxDifference(mountains, 2, 50, steep_light) <= 1);
+  ok1(MaxDifference(mountains, 25, 13, light) <= 1);
+
+  /* a broken map file with huge deltas must not overflow */
+  const auto broken = MakeRandom(-32000, 32000);
+  ok1(MaxDifference(broken, 1, 8, light) <= 1);
+  ok1(MaxDifference(broken, 4, 512, steep_light) <= 1);
+
+  return exit_status();
+}
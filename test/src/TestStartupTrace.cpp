@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "StartupTrace.hpp"
+#include "io/FileLineReader.hpp"
+#include "system/Path.hpp"
+#include "util/StringAPI.hxx"
+#include "util/StringCompare.hxx"
+#include "util/PrintException.hxx"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+using namespace std::chrono;
+
+static void
+TestDisabled()
+{
+  ok1(!StartupTrace::IsEnabled());
+
+  {
+    const StartupTrace::Timer timer{StartupStage::PROFILE};
+  }
+
+  ok1(StartupTrace::Get(StartupStage::PROFILE).count == 0);
+}
+
+static void
+TestTimer()
+{
+  StartupTrace::Enable();
+  ok1(StartupTrace::IsEnabled());
+
+  {
+    const StartupTrace::Timer timer{StartupStage::WAYPOINTS};
+    /* call the function directly; new-expressions may be optimised
+       away */
+    for (unsigned i = 0; i < 10; ++i)
+      ::operator delete(::operator new(16));
+  }
+
+  auto s = StartupTrace::Get(StartupStage::WAYPOINTS);
+  ok1(s.count == 1);
+  ok1(s.have_counters);
+  ok1(s.counters.allocations >= 10);
+
+  /* a stage run twice is summed */
+  StartupTrace::Add(StartupStage::WAYPOINTS, milliseconds(20),
+                    {1024, 0, 5, s.counters.have_io});
+  const auto s2 = StartupTrace::Get(StartupStage::WAYPOINTS);
+  ok1(s2.count == 2);
+  ok1(s2.duration == s.duration + milliseconds(20));
+  ok1(s2.counters.allocations == s.counters.allocations + 5);
+  ok1(s2.counters.read_bytes == s.counters.read_bytes + 1024);
+
+  /* a stage run by another thread has no counters */
+  StartupTrace::Add(StartupStage::TERRAIN_OVERVIEW, milliseconds(300));
+  s = StartupTrace::Get(StartupStage::TERRAIN_OVERVIEW);
+  ok1(s.count == 1);
+  ok1(!s.have_counters);
+  ok1(s.duration == milliseconds(300));
+
+  /* the other stages are not affected */
+  ok1(StartupTrace::Get(StartupStage::AIRSPACE).count == 0);
+}
+
+static void
+TestReport()
+{
+  ok1(!StartupTrace::IsComplete());
+  StartupTrace::Complete(milliseconds(1234));
+  ok1(StartupTrace::IsComplete());
+
+  const Path path(_T("output/TestStartupTrace.txt"));
+  StartupTrace::WriteReport(path);
+
+  FileLineReaderA reader(path);
+
+  bool found_total = false, found_terrain = false, found_airspace = false;
+  unsigned n_stages = 0;
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    if (StringIsEqual(line, "# total 1234 ms"))
+      found_total = true;
+    else if (StringIsEqual(line, "Terrain overview\t1\t300\t-\t-\t-"))
+      found_terrain = true;
+    else if (StringIsEqual(line, "Airspace\t0\t0\t-\t-\t-"))
+      found_airspace = true;
+
+    if (*line != '#')
+      ++n_stages;
+  }
+
+  ok1(found_total);
+  ok1(found_terrain);
+  ok1(found_airspace);
+  ok1(n_stages == unsigned(StartupStage::COUNT));
+}
+
+static void
+TestNames()
+{
+  ok1(strcmp(StartupTrace::GetStageName(StartupStage::PROFILE),
+             "Profile") == 0);
+  ok1(strcmp(StartupTrace::GetStageName(StartupStage::LUA),
+             "Lua init") == 0);
+}
+
+int
+main()
+try {
+  plan_tests(22);
+
+  TestDisabled();
+  TestTimer();
+  TestReport();
+  TestNames();
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Task/PathSolvers/TaskDijkstraMax.hpp"
+#include "Geo/SearchPointVector.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "TestUtil.hpp"
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+static std::size_t n_allocations;
+
+void *
+operator new(std::size_t size)
+{
+  ++n_allocations;
+
+  if (void *p = malloc(size))
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+  free(p);
+}
+
+static const GeoPoint origin(Angle::Degrees(7), Angle::Degrees(51));
+static const FlatProjection projection(origin);
+
+static unsigned seed = 42;
+
+static double
+Random() noexcept
+{
+  seed = seed * 1103515245 + 12345;
+  return double((seed >> 8) & 0xffff) / 0x10000;
+}
+
+/**
+ * A cloud of points around a turn point.
+ */
+static SearchPointVector
+MakeBoundary(unsigned n, double east, double north) noexcept
+{
+  SearchPointVector v;
+  for (unsigned i = 0; i < n; ++i)
+    v.push_back(SearchPoint(GeoPoint(origin.longitude +
+                                     Angle::Degrees(east + 0.1 * Random()),
+                                     origin.latitude +
+                                     Angle::Degrees(north + 0.1 * Random())),
+                            projection));
+  return v;
+}
+
+static int
+Distance(const SearchPoint &a, const SearchPoint &b) noexcept
+{
+  return int(unsigned(a.GetLocation().Distance(b.GetLocation())));
+}
+
+/**
+ * The best value found by enumerating all paths: the longest path,
+ * minus the index of its first point (the bias applied by
+ * TaskDijkstra::AddZeroStartEdges()).
+ */
+static int
+BruteForce(const std::vector<SearchPointVector> &boundaries,
+           unsigned stage, const SearchPoint &from) noexcept
+{
+  if (stage == boundaries.size())
+    return 0;
+
+  int best = -1;
+  for (const auto &p : boundaries[stage])
+    best = std::max(best, Distance(from, p) +
+                    BruteForce(boundaries, stage + 1, p));
+  return best;
+}
+
+static int
+BruteForce(const std::vector<SearchPointVector> &boundaries) noexcept
+{
+  int best = -1;
+  for (unsigned i = 0; i < boundaries[0].size(); ++i)
+    best = std::max(best, BruteForce(boundaries, 1, boundaries[0][i]) -
+                    int(i));
+  return best;
+}
+
+static int
+GetSolutionValue(const TaskDijkstraMax &dijkstra,
+                 const std::vector<SearchPointVector> &boundaries) noexcept
+{
+  int value = 0;
+  for (unsigned i = 1; i < boundaries.size(); ++i)
+    value += Distance(dijkstra.GetSolution(i - 1), dijkstra.GetSolution(i));
+
+  /* subtract the index of the first point */
+  const auto &first = dijkstra.GetSolution(0);
+  for (unsigned i = 0; i < boundaries[0].size(); ++i)
+    if (&boundaries[0][i] == &first)
+      return value - int(i);
+
+  return -1;
+}
+
+int
+main()
+{
+  plan_tests(4);
+
+  std::vector<SearchPointVector> boundaries;
+  boundaries.push_back(MakeBoundary(6, 0, 0));
+  boundaries.push_back(MakeBoundary(12, 0.4, 0.1));
+  boundaries.push_back(MakeBoundary(12, 0.5, 0.5));
+  boundaries.push_back(MakeBoundary(12, 0.1, 0.4));
+  boundaries.push_back(MakeBoundary(6, 0, 0));
+
+  TaskDijkstraMax dijkstra;
+  dijkstra.SetTaskSize(boundaries.size());
+  for (unsigned i = 0; i < boundaries.size(); ++i)
+    dijkstra.SetBoundary(i, boundaries[i]);
+
+  ok1(dijkstra.DistanceMax());
+  const int expected = BruteForce(boundaries);
+  ok1(GetSolutionValue(dijkstra, boundaries) == expected);
+
+  /* the second search reuses the memory of the first one */
+  const std::size_t allocations_start = n_allocations;
+  const bool success = dijkstra.DistanceMax();
+  const std::size_t allocations = n_allocations - allocations_start;
+
+  ok1(success && GetSolutionValue(dijkstra, boundaries) == expected);
+  ok1(allocations == 0);
+
+  return exit_status();
+}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Task/PathSolvers/TaskDijkstraMin.hpp"
+#include "Geo/SearchPointVector.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "TestUtil.hpp"
+
+#include <limits>
+#include <vector>
+
+static const GeoPoint origin(Angle::Degrees(7), Angle::Degrees(51));
+static const FlatProjection projection(origin);
+
+static unsigned seed = 42;
+
+static double
+Random() noexcept
+{
+  seed = seed * 1103515245 + 12345;
+  return double((seed >> 8) & 0xffff) / 0x10000;
+}
+
+static SearchPoint
+MakePoint(double east, double north) noexcept
+{
+  return SearchPoint(GeoPoint(origin.longitude + Angle::Degrees(east),
+                              origin.latitude + Angle::Degrees(north)),
+                     projection);
+}
+
+/**
+ * A ring of points around a turn point.
+ */
+static SearchPointVector
+MakeBoundary(unsigned n, double east, double north) noexcept
+{
+  SearchPointVector v;
+  for (unsigned i = 0; i < n; ++i)
+    v.push_back(MakePoint(east + 0.05 * (Random() - 0.5),
+                          north + 0.05 * (Random() - 0.5)));
+  return v;
+}
+
+static SearchPointVector
+MakeSingle(double east, double north) noexcept
+{
+  SearchPointVector v;
+  v.push_back(MakePoint(east, north));
+  return v;
+}
+
+static unsigned
+Distance(const SearchPoint &a, const SearchPoint &b) noexcept
+{
+  return unsigned(a.GetLocation().Distance(b.GetLocation()));
+}
+
+/**
+ * The length of the shortest path found by enumerating all paths,
+ * using the solver's integer metric.
+ */
+static unsigned
+BruteForce(const SearchPoint &location,
+           const std::vector<SearchPointVector> &boundaries,
+           unsigned stage) noexcept
+{
+  unsigned best = std::numeric_limits<unsigned>::max();
+  for (const auto &p : boundaries[stage]) {
+    const unsigned rest = stage + 1 < boundaries.size()
+      ? BruteForce(p, boundaries, stage + 1)
+      : 0;
+    best = std::min(best, Distance(location, p) + rest);
+  }
+
+  return best;
+}
+
+static bool
+Solve(TaskDijkstraMin &dijkstra, const SearchPoint &location,
+      const std::vector<SearchPointVector> &boundaries, unsigned active)
+{
+  dijkstra.SetTaskSize(boundaries.size() - active);
+  for (unsigned i = active; i < boundaries.size(); ++i)
+    dijkstra.SetBoundary(i - active, boundaries[i]);
+
+  if (!dijkstra.DistanceMin(location))
+    return false;
+
+  /* the solution must be the shortest path */
+  unsigned length = Distance(location, dijkstra.GetSolution(0));
+  for (unsigned i = active + 1; i < boundaries.size(); ++i)
+    length += Distance(dijkstra.GetSolution(i - active - 1),
+                       dijkstra.GetSolution(i - active));
+
+  const std::vector<SearchPointVector> remaining(boundaries.begin() + active,
+                                                 boundaries.end());
+  return length == BruteForce(location, remaining, 0);
+}
+
+int
+main()
+{
+  plan_tests(7);
+
+  std::vector<SearchPointVector> boundaries;
+  boundaries.push_back(MakeSingle(0, 0));
+  boundaries.push_back(MakeBoundary(8, 0.3, 0.1));
+  boundaries.push_back(MakeBoundary(10, 0.5, 0.4));
+  boundaries.push_back(MakeBoundary(7, 0.1, 0.5));
+  boundaries.push_back(MakeSingle(0, 0));
+
+  TaskDijkstraMin dijkstra;
+
+  /* the first solve builds all layers */
+  SearchPoint location = MakePoint(0.01, 0.01);
+  ok1(Solve(dijkstra, location, boundaries, 1));
+
+  /* the aircraft has moved: only the first edges change */
+  location = MakePoint(0.2, 0.05);
+  ok1(Solve(dijkstra, location, boundaries, 1));
+
+  /* a new sample in the active sector */
+  boundaries[1].push_back(MakePoint(0.31, 0.09));
+  ok1(Solve(dijkstra, location, boundaries, 1));
+
+  /* a later sector has been modified */
+  boundaries[3] = MakeBoundary(9, 0.15, 0.45);
+  ok1(Solve(dijkstra, location, boundaries, 1));
+
+  /* the active task point has advanced */
+  location = MakePoint(0.45, 0.35);
+  ok1(Solve(dijkstra, location, boundaries, 2));
+
+  /* a fresh solver gives the same result */
+  TaskDijkstraMin fresh;
+  ok1(Solve(fresh, location, boundaries, 2) &&
+      fresh.GetSolution(0).GetLocation() ==
+      dijkstra.GetSolution(0).GetLocation());
+
+  /* an empty boundary can't be solved */
+  boundaries[3].clear();
+  ok1(!dijkstra.DistanceMin(location));
+
+  return exit_status();
+}
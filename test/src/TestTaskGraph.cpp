@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "thread/TaskGraph.hpp"
+#include "thread/ThreadPool.hpp"
+#include "TestUtil.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+/**
+ * A diamond with a tail: a -> (b, c) -> d, plus the independent e.
+ * Each task records the value of a shared counter when it starts
+ * and when it finishes.
+ */
+struct Diamond {
+  TaskGraph graph;
+
+  std::atomic<unsigned> counter{0};
+  unsigned started[5], finished[5];
+  unsigned a, b, c, d, e;
+
+  Diamond() noexcept {
+    a = Add("a", 0, {});
+    b = Add("b", 1, {a});
+    c = Add("c", 2, {a});
+    e = Add("e", 4, {});
+    d = Add("d", 3, {b, c});
+  }
+
+  unsigned Add(const char *name, unsigned i,
+               std::initializer_list<unsigned> dependencies) noexcept {
+    return graph.AddTask(name, [this, i]{
+      started[i] = counter++;
+
+      /* "c" takes longest, so the critical path is a-c-d */
+      std::this_thread::sleep_for(milliseconds(i == 2 ? 20 : 2));
+
+      finished[i] = counter++;
+    }, dependencies);
+  }
+
+  bool CheckOrder() const noexcept {
+    return finished[0] < started[1] && finished[0] < started[2] &&
+      finished[1] < started[3] && finished[2] < started[3];
+  }
+
+  bool CheckCriticalPath() const noexcept {
+    const auto path = graph.GetCriticalPath();
+    return path == std::vector<unsigned>{a, c, d} &&
+      graph.GetCriticalLength() ==
+      graph.GetDuration(a) + graph.GetDuration(c) + graph.GetDuration(d) &&
+      graph.GetCriticalLength() < graph.GetWork();
+  }
+};
+
+/**
+ * Run the diamond with an expired deadline: each Run() call must run
+ * at least one task, and the round must eventually complete with
+ * all dependencies respected.
+ */
+static void
+TestDeadline(ThreadPool *pool)
+{
+  Diamond diamond;
+
+  unsigned n_calls = 0;
+  bool pending = true;
+  while (!diamond.graph.Run(pool, TaskGraph::Clock::now())) {
+    pending = diamond.graph.IsPending() && pending;
+    ++n_calls;
+  }
+
+  ok1(pending);
+  ok1(!diamond.graph.IsPending());
+  ok1(n_calls > 0 && n_calls < 5);
+  ok1(diamond.counter == 10);
+  ok1(diamond.CheckOrder());
+  ok1(diamond.CheckCriticalPath());
+
+  /* the next call starts a new round */
+  ok1(diamond.graph.Run(pool));
+  ok1(diamond.counter == 20);
+}
+
+int
+main()
+{
+  plan_tests(25);
+
+  {
+    /* without a pool, the tasks run in the order they were added */
+    Diamond diamond;
+    diamond.graph.Run(nullptr);
+
+    ok1(diamond.CheckOrder());
+    ok1(diamond.finished[4] < diamond.started[3]);
+    ok1(diamond.CheckCriticalPath());
+  }
+
+  {
+    ThreadPool pool("TestGraph", 3);
+    Diamond diamond;
+
+    bool all_ok = true;
+    for (unsigned i = 0; i < 20; ++i) {
+      diamond.graph.Run(&pool);
+      all_ok = diamond.CheckOrder() && all_ok;
+    }
+
+    ok1(all_ok);
+    ok1(diamond.counter == 20 * 10);
+    ok1(diamond.CheckCriticalPath());
+    ok1(diamond.graph.GetWork() >= milliseconds(28));
+  }
+
+  {
+    /* without workers, everything runs in the calling thread */
+    ThreadPool pool("TestGraph", 0);
+    Diamond diamond;
+    diamond.graph.Run(&pool);
+    ok1(diamond.CheckOrder());
+  }
+
+  TestDeadline(nullptr);
+
+  {
+    ThreadPool pool("TestGraph", 3);
+    TestDeadline(&pool);
+  }
+
+  {
+    TaskGraph empty;
+    empty.Run(nullptr);
+    ok1(empty.GetCriticalLength() == TaskGraph::Duration::zero());
+  }
+
+  return exit_status();
+}
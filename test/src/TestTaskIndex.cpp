@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Task/TaskIndex.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+
+using std::chrono::system_clock;
+
+int
+main()
+{
+  plan_tests(16);
+
+  const Path directory(_T("output/results"));
+  Directory::Create(directory);
+  const auto index_path = AllocatedPath::Build(directory, _T("tasks.idx"));
+  File::Delete(index_path);
+
+  /* the files need not exist, but RemoveUnused() deletes entries of
+     missing files which were not used */
+  const Path a(_T("test/data/01lz1hq1.igc")), b(_T("does/not/exist.tsk"));
+  const auto mtime = system_clock::from_time_t(1234567890) +
+    std::chrono::milliseconds(123);
+
+  TaskIndex index;
+  index.Load(index_path);
+  ok1(!index.IsModified());
+  ok1(index.Lookup(a, 42, mtime) == nullptr);
+
+  index.Put(a, 42, mtime, {_T("first"), _T("second")});
+  index.Put(b, 1, mtime, {tstring{}});
+  ok1(index.IsModified());
+
+  TaskIndex::Summary summary;
+  summary.defined = true;
+  summary.type = TaskFactoryType::AAT;
+  summary.n_points = 5;
+  summary.distance = 123456;
+  index.SetSummary(a, 1, summary);
+  index.SetSummary(a, 7, summary);
+
+  index.Save(index_path);
+  ok1(!index.IsModified());
+
+  /* load it again */
+  TaskIndex loaded;
+  loaded.Load(index_path);
+
+  /* modified files are not found */
+  ok1(loaded.Lookup(a, 43, mtime) == nullptr);
+  ok1(loaded.Lookup(a, 42, mtime + std::chrono::seconds(1)) == nullptr);
+
+  const auto *entry = loaded.Lookup(a, 42, mtime);
+  ok1(entry != nullptr);
+  ok1(entry != nullptr && entry->tasks.size() == 2);
+  ok1(entry != nullptr && entry->tasks.size() == 2 &&
+      entry->tasks[0].name == _T("first") &&
+      entry->tasks[1].name == _T("second"));
+  ok1(entry != nullptr && entry->tasks.size() == 2 &&
+      !entry->tasks[0].summary.defined);
+  ok1(entry != nullptr && entry->tasks.size() == 2 &&
+      entry->tasks[1].summary.defined &&
+      entry->tasks[1].summary.type == TaskFactoryType::AAT &&
+      entry->tasks[1].summary.n_points == 5 &&
+      entry->tasks[1].summary.distance == 123456);
+
+  /* "b" was not used and does not exist */
+  loaded.RemoveUnused();
+  ok1(loaded.IsModified());
+  ok1(loaded.Lookup(b, 1, mtime) == nullptr);
+  ok1(loaded.Lookup(a, 42, mtime) != nullptr);
+
+  /* a corrupt file results in an empty index */
+  File::WriteExisting(index_path, "garbage");
+  loaded.Load(index_path);
+  ok1(loaded.Lookup(a, 42, mtime) == nullptr);
+  ok1(!loaded.IsModified());
+
+  File::Delete(index_path);
+
+  return exit_status();
+}
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Terrain/Prefetch.hpp"
+#include "Terrain/RasterTile.hpp"
+#include "Geo/GeoVector.hpp"
+#include "TestUtil.hpp"
+
+static bool
+IsAt(const GeoPoint &origin, const GeoPoint &p,
+     double distance, double bearing)
+{
+  if (!p.IsValid())
+    return false;
+
+  const auto v = origin.DistanceBearing(p);
+  return equals(v.distance, distance) &&
+    equals(v.bearing.Degrees(), bearing);
+}
+
+static void
+TestPredict()
+{
+  using namespace TerrainPrefetch;
+
+  const GeoPoint origin(Angle::Degrees(7), Angle::Degrees(51));
+  const GeoPoint north = GeoVector(3000, Angle::Zero()).EndPoint(origin);
+  const GeoPoint east_far =
+    GeoVector(40000, Angle::Degrees(90)).EndPoint(origin);
+
+  /* no location */
+  ok1(!Predict(GeoPoint::Invalid(), Angle::Degrees(90), 30,
+               GeoPoint::Invalid(), false).IsValid());
+
+  /* along the track */
+  ok1(IsAt(origin, Predict(origin, Angle::Degrees(90), 30,
+                           GeoPoint::Invalid(), false),
+           30 * LOOK_AHEAD, 90));
+
+  /* limited to MAX_DISTANCE */
+  ok1(IsAt(origin, Predict(origin, Angle::Degrees(90), 250,
+                           GeoPoint::Invalid(), false),
+           MAX_DISTANCE, 90));
+
+  /* the track leads to the waypoint: the path ends there */
+  ok1(IsAt(origin, Predict(origin, Angle::Degrees(15), 30, north, false),
+           3000, 0));
+
+  /* the waypoint is elsewhere: follow the track */
+  ok1(IsAt(origin, Predict(origin, Angle::Degrees(90), 30, north, false),
+           30 * LOOK_AHEAD, 90));
+
+  /* circling: towards the waypoint */
+  ok1(IsAt(origin, Predict(origin, Angle::Degrees(200), 30, east_far, true),
+           WAYPOINT_DISTANCE, 90));
+  ok1(IsAt(origin, Predict(origin, Angle::Degrees(200), 30, north, true),
+           3000, 0));
+
+  /* circling without a task */
+  ok1(!Predict(origin, Angle::Degrees(200), 30,
+               GeoPoint::Invalid(), true).IsValid());
+
+  /* too slow for the track */
+  ok1(IsAt(origin, Predict(origin, Angle::Degrees(90), 3, north, false),
+           3000, 0));
+  ok1(!Predict(origin, Angle::Degrees(90), 3,
+               GeoPoint::Invalid(), false).IsValid());
+}
+
+static void
+TestPathDistance()
+{
+  RasterTile tile;
+  tile.Set({1000, 0}, {1256, 256});
+
+  const IntPoint2D p{128, 128};
+
+  /* no path: the plain distance */
+  ok1(tile.CalcPathDistanceTo(p, p) == 872);
+
+  /* the path passes through the tile: only half of the distance
+     along the path counts */
+  ok1(tile.CalcPathDistanceTo(p, {2000, 128}) == 128 + 1000 / 2);
+
+  /* the path leads away from the tile */
+  ok1(tile.CalcPathDistanceTo(p, {-2000, 128}) == 872);
+}
+
+int
+main()
+{
+  plan_tests(13);
+
+  TestPredict();
+  TestPathDistance();
+
+  return exit_status();
+}
@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Terrain/RasterTileCache.hpp"
+#include "Terrain/jasper/jas_seq.h"
+#include "io/StringOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "io/MemoryReader.hxx"
+#include "io/BufferedReader.hxx"
+#include "TestUtil.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static constexpr unsigned MAP_SIZE = 1024, TILE_SIZE = 256;
+static constexpr unsigned N_TILES = MAP_SIZE / TILE_SIZE;
+
+[[gnu::const]]
+static TerrainHeight
+MakeHeight(unsigned x, unsigned y) noexcept
+{
+  return TerrainHeight(int16_t((x * 7 + y * 3) % 1000));
+}
+
+class TestCache : public RasterTileCache {
+public:
+  explicit TestCache(unsigned map_size=MAP_SIZE) noexcept {
+    const unsigned n_tiles = map_size / TILE_SIZE;
+    SetSize({map_size, map_size}, {TILE_SIZE, TILE_SIZE},
+            {n_tiles, n_tiles});
+
+    std::vector<jas_seqent_t> data(TILE_SIZE * TILE_SIZE);
+    std::vector<jas_seqent_t *> rows(TILE_SIZE);
+
+    for (unsigned i = 0; i < n_tiles * n_tiles; ++i) {
+      const RasterLocation start = GetTileStart(i, n_tiles);
+      for (unsigned y = 0; y < TILE_SIZE; ++y) {
+        rows[y] = data.data() + y * TILE_SIZE;
+        for (unsigned x = 0; x < TILE_SIZE; ++x)
+          rows[y][x] = MakeHeight(start.x + x, start.y + y).GetValue();
+      }
+
+      jas_matrix m{};
+      m.numrows_ = m.numcols_ = TILE_SIZE;
+      m.rows_ = rows.data();
+
+      PutOverviewTile(i, start, start + RasterLocation{TILE_SIZE, TILE_SIZE},
+                      m);
+    }
+  }
+
+  static RasterLocation GetTileStart(unsigned i,
+                                     unsigned n_tiles=N_TILES) noexcept {
+    return {i % n_tiles * TILE_SIZE, i / n_tiles * TILE_SIZE};
+  }
+
+  void LoadTile(unsigned i, unsigned distance) noexcept {
+    std::vector<TerrainHeight> heights;
+    const RasterLocation start = GetTileStart(i);
+    for (unsigned y = 0; y < TILE_SIZE; ++y)
+      for (unsigned x = 0; x < TILE_SIZE; ++x)
+        heights.push_back(MakeHeight(start.x + x, start.y + y));
+
+    auto &tile = tiles.GetLinear(i);
+    tile.SetRequest();
+    PutTileBuffer(i, MakeTileBuffer(i, heights));
+    tile.distance = distance;
+  }
+
+  bool IsTileLoaded(unsigned i) const noexcept {
+    return tiles.GetLinear(i).IsLoaded();
+  }
+
+  /**
+   * Does the tile contain the expected full resolution data?
+   */
+  bool CheckTile(unsigned i) const noexcept {
+    if (!IsTileLoaded(i))
+      return false;
+
+    const RasterLocation start = GetTileStart(i);
+    for (unsigned y = 0; y < TILE_SIZE; y += 7)
+      for (unsigned x = 0; x < TILE_SIZE; x += 5)
+        if (GetHeight(start + RasterLocation{x, y}).GetValue() !=
+            MakeHeight(start.x + x, start.y + y).GetValue())
+          return false;
+
+    return true;
+  }
+};
+
+static std::string
+Save(const RasterTileCache &cache, unsigned max_tiles)
+{
+  StringOutputStream sos;
+  BufferedOutputStream bos(sos);
+  cache.SaveTiles(bos, max_tiles);
+  bos.Flush();
+  return std::move(sos).GetValue();
+}
+
+static unsigned
+Load(RasterTileCache &cache, std::string_view data)
+{
+  MemoryReader mr(std::as_bytes(std::span{data}));
+  BufferedReader br(mr);
+  return cache.LoadTiles(br);
+}
+
+static bool
+LoadThrows(RasterTileCache &cache, std::string_view data)
+{
+  try {
+    Load(cache, data);
+    return false;
+  } catch (const std::runtime_error &) {
+    return true;
+  }
+}
+
+/**
+ * Does GetHeights() return the same as GetHeight() for points in
+ * loaded and unloaded tiles, in scattered order, and out of range?
+ */
+static bool
+CheckHeights(const RasterTileCache &cache) noexcept
+{
+  std::vector<RasterLocation> points;
+  for (unsigned i = 0; i < 500; ++i)
+    points.push_back({(i * 769) % (MAP_SIZE + 16),
+                      (i * 389) % (MAP_SIZE + 8)});
+
+  std::vector<TerrainHeight> heights(points.size());
+  cache.GetHeights(points, heights);
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const auto expected = cache.GetHeight(points[i]);
+    if (heights[i].IsInvalid() != expected.IsInvalid() ||
+        (!expected.IsInvalid() &&
+         heights[i].GetValue() != expected.GetValue()))
+      return false;
+  }
+
+  return true;
+}
+
+int
+main()
+{
+  plan_tests(16);
+
+  TestCache source;
+  source.LoadTile(0, 300);
+  source.LoadTile(5, 100);
+  source.LoadTile(6, 200);
+
+  const auto stats = source.GetStatsSnapshot();
+  ok1(stats.resident_tiles == 3);
+  ok1(stats.resident_bytes == 3 * TILE_SIZE * TILE_SIZE * sizeof(TerrainHeight));
+
+  /* bulk lookups */
+  ok1(CheckHeights(source));
+  ok1(CheckHeights(TestCache{}));
+
+  /* only the two nearest tiles are saved */
+  const auto data = Save(source, 2);
+
+  TestCache dest;
+  ok1(Load(dest, data) == 2);
+  ok1(dest.CheckTile(5));
+  ok1(dest.CheckTile(6));
+  ok1(!dest.IsTileLoaded(0));
+
+  /* all tiles */
+  TestCache dest2;
+  ok1(Load(dest2, Save(source, 16)) == 3);
+  ok1(dest2.CheckTile(0));
+
+  /* no tiles */
+  TestCache dest3;
+  ok1(Load(dest3, Save(TestCache{}, 16)) == 0);
+  ok1(!dest3.IsTileLoaded(0));
+
+  /* a different map */
+  TestCache other(MAP_SIZE * 2);
+  ok1(LoadThrows(other, data));
+
+  /* truncated */
+  TestCache dest4;
+  ok1(LoadThrows(dest4, std::string_view{data}.substr(0, data.size() - 1)));
+
+  /* restoring into a tile which is already loaded */
+  TestCache dest5;
+  dest5.LoadTile(6, 0);
+  ok1(LoadThrows(dest5, data));
+
+  /* garbage */
+  TestCache dest6;
+  ok1(LoadThrows(dest6, std::string(64, 'x')));
+
+  return exit_status();
+}
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Computer/ThermalHistory.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std::chrono;
+
+static constexpr TimeStamp now{hours{12}};
+
+static GeoPoint
+MakePoint(double longitude, double latitude)
+{
+  return GeoPoint(Angle::Degrees(longitude), Angle::Degrees(latitude));
+}
+
+static void
+Add(ThermalHistory &history, const GeoPoint &location, double lift_rate)
+{
+  /* a 5 minute climb */
+  history.Add(location, lift_rate * 300, seconds{300}, now);
+}
+
+static void
+TestMerge()
+{
+  ThermalHistory history;
+
+  /* two climbs in the same cell, one in the next cell */
+  Add(history, MakePoint(7.001, 51.001), 1);
+  Add(history, MakePoint(7.003, 51.003), 3);
+  Add(history, MakePoint(7.021, 51.001), 2);
+
+  ok1(history.size() == 2);
+
+  const auto *hotspot =
+    history.FindNearest(MakePoint(7.002, 51.002), 10000);
+  ok1(hotspot != nullptr);
+  ok1(hotspot->n_climbs == 2);
+  ok1(equals(hotspot->GetLiftRate(), 2));
+  ok1(equals(hotspot->best_lift_rate, 3));
+
+  /* the location is weighted by the gain */
+  ok1(hotspot->location.longitude.Degrees() > 7.002);
+  ok1(hotspot->location.longitude.Degrees() < 7.003);
+}
+
+static void
+TestNearest()
+{
+  ThermalHistory history;
+  ok1(history.FindNearest(MakePoint(7, 51), 100000) == nullptr);
+
+  Add(history, MakePoint(7.00, 51.00), 1);
+  Add(history, MakePoint(7.10, 51.00), 3);
+
+  const GeoPoint here = MakePoint(7.04, 51.00);
+
+  /* the western one is closer */
+  const auto *hotspot = history.FindNearest(here, 100000);
+  ok1(hotspot != nullptr && hotspot->best_lift_rate < 2);
+
+  /* ... but too weak */
+  hotspot = history.FindNearest(here, 100000, 2);
+  ok1(hotspot != nullptr && hotspot->best_lift_rate > 2);
+
+  /* out of range */
+  ok1(history.FindNearest(here, 1000) == nullptr);
+
+  /* across the date line */
+  history.Clear();
+  Add(history, MakePoint(179.999, -40), 1);
+  ok1(history.FindNearest(MakePoint(-179.999, -40), 1000) != nullptr);
+}
+
+/**
+ * Compare the grid search with a linear search over many random
+ * hotspots.
+ */
+static void
+TestRandom()
+{
+  ThermalHistory history;
+
+  srand(42);
+  const auto random = [](double range){
+    return (rand() / double(RAND_MAX) - 0.5) * range;
+  };
+
+  for (unsigned i = 0; i < 2000; ++i)
+    Add(history, MakePoint(10 + random(2), 45 + random(2)), 1);
+
+  const GeoBounds world(MakePoint(-180, 90), MakePoint(180, -90));
+
+  bool all_ok = true;
+  for (unsigned i = 0; i < 200; ++i) {
+    const GeoPoint here = MakePoint(10 + random(2), 45 + random(2));
+
+    double expected = 5000;
+    history.VisitWithin(world, [&](const ThermalHistory::Hotspot &hotspot){
+      expected = std::min(expected, here.DistanceS(hotspot.location));
+    });
+
+    const auto *hotspot = history.FindNearest(here, 5000);
+    all_ok = (hotspot != nullptr
+              ? here.DistanceS(hotspot->location) == expected
+              : expected >= 5000) && all_ok;
+  }
+
+  ok1(all_ok);
+
+  unsigned n = 0;
+  const GeoBounds bounds(MakePoint(9.5, 45.5), MakePoint(10.5, 44.5));
+  history.VisitWithin(bounds, [&](const ThermalHistory::Hotspot &hotspot){
+    all_ok = bounds.IsInside(hotspot.location) && all_ok;
+    ++n;
+  });
+
+  ok1(all_ok);
+  ok1(n > 0 && n < history.size());
+}
+
+int
+main()
+{
+  plan_tests(15);
+
+  TestMerge();
+  TestNearest();
+  TestRandom();
+
+  return exit_status();
+}
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "thread/ThreadPool.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static constexpr std::size_t N_TASKS = 1000;
+
+/**
+ * Run a batch and check that each task was run exactly once.
+ */
+static bool
+RunBatch(ThreadPool &pool, std::size_t n)
+{
+  std::vector<std::atomic<unsigned>> counters(n);
+  pool.ForEach(n, [&](std::size_t i){
+    counters[i].fetch_add(1, std::memory_order_relaxed);
+  });
+
+  return std::all_of(counters.begin(), counters.end(), [](const auto &c){
+    return c.load(std::memory_order_relaxed) == 1;
+  });
+}
+
+int
+main()
+{
+  plan_tests(6);
+
+  {
+    ThreadPool pool("TestPool", 3);
+    ok1(RunBatch(pool, N_TASKS));
+
+    bool all_ok = true;
+    for (unsigned i = 0; i < 20; ++i)
+      all_ok = RunBatch(pool, 1 + i * 7) && all_ok;
+    ok1(all_ok);
+
+    ok1(RunBatch(pool, 0));
+  }
+
+  {
+    /* without workers, everything runs in the calling thread */
+    ThreadPool pool("TestPool", 0);
+    ok1(RunBatch(pool, N_TASKS));
+
+    const auto self = std::this_thread::get_id();
+    std::atomic<bool> inline_only{true};
+    pool.ForEach(N_TASKS, [&](std::size_t){
+      if (std::this_thread::get_id() != self)
+        inline_only = false;
+    });
+    ok1(inline_only);
+  }
+
+  /* a pool which was never used has no threads to join */
+  {
+    ThreadPool pool("TestPool", 3);
+  }
+  ok1(true);
+
+  return exit_status();
+}
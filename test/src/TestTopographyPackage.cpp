@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Topography/TopographyPackage.hpp"
+#include "io/StringOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <string.h>
+
+static constexpr unsigned N_SHAPES = 200;
+
+static const GeoPoint center(Angle::Degrees(11), Angle::Degrees(47));
+
+struct TestShape {
+  GeoBounds bounds;
+  std::vector<uint16_t> lines;
+  std::vector<ShapePoint> points;
+  std::string label;
+  std::vector<uint16_t> indices;
+};
+
+static double
+Random(double min, double max)
+{
+  return min + (max - min) * (rand() / (double)RAND_MAX);
+}
+
+static std::vector<TestShape>
+MakeShapes()
+{
+  std::vector<TestShape> shapes;
+  for (unsigned i = 0; i < N_SHAPES; ++i) {
+    auto &shape = shapes.emplace_back();
+
+    const GeoPoint nw(Angle::Degrees(Random(10, 12)),
+                      Angle::Degrees(Random(46.1, 48)));
+    const GeoPoint se(nw.longitude + Angle::Degrees(Random(0, 0.1)),
+                      nw.latitude - Angle::Degrees(Random(0, 0.1)));
+    shape.bounds = GeoBounds(nw, se);
+
+    const unsigned n_lines = 1 + i % 3;
+    for (unsigned l = 0; l < n_lines; ++l) {
+      const unsigned n_points = 3 + (i + l) % 5;
+      shape.lines.push_back(n_points);
+      for (unsigned p = 0; p < n_points; ++p)
+        shape.points.push_back({float(i), float(l * 100 + p)});
+    }
+
+    if (i % 4 == 0)
+      shape.label = "Shape " + std::to_string(i);
+
+    if (i % 2 == 0) {
+      shape.indices.push_back(2);
+      shape.indices.push_back(0);
+      shape.indices.push_back(shape.points.size() - 1);
+    }
+  }
+
+  return shapes;
+}
+
+static std::vector<TopographyPackage::Shape>
+ToPackageShapes(const std::vector<TestShape> &src)
+{
+  std::vector<TopographyPackage::Shape> result;
+  for (const auto &i : src) {
+    auto &shape = result.emplace_back();
+    shape.bounds = i.bounds;
+    shape.type = 2;
+    shape.lines = i.lines;
+    shape.points = i.points;
+    shape.label = i.label.empty() ? nullptr : i.label.c_str();
+    shape.indices[1] = i.indices;
+  }
+
+  return result;
+}
+
+static bool
+Equals(const TopographyPackage::Shape &a, const TestShape &b)
+{
+  if (a.type != 2 ||
+      !std::equal(a.lines.begin(), a.lines.end(),
+                  b.lines.begin(), b.lines.end()) ||
+      !std::equal(a.points.begin(), a.points.end(),
+                  b.points.begin(), b.points.end()) ||
+      !std::equal(a.indices[1].begin(), a.indices[1].end(),
+                  b.indices.begin(), b.indices.end()) ||
+      !a.indices[0].empty())
+    return false;
+
+  if (b.label.empty() ? a.label != nullptr
+      : (a.label == nullptr || b.label != a.label))
+    return false;
+
+  /* the bounds are stored as radians */
+  return std::abs((a.bounds.GetWest() - b.bounds.GetWest()).Native()) < 1e-12 &&
+    std::abs((a.bounds.GetNorth() - b.bounds.GetNorth()).Native()) < 1e-12 &&
+    std::abs((a.bounds.GetEast() - b.bounds.GetEast()).Native()) < 1e-12 &&
+    std::abs((a.bounds.GetSouth() - b.bounds.GetSouth()).Native()) < 1e-12;
+}
+
+/**
+ * Compare WhichShapes() with a brute force search.
+ */
+static bool
+CheckWhichShapes(const TopographyPackage::Layer &layer,
+                 const std::vector<TestShape> &shapes,
+                 const GeoBounds &bounds)
+{
+  std::vector<uint32_t> status((shapes.size() + 31) / 32, 0xdeadbeef);
+  const std::size_t n = layer.WhichShapes(bounds, status);
+
+  std::size_t expected_n = 0;
+  for (std::size_t i = 0; i < shapes.size(); ++i) {
+    const bool expected = shapes[i].bounds.Overlaps(bounds);
+    const bool found = (status[i / 32] >> (i % 32)) & 1;
+    if (found != expected)
+      return false;
+
+    expected_n += expected;
+  }
+
+  return n == expected_n;
+}
+
+template<typename T>
+static bool
+IsAligned(const T *p)
+{
+  return reinterpret_cast<std::uintptr_t>(p) % alignof(T) == 0;
+}
+
+static bool
+Throws(std::span<const std::byte> data)
+{
+  try {
+    TopographyPackage package(data);
+    return false;
+  } catch (const std::runtime_error &) {
+    return true;
+  }
+}
+
+int
+main()
+{
+  plan_tests(17);
+
+  srand(42);
+
+  const auto shapes = MakeShapes();
+  const auto package_shapes = ToPackageShapes(shapes);
+  const unsigned min_distance[TopographyPackage::MAX_LEVELS] = {1, 2, 3, 4};
+  const unsigned no_distance[TopographyPackage::MAX_LEVELS]{};
+
+  TopographyPackageWriter writer;
+  writer.AddLayer("empty", center, no_distance, {});
+  writer.AddLayer("roads", center, min_distance, package_shapes);
+
+  StringOutputStream sos;
+  {
+    BufferedOutputStream bos(sos);
+    writer.Finish(bos);
+    bos.Flush();
+  }
+
+  const std::string &value = sos.GetValue();
+  const auto data = std::as_bytes(std::span{value});
+
+  const TopographyPackage package(data);
+  ok1(package.FindLayer("rivers") == nullptr);
+
+  const auto *empty = package.FindLayer("empty");
+  ok1(empty != nullptr);
+  ok1(empty->size() == 0);
+
+  const auto *layer = package.FindLayer("roads");
+  ok1(layer != nullptr);
+  ok1(layer->size() == N_SHAPES);
+  ok1(layer->GetMinimumPointDistance(2) == 3);
+  ok1(std::abs((layer->GetCenter().longitude - center.longitude).Native()) < 1e-12);
+
+  bool all_equal = true;
+  for (std::size_t i = 0; i < shapes.size(); ++i)
+    all_equal = all_equal && Equals(layer->GetShape(i), shapes[i]);
+  ok1(all_equal);
+
+  /* the points are used in place */
+  ok1(IsAligned(layer->GetShape(7).points.data()));
+
+  /* spatial index */
+  ok1(CheckWhichShapes(*layer, shapes, layer->GetBounds()));
+  ok1(CheckWhichShapes(*layer, shapes,
+                       GeoBounds({Angle::Degrees(10.5), Angle::Degrees(47.5)},
+                                 {Angle::Degrees(10.7), Angle::Degrees(47.2)})));
+  ok1(CheckWhichShapes(*layer, shapes,
+                       GeoBounds({Angle::Degrees(11.9), Angle::Degrees(46.3)},
+                                 {Angle::Degrees(13), Angle::Degrees(45)})));
+  ok1(CheckWhichShapes(*layer, shapes,
+                       GeoBounds({Angle::Degrees(20), Angle::Degrees(47.5)},
+                                 {Angle::Degrees(21), Angle::Degrees(47.2)})));
+
+  /* malformed files */
+  std::string bad_magic = value;
+  bad_magic[0] = 'Z';
+  ok1(Throws(std::as_bytes(std::span{bad_magic})));
+  ok1(Throws(data.first(sizeof(TopographyPackage::Header) + 8)));
+  ok1(Throws(data.first(data.size() / 2)));
+
+  /* a broken record is detected when the shape is read */
+  std::string bad_record = value;
+  {
+    TopographyPackage::LayerEntry entry;
+    memcpy(&entry, bad_record.data() + sizeof(TopographyPackage::Header) +
+           sizeof(entry), sizeof(entry));
+
+    const std::size_t offset = entry.offset +
+      sizeof(TopographyPackage::LayerHeader) +
+      offsetof(TopographyPackage::ShapeRecord, points_offset);
+    const uint32_t points_offset = 0xfffffff0;
+    memcpy(bad_record.data() + offset, &points_offset, sizeof(points_offset));
+  }
+
+  const TopographyPackage bad_package(std::as_bytes(std::span{bad_record}));
+  try {
+    bad_package.FindLayer("roads")->GetShape(0);
+    ok1(false);
+  } catch (const std::runtime_error &) {
+    ok1(true);
+  }
+
+  return exit_status();
+}
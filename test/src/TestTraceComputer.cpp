@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Computer/TraceComputer.hpp"
+#include "Computer/Settings.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+
+using namespace std::chrono;
+
+static TracePointVector
+MakePoints(unsigned n)
+{
+  TracePointVector v;
+  for (unsigned i = 0; i < n; ++i) {
+    const GeoPoint location(Angle::Degrees(7 + 0.001 * i),
+                            Angle::Degrees(51 + 0.002 * std::sin(i * 0.1)));
+    v.push_back(TracePoint(location, duration<unsigned>(5 * i),
+                           int(1000 + i), 0, 0));
+  }
+
+  return v;
+}
+
+static bool
+Equals(const TracePointVector &a, const TracePointVector &b) noexcept
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (unsigned i = 0; i < a.size(); ++i)
+    if (a[i].GetTime() != b[i].GetTime() ||
+        !(a[i].GetFlatLocation() == b[i].GetFlatLocation()))
+      return false;
+
+  return true;
+}
+
+int
+main()
+{
+  plan_tests(6);
+
+  ComputerSettings settings;
+  settings.contest.enable = false;
+
+  TraceComputer trace_computer;
+  const Serial empty_serial = trace_computer.LockedGetSerial();
+
+  const auto points = MakePoints(300);
+  trace_computer.Restore(settings, points);
+  ok1(trace_computer.LockedGetSerial() != empty_serial);
+
+  /* the published copy is the same as the trace */
+  TracePointVector all;
+  trace_computer.LockedCopyTo(all);
+  ok1(all.size() == trace_computer.GetFull().size());
+
+  TracePointVector expected;
+  trace_computer.GetFull().GetPoints(expected);
+  ok1(Equals(all, expected));
+
+  /* the filtered copy matches Trace::GetPoints() */
+  const GeoPoint center(Angle::Degrees(7.1), Angle::Degrees(51));
+  for (const double resolution : {10., 500.}) {
+    TracePointVector filtered, expected_filtered;
+    trace_computer.LockedCopyTo(filtered, duration<unsigned>(200),
+                                center, resolution);
+    trace_computer.GetFull().GetPoints(expected_filtered,
+                                       duration<unsigned>(200),
+                                       center, resolution);
+    ok1(Equals(filtered, expected_filtered));
+  }
+
+  /* after a reset, readers see an empty trace */
+  trace_computer.Reset();
+  trace_computer.LockedCopyTo(all);
+  ok1(all.empty());
+
+  return exit_status();
+}
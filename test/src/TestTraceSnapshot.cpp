@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Engine/Contest/Solvers/TraceSnapshot.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "TestUtil.hpp"
+
+using namespace std::chrono;
+
+static void
+Append(Trace &trace, unsigned first, unsigned last)
+{
+  for (unsigned i = first; i < last; ++i) {
+    const GeoPoint location(Angle::Degrees(7 + 0.01 * i),
+                            Angle::Degrees(51 + 0.005 * (i % 7)));
+    trace.push_back(TracePoint(location, duration<unsigned>(10 * i),
+                               int(1000 + 3 * i), 0, 0));
+  }
+}
+
+/**
+ * Does the snapshot match the #TracePoint objects?
+ */
+static bool
+Compare(const TraceSnapshot &snapshot, const TracePointerVector &v)
+{
+  if (snapshot.size() != v.size())
+    return false;
+
+  for (unsigned i = 0; i < v.size(); ++i) {
+    if (!(snapshot.GetFlatLocation(i) == v[i]->GetFlatLocation()) ||
+        snapshot.GetTime(i) != v[i]->GetTime() ||
+        snapshot.GetIntegerAltitude(i) != v[i]->GetIntegerAltitude())
+      return false;
+
+    for (unsigned j = 0; j < i; j += 5)
+      if (snapshot.GetFlatDistance(i, j) != v[i]->FlatDistanceTo(*v[j]))
+        return false;
+  }
+
+  return true;
+}
+
+/**
+ * Do the (cached) distance rows match TracePoint::FlatDistanceTo()?
+ */
+static bool
+CompareRows(TraceSnapshot &snapshot, const TracePointerVector &v)
+{
+  for (unsigned i = 0; i < v.size(); i += 3) {
+    const unsigned *row = snapshot.GetDistanceRow(i);
+    for (unsigned j = i; j < v.size(); ++j)
+      if (row[j - i] != v[i]->FlatDistanceTo(*v[j]))
+        return false;
+  }
+
+  return true;
+}
+
+int
+main()
+{
+  plan_tests(7);
+
+  Trace trace({}, Trace::null_time, 64);
+  Append(trace, 0, 40);
+
+  TracePointerVector v;
+  v.reserve(trace.GetMaxSize());
+  trace.GetPoints(v);
+
+  TraceSnapshot snapshot;
+  snapshot.Update(v);
+  ok1(Compare(snapshot, v));
+  ok1(CompareRows(snapshot, v));
+
+  /* new points are appended to the existing snapshot, and the
+     cached rows are extended */
+  Append(trace, 40, 50);
+  ok1(trace.SyncPoints(v));
+  snapshot.Update(v);
+  ok1(Compare(snapshot, v));
+  ok1(CompareRows(snapshot, v));
+
+  /* after thinning, it has to be rebuilt */
+  Append(trace, 50, 100);
+  trace.GetPoints(v);
+  snapshot.clear();
+  snapshot.Update(v);
+  ok1(Compare(snapshot, v));
+  ok1(CompareRows(snapshot, v));
+
+  return exit_status();
+}
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "FLARM/List.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+
+#include <stdio.h>
+
+static constexpr TimeStamp now{std::chrono::seconds{10}};
+
+static FlarmId
+MakeId(uint32_t value)
+{
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%06X", value);
+  return FlarmId::Parse(buffer, nullptr);
+}
+
+static bool
+IsSorted(const TrafficList &list)
+{
+  return std::is_sorted(list.list.begin(), list.list.end(),
+                        [](const FlarmTraffic &a, const FlarmTraffic &b){
+                          return a.id < b.id;
+                        });
+}
+
+static void
+Add(TrafficList &list, uint32_t id)
+{
+  FlarmTraffic *traffic = list.AllocateTraffic(MakeId(id));
+  if (traffic != nullptr)
+    traffic->valid.Update(now);
+}
+
+static void
+TestAllocate()
+{
+  TrafficList list;
+  list.Clear();
+
+  for (uint32_t id : {0x500, 0x100, 0x300, 0x200, 0x400})
+    Add(list, id);
+
+  ok1(list.GetActiveTrafficCount() == 5);
+  ok1(IsSorted(list));
+  ok1(list.FindTraffic(MakeId(0x300)) != nullptr);
+  ok1(list.FindTraffic(MakeId(0x300))->id == MakeId(0x300));
+  ok1(list.FindTraffic(MakeId(0x250)) == nullptr);
+  ok1(list.FindTraffic(MakeId(0x600)) == nullptr);
+
+  /* expire one target; the order of the others is preserved */
+  list.list[2].valid.Clear();
+  list.Expire(now);
+  ok1(list.GetActiveTrafficCount() == 4);
+  ok1(IsSorted(list));
+  ok1(list.FindTraffic(MakeId(0x300)) == nullptr);
+  ok1(list.FindTraffic(MakeId(0x400)) != nullptr);
+}
+
+static void
+TestComplement()
+{
+  TrafficList a, b;
+  a.Clear();
+  b.Clear();
+
+  for (uint32_t id : {0x100, 0x300, 0x500})
+    Add(a, id);
+
+  for (uint32_t id : {0x200, 0x300, 0x600})
+    Add(b, id);
+
+  a.Complement(b);
+  ok1(a.GetActiveTrafficCount() == 5);
+  ok1(IsSorted(a));
+  ok1(a.FindTraffic(MakeId(0x200)) != nullptr);
+  ok1(a.FindTraffic(MakeId(0x600)) != nullptr);
+
+  /* merging into an empty list copies it */
+  TrafficList c;
+  c.Clear();
+  c.Complement(b);
+  ok1(c.GetActiveTrafficCount() == 3);
+
+  /* overflow: the highest ids are dropped */
+  TrafficList full, more;
+  full.Clear();
+  more.Clear();
+  for (uint32_t i = 0; i < TrafficList::MAX_COUNT - 1; ++i)
+    Add(full, 0x1000 + 2 * i);
+
+  Add(more, 0x0001);
+  Add(more, 0x1000);
+  Add(more, 0xfffff);
+
+  full.Complement(more);
+  ok1(full.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(IsSorted(full));
+  ok1(full.FindTraffic(MakeId(0x0001)) != nullptr);
+  ok1(full.FindTraffic(MakeId(0xfffff)) == nullptr);
+
+  /* a full list allocates nothing */
+  ok1(full.AllocateTraffic(MakeId(0x0002)) == nullptr);
+}
+
+static void
+TestCopyFrom()
+{
+  TrafficList src;
+  src.Clear();
+  for (uint32_t id : {0x300, 0x100, 0x200})
+    Add(src, id);
+  src.modified.Update(now);
+
+  /* the destination holds more (stale) targets than the source */
+  TrafficList dest;
+  dest.Clear();
+  for (uint32_t id = 0x1000; id < 0x1010; ++id)
+    Add(dest, id);
+
+  dest.CopyFrom(src);
+  ok1(dest.GetActiveTrafficCount() == 3);
+  ok1(IsSorted(dest));
+  ok1(dest.FindTraffic(MakeId(0x200)) != nullptr);
+  ok1(dest.FindTraffic(MakeId(0x1000)) == nullptr);
+  ok1(dest.modified.IsValid());
+}
+
+int
+main()
+{
+  plan_tests(25);
+
+  TestAllocate();
+  TestComplement();
+  TestCopyFrom();
+
+  return exit_status();
+}
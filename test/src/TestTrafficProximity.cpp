@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Computer/TrafficProximityComputer.hpp"
+#include "Computer/TrafficProximity.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Tracking/JETProvider/RadarParser.hpp"
+#include "Tracking/JETProvider/TrafficTable.hpp"
+#include "Tracking/JETProvider/Settings.hpp"
+#include "TestUtil.hpp"
+
+#include <string>
+
+#include <stdio.h>
+
+static constexpr unsigned EPOCH = 1615771825;
+
+static std::string
+MakeLine(const char *id, double latitude, double longitude,
+         unsigned track, unsigned altitude_ft, unsigned speed_kt)
+{
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer), "%s,,,%f,%f,%u,%u,%u,0,%u,\n",
+           id, latitude, longitude, track, altitude_ft, speed_kt, EPOCH);
+  return buffer;
+}
+
+static std::shared_ptr<const JETProvider::TrafficTable>
+MakeTable(const std::string &lines)
+{
+  NMEAInfo basic{};
+  basic.clock = TimeStamp{FloatDuration{100}};
+
+  RadarParser::Radar radar;
+  if (!RadarParser::ParseRadarBuffer(basic, "0,0\n" + lines, radar))
+    return nullptr;
+
+  return std::make_shared<const JETProvider::TrafficTable>(std::move(radar));
+}
+
+static std::string
+MakeScenario()
+{
+  std::string lines;
+
+  /* 3 km north, head-on */
+  lines += MakeLine("a", 51.027, 7, 180, 3281, 100);
+  /* 3 km north, flying away faster than we do */
+  lines += MakeLine("b", 51.027, 7.001, 0, 3281, 200);
+  /* 3 km east, parallel track */
+  lines += MakeLine("c", 51, 7.043, 0, 3281, 100);
+  /* head-on, but 600 m above */
+  lines += MakeLine("d", 51.027, 7, 180, 5250, 100);
+  /* head-on, but out of range */
+  lines += MakeLine("e", 51.2, 7, 180, 3281, 100);
+  /* 3 km north, 1.5 km east, heading west: crossing ahead of us */
+  lines += MakeLine("f", 51.027, 7.0214, 270, 3281, 100);
+  return lines;
+}
+
+static AircraftState
+MakeAircraft()
+{
+  AircraftState aircraft;
+  aircraft.Reset();
+  aircraft.location = GeoPoint(Angle::Degrees(7), Angle::Degrees(51));
+  aircraft.altitude = 1000;
+  aircraft.track = Angle::Zero();
+  aircraft.ground_speed = 30;
+  return aircraft;
+}
+
+static void
+Check(const std::shared_ptr<const JETProvider::TrafficTable> &table)
+{
+  JETProviderSettings settings;
+  settings.SetDefaults();
+
+  const auto now = std::chrono::system_clock::from_time_t(EPOCH);
+
+  TrafficProximityComputer computer;
+  TrafficProximityInfo info;
+  info.Clear();
+  computer.Compute(table, now, std::chrono::seconds{30},
+                   MakeAircraft(), settings, info);
+
+  ok1(info.intruder_count == 1);
+  ok1(info.nearest.id == "a");
+  ok1(fabs(info.nearest.distance - 3002) < 20);
+  ok1(fabs(info.nearest.relative_altitude) < 1);
+  ok1(fabs(info.nearest.closing_speed - 81.4) < 1);
+  ok1(fabs(info.nearest.time_to_closest - 36.9) < 1);
+
+  /* a wider cone also catches the crossing target */
+  settings.proximity.cone = 60;
+  computer.Compute(table, now, std::chrono::seconds{30},
+                   MakeAircraft(), settings, info);
+  ok1(info.intruder_count == 2);
+}
+
+int
+main()
+{
+  plan_tests(16);
+
+  const auto small = MakeTable(MakeScenario());
+  if (!ok1(small != nullptr))
+    return exit_status();
+
+  Check(small);
+
+  /* many targets far away: the grid index is used instead of a
+     linear scan */
+  std::string lines = MakeScenario();
+  for (unsigned i = 0; i < 2000; ++i) {
+    char id[16];
+    snprintf(id, sizeof(id), "x%u", i);
+    lines += MakeLine(id, 52 + (i % 50) * 0.02, 8 + (i / 50) * 0.03,
+                      180, 3281, 100);
+  }
+
+  const auto large = MakeTable(lines);
+  if (!ok1(large != nullptr))
+    return exit_status();
+
+  Check(large);
+
+  return exit_status();
+}
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "util/TripleBuffer.hpp"
+#include "TestUtil.hpp"
+
+#include <thread>
+
+struct Pair {
+  unsigned a = 0, b = 0;
+};
+
+static void
+TestSingleThread()
+{
+  TripleBuffer<Pair> buffer;
+  ok1(!buffer.Acquire());
+  ok1(buffer.GetFrontVersion() == 0);
+
+  buffer.GetBack() = {1, 1};
+  buffer.Publish();
+  buffer.GetBack() = {2, 2};
+  buffer.Publish();
+
+  /* only the newest version is seen */
+  ok1(buffer.Acquire());
+  ok1(buffer.GetFront().a == 2);
+  ok1(buffer.GetFrontVersion() == 2);
+  ok1(!buffer.Acquire());
+  ok1(buffer.GetFront().a == 2);
+}
+
+/**
+ * A writer thread publishes many versions; the reader must only see
+ * complete ones, with increasing version numbers.
+ */
+static void
+TestThreads()
+{
+  static constexpr unsigned N = 100000;
+
+  TripleBuffer<Pair> buffer;
+
+  std::thread writer([&buffer]{
+    for (unsigned i = 1; i <= N; ++i) {
+      Pair &p = buffer.GetBack();
+      p.a = i;
+      p.b = i;
+      buffer.Publish();
+
+      if (i % 64 == 0)
+        std::this_thread::yield();
+    }
+  });
+
+  bool consistent = true, increasing = true;
+  unsigned last = 0;
+  while (last < N) {
+    if (!buffer.Acquire()) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    const Pair &p = buffer.GetFront();
+    if (p.a != p.b || p.a != buffer.GetFrontVersion())
+      consistent = false;
+
+    if (p.a <= last)
+      increasing = false;
+
+    last = p.a;
+  }
+
+  writer.join();
+
+  ok1(consistent);
+  ok1(increasing);
+  ok1(last == N);
+}
+
+int
+main()
+{
+  plan_tests(10);
+
+  TestSingleThread();
+  TestThreads();
+
+  return exit_status();
+}
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "event/Loop.hxx"
+#include "event/FineTimerEvent.hxx"
+#include "io/uring/Queue.hxx"
+#include "io/uring/ReadStream.hxx"
+#include "io/UniqueFileDescriptor.hxx"
+#include "TestUtil.hpp"
+
+#include <string>
+
+#include <errno.h>
+
+/**
+ * Larger than all buffers of a #Uring::ReadStream together, but
+ * still fits into a pipe.
+ */
+static constexpr std::size_t BIG_SIZE = 60000;
+
+class Reader final : public Uring::ReadStreamHandler {
+  EventLoop &event_loop;
+
+  UniqueFileDescriptor w;
+
+public:
+  std::string received;
+  bool ended = false;
+  int error = 0;
+
+  Reader(EventLoop &_event_loop, UniqueFileDescriptor &&_w) noexcept
+    :event_loop(_event_loop), w(std::move(_w)) {}
+
+  void OnUringRead(std::span<const std::byte> src) noexcept override {
+    received.append(reinterpret_cast<const char *>(src.data()), src.size());
+
+    if (received.size() == BIG_SIZE)
+      /* the second chunk is written after the stream is running */
+      (void)w.Write("hello", 5);
+    else if (received.size() == BIG_SIZE + 5)
+      w.Close();
+  }
+
+  void OnUringReadEnd() noexcept override {
+    ended = true;
+    event_loop.Break();
+  }
+
+  void OnUringReadError(int _error) noexcept override {
+    error = _error;
+    event_loop.Break();
+  }
+};
+
+class Idle final : public Uring::ReadStreamHandler {
+public:
+  bool called = false;
+  int error = 0;
+
+  void OnUringRead(std::span<const std::byte>) noexcept override {
+    called = true;
+  }
+
+  void OnUringReadEnd() noexcept override {
+    called = true;
+  }
+
+  void OnUringReadError(int _error) noexcept override {
+    error = _error;
+  }
+};
+
+static std::string
+MakeData(std::size_t size) noexcept
+{
+  std::string data;
+  data.reserve(size);
+  for (std::size_t i = 0; i < size; ++i)
+    data.push_back('a' + i % 26);
+  return data;
+}
+
+int
+main()
+{
+  plan_tests(6);
+
+  EventLoop event_loop;
+  auto *queue = event_loop.GetUring();
+  if (queue == nullptr) {
+    skip(6, 0, "io_uring not available");
+    return exit_status();
+  }
+
+  /* read a large block, then a small one written later, then the
+     end of the stream */
+  UniqueFileDescriptor r1, w1;
+  if (!UniqueFileDescriptor::CreatePipeNonBlock(r1, w1))
+    return EXIT_FAILURE;
+
+  const std::string data = MakeData(BIG_SIZE);
+  ok1(w1.Write(data.data(), data.size()) == ssize_t(data.size()));
+
+  Reader reader(event_loop, std::move(w1));
+  ok1(Uring::ReadStream::Start(*queue, r1, reader) != nullptr);
+
+  /* a cancelled stream must not invoke its handler */
+  UniqueFileDescriptor r2, w2;
+  if (!UniqueFileDescriptor::CreatePipeNonBlock(r2, w2))
+    return EXIT_FAILURE;
+
+  Idle cancelled;
+  auto *stream = Uring::ReadStream::Start(*queue, r2, cancelled);
+  if (stream != nullptr)
+    stream->Cancel();
+  (void)w2.Write("x", 1);
+
+  /* a stream which is still pending when the EventLoop finishes */
+  UniqueFileDescriptor r3, w3;
+  if (!UniqueFileDescriptor::CreatePipeNonBlock(r3, w3))
+    return EXIT_FAILURE;
+
+  Idle pending;
+  Uring::ReadStream::Start(*queue, r3, pending);
+
+  FineTimerEvent timeout(event_loop, BIND_METHOD(event_loop, &EventLoop::Break));
+  timeout.Schedule(std::chrono::seconds(10));
+
+  event_loop.Run();
+
+  ok1(reader.ended && reader.error == 0);
+  ok1(reader.received == data + "hello");
+  ok1(!cancelled.called && cancelled.error == 0);
+  ok1(!pending.called && pending.error == ECANCELED);
+
+  return exit_status();
+}
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Waypoint/WaypointCache.hpp"
+#include "Engine/Waypoint/Waypoint.hpp"
+#include "io/StringOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "io/BufferedReader.hxx"
+#include "io/MemoryReader.hxx"
+#include "TestUtil.hpp"
+
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+static std::vector<WaypointPtr>
+MakeWaypoints()
+{
+  std::vector<WaypointPtr> waypoints;
+
+  Waypoint airfield(GeoPoint(Angle::Degrees(7.5), Angle::Degrees(51.25)));
+  airfield.elevation = 123;
+  airfield.has_elevation = true;
+  airfield.shortname = _T("EDXY");
+  airfield.name = _T("Airfield");
+  airfield.comment = _T("Comment");
+  airfield.details = _T("Details\nwith two lines");
+  airfield.files_embed.push_front(_T("b.jpg"));
+  airfield.files_embed.push_front(_T("a.jpg"));
+  airfield.original_id = 42;
+  airfield.runway.SetDirectionDegrees(270);
+  airfield.runway.SetLength(800);
+  airfield.radio_frequency = RadioFrequency::FromMegaKiloHertz(123, 450);
+  airfield.flags.turn_point = true;
+  airfield.flags.home = true;
+  airfield.type = Waypoint::Type::AIRFIELD;
+  airfield.origin = WaypointOrigin::PRIMARY;
+  waypoints.push_back(std::make_shared<Waypoint>(std::move(airfield)));
+
+  Waypoint point(GeoPoint(Angle::Degrees(-3), Angle::Degrees(-40)));
+  point.name = _T("No elevation");
+  point.origin = WaypointOrigin::WATCHED;
+  waypoints.push_back(std::make_shared<Waypoint>(std::move(point)));
+
+  return waypoints;
+}
+
+static bool
+Equals(const Waypoint &a, const Waypoint &b)
+{
+  return a.location == b.location &&
+    a.has_elevation == b.has_elevation &&
+    (!a.has_elevation || a.elevation == b.elevation) &&
+    a.shortname == b.shortname && a.name == b.name &&
+    a.comment == b.comment && a.details == b.details &&
+    a.files_embed == b.files_embed &&
+    a.original_id == b.original_id &&
+    a.runway.IsDirectionDefined() == b.runway.IsDirectionDefined() &&
+    a.runway.IsLengthDefined() == b.runway.IsLengthDefined() &&
+    (!a.runway.IsLengthDefined() ||
+     a.runway.GetLength() == b.runway.GetLength()) &&
+    a.radio_frequency == b.radio_frequency &&
+    a.flags.turn_point == b.flags.turn_point &&
+    a.flags.home == b.flags.home &&
+    a.flags.start_point == b.flags.start_point &&
+    a.type == b.type && a.origin == b.origin;
+}
+
+static std::string
+Save(const std::vector<WaypointPtr> &waypoints, std::string_view key)
+{
+  StringOutputStream sos;
+  BufferedOutputStream bos(sos);
+  SaveWaypointCache(bos, key, waypoints);
+  bos.Flush();
+  return sos.GetValue();
+}
+
+static std::vector<Waypoint>
+Load(std::string_view data, std::string_view key)
+{
+  MemoryReader reader(std::as_bytes(std::span{data}));
+  BufferedReader br(reader);
+  return LoadWaypointCache(br, key);
+}
+
+static bool
+Throws(std::string_view data, std::string_view key)
+{
+  try {
+    Load(data, key);
+    return false;
+  } catch (const std::runtime_error &) {
+    return true;
+  }
+}
+
+int
+main()
+{
+  plan_tests(9);
+
+  const auto waypoints = MakeWaypoints();
+  const std::string data = Save(waypoints, "/path/waypoints.cup");
+
+  const auto loaded = Load(data, "/path/waypoints.cup");
+  ok1(loaded.size() == waypoints.size());
+  ok1(Equals(loaded[0], *waypoints[0]));
+  ok1(Equals(loaded[1], *waypoints[1]));
+
+  /* the order of the embedded files is preserved */
+  ok1(loaded[0].files_embed.front() == _T("a.jpg"));
+  ok1(std::distance(loaded[0].files_embed.begin(),
+                    loaded[0].files_embed.end()) == 2);
+
+  /* the snapshot of another file is refused */
+  ok1(Throws(data, "/path/other.cup"));
+
+  /* malformed snapshots */
+  ok1(Throws(std::string_view{data}.substr(0, data.size() - 1),
+             "/path/waypoints.cup"));
+
+  std::string bad_version = data;
+  bad_version[0] ^= 0x40;
+  ok1(Throws(bad_version, "/path/waypoints.cup"));
+
+  /* an empty list */
+  ok1(Load(Save({}, "x"), "x").empty());
+
+  return exit_status();
+}
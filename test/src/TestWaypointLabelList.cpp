@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Renderer/WaypointLabelList.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+static const PixelRect screen{0, 0, 640, 480};
+
+static void
+Add(WaypointLabelList &list, unsigned id, const TCHAR *name,
+    int altitude, bool in_task = false, bool landable = false,
+    PixelPoint p = {100, 100})
+{
+  list.Add(id, name, p, {}, false, altitude,
+           in_task, landable, false, false);
+}
+
+/**
+ * Returns the names of all labels in drawing order, separated by
+ * spaces.
+ */
+static std::basic_string<TCHAR>
+GetOrder(const WaypointLabelList &list)
+{
+  std::basic_string<TCHAR> result;
+  for (const auto &l : list) {
+    if (!result.empty())
+      result.push_back(_T(' '));
+    result.append(l.Name);
+  }
+
+  return result;
+}
+
+int
+main()
+{
+  plan_tests(5);
+
+  WaypointLabelList list;
+
+  list.BeginUpdate(screen);
+  Add(list, 1, _T("A"), 100);
+  Add(list, 2, _T("B"), 50, false, true);
+  Add(list, 3, _T("C"), 200);
+  list.EndUpdate();
+  ok1(GetOrder(list) == _T("B C A"));
+
+  /* a changed arrival altitude reorders the labels; a second label
+     for the same waypoint and labels outside of the screen are
+     ignored */
+  list.BeginUpdate(screen);
+  Add(list, 4, _T("D"), 0, true);
+  Add(list, 1, _T("A"), 300);
+  Add(list, 2, _T("B"), 50, false, true);
+  Add(list, 3, _T("C"), 200);
+  Add(list, 3, _T("X"), 1000, true);
+  Add(list, 5, _T("E"), 0, false, false, {-100, 100});
+  list.EndUpdate();
+  ok1(GetOrder(list) == _T("D B A C"));
+
+  /* waypoints which were not submitted are removed */
+  list.BeginUpdate(screen);
+  Add(list, 1, _T("A"), 300);
+  Add(list, 3, _T("C"), 200);
+  Add(list, 4, _T("D"), 0, true);
+  list.EndUpdate();
+  ok1(GetOrder(list) == _T("D A C"));
+
+  /* B was reachable, but isn't anymore */
+  list.BeginUpdate(screen);
+  Add(list, 1, _T("A"), 300);
+  Add(list, 2, _T("B"), 400);
+  Add(list, 3, _T("C"), 200);
+  list.EndUpdate();
+  ok1(GetOrder(list) == _T("B A C"));
+
+  list.Clear();
+  ok1(list.size() == 0);
+
+  return exit_status();
+}
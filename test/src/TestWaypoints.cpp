@@ -138,6 +138,43 @@ TestNamePrefixVisitor(const Waypoints &waypoints)
   TestNamePrefixVisitor(waypoints, _T("Field"), 51 - 8);
 }
 
+static unsigned
+CountNameMatches(const Waypoints &waypoints, const TCHAR *query)
+{
+  unsigned count = 0;
+  waypoints.VisitNameMatches(query, [&count](const auto &){ ++count; });
+  return count;
+}
+
+static unsigned
+CountNameMatchesWithinRange(const Waypoints &waypoints, const TCHAR *query,
+                            const GeoPoint &location, double distance)
+{
+  unsigned count = 0;
+  waypoints.VisitNameMatchesWithinRange(query, location, distance,
+                                        [&count](const auto &){ ++count; });
+  return count;
+}
+
+static void
+TestNameMatches(const Waypoints &waypoints, const GeoPoint &center)
+{
+  /* substrings of three or more characters */
+  ok1(CountNameMatches(waypoints, _T("field")) == 65);
+  ok1(CountNameMatches(waypoints, _T("eld")) == 65);
+  ok1(CountNameMatches(waypoints, _T("Point")) == 86);
+  ok1(CountNameMatches(waypoints, _T("d #15")) == 2);
+  ok1(CountNameMatches(waypoints, _T("Foo")) == 0);
+
+  /* shorter strings match only prefixes */
+  ok1(CountNameMatches(waypoints, _T("ai")) == 22);
+  ok1(CountNameMatches(waypoints, _T("el")) == 0);
+
+  ok1(CountNameMatchesWithinRange(waypoints, _T("Field"), center, 10500) == 5);
+  ok1(CountNameMatchesWithinRange(waypoints, _T("F"), center, 10500) == 3);
+  ok1(CountNameMatchesWithinRange(waypoints, _T(""), center, 10500) == 11);
+}
+
 class CloserThan
 {
   double distance;
@@ -285,7 +322,7 @@ main(int argc, char** argv)
   if (!ParseArgs(argc, argv))
     return 0;
 
-  plan_tests(52);
+  plan_tests(65);
 
   Waypoints waypoints;
   GeoPoint center(Angle::Degrees(51.4), Angle::Degrees(7.85));
@@ -299,6 +336,7 @@ main(int argc, char** argv)
 
   TestLookups(waypoints, center);
   TestNamePrefixVisitor(waypoints);
+  TestNameMatches(waypoints, center);
   TestRangeVisitor(waypoints, center);
   TestGetNearest(waypoints, center);
   TestIterator(waypoints);
@@ -306,6 +344,10 @@ main(int argc, char** argv)
   ok(TestCopy(waypoints), "waypoint copy", 0);
   ok(TestErase(waypoints, 3), "waypoint erase", 0);
   ok(TestReplace(waypoints, 4), "waypoint replace", 0);
+  ok1(CountNameMatches(waypoints, _T("Fred")) == 1);
+  // one erased, one copied
+  ok1(CountNameMatches(waypoints, _T("Waypoint")) == 86);
+  ok1(CountNameMatches(waypoints, _T("Field")) == 64);
 
   // test clear
   waypoints.Clear();
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Weather/SampleGrid.hpp"
+#include "TestUtil.hpp"
+
+using std::chrono::system_clock;
+using namespace std::chrono;
+
+static std::shared_ptr<const WeatherSampleGrid>
+MakeGrid(system_clock::time_point time, int16_t first=10)
+{
+  /* 3x2 cells of one degree, north-west corner at 8E 50N */
+  const GeoBounds bounds(GeoPoint(Angle::Degrees(8), Angle::Degrees(50)),
+                         GeoPoint(Angle::Degrees(11), Angle::Degrees(48)));
+
+  std::vector<int16_t> values{
+    first, 20, 30,
+    -1, 50, 60,
+  };
+
+  return std::make_shared<WeatherSampleGrid>(bounds, 3, 2, std::move(values),
+                                             0.5f, 1.f, -1, time);
+}
+
+static GeoPoint
+Point(double longitude, double latitude)
+{
+  return GeoPoint(Angle::Degrees(longitude), Angle::Degrees(latitude));
+}
+
+static void
+TestSample()
+{
+  const auto grid = MakeGrid(system_clock::now());
+
+  ok1(grid->Sample(Point(8.5, 49.5)) == 6);
+  ok1(grid->Sample(Point(9.5, 49.5)) == 11);
+  ok1(grid->Sample(Point(10.9, 49.9)) == 16);
+  ok1(grid->Sample(Point(9.5, 48.5)) == 26);
+  ok1(grid->Sample(Point(10.5, 48.1)) == 31);
+
+  /* the east and south edges belong to the last cells */
+  ok1(grid->Sample(Point(11, 48)) == 31);
+
+  /* no data */
+  ok1(!grid->Sample(Point(8.5, 48.5)));
+
+  /* outside */
+  ok1(!grid->Sample(Point(7.9, 49.5)));
+  ok1(!grid->Sample(Point(9.5, 50.1)));
+  ok1(!grid->Sample(Point(11.1, 48.5)));
+}
+
+static void
+TestPublish()
+{
+  const auto now = system_clock::now();
+
+  ok1(WeatherSamples::Get(_T("test/a")) == nullptr);
+
+  const auto later = MakeGrid(now + hours{2}, 100);
+  WeatherSamples::Publish(_T("test/a"), later);
+  ok1(WeatherSamples::Get(_T("test/a")) == later);
+
+  /* closer to now: replaces */
+  const auto current = MakeGrid(now + minutes{10}, 200);
+  WeatherSamples::Publish(_T("test/a"), current);
+  ok1(WeatherSamples::Get(_T("test/a")) == current);
+
+  /* further from now: ignored */
+  WeatherSamples::Publish(_T("test/a"), MakeGrid(now - hours{1}));
+  ok1(WeatherSamples::Get(_T("test/a")) == current);
+  ok1(WeatherSamples::Get(_T("test/a"))->Sample(Point(8.5, 49.5)) == 101);
+
+  ok1(WeatherSamples::Get(_T("test/b")) == nullptr);
+
+  WeatherSamples::Remove(_T("test/a"));
+  ok1(WeatherSamples::Get(_T("test/a")) == nullptr);
+}
+
+int
+main()
+{
+  plan_tests(17);
+
+  TestSample();
+  TestPublish();
+
+  return exit_status();
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "Weather/Stats.hpp"
+#include "TestUtil.hpp"
+
+#include <string.h>
+
+using namespace std::chrono;
+
+static void
+TestAdd()
+{
+  const auto stage = WeatherStage::NOAA_DOWNLOAD;
+
+  ok1(WeatherStats::Get(stage).count == 0);
+  ok1(WeatherStats::Get(stage).GetAverageTime() == WeatherStats::Duration::zero());
+
+  WeatherStats::Add(stage, milliseconds(10), 1000);
+  WeatherStats::Add(stage, milliseconds(30), 3000, false);
+
+  const auto s = WeatherStats::Get(stage);
+  ok1(s.count == 2);
+  ok1(s.errors == 1);
+  ok1(s.bytes == 4000);
+  ok1(s.total_time == milliseconds(40));
+  ok1(s.max_time == milliseconds(30));
+  ok1(s.GetAverageTime() == milliseconds(20));
+
+  /* the other stages are not affected */
+  ok1(WeatherStats::Get(WeatherStage::RASP_LOAD).count == 0);
+}
+
+static void
+TestTimer()
+{
+  const auto stage = WeatherStage::PCMET_DOWNLOAD;
+
+  {
+    WeatherStats::Timer timer{stage};
+    timer.Succeed(123);
+  }
+
+  auto s = WeatherStats::Get(stage);
+  ok1(s.count == 1);
+  ok1(s.errors == 0);
+  ok1(s.bytes == 123);
+
+  /* a timer which was never told about success counts as error */
+  {
+    WeatherStats::Timer timer{stage};
+  }
+
+  s = WeatherStats::Get(stage);
+  ok1(s.count == 2);
+  ok1(s.errors == 1);
+  ok1(s.bytes == 123);
+}
+
+static void
+TestNames()
+{
+  ok1(strcmp(WeatherStats::GetStageName(WeatherStage::SKYSIGHT_LOGIN),
+             "Skysight login") == 0);
+  ok1(strcmp(WeatherStats::GetStageName(WeatherStage::NOAA_DOWNLOAD),
+             "NOAA download") == 0);
+}
+
+int
+main()
+{
+  plan_tests(17);
+
+  TestAdd();
+  TestTimer();
+  TestNames();
+
+  return exit_status();
+}
@@ -10,6 +10,8 @@ class ZeroFinderTest: public ZeroFinder
   unsigned func;
 
 public:
+  unsigned n_calls = 0;
+
   ZeroFinderTest(double x_min, double x_max, unsigned _func = 0) :
     ZeroFinder(x_min, x_max, 0.0001), func(_func) {}
 
@@ -19,6 +21,8 @@ public:
 double
 ZeroFinderTest::f(const double x) noexcept
 {
+  ++n_calls;
+
   if (func == 0)
     return 2 * x * x - 3 * x - 5;
 
@@ -35,7 +39,7 @@ ZeroFinderTest::f(const double x) noexcept
 
 int main()
 {
-  plan_tests(18);
+  plan_tests(21);
 
   ZeroFinderTest zf(-100, 100, 0);
   ok1(equals(zf.find_zero(-150), -1));
@@ -66,5 +70,18 @@ int main()
   ok1(equals(zf4.find_min(1), M_PI));
   ok1(equals(zf4.find_min(140), M_PI));
 
+  /* a hint close to the root needs fewer evaluations than a search
+     of the whole range */
+  ZeroFinderTest zf5(0, 10, 1);
+  const double cold = zf5.find_zero(-150);
+  const unsigned cold_calls = zf5.n_calls;
+  zf5.n_calls = 0;
+  const double warm = zf5.find_zero(cold + 0.05);
+  ok1(equals(warm, 1.584963));
+  ok1(zf5.n_calls < cold_calls);
+
+  /* a bad hint still finds the root */
+  ok1(equals(zf5.find_zero(9.9), 1.584963));
+
   return exit_status();
 }
@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Copyright The XCSoar Project
+
+#include "io/ZipArchive.hpp"
+#include "io/ZipArchiveCache.hpp"
+#include "io/ZipReader.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+
+#include <zzip/lib.h>
+#include <zzip/util.h>
+#include <zlib.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+static constexpr Path MAP_FILE{"test/data/benalla9.xcm"};
+
+static uint32_t
+Checksum(ZipArchive &archive, const char *name)
+{
+  ZipReader reader{archive.get(), name};
+
+  uLong crc = crc32(0, nullptr, 0);
+  std::byte buffer[4096];
+  std::size_t nbytes;
+  while ((nbytes = reader.Read(buffer, sizeof(buffer))) > 0)
+    crc = crc32(crc, (const Bytef *)buffer, nbytes);
+
+  return crc;
+}
+
+static void
+TestLookup()
+{
+  ZipArchive archive{MAP_FILE};
+
+  std::vector<std::string> names;
+  for (std::string name; !(name = archive.NextName()).empty();)
+    names.push_back(std::move(name));
+  ok1(names.size() == 28);
+
+  bool all = true;
+  for (const auto &name : names)
+    all &= archive.Exists(name.c_str());
+  ok1(all);
+
+  ok1(!archive.Exists("terrain"));
+  ok1(!archive.Exists("terrain.jp2x"));
+  ok1(!archive.Exists(""));
+
+  /* case-insensitive lookups do not use the hash table */
+  ZZIP_STAT st;
+  ok1(zzip_dir_stat(archive.get(), "TERRAIN.JP2", &st, ZZIP_CASELESS) == 0 &&
+      st.st_size == 283023);
+  ok1(zzip_dir_stat(archive.get(), "TERRAIN.JP2", &st, 0) != 0);
+}
+
+static void
+TestChecksums()
+{
+  ZipArchive archive{MAP_FILE};
+
+  /* stored */
+  ok1(Checksum(archive, "terrain.jp2") == 0x04145c99);
+  /* deflated */
+  ok1(Checksum(archive, "airspace.txt") == 0x644f9bc1);
+  ok1(Checksum(archive, "watrcrslhydro_line.shp") == 0x7bc26b66);
+}
+
+/**
+ * Two entries read alternately must not disturb each other's
+ * position.
+ */
+static void
+TestInterleaved()
+{
+  ZipArchive archive{MAP_FILE};
+
+  ZipReader a{archive.get(), "watrcrslhydro_line.shp"};
+  ZipReader b{archive.get(), "terrain.jp2"};
+
+  uLong crc_a = crc32(0, nullptr, 0), crc_b = crc_a;
+  std::byte buffer[1000];
+
+  bool done_a = false, done_b = false;
+  while (!done_a || !done_b) {
+    if (std::size_t n = a.Read(buffer, sizeof(buffer)); n > 0)
+      crc_a = crc32(crc_a, (const Bytef *)buffer, n);
+    else
+      done_a = true;
+
+    if (std::size_t n = b.Read(buffer, 333); n > 0)
+      crc_b = crc32(crc_b, (const Bytef *)buffer, n);
+    else
+      done_b = true;
+  }
+
+  ok1(crc_a == 0x7bc26b66);
+  ok1(crc_b == 0x04145c99);
+  ok1(a.GetPosition() == 545732);
+  ok1(b.GetPosition() == 283023);
+}
+
+static void
+TestSeek()
+{
+  ZipArchive archive{MAP_FILE};
+
+  std::vector<char> data(2000);
+  {
+    ZipReader reader{archive.get(), "terrain.jp2"};
+    reader.Read(data.data(), data.size());
+  }
+
+  ZZIP_FILE *file = zzip_open_rb(archive.get(), "terrain.jp2");
+  ok1(file != nullptr);
+
+  char buffer[16];
+  ok1(zzip_seek(file, 1000, SEEK_SET) == 1000);
+  ok1(zzip_read(file, buffer, sizeof(buffer)) == sizeof(buffer));
+  ok1(std::equal(buffer, buffer + sizeof(buffer), data.begin() + 1000));
+  ok1(zzip_tell(file) == 1016);
+
+  ok1(zzip_seek(file, 10, SEEK_SET) == 10);
+  ok1(zzip_read(file, buffer, sizeof(buffer)) == sizeof(buffer));
+  ok1(std::equal(buffer, buffer + sizeof(buffer), data.begin() + 10));
+
+  zzip_close(file);
+}
+
+static void
+TestShared()
+{
+  auto a = OpenSharedZipArchive(MAP_FILE);
+  auto b = OpenSharedZipArchive(MAP_FILE);
+  ok1(a != nullptr);
+#ifdef ZZIP_HAVE_PREAD
+  ok1(a == b);
+#else
+  ok1(a != b);
+#endif
+
+  /* an entry which is still being read keeps the archive open */
+  ZipReader reader{a->get(), "airspace.txt"};
+  a.reset();
+  b.reset();
+
+  char buffer[16];
+  ok1(reader.Read(buffer, sizeof(buffer)) == sizeof(buffer));
+
+  /* the closed archive is not returned again */
+  a = OpenSharedZipArchive(MAP_FILE);
+  ok1(a != nullptr && a->Exists("airspace.txt"));
+}
+
+static void
+TestConcurrent()
+{
+#ifdef ZZIP_HAVE_PREAD
+  static constexpr unsigned N_THREADS = 4;
+  static constexpr const char *names[] = {
+    "terrain.jp2", "airspace.txt", "watrcrslhydro_line.shp",
+    "roadltrans_line.shp", "watrcrslhydro_line.shx",
+  };
+  static constexpr uint32_t crcs[] = {
+    0x04145c99, 0x644f9bc1, 0x7bc26b66, 0xf0230ce8, 0x6a041477,
+  };
+
+  const auto archive = OpenSharedZipArchive(MAP_FILE);
+
+  unsigned errors[N_THREADS]{};
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < N_THREADS; ++t)
+    threads.emplace_back([&archive, &errors, t](){
+      for (unsigned i = 0; i < 20; ++i) {
+        const unsigned n = (t + i) % std::size(names);
+        if (Checksum(*archive, names[n]) != crcs[n])
+          ++errors[t];
+      }
+    });
+
+  for (auto &thread : threads)
+    thread.join();
+
+  bool ok = true;
+  for (unsigned e : errors)
+    ok &= e == 0;
+  ok1(ok);
+#else
+  /* a ZZIP_DIR must not be shared between threads */
+  skip(1, "no pread()");
+#endif
+}
+
+int main()
+{
+  plan_tests(27);
+
+  TestLookup();
+  TestChecksums();
+  TestInterleaved();
+  TestSeek();
+  TestShared();
+  TestConcurrent();
+
+  return exit_status();
+}
@@ -875,35 +875,56 @@ bool test_task_random(TaskManager& task_manager,
   return true;
 }
 
+static const char *
+GetFactoryTypeName(TaskFactoryType type)
+{
+  switch (type) {
+  case TaskFactoryType::AAT:
+    return "AAT";
+  case TaskFactoryType::RACING:
+    return "RT";
+  case TaskFactoryType::FAI_GENERAL:
+    return "FAI";
+  case TaskFactoryType::MAT:
+    return "MAT";
+  default:
+    return "unknown";
+  }
+}
+
 bool test_task_random_RT_AAT_FAI(TaskManager& task_manager,
                       const Waypoints &waypoints,
                       const unsigned _num_points)
 {
-  WaypointPtr wp;
-
-  char tmp[255];
-  char tskType[20];
-  tskType[0] = '\0';
-
-
   switch (rand() %3) {
   case 0:
-    task_manager.SetFactory(TaskFactoryType::AAT);
-    strcpy(tskType,"AAT");
     test_note("# creating random AAT task\n");
-    break;
+    return test_task_random_type(task_manager, waypoints,
+                                 TaskFactoryType::AAT, _num_points);
   case 1:
-    task_manager.SetFactory(TaskFactoryType::RACING);
-    strcpy(tskType,"RT");
     test_note("# creating random RT task\n");
-    break;
+    return test_task_random_type(task_manager, waypoints,
+                                 TaskFactoryType::RACING, _num_points);
   case 2:
-    task_manager.SetFactory(TaskFactoryType::FAI_GENERAL);
-    strcpy(tskType,"FAI");
     test_note("# creating random FAI GENERAL\n");
-    break;
+    return test_task_random_type(task_manager, waypoints,
+                                 TaskFactoryType::FAI_GENERAL, _num_points);
   }
 
+  return false;
+}
+
+bool test_task_random_type(TaskManager& task_manager,
+                           const Waypoints &waypoints,
+                           TaskFactoryType type,
+                           const unsigned _num_points)
+{
+  WaypointPtr wp;
+
+  char tmp[255];
+
+  task_manager.SetFactory(type);
+
   AbstractTaskFactory &fact = task_manager.GetFactory();
 
   //max points includes start & finish
@@ -972,7 +993,7 @@ bool test_task_random_RT_AAT_FAI(TaskManager& task_manager,
   }
   task_manager.Resume();
   sprintf(tmp, "# SUCCESS CREATING %s task! task_size():%d..\n",
-      tskType,
+      GetFactoryTypeName(type),
       task_manager.TaskSize());
   test_note(tmp);
   return true;
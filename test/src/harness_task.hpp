@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Task/TaskManager.hpp"
+#include "Task/Factory/TaskFactoryType.hpp"
 
 static constexpr std::size_t NUM_TASKS = 5;
 
@@ -50,6 +51,15 @@ bool test_task_random_RT_AAT_FAI(TaskManager& task_manager,
                       const Waypoints &waypoints,
                       const unsigned num_points);
 
+/**
+ * Generates a random task of the given type with valid random
+ * start/finish/intermediate points, sizes etc
+ */
+bool test_task_random_type(TaskManager& task_manager,
+                           const Waypoints &waypoints,
+                           TaskFactoryType type,
+                           const unsigned num_points);
+
 bool test_task(TaskManager& task_manager,
                const Waypoints &waypoints,
                int test_num);
@@ -41,7 +41,7 @@ task_load(const TaskBehaviour &task_behaviour)
 class ReplayLoggerSim: public IgcReplay
 {
 public:
-  explicit ReplayLoggerSim(std::unique_ptr<NLineReader> &&_reader)
+  explicit ReplayLoggerSim(std::unique_ptr<FileLineReaderA> &&_reader)
     :IgcReplay(std::move(_reader)),
      started(false) {}
 